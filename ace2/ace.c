@@ -10,6 +10,7 @@
 #include "blif.h"
 #include "cycle.h"
 #include "sim.h"
+#include "bitsim.h"
 #include "bdd.h"
 #include "depth.h"
 #include "cube.h"
@@ -339,6 +340,7 @@ int main(int argc, char * argv[]) {
 	Abc_Ntk_t * ntk;
 	Abc_Obj_t * obj;
 	int seed = 0;
+	int bitsim = FALSE;
 
 	p = ACE_PI_STATIC_PROB;
 	d = ACE_PI_SWITCH_PROB;
@@ -347,7 +349,7 @@ int main(int argc, char * argv[]) {
 	char new_blif_file_name[BLIF_FILE_NAME_LEN];
     char* clk_name = NULL;
 	ace_io_parse_argv(argc, argv, &BLIF, &IN_ACT, &OUT_ACT, blif_file_name,
-			new_blif_file_name, &pi_format, &p, &d, &seed, &clk_name);
+			new_blif_file_name, &pi_format, &p, &d, &seed, &clk_name, &bitsim);
 
 	srand(seed);
 
@@ -428,8 +430,17 @@ int main(int argc, char * argv[]) {
 		error = ace_io_read_activity(ntk, IN_ACT, pi_format, p, d, clk_name);
 	}
 
+	if (!error && bitsim && pi_format == ACE_VEC) {
+		printf("Input vectors are not supported by bit-parallel simulation, using BDDs\n");
+		bitsim = FALSE;
+	}
+
 	if (!error) {
-		error = ace_calc_activity(ntk, ACE_NUM_VECTORS, clk_name);
+		if (bitsim) {
+			error = ace_bitsim_activity(ntk, ACE_NUM_VECTORS, clk_name);
+		} else {
+			error = ace_calc_activity(ntk, ACE_NUM_VECTORS, clk_name);
+		}
 	}
 
 	//Abc_NtkToSop(ntk, 0);
@@ -0,0 +1,249 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "vtr_assert.h"
+
+#include "ace.h"
+#include "bitsim.h"
+
+#include "bdd/cudd/cudd.h"
+#include "bdd/cudd/cuddInt.h"
+
+/*
+ * Bit-parallel Monte-Carlo activity estimation.
+ *
+ * Every bit of a 64 bit word is an independent simulation stream, so a node
+ * is evaluated for all the streams at once with word wide logic operations.
+ * The node functions are compiled from their BDDs once, into a list of
+ * multiplexers evaluated in feed-forward order, instead of walking the BDD
+ * (and looking up the activity info of every fanin) for every vector.
+ * Activities are the simulated frequencies of ones and of toggles between
+ * consecutive cycles, so no BDD based probability calculation is needed.
+ */
+
+/* A BDD node of a compiled node function: slot = fanin ? then : else */
+typedef struct {
+	int var;
+	int then_slot;
+	int then_compl;
+	int else_slot;
+	int else_compl;
+} ace_bitsim_op_t;
+
+/* Slot 0 is the constant one, op k writes slot k + 1 */
+typedef struct {
+	std::vector<ace_bitsim_op_t> ops;
+	int out_slot;
+	int out_compl;
+} ace_bitsim_func_t;
+
+static int compile_bdd(DdNode * bdd, std::unordered_map<DdNode*, int> & slots,
+		ace_bitsim_func_t * func);
+static void compile_node(Abc_Obj_t * obj, ace_bitsim_func_t * func);
+static uint64_t evaluate_node(const ace_bitsim_func_t * func,
+		const uint64_t * fanin_values, std::vector<uint64_t> & slots);
+static uint64_t rand_word(uint64_t * state);
+static uint64_t bernoulli_word(double prob, uint64_t * state);
+
+static int compile_bdd(DdNode * bdd, std::unordered_map<DdNode*, int> & slots,
+		ace_bitsim_func_t * func) {
+	/* the regular constant is one */
+	if (Cudd_IsConstant(bdd)) {
+		return 0;
+	}
+
+	auto found = slots.find(bdd);
+	if (found != slots.end()) {
+		return found->second;
+	}
+
+	ace_bitsim_op_t op;
+	op.var = bdd->index;
+	op.then_slot = compile_bdd(Cudd_Regular(cuddT(bdd)), slots, func);
+	op.then_compl = Cudd_IsComplement(cuddT(bdd));
+	op.else_slot = compile_bdd(Cudd_Regular(cuddE(bdd)), slots, func);
+	op.else_compl = Cudd_IsComplement(cuddE(bdd));
+
+	func->ops.push_back(op);
+	int slot = func->ops.size();
+	slots[bdd] = slot;
+
+	return slot;
+}
+
+static void compile_node(Abc_Obj_t * obj, ace_bitsim_func_t * func) {
+	std::unordered_map<DdNode*, int> slots;
+	DdNode * bdd = (DdNode*) obj->pData;
+
+	func->out_slot = compile_bdd(Cudd_Regular(bdd), slots, func);
+	func->out_compl = Cudd_IsComplement(bdd);
+
+	for (const ace_bitsim_op_t & op : func->ops) {
+		VTR_ASSERT(op.var < Abc_ObjFaninNum(obj));
+	}
+}
+
+static uint64_t evaluate_node(const ace_bitsim_func_t * func,
+		const uint64_t * fanin_values, std::vector<uint64_t> & slots) {
+	slots.resize(func->ops.size() + 1);
+	slots[0] = ~0ULL;
+
+	for (size_t k = 0; k < func->ops.size(); k++) {
+		const ace_bitsim_op_t & op = func->ops[k];
+		uint64_t then_value = op.then_compl ? ~slots[op.then_slot] : slots[op.then_slot];
+		uint64_t else_value = op.else_compl ? ~slots[op.else_slot] : slots[op.else_slot];
+		uint64_t var_value = fanin_values[op.var];
+
+		slots[k + 1] = (var_value & then_value) | (~var_value & else_value);
+	}
+
+	return func->out_compl ? ~slots[func->out_slot] : slots[func->out_slot];
+}
+
+/* xorshift64*, the quality of rand() is not needed here */
+static uint64_t rand_word(uint64_t * state) {
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * 0x2545F4914F6CDD1DULL;
+}
+
+/* Returns a word whose bits are each 1 with probability prob (to 16 bits of precision) */
+static uint64_t bernoulli_word(double prob, uint64_t * state) {
+	if (prob <= 0.0) {
+		return 0;
+	} else if (prob >= 1.0) {
+		return ~0ULL;
+	}
+
+	/* combine random words following the binary expansion of prob, from its lsb */
+	unsigned fixed = (unsigned) (prob * 65536.0 + 0.5);
+	uint64_t word = 0;
+	for (int b = 0; b < 16; b++) {
+		uint64_t random = rand_word(state);
+		word = ((fixed >> b) & 1) ? (word | random) : (word & random);
+	}
+
+	return word;
+}
+
+int ace_bitsim_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name) {
+	Abc_Obj_t * obj;
+	Abc_Obj_t * fanin;
+	Ace_Obj_Info_t * info;
+	int i, j;
+
+	VTR_ASSERT(num_vectors > 1);
+
+	if (!Abc_NtkHasBdd(ntk)) {
+		Abc_NtkSopToBdd(ntk);
+	}
+
+	printf("Stage 1: Simulating Activities (%d vectors x %d streams)...\n",
+			num_vectors, ACE_BITSIM_LANES);
+	fflush(0);
+
+	Vec_Ptr_t * nodes_logic = Abc_NtkDfs(ntk, TRUE);
+
+	std::vector<ace_bitsim_func_t> funcs(Vec_PtrSize(nodes_logic));
+	Vec_PtrForEachEntry(Abc_Obj_t*, nodes_logic, obj, i)
+	{
+		compile_node(obj, &funcs[i]);
+	}
+
+	int num_objs = Abc_NtkObjNumMax(ntk);
+	std::vector<uint64_t> values(num_objs, 0);
+	std::vector<uint64_t> prev_values(num_objs, 0);
+	std::vector<long> num_ones(num_objs, 0);
+	std::vector<long> num_toggles(num_objs, 0);
+
+	std::vector<uint64_t> fanin_values;
+	std::vector<uint64_t> slots;
+
+	uint64_t state = ((uint64_t) rand() << 32) ^ (uint64_t) rand() ^ 0x9E3779B97F4A7C15ULL;
+
+	for (int cycle = 0; cycle < num_vectors; cycle++) {
+		/* primary inputs follow their static and switching probabilities */
+		Abc_NtkForEachPi(ntk, obj, i)
+		{
+			info = Ace_ObjInfo(obj);
+			uint64_t & value = values[Abc_ObjId(obj)];
+
+			if (cycle == 0) {
+				value = bernoulli_word(info->static_prob, &state);
+			} else {
+				double prob0to1 = ACE_P0TO1(info->static_prob, info->switch_prob);
+				double prob1to0 = ACE_P1TO0(info->static_prob, info->switch_prob);
+				value ^= (value & bernoulli_word(prob1to0, &state))
+						| (~value & bernoulli_word(prob0to1, &state));
+			}
+		}
+
+		/* latches output what they sampled at the end of the previous cycle (0 initially) */
+		Abc_NtkForEachLatch(ntk, obj, i)
+		{
+			uint64_t value = (cycle == 0) ? 0 : values[Abc_ObjId(Abc_ObjFanin0(obj))];
+			values[Abc_ObjId(obj)] = value;
+			values[Abc_ObjId(Abc_ObjFanout0(obj))] = value;
+		}
+
+		Vec_PtrForEachEntry(Abc_Obj_t*, nodes_logic, obj, i)
+		{
+			fanin_values.resize(Abc_ObjFaninNum(obj));
+			Abc_ObjForEachFanin(obj, fanin, j)
+			{
+				fanin_values[j] = values[Abc_ObjId(fanin)];
+			}
+			values[Abc_ObjId(obj)] = evaluate_node(&funcs[i], fanin_values.data(), slots);
+		}
+
+		Abc_NtkForEachPo(ntk, obj, i)
+		{
+			values[Abc_ObjId(obj)] = values[Abc_ObjId(Abc_ObjFanin0(obj))];
+		}
+		Abc_NtkForEachLatchInput(ntk, obj, i)
+		{
+			values[Abc_ObjId(obj)] = values[Abc_ObjId(Abc_ObjFanin0(obj))];
+		}
+
+		Abc_NtkForEachObj(ntk, obj, i)
+		{
+			int id = Abc_ObjId(obj);
+			num_ones[id] += __builtin_popcountll(values[id]);
+			if (cycle > 0) {
+				num_toggles[id] += __builtin_popcountll(values[id] ^ prev_values[id]);
+			}
+		}
+		prev_values = values;
+	}
+
+	double num_samples = (double) num_vectors * ACE_BITSIM_LANES;
+	double num_transitions = (double) (num_vectors - 1) * ACE_BITSIM_LANES;
+
+	Abc_NtkForEachObj(ntk, obj, i)
+	{
+		info = Ace_ObjInfo(obj);
+		int id = Abc_ObjId(obj);
+
+		info->static_prob = num_ones[id] / num_samples;
+		info->switch_prob = num_toggles[id] / num_transitions;
+		VTR_ASSERT(info->static_prob >= 0.0 && info->static_prob <= 1.0);
+		VTR_ASSERT(info->switch_prob >= 0.0 && info->switch_prob <= 1.0);
+
+		if (Abc_ObjIsPi(obj) && strcmp(Abc_ObjName(obj), clk_name) == 0) {
+			info->switch_act = 2;
+			info->switch_prob = 1;
+			info->static_prob = 0.5;
+		} else {
+			info->switch_act = info->switch_prob;
+		}
+		info->status = ACE_SIM;
+	}
+
+	Vec_PtrFree(nodes_logic);
+
+	return 0;
+}
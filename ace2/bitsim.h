@@ -0,0 +1,11 @@
+#ifndef __ACE_BITSIM_H__
+#define __ACE_BITSIM_H__
+
+#include "ace.h"
+
+/* Number of independent simulation streams evaluated at once, one per bit of a word */
+#define ACE_BITSIM_LANES 64
+
+int ace_bitsim_activity(Abc_Ntk_t * ntk, int num_vectors, char * clk_name);
+
+#endif
@@ -111,9 +111,12 @@ bool Container::addConnectionHash(QString start, QString end)
 //at the moment wire crossing is not considered
 void Container::arrangeContainer()
 {
+    //moving every unit would update the scene index for each of them, rebuild it once instead
+    myScene->setItemIndexMethod(QGraphicsScene::NoIndex);
     computeLayers();
     spreadLayers();
     myScene->setSceneRect(0,0,1000.0+400*maxlayer+maxcountPerLayer*50,1000.0+400*maxcountPerLayer);
+    myScene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
 }
 
 /*---------------------------------------------------------------------------------------------
@@ -243,10 +246,12 @@ void Container::copySimCyclesIntoNodes()
 void Container::computeLayers()
 {
     QQueue<LogicUnit*> nodequeue;
+    QSet<LogicUnit*> queuedset; //the units in nodequeue (QQueue::contains is a linear search)
     QHash<QString, LogicUnit*> donehashtable;
     for (int i = 0; i < myOdin->blifexplorer_netlist->num_top_input_nodes; i++){
         QString name = myOdin->blifexplorer_netlist->top_input_nodes[i]->name;
         nodequeue.enqueue(getReferenceToUnit(name));
+        queuedset.insert(nodequeue.last());
     }
 
     // Enqueue constant nodes.
@@ -257,6 +262,7 @@ void Container::computeLayers()
     for (int i = 0; i < num_constant_nodes; i++){
         QString name = constant_nodes[i]->name;
         nodequeue.enqueue(getReferenceToUnit(name));
+        queuedset.insert(nodequeue.last());
     }
 
     // go through the netlist. While doing so
@@ -265,6 +271,7 @@ void Container::computeLayers()
     int maxparent;
     while(!nodequeue.isEmpty()){
         node = nodequeue.dequeue();
+        queuedset.remove(node);
         //remember name of the node so it is not processed again
         QString nodeName(node->getName());
         //assign layer
@@ -290,27 +297,25 @@ void Container::computeLayers()
             QString kidName(nodeKid->name);
             LogicUnit* kidUnit = getReferenceToUnit(kidName);
 
-            bool inQueue = nodequeue.contains(kidUnit);
+            bool inQueue = queuedset.contains(kidUnit);
             bool done = donehashtable.contains(kidName);
 
             if(!inQueue && !done && parentsDone(kidUnit,donehashtable)){
                 nodequeue.enqueue(kidUnit);
+                queuedset.insert(kidUnit);
             }
         }
     }
     maxlayer++;
     /*Locate all outputs at the very end of the graph*/
     QHash<QString, LogicUnit*>::const_iterator blockIterator = unithashtable.constBegin();
-    for(int i = 0; i<=maxlayer;i++){
-        blockIterator = unithashtable.constBegin();
-        while(blockIterator != unithashtable.constEnd()){
-            LogicUnit* actUnit = blockIterator.value();
-            if(actUnit->getName().contains("top^out")){
-                actUnit->setLayer(maxlayer);
-            }
-
-            ++blockIterator;
+    while(blockIterator != unithashtable.constEnd()){
+        LogicUnit* actUnit = blockIterator.value();
+        if(actUnit->getName().contains("top^out")){
+            actUnit->setLayer(maxlayer);
         }
+
+        ++blockIterator;
     }
 
 }
@@ -320,28 +325,32 @@ void Container::computeLayers()
  *-------------------------------------------------------------------------------------------*/
 void Container::spreadLayers()
 {
+    //bucket the visible units by layer in a single pass over all units,
+    //in the order the layers used to be filled in
+    QVector<QList<LogicUnit*> > layers(maxlayer+1);
     QHash<QString, LogicUnit*>::const_iterator blockIterator = unithashtable.constBegin();
+    while(blockIterator != unithashtable.constEnd()){
+        LogicUnit* actUnit = blockIterator.value();
+        int layer = actUnit->getLayer();
+        if(actUnit->isVisible() && layer >= 0 && layer <= maxlayer){
+            layers[layer].append(actUnit);
+        }
+        ++blockIterator;
+    }
+
     LogicUnit* lastUnit = NULL;
     int counter = 0;
     int offset = 200;
 
     for(int i = 0; i<=maxlayer;i++){
-        blockIterator = unithashtable.constBegin();
-
-        while(blockIterator != unithashtable.constEnd()){
-            LogicUnit* actUnit = blockIterator.value();
-            if(actUnit->isVisible()){
-                if(actUnit->getLayer()== i){
-                    actUnit->setPos(offset+15*counter,100.0+200*counter);
-                    actUnit->updateWires();
-                    lastUnit = actUnit;
-                    counter++;
-                }
-                if(maxcountPerLayer < counter){
-                    maxcountPerLayer = counter;
-                }
+        foreach(LogicUnit* actUnit, layers[i]){
+            actUnit->setPos(offset+15*counter,100.0+200*counter);
+            actUnit->updateWires();
+            lastUnit = actUnit;
+            counter++;
+            if(maxcountPerLayer < counter){
+                maxcountPerLayer = counter;
             }
-            ++blockIterator;
         }
         if(lastUnit!=NULL){
             offset = lastUnit->x()+200;
@@ -786,11 +795,14 @@ int Container::readInFileOdinOnly(){
     //let odin ii parse in the file and return a hashtable of all nodes in the netlist
     startOdin();
     fprintf(stdout, "VISUALIZATION: Creating nodes...\n");
+    //the items are indexed once created, rather than one by one
+    myScene->setItemIndexMethod(QGraphicsScene::NoIndex);
     //iterate through the hashtable and create all nodes based on the type
     myItemcount = createNodesFromOdin();
     fprintf(stdout, "VISUALIZATION: Creating Node connections...\n");
      //create connections
     cons = createConnectionsFromOdinIterate();
+    myScene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
      if(myItemcount <= 0)
          return -1;
 
@@ -978,24 +990,12 @@ void Container::showSimulationStep(int cycle)
  *-------------------------------------------------------------------------------------------*/
 Wire *Container::getConnectionBetween(QString nodeName, QString kidName)
 {
-    Wire* result = NULL;
-    QHash<QString, Wire *> wires;
-    QHash<QString, LogicUnit *> hash =unithashtable;
-    QHash<QString, LogicUnit *>::const_iterator blockIterator = hash.constBegin();
-
-     while(blockIterator != unithashtable.constEnd()){
-         QString actName = blockIterator.key();
-         if(actName.compare(nodeName)==0){
-             LogicUnit* actUnit = blockIterator.value();
-             wires = actUnit->getOutConsHash();
-         }
-         ++blockIterator;
-     }
-
-     if(wires.contains(kidName)){
-        result = wires.value(kidName);
-     }
-     return result;
+    //the connections are looked up right after they are created, so the
+    //search from the most recent connection of the unit is short
+    LogicUnit* actUnit = unithashtable.value(nodeName, NULL);
+    if(actUnit == NULL)
+        return NULL;
+    return actUnit->getOutConTo(kidName);
 }
 
 QList<LogicUnit *> Container::getClocks()
@@ -1044,17 +1044,13 @@ void Container::expandCollapse(QString modulename)
     //toggle module visibility
     module->setVisible(!module->isVisible());
 
-    QHash<QString, LogicUnit *> hash =unithashtable;
-    QHash<QString, LogicUnit *>::const_iterator blockIterator = hash.constBegin();
-
-     while(blockIterator != unithashtable.constEnd()){
-         LogicUnit* actNode = blockIterator.value();
-         if(actNode->hasModule &&
-                 actNode->getModule()->getName().compare(modulename)==0){
-            actNode->setVisible(makeAllVisible);
-         }
-         ++blockIterator;
-     }
+    //only the nodes of the module change
+    foreach(LogicUnit* actNode, module->getModuleNodes()){
+        if(actNode->hasModule &&
+                actNode->getModule()->getName().compare(modulename)==0){
+           actNode->setVisible(makeAllVisible);
+        }
+    }
      arrangeContainer();
 
 
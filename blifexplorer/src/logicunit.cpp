@@ -146,14 +146,20 @@ void LogicUnit::addConnection(Wire *wire)
         //increase the input count if this instance is the ending point
         if(wire->endUnit()->getName().compare(myName) == 0){
             myIncount++;
+            //only the inputs are spread over the new input count
             foreach (Wire *oldwire, wires) {
-                oldwire->setMaxNumber(myIncount);
+                if(oldwire->endUnit() == this)
+                    oldwire->setMaxNumber(myIncount);
             }
             wire->setNumber(myIncount);
             wire->setMaxNumber(myIncount);
+            wires.append(wire);
+        }else{
+            //an output does not move the other wires, so only the new one is placed.
+            //(Updating all of them made connecting high fanout nodes quadratic.)
+            wires.append(wire);
+            wire->updatePosition();
         }
-        wires.append(wire);
-        itemChange(QGraphicsPolygonItem::ItemPositionChange,QVariant(0));
     }else{//I am a Module
         if(wire->startUnit()->hasModule){
             //I am the start module
@@ -289,82 +295,53 @@ QVariant LogicUnit::itemChange(GraphicsItemChange change,
 /*---------------------------------------------------------------------------------------------
  * (function: paint)
  *-------------------------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------------------------
+ * (function: typeImage)
+ *-------------------------------------------------------------------------------------------*/
+//The picture of a unit type, decoded once rather than on every paint
+static const QImage& typeImage(LogicUnit::UnitType unitType)
+{
+    static QHash<int, QImage> images;
+    static const QImage noImage;
+
+    const char* file;
+    switch (unitType) {
+    case LogicUnit::And:        file = ":/images/nodeTypes/AND.png"; break;
+    case LogicUnit::Nand:       file = ":/images/nodeTypes/NAND.png"; break;
+    case LogicUnit::Or:         file = ":/images/nodeTypes/OR.png"; break;
+    case LogicUnit::Nor:        file = ":/images/nodeTypes/NOR.png"; break;
+    case LogicUnit::Xor:        file = ":/images/nodeTypes/XOR.png"; break;
+    case LogicUnit::Xnor:       file = ":/images/nodeTypes/XNOR.png"; break;
+    case LogicUnit::Not:        file = ":/images/nodeTypes/NOT.png"; break;
+    case LogicUnit::MUX:        file = ":/images/nodeTypes/MUX.png"; break;
+    case LogicUnit::ADDER_FUNC: file = ":/images/nodeTypes/ADDER_FUNC.png"; break;
+    case LogicUnit::CARRY_FUNC: file = ":/images/nodeTypes/CARRY_FUNC.png"; break;
+    case LogicUnit::MEMORY:     file = ":/images/nodeTypes/Hmemory.png"; break;
+    case LogicUnit::Module:     file = ":/images/nodeTypes/module.png"; break;
+    case LogicUnit::MINUS:      file = ":/images/nodeTypes/Hminus.png"; break;
+    case LogicUnit::ADD:        file = ":/images/nodeTypes/Hadd.png"; break;
+    case LogicUnit::MULTIPLY:   file = ":/images/nodeTypes/Hmult.png"; break;
+    default:
+        return noImage;
+    }
+
+    if(!images.contains(unitType))
+        images.insert(unitType, QImage(file));
+    return images[unitType];
+}
+
 void LogicUnit::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget){
      QGraphicsPolygonItem::paint(painter,option,widget);
-QImage image;
 
-//If a picture defines the shape, use the fullrect and draw invisible borders
+    //Zoomed out far enough for a unit to only be a few pixels, the outline is all that can be seen
+    qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if(levelOfDetail < 0.15)
+        return;
 
-    switch (myUnitType) {
-    case And:
-        image.load(":/images/nodeTypes/AND.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case Nand:
-        image.load(":/images/nodeTypes/NAND.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case Or:
-        image.load(":/images/nodeTypes/OR.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case Nor:
-        image.load(":/images/nodeTypes/NOR.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case Xor:
-        image.load(":/images/nodeTypes/XOR.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case Xnor:
-        image.load(":/images/nodeTypes/XNOR.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case Not:
-        image.load(":/images/nodeTypes/NOT.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case MUX:
-        image.load(":/images/nodeTypes/MUX.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case ADDER_FUNC:
-        image.load(":/images/nodeTypes/ADDER_FUNC.png");
-        painter->drawImage(boundingRect(),image);
-            break;
-    case CARRY_FUNC:
-        image.load(":/images/nodeTypes/CARRY_FUNC.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case MEMORY:
-        image.load(":/images/nodeTypes/Hmemory.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case Module:
-        image.load(":/images/nodeTypes/module.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case MINUS:
-        image.load(":/images/nodeTypes/Hminus.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case ADD:
-        image.load(":/images/nodeTypes/Hadd.png");
-        painter->drawImage(boundingRect(),image);
-        break;
-    case MULTIPLY:
-        image.load(":/images/nodeTypes/Hmult.png");
+//If a picture defines the shape, use the fullrect and draw invisible borders
+    const QImage& image = typeImage(myUnitType);
+    if(!image.isNull())
         painter->drawImage(boundingRect(),image);
-        break;
-    case LogicGate:
-    case Input:
-    case Output:
-    case Latch:
-    case Clock:
-    default:
-        break;
-    }
-
 
     painter->setFont(QFont("Times", 9));
 
@@ -398,6 +375,20 @@ QList<Wire *> LogicUnit::getOutCons()
    return outgoing;
 }
 
+/*---------------------------------------------------------------------------------------------
+ * (function: getOutConTo)
+ *-------------------------------------------------------------------------------------------*/
+//The outgoing connection to the unit named kidName (most recent first), or NULL
+Wire * LogicUnit::getOutConTo(QString kidName)
+{
+    for(int i = wires.count()-1; i >= 0; i--){
+        Wire *wire = wires.at(i);
+        if(wire->startUnit() == this && wire->endUnit()->getName().compare(kidName)==0)
+            return wire;
+    }
+    return NULL;
+}
+
 /*---------------------------------------------------------------------------------------------
  * (function: getOutConsHash)
  *-------------------------------------------------------------------------------------------*/
@@ -631,6 +622,11 @@ LogicUnit * LogicUnit::getModule()
     return moduleViewPartners.at(0);
 }
 
+QList<LogicUnit*> LogicUnit::getModuleNodes()
+{
+    return moduleViewPartners;
+}
+
 int LogicUnit::getMaxOutNumber()
 {
     return outNodes.count();
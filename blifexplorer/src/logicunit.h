@@ -79,6 +79,7 @@ public:
     QString getName();
     QList<Wire *> getOutCons();
     QHash<QString, Wire *> getOutConsHash();
+    Wire* getOutConTo(QString kidName);
     QList<Wire *> getAllCons();
     void setLayer(int layer);
     int getLayer();
@@ -99,6 +100,7 @@ public:
     void addPartner(LogicUnit* partner);
     bool hasModule;
     LogicUnit* getModule();
+    QList<LogicUnit*> getModuleNodes();
     int getMaxOutNumber();
     int getMaxNumber();
     void showActivity();
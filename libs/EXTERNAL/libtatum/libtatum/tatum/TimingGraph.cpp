@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <map>
@@ -8,6 +9,14 @@
 #include "tatum/error.hpp"
 #include "tatum/TimingGraph.hpp"
 
+#if defined(TATUM_USE_TBB)
+# include <numeric>
+# include <tbb/blocked_range.h>
+# include <tbb/enumerable_thread_specific.h>
+# include <tbb/parallel_for.h>
+# include <tbb/parallel_sort.h>
+#endif
+
 
 
 namespace tatum {
@@ -175,7 +184,22 @@ LevelId TimingGraph::node_level(const NodeId node) const {
 }
 
 
+void TimingGraph::reserve(size_t num_nodes, size_t num_edges) {
+    node_ids_.reserve(num_nodes);
+    node_types_.reserve(num_nodes);
+    node_in_edges_.reserve(num_nodes);
+    node_out_edges_.reserve(num_nodes);
+
+    edge_ids_.reserve(num_edges);
+    edge_types_.reserve(num_edges);
+    edge_src_nodes_.reserve(num_edges);
+    edge_sink_nodes_.reserve(num_edges);
+    edges_disabled_.reserve(num_edges);
+}
+
 NodeId TimingGraph::add_node(const NodeType type) {
+    expand_adjacency();
+
     //Invalidate the levelization
     is_levelized_ = false;
 
@@ -204,6 +228,8 @@ EdgeId TimingGraph::add_edge(const EdgeType type, const NodeId src_node, const N
     TATUM_ASSERT(valid_node_id(src_node));
     TATUM_ASSERT(valid_node_id(sink_node));
 
+    expand_adjacency();
+
     //Invalidate the levelization
     is_levelized_ = false;
 
@@ -236,6 +262,9 @@ EdgeId TimingGraph::add_edge(const EdgeType type, const NodeId src_node, const N
 void TimingGraph::remove_node(const NodeId node_id) {
     TATUM_ASSERT(valid_node_id(node_id));
 
+    //Before iterating over the node's edges, since removing them expands the adjacency
+    expand_adjacency();
+
     //Invalidate the levelization
     is_levelized_ = false;
 
@@ -259,6 +288,8 @@ void TimingGraph::remove_node(const NodeId node_id) {
 void TimingGraph::remove_edge(const EdgeId edge_id) {
     TATUM_ASSERT(valid_edge_id(edge_id));
 
+    expand_adjacency();
+
     //Invalidate the levelization
     is_levelized_ = false;
 
@@ -334,32 +365,36 @@ void TimingGraph::force_levelize() {
     //Also records primary outputs
 
     //Clear any previous levelization
-    level_nodes_.clear();
+    level_nodes_csr_.clear();
+    level_node_offsets_.clear();
     level_ids_.clear();
     node_levels_.clear();
     primary_inputs_.clear();
     logical_outputs_.clear();
 
+    //Nodes in each level, stored contiguously once levelization is complete
+    tatum::util::linear_map<LevelId,std::vector<NodeId>> nodes_by_level;
+
     //Allocate space for the first level
-    level_nodes_.resize(1);
+    nodes_by_level.resize(1);
 
     //Copy the number of input edges per-node
     //These will be decremented to know when all a node's upstream parents have been
     //placed in a previous level (indicating that the node goes in the current level)
     //
     //Also initialize the first level (nodes with no fanin)
-    std::vector<int> node_fanin_remaining(nodes().size());
+    std::vector<std::atomic<int>> node_fanin_remaining(nodes().size());
     for(NodeId node_id : nodes()) {
         size_t node_fanin = 0;
         for(EdgeId edge : node_in_edges(node_id)) {
             if(edge_disabled(edge)) continue;
             ++node_fanin;
         }
-        node_fanin_remaining[size_t(node_id)] = node_fanin;
+        node_fanin_remaining[size_t(node_id)].store(node_fanin, std::memory_order_relaxed);
 
         //Initialize the first level
         if(node_fanin == 0) {
-            level_nodes_[LevelId(0)].push_back(node_id);
+            nodes_by_level[LevelId(0)].push_back(node_id);
 
             if (node_type(node_id) == NodeType::SOURCE) {
                 //We require that all primary inputs (i.e. top-level circuit inputs) to
@@ -381,48 +416,65 @@ void TimingGraph::force_levelize() {
 
     std::vector<NodeId> last_level;
 
+#if defined(TATUM_USE_TBB)
+    LevelizeFrontierState frontier_state;
+#endif
+
     bool inserted_node_in_level = true;
     while(inserted_node_in_level) { //If nothing was inserted we are finished
         inserted_node_in_level = false;
 
-        for(const NodeId node_id : level_nodes_[LevelId(level_idx)]) {
-            //Inspect the fanout
-            for(EdgeId edge_id : node_out_edges(node_id)) {
-                if(edge_disabled(edge_id)) continue;
-
-                NodeId sink_node = edge_sink_node(edge_id);
-
-                //Decrement the fanin count
-                TATUM_ASSERT(node_fanin_remaining[size_t(sink_node)] > 0);
-                node_fanin_remaining[size_t(sink_node)]--;
-
-                //Add to the next level if all fanin has been seen
-                if(node_fanin_remaining[size_t(sink_node)] == 0) {
-
-                    if (node_out_edges(sink_node).size() != 0) {
-                        //Place into next level
-                        
-                        //Ensure there is space by allocating the next level if required
-                        level_nodes_.resize(level_idx+2);
-
-                        //Add the node
-                        level_nodes_[LevelId(level_idx+1)].push_back(sink_node);
-
-                        inserted_node_in_level = true;
-                    } else {
-                        //No fan-out
-                        //
-                        //We choose to put these nodes into the *last* level,
-                        //since it makes it easier to walk back from them in the
-                        //required time traversal
-                        TATUM_ASSERT(node_out_edges(sink_node).size() == 0);
-                        
-                        last_level.push_back(sink_node);
+        //Nodes whose fanin have all been seen, in the order they were found
+        std::vector<NodeId> ready_nodes;
+
+#if defined(TATUM_USE_TBB)
+        if (nodes_by_level[LevelId(level_idx)].size() >= PARALLEL_LEVELIZE_MIN_NODES) {
+            ready_nodes = levelize_frontier_parallel(nodes_by_level[LevelId(level_idx)], level_idx, node_fanin_remaining, frontier_state);
+        } else
+#endif
+        {
+            for(const NodeId node_id : nodes_by_level[LevelId(level_idx)]) {
+                //Inspect the fanout
+                for(EdgeId edge_id : node_out_edges(node_id)) {
+                    if(edge_disabled(edge_id)) continue;
+
+                    NodeId sink_node = edge_sink_node(edge_id);
+
+                    //Decrement the fanin count
+                    int fanin_remaining = node_fanin_remaining[size_t(sink_node)].fetch_sub(1, std::memory_order_relaxed) - 1;
+                    TATUM_ASSERT(fanin_remaining >= 0);
+
+                    //Add to the next level if all fanin has been seen
+                    if(fanin_remaining == 0) {
+                        ready_nodes.push_back(sink_node);
                     }
                 }
             }
         }
 
+        for (NodeId sink_node : ready_nodes) {
+            if (node_out_edges(sink_node).size() != 0) {
+                //Place into next level
+                
+                //Ensure there is space by allocating the next level if required
+                nodes_by_level.resize(level_idx+2);
+
+                //Add the node
+                nodes_by_level[LevelId(level_idx+1)].push_back(sink_node);
+
+                inserted_node_in_level = true;
+            } else {
+                //No fan-out
+                //
+                //We choose to put these nodes into the *last* level,
+                //since it makes it easier to walk back from them in the
+                //required time traversal
+                TATUM_ASSERT(node_out_edges(sink_node).size() == 0);
+                
+                last_level.push_back(sink_node);
+            }
+        }
+
         if(inserted_node_in_level) {
             level_idx++;
             level_ids_.emplace_back(level_idx);
@@ -430,7 +482,7 @@ void TimingGraph::force_levelize() {
     }
 
     //Add the last level to the end of the levelization
-    level_nodes_.emplace_back(last_level);
+    nodes_by_level.emplace_back(last_level);
     level_idx++;
     level_ids_.emplace_back(level_idx);
 
@@ -442,18 +494,108 @@ void TimingGraph::force_levelize() {
     };
     std::copy_if(last_level.begin(), last_level.end(), std::back_inserter(logical_outputs_), is_sink);
 
-    //Build the reverse node-to-level look-up
+    //Build the reverse node-to-level look-up, and store the levels contiguously
     node_levels_.resize(nodes().size());
+    level_nodes_csr_.reserve(nodes().size());
+    level_node_offsets_.reserve(level_ids_.size() + 1);
     for (LevelId level : level_ids_) {
-        for(NodeId node : level_nodes_[level]) {
+        level_node_offsets_.push_back(level_nodes_csr_.size());
+        for(NodeId node : nodes_by_level[level]) {
             node_levels_[node] = level;
+            level_nodes_csr_.push_back(node);
         }
     }
+    level_node_offsets_.push_back(level_nodes_csr_.size());
 
     //Mark the levelization as valid
     is_levelized_ = true;
 }
 
+#if defined(TATUM_USE_TBB)
+//Walks the fanout of frontier (the nodes of level level_idx) concurrently, decrementing the
+//remaining fanin counts of their sinks, and returns the sinks whose fanin have all been seen.
+//
+//The serial walk finds a node when its last fanin edge is seen, visiting the frontier
+//nodes (and their out edges) in order. So the newly found nodes are sorted by the
+//position of their last fanin edge from the frontier, making the result identical
+//to the serial walk.
+std::vector<NodeId> TimingGraph::levelize_frontier_parallel(const std::vector<NodeId>& frontier,
+                                                            int level_idx,
+                                                            std::vector<std::atomic<int>>& node_fanin_remaining,
+                                                            LevelizeFrontierState& state) const {
+    if (state.edge_out_index.empty()) {
+        //Initialize on first use
+        state.edge_out_index.resize(edges().size());
+        tbb::parallel_for(size_t(0), nodes().size(), [&](size_t inode) {
+            uint32_t out_index = 0;
+            for (EdgeId edge_id : node_out_edges(NodeId(inode))) {
+                state.edge_out_index[size_t(edge_id)] = out_index++;
+            }
+        });
+        state.node_frontier_level.resize(nodes().size(), -1);
+        state.node_frontier_index.resize(nodes().size());
+    }
+
+    tbb::parallel_for(size_t(0), frontier.size(), [&](size_t inode) {
+        state.node_frontier_level[size_t(frontier[inode])] = level_idx;
+        state.node_frontier_index[size_t(frontier[inode])] = inode;
+    });
+
+    tbb::enumerable_thread_specific<std::vector<NodeId>> thread_ready_nodes;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, frontier.size()), [&](const tbb::blocked_range<size_t>& range) {
+        auto& ready_nodes = thread_ready_nodes.local();
+        for (size_t inode = range.begin(); inode != range.end(); ++inode) {
+            for(EdgeId edge_id : node_out_edges(frontier[inode])) {
+                if(edge_disabled(edge_id)) continue;
+
+                NodeId sink_node = edge_sink_node(edge_id);
+
+                int fanin_remaining = node_fanin_remaining[size_t(sink_node)].fetch_sub(1, std::memory_order_relaxed) - 1;
+                TATUM_ASSERT(fanin_remaining >= 0);
+
+                if(fanin_remaining == 0) {
+                    ready_nodes.push_back(sink_node);
+                }
+            }
+        }
+    });
+
+    std::vector<NodeId> ready_nodes;
+    for (const auto& nodes : thread_ready_nodes) {
+        ready_nodes.insert(ready_nodes.end(), nodes.begin(), nodes.end());
+    }
+
+    //Position of each node's last fanin edge from the frontier, in serial walk order
+    std::vector<uint64_t> ready_node_keys(ready_nodes.size(), 0);
+    tbb::parallel_for(size_t(0), ready_nodes.size(), [&](size_t inode) {
+        uint64_t key = 0;
+        for (EdgeId edge_id : node_in_edges(ready_nodes[inode])) {
+            if (edge_disabled(edge_id)) continue;
+
+            size_t src_node = size_t(edge_src_node(edge_id));
+            if (state.node_frontier_level[src_node] != level_idx) continue;
+
+            uint64_t edge_key = (uint64_t(state.node_frontier_index[src_node]) << 32) | state.edge_out_index[size_t(edge_id)];
+            key = std::max(key, edge_key);
+        }
+        ready_node_keys[inode] = key;
+    });
+
+    std::vector<size_t> order(ready_nodes.size());
+    std::iota(order.begin(), order.end(), 0);
+    tbb::parallel_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return ready_node_keys[lhs] < ready_node_keys[rhs];
+    });
+
+    std::vector<NodeId> sorted_ready_nodes;
+    sorted_ready_nodes.reserve(ready_nodes.size());
+    for (size_t inode : order) {
+        sorted_ready_nodes.push_back(ready_nodes[inode]);
+    }
+    return sorted_ready_nodes;
+}
+#endif
+
 bool TimingGraph::validate() const {
     bool valid = true;
     valid &= validate_sizes();
@@ -474,9 +616,64 @@ GraphIdMaps TimingGraph::optimize_layout() {
 
     levelize();
 
+    //The graph is typically final once its layout is optimized
+    compact_adjacency();
+
     return {node_id_map, edge_id_map};
 }
 
+void TimingGraph::compact_adjacency() {
+    if (adjacency_compacted_) return;
+
+    auto compact = [this](tatum::util::linear_map<NodeId,std::vector<EdgeId>>& node_edges,
+                          std::vector<EdgeId>& edges_csr,
+                          std::vector<size_t>& edge_offsets) {
+        size_t num_refs = 0;
+        for (const auto& edges_ref : node_edges) {
+            num_refs += edges_ref.size();
+        }
+
+        edges_csr.clear();
+        edges_csr.reserve(num_refs);
+        edge_offsets.clear();
+        edge_offsets.reserve(nodes().size() + 1);
+        for (const auto& edges_ref : node_edges) {
+            edge_offsets.push_back(edges_csr.size());
+            edges_csr.insert(edges_csr.end(), edges_ref.begin(), edges_ref.end());
+        }
+        edge_offsets.push_back(edges_csr.size());
+
+        //Release the per-node vectors
+        node_edges = tatum::util::linear_map<NodeId,std::vector<EdgeId>>();
+    };
+
+    compact(node_in_edges_, in_edges_csr_, in_edge_offsets_);
+    compact(node_out_edges_, out_edges_csr_, out_edge_offsets_);
+    adjacency_compacted_ = true;
+}
+
+void TimingGraph::expand_adjacency() {
+    if (!adjacency_compacted_) return;
+
+    auto expand = [this](std::vector<EdgeId>& edges_csr,
+                         std::vector<size_t>& edge_offsets,
+                         tatum::util::linear_map<NodeId,std::vector<EdgeId>>& node_edges) {
+        node_edges.clear();
+        node_edges.reserve(nodes().size());
+        for (size_t inode = 0; inode + 1 < edge_offsets.size(); ++inode) {
+            node_edges.emplace_back(edges_csr.begin() + edge_offsets[inode],
+                                    edges_csr.begin() + edge_offsets[inode + 1]);
+        }
+
+        edges_csr = std::vector<EdgeId>();
+        edge_offsets = std::vector<size_t>();
+    };
+
+    expand(in_edges_csr_, in_edge_offsets_, node_in_edges_);
+    expand(out_edges_csr_, out_edge_offsets_, node_out_edges_);
+    adjacency_compacted_ = false;
+}
+
 tatum::util::linear_map<EdgeId,EdgeId> TimingGraph::optimize_edge_layout() const {
     //Make all edges in a level be contiguous in memory
 
@@ -549,6 +746,7 @@ tatum::util::linear_map<NodeId,NodeId> TimingGraph::optimize_node_layout() const
 }
 
 void TimingGraph::remap_nodes(const tatum::util::linear_map<NodeId,NodeId>& node_id_map) {
+    expand_adjacency();
     is_levelized_ = false;
 
     //Update values
@@ -563,6 +761,7 @@ void TimingGraph::remap_nodes(const tatum::util::linear_map<NodeId,NodeId>& node
 }
 
 void TimingGraph::remap_edges(const tatum::util::linear_map<EdgeId,EdgeId>& edge_id_map) {
+    expand_adjacency();
     is_levelized_ = false;
 
     //Update values
@@ -595,8 +794,8 @@ bool TimingGraph::valid_level_id(const LevelId level_id) const {
 
 bool TimingGraph::validate_sizes() const {
     if (   node_ids_.size() != node_types_.size()
-        || node_ids_.size() != node_in_edges_.size()
-        || node_ids_.size() != node_out_edges_.size()
+        || node_ids_.size() != (adjacency_compacted_ ? in_edge_offsets_.size() - 1 : node_in_edges_.size())
+        || node_ids_.size() != (adjacency_compacted_ ? out_edge_offsets_.size() - 1 : node_out_edges_.size())
         || node_ids_.size() != node_levels_.size()) {
         throw tatum::Error("Inconsistent node attribute sizes");
     }
@@ -608,7 +807,7 @@ bool TimingGraph::validate_sizes() const {
         throw tatum::Error("Inconsistent edge attribute sizes");
     }
 
-    if (level_ids_.size() != level_nodes_.size()) {
+    if (level_node_offsets_.size() != (level_ids_.empty() ? 0 : level_ids_.size() + 1)) {
         throw tatum::Error("Inconsistent level attribute sizes");
     }
 
@@ -622,7 +821,7 @@ bool TimingGraph::validate_values() const {
             throw tatum::Error("Invalid node id", node_id);
         }
 
-        for(EdgeId edge_id : node_in_edges_[node_id]) {
+        for(EdgeId edge_id : node_in_edges(node_id)) {
             if(!valid_edge_id(edge_id)) {
                 throw tatum::Error("Invalid node-in-edge reference", node_id, edge_id);
             }
@@ -632,7 +831,7 @@ bool TimingGraph::validate_values() const {
                 throw tatum::Error("Mismatched edge-sink/node-in-edge reference", node_id, edge_id);
             }
         }
-        for(EdgeId edge_id : node_out_edges_[node_id]) {
+        for(EdgeId edge_id : node_out_edges(node_id)) {
             if(!valid_edge_id(edge_id)) {
                 throw tatum::Error("Invalid node-out-edge reference", node_id, edge_id);
             }
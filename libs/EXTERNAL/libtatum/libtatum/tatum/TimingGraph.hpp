@@ -52,7 +52,19 @@
  * and optimize_node_layout() member functions.  In the future (particularily if incremental modification
  * support is added), it may be a good idea apply these modifications automatically as needed.
  *
+ * Compact Adjacency
+ * ===================
+ * While the graph is being built each node keeps its in/out edges in its own vector, which is cheap
+ * to modify. Once the layout is optimized (see optimize_layout()) the graph is typically no longer
+ * modified, so the adjacency is compacted into a Compressed Sparse Row (CSR) form: the edges of
+ * all nodes are stored contiguously (in node order), along with the offset of each node's first
+ * edge. The levels are always stored this way. Traversals then scan memory sequentially, and the
+ * per-node allocations are released. Modifying the graph afterwards transparently expands the
+ * adjacency back to per-node vectors.
+ *
  */
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <limits>
@@ -86,11 +98,23 @@ class TimingGraph {
 
         ///\param id The node id
         ///\returns A range of all out-going edges the node drives
-        edge_range node_out_edges(const NodeId id) const { return tatum::util::make_range(node_out_edges_[id].begin(), node_out_edges_[id].end()); }
+        edge_range node_out_edges(const NodeId id) const {
+            if (adjacency_compacted_) {
+                return tatum::util::make_range(out_edges_csr_.begin() + out_edge_offsets_[size_t(id)],
+                                               out_edges_csr_.begin() + out_edge_offsets_[size_t(id) + 1]);
+            }
+            return tatum::util::make_range(node_out_edges_[id].begin(), node_out_edges_[id].end());
+        }
 
         ///\param id The node id
         ///\returns A range of all in-coming edges the node drives
-        edge_range node_in_edges(const NodeId id) const { return tatum::util::make_range(node_in_edges_[id].begin(), node_in_edges_[id].end()); }
+        edge_range node_in_edges(const NodeId id) const {
+            if (adjacency_compacted_) {
+                return tatum::util::make_range(in_edges_csr_.begin() + in_edge_offsets_[size_t(id)],
+                                               in_edges_csr_.begin() + in_edge_offsets_[size_t(id) + 1]);
+            }
+            return tatum::util::make_range(node_in_edges_[id].begin(), node_in_edges_[id].end());
+        }
 
         ///\param id The Node id
         ///\returns The number of active (undisabled) edges terminating at the node
@@ -143,8 +167,8 @@ class TimingGraph {
         ///\see levelize()
         node_range level_nodes(const LevelId level_id) const { 
             TATUM_ASSERT_MSG(is_levelized_, "Timing graph must be levelized");
-            return tatum::util::make_range(level_nodes_[level_id].begin(),
-                                           level_nodes_[level_id].end()); 
+            return tatum::util::make_range(level_nodes_csr_.begin() + level_node_offsets_[size_t(level_id)],
+                                           level_nodes_csr_.begin() + level_node_offsets_[size_t(level_id) + 1]);
         }
 
         ///\pre The graph must be levelized.
@@ -199,6 +223,10 @@ class TimingGraph {
         ///\warning Graph will likely need to be re-levelized after modification
         NodeId add_node(const NodeType type);
 
+        ///Reserves space for the given number of nodes and edges
+        ///(e.g. before adding a known number of them)
+        void reserve(size_t num_nodes, size_t num_edges);
+
         ///Adds an edge to the timing graph
         ///\param type The edge's type
         ///\param src_node The node id of the edge's driving node
@@ -240,10 +268,18 @@ class TimingGraph {
          * Memory layout optimization operations
          */
         ///Optimizes the graph's internal memory layout for better performance
+        ///\post The node adjacency is compacted (see compact_adjacency())
         ///\warning Old IDs will be invalidated
         ///\returns The mapping from old to new IDs
         GraphIdMaps optimize_layout();
 
+        ///Stores the in/out edges of all nodes contiguously (CSR form), releasing the per-node edge vectors
+        ///\note Modifying the graph's nodes or edges afterwards expands the adjacency again
+        void compact_adjacency();
+
+        ///\returns true if the node adjacency is stored in the compact (CSR) form
+        bool adjacency_compacted() const { return adjacency_compacted_; }
+
 
         ///Sets whether dangling combinational nodes is an error (if true) or not
         void set_allow_dangling_combinational_nodes(bool value) {
@@ -264,6 +300,26 @@ class TimingGraph {
 
         void force_levelize();
 
+        ///Moves the compact adjacency back to per-node edge vectors, so it can be modified
+        void expand_adjacency();
+
+#if defined(TATUM_USE_TBB)
+        ///Levels with fewer nodes than this are levelized serially
+        static constexpr size_t PARALLEL_LEVELIZE_MIN_NODES = 16384;
+
+        ///Look-ups used by levelize_frontier_parallel(), kept across levels
+        struct LevelizeFrontierState {
+            std::vector<uint32_t> edge_out_index; //Index of each edge in its source node's out edges
+            std::vector<int> node_frontier_level; //Last level each node was in the frontier of
+            std::vector<uint32_t> node_frontier_index; //Index of each node in that frontier
+        };
+
+        std::vector<NodeId> levelize_frontier_parallel(const std::vector<NodeId>& frontier,
+                                                       int level_idx,
+                                                       std::vector<std::atomic<int>>& node_fanin_remaining,
+                                                       LevelizeFrontierState& state) const;
+#endif
+
         bool valid_node_id(const NodeId node_id) const;
         bool valid_edge_id(const EdgeId edge_id) const;
         bool valid_level_id(const LevelId level_id) const;
@@ -282,8 +338,8 @@ class TimingGraph {
         //Node data
         tatum::util::linear_map<NodeId,NodeId> node_ids_; //The node IDs in the graph
         tatum::util::linear_map<NodeId,NodeType> node_types_; //Type of node
-        tatum::util::linear_map<NodeId,std::vector<EdgeId>> node_in_edges_; //Incomiing edge IDs for node
-        tatum::util::linear_map<NodeId,std::vector<EdgeId>> node_out_edges_; //Out going edge IDs for node
+        tatum::util::linear_map<NodeId,std::vector<EdgeId>> node_in_edges_; //Incomiing edge IDs for node (unless compacted)
+        tatum::util::linear_map<NodeId,std::vector<EdgeId>> node_out_edges_; //Out going edge IDs for node (unless compacted)
         tatum::util::linear_map<NodeId,LevelId> node_levels_; //Out going edge IDs for node
 
         //Edge data
@@ -293,9 +349,18 @@ class TimingGraph {
         tatum::util::linear_map<EdgeId,NodeId> edge_src_nodes_; //Source node for each edge
         tatum::util::linear_map<EdgeId,bool>   edges_disabled_;
 
+        //Compact node adjacency, filled in by compact_adjacency(): the in edges of node i are
+        //in_edges_csr_[in_edge_offsets_[i] .. in_edge_offsets_[i+1]), and similarly for out edges
+        std::vector<EdgeId> in_edges_csr_;
+        std::vector<size_t> in_edge_offsets_;
+        std::vector<EdgeId> out_edges_csr_;
+        std::vector<size_t> out_edge_offsets_;
+        bool adjacency_compacted_ = false;
+
         //Auxilary graph-level info, filled in by levelize()
         tatum::util::linear_map<LevelId,LevelId> level_ids_; //The level IDs in the graph
-        tatum::util::linear_map<LevelId,std::vector<NodeId>> level_nodes_; //Nodes in each level
+        std::vector<NodeId> level_nodes_csr_; //Nodes of all levels, level by level
+        std::vector<size_t> level_node_offsets_; //Index of each level's first node in level_nodes_csr_ (and a sentinel)
         std::vector<NodeId> primary_inputs_; //Primary input nodes of the timing graph.
         std::vector<NodeId> logical_outputs_; //Logical output nodes of the timing graph.
         bool is_levelized_ = false; //Inidcates if the current levelization is valid
@@ -373,10 +373,7 @@ bool CommonAnalysisVisitor<AnalysisOps>::do_arrival_traverse_edge(const TimingGr
             const Time edge_delay = ops_.data_edge_delay(dc, tg, edge_id);
             TATUM_ASSERT_SAFE(edge_delay.valid());
 
-            for(const TimingTag& src_data_tag : src_data_tags) {
-                Time new_arr = src_data_tag.time() + edge_delay;
-                timing_modified |= ops_.merge_arr_tags(node_id, new_arr, src_node_id, src_data_tag);
-            }
+            timing_modified |= ops_.merge_arr_tags(node_id, src_data_tags, edge_delay, src_node_id);
         }
     }
 
@@ -431,10 +428,8 @@ bool CommonAnalysisVisitor<AnalysisOps>::do_required_traverse_edge(const TimingG
         const Time& edge_delay = ops_.data_edge_delay(dc, tg, edge_id);
         TATUM_ASSERT_SAFE(edge_delay.valid());
 
-        for(const TimingTag& sink_tag : sink_data_tags) {
-            //We only propogate the required time if we have a valid matching arrival time
-            timing_modified |= ops_.merge_req_tags(node_id, sink_tag.time() - edge_delay, sink_node_id, sink_tag, true);
-        }
+        //We only propogate the required time if we have a valid matching arrival time
+        timing_modified |= ops_.merge_req_tags(node_id, sink_data_tags, -edge_delay, sink_node_id, true);
     }
 
     return timing_modified;
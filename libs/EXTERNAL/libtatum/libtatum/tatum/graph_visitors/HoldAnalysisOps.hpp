@@ -68,6 +68,10 @@ class HoldAnalysisOps : public CommonAnalysisOps {
             return node_tags_[node].max(time, origin, ref_tag, arrival_must_be_valid); 
         }
 
+        bool merge_req_tags(const NodeId node, TimingTags::tag_range ref_tags, const Time offset, const NodeId origin, bool arrival_must_be_valid=false) { 
+            return node_tags_[node].max_tags(ref_tags, offset, origin, arrival_must_be_valid); 
+        }
+
         bool merge_arr_tags(const NodeId node, const TimingTag& ref_tag) { 
             return merge_arr_tags(node, ref_tag.time(), ref_tag.origin_node(), ref_tag);
         }
@@ -76,6 +80,10 @@ class HoldAnalysisOps : public CommonAnalysisOps {
             return node_tags_[node].min(time, origin, ref_tag); 
         }
 
+        bool merge_arr_tags(const NodeId node, TimingTags::tag_range ref_tags, const Time offset, const NodeId origin) { 
+            return node_tags_[node].min_tags(ref_tags, offset, origin); 
+        }
+
         Time data_edge_delay(const DelayCalculator& dc, const TimingGraph& tg, const EdgeId edge_id) { 
             Time delay = dc.min_edge_delay(tg, edge_id);
             TATUM_ASSERT_MSG(delay.value() >= 0., "Data edge delay expected to be positive");
@@ -8,4 +8,5 @@
 #include "graph_walkers/SerialWalker.hpp"
 #include "graph_walkers/SerialIncrWalker.hpp"
 #include "graph_walkers/ParallelLevelizedWalker.hpp"
+#include "graph_walkers/ParallelTaskWalker.hpp"
 #include "graph_walkers/ParallelWalker.hpp"
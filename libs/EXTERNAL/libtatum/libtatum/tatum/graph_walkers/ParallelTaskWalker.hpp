@@ -0,0 +1,198 @@
+#pragma once
+#include "tatum/graph_walkers/ParallelLevelizedWalker.hpp"
+#include "tatum/TimingGraph.hpp"
+
+#ifdef TATUM_USE_TBB
+# include <atomic>
+# include <tbb/parallel_for_each.h>
+#endif
+
+namespace tatum {
+
+/**
+ * A parallel timing analyzer which avoids most of the level barriers of the ParallelLevelizedWalker.
+ *
+ * Waiting for every level to finish before the next one starts is inefficient for deep timing
+ * graphs with many levels holding only a few nodes each. This walker instead splits the levels
+ * into segments:
+ *  - A level with many nodes forms its own segment, whose nodes are traversed in parallel (as by
+ *    the ParallelLevelizedWalker).
+ *  - Consecutive smaller levels are fused into one segment. If it has few nodes it is traversed
+ *    serially. Otherwise it is traversed as a task graph: each node keeps a counter of its fanin
+ *    (fanout for required times) within the segment, and becomes a (work stolen) task once the
+ *    counter reaches zero, so no thread waits between the fused levels.
+ *
+ * Each node still only reads the nodes it depends on once they are done, so the results are
+ * identical to the other walkers. If TBB is not available it operates serially and is equivalent
+ * to the SerialWalker.
+ */
+class ParallelTaskWalker : public ParallelLevelizedWalker {
+#if defined(TATUM_USE_TBB)
+    public:
+        void do_arrival_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            update_schedule(tg);
+
+            for (size_t isegment = 0; isegment < segments_.size(); ++isegment) {
+                traverse_segment(tg, isegment, /*arrival=*/true, [&](NodeId node) {
+                    visitor.do_arrival_traverse_node(tg, tc, dc, node);
+                });
+            }
+        }
+
+        void do_required_traversal_impl(const TimingGraph& tg, const TimingConstraints& tc, const DelayCalculator& dc, GraphVisitor& visitor) override {
+            update_schedule(tg);
+
+            for (size_t isegment = segments_.size(); isegment-- > 0;) {
+                traverse_segment(tg, isegment, /*arrival=*/false, [&](NodeId node) {
+                    visitor.do_required_traverse_node(tg, tc, dc, node);
+                });
+            }
+        }
+
+    private:
+        ///Levels with at least this many nodes are traversed in parallel in their own segment
+        static constexpr size_t WIDE_LEVEL_MIN_NODES = 4096;
+
+        ///Fused levels with fewer nodes than this in total are traversed serially
+        static constexpr size_t TASK_SEGMENT_MIN_NODES = 512;
+
+        enum class SegmentType {
+            SERIAL, //Nodes traversed in level order by the calling thread
+            WIDE,   //A single level, whose nodes are traversed in parallel
+            TASK    //Fused levels, whose nodes are traversed once their dependencies are done
+        };
+
+        struct Segment {
+            SegmentType type;
+            std::vector<NodeId> nodes; //In level order
+            std::vector<NodeId> arrival_roots; //TASK only: nodes with no fanin within the segment
+            std::vector<NodeId> required_roots; //TASK only: nodes with no fanout within the segment
+        };
+
+        //Re-builds the segments if tg is not the graph they were built for
+        void update_schedule(const TimingGraph& tg) {
+            if (schedule_graph_ == &tg
+                && schedule_num_nodes_ == tg.nodes().size()
+                && schedule_num_edges_ == tg.edges().size()
+                && schedule_num_levels_ == tg.levels().size()) {
+                return;
+            }
+
+            segments_.clear();
+            node_segment_.assign(tg.nodes().size(), -1);
+
+            //Split the levels into segments
+            for (LevelId level_id : tg.levels()) {
+                auto level_nodes = tg.level_nodes(level_id);
+                bool wide = level_nodes.size() >= WIDE_LEVEL_MIN_NODES;
+
+                if (wide || segments_.empty() || segments_.back().type == SegmentType::WIDE) {
+                    segments_.emplace_back();
+                    segments_.back().type = wide ? SegmentType::WIDE : SegmentType::SERIAL;
+                }
+
+                Segment& segment = segments_.back();
+                for (NodeId node : level_nodes) {
+                    segment.nodes.push_back(node);
+                    node_segment_[size_t(node)] = segments_.size() - 1;
+                }
+            }
+
+            //Count the dependencies of each node within its segment
+            arrival_deps_.assign(tg.nodes().size(), 0);
+            required_deps_.assign(tg.nodes().size(), 0);
+            for (EdgeId edge : tg.edges()) {
+                if (tg.edge_disabled(edge)) continue;
+
+                size_t src_node = size_t(tg.edge_src_node(edge));
+                size_t sink_node = size_t(tg.edge_sink_node(edge));
+                if (node_segment_[src_node] == node_segment_[sink_node]) {
+                    ++arrival_deps_[sink_node];
+                    ++required_deps_[src_node];
+                }
+            }
+
+            for (Segment& segment : segments_) {
+                if (segment.type != SegmentType::SERIAL || segment.nodes.size() < TASK_SEGMENT_MIN_NODES) continue;
+
+                segment.type = SegmentType::TASK;
+                for (NodeId node : segment.nodes) {
+                    if (arrival_deps_[size_t(node)] == 0) segment.arrival_roots.push_back(node);
+                    if (required_deps_[size_t(node)] == 0) segment.required_roots.push_back(node);
+                }
+            }
+
+            deps_remaining_ = std::vector<std::atomic<int>>(tg.nodes().size());
+
+            schedule_graph_ = &tg;
+            schedule_num_nodes_ = tg.nodes().size();
+            schedule_num_edges_ = tg.edges().size();
+            schedule_num_levels_ = tg.levels().size();
+        }
+
+        template<class Visit>
+        void traverse_segment(const TimingGraph& tg, size_t isegment, bool arrival, const Visit& visit) {
+            const Segment& segment = segments_[isegment];
+
+            if (segment.type == SegmentType::SERIAL) {
+                if (arrival) {
+                    for (auto iter = segment.nodes.begin(); iter != segment.nodes.end(); ++iter) {
+                        visit(*iter);
+                    }
+                } else {
+                    for (auto iter = segment.nodes.rbegin(); iter != segment.nodes.rend(); ++iter) {
+                        visit(*iter);
+                    }
+                }
+                return;
+            }
+
+            if (segment.type == SegmentType::WIDE) {
+                tbb::parallel_for_each(segment.nodes.begin(), segment.nodes.end(), [&](NodeId node) {
+                    visit(node);
+                });
+                return;
+            }
+
+            TATUM_ASSERT(segment.type == SegmentType::TASK);
+            const std::vector<int>& deps = arrival ? arrival_deps_ : required_deps_;
+            for (NodeId node : segment.nodes) {
+                deps_remaining_[size_t(node)].store(deps[size_t(node)], std::memory_order_relaxed);
+            }
+
+            const std::vector<NodeId>& roots = arrival ? segment.arrival_roots : segment.required_roots;
+            tbb::parallel_for_each(roots.begin(), roots.end(), [&](NodeId node, tbb::feeder<NodeId>& feeder) {
+                visit(node);
+
+                //Release the nodes which depend on node. The acquire-release decrement ensures
+                //the last dependency's results are visible to the released node
+                auto edges = arrival ? tg.node_out_edges(node) : tg.node_in_edges(node);
+                for (EdgeId edge : edges) {
+                    if (tg.edge_disabled(edge)) continue;
+
+                    NodeId next_node = arrival ? tg.edge_sink_node(edge) : tg.edge_src_node(edge);
+                    if (node_segment_[size_t(next_node)] != int(isegment)) continue;
+
+                    if (deps_remaining_[size_t(next_node)].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        feeder.add(next_node);
+                    }
+                }
+            });
+        }
+
+    private:
+        std::vector<Segment> segments_; //In level order
+        std::vector<int> node_segment_; //Segment of each node
+        std::vector<int> arrival_deps_; //Active fanin of each node within its segment
+        std::vector<int> required_deps_; //Active fanout of each node within its segment
+        std::vector<std::atomic<int>> deps_remaining_; //Dependencies of each node not yet traversed
+
+        //The graph the schedule was built for
+        const TimingGraph* schedule_graph_ = nullptr;
+        size_t schedule_num_nodes_ = 0;
+        size_t schedule_num_edges_ = 0;
+        size_t schedule_num_levels_ = 0;
+#endif
+};
+
+} //namepsace
@@ -3,5 +3,5 @@
 #include "tatum/graph_walkers_fwd.hpp"
 
 
-//Include the def'n of ParallelLevelizedWalker
-#include "ParallelLevelizedWalker.hpp"
+//Include the def'n of ParallelTaskWalker
+#include "ParallelTaskWalker.hpp"
@@ -6,8 +6,10 @@ class SerialWalker;
 
 class ParallelLevelizedWalker;
 
+class ParallelTaskWalker;
+
 ///The default parallel graph walker
-using ParallelWalker = ParallelLevelizedWalker;
+using ParallelWalker = ParallelTaskWalker;
 
 } //namespace
 
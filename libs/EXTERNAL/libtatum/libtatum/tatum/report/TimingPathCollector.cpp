@@ -3,7 +3,14 @@
 #include "tatum/report/TimingPathCollector.hpp"
 #include "tatum/report/TimingReportTagRetriever.hpp"
 #include "tatum/report/timing_path_tracing.hpp"
+#include <algorithm>
+#include <iterator>
 #include <map>
+#include <numeric>
+
+#if defined(TATUM_USE_TBB)
+# include <tbb/parallel_for.h>
+#endif
 
 namespace tatum {
 
@@ -13,14 +20,13 @@ std::vector<SkewPath> collect_worst_skew_paths(const TimingGraph& timing_graph,
                                               const detail::TagRetriever& tag_retriever, TimingType timing_type, size_t npaths);
 
 std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_graph, const detail::TagRetriever& tag_retriever, size_t npaths) {
-    std::vector<TimingPath> paths;
-
     struct TagNode {
-        TagNode(TimingTag t, NodeId n) noexcept
-            : tag(t), node(n) {}
+        TagNode(TimingTag t, NodeId n, size_t o) noexcept
+            : tag(t), node(n), order(o) {}
 
         TimingTag tag;
         NodeId node;
+        size_t order; //Position in end-point order, to break slack ties deterministically
 
     };
 
@@ -29,41 +35,55 @@ std::vector<TimingPath> collect_worst_timing_paths(const TimingGraph& timing_gra
     //Add the slacks of all sink
     for(NodeId node : timing_graph.logical_outputs()) {
         for(TimingTag tag : tag_retriever.slacks(node)) {
-            tags_and_sinks.emplace_back(tag,node);
+            tags_and_sinks.emplace_back(tag, node, tags_and_sinks.size());
         }
     }
 
-    //Sort in ascending slack order so most negative slacks are first
+    //Select the npaths worst slacks in ascending slack order (so most negative slacks are first).
+    //Only the selected end-points are sorted (through a heap bounded to npaths) and traced.
     auto ascending_slack_order = [](const TagNode& lhs, const TagNode& rhs) {
-        return lhs.tag.time() < rhs.tag.time();
+        if (lhs.tag.time().value() != rhs.tag.time().value()) {
+            return lhs.tag.time().value() < rhs.tag.time().value();
+        }
+        return lhs.order < rhs.order;
     };
-    std::sort(tags_and_sinks.begin(), tags_and_sinks.end(), ascending_slack_order);
-
-
-    //Trace the paths for each tag/node pair
-    // The the map will sort the nodes and tags from worst to best slack (i.e. ascending slack order),
-    // so the first pair is the most critical end-point
-    for(const auto& tag_node : tags_and_sinks) {
-        NodeId sink_node = tag_node.node;
-        TimingTag sink_tag = tag_node.tag;
+    size_t num_paths = std::min(npaths, tags_and_sinks.size());
+    std::partial_sort(tags_and_sinks.begin(), tags_and_sinks.begin() + num_paths, tags_and_sinks.end(), ascending_slack_order);
 
-        TimingPath path = detail::trace_path(timing_graph, tag_retriever, sink_tag.launch_clock_domain(), sink_tag.capture_clock_domain(), sink_node); 
+    //Trace the paths for each selected tag/node pair, from the most critical end-point
+    //to the least. The paths are independent so they are traced concurrently.
+    std::vector<TimingPath> paths(num_paths);
+    auto trace_end_point_path = [&](size_t ipath) {
+        NodeId sink_node = tags_and_sinks[ipath].node;
+        TimingTag sink_tag = tags_and_sinks[ipath].tag;
 
-        paths.push_back(path);
-
-        if(paths.size() >= npaths) break;
+        paths[ipath] = detail::trace_path(timing_graph, tag_retriever, sink_tag.launch_clock_domain(), sink_tag.capture_clock_domain(), sink_node);
+    };
+#if defined(TATUM_USE_TBB)
+    tbb::parallel_for(size_t(0), num_paths, trace_end_point_path);
+#else
+    for(size_t ipath = 0; ipath < num_paths; ++ipath) {
+        trace_end_point_path(ipath);
     }
+#endif
 
     return paths;
 }
 
 std::vector<SkewPath> collect_worst_skew_paths(const TimingGraph& timing_graph, const TimingConstraints& timing_constraints, 
                                                const detail::TagRetriever& tag_retriever, TimingType timing_type, size_t npaths) {
-    std::vector<SkewPath> paths;
-
+    //The skew paths of each sink are independent, so they are traced concurrently
+    std::vector<NodeId> sinks;
     for(NodeId node : timing_graph.nodes()) {
-        NodeType node_type = timing_graph.node_type(node);
-        if (node_type != NodeType::SINK) continue;
+        if (timing_graph.node_type(node) == NodeType::SINK) {
+            sinks.push_back(node);
+        }
+    }
+
+    std::vector<std::vector<SkewPath>> sink_paths(sinks.size());
+    auto trace_sink_skew_paths = [&](size_t isink) {
+        NodeId node = sinks[isink];
+        std::vector<SkewPath>& paths = sink_paths[isink];
 
         const auto& required_tags = tag_retriever.tags(node, TagType::DATA_REQUIRED);
 
@@ -141,9 +161,27 @@ std::vector<SkewPath> collect_worst_skew_paths(const TimingGraph& timing_graph,
 
             paths.push_back(path);
         }
+    };
+#if defined(TATUM_USE_TBB)
+    tbb::parallel_for(size_t(0), sinks.size(), trace_sink_skew_paths);
+#else
+    for(size_t isink = 0; isink < sinks.size(); ++isink) {
+        trace_sink_skew_paths(isink);
+    }
+#endif
+
+    std::vector<SkewPath> all_paths;
+    for(auto& paths : sink_paths) {
+        std::move(paths.begin(), paths.end(), std::back_inserter(all_paths));
     }
 
-    auto skew_order = [&](const SkewPath& lhs, const SkewPath& rhs) {
+    auto skew_order = [&](size_t lhs_idx, size_t rhs_idx) {
+        const SkewPath& lhs = all_paths[lhs_idx];
+        const SkewPath& rhs = all_paths[rhs_idx];
+        if (lhs.clock_skew.value() == rhs.clock_skew.value()) {
+            return lhs_idx < rhs_idx; //Keep sink order on ties
+        }
+
         if (timing_type == TimingType::SETUP) {
             //Positive skew helps setup paths (since the capture clock edge is delayed, 
             //lengthening the clock period), so show the most negative skews first.
@@ -156,10 +194,18 @@ std::vector<SkewPath> collect_worst_skew_paths(const TimingGraph& timing_graph,
             return lhs.clock_skew > rhs.clock_skew;
         }
     };
-    std::sort(paths.begin(), paths.end(), skew_order);
 
-    //TODO: not very efficient, since we generate all paths first and then trim to npaths...
-    paths.resize(std::min(paths.size(), npaths));
+    //Only the npaths worst paths are sorted (through a heap bounded to npaths)
+    std::vector<size_t> path_order(all_paths.size());
+    std::iota(path_order.begin(), path_order.end(), 0);
+    size_t num_paths = std::min(npaths, all_paths.size());
+    std::partial_sort(path_order.begin(), path_order.begin() + num_paths, path_order.end(), skew_order);
+
+    std::vector<SkewPath> paths;
+    paths.reserve(num_paths);
+    for(size_t ipath = 0; ipath < num_paths; ++ipath) {
+        paths.push_back(std::move(all_paths[path_order[ipath]]));
+    }
 
     return paths;
 }
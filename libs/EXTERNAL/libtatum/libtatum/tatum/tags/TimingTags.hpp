@@ -30,7 +30,8 @@ class TimingTags {
         class Iterator;
     private:
         //In practice the vast majority of nodes have only a handful of tags,
-        //so we reserve space for some to avoid costly memory allocations
+        //so we reserve space for some when the first tag is added, to avoid
+        //costly memory allocations
         constexpr static size_t DEFAULT_TAGS_TO_RESERVE = 3;
         constexpr static size_t GROWTH_FACTOR = 2;
 
@@ -45,7 +46,10 @@ class TimingTags {
     public:
 
         //Constructors
-        TimingTags(size_t num_reserve=DEFAULT_TAGS_TO_RESERVE);
+        ///\param num_reserve The number of tags to allocate storage for. By default no storage
+        ///                   is allocated until the first tag is added, since analyzers hold
+        ///                   sets of tags for every node and many of them stay empty
+        TimingTags(size_t num_reserve=0);
         TimingTags(const TimingTags&);
         TimingTags(TimingTags&&);
         TimingTags& operator=(TimingTags);
@@ -97,6 +101,20 @@ class TimingTags {
         ///\remark Finds (or creates) the tag with the same clock domain as base_tag and update the required time if new_time is smaller
         bool min(const Time& new_time, const NodeId origin, const TimingTag& base_tag, bool arr_must_be_valid=false);
 
+        ///Updates this set of tags from the tags of another node, as if max() were called with
+        ///new_time = src_tag.time() + offset and base_tag = src_tag for each tag in src_tags.
+        ///\param src_tags The tags to merge, all of the same type
+        ///\param offset The delay added to each of the src_tags times
+        ///\param origin The origin node recorded on updated tags
+        ///\remark Nodes on the same paths tend to store their tags in the same clock domain order,
+        ///        so each source tag is first matched against the tag at the same position in this
+        ///        set. This avoids find_matching_tag()'s linear search in the common case, which
+        ///        otherwise makes merging quadratic in the number of clock domains.
+        bool max_tags(tag_range src_tags, const Time& offset, const NodeId origin, bool arr_must_be_valid=false);
+
+        ///Like max_tags(), but as if min() were called for each tag in src_tags
+        bool min_tags(tag_range src_tags, const Time& offset, const NodeId origin, bool arr_must_be_valid=false);
+
         ///Clears the tags in the current set
         void clear();
 
@@ -179,6 +197,9 @@ class TimingTags {
         //          corresponding arrival time, or end(TagType::DATA_REQUIRED)
         std::pair<bool,iterator> find_data_required_with_valid_data_arrival(DomainId launch_domain, DomainId capture_domain);
 
+        ///Implements max_tags() (if use_max is true) and min_tags()
+        bool merge_tags(tag_range src_tags, const Time& offset, const NodeId origin, bool use_max, bool arr_must_be_valid);
+
 
         iterator insert(iterator iter, const TimingTag& tag);
         void grow_insert(size_t index, const TimingTag& tag);
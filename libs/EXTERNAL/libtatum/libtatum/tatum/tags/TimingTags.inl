@@ -228,6 +228,14 @@ inline bool TimingTags::min(const Time& new_time, const NodeId origin, const Tim
     return modified;
 }
 
+inline bool TimingTags::max_tags(tag_range src_tags, const Time& offset, const NodeId origin, bool arr_must_be_valid) {
+    return merge_tags(src_tags, offset, origin, true, arr_must_be_valid);
+}
+
+inline bool TimingTags::min_tags(tag_range src_tags, const Time& offset, const NodeId origin, bool arr_must_be_valid) {
+    return merge_tags(src_tags, offset, origin, false, arr_must_be_valid);
+}
+
 inline void TimingTags::clear() {
     size_ = 0;
     num_clock_launch_tags_ = 0;
@@ -279,6 +287,69 @@ inline std::pair<bool,TimingTags::iterator> TimingTags::find_data_required_with_
     return {true, find_matching_tag(TagType::DATA_REQUIRED, launch_domain, capture_domain)};
 }
 
+inline bool TimingTags::merge_tags(tag_range src_tags, const Time& offset, const NodeId origin, bool use_max, bool arr_must_be_valid) {
+    bool modified = false;
+    if(src_tags.empty()) return modified;
+
+    const TagType type = src_tags.begin()->type();
+    TATUM_ASSERT(!arr_must_be_valid || type == TagType::DATA_REQUIRED);
+
+    auto is_wildcard = [](const TimingTag& tag) {
+        return !tag.launch_clock_domain() || !tag.capture_clock_domain();
+    };
+
+    //New tags of type are inserted at end(type), so the position of the first
+    //tag of type (and of every existing tag of type) is stable during the merge
+    const size_t first = std::distance(begin(), begin(type));
+
+    //A positional match is only the tag find_matching_tag() would return if no
+    //earlier wildcard tag could match first
+    bool has_wildcard = std::any_of(begin(type), end(type), is_wildcard);
+
+    size_t index = 0;
+    for(const TimingTag& src_tag : src_tags) {
+        TATUM_ASSERT_SAFE(src_tag.type() == type);
+        const Time new_time = src_tag.time() + offset;
+
+        bool src_wildcard = is_wildcard(src_tag);
+        size_t num_tags = std::distance(begin(type), end(type));
+
+        if(!has_wildcard && !src_wildcard && index < num_tags
+           && tags_[first + index].launch_clock_domain() == src_tag.launch_clock_domain()
+           && tags_[first + index].capture_clock_domain() == src_tag.capture_clock_domain()) {
+            //Fast path: the tag at the same position has the same domains
+            TimingTag& tag = tags_[first + index];
+
+            bool valid = true;
+            if(arr_must_be_valid) {
+                auto arr_iter = find_matching_tag(TagType::DATA_ARRIVAL, src_tag.launch_clock_domain(), DomainId::INVALID());
+                valid = arr_iter != end(TagType::DATA_ARRIVAL) && arr_iter->time().valid();
+            }
+
+            if(valid) {
+                if(use_max) {
+                    modified |= tag.max(new_time, origin, src_tag);
+                } else {
+                    modified |= tag.min(new_time, origin, src_tag);
+                }
+            }
+        } else {
+            //Fall back to searching for the matching tag
+            if(use_max) {
+                modified |= max(new_time, origin, src_tag, arr_must_be_valid);
+            } else {
+                modified |= min(new_time, origin, src_tag, arr_must_be_valid);
+            }
+
+            //The source tag may have been added
+            has_wildcard |= src_wildcard;
+        }
+        ++index;
+    }
+
+    return modified;
+}
+
 inline size_t TimingTags::capacity() const { return capacity_; }
 
 inline TimingTags::iterator TimingTags::insert(iterator iter, const TimingTag& tag) {
@@ -309,7 +380,8 @@ inline TimingTags::iterator TimingTags::insert(iterator iter, const TimingTag& t
 }
 
 inline void TimingTags::grow_insert(size_t index, const TimingTag& tag) {
-    size_t new_capacity = (capacity() == 0) ? 1 : GROWTH_FACTOR * capacity();
+    //Storage is materialized on the first write
+    size_t new_capacity = (capacity() == 0) ? DEFAULT_TAGS_TO_RESERVE : GROWTH_FACTOR * capacity();
 
     //We construct a new copy of ourselves at the new capacity and with the new
     //tag inserted
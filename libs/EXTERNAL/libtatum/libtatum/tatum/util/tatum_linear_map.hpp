@@ -97,6 +97,8 @@ class linear_map {
 
         void clear() { vec_.clear(); }
 
+        void reserve(size_t n) { vec_.reserve(n); }
+
         size_t capacity() const { return vec_.capacity(); }
         void shrink_to_fit() { vec_.shrink_to_fit(); }
 
@@ -42,6 +42,7 @@
 #include "vtr_hash.h"
 #include "vtr_bimap.h"
 #include "vtr_string_interning.h"
+#include "vtr_dynamic_bitset.h"
 
 #include "logic_types.h"
 #include "clock_types.h"
@@ -1281,6 +1282,10 @@ class t_pb_graph_node {
 
     int total_primitive_count; /* total number of this primitive type in the cluster */
 
+    /* Bits (indexed by t_model::index) set for each model implemented by a primitive in or under this node, outside
+     * modes disabled for packing. Loaded by the packer's feasibility filter; bits past the end are unset. */
+    vtr::dynamic_bitset<> implementable_models;
+
     /* Interconnect instances for this pb
      * Only used for power
      */
@@ -1,5 +1,4 @@
 #include <algorithm>
-#include <kj/std/iostream.h>
 #include <limits>
 #include <map>
 #include <regex>
@@ -7,7 +6,7 @@
 #include <stdlib.h>
 #include <string>
 #include <string.h>
-#include <zlib.h>
+#include <unordered_map>
 #include <sstream>
 
 #include "vtr_assert.h"
@@ -22,6 +21,7 @@
 #include "arch_types.h"
 
 #include "read_fpga_interchange_arch.h"
+#include "gzip_input_stream.h"
 
 /*
  * FPGA Interchange Device frontend
@@ -30,7 +30,7 @@
  * and populate the various VTR architecture's internal data structures.
  *
  * The Device data is, by default, GZipped, hence the requirement of the ZLIB library to allow
- * for in-memory decompression of the input file.
+ * for streaming decompression of the input file.
  */
 
 using namespace DeviceResources;
@@ -155,19 +155,38 @@ static float get_corner_value(Device::CornerModel::Reader model, const char* spe
     return 0.;
 }
 
-/** @brief Returns the port corresponding to the given model in the architecture */
-static t_model_ports* get_model_port(t_arch* arch, std::string model, std::string port, bool fail = true) {
+/** @brief The architecture models and their ports by name, which the cells of large devices look up many times */
+struct t_model_index {
+    std::unordered_map<std::string, t_model*> models;
+    std::unordered_map<std::string, std::unordered_map<std::string, t_model_ports*>> model_ports;
+};
+
+/** @brief Indexes the models of the architecture. The first model (and port) of a name is kept, as a linear search would find */
+static void build_model_index(const t_arch* arch, t_model_index& index) {
+    index.models.clear();
+    index.model_ports.clear();
+
     for (t_model* m : {arch->models, arch->model_library}) {
         for (; m != nullptr; m = m->next) {
-            if (std::string(m->name) != model)
+            if (!index.models.emplace(m->name, m).second)
                 continue;
 
+            auto& ports = index.model_ports[m->name];
             for (t_model_ports* p : {m->inputs, m->outputs})
                 for (; p != nullptr; p = p->next)
-                    if (std::string(p->name) == port)
-                        return p;
+                    ports.emplace(p->name, p);
         }
     }
+}
+
+/** @brief Returns the port corresponding to the given model in the architecture */
+static t_model_ports* get_model_port(const t_model_index& index, const std::string& model, const std::string& port, bool fail = true) {
+    auto model_iter = index.model_ports.find(model);
+    if (model_iter != index.model_ports.end()) {
+        auto port_iter = model_iter->second.find(port);
+        if (port_iter != model_iter->second.end())
+            return port_iter->second;
+    }
 
     if (fail)
         archfpga_throw(__FILE__, __LINE__,
@@ -177,11 +196,10 @@ static t_model_ports* get_model_port(t_arch* arch, std::string model, std::strin
 }
 
 /** @brief Returns the specified architecture model */
-static t_model* get_model(t_arch* arch, std::string model) {
-    for (t_model* m : {arch->models, arch->model_library})
-        for (; m != nullptr; m = m->next)
-            if (std::string(m->name) == model)
-                return m;
+static t_model* get_model(const t_model_index& index, const std::string& model) {
+    auto iter = index.models.find(model);
+    if (iter != index.models.end())
+        return iter->second;
 
     archfpga_throw(__FILE__, __LINE__,
                    "Could not find model: %s\n", model.c_str());
@@ -201,7 +219,7 @@ static T* get_type_by_name(const char* type_name, std::vector<T>& types) {
 }
 
 /** @brief Returns a generic port instantiation for a complex block */
-static t_port get_generic_port(t_arch* arch,
+static t_port get_generic_port(const t_model_index& models,
                                t_pb_type* pb_type,
                                PORTS dir,
                                std::string name,
@@ -223,7 +241,7 @@ static t_port get_generic_port(t_arch* arch,
     port.port_power = (t_port_power*)vtr::calloc(1, sizeof(t_port_power));
 
     if (!model.empty())
-        port.model_port = get_model_port(arch, model, name);
+        port.model_port = get_model_port(models, model, name);
 
     return port;
 }
@@ -291,6 +309,7 @@ struct ArchReader {
 
         process_models();
         process_constant_model();
+        build_model_index(arch_, models_);
 
         process_device();
 
@@ -337,6 +356,9 @@ struct ArchReader {
     std::unordered_map<uint32_t, std::set<t_bel_cell_mapping>> bel_cell_mappings_;
     std::unordered_map<std::string, int> segment_name_to_segment_idx;
 
+    // Models by name, once all of them are created
+    t_model_index models_;
+
     // Utils
 
     /** @brief Returns the string corresponding to the given index */
@@ -1305,12 +1327,12 @@ struct ArchReader {
         lut->parent_mode = mode;
 
         lut->blif_model = vtr::strdup(MODEL_NAMES);
-        lut->model = get_model(arch_, std::string(MODEL_NAMES));
+        lut->model = get_model(models_, std::string(MODEL_NAMES));
 
         lut->num_ports = 2;
         lut->ports = (t_port*)vtr::calloc(lut->num_ports, sizeof(t_port));
-        lut->ports[0] = get_generic_port(arch_, lut, IN_PORT, "in", MODEL_NAMES, width);
-        lut->ports[1] = get_generic_port(arch_, lut, OUT_PORT, "out", MODEL_NAMES);
+        lut->ports[0] = get_generic_port(models_, lut, IN_PORT, "in", MODEL_NAMES, width);
+        lut->ports[1] = get_generic_port(models_, lut, OUT_PORT, "out", MODEL_NAMES);
 
         lut->ports[0].equivalent = PortEquivalence::FULL;
 
@@ -1412,9 +1434,9 @@ struct ArchReader {
         opad->num_ports = num_ports;
         opad->ports = (t_port*)vtr::calloc(num_ports, sizeof(t_port));
         opad->blif_model = vtr::strdup(MODEL_OUTPUT);
-        opad->model = get_model(arch_, std::string(MODEL_OUTPUT));
+        opad->model = get_model(models_, std::string(MODEL_OUTPUT));
 
-        opad->ports[0] = get_generic_port(arch_, opad, IN_PORT, "outpad", MODEL_OUTPUT);
+        opad->ports[0] = get_generic_port(models_, opad, IN_PORT, "outpad", MODEL_OUTPUT);
         omode->pb_type_children[0] = *opad;
 
         // IPAD mode
@@ -1434,9 +1456,9 @@ struct ArchReader {
         ipad->num_ports = num_ports;
         ipad->ports = (t_port*)vtr::calloc(num_ports, sizeof(t_port));
         ipad->blif_model = vtr::strdup(MODEL_INPUT);
-        ipad->model = get_model(arch_, std::string(MODEL_INPUT));
+        ipad->model = get_model(models_, std::string(MODEL_INPUT));
 
-        ipad->ports[0] = get_generic_port(arch_, ipad, OUT_PORT, "inpad", MODEL_INPUT);
+        ipad->ports[0] = get_generic_port(models_, ipad, OUT_PORT, "inpad", MODEL_INPUT);
         imode->pb_type_children[0] = *ipad;
 
         // Handle interconnects
@@ -1504,7 +1526,7 @@ struct ArchReader {
                 auto pin_reader = get_bel_pin_reader(site, bel, bel_pin);
                 bool is_inout = pin_reader.getDir() == INOUT;
 
-                auto model_port = get_model_port(arch_, name, cell_pin, false);
+                auto model_port = get_model_port(models_, name, cell_pin, false);
 
                 if (is_inout && model_port != nullptr)
                     bel_pin = model_port->dir == IN_PORT ? bel_pin + in_suffix_ : bel_pin + out_suffix_;
@@ -1561,7 +1583,7 @@ struct ArchReader {
             leaf->num_ports = num_ports;
             leaf->ports = (t_port*)vtr::calloc(num_ports, sizeof(t_port));
             leaf->blif_model = vtr::strdup((std::string(".subckt ") + name).c_str());
-            leaf->model = get_model(arch_, name);
+            leaf->model = get_model(models_, name);
 
             mode->num_interconnect = num_ports;
             mode->interconnect = new t_interconnect[num_ports];
@@ -1582,7 +1604,7 @@ struct ArchReader {
                     pin_suffix = std::string("[") + regex_matches[2].str() + std::string("]");
                 }
 
-                auto model_port = get_model_port(arch_, name, cell_pin);
+                auto model_port = get_model_port(models_, name, cell_pin);
 
                 auto size = model_port->size;
                 auto dir = model_port->dir;
@@ -1743,14 +1765,14 @@ struct ArchReader {
                 pb_type->num_input_pins += is_input ? 1 : 0;
                 pb_type->num_output_pins += is_input ? 0 : 1;
 
-                auto port = get_generic_port(arch_, pb_type, dir, pin_name, /*string_model=*/"", num_pins);
+                auto port = get_generic_port(models_, pb_type, dir, pin_name, /*string_model=*/"", num_pins);
                 ports[pin_count] = port;
                 port.index = pin_count++;
                 port.port_index_by_type = pins_dir_count++;
                 port.absolute_first_pin_index = pin_abs++;
 
                 if (!model.empty())
-                    port.model_port = get_model_port(arch_, model, pin_name);
+                    port.model_port = get_model_port(models_, model, pin_name);
             }
         }
     }
@@ -2135,10 +2157,10 @@ struct ArchReader {
             leaf_pb_type->num_ports = num_ports;
             leaf_pb_type->ports = (t_port*)vtr::calloc(num_ports, sizeof(t_port));
             leaf_pb_type->blif_model = vtr::strdup(const_cell.first.c_str());
-            leaf_pb_type->model = get_model(arch_, const_cell.first);
+            leaf_pb_type->model = get_model(models_, const_cell.first);
 
-            leaf_pb_type->ports[0] = get_generic_port(arch_, leaf_pb_type, OUT_PORT, const_cell.second, const_cell.first);
-            pb_type->ports[count] = get_generic_port(arch_, leaf_pb_type, OUT_PORT, const_cell.first + "_" + const_cell.second);
+            leaf_pb_type->ports[0] = get_generic_port(models_, leaf_pb_type, OUT_PORT, const_cell.second, const_cell.first);
+            pb_type->ports[count] = get_generic_port(models_, leaf_pb_type, OUT_PORT, const_cell.first + "_" + const_cell.second);
 
             std::string istr = leaf_name + "." + const_cell.second;
             std::string ostr = const_block_ + "." + const_cell.first + "_" + const_cell.second;
@@ -2502,32 +2524,8 @@ void FPGAInterchangeReadArch(const char* FPGAInterchangeDeviceFile,
                              t_arch* arch,
                              std::vector<t_physical_tile_type>& PhysicalTileTypes,
                              std::vector<t_logical_block_type>& LogicalBlockTypes) {
-    // Decompress GZipped capnproto device file
-    gzFile file = gzopen(FPGAInterchangeDeviceFile, "r");
-    VTR_ASSERT(file != Z_NULL);
-
-    std::vector<uint8_t> output_data;
-    output_data.resize(4096);
-    std::stringstream sstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    while (true) {
-        int ret = gzread(file, output_data.data(), output_data.size());
-        VTR_ASSERT(ret >= 0);
-        if (ret > 0) {
-            sstream.write((const char*)output_data.data(), ret);
-            VTR_ASSERT(sstream);
-        } else {
-            VTR_ASSERT(ret == 0);
-            int error;
-            gzerror(file, &error);
-            VTR_ASSERT(error == Z_OK);
-            break;
-        }
-    }
-
-    VTR_ASSERT(gzclose(file) == Z_OK);
-
-    sstream.seekg(0);
-    kj::std::StdInputStream istream(sstream);
+    // Read the GZipped capnproto device file, inflating it as the message is read
+    GzipInputStream istream(FPGAInterchangeDeviceFile);
 
     // Reader options
     capnp::ReaderOptions reader_options;
@@ -42,6 +42,12 @@
 #include <string>
 #include <sstream>
 #include <algorithm>
+#include <exception>
+#include <mutex>
+
+#ifdef ARCHFPGA_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
 
 #include "pugixml.hpp"
 #include "pugixml_util.hpp"
@@ -68,6 +74,9 @@
 using namespace std::string_literals;
 using pugiutil::ReqOpt;
 
+/* Guards the arch string internment while the complex blocks are loaded concurrently */
+static std::mutex metadata_strings_mutex;
+
 struct t_fc_override {
     std::string port_name;
     std::string seg_name;
@@ -224,6 +233,8 @@ static void ProcessBlockTypeLocs(t_grid_def& grid_def, int die_number, vtr::stri
 static int get_number_of_layers(pugi::xml_node layout_type_tag, const pugiutil::loc_data& loc_data);
 static void ProcessDevice(pugi::xml_node Node, t_arch* arch, t_default_fc_spec& arch_def_fc, const pugiutil::loc_data& loc_data);
 static void ProcessComplexBlocks(vtr::string_internment* strings, pugi::xml_node Node, std::vector<t_logical_block_type>& LogicalBlockTypes, t_arch& arch, const bool timing_enabled, const pugiutil::loc_data& loc_data);
+static void InternPb_TypeMetadataStrings(vtr::string_internment* strings, pugi::xml_node Parent);
+static void LogDisabledPackingModes(const t_pb_type* pb_type);
 static void ProcessSwitches(pugi::xml_node Node,
                             t_arch_switch_inf** Switches,
                             int* NumSwitches,
@@ -1797,11 +1808,6 @@ static void ProcessMode(vtr::string_internment* strings,
 
     /* Override if user specify */
     mode->disable_packing = get_attribute(Parent, "disable_packing", loc_data, ReqOpt::OPTIONAL).as_bool(mode->disable_packing);
-    if (true == mode->disable_packing) {
-        VTR_LOG("mode '%s[%s]' is defined by user to be disabled in packing\n",
-                mode->parent_pb_type->name,
-                mode->name);
-    }
 
     mode->num_pb_type_children = count_children(Parent, "pb_type", loc_data, ReqOpt::OPTIONAL);
     if (mode->num_pb_type_children > 0) {
@@ -1859,6 +1865,7 @@ static t_metadata_dict ProcessMetadata(vtr::string_internment* strings, pugi::xm
             auto key = get_attribute(meta_tag, "name", loc_data).as_string();
 
             auto value = meta_tag.child_value();
+            std::lock_guard<std::mutex> lock(metadata_strings_mutex);
             data.add(strings->intern_string(vtr::string_view(key)),
                      strings->intern_string(vtr::string_view(value)));
             meta_tag = meta_tag.next_sibling(meta_tag.name());
@@ -3579,8 +3586,8 @@ static void ProcessSubTiles(pugi::xml_node Node,
  * child type objects. */
 static void ProcessComplexBlocks(vtr::string_internment* strings, pugi::xml_node Node, std::vector<t_logical_block_type>& LogicalBlockTypes, t_arch& arch, const bool timing_enabled, const pugiutil::loc_data& loc_data) {
     pugi::xml_node CurBlockType;
-    pugi::xml_node Cur;
     std::map<std::string, int> pb_type_descriptors;
+    std::vector<pugi::xml_node> block_type_nodes;
 
     /* Alloc the type list. Need one additional t_type_desctiptors:
      * 1: empty psuedo-type
@@ -3594,8 +3601,6 @@ static void ProcessComplexBlocks(vtr::string_internment* strings, pugi::xml_node
 
     CurBlockType = Node.first_child();
     while (CurBlockType) {
-        int pb_type_idx = 0;
-
         check_node(CurBlockType, "pb_type", loc_data);
 
         t_logical_block_type LogicalBlockType;
@@ -3612,10 +3617,9 @@ static void ProcessComplexBlocks(vtr::string_internment* strings, pugi::xml_node
                            "Duplicate pb_type descriptor name: '%s'.\n", LogicalBlockType.name);
         }
 
-        /* Load pb_type info to assign to the Logical Block Type */
+        /* The pb_type info is loaded below */
         LogicalBlockType.pb_type = new t_pb_type;
         LogicalBlockType.pb_type->name = vtr::strdup(LogicalBlockType.name);
-        ProcessPb_Type(strings, CurBlockType, LogicalBlockType.pb_type, nullptr, timing_enabled, arch, loc_data, pb_type_idx);
 
         LogicalBlockType.index = index;
 
@@ -3624,11 +3628,78 @@ static void ProcessComplexBlocks(vtr::string_internment* strings, pugi::xml_node
 
         /* Push newly created Types to corresponding vectors */
         LogicalBlockTypes.push_back(LogicalBlockType);
+        block_type_nodes.push_back(CurBlockType);
 
         /* Free this node and get its next sibling node */
         CurBlockType = CurBlockType.next_sibling(CurBlockType.name());
     }
     pb_type_descriptors.clear();
+
+    /* The pb_type hierarchies of the types are independent, so they are loaded concurrently.
+     * Their metadata strings are interned beforehand (in file order), so the string ids do
+     * not depend on the order the types are processed in. */
+    for (pugi::xml_node block_type_node : block_type_nodes) {
+        InternPb_TypeMetadataStrings(strings, block_type_node);
+    }
+
+    std::vector<std::exception_ptr> errors(block_type_nodes.size());
+    auto process_block_type = [&](size_t itype) {
+        try {
+            int pb_type_idx = 0;
+            ProcessPb_Type(strings, block_type_nodes[itype], LogicalBlockTypes[itype + 1].pb_type, nullptr, timing_enabled, arch, loc_data, pb_type_idx);
+        } catch (...) {
+            errors[itype] = std::current_exception();
+        }
+    };
+#ifdef ARCHFPGA_USE_TBB
+    tbb::parallel_for(size_t(0), block_type_nodes.size(), process_block_type);
+#else
+    for (size_t itype = 0; itype < block_type_nodes.size(); ++itype) {
+        process_block_type(itype);
+    }
+#endif
+
+    /* Report the disabled modes and the first error in file order, as a serial load would */
+    for (size_t itype = 0; itype < block_type_nodes.size(); ++itype) {
+        if (errors[itype]) {
+            std::rethrow_exception(errors[itype]);
+        }
+        LogDisabledPackingModes(LogicalBlockTypes[itype + 1].pb_type);
+    }
+}
+
+static void InternPb_TypeMetadataStrings(vtr::string_internment* strings, pugi::xml_node Parent) {
+    for (pugi::xml_node Cur : Parent.children()) {
+        if (0 == strcmp(Cur.name(), "metadata")) {
+            for (pugi::xml_node meta_tag : Cur.children("meta")) {
+                pugi::xml_attribute key = meta_tag.attribute("name");
+                if (key) {
+                    strings->intern_string(vtr::string_view(key.as_string()));
+                    strings->intern_string(vtr::string_view(meta_tag.child_value()));
+                }
+            }
+        } else {
+            InternPb_TypeMetadataStrings(strings, Cur);
+        }
+    }
+}
+
+static void LogDisabledPackingModes(const t_pb_type* pb_type) {
+    if (pb_type->blif_model != nullptr || pb_type->class_type != UNKNOWN_CLASS) {
+        /* Leaf pb_types (including the modes generated for the LUT and memory classes) are never disabled by the user */
+        return;
+    }
+    for (int i = 0; i < pb_type->num_modes; ++i) {
+        const t_mode* mode = &pb_type->modes[i];
+        if (true == mode->disable_packing) {
+            VTR_LOG("mode '%s[%s]' is defined by user to be disabled in packing\n",
+                    mode->parent_pb_type->name,
+                    mode->name);
+        }
+        for (int j = 0; j < mode->num_pb_type_children; ++j) {
+            LogDisabledPackingModes(&mode->pb_type_children[j]);
+        }
+    }
 }
 
 static void ProcessSegments(pugi::xml_node Parent,
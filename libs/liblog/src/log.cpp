@@ -7,6 +7,8 @@
 
 #include <stdio.h>
 #include <stdarg.h> /* Allows for variable arguments, necessary for wrapping printf */
+#include <mutex>
+#include <string>
 #include "log.h"
 
 #define LOG_DEFAULT_FILE_NAME "output.log"
@@ -15,12 +17,25 @@ static int log_warning = 0;
 static int log_error = 0;
 FILE* log_stream = nullptr;
 
+/* Serializes the writes (and message counts) of concurrent threads, so each message is written in one piece */
+static std::mutex log_mutex;
+
+/* Messages of the calling thread held back while it buffers its output (see log_set_thread_buffering) */
+static thread_local bool log_thread_buffering = false;
+static thread_local std::string log_thread_buffer;
+
 static void check_init();
+static std::string format_message(const char* message, va_list args);
+static void write_message(FILE* stream, const std::string& text);
+static void write_message_locked(FILE* stream, const std::string& text);
+static void flush_thread_buffer_locked();
 
 /* Set the output file of logger.
  * If different than current log file, close current log file and reopen to new log file
  */
 void log_set_output_file(const char* filename) {
+    std::lock_guard<std::mutex> lock(log_mutex);
+
     if (log_stream != nullptr) {
         fclose(log_stream);
     }
@@ -38,8 +53,11 @@ void log_set_output_file(const char* filename) {
 void log_print_direct(const char* message, ...) {
     va_list args;
     va_start(args, message);
-    vprintf(message, args);
+    std::string text = format_message(message, args);
     va_end(args);
+
+    std::lock_guard<std::mutex> lock(log_mutex);
+    fputs(text.c_str(), stdout);
 }
 
 void log_print_info(const char* message, ...) {
@@ -47,16 +65,10 @@ void log_print_info(const char* message, ...) {
 
     va_list args;
     va_start(args, message);
-    vprintf(message, args);
+    std::string text = format_message(message, args);
     va_end(args);
 
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        vfprintf(log_stream, message, args);
-        va_end(args);
-
-        fflush(log_stream);
-    }
+    write_message(stdout, text);
 }
 
 void log_print_warning(const char* /*filename*/, unsigned int /*line_num*/, const char* message, ...) {
@@ -64,20 +76,16 @@ void log_print_warning(const char* /*filename*/, unsigned int /*line_num*/, cons
 
     va_list args;
     va_start(args, message);
-    log_warning++;
-
-    printf("Warning %d: ", log_warning);
-    vprintf(message, args);
+    std::string text = format_message(message, args);
     va_end(args);
 
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        fprintf(log_stream, "Warning %d: ", log_warning);
-        vfprintf(log_stream, message, args);
-
-        va_end(args);
-        fflush(log_stream);
+    int warning_num;
+    {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        warning_num = ++log_warning;
     }
+
+    write_message(stdout, "Warning " + std::to_string(warning_num) + ": " + text);
 }
 
 void log_print_error(const char* /*filename*/, unsigned int /*line_num*/, const char* message, ...) {
@@ -85,22 +93,27 @@ void log_print_error(const char* /*filename*/, unsigned int /*line_num*/, const
 
     va_list args;
     va_start(args, message);
-    log_error++;
-
-    check_init();
-    fprintf(stderr, "Error %d: ", log_error);
-    vfprintf(stderr, message, args);
+    std::string text = format_message(message, args);
     va_end(args);
 
-    if (log_stream) {
-        va_start(args, message); /* Must reset variable arguments so that they can be read again */
-        fprintf(log_stream, "Error %d: ", log_error);
-        vfprintf(log_stream, message, args);
+    /* Errors are never held back, but follow what the thread logged before */
+    std::lock_guard<std::mutex> lock(log_mutex);
+    flush_thread_buffer_locked();
 
-        va_end(args);
+    log_error++;
+    write_message_locked(stderr, "Error " + std::to_string(log_error) + ": " + text);
+}
 
-        fflush(log_stream);
+bool log_set_thread_buffering(bool enable) {
+    bool was_buffering = log_thread_buffering;
+    log_thread_buffering = enable;
+
+    if (was_buffering && !enable) {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        flush_thread_buffer_locked();
     }
+
+    return was_buffering;
 }
 
 /**
@@ -110,7 +123,52 @@ static void check_init() {
     //We now allow a nullptr log_stream (i.e. no log file) so nothing to do here
 }
 
+/* Returns the printf style message formatted with args */
+static std::string format_message(const char* message, va_list args) {
+    va_list args_copy;
+    va_copy(args_copy, args); /* Must copy variable arguments so that they can be read again */
+    int len = vsnprintf(nullptr, 0, message, args_copy);
+    va_end(args_copy);
+
+    if (len <= 0) {
+        return std::string();
+    }
+
+    std::string text(len, '\0');
+    vsnprintf(&text[0], len + 1, message, args);
+    return text;
+}
+
+/* Writes text to stream and the log file, or holds it back while the calling thread buffers its output */
+static void write_message(FILE* stream, const std::string& text) {
+    if (log_thread_buffering && stream == stdout) {
+        log_thread_buffer += text;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(log_mutex);
+    write_message_locked(stream, text);
+}
+
+static void write_message_locked(FILE* stream, const std::string& text) {
+    fputs(text.c_str(), stream);
+
+    if (log_stream) {
+        fputs(text.c_str(), log_stream);
+        fflush(log_stream);
+    }
+}
+
+static void flush_thread_buffer_locked() {
+    if (!log_thread_buffer.empty()) {
+        write_message_locked(stdout, log_thread_buffer);
+        log_thread_buffer.clear();
+    }
+}
+
 void log_close() {
+    std::lock_guard<std::mutex> lock(log_mutex);
+
     if (log_stream) {
         fclose(log_stream);
     }
@@ -17,6 +17,11 @@ void log_print_info(const char* message, ...);
 void log_print_warning(const char* filename, unsigned int line_num, const char* message, ...);
 void log_print_error(const char* filename, unsigned int line_num, const char* message, ...);
 
+/* While enabled, the messages of the calling thread are held back and written in one piece
+ * when it is disabled again, so that they do not interleave with those of other threads.
+ * Errors are never held back.  Returns whether the thread was buffering before. */
+bool log_set_thread_buffering(bool enable);
+
 void log_close();
 
 #endif
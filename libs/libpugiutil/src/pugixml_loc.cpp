@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <cstring>
 #include <algorithm>
 #include "pugixml_util.hpp"
 #include "pugixml_loc.hpp"
@@ -7,43 +8,53 @@ namespace pugiutil {
 
 //Return the line number from the given offset
 std::size_t loc_data::line(std::ptrdiff_t offset) const {
-    auto it = std::lower_bound(offsets_.begin(), offsets_.end(), offset);
-    std::size_t index = it - offsets_.begin();
+    const auto& offsets = newlines();
+    auto it = std::lower_bound(offsets.begin(), offsets.end(), offset);
+    std::size_t index = it - offsets.begin();
 
-    return 1 + index;
+    return first_line_ + index;
 }
 
 //Return the column number from the given offset
 std::size_t loc_data::col(std::ptrdiff_t offset) const {
-    auto it = std::lower_bound(offsets_.begin(), offsets_.end(), offset);
-    std::size_t index = it - offsets_.begin();
+    const auto& offsets = newlines();
+    auto it = std::lower_bound(offsets.begin(), offsets.end(), offset);
+    std::size_t index = it - offsets.begin();
 
-    return index == 0 ? offset + 1 : offset - offsets_[index - 1];
+    return index == 0 ? offset + 1 : offset - offsets[index - 1];
 }
 
-void loc_data::build_loc_data() {
-    FILE* f = fopen(filename_.c_str(), "rb");
+const std::vector<std::ptrdiff_t>& loc_data::newlines() const {
+    std::call_once(offsets_->built, [this]() { build_loc_data(); });
+    return offsets_->newlines;
+}
 
-    if (f == nullptr) {
-        throw XmlError("Failed to open file", filename_);
-    }
+void loc_data::build_loc_data() const {
+    //Without a file (e.g. a default constructed location data, or a file removed since
+    //it was parsed) every offset is reported on the first line
+    if (filename_.empty()) return;
+    FILE* f = fopen(filename_.c_str(), "rb");
+    if (f == nullptr) return;
 
     std::ptrdiff_t offset = 0;
 
-    char buffer[1024];
+    std::vector<char> buffer(1 << 16);
     std::size_t size;
 
-    while ((size = fread(buffer, 1, sizeof(buffer), f)) > 0) {
-        for (std::size_t i = 0; i < size; ++i) {
-            if (buffer[i] == '\n') {
-                offsets_.push_back(offset + i);
-            }
-        }
-
+    while ((size = fread(buffer.data(), 1, buffer.size(), f)) > 0) {
+        build_loc_data(buffer.data(), size, offset);
         offset += size;
     }
 
     fclose(f);
 }
 
+void loc_data::build_loc_data(const char* buffer, std::size_t size, std::ptrdiff_t buffer_offset) const {
+    //memchr is vectorized by the C library, and newlines are sparse
+    const char* end = buffer + size;
+    for (const char* p = buffer; (p = static_cast<const char*>(std::memchr(p, '\n', end - p))) != nullptr; ++p) {
+        offsets_->newlines.push_back(buffer_offset + (p - buffer));
+    }
+}
+
 } // namespace pugiutil
@@ -5,19 +5,38 @@
  * hanlding the retrieval of line numbers (useful for error messages)
  */
 
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 #include "pugixml.hpp"
 
 namespace pugiutil {
 
 //pugi offset to line/col data based on: https://stackoverflow.com/questions/21003471/convert-pugixmls-result-offset-to-column-line
+//
+//The line offsets of a file are only needed to report locations (mostly errors), so they
+//are built on the first query rather than by re-reading the (possibly very large) file
+//up front. Copies share the offsets.
 class loc_data {
   public:
-    loc_data() = default;
+    loc_data()
+        : offsets_(std::make_shared<t_offsets>()) {}
 
     loc_data(std::string filename_val)
-        : filename_(filename_val) {
-        build_loc_data();
+        : filename_(filename_val)
+        , offsets_(std::make_shared<t_offsets>()) {
+    }
+
+    //Location data of a fragment of filename held in buffer, which starts
+    //at line first_line of the file. Columns on the fragment's first line
+    //are relative to the start of the fragment.
+    loc_data(std::string filename_val, const char* buffer, std::size_t size, std::size_t first_line = 1)
+        : filename_(filename_val)
+        , first_line_(first_line)
+        , offsets_(std::make_shared<t_offsets>()) {
+        //The buffer may not outlive the location data, so its offsets are built now
+        std::call_once(offsets_->built, [&]() { build_loc_data(buffer, size); });
     }
 
     //The filename this location data is for
@@ -41,10 +60,20 @@ class loc_data {
     std::size_t col(std::ptrdiff_t offset) const;
 
   private:
-    void build_loc_data();
+    struct t_offsets {
+        std::once_flag built;
+        std::vector<std::ptrdiff_t> newlines; //Offsets of the newlines
+    };
+
+    //The newline offsets, built on first use
+    const std::vector<std::ptrdiff_t>& newlines() const;
+
+    void build_loc_data() const;
+    void build_loc_data(const char* buffer, std::size_t size, std::ptrdiff_t buffer_offset = 0) const;
 
     std::string filename_;
-    std::vector<std::ptrdiff_t> offsets_;
+    std::size_t first_line_ = 1;
+    std::shared_ptr<t_offsets> offsets_;
 };
 } // namespace pugiutil
 
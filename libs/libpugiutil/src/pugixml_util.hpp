@@ -51,6 +51,16 @@ class XmlError : public std::runtime_error {
 loc_data load_xml(pugi::xml_document& doc,     //Document object to be loaded with file contents
                   const std::string filename); //Filename to load from
 
+//Loads a fragment of an XML file held in buffer into the passed pugi::xml_document
+//
+//Returns loc_data look-up for xml node line numbers, offset so they
+//refer to the lines of the file the fragment starts at first_line of
+loc_data load_xml_buffer(pugi::xml_document& doc,    //Document object to be loaded with the fragment
+                         const std::string filename, //Filename the fragment was read from
+                         const char* buffer,         //Fragment contents
+                         std::size_t size,           //Fragment size in bytes
+                         std::size_t first_line);    //Line of the file the fragment starts at
+
 //Defines whether something (e.g. a node/attribute) is optional or required.
 //  We use this to improve clarity at the function call site (compared to just
 //  using boolean values).
@@ -1,3 +1,6 @@
+#include <atomic>
+#include <exception>
+
 #include "vtr_log.h"
 #include "vtr_memory.h"
 #include "vtr_util.h"
@@ -10,8 +13,26 @@
 
 #include "describe_rr_node.h"
 
+#ifdef RRGRAPH_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 /*********************** Subroutines local to this module *******************/
 
+///@brief Number of consecutive rr nodes checked together by check_rr_graph()
+static constexpr size_t CHECK_RR_GRAPH_CHUNK_SIZE = 4096;
+
+static void check_rr_node_connectivity(const RRGraphView& rr_graph,
+                                       const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                       const DeviceGrid& grid,
+                                       const t_chan_width& chan_width,
+                                       const e_route_type route_type,
+                                       const int virtual_clock_network_root_idx,
+                                       bool is_flat,
+                                       RRNodeId rr_node,
+                                       std::vector<std::pair<int, int>>& edges,
+                                       std::vector<std::atomic<int>>& total_edges_to_node);
+
 static bool rr_node_is_global_clb_ipin(const RRGraphView& rr_graph, const DeviceGrid& grid, RRNodeId inode);
 
 static void check_unbuffered_edges(const RRGraphView& rr_graph, int from_node);
@@ -60,165 +81,45 @@ void check_rr_graph(const RRGraphView& rr_graph,
         route_type = GLOBAL;
     }
 
-    auto total_edges_to_node = std::vector<int>(rr_graph.num_nodes());
-    auto switch_types_from_current_to_node = std::vector<unsigned char>(rr_graph.num_nodes());
-    const int num_rr_switches = rr_graph.num_rr_switches();
-
-    std::vector<std::pair<int, int>> edges;
-
-    for (const RRNodeId& rr_node : rr_graph.nodes()) {
-        size_t inode = (size_t)rr_node;
-        rr_graph.validate_node(rr_node);
-
-        /* Ignore any uninitialized rr_graph nodes */
-        if (!rr_graph.node_is_initialized(rr_node)) {
-            continue;
-        }
-
-        // Virtual clock network sink is special, ignore.
-        if (virtual_clock_network_root_idx == int(inode)) {
-            continue;
-        }
-
-        t_rr_type rr_type = rr_graph.node_type(rr_node);
-        int num_edges = rr_graph.num_edges(RRNodeId(inode));
-
-        check_rr_node(rr_graph, rr_indexed_data, grid, chan_width, route_type, inode, is_flat);
-
-        /* Check all the connectivity (edges, etc.) information.                    */
-        edges.resize(0);
-        edges.reserve(num_edges);
-
-        for (int iedge = 0; iedge < num_edges; iedge++) {
-            int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
-
-            if (to_node < 0 || to_node >= (int)rr_graph.num_nodes()) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_rr_graph: node %d has an edge %d.\n"
-                                "\tEdge is out of range.\n",
-                                inode, to_node);
-            }
-
-            check_rr_edge(rr_graph,
-                          grid,
-                          rr_indexed_data,
-                          inode,
-                          iedge,
-                          to_node,
-                          is_flat);
-
-            edges.emplace_back(to_node, iedge);
-            total_edges_to_node[to_node]++;
-
-            auto switch_type = rr_graph.edge_switch(rr_node, iedge);
-
-            if (switch_type < 0 || switch_type >= num_rr_switches) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_rr_graph: node %d has a switch type %d.\n"
-                                "\tSwitch type is out of range.\n",
-                                inode, switch_type);
-            }
-        } /* End for all edges of node. */
-
-        std::sort(edges.begin(), edges.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
-            return lhs.first < rhs.first;
-        });
-
-        //Check that multiple edges between the same from/to nodes make sense
-        for (int iedge = 0; iedge < num_edges; iedge++) {
-            int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
-
-            auto range = std::equal_range(edges.begin(), edges.end(),
-                                          to_node, node_edge_sorter());
-
-            size_t num_edges_to_node = std::distance(range.first, range.second);
-
-            if (num_edges_to_node == 1) continue; //Single edges are always OK
-
-            VTR_ASSERT_MSG(num_edges_to_node > 1, "Expect multiple edges");
-
-            t_rr_type to_rr_type = rr_graph.node_type(RRNodeId(to_node));
-
-            /* It is unusual to have more than one programmable switch (in the same direction) between a from_node and a to_node,
-             * as the duplicate switch doesn't add more routing flexibility.
-             *
-             * However, such duplicate switches can occur for some types of nodes, which we allow below.
-             * Reasons one could have duplicate switches between two nodes include:
-             *      - The two switches have different electrical characteristics.
-             *      - Wires near the edges of an FPGA are often cut off, and the stubs connected together.
-             *        A regular switch pattern could then result in one physical wire connecting multiple
-             *        times to other wires, IPINs or OPINs.
-             *
-             * Only expect the following cases to have multiple edges
-             * - CHAN <-> CHAN connections
-             * - CHAN  -> IPIN connections (unique rr_node for IPIN nodes on multiple sides)
-             * - OPIN  -> CHAN connections (unique rr_node for OPIN nodes on multiple sides)
-             */
-            bool is_chan_to_chan = (rr_type == CHANX || rr_type == CHANY) && (to_rr_type == CHANY || to_rr_type == CHANX);
-            bool is_chan_to_ipin = (rr_type == CHANX || rr_type == CHANY) && to_rr_type == IPIN;
-            bool is_opin_to_chan = rr_type == OPIN && (to_rr_type == CHANX || to_rr_type == CHANY);
-            bool is_internal_edge = false;
-            if (is_flat) {
-                is_internal_edge = (rr_type == IPIN && to_rr_type == IPIN) || (rr_type == OPIN && to_rr_type == OPIN);
-            }
-            if (!(is_chan_to_chan || is_chan_to_ipin || is_opin_to_chan || is_internal_edge)) {
-                VPR_ERROR(VPR_ERROR_ROUTE,
-                          "in check_rr_graph: node %d (%s) connects to node %d (%s) %zu times - multi-connections only expected for CHAN<->CHAN, CHAN->IPIN, OPIN->CHAN.\n",
-                          inode, rr_node_typename[rr_type], to_node, rr_node_typename[to_rr_type], num_edges_to_node);
-            }
-
-            //Between two wire segments
-            VTR_ASSERT_MSG(to_rr_type == CHANX || to_rr_type == CHANY || to_rr_type == IPIN, "Expect channel type or input pin type");
-            VTR_ASSERT_MSG(rr_type == CHANX || rr_type == CHANY || rr_type == OPIN, "Expect channel type or output pin type");
-
-            //While multiple connections between the same wires can be electrically legal,
-            //they are redundant if they are of the same switch type.
-            //
-            //Identify any such edges with identical switches
-            std::map<short, int> switch_counts;
-            for (const auto& to_edge : vtr::Range<decltype(edges)::const_iterator>(range.first, range.second)) {
-                auto edge = to_edge.second;
-                auto edge_switch = rr_graph.edge_switch(rr_node, edge);
-
-                switch_counts[edge_switch]++;
-            }
-
-            //Tell the user about any redundant edges
-            for (auto kv : switch_counts) {
-                if (kv.second <= 1) continue;
-
-                /* Redundant edges are not allowed for chan <-> chan connections
-                 * but allowed for input pin <-> chan or output pin <-> chan connections 
-                 */
-                if ((to_rr_type == CHANX || to_rr_type == CHANY)
-                    && (rr_type == CHANX || rr_type == CHANY)) {
-                    auto switch_type = rr_graph.rr_switch_inf(RRSwitchId(kv.first)).type();
-
-                    VPR_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d has %d redundant connections to node %d of switch type %d (%s)",
-                              inode, kv.second, to_node, kv.first, SWITCH_TYPE_STRINGS[size_t(switch_type)]);
-                }
-            }
-        }
-
-        /* Slow test could leave commented out most of the time. */
-        check_unbuffered_edges(rr_graph, inode);
-
-        //Check that all config/non-config edges are appropriately organized
-        for (auto edge : rr_graph.configurable_edges(RRNodeId(inode))) {
-            if (!rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is non-configurable, but in configurable edges",
-                                inode, edge);
+    //Fan-in of each node, counted by the (possibly concurrent) checks of its driving nodes
+    auto total_edges_to_node = std::vector<std::atomic<int>>(rr_graph.num_nodes());
+
+    /* The nodes are checked in fixed size chunks, in parallel if possible. Each chunk stops at its
+     * first error, and the error of the first failing chunk is re-thrown afterwards, so the error
+     * reported is the same as if the nodes had been checked in order. Errors demoted to warnings
+     * (e.g. by --disable_errors) may however be logged in any order. */
+    size_t num_nodes = rr_graph.num_nodes();
+    size_t num_chunks = (num_nodes + CHECK_RR_GRAPH_CHUNK_SIZE - 1) / CHECK_RR_GRAPH_CHUNK_SIZE;
+    std::vector<std::exception_ptr> chunk_errors(num_chunks);
+
+    auto check_chunk = [&](size_t ichunk) {
+        std::vector<std::pair<int, int>> edges;
+        size_t end_node = std::min(num_nodes, (ichunk + 1) * CHECK_RR_GRAPH_CHUNK_SIZE);
+        try {
+            for (size_t inode = ichunk * CHECK_RR_GRAPH_CHUNK_SIZE; inode < end_node; inode++) {
+                check_rr_node_connectivity(rr_graph, rr_indexed_data, grid, chan_width, route_type,
+                                           virtual_clock_network_root_idx, is_flat, RRNodeId(inode),
+                                           edges, total_edges_to_node);
             }
+        } catch (...) {
+            chunk_errors[ichunk] = std::current_exception();
         }
+    };
+
+#ifdef RRGRAPH_USE_TBB
+    tbb::parallel_for(size_t(0), num_chunks, check_chunk);
+#else
+    for (size_t ichunk = 0; ichunk < num_chunks; ichunk++) {
+        check_chunk(ichunk);
+        if (chunk_errors[ichunk]) break;
+    }
+#endif
 
-        for (auto edge : rr_graph.non_configurable_edges(RRNodeId(inode))) {
-            if (rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is configurable, but in non-configurable edges",
-                                inode, edge);
-            }
+    for (const std::exception_ptr& chunk_error : chunk_errors) {
+        if (chunk_error) {
+            std::rethrow_exception(chunk_error);
         }
-
-    } /* End for all rr_nodes */
+    }
 
     // AM: For the time being, if is_flat is enabled, we don't have proper tests to check whether a node should have an incoming
     // edge or not
@@ -248,8 +149,10 @@ void check_rr_graph(const RRGraphView& rr_graph,
             }
         }
 
+        int fan_in = total_edges_to_node[inode].load(std::memory_order_relaxed);
+
         if (rr_type != SOURCE) {
-            if (total_edges_to_node[inode] < 1 && !rr_node_is_global_clb_ipin(rr_graph, grid, rr_node)) {
+            if (fan_in < 1 && !rr_node_is_global_clb_ipin(rr_graph, grid, rr_node)) {
                 /* A global CLB input pin will not have any edges, and neither will  *
                  * a SOURCE or the start of a carry-chain.  Anything else is an error.
                  * For simplicity, carry-chain input pin are entirely ignored in this test
@@ -301,15 +204,182 @@ void check_rr_graph(const RRGraphView& rr_graph,
                 }
             }
         } else { /* SOURCE.  No fanin for now; change if feedthroughs allowed. */
-            if (total_edges_to_node[inode] != 0) {
+            if (fan_in != 0) {
                 VTR_LOG_ERROR("in check_rr_graph: SOURCE node %d has a fanin of %d, expected 0.\n",
-                              inode, total_edges_to_node[inode]);
+                              inode, fan_in);
             }
         }
     }
 
 }
 
+/* Checks rr_node and its out-going edges, adding the edges to the fan-in counts of their sink nodes.
+ * edges is scratch space, re-used between calls. */
+static void check_rr_node_connectivity(const RRGraphView& rr_graph,
+                                       const vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
+                                       const DeviceGrid& grid,
+                                       const t_chan_width& chan_width,
+                                       const e_route_type route_type,
+                                       const int virtual_clock_network_root_idx,
+                                       bool is_flat,
+                                       RRNodeId rr_node,
+                                       std::vector<std::pair<int, int>>& edges,
+                                       std::vector<std::atomic<int>>& total_edges_to_node) {
+    const int num_rr_switches = rr_graph.num_rr_switches();
+
+    size_t inode = (size_t)rr_node;
+    rr_graph.validate_node(rr_node);
+
+    /* Ignore any uninitialized rr_graph nodes */
+    if (!rr_graph.node_is_initialized(rr_node)) {
+        return;
+    }
+
+    // Virtual clock network sink is special, ignore.
+    if (virtual_clock_network_root_idx == int(inode)) {
+        return;
+    }
+
+    t_rr_type rr_type = rr_graph.node_type(rr_node);
+    int num_edges = rr_graph.num_edges(RRNodeId(inode));
+
+    check_rr_node(rr_graph, rr_indexed_data, grid, chan_width, route_type, inode, is_flat);
+
+    /* Check all the connectivity (edges, etc.) information.                    */
+    edges.resize(0);
+    edges.reserve(num_edges);
+
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+
+        if (to_node < 0 || to_node >= (int)rr_graph.num_nodes()) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_rr_graph: node %d has an edge %d.\n"
+                            "\tEdge is out of range.\n",
+                            inode, to_node);
+        }
+
+        check_rr_edge(rr_graph,
+                      grid,
+                      rr_indexed_data,
+                      inode,
+                      iedge,
+                      to_node,
+                      is_flat);
+
+        edges.emplace_back(to_node, iedge);
+        total_edges_to_node[to_node].fetch_add(1, std::memory_order_relaxed);
+
+        auto switch_type = rr_graph.edge_switch(rr_node, iedge);
+
+        if (switch_type < 0 || switch_type >= num_rr_switches) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_rr_graph: node %d has a switch type %d.\n"
+                            "\tSwitch type is out of range.\n",
+                            inode, switch_type);
+        }
+    } /* End for all edges of node. */
+
+    std::sort(edges.begin(), edges.end(), [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    //Check that multiple edges between the same from/to nodes make sense
+    for (int iedge = 0; iedge < num_edges; iedge++) {
+        int to_node = size_t(rr_graph.edge_sink_node(rr_node, iedge));
+
+        auto range = std::equal_range(edges.begin(), edges.end(),
+                                      to_node, node_edge_sorter());
+
+        size_t num_edges_to_node = std::distance(range.first, range.second);
+
+        if (num_edges_to_node == 1) continue; //Single edges are always OK
+
+        VTR_ASSERT_MSG(num_edges_to_node > 1, "Expect multiple edges");
+
+        t_rr_type to_rr_type = rr_graph.node_type(RRNodeId(to_node));
+
+        /* It is unusual to have more than one programmable switch (in the same direction) between a from_node and a to_node,
+         * as the duplicate switch doesn't add more routing flexibility.
+         *
+         * However, such duplicate switches can occur for some types of nodes, which we allow below.
+         * Reasons one could have duplicate switches between two nodes include:
+         *      - The two switches have different electrical characteristics.
+         *      - Wires near the edges of an FPGA are often cut off, and the stubs connected together.
+         *        A regular switch pattern could then result in one physical wire connecting multiple
+         *        times to other wires, IPINs or OPINs.
+         *
+         * Only expect the following cases to have multiple edges
+         * - CHAN <-> CHAN connections
+         * - CHAN  -> IPIN connections (unique rr_node for IPIN nodes on multiple sides)
+         * - OPIN  -> CHAN connections (unique rr_node for OPIN nodes on multiple sides)
+         */
+        bool is_chan_to_chan = (rr_type == CHANX || rr_type == CHANY) && (to_rr_type == CHANY || to_rr_type == CHANX);
+        bool is_chan_to_ipin = (rr_type == CHANX || rr_type == CHANY) && to_rr_type == IPIN;
+        bool is_opin_to_chan = rr_type == OPIN && (to_rr_type == CHANX || to_rr_type == CHANY);
+        bool is_internal_edge = false;
+        if (is_flat) {
+            is_internal_edge = (rr_type == IPIN && to_rr_type == IPIN) || (rr_type == OPIN && to_rr_type == OPIN);
+        }
+        if (!(is_chan_to_chan || is_chan_to_ipin || is_opin_to_chan || is_internal_edge)) {
+            VPR_ERROR(VPR_ERROR_ROUTE,
+                      "in check_rr_graph: node %d (%s) connects to node %d (%s) %zu times - multi-connections only expected for CHAN<->CHAN, CHAN->IPIN, OPIN->CHAN.\n",
+                      inode, rr_node_typename[rr_type], to_node, rr_node_typename[to_rr_type], num_edges_to_node);
+        }
+
+        //Between two wire segments
+        VTR_ASSERT_MSG(to_rr_type == CHANX || to_rr_type == CHANY || to_rr_type == IPIN, "Expect channel type or input pin type");
+        VTR_ASSERT_MSG(rr_type == CHANX || rr_type == CHANY || rr_type == OPIN, "Expect channel type or output pin type");
+
+        //While multiple connections between the same wires can be electrically legal,
+        //they are redundant if they are of the same switch type.
+        //
+        //Identify any such edges with identical switches
+        std::map<short, int> switch_counts;
+        for (const auto& to_edge : vtr::Range<std::vector<std::pair<int, int>>::const_iterator>(range.first, range.second)) {
+            auto edge = to_edge.second;
+            auto edge_switch = rr_graph.edge_switch(rr_node, edge);
+
+            switch_counts[edge_switch]++;
+        }
+
+        //Tell the user about any redundant edges
+        for (auto kv : switch_counts) {
+            if (kv.second <= 1) continue;
+
+            /* Redundant edges are not allowed for chan <-> chan connections
+             * but allowed for input pin <-> chan or output pin <-> chan connections 
+             */
+            if ((to_rr_type == CHANX || to_rr_type == CHANY)
+                && (rr_type == CHANX || rr_type == CHANY)) {
+                auto switch_type = rr_graph.rr_switch_inf(RRSwitchId(kv.first)).type();
+
+                VPR_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d has %d redundant connections to node %d of switch type %d (%s)",
+                          inode, kv.second, to_node, kv.first, SWITCH_TYPE_STRINGS[size_t(switch_type)]);
+            }
+        }
+    }
+
+    /* Slow test could leave commented out most of the time. */
+    check_unbuffered_edges(rr_graph, inode);
+
+    //Check that all config/non-config edges are appropriately organized
+    for (auto edge : rr_graph.configurable_edges(RRNodeId(inode))) {
+        if (!rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is non-configurable, but in configurable edges",
+                            inode, edge);
+        }
+    }
+
+    for (auto edge : rr_graph.non_configurable_edges(RRNodeId(inode))) {
+        if (rr_graph.edge_is_configurable(RRNodeId(inode), edge)) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "in check_rr_graph: node %d edge %d is configurable, but in non-configurable edges",
+                            inode, edge);
+        }
+    }
+
+}
+
 static bool rr_node_is_global_clb_ipin(const RRGraphView& rr_graph, const DeviceGrid& grid, RRNodeId inode) {
     /* Returns true if inode refers to a global CLB input pin node.   */
 
@@ -3,12 +3,55 @@
 #include "vtr_time.h"
 #include <queue>
 #include <random>
+#include <algorithm>
+#include <cstdlib>
 //#include <algorithm>
 
 //#include "globals.h"
 
 RRGraphBuilder::RRGraphBuilder() {}
 
+/* Returns the distance of (x, y) along the Hilbert curve covering the n x n grid (n a power of 2) */
+static uint64_t hilbert_index(uint32_t n, uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += uint64_t(s) * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/* Logs the average id distance between the source and sink of the edges, and the share of edges
+ * whose sink node data is in the same 4 KiB block as the source's: a rough estimate of how often
+ * the router finds the sink's data in a cache line it recently loaded. */
+static void log_edge_locality(const t_rr_graph_storage& node_storage, const char* when) {
+    constexpr size_t nodes_per_block = 4096 / sizeof(t_rr_node_data);
+    size_t num_edges = 0;
+    size_t num_near_edges = 0;
+    double total_distance = 0.;
+    for (size_t i = 0; i < node_storage.size(); ++i) {
+        RRNodeId u(i);
+        for (RREdgeId edge = node_storage.first_edge(u); edge < node_storage.last_edge(u); edge = RREdgeId(size_t(edge) + 1)) {
+            size_t v = size_t(node_storage.edge_sink_node(edge));
+            total_distance += (v > i) ? v - i : i - v;
+            num_near_edges += (v / nodes_per_block == i / nodes_per_block);
+            ++num_edges;
+        }
+    }
+    if (num_edges == 0) return;
+    VTR_LOG("RR graph edge locality %s reordering: average node id distance %g, %.2f%% of edges within a 4 KiB node block\n",
+            when, total_distance / num_edges, 100. * num_near_edges / num_edges);
+}
+
 t_rr_graph_storage& RRGraphBuilder::rr_nodes() {
     return node_storage_;
 }
@@ -87,6 +130,7 @@ void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_
     size_t v_num = node_storage_.size();
     if (reorder_rr_graph_nodes_threshold < 0 || v_num < (size_t)reorder_rr_graph_nodes_threshold) return;
     vtr::ScopedStartFinishTimer timer("Reordering rr_graph nodes");
+    log_edge_locality(node_storage_, "before");
     vtr::vector<RRNodeId, RRNodeId> src_order(v_num); // new id -> old id
     size_t cur_idx = 0;
     for (RRNodeId& n : src_order) { // Initialize to [0, 1, 2 ...]
@@ -131,6 +175,30 @@ void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_
     } else if (reorder_rr_graph_nodes_algorithm == RANDOM_SHUFFLE) {
         std::mt19937 g(reorder_rr_graph_nodes_seed);
         std::shuffle(src_order.begin(), src_order.end(), g);
+    } else if (reorder_rr_graph_nodes_algorithm == SPATIAL_HILBERT) {
+        // The curve covers the smallest power of 2 square containing every node's (xlow, ylow)
+        uint32_t grid_size = 1;
+        for (size_t i = 0; i < v_num; ++i) {
+            RRNodeId u(i);
+            uint32_t max_coord = std::max<int>(0, std::max(node_storage_.node_xlow(u), node_storage_.node_ylow(u)));
+            while (grid_size <= max_coord) grid_size *= 2;
+        }
+
+        vtr::vector<RRNodeId, uint64_t> curve_idx(v_num);
+        for (size_t i = 0; i < v_num; ++i) {
+            RRNodeId u(i);
+            curve_idx[u] = hilbert_index(grid_size,
+                                         std::max<int>(0, node_storage_.node_xlow(u)),
+                                         std::max<int>(0, node_storage_.node_ylow(u)));
+        }
+
+        // Sort by layer, then curve position, then type; the original order breaks ties
+        std::sort(src_order.begin(), src_order.end(),
+                  [&](RRNodeId a, RRNodeId b) -> bool {
+                      auto key_a = std::make_tuple(node_storage_.node_layer(a), curve_idx[a], node_storage_.node_type(a), size_t(a));
+                      auto key_b = std::make_tuple(node_storage_.node_layer(b), curve_idx[b], node_storage_.node_type(b), size_t(b));
+                      return key_a < key_b;
+                  });
     }
     vtr::vector<RRNodeId, RRNodeId> dest_order(v_num);
     cur_idx = 0;
@@ -142,6 +210,7 @@ void RRGraphBuilder::reorder_nodes(e_rr_node_reorder_algorithm reorder_rr_graph_
     VTR_ASSERT_SAFE(node_storage_.validate(rr_switch_inf_));
 
     node_lookup().reorder(dest_order);
+    log_edge_locality(node_storage_, "after");
 
     rr_node_metadata().remap_keys([&](int node) { return size_t(dest_order[RRNodeId(node)]); });
     rr_edge_metadata().remap_keys([&](std::tuple<int, int, short> edge) {
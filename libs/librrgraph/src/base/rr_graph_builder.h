@@ -135,6 +135,16 @@ class RRGraphBuilder {
 
     /** @brief Clear all the underlying data storage */
     void clear();
+
+    /** @brief Return the (estimated) heap memory used by the nodes and edges, in bytes */
+    size_t storage_memory_usage() const {
+        return node_storage_.memory_usage();
+    }
+
+    /** @brief Return the (estimated) heap memory used by the fast look-up of the nodes (node_lookup()), in bytes */
+    size_t node_lookup_memory_usage() const {
+        return node_lookup_.memory_usage();
+    }
     /** @brief reorder all the nodes
      * Reordering the rr-graph nodes may be helpful in
      *   - Increasing cache locality during routing
@@ -142,6 +152,9 @@ class RRGraphBuilder {
      * Reorder RRNodeId's using one of these algorithms:
      *   - DEGREE_BFS: Order by degree primarily, and BFS traversal order secondarily.
      *   - RANDOM_SHUFFLE: Shuffle using the specified seed. Great for testing.
+     *   - SPATIAL_HILBERT: Order by layer, then by the position of (xlow, ylow) along a Hilbert
+     *     curve covering the device, then by type. The router expands nodes which are close on
+     *     the device, which this keeps close in memory.
      * The DEGREE_BFS algorithm was selected because it had the best performance of seven
      * existing algorithms here: https://github.com/SymbiFlow/vtr-rrgraph-reordering-tool
      * It might be worth further research, as the DEGREE_BFS algorithm is simple and
@@ -152,6 +165,10 @@ class RRGraphBuilder {
      * in the rr-graph before routing we check that no code depends on the rr-graph node order
      * Nonetheless, it does improve performance ~7% for the SymbiFlow Xilinx Artix 7 graph.
      *
+     * The edge locality of the graph (average node id distance between the source and sink of the
+     * edges, and the share of edges whose sink node data is near the source's) is logged before
+     * and after reordering, to measure what the reordering buys.
+     *
      * NOTE: Re-ordering will invalidate any references to rr_graph nodes, so this
      *       should generally be called before creating such references.
      */
@@ -336,6 +353,18 @@ class RRGraphBuilder {
         node_storage_.init_fan_in();
     }
 
+    /** @brief Build the reverse adjacency (in-edges) of the rr-graph. Must be called after
+     * partition_edges(). Views made before this call do not see the in-edges. */
+    inline void init_in_edges() {
+        node_storage_.init_in_edges();
+    }
+
+    /** @brief Compress the edge storage of the complete rr-graph for read-only use (see
+     * t_rr_graph_storage::compress_edges()). Views made before this call must be re-made. */
+    inline void compress_edges() {
+        node_storage_.compress_edges();
+    }
+
     /** @brief Disable the flags which would prevent adding adding extra-resources, when flat-routing
      * is enabled, to the RR Graph
      * @note
@@ -5,6 +5,7 @@
 #include <algorithm>
 
 void t_rr_graph_storage::reserve_edges(size_t num_edges) {
+    decompress_edges();
     edge_src_node_.reserve(num_edges);
     edge_dest_node_.reserve(num_edges);
     edge_switch_.reserve(num_edges);
@@ -402,10 +403,108 @@ void t_rr_graph_storage::init_fan_in() {
     node_fan_in_.shrink_to_fit();
     //Walk the graph and increment fanin on all downstream nodes
     for(const auto& edge_id : edge_dest_node_.keys()) {
-        node_fan_in_[edge_dest_node_[edge_id]] += 1;
+        node_fan_in_[edge_sink_node(edge_id)] += 1;
     }
 }
 
+void t_rr_graph_storage::init_in_edges() {
+    VTR_ASSERT(partitioned_);
+    if (has_in_edges()) {
+        return;
+    }
+
+    // Counting sort of the edges by sink node. Edges are visited in increasing id
+    // order, so the in-edges of each node are also sorted by id.
+    node_first_in_edge_.resize(node_storage_.size() + 1, 0);
+    for (const auto& edge_id : edge_dest_node_.keys()) {
+        node_first_in_edge_[RRNodeId(size_t(edge_sink_node(edge_id)) + 1)] += 1;
+    }
+    for (size_t inode = 1; inode < node_first_in_edge_.size(); inode++) {
+        node_first_in_edge_[RRNodeId(inode)] += node_first_in_edge_[RRNodeId(inode - 1)];
+    }
+
+    std::vector<uint32_t> next_slot(node_first_in_edge_.begin(), node_first_in_edge_.end() - 1);
+    node_in_edges_.resize(edge_dest_node_.size());
+    for (const auto& edge_id : edge_dest_node_.keys()) {
+        node_in_edges_[next_slot[size_t(edge_sink_node(edge_id))]++] = edge_id;
+    }
+}
+
+/* Number of bits needed to represent the values [0, num_values) */
+static size_t num_bits_for(size_t num_values) {
+    size_t num_bits = 0;
+    while (num_bits < 64 && (size_t(1) << num_bits) < num_values) {
+        ++num_bits;
+    }
+    return num_bits;
+}
+
+void t_rr_graph_storage::compress_edges() {
+    VTR_ASSERT(partitioned_);
+    if (edges_compressed_) {
+        return;
+    }
+
+    // The source nodes are implied by node_first_edge_
+    edge_src_node_ = vtr::vector<RREdgeId, RRNodeId>();
+
+    short max_switch = 0;
+    for (short edge_switch : edge_switch_) {
+        // Negative (unset) switches can not be compressed
+        VTR_ASSERT(edge_switch >= 0);
+        max_switch = std::max(max_switch, edge_switch);
+    }
+
+    size_t node_bits = num_bits_for(node_storage_.size());
+    size_t switch_bits = std::max<size_t>(num_bits_for(size_t(max_switch) + 1), 1);
+    if (node_bits + switch_bits <= 32) {
+        // Pack the switch into the high bits of the destination
+        edge_switch_shift_ = node_bits;
+        edge_dest_mask_ = (uint32_t(1) << node_bits) - 1;
+        for (const auto& edge : edge_dest_node_.keys()) {
+            edge_dest_node_[edge] = RRNodeId(size_t(edge_dest_node_[edge]) | (size_t(edge_switch_[edge]) << node_bits));
+        }
+        edge_switch_ = vtr::vector<RREdgeId, short>();
+    } else if (max_switch <= std::numeric_limits<uint8_t>::max()) {
+        edge_switch_u8_.resize(edge_switch_.size());
+        for (const auto& edge : edge_switch_.keys()) {
+            edge_switch_u8_[edge] = edge_switch_[edge];
+        }
+        edge_switch_ = vtr::vector<RREdgeId, short>();
+    }
+
+    edges_compressed_ = true;
+}
+
+void t_rr_graph_storage::decompress_edges() {
+    if (!edges_compressed_) {
+        return;
+    }
+
+    size_t num_edges = edge_dest_node_.size();
+    edge_src_node_.resize(num_edges);
+    for (size_t inode = 0; inode < node_storage_.size(); inode++) {
+        RRNodeId node(inode);
+        for (RREdgeId edge : edge_range(node)) {
+            edge_src_node_[edge] = node;
+        }
+    }
+
+    if (edge_switch_.empty()) {
+        vtr::vector<RREdgeId, short> switches(num_edges);
+        for (const auto& edge : edge_dest_node_.keys()) {
+            switches[edge] = edge_switch(edge);
+            edge_dest_node_[edge] = edge_sink_node(edge);
+        }
+        edge_switch_ = std::move(switches);
+        edge_switch_u8_ = vtr::vector<RREdgeId, uint8_t>();
+    }
+    edge_dest_mask_ = std::numeric_limits<uint32_t>::max();
+    edge_switch_shift_ = 0;
+
+    edges_compressed_ = false;
+}
+
 size_t t_rr_graph_storage::count_rr_switches(
     const std::vector<t_arch_switch_inf>& arch_switch_inf,
     t_arch_switch_fanin& arch_switch_fanins) {
@@ -545,7 +644,7 @@ t_edge_size t_rr_graph_storage::num_configurable_edges(RRNodeId id, const vtr::v
     auto first_id = size_t(node_first_edge_[id]);
     auto last_id = size_t((&node_first_edge_[id])[1]);
     for (size_t idx = first_id; idx < last_id; ++idx) {
-        auto switch_idx = edge_switch_[RREdgeId(idx)];
+        auto switch_idx = edge_switch(RREdgeId(idx));
         if (!rr_switches[RRSwitchId(switch_idx)].configurable()) {
             return idx - first_id;
         }
@@ -793,7 +892,12 @@ t_rr_graph_view t_rr_graph_storage::view() const {
         vtr::make_const_array_view_id(node_ptc_twist_incr_),
         vtr::make_const_array_view_id(edge_src_node_),
         vtr::make_const_array_view_id(edge_dest_node_),
-        vtr::make_const_array_view_id(edge_switch_));
+        vtr::make_const_array_view_id(edge_switch_),
+        vtr::make_const_array_view_id(edge_switch_u8_),
+        edge_dest_mask_,
+        edge_switch_shift_,
+        vtr::make_const_array_view_id(node_first_in_edge_),
+        vtr::array_view<const RREdgeId>(node_in_edges_.data(), node_in_edges_.size()));
 }
 
 // Given `order`, a vector mapping each RRNodeId to a new one (old -> new),
@@ -813,6 +917,11 @@ t_rr_graph_view t_rr_graph_storage::view() const {
 void t_rr_graph_storage::reorder(const vtr::vector<RRNodeId, RRNodeId>& order,
                                  const vtr::vector<RRNodeId, RRNodeId>& inverse_order) {
     VTR_ASSERT(order.size() == inverse_order.size());
+    // Rebuilt on demand with init_in_edges()
+    clear_in_edges();
+    // The node ids change, so the edges are re-compressed afterwards
+    bool was_compressed = edges_compressed_;
+    decompress_edges();
     {
         auto old_node_storage = node_storage_;
 
@@ -858,4 +967,19 @@ void t_rr_graph_storage::reorder(const vtr::vector<RRNodeId, RRNodeId>& order,
             node_fan_in_[order[RRNodeId(i)]] = old_node_fan_in[RRNodeId(i)];
         }
     }
+    {
+        auto old_node_layer = node_layer_;
+        for (size_t i = 0; i < node_layer_.size(); i++) {
+            node_layer_[order[RRNodeId(i)]] = old_node_layer[RRNodeId(i)];
+        }
+    }
+    {
+        auto old_node_ptc_twist_incr = node_ptc_twist_incr_;
+        for (size_t i = 0; i < node_ptc_twist_incr_.size(); i++) {
+            node_ptc_twist_incr_[order[RRNodeId(i)]] = old_node_ptc_twist_incr[RRNodeId(i)];
+        }
+    }
+    if (was_compressed) {
+        compress_edges();
+    }
 }
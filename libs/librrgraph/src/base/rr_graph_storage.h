@@ -2,7 +2,9 @@
 #define RR_GRAPH_STORAGE
 
 #include <exception>
+#include <algorithm>
 #include <bitset>
+#include <limits>
 
 #include "vtr_vector.h"
 #include "physical_types.h"
@@ -13,6 +15,7 @@
 #include "rr_edge.h"
 #include "vtr_log.h"
 #include "vtr_memory.h"
+#include "vtr_memory_usage.h"
 #include "vtr_strong_id_range.h"
 #include "vtr_array_view.h"
 
@@ -338,11 +341,21 @@ class t_rr_graph_storage {
 
     /** @brief Get the destination node for the specified edge. */
     RRNodeId edge_sink_node(const RREdgeId& edge) const {
-        return edge_dest_node_[edge];
+        return RRNodeId(size_t(edge_dest_node_[edge]) & edge_dest_mask_);
     }
 
     /** @brief Call the `apply` function with the edge id, source, and sink nodes of every edge. */
     void for_each_edge(std::function<void(RREdgeId, RRNodeId, RRNodeId)> apply) const {
+        if (edges_compressed_) {
+            // The edges are sorted by source node, so this visits them in the same order
+            for (size_t inode = 0; inode < node_storage_.size(); inode++) {
+                RRNodeId node(inode);
+                for (RREdgeId edge : edge_range(node)) {
+                    apply(edge, node, edge_sink_node(edge));
+                }
+            }
+            return;
+        }
         for (size_t i = 0; i < edge_dest_node_.size(); i++) {
             RREdgeId edge(i);
             apply(edge, edge_src_node_[edge], edge_dest_node_[edge]);
@@ -360,7 +373,13 @@ class t_rr_graph_storage {
 
     /** @brief Get the switch used for the specified edge. */
     short edge_switch(const RREdgeId& edge) const {
-        return edge_switch_[edge];
+        if (!edge_switch_.empty()) {
+            return edge_switch_[edge];
+        }
+        if (!edge_switch_u8_.empty()) {
+            return edge_switch_u8_[edge];
+        }
+        return short(size_t(edge_dest_node_[edge]) >> edge_switch_shift_);
     }
 
     /** @brief Get the switch used for the iedge'th edge from specified RRNodeId.
@@ -466,12 +485,17 @@ class t_rr_graph_storage {
         node_ptc_.clear();
         node_first_edge_.clear();
         node_fan_in_.clear();
+        clear_in_edges();
         node_layer_.clear();
         node_ptc_twist_incr_.clear();
         edge_src_node_.clear();
         edge_dest_node_.clear();
         edge_switch_.clear();
+        edge_switch_u8_.clear();
         edge_remapped_.clear();
+        edge_dest_mask_ = std::numeric_limits<uint32_t>::max();
+        edge_switch_shift_ = 0;
+        edges_compressed_ = false;
         edges_read_ = false;
         partitioned_ = false;
         remapped_edges_ = false;
@@ -488,7 +512,7 @@ class t_rr_graph_storage {
     /** @brief Clear edge_remap data structure, and then initialize it with the given value */
     void init_edge_remap(bool val) {
         edge_remapped_.clear();
-        edge_remapped_.resize(edge_switch_.size(), val);
+        edge_remapped_.resize(edge_dest_node_.size(), val);
     }
 
     /** @brief Shrink memory usage of the RR graph storage.
@@ -500,14 +524,24 @@ class t_rr_graph_storage {
         node_ptc_.shrink_to_fit();
         node_first_edge_.shrink_to_fit();
         node_fan_in_.shrink_to_fit();
+        node_first_in_edge_.shrink_to_fit();
+        node_in_edges_.shrink_to_fit();
         node_layer_.shrink_to_fit();
         node_ptc_twist_incr_.shrink_to_fit();
         edge_src_node_.shrink_to_fit();
         edge_dest_node_.shrink_to_fit();
         edge_switch_.shrink_to_fit();
+        edge_switch_u8_.shrink_to_fit();
         edge_remapped_.shrink_to_fit();
     }
 
+    /** @brief Return the (estimated) heap memory used by the RR graph storage, in bytes */
+    size_t memory_usage() const {
+        return vtr::memory_usage(node_storage_, node_ptc_, node_first_edge_, node_fan_in_,
+                                 node_first_in_edge_, node_in_edges_, node_layer_, node_ptc_twist_incr_,
+                                 edge_src_node_, edge_dest_node_, edge_switch_, edge_switch_u8_, edge_remapped_);
+    }
+
     /** @brief Append 1 more RR node to the RR graph.*/
     void emplace_back() {
         // No edges can be assigned if mutating the rr node array.
@@ -664,6 +698,63 @@ class t_rr_graph_storage {
      * have a complete rr-graph and not called often.*/
     void init_fan_in();
 
+    /*******************
+     * In-edge methods *
+     *******************/
+
+    /** @brief Build the reverse adjacency (the in-edges of every node).
+     * Must be called after partition_edges. This costs an extra RREdgeId per edge,
+     * so it is only built for algorithms that search the graph backwards
+     * (e.g. the bidirectional connection search of the router).
+     * Does nothing if the in-edges are already built. */
+    void init_in_edges();
+
+    /** @brief Have the in-edges been built with init_in_edges()? */
+    bool has_in_edges() const {
+        return !node_first_in_edge_.empty();
+    }
+
+    /** @brief Returns the in-edges of node id, sorted by edge id. Requires has_in_edges(). */
+    vtr::array_view<const RREdgeId> node_in_edges(RRNodeId id) const {
+        VTR_ASSERT_SAFE(has_in_edges());
+        uint32_t first = node_first_in_edge_[id];
+        uint32_t last = node_first_in_edge_[RRNodeId(size_t(id) + 1)];
+        return vtr::array_view<const RREdgeId>(node_in_edges_.data() + first, last - first);
+    }
+
+    /** @brief Release the in-edges. They are also dropped whenever the edges are re-partitioned. */
+    void clear_in_edges() {
+        node_first_in_edge_.clear();
+        node_in_edges_.clear();
+    }
+
+    /**************************
+     * Edge compression methods *
+     **************************/
+
+    /** @brief Compress the edge storage of the fully built graph, for read-only use.
+     * Must be called after partition_edges().
+     *
+     * Once the edges are partitioned the source node of an edge is implied by
+     * node_first_edge_, so the source array is released (edge_src_node() of the
+     * view then binary searches node_first_edge_). If the node and switch ids fit
+     * in 32 bits together, the switch of each edge is packed into the unused high
+     * bits of its destination, otherwise the switches are narrowed to 8 bits when
+     * there are few enough of them. Edges take 4 or 5 bytes instead of 10.
+     *
+     * The edge mutators restore the uncompressed storage before modifying it.
+     * Views made before this call must be re-made.
+     */
+    void compress_edges();
+
+    /** @brief Restore the uncompressed edge storage. Does nothing if the edges are not compressed. */
+    void decompress_edges();
+
+    /** @brief Is the edge storage currently compressed by compress_edges()? */
+    bool edges_compressed() const {
+        return edges_compressed_;
+    }
+
     static inline Direction get_node_direction(
         vtr::array_view_id<RRNodeId, const t_rr_node_data> node_storage,
         RRNodeId id) {
@@ -691,7 +782,10 @@ class t_rr_graph_storage {
     }
 
     inline void clear_node_first_edge() {
+        // The compressed edges need node_first_edge_ to recover their source nodes
+        decompress_edges();
         node_first_edge_.clear();
+        clear_in_edges();
     }
 
   private:
@@ -729,7 +823,7 @@ class t_rr_graph_storage {
      * storage_ stores the core RR node data used by the router and is **very**
      * hot.
      */
-    vtr::vector<RRNodeId, t_rr_node_data, vtr::aligned_allocator<t_rr_node_data>> node_storage_;
+    vtr::vector<RRNodeId, t_rr_node_data, vtr::huge_page_allocator<t_rr_node_data>> node_storage_;
 
     /**@brief
      * The PTC data is cold data, and is generally not used during the inner
@@ -747,6 +841,15 @@ class t_rr_graph_storage {
     /** @brief Fan in counts for each RR node. */
     vtr::vector<RRNodeId, t_edge_size> node_fan_in_;
 
+    /** @brief
+     * Reverse adjacency, built by init_in_edges(). The in-edges of a node are
+     * node_in_edges_[node_first_in_edge_[node] .. node_first_in_edge_[node + 1]).
+     * Like node_first_edge_, node_first_in_edge_ has one dummy element at the end.
+     * Both are empty unless init_in_edges() was called.
+     */
+    vtr::vector<RRNodeId, uint32_t> node_first_in_edge_;
+    std::vector<RREdgeId> node_in_edges_;
+
     /** @brief
      * Layer number that each RR node is located at
      * Layer number refers to the die that the node belongs to. The layer number of base die is zero and die above it one, etc.
@@ -766,9 +869,20 @@ class t_rr_graph_storage {
 
     /** @brief Edge storage */
     vtr::vector<RREdgeId, RRNodeId> edge_src_node_;
-    vtr::vector<RREdgeId, RRNodeId> edge_dest_node_;
+    vtr::vector<RREdgeId, RRNodeId, vtr::huge_page_allocator<RRNodeId>> edge_dest_node_;
     vtr::vector<RREdgeId, short> edge_switch_;
 
+    /** @brief
+     * Compressed edge storage (see compress_edges()). When the edges are compressed
+     * edge_src_node_ is empty, and the switch of each edge is either stored in
+     * edge_switch_u8_, or (if that is also empty) in the bits of edge_dest_node_
+     * above edge_switch_shift_. edge_dest_mask_ selects the destination node bits.
+     */
+    vtr::vector<RREdgeId, uint8_t> edge_switch_u8_;
+    uint32_t edge_dest_mask_;
+    uint8_t edge_switch_shift_;
+    bool edges_compressed_;
+
     /** @brief
      * The delay of certain switches specified in the architecture file depends on the number of inputs of the edge's sink node (pins or tracks).
      * For example, in the case of a MUX switch, the delay increases as the number of inputs increases.
@@ -836,7 +950,12 @@ class t_rr_graph_view {
         const vtr::array_view_id<RRNodeId, const short> node_ptc_twist_incr,
         const vtr::array_view_id<RREdgeId, const RRNodeId> edge_src_node,
         const vtr::array_view_id<RREdgeId, const RRNodeId> edge_dest_node,
-        const vtr::array_view_id<RREdgeId, const short> edge_switch)
+        const vtr::array_view_id<RREdgeId, const short> edge_switch,
+        const vtr::array_view_id<RREdgeId, const uint8_t> edge_switch_u8,
+        const uint32_t edge_dest_mask,
+        const uint8_t edge_switch_shift,
+        const vtr::array_view_id<RRNodeId, const uint32_t> node_first_in_edge,
+        const vtr::array_view<const RREdgeId> node_in_edges)
         : node_storage_(node_storage)
         , node_ptc_(node_ptc)
         , node_first_edge_(node_first_edge)
@@ -845,7 +964,12 @@ class t_rr_graph_view {
         , node_ptc_twist_incr_(node_ptc_twist_incr)
         , edge_src_node_(edge_src_node)
         , edge_dest_node_(edge_dest_node)
-        , edge_switch_(edge_switch) {}
+        , edge_switch_(edge_switch)
+        , edge_switch_u8_(edge_switch_u8)
+        , edge_dest_mask_(edge_dest_mask)
+        , edge_switch_shift_(edge_switch_shift)
+        , node_first_in_edge_(node_first_in_edge)
+        , node_in_edges_(node_in_edges) {}
 
     /****************
      * Node methods *
@@ -932,12 +1056,49 @@ class t_rr_graph_view {
 
     // Get the destination node for the specified edge.
     RRNodeId edge_sink_node(RREdgeId edge) const {
-        return edge_dest_node_[edge];
+        return RRNodeId(size_t(edge_dest_node_[edge]) & edge_dest_mask_);
     }
 
     // Get the switch used for the specified edge.
     short edge_switch(RREdgeId edge) const {
-        return edge_switch_[edge];
+        if (!edge_switch_.empty()) {
+            return edge_switch_[edge];
+        }
+        if (!edge_switch_u8_.empty()) {
+            return edge_switch_u8_[edge];
+        }
+        return short(size_t(edge_dest_node_[edge]) >> edge_switch_shift_);
+    }
+
+    // Get the source node for the specified edge.
+    //
+    // If the edges are compressed this is a binary search of the first edges.
+    RRNodeId edge_src_node(RREdgeId edge) const {
+        if (!edge_src_node_.empty()) {
+            return edge_src_node_[edge];
+        }
+        // The source is the last node whose first edge is at or before edge
+        auto first_edge_begin = node_first_edge_.begin();
+        auto next = std::upper_bound(first_edge_begin, node_first_edge_.begin() + node_storage_.size(), edge);
+        return RRNodeId(size_t(next - first_edge_begin) - 1);
+    }
+
+    /* In-edge accessors
+     *
+     * Only available if t_rr_graph_storage::init_in_edges() was called before
+     * the view was made. */
+
+    bool has_in_edges() const {
+        return !node_first_in_edge_.empty();
+    }
+
+    // Returns the RREdgeId's of the edges ending at RRNodeId id.
+    // Use edge_src_node() to get the other end of each edge.
+    vtr::array_view<const RREdgeId> node_in_edges(RRNodeId id) const {
+        VTR_ASSERT_SAFE(has_in_edges());
+        uint32_t first = node_first_in_edge_[id];
+        uint32_t last = (&node_first_in_edge_[id])[1];
+        return vtr::array_view<const RREdgeId>(node_in_edges_.data() + first, last - first);
     }
 
   private:
@@ -958,6 +1119,11 @@ class t_rr_graph_view {
     vtr::array_view_id<RREdgeId, const RRNodeId> edge_src_node_;
     vtr::array_view_id<RREdgeId, const RRNodeId> edge_dest_node_;
     vtr::array_view_id<RREdgeId, const short> edge_switch_;
+    vtr::array_view_id<RREdgeId, const uint8_t> edge_switch_u8_;
+    uint32_t edge_dest_mask_;
+    uint8_t edge_switch_shift_;
+    vtr::array_view_id<RRNodeId, const uint32_t> node_first_in_edge_;
+    vtr::array_view<const RREdgeId> node_in_edges_;
 };
 
 #endif /* _RR_GRAPH_STORAGE_ */
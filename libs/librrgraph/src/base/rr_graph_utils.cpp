@@ -6,9 +6,11 @@
 #include <queue>
 #include <random>
 #include <algorithm>
+#include <unordered_map>
 
 #include "rr_graph_utils.h"
 
+#include "vtr_hash.h"
 #include "vtr_memory.h"
 #include "vtr_time.h"
 
@@ -119,4 +121,69 @@ vtr::vector<RRNodeId, std::vector<RREdgeId>> get_fan_in_list(const RRGraphView&
         });
 
     return node_fan_in_list;
-}
\ No newline at end of file
+}
+
+/* Hash of the attributes and out-edges of node, relative to its position */
+static size_t rr_node_pattern_hash(const RRGraphView& rr_graph, RRNodeId node) {
+    t_rr_type type = rr_graph.node_type(node);
+    int x = rr_graph.node_xlow(node);
+    int y = rr_graph.node_ylow(node);
+    int layer = rr_graph.node_layer(node);
+
+    size_t hash = 0;
+    vtr::hash_combine(hash, int(type));
+    vtr::hash_combine(hash, rr_graph.node_ptc_num(node));
+    vtr::hash_combine(hash, rr_graph.node_capacity(node));
+    vtr::hash_combine(hash, size_t(rr_graph.node_cost_index(node)));
+    vtr::hash_combine(hash, int(rr_graph.node_rc_index(node)));
+    vtr::hash_combine(hash, rr_graph.node_xhigh(node) - x);
+    vtr::hash_combine(hash, rr_graph.node_yhigh(node) - y);
+    if (type == CHANX || type == CHANY) {
+        vtr::hash_combine(hash, int(rr_graph.node_direction(node)));
+    } else if (type == IPIN || type == OPIN) {
+        for (e_side side : SIDES) {
+            vtr::hash_combine(hash, rr_graph.is_node_on_specific_side(node, side));
+        }
+    }
+
+    for (t_edge_size iedge : rr_graph.edges(node)) {
+        RRNodeId sink = rr_graph.edge_sink_node(node, iedge);
+        vtr::hash_combine(hash, int(rr_graph.node_type(sink)));
+        vtr::hash_combine(hash, rr_graph.node_ptc_num(sink));
+        vtr::hash_combine(hash, rr_graph.node_xlow(sink) - x);
+        vtr::hash_combine(hash, rr_graph.node_ylow(sink) - y);
+        vtr::hash_combine(hash, rr_graph.node_layer(sink) - layer);
+        vtr::hash_combine(hash, int(rr_graph.edge_switch(node, iedge)));
+    }
+    return hash;
+}
+
+t_rr_graph_pattern_stats get_rr_graph_pattern_stats(const RRGraphView& rr_graph) {
+    struct t_pattern {
+        size_t num_instances = 0;
+        size_t num_edges = 0;
+    };
+    // Patterns are identified by their hash: collisions only make the
+    // graph look slightly more regular than it is
+    std::unordered_map<size_t, t_pattern> patterns;
+
+    t_rr_graph_pattern_stats stats;
+    for (size_t inode = 0; inode < rr_graph.num_nodes(); ++inode) {
+        RRNodeId node(inode);
+        t_pattern& pattern = patterns[rr_node_pattern_hash(rr_graph, node)];
+        pattern.num_instances++;
+        pattern.num_edges = rr_graph.num_edges(node);
+
+        stats.num_nodes++;
+        stats.num_edges += pattern.num_edges;
+    }
+
+    stats.num_node_patterns = patterns.size();
+    for (const auto& kv : patterns) {
+        stats.num_pattern_edges += kv.second.num_edges;
+        if (kv.second.num_instances == 1) {
+            stats.num_irregular_nodes++;
+        }
+    }
+    return stats;
+}
@@ -45,6 +45,19 @@ std::vector<RRSwitchId> find_rr_graph_switches(const RRGraph& rr_graph,
 // containing a list of fan-in edges for each node.
 vtr::vector<RRNodeId, std::vector<RREdgeId>> get_fan_in_list(const RRGraphView& rr_graph);
 
+/* How much of a rr graph repeats. Nodes share a pattern if they have the same attributes
+ * and the same out-edges relative to their own position (i.e. if they differ only by
+ * a translation), as most nodes of regular devices do. */
+struct t_rr_graph_pattern_stats {
+    size_t num_nodes = 0;
+    size_t num_edges = 0;
+    size_t num_node_patterns = 0;   // Distinct node patterns
+    size_t num_pattern_edges = 0;   // Edges of the distinct node patterns
+    size_t num_irregular_nodes = 0; // Nodes whose pattern is not shared with any other node
+};
+
+t_rr_graph_pattern_stats get_rr_graph_pattern_stats(const RRGraphView& rr_graph);
+
 int seg_index_of_cblock(const RRGraphView& rr_graph, t_rr_type from_rr_type, int to_node);
 int seg_index_of_sblock(const RRGraphView& rr_graph, int from_node, int to_node);
 
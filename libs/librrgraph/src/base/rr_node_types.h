@@ -7,6 +7,7 @@
 #include <map>
 #include "vtr_range.h"
 #include "vtr_ndmatrix.h"
+#include "rr_graph_fwd.h"
 
 /**
  * @brief Type of a routing resource node.
@@ -54,6 +55,7 @@ enum e_rr_node_reorder_algorithm {
     DONT_REORDER,
     DEGREE_BFS,
     RANDOM_SHUFFLE,
+    SPATIAL_HILBERT,
 };
 
 ///@brief Type used to express rr_node edge index.
@@ -114,6 +116,6 @@ struct t_rr_rc_data {
 
 // This is the data type of fast lookups of an rr-node given an (rr_type, layer, x, y, and the side)
 //[0..num_rr_types-1][0..num_layer-1][0..grid_width-1][0..grid_height-1][0..NUM_SIDES-1][0..max_ptc-1]
-typedef std::array<vtr::NdMatrix<std::vector<int>, 4>, NUM_RR_TYPES> t_rr_node_indices;
+typedef std::array<vtr::NdMatrix<std::vector<RRNodeId>, 4>, NUM_RR_TYPES> t_rr_node_indices;
 
 #endif
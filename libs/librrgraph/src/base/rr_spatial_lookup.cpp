@@ -1,4 +1,7 @@
+#include <limits>
+
 #include "vtr_assert.h"
+#include "vtr_memory_usage.h"
 #include "rr_spatial_lookup.h"
 
 RRSpatialLookup::RRSpatialLookup() {
@@ -33,64 +36,25 @@ RRNodeId RRSpatialLookup::find_node(int layer,
         return RRNodeId::INVALID();
     }
 
-    /* Currently need to swap x and y for CHANX because of chan, seg convention 
-     * This is due to that the fast look-up builders uses (y, x) coordinate when
-     * registering a CHANX node in the look-up
-     * TODO: Once the builders is reworked for use consistent (x, y) convention,
-     * the following swapping can be removed
-     */
-    size_t node_x = x;
-    size_t node_y = y;
-    if (type == CHANX) {
-        std::swap(node_x, node_y);
-    }
-
-    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
-
     /* Sanity check to ensure the layer, x, y, side and ptc are in range
      * - Return an valid id by searching in look-up when all the parameters are in range
      * - Return an invalid id if any out-of-range is detected
      */
-    if (size_t(type) >= rr_node_indices_.size()) {
-        return RRNodeId::INVALID();
-    }
-
-    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)) {
-        return RRNodeId::INVALID();
-    }
-
-    if (node_x >= rr_node_indices_[type].dim_size(1)) {
-        return RRNodeId::INVALID();
-    }
-
-    if(node_y >= rr_node_indices_[type].dim_size(2)){
+    vtr::array_view<const RRNodeId> nodes = node_list(layer, x, y, type, node_side);
+    if (size_t(ptc) >= nodes.size()) {
         return RRNodeId::INVALID();
     }
 
-    if (node_side >= rr_node_indices_[type].dim_size(3)) {
-        return RRNodeId::INVALID();
-    }
-
-    if (size_t(ptc) >= rr_node_indices_[type][layer][node_x][node_y][node_side].size()) {
-        return RRNodeId::INVALID();
-    }
-
-    return RRNodeId(rr_node_indices_[type][layer][node_x][node_y][node_side][ptc]);
+    return nodes[ptc];
 }
 
-std::vector<RRNodeId> RRSpatialLookup::find_nodes(int layer,
-                                                  int x,
-                                                  int y,
-                                                  t_rr_type type,
-                                                  e_side side) const {
-    /* TODO: The implementation of this API should be worked 
-     * when rr_node_indices adapts RRNodeId natively!
-     */
-    std::vector<RRNodeId> nodes;
-
-    /* Pre-check: the layer, x, y are valid! Otherwise, return an empty vector */
-    if (layer < 0 || x < 0 || y < 0) {
-        return nodes;
+vtr::array_view<const RRNodeId> RRSpatialLookup::node_list(int layer,
+                                                           int x,
+                                                           int y,
+                                                           t_rr_type type,
+                                                           e_side side) const {
+    if (layer < 0 || x < 0 || y < 0 || size_t(type) >= rr_node_indices_.size()) {
+        return vtr::array_view<const RRNodeId>();
     }
 
     /* Currently need to swap x and y for CHANX because of chan, seg convention 
@@ -105,44 +69,54 @@ std::vector<RRNodeId> RRSpatialLookup::find_nodes(int layer,
         std::swap(node_x, node_y);
     }
 
-    VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
-
-    /* Sanity check to ensure the x, y, side are in range 
-     * - Return a list of valid ids by searching in look-up when all the parameters are in range
-     * - Return an empty list if any out-of-range is detected
-     */
-    if (size_t(type) >= rr_node_indices_.size()) {
-        return nodes;
+    if (flat_) {
+        const std::array<size_t, 4>& dims = flat_dims_[type];
+        if (size_t(layer) >= dims[0] || node_x >= dims[1] || node_y >= dims[2] || size_t(side) >= dims[3]) {
+            return vtr::array_view<const RRNodeId>();
+        }
+        size_t cell = flat_type_first_cell_[type] + ((size_t(layer) * dims[1] + node_x) * dims[2] + node_y) * dims[3] + size_t(side);
+        uint32_t first = flat_cell_first_node_[cell];
+        uint32_t last = flat_cell_first_node_[cell + 1];
+        return vtr::array_view<const RRNodeId>(flat_nodes_.data() + first, last - first);
     }
 
-    if (size_t(layer) >= rr_node_indices_[type].dim_size(0)) {
-        return nodes;
+    const auto& type_indices = rr_node_indices_[type];
+    VTR_ASSERT_SAFE(4 == type_indices.ndims());
+    if (size_t(layer) >= type_indices.dim_size(0)
+        || node_x >= type_indices.dim_size(1)
+        || node_y >= type_indices.dim_size(2)
+        || size_t(side) >= type_indices.dim_size(3)) {
+        return vtr::array_view<const RRNodeId>();
     }
 
-    if (node_x >= rr_node_indices_[type].dim_size(1)) {
-        return nodes;
-    }
+    const std::vector<RRNodeId>& nodes = type_indices[layer][node_x][node_y][side];
+    return vtr::array_view<const RRNodeId>(nodes.data(), nodes.size());
+}
 
-    if(node_y >= rr_node_indices_[type].dim_size(2)){
-        return nodes;
-    }
+std::vector<RRNodeId> RRSpatialLookup::find_nodes(int layer,
+                                                  int x,
+                                                  int y,
+                                                  t_rr_type type,
+                                                  e_side side) const {
+    /* TODO: The implementation of this API should be worked 
+     * when rr_node_indices adapts RRNodeId natively!
+     */
+    std::vector<RRNodeId> nodes;
 
-    if (side >= rr_node_indices_[type].dim_size(3)) {
-        return nodes;
-    }
+    vtr::array_view<const RRNodeId> node_list = this->node_list(layer, x, y, type, side);
 
     /* Reserve space to avoid memory fragmentation */
     size_t num_nodes = 0;
-    for (const auto& node : rr_node_indices_[type][layer][node_x][node_y][side]) {
-        if (RRNodeId(node)) {
+    for (RRNodeId node : node_list) {
+        if (node) {
             num_nodes++;
         }
     }
 
     nodes.reserve(num_nodes);
-    for (const auto& node : rr_node_indices_[type][layer][node_x][node_y][side]) {
-        if (RRNodeId(node)) {
-            nodes.push_back(RRNodeId(node));
+    for (RRNodeId node : node_list) {
+        if (node) {
+            nodes.push_back(node);
         }
     }
 
@@ -214,12 +188,38 @@ std::vector<RRNodeId> RRSpatialLookup::find_grid_nodes_at_all_sides(int layer,
     return nodes;
 }
 
+vtr::array_view<const RRNodeId> RRSpatialLookup::channel_nodes(int layer,
+                                                               int x,
+                                                               int y,
+                                                               t_rr_type type) const {
+    /* Pre-check: node type should be routing tracks! */
+    if (type != CHANX && type != CHANY) {
+        return vtr::array_view<const RRNodeId>();
+    }
+
+    return node_list(layer, x, y, type, SIDES[0]);
+}
+
+vtr::array_view<const RRNodeId> RRSpatialLookup::grid_nodes(int layer,
+                                                            int x,
+                                                            int y,
+                                                            t_rr_type rr_type,
+                                                            e_side side) const {
+    VTR_ASSERT(rr_type == SOURCE || rr_type == OPIN || rr_type == IPIN || rr_type == SINK);
+    if (rr_type != IPIN && rr_type != OPIN) {
+        side = SIDES[0];
+    }
+
+    return node_list(layer, x, y, rr_type, side);
+}
+
 void RRSpatialLookup::reserve_nodes(int layer,
                                     int x,
                                     int y,
                                     t_rr_type type,
                                     int num_nodes,
                                     e_side side) {
+    unflatten();
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
 
     /* For non-IPIN/OPIN nodes, the side should always be the TOP side which follows the convention in find_node() API! */
@@ -240,6 +240,7 @@ void RRSpatialLookup::add_node(RRNodeId node,
                                int ptc,
                                e_side side) {
     VTR_ASSERT(node); /* Must have a valid node id to be added */
+    unflatten();
     VTR_ASSERT_SAFE(4 == rr_node_indices_[type].ndims());
 
     /* For non-IPIN/OPIN nodes, the side should always be the TOP side which follows the convention in find_node() API! */
@@ -251,11 +252,11 @@ void RRSpatialLookup::add_node(RRNodeId node,
 
     if (size_t(ptc) >= rr_node_indices_[type][layer][x][y][side].size()) {
         /* Deposit invalid ids to newly allocated elements while original elements are untouched */
-        rr_node_indices_[type][layer][x][y][side].resize(ptc + 1, int(size_t(RRNodeId::INVALID())));
+        rr_node_indices_[type][layer][x][y][side].resize(ptc + 1, RRNodeId::INVALID());
     }
 
     /* Resize on demand finished; Register the node */
-    rr_node_indices_[type][layer][x][y][side][ptc] = int(size_t(node));
+    rr_node_indices_[type][layer][x][y][side][ptc] = node;
 }
 
 void RRSpatialLookup::mirror_nodes(const int layer,
@@ -264,6 +265,7 @@ void RRSpatialLookup::mirror_nodes(const int layer,
                                    t_rr_type type,
                                    e_side side) {
     VTR_ASSERT(SOURCE == type || SINK == type);
+    unflatten();
     resize_nodes(layer, des_coord.x(), des_coord.y(), type, side);
     rr_node_indices_[type][layer][des_coord.x()][des_coord.y()][side] = rr_node_indices_[type][layer][src_coord.x()][src_coord.y()][side];
 }
@@ -277,6 +279,7 @@ void RRSpatialLookup::resize_nodes(int layer,
      * This may seldom happen because the rr_graph building function
      * should ensure the fast look-up well organized  
      */
+    unflatten();
     VTR_ASSERT(type < rr_node_indices_.size());
     VTR_ASSERT(x >= 0);
     VTR_ASSERT(y >= 0);
@@ -294,6 +297,12 @@ void RRSpatialLookup::resize_nodes(int layer,
 }
 
 void RRSpatialLookup::reorder(const vtr::vector<RRNodeId, RRNodeId> dest_order) {
+    for (RRNodeId& node : flat_nodes_) {
+        if (node) {
+            node = dest_order[node];
+        }
+    }
+
     // update rr_node_indices, a map to optimize rr_index lookups
     for (auto& grid : rr_node_indices_) {
         for(size_t l = 0; l < grid.dim_size(0); l++) {
@@ -301,8 +310,8 @@ void RRSpatialLookup::reorder(const vtr::vector<RRNodeId, RRNodeId> dest_order)
                 for (size_t y = 0; y < grid.dim_size(2); y++) {
                     for (size_t s = 0; s < grid.dim_size(3); s++) {
                         for (auto &node: grid[l][x][y][s]) {
-                            if (node != OPEN) {
-                                node = size_t(dest_order[RRNodeId(node)]);
+                            if (node) {
+                                node = dest_order[node];
                             }
                         }
                     }
@@ -312,8 +321,81 @@ void RRSpatialLookup::reorder(const vtr::vector<RRNodeId, RRNodeId> dest_order)
     }
 }
 
+void RRSpatialLookup::flatten() {
+    if (flat_) {
+        return;
+    }
+
+    size_t num_cells = 0;
+    size_t num_nodes = 0;
+    for (size_t type = 0; type < rr_node_indices_.size(); type++) {
+        const auto& type_indices = rr_node_indices_[type];
+        flat_type_first_cell_[type] = num_cells;
+        size_t type_num_cells = 1;
+        for (size_t dim = 0; dim < 4; dim++) {
+            flat_dims_[type][dim] = type_indices.dim_size(dim);
+            type_num_cells *= flat_dims_[type][dim];
+        }
+        num_cells += type_num_cells;
+        for (size_t icell = 0; icell < type_indices.size(); icell++) {
+            num_nodes += type_indices.get(icell).size();
+        }
+    }
+    VTR_ASSERT(num_nodes <= std::numeric_limits<uint32_t>::max());
+
+    // Visit the locations in the row-major order of the cell index (see node_list())
+    flat_cell_first_node_.clear();
+    flat_cell_first_node_.reserve(num_cells + 1);
+    flat_nodes_.clear();
+    flat_nodes_.reserve(num_nodes);
+    for (auto& type_indices : rr_node_indices_) {
+        for (size_t icell = 0; icell < type_indices.size(); icell++) {
+            const std::vector<RRNodeId>& nodes = type_indices.get(icell);
+            flat_cell_first_node_.push_back(flat_nodes_.size());
+            flat_nodes_.insert(flat_nodes_.end(), nodes.begin(), nodes.end());
+        }
+        type_indices.clear();
+    }
+    flat_cell_first_node_.push_back(flat_nodes_.size());
+
+    flat_ = true;
+}
+
+void RRSpatialLookup::unflatten() {
+    if (!flat_) {
+        return;
+    }
+
+    for (size_t type = 0; type < rr_node_indices_.size(); type++) {
+        const std::array<size_t, 4>& dims = flat_dims_[type];
+        auto& type_indices = rr_node_indices_[type];
+        type_indices.resize({dims[0], dims[1], dims[2], dims[3]});
+
+        for (size_t icell = 0; icell < type_indices.size(); icell++) {
+            size_t cell = flat_type_first_cell_[type] + icell;
+            type_indices.get(icell).assign(flat_nodes_.begin() + flat_cell_first_node_[cell],
+                                           flat_nodes_.begin() + flat_cell_first_node_[cell + 1]);
+        }
+    }
+
+    flat_cell_first_node_ = std::vector<uint32_t>();
+    flat_nodes_ = std::vector<RRNodeId>();
+    flat_ = false;
+}
+
 void RRSpatialLookup::clear() {
     for (auto& data : rr_node_indices_) {
         data.clear();
     }
+    flat_cell_first_node_.clear();
+    flat_nodes_.clear();
+    flat_ = false;
+}
+
+size_t RRSpatialLookup::memory_usage() const {
+    size_t bytes = vtr::memory_usage(flat_cell_first_node_, flat_nodes_);
+    for (const auto& data : rr_node_indices_) {
+        bytes += vtr::memory_usage(data);
+    }
+    return bytes;
 }
@@ -14,7 +14,12 @@
  *
  *   - Update the look-up with new nodes
  *   - Find the id of a node with given information, e.g., x, y, type etc.
+ *
+ * Once the routing resource graph is built, the look-up can be flattened
+ * (see flatten()) into a single compressed (CSR) array, which is faster and
+ * smaller to query.
  */
+#include "vtr_array_view.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
 #include "physical_types.h"
@@ -117,6 +122,30 @@ class RRSpatialLookup {
                                                        int y,
                                                        t_rr_type rr_type) const;
 
+    /**
+     * @brief Returns the nodes of the routing channel at (layer, x, y), indexed by track number.
+     *
+     * Unlike find_channel_nodes() this does not allocate, but the list may contain invalid ids
+     * (for the tracks which do not exist at this location), which the caller must skip.
+     * The list is invalidated by any mutation of the look-up.
+     */
+    vtr::array_view<const RRNodeId> channel_nodes(int layer,
+                                                  int x,
+                                                  int y,
+                                                  t_rr_type type) const;
+
+    /**
+     * @brief Returns the nodes of the given type on the given side of the grid tile at (layer, x, y), indexed by ptc.
+     *
+     * Like channel_nodes() this does not allocate, and the list may contain invalid ids.
+     * The side only applies to IPIN/OPIN nodes.
+     */
+    vtr::array_view<const RRNodeId> grid_nodes(int layer,
+                                               int x,
+                                               int y,
+                                               t_rr_type rr_type,
+                                               e_side side = SIDES[0]) const;
+
     /* -- Mutators -- */
   public:
     /** @brief Reserve the memory for a list of nodes at (layer, x, y) location with given type and side */
@@ -224,9 +253,27 @@ class RRSpatialLookup {
     /** @brief Reorder the internal look up to be more memory efficient */
     void reorder(const vtr::vector<RRNodeId, RRNodeId> dest_order);
 
+    /**
+     * @brief Flatten the look-up into a compressed (CSR) array, once all the nodes have been added
+     *
+     * The node list of each (type, layer, x, y, side) location is stored contiguously in a single
+     * array, and found through an offset table indexed by a perfect hash of the location (its
+     * row-major index in the dimensions of the type). This avoids the pointer chasing and per
+     * location allocations of the nested look-up.
+     *
+     * The mutators transparently restore the nested look-up, so nodes can still be added afterwards.
+     */
+    void flatten();
+
+    /** @brief Is the look-up currently flattened? */
+    bool is_flat() const { return flat_; }
+
     /** @brief Clear all the data inside */
     void clear();
 
+    /** @brief Return the (estimated) heap memory used by the look-up, in bytes */
+    size_t memory_usage() const;
+
     /* -- Internal data queries -- */
   private:
     /* An internal API to find all the nodes in a specific location with a given type
@@ -240,10 +287,31 @@ class RRSpatialLookup {
                                      t_rr_type type,
                                      e_side side = SIDES[0]) const;
 
+    /* The ptc indexed list of nodes at a location (empty if out of range),
+     * from either the nested or the flattened look-up */
+    vtr::array_view<const RRNodeId> node_list(int layer,
+                                              int x,
+                                              int y,
+                                              t_rr_type type,
+                                              e_side side) const;
+
+    /* Restore the nested look-up from the flattened one (before a mutation) */
+    void unflatten();
+
     /* -- Internal data storage -- */
   private:
     /* Fast look-up: TODO: Should rework the data type. Currently it is based on a 3-dimensional array mater where some dimensions must always be accessed with a specific index. Such limitation should be overcome */
     t_rr_node_indices rr_node_indices_;
+
+    /* Flattened look-up (see flatten()). The nodes at location (layer, x, y, side) of a type are
+     * flat_nodes_[flat_cell_first_node_[cell] .. flat_cell_first_node_[cell + 1]), where
+     * cell = flat_type_first_cell_[type] + ((layer * dim1 + x) * dim2 + y) * dim3 + side
+     * in the dimensions flat_dims_[type] of the nested look-up. */
+    bool flat_ = false;
+    std::array<std::array<size_t, 4>, NUM_RR_TYPES> flat_dims_ = {};
+    std::array<size_t, NUM_RR_TYPES> flat_type_first_cell_ = {};
+    std::vector<uint32_t> flat_cell_first_node_;
+    std::vector<RRNodeId> flat_nodes_;
 };
 
 #endif
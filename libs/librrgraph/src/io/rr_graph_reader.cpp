@@ -17,8 +17,21 @@
 
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#include "rr_graph_xml_edges.h"
+#include "rr_metadata.h"
 
+#include <cstdio>
 #include <fstream>
+#include <istream>
+#include <limits>
+#include <streambuf>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
 
 #include "vtr_time.h"
 #include "pugixml.hpp"
@@ -29,6 +42,113 @@
 #    include "mmap_file.h"
 #endif
 
+/*********************** Subroutines local to this module *******************/
+
+namespace {
+
+///@brief The contents of an XML rr graph file, memory mapped where supported
+class XmlFileData {
+  public:
+    explicit XmlFileData(const char* filename) {
+#ifndef _WIN32
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            vpr_throw(VPR_ERROR_ROUTE, filename, 0, "Could not open file '%s'.\n", filename);
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            close(fd);
+            vpr_throw(VPR_ERROR_ROUTE, filename, 0, "Could not stat file '%s'.\n", filename);
+        }
+        size_ = file_stat.st_size;
+        if (size_ > 0) {
+            void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                mapped_ = mapped;
+                data_ = static_cast<const char*>(mapped);
+            }
+        }
+        close(fd);
+        if (mapped_ || size_ == 0) {
+            return;
+        }
+#endif
+        //Fallback: read the whole file
+        FILE* fp = std::fopen(filename, "rb");
+        if (!fp) {
+            vpr_throw(VPR_ERROR_ROUTE, filename, 0, "Could not open file '%s'.\n", filename);
+        }
+        std::fseek(fp, 0, SEEK_END);
+        buffer_.resize(std::ftell(fp));
+        std::fseek(fp, 0, SEEK_SET);
+        size_t num_read = std::fread(buffer_.data(), 1, buffer_.size(), fp);
+        std::fclose(fp);
+        buffer_.resize(num_read);
+
+        size_ = buffer_.size();
+        data_ = buffer_.data();
+    }
+
+    XmlFileData(const XmlFileData&) = delete;
+    XmlFileData& operator=(const XmlFileData&) = delete;
+
+    ~XmlFileData() {
+#ifndef _WIN32
+        if (mapped_) {
+            munmap(mapped_, size_);
+        }
+#endif
+    }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+  private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    void* mapped_ = nullptr;
+    std::vector<char> buffer_;
+};
+
+///@brief A read-only stream buffer over consecutive parts of a file's contents, without copying them
+class TextPartsStreambuf : public std::streambuf {
+  public:
+    explicit TextPartsStreambuf(std::vector<std::pair<const char*, const char*>> parts)
+        : parts_(std::move(parts)) {}
+
+  protected:
+    int_type underflow() override {
+        while (next_part_ < parts_.size()) {
+            char* part_begin = const_cast<char*>(parts_[next_part_].first);
+            char* part_end = const_cast<char*>(parts_[next_part_].second);
+            ++next_part_;
+            if (part_begin != part_end) {
+                setg(part_begin, part_begin, part_end);
+                return traits_type::to_int_type(*part_begin);
+            }
+        }
+        return traits_type::eof();
+    }
+
+  private:
+    std::vector<std::pair<const char*, const char*>> parts_;
+    size_t next_part_ = 0;
+};
+
+} // namespace
+
+static void load_xml_rr_edges(RRGraphBuilder* rr_graph_builder,
+                              const t_xml_rr_edges& xml_edges,
+                              const t_arch* arch,
+                              bool read_edge_metadata,
+                              const char* read_rr_graph_name);
+
+#ifdef VTR_ENABLE_CAPNPROTO
+static void load_capnp_rr_edges(RRGraphBuilder* rr_graph_builder,
+                                const ::capnp::List<ucap::Edge>::Reader& edges,
+                                const char* read_rr_graph_name);
+#endif
+
 /************************ Subroutine definitions ****************************/
 /* loads the given RR_graph file into the appropriate data structures
  * as specified by read_rr_graph_name. Set up correct routing data
@@ -98,15 +218,45 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
 
     if (vtr::check_file_name_extension(read_rr_graph_name, ".xml")) {
         try {
-            std::ifstream file(read_rr_graph_name);
+            XmlFileData file(read_rr_graph_name);
+
+            //The edges are by far the largest part of the file, so rather than building a DOM of them
+            //they are parsed straight from the file text and added in bulk. pugixml only sees the first
+            //edge, as the schema requires one. Files which use XML features the edge parser does not
+            //support are entirely parsed by pugixml.
+            t_xml_rr_edges xml_edges;
+            std::vector<std::pair<const char*, const char*>> dom_parts = {{file.begin(), file.end()}};
+            if (parse_xml_rr_edges(file.begin(), file.end(), read_edge_metadata, xml_edges)) {
+                dom_parts = {{file.begin(), xml_edges.first_edge_end}, {xml_edges.rr_edges_end, file.end()}};
+                reader.set_rr_edges_bulk_loader([rr_graph_builder, &xml_edges, arch, read_edge_metadata, read_rr_graph_name]() {
+                    load_xml_rr_edges(rr_graph_builder, xml_edges, arch, read_edge_metadata, read_rr_graph_name);
+                });
+            }
+
+            TextPartsStreambuf dom_buf(std::move(dom_parts));
+            std::istream dom_stream(&dom_buf);
             void* context;
-            uxsd::load_rr_graph_xml(reader, context, read_rr_graph_name, file);
+            uxsd::load_rr_graph_xml(reader, context, read_rr_graph_name, dom_stream);
         } catch (pugiutil::XmlError& e) {
             vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, e.line(), "%s", e.what());
         }
 #ifdef VTR_ENABLE_CAPNPROTO
     } else if (vtr::check_file_name_extension(read_rr_graph_name, ".bin")) {
         MmapFile f(read_rr_graph_name);
+
+        //The edges are by far the largest part of the file, so rather than going through one
+        //serializer callback per edge, they are added in bulk straight from the mapped file
+        ::capnp::ReaderOptions opts = ::capnp::ReaderOptions();
+        opts.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+        ::capnp::FlatArrayMessageReader message(f.getData(), opts);
+        auto rr_graph_root = message.getRoot<ucap::RrGraph>();
+        if (rr_graph_root.hasRrEdges()) {
+            auto edges = rr_graph_root.getRrEdges().getEdges();
+            reader.set_rr_edges_bulk_loader([rr_graph_builder, edges, read_rr_graph_name]() {
+                load_capnp_rr_edges(rr_graph_builder, edges, read_rr_graph_name);
+            });
+        }
+
         void* context;
         uxsd::load_rr_graph_capnp(reader, f.getData(), context, read_rr_graph_name);
 #endif
@@ -117,3 +267,69 @@ void load_rr_file(RRGraphBuilder* rr_graph_builder,
             read_rr_graph_name);
     }
 }
+
+/* Adds all the edges of an XML rr graph file, parsed by parse_xml_rr_edges(), to the rr graph.
+ * The metadata of the first edge is left to the serializer, which sees that edge */
+static void load_xml_rr_edges(RRGraphBuilder* rr_graph_builder,
+                              const t_xml_rr_edges& xml_edges,
+                              const t_arch* arch,
+                              bool read_edge_metadata,
+                              const char* read_rr_graph_name) {
+    size_t num_nodes = rr_graph_builder->rr_nodes().size();
+
+    size_t num_edges = 0;
+    for (const t_xml_rr_edges_chunk& chunk : xml_edges.chunks) {
+        num_edges += chunk.edges.size();
+    }
+    rr_graph_builder->reserve_edges(num_edges);
+
+    size_t first_chunk_edge = 0;
+    for (const t_xml_rr_edges_chunk& chunk : xml_edges.chunks) {
+        for (const t_xml_rr_edge& edge : chunk.edges) {
+            if (edge.src_node >= num_nodes) {
+                vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, -1,
+                          "source_node %u is larger than rr_nodes.size() %zu",
+                          edge.src_node, num_nodes);
+            }
+
+            // The edge ids in the rr graph file are rr edge id not architecture edge id
+            rr_graph_builder->emplace_back_edge(RRNodeId(edge.src_node), RRNodeId(edge.sink_node), edge.switch_id, true);
+        }
+
+        if (read_edge_metadata) {
+            for (const t_xml_rr_edge_meta& meta : chunk.metadata) {
+                if (first_chunk_edge + meta.iedge == 0) continue;
+
+                const t_xml_rr_edge& edge = chunk.edges[meta.iedge];
+                vpr::add_rr_edge_metadata(rr_graph_builder->rr_edge_metadata(), edge.src_node, edge.sink_node, edge.switch_id,
+                                          vtr::string_view(meta.name.data(), meta.name.size()),
+                                          vtr::string_view(meta.value.data(), meta.value.size()),
+                                          arch);
+            }
+        }
+        first_chunk_edge += chunk.edges.size();
+    }
+}
+
+#ifdef VTR_ENABLE_CAPNPROTO
+/* Adds all the edges of a binary rr graph file to the rr graph, reading them directly
+ * from the (memory mapped) capnp message */
+static void load_capnp_rr_edges(RRGraphBuilder* rr_graph_builder,
+                                const ::capnp::List<ucap::Edge>::Reader& edges,
+                                const char* read_rr_graph_name) {
+    size_t num_nodes = rr_graph_builder->rr_nodes().size();
+    rr_graph_builder->reserve_edges(edges.size());
+
+    for (const auto& edge : edges) {
+        unsigned int src_node = edge.getSrcNode();
+        if (src_node >= num_nodes) {
+            vpr_throw(VPR_ERROR_ROUTE, read_rr_graph_name, -1,
+                      "source_node %u is larger than rr_nodes.size() %zu",
+                      src_node, num_nodes);
+        }
+
+        // The edge ids in the rr graph file are rr edge id not architecture edge id
+        rr_graph_builder->emplace_back_edge(RRNodeId(src_node), RRNodeId(edge.getSinkNode()), edge.getSwitchId(), true);
+    }
+}
+#endif
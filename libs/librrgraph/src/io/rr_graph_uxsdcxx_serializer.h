@@ -334,6 +334,13 @@ class RrGraphSerializer final : public uxsd::RrGraphBase<RrGraphContextTypes> {
         curr_tmp_y = -1;
     }
 
+    /** @brief Registers a function that adds all rr edges to the rr graph in one go (e.g. straight from a
+     * memory mapped binary file). It is called when the rr_edges section is entered, after which
+     * add_rr_edges_edge() only handles the edge metadata instead of appending each edge on its own. */
+    void set_rr_edges_bulk_loader(std::function<void()> bulk_loader) {
+        rr_edges_bulk_loader_ = std::move(bulk_loader);
+    }
+
     /* A truth table to help understand the conversion from VPR side mask to uxsd side code
      *
      * index | LEFT BOTTOM RIGHT TOP | mask
@@ -992,19 +999,31 @@ class RrGraphSerializer final : public uxsd::RrGraphBase<RrGraphContextTypes> {
      * </xs:complexType>
      */
     inline void preallocate_rr_edges_edge(void*& /*ctx*/, size_t size) final {
-        rr_graph_builder_->reserve_edges(size);
+        if (!rr_edges_bulk_loader_) {
+            rr_graph_builder_->reserve_edges(size);
+        }
         if (read_edge_metadata_) {
             rr_edge_metadata_->reserve(size);
         }
     }
     inline MetadataBind add_rr_edges_edge(void*& /*ctx*/, unsigned int sink_node, unsigned int src_node, unsigned int switch_id) final {
+        MetadataBind bind(rr_node_metadata_, rr_edge_metadata_, strings_, empty_);
+        if (rr_edges_bulk_loader_) {
+            // The edge itself was already added by the bulk loader, only its metadata is left
+            if (read_edge_metadata_) {
+                bind.set_edge_target(src_node, sink_node, switch_id);
+            } else {
+                bind.set_ignore();
+            }
+            return bind;
+        }
+
         if (src_node >= rr_nodes_->size()) {
             report_error(
                 "source_node %d is larger than rr_nodes.size() %d",
                 src_node, rr_nodes_->size());
         }
 
-        MetadataBind bind(rr_node_metadata_, rr_edge_metadata_, strings_, empty_);
         if (read_edge_metadata_) {
             bind.set_edge_target(src_node, sink_node, switch_id);
         } else {
@@ -1064,6 +1083,9 @@ class RrGraphSerializer final : public uxsd::RrGraphBase<RrGraphContextTypes> {
     }
 
     inline void* init_rr_graph_rr_edges(void*& /*ctx*/) final {
+        if (rr_edges_bulk_loader_) {
+            rr_edges_bulk_loader_();
+        }
         return nullptr;
     }
     inline void finish_rr_graph_rr_edges(void*& /*ctx*/) final {
@@ -2088,6 +2110,7 @@ class RrGraphSerializer final : public uxsd::RrGraphBase<RrGraphContextTypes> {
     vtr::interned_string empty_;
     const std::function<void(const char*)>* report_error_;
     bool is_flat_;
+    std::function<void()> rr_edges_bulk_loader_;
 
     // Temporary data to check grid block types
     int curr_tmp_block_type_id;
@@ -7,11 +7,17 @@
 
 #include "rr_graph_writer.h"
 
+#include <algorithm>
+#include <charconv>
 #include <cstdio>
 #include <fstream>
 #include <limits>
+#include <string>
 #include "rr_graph_uxsdcxx_serializer.h"
 #include "rr_graph_uxsdcxx.h"
+#ifdef RRGRAPH_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
 #ifdef VTR_ENABLE_CAPNPROTO
 #    include "capnp/serialize.h"
 #    include "ndmatrix_serdes.h"
@@ -19,6 +25,274 @@
 #    include "rr_graph_uxsdcxx_capnp.h"
 #endif
 
+/*********************** Subroutines local to this module *******************/
+
+namespace {
+
+///@brief Number of rr nodes whose node (or out-going edge) records are formatted together
+constexpr size_t RR_GRAPH_XML_NODES_PER_CHUNK = 4096;
+
+///@brief Number of chunks formatted (concurrently) before being written, which bounds the memory used
+constexpr size_t RR_GRAPH_XML_CHUNKS_PER_WINDOW = 64;
+
+/**
+ * @brief Appends XML text to a string
+ *
+ * Numbers are formatted with std::to_chars, which gives the same text as the std::ostream
+ * used by the generated writer (floats with max_digits10 significant digits), without the
+ * per-call overhead of the stream.
+ */
+class XmlTextBuffer {
+  public:
+    explicit XmlTextBuffer(std::string& text)
+        : text_(text) {}
+
+    XmlTextBuffer& operator<<(const char* str) {
+        text_ += str;
+        return *this;
+    }
+
+    XmlTextBuffer& operator<<(const std::string& str) {
+        text_ += str;
+        return *this;
+    }
+
+    XmlTextBuffer& operator<<(int value) {
+        return append_integer(value);
+    }
+
+    XmlTextBuffer& operator<<(unsigned int value) {
+        return append_integer(value);
+    }
+
+    XmlTextBuffer& operator<<(float value) {
+        char buf[32];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, std::numeric_limits<float>::max_digits10);
+        text_.append(buf, result.ptr);
+        return *this;
+    }
+
+  private:
+    template<typename T>
+    XmlTextBuffer& append_integer(T value) {
+        char buf[16];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        text_.append(buf, result.ptr);
+        return *this;
+    }
+
+  private:
+    std::string& text_;
+};
+
+void format_metadata_xml(XmlTextBuffer& buf, const t_metadata_dict& metadata, const vtr::string_internment* strings, std::string& temp) {
+    buf << "<metadata>\n";
+    for (const auto& meta : metadata) {
+        VTR_ASSERT(meta.second.size() == 1);
+        meta.first.get(strings, &temp);
+        buf << "<meta name=\"" << temp << "\">";
+        meta.second[0].as_string().get(strings, &temp);
+        buf << temp << "</meta>\n";
+    }
+    buf << "</metadata>\n";
+}
+
+///@brief Formats the <node> records of the nodes [begin_node, end_node) as uxsd::write_rr_nodes() does
+void format_rr_node_records_xml(RrGraphSerializer& serializer,
+                                const MetadataStorage<int>& node_metadata,
+                                const vtr::string_internment* strings,
+                                size_t begin_node,
+                                size_t end_node,
+                                std::string& text) {
+    XmlTextBuffer buf(text);
+    std::string temp;
+    void* context = nullptr;
+    for (size_t inode = begin_node; inode < end_node; inode++) {
+        const t_rr_node node = serializer.get_rr_nodes_node(inode, context);
+
+        buf << "<node capacity=\"" << serializer.get_node_capacity(node) << "\"";
+        uxsd::enum_node_direction direction = serializer.get_node_direction(node);
+        if ((bool)direction) {
+            buf << " direction=\"" << uxsd::lookup_node_direction[(int)direction] << "\"";
+        }
+        buf << " id=\"" << serializer.get_node_id(node) << "\"";
+        buf << " type=\"" << uxsd::lookup_node_type[(int)serializer.get_node_type(node)] << "\">";
+
+        buf << "<loc layer=\"" << serializer.get_node_loc_layer(node) << "\"";
+        buf << " ptc=\"" << serializer.get_node_loc_ptc(node) << "\"";
+        uxsd::enum_loc_side side = serializer.get_node_loc_side(node);
+        if ((bool)side) {
+            buf << " side=\"" << uxsd::lookup_loc_side[(int)side] << "\"";
+        }
+        int twist = serializer.get_node_loc_twist(node);
+        if (twist) {
+            buf << " twist=\"" << twist << "\"";
+        }
+        buf << " xhigh=\"" << serializer.get_node_loc_xhigh(node) << "\"";
+        buf << " xlow=\"" << serializer.get_node_loc_xlow(node) << "\"";
+        buf << " yhigh=\"" << serializer.get_node_loc_yhigh(node) << "\"";
+        buf << " ylow=\"" << serializer.get_node_loc_ylow(node) << "\"/>\n";
+
+        buf << "<timing C=\"" << serializer.get_node_timing_C(node) << "\"";
+        buf << " R=\"" << serializer.get_node_timing_R(node) << "\"/>\n";
+
+        if (serializer.has_node_segment(node)) {
+            buf << "<segment segment_id=\"" << serializer.get_node_segment_segment_id(node) << "\"/>\n";
+        }
+
+        auto metadata = node_metadata.find(inode);
+        if (metadata != node_metadata.end()) {
+            format_metadata_xml(buf, metadata->second, strings, temp);
+        }
+
+        buf << "</node>\n";
+    }
+}
+
+///@brief Formats the <edge> records of the edges leaving the nodes [begin_node, end_node) as uxsd::write_rr_edges() does
+void format_rr_edge_records_xml(const RRGraphView& rr_graph,
+                                const MetadataStorage<std::tuple<int, int, short>>& edge_metadata,
+                                const vtr::string_internment* strings,
+                                size_t begin_node,
+                                size_t end_node,
+                                std::string& text) {
+    XmlTextBuffer buf(text);
+    std::string temp;
+    for (size_t inode = begin_node; inode < end_node; inode++) {
+        RRNodeId src_node(inode);
+        for (t_edge_size iedge = 0; iedge < rr_graph.num_edges(src_node); iedge++) {
+            unsigned int sink_node = size_t(rr_graph.edge_sink_node(src_node, iedge));
+            unsigned int switch_id = rr_graph.edge_switch(src_node, iedge);
+
+            buf << "<edge sink_node=\"" << sink_node << "\"";
+            buf << " src_node=\"" << (unsigned int)inode << "\"";
+            buf << " switch_id=\"" << switch_id << "\">";
+
+            auto metadata = edge_metadata.find(std::make_tuple(int(inode), int(sink_node), short(switch_id)));
+            if (metadata != edge_metadata.end()) {
+                format_metadata_xml(buf, metadata->second, strings, temp);
+            }
+
+            buf << "</edge>\n";
+        }
+    }
+}
+
+/**
+ * @brief Formats the records of the nodes [0, num_nodes) in chunks with format_chunk(begin_node, end_node, text),
+ *        and writes them to os in order
+ *
+ * With TBB, a window of chunks is formatted concurrently into separate buffers before being written.
+ */
+template<typename FormatChunk>
+void write_rr_node_chunks_xml(std::ostream& os, size_t num_nodes, const FormatChunk& format_chunk) {
+    size_t num_chunks = (num_nodes + RR_GRAPH_XML_NODES_PER_CHUNK - 1) / RR_GRAPH_XML_NODES_PER_CHUNK;
+    std::vector<std::string> chunk_text(std::min(num_chunks, RR_GRAPH_XML_CHUNKS_PER_WINDOW));
+
+    for (size_t first_chunk = 0; first_chunk < num_chunks; first_chunk += RR_GRAPH_XML_CHUNKS_PER_WINDOW) {
+        size_t window_size = std::min(RR_GRAPH_XML_CHUNKS_PER_WINDOW, num_chunks - first_chunk);
+
+        auto format_window_chunk = [&](size_t iwindow) {
+            size_t begin_node = (first_chunk + iwindow) * RR_GRAPH_XML_NODES_PER_CHUNK;
+            size_t end_node = std::min(num_nodes, begin_node + RR_GRAPH_XML_NODES_PER_CHUNK);
+            chunk_text[iwindow].clear();
+            format_chunk(begin_node, end_node, chunk_text[iwindow]);
+        };
+#ifdef RRGRAPH_USE_TBB
+        tbb::parallel_for(size_t(0), window_size, format_window_chunk);
+#else
+        for (size_t iwindow = 0; iwindow < window_size; iwindow++) {
+            format_window_chunk(iwindow);
+        }
+#endif
+
+        for (size_t iwindow = 0; iwindow < window_size; iwindow++) {
+            os.write(chunk_text[iwindow].data(), chunk_text[iwindow].size());
+        }
+    }
+}
+
+/**
+ * @brief Writes the rr graph to os in XML format
+ *
+ * The output is identical to uxsd::write_rr_graph_xml(). The small sections are written by the
+ * generated writer, but the node and edge records, which make up most of the file, are formatted
+ * in chunks directly from the rr graph.
+ */
+void write_rr_graph_xml(RrGraphSerializer& serializer,
+                        RRGraphBuilder* rr_graph_builder,
+                        const RRGraphView& rr_graph,
+                        const vtr::string_internment* strings,
+                        std::ostream& os) {
+    void* context = nullptr;
+
+    serializer.start_write();
+    os << "<rr_graph";
+    if ((bool)serializer.get_rr_graph_tool_comment(context))
+        os << " tool_comment=\"" << serializer.get_rr_graph_tool_comment(context) << "\"";
+    if ((bool)serializer.get_rr_graph_tool_name(context))
+        os << " tool_name=\"" << serializer.get_rr_graph_tool_name(context) << "\"";
+    if ((bool)serializer.get_rr_graph_tool_version(context))
+        os << " tool_version=\"" << serializer.get_rr_graph_tool_version(context) << "\"";
+    os << ">\n";
+
+    {
+        auto child_context = serializer.get_rr_graph_channels(context);
+        os << "<channels>\n";
+        uxsd::write_channels(serializer, os, child_context);
+        os << "</channels>\n";
+    }
+    {
+        auto child_context = serializer.get_rr_graph_switches(context);
+        os << "<switches>\n";
+        uxsd::write_switches(serializer, os, child_context);
+        os << "</switches>\n";
+    }
+    {
+        auto child_context = serializer.get_rr_graph_segments(context);
+        os << "<segments>\n";
+        uxsd::write_segments(serializer, os, child_context);
+        os << "</segments>\n";
+    }
+    {
+        auto child_context = serializer.get_rr_graph_block_types(context);
+        os << "<block_types>\n";
+        uxsd::write_block_types(serializer, os, child_context);
+        os << "</block_types>\n";
+    }
+    {
+        auto child_context = serializer.get_rr_graph_grid(context);
+        os << "<grid>\n";
+        uxsd::write_grid_locs(serializer, os, child_context);
+        os << "</grid>\n";
+    }
+
+    //The metadata lookups are built on first use, so build them before they are shared between threads
+    const MetadataStorage<int>& node_metadata = rr_graph_builder->rr_node_metadata();
+    const MetadataStorage<std::tuple<int, int, short>>& edge_metadata = rr_graph_builder->rr_edge_metadata();
+    node_metadata.size();
+    edge_metadata.size();
+
+    size_t num_nodes = serializer.num_rr_nodes_node(context);
+
+    os << "<rr_nodes>\n";
+    write_rr_node_chunks_xml(os, num_nodes, [&](size_t begin_node, size_t end_node, std::string& text) {
+        format_rr_node_records_xml(serializer, node_metadata, strings, begin_node, end_node, text);
+    });
+    os << "</rr_nodes>\n";
+
+    os << "<rr_edges>\n";
+    write_rr_node_chunks_xml(os, num_nodes, [&](size_t begin_node, size_t end_node, std::string& text) {
+        format_rr_edge_records_xml(rr_graph, edge_metadata, strings, begin_node, end_node, text);
+    });
+    os << "</rr_edges>\n";
+
+    os << "</rr_graph>\n";
+    serializer.finish_write();
+}
+
+} // namespace
+
 /************************ Subroutine definitions ****************************/
 
 /* This function is used to write the rr_graph into xml format into a a file with name: file_name */
@@ -74,8 +348,7 @@ void write_rr_graph(RRGraphBuilder* rr_graph_builder,
         std::fstream fp;
         fp.open(file_name, std::fstream::out | std::fstream::trunc);
         fp.precision(std::numeric_limits<float>::max_digits10);
-        void* context;
-        uxsd::write_rr_graph_xml(reader, context, fp);
+        write_rr_graph_xml(reader, rr_graph_builder, *rr_graph_view, &arch->strings, fp);
 #ifdef VTR_ENABLE_CAPNPROTO
     } else if (vtr::check_file_name_extension(file_name, ".bin")) {
         ::capnp::MallocMessageBuilder builder;
@@ -0,0 +1,404 @@
+#include "rr_graph_xml_edges.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+#ifdef RRGRAPH_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+/*********************** Subroutines local to this module *******************/
+
+namespace {
+
+///@brief Approximate size of the parts of the <rr_edges> section parsed concurrently
+constexpr size_t XML_RR_EDGES_CHUNK_BYTES = 16 * 1024 * 1024;
+
+bool is_xml_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool starts_with(const char* p, const char* end, std::string_view prefix) {
+    return size_t(end - p) >= prefix.size() && std::memcmp(p, prefix.data(), prefix.size()) == 0;
+}
+
+///@brief Returns true if p is at the start tag of an element called name (name includes the leading '<')
+bool starts_with_tag(const char* p, const char* end, std::string_view name) {
+    if (!starts_with(p, end, name) || size_t(end - p) == name.size()) {
+        return false;
+    }
+    char next = p[name.size()];
+    return is_xml_space(next) || next == '/' || next == '>';
+}
+
+///@brief Returns the first <edge> start tag in [p, end), or end if there is none
+const char* find_edge_start(const char* p, const char* end) {
+    while (p < end) {
+        p = static_cast<const char*>(std::memchr(p, '<', end - p));
+        if (!p) {
+            return end;
+        }
+        if (starts_with_tag(p, end, "<edge")) {
+            return p;
+        }
+        ++p;
+    }
+    return end;
+}
+
+bool parse_unsigned(std::string_view text, unsigned int& value) {
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+/**
+ * @brief Parses the elements of (a part of) the <rr_edges> section
+ *
+ * Any text outside of the supported subset of XML makes the parse fail, rather than being reported.
+ */
+class XmlRrEdgesParser {
+  public:
+    XmlRrEdgesParser(const char* begin, const char* end, bool read_edge_metadata, t_xml_rr_edges_chunk& chunk)
+        : p_(begin)
+        , end_(end)
+        , read_edge_metadata_(read_edge_metadata)
+        , chunk_(chunk) {}
+
+    /**
+     * @brief Parses the elements which start before chunk_end
+     *
+     * On success, pos() is the start of the first element at or after chunk_end (or the end of the section).
+     */
+    bool parse(const char* chunk_end) {
+        while (true) {
+            skip_space();
+            if (p_ >= chunk_end || p_ == end_) {
+                return true;
+            }
+            if (starts_with(p_, end_, "<!--")) {
+                if (!skip_comment()) return false;
+                continue;
+            }
+            if (!starts_with_tag(p_, end_, "<edge") || !parse_edge()) {
+                return false;
+            }
+            if (!first_edge_end_) {
+                first_edge_end_ = p_;
+            }
+        }
+    }
+
+    const char* pos() const { return p_; }
+    const char* first_edge_end() const { return first_edge_end_; }
+    bool saw_comment() const { return saw_comment_; }
+
+  private:
+    bool parse_edge() {
+        p_ += std::strlen("<edge");
+
+        t_xml_rr_edge edge;
+        bool has_src_node = false;
+        bool has_sink_node = false;
+        bool has_switch_id = false;
+        bool has_children = false;
+        if (!parse_attributes(has_children, [&](std::string_view name, std::string_view value) {
+                bool* has_attribute = nullptr;
+                unsigned int* attribute = nullptr;
+                if (name == "src_node") {
+                    has_attribute = &has_src_node;
+                    attribute = &edge.src_node;
+                } else if (name == "sink_node") {
+                    has_attribute = &has_sink_node;
+                    attribute = &edge.sink_node;
+                } else if (name == "switch_id") {
+                    has_attribute = &has_switch_id;
+                    attribute = &edge.switch_id;
+                } else {
+                    return false;
+                }
+                if (*has_attribute || !parse_unsigned(value, *attribute)) {
+                    return false;
+                }
+                *has_attribute = true;
+                return true;
+            })) {
+            return false;
+        }
+        if (!has_src_node || !has_sink_node || !has_switch_id) {
+            return false;
+        }
+        chunk_.edges.push_back(edge);
+
+        if (!has_children) {
+            return true;
+        }
+
+        bool has_metadata = false;
+        while (true) {
+            skip_space();
+            if (starts_with(p_, end_, "<!--")) {
+                if (!skip_comment()) return false;
+            } else if (starts_with(p_, end_, "</")) {
+                return parse_end_tag("edge");
+            } else if (!has_metadata && starts_with_tag(p_, end_, "<metadata")) {
+                if (!parse_metadata()) return false;
+                has_metadata = true;
+            } else {
+                return false;
+            }
+        }
+    }
+
+    bool parse_metadata() {
+        p_ += std::strlen("<metadata");
+        skip_space();
+        if (starts_with(p_, end_, "/>")) {
+            p_ += 2;
+            return true;
+        }
+        if (p_ == end_ || *p_ != '>') {
+            return false;
+        }
+        ++p_;
+
+        while (true) {
+            skip_space();
+            if (starts_with(p_, end_, "<!--")) {
+                if (!skip_comment()) return false;
+            } else if (starts_with(p_, end_, "</")) {
+                return parse_end_tag("metadata");
+            } else if (starts_with_tag(p_, end_, "<meta")) {
+                if (!parse_meta()) return false;
+            } else {
+                return false;
+            }
+        }
+    }
+
+    bool parse_meta() {
+        p_ += std::strlen("<meta");
+
+        std::string_view meta_name;
+        bool has_name = false;
+        bool has_children = false;
+        if (!parse_attributes(has_children, [&](std::string_view name, std::string_view value) {
+                //pugixml converts white space characters in attribute values
+                if (name != "name" || has_name || value.find_first_of("\t\n\r") != std::string_view::npos) {
+                    return false;
+                }
+                meta_name = value;
+                has_name = true;
+                return true;
+            })) {
+            return false;
+        }
+        if (!has_name) {
+            return false;
+        }
+
+        std::string_view meta_value;
+        if (has_children) {
+            const char* value_end = static_cast<const char*>(std::memchr(p_, '<', end_ - p_));
+            if (!value_end) {
+                return false;
+            }
+            meta_value = std::string_view(p_, value_end - p_);
+            //pugixml converts entity references and line ends in text
+            if (meta_value.find_first_of("&\r") != std::string_view::npos) {
+                return false;
+            }
+            p_ = value_end;
+            if (!starts_with(p_, end_, "</") || !parse_end_tag("meta")) {
+                return false;
+            }
+        }
+
+        if (read_edge_metadata_) {
+            chunk_.metadata.push_back({chunk_.edges.size() - 1, std::string(meta_name), std::string(meta_value)});
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses the attributes of a start tag with on_attribute(name, value), up to the closing '>' or '/>'
+     *
+     * has_children is set to true if the element is not empty (i.e. the tag ends with '>').
+     */
+    template<typename OnAttribute>
+    bool parse_attributes(bool& has_children, const OnAttribute& on_attribute) {
+        while (true) {
+            bool separated = skip_space();
+            if (starts_with(p_, end_, "/>")) {
+                p_ += 2;
+                has_children = false;
+                return true;
+            }
+            if (p_ == end_) {
+                return false;
+            }
+            if (*p_ == '>') {
+                ++p_;
+                has_children = true;
+                return true;
+            }
+            if (!separated) {
+                return false;
+            }
+
+            const char* name_begin = p_;
+            while (p_ < end_ && *p_ != '=' && !is_xml_space(*p_) && *p_ != '>' && *p_ != '/') {
+                ++p_;
+            }
+            std::string_view name(name_begin, p_ - name_begin);
+            skip_space();
+            if (name.empty() || p_ == end_ || *p_ != '=') {
+                return false;
+            }
+            ++p_;
+            skip_space();
+            if (p_ == end_ || (*p_ != '"' && *p_ != '\'')) {
+                return false;
+            }
+            char quote = *p_++;
+            const char* value_end = static_cast<const char*>(std::memchr(p_, quote, end_ - p_));
+            if (!value_end) {
+                return false;
+            }
+            std::string_view value(p_, value_end - p_);
+            p_ = value_end + 1;
+            if (value.find_first_of("<&") != std::string_view::npos || !on_attribute(name, value)) {
+                return false;
+            }
+        }
+    }
+
+    ///@brief Parses the end tag </name>
+    bool parse_end_tag(std::string_view name) {
+        p_ += 2;
+        if (!starts_with(p_, end_, name)) {
+            return false;
+        }
+        p_ += name.size();
+        skip_space();
+        if (p_ == end_ || *p_ != '>') {
+            return false;
+        }
+        ++p_;
+        return true;
+    }
+
+    bool skip_comment() {
+        std::string_view text(p_ + 4, end_ - p_ - 4);
+        size_t comment_end = text.find("-->");
+        if (comment_end == std::string_view::npos) {
+            return false;
+        }
+        p_ = text.data() + comment_end + 3;
+        saw_comment_ = true;
+        return true;
+    }
+
+    ///@brief Skips any white space, returns true if there was some
+    bool skip_space() {
+        const char* begin = p_;
+        while (p_ < end_ && is_xml_space(*p_)) {
+            ++p_;
+        }
+        return p_ != begin;
+    }
+
+  private:
+    const char* p_;
+    const char* end_;
+    bool read_edge_metadata_;
+    t_xml_rr_edges_chunk& chunk_;
+
+    const char* first_edge_end_ = nullptr;
+    bool saw_comment_ = false;
+};
+
+/**
+ * @brief Parses the elements in [begin, end) of the <rr_edges> section in num_chunks chunks
+ *
+ * The chunks start at <edge> tags found by a plain text search, which may be within comments: saw_comment
+ * is set if any chunk contains comments, in which case the chunks are not reliable.
+ */
+bool parse_xml_rr_edges_chunks(const char* begin,
+                               const char* end,
+                               size_t num_chunks,
+                               bool read_edge_metadata,
+                               t_xml_rr_edges& xml_edges,
+                               bool& saw_comment) {
+    std::vector<const char*> chunk_begins = {begin};
+    for (size_t ichunk = 1; ichunk < num_chunks; ichunk++) {
+        const char* approx_begin = begin + (end - begin) / num_chunks * ichunk;
+        chunk_begins.push_back(find_edge_start(std::max(approx_begin, chunk_begins.back()), end));
+    }
+    chunk_begins.push_back(end);
+
+    xml_edges.chunks.clear();
+    xml_edges.chunks.resize(num_chunks);
+    std::vector<char> chunk_ok(num_chunks, false);
+    std::vector<char> chunk_saw_comment(num_chunks, false);
+    std::vector<const char*> chunk_first_edge_end(num_chunks, nullptr);
+
+    auto parse_chunk = [&](size_t ichunk) {
+        XmlRrEdgesParser parser(chunk_begins[ichunk], end, read_edge_metadata, xml_edges.chunks[ichunk]);
+        chunk_ok[ichunk] = parser.parse(chunk_begins[ichunk + 1]) && parser.pos() == chunk_begins[ichunk + 1];
+        chunk_saw_comment[ichunk] = parser.saw_comment();
+        chunk_first_edge_end[ichunk] = parser.first_edge_end();
+    };
+#ifdef RRGRAPH_USE_TBB
+    tbb::parallel_for(size_t(0), num_chunks, parse_chunk);
+#else
+    for (size_t ichunk = 0; ichunk < num_chunks; ichunk++) {
+        parse_chunk(ichunk);
+    }
+#endif
+
+    saw_comment = std::find(chunk_saw_comment.begin(), chunk_saw_comment.end(), true) != chunk_saw_comment.end();
+    if (std::find(chunk_ok.begin(), chunk_ok.end(), false) != chunk_ok.end()) {
+        return false;
+    }
+
+    auto first_edge_end = std::find_if(chunk_first_edge_end.begin(), chunk_first_edge_end.end(), [](const char* p) { return p != nullptr; });
+    if (first_edge_end == chunk_first_edge_end.end()) {
+        return false; //The schema requires at least one edge
+    }
+    xml_edges.first_edge_end = *first_edge_end;
+    xml_edges.rr_edges_end = end;
+    return true;
+}
+
+} // namespace
+
+/************************ Subroutine definitions ****************************/
+
+bool parse_xml_rr_edges(const char* begin, const char* end, bool read_edge_metadata, t_xml_rr_edges& xml_edges) {
+    std::string_view text(begin, end - begin);
+    size_t rr_edges_begin = text.find("<rr_edges>");
+    size_t rr_edges_end = text.rfind("</rr_edges>");
+    if (rr_edges_begin == std::string_view::npos || rr_edges_end == std::string_view::npos || rr_edges_end < rr_edges_begin) {
+        return false;
+    }
+    const char* content_begin = begin + rr_edges_begin + std::strlen("<rr_edges>");
+    const char* content_end = begin + rr_edges_end;
+
+    size_t num_chunks = 1;
+#ifdef RRGRAPH_USE_TBB
+    num_chunks = std::max<size_t>(1, (content_end - content_begin) / XML_RR_EDGES_CHUNK_BYTES);
+#endif
+
+    bool saw_comment = false;
+    bool parsed = parse_xml_rr_edges_chunks(content_begin, content_end, num_chunks, read_edge_metadata, xml_edges, saw_comment);
+    if (num_chunks > 1 && saw_comment) {
+        //Some chunks may have started within comments, so parse the section as a whole
+        parsed = parse_xml_rr_edges_chunks(content_begin, content_end, 1, read_edge_metadata, xml_edges, saw_comment);
+    }
+    if (!parsed) {
+        xml_edges = t_xml_rr_edges();
+    }
+    return parsed;
+}
@@ -0,0 +1,58 @@
+/* Defines a direct parser for the <rr_edges> section of rr graphs written in xml format */
+
+#ifndef RR_GRAPH_XML_EDGES_H
+#define RR_GRAPH_XML_EDGES_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief An <edge> element of an XML rr graph file
+ */
+struct t_xml_rr_edge {
+    unsigned int src_node;
+    unsigned int sink_node;
+    unsigned int switch_id;
+};
+
+/**
+ * @brief A <meta> element of the metadata of an <edge> element
+ */
+struct t_xml_rr_edge_meta {
+    size_t iedge; ///<Index of the edge in its chunk
+    std::string name;
+    std::string value;
+};
+
+/**
+ * @brief The edges of a contiguous part of the <rr_edges> section, in file order
+ */
+struct t_xml_rr_edges_chunk {
+    std::vector<t_xml_rr_edge> edges;
+    std::vector<t_xml_rr_edge_meta> metadata; ///<Only parsed if requested
+};
+
+/**
+ * @brief The <rr_edges> section of an XML rr graph file, parsed straight from the file text
+ */
+struct t_xml_rr_edges {
+    std::vector<t_xml_rr_edges_chunk> chunks; ///<The edges, in file order
+
+    const char* first_edge_end = nullptr; ///<End of the first <edge> element
+    const char* rr_edges_end = nullptr;   ///<Start of the </rr_edges> tag
+};
+
+/**
+ * @brief Parses the <edge> elements of the <rr_edges> section of the XML rr graph file text [begin, end)
+ *
+ * Parsing an rr graph with pugixml builds a DOM of the whole file, where the edges take up most of
+ * the memory and time. This parser instead reads the edges straight from the text, in parallel chunks
+ * if built with TBB. It only supports the subset of XML written by VPR (and comments): it returns false
+ * if the file contains anything else (e.g. entity references or CDATA) in the <rr_edges> section,
+ * or if the section is malformed. The file should then be parsed by pugixml, which reports any errors.
+ *
+ * The metadata of the edges is only parsed (instead of just checked) if read_edge_metadata is true.
+ */
+bool parse_xml_rr_edges(const char* begin, const char* end, bool read_edge_metadata, t_xml_rr_edges& xml_edges);
+
+#endif /* RR_GRAPH_XML_EDGES_H */
@@ -21,6 +21,10 @@
 
 #include "histogram.h"
 
+#ifdef RRGRAPH_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 /******************* Subroutines local to this module ************************/
 
 static void load_rr_indexed_data_base_costs(const RRGraphView& rr_graph, vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data, enum e_base_cost_type base_cost_type, const bool echo_enabled, const char* echo_file_name);
@@ -29,7 +33,22 @@ static float get_delay_normalization_fac(const vtr::vector<RRIndexedDataId, t_rr
 
 static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph, vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data);
 
-static void calculate_average_switch(const RRGraphView& rr_graph, int inode, double& avg_switch_R, double& avg_switch_T, double& avg_switch_Cinternal, int& num_switches, short& buffered, vtr::vector<RRNodeId, std::vector<RREdgeId>>& fan_in_list);
+/* The average parameters of the non-SHORT fan-in switches of a routing wire */
+struct t_avg_fan_in_switch {
+    double R = 0;
+    double T = 0;
+    double Cinternal = 0;
+    int num_switches = 0;
+    short buffered = UNDEFINED;
+};
+
+/* Number of consecutive rr nodes whose fan-in switches are averaged together by load_rr_indexed_data_T_values() */
+static constexpr size_t T_VALUES_NODE_CHUNK_SIZE = 4096;
+
+/* Number of chunks averaged (in parallel) before their results are collected */
+static constexpr size_t T_VALUES_CHUNKS_PER_WINDOW = 64;
+
+static void calculate_average_switch(const RRGraphView& rr_graph, RRNodeId node, t_avg_fan_in_switch& avg_switch, vtr::array_view<const RREdgeId> fan_in_edges);
 
 static void fixup_rr_indexed_data_T_values(vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data, size_t num_segment);
 
@@ -494,7 +513,38 @@ static float get_delay_normalization_fac(const vtr::vector<RRIndexedDataId, t_rr
  */
 static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
                                           vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data) {
-    auto fan_in_list = get_fan_in_list(rr_graph);
+    const t_rr_graph_storage& rr_nodes = rr_graph.rr_nodes();
+    size_t num_nodes = rr_graph.num_nodes();
+
+    /*
+     * The fan-in edges of every node, sorted by edge id. The in-edges of the graph are reused
+     * if they were already built, otherwise they are built the same way (a counting sort of
+     * the edges by sink node), which is much cheaper than a vector of edges per node.
+     */
+    std::vector<uint32_t> node_first_fan_in;
+    std::vector<RREdgeId> fan_in_edges;
+    if (!rr_nodes.has_in_edges()) {
+        node_first_fan_in.resize(num_nodes + 1, 0);
+        rr_nodes.for_each_edge([&](RREdgeId /*edge*/, RRNodeId /*src*/, RRNodeId sink) {
+            node_first_fan_in[size_t(sink) + 1]++;
+        });
+        for (size_t inode = 1; inode <= num_nodes; inode++) {
+            node_first_fan_in[inode] += node_first_fan_in[inode - 1];
+        }
+
+        std::vector<uint32_t> next_slot(node_first_fan_in.begin(), node_first_fan_in.end() - 1);
+        fan_in_edges.resize(node_first_fan_in.back());
+        rr_nodes.for_each_edge([&](RREdgeId edge, RRNodeId /*src*/, RRNodeId sink) {
+            fan_in_edges[next_slot[size_t(sink)]++] = edge;
+        });
+    }
+    auto node_fan_in_edges = [&](RRNodeId node) {
+        if (rr_nodes.has_in_edges()) {
+            return rr_nodes.node_in_edges(node);
+        }
+        uint32_t first = node_first_fan_in[size_t(node)];
+        return vtr::array_view<const RREdgeId>(fan_in_edges.data() + first, node_first_fan_in[size_t(node) + 1] - first);
+    };
 
     vtr::vector<RRIndexedDataId, int> num_nodes_of_index(rr_indexed_data.size(), 0);
     vtr::vector<RRIndexedDataId, std::vector<float>> C_total(rr_indexed_data.size());
@@ -518,57 +568,86 @@ static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
      *
      * The median of R and C values for each cost index is assigned to the indexed
      * data.
+     *
+     * The fan-in switches of the nodes are averaged in parallel, a window of chunks
+     * at a time. The averages are then collected serially in node order, so the values
+     * (and warnings) are the same as those of a serial walk.
      */
-    for (const RRNodeId& rr_id : rr_graph.nodes()) {
-        t_rr_type rr_type = rr_graph.node_type(rr_id);
+    const size_t window_size = T_VALUES_NODE_CHUNK_SIZE * T_VALUES_CHUNKS_PER_WINDOW;
+    std::vector<t_avg_fan_in_switch> window_avg_switches(std::min(num_nodes, window_size));
+
+    for (size_t window_begin = 0; window_begin < num_nodes; window_begin += window_size) {
+        size_t window_end = std::min(num_nodes, window_begin + window_size);
+        size_t num_chunks = (window_end - window_begin + T_VALUES_NODE_CHUNK_SIZE - 1) / T_VALUES_NODE_CHUNK_SIZE;
+
+        auto average_chunk = [&](size_t ichunk) {
+            size_t chunk_begin = window_begin + ichunk * T_VALUES_NODE_CHUNK_SIZE;
+            size_t chunk_end = std::min(window_end, chunk_begin + T_VALUES_NODE_CHUNK_SIZE);
+            for (size_t inode = chunk_begin; inode < chunk_end; inode++) {
+                RRNodeId rr_id(inode);
+                t_rr_type rr_type = rr_graph.node_type(rr_id);
+                if (rr_type != CHANX && rr_type != CHANY) {
+                    continue;
+                }
+                calculate_average_switch(rr_graph, rr_id, window_avg_switches[inode - window_begin], node_fan_in_edges(rr_id));
+            }
+        };
 
-        if (rr_type != CHANX && rr_type != CHANY) {
-            continue;
+#ifdef RRGRAPH_USE_TBB
+        tbb::parallel_for(size_t(0), num_chunks, average_chunk);
+#else
+        for (size_t ichunk = 0; ichunk < num_chunks; ichunk++) {
+            average_chunk(ichunk);
         }
+#endif
+
+        for (size_t inode = window_begin; inode < window_end; inode++) {
+            RRNodeId rr_id(inode);
+            t_rr_type rr_type = rr_graph.node_type(rr_id);
+
+            if (rr_type != CHANX && rr_type != CHANY) {
+                continue;
+            }
 
-        auto cost_index = rr_graph.node_cost_index(rr_id);
+            auto cost_index = rr_graph.node_cost_index(rr_id);
 
-        auto node_cords = rr_graph.node_coordinate_to_string(RRNodeId(rr_id));
+            /* get average switch parameters */
+            const t_avg_fan_in_switch& avg_switch = window_avg_switches[inode - window_begin];
+            short buffered = avg_switch.buffered;
 
-        /* get average switch parameters */
-        double avg_switch_R = 0;
-        double avg_switch_T = 0;
-        double avg_switch_Cinternal = 0;
-        int num_switches = 0;
-        short buffered = UNDEFINED;
-        calculate_average_switch(rr_graph, (size_t)rr_id, avg_switch_R, avg_switch_T, avg_switch_Cinternal, num_switches, buffered, fan_in_list);
+            if (avg_switch.num_switches == 0) {
+                auto node_cords = rr_graph.node_coordinate_to_string(rr_id);
+                VTR_LOG_WARN("Node: %d with RR_type: %s  at Location:%s, had no out-going switches\n", rr_id,
+                             rr_graph.node_type_string(rr_id), node_cords.c_str());
+                continue;
+            }
+            VTR_ASSERT(avg_switch.num_switches > 0);
 
-        if (num_switches == 0) {
-            VTR_LOG_WARN("Node: %d with RR_type: %s  at Location:%s, had no out-going switches\n", rr_id,
-                         rr_graph.node_type_string(rr_id), node_cords.c_str());
-            continue;
-        }
-        VTR_ASSERT(num_switches > 0);
-
-        num_nodes_of_index[cost_index]++;
-        C_total[cost_index].push_back(rr_graph.node_C(rr_id));
-        R_total[cost_index].push_back(rr_graph.node_R(rr_id));
-
-        switch_R_total[cost_index].push_back(avg_switch_R);
-        switch_T_total[cost_index].push_back(avg_switch_T);
-        switch_Cinternal_total[cost_index].push_back(avg_switch_Cinternal);
-        if (buffered == UNDEFINED) {
-            /* this segment does not have any outgoing edges to other general routing wires */
-            continue;
-        }
+            num_nodes_of_index[cost_index]++;
+            C_total[cost_index].push_back(rr_graph.node_C(rr_id));
+            R_total[cost_index].push_back(rr_graph.node_R(rr_id));
 
-        /* need to make sure all wire switches of a given wire segment type have the same 'buffered' value */
-        if (switches_buffered[cost_index] == UNDEFINED) {
-            switches_buffered[cost_index] = buffered;
-        } else {
-            if (switches_buffered[cost_index] != buffered) {
-                // If a previous buffering state is inconsistent with the current one,
-                // the node should be treated as buffered, as there are only two possible
-                // values for the buffering state (except for the UNDEFINED case).
-                //
-                // This means that at least one edge of this node has a buffered switch,
-                // which prevails over unbuffered ones.
-                switches_buffered[cost_index] = 1;
+            switch_R_total[cost_index].push_back(avg_switch.R);
+            switch_T_total[cost_index].push_back(avg_switch.T);
+            switch_Cinternal_total[cost_index].push_back(avg_switch.Cinternal);
+            if (buffered == UNDEFINED) {
+                /* this segment does not have any outgoing edges to other general routing wires */
+                continue;
+            }
+
+            /* need to make sure all wire switches of a given wire segment type have the same 'buffered' value */
+            if (switches_buffered[cost_index] == UNDEFINED) {
+                switches_buffered[cost_index] = buffered;
+            } else {
+                if (switches_buffered[cost_index] != buffered) {
+                    // If a previous buffering state is inconsistent with the current one,
+                    // the node should be treated as buffered, as there are only two possible
+                    // values for the buffering state (except for the UNDEFINED case).
+                    //
+                    // This means that at least one edge of this node has a buffered switch,
+                    // which prevails over unbuffered ones.
+                    switches_buffered[cost_index] = 1;
+                }
             }
         }
     }
@@ -627,15 +706,13 @@ static void load_rr_indexed_data_T_values(const RRGraphView& rr_graph,
  * It is not safe to assume that each node of the same wire type has the same switches with the same
  * delays, therefore we take their average to take into account the possible differences
  */
-static void calculate_average_switch(const RRGraphView& rr_graph, int inode, double& avg_switch_R, double& avg_switch_T, double& avg_switch_Cinternal, int& num_switches, short& buffered, vtr::vector<RRNodeId, std::vector<RREdgeId>>& fan_in_list) {
-    auto node = RRNodeId(inode);
-
-    avg_switch_R = 0;
-    avg_switch_T = 0;
-    avg_switch_Cinternal = 0;
-    num_switches = 0;
-    buffered = UNDEFINED;
-    for (const auto& edge : fan_in_list[node]) {
+static void calculate_average_switch(const RRGraphView& rr_graph, RRNodeId node, t_avg_fan_in_switch& avg_switch, vtr::array_view<const RREdgeId> fan_in_edges) {
+    double avg_switch_R = 0;
+    double avg_switch_T = 0;
+    double avg_switch_Cinternal = 0;
+    int num_switches = 0;
+    short buffered = UNDEFINED;
+    for (const auto& edge : fan_in_edges) {
         /* want to get C/R/Tdel/Cinternal of switches that connect this track segment to other track segments */
         if (rr_graph.node_type(node) == CHANX || rr_graph.node_type(node) == CHANY) {
             int switch_index = rr_graph.rr_nodes().edge_switch(edge);
@@ -675,6 +752,12 @@ static void calculate_average_switch(const RRGraphView& rr_graph, int inode, dou
     VTR_ASSERT(std::isfinite(avg_switch_R));
     VTR_ASSERT(std::isfinite(avg_switch_T));
     VTR_ASSERT(std::isfinite(avg_switch_Cinternal));
+
+    avg_switch.R = avg_switch_R;
+    avg_switch.T = avg_switch_T;
+    avg_switch.Cinternal = avg_switch_Cinternal;
+    avg_switch.num_switches = num_switches;
+    avg_switch.buffered = buffered;
 }
 
 static void fixup_rr_indexed_data_T_values(vtr::vector<RRIndexedDataId, t_rr_indexed_data>& rr_indexed_data,
@@ -427,8 +427,38 @@ class BitFields {
     static size_t size() {
         return (sizeof(T) << 2); // 8 bit in a byte, 2 bits for a verilog bits = 4 bits in a byte, << 2 = sizeof x 4
     }
+
+    /**
+     * raw access to the 2 bit encoded verilog bits, for the word level operations
+     */
+    T get_raw() {
+        return this->bits;
+    }
+
+    void set_raw(T raw, T mask) {
+        this->bits = static_cast<T>((this->bits & ~mask) | (raw & mask));
+    }
 };
 
+/**
+ * pack the low bit of each of the 8 encoded verilog bits (0 or 1 only) into a byte, and back
+ */
+inline uint64_t pack_known_bits(veri_internal_bits_t raw) {
+    uint64_t packed = raw & 0x5555;
+    packed = (packed | (packed >> 1)) & 0x3333;
+    packed = (packed | (packed >> 2)) & 0x0F0F;
+    packed = (packed | (packed >> 4)) & 0x00FF;
+    return packed;
+}
+
+inline veri_internal_bits_t unpack_known_bits(uint64_t packed) {
+    packed &= 0x00FF;
+    packed = (packed | (packed << 4)) & 0x0F0F;
+    packed = (packed | (packed << 2)) & 0x3333;
+    packed = (packed | (packed << 1)) & 0x5555;
+    return static_cast<veri_internal_bits_t>(packed);
+}
+
 // #define DEBUG_V_BITS
 
 /*****
@@ -447,6 +477,20 @@ class VerilogBits {
         return this->bits.size();
     }
 
+    /**
+     * mask of the encoded bits of a bitfield which are part of the bitstring
+     */
+    veri_internal_bits_t valid_mask(size_t index) {
+        size_t first_bit = index * BitFields<veri_internal_bits_t>::size();
+        if (first_bit >= this->bit_size)
+            return 0;
+
+        size_t valid_bits = std::min(this->bit_size - first_bit, BitFields<veri_internal_bits_t>::size());
+        return static_cast<veri_internal_bits_t>((1UL << (valid_bits << 1)) - 1);
+    }
+
+    static_assert(64 % (sizeof(veri_internal_bits_t) << 2) == 0, "bitfields must not straddle 64 bit words");
+
   public:
     VerilogBits() {
         this->bit_size = 0;
@@ -525,14 +569,59 @@ class VerilogBits {
     }
 
     bool has_unknown() {
-        for (size_t address = 0x0; address < this->size(); address++) {
-            if (is_unk[this->get_bit(address)])
+        /* x and z are the only values with the high bit set */
+        for (size_t i = 0; i < this->list_size(); i++) {
+            if (this->bits[i].get_raw() & this->valid_mask(i) & _All_x)
                 return true;
         }
 
         return false;
     }
 
+    /**
+     * Packs the bits [0, length) lsb first into 64 bit words, using pad past the end of the bitstring.
+     * The bits of the last word past length are 0.
+     * Returns false if one of the bits or the pad is x or z, since those only have a 4-valued meaning.
+     */
+    bool get_words(std::vector<uint64_t>& words, size_t length, bit_value_t pad) {
+        if (is_unk[pad])
+            return false;
+
+        words.assign((length + 63) / 64, (pad == _1) ? ~0ULL : 0ULL);
+
+        const size_t field_size = BitFields<veri_internal_bits_t>::size();
+        size_t known_length = std::min(length, this->size());
+        for (size_t i = 0; i * field_size < known_length; i++) {
+            veri_internal_bits_t raw = static_cast<veri_internal_bits_t>(this->bits[i].get_raw() & this->valid_mask(i));
+            if (raw & _All_x)
+                return false;
+
+            size_t first_bit = i * field_size;
+            size_t field_bits = std::min(known_length - first_bit, field_size);
+            uint64_t field_mask = ((1ULL << field_bits) - 1) << (first_bit % 64);
+
+            uint64_t& word = words[first_bit / 64];
+            word = (word & ~field_mask) | ((pack_known_bits(raw) << (first_bit % 64)) & field_mask);
+        }
+
+        if (length % 64)
+            words.back() &= (1ULL << (length % 64)) - 1;
+
+        return true;
+    }
+
+    /**
+     * Sets every bit of the bitstring from words, packed lsb first as in get_words()
+     */
+    void set_words(const std::vector<uint64_t>& words) {
+        const size_t field_size = BitFields<veri_internal_bits_t>::size();
+        for (size_t i = 0; i * field_size < this->size(); i++) {
+            size_t first_bit = i * field_size;
+            uint64_t packed = words[first_bit / 64] >> (first_bit % 64);
+            this->bits[i].set_raw(unpack_known_bits(packed), this->valid_mask(i));
+        }
+    }
+
     bool is_only_z() {
         for (size_t address = 0x0; address < this->size(); address++) {
             if (!is_z_bit[this->get_bit(address)])
@@ -597,6 +686,18 @@ class VerilogBits {
     VerilogBits twos_complement(BitSpace::bit_value_t previous_carry) {
         VerilogBits other(this->bit_size, _0);
 
+        /* without x and z, this is a word level negation */
+        std::vector<uint64_t> words;
+        if (!is_unk[previous_carry] && this->get_words(words, this->size(), _0)) {
+            uint64_t carry = (previous_carry == _1) ? 1 : 0;
+            for (uint64_t& word : words) {
+                word = ~word + carry;
+                carry = (carry && word == 0) ? 1 : 0;
+            }
+            other.set_words(words);
+            return other;
+        }
+
         for (size_t i = 0; i < this->size(); i++) {
             BitSpace::bit_value_t not_bit_i = BitSpace::l_not[this->get_bit(i)];
 
@@ -1053,6 +1154,17 @@ class VNumber {
         return this->bitstring.has_unknown();
     }
 
+    /**
+     * Packs the bits [0, length) into 64 bit words, lsb first and padded, see VerilogBits::get_words()
+     */
+    bool get_words(std::vector<uint64_t>& words, size_t length) {
+        return this->bitstring.get_words(words, length, this->get_padding_bit());
+    }
+
+    void set_words(const std::vector<uint64_t>& words) {
+        this->bitstring.set_words(words);
+    }
+
     bool is_z() {
         return this->bitstring.is_only_z();
     }
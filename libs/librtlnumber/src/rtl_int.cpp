@@ -7,6 +7,7 @@
  */
 
 #include <string>
+#include <vector>
 
 #include "internal_bits.hpp"
 #include "rtl_int.hpp"
@@ -73,6 +74,19 @@ static compare_bit eval_op(VNumber& a_in, VNumber& b_in) {
     }
 
     size_t std_length = std::max(a.size(), b.size());
+
+    /* without x and z, compare whole words from the msb */
+    std::vector<uint64_t> words_a;
+    std::vector<uint64_t> words_b;
+    if (a.get_words(words_a, std_length) && b.get_words(words_b, std_length)) {
+        for (size_t i = words_a.size() - 1; i < words_a.size(); i--) {
+            if (words_a[i] != words_b[i])
+                return ((words_a[i] < words_b[i]) != invert_result) ? LT_EVAL : GT_EVAL;
+        }
+
+        return EQ_EVAL;
+    }
+
     bit_value_t pad_a = a.get_padding_bit();
     bit_value_t pad_b = b.get_padding_bit();
 
@@ -143,6 +157,25 @@ static VNumber sum_op(VNumber& a, VNumber& b, const bit_value_t& initial_carry,
     bit_value_t previous_carry = initial_carry;
     VNumber result(new_length, _0, is_addition_signed_operation, a.is_defined_size() && b.is_defined_size());
 
+    /* without x and z, add whole words at once */
+    std::vector<uint64_t> words_a;
+    std::vector<uint64_t> words_b;
+    if (!is_unk[initial_carry] && a.get_words(words_a, new_length) && b.get_words(words_b, new_length)) {
+        uint64_t carry = (initial_carry == _1) ? 1 : 0;
+        for (size_t i = 0; i < words_a.size(); i++) {
+            uint64_t sum = words_a[i] + words_b[i];
+            uint64_t carry_out = (sum < words_a[i]) ? 1 : 0;
+            sum += carry;
+            carry_out |= (sum < carry) ? 1 : 0;
+
+            words_a[i] = sum;
+            carry = carry_out;
+        }
+
+        result.set_words(words_a);
+        return result;
+    }
+
     for (size_t i = 0; i < new_length; i++) {
         bit_value_t bit_a = pad_a;
         if (i < a.size()) {
@@ -0,0 +1,93 @@
+#include "gzip_input_stream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "vtr_error.h"
+#include "vtr_util.h"
+
+// Size of the chunks inflated at once, and the number of chunks inflated ahead of the reader
+constexpr size_t GZIP_CHUNK_SIZE = 1 << 20;
+constexpr size_t GZIP_MAX_CHUNKS_AHEAD = 4;
+
+GzipInputStream::GzipInputStream(const std::string& file)
+    : file_name_(file)
+    , file_(gzopen(file.c_str(), "rb")) {
+    if (file_ == Z_NULL) {
+        throw vtr::VtrError(vtr::string_fmt("Failed to open gzipped file '%s'", file.c_str()), __FILE__, __LINE__);
+    }
+    gzbuffer(file_, GZIP_CHUNK_SIZE);
+
+    thread_ = std::thread([this]() { inflate_chunks(); });
+}
+
+GzipInputStream::~GzipInputStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    chunk_read_.notify_all();
+    thread_.join();
+
+    gzclose(file_);
+}
+
+void GzipInputStream::inflate_chunks() {
+    while (true) {
+        std::vector<unsigned char> chunk(GZIP_CHUNK_SIZE);
+        int ret = gzread(file_, chunk.data(), chunk.size());
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (ret < 0) {
+            int errnum;
+            error_ = gzerror(file_, &errnum);
+            done_ = true;
+        } else if (ret == 0) {
+            done_ = true;
+        } else {
+            chunk.resize(ret);
+            chunk_read_.wait(lock, [this]() { return stop_ || chunks_.size() < GZIP_MAX_CHUNKS_AHEAD; });
+            if (stop_) {
+                done_ = true;
+            } else {
+                chunks_.push_back(std::move(chunk));
+            }
+        }
+        bool finished = done_;
+        lock.unlock();
+        chunk_ready_.notify_one();
+
+        if (finished) break;
+    }
+}
+
+size_t GzipInputStream::tryRead(void* buffer, size_t minBytes, size_t maxBytes) {
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    size_t num_read = 0;
+
+    while (num_read < minBytes) {
+        if (chunk_pos_ == chunk_.size()) {
+            //Wait for the next inflated chunk
+            std::unique_lock<std::mutex> lock(mutex_);
+            chunk_ready_.wait(lock, [this]() { return !chunks_.empty() || done_; });
+            if (chunks_.empty()) {
+                if (!error_.empty()) {
+                    throw vtr::VtrError(vtr::string_fmt("Failed to inflate '%s': %s", file_name_.c_str(), error_.c_str()), __FILE__, __LINE__);
+                }
+                break; //End of file
+            }
+            chunk_ = std::move(chunks_.front());
+            chunks_.pop_front();
+            chunk_pos_ = 0;
+            lock.unlock();
+            chunk_read_.notify_one();
+        }
+
+        size_t num_copied = std::min(maxBytes - num_read, chunk_.size() - chunk_pos_);
+        std::memcpy(out + num_read, chunk_.data() + chunk_pos_, num_copied);
+        chunk_pos_ += num_copied;
+        num_read += num_copied;
+    }
+
+    return num_read;
+}
@@ -0,0 +1,54 @@
+#ifndef GZIP_INPUT_STREAM_H_
+#define GZIP_INPUT_STREAM_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+#include "kj/io.h"
+
+// Input stream of a gzipped file, which is inflated as it is read.
+//
+// Reading a capnp message through it (e.g. with capnp::InputStreamMessageReader)
+// avoids first decompressing the whole file into memory. The file is inflated by
+// a separate thread a few chunks ahead of the reader, so inflating overlaps with
+// copying the message.
+class GzipInputStream : public kj::InputStream {
+  public:
+    explicit GzipInputStream(const std::string& file);
+    ~GzipInputStream();
+
+    GzipInputStream(const GzipInputStream&) = delete;
+    GzipInputStream& operator=(const GzipInputStream&) = delete;
+
+    size_t tryRead(void* buffer, size_t minBytes, size_t maxBytes) override;
+
+  private:
+    void inflate_chunks();
+
+  private:
+    std::string file_name_;
+    gzFile file_;
+
+    // Inflated chunks not yet read, shared with the inflating thread
+    std::mutex mutex_;
+    std::condition_variable chunk_ready_;
+    std::condition_variable chunk_read_;
+    std::deque<std::vector<unsigned char>> chunks_;
+    bool done_ = false;
+    bool stop_ = false;
+    std::string error_;
+
+    // The chunk currently being read, and the position of the next byte in it
+    std::vector<unsigned char> chunk_;
+    size_t chunk_pos_ = 0;
+
+    std::thread thread_;
+};
+
+#endif /* GZIP_INPUT_STREAM_H_ */
@@ -6,6 +6,11 @@
 // Functions:
 //  ToNdMatrix - Converts Matrix capnproto message to vtr::NdMatrix
 //  FromNdMatrix - Converts vtr::NdMatrix to Matrix capnproto
+//  FromNdMatrixRaw - Stores a vtr::NdMatrix of trivially copyable values in
+//                    Matrix capnproto as raw bytes, which ToNdMatrix reads back
+//                    with a single copy.  Much faster and smaller for large
+//                    matrices, but only readable on machines with the same
+//                    type layout and endianness.
 //
 // Example:
 //
@@ -56,11 +61,38 @@
 //      vtr::NdMatrix<Vec2, 3> mat_out;
 //      ToNdMatrix<3, Test::Vec2, Vec2>(&mat_out, test.getVectors(), FromVec2);
 //  }
+#include <cstring>
 #include <functional>
+#include <type_traits>
 #include "vtr_ndmatrix.h"
 #include "vpr_error.h"
 #include "matrix.capnp.h"
 
+// Copies the raw bytes of a Matrix capnproto message (see FromNdMatrixRaw) into
+// the storage of m_out, which must already have the dimensions of the message.
+template<size_t N, typename CType>
+void ToNdMatrixRaw(
+    vtr::NdMatrix<CType, N>* m_out,
+    const ::capnp::Data::Reader& raw,
+    size_t required_elements) {
+    if constexpr (std::is_trivially_copyable<CType>::value) {
+        if (raw.size() != required_elements * sizeof(CType)) {
+            VPR_THROW(VPR_ERROR_OTHER,
+                      "Wrong raw matrix size, expected %zu bytes, actual %zu",
+                      required_elements * sizeof(CType), raw.size());
+        }
+        if (required_elements > 0) {
+            std::memcpy(&m_out->get(0), raw.begin(), raw.size());
+        }
+    } else {
+        (void)m_out;
+        (void)required_elements;
+        VPR_THROW(VPR_ERROR_OTHER,
+                  "Raw matrix data of %zu bytes can not be read into a matrix of non trivially copyable values",
+                  raw.size());
+    }
+}
+
 // Generic function to convert from Matrix capnproto message to vtr::NdMatrix.
 //
 // Template arguments:
@@ -93,6 +125,11 @@ void ToNdMatrix(
     }
     m_out->resize(dim_sizes);
 
+    if (m_in.hasRaw()) {
+        ToNdMatrixRaw<N, CType>(m_out, m_in.getRaw(), required_elements);
+        return;
+    }
+
     const auto& data = m_in.getData();
     if (data.size() != required_elements) {
         VPR_THROW(VPR_ERROR_OTHER,
@@ -138,4 +175,39 @@ void FromNdMatrix(
     }
 }
 
+// Stores vtr::NdMatrix in a Matrix capnproto message as the raw bytes of its
+// storage (in the raw field, instead of one data Entry per element).
+//
+// Template arguments:
+//  N = Number of matrix dimensions, must be fixed.
+//  CapType = Element capnproto type of the Matrix capnproto message, which
+//            ToNdMatrix also accepts to read the message.
+//  CType = Source C++ type that is a single element of vtr::NdMatrix.  Must be
+//          trivially copyable, and should have no padding so written files are
+//          reproducible.
+//
+// Arguments:
+//  m_out = Target capnproto message builder.
+//  m_in = Source vtr::NdMatrix.
+//
+template<size_t N, typename CapType, typename CType>
+void FromNdMatrixRaw(
+    typename Matrix<CapType>::Builder* m_out,
+    const vtr::NdMatrix<CType, N>& m_in) {
+    static_assert(std::is_trivially_copyable<CType>::value,
+                  "Raw matrix serialization requires trivially copyable values");
+
+    size_t elements = 1;
+    auto dims = m_out->initDims(N);
+    for (size_t i = 0; i < N; ++i) {
+        dims.set(i, m_in.dim_size(i));
+        elements *= dims[i];
+    }
+
+    auto raw = m_out->initRaw(elements * sizeof(CType));
+    if (elements > 0) {
+        std::memcpy(raw.begin(), &m_in.get(0), raw.size());
+    }
+}
+
 #endif /* NDMATRIX_SERDES_H_ */
@@ -101,7 +101,7 @@ class array_view {
 
     ///@brief check if the array is empty
     constexpr bool empty() const noexcept {
-        return size_ != 0;
+        return size_ == 0;
     }
 
     ///@brief return a pointer to the first element of the array
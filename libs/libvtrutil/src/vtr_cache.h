@@ -28,6 +28,15 @@ class Cache {
         }
     }
 
+    ///@brief Like get(), but the cached value may be modified
+    CacheValue* get_mutable(const CacheKey& key) {
+        if (key == key_ && value_) {
+            return value_.get();
+        } else {
+            return nullptr;
+        }
+    }
+
     ///@brief Update the cache.
     const CacheValue* set(const CacheKey& key, std::unique_ptr<CacheValue> value) {
         key_ = key;
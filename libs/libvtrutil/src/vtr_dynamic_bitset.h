@@ -63,6 +63,11 @@ class dynamic_bitset {
         return (array_[index_value / kWidth] & (1u << (index_value % kWidth))) != 0;
     }
 
+    ///@brief Return the heap memory used by the bitset, in bytes
+    size_t memory_usage() const {
+        return array_.capacity() * sizeof(Storage);
+    }
+
   private:
     std::vector<Storage> array_;
 };
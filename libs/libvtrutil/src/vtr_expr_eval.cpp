@@ -2,7 +2,9 @@
 #include "vtr_error.h"
 #include "vtr_util.h"
 #include "vtr_math.h"
+#include "vtr_assert.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -24,10 +26,11 @@ static int before_addition = 0;
 
 /*---- Functions for Parsing the Symbolic Formulas ----*/
 
-/* converts specified formula to a vector in reverse-polish notation */
-static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint);
+/* converts specified formula to a vector in reverse-polish notation. if var_names is specified, variables are
+ * left unevaluated and refer to their index in var_names instead */
+static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint, vector<string>* var_names = nullptr);
 
-static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint);
+static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint, vector<string>* var_names);
 
 /* returns integer specifying precedence of passed-in operator. higher integer
  * means higher precedence */
@@ -51,6 +54,9 @@ static int parse_rpn_vector(vector<Formula_Object>& rpn_vec);
 /* applies operation specified by 'op' to the given arguments. arg1 comes before arg2 */
 static int apply_rpn_op(const Formula_Object& arg1, const Formula_Object& arg2, const Formula_Object& op);
 
+/* applies operator 'op' to the given values. arg1 comes before arg2 */
+static int apply_op(int arg1, int arg2, t_operator op);
+
 /* checks if specified character represents an ASCII number */
 static bool is_char_number(const char ch);
 
@@ -201,6 +207,131 @@ int FormulaParser::parse_piecewise_formula(const char* formula, const t_formula_
     return result;
 }
 
+/* compiles the specified formula, which may be piece-wise (see parse_piecewise_formula) */
+CompiledFormula::CompiledFormula(const std::string& formula)
+    : formula_(formula) {
+    if (formula.empty()) {
+        throw vtr::VtrError(vtr::string_fmt("CompiledFormula: formula is empty\n"), __FILE__, __LINE__);
+    }
+
+    is_piecewise_ = FormulaParser::is_piecewise_formula(formula.c_str());
+    if (!is_piecewise_) {
+        program_ = compile_rpn(formula);
+        return;
+    }
+
+    /* {start_0:end_0} formula_0; ... {start_i:end_i} formula_i; ... */
+    size_t str_ind = 0;
+    while (true) {
+        size_t range_begin = formula.find('{', str_ind);
+        if (range_begin == string::npos) {
+            break;
+        }
+        size_t range_sep = formula.find(':', range_begin);
+        if (range_sep == string::npos) {
+            throw vtr::VtrError(vtr::string_fmt("CompiledFormula: could not find char %c in piece-wise formula '%s'\n", ':', formula.c_str()), __FILE__, __LINE__);
+        }
+        size_t range_end = formula.find('}', range_sep);
+        if (range_end == string::npos) {
+            throw vtr::VtrError(vtr::string_fmt("CompiledFormula: could not find char %c in piece-wise formula '%s'\n", '}', formula.c_str()), __FILE__, __LINE__);
+        }
+        size_t piece_end = std::min(formula.find(';', range_end), formula.size());
+
+        t_formula_piece piece;
+        piece.start = compile_rpn(formula.substr(range_begin + 1, range_sep - range_begin - 1));
+        piece.end = compile_rpn(formula.substr(range_sep + 1, range_end - range_sep - 1));
+        piece.formula = compile_rpn(formula.substr(range_end + 1, piece_end - range_end - 1));
+        pieces_.push_back(std::move(piece));
+
+        str_ind = piece_end;
+    }
+}
+
+/* returns integer result of the compiled formula with the variable values in mydata */
+int CompiledFormula::evaluate(const t_formula_data& mydata) const {
+    if (!is_piecewise_) {
+        return evaluate_rpn(program_, mydata);
+    }
+
+    /* evaluate the formula of the range to which the incoming wire 't' corresponds */
+    int t = mydata.get_var_value("t");
+    for (const t_formula_piece& piece : pieces_) {
+        int range_start = evaluate_rpn(piece.start, mydata);
+        int range_end = evaluate_rpn(piece.end, mydata);
+
+        if (range_start > range_end) {
+            throw vtr::VtrError(vtr::string_fmt("CompiledFormula: range_start, %d, is bigger than range end, %d\n", range_start, range_end), __FILE__, __LINE__);
+        }
+
+        if (range_start <= t && range_end >= t) {
+            return evaluate_rpn(piece.formula, mydata);
+        }
+    }
+
+    throw vtr::VtrError(vtr::string_fmt("CompiledFormula: no range of piece-wise formula '%s' contains t = %d\n", formula_.c_str(), t), __FILE__, __LINE__);
+}
+
+/* converts the non-piece-wise formula to reverse-polish notation, and checks it can be evaluated */
+CompiledFormula::t_rpn_program CompiledFormula::compile_rpn(const string& formula) {
+    t_rpn_program program;
+
+    t_formula_data no_data;
+    stack<Formula_Object> op_stack;
+    formula_to_rpn(formula.c_str(), no_data, program.rpn, op_stack, false, &var_names_);
+
+    if (program.rpn.empty()) {
+        throw vtr::VtrError(vtr::string_fmt("CompiledFormula: formula '%s' is empty\n", formula.c_str()), __FILE__, __LINE__);
+    }
+
+    /* every operator has two operands, and a single value must be left once all are applied */
+    int stack_depth = 0;
+    for (const Formula_Object& fobj : program.rpn) {
+        if (E_FML_OPERATOR == fobj.type) {
+            if (stack_depth < 2) {
+                throw vtr::VtrError(vtr::string_fmt("CompiledFormula: operator '%s' is missing an operand in formula '%s'\n", fobj.to_string().c_str(), formula.c_str()), __FILE__, __LINE__);
+            }
+            stack_depth--;
+        } else {
+            stack_depth++;
+            program.max_stack_depth = std::max(program.max_stack_depth, stack_depth);
+        }
+    }
+    if (stack_depth != 1) {
+        throw vtr::VtrError(vtr::string_fmt("CompiledFormula: found multiple numbers in formula '%s', but no operator\n", formula.c_str()), __FILE__, __LINE__);
+    }
+
+    return program;
+}
+
+/* runs the reverse-polish notation program on a stack of values */
+int CompiledFormula::evaluate_rpn(const t_rpn_program& program, const t_formula_data& mydata) const {
+    //Formulas are short: only fall back to the heap for unusually deep ones
+    constexpr int MAX_INLINE_STACK_DEPTH = 16;
+    int inline_values[MAX_INLINE_STACK_DEPTH];
+    vector<int> heap_values;
+    int* values = inline_values;
+    if (program.max_stack_depth > MAX_INLINE_STACK_DEPTH) {
+        heap_values.resize(program.max_stack_depth);
+        values = heap_values.data();
+    }
+
+    int num_values = 0;
+    for (const Formula_Object& fobj : program.rpn) {
+        if (E_FML_NUMBER == fobj.type) {
+            values[num_values++] = fobj.data.num;
+        } else if (E_FML_VARIABLE == fobj.type) {
+            values[num_values++] = mydata.get_var_value(var_names_[fobj.data.num]);
+        } else {
+            VTR_ASSERT_SAFE(E_FML_OPERATOR == fobj.type && num_values >= 2);
+            num_values--;
+            values[num_values - 1] = apply_op(values[num_values - 1], values[num_values], fobj.data.op);
+        }
+    }
+    VTR_ASSERT_SAFE(num_values == 1);
+
+    return values[0];
+}
+
 /* increments str_ind until it reaches specified char in formula. returns true if character was found, false otherwise */
 static bool goto_next_char(int* str_ind, const string& pw_formula, char ch) {
     bool result = true;
@@ -225,7 +356,7 @@ static bool goto_next_char(int* str_ind, const string& pw_formula, char ch) {
 
 /* Parses the specified formula using a shunting yard algorithm (see wikipedia). The function's result
  * is stored in the rpn_output vector in reverse-polish notation */
-static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint) {
+static void formula_to_rpn(const char* formula, const t_formula_data& mydata, vector<Formula_Object>& rpn_output, stack<Formula_Object>& op_stack, bool is_breakpoint, vector<string>* var_names) {
     // Empty op_stack.
     while (!op_stack.empty()) {
         op_stack.pop();
@@ -246,7 +377,7 @@ static void formula_to_rpn(const char* formula, const t_formula_data& mydata, ve
             /* skip space */
         } else {
             /* parse the character */
-            get_formula_object(ch, ichar, mydata, &fobj, is_breakpoint);
+            get_formula_object(ch, ichar, mydata, &fobj, is_breakpoint, var_names);
             switch (fobj.type) {
                 case E_FML_NUMBER:
                     /* add to output vector */
@@ -295,7 +426,7 @@ static void formula_to_rpn(const char* formula, const t_formula_data& mydata, ve
  * which help determine which numeric value, if any, gets assigned to fobj
  * ichar is incremented by the corresponding count if the need to step through the
  * character array arises */
-static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint) {
+static void get_formula_object(const char* ch, int& ichar, const t_formula_data& mydata, Formula_Object* fobj, bool is_breakpoint, vector<string>* var_names) {
     /* the character can either be part of a number, or it can be an object like W, t, (, +, etc
      * here we have to account for both possibilities */
 
@@ -317,6 +448,14 @@ static void get_formula_object(const char* ch, int& ichar, const t_formula_data&
                 throw vtr::VtrError(vtr::string_fmt("in get_formula_object: recognized function: %s\n", var_name.c_str()), __FILE__, __LINE__);
             }
 
+        } else if (var_names) {
+            //A variable, evaluated later
+            fobj->type = E_FML_VARIABLE;
+            auto iter = std::find(var_names->begin(), var_names->end(), var_name);
+            fobj->data.num = iter - var_names->begin();
+            if (iter == var_names->end()) {
+                var_names->push_back(var_name);
+            }
         } else if (!is_breakpoint) {
             //A number
             fobj->type = E_FML_NUMBER;
@@ -674,60 +813,69 @@ static int apply_rpn_op(const Formula_Object& arg1, const Formula_Object& arg2,
     }
 
     /* apply operation to arguments */
-    switch (op.data.op) {
+    result = apply_op(arg1.data.num, arg2.data.num, op.data.op);
+
+    return result;
+}
+
+/* applies operator 'op' to the given values. arg1 comes before arg2 */
+static int apply_op(int arg1, int arg2, t_operator op) {
+    int result = -1;
+
+    switch (op) {
         case E_OP_ADD:
-            result = arg1.data.num + arg2.data.num;
+            result = arg1 + arg2;
             break;
         case E_OP_SUB:
-            result = arg1.data.num - arg2.data.num;
+            result = arg1 - arg2;
             break;
         case E_OP_MULT:
-            result = arg1.data.num * arg2.data.num;
+            result = arg1 * arg2;
             break;
         case E_OP_DIV:
-            result = arg1.data.num / arg2.data.num;
+            result = arg1 / arg2;
             break;
         case E_OP_MAX:
-            result = std::max(arg1.data.num, arg2.data.num);
+            result = std::max(arg1, arg2);
             break;
         case E_OP_MIN:
-            result = std::min(arg1.data.num, arg2.data.num);
+            result = std::min(arg1, arg2);
             break;
         case E_OP_GCD:
-            result = vtr::gcd(arg1.data.num, arg2.data.num);
+            result = vtr::gcd(arg1, arg2);
             break;
         case E_OP_LCM:
-            result = vtr::lcm(arg1.data.num, arg2.data.num);
+            result = vtr::lcm(arg1, arg2);
             break;
         case E_OP_AND:
-            result = arg1.data.num && arg2.data.num;
+            result = arg1 && arg2;
             break;
         case E_OP_OR:
-            result = (arg1.data.num || arg2.data.num);
+            result = (arg1 || arg2);
             break;
         case E_OP_GT:
-            result = arg1.data.num > arg2.data.num;
+            result = arg1 > arg2;
             break;
         case E_OP_LT:
-            result = arg1.data.num < arg2.data.num;
+            result = arg1 < arg2;
             break;
         case E_OP_GTE:
-            result = (arg1.data.num >= arg2.data.num);
+            result = (arg1 >= arg2);
             break;
         case E_OP_LTE:
-            result = (arg1.data.num <= arg2.data.num);
+            result = (arg1 <= arg2);
             break;
         case E_OP_EQ:
-            result = arg1.data.num == arg2.data.num;
+            result = arg1 == arg2;
             break;
         case E_OP_MOD:
-            result = arg1.data.num % arg2.data.num;
+            result = arg1 % arg2;
             break;
         case E_OP_AA:
-            result = additional_assignment_op(arg1.data.num, arg2.data.num);
+            result = additional_assignment_op(arg1, arg2);
             break;
         default:
-            throw vtr::VtrError(vtr::string_fmt("in apply_rpn_op: invalid operation: %d\n", op.data.op), __FILE__, __LINE__);
+            throw vtr::VtrError(vtr::string_fmt("in apply_rpn_op: invalid operation: %d\n", op), __FILE__, __LINE__);
             break;
     }
 
@@ -229,6 +229,56 @@ class FormulaParser {
     std::stack<Formula_Object> op_stack_;
 };
 
+/**
+ * @brief A formula parsed once, to be evaluated with many variable values
+ *
+ * FormulaParser parses the formula text on every evaluation. When the same formula is evaluated
+ * many times (e.g. a switch block permutation function at every location and for every wire),
+ * compile it once instead: the formula (which may be piece-wise) is converted to reverse-polish
+ * notation, with its variables referred to by name, and evaluate() only runs the RPN program
+ * with the current variable values.
+ *
+ * Breakpoint expressions are not supported.
+ */
+class CompiledFormula {
+  public:
+    CompiledFormula() = default;
+
+    ///@brief compiles formula, throwing a VtrError if it is empty or malformed
+    explicit CompiledFormula(const std::string& formula);
+
+    ///@brief returns integer result of the formula with the variable values in mydata
+    int evaluate(const t_formula_data& mydata) const;
+
+    ///@brief returns the formula text this was compiled from
+    const std::string& formula() const { return formula_; }
+
+  private:
+    ///@brief A non-piece-wise formula in reverse-polish notation
+    struct t_rpn_program {
+        std::vector<Formula_Object> rpn; ///<Variables hold their index in var_names_
+        int max_stack_depth = 0;         ///<Largest number of operands on the stack during evaluation
+    };
+
+    ///@brief A piece of a piece-wise formula, evaluated if the incoming wire 't' is in [start, end]
+    struct t_formula_piece {
+        t_rpn_program start;
+        t_rpn_program end;
+        t_rpn_program formula;
+    };
+
+    t_rpn_program compile_rpn(const std::string& formula);
+    int evaluate_rpn(const t_rpn_program& program, const t_formula_data& mydata) const;
+
+  private:
+    std::string formula_;
+    std::vector<std::string> var_names_;
+
+    bool is_piecewise_ = false;
+    t_rpn_program program_;              ///<The formula, if not piece-wise
+    std::vector<t_formula_piece> pieces_; ///<The pieces of the formula, if piece-wise
+};
+
 } // namespace vtr
 
 #endif
@@ -0,0 +1,610 @@
+#ifndef VTR_FLAT_HASH_MAP_H
+#define VTR_FLAT_HASH_MAP_H
+/**
+ * @file
+ * @brief Open addressing hash map and set, as drop-in replacements for std::unordered_map/set in hot code
+ *
+ * std::unordered_map allocates a node per element and chains them in buckets, so every
+ * insertion allocates and every lookup chases pointers. vtr::flat_hash_map stores its
+ * elements inline in a single array of slots, and finds them through a parallel array
+ * of one byte control words:
+ *  - Each control word is either EMPTY, DELETED (a tombstone) or, for a full slot, the
+ *    low 7 bits of the hash of its key.
+ *  - The table is probed a group of 16 control words at a time. With SSE2 a whole group
+ *    is compared against the 7 bits of the hash of the searched key with a single
+ *    instruction, so the keys of the slots are only compared on a (1/128 false positive)
+ *    fingerprint match. Without SSE2 the group is scanned with portable code.
+ *  - Groups are probed quadratically (triangular numbers), which visits every group
+ *    since the number of groups is a power of two. A probe stops at the first group
+ *    holding an EMPTY word.
+ *  - The table grows (doubles) when full and deleted slots exceed 7/8 of its capacity.
+ *
+ * Unlike std::unordered_map:
+ *  - Insertion and rehashing invalidate all iterators, pointers and references.
+ *  - erase() leaves the other iterators valid (only the erased element is destroyed).
+ *  - Iteration order is unspecified, and changes with the capacity of the table.
+ *
+ * Example:
+ *
+ *      vtr::flat_hash_map<const t_pb_graph_node*, const t_mode*> mode_map;
+ *      auto result = mode_map.insert(std::make_pair(pb_graph_node, mode));
+ *      if (!result.second) {
+ *          //pb_graph_node was already in the map, result.first->second is its mode
+ *      }
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
+#include "vtr_assert.h"
+
+namespace vtr {
+
+namespace detail {
+
+///@brief Control word of an unused slot
+constexpr int8_t FLAT_HASH_EMPTY = -128; //0x80
+///@brief Control word of an erased slot (tombstone)
+constexpr int8_t FLAT_HASH_DELETED = -2; //0xFE
+///@brief Number of control words probed at once
+constexpr size_t FLAT_HASH_GROUP_WIDTH = 16;
+
+///@brief Returns the index of the lowest set bit of mask, which must be non-zero
+inline int flat_hash_lowest_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+///@brief A group of FLAT_HASH_GROUP_WIDTH control words, loaded for matching
+class flat_hash_group {
+  public:
+    explicit flat_hash_group(const int8_t* ctrl) {
+#if defined(__SSE2__)
+        ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        ctrl_ = ctrl;
+#endif
+    }
+
+    ///@brief Returns a bit mask of the words of the group equal to h2
+    uint32_t match(int8_t h2) const {
+#if defined(__SSE2__)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < FLAT_HASH_GROUP_WIDTH; ++i) {
+            mask |= uint32_t(ctrl_[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    ///@brief Returns a bit mask of the EMPTY words of the group
+    uint32_t match_empty() const {
+        return match(FLAT_HASH_EMPTY);
+    }
+
+    ///@brief Returns a bit mask of the EMPTY or DELETED words of the group (i.e. those with the sign bit set)
+    uint32_t match_empty_or_deleted() const {
+#if defined(__SSE2__)
+        return _mm_movemask_epi8(ctrl_);
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < FLAT_HASH_GROUP_WIDTH; ++i) {
+            mask |= uint32_t(ctrl_[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+  private:
+#if defined(__SSE2__)
+    __m128i ctrl_;
+#else
+    const int8_t* ctrl_;
+#endif
+};
+
+///@brief Key extractor of flat_hash_map elements
+struct flat_hash_map_key {
+    template<class V>
+    static const typename V::first_type& get(const V& value) { return value.first; }
+};
+
+///@brief Key extractor of flat_hash_set elements
+struct flat_hash_set_key {
+    template<class V>
+    static const V& get(const V& value) { return value; }
+};
+
+/**
+ * @brief The open addressing table shared by flat_hash_map and flat_hash_set
+ *
+ * V is the element type, K its key type and KeyOf extracts the key of an element.
+ */
+template<class K, class V, class KeyOf, class Hash, class KeyEqual>
+class flat_hash_table {
+  public:
+    typedef K key_type;
+    typedef V value_type;
+    typedef size_t size_type;
+    typedef Hash hasher;
+    typedef KeyEqual key_equal;
+
+    template<bool IsConst>
+    class basic_iterator {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename flat_hash_table::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IsConst, const value_type*, value_type*>::type pointer;
+        typedef typename std::conditional<IsConst, const value_type&, value_type&>::type reference;
+
+        basic_iterator() = default;
+
+        ///@brief Conversion from iterator to const_iterator
+        template<bool WasConst, class = typename std::enable_if<IsConst && !WasConst>::type>
+        basic_iterator(const basic_iterator<WasConst>& other)
+            : ctrl_(other.ctrl_)
+            , ctrl_end_(other.ctrl_end_)
+            , slot_(other.slot_) {}
+
+        reference operator*() const { return *slot_; }
+        pointer operator->() const { return slot_; }
+
+        basic_iterator& operator++() {
+            ++ctrl_;
+            ++slot_;
+            skip_unused();
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            basic_iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.ctrl_ == rhs.ctrl_; }
+        friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.ctrl_ != rhs.ctrl_; }
+
+      private:
+        friend class flat_hash_table;
+        template<bool>
+        friend class basic_iterator;
+
+        basic_iterator(const int8_t* ctrl, const int8_t* ctrl_end, pointer slot)
+            : ctrl_(ctrl)
+            , ctrl_end_(ctrl_end)
+            , slot_(slot) {}
+
+        void skip_unused() {
+            while (ctrl_ != ctrl_end_ && *ctrl_ < 0) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+        const int8_t* ctrl_ = nullptr;
+        const int8_t* ctrl_end_ = nullptr;
+        pointer slot_ = nullptr;
+    };
+
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+  public:
+    flat_hash_table() = default;
+
+    flat_hash_table(const flat_hash_table& other)
+        : hash_(other.hash_)
+        , equal_(other.equal_) {
+        reserve(other.size());
+        for (const value_type& value : other) {
+            insert_unique(value);
+        }
+    }
+
+    flat_hash_table(flat_hash_table&& other) noexcept {
+        swap(other);
+    }
+
+    flat_hash_table& operator=(flat_hash_table other) {
+        swap(other);
+        return *this;
+    }
+
+    ~flat_hash_table() {
+        destroy_values();
+        deallocate_slots();
+    }
+
+  public: //Accessors
+    iterator begin() {
+        iterator it(ctrl_.data(), ctrl_.data() + capacity_, slots_);
+        it.skip_unused();
+        return it;
+    }
+    iterator end() { return iterator(ctrl_.data() + capacity_, ctrl_.data() + capacity_, slots_ + capacity_); }
+    const_iterator begin() const { return const_cast<flat_hash_table*>(this)->begin(); }
+    const_iterator end() const { return const_cast<flat_hash_table*>(this)->end(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    ///@brief Returns the number of elements
+    size_type size() const { return size_; }
+
+    ///@brief Returns true if there are no elements
+    bool empty() const { return size_ == 0; }
+
+    ///@brief Returns the number of slots of the table
+    size_type capacity() const { return capacity_; }
+
+    ///@brief Returns an iterator to the element with key, or end() if there is none
+    iterator find(const K& key) {
+        size_t index = find_index(key);
+        return (index == NO_INDEX) ? end() : iterator_at(index);
+    }
+
+    const_iterator find(const K& key) const {
+        return const_cast<flat_hash_table*>(this)->find(key);
+    }
+
+    ///@brief Returns 1 if there is an element with key, and 0 otherwise
+    size_type count(const K& key) const {
+        return find_index(key) != NO_INDEX ? 1 : 0;
+    }
+
+    ///@brief Returns true if there is an element with key
+    bool contains(const K& key) const {
+        return find_index(key) != NO_INDEX;
+    }
+
+  public: //Mutators
+    /**
+     * @brief Inserts value if there is no element with its key
+     * @return An iterator to the element with the key of value, and whether value was inserted
+     */
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return emplace(value);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace(std::move(value));
+    }
+
+    template<class P, class = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+    std::pair<iterator, bool> insert(P&& value) {
+        return emplace(std::forward<P>(value));
+    }
+
+    ///@brief Inserts the elements of [first, last) whose keys are not in the table
+    template<class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    /**
+     * @brief Constructs an element from args, and inserts it if there is no element with its key
+     * @return An iterator to the element with the key of the new element, and whether it was inserted
+     */
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        //The element is built first to find its key, as for std::unordered_map
+        value_type value(std::forward<Args>(args)...);
+        const K& key = KeyOf::get(value);
+
+        size_t hash = hash_of(key);
+        size_t index = find_index(key, hash);
+        if (index != NO_INDEX) {
+            return std::make_pair(iterator_at(index), false);
+        }
+        index = prepare_insert(hash);
+        ::new (static_cast<void*>(slots_ + index)) value_type(std::move(value));
+        return std::make_pair(iterator_at(index), true);
+    }
+
+    ///@brief Removes the element with key (if any), and returns the number of elements removed
+    size_type erase(const K& key) {
+        size_t index = find_index(key);
+        if (index == NO_INDEX) {
+            return 0;
+        }
+        erase_index(index);
+        return 1;
+    }
+
+    ///@brief Removes the element at pos, and returns an iterator to the next element
+    iterator erase(const_iterator pos) {
+        size_t index = pos.ctrl_ - ctrl_.data();
+        erase_index(index);
+        iterator next = iterator_at(index);
+        next.skip_unused();
+        return next;
+    }
+
+    ///@brief Removes all elements, keeping the allocated table
+    void clear() {
+        destroy_values();
+        std::fill(ctrl_.begin(), ctrl_.end(), FLAT_HASH_EMPTY);
+        size_ = 0;
+        num_deleted_ = 0;
+    }
+
+    ///@brief Grows the table so that num_values elements fit without rehashing
+    void reserve(size_type num_values) {
+        size_t needed = capacity_for(num_values);
+        if (needed > capacity_) {
+            rehash(needed);
+        }
+    }
+
+    void swap(flat_hash_table& other) noexcept {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(num_deleted_, other.num_deleted_);
+        swap(hash_, other.hash_);
+        swap(equal_, other.equal_);
+    }
+
+  protected:
+    ///@brief Returns an iterator to the element with key, inserting one built by make_value() if there is none
+    template<class MakeValue>
+    iterator find_or_insert(const K& key, MakeValue make_value) {
+        size_t hash = hash_of(key);
+        size_t index = find_index(key, hash);
+        if (index == NO_INDEX) {
+            index = prepare_insert(hash);
+            ::new (static_cast<void*>(slots_ + index)) value_type(make_value());
+        }
+        return iterator_at(index);
+    }
+
+    static constexpr size_t NO_INDEX = size_t(-1);
+
+    size_t find_index(const K& key) const {
+        return find_index(key, hash_of(key));
+    }
+
+  private:
+    static constexpr size_t MIN_CAPACITY = FLAT_HASH_GROUP_WIDTH;
+
+    ///@brief Returns the capacity (a power of two) keeping num_values elements at or below the maximum load
+    static size_t capacity_for(size_type num_values) {
+        size_t capacity = MIN_CAPACITY;
+        while (max_load(capacity) < num_values) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+    /**
+     * @brief Returns the hash of key, mixed so that all of its bits depend on all of the key
+     *
+     * std::hash of pointers and integers is typically the identity, whose low bits
+     * (e.g. the alignment of pointers) are far from random.
+     */
+    size_t hash_of(const K& key) const {
+        uint64_t hash = uint64_t(hash_(key));
+        hash ^= hash >> 32;
+        hash *= UINT64_C(0x9E3779B97F4A7C15);
+        hash ^= hash >> 29;
+        return size_t(hash);
+    }
+
+    ///@brief The fingerprint of hash stored in the control words (7 bits)
+    static int8_t h2(size_t hash) { return int8_t(hash & 0x7F); }
+
+    ///@brief The group where the probe sequence of hash starts
+    size_t h1(size_t hash) const { return hash >> 7; }
+
+    size_t num_groups() const { return capacity_ / FLAT_HASH_GROUP_WIDTH; }
+
+    size_t find_index(const K& key, size_t hash) const {
+        if (capacity_ == 0) {
+            return NO_INDEX;
+        }
+
+        size_t group_mask = num_groups() - 1;
+        size_t igroup = h1(hash) & group_mask;
+        int8_t fingerprint = h2(hash);
+        for (size_t step = 1;; ++step) {
+            size_t first = igroup * FLAT_HASH_GROUP_WIDTH;
+            flat_hash_group group(ctrl_.data() + first);
+            for (uint32_t mask = group.match(fingerprint); mask != 0; mask &= mask - 1) {
+                size_t index = first + flat_hash_lowest_bit(mask);
+                if (equal_(KeyOf::get(slots_[index]), key)) {
+                    return index;
+                }
+            }
+            if (group.match_empty()) {
+                return NO_INDEX;
+            }
+            if (step == num_groups()) {
+                return NO_INDEX; //Probed every group
+            }
+            igroup = (igroup + step) & group_mask;
+        }
+    }
+
+    ///@brief Returns the first EMPTY or DELETED slot of the probe sequence of hash
+    size_t find_free_index(size_t hash) const {
+        size_t group_mask = num_groups() - 1;
+        size_t igroup = h1(hash) & group_mask;
+        for (size_t step = 1;; ++step) {
+            size_t first = igroup * FLAT_HASH_GROUP_WIDTH;
+            uint32_t mask = flat_hash_group(ctrl_.data() + first).match_empty_or_deleted();
+            if (mask) {
+                return first + flat_hash_lowest_bit(mask);
+            }
+            VTR_ASSERT_SAFE(step < num_groups());
+            igroup = (igroup + step) & group_mask;
+        }
+    }
+
+    ///@brief Claims a free slot for a new element of hash (growing the table if needed), and returns its index
+    size_t prepare_insert(size_t hash) {
+        if (size_ + num_deleted_ + 1 > max_load(capacity_)) {
+            //Drop the tombstones if they take up the room, otherwise grow
+            size_t capacity = (size_ + 1 > max_load(capacity_) / 2) ? capacity_for(2 * (size_ + 1)) : capacity_;
+            rehash(std::max(capacity, MIN_CAPACITY));
+        }
+
+        size_t index = find_free_index(hash);
+        if (ctrl_[index] == FLAT_HASH_DELETED) {
+            --num_deleted_;
+        }
+        ctrl_[index] = h2(hash);
+        ++size_;
+        return index;
+    }
+
+    ///@brief Inserts value, whose key must not be in the table, without checking for growth
+    void insert_unique(const value_type& value) {
+        size_t hash = hash_of(KeyOf::get(value));
+        size_t index = find_free_index(hash);
+        ctrl_[index] = h2(hash);
+        ++size_;
+        ::new (static_cast<void*>(slots_ + index)) value_type(value);
+    }
+
+    void erase_index(size_t index) {
+        VTR_ASSERT_SAFE(ctrl_[index] >= 0);
+        slots_[index].~value_type();
+        --size_;
+
+        //A probe never continues past a group holding an EMPTY word,
+        //so the slot can be made EMPTY instead of a tombstone
+        size_t first = index - index % FLAT_HASH_GROUP_WIDTH;
+        if (flat_hash_group(ctrl_.data() + first).match_empty()) {
+            ctrl_[index] = FLAT_HASH_EMPTY;
+        } else {
+            ctrl_[index] = FLAT_HASH_DELETED;
+            ++num_deleted_;
+        }
+    }
+
+    void rehash(size_t capacity) {
+        VTR_ASSERT(capacity >= size_);
+
+        std::vector<int8_t> old_ctrl(capacity, FLAT_HASH_EMPTY);
+        old_ctrl.swap(ctrl_);
+        value_type* old_slots = slots_;
+        size_t old_capacity = capacity_;
+
+        slots_ = std::allocator<value_type>().allocate(capacity);
+        capacity_ = capacity;
+        num_deleted_ = 0;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                size_t hash = hash_of(KeyOf::get(old_slots[i]));
+                size_t index = find_free_index(hash);
+                ctrl_[index] = h2(hash);
+                ::new (static_cast<void*>(slots_ + index)) value_type(std::move(old_slots[i]));
+                old_slots[i].~value_type();
+            }
+        }
+
+        if (old_slots) {
+            std::allocator<value_type>().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    iterator iterator_at(size_t index) {
+        return iterator(ctrl_.data() + index, ctrl_.data() + capacity_, slots_ + index);
+    }
+
+    void destroy_values() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].~value_type();
+            }
+        }
+    }
+
+    void deallocate_slots() {
+        if (slots_) {
+            std::allocator<value_type>().deallocate(slots_, capacity_);
+            slots_ = nullptr;
+        }
+    }
+
+  private:
+    std::vector<int8_t> ctrl_;   ///<[0..capacity_-1] Control word of each slot
+    value_type* slots_ = nullptr; ///<[0..capacity_-1] Element storage, only constructed for full slots
+    size_t capacity_ = 0;         ///<Number of slots, a power of two multiple of FLAT_HASH_GROUP_WIDTH (or zero)
+    size_t size_ = 0;             ///<Number of full slots
+    size_t num_deleted_ = 0;      ///<Number of DELETED slots
+    Hash hash_;
+    KeyEqual equal_;
+};
+
+} // namespace detail
+
+/**
+ * @brief An open addressing hash map with the interface of std::unordered_map
+ *
+ * See the file comment for how it differs from std::unordered_map.
+ */
+template<class K, class T, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class flat_hash_map : public detail::flat_hash_table<K, std::pair<const K, T>, detail::flat_hash_map_key, Hash, KeyEqual> {
+    typedef detail::flat_hash_table<K, std::pair<const K, T>, detail::flat_hash_map_key, Hash, KeyEqual> table_type;
+
+  public:
+    typedef T mapped_type;
+
+  public:
+    ///@brief Returns the value of key, inserting a value initialized one if key is not in the map
+    T& operator[](const K& key) {
+        return this->find_or_insert(key, [&]() { return typename table_type::value_type(key, T()); })->second;
+    }
+
+    ///@brief Returns the value of key, which must be in the map
+    T& at(const K& key) {
+        auto it = this->find(key);
+        VTR_ASSERT(it != this->end());
+        return it->second;
+    }
+
+    const T& at(const K& key) const {
+        auto it = this->find(key);
+        VTR_ASSERT(it != this->end());
+        return it->second;
+    }
+};
+
+/**
+ * @brief An open addressing hash set with the interface of std::unordered_set
+ *
+ * See the file comment for how it differs from std::unordered_set.
+ */
+template<class K, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class flat_hash_set : public detail::flat_hash_table<K, K, detail::flat_hash_set_key, Hash, KeyEqual> {};
+
+} // namespace vtr
+#endif
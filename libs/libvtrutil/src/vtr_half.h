@@ -0,0 +1,114 @@
+#ifndef VTR_HALF_H
+#define VTR_HALF_H
+/**
+ * @file
+ * @brief Conversions between float and IEEE 754 half precision (binary16) values
+ *
+ * Half precision halves the storage of large float tables (e.g. delay look-ups) which
+ * only need ~3 significant digits. Halves keep 11 significant bits, but their range
+ * is small (normal values span [6.1e-5, 65504]), so values such as delays in seconds
+ * must be scaled into it: half_scale() picks a power of two scale for a table,
+ * which makes the scaling itself exact.
+ *
+ * The conversions use the F16C instructions when compiled for them, and a few integer
+ * operations otherwise. (A look-up table for the decode would itself take 256 KiB of
+ * cache, which defeats the purpose of compact tables.)
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#    include <immintrin.h>
+#endif
+
+namespace vtr {
+
+namespace detail {
+
+inline uint32_t float_bits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bits_float(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace detail
+
+///@brief Returns the half precision value nearest to value (ties to even); out of range values become +/-infinity
+inline uint16_t float_to_half(float value) {
+#if defined(__F16C__)
+    return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+    constexpr uint32_t F32_INFINITY = 255u << 23;
+    constexpr uint32_t F16_OVERFLOW = (127u + 16u) << 23; //2^16, the first value rounding to infinity or beyond
+    constexpr uint32_t F16_MIN_NORMAL = 113u << 23;       //2^-14
+    constexpr uint32_t DENORM_MAGIC = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    uint32_t bits = detail::float_bits(value);
+    uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint16_t half;
+    if (bits >= F16_OVERFLOW) {
+        half = (bits > F32_INFINITY) ? 0x7E00 : 0x7C00; //NaN or infinity
+    } else if (bits < F16_MIN_NORMAL) {
+        //Subnormal (or zero): adding the magic value aligns the mantissa, and the FPU rounds it
+        float aligned = detail::bits_float(bits) + detail::bits_float(DENORM_MAGIC);
+        half = uint16_t(detail::float_bits(aligned) - DENORM_MAGIC);
+    } else {
+        uint32_t mantissa_odd = (bits >> 13) & 1;
+        bits += (uint32_t(15 - 127) << 23) + 0xFFF; //Rebias the exponent and round
+        bits += mantissa_odd;                       //Ties to even
+        half = uint16_t(bits >> 13);
+    }
+    return half | uint16_t(sign >> 16);
+#endif
+}
+
+///@brief Returns the float value of the half precision value half (exactly)
+inline float half_to_float(uint16_t half) {
+#if defined(__F16C__)
+    return _cvtsh_ss(half);
+#else
+    constexpr uint32_t SHIFTED_EXPONENT = 0x7C00u << 13;
+
+    uint32_t bits = uint32_t(half & 0x7FFF) << 13;
+    uint32_t exponent = bits & SHIFTED_EXPONENT;
+    bits += uint32_t(127 - 15) << 23; //Rebias the exponent
+
+    if (exponent == SHIFTED_EXPONENT) {
+        bits += uint32_t(128 - 16) << 23; //Infinity or NaN
+    } else if (exponent == 0) {
+        //Subnormal (or zero): renormalize through the FPU
+        bits += 1u << 23;
+        bits = detail::float_bits(detail::bits_float(bits) - detail::bits_float(113u << 23));
+    }
+    return detail::bits_float(bits | (uint32_t(half & 0x8000) << 16));
+#endif
+}
+
+/**
+ * @brief Returns the power of two scale which maps magnitudes up to max_magnitude into the normal half range
+ *
+ * Values are stored as float_to_half(value / scale) and read as half_to_float(half) * scale.
+ * The largest magnitude maps to at most 2^15, leaving ~29 binary orders of magnitude below
+ * it before values lose precision (i.e. become subnormal halves).
+ */
+inline float half_scale(float max_magnitude) {
+    if (!std::isfinite(max_magnitude) || max_magnitude <= 0.f) {
+        return 1.f;
+    }
+    int exponent;
+    std::frexp(max_magnitude, &exponent); //max_magnitude = m * 2^exponent, with m in [0.5, 1)
+    return std::ldexp(1.f, exponent - 15);
+}
+
+} // namespace vtr
+#endif
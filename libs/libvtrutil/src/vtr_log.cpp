@@ -17,6 +17,13 @@ void set_log_file(const char* filename) {
     log_set_output_file(filename);
 }
 
+ScopedLogBuffer::ScopedLogBuffer()
+    : was_buffering_(log_set_thread_buffering(true)) {}
+
+ScopedLogBuffer::~ScopedLogBuffer() {
+    log_set_thread_buffering(was_buffering_);
+}
+
 } // namespace vtr
 
 void add_warnings_to_suppress(std::string function_name) {
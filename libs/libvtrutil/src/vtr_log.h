@@ -45,6 +45,9 @@
  *
  *      VTR_LOGF("my_file.txt", "This message will be logged from file 'my_file.txt' line %d\n", 42);
  *  
+ * Note that the message arguments are only evaluated if the condition holds, so
+ * a filtered out (e.g. too verbose) message costs a single test.
+ *
  * Debug Logging
  * =============
  *
@@ -140,6 +143,24 @@ extern PrintHandlerDirect printf_direct;
 
 void set_log_file(const char* filename);
 
+/**
+ * @brief Holds back the log messages of the calling thread while in scope, and writes them in one piece when destroyed
+ *
+ * Used around tasks run by worker threads, so that the messages of a task stay together in the log instead of
+ * interleaving with those of the other threads. Errors are written immediately. Nested scopes have no effect.
+ */
+class ScopedLogBuffer {
+  public:
+    ScopedLogBuffer();
+    ~ScopedLogBuffer();
+
+    ScopedLogBuffer(const ScopedLogBuffer&) = delete;
+    ScopedLogBuffer& operator=(const ScopedLogBuffer&) = delete;
+
+  private:
+    bool was_buffering_;
+};
+
 } // namespace vtr
 
 static std::unordered_set<std::string> warnings_to_suppress;
@@ -15,6 +15,10 @@
 #    include <malloc.h>
 #endif
 
+#ifdef __linux__
+#    include <sys/mman.h>
+#endif
+
 namespace vtr {
 
 #ifndef __GLIBC__
@@ -27,6 +31,16 @@ int malloc_trim(size_t pad) {
 }
 #endif
 
+void advise_huge_pages(void* ptr, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    //Failures (e.g. transparent huge pages disabled) only lose the speedup
+    madvise(ptr, size, MADV_HUGEPAGE);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
 void* free(void* some) {
     if (some) {
         std::free(some);
@@ -1,5 +1,6 @@
 #ifndef VTR_MEMORY_H
 #define VTR_MEMORY_H
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <new>
@@ -146,6 +147,81 @@ bool operator==(const aligned_allocator<T>&, const aligned_allocator<T>&) {
     return true;
 }
 
+///@brief Size of the (transparent) huge pages that huge_page_allocator backs its large allocations with
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/**
+ * @brief Advises the OS to back [ptr, ptr + size) with transparent huge pages
+ *
+ * Only done on Linux, elsewhere (or if huge pages are disabled) this is a no-op.
+ * ptr should be aligned to HUGE_PAGE_SIZE.
+ */
+void advise_huge_pages(void* ptr, size_t size);
+
+/**
+ * @brief huge_page_allocator is a STL allocator for large, long-lived arrays which are accessed randomly
+ *
+ * Allocations of at least HUGE_PAGE_SIZE bytes are aligned to it and backed by transparent huge pages
+ * (see advise_huge_pages()), so that the random accesses into them incur far fewer TLB misses.
+ * Smaller allocations behave like aligned_allocator.
+ */
+template<class T>
+struct huge_page_allocator {
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    huge_page_allocator() = default;
+
+    template<class U>
+    huge_page_allocator(const huge_page_allocator<U>& /*other*/) noexcept {}
+
+    pointer allocate(size_type n, const void* /*hint*/ = 0) {
+        size_t size = sizeof(T) * n;
+        bool huge = size >= HUGE_PAGE_SIZE;
+
+        //posix_memalign() requires the alignment to be a multiple of sizeof(void*)
+        size_t align = huge ? HUGE_PAGE_SIZE : std::max(alignof(T), sizeof(void*));
+
+        void* data;
+        int ret = vtr::memalign(&data, align, size);
+        if (ret != 0) {
+            throw std::bad_alloc();
+        }
+        if (huge) {
+            advise_huge_pages(data, size);
+        }
+        return static_cast<pointer>(data);
+    }
+
+    void deallocate(T* p, size_type /*n*/) {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        vtr::free(p);
+#endif
+    }
+};
+
+/**
+ * @brief compare two huge_page_allocators.
+ *
+ * Since the allocator doesn't have any internal state, all allocators for a given type are the same.
+ */
+template<typename T>
+bool operator==(const huge_page_allocator<T>&, const huge_page_allocator<T>&) {
+    return true;
+}
+
+template<typename T>
+bool operator!=(const huge_page_allocator<T>&, const huge_page_allocator<T>&) {
+    return false;
+}
+
 } // namespace vtr
 
 #endif
@@ -0,0 +1,218 @@
+#ifndef VTR_MEMORY_USAGE_H
+#define VTR_MEMORY_USAGE_H
+
+/**
+ * @file
+ * @brief Estimates of the heap memory owned by containers
+ *
+ * vtr::memory_usage(value) returns the number of heap bytes owned by value (excluding sizeof(value) itself),
+ * recursing into the elements of (nested) containers. It is an estimate: the node based containers are assumed
+ * to allocate one node (the value and two pointers) per element plus their bucket array, and the allocator's
+ * own overhead is ignored. Other types report their heap memory with a `size_t memory_usage() const` member
+ * function; types it doesn't know own no heap memory.
+ *
+ * For example:
+ *
+ *      std::vector<std::vector<int>> vec(10, std::vector<int>(100));
+ *      size_t bytes = vtr::memory_usage(vec); //10 * sizeof(std::vector<int>) + 10 * 100 * sizeof(int)
+ */
+
+#include <climits>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "vtr_ndmatrix.h"
+#include "vtr_optional.h"
+#include "vtr_vector.h"
+#include "vtr_vector_map.h"
+
+namespace vtr {
+
+template<typename T>
+size_t memory_usage(const T& value);
+
+namespace detail {
+
+///@brief The heap bytes of a node of a node based container holding a value_type
+template<typename value_type>
+constexpr size_t node_bytes() {
+    return sizeof(value_type) + 2 * sizeof(void*);
+}
+
+///@brief Whether T reports its heap memory with a memory_usage() member function
+template<typename T, typename = void>
+struct has_memory_usage : std::false_type {};
+
+template<typename T>
+struct has_memory_usage<T, std::void_t<decltype(std::declval<const T&>().memory_usage())>> : std::true_type {};
+
+///@brief Whether values of T are known to own no heap memory, so containers can skip looking at their elements
+template<typename T>
+constexpr bool owns_no_heap_memory() {
+    return std::is_trivially_copyable<T>::value && !has_memory_usage<T>::value;
+}
+
+///@brief The heap bytes owned by the elements of range (besides the elements themselves)
+template<typename Range>
+size_t elements_memory_usage(const Range& range) {
+    using value_type = typename std::decay<decltype(*std::begin(range))>::type;
+
+    size_t bytes = 0;
+    if (!owns_no_heap_memory<value_type>()) {
+        for (const auto& value : range) {
+            bytes += memory_usage(value);
+        }
+    }
+    return bytes;
+}
+
+///@brief Types without a specialization report their heap memory with memory_usage(), or own none
+template<typename T>
+struct t_memory_usage {
+    static size_t bytes(const T& value) {
+        if constexpr (has_memory_usage<T>::value) {
+            return value.memory_usage();
+        } else {
+            return 0;
+        }
+    }
+};
+
+template<typename T, typename A>
+struct t_memory_usage<std::vector<T, A>> {
+    static size_t bytes(const std::vector<T, A>& vec) {
+        return vec.capacity() * sizeof(T) + elements_memory_usage(vec);
+    }
+};
+
+template<typename A>
+struct t_memory_usage<std::vector<bool, A>> {
+    static size_t bytes(const std::vector<bool, A>& vec) {
+        return vec.capacity() / CHAR_BIT;
+    }
+};
+
+template<typename K, typename V, typename A>
+struct t_memory_usage<vtr::vector<K, V, A>> {
+    static size_t bytes(const vtr::vector<K, V, A>& vec) {
+        if (std::is_same<V, bool>::value) {
+            return vec.capacity() / CHAR_BIT;
+        }
+        return vec.capacity() * sizeof(V) + elements_memory_usage(vec);
+    }
+};
+
+template<typename K, typename V, typename S>
+struct t_memory_usage<vtr::vector_map<K, V, S>> {
+    static size_t bytes(const vtr::vector_map<K, V, S>& vec) {
+        if (std::is_same<V, bool>::value) {
+            return vec.capacity() / CHAR_BIT;
+        }
+        return vec.capacity() * sizeof(V) + elements_memory_usage(vec);
+    }
+};
+
+template<typename T>
+struct t_memory_usage<vtr::optional<T>> {
+    static size_t bytes(const vtr::optional<T>& value) {
+        return value ? memory_usage(*value) : 0;
+    }
+};
+
+template<typename C, typename Tr, typename A>
+struct t_memory_usage<std::basic_string<C, Tr, A>> {
+    static size_t bytes(const std::basic_string<C, Tr, A>& str) {
+        //Short strings are stored inline
+        if (str.capacity() < sizeof(str) / sizeof(C)) {
+            return 0;
+        }
+        return (str.capacity() + 1) * sizeof(C);
+    }
+};
+
+template<typename T1, typename T2>
+struct t_memory_usage<std::pair<T1, T2>> {
+    static size_t bytes(const std::pair<T1, T2>& pair) {
+        return memory_usage(pair.first) + memory_usage(pair.second);
+    }
+};
+
+template<typename T, size_t N>
+struct t_memory_usage<vtr::NdMatrix<T, N>> {
+    static size_t bytes(const vtr::NdMatrix<T, N>& matrix) {
+        size_t bytes = matrix.size() * sizeof(T);
+        if (!owns_no_heap_memory<T>()) {
+            for (size_t i = 0; i < matrix.size(); ++i) {
+                bytes += memory_usage(matrix.get(i));
+            }
+        }
+        return bytes;
+    }
+};
+
+///@brief The heap bytes of a node based associative container
+template<typename Map>
+size_t node_container_memory_usage(const Map& map) {
+    return map.size() * node_bytes<typename Map::value_type>() + elements_memory_usage(map);
+}
+
+///@brief The heap bytes of a hashed container: its nodes and bucket array
+template<typename Map>
+size_t hashed_container_memory_usage(const Map& map) {
+    return map.bucket_count() * sizeof(void*) + node_container_memory_usage(map);
+}
+
+template<typename K, typename V, typename C, typename A>
+struct t_memory_usage<std::map<K, V, C, A>> {
+    static size_t bytes(const std::map<K, V, C, A>& map) { return node_container_memory_usage(map); }
+};
+
+template<typename K, typename V, typename C, typename A>
+struct t_memory_usage<std::multimap<K, V, C, A>> {
+    static size_t bytes(const std::multimap<K, V, C, A>& map) { return node_container_memory_usage(map); }
+};
+
+template<typename K, typename C, typename A>
+struct t_memory_usage<std::set<K, C, A>> {
+    static size_t bytes(const std::set<K, C, A>& set) { return node_container_memory_usage(set); }
+};
+
+template<typename K, typename V, typename H, typename E, typename A>
+struct t_memory_usage<std::unordered_map<K, V, H, E, A>> {
+    static size_t bytes(const std::unordered_map<K, V, H, E, A>& map) { return hashed_container_memory_usage(map); }
+};
+
+template<typename K, typename V, typename H, typename E, typename A>
+struct t_memory_usage<std::unordered_multimap<K, V, H, E, A>> {
+    static size_t bytes(const std::unordered_multimap<K, V, H, E, A>& map) { return hashed_container_memory_usage(map); }
+};
+
+template<typename K, typename H, typename E, typename A>
+struct t_memory_usage<std::unordered_set<K, H, E, A>> {
+    static size_t bytes(const std::unordered_set<K, H, E, A>& set) { return hashed_container_memory_usage(set); }
+};
+
+} // namespace detail
+
+///@brief Returns the (estimated) number of heap bytes owned by value, excluding sizeof(value)
+template<typename T>
+size_t memory_usage(const T& value) {
+    return detail::t_memory_usage<T>::bytes(value);
+}
+
+///@brief Returns the (estimated) total number of heap bytes owned by values
+template<typename T, typename... Ts>
+size_t memory_usage(const T& value, const Ts&... values) {
+    return memory_usage(value) + memory_usage(values...);
+}
+
+} // namespace vtr
+
+#endif
@@ -33,6 +33,11 @@ RandState get_random_state() {
     return random_state;
 }
 
+/* restores the random_state value */
+void set_random_state(RandState state) {
+    random_state = state;
+}
+
 int irand(int imax, RandState& state) {
 #ifdef SPEC_CPU
     /* SPEC CPU requires a different random number generator */
@@ -88,4 +93,59 @@ float frand() {
 #endif
 }
 
+/* Expands a 64 bit seed into well mixed state words (the splitmix64 generator)   *
+ * so that similar seeds (e.g. 1, 2, 3) still give unrelated streams.           */
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15u);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+}
+
+RandomStream::RandomStream(uint64_t seed, size_t stream_index) {
+    uint64_t x = seed;
+    uint64_t s01 = splitmix64(x);
+    uint64_t s23 = splitmix64(x);
+    state_[0] = (uint32_t)s01;
+    state_[1] = (uint32_t)(s01 >> 32);
+    state_[2] = (uint32_t)s23;
+    state_[3] = (uint32_t)(s23 >> 32);
+    //The all zero state is a fixed point of the generator
+    if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+        state_[0] = 1;
+    }
+
+    for (size_t i = 0; i < stream_index; ++i) {
+        jump();
+    }
+}
+
+void RandomStream::irand(int imax, int* values, size_t num_values) {
+    for (size_t i = 0; i < num_values; ++i) {
+        values[i] = irand(imax);
+    }
+}
+
+void RandomStream::jump() {
+    static constexpr uint32_t JUMP[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+
+    uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (uint32_t jump_word : JUMP) {
+        for (int b = 0; b < 32; b++) {
+            if (jump_word & (uint32_t(1) << b)) {
+                s0 ^= state_[0];
+                s1 ^= state_[1];
+                s2 ^= state_[2];
+                s3 ^= state_[3];
+            }
+            next();
+        }
+    }
+
+    state_[0] = s0;
+    state_[1] = s1;
+    state_[2] = s2;
+    state_[3] = s3;
+}
+
 } // namespace vtr
@@ -1,6 +1,8 @@
 #ifndef VTR_RANDOM_H
 #define VTR_RANDOM_H
 #include <algorithm> //For std::swap
+#include <cstddef>
+#include <cstdint>
 
 namespace vtr {
 /*********************** Portable random number generators *******************/
@@ -14,6 +16,9 @@ void srandom(int seed);
 ///@brief Return The random number generator state
 RandState get_random_state();
 
+///@brief Restores a random number generator state returned by get_random_state(), e.g. to resume from a checkpoint
+void set_random_state(RandState state);
+
 ///@brief Return a randomly generated integer less than or equal imax
 int irand(int imax);
 
@@ -23,6 +28,64 @@ int irand(int imax, RandState& rand_state);
 ///@brief Return a randomly generated float number between [0,1]
 float frand();
 
+/**
+ * @brief A pseudo-random number generator which can be split into independent streams
+ *
+ * Unlike the generator behind vtr::irand()/vtr::frand(), which has a single global
+ * state, each RandomStream has its own state, so parallel workers can each own one
+ * without contending on (or racing over) a shared generator.
+ *
+ * This is the xoshiro128** generator (http://prng.di.unimi.it/) with a period of 2^128 - 1.
+ * Its jump() advances a stream by 2^64 values, so the streams built from the same seed
+ * with different stream indices never overlap in practice, and are reproducible for a
+ * given (seed, stream index) however many workers there are.
+ */
+class RandomStream {
+  public:
+    ///@brief Builds stream number stream_index of seed
+    explicit RandomStream(uint64_t seed = 0, size_t stream_index = 0);
+
+    ///@brief Returns the next 32 random bits
+    uint32_t next() {
+        const uint32_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint32_t t = state_[1] << 9;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 11);
+
+        return result;
+    }
+
+    ///@brief Returns a random integer in [0..imax]
+    int irand(int imax) {
+        //Scale the 32 random bits to [0..imax] with a multiply, instead of a (slow and biased) modulus
+        return (int)(((uint64_t)next() * ((uint64_t)imax + 1)) >> 32);
+    }
+
+    ///@brief Returns a random float in [0..1)
+    float frand() {
+        //The top 24 bits fill the float mantissa exactly
+        return (next() >> 8) * (1.f / (1u << 24));
+    }
+
+    ///@brief Fills values[0..num_values-1] with random integers in [0..imax], e.g. for a batch of move proposals
+    void irand(int imax, int* values, size_t num_values);
+
+    ///@brief Advances the stream by 2^64 values
+    void jump();
+
+  private:
+    static uint32_t rotl(uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    uint32_t state_[4];
+};
+
 /**
  * @brief Portable/invariant version of std::shuffle
  *
@@ -41,5 +104,14 @@ void shuffle(Iter first, Iter last, RandState& rand_state) {
     }
 }
 
+///@brief Portable/invariant version of std::shuffle, drawing from a RandomStream
+template<typename Iter>
+void shuffle(Iter first, Iter last, RandomStream& rand_stream) {
+    for (auto i = (last - first) - 1; i > 0; --i) {
+        using std::swap;
+        swap(first[i], first[rand_stream.irand(i)]);
+    }
+}
+
 } // namespace vtr
 #endif
@@ -0,0 +1,156 @@
+#ifndef VTR_STAMPED_ID_MAP_H
+#define VTR_STAMPED_ID_MAP_H
+#include <cstdint>
+#include <vector>
+
+#include "vtr_assert.h"
+
+namespace vtr {
+/**
+ * @brief A std::map-like container for a sparse set of keys from a large id space (e.g. vtr::StrongId)
+ *
+ * Each key is given a local slot in insertion order, and the keys and values
+ * are stored in dense vectors indexed by slot. Keys are found through an open
+ * addressing (linear probing) table of slots.
+ *
+ * Every table entry records the epoch it was written in. clear() bumps the epoch
+ * instead of touching the table, which empties the map in O(1) while keeping all
+ * of its storage. A map that is cleared and refilled with a similar number of
+ * keys therefore allocates nothing, unlike a std::map which allocates a node per key.
+ *
+ * Requires that K be convertable to size_t with the size_t operator (i.e. size_t()).
+ * Keys can not be erased individually.
+ */
+template<class K, class T>
+class stamped_id_map {
+  public:
+    typedef K key_type;
+    typedef T mapped_type;
+    typedef typename std::vector<T>::size_type size_type;
+
+  public:
+    ///@brief Returns the number of keys in the map
+    size_type size() const { return keys_.size(); }
+
+    ///@brief Returns true if the map holds no keys
+    bool empty() const { return keys_.empty(); }
+
+    ///@brief Returns 1 if key is in the map, and 0 otherwise
+    size_type count(const K key) const {
+        return find_slot(key) != NO_SLOT ? 1 : 0;
+    }
+
+    ///@brief Returns the value of key, inserting a value initialized one if key is not in the map
+    T& operator[](const K key) {
+        int slot = find_slot(key);
+        if (slot == NO_SLOT) {
+            slot = insert_slot(key);
+        }
+        return values_[slot];
+    }
+
+    ///@brief Returns the value of key, which must be in the map
+    const T& at(const K key) const {
+        int slot = find_slot(key);
+        VTR_ASSERT(slot != NO_SLOT);
+        return values_[slot];
+    }
+
+    ///@brief Removes all keys, keeping the allocated storage for reuse
+    void clear() {
+        keys_.clear();
+        values_.clear();
+
+        ++epoch_;
+        if (epoch_ == 0) {
+            //The epoch wrapped around, so stale entries could look current
+            for (t_entry& entry : table_) {
+                entry.epoch = 0;
+            }
+            epoch_ = 1;
+        }
+    }
+
+    ///@brief Reserves space for num_keys keys
+    void reserve(size_type num_keys) {
+        keys_.reserve(num_keys);
+        values_.reserve(num_keys);
+        if (table_size_for(num_keys) > table_.size()) {
+            rehash(table_size_for(num_keys));
+        }
+    }
+
+  private:
+    static constexpr int NO_SLOT = -1;
+    static constexpr size_t MIN_TABLE_SIZE = 16;
+
+    struct t_entry {
+        uint32_t epoch = 0;
+        int slot = NO_SLOT;
+    };
+
+    ///@brief Table size (a power of two) keeping the load factor at or below 1/2
+    static size_t table_size_for(size_type num_keys) {
+        size_t table_size = MIN_TABLE_SIZE;
+        while (table_size < 2 * num_keys) {
+            table_size *= 2;
+        }
+        return table_size;
+    }
+
+    size_t home_index(const K key) const {
+        //Fibonacci hashing spreads consecutive ids over the table
+        uint64_t hash = uint64_t(size_t(key)) * UINT64_C(0x9E3779B97F4A7C15);
+        return size_t(hash >> 32) & (table_.size() - 1);
+    }
+
+    int find_slot(const K key) const {
+        if (table_.empty()) return NO_SLOT;
+
+        size_t mask = table_.size() - 1;
+        for (size_t i = home_index(key);; i = (i + 1) & mask) {
+            const t_entry& entry = table_[i];
+            if (entry.epoch != epoch_) return NO_SLOT;
+            if (keys_[entry.slot] == key) return entry.slot;
+        }
+    }
+
+    int insert_slot(const K key) {
+        if (2 * (keys_.size() + 1) > table_.size()) {
+            rehash(table_size_for(keys_.size() + 1));
+        }
+
+        int slot = keys_.size();
+        keys_.push_back(key);
+        values_.emplace_back();
+        place(key, slot);
+        return slot;
+    }
+
+    void place(const K key, int slot) {
+        size_t mask = table_.size() - 1;
+        size_t i = home_index(key);
+        while (table_[i].epoch == epoch_) {
+            i = (i + 1) & mask;
+        }
+        table_[i].epoch = epoch_;
+        table_[i].slot = slot;
+    }
+
+    void rehash(size_t table_size) {
+        table_.assign(table_size, t_entry());
+        epoch_ = 1;
+        for (size_t slot = 0; slot < keys_.size(); ++slot) {
+            place(keys_[slot], slot);
+        }
+    }
+
+  private:
+    std::vector<t_entry> table_;
+    std::vector<K> keys_;
+    std::vector<T> values_;
+    uint32_t epoch_ = 1;
+};
+
+} // namespace vtr
+#endif
@@ -0,0 +1,125 @@
+#ifndef VTR_STRING_ID_INDEX_H
+#define VTR_STRING_ID_INDEX_H
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "vtr_assert.h"
+
+namespace vtr {
+/**
+ * @brief A hash index from strings to their ids in a string table (e.g. a vtr::vector_map<StringId, std::string>)
+ *
+ * Unlike a std::unordered_map<std::string, StringId> the index holds no copy of the strings:
+ * it is an open addressing (linear probing) table of 32-bit hash and id pairs, and candidate
+ * strings are compared against the string table passed to find(). Each string therefore costs
+ * at most 16 bytes of index (at the maximum load factor of 1/2), rather than a heap allocated
+ * hash node holding a second copy of the string.
+ *
+ * Requires that the string table be indexable by StringId, returning the string, and that
+ * StringId be a vtr::StrongId (or similar) whose default value is invalid.
+ * Strings can not be removed individually.
+ */
+template<class StringId>
+class string_id_index {
+  public:
+    typedef size_t size_type;
+
+  public:
+    ///@brief Returns the number of strings in the index
+    size_type size() const { return size_; }
+
+    ///@brief Returns true if the index holds no strings
+    bool empty() const { return size_ == 0; }
+
+    ///@brief Returns the heap memory used by the index, in bytes
+    size_t memory_usage() const { return table_.capacity() * sizeof(t_entry); }
+
+    ///@brief Returns the id of str in strings, or an invalid id if it is not in the index
+    template<class Strings>
+    StringId find(std::string_view str, const Strings& strings) const {
+        if (table_.empty()) return StringId();
+
+        uint32_t hash = hash_string(str);
+        size_t mask = table_.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const t_entry& entry = table_[i];
+            if (!entry.id) return StringId();
+            if (entry.hash == hash && std::string_view(strings[entry.id]) == str) return entry.id;
+        }
+    }
+
+    ///@brief Adds str (which must not already be in the index) as string id
+    void insert(std::string_view str, StringId id) {
+        VTR_ASSERT(id);
+        if (2 * (size_ + 1) > table_.size()) {
+            rehash(table_size_for(size_ + 1));
+        }
+        place(hash_string(str), id);
+        ++size_;
+    }
+
+    ///@brief Removes all strings, keeping the allocated storage for reuse
+    void clear() {
+        table_.assign(table_.size(), t_entry());
+        size_ = 0;
+    }
+
+    ///@brief Reserves space for num_strings strings
+    void reserve(size_type num_strings) {
+        if (table_size_for(num_strings) > table_.size()) {
+            rehash(table_size_for(num_strings));
+        }
+    }
+
+  private:
+    static constexpr size_t MIN_TABLE_SIZE = 16;
+
+    struct t_entry {
+        uint32_t hash = 0;
+        StringId id;
+    };
+
+    ///@brief Table size (a power of two) keeping the load factor at or below 1/2
+    static size_t table_size_for(size_type num_strings) {
+        size_t table_size = MIN_TABLE_SIZE;
+        while (table_size < 2 * num_strings) {
+            table_size *= 2;
+        }
+        return table_size;
+    }
+
+    static uint32_t hash_string(std::string_view str) {
+        uint64_t hash = std::hash<std::string_view>()(str);
+        return uint32_t(hash ^ (hash >> 32));
+    }
+
+    void place(uint32_t hash, StringId id) {
+        size_t mask = table_.size() - 1;
+        size_t i = hash & mask;
+        while (table_[i].id) {
+            i = (i + 1) & mask;
+        }
+        table_[i].hash = hash;
+        table_[i].id = id;
+    }
+
+    void rehash(size_t table_size) {
+        std::vector<t_entry> old_table(table_size);
+        std::swap(old_table, table_);
+        for (const t_entry& entry : old_table) {
+            if (entry.id) {
+                place(entry.hash, entry.id);
+            }
+        }
+    }
+
+  private:
+    std::vector<t_entry> table_;
+    size_type size_ = 0;
+};
+
+} // namespace vtr
+#endif
@@ -1,11 +1,68 @@
 #include "vtr_time.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
 #include "vtr_log.h"
 #include "vtr_rusage.h"
 
 namespace vtr {
 
-int f_timer_depth = 0;
+//Each thread nests its own action timers
+thread_local int f_timer_depth = 0;
+
+namespace {
+
+///@brief A finished action timer of the timing trace
+struct t_trace_event {
+    std::string action;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point finish;
+    int thread;
+    int depth;
+    float max_rss_mib;
+    float delta_max_rss_mib;
+};
+
+///@brief The timing trace being recorded, shared by all threads
+struct t_timing_trace {
+    std::mutex mutex;
+    std::atomic<bool> enabled{false};
+    std::string filename;
+    std::vector<t_trace_event> events;
+};
+
+t_timing_trace f_timing_trace;
+
+std::atomic<int> f_num_trace_threads{0};
+
+///@brief Returns the trace id of the calling thread (threads are numbered in the order they first start an action timer)
+int trace_thread_id() {
+    thread_local int id = f_num_trace_threads++;
+    return id;
+}
+
+///@brief Returns str escaped for use as a JSON string
+std::string json_escape(const std::string& str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
 
 ///@brief Constructor
 Timer::Timer()
@@ -28,15 +85,28 @@ float Timer::delta_max_rss_mib() const {
     return (get_max_rss() - initial_max_rss_) / BYTE_TO_MIB;
 }
 
+///@brief Returns the construction time
+std::chrono::time_point<Timer::clock> Timer::start_time() const {
+    return start_;
+}
+
 ///@brief Constructor
 ScopedActionTimer::ScopedActionTimer(std::string action_str)
     : action_(action_str)
     , depth_(f_timer_depth++) {
+    trace_thread_id(); //Number the threads in the order they start timing
 }
 
 ///@brief Destructor
 ScopedActionTimer::~ScopedActionTimer() {
     --f_timer_depth;
+
+    if (f_timing_trace.enabled) {
+        t_trace_event event{action_, start_time(), clock::now(), trace_thread_id(), depth_, max_rss_mib(), delta_max_rss_mib()};
+
+        std::lock_guard<std::mutex> lock(f_timing_trace.mutex);
+        f_timing_trace.events.push_back(std::move(event));
+    }
 }
 
 ///@brief Sets quiet value (when true, prints the timing info)
@@ -96,4 +166,64 @@ ScopedStartFinishTimer::~ScopedStartFinishTimer() {
     }
 }
 
+void start_timing_trace(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(f_timing_trace.mutex);
+    f_timing_trace.filename = filename;
+    f_timing_trace.events.clear();
+    f_timing_trace.enabled = true;
+}
+
+void write_timing_trace() {
+    std::lock_guard<std::mutex> lock(f_timing_trace.mutex);
+    if (!f_timing_trace.enabled) {
+        return;
+    }
+    f_timing_trace.enabled = false;
+
+    std::vector<t_trace_event>& events = f_timing_trace.events;
+
+    //Parents before their children, so viewers nest events which start at the same time correctly
+    std::stable_sort(events.begin(), events.end(), [](const t_trace_event& lhs, const t_trace_event& rhs) {
+        return lhs.start < rhs.start || (lhs.start == rhs.start && lhs.depth < rhs.depth);
+    });
+
+    std::ofstream os(f_timing_trace.filename);
+    if (!os) {
+        VTR_LOG_WARN("Failed to open timing trace file '%s'\n", f_timing_trace.filename.c_str());
+        return;
+    }
+
+    //Times are in microseconds since the first recorded action started
+    auto to_us = [&](std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    auto origin = events.empty() ? std::chrono::steady_clock::time_point() : events.front().start;
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const t_trace_event& event = events[i];
+        char buf[256];
+        snprintf(buf, sizeof(buf), "\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d,\"args\":{\"depth\":%d,\"max_rss_mib\":%.1f,\"delta_max_rss_mib\":%.1f}",
+                 to_us(event.start - origin), to_us(event.finish - event.start), event.thread,
+                 event.depth, event.max_rss_mib, event.delta_max_rss_mib);
+
+        os << "{\"name\":\"" << json_escape(event.action) << "\"," << buf << "}";
+
+        //Peak memory usage as a counter track
+        snprintf(buf, sizeof(buf), "{\"name\":\"max_rss\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":0,\"args\":{\"MiB\":%.1f}}",
+                 to_us(event.finish - origin), event.max_rss_mib);
+        os << ",\n"
+           << buf << (i + 1 < events.size() ? ",\n" : "\n");
+    }
+    os << "]}\n";
+
+    VTR_LOG("Wrote timing trace of %zu actions to '%s'\n", events.size(), f_timing_trace.filename.c_str());
+    events.clear();
+}
+
+///@brief Destructor
+ScopedTimingTraceWriter::~ScopedTimingTraceWriter() {
+    write_timing_trace();
+}
+
 } // namespace vtr
@@ -28,8 +28,11 @@ class Timer {
     ///@brief Return change in peak memory resident set size (in MiB)
     float delta_max_rss_mib() const;
 
-  private:
+  protected:
     using clock = std::chrono::steady_clock;
+    std::chrono::time_point<clock> start_time() const;
+
+  private:
     std::chrono::time_point<clock> start_;
 
     size_t initial_max_rss_; //Maximum resident set size In bytes
@@ -37,6 +40,8 @@ class Timer {
 };
 
 ///@brief Scoped time class which prints the time elapsed for the specifid action
+///
+///Every action timer is also recorded in the timing trace, if one is being recorded (see start_timing_trace()).
 class ScopedActionTimer : public Timer {
   public:
     ScopedActionTimer(const std::string action);
@@ -94,6 +99,32 @@ class ScopedStartFinishTimer : public ScopedActionTimer {
     ScopedStartFinishTimer(const std::string action);
     ~ScopedStartFinishTimer();
 };
+
+/**
+ * @brief Starts recording the action timers of all threads, to be written to filename by write_timing_trace()
+ *
+ * The trace is a Chrome trace event JSON file (viewable with chrome://tracing or Perfetto), with one complete
+ * event per action timer (nested by time on the track of the thread it ran on) annotated with the peak memory
+ * usage at its end. Action timers which are still running when the trace is started are recorded too.
+ */
+void start_timing_trace(const std::string& filename);
+
+///@brief Writes the recorded timing trace (if start_timing_trace() was called) and stops recording
+void write_timing_trace();
+
+/**
+ * @brief Writes the timing trace (see write_timing_trace()) when destructed
+ *
+ * Construct it before the outermost action timer, so the trace is written once all the timers have finished.
+ */
+class ScopedTimingTraceWriter {
+  public:
+    ScopedTimingTraceWriter() = default;
+    ~ScopedTimingTraceWriter();
+
+    ScopedTimingTraceWriter(const ScopedTimingTraceWriter&) = delete;
+    ScopedTimingTraceWriter& operator=(const ScopedTimingTraceWriter&) = delete;
+};
 } // namespace vtr
 
 #endif
@@ -122,6 +122,8 @@ class vector_map {
 
     ///@brief Returns the capacity of the container
     size_t capacity() const { return vec_.capacity(); }
+    ///@brief Requests the container to reserve space for n elements
+    void reserve(size_t n) { vec_.reserve(n); }
     ///@brief Requests the container to reduce its capacity to fit its size.
     void shrink_to_fit() { vec_.shrink_to_fit(); }
 
@@ -16,6 +16,8 @@ TEST_CASE("Array view", "[array_view/array_view]") {
     const vtr::array_view<uint16_t> carr_view3(arr_view);
 
     REQUIRE(arr.size() == arr_view.size());
+    REQUIRE(!arr_view.empty());
+    REQUIRE(vtr::array_view<uint16_t>().empty());
     REQUIRE(arr.data() == arr_view.data());
     REQUIRE(arr.data() == carr_view.data());
     REQUIRE(arr.data() == carr_view2.data());
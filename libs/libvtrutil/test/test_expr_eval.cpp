@@ -88,3 +88,42 @@ TEST_CASE("Function Expressions", "[vtr_expr_eval]") {
     REQUIRE(parser.parse_formula("gcd(20, 25)", vars) == 5);
     REQUIRE(parser.parse_formula("lcm(20, 25)", vars) == 100);
 }
+
+TEST_CASE("Compiled Formulas", "[vtr_expr_eval]") {
+    vtr::FormulaParser parser;
+    vtr::t_formula_data vars;
+
+    const char* formulas[] = {"42", "x + y * 2", "(x + y) * 2", "max(x, y) - min(x, y)", "gcd(x, 20) + lcm(y, 4)",
+                              "x % y + x / y", "(x > y) || (x == 3)", "W - t - 1", "(t + 3 * W) % W"};
+
+    for (const char* formula : formulas) {
+        vtr::CompiledFormula compiled(formula);
+        for (int x : {1, 3, 10}) {
+            for (int y : {2, 7}) {
+                vars.clear();
+                vars.set_var_value("x", x);
+                vars.set_var_value("y", y);
+                vars.set_var_value("W", y * 4);
+                vars.set_var_value("t", x);
+                REQUIRE(compiled.evaluate(vars) == parser.parse_formula(formula, vars));
+            }
+        }
+    }
+
+    //Piece-wise formulas pick the formula of the range containing t
+    vtr::CompiledFormula piecewise("{0:(W/2)} t-1; {(W/2)+1:W} t+1;");
+    vars.clear();
+    vars.set_var_value("W", 10);
+    for (int t = 0; t <= 10; ++t) {
+        vars.set_var_value("t", t);
+        REQUIRE(piecewise.evaluate(vars) == parser.parse_piecewise_formula(piecewise.formula().c_str(), vars));
+    }
+
+    REQUIRE_THROWS(vtr::CompiledFormula(""));
+    REQUIRE_THROWS(vtr::CompiledFormula("x +"));
+    REQUIRE_THROWS(vtr::CompiledFormula("(x + y"));
+    REQUIRE_THROWS(vtr::CompiledFormula("x y"));
+
+    vtr::CompiledFormula unbound("z + 1");
+    REQUIRE_THROWS(unbound.evaluate(vars));
+}
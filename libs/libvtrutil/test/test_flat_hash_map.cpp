@@ -0,0 +1,98 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_flat_hash_map.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("Matches std::unordered_map", "[vtr_flat_hash_map]") {
+    std::unordered_map<int, int> ref;
+    vtr::flat_hash_map<int, int> map;
+
+    //Insertions with repeats, interleaved with erasures
+    for (int i = 0; i < 20000; ++i) {
+        int key = (i * 7919) % 5003;
+        if (i % 3 == 0) {
+            REQUIRE(map.erase(key) == ref.erase(key));
+        } else {
+            auto result = map.insert(std::make_pair(key, i));
+            auto ref_result = ref.insert(std::make_pair(key, i));
+            REQUIRE(result.second == ref_result.second);
+            REQUIRE(result.first->first == key);
+            REQUIRE(result.first->second == ref_result.first->second);
+        }
+    }
+
+    REQUIRE(map.size() == ref.size());
+    for (const auto& kv : ref) {
+        REQUIRE(map.count(kv.first) == 1);
+        REQUIRE(map.at(kv.first) == kv.second);
+    }
+    for (int key = 5003; key < 6000; ++key) {
+        REQUIRE(map.find(key) == map.end());
+    }
+
+    //Iteration visits each element once
+    size_t num_visited = 0;
+    for (const auto& kv : map) {
+        REQUIRE(ref.at(kv.first) == kv.second);
+        ++num_visited;
+    }
+    REQUIRE(num_visited == ref.size());
+}
+
+TEST_CASE("Operator[] and erase while iterating", "[vtr_flat_hash_map]") {
+    vtr::flat_hash_map<std::string, int> map;
+
+    for (int i = 0; i < 1000; ++i) {
+        map[std::to_string(i % 100)] += i;
+    }
+    REQUIRE(map.size() == 100);
+    REQUIRE(map.at("7") == 7 * 10 + 100 * 45);
+
+    //Erase the odd keys
+    for (auto it = map.begin(); it != map.end();) {
+        if (std::stoi(it->first) % 2) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto& kv : map) {
+        REQUIRE(std::stoi(kv.first) % 2 == 0);
+    }
+    REQUIRE(map.size() == 50);
+
+    //Copies are independent
+    vtr::flat_hash_map<std::string, int> copy = map;
+    copy.clear();
+    REQUIRE(copy.empty());
+    REQUIRE(map.size() == 50);
+
+    vtr::flat_hash_map<std::string, int> moved = std::move(map);
+    REQUIRE(moved.size() == 50);
+    REQUIRE(moved.count("0") == 1);
+}
+
+TEST_CASE("Pointer keys and tombstones", "[vtr_flat_hash_map]") {
+    //Aligned pointers have constant low bits, which the table must not rely on
+    std::vector<double> storage(4096);
+    vtr::flat_hash_set<const double*> set;
+
+    set.reserve(64);
+    size_t capacity = set.capacity();
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            REQUIRE(set.insert(&storage[round * 40 + i]).second);
+        }
+        REQUIRE(set.size() == 50);
+        for (int i = 0; i < 50; ++i) {
+            REQUIRE(set.contains(&storage[round * 40 + i]));
+            REQUIRE(set.erase(&storage[round * 40 + i]) == 1);
+        }
+        REQUIRE(set.empty());
+    }
+    //Churn with a steady size reuses the table instead of growing it
+    REQUIRE(set.capacity() == capacity);
+}
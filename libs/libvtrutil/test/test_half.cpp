@@ -0,0 +1,51 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_half.h"
+
+#include <cmath>
+#include <limits>
+
+TEST_CASE("Half round trip", "[vtr_half]") {
+    //Every non-NaN half converts to a float and back unchanged
+    for (uint32_t half = 0; half <= 0xFFFF; ++half) {
+        float value = vtr::half_to_float(uint16_t(half));
+        if (std::isnan(value)) {
+            REQUIRE((half & 0x7C00) == 0x7C00);
+            continue;
+        }
+        REQUIRE(vtr::float_to_half(value) == half);
+    }
+}
+
+TEST_CASE("Half conversion", "[vtr_half]") {
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(1.f)) == 1.f);
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(-2.5f)) == -2.5f);
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(65504.f)) == 65504.f);
+
+    //Out of range values saturate to infinity
+    float inf = std::numeric_limits<float>::infinity();
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(1e6f)) == inf);
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(inf)) == inf);
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(-inf)) == -inf);
+    REQUIRE(std::isnan(vtr::half_to_float(vtr::float_to_half(std::numeric_limits<float>::quiet_NaN()))));
+
+    //Ties round to even: 2049 lies halfway between the halves 2048 and 2050
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(2049.f)) == 2048.f);
+    REQUIRE(vtr::half_to_float(vtr::float_to_half(2051.f)) == 2052.f);
+}
+
+TEST_CASE("Scaled half precision", "[vtr_half]") {
+    //Delays in seconds are below the normal half range, and must be scaled
+    float max_delay = 3.7e-9f;
+    float scale = vtr::half_scale(max_delay);
+    REQUIRE(max_delay / scale <= 32768.f);
+    REQUIRE(max_delay / scale > 16384.f);
+
+    for (float delay = 1e-12f; delay < max_delay; delay *= 1.37f) {
+        float decoded = vtr::half_to_float(vtr::float_to_half(delay / scale)) * scale;
+        REQUIRE(std::abs(decoded - delay) <= delay / 2048.f);
+    }
+
+    REQUIRE(vtr::half_scale(0.f) == 1.f);
+    REQUIRE(vtr::half_scale(std::numeric_limits<float>::infinity()) == 1.f);
+}
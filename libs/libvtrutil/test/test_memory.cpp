@@ -0,0 +1,54 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_memory.h"
+#include "vtr_memory_usage.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("Huge page allocator", "[vtr_memory]") {
+    SECTION("Small allocation") {
+        std::vector<int, vtr::huge_page_allocator<int>> vec(100);
+        for (size_t i = 0; i < vec.size(); ++i) {
+            vec[i] = i;
+        }
+        REQUIRE(reinterpret_cast<uintptr_t>(vec.data()) % alignof(int) == 0);
+        REQUIRE(vec[99] == 99);
+    }
+
+    SECTION("Huge allocation") {
+        size_t num_elements = 2 * vtr::HUGE_PAGE_SIZE / sizeof(uint64_t);
+        std::vector<uint64_t, vtr::huge_page_allocator<uint64_t>> vec(num_elements, 7);
+        REQUIRE(reinterpret_cast<uintptr_t>(vec.data()) % vtr::HUGE_PAGE_SIZE == 0);
+        REQUIRE(vec.front() == 7);
+        REQUIRE(vec.back() == 7);
+
+        //Growing keeps the contents
+        vec.push_back(8);
+        REQUIRE(vec[num_elements - 1] == 7);
+        REQUIRE(vec.back() == 8);
+    }
+}
+
+TEST_CASE("Memory usage", "[vtr_memory]") {
+    SECTION("Flat containers") {
+        std::vector<int> vec;
+        vec.reserve(100);
+        REQUIRE(vtr::memory_usage(vec) == 100 * sizeof(int));
+        REQUIRE(vtr::memory_usage(42) == 0);
+
+        vtr::NdMatrix<float, 2> matrix({10, 20});
+        REQUIRE(vtr::memory_usage(matrix) == 200 * sizeof(float));
+    }
+
+    SECTION("Nested containers") {
+        std::vector<std::vector<int>> vec(10, std::vector<int>(100));
+        REQUIRE(vtr::memory_usage(vec) == 10 * sizeof(std::vector<int>) + 10 * 100 * sizeof(int));
+
+        std::unordered_map<int, std::vector<char>> map;
+        map[0] = std::vector<char>(1000);
+        REQUIRE(vtr::memory_usage(map) >= 1000 + sizeof(std::pair<const int, std::vector<char>>));
+        REQUIRE(vtr::memory_usage(vec, map) == vtr::memory_usage(vec) + vtr::memory_usage(map));
+    }
+}
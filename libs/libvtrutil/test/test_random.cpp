@@ -14,3 +14,69 @@ TEST_CASE("shuffle", "[vtr_random/shuffle]") {
     std::vector<int> numbers_shuffled_1 = {5, 2, 4, 1, 3};
     REQUIRE(numbers == numbers_shuffled_1);
 }
+
+TEST_CASE("random_state", "[vtr_random/random_state]") {
+    vtr::srandom(42);
+    vtr::irand(100);
+
+    //Restoring the state repeats the same sequence
+    vtr::RandState state = vtr::get_random_state();
+    std::vector<int> sequence;
+    for (int i = 0; i < 5; ++i) {
+        sequence.push_back(vtr::irand(1000));
+    }
+
+    vtr::srandom(7);
+    vtr::set_random_state(state);
+    REQUIRE(vtr::get_random_state() == state);
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(vtr::irand(1000) == sequence[i]);
+    }
+}
+
+TEST_CASE("random_stream", "[vtr_random/random_stream]") {
+    //The same (seed, stream index) always gives the same sequence
+    vtr::RandomStream stream_a(42, 3);
+    vtr::RandomStream stream_b(42, 3);
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(stream_a.next() == stream_b.next());
+    }
+
+    //Stream i + 1 is stream i jumped ahead
+    vtr::RandomStream stream_0(42, 0);
+    vtr::RandomStream stream_1(42, 1);
+    stream_0.jump();
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(stream_0.next() == stream_1.next());
+    }
+
+    //Different streams and seeds differ
+    vtr::RandomStream stream_2(42, 2);
+    vtr::RandomStream other_seed(43, 2);
+    bool any_different = false;
+    for (int i = 0; i < 10; ++i) {
+        any_different |= (stream_2.next() != other_seed.next());
+    }
+    REQUIRE(any_different);
+
+    //Values stay in range
+    vtr::RandomStream stream(7);
+    for (int i = 0; i < 1000; ++i) {
+        int ival = stream.irand(10);
+        REQUIRE(ival >= 0);
+        REQUIRE(ival <= 10);
+
+        float fval = stream.frand();
+        REQUIRE(fval >= 0.);
+        REQUIRE(fval < 1.);
+    }
+
+    //A batch draws the same values as one at a time
+    vtr::RandomStream batch_stream(7, 1);
+    vtr::RandomStream single_stream(7, 1);
+    std::vector<int> batch(16);
+    batch_stream.irand(99, batch.data(), batch.size());
+    for (int value : batch) {
+        REQUIRE(value == single_stream.irand(99));
+    }
+}
@@ -0,0 +1,49 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_stamped_id_map.h"
+#include "vtr_strong_id.h"
+
+#include <map>
+
+struct stamped_test_tag;
+typedef vtr::StrongId<stamped_test_tag> StampedTestId;
+
+TEST_CASE("Matches std::map", "[vtr_stamped_id_map]") {
+    std::map<StampedTestId, int> ref;
+    vtr::stamped_id_map<StampedTestId, int> map;
+
+    //Sparse keys from a large id space, with repeats
+    for (int i = 0; i < 1000; ++i) {
+        StampedTestId key((i * 7919) % 100003);
+        ref[key] += i;
+        map[key] += i;
+    }
+
+    REQUIRE(map.size() == ref.size());
+    for (const auto& kv : ref) {
+        REQUIRE(map.count(kv.first) == 1);
+        REQUIRE(map.at(kv.first) == kv.second);
+    }
+    REQUIRE(map.count(StampedTestId(100004)) == 0);
+}
+
+TEST_CASE("Clear", "[vtr_stamped_id_map]") {
+    vtr::stamped_id_map<StampedTestId, float> map;
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(map.count(StampedTestId(i + round)) == 0);
+            map[StampedTestId(i + round)] = i;
+        }
+        REQUIRE(map.size() == 100);
+        REQUIRE(map.at(StampedTestId(round)) == 0.f);
+
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.count(StampedTestId(round)) == 0);
+
+        //New keys start value initialized
+        REQUIRE(map[StampedTestId(round)] == 0.f);
+        map.clear();
+    }
+}
@@ -0,0 +1,37 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "vtr_string_id_index.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector_map.h"
+
+#include <string>
+
+struct string_index_test_tag;
+typedef vtr::StrongId<string_index_test_tag> IndexTestStringId;
+
+TEST_CASE("Finds inserted strings", "[vtr_string_id_index]") {
+    vtr::vector_map<IndexTestStringId, std::string> strings;
+    vtr::string_id_index<IndexTestStringId> index;
+
+    REQUIRE(!index.find("a", strings));
+
+    //Enough strings to rehash several times, including the empty string
+    for (int i = 0; i < 1000; ++i) {
+        std::string str = (i == 0) ? "" : "top.sub" + std::to_string(i);
+        IndexTestStringId id(strings.size());
+        strings.push_back(str);
+        index.insert(str, id);
+    }
+    REQUIRE(index.size() == 1000);
+
+    for (size_t i = 0; i < strings.size(); ++i) {
+        IndexTestStringId id(i);
+        REQUIRE(index.find(strings[id], strings) == id);
+    }
+    REQUIRE(!index.find("top.sub1000", strings));
+    REQUIRE(!index.find("top.sub", strings));
+
+    index.clear();
+    REQUIRE(index.empty());
+    REQUIRE(!index.find("top.sub1", strings));
+}
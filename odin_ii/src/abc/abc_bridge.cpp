@@ -0,0 +1,763 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "abc_bridge.h"
+#include "odin_globals.h"
+#include "odin_util.h"
+#include "node_creation_library.h"
+#include "netlist_traversal.h"
+
+#include "vtr_memory.h"
+#include "vtr_util.h"
+
+#ifdef ODIN_USE_ABC
+#    include "base/abc/abc.h"
+#    include "base/main/main.h"
+#    include "base/io/ioAbc.h"
+#    include "base/cmd/cmd.h"
+#endif
+
+#ifndef ODIN_USE_ABC
+
+bool abc_bridge::is_available() {
+    return false;
+}
+
+bool abc_bridge::map_netlist(netlist_t* /*netlist*/, const std::string& /*script*/, int /*num_jobs*/, const char* /*file_name*/) {
+    return false;
+}
+
+#else
+
+namespace {
+
+/* the clock of the latches, restored on the latches of the mapped netlist */
+struct clock_domain_t {
+    const char* clock = NULL;
+    const char* edge = NULL;
+    bool is_single = true; // all the latches are clocked by the same edge of a top level input
+};
+
+/* soft logic mapped by one ABC run */
+struct partition_t {
+    std::vector<nnode_t*> nodes;       // soft logic nodes, in the order of the BLIF writer
+    std::vector<nnode_t*> top_outputs; // top level outputs buffered from the partition
+    size_t size() const { return nodes.size() + top_outputs.size(); }
+};
+
+const char* FALLBACK_MESSAGE = "Cannot map the netlist in-process with ABC (%s), writing the unmapped netlist\n";
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: driver_node)
+ * @brief the node driving the input pin pin_idx of node, if any
+ * ---------------------------------------------------------------------------------------------
+ */
+nnode_t* driver_node(nnode_t* node, long pin_idx) {
+    nnet_t* net = node->input_pins[pin_idx]->net;
+    return net->num_driver_pins ? net->driver_pins[0]->node : NULL;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: driver_name)
+ * @brief the name of the net driving the input pin pin_idx of node, as printed by the BLIF writer
+ * ---------------------------------------------------------------------------------------------
+ */
+char* driver_name(nnode_t* node, long pin_idx) {
+    static char unconn[] = "unconn";
+
+    nnode_t* driver = driver_node(node, pin_idx);
+    if (!driver) {
+        warning_message(NETLIST, node->loc,
+                        "Net %s driving node %s is itself undriven.",
+                        node->input_pins[pin_idx]->net->name, node->name);
+        return unconn;
+    }
+    return driver->name;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: is_single_driven)
+ * @brief whether none of the input nets of node has several drivers (for which the BLIF
+ * writer creates implicit buffers, driven several times)
+ * ---------------------------------------------------------------------------------------------
+ */
+bool is_single_driven(nnode_t* node) {
+    for (int i = 0; i < node->num_input_pins; i++) {
+        if (node->input_pins[i]->net->num_driver_pins > 1)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: node_cover)
+ * @brief the cover of a soft logic node, identical to the one of the BLIF writer,
+ * or an empty string if node is not soft logic
+ * ---------------------------------------------------------------------------------------------
+ */
+std::string node_cover(nnode_t* node) {
+    std::string cover;
+    switch (node->type) {
+        case GT:
+            return "100 1\n";
+        case LT:
+            return "010 1\n";
+        case ADDER_FUNC:
+            return "001 1\n010 1\n100 1\n111 1\n";
+        case CARRY_FUNC:
+            return "011 1\n101 1\n110 1\n111 1\n";
+        case BITWISE_NOT:
+            return "0 1\n";
+        case BUF_NODE:
+        case CLOCK_NODE:
+            return "1 1\n";
+        case SMUX_2:
+            return "01- 1\n1-1 1\n";
+        case LOGICAL_AND:
+            cover.append(node->num_input_pins, '1');
+            cover += " 1\n";
+            break;
+        case LOGICAL_OR:
+        case LOGICAL_NAND:
+            for (int i = 0; i < node->num_input_pins; i++) {
+                for (int j = 0; j < node->num_input_pins; j++)
+                    cover += (i != j) ? '-' : (node->type == LOGICAL_OR) ? '1' : '0';
+                cover += " 1\n";
+            }
+            break;
+        case LOGICAL_NOT:
+        case LOGICAL_NOR:
+            cover.append(node->num_input_pins, '0');
+            cover += " 1\n";
+            break;
+        case LOGICAL_EQUAL:
+        case LOGICAL_XOR:
+        case NOT_EQUAL:
+        case LOGICAL_XNOR: {
+            oassert(node->num_input_pins <= 3);
+            /* a 1 when odd (XOR) or even (XNOR) number of 1s */
+            bool odd = (node->type == LOGICAL_EQUAL || node->type == LOGICAL_XOR);
+            for (long i = 0; i < my_power(2, node->num_input_pins); i++) {
+                bool is_odd = (i % 8 == 1) || (i % 8 == 2) || (i % 8 == 4) || (i % 8 == 7);
+                if (is_odd == odd) {
+                    char* bits = convert_long_to_bit_string(i, node->num_input_pins);
+                    cover += bits;
+                    cover += " 1\n";
+                    vtr::free(bits);
+                }
+            }
+            break;
+        }
+        case MUX_2:
+            oassert(node->input_port_sizes[0] == node->input_port_sizes[1]);
+            for (long i = 0; i < node->input_port_sizes[0]; i++) {
+                for (long j = 0; j < node->num_input_pins; j++) {
+                    if (i == j || i + node->input_port_sizes[0] == j)
+                        cover += '1';
+                    else if (i > node->input_port_sizes[0])
+                        cover += '0';
+                    else
+                        cover += '-';
+                }
+                cover += " 1\n";
+            }
+            break;
+        default:
+            break;
+    }
+    return cover;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: collect_nodes)
+ * @brief collects the nodes the BLIF writer would output (in its depth first order, which
+ * the writer re-uses if the netlist cannot be mapped in-process)
+ *
+ * @param netlist pointer to the netlist
+ * @param nodes the soft logic and latch nodes of the netlist
+ * @param domain the clock of the latches
+ * @return NULL if the netlist can be mapped in-process, otherwise why it cannot
+ * ---------------------------------------------------------------------------------------------
+ */
+const char* collect_nodes(netlist_t* netlist, std::vector<nnode_t*>& nodes, clock_domain_t& domain) {
+    for (nnode_t* node : get_netlist_traversal_order(netlist)) {
+
+        switch (node->type) {
+            case INPUT_NODE:
+            case OUTPUT_NODE:
+            case PAD_NODE:
+            case GND_NODE:
+            case VCC_NODE:
+                break;
+            case CLOCK_NODE:
+                /* top level clocks are inputs, others buffer their driver */
+                if (node->num_input_pins == 1)
+                    nodes.push_back(node);
+                break;
+            case FF_NODE: {
+                oassert(node->num_input_pins == 2);
+                /* ABC drops the nets only used as clocks, so a sequential network keeps top level clocks only */
+                nnode_t* clock_driver = driver_node(node, 1);
+                if (!clock_driver || (clock_driver->type != INPUT_NODE && clock_driver->type != CLOCK_NODE) || clock_driver->num_input_pins)
+                    domain.is_single = false;
+
+                const char* edge = edge_type_blif_str(node->attributes->clk_edge_type, node->loc);
+                const char* clock = driver_name(node, 1);
+                if (!domain.clock) {
+                    domain.clock = clock;
+                    domain.edge = edge;
+                } else if (strcmp(domain.clock, clock) || strcmp(domain.edge, edge)) {
+                    domain.is_single = false;
+                }
+                nodes.push_back(node);
+                break;
+            }
+            case MULTIPLY:
+            case ADD:
+            case MINUS:
+            case MEMORY:
+            case HARD_IP:
+                return "the netlist has hard blocks";
+            default:
+                if (node_cover(node).empty())
+                    error_message(NETLIST, node->loc, "%s", "Output blif: node should have been converted to softer version.");
+                nodes.push_back(node);
+                break;
+        }
+        if (!is_single_driven(node))
+            return "the netlist has multi-driven nets";
+    }
+
+    for (long i = 0; i < netlist->num_top_output_nodes; i++) {
+        nnet_t* net = netlist->top_output_nodes[i]->input_pins[0]->net;
+        if (net->num_driver_pins > 1)
+            return "the netlist has multi-driven nets";
+    }
+    return NULL;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: partition_netlist)
+ * @brief splits the soft logic between the latches into its connected components,
+ * and balances them (by number of nodes) over at most num_partitions partitions
+ * ---------------------------------------------------------------------------------------------
+ */
+std::vector<partition_t> partition_netlist(const netlist_t* netlist, const std::vector<nnode_t*>& nodes, int num_partitions) {
+    std::vector<nnode_t*> logic_nodes;
+    std::unordered_map<nnode_t*, size_t> logic_index;
+    for (nnode_t* node : nodes) {
+        if (node->type != FF_NODE) {
+            logic_index[node] = logic_nodes.size();
+            logic_nodes.push_back(node);
+        }
+    }
+
+    /* union-find of the nodes connected through soft logic nets */
+    std::vector<size_t> parent(logic_nodes.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](size_t i) {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    for (size_t i = 0; i < logic_nodes.size(); i++) {
+        for (int j = 0; j < logic_nodes[i]->num_input_pins; j++) {
+            auto driver = logic_index.find(driver_node(logic_nodes[i], j));
+            if (driver != logic_index.end())
+                parent[find(i)] = find(driver->second);
+        }
+    }
+
+    std::vector<partition_t> components;
+    std::unordered_map<size_t, size_t> component_of_root;
+    for (size_t i = 0; i < logic_nodes.size(); i++) {
+        auto inserted = component_of_root.insert({find(i), components.size()});
+        if (inserted.second)
+            components.emplace_back();
+        components[inserted.first->second].nodes.push_back(logic_nodes[i]);
+    }
+    for (long i = 0; i < netlist->num_top_output_nodes; i++) {
+        nnode_t* top_output_node = netlist->top_output_nodes[i];
+        if (!top_output_node->input_pins[0]->net->num_driver_pins)
+            continue;
+        auto driver = logic_index.find(driver_node(top_output_node, 0));
+        if (driver != logic_index.end()) {
+            components[component_of_root.at(find(driver->second))].top_outputs.push_back(top_output_node);
+        } else {
+            components.emplace_back();
+            components.back().top_outputs.push_back(top_output_node);
+        }
+    }
+
+    /* largest components first, each to the least loaded partition */
+    std::vector<size_t> order(components.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return components[lhs].size() > components[rhs].size();
+    });
+
+    std::vector<partition_t> partitions(std::max<size_t>(1, std::min<size_t>(num_partitions, components.size())));
+    for (size_t icomponent : order) {
+        partition_t& partition = *std::min_element(partitions.begin(), partitions.end(), [](const partition_t& lhs, const partition_t& rhs) {
+            return lhs.size() < rhs.size();
+        });
+        const partition_t& component = components[icomponent];
+        partition.nodes.insert(partition.nodes.end(), component.nodes.begin(), component.nodes.end());
+        partition.top_outputs.insert(partition.top_outputs.end(), component.top_outputs.begin(), component.top_outputs.end());
+    }
+    return partitions;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (functions: create_const, create_buf and create_logic)
+ * @brief add the nodes of the netlist to the ABC network, creating the nets as needed
+ * ---------------------------------------------------------------------------------------------
+ */
+void create_const(Abc_Ntk_t* ntk, char* name, bool is_const1) {
+    Abc_Obj_t* abc_node = is_const1 ? Abc_NtkCreateNodeConst1(ntk) : Abc_NtkCreateNodeConst0(ntk);
+    Abc_ObjAddFanin(Abc_NtkFindOrCreateNet(ntk, name), abc_node);
+}
+
+void create_buf(Abc_Ntk_t* ntk, char* input_name, char* output_name) {
+    Abc_Obj_t* abc_node = Abc_NtkCreateNodeBuf(ntk, Abc_NtkFindOrCreateNet(ntk, input_name));
+    Abc_ObjAddFanin(Abc_NtkFindOrCreateNet(ntk, output_name), abc_node);
+}
+
+void create_logic(Abc_Ntk_t* ntk, nnode_t* node) {
+    oassert(node->num_output_pins == 1);
+    std::vector<char*> fanins;
+    for (int i = 0; i < node->num_input_pins; i++)
+        fanins.push_back(driver_name(node, i));
+
+    Abc_Obj_t* abc_node = Io_ReadCreateNode(ntk, node->name, fanins.data(), (int)fanins.size());
+    abc_node->pData = Abc_SopRegister((Mem_Flex_t*)ntk->pManFunc, node_cover(node).c_str());
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: build_network)
+ * @brief builds the sequential ABC netlist of the whole netlist, named as by the BLIF writer
+ * ---------------------------------------------------------------------------------------------
+ */
+Abc_Ntk_t* build_network(const netlist_t* netlist, const std::vector<nnode_t*>& nodes) {
+    Abc_Ntk_t* ntk = Abc_NtkAlloc(ABC_NTK_NETLIST, ABC_FUNC_SOP, 1);
+    ntk->pName = Extra_UtilStrsav(netlist->identifier);
+
+    for (long i = 0; i < netlist->num_top_input_nodes; i++)
+        Io_ReadCreatePi(ntk, netlist->top_input_nodes[i]->name);
+
+    for (long i = 0; i < netlist->num_top_output_nodes; i++) {
+        nnode_t* top_output_node = netlist->top_output_nodes[i];
+        if (!top_output_node->input_pins[0]->net->num_driver_pins) {
+            warning_message(NETLIST,
+                            top_output_node->loc,
+                            "This output is undriven (%s) and will be removed\n",
+                            top_output_node->name);
+            continue;
+        }
+        Io_ReadCreatePo(ntk, top_output_node->name);
+        create_buf(ntk, driver_name(top_output_node, 0), top_output_node->name);
+    }
+
+    /* gnd, unconn, and vcc */
+    create_const(ntk, netlist->gnd_node->name, false);
+    create_const(ntk, netlist->pad_node->name, false);
+    create_const(ntk, netlist->vcc_node->name, true);
+
+    for (nnode_t* node : nodes) {
+        if (node->type == FF_NODE) {
+            Abc_Obj_t* latch = Io_ReadCreateLatch(ntk, driver_name(node, 0), node->name);
+            if (node->initial_value == init_value_e::_0)
+                Abc_LatchSetInit0(latch);
+            else if (node->initial_value == init_value_e::_1)
+                Abc_LatchSetInit1(latch);
+            else
+                Abc_LatchSetInitDc(latch);
+        } else {
+            create_logic(ntk, node);
+        }
+    }
+
+    Abc_NtkFinalizeRead(ntk);
+    return ntk;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: build_partition)
+ * @brief builds the combinational ABC netlist of a partition: its inputs are the nets
+ * driven outside of it, and its outputs the latch inputs, the latch clocks and the top
+ * level outputs it drives
+ * ---------------------------------------------------------------------------------------------
+ */
+Abc_Ntk_t* build_partition(const netlist_t* netlist, const partition_t& partition, const std::unordered_set<nnode_t*>& latch_drivers) {
+    Abc_Ntk_t* ntk = Abc_NtkAlloc(ABC_NTK_NETLIST, ABC_FUNC_SOP, 1);
+    ntk->pName = Extra_UtilStrsav(netlist->identifier);
+
+    std::unordered_set<nnode_t*> members(partition.nodes.begin(), partition.nodes.end());
+    std::unordered_set<std::string> sources;
+    auto create_source = [&](nnode_t* node, long pin_idx) {
+        nnode_t* driver = driver_node(node, pin_idx);
+        if (members.count(driver))
+            return;
+        char* name = driver_name(node, pin_idx);
+        if (!sources.insert(name).second)
+            return;
+        if (!driver || driver->type == GND_NODE || driver->type == PAD_NODE)
+            create_const(ntk, name, false);
+        else if (driver->type == VCC_NODE)
+            create_const(ntk, name, true);
+        else
+            Io_ReadCreatePi(ntk, name);
+    };
+
+    for (nnode_t* node : partition.nodes) {
+        for (int i = 0; i < node->num_input_pins; i++)
+            create_source(node, i);
+        create_logic(ntk, node);
+        if (latch_drivers.count(node))
+            Io_ReadCreatePo(ntk, node->name);
+    }
+    for (nnode_t* top_output_node : partition.top_outputs) {
+        create_source(top_output_node, 0);
+        Io_ReadCreatePo(ntk, top_output_node->name);
+        create_buf(ntk, driver_name(top_output_node, 0), top_output_node->name);
+    }
+
+    Abc_NtkFinalizeRead(ntk);
+    return ntk;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: run_script)
+ * @brief runs the ABC script on the network (consumed), in the ABC frame of this process
+ * @return the mapped ABC netlist, or NULL if ABC rejects the network
+ * ---------------------------------------------------------------------------------------------
+ */
+Abc_Ntk_t* run_script(Abc_Ntk_t* ntk, const std::string& script) {
+    if (!Abc_NtkCheckRead(ntk)) {
+        Abc_NtkDelete(ntk);
+        return NULL;
+    }
+    Abc_Ntk_t* logic_ntk = Abc_NtkToLogic(ntk);
+    Abc_NtkDelete(ntk);
+
+    Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+    Abc_FrameReplaceCurrentNetwork(abc_frame, logic_ntk);
+    if (Cmd_CommandExecute(abc_frame, script.c_str()))
+        error_message(NETLIST, unknown_location, "ABC failed to run the script \"%s\"", script.c_str());
+
+    /* as ABC's BLIF writer */
+    Abc_Ntk_t* mapped_ntk = Abc_NtkToNetlist(Abc_FrameReadNtk(abc_frame));
+    if (mapped_ntk == NULL || Abc_NtkHasMapping(mapped_ntk) || Abc_NtkBlackboxNum(mapped_ntk) || Abc_NtkWhiteboxNum(mapped_ntk))
+        error_message(NETLIST, unknown_location, "%s", "The ABC script must end with a LUT mapped (or unmapped) flat network");
+    if (!Abc_NtkHasSop(mapped_ntk))
+        Abc_NtkToSop(mapped_ntk, -1, ABC_INFINITY);
+    return mapped_ntk;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: write_names)
+ * @brief writes the logic of the mapped ABC netlist, prefixing the names of the nets
+ * internal to it (which ABC names independently in each partition) by internal_prefix
+ * ---------------------------------------------------------------------------------------------
+ */
+void write_names(FILE* out, Abc_Ntk_t* ntk, const std::string& internal_prefix) {
+    Abc_Obj_t* obj;
+    int i;
+
+    std::unordered_set<Abc_Obj_t*> io_nets;
+    Abc_NtkForEachPi (ntk, obj, i) {
+        io_nets.insert(Abc_ObjFanout0(obj));
+    }
+    Abc_NtkForEachPo (ntk, obj, i) {
+        io_nets.insert(Abc_ObjFanin0(obj));
+    }
+    auto print_net = [&](Abc_Obj_t* net) {
+        fputc(' ', out);
+        if (!io_nets.count(net))
+            fputs(internal_prefix.c_str(), out);
+        fputs(Abc_ObjName(net), out);
+    };
+
+    Abc_NtkForEachNode (ntk, obj, i) {
+        Abc_Obj_t* fanin;
+        int j;
+        fputs(".names", out);
+        Abc_ObjForEachFanin (obj, fanin, j) {
+            print_net(fanin);
+        }
+        print_net(Abc_ObjFanout0(obj));
+        fprintf(out, "\n%s\n", (char*)Abc_ObjData(obj));
+    }
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: write_mapped_blif)
+ * @brief writes the mapped sequential ABC netlist, with the clock of the latches restored
+ * ---------------------------------------------------------------------------------------------
+ */
+void write_mapped_blif(FILE* out, Abc_Ntk_t* ntk, const clock_domain_t& domain) {
+    Abc_Obj_t* obj;
+    int i;
+
+    fprintf(out, ".model %s\n", Abc_NtkName(ntk));
+
+    fputs(".inputs", out);
+    Abc_NtkForEachPi (ntk, obj, i) {
+        fprintf(out, " %s", Abc_ObjName(Abc_ObjFanout0(obj)));
+    }
+    fputc('\n', out);
+
+    fputs(".outputs", out);
+    Abc_NtkForEachPo (ntk, obj, i) {
+        fprintf(out, " %s", Abc_ObjName(Abc_ObjFanin0(obj)));
+    }
+    fputs("\n\n", out);
+
+    Abc_NtkForEachLatch (ntk, obj, i) {
+        int init = Abc_LatchIsInit0(obj) ? 0 : Abc_LatchIsInit1(obj) ? 1 : 2;
+        fprintf(out, ".latch %s %s %s %s %d\n",
+                Abc_ObjName(Abc_ObjFanin0(Abc_ObjFanin0(obj))),
+                Abc_ObjName(Abc_ObjFanout0(Abc_ObjFanout0(obj))),
+                domain.edge, domain.clock, init);
+    }
+    fputc('\n', out);
+
+    write_names(out, ntk, "");
+
+    fputs(".end\n\n", out);
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: map_whole_netlist)
+ * @brief maps the netlist, with its latches, in a single ABC run
+ * ---------------------------------------------------------------------------------------------
+ */
+bool map_whole_netlist(const netlist_t* netlist, const std::vector<nnode_t*>& nodes, const clock_domain_t& domain, const std::string& script, const char* file_name) {
+    Abc_Start();
+    Abc_Ntk_t* mapped_ntk = run_script(build_network(netlist, nodes), script);
+    if (!mapped_ntk) {
+        Abc_Stop();
+        printf(FALLBACK_MESSAGE, "ABC rejected the netlist");
+        return false;
+    }
+
+    FILE* out = fopen(file_name, "w");
+    if (out == NULL)
+        error_message(NETLIST, unknown_location, "Could not open output file %s\n", file_name);
+    write_mapped_blif(out, mapped_ntk, domain);
+    fclose(out);
+
+    Abc_NtkDelete(mapped_ntk);
+    Abc_Stop();
+    return true;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: map_partitions)
+ * @brief maps the soft logic of each partition in its own ABC run, concurrently, and
+ * stitches the mapped partitions back together with the latches of the netlist
+ *
+ * ABC keeps its state in globals, so each partition is mapped by a child process with
+ * its own ABC frame, which writes the logic of its partition to a part file.
+ * ---------------------------------------------------------------------------------------------
+ */
+bool map_partitions(const netlist_t* netlist, const std::vector<nnode_t*>& nodes, const std::string& script, int num_jobs, const char* file_name) {
+    std::vector<partition_t> partitions = partition_netlist(netlist, nodes, num_jobs);
+
+    std::unordered_set<nnode_t*> latch_drivers;
+    for (nnode_t* node : nodes) {
+        if (node->type == FF_NODE) {
+            latch_drivers.insert(driver_node(node, 0));
+            latch_drivers.insert(driver_node(node, 1));
+        }
+    }
+
+    printf("Mapping the netlist in-process with ABC in %zu partition(s): %s\n", partitions.size(), script.c_str());
+
+    /* map the partitions */
+    enum { MAPPED = 0,
+           REJECTED = 2 };
+    std::vector<std::string> part_file_names;
+    std::vector<pid_t> workers;
+    for (size_t i = 0; i < partitions.size(); i++) {
+        part_file_names.push_back(std::string(file_name) + ".part" + std::to_string(i));
+
+        fflush(stdout);
+        fflush(stderr);
+        pid_t pid = fork();
+        if (pid < 0)
+            error_message(NETLIST, unknown_location, "%s", "Could not start the ABC mapping of a partition");
+        if (pid == 0) {
+            Abc_Start();
+            Abc_Ntk_t* mapped_ntk = run_script(build_partition(netlist, partitions[i], latch_drivers), script);
+            int status = REJECTED;
+            if (mapped_ntk) {
+                FILE* part = fopen(part_file_names[i].c_str(), "w");
+                if (part) {
+                    write_names(part, mapped_ntk, "abc_part" + std::to_string(i) + "^");
+                    status = fclose(part) ? EXIT_FAILURE : MAPPED;
+                } else {
+                    status = EXIT_FAILURE;
+                }
+            }
+            fflush(stdout);
+            _exit(status);
+        }
+        workers.push_back(pid);
+    }
+
+    bool rejected = false;
+    bool failed = false;
+    for (pid_t pid : workers) {
+        int status;
+        if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || (WEXITSTATUS(status) != MAPPED && WEXITSTATUS(status) != REJECTED))
+            failed = true;
+        else if (WEXITSTATUS(status) == REJECTED)
+            rejected = true;
+    }
+    if (failed || rejected) {
+        for (const std::string& part_file_name : part_file_names)
+            remove(part_file_name.c_str());
+        if (failed)
+            error_message(NETLIST, unknown_location, "%s", "ABC failed to map a partition of the netlist");
+        printf(FALLBACK_MESSAGE, "ABC rejected the netlist");
+        return false;
+    }
+
+    /* stitch the partitions back with the latches */
+    FILE* out = fopen(file_name, "w");
+    if (out == NULL)
+        error_message(NETLIST, unknown_location, "Could not open output file %s\n", file_name);
+
+    fprintf(out, ".model %s\n", netlist->identifier);
+    fputs(".inputs", out);
+    for (long i = 0; i < netlist->num_top_input_nodes; i++)
+        fprintf(out, " %s", netlist->top_input_nodes[i]->name);
+    fputc('\n', out);
+    fputs(".outputs", out);
+    for (long i = 0; i < netlist->num_top_output_nodes; i++) {
+        nnode_t* top_output_node = netlist->top_output_nodes[i];
+        if (!top_output_node->input_pins[0]->net->num_driver_pins) {
+            warning_message(NETLIST,
+                            top_output_node->loc,
+                            "This output is undriven (%s) and will be removed\n",
+                            top_output_node->name);
+        } else {
+            fprintf(out, " %s", top_output_node->name);
+        }
+    }
+    fputc('\n', out);
+
+    /* add gnd, unconn, and vcc */
+    fprintf(out, "\n.names %s\n.names %s\n.names %s\n1\n\n", netlist->gnd_node->name, netlist->pad_node->name, netlist->vcc_node->name);
+
+    for (nnode_t* node : nodes) {
+        if (node->type == FF_NODE) {
+            fprintf(out, ".latch %s %s %s %s %d\n",
+                    driver_name(node, 0),
+                    node->name,
+                    edge_type_blif_str(node->attributes->clk_edge_type, node->loc),
+                    driver_name(node, 1),
+                    node->initial_value);
+        }
+    }
+    fputc('\n', out);
+
+    std::vector<char> buffer(1 << 16);
+    for (const std::string& part_file_name : part_file_names) {
+        FILE* part = fopen(part_file_name.c_str(), "r");
+        if (part == NULL)
+            error_message(NETLIST, unknown_location, "Could not open the mapped partition %s\n", part_file_name.c_str());
+        size_t num_read;
+        while ((num_read = fread(buffer.data(), 1, buffer.size(), part)) > 0)
+            fwrite(buffer.data(), 1, num_read, out);
+        fclose(part);
+        remove(part_file_name.c_str());
+    }
+
+    fputs(".end\n\n", out);
+    fclose(out);
+    return true;
+}
+
+} // namespace
+
+bool abc_bridge::is_available() {
+    return true;
+}
+
+bool abc_bridge::map_netlist(netlist_t* netlist, const std::string& script, int num_jobs, const char* file_name) {
+    /* the names of the BLIF writer */
+    if (!coarsen_cleanup) {
+        vtr::free(netlist->gnd_node->name);
+        vtr::free(netlist->vcc_node->name);
+        vtr::free(netlist->pad_node->name);
+        netlist->gnd_node->name = vtr::strdup("gnd");
+        netlist->vcc_node->name = vtr::strdup("vcc");
+        netlist->pad_node->name = vtr::strdup("unconn");
+    }
+
+    std::vector<nnode_t*> nodes;
+    clock_domain_t domain;
+    if (const char* reason = collect_nodes(netlist, nodes, domain)) {
+        printf(FALLBACK_MESSAGE, reason);
+        return false;
+    }
+
+    /* a single clock domain is mapped sequentially (with its latches) unless it is split over several jobs */
+    if (domain.is_single && num_jobs <= 1) {
+        printf("Mapping the netlist in-process with ABC: %s\n", script.c_str());
+        return map_whole_netlist(netlist, nodes, domain, script, file_name);
+    }
+    return map_partitions(netlist, nodes, script, num_jobs, file_name);
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ABC_BRIDGE_H
+#define ABC_BRIDGE_H
+
+#include "odin_types.h" // netlist_t
+
+/**
+ * @brief In-process technology mapping of the netlist with ABC (--abc_script)
+ *
+ * The netlist is converted straight into an ABC network (using the same names and
+ * covers as the BLIF writer), the ABC script is run on it in-process, and the mapped
+ * network is written as the output BLIF. This replaces writing the unmapped BLIF,
+ * reading it back in ABC and restoring the latch clocks of ABC's output afterwards.
+ *
+ * A netlist with a single clock domain is mapped as a whole, latches included. Netlists
+ * with several (or derived) clock domains, or split over several jobs (--abc_jobs), are
+ * cut at their latches instead: the soft logic between the latches is split into its
+ * connected components, which are balanced over the jobs and mapped concurrently (each
+ * by its own ABC process, as ABC keeps its state in globals). The mapped partitions are
+ * then stitched back together with the latches, which keep their own clocks. The script
+ * of a partitioned netlist should therefore only use combinational commands.
+ *
+ * Netlists with hard blocks (which ABC would black box) or multi-driven nets are left
+ * unmapped and must go through the BLIF file.
+ *
+ * Requires Odin-II to be built with ABC (WITH_ABC)
+ */
+namespace abc_bridge {
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: is_available)
+ * @brief whether Odin-II was built with ABC
+ * ---------------------------------------------------------------------------------------------
+ */
+bool is_available();
+
+/**
+ * ---------------------------------------------------------------------------------------------
+ * (function: map_netlist)
+ * @brief maps the netlist with the ABC script and writes the mapped BLIF to file_name
+ *
+ * @param netlist pointer to the netlist
+ * @param script the ABC commands to run (e.g. "strash; dch -f; if -K 6")
+ * @param num_jobs the maximum number of partitions mapped concurrently
+ * @param file_name the output blif file name
+ * @return false (without writing anything) if the netlist cannot be mapped in-process
+ * ---------------------------------------------------------------------------------------------
+ */
+bool map_netlist(netlist_t* netlist, const std::string& script, int num_jobs, const char* file_name);
+
+} // namespace abc_bridge
+
+#endif // ABC_BRIDGE_H
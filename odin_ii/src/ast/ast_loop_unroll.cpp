@@ -49,10 +49,21 @@ ast_node_t* unroll_for_loop(ast_node_t* node, ast_node_t* parent, int* num_unrol
     int this_genblk = 0;
     for (i = 0; i < parent->num_children; i++) {
         if (node == parent->children[i]) {
+            /* splice all the unrolled children in place of the loop at once, instead of
+             * shifting the rest of the parent's children for every iteration */
+            int num_children = parent->num_children - 1 + unrolled_for->num_children;
+            ast_node_t** children = (ast_node_t**)vtr::malloc(sizeof(ast_node_t*) * num_children);
+            memcpy(children, parent->children, sizeof(ast_node_t*) * i);
+            memcpy(children + i, unrolled_for->children, sizeof(ast_node_t*) * unrolled_for->num_children);
+            memcpy(children + i + unrolled_for->num_children, parent->children + i + 1, sizeof(ast_node_t*) * (parent->num_children - i - 1));
+
+            vtr::free(parent->children);
+            parent->children = children;
+            parent->num_children = num_children;
+
             int j;
             for (j = i; j < (unrolled_for->num_children + i); j++) {
-                ast_node_t* child = unrolled_for->children[j - i];
-                add_child_to_node_at_index(parent, child, j);
+                ast_node_t* child = parent->children[j];
                 unrolled_for->children[j - i] = NULL;
 
                 /* create scopes as necessary */
@@ -119,8 +130,8 @@ ast_node_t* unroll_for_loop(ast_node_t* node, ast_node_t* parent, int* num_unrol
                 }
             }
 
-            oassert(j == (unrolled_for->num_children + i) && parent->children[j] == node);
-            remove_child_from_node_at_index(parent, j);
+            oassert(j == (unrolled_for->num_children + i));
+            free_whole_tree(node);
 
             break;
         }
@@ -96,9 +96,12 @@ bool is_valid_identifier(char* str);
  * (function: parse_to_ast)
  *-------------------------------------------------------------------------------------------*/
 void parse_to_ast() {
+    extern void prefetch_files(const std::vector<std::string>& file_names);
     extern void push_include(const char* file_name);
 
-    /* read all the files in the configuration file */
+    /* read all the files in the configuration file (in parallel, the parse itself is serial) */
+    prefetch_files(configuration.list_of_file_names);
+
     my_location.file = configuration.list_of_file_names.size() - 1;
     int parse_counter = my_location.file;
 
@@ -82,6 +82,7 @@ struct hard_block_models {
 extern int line_count;
 extern int num_lines;
 extern bool skip_reading_bit_map;
+extern char* implicit_clock_name;
 extern bool insert_global_clock;
 
 extern FILE* file;
@@ -100,17 +101,20 @@ extern FILE* file;
  * @param size buffer size (in the case of using fgets)
  * @param fd file stream
  * 
+ * The buffer is only allocated on the first call and then reused
+ * for the following lines, the caller frees it once done reading.
+ * 
  * @return null pointer if end of the file, otherwise the read line
  *---------------------------------------------------------------------------------------------*/
 inline char* getbline(char*& buf, size_t size, FILE* fd) {
-    char* retval = NULL;
-    if (buf) {
-        vtr::free(buf);
-        buf = NULL;
-    }
+    if (!buf)
+        buf = (char*)vtr::malloc(READ_BLIF_BUFFER * sizeof(char));
 
-    buf = (char*)vtr::malloc(READ_BLIF_BUFFER * sizeof(char));
-    retval = vtr::fgets(buf, size, fd);
+    char* retval = vtr::fgets(buf, size, fd);
+    if (!retval) {
+        // don't leave the previous line in the buffer at the end of the file
+        buf[0] = '\0';
+    }
 
     return (retval);
 }
@@ -542,12 +546,6 @@ class blif {
          * ---------------------------------------------------------------------------------------------
          */
         void depth_first_traversal_to_output(short marker_value, FILE* fp, const netlist_t* netlist);
-        /**
-         * ---------------------------------------------------------------------------------------------
-         * (function: depth_first_traverse)
-         * ---------------------------------------------------------------------------------------------
-         */
-        void depth_traverse_output_blif(nnode_t* node, uintptr_t traverse_mark_number, FILE* fp);
         /**
          * ---------------------------------------------------------------------------------------------
          * (function: output_node)
@@ -43,6 +43,7 @@
 int line_count;
 int num_lines;
 bool skip_reading_bit_map;
+char* implicit_clock_name; // the clock of the latches without control, found once by search_clock_name
 bool insert_global_clock;
 
 FILE* file;
@@ -65,6 +66,7 @@ blif::reader::reader() {
     blif_netlist = allocate_netlist();
 
     skip_reading_bit_map = false;
+    implicit_clock_name = NULL;
     /*Opening the blif file */
     file = vtr::fopen(configuration.list_of_file_names[my_location.file].c_str(), "r");
     if (file == NULL) {
@@ -74,10 +76,16 @@ blif::reader::reader() {
     num_lines = count_blif_lines();
 
     output_nets_hash = new hash_table();
+    // most nets are driven by a .names of two lines (names and bit map)
+    output_nets_hash->reserve(num_lines / 2);
 }
 
 blif::reader::~reader() {
     delete output_nets_hash;
+    if (implicit_clock_name) {
+        vtr::free(implicit_clock_name);
+        implicit_clock_name = NULL;
+    }
 }
 
 void* blif::reader::_read() {
@@ -1372,10 +1380,14 @@ void blif::reader::create_latch_node_and_driver() {
  * (function: search_clock_name)
  * 
  * @brief to search the clock if the control in the latch
- * is not mentioned
+ * is not mentioned. The file is only searched for the first
+ * such latch, the following ones get a copy of the same name.
  * ---------------------------------------------------------------------------------------------
  */
 char* blif::reader::search_clock_name() {
+    if (implicit_clock_name)
+        return vtr::strdup(implicit_clock_name);
+
     fpos_t pos;
     int last_line = my_location.line;
     fgetpos(file, &pos);
@@ -1439,6 +1451,7 @@ char* blif::reader::search_clock_name() {
 
     vtr::free(input_names);
 
+    implicit_clock_name = vtr::strdup(to_return);
     return to_return;
 }
 
@@ -34,10 +34,20 @@
 #include "hard_blocks.h"
 #include "adders.h"
 #include "blif.h"
+#include "netlist_traversal.h"
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
 
+/**
+ * @brief prints a space separated name. The names make up most of the
+ * output, so they are copied to the (buffered) file without formatting
+ */
+static inline void print_name(FILE* out, const char* name) {
+    fputc(' ', out);
+    fputs(name, out);
+}
+
 blif::writer::writer()
     : generic_writer() {
 }
@@ -57,6 +67,7 @@ inline void blif::writer::_create_file(const char* file_name, const file_type_e
                       "blif back-end entity cannot create file types(%d) other than blif", file_type);
     // create the blif file and set it as the output file
     this->output_file = create_blif(file_name);
+    this->set_output_file_buffer();
 }
 /**
  * ---------------------------------------------------------------------------------------------
@@ -122,7 +133,7 @@ void blif::writer::print_net_driver(FILE* out, nnode_t* node, nnet_t* net, long
                         "Net %s driving node %s is itself undriven.",
                         net->name, node->name);
 
-        fprintf(out, " %s", "unconn");
+        print_name(out, "unconn");
     } else if (global_args.high_level_block.provenance() == argparse::Provenance::SPECIFIED
                && driver->node->related_ast_node != NULL) {
         fprintf(out, " %s^^%i-%i",
@@ -131,9 +142,9 @@ void blif::writer::print_net_driver(FILE* out, nnode_t* node, nnet_t* net, long
                 driver->node->related_ast_node->high_number);
     } else {
         if (driver->name != NULL && ((driver->node->type == MULTIPLY) || (driver->node->type == HARD_IP) || (driver->node->type == MEMORY) || (driver->node->type == ADD) || (driver->node->type == MINUS))) {
-            fprintf(out, " %s", driver->name);
+            print_name(out, driver->name);
         } else {
-            fprintf(out, " %s", driver->node->name);
+            print_name(out, driver->node->name);
         }
     }
 }
@@ -152,7 +163,7 @@ void blif::writer::print_input_single_driver(FILE* out, nnode_t* node, long pin_
     oassert(pin_idx < node->num_input_pins);
     nnet_t* net = node->input_pins[pin_idx]->net;
     if (warn_undriven(node, net)) {
-        fprintf(out, " unconn");
+        fputs(" unconn", out);
     } else {
         oassert(net->num_driver_pins == 1);
         print_net_driver(out, node, net, 0);
@@ -177,7 +188,7 @@ void blif::writer::print_output_pin(FILE* out, nnode_t* node) {
                 node->related_ast_node->far_tag,
                 node->related_ast_node->high_number);
     else
-        fprintf(out, " %s", node->name);
+        print_name(out, node->name);
 }
 /**
  * ---------------------------------------------------------------------------------------------
@@ -199,7 +210,7 @@ void blif::writer::print_dot_names_header(FILE* out, nnode_t* node) {
             names[i] = op_node_name(BUF_NODE, node->name);
             // Assign each driver to the implicit buffer
             for (int j = 0; j < input_net->num_driver_pins; j++) {
-                fprintf(out, ".names");
+                fputs(".names", out);
                 print_net_driver(out, node, input_net, j);
                 fprintf(out, " %s\n1 1\n\n", names[i]);
             }
@@ -207,11 +218,11 @@ void blif::writer::print_dot_names_header(FILE* out, nnode_t* node) {
     }
 
     // Print the actual header
-    fprintf(out, ".names");
+    fputs(".names", out);
     for (int i = 0; i < node->num_input_pins; i++) {
         if (names[i]) {
             // Use the implicit buffer we created before
-            fprintf(out, " %s", names[i]);
+            print_name(out, names[i]);
             vtr::free(names[i]);
         } else {
             // Directly use the driver
@@ -222,7 +233,7 @@ void blif::writer::print_dot_names_header(FILE* out, nnode_t* node) {
 
     oassert(node->num_output_pins == 1);
     print_output_pin(out, node);
-    fprintf(out, "\n");
+    fputc('\n', out);
 }
 /**
  * ---------------------------------------------------------------------------------------------
@@ -266,14 +277,14 @@ void blif::writer::output_blif(FILE* out, const netlist_t* netlist) {
 
     /* generate all the signals */
 
-    fprintf(out, ".inputs");
+    fputs(".inputs", out);
     for (long i = 0; i < netlist->num_top_input_nodes; i++) {
         nnode_t* top_input_node = netlist->top_input_nodes[i];
         print_output_pin(out, top_input_node);
     }
-    fprintf(out, "\n");
+    fputc('\n', out);
 
-    fprintf(out, ".outputs");
+    fputs(".outputs", out);
     for (long i = 0; i < netlist->num_top_output_nodes; i++) {
         nnode_t* top_output_node = netlist->top_output_nodes[i];
         if (!top_output_node->input_pins[0]->net->num_driver_pins) {
@@ -285,11 +296,11 @@ void blif::writer::output_blif(FILE* out, const netlist_t* netlist) {
             print_output_pin(out, top_output_node);
         }
     }
-    fprintf(out, "\n");
+    fputc('\n', out);
 
     /* add gnd, unconn, and vcc */
-    fprintf(out, "\n.names gnd\n.names unconn\n.names vcc\n1\n");
-    fprintf(out, "\n");
+    fputs("\n.names gnd\n.names unconn\n.names vcc\n1\n", out);
+    fputc('\n', out);
 
     // TODO Uncomment this for In Outs
     // connect all the outputs up to the last gate
@@ -316,19 +327,19 @@ void blif::writer::output_blif(FILE* out, const netlist_t* netlist) {
             nnet_t* net = node->input_pins[0]->net;
             warn_undriven(node, net);
             for (int j = 0; j < net->num_driver_pins; j++) {
-                fprintf(out, ".names");
+                fputs(".names", out);
                 print_net_driver(out, node, net, j);
                 print_output_pin(out, node);
-                fprintf(out, "\n");
+                fputc('\n', out);
 
-                fprintf(out, "1 1\n\n");
+                fputs("1 1\n\n", out);
             }
         }
     }
 
     /* finish off the top level module */
-    fprintf(out, ".end\n");
-    fprintf(out, "\n");
+    fputs(".end\n", out);
+    fputc('\n', out);
 
     /* Print out any hard block modules */
     add_the_blackbox_for_mults(out);
@@ -350,8 +361,6 @@ void blif::writer::output_blif(FILE* out, const netlist_t* netlist) {
  * ---------------------------------------------------------------------------------------------
  */
 void blif::writer::depth_first_traversal_to_output(short marker_value, FILE* fp, const netlist_t* netlist) {
-    int i;
-
     /* if a coarsen blif is recieved, these variables are already created */
     if (!coarsen_cleanup) {
         netlist->gnd_node->name = vtr::strdup("gnd");
@@ -359,63 +368,9 @@ void blif::writer::depth_first_traversal_to_output(short marker_value, FILE* fp,
         netlist->pad_node->name = vtr::strdup("unconn");
     }
 
-    /* now traverse the ground, vcc, and unconn pins */
-    depth_traverse_output_blif(netlist->gnd_node, marker_value, fp);
-    depth_traverse_output_blif(netlist->vcc_node, marker_value, fp);
-    depth_traverse_output_blif(netlist->pad_node, marker_value, fp);
-
-    /* start with the primary input list */
-    for (i = 0; i < netlist->num_top_input_nodes; i++) {
-        if (netlist->top_input_nodes[i] != NULL) {
-            depth_traverse_output_blif(netlist->top_input_nodes[i], marker_value, fp);
-        }
-    }
-}
-
-/**
- * ---------------------------------------------------------------------------------------------
- * (function: depth_first_traverse)
- *
- * @brief traverse the netlist to output the blif file
- *
- * @param node pointer to the netlist node
- * @param traverse_mark_number unique traversal mark for output blif pass
- * @param fp the output blif file
- * ---------------------------------------------------------------------------------------------
- */
-void blif::writer::depth_traverse_output_blif(nnode_t* node, uintptr_t traverse_mark_number, FILE* fp) {
-    int i, j;
-    nnode_t* next_node;
-    nnet_t* next_net;
-
-    if (node->traverse_visited == traverse_mark_number) {
-        return;
-    } else {
-        /* ELSE - this is a new node so depth visit it */
-
-        /* POST traverse  map the node since you might delete */
-        output_node(node, traverse_mark_number, fp);
-
-        /* mark that we have visitied this node now */
-        node->traverse_visited = traverse_mark_number;
-
-        for (i = 0; i < node->num_output_pins; i++) {
-            if (node->output_pins[i]->net == NULL)
-                continue;
-
-            next_net = node->output_pins[i]->net;
-            for (j = 0; j < next_net->num_fanout_pins; j++) {
-                if (next_net->fanout_pins[j] == NULL)
-                    continue;
-
-                next_node = next_net->fanout_pins[j]->node;
-                if (next_node == NULL)
-                    continue;
-
-                /* recursive call point */
-                depth_traverse_output_blif(next_node, traverse_mark_number, fp);
-            }
-        }
+    /* the ground, vcc, and unconn pins first, then the primary inputs (shared with the other read-only passes) */
+    for (nnode_t* node : get_netlist_traversal_order(netlist)) {
+        output_node(node, marker_value, fp);
     }
 }
 /**
@@ -552,9 +507,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
         case LOGICAL_AND: {
             /* generates: 111111 1 */
             for (i = 0; i < node->num_input_pins; i++) {
-                fprintf(out, "1");
+                fputc('1', out);
             }
-            fprintf(out, " 1\n");
+            fputs(" 1\n", out);
             break;
         }
         case LOGICAL_OR: {
@@ -562,11 +517,11 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < node->num_input_pins; i++) {
                 for (j = 0; j < node->num_input_pins; j++) {
                     if (i == j)
-                        fprintf(out, "1");
+                        fputc('1', out);
                     else
-                        fprintf(out, "-");
+                        fputc('-', out);
                 }
-                fprintf(out, " 1\n");
+                fputs(" 1\n", out);
             }
             break;
         }
@@ -575,11 +530,11 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < node->num_input_pins; i++) {
                 for (j = 0; j < node->num_input_pins; j++) {
                     if (i == j)
-                        fprintf(out, "0");
+                        fputc('0', out);
                     else
-                        fprintf(out, "-");
+                        fputc('-', out);
                 }
-                fprintf(out, " 1\n");
+                fputs(" 1\n", out);
             }
             break;
         }
@@ -587,9 +542,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
         case LOGICAL_NOR: {
             /* generates: 0000000 1 */
             for (i = 0; i < node->num_input_pins; i++) {
-                fprintf(out, "0");
+                fputc('0', out);
             }
-            fprintf(out, " 1\n");
+            fputs(" 1\n", out);
             break;
         }
         case LOGICAL_EQUAL:
@@ -599,9 +554,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < my_power(2, node->num_input_pins); i++) {
                 if ((i % 8 == 1) || (i % 8 == 2) || (i % 8 == 4) || (i % 8 == 7)) {
                     temp_string = convert_long_to_bit_string(i, node->num_input_pins);
-                    fprintf(out, "%s", temp_string);
+                    fputs(temp_string, out);
                     vtr::free(temp_string);
-                    fprintf(out, " 1\n");
+                    fputs(" 1\n", out);
                 }
             }
             break;
@@ -612,9 +567,9 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             for (i = 0; i < my_power(2, node->num_input_pins); i++) {
                 if ((i % 8 == 0) || (i % 8 == 3) || (i % 8 == 5) || (i % 8 == 6)) {
                     temp_string = convert_long_to_bit_string(i, node->num_input_pins);
-                    fprintf(out, "%s", temp_string);
+                    fputs(temp_string, out);
                     vtr::free(temp_string);
-                    fprintf(out, " 1\n");
+                    fputs(" 1\n", out);
                 }
             }
             break;
@@ -624,7 +579,7 @@ void blif::writer::define_logical_function(nnode_t* node, FILE* out) {
             break;
     }
 
-    fprintf(out, "\n");
+    fputc('\n', out);
 }
 
 /** 
@@ -645,9 +600,9 @@ void blif::writer::define_set_input_logical_function(nnode_t* node, const char*
 
     /* print out the blif definition of this gate */
     if (bit_output != NULL) {
-        fprintf(out, "%s", bit_output);
+        fputs(bit_output, out);
     }
-    fprintf(out, "\n");
+    fputc('\n', out);
 }
 
 /** 
@@ -667,9 +622,9 @@ void blif::writer::define_clock(nnode_t* node, FILE* out) {
         print_dot_names_header(out, node);
 
         /* print out the blif definition of this gate */
-        fprintf(out, "%s", "1 1");
+        fputs("1 1", out);
 
-        fprintf(out, "\n");
+        fputc('\n', out);
     }
 }
 
@@ -694,7 +649,7 @@ void blif::writer::define_ff(nnode_t* node, FILE* out) {
     std::string output;
     std::string clock_driver;
 
-    fprintf(out, ".latch");
+    fputs(".latch", out);
 
     /* input */
     print_input_single_driver(out, node, 0);
@@ -703,7 +658,7 @@ void blif::writer::define_ff(nnode_t* node, FILE* out) {
     print_output_pin(out, node);
 
     /* sensitivity */
-    fprintf(out, " %s", clk_edge_type_str);
+    print_name(out, clk_edge_type_str);
 
     /* clock */
     print_input_single_driver(out, node, 1);
@@ -730,16 +685,16 @@ void blif::writer::define_decoded_mux(nnode_t* node, FILE* out) {
     for (long i = 0; i < node->input_port_sizes[0]; i++) {
         for (long j = 0; j < node->num_input_pins; j++) {
             if (i == j)
-                fprintf(out, "1");
+                fputc('1', out);
             else if (i + node->input_port_sizes[0] == j)
-                fprintf(out, "1");
+                fputc('1', out);
             else if (i > node->input_port_sizes[0])
-                fprintf(out, "0");
+                fputc('0', out);
             else
-                fprintf(out, "-");
+                fputc('-', out);
         }
-        fprintf(out, " 1\n");
+        fputs(" 1\n", out);
     }
 
-    fprintf(out, "\n");
+    fputc('\n', out);
 }
@@ -31,6 +31,7 @@
 #include "node_creation_library.h"
 #include "adders.h"
 #include "netlist_utils.h"
+#include "netlist_traversal.h"
 #include "read_xml_arch_file.h"
 #include "odin_globals.h"
 #include "multipliers.h"
@@ -1103,6 +1104,7 @@ void remove_fanout_pins(nnode_t* node) {
         }
         node->input_pins[i]->net->fanout_pins[k] = NULL;
         node->input_pins[i]->net->num_fanout_pins--;
+        mark_netlist_modified();
     }
 }
 
@@ -52,6 +52,7 @@
 #include "hard_soft_logic_mixer.h"
 #include "generic_reader.h"
 #include "blif.h"
+#include "abc_bridge.h"
 
 #include "vtr_error.h"
 #include "vtr_util.h"
@@ -179,17 +180,31 @@ static void techmap() {
 }
 
 static void output() {
+    /* map the netlist in-process with ABC, falling back to the unmapped output if it cannot */
+    bool abc_mapped = false;
+    if (syn_netlist && global_args.abc_script.provenance() == argparse::Provenance::SPECIFIED) {
+        if (!abc_bridge::is_available())
+            error_message(UTIL, unknown_location, "%s", "--abc_script requires Odin-II to be built with ABC");
+        if (configuration.output_file_type != file_type_e::BLIF || global_args.high_level_block.provenance() == argparse::Provenance::SPECIFIED)
+            error_message(UTIL, unknown_location, "%s", "--abc_script only supports plain BLIF outputs");
+
+        abc_mapped = abc_bridge::map_netlist(syn_netlist, global_args.abc_script, global_args.abc_jobs, global_args.output_file.value().c_str());
+    }
+
     /* creating the output file */
-    writer._create_file(global_args.output_file.value().c_str(), configuration.output_file_type);
+    if (!abc_mapped)
+        writer._create_file(global_args.output_file.value().c_str(), configuration.output_file_type);
 
     if (syn_netlist) {
         /**
          * point for outputs.  This includes soft and hard mapping all structures to the
          * target format.  Some of these could be considred optimizations
          */
-        printf("Outputting the netlist to the specified output format\n");
+        if (!abc_mapped) {
+            printf("Outputting the netlist to the specified output format\n");
 
-        writer._write(syn_netlist);
+            writer._write(syn_netlist);
+        }
 
         module_names_to_idx = sc_free_string_cache(module_names_to_idx);
 
@@ -476,6 +491,21 @@ void get_options(int argc, char** argv) {
         .default_value("default_out.blif")
         .metavar("OUTPUT_FILE_PATH");
 
+    output_grp.add_argument(global_args.abc_script, "--abc_script")
+        .help(
+            "Technology map the netlist in-process with these ABC commands (e.g. 'strash; dch -f; if -K 6')"
+            " and output the mapped netlist, with the latch clocks restored."
+            " Netlists with hard blocks are output unmapped")
+        .metavar("ABC_SCRIPT");
+
+    output_grp.add_argument(global_args.abc_jobs, "--abc_jobs")
+        .help(
+            "Maximum number of partitions of the netlist mapped concurrently by --abc_script."
+            " Netlists split over several jobs (or with several clock domains) are cut at their latches,"
+            " and their soft logic is mapped combinationally")
+        .default_value("1")
+        .metavar("NUM_JOBS");
+
     auto& other_grp = parser.add_argument_group("other options");
 
     other_grp.add_argument(global_args.show_help, "-h")
@@ -579,6 +609,11 @@ void get_options(int argc, char** argv) {
         .action(argparse::Action::STORE_TRUE)
         .metavar("BATCH FLAG");
 
+    other_sim_grp.add_argument(global_args.sim_event_driven, "--event_driven")
+        .help("Only re-evaluate the combinational nodes driven by a node whose output changed in the simulated cycle")
+        .default_value("false")
+        .action(argparse::Action::STORE_TRUE);
+
     other_sim_grp.add_argument(global_args.sim_directory, "--sim_dir")
         .help("Directory output for simulation")
         .default_value(DEFAULT_OUTPUT)
@@ -45,6 +45,13 @@ generic_writer::~generic_writer() {
         delete this->verilog_writer;
 }
 
+void generic_writer::set_output_file_buffer() {
+    if (this->output_file) {
+        this->output_file_buffer.resize(OUTPUT_FILE_BUFFER_SIZE);
+        setvbuf(this->output_file, this->output_file_buffer.data(), _IOFBF, this->output_file_buffer.size());
+    }
+}
+
 inline void generic_writer::_write(const netlist_t* netlist) {
     switch (configuration.output_file_type) {
         case (file_type_e::BLIF): {
@@ -26,8 +26,13 @@
 #ifndef __GENERIC_WRITER_H__
 #define __GENERIC_WRITER_H__
 
+#include <vector>
+
 #include "generic_io.h"
 
+/* size of the stdio buffer of the output files (4 MiB) */
+#define OUTPUT_FILE_BUFFER_SIZE (4 * 1024 * 1024)
+
 /**
  * @brief A class to provide the general object of an input file writer
  */
@@ -65,6 +70,17 @@ class generic_writer : public generic_io {
   protected:
     FILE* output_file;
 
+    /**
+     * @brief Replaces the default stdio buffer of the output file by a
+     * large one, so that the many small writes of the netlist writers are
+     * sent to the file system in a few large blocks
+     */
+    void set_output_file_buffer();
+
+  private:
+    /* the stdio buffer of output_file. It is only released once the file is closed */
+    std::vector<char> output_file_buffer;
+
   private:
     generic_writer* blif_writer;
     generic_writer* verilog_writer;
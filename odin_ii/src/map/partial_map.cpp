@@ -25,6 +25,7 @@
 
 #include <cstring>
 #include <cstdio>
+#include <vector>
 
 #include "odin_types.h"
 #include "odin_globals.h"
@@ -93,36 +94,57 @@ void depth_first_traversal_to_partial_map(short marker_value, netlist_t* netlist
     depth_first_traverse_partial_map(netlist->pad_node, marker_value, netlist);
 }
 
+/* a node being visited by depth_first_traverse_partial_map, and how far its fanouts are visited */
+struct partial_map_frame_t {
+    nnode_t* node;
+    int output_pin;
+    int fanout_pin;
+};
+
 /*---------------------------------------------------------------------------------------------
  * (function: depth_first_traverse)
+ * 	Maps the nodes reachable from node in post order (fanouts first). Uses an explicit
+ * 	stack rather than recursion, since long carry chains and wide datapaths make the
+ * 	netlist far deeper than the call stack allows.
  *-------------------------------------------------------------------------------------------*/
 void depth_first_traverse_partial_map(nnode_t* node, uintptr_t traverse_mark_number, netlist_t* netlist) {
-    int i, j;
-
-    if (node->traverse_visited != traverse_mark_number) {
-        /*this is a new node so depth visit it */
-
-        /* mark that we have visitied this node now */
-        node->traverse_visited = traverse_mark_number;
-
-        for (i = 0; i < node->num_output_pins; i++) {
-            if (node->output_pins[i]->net) {
-                nnet_t* next_net = node->output_pins[i]->net;
-                if (next_net->fanout_pins) {
-                    for (j = 0; j < next_net->num_fanout_pins; j++) {
-                        if (next_net->fanout_pins[j]) {
-                            if (next_net->fanout_pins[j]->node) {
-                                /* recursive call point */
-                                depth_first_traverse_partial_map(next_net->fanout_pins[j]->node, traverse_mark_number, netlist);
-                            }
-                        }
-                    }
-                }
+    if (node->traverse_visited == traverse_mark_number)
+        return;
+
+    std::vector<partial_map_frame_t> stack;
+
+    /* mark that we have visitied this node now */
+    node->traverse_visited = traverse_mark_number;
+    stack.push_back({node, 0, 0});
+
+    while (!stack.empty()) {
+        partial_map_frame_t& frame = stack.back();
+        nnode_t* current = frame.node;
+        nnode_t* next_node = NULL;
+
+        /* the pins and nets are looked up again on every step, since mapping a fanout may change them */
+        while (!next_node && frame.output_pin < current->num_output_pins) {
+            nnet_t* next_net = current->output_pins[frame.output_pin]->net;
+            if (next_net && next_net->fanout_pins && frame.fanout_pin < next_net->num_fanout_pins) {
+                npin_t* fanout_pin = next_net->fanout_pins[frame.fanout_pin++];
+                if (fanout_pin && fanout_pin->node && fanout_pin->node->traverse_visited != traverse_mark_number)
+                    next_node = fanout_pin->node;
+            } else {
+                frame.output_pin++;
+                frame.fanout_pin = 0;
             }
         }
 
-        /* POST traverse  map the node since you might delete */
-        partial_map_node(node, traverse_mark_number, netlist);
+        if (next_node) {
+            /* this is a new node so depth visit it */
+            next_node->traverse_visited = traverse_mark_number;
+            stack.push_back({next_node, 0, 0});
+        } else {
+            stack.pop_back();
+
+            /* POST traverse  map the node since you might delete */
+            partial_map_node(current, traverse_mark_number, netlist);
+        }
     }
 }
 
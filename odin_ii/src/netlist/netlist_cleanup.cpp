@@ -28,6 +28,7 @@
 
 #include "odin_types.h"
 #include "odin_globals.h"
+#include "netlist_traversal.h"
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
@@ -181,8 +182,10 @@ void remove_unused_nodes(node_list_t* remove) {
         for (i = 0; i < remove->node->num_input_pins; i++) {
             npin_t* input_pin = remove->node->input_pins[i];
             /* Remove the fanout pin from the net */
-            if (input_pin)
+            if (input_pin) {
                 input_pin->net->fanout_pins[input_pin->pin_net_idx] = NULL;
+                mark_netlist_modified();
+            }
         }
         remove->node->node_data = VISITED_REMOVAL;
         remove = remove->next;
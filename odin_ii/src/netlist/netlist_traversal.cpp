@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "netlist_traversal.h"
+
+unsigned long long netlist_version = 0;
+
+/* cached traversal order of a netlist, and the netlist version it was computed for */
+struct traversal_order_t {
+    unsigned long long version;
+    std::vector<nnode_t*> nodes;
+};
+
+static std::unordered_map<const netlist_t*, traversal_order_t> traversal_orders;
+
+/* a node being visited, and how far its fanouts are visited */
+struct traversal_frame_t {
+    nnode_t* node;
+    int output_pin;
+    int fanout_pin;
+};
+
+/*---------------------------------------------------------------------------------------------
+ * (function: depth_first_traversal_order)
+ * 	Appends the nodes reachable from node, which are not visited yet, in pre-order. Uses an
+ * 	explicit stack rather than recursion, since long carry chains and wide datapaths make the
+ * 	netlist far deeper than the call stack allows.
+ *-------------------------------------------------------------------------------------------*/
+static void depth_first_traversal_order(nnode_t* node, std::unordered_set<nnode_t*>& visited, std::vector<nnode_t*>& order) {
+    if (!visited.insert(node).second)
+        return;
+
+    std::vector<traversal_frame_t> stack;
+    order.push_back(node);
+    stack.push_back({node, 0, 0});
+
+    while (!stack.empty()) {
+        traversal_frame_t& frame = stack.back();
+        nnode_t* current = frame.node;
+        nnode_t* next_node = NULL;
+
+        while (!next_node && frame.output_pin < current->num_output_pins) {
+            nnet_t* next_net = current->output_pins[frame.output_pin]->net;
+            if (next_net && frame.fanout_pin < next_net->num_fanout_pins) {
+                npin_t* fanout_pin = next_net->fanout_pins[frame.fanout_pin++];
+                if (fanout_pin && fanout_pin->node && visited.insert(fanout_pin->node).second)
+                    next_node = fanout_pin->node;
+            } else {
+                frame.output_pin++;
+                frame.fanout_pin = 0;
+            }
+        }
+
+        if (next_node) {
+            order.push_back(next_node);
+            stack.push_back({next_node, 0, 0});
+        } else {
+            stack.pop_back();
+        }
+    }
+}
+
+const std::vector<nnode_t*>& get_netlist_traversal_order(const netlist_t* netlist) {
+    auto it = traversal_orders.find(netlist);
+    if (it != traversal_orders.end() && it->second.version == netlist_version)
+        return it->second.nodes;
+
+    traversal_order_t& traversal = traversal_orders[netlist];
+    traversal.version = netlist_version;
+    traversal.nodes.clear();
+
+    std::unordered_set<nnode_t*> visited;
+    visited.reserve(netlist->num_internal_nodes + netlist->num_top_input_nodes + netlist->num_top_output_nodes + netlist->num_ff_nodes + 3);
+
+    /* the constant nodes first, then the primary inputs */
+    depth_first_traversal_order(netlist->gnd_node, visited, traversal.nodes);
+    depth_first_traversal_order(netlist->vcc_node, visited, traversal.nodes);
+    depth_first_traversal_order(netlist->pad_node, visited, traversal.nodes);
+    for (int i = 0; i < netlist->num_top_input_nodes; i++) {
+        if (netlist->top_input_nodes[i] != NULL)
+            depth_first_traversal_order(netlist->top_input_nodes[i], visited, traversal.nodes);
+    }
+
+    return traversal.nodes;
+}
+
+void free_netlist_traversal_order(const netlist_t* netlist) {
+    traversal_orders.erase(netlist);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023 CAS—Atlantic (University of New Brunswick, CASA)
+ * 
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef NETLIST_TRAVERSAL_H
+#define NETLIST_TRAVERSAL_H
+
+#include <vector>
+
+#include "odin_types.h"
+
+/**
+ * Version of the netlists, incremented by every structural change made through the
+ * netlist_utils primitives (which the node_creation_library builds on). Cached
+ * traversals of a netlist are only re-used while the version is unchanged.
+ */
+extern unsigned long long netlist_version;
+
+inline void mark_netlist_modified() {
+    netlist_version++;
+}
+
+/**
+ * @brief returns the nodes reachable from the constant nodes (gnd, vcc, pad) and the
+ * primary inputs of the netlist through their fanouts, in depth first pre-order
+ * (i.e. the order in which the BLIF writer outputs them).
+ *
+ * The order is computed once and cached until the netlist is modified, so read-only
+ * passes (e.g. the BLIF writer and the ABC bridge) share it instead of re-traversing
+ * the netlist. It does not use the traverse_visited marks of the nodes.
+ *
+ * @param netlist pointer to the netlist
+ * @return the traversal order (valid until the netlist is modified or freed)
+ */
+const std::vector<nnode_t*>& get_netlist_traversal_order(const netlist_t* netlist);
+
+/**
+ * @brief drops the cached traversal of the netlist (when it is freed)
+ */
+void free_netlist_traversal_order(const netlist_t* netlist);
+
+#endif // NETLIST_TRAVERSAL_H
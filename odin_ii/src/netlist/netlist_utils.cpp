@@ -29,15 +29,22 @@
 #include "odin_types.h"
 #include "odin_globals.h"
 #include "netlist_utils.h"
+#include "netlist_traversal.h"
 #include "odin_util.h"
 
 #include "vtr_util.h"
 #include "vtr_memory.h"
 
+/* pins and nets are by far the most numerous netlist structures, so they come from pools */
+static struct_pool_t* npin_pool();
+static struct_pool_t* nnet_pool();
+static npin_t* free_npin_struct(npin_t* to_free);
+
 /*---------------------------------------------------------------------------------------------
  * (function: allocate_nnode)
  *-------------------------------------------------------------------------------------------*/
 nnode_t* allocate_nnode(loc_t loc) {
+    mark_netlist_modified();
     nnode_t* new_node = (nnode_t*)my_malloc_struct(sizeof(nnode_t));
 
     new_node->loc = loc;
@@ -74,6 +81,8 @@ nnode_t* allocate_nnode(loc_t loc) {
     new_node->bit_map = NULL;
     new_node->bit_map_line_count = 0;
 
+    new_node->generic_cover = NULL;
+
     new_node->in_queue = false;
 
     new_node->undriven_pins = 0;
@@ -94,6 +103,7 @@ nnode_t* allocate_nnode(loc_t loc) {
  * (function: free_nnode)
  *-------------------------------------------------------------------------------------------*/
 nnode_t* free_nnode(nnode_t* to_free) {
+    mark_netlist_modified();
     if (to_free) {
         /* need to free node_data */
 
@@ -102,7 +112,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
                 vtr::free(to_free->input_pins[i]->name);
                 to_free->input_pins[i]->name = NULL;
             }
-            to_free->input_pins[i] = (npin_t*)vtr::free(to_free->input_pins[i]);
+            to_free->input_pins[i] = free_npin_struct(to_free->input_pins[i]);
         }
 
         to_free->input_pins = (npin_t**)vtr::free(to_free->input_pins);
@@ -112,7 +122,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
                 vtr::free(to_free->output_pins[i]->name);
                 to_free->output_pins[i]->name = NULL;
             }
-            to_free->output_pins[i] = (npin_t*)vtr::free(to_free->output_pins[i]);
+            to_free->output_pins[i] = free_npin_struct(to_free->output_pins[i]);
         }
 
         to_free->output_pins = (npin_t**)vtr::free(to_free->output_pins);
@@ -120,6 +130,7 @@ nnode_t* free_nnode(nnode_t* to_free) {
         vtr::free(to_free->input_port_sizes);
         vtr::free(to_free->output_port_sizes);
         vtr::free(to_free->undriven_pins);
+        vtr::free(to_free->generic_cover);
 
         free_attribute(to_free->attributes);
 
@@ -189,13 +200,48 @@ void add_input_port_information(nnode_t* node, int port_width) {
     node->num_input_port_sizes++;
 }
 
+/*---------------------------------------------------------------------------------------------
+ * (function: npin_pool)
+ *-------------------------------------------------------------------------------------------*/
+static struct_pool_t* npin_pool() {
+    static struct_pool_t* pool = NULL;
+    if (!pool) {
+        pool = new struct_pool_t;
+        init_struct_pool(pool, sizeof(npin_t));
+    }
+    return pool;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: nnet_pool)
+ *-------------------------------------------------------------------------------------------*/
+static struct_pool_t* nnet_pool() {
+    static struct_pool_t* pool = NULL;
+    if (!pool) {
+        pool = new struct_pool_t;
+        init_struct_pool(pool, sizeof(nnet_t));
+    }
+    return pool;
+}
+
+/*---------------------------------------------------------------------------------------------
+ * (function: free_npin_struct)
+ * 	Drops the simulation values of the pin and gives it back to the pool
+ *-------------------------------------------------------------------------------------------*/
+static npin_t* free_npin_struct(npin_t* to_free) {
+    if (to_free)
+        to_free->values.reset();
+
+    return (npin_t*)my_free_struct_to_pool(npin_pool(), to_free);
+}
+
 /*---------------------------------------------------------------------------------------------
  * (function: allocate_npin)
  *-------------------------------------------------------------------------------------------*/
 npin_t* allocate_npin() {
     npin_t* new_pin;
 
-    new_pin = (npin_t*)my_malloc_struct(sizeof(npin_t));
+    new_pin = (npin_t*)my_malloc_struct_from_pool(npin_pool());
 
     new_pin->name = NULL;
     new_pin->type = NO_ID;
@@ -219,6 +265,7 @@ npin_t* allocate_npin() {
  * (function: free_npin)
  *-------------------------------------------------------------------------------------------*/
 npin_t* free_npin(npin_t* to_free) {
+    mark_netlist_modified();
     if (to_free) {
         if (to_free->name)
             vtr::free(to_free->name);
@@ -232,7 +279,7 @@ npin_t* free_npin(npin_t* to_free) {
 
         /* now free the pin */
     }
-    return (npin_t*)vtr::free(to_free);
+    return free_npin_struct(to_free);
 }
 
 /*-------------------------------------------------------------------------
@@ -282,7 +329,8 @@ npin_t* copy_input_npin(npin_t* copy_pin) {
  * (function: allocate_nnet)
  *-------------------------------------------------------------------------------------------*/
 nnet_t* allocate_nnet() {
-    nnet_t* new_net = (nnet_t*)my_malloc_struct(sizeof(nnet_t));
+    mark_netlist_modified();
+    nnet_t* new_net = (nnet_t*)my_malloc_struct_from_pool(nnet_pool());
 
     new_net->name = NULL;
     new_net->driver_pins = NULL;
@@ -303,6 +351,7 @@ nnet_t* allocate_nnet() {
  * (function: free_nnet)
  *-------------------------------------------------------------------------------------------*/
 nnet_t* free_nnet(nnet_t* to_free) {
+    mark_netlist_modified();
     if (to_free) {
         to_free->fanout_pins = (npin_t**)vtr::free(to_free->fanout_pins);
 
@@ -312,15 +361,18 @@ nnet_t* free_nnet(nnet_t* to_free) {
         if (to_free->num_driver_pins)
             vtr::free(to_free->driver_pins);
 
+        to_free->values.reset();
+
         /* now free the net */
     }
-    return (nnet_t*)vtr::free(to_free);
+    return (nnet_t*)my_free_struct_to_pool(nnet_pool(), to_free);
 }
 
 /*---------------------------------------------------------------------------
  * (function: move_a_output_pin)
  *-------------------------------------------------------------------------*/
 void move_output_pin(nnode_t* node, int old_idx, int new_idx) {
+    mark_netlist_modified();
     npin_t* pin;
 
     oassert(node != NULL);
@@ -340,6 +392,7 @@ void move_output_pin(nnode_t* node, int old_idx, int new_idx) {
  * (function: move_a_input_pin)
  *-------------------------------------------------------------------------*/
 void move_input_pin(nnode_t* node, int old_idx, int new_idx) {
+    mark_netlist_modified();
     npin_t* pin;
 
     oassert(node != NULL);
@@ -359,6 +412,7 @@ void move_input_pin(nnode_t* node, int old_idx, int new_idx) {
  * (function: add_a_input_pin_to_node_spot_idx)
  *-------------------------------------------------------------------------------------------*/
 void add_input_pin_to_node(nnode_t* node, npin_t* pin, int pin_idx) {
+    mark_netlist_modified();
     oassert(node != NULL);
     oassert(pin != NULL);
     oassert(pin_idx < node->num_input_pins);
@@ -374,11 +428,15 @@ void add_input_pin_to_node(nnode_t* node, npin_t* pin, int pin_idx) {
  * (function: add_a_input_pin_to_spot_idx)
  *-------------------------------------------------------------------------------------------*/
 void add_fanout_pin_to_net(nnet_t* net, npin_t* pin) {
+    mark_netlist_modified();
     oassert(net != NULL);
     oassert(pin != NULL);
     oassert(pin->type != OUTPUT);
     /* assumes the pin spots have been allocated and the pin */
-    net->fanout_pins = (npin_t**)vtr::realloc(net->fanout_pins, sizeof(npin_t*) * (net->num_fanout_pins + 1));
+    /* grow the fanouts to the next power of two, since the constant nets get a fanout for every mapped operator */
+    int num_fanout_pins = net->num_fanout_pins;
+    if ((num_fanout_pins & (num_fanout_pins - 1)) == 0)
+        net->fanout_pins = (npin_t**)vtr::realloc(net->fanout_pins, sizeof(npin_t*) * (num_fanout_pins ? 2 * num_fanout_pins : 1));
     net->fanout_pins[net->num_fanout_pins] = pin;
     net->num_fanout_pins++;
     /* record the node and pin spot in the pin */
@@ -391,6 +449,7 @@ void add_fanout_pin_to_net(nnet_t* net, npin_t* pin) {
  * (function: add_a_output_pin_to_node_spot_idx)
  *-------------------------------------------------------------------------------------------*/
 void add_output_pin_to_node(nnode_t* node, npin_t* pin, int pin_idx) {
+    mark_netlist_modified();
     oassert(node != NULL);
     oassert(pin != NULL);
     oassert(pin_idx < node->num_output_pins);
@@ -406,6 +465,7 @@ void add_output_pin_to_node(nnode_t* node, npin_t* pin, int pin_idx) {
  * (function: add_a_output_pin_to_spot_idx)
  *-------------------------------------------------------------------------------------------*/
 void add_driver_pin_to_net(nnet_t* net, npin_t* pin) {
+    mark_netlist_modified();
     oassert(net != NULL);
     oassert(pin != NULL);
     oassert(pin->type != INPUT);
@@ -426,6 +486,7 @@ void add_driver_pin_to_net(nnet_t* net, npin_t* pin) {
  * 	The lasting one is input, and output disappears
  *-------------------------------------------------------------------------------------------*/
 void combine_nets(nnet_t* output_net, nnet_t* input_net, netlist_t* netlist) {
+    mark_netlist_modified();
     /* copy the driver over to the new_net */
     for (int i = 0; i < output_net->num_driver_pins; i++) {
         /* IF - there is a pin assigned to this net, then copy it */
@@ -494,6 +555,7 @@ void combine_nets_with_spot_copy(nnet_t* output_net, nnet_t* input_net, long sc_
  * TODO: improve error message
  *-------------------------------------------------------------------------------------------*/
 void join_nets(nnet_t* join_to_net, nnet_t* other_net) {
+    mark_netlist_modified();
     if (join_to_net == other_net) {
         for (int i = 0; i < join_to_net->num_driver_pins; i++) {
             const char* pin_name = join_to_net->driver_pins[i]->name ? join_to_net->driver_pins[i]->name : "unknown";
@@ -598,6 +660,7 @@ void integrate_nets(char* alias_name, char* full_name, nnet_t* driver_net) {
  * (function: remap_pin_to_new_node)
  *-----------------------------------------------------------------------*/
 void remap_pin_to_new_node(npin_t* pin, nnode_t* new_node, int pin_idx) {
+    mark_netlist_modified();
     if (pin->type == INPUT) {
         /* clean out the entry in the old net */
         pin->node->input_pins[pin->pin_node_idx] = NULL;
@@ -1141,6 +1204,8 @@ void free_netlist(netlist_t* to_free) {
     if (!to_free)
         return;
 
+    free_netlist_traversal_order(to_free);
+
     sc_free_string_cache(to_free->nets_sc);
     sc_free_string_cache(to_free->out_pins_sc);
     sc_free_string_cache(to_free->nodes_sc);
@@ -1223,6 +1288,7 @@ chain_information_t* allocate_chain_info() {
 }
 
 void remove_fanout_pins_from_net(nnet_t* net, npin_t* /*pin*/, int id) {
+    mark_netlist_modified();
     int i;
     for (i = id; i < net->num_fanout_pins - 1; i++) {
         net->fanout_pins[i] = net->fanout_pins[i + 1];
@@ -1234,6 +1300,7 @@ void remove_fanout_pins_from_net(nnet_t* net, npin_t* /*pin*/, int id) {
 }
 
 void delete_npin(npin_t* pin) {
+    mark_netlist_modified();
     if (pin->type == INPUT) {
         /* detach from its node */
         pin->node->input_pins[pin->pin_node_idx] = NULL;
@@ -27,9 +27,13 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
-#include <sstream>
 #include <dlfcn.h>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <atomic>
+#include <vector>
 
 #include "simulate_blif.h"
 #include "odin_buffer.h"
@@ -137,7 +141,7 @@ static void update_pin_value(npin_t* pin, BitSpace::bit_value_t value, int cycle
 static int get_pin_cycle(npin_t* pin);
 
 BitSpace::bit_value_t get_line_pin_value(line_t* line, int pin_num, int cycle);
-static int line_has_unknown_pin(line_t* line, int cycle);
+static bool get_line_values(line_t* line, int cycle, std::vector<BitSpace::bit_value_t>& values);
 
 static void compute_flipflop_node(nnode_t* node, int cycle);
 static void compute_mux_2_node(nnode_t* node, int cycle);
@@ -177,6 +181,8 @@ static void insert_pin_into_line(npin_t* pin, int pin_number, line_t* line, int
 static char* generate_vector_header(lines_t* l);
 static void write_vector_headers(FILE* file, lines_t* l);
 
+static void append_line_bits(const std::vector<BitSpace::bit_value_t>& values, std::string& buffer);
+static void append_line_hex(const std::vector<BitSpace::bit_value_t>& values, const char* hex_digits, std::string& buffer);
 static void write_vector_to_file(lines_t* l, FILE* file, int cycle);
 static void write_cycle_to_file(lines_t* l, FILE* file, int cycle);
 
@@ -196,6 +202,86 @@ static nnode_t* print_update_trace(nnode_t* bottom_node, int cycle);
 int number_of_workers = 0;
 int num_of_clock = 0;
 
+/*
+ * Stages with fewer nodes than this are computed by the simulating thread
+ * alone, since waking up the workers would take longer than computing them.
+ */
+#define MIN_PARALLEL_STAGE_NODES 256
+
+/*
+ * Threads reused by simulate_cycle to compute the stages of every cycle.
+ *
+ * Each stage is split into number_of_workers parts. The simulating thread
+ * computes the last part itself, and waits until the workers are done with
+ * theirs before going to the next stage (since a stage depends on the
+ * previous ones).
+ */
+class sim_worker_pool {
+  public:
+    explicit sim_worker_pool(int num_parts);
+    ~sim_worker_pool();
+
+    /* Computes the nodes of stage current_stage of s for the given cycle. */
+    void compute_stage(int current_stage, stages_t* s, int cycle);
+
+  private:
+    void worker_loop(int part);
+
+    int num_parts;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable stage_ready;
+    std::condition_variable stage_done;
+
+    // Stage being computed, published to the workers by bumping stage_id
+    size_t stage_id = 0;
+    int num_busy_workers = 0;
+    bool stop = false;
+    int current_stage = 0;
+    stages_t* current_stages = NULL;
+    int current_cycle = 0;
+};
+
+static std::unique_ptr<sim_worker_pool> worker_pool;
+
+/*
+ * stdio buffers of the vector files, which get a line (or a cycle of modelsim
+ * forces) per cycle: a large buffer turns these into few large writes.
+ */
+#define VECTOR_FILE_BUFFER_SIZE (1024 * 1024)
+static std::vector<char> out_file_buffer;
+static std::vector<char> in_out_file_buffer;
+static std::vector<char> modelsim_out_file_buffer;
+
+static void set_vector_file_buffer(FILE* file, std::vector<char>& buffer) {
+    buffer.resize(VECTOR_FILE_BUFFER_SIZE);
+    setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+}
+
+/*
+ * State of the event driven simulation (--event_driven), built from the stages
+ * once the first cycle is simulated. Nodes are indexed in stage order.
+ *
+ * A combinational node is only re-evaluated in a cycle if a node driving it
+ * changed an output value in that cycle (or the cycle before, if that node
+ * comes later in the stages); otherwise its outputs keep their previous values.
+ * The other nodes (flip-flops, memories, muxes, clocks, hard blocks...) are
+ * evaluated every cycle.
+ */
+struct event_sim_t {
+    std::vector<int> stage_offset;            // [0..s->count-1] -> index of the first node of the stage
+    std::vector<int> stage_of;                // [node index] -> stage
+    std::vector<std::vector<int>> fanouts;    // [node index] -> indices of the nodes it drives
+    std::vector<bool> combinational;          // [node index] -> whether the node can be skipped when its inputs are unchanged
+    std::unique_ptr<std::atomic<int>[]> event_cycle; // [node index] -> last cycle the node has to be evaluated in
+
+    std::atomic<long long> num_evaluated{0};
+    std::atomic<long long> num_skipped{0};
+};
+
+static std::unique_ptr<event_sim_t> event_sim;
+
 /*
  * Performs simulation.
  */
@@ -237,8 +323,10 @@ void simulate_netlist(netlist_t* netlist) {
  */
 sim_data_t* init_simulation(netlist_t* netlist) {
     number_of_workers = global_args.parralelized_simulation.value();
-    if (number_of_workers > 1)
+    if (number_of_workers > 1) {
         printf("Executing simulation with maximum of %d threads\n", number_of_workers);
+        worker_pool = std::make_unique<sim_worker_pool>(number_of_workers);
+    }
 
     num_of_clock = 0;
 
@@ -254,6 +342,7 @@ sim_data_t* init_simulation(netlist_t* netlist) {
     sim_data->out = fopen(out_vec_file, "w");
     if (!sim_data->out)
         error_message(SIMULATION, unknown_location, "%s\n", "Could not create output vector file.");
+    set_vector_file_buffer(sim_data->out, out_file_buffer);
 
     // Open the input vector file.
     char in_vec_file[BUFFER_MAX_SIZE] = {0};
@@ -261,6 +350,7 @@ sim_data_t* init_simulation(netlist_t* netlist) {
     sim_data->in_out = fopen(in_vec_file, "w+");
     if (!sim_data->in_out)
         error_message(SIMULATION, unknown_location, "%s\n", "Could not create input vector file.");
+    set_vector_file_buffer(sim_data->in_out, in_out_file_buffer);
 
     // Open the activity output file.
     char act_file[BUFFER_MAX_SIZE] = {0};
@@ -275,6 +365,7 @@ sim_data_t* init_simulation(netlist_t* netlist) {
     sim_data->modelsim_out = fopen(test_file, "w");
     if (!sim_data->modelsim_out)
         error_message(SIMULATION, unknown_location, "%s\n", "Could not create modelsim output file.");
+    set_vector_file_buffer(sim_data->modelsim_out, modelsim_out_file_buffer);
 
     // Create and verify the lines.
     sim_data->input_lines = create_lines(netlist, INPUT);
@@ -334,6 +425,9 @@ sim_data_t* init_simulation(netlist_t* netlist) {
 }
 
 sim_data_t* terminate_simulation(sim_data_t* sim_data) {
+    worker_pool.reset();
+    event_sim.reset();
+
     free_stages(sim_data->stages);
 
     fclose(sim_data->act_out);
@@ -347,6 +441,12 @@ sim_data_t* terminate_simulation(sim_data_t* sim_data) {
         fclose(sim_data->in);
 
     fclose(sim_data->out);
+
+    // the vector files are closed, their buffers can be released
+    std::vector<char>().swap(out_file_buffer);
+    std::vector<char>().swap(in_out_file_buffer);
+    std::vector<char>().swap(modelsim_out_file_buffer);
+
     vtr::free(sim_data);
     sim_data = NULL;
     return sim_data;
@@ -466,42 +566,235 @@ int single_step(sim_data_t* sim_data, int cycle) {
  * cycles if speedup is observed.
  */
 
-static void compute_and_store_part(int start, int end, int current_stage, stages_t* s, int cycle) {
-    for (int j = start; j >= 0 && j <= end && j < s->counts[current_stage]; j++)
-        if (s->stages[current_stage][j])
-            compute_and_store_value(s->stages[current_stage][j], cycle);
+/*
+ * Whether the outputs of a node only depend on the current values of its inputs.
+ */
+static bool is_combinational_node(nnode_t* node) {
+    if (is_clock_node(node))
+        return false;
+
+    switch (node->type) {
+        case GENERIC:
+        case BUF_NODE:
+        case LOGICAL_AND:
+        case LOGICAL_OR:
+        case LOGICAL_NAND:
+        case LOGICAL_NOT:
+        case LOGICAL_NOR:
+        case LOGICAL_XOR:
+        case LOGICAL_XNOR:
+        case LOGICAL_EQUAL:
+        case NOT_EQUAL:
+        case LT:
+        case GT:
+        case ADDER_FUNC:
+        case CARRY_FUNC:
+        case BITWISE_NOT:
+        case ASL:
+        case SL:
+        case SR:
+        case ASR:
+        case MULTIPLY:
+        case DIVIDE:
+        case MODULO:
+        case POWER:
+        case ADD:
+        case MINUS:
+        case GND_NODE:
+        case VCC_NODE:
+        case PAD_NODE:
+        case OUTPUT_NODE:
+            return true;
+        default:
+            return false;
+    }
 }
 
-static void simulate_cycle(int cycle, stages_t* s) {
-    double total_run_time = 0;
+/*
+ * Builds the event driven simulation state of the stages. Every node is
+ * evaluated in cycle 1, since events are only recorded from then on.
+ */
+static void init_event_sim(stages_t* s) {
+    event_sim = std::make_unique<event_sim_t>();
+
+    std::unordered_map<nnode_t*, int> node_index;
+    int num_nodes = 0;
     for (int i = 0; i < s->count; i++) {
-        double time = wall_time();
+        event_sim->stage_offset.push_back(num_nodes);
+        for (int j = 0; j < s->counts[i]; j++) {
+            if (s->stages[i][j])
+                node_index[s->stages[i][j]] = num_nodes + j;
+        }
+        num_nodes += s->counts[i];
+    }
 
-        std::vector<std::thread> workers;
-        int previous_end = 0;
+    event_sim->stage_of.resize(num_nodes, 0);
+    event_sim->fanouts.resize(num_nodes);
+    event_sim->combinational.resize(num_nodes, false);
+    event_sim->event_cycle = std::make_unique<std::atomic<int>[]>(num_nodes);
 
-        int nodes_per_thread = s->counts[i] / number_of_workers;
-        int remainder_nodes_per_thread = s->counts[i] % number_of_workers;
+    for (int i = 0; i < s->count; i++) {
+        for (int j = 0; j < s->counts[i]; j++) {
+            int index = event_sim->stage_offset[i] + j;
+            event_sim->stage_of[index] = i;
+            event_sim->event_cycle[index].store(1, std::memory_order_relaxed);
+
+            nnode_t* node = s->stages[i][j];
+            if (!node)
+                continue;
+
+            event_sim->combinational[index] = is_combinational_node(node);
+
+            int num_children = 0;
+            nnode_t** children = get_children_of(node, &num_children);
+            for (int k = 0; k < num_children; k++) {
+                auto child = node_index.find(children[k]);
+                if (child != node_index.end())
+                    event_sim->fanouts[index].push_back(child->second);
+            }
+            vtr::free(children);
 
-        for (int id = 0; id < number_of_workers; id++) {
-            int start = previous_end;
-            int end = start + nodes_per_thread + ((remainder_nodes_per_thread > 0) ? 1 : 0);
+            std::vector<int>& fanouts = event_sim->fanouts[index];
+            std::sort(fanouts.begin(), fanouts.end());
+            fanouts.erase(std::unique(fanouts.begin(), fanouts.end()), fanouts.end());
+        }
+    }
+}
 
-            remainder_nodes_per_thread -= 1;
-            previous_end = end + 1;
+/*
+ * Records that the node with the given index has to be evaluated in the given cycle.
+ */
+static void schedule_event(int index, int cycle) {
+    std::atomic<int>& event_cycle = event_sim->event_cycle[index];
+    int current = event_cycle.load(std::memory_order_relaxed);
+    while (current < cycle && !event_cycle.compare_exchange_weak(current, cycle, std::memory_order_relaxed))
+        ;
+}
 
-            if ((end - start) > 0) {
-                if (id < number_of_workers - 1) // if child threads
-                    workers.push_back(std::thread(compute_and_store_part, start, end, i, s, cycle));
-                else
-                    compute_and_store_part(start, end, i, s, cycle);
-            }
+/*
+ * Computes a node in event driven simulation. Returns false if the node was skipped.
+ */
+static bool compute_and_store_event(nnode_t* node, int index, int cycle) {
+    if (event_sim->combinational[index] && event_sim->event_cycle[index].load(std::memory_order_relaxed) < cycle) {
+        // Inputs unchanged, so are the outputs. There is no toggle to count for coverage either.
+        for (int i = 0; i < node->num_output_pins; i++)
+            update_pin_value(node->output_pins[i], get_pin_value(node->output_pins[i], cycle - 1), cycle);
+        node->covered = true;
+        return false;
+    }
+
+    compute_and_store_value(node, cycle);
+
+    bool changed = false;
+    for (int i = 0; i < node->num_output_pins && !changed; i++)
+        changed = get_pin_value(node->output_pins[i], cycle) != get_pin_value(node->output_pins[i], cycle - 1);
+
+    if (changed) {
+        int stage = event_sim->stage_of[index];
+        for (int child : event_sim->fanouts[index])
+            schedule_event(child, (event_sim->stage_of[child] > stage) ? cycle : cycle + 1);
+    }
+    return true;
+}
+
+/*
+ * Computes the nodes [start, end) of a stage.
+ */
+static void compute_and_store_part(int start, int end, int current_stage, stages_t* s, int cycle) {
+    if (!event_sim) {
+        for (int j = start; j < end; j++)
+            if (s->stages[current_stage][j])
+                compute_and_store_value(s->stages[current_stage][j], cycle);
+        return;
+    }
+
+    long long num_evaluated = 0;
+    long long num_skipped = 0;
+    for (int j = start; j < end; j++) {
+        if (!s->stages[current_stage][j])
+            continue;
+
+        if (compute_and_store_event(s->stages[current_stage][j], event_sim->stage_offset[current_stage] + j, cycle))
+            num_evaluated++;
+        else
+            num_skipped++;
+    }
+    event_sim->num_evaluated.fetch_add(num_evaluated, std::memory_order_relaxed);
+    event_sim->num_skipped.fetch_add(num_skipped, std::memory_order_relaxed);
+}
+
+/*
+ * Computes the part-th of num_parts contiguous parts of a stage.
+ */
+static void compute_stage_part(int part, int num_parts, int current_stage, stages_t* s, int cycle) {
+    long long count = s->counts[current_stage];
+    int start = (int)(count * part / num_parts);
+    int end = (int)(count * (part + 1) / num_parts);
+    compute_and_store_part(start, end, current_stage, s, cycle);
+}
+
+sim_worker_pool::sim_worker_pool(int num_parts_)
+    : num_parts(num_parts_) {
+    for (int part = 0; part < num_parts - 1; part++)
+        workers.push_back(std::thread(&sim_worker_pool::worker_loop, this, part));
+}
+
+sim_worker_pool::~sim_worker_pool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    stage_ready.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void sim_worker_pool::compute_stage(int stage, stages_t* s, int cycle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current_stage = stage;
+        current_stages = s;
+        current_cycle = cycle;
+        num_busy_workers = (int)workers.size();
+        stage_id++;
+    }
+    stage_ready.notify_all();
+
+    compute_stage_part(num_parts - 1, num_parts, stage, s, cycle);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    stage_done.wait(lock, [this] { return num_busy_workers == 0; });
+}
+
+void sim_worker_pool::worker_loop(int part) {
+    size_t last_stage_id = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            stage_ready.wait(lock, [&] { return stop || stage_id != last_stage_id; });
+            if (stop)
+                return;
+            last_stage_id = stage_id;
         }
 
-        for (auto& worker : workers)
-            worker.join();
+        compute_stage_part(part, num_parts, current_stage, current_stages, current_cycle);
 
-        total_run_time += wall_time() - time;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--num_busy_workers == 0)
+            stage_done.notify_one();
+    }
+}
+
+static void simulate_cycle(int cycle, stages_t* s) {
+    if (global_args.sim_event_driven && !event_sim)
+        init_event_sim(s);
+
+    for (int i = 0; i < s->count; i++) {
+        if (worker_pool && s->counts[i] >= MIN_PARALLEL_STAGE_NODES)
+            worker_pool->compute_stage(i, s, cycle);
+        else
+            compute_and_store_part(0, s->counts[i], i, s, cycle);
     }
 }
 
@@ -1610,6 +1903,65 @@ static void compute_hard_ip_node(nnode_t* node, int cycle) {
 #endif
 }
 
+/*
+ * Compiles the bit map of a generic node with at most 64 inputs, so it can be
+ * evaluated with bitwise operations (see evaluate_generic_cover).
+ */
+static void compile_generic_cover(nnode_t* node, int lut_size) {
+    node->generic_cover = (generic_cover_line_t*)vtr::malloc(sizeof(generic_cover_line_t) * node->bit_map_line_count);
+
+    for (int i = 0; i < node->bit_map_line_count; i++) {
+        generic_cover_line_t& line = node->generic_cover[i];
+        line.care = 0;
+        line.value = 0;
+        line.invalid = 0;
+        for (int j = 0; j < lut_size; j++) {
+            char c = node->bit_map[i][j];
+            if (c == '0' || c == '1') {
+                line.care |= uint64_t(1) << j;
+                if (c == '1')
+                    line.value |= uint64_t(1) << j;
+            } else if (c != '-') {
+                line.invalid |= uint64_t(1) << j;
+            }
+        }
+    }
+}
+
+/*
+ * Evaluates the compiled bit map of a generic node, reading each input pin once.
+ *
+ * Returns _1 if a line matches and _0 if none does. Like scanning the bit map
+ * input by input, returns _x once an unknown input is reached in a line before
+ * the line mismatches.
+ */
+static BitSpace::bit_value_t evaluate_generic_cover(nnode_t* node, int lut_size, int cycle) {
+    uint64_t inputs = 0;
+    uint64_t unknown_inputs = 0;
+    for (int j = 0; j < lut_size; j++) {
+        BitSpace::bit_value_t value = get_pin_value(node->input_pins[j], cycle);
+        if (BitSpace::is_unk[value])
+            unknown_inputs |= uint64_t(1) << j;
+        else if (value == BitSpace::_1)
+            inputs |= uint64_t(1) << j;
+    }
+
+    // Lowest set bits, i.e. the first inputs scanned
+    uint64_t first_unknown = unknown_inputs & (~unknown_inputs + 1);
+    for (int i = 0; i < node->bit_map_line_count; i++) {
+        const generic_cover_line_t& line = node->generic_cover[i];
+
+        uint64_t mismatches = (((inputs ^ line.value) & line.care) | line.invalid) & ~unknown_inputs;
+        uint64_t first_mismatch = mismatches & (~mismatches + 1);
+        if (unknown_inputs && (!mismatches || first_unknown < first_mismatch))
+            return BitSpace::_x;
+        if (!mismatches)
+            return BitSpace::_1;
+    }
+
+    return BitSpace::_0;
+}
+
 // TODO: Needs to be verified.
 static void compute_generic_node(nnode_t* node, int cycle) {
     int line_count_bitmap = node->bit_map_line_count;
@@ -1619,6 +1971,17 @@ static void compute_generic_node(nnode_t* node, int cycle) {
     while (bit_map[0][lut_size] != 0)
         lut_size++;
 
+    if (lut_size <= 64) {
+        if (!node->generic_cover)
+            compile_generic_cover(node, lut_size);
+
+        BitSpace::bit_value_t found = evaluate_generic_cover(node, lut_size, cycle);
+        if (found != BitSpace::_x && node->generic_output != BitSpace::_1)
+            found = BitSpace::l_not[found];
+        update_pin_value(node->output_pins[0], found, cycle);
+        return;
+    }
+
     int found = 0;
     int i;
     for (i = 0; i < line_count_bitmap && (!found); i++) {
@@ -2481,58 +2844,59 @@ static void write_cycle_to_file(lines_t* l, FILE* file, int cycle) {
     write_vector_to_file(l, file, cycle);
 }
 
+/*
+ * Appends one digit (0, 1 or x) per pin value to the given buffer,
+ * most significant pin first.
+ */
+static void append_line_bits(const std::vector<BitSpace::bit_value_t>& values, std::string& buffer) {
+    for (int j = (int)values.size() - 1; j >= 0; j--) {
+        if (BitSpace::is_unk[values[j]])
+            buffer.push_back('x');
+        else
+            buffer.push_back('0' + (int)values[j]);
+    }
+}
+
+/*
+ * Appends the (known) pin values as hex digits to the given buffer,
+ * most significant digit first.
+ */
+static void append_line_hex(const std::vector<BitSpace::bit_value_t>& values, const char* hex_digits, std::string& buffer) {
+    int hex_digit = 0;
+    for (int j = (int)values.size() - 1; j >= 0; j--) {
+        if (values[j] > 0)
+            hex_digit += 1 << (j % 4);
+
+        if (!(j % 4)) {
+            buffer.push_back(hex_digits[hex_digit]);
+            hex_digit = 0;
+        }
+    }
+}
+
 /*
  * Writes all values in the given lines to a line in the given file
- * for the given cycle.
+ * for the given cycle. The line is formatted in memory and written at once.
  */
 static void write_vector_to_file(lines_t* l, FILE* file, int cycle) {
-    std::stringstream buffer;
-    int i;
+    static std::string buffer;
+    static std::vector<BitSpace::bit_value_t> values;
+    buffer.clear();
 
-    for (i = 0; i < l->count; i++) {
-        buffer.str(std::string());
+    for (int i = 0; i < l->count; i++) {
         line_t* line = l->lines[i];
-        int num_pins = line->number_of_pins;
 
-        if (line_has_unknown_pin(line, cycle) || num_pins == 1) {
-            int j;
-            for (j = num_pins - 1; j >= 0; j--) {
-                BitSpace::bit_value_t value = get_line_pin_value(line, j, cycle);
-
-                if (BitSpace::is_unk[value]) {
-                    buffer << "x";
-                } else {
-                    buffer << std::dec << (int)value;
-                }
-            }
-            // If there are no known values, print a single capital X.
-            // (Only for testing. Breaks machine readability.)
-            //if (!known_values && num_pins > 1)
-            //	odin_sprintf(buffer, "X");
+        if (get_line_values(line, cycle, values) || line->number_of_pins == 1) {
+            append_line_bits(values, buffer);
         } else {
-            buffer << "0X";
-
-            int hex_digit = 0;
-            int j;
-            for (j = num_pins - 1; j >= 0; j--) {
-                BitSpace::bit_value_t value = get_line_pin_value(line, j, cycle);
-
-                hex_digit += value << j % 4;
-
-                if (!(j % 4)) {
-                    buffer << std::hex << hex_digit;
-                    hex_digit = 0;
-                }
-            }
+            buffer.append("0X");
+            append_line_hex(values, "0123456789abcdef", buffer);
         }
-        buffer << " ";
-        // Expand the value to fill to space under the header. (Gets ugly sometimes.)
-        //while (strlen(buffer) < strlen(l->lines[i]->name))
-        //	strcat(buffer," ");
-
-        fprintf(file, "%s", buffer.str().c_str());
+        buffer.push_back(' ');
     }
-    fprintf(file, "\n");
+    buffer.push_back('\n');
+
+    fwrite(buffer.data(), sizeof(char), buffer.size(), file);
 }
 
 /*
@@ -2561,38 +2925,29 @@ static void write_cycle_to_modelsim_file(netlist_t* netlist, lines_t* l, FILE* m
  * Writes a vector to the given modelsim out file.
  */
 static void write_vector_to_modelsim_file(lines_t* l, FILE* modelsim_out, int cycle) {
-    int i;
-    for (i = 0; i < l->count; i++) {
-        if (line_has_unknown_pin(l->lines[i], cycle) || l->lines[i]->number_of_pins == 1) {
-            fprintf(modelsim_out, "force %s ", l->lines[i]->name);
-            int j;
+    static std::string buffer;
+    static std::vector<BitSpace::bit_value_t> values;
+    buffer.clear();
 
-            for (j = l->lines[i]->number_of_pins - 1; j >= 0; j--) {
-                int value = get_line_pin_value(l->lines[i], j, cycle);
+    std::string time = std::to_string(cycle / 2 * 100);
+    for (int i = 0; i < l->count; i++) {
+        line_t* line = l->lines[i];
 
-                if (BitSpace::is_unk[value])
-                    fprintf(modelsim_out, "%s", "x");
-                else
-                    fprintf(modelsim_out, "%d", value);
-            }
-            fprintf(modelsim_out, " %d\n", cycle / 2 * 100);
+        buffer.append("force ");
+        buffer.append(line->name);
+        if (get_line_values(line, cycle, values) || line->number_of_pins == 1) {
+            buffer.push_back(' ');
+            append_line_bits(values, buffer);
         } else {
-            int value = 0;
-            fprintf(modelsim_out, "force %s 16#", l->lines[i]->name);
-
-            int j;
-            for (j = l->lines[i]->number_of_pins - 1; j >= 0; j--) {
-                if (get_line_pin_value(l->lines[i], j, cycle) > 0)
-                    value += my_power(2, j % 4);
-
-                if (j % 4 == 0) {
-                    fprintf(modelsim_out, "%X", value);
-                    value = 0;
-                }
-            }
-            fprintf(modelsim_out, " %d\n", cycle / 2 * 100);
+            buffer.append(" 16#");
+            append_line_hex(values, "0123456789ABCDEF", buffer);
         }
+        buffer.push_back(' ');
+        buffer.append(time);
+        buffer.push_back('\n');
     }
+
+    fwrite(buffer.data(), sizeof(char), buffer.size(), modelsim_out);
 }
 
 /*
@@ -2788,18 +3143,16 @@ static char* get_mif_filename(nnode_t* node) {
 }
 
 /*
- * Returns true if the given line has a pin for
- * the given cycle whose value is x.
+ * Gets the values of the pins of the given line for the given cycle,
+ * and returns whether any of them is unknown.
  */
-static int line_has_unknown_pin(line_t* line, int cycle) {
+static bool get_line_values(line_t* line, int cycle, std::vector<BitSpace::bit_value_t>& values) {
     bool unknown = false;
-    int j;
-    for (j = line->number_of_pins - 1; j >= 0; j--) {
-        BitSpace::bit_value_t current_value = get_line_pin_value(line, j, cycle);
-        if (BitSpace::is_unk[current_value]) {
+    values.resize(line->number_of_pins);
+    for (int j = 0; j < line->number_of_pins; j++) {
+        values[j] = get_line_pin_value(line, j, cycle);
+        if (BitSpace::is_unk[values[j]])
             unknown = true;
-            break;
-        }
     }
     return unknown;
 }
@@ -2983,6 +3336,15 @@ static void print_simulation_stats(stages_t* stages, int /*num_vectors*/, double
         "Coverage:          "
         "%d (%4.1f%%)\n",
         covered_nodes, (covered_nodes / (double)stages->num_nodes) * 100);
+
+    if (event_sim) {
+        long long num_evaluated = event_sim->num_evaluated.load();
+        long long num_computed = num_evaluated + event_sim->num_skipped.load();
+        printf(
+            "Evaluated nodes:   "
+            "%lld (%4.1f%%)\n",
+            num_evaluated, num_computed ? (num_evaluated / (double)num_computed) * 100 : 0.0);
+    }
 }
 
 /*
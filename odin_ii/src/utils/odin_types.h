@@ -88,6 +88,8 @@ struct global_args_t {
     argparse::ArgValue<std::vector<std::string>> input_files;
     argparse::ArgValue<std::string> blif_file;
     argparse::ArgValue<std::string> output_file;
+    argparse::ArgValue<std::string> abc_script; // ABC commands mapping the netlist in-process before it is output
+    argparse::ArgValue<int> abc_jobs;           // maximum number of netlist partitions mapped concurrently by ABC
     argparse::ArgValue<std::string> arch_file;   // Name of the FPGA architecture file
     argparse::ArgValue<bool> permissive;         // turn possible_errors into warnings
     argparse::ArgValue<bool> print_parse_tokens; // print the tokens as they are parsed byt the parser
@@ -137,6 +139,8 @@ struct global_args_t {
 
     argparse::ArgValue<int> parralelized_simulation;
     argparse::ArgValue<bool> parralelized_simulation_in_batch;
+    // only re-evaluate the combinational nodes whose inputs changed
+    argparse::ArgValue<bool> sim_event_driven;
     // deprecated since this should be defined when compiled
     argparse::ArgValue<int> sim_initial_value;
     // The seed for creating random simulation vector
@@ -515,6 +519,14 @@ struct attr_t {
     long ABITS;                  // Addr width
 };
 
+/* A line of the bit map of a generic node (with at most 64 inputs), compiled by the simulator.
+ * Bit j of each mask is about input j. */
+struct generic_cover_line_t {
+    uint64_t care;    // input j must have the value of bit j of value
+    uint64_t value;   // the required values
+    uint64_t invalid; // the line has a character other than '0', '1' or '-' for input j, which never matches
+};
+
 /* DEFINTIONS for all the different types of nodes there are.  This is also used cross-referenced in utils.c so that I can get a string version
  * of these names, so if you add new tpyes in here, be sure to add those same types in utils.c */
 struct nnode_t {
@@ -559,6 +571,9 @@ struct nnode_t {
     char** bit_map; /*storing the bit map */
     int bit_map_line_count;
 
+    // bit_map compiled by the simulator, one entry per line (NULL until the node is first simulated)
+    generic_cover_line_t* generic_cover;
+
     // For simulation
     int in_queue;           // Flag used by the simulator to avoid double queueing.
     npin_t** undriven_pins; // These pins have been found by the simulator to have no driver.
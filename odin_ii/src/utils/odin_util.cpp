@@ -32,6 +32,8 @@
 #include <climits>
 #include <cerrno>
 #include <cstdarg>
+#include <cstddef>
+#include <algorithm>
 
 #include "odin_types.h"
 #include "odin_globals.h"
@@ -675,9 +677,10 @@ std::string make_simple_name(char* input, const char* flatten_string, char flatt
 /*-----------------------------------------------------------------------
  * (function: my_malloc_struct )
  *-----------------------------------------------------------------*/
+static long int m_id = 0;
+
 void* my_malloc_struct(long bytes_to_alloc) {
     void* allocated = vtr::calloc(1, bytes_to_alloc);
-    static long int m_id = 0;
 
     // ways to stop the execution at the point when a specific structure is built...note it needs to be m_id - 1 ... it's unique_id in most data structures
     //oassert(m_id != 193);
@@ -693,6 +696,65 @@ void* my_malloc_struct(long bytes_to_alloc) {
     return allocated;
 }
 
+/* number of structures per pool block */
+#define STRUCT_POOL_BLOCK_SIZE 4096
+
+/*-----------------------------------------------------------------------
+ * (function: init_struct_pool )
+ *-----------------------------------------------------------------*/
+void init_struct_pool(struct_pool_t* pool, size_t struct_size) {
+    /* keep every structure aligned, and large enough to hold a free list link */
+    size_t align = alignof(std::max_align_t);
+    struct_size = std::max(struct_size, sizeof(void*));
+    pool->struct_size = (struct_size + align - 1) / align * align;
+    pool->structs_per_block = STRUCT_POOL_BLOCK_SIZE;
+
+    pool->blocks.clear();
+    pool->block_next = NULL;
+    pool->block_end = NULL;
+    pool->free_list = NULL;
+}
+
+/*-----------------------------------------------------------------------
+ * (function: my_malloc_struct_from_pool )
+ * 	Same as my_malloc_struct, but takes the zeroed structure from the pool
+ *-----------------------------------------------------------------*/
+void* my_malloc_struct_from_pool(struct_pool_t* pool) {
+    void* allocated;
+
+    if (pool->free_list) {
+        allocated = pool->free_list;
+        pool->free_list = *((void**)allocated);
+    } else {
+        if (pool->block_next == pool->block_end) {
+            pool->blocks.push_back((char*)vtr::malloc(pool->struct_size * pool->structs_per_block));
+            pool->block_next = pool->blocks.back();
+            pool->block_end = pool->block_next + pool->struct_size * pool->structs_per_block;
+        }
+        allocated = pool->block_next;
+        pool->block_next += pool->struct_size;
+    }
+
+    memset(allocated, 0, pool->struct_size);
+
+    /* mark the unique_id */
+    *((long int*)allocated) = m_id++;
+
+    return allocated;
+}
+
+/*-----------------------------------------------------------------------
+ * (function: my_free_struct_to_pool )
+ * 	Puts a structure from my_malloc_struct_from_pool back on the free list
+ *-----------------------------------------------------------------*/
+void* my_free_struct_to_pool(struct_pool_t* pool, void* to_free) {
+    if (to_free) {
+        *((void**)to_free) = pool->free_list;
+        pool->free_list = to_free;
+    }
+    return NULL;
+}
+
 /*
  * Changes the given string to upper case.
  */
@@ -27,6 +27,7 @@
 #define ODIN_UTIL_H
 
 #include <string>
+#include <vector>
 
 #include "odin_types.h"
 
@@ -67,6 +68,24 @@ std::string make_simple_name(char* input, const char* flatten_string, char flatt
 
 void* my_malloc_struct(long bytes_to_alloc);
 
+/* Pool of same sized structures, carved out of large blocks instead of one
+ * calloc each. Freed structures are kept on a free list for reuse, and the
+ * blocks are never given back to the system. */
+struct struct_pool_t {
+    size_t struct_size;
+    size_t structs_per_block;
+
+    std::vector<char*> blocks;
+    char* block_next;
+    char* block_end;
+
+    void* free_list;
+};
+
+void init_struct_pool(struct_pool_t* pool, size_t struct_size);
+void* my_malloc_struct_from_pool(struct_pool_t* pool);
+void* my_free_struct_to_pool(struct_pool_t* pool, void* to_free);
+
 void reverse_string(char* token, int length);
 char* append_string(const char* string, const char* appendage, ...);
 char* string_to_upper(char* string);
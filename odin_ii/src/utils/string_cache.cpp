@@ -31,89 +31,121 @@
 #include "vtr_util.h"
 #include "vtr_memory.h"
 
-unsigned long
-string_hash(STRING_CACHE* sc,
-            const char* string);
-void generate_sc_hash(STRING_CACHE* sc);
-
-unsigned long
-string_hash(STRING_CACHE* sc,
-            const char* string) {
-    long a, i, mod, mul;
-
-    a = 0;
-    mod = sc->mod;
-    mul = sc->mul;
-    for (i = 0; string[i]; i++)
-        a = (a * mul + (unsigned char)string[i]) % mod;
-    return a;
+#define SC_INITIAL_SIZE 100
+#define SC_INITIAL_HASH_SIZE 256
+#define SC_BLOCK_SIZE 4096
+
+static unsigned long string_hash(const char* string);
+static long find_slot(STRING_CACHE* sc, const char* string, unsigned long hash);
+static void grow_slots(STRING_CACHE* sc);
+static char* store_string(STRING_CACHE* sc, const char* string);
+
+/*
+ * 64-bit FNV-1a hash
+ */
+static unsigned long string_hash(const char* string) {
+    unsigned long long hash = 14695981039346656037ULL;
+    for (long i = 0; string[i]; i++) {
+        hash ^= (unsigned char)string[i];
+        hash *= 1099511628211ULL;
+    }
+    return (unsigned long)hash;
 }
 
-void generate_sc_hash(STRING_CACHE* sc) {
-    long i;
-    long hash;
+/*
+ * Returns the slot holding string, or the empty slot where it would be inserted.
+ */
+static long find_slot(STRING_CACHE* sc, const char* string, unsigned long hash) {
+    long mask = sc->string_hash_size - 1;
+    long slot = (long)(hash & mask);
+    while (sc->slots[slot] >= 0) {
+        long i = sc->slots[slot];
+        if (sc->string_hash[i] == hash && !strcmp(sc->string[i], string))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
 
-    if (sc->string_hash != NULL)
-        vtr::free(sc->string_hash);
-    if (sc->next_string != NULL)
-        vtr::free(sc->next_string);
-    sc->string_hash_size = sc->size * 2 + 11;
-    sc->string_hash = (long*)sc_do_alloc(sc->string_hash_size, sizeof(long));
-    sc->next_string = (long*)sc_do_alloc(sc->size, sizeof(long));
-    memset(sc->string_hash, 0xff, sc->string_hash_size * sizeof(long));
-    memset(sc->next_string, 0xff, sc->size * sizeof(long));
-    for (i = 0; i < sc->free; i++) {
-        hash = string_hash(sc, sc->string[i]) % sc->string_hash_size;
-        sc->next_string[i] = sc->string_hash[hash];
-        sc->string_hash[hash] = i;
+/*
+ * Doubles the number of slots, reinserting the strings with their stored hashes.
+ */
+static void grow_slots(STRING_CACHE* sc) {
+    vtr::free(sc->slots);
+    sc->string_hash_size *= 2;
+    sc->slots = (long*)sc_do_alloc(sc->string_hash_size, sizeof(long));
+    memset(sc->slots, 0xff, sc->string_hash_size * sizeof(long));
+
+    long mask = sc->string_hash_size - 1;
+    for (long i = 0; i < sc->free; i++) {
+        long slot = (long)(sc->string_hash[i] & mask);
+        while (sc->slots[slot] >= 0)
+            slot = (slot + 1) & mask;
+        sc->slots[slot] = i;
     }
 }
 
+/*
+ * Copies string to the arena.
+ */
+static char* store_string(STRING_CACHE* sc, const char* string) {
+    long len = strlen(string) + 1;
+    if (len > sc->block_free) {
+        long block_size = (len > SC_BLOCK_SIZE) ? len : SC_BLOCK_SIZE;
+        sc->blocks = (char**)vtr::realloc(sc->blocks, (sc->num_blocks + 1) * sizeof(char*));
+        sc->blocks[sc->num_blocks++] = (char*)sc_do_alloc(block_size, sizeof(char));
+        sc->block_next = sc->blocks[sc->num_blocks - 1];
+        sc->block_free = block_size;
+    }
+
+    char* stored = sc->block_next;
+    memcpy(stored, string, len);
+    sc->block_next += len;
+    sc->block_free -= len;
+    return stored;
+}
+
 STRING_CACHE*
 sc_new_string_cache(void) {
     STRING_CACHE* sc;
 
     sc = (STRING_CACHE*)sc_do_alloc(1, sizeof(STRING_CACHE));
-    sc->size = 100;
-    sc->string_hash_size = 0;
-    sc->string_hash = NULL;
-    sc->next_string = NULL;
+    sc->size = SC_INITIAL_SIZE;
     sc->free = 0;
     sc->string = (char**)sc_do_alloc(sc->size, sizeof(char*));
     sc->data = (void**)sc_do_alloc(sc->size, sizeof(void*));
-    sc->mod = 834535547;
-    sc->mul = 247999;
-    generate_sc_hash(sc);
+    sc->string_hash = (unsigned long*)sc_do_alloc(sc->size, sizeof(unsigned long));
+
+    sc->string_hash_size = SC_INITIAL_HASH_SIZE;
+    sc->slots = (long*)sc_do_alloc(sc->string_hash_size, sizeof(long));
+    memset(sc->slots, 0xff, sc->string_hash_size * sizeof(long));
+
+    sc->blocks = NULL;
+    sc->num_blocks = 0;
+    sc->block_next = NULL;
+    sc->block_free = 0;
     return sc;
 }
 
 long sc_lookup_string(STRING_CACHE* sc,
                       const char* string) {
-    long i, hash;
-
     if (sc == NULL) {
         return -1;
     } else {
-        hash = string_hash(sc, string) % sc->string_hash_size;
-        i = sc->string_hash[hash];
-        while (i >= 0) {
-            if (!strcmp(sc->string[i], string))
-                return i;
-            i = sc->next_string[i];
-        }
-        return -1;
+        return sc->slots[find_slot(sc, string, string_hash(string))];
     }
 }
 
 long sc_add_string(STRING_CACHE* sc,
                    const char* string) {
     long i;
-    long hash;
     void* a;
 
-    i = sc_lookup_string(sc, string);
-    if (i >= 0)
-        return i;
+    unsigned long hash = string_hash(string);
+    long slot = find_slot(sc, string, hash);
+    if (sc->slots[slot] >= 0)
+        return sc->slots[slot];
+
     if (sc->free >= sc->size) {
         sc->size = sc->size * 2 + 10;
 
@@ -129,15 +161,24 @@ long sc_add_string(STRING_CACHE* sc,
         vtr::free(sc->data);
         sc->data = (void**)a;
 
-        generate_sc_hash(sc);
+        a = sc_do_alloc(sc->size, sizeof(unsigned long));
+        if (sc->free > 0)
+            memcpy(a, sc->string_hash, sc->free * sizeof(unsigned long));
+        vtr::free(sc->string_hash);
+        sc->string_hash = (unsigned long*)a;
     }
+
     i = sc->free;
     sc->free++;
-    sc->string[i] = vtr::strdup(string);
+    sc->string[i] = store_string(sc, string);
     sc->data[i] = NULL;
-    hash = string_hash(sc, string) % sc->string_hash_size;
-    sc->next_string[i] = sc->string_hash[hash];
-    sc->string_hash[hash] = i;
+    sc->string_hash[i] = hash;
+    sc->slots[slot] = i;
+
+    /* keep the table at most half full, so probe sequences stay short */
+    if (sc->free * 2 > sc->string_hash_size)
+        grow_slots(sc);
+
     return i;
 }
 
@@ -161,31 +202,23 @@ void* sc_do_alloc(long a,
 
 STRING_CACHE* sc_free_string_cache(STRING_CACHE* sc) {
     if (sc != NULL) {
-        if (sc->string != NULL) {
-            for (long i = 0; i < sc->free; i++) {
-                if (sc->string[i] != NULL) {
-                    vtr::free(sc->string[i]);
-                }
-                sc->string[i] = NULL;
-            }
-            vtr::free(sc->string);
+        for (long i = 0; i < sc->num_blocks; i++) {
+            vtr::free(sc->blocks[i]);
         }
+        vtr::free(sc->blocks);
+        sc->blocks = NULL;
+
+        vtr::free(sc->string);
         sc->string = NULL;
 
-        if (sc->data != NULL) {
-            vtr::free(sc->data);
-        }
+        vtr::free(sc->data);
         sc->data = NULL;
 
-        if (sc->string_hash != NULL) {
-            vtr::free(sc->string_hash);
-        }
+        vtr::free(sc->string_hash);
         sc->string_hash = NULL;
 
-        if (sc->next_string != NULL) {
-            vtr::free(sc->next_string);
-        }
-        sc->next_string = NULL;
+        vtr::free(sc->slots);
+        sc->slots = NULL;
 
         vtr::free(sc);
     }
@@ -50,6 +50,7 @@ inline void verilog::writer::_create_file(const char* file_name, const file_type
                       "verilog back-end entity cannot create file types(%d) other than verilog", file_type);
     // create the verilog file and set it as the output file
     this->output_file = create_verilog(file_name);
+    this->set_output_file_buffer();
 }
 
 void verilog::writer::_write(const netlist_t* netlist) {
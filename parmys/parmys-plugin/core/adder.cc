@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include "adder.h"
+#include "hard_block.h"
 #include "multiplier.h"
 #include "netlist_utils.h"
 #include "node_utils.h"
@@ -96,19 +97,13 @@ void report_add_distribution()
  *-------------------------------------------------------------------------*/
 void find_hard_adders()
 {
-    hard_adders = Arch.models;
+    hard_adders = find_hard_block("adder");
     // Disable the size in configuration file.(The threshold for the extra bits).
     // min_add = configuration.min_hard_adder;
     min_threshold_adder = configuration.min_threshold_adder;
 
-    while (hard_adders != NULL) {
-        if (strcmp(hard_adders->name, "adder") == 0) {
-            init_add_distribution();
-            return;
-        } else {
-            hard_adders = hard_adders->next;
-        }
-    }
+    if (hard_adders != NULL)
+        init_add_distribution();
 
     return;
 }
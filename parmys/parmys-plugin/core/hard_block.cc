@@ -55,15 +55,25 @@ void cache_hard_block_names()
 {
     t_model *hard_blocks = NULL;
 
+    free_hard_block_names();
+
     hard_blocks = Arch.models;
     hard_block_names = sc_new_string_cache();
     while (hard_blocks) {
         int sc_spot = sc_add_string(hard_block_names, hard_blocks->name);
-        hard_block_names->data[sc_spot] = (void *)hard_blocks;
+        /* keep the first model of a given name, as a walk of the model list would find */
+        if (hard_block_names->data[sc_spot] == NULL)
+            hard_block_names->data[sc_spot] = (void *)hard_blocks;
         hard_blocks = hard_blocks->next;
     }
 }
 
+void free_hard_block_names()
+{
+    if (hard_block_names)
+        hard_block_names = sc_free_string_cache(hard_block_names);
+}
+
 void register_hard_blocks()
 {
     cache_hard_block_names();
@@ -96,18 +106,20 @@ void register_hard_blocks()
     }
 }
 
+/*
+ * Looks the model up in the hard block names cache, which is built on first use
+ * instead of walking the list of architecture models on every call.
+ */
 t_model *find_hard_block(const char *name)
 {
-    t_model *hard_blocks;
+    if (!hard_block_names)
+        cache_hard_block_names();
 
-    hard_blocks = Arch.models;
-    while (hard_blocks)
-        if (!strcmp(hard_blocks->name, name))
-            return hard_blocks;
-        else
-            hard_blocks = hard_blocks->next;
+    long sc_spot = sc_lookup_string(hard_block_names, name);
+    if (sc_spot == -1)
+        return NULL;
 
-    return NULL;
+    return (t_model *)hard_block_names->data[sc_spot];
 }
 
 void cell_hard_block(nnode_t *node, Yosys::Module *module, netlist_t *netlist, Yosys::Design *design)
@@ -23,6 +23,7 @@
 extern STRING_CACHE *hard_block_names;
 
 void register_hard_blocks();
+void free_hard_block_names();
 t_model *find_hard_block(const char *name);
 void cell_hard_block(nnode_t *node, Yosys::Module *module, netlist_t *netlist, Yosys::Design *design);
 void output_hard_blocks_yosys(Yosys::Design *design);
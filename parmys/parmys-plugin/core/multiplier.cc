@@ -16,6 +16,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include "multiplier.h"
+#include "hard_block.h"
 #include "netlist_utils.h"
 #include "node_utils.h"
 #include "odin_globals.h"
@@ -544,16 +545,10 @@ void report_mult_distribution()
  *-------------------------------------------------------------------------*/
 void find_hard_multipliers()
 {
-    hard_multipliers = Arch.models;
+    hard_multipliers = find_hard_block("multiply");
     min_mult = configuration.min_hard_multiplier;
-    while (hard_multipliers != NULL) {
-        if (strcmp(hard_multipliers->name, "multiply") == 0) {
-            init_mult_distribution();
-            return;
-        } else {
-            hard_multipliers = hard_multipliers->next;
-        }
-    }
+    if (hard_multipliers != NULL)
+        init_mult_distribution();
 
     return;
 }
@@ -17,7 +17,8 @@
  */
 #include "mixing_optimization.h"
 
-#include <stdint.h> // INT_MAX
+#include <algorithm> // std::stable_sort
+#include <stdint.h>  // INT_MAX
 #include <vector>
 
 #include "adder.h"                 // hard_adders
@@ -87,39 +88,37 @@ void MultsOpt::perform(netlist_t *netlist, std::vector<nnode_t *> &weighted_node
 {
     size_t nodes_count = weighted_nodes.size();
 
-    // per optimization, instantiate hard logic
-    for (int i = 0; i < this->_blocks_count; i++) {
-        int maximal_cost = -1;
-        int index = -1;
-        for (size_t j = 0; j < nodes_count; j++) {
-            // if found a new maximal cost that is higher than a current maximum AND is not restricted by input
-            // params for minimal "hardenable" multiplier width
-            if (maximal_cost < weighted_nodes[j]->weight && this->hardenable(weighted_nodes[j])) {
-                maximal_cost = weighted_nodes[j]->weight;
-                index = j;
-            }
+    // classify the nodes once: the candidates are the nodes with a non-negative cost that are
+    // not restricted by input params for minimal "hardenable" multiplier width
+    std::vector<size_t> candidates;
+    for (size_t j = 0; j < nodes_count; j++) {
+        if (weighted_nodes[j]->weight > -1 && this->hardenable(weighted_nodes[j])) {
+            candidates.push_back(j);
         }
+    }
+
+    // the most costly candidates are hardened first, ties going to the earliest node
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [&](size_t a, size_t b) { return weighted_nodes[a]->weight > weighted_nodes[b]->weight; });
 
-        // if there are no suitable nodes left, leave the loop to
-        // implement remaining nodes in soft logic
-        if (index < 0)
-            break;
+    // per optimization, instantiate hard logic. if there are no suitable nodes left, the
+    // remaining nodes are implemented in soft logic
+    size_t num_hardened = std::min<size_t>(candidates.size(), std::max(this->_blocks_count, 0));
+    for (size_t i = 0; i < num_hardened; i++) {
+        nnode_t *node = weighted_nodes[candidates[i]];
 
-        // indicate for future iterations the node was hardened
-        weighted_nodes[index]->weight = -1;
+        // indicate the node was hardened
+        node->weight = -1;
 
         if (hard_multipliers) {
-            instantiate_hard_multiplier(weighted_nodes[index], this->cached_traverse_value, netlist);
+            instantiate_hard_multiplier(node, this->cached_traverse_value, netlist);
         }
     }
 
-    // From the end of the vector, remove all nodes that were implemented in hard logic. The remaining
+    // Remove all nodes that were implemented in hard logic, keeping the order of the others. The remaining
     // nodes will be instantiated in soft_map_remaining_nodes
-    for (int i = nodes_count - 1; i >= 0; i--) {
-        if (weighted_nodes[i]->weight == -1) {
-            weighted_nodes.erase(weighted_nodes.begin() + i);
-        }
-    }
+    weighted_nodes.erase(std::remove_if(weighted_nodes.begin(), weighted_nodes.end(), [](nnode_t *node) { return node->weight == -1; }),
+                         weighted_nodes.end());
 }
 
 void MixingOpt::set_blocks_needed(int new_count) { this->_blocks_count = new_count; }
@@ -373,7 +373,10 @@ void add_fanout_pin_to_net(nnet_t *net, npin_t *pin)
     oassert(pin != NULL);
     oassert(pin->type != OUTPUT);
     /* assumes the pin spots have been allocated and the pin */
-    net->fanout_pins = (npin_t **)vtr::realloc(net->fanout_pins, sizeof(npin_t *) * (net->num_fanout_pins + 1));
+    /* grow the fanouts to the next power of two, since the constant nets get a fanout for every mapped operator */
+    int num_fanout_pins = net->num_fanout_pins;
+    if ((num_fanout_pins & (num_fanout_pins - 1)) == 0)
+        net->fanout_pins = (npin_t **)vtr::realloc(net->fanout_pins, sizeof(npin_t *) * (num_fanout_pins ? 2 * num_fanout_pins : 1));
     net->fanout_pins[net->num_fanout_pins] = pin;
     net->num_fanout_pins++;
     /* record the node and pin spot in the pin */
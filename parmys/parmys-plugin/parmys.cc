@@ -226,20 +226,17 @@ struct ParMYSPass : public Pass {
     {
 
         int base_pin_idx = node->num_input_pins;
+        std::string mapping_name = RTLIL::unescape_id(mapping);
 
         allocate_more_input_pins(node, in_port.size());
         add_input_port_information(node, in_port.size());
 
         for (int i = 0; i < in_port.size(); i++) {
-
-            char *in_pin_name = sig_full_ref_name_sig(in_port[i], cstr_bits_seen);
-
             npin_t *in_pin = allocate_npin();
-            in_pin->name = vtr::strdup(in_pin_name);
-            in_pin->mapping = vtr::strdup(RTLIL::unescape_id(mapping).c_str());
+            // the pin takes ownership of the name
+            in_pin->name = sig_full_ref_name_sig(in_port[i], cstr_bits_seen);
+            in_pin->mapping = vtr::strdup(mapping_name.c_str());
             add_input_pin_to_node(node, in_pin, base_pin_idx + i);
-
-            vtr::free(in_pin_name);
         }
     }
 
@@ -248,6 +245,7 @@ struct ParMYSPass : public Pass {
     {
 
         int base_pin_idx = node->num_output_pins;
+        std::string mapping_name = RTLIL::unescape_id(mapping);
 
         allocate_more_output_pins(node, out_port.size()); //?
         add_output_port_information(node, out_port.size());
@@ -257,19 +255,20 @@ struct ParMYSPass : public Pass {
         for (int i = 0; i < out_port.size(); i++) {
             npin_t *out_pin = allocate_npin();
             out_pin->name = NULL;
-            out_pin->mapping = vtr::strdup(RTLIL::unescape_id(mapping).c_str());
+            out_pin->mapping = vtr::strdup(mapping_name.c_str());
             add_output_pin_to_node(node, out_pin, base_pin_idx + i);
 
             char *output_pin_name = sig_full_ref_name_sig(out_port[i], cstr_bits_seen);
             nnet_t *out_net = (nnet_t *)output_nets_hash->get(output_pin_name);
             if (out_net == nullptr) {
                 out_net = allocate_nnet();
-                out_net->name = vtr::strdup(output_pin_name);
                 output_nets_hash->add(output_pin_name, out_net);
+                // the net takes ownership of the name
+                out_net->name = output_pin_name;
+            } else {
+                vtr::free(output_pin_name);
             }
             add_driver_pin_to_net(out_net, out_pin);
-
-            vtr::free(output_pin_name);
         }
     }
 
@@ -423,6 +422,11 @@ struct ParMYSPass : public Pass {
             }
         }
 
+        // the internal nodes are collected here and added to the netlist at once, instead of
+        // growing the netlist array by one node at a time
+        std::vector<nnode_t *> internal_nodes;
+        internal_nodes.reserve(top_module->cells().size());
+
         long hard_id = 0;
         for (auto cell : top_module->cells()) {
 
@@ -636,9 +640,7 @@ struct ParMYSPass : public Pass {
             }
 
             /*add this node to blif_netlist as an internal node */
-            odin_netlist->internal_nodes =
-              (nnode_t **)vtr::realloc(odin_netlist->internal_nodes, sizeof(nnode_t *) * (odin_netlist->num_internal_nodes + 1));
-            odin_netlist->internal_nodes[odin_netlist->num_internal_nodes++] = new_node;
+            internal_nodes.push_back(new_node);
         }
 
         // add intermediate buffer nodes
@@ -659,14 +661,11 @@ struct ParMYSPass : public Pass {
                 allocate_more_input_pins(buf_node, 1);
                 add_input_port_information(buf_node, 1);
 
-                char *in_pin_name = sig_full_ref_name_sig(rhs_bit, cstr_bits_seen);
                 npin_t *in_pin = allocate_npin();
-                in_pin->name = vtr::strdup(in_pin_name);
+                in_pin->name = sig_full_ref_name_sig(rhs_bit, cstr_bits_seen);
                 in_pin->type = INPUT;
                 add_input_pin_to_node(buf_node, in_pin, 0);
 
-                vtr::free(in_pin_name);
-
                 allocate_more_output_pins(buf_node, 1);
                 add_output_port_information(buf_node, 1);
 
@@ -685,13 +684,17 @@ struct ParMYSPass : public Pass {
 
                 buf_node->name = vtr::strdup(output_pin_name);
 
-                odin_netlist->internal_nodes =
-                  (nnode_t **)vtr::realloc(odin_netlist->internal_nodes, sizeof(nnode_t *) * (odin_netlist->num_internal_nodes + 1));
-                odin_netlist->internal_nodes[odin_netlist->num_internal_nodes++] = buf_node;
+                internal_nodes.push_back(buf_node);
 
                 vtr::free(output_pin_name);
             }
 
+        odin_netlist->internal_nodes = (nnode_t **)vtr::realloc(odin_netlist->internal_nodes,
+                                                                sizeof(nnode_t *) * (odin_netlist->num_internal_nodes + internal_nodes.size()));
+        for (nnode_t *node : internal_nodes) {
+            odin_netlist->internal_nodes[odin_netlist->num_internal_nodes++] = node;
+        }
+
         hook_up_nets(odin_netlist, output_nets_hash);
 
         delete output_nets_hash;
@@ -1157,6 +1160,9 @@ struct ParMYSPass : public Pass {
 
         free_netlist(transformed);
 
+        /* the cached hard block names point to the models of this architecture */
+        free_hard_block_names();
+
         if (Arch.models) {
             free_arch(&Arch);
             Arch.models = nullptr;
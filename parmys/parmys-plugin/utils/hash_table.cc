@@ -29,9 +29,9 @@ void Hashtable::destroy_free_items()
         vtr::free(kv.second);
 }
 
-void Hashtable::add(std::string key, void *item) { this->my_map.emplace(key, item); }
+void Hashtable::add(const std::string &key, void *item) { this->my_map.emplace(key, item); }
 
-void *Hashtable::remove(std::string key)
+void *Hashtable::remove(const std::string &key)
 {
     void *value = NULL;
     auto v = this->my_map.find(key);
@@ -42,7 +42,7 @@ void *Hashtable::remove(std::string key)
     return value;
 }
 
-void *Hashtable::get(std::string key)
+void *Hashtable::get(const std::string &key)
 {
     void *value = NULL;
     auto v = this->my_map.find(key);
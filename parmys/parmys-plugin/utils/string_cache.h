@@ -18,16 +18,26 @@
 #ifndef _STRING_CACHE_H_
 #define _STRING_CACHE_H_
 
+/*
+ * Strings are kept in insertion order in string[0..free-1] (with their data), and
+ * indexed by an open addressing hash table with linear probing. The hash of each
+ * string is kept, so lookups only compare strings with the same hash, and growing
+ * the table does not rehash the strings. The strings are stored in arena blocks.
+ */
 struct STRING_CACHE {
-    long size;
-    long string_hash_size;
-    long free;
-    long mod;
-    long mul;
+    long size; // capacity of string and data
+    long free; // number of strings
     char **string;
     void **data;
-    long *string_hash;
-    long *next_string;
+
+    long string_hash_size;      // number of slots, a power of two
+    long *slots;                // [0..string_hash_size-1] -> index of a string, or -1 if empty
+    unsigned long *string_hash; // [0..size-1] -> hash of the string
+
+    char **blocks; // arena blocks holding the strings
+    long num_blocks;
+    char *block_next; // first free byte of the last block
+    long block_free;  // bytes left in the last block
 };
 
 /* creates the hash where it is indexed by a string and the void ** holds the data */
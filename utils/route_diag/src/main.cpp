@@ -7,8 +7,14 @@
 // used.
 //
 // Tool can either perform one route between a source (--source_rr_node) and
-// a sink (--sink_rr_node), or profile a source to all tiles (set
-// --source_rr_node and "--profile_source true").
+// a sink (--sink_rr_node), profile a source to all tiles (set
+// --source_rr_node and "--profile_source true"), or replay the connections
+// captured by vpr --write_router_connection_capture (--replay_connections),
+// to benchmark the connection router with the selected --router_heap and
+// --router_lookahead. The replay needs the RR graph of the capture run,
+// i.e. the same architecture, circuit and --route_chan_width.
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
@@ -35,6 +41,7 @@
 #include "route_common.h"
 #include "route_timing.h"
 #include "route_export.h"
+#include "router_connection_capture.h"
 #include "rr_graph.h"
 #include "rr_graph2.h"
 #include "timing_place_lookup.h"
@@ -44,6 +51,8 @@ struct t_route_util_options {
     argparse::ArgValue<int> source_rr_node;
     argparse::ArgValue<int> sink_rr_node;
     argparse::ArgValue<bool> profile_source;
+    argparse::ArgValue<std::string> replay_connections;
+    argparse::ArgValue<int> replay_repeats;
 
     t_options options;
 };
@@ -99,6 +108,7 @@ static void do_one_route(const Netlist<>& net_list,
                                                   router_opts.write_router_lookahead,
                                                   router_opts.read_router_lookahead,
                                                   segment_inf,
+                                                  router_opts.lookahead_half_precision,
                                                   is_flat);
 
     ConnectionRouter<BinaryHeap> router(
@@ -165,6 +175,7 @@ static void profile_source(const Netlist<>& net_list,
                                                   router_opts.write_router_lookahead,
                                                   router_opts.read_router_lookahead,
                                                   segment_inf,
+                                                  router_opts.lookahead_half_precision,
                                                   is_flat);
     RouterDelayProfiler profiler(net_list, router_lookahead.get(), is_flat);
 
@@ -235,6 +246,138 @@ static void profile_source(const Netlist<>& net_list,
     VTR_LOG("\n");
 }
 
+// Returns the value below which the fraction p of the sorted values fall
+static float percentile(const std::vector<float>& sorted_values, float p) {
+    if (sorted_values.empty()) return 0.;
+    size_t index = std::min(sorted_values.size() - 1, size_t(p * sorted_values.size()));
+    return sorted_values[index];
+}
+
+static void replay_connections(const std::string& capture_file,
+                               int num_repeats,
+                               const t_det_routing_arch& det_routing_arch,
+                               const t_router_opts& router_opts,
+                               const std::vector<t_segment_inf>& segment_inf,
+                               bool is_flat) {
+    vtr::ScopedStartFinishTimer timer("Replaying connections");
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    router_capture::t_capture capture = router_capture::read_capture(capture_file);
+    if (capture.num_rr_nodes != device_ctx.rr_graph.num_nodes()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "'%s' - Captured for a RR graph of %u nodes, but the RR graph has %zu nodes"
+                        " (replay with the architecture, circuit and --route_chan_width of the capture run).\n",
+                        capture_file.c_str(), capture.num_rr_nodes, device_ctx.rr_graph.num_nodes());
+    }
+
+    update_rr_base_costs(1);
+
+    auto router_lookahead = make_router_lookahead(det_routing_arch,
+                                                  router_opts.lookahead_type,
+                                                  router_opts.write_router_lookahead,
+                                                  router_opts.read_router_lookahead,
+                                                  segment_inf,
+                                                  router_opts.lookahead_half_precision,
+                                                  is_flat);
+
+    if (router_opts.bidir_search_min_dist >= 0) {
+        g_vpr_ctx.mutable_device().rr_graph_builder.init_in_edges();
+    }
+
+    auto router = make_connection_router(router_opts.router_heap,
+                                         device_ctx.grid,
+                                         *router_lookahead,
+                                         device_ctx.rr_graph.rr_nodes(),
+                                         &device_ctx.rr_graph,
+                                         device_ctx.rr_rc_data,
+                                         device_ctx.rr_graph.rr_switch(),
+                                         route_ctx.rr_node_route_inf,
+                                         is_flat);
+    router->set_bidir_search_min_dist(router_opts.bidir_search_min_dist);
+
+    //Rebuild the route trees up front, so only the searches are timed
+    std::vector<RouteTree> trees;
+    {
+        t_rr_node_route_inf_storage scratch;
+        scratch.resize(device_ctx.rr_graph.num_nodes());
+        trees.reserve(capture.connections.size());
+        for (const auto& connection : capture.connections) {
+            trees.push_back(router_capture::build_route_tree(connection.tree, scratch, is_flat));
+        }
+    }
+
+    ConnectionParameters conn_params(ParentNetId::INVALID(),
+                                     -1,
+                                     false,
+                                     std::unordered_map<RRNodeId, int>());
+
+    RouterStats router_stats;
+    std::vector<float> latencies;
+    latencies.reserve(size_t(num_repeats) * capture.connections.size());
+    size_t num_unrouted = 0;
+    double search_time = 0.;
+
+    for (int repeat = 0; repeat < num_repeats; repeat++) {
+        size_t loaded_congestion = capture.congestion.size();
+        for (size_t iconn = 0; iconn < capture.connections.size(); iconn++) {
+            const auto& connection = capture.connections[iconn];
+            const auto& query = connection.query;
+            if (connection.congestion != loaded_congestion) {
+                router_capture::load_congestion(capture.congestion[connection.congestion], route_ctx.rr_node_route_inf);
+                loaded_congestion = connection.congestion;
+            }
+
+            t_conn_cost_params cost_params;
+            cost_params.criticality = query.criticality;
+            cost_params.astar_fac = query.astar_fac;
+            cost_params.bend_cost = query.bend_cost;
+            cost_params.pres_fac = query.pres_fac;
+
+            t_bb bounding_box;
+            bounding_box.xmin = query.xmin;
+            bounding_box.xmax = query.xmax;
+            bounding_box.ymin = query.ymin;
+            bounding_box.ymax = query.ymax;
+
+            auto start = std::chrono::steady_clock::now();
+            router->reset_path_costs();
+            bool found_path;
+            std::tie(found_path, std::ignore, std::ignore) = router->timing_driven_route_connection_from_route_tree(trees[iconn].root(),
+                                                                                                                      RRNodeId(query.sink_node),
+                                                                                                                      cost_params,
+                                                                                                                      bounding_box,
+                                                                                                                      router_stats,
+                                                                                                                      conn_params,
+                                                                                                                      false);
+            float latency = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+            latencies.push_back(latency);
+            search_time += latency;
+            if (!found_path && repeat == 0) {
+                ++num_unrouted;
+            }
+        }
+    }
+
+    size_t num_searches = latencies.size();
+    std::sort(latencies.begin(), latencies.end());
+
+    VTR_LOG("Replayed %zu connections (%zu congestion snapshots) %d time(s): %zu searches in %g s\n",
+            capture.connections.size(), capture.congestion.size(), num_repeats, num_searches, search_time);
+    if (num_unrouted) {
+        VTR_LOG_WARN("%zu captured connections found no path\n", num_unrouted);
+    }
+    if (num_searches == 0) return;
+
+    VTR_LOG("  Throughput: %g connections/s\n", num_searches / search_time);
+    VTR_LOG("  Heap pushes: %zu (%.1f per connection)\n", router_stats.heap_pushes, float(router_stats.heap_pushes) / num_searches);
+    VTR_LOG("  Heap pops: %zu (%.1f per connection)\n", router_stats.heap_pops, float(router_stats.heap_pops) / num_searches);
+    VTR_LOG("  Latency (us): p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+            1e6 * percentile(latencies, 0.5), 1e6 * percentile(latencies, 0.9),
+            1e6 * percentile(latencies, 0.99), 1e6 * latencies.back());
+}
+
 static t_chan_width setup_chan_width(t_router_opts router_opts,
         t_chan_width_dist chan_width_dist) {
     /*we give plenty of tracks, this increases routability for the */
@@ -282,6 +425,16 @@ t_route_util_options read_route_util_options(int argc, const char** argv) {
             "Profile routes from source to IPINs at all locations."
             "This is similiar to the placer delay matrix construction.")
         .show_in(argparse::ShowIn::HELP_ONLY);
+    route_diag_grp.add_argument(args.replay_connections, "--replay_connections")
+        .help(
+            "Replays the connections captured by vpr --write_router_connection_capture"
+            " and reports the router throughput, heap operations and latency percentiles.")
+        .metavar("CAPTURE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+    route_diag_grp.add_argument(args.replay_repeats, "--replay_repeats")
+        .help("Number of times the connections are replayed with --replay_connections.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
 
     parser.parse_args(argc, argv);
 
@@ -333,7 +486,14 @@ int main(int argc, const char **argv) {
             Arch.num_directs,
             is_flat);
 
-        if(route_options.profile_source) {
+        if (!route_options.replay_connections.value().empty()) {
+            replay_connections(route_options.replay_connections,
+                               route_options.replay_repeats,
+                               vpr_setup.RoutingArch,
+                               vpr_setup.RouterOpts,
+                               vpr_setup.Segments,
+                               is_flat);
+        } else if(route_options.profile_source) {
             profile_source(net_list,
                            vpr_setup.RoutingArch,
                            RRNodeId(route_options.source_rr_node),
@@ -12,12 +12,10 @@
 
 #include "VprTimingGraphResolver.h"
 
-void generate_setup_timing_stats(const std::string& prefix, const SetupTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
+static void write_setup_timing_reports(const std::string& prefix, const SetupTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
     auto& timing_ctx = g_vpr_ctx.timing();
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    print_setup_timing_summary(*timing_ctx.constraints, *timing_info.setup_analyzer(), "Final ", analysis_opts.write_timing_summary);
-
     VprTimingGraphResolver resolver(atom_ctx.nlist, atom_ctx.lookup, *timing_ctx.graph, delay_calc, is_flat);
     resolver.set_detail_level(analysis_opts.timing_report_detail);
 
@@ -32,12 +30,10 @@ void generate_setup_timing_stats(const std::string& prefix, const SetupTimingInf
     timing_reporter.report_unconstrained_setup(prefix + "report_unconstrained_timing.setup.rpt", *timing_info.setup_analyzer());
 }
 
-void generate_hold_timing_stats(const std::string& prefix, const HoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
+static void write_hold_timing_reports(const std::string& prefix, const HoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
     auto& timing_ctx = g_vpr_ctx.timing();
     auto& atom_ctx = g_vpr_ctx.atom();
 
-    print_hold_timing_summary(*timing_ctx.constraints, *timing_info.hold_analyzer(), "Final ");
-
     VprTimingGraphResolver resolver(atom_ctx.nlist, atom_ctx.lookup, *timing_ctx.graph, delay_calc, is_flat);
     resolver.set_detail_level(analysis_opts.timing_report_detail);
 
@@ -51,3 +47,33 @@ void generate_hold_timing_stats(const std::string& prefix, const HoldTimingInfo&
 
     timing_reporter.report_unconstrained_hold(prefix + "report_unconstrained_timing.hold.rpt", *timing_info.hold_analyzer());
 }
+
+void generate_setup_timing_stats(const std::string& prefix, const SetupTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+
+    print_setup_timing_summary(*timing_ctx.constraints, *timing_info.setup_analyzer(), "Final ", analysis_opts.write_timing_summary);
+
+    write_setup_timing_reports(prefix, timing_info, delay_calc, analysis_opts, is_flat);
+}
+
+void generate_hold_timing_stats(const std::string& prefix, const HoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+
+    print_hold_timing_summary(*timing_ctx.constraints, *timing_info.hold_analyzer(), "Final ");
+
+    write_hold_timing_reports(prefix, timing_info, delay_calc, analysis_opts, is_flat);
+}
+
+void generate_corner_timing_stats(const t_timing_corner& corner, const SetupHoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat) {
+    auto& timing_ctx = g_vpr_ctx.timing();
+
+    std::string summary_prefix = "Final " + corner.name + " corner ";
+    std::string report_prefix = corner.name + ".";
+
+    print_hold_timing_summary(*timing_ctx.constraints, *timing_info.hold_analyzer(), summary_prefix);
+    write_hold_timing_reports(report_prefix, timing_info, delay_calc, analysis_opts, is_flat);
+
+    //The timing summary file only describes the nominal corner
+    print_setup_timing_summary(*timing_ctx.constraints, *timing_info.setup_analyzer(), summary_prefix, /*summary_filename=*/"");
+    write_setup_timing_reports(report_prefix, timing_info, delay_calc, analysis_opts, is_flat);
+}
@@ -8,4 +8,7 @@
 void generate_setup_timing_stats(const std::string& prefix, const SetupTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& report_detail, bool is_flat);
 void generate_hold_timing_stats(const std::string& prefix, const HoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& report_detail, bool is_flat);
 
+///@brief Prints the setup and hold timing summaries of a --timing_corners corner, and writes its reports prefixed by the corner name
+void generate_corner_timing_stats(const t_timing_corner& corner, const SetupHoldTimingInfo& timing_info, const AnalysisDelayCalculator& delay_calc, const t_analysis_opts& analysis_opts, bool is_flat);
+
 #endif
@@ -12,6 +12,11 @@
 #include <regex>
 #include <limits>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/global_control.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vtr_assert.h"
 #include "vtr_math.h"
 #include "vtr_log.h"
@@ -26,13 +31,40 @@
 
 #define MAX_SIZE_FACTOR 10000
 
-using vtr::FormulaParser;
+using vtr::CompiledFormula;
 using vtr::t_formula_data;
 
+///@brief The compiled expressions of a grid location specification (t_grid_loc_def)
+struct t_grid_loc_def_formulas {
+    CompiledFormula startx;
+    CompiledFormula endx;
+    CompiledFormula incrx;
+    CompiledFormula repeatx;
+
+    CompiledFormula starty;
+    CompiledFormula endy;
+    CompiledFormula incry;
+    CompiledFormula repeaty;
+};
+
+///@brief [0..num_layers-1][0..num_loc_defs-1] The compiled expressions of the location specifications of a grid layout
+typedef std::vector<std::vector<t_grid_loc_def_formulas>> t_grid_def_formulas;
+
 static DeviceGrid auto_size_device_grid(const std::vector<t_grid_def>& grid_layouts, const std::map<t_logical_block_type_ptr, size_t>& minimum_instance_counts, float maximum_device_utilization);
 static std::vector<t_logical_block_type_ptr> grid_overused_resources(const DeviceGrid& grid, std::map<t_logical_block_type_ptr, size_t> instance_counts);
+static std::vector<t_logical_block_type_ptr> overused_resources(std::unordered_map<t_physical_tile_type_ptr, int> avail_tiles, std::map<t_logical_block_type_ptr, size_t> instance_counts);
+static bool grid_may_satisfy_instance_counts(const t_grid_def& grid_def, const t_grid_def_formulas& grid_def_formulas, size_t grid_width, size_t grid_height, const std::map<t_logical_block_type_ptr, size_t>& instance_counts);
+static size_t count_loc_positions(size_t start, size_t end, size_t incr, size_t repeat, size_t block_size, size_t grid_size);
 static bool grid_satisfies_instance_counts(const DeviceGrid& grid, std::map<t_logical_block_type_ptr, size_t> instance_counts, float maximum_utilization);
+static t_grid_def_formulas compile_grid_def_formulas(const t_grid_def& grid_def);
 static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t width, size_t height, bool warn_out_of_range = true, std::vector<t_logical_block_type_ptr> limiting_resources = std::vector<t_logical_block_type_ptr>());
+static DeviceGrid build_device_grid(const t_grid_def& grid_def,
+                                    const t_grid_def_formulas& grid_def_formulas,
+                                    size_t width,
+                                    size_t height,
+                                    bool warn_out_of_range,
+                                    std::vector<t_logical_block_type_ptr> limiting_resources,
+                                    bool quiet);
 
 static void CheckGrid(const DeviceGrid& grid);
 
@@ -43,7 +75,8 @@ static void set_grid_block_type(int priority,
                                 size_t y_root,
                                 vtr::NdMatrix<t_grid_tile, 3>& grid,
                                 vtr::NdMatrix<int, 3>& grid_priorities,
-                                const t_metadata_dict* meta);
+                                const t_metadata_dict* meta,
+                                bool quiet);
 
 ///@brief Create the device grid based on resource requirements
 DeviceGrid create_device_grid(std::string layout_name, const std::vector<t_grid_def>& grid_layouts, const std::map<t_logical_block_type_ptr, size_t>& minimum_instance_counts, float target_device_utilization) {
@@ -174,42 +207,89 @@ static DeviceGrid auto_size_device_grid(const std::vector<t_grid_def>& grid_layo
         const auto& grid_def = *auto_layout_itr;
         VTR_ASSERT(grid_def.aspect_ratio >= 0.);
 
+        //Compile the location expressions once for all the device sizes tried
+        t_grid_def_formulas grid_def_formulas = compile_grid_def_formulas(grid_def);
+
+        //Device sizes are tried in batches, in parallel. The smallest satisfying size of a batch is the
+        //one a one-by-one search finds, since all the smaller sizes were tried in this or earlier batches
+#ifdef VPR_USE_TBB
+        size_t batch_size = std::max<size_t>(1, tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+#else
+        size_t batch_size = 1;
+#endif
+
+        auto height_of = [&](size_t grid_width) -> size_t {
+            //Scale opposite dimension to match aspect ratio
+            return vtr::nint(grid_width / grid_def.aspect_ratio);
+        };
+
         //Initial size is num_layers x 3 x 3, the smallest possible while avoiding
         //start before end location issues with <perimeter> location
         //specifications
         size_t width = 3;
-        size_t height = 3;
         std::vector<t_logical_block_type_ptr> limiting_resources;
-        size_t grid_size = 0;
+        size_t limiting_width = 0; //The width limiting_resources were computed at (0 if none)
+        bool reached_max_size = false;
         do {
-            //Scale opposite dimension to match aspect ratio
-            height = vtr::nint(width / grid_def.aspect_ratio);
+            //The next widths to try, up to the first whose grid reaches the maximum size.
+            //Widths which can not hold enough blocks even if no location specifications
+            //overlapped are skipped without building their grid
+            std::vector<size_t> batch_widths;
+            while (batch_widths.size() < batch_size && !reached_max_size) {
+                if (grid_may_satisfy_instance_counts(grid_def, grid_def_formulas, width, height_of(width), minimum_instance_counts)) {
+                    batch_widths.push_back(width);
+                }
+                reached_max_size = (width * height_of(width) >= max_size);
+                width++;
+            }
 
+            std::vector<char> batch_satisfied(batch_widths.size(), false);
+            std::vector<std::vector<t_logical_block_type_ptr>> batch_overused_resources(batch_widths.size());
+            auto try_size = [&](size_t i) {
 #ifdef VERBOSE
-            VTR_LOG("Grid size: %zu x %zu (AR: %.2f) \n", width, height, float(width) / height);
+                VTR_LOG("Grid size: %zu x %zu (AR: %.2f) \n", batch_widths[i], height_of(batch_widths[i]), float(batch_widths[i]) / height_of(batch_widths[i]));
 #endif
 
-            //Build the device
-            // Don't warn about out-of-range specifications since these can
-            // occur (harmlessly) at small device dimensions
-            grid = build_device_grid(grid_def, width, height, false, limiting_resources);
-
-            //Check if it satisfies the block counts
-            if (grid_satisfies_instance_counts(grid, minimum_instance_counts, maximum_device_utilization)) {
-                //Re-build the grid at the final size with out-of-range
-                grid = build_device_grid(grid_def, width, height, false, limiting_resources);
-                return grid;
+                //Build the device
+                // Don't warn about out-of-range specifications since these can
+                // occur (harmlessly) at small device dimensions, nor about anything
+                // else (the grid of the final size is re-built with its warnings)
+                DeviceGrid candidate_grid = build_device_grid(grid_def, grid_def_formulas, batch_widths[i], height_of(batch_widths[i]),
+                                                              false, std::vector<t_logical_block_type_ptr>(), /*quiet=*/true);
+
+                //Check if it satisfies the block counts
+                batch_satisfied[i] = grid_satisfies_instance_counts(candidate_grid, minimum_instance_counts, maximum_device_utilization);
+                if (!batch_satisfied[i]) {
+                    batch_overused_resources[i] = grid_overused_resources(candidate_grid, minimum_instance_counts);
+                }
+            };
+#ifdef VPR_USE_TBB
+            tbb::parallel_for(size_t(0), batch_widths.size(), try_size);
+#else
+            for (size_t i = 0; i < batch_widths.size(); ++i) {
+                try_size(i);
             }
+#endif
 
-            limiting_resources = grid_overused_resources(grid, minimum_instance_counts);
-
-            //Determine grid size
-            grid_size = width * height;
-
-            //Increase the grid size
-            width++;
-
-        } while (grid_size < max_size);
+            for (size_t i = 0; i < batch_widths.size(); ++i) {
+                size_t final_width = batch_widths[i];
+                if (batch_satisfied[i]) {
+                    //Re-build the grid at the final size, limited by the resources of the previous size
+                    if (final_width == 3) {
+                        limiting_resources.clear();
+                    } else if (limiting_width != final_width - 1) {
+                        //The previous size was skipped
+                        DeviceGrid previous_grid = build_device_grid(grid_def, grid_def_formulas, final_width - 1, height_of(final_width - 1),
+                                                                     false, std::vector<t_logical_block_type_ptr>(), /*quiet=*/true);
+                        limiting_resources = grid_overused_resources(previous_grid, minimum_instance_counts);
+                    }
+                    return build_device_grid(grid_def, grid_def_formulas, final_width, height_of(final_width),
+                                             false, limiting_resources, /*quiet=*/false);
+                }
+                limiting_resources = std::move(batch_overused_resources[i]);
+                limiting_width = final_width;
+            }
+        } while (!reached_max_size);
 
         //Maximum device size reached
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
@@ -265,20 +345,25 @@ static DeviceGrid auto_size_device_grid(const std::vector<t_grid_def>& grid_layo
 static std::vector<t_logical_block_type_ptr> grid_overused_resources(const DeviceGrid& grid, std::map<t_logical_block_type_ptr, size_t> instance_counts) {
     auto& device_ctx = g_vpr_ctx.device();
 
-    std::vector<t_logical_block_type_ptr> overused_resources;
-
-    std::unordered_map<t_physical_tile_type_ptr, size_t> min_count_map;
-    // Initialize min_count_map
-    for (const auto& tile_type : device_ctx.physical_tile_types) {
-        min_count_map.insert(std::make_pair(&tile_type, size_t(0)));
-    }
-
     //Initialize available tile counts
     std::unordered_map<t_physical_tile_type_ptr, int> avail_tiles;
     for (auto& tile_type : device_ctx.physical_tile_types) {
         avail_tiles[&tile_type] = grid.num_instances(&tile_type, -1);
     }
 
+    return overused_resources(avail_tiles, instance_counts);
+}
+
+/**
+ * @brief Estimates what logical block types will be unimplementable with avail_tiles tiles of each type
+ *
+ * Having more tiles of any type never makes more logical block types unimplementable.
+ */
+static std::vector<t_logical_block_type_ptr> overused_resources(std::unordered_map<t_physical_tile_type_ptr, int> avail_tiles, std::map<t_logical_block_type_ptr, size_t> instance_counts) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    std::vector<t_logical_block_type_ptr> overused_resources;
+
     //Sort so we allocate logical blocks with the fewest equivalent sites first (least flexible)
     std::vector<const t_logical_block_type*> logical_block_types;
     for (auto& block_type : device_ctx.logical_block_types) {
@@ -316,6 +401,82 @@ static std::vector<t_logical_block_type_ptr> grid_overused_resources(const Devic
     return overused_resources;
 }
 
+/**
+ * @brief Returns false if a grid_width x grid_height grid of grid_def can not satisfy the instance counts
+ *
+ * Counts, from the location specifications alone, the instances each specification would create if no other
+ * specification overlapped it. These counts can only exceed those of the actual grid (overlapping
+ * specifications remove instances), so if even they are not enough, neither is the grid, which need not be built.
+ */
+static bool grid_may_satisfy_instance_counts(const t_grid_def& grid_def, const t_grid_def_formulas& grid_def_formulas, size_t grid_width, size_t grid_height, const std::map<t_logical_block_type_ptr, size_t>& instance_counts) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    std::unordered_map<t_physical_tile_type_ptr, int> avail_tiles;
+    for (auto& tile_type : device_ctx.physical_tile_types) {
+        avail_tiles[&tile_type] = 0;
+    }
+
+    for (size_t layer = 0; layer < grid_def.layers.size(); layer++) {
+        const auto& loc_defs = grid_def.layers[layer].loc_defs;
+        for (size_t iloc_def = 0; iloc_def < loc_defs.size(); iloc_def++) {
+            auto type = find_tile_type_by_name(loc_defs[iloc_def].block_type, device_ctx.physical_tile_types);
+            if (!type) {
+                return true; //Reported when the grid is built
+            }
+            const t_grid_loc_def_formulas& formulas = grid_def_formulas[layer][iloc_def];
+
+            t_formula_data vars;
+            vars.set_var_value("W", grid_width);
+            vars.set_var_value("H", grid_height);
+            vars.set_var_value("w", type->width);
+            vars.set_var_value("h", type->height);
+
+            size_t num_x = count_loc_positions(formulas.startx.evaluate(vars), formulas.endx.evaluate(vars),
+                                               formulas.incrx.evaluate(vars), formulas.repeatx.evaluate(vars),
+                                               type->width, grid_width);
+            size_t num_y = count_loc_positions(formulas.starty.evaluate(vars), formulas.endy.evaluate(vars),
+                                               formulas.incry.evaluate(vars), formulas.repeaty.evaluate(vars),
+                                               type->height, grid_height);
+
+            size_t num_instances = num_x * num_y;
+            if (num_x == size_t(-1) || num_y == size_t(-1) || num_instances > size_t(std::numeric_limits<int>::max() - avail_tiles[type])) {
+                return true; //Invalid (reported when the grid is built) or more than enough
+            }
+            avail_tiles[type] += num_instances;
+        }
+    }
+
+    return overused_resources(avail_tiles, instance_counts).empty();
+}
+
+/**
+ * @brief Returns the number of positions at which build_device_grid() places a block of size block_size
+ *        along one dimension of size grid_size, for the location specification start/end/incr/repeat
+ *
+ * Returns size_t(-1) if the specification is invalid.
+ */
+static size_t count_loc_positions(size_t start, size_t end, size_t incr, size_t repeat, size_t block_size, size_t grid_size) {
+    if (start > grid_size - 1) {
+        return 0; //No instances will be created
+    }
+    if (end < start || incr < block_size || repeat < end - start + 1 || incr == 0) {
+        return size_t(-1);
+    }
+
+    size_t num_positions = 0;
+    size_t region_end = 0;
+    for (size_t k = 0; region_end < grid_size; ++k) { //Repeats
+        size_t region_start = start + k * repeat;
+        region_end = end + k * repeat;
+
+        size_t max_pos = std::min(region_end, grid_size - 1);
+        if (region_start + (block_size - 1) <= max_pos) {
+            num_positions += (max_pos - (block_size - 1) - region_start) / incr + 1;
+        }
+    }
+    return num_positions;
+}
+
 static bool grid_satisfies_instance_counts(const DeviceGrid& grid, std::map<t_logical_block_type_ptr, size_t> instance_counts, float maximum_utilization) {
     //Are the resources satisified?
     auto overused_resources = grid_overused_resources(grid, instance_counts);
@@ -334,8 +495,60 @@ static bool grid_satisfies_instance_counts(const DeviceGrid& grid, std::map<t_lo
     return true; //OK
 }
 
+///@brief Compiles the expressions of the location specifications of grid_def
+static t_grid_def_formulas compile_grid_def_formulas(const t_grid_def& grid_def) {
+    t_grid_def_formulas grid_def_formulas(grid_def.layers.size());
+    for (size_t layer = 0; layer < grid_def.layers.size(); layer++) {
+        for (const auto& grid_loc_def : grid_def.layers[layer].loc_defs) {
+            auto& xspec = grid_loc_def.x;
+            auto& yspec = grid_loc_def.y;
+
+            VTR_ASSERT_MSG(!xspec.start_expr.empty(), "x start position must be specified");
+            VTR_ASSERT_MSG(!xspec.end_expr.empty(), "x end position must be specified");
+            VTR_ASSERT_MSG(!xspec.incr_expr.empty(), "x increment must be specified");
+            VTR_ASSERT_MSG(!xspec.repeat_expr.empty(), "x repeat must be specified");
+
+            VTR_ASSERT_MSG(!yspec.start_expr.empty(), "y start position must be specified");
+            VTR_ASSERT_MSG(!yspec.end_expr.empty(), "y end position must be specified");
+            VTR_ASSERT_MSG(!yspec.incr_expr.empty(), "y increment must be specified");
+            VTR_ASSERT_MSG(!yspec.repeat_expr.empty(), "y repeat must be specified");
+
+            t_grid_loc_def_formulas formulas;
+            formulas.startx = CompiledFormula(xspec.start_expr);
+            formulas.endx = CompiledFormula(xspec.end_expr);
+            formulas.incrx = CompiledFormula(xspec.incr_expr);
+            formulas.repeatx = CompiledFormula(xspec.repeat_expr);
+
+            formulas.starty = CompiledFormula(yspec.start_expr);
+            formulas.endy = CompiledFormula(yspec.end_expr);
+            formulas.incry = CompiledFormula(yspec.incr_expr);
+            formulas.repeaty = CompiledFormula(yspec.repeat_expr);
+
+            grid_def_formulas[layer].push_back(std::move(formulas));
+        }
+    }
+    return grid_def_formulas;
+}
+
 ///@brief Build the specified device grid
 static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t grid_width, size_t grid_height, bool warn_out_of_range, const std::vector<t_logical_block_type_ptr> limiting_resources) {
+    return build_device_grid(grid_def, compile_grid_def_formulas(grid_def), grid_width, grid_height, warn_out_of_range, limiting_resources, /*quiet=*/false);
+}
+
+/**
+ * @brief Build the specified device grid, with the compiled expressions of its location specifications
+ *
+ * If quiet is set no warning is logged (which also allows building several grids in parallel).
+ */
+static DeviceGrid build_device_grid(const t_grid_def& grid_def,
+                                    const t_grid_def_formulas& grid_def_formulas,
+                                    size_t grid_width,
+                                    size_t grid_height,
+                                    bool warn_out_of_range,
+                                    const std::vector<t_logical_block_type_ptr> limiting_resources,
+                                    bool quiet) {
+    warn_out_of_range &= !quiet;
+
     if (grid_def.grid_type == GridDefType::FIXED) {
         if (grid_def.width != int(grid_width) || grid_def.height != int(grid_height)) {
             VPR_FATAL_ERROR(VPR_ERROR_OTHER,
@@ -366,15 +579,19 @@ static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t grid_widt
                                     empty_type,
                                     layer, x, y,
                                     grid, grid_priorities,
-                                    /*meta=*/nullptr);
+                                    /*meta=*/nullptr,
+                                    quiet);
             }
         }
     }
 
-    FormulaParser p;
     std::set<t_physical_tile_type_ptr> seen_types;
     for (int layer = 0; layer < num_layers; layer++) {
-        for (const auto& grid_loc_def : grid_def.layers.at(layer).loc_defs) {
+        const auto& loc_defs = grid_def.layers.at(layer).loc_defs;
+        for (size_t iloc_def = 0; iloc_def < loc_defs.size(); iloc_def++) {
+            const auto& grid_loc_def = loc_defs[iloc_def];
+            const t_grid_loc_def_formulas& formulas = grid_def_formulas[layer][iloc_def];
+
             //Fill in the block types according to the specification
             auto type = find_tile_type_by_name(grid_loc_def.block_type, device_ctx.physical_tile_types);
 
@@ -395,28 +612,18 @@ static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t grid_widt
             //Load the x specification
             auto& xspec = grid_loc_def.x;
 
-            VTR_ASSERT_MSG(!xspec.start_expr.empty(), "x start position must be specified");
-            VTR_ASSERT_MSG(!xspec.end_expr.empty(), "x end position must be specified");
-            VTR_ASSERT_MSG(!xspec.incr_expr.empty(), "x increment must be specified");
-            VTR_ASSERT_MSG(!xspec.repeat_expr.empty(), "x repeat must be specified");
-
-            size_t startx = p.parse_formula(xspec.start_expr, vars);
-            size_t endx = p.parse_formula(xspec.end_expr, vars);
-            size_t incrx = p.parse_formula(xspec.incr_expr, vars);
-            size_t repeatx = p.parse_formula(xspec.repeat_expr, vars);
+            size_t startx = formulas.startx.evaluate(vars);
+            size_t endx = formulas.endx.evaluate(vars);
+            size_t incrx = formulas.incrx.evaluate(vars);
+            size_t repeatx = formulas.repeatx.evaluate(vars);
 
             //Load the y specification
             auto& yspec = grid_loc_def.y;
 
-            VTR_ASSERT_MSG(!yspec.start_expr.empty(), "y start position must be specified");
-            VTR_ASSERT_MSG(!yspec.end_expr.empty(), "y end position must be specified");
-            VTR_ASSERT_MSG(!yspec.incr_expr.empty(), "y increment must be specified");
-            VTR_ASSERT_MSG(!yspec.repeat_expr.empty(), "y repeat must be specified");
-
-            size_t starty = p.parse_formula(yspec.start_expr, vars);
-            size_t endy = p.parse_formula(yspec.end_expr, vars);
-            size_t incry = p.parse_formula(yspec.incr_expr, vars);
-            size_t repeaty = p.parse_formula(yspec.repeat_expr, vars);
+            size_t starty = formulas.starty.evaluate(vars);
+            size_t endy = formulas.endy.evaluate(vars);
+            size_t incry = formulas.incry.evaluate(vars);
+            size_t repeaty = formulas.repeaty.evaluate(vars);
 
             //Check start against the device dimensions
             // Start locations outside the device will never create block instances
@@ -523,7 +730,8 @@ static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t grid_widt
                                                 type,
                                                 layer, x, y,
                                                 grid, grid_priorities,
-                                                grid_loc_def.meta);
+                                                grid_loc_def.meta,
+                                                quiet);
                         }
                     }
                 }
@@ -535,7 +743,7 @@ static DeviceGrid build_device_grid(const t_grid_def& grid_def, size_t grid_widt
     for (auto const& type : device_ctx.physical_tile_types) {
         if (&type == empty_type) continue; //Don't worry if empty hasn't been specified
 
-        if (!seen_types.count(&type)) {
+        if (!seen_types.count(&type) && !quiet) {
             VTR_LOG_WARN("Block type '%s' was not specified in device grid layout\n",
                          type.name);
         }
@@ -555,7 +763,8 @@ static void set_grid_block_type(int priority,
                                 size_t y_root,
                                 vtr::NdMatrix<t_grid_tile, 3>& grid,
                                 vtr::NdMatrix<int, 3>& grid_priorities,
-                                const t_metadata_dict* meta) {
+                                const t_metadata_dict* meta,
+                                bool quiet) {
     struct TypeLocation {
         TypeLocation(size_t x_val, size_t y_val, const t_physical_tile_type* type_val, int priority_val)
             : x(x_val)
@@ -599,7 +808,7 @@ static void set_grid_block_type(int priority,
         return;
     }
 
-    if (priority == max_priority_type_loc.priority) {
+    if (priority == max_priority_type_loc.priority && !quiet) {
         //Ambiguous case where current grid block and new specification have equal priority
         //
         //We arbitrarily decide to take the 'last applied' wins approach, and warn the user
@@ -807,6 +1016,60 @@ float calculate_device_utilization(const DeviceGrid& grid, std::map<t_logical_bl
     return utilization;
 }
 
+DeviceGrid crop_device_grid(const DeviceGrid& grid, vtr::Rect<int> region, t_grid_crop& crop) {
+    int xmin = std::max(region.xmin(), 0);
+    int ymin = std::max(region.ymin(), 0);
+    int xmax = std::min(region.xmax(), int(grid.width()) - 1);
+    int ymax = std::min(region.ymax(), int(grid.height()) - 1);
+    VTR_ASSERT(xmin <= xmax && ymin <= ymax);
+
+    //Grow the region until it covers every tile it overlaps
+    bool grown = true;
+    while (grown) {
+        grown = false;
+        for (int layer_num = 0; layer_num < grid.get_num_layers(); ++layer_num) {
+            for (int x = xmin; x <= xmax; ++x) {
+                for (int y = ymin; y <= ymax; ++y) {
+                    t_physical_tile_loc tile_loc(x, y, layer_num);
+                    auto type = grid.get_physical_type(tile_loc);
+                    int root_x = x - grid.get_width_offset(tile_loc);
+                    int root_y = y - grid.get_height_offset(tile_loc);
+                    int top_x = root_x + type->width - 1;
+                    int top_y = root_y + type->height - 1;
+                    if (root_x < xmin || root_y < ymin || top_x > xmax || top_y > ymax) {
+                        xmin = std::min(xmin, root_x);
+                        ymin = std::min(ymin, root_y);
+                        xmax = std::max(xmax, top_x);
+                        ymax = std::max(ymax, top_y);
+                        grown = true;
+                    }
+                }
+            }
+        }
+    }
+
+    vtr::NdMatrix<t_grid_tile, 3> cropped_grid({size_t(grid.get_num_layers()), size_t(xmax - xmin + 1), size_t(ymax - ymin + 1)});
+    for (int layer_num = 0; layer_num < grid.get_num_layers(); ++layer_num) {
+        for (int x = xmin; x <= xmax; ++x) {
+            for (int y = ymin; y <= ymax; ++y) {
+                t_physical_tile_loc tile_loc(x, y, layer_num);
+                t_grid_tile& tile = cropped_grid[layer_num][x - xmin][y - ymin];
+                tile.type = grid.get_physical_type(tile_loc);
+                tile.width_offset = grid.get_width_offset(tile_loc);
+                tile.height_offset = grid.get_height_offset(tile_loc);
+                tile.meta = grid.get_metadata(tile_loc);
+            }
+        }
+    }
+
+    crop.x_offset = xmin;
+    crop.y_offset = ymin;
+    crop.full_width = grid.width();
+    crop.full_height = grid.height();
+
+    return DeviceGrid(grid.name(), cropped_grid, grid.limiting_resources());
+}
+
 size_t count_grid_tiles(const DeviceGrid& grid) {
     return grid.get_num_layers() * grid.width() * grid.height();
 }
@@ -10,7 +10,9 @@
  */
 
 #include <vector>
+#include "vtr_geometry.h"
 #include "physical_types.h"
+#include "vpr_types.h"
 
 ///@brief Find the device satisfying the specified minimum resources
 DeviceGrid create_device_grid(std::string layout_name,
@@ -21,6 +23,14 @@ DeviceGrid create_device_grid(std::string layout_name,
 ///@brief Find the device close in size to the specified dimensions
 DeviceGrid create_device_grid(std::string layout_name, const std::vector<t_grid_def>& grid_layouts, size_t min_width, size_t min_height);
 
+/**
+ * @brief Returns the part of grid covering region (inclusive bounds, clamped to the grid)
+ *
+ * The region is grown so that no tile straddles its edges. Sets crop to the location
+ * of the returned grid within grid.
+ */
+DeviceGrid crop_device_grid(const DeviceGrid& grid, vtr::Rect<int> region, t_grid_crop& crop);
+
 /**
  * @brief Calculate the device utilization
  *
@@ -2,6 +2,8 @@
 #include <vector>
 #include <sstream>
 #include <list>
+#include <filesystem>
+#include <type_traits>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
@@ -9,6 +11,8 @@
 #include "vtr_log.h"
 #include "vtr_memory.h"
 #include "vtr_time.h"
+#include "vtr_digest.h"
+#include "vtr_version.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -27,6 +31,7 @@
 #include "echo_files.h"
 #include "clock_modeling.h"
 #include "ShowSetup.h"
+#include "flow_checkpoint.h"
 
 static void SetupNetlistOpts(const t_options& Options, t_netlist_opts& NetlistOpts);
 static void SetupPackerOpts(const t_options& Options,
@@ -46,6 +51,16 @@ static void SetupSwitches(const t_arch& Arch,
                           int NumArchSwitches);
 static void SetupAnalysisOpts(const t_options& Options, t_analysis_opts& analysis_opts);
 static void SetupPowerOpts(const t_options& Options, t_power_opts* power_opts, t_arch* Arch);
+static void SetupCacheFiles(const t_options& Options,
+                            t_file_name_opts* FileNameOpts,
+                            t_det_routing_arch* RoutingArch,
+                            t_router_opts* RouterOpts,
+                            t_placer_opts* PlacerOpts);
+static void SetupFlowCheckpoint(const t_options& Options,
+                                t_file_name_opts* FileNameOpts,
+                                t_packer_opts* PackerOpts,
+                                t_placer_opts* PlacerOpts,
+                                t_router_opts* RouterOpts);
 
 /**
  * @brief Identify which switch must be used for *track* to *IPIN* connections based on architecture file specification.
@@ -136,6 +151,7 @@ void SetupVPR(const t_options* Options,
     FileNameOpts->write_block_usage = Options->write_block_usage;
 
     FileNameOpts->verify_file_digests = Options->verify_file_digests;
+    FileNameOpts->fork_jobs_file = Options->fork_jobs;
 
     SetupNetlistOpts(*Options, *NetlistOpts);
     SetupPlacerOpts(*Options, PlacerOpts);
@@ -227,6 +243,8 @@ void SetupVPR(const t_options* Options,
     SetupPackerOpts(*Options, PackerOpts);
     RoutingArch->write_rr_graph_filename = Options->write_rr_graph_file;
     RoutingArch->read_rr_graph_filename = Options->read_rr_graph_file;
+    RoutingArch->read_rr_graph_is_cached = false;
+    SetupCacheFiles(*Options, FileNameOpts, RoutingArch, RouterOpts, PlacerOpts);
 
     for (auto has_global_routing : Arch->layer_global_routing) {
         device_ctx.inter_cluster_prog_routing_resources.emplace_back(has_global_routing);
@@ -273,6 +291,8 @@ void SetupVPR(const t_options* Options,
         }
     }
 
+    SetupFlowCheckpoint(*Options, FileNameOpts, PackerOpts, PlacerOpts, RouterOpts);
+
     ShowSetup(*vpr_setup);
 
     /* init global variables */
@@ -284,7 +304,16 @@ void SetupVPR(const t_options* Options,
     {
         vtr::ScopedStartFinishTimer t("Building complex block graph");
         alloc_and_load_all_pb_graphs(PowerOpts->do_power, RouterOpts->flat_routing);
-        *PackerRRGraphs = alloc_and_load_all_lb_type_rr_graph();
+
+        //The pb graphs point into the architecture's pb types, so only the routing graphs built on them are cached
+        if (!FileNameOpts->read_lb_type_rr_graphs_file.empty()) {
+            *PackerRRGraphs = read_lb_type_rr_graphs(FileNameOpts->read_lb_type_rr_graphs_file);
+        } else {
+            *PackerRRGraphs = alloc_and_load_all_lb_type_rr_graph();
+            if (!FileNameOpts->write_lb_type_rr_graphs_file.empty()) {
+                write_lb_type_rr_graphs(FileNameOpts->write_lb_type_rr_graphs_file, *PackerRRGraphs);
+            }
+        }
     }
 
     if (RouterOpts->flat_routing) {
@@ -319,6 +348,256 @@ void SetupVPR(const t_options* Options,
     }
 }
 
+template<typename T>
+static void add_cache_key_option(std::ostream& key, const argparse::ArgValue<T>& option) {
+    key << option.argument_name() << "=";
+    if constexpr (std::is_enum<T>::value) {
+        key << static_cast<int>(option.value());
+    } else {
+        key << option.value();
+    }
+    key << "\n";
+}
+
+///@brief Returns the name of the cache file holding the artifact described by key
+static std::string get_cache_file_name(const std::string& cache_dir, const char* artifact, const std::stringstream& key, const char* extension) {
+    std::stringstream key_stream(key.str());
+    std::string digest = vtr::secure_digest_stream(key_stream);
+    digest = digest.substr(digest.find(':') + 1); //Drop the hash type prefix, which isn't valid in file names
+
+    return (std::filesystem::path(cache_dir) / (std::string(artifact) + "_" + digest + extension)).string();
+}
+
+void SetupVprJobOpts(const t_options& Options, t_vpr_setup* vpr_setup) {
+    //The stages to run and the cached artifacts were set up (and may already be loaded) for the original options
+    const t_placer_opts old_placer_opts = vpr_setup->PlacerOpts;
+    const t_router_opts old_router_opts = vpr_setup->RouterOpts;
+    const e_stage_action old_do_analysis = vpr_setup->AnalysisOpts.doAnalysis;
+
+    SetupPlacerOpts(Options, &vpr_setup->PlacerOpts);
+    SetupAnnealSched(Options, &vpr_setup->AnnealSched);
+    SetupRouterOpts(Options, &vpr_setup->RouterOpts);
+    SetupAnalysisOpts(Options, vpr_setup->AnalysisOpts);
+
+    vpr_setup->PlacerOpts.doPlacement = old_placer_opts.doPlacement;
+    vpr_setup->PlacerOpts.read_placement_delay_lookup = old_placer_opts.read_placement_delay_lookup;
+    vpr_setup->PlacerOpts.write_placement_delay_lookup = old_placer_opts.write_placement_delay_lookup;
+    vpr_setup->RouterOpts.doRouting = old_router_opts.doRouting;
+    vpr_setup->RouterOpts.read_router_lookahead = old_router_opts.read_router_lookahead;
+    vpr_setup->RouterOpts.write_router_lookahead = old_router_opts.write_router_lookahead;
+    vpr_setup->AnalysisOpts.doAnalysis = old_do_analysis;
+
+    t_file_name_opts& file_name_opts = vpr_setup->FileNameOpts;
+    file_name_opts.PlaceFile = Options.PlaceFile;
+    file_name_opts.RouteFile = Options.RouteFile;
+    file_name_opts.PowerFile = Options.PowerFile;
+    file_name_opts.out_file_prefix = Options.out_file_prefix;
+    file_name_opts.write_vpr_constraints_file = Options.write_vpr_constraints_file;
+    file_name_opts.write_block_usage = Options.write_block_usage;
+
+    vtr::out_file_prefix = Options.out_file_prefix;
+
+    vtr::srandom(vpr_setup->PlacerOpts.seed);
+}
+
+/**
+ * @brief Reads cache_file into read_file if it exists, otherwise arranges for the artifact to be written to the cache
+ *
+ * Artifacts are first written to a per-process temporary file and only moved to cache_file at the end
+ * of the flow, so concurrent runs sharing a cache never read a partially written file. Files given
+ * explicitly on the command line take precedence over the cache.
+ */
+static void setup_cache_file(const std::string& cache_file, std::string& read_file, std::string& write_file, t_file_name_opts* FileNameOpts) {
+    if (!read_file.empty()) {
+        return;
+    }
+
+    if (vtr::file_exists(cache_file.c_str())) {
+        read_file = cache_file;
+    } else if (write_file.empty()) {
+        write_file = cache_file + ".tmp" + std::to_string(vtr::get_pid()) + std::filesystem::path(cache_file).extension().string();
+        FileNameOpts->cache_files_to_commit.emplace_back(write_file, cache_file);
+    }
+}
+
+/**
+ * @brief Points the intra-cluster routing graph, rr graph, router lookahead and placement delay model files
+ *        at the --cache_dir cache
+ *
+ * Each artifact is named after a digest of the inputs it is computed from (architecture file,
+ * channel width and relevant options), so that later runs with identical inputs reuse it.
+ */
+static void SetupCacheFiles(const t_options& Options,
+                            t_file_name_opts* FileNameOpts,
+                            t_det_routing_arch* RoutingArch,
+                            t_router_opts* RouterOpts,
+                            t_placer_opts* PlacerOpts) {
+    FileNameOpts->cache_dir = Options.cache_dir;
+    if (FileNameOpts->cache_dir.empty()) {
+        return;
+    }
+
+#ifndef VTR_ENABLE_CAPNPROTO
+    VTR_LOG_WARN("--cache_dir requires VPR to be built with Cap'n Proto support (VTR_ENABLE_CAPNPROTO), ignoring it\n");
+    FileNameOpts->cache_dir.clear();
+    return;
+#endif
+
+    std::error_code ec;
+    std::filesystem::create_directories(FileNameOpts->cache_dir, ec);
+    if (ec) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to create cache directory '%s': %s\n", FileNameOpts->cache_dir.c_str(), ec.message().c_str());
+    }
+
+    //The intra-cluster routing graphs only depend on the architecture
+    std::stringstream arch_key;
+    arch_key << "vtr_version=" << vtr::VERSION << "\n";
+    arch_key << "arch_file=" << vtr::secure_digest_file(Options.ArchFile) << "\n";
+    add_cache_key_option(arch_key, Options.arch_format);
+
+    setup_cache_file(get_cache_file_name(FileNameOpts->cache_dir, "lb_type_rr_graphs", arch_key, ".capnp"),
+                     FileNameOpts->read_lb_type_rr_graphs_file, FileNameOpts->write_lb_type_rr_graphs_file, FileNameOpts);
+
+    //The cleaned atom netlist depends on the circuit, its architecture models and the netlist cleaning options
+    if (vtr::file_exists(Options.CircuitFile.value().c_str())) {
+        std::stringstream atom_netlist_key;
+        atom_netlist_key << arch_key.str();
+        atom_netlist_key << "circuit_file=" << vtr::secure_digest_file(Options.CircuitFile) << "\n";
+        add_cache_key_option(atom_netlist_key, Options.circuit_format);
+        add_cache_key_option(atom_netlist_key, Options.absorb_buffer_luts);
+        add_cache_key_option(atom_netlist_key, Options.const_gen_inference);
+        add_cache_key_option(atom_netlist_key, Options.sweep_dangling_primary_ios);
+        add_cache_key_option(atom_netlist_key, Options.sweep_dangling_nets);
+        add_cache_key_option(atom_netlist_key, Options.sweep_dangling_blocks);
+        add_cache_key_option(atom_netlist_key, Options.sweep_constant_primary_outputs);
+
+        setup_cache_file(get_cache_file_name(FileNameOpts->cache_dir, "atom_netlist", atom_netlist_key, ".capnp"),
+                         FileNameOpts->read_atom_netlist_snapshot_file, FileNameOpts->write_atom_netlist_snapshot_file, FileNameOpts);
+    }
+
+    //The other cached artifacts are only valid for a single channel width, which must not change during the flow
+    if (RouterOpts->fixed_channel_width == NO_FIXED_CHANNEL_WIDTH || PlacerOpts->place_chan_width != RouterOpts->fixed_channel_width) {
+        VTR_LOG_WARN("--cache_dir requires placement and routing to use the same fixed channel width (--route_chan_width) to cache routing artifacts\n");
+        return;
+    }
+
+    if (RouterOpts->flat_routing) {
+        VTR_LOG_WARN("--cache_dir does not cache routing artifacts with flat routing\n");
+        return;
+    }
+
+    //Inputs of the rr graph
+    std::stringstream rr_graph_key;
+    rr_graph_key << arch_key.str();
+    if (!RoutingArch->read_rr_graph_filename.empty()) {
+        rr_graph_key << "read_rr_graph=" << vtr::secure_digest_file(RoutingArch->read_rr_graph_filename) << "\n";
+    }
+    add_cache_key_option(rr_graph_key, Options.device_layout);
+    add_cache_key_option(rr_graph_key, Options.crop_device_to_floorplan);
+    if (Options.crop_device_to_floorplan) {
+        rr_graph_key << "read_vpr_constraints=" << vtr::secure_digest_file(Options.read_vpr_constraints_file) << "\n";
+        add_cache_key_option(rr_graph_key, Options.crop_device_margin);
+    }
+    add_cache_key_option(rr_graph_key, Options.RouteChanWidth);
+    add_cache_key_option(rr_graph_key, Options.RouteType);
+    add_cache_key_option(rr_graph_key, Options.base_cost_type);
+    add_cache_key_option(rr_graph_key, Options.clock_modeling);
+    add_cache_key_option(rr_graph_key, Options.two_stage_clock_routing);
+    add_cache_key_option(rr_graph_key, Options.reorder_rr_graph_nodes_algorithm);
+    add_cache_key_option(rr_graph_key, Options.reorder_rr_graph_nodes_threshold);
+    add_cache_key_option(rr_graph_key, Options.reorder_rr_graph_nodes_seed);
+
+    //The lookahead is computed on the rr graph
+    std::stringstream lookahead_key;
+    lookahead_key << rr_graph_key.str();
+    add_cache_key_option(lookahead_key, Options.router_lookahead_type);
+    add_cache_key_option(lookahead_key, Options.router_lookahead_half_precision);
+
+    //The placement delay model is computed by routing on the rr graph with the lookahead
+    std::stringstream place_delay_key;
+    place_delay_key << lookahead_key.str();
+    add_cache_key_option(place_delay_key, Options.place_delay_model);
+    add_cache_key_option(place_delay_key, Options.place_delay_model_reducer);
+    add_cache_key_option(place_delay_key, Options.place_delay_model_half_precision);
+    add_cache_key_option(place_delay_key, Options.place_delta_delay_matrix_calculation_method);
+    add_cache_key_option(place_delay_key, Options.place_delay_offset);
+    add_cache_key_option(place_delay_key, Options.place_delay_ramp_delta_threshold);
+    add_cache_key_option(place_delay_key, Options.place_delay_ramp_slope);
+    add_cache_key_option(place_delay_key, Options.allowed_tiles_for_delay_model);
+    add_cache_key_option(place_delay_key, Options.astar_fac);
+    add_cache_key_option(place_delay_key, Options.bend_cost);
+    add_cache_key_option(place_delay_key, Options.router_heap);
+
+    //A user specified rr graph is never copied into the cache
+    if (RoutingArch->read_rr_graph_filename.empty()) {
+        setup_cache_file(get_cache_file_name(FileNameOpts->cache_dir, "rr_graph", rr_graph_key, ".bin"),
+                         RoutingArch->read_rr_graph_filename, RoutingArch->write_rr_graph_filename, FileNameOpts);
+        RoutingArch->read_rr_graph_is_cached = !RoutingArch->read_rr_graph_filename.empty();
+    }
+
+    //Only the map based lookaheads can be saved
+    if (RouterOpts->lookahead_type == e_router_lookahead::MAP || RouterOpts->lookahead_type == e_router_lookahead::EXTENDED_MAP) {
+        setup_cache_file(get_cache_file_name(FileNameOpts->cache_dir, "router_lookahead", lookahead_key, ".capnp"),
+                         RouterOpts->read_router_lookahead, RouterOpts->write_router_lookahead, FileNameOpts);
+    }
+
+    setup_cache_file(get_cache_file_name(FileNameOpts->cache_dir, "place_delay_model", place_delay_key, ".capnp"),
+                     PlacerOpts->read_placement_delay_lookup, PlacerOpts->write_placement_delay_lookup, FileNameOpts);
+}
+
+/**
+ * @brief Sets up the --resume_from flow checkpoints
+ *
+ * The stages which a previous run checkpointed as complete are loaded from their output files
+ * instead of being run again, and the placer and router checkpoint their progress in the directory.
+ */
+static void SetupFlowCheckpoint(const t_options& Options,
+                                t_file_name_opts* FileNameOpts,
+                                t_packer_opts* PackerOpts,
+                                t_placer_opts* PlacerOpts,
+                                t_router_opts* RouterOpts) {
+    const std::string& checkpoint_dir = Options.resume_from;
+    FileNameOpts->flow_checkpoint_dir = checkpoint_dir;
+    if (checkpoint_dir.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(checkpoint_dir, ec);
+    if (ec) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to create flow checkpoint directory '%s': %s\n", checkpoint_dir.c_str(), ec.message().c_str());
+    }
+
+    //Stages are resumed in flow order: a stage is only skipped if all the stages before it were
+    bool resume = true;
+    if (PackerOpts->doPacking == STAGE_DO) {
+        resume = is_flow_stage_checkpointed(checkpoint_dir, e_flow_checkpoint_stage::PACK, FileNameOpts->NetFile);
+        if (resume) {
+            VTR_LOG("Resuming from flow checkpoint: loading packing from '%s'\n", FileNameOpts->NetFile.c_str());
+            PackerOpts->doPacking = STAGE_LOAD;
+        }
+    }
+    if (resume && PlacerOpts->doPlacement == STAGE_DO) {
+        resume = is_flow_stage_checkpointed(checkpoint_dir, e_flow_checkpoint_stage::PLACE, FileNameOpts->PlaceFile);
+        if (resume) {
+            VTR_LOG("Resuming from flow checkpoint: loading placement from '%s'\n", FileNameOpts->PlaceFile.c_str());
+            PlacerOpts->doPlacement = STAGE_LOAD;
+        }
+    }
+    if (resume && RouterOpts->doRouting == STAGE_DO) {
+        resume = is_flow_stage_checkpointed(checkpoint_dir, e_flow_checkpoint_stage::ROUTE, FileNameOpts->RouteFile);
+        if (resume) {
+            VTR_LOG("Resuming from flow checkpoint: loading routing from '%s'\n", FileNameOpts->RouteFile.c_str());
+            RouterOpts->doRouting = STAGE_LOAD;
+        }
+    }
+
+    if (PlacerOpts->place_snapshot_file.empty()) {
+        PlacerOpts->place_snapshot_file = get_place_snapshot_checkpoint_file(checkpoint_dir);
+    }
+    RouterOpts->route_checkpoint_file = get_route_checkpoint_file(checkpoint_dir);
+}
+
 static void SetupTiming(const t_options& Options, const bool TimingEnabled, t_timing_inf* Timing) {
     /* Don't do anything if they don't want timing */
     if (false == TimingEnabled) {
@@ -429,13 +708,20 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->switch_usage_analysis = Options.full_stats;
 
     RouterOpts->verify_binary_search = Options.verify_binary_search;
+    RouterOpts->aggressive_binary_search_abort = Options.aggressive_binary_search_abort;
+    RouterOpts->reuse_lookahead_across_chan_widths = Options.reuse_lookahead_across_chan_widths;
+    RouterOpts->congestion_driven_net_order = Options.congestion_driven_net_order;
     RouterOpts->router_algorithm = Options.RouterAlgorithm;
+    RouterOpts->deterministic_parallel_route = Options.deterministic_parallel_route;
+    RouterOpts->parallel_route_cutline_nets = Options.parallel_route_cutline_nets;
     RouterOpts->fixed_channel_width = Options.RouteChanWidth;
     RouterOpts->min_channel_width_hint = Options.min_route_chan_width_hint;
     RouterOpts->read_rr_edge_metadata = Options.read_rr_edge_metadata;
     RouterOpts->reorder_rr_graph_nodes_algorithm = Options.reorder_rr_graph_nodes_algorithm;
     RouterOpts->reorder_rr_graph_nodes_threshold = Options.reorder_rr_graph_nodes_threshold;
     RouterOpts->reorder_rr_graph_nodes_seed = Options.reorder_rr_graph_nodes_seed;
+    RouterOpts->compress_rr_graph_edges = Options.compress_rr_graph_edges;
+    RouterOpts->report_rr_graph_patterns = Options.report_rr_graph_patterns;
 
     RouterOpts->initial_pres_fac = Options.initial_pres_fac;
     RouterOpts->base_cost_type = Options.base_cost_type;
@@ -447,13 +733,18 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     }
     RouterOpts->routing_failure_predictor = Options.routing_failure_predictor;
     RouterOpts->routing_budgets_algorithm = Options.routing_budgets_algorithm;
+    RouterOpts->routing_budgets_convergence_delta = Options.routing_budgets_convergence_delta;
     RouterOpts->save_routing_per_iteration = Options.save_routing_per_iteration;
     RouterOpts->congested_routing_iteration_threshold_frac = Options.congested_routing_iteration_threshold_frac;
     RouterOpts->route_bb_update = Options.route_bb_update;
     RouterOpts->clock_modeling = Options.clock_modeling;
     RouterOpts->two_stage_clock_routing = Options.two_stage_clock_routing;
     RouterOpts->high_fanout_threshold = Options.router_high_fanout_threshold;
+    RouterOpts->batch_clock_routing = Options.batch_clock_routing;
+    RouterOpts->global_route_corridors = Options.global_route_corridors;
+    RouterOpts->global_route_corridor_margin = Options.global_route_corridor_margin;
     RouterOpts->high_fanout_max_slope = Options.router_high_fanout_max_slope;
+    RouterOpts->bidir_search_min_dist = Options.router_bidir_search_min_dist;
     RouterOpts->router_debug_net = Options.router_debug_net;
     RouterOpts->router_debug_sink_rr = Options.router_debug_sink_rr;
     RouterOpts->router_debug_iteration = Options.router_debug_iteration;
@@ -462,6 +753,7 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->reconvergence_cpd_threshold = Options.router_reconvergence_cpd_threshold;
     RouterOpts->initial_timing = Options.router_initial_timing;
     RouterOpts->update_lower_bound_delays = Options.router_update_lower_bound_delays;
+    RouterOpts->skip_timing_update_criticality = Options.router_skip_timing_update_criticality;
     RouterOpts->first_iteration_timing_report_file = Options.router_first_iteration_timing_report_file;
     RouterOpts->strict_checks = Options.strict_checks;
 
@@ -471,6 +763,15 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->write_intra_cluster_router_lookahead = Options.write_intra_cluster_router_lookahead;
     RouterOpts->read_intra_cluster_router_lookahead = Options.read_intra_cluster_router_lookahead;
 
+    RouterOpts->route_warm_start_file = Options.route_warm_start_file;
+
+    RouterOpts->write_router_connection_telemetry = Options.write_router_connection_telemetry;
+    RouterOpts->write_router_connection_capture = Options.write_router_connection_capture;
+    RouterOpts->router_connection_capture_limit = Options.router_connection_capture_limit;
+    RouterOpts->write_router_lookahead_profile = Options.write_router_lookahead_profile;
+    RouterOpts->router_lookahead_profile_correction = Options.router_lookahead_profile_correction;
+    RouterOpts->lookahead_half_precision = Options.router_lookahead_half_precision;
+
     RouterOpts->router_heap = Options.router_heap;
     RouterOpts->exit_after_first_routing_iteration = Options.exit_after_first_routing_iteration;
 
@@ -534,6 +835,14 @@ static void SetupAnnealSched(const t_options& Options,
         VPR_FATAL_ERROR(VPR_ERROR_OTHER, "success_target must be between 0 and 1 exclusive.\n");
     }
 
+    AnnealSched->converge_tol = Options.PlaceConvergeTol;
+    AnnealSched->converge_temps = Options.PlaceConvergeTemps;
+    if (AnnealSched->converge_tol > 0 && AnnealSched->converge_temps < 1) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "anneal_converge_temps must be at least 1.\n");
+    }
+
+    AnnealSched->time_budget = Options.PlaceTimeBudget;
+
     AnnealSched->type = Options.anneal_sched_type;
 }
 
@@ -585,6 +894,8 @@ void SetupPackerOpts(const t_options& Options,
     PackerOpts->timing_update_type = Options.timing_update_type;
     PackerOpts->pack_num_moves = Options.pack_num_moves;
     PackerOpts->pack_move_type = Options.pack_move_type;
+    PackerOpts->timing_update_interval = Options.pack_timing_update_interval;
+    PackerOpts->write_pack_profile = Options.write_pack_profile;
 }
 
 static void SetupNetlistOpts(const t_options& Options, t_netlist_opts& NetlistOpts) {
@@ -595,6 +906,7 @@ static void SetupNetlistOpts(const t_options& Options, t_netlist_opts& NetlistOp
     NetlistOpts.sweep_dangling_blocks = Options.sweep_dangling_blocks;
     NetlistOpts.sweep_constant_primary_outputs = Options.sweep_constant_primary_outputs;
     NetlistOpts.netlist_verbosity = Options.netlist_verbosity;
+    NetlistOpts.parallel_blif_parse = Options.parallel_blif_parse;
 }
 
 /**
@@ -610,6 +922,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     PlacerOpts->inner_loop_recompute_divider = Options.inner_loop_recompute_divider;
     PlacerOpts->quench_recompute_divider = Options.quench_recompute_divider;
+    PlacerOpts->inner_loop_recompute_accepted_moves = Options.inner_loop_recompute_accepted_moves;
 
     PlacerOpts->place_cost_exp = 1;
 
@@ -638,6 +951,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
     PlacerOpts->tsu_abs_margin = Options.place_tsu_abs_margin;
     PlacerOpts->delay_model_type = Options.place_delay_model;
     PlacerOpts->delay_model_reducer = Options.place_delay_model_reducer;
+    PlacerOpts->delay_model_half_precision = Options.place_delay_model_half_precision;
 
     PlacerOpts->place_freq = PLACE_ONCE; /* DEFAULT */
 
@@ -645,6 +959,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
+    PlacerOpts->move_timing_stats = Options.place_move_timing_stats;
     PlacerOpts->placement_saves_per_temperature = Options.placement_saves_per_temperature;
     PlacerOpts->place_delta_delay_matrix_calculation_method = Options.place_delta_delay_matrix_calculation_method;
 
@@ -661,11 +976,17 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
     PlacerOpts->place_static_move_prob = Options.place_static_move_prob;
     PlacerOpts->place_static_notiming_move_prob = Options.place_static_notiming_move_prob;
     PlacerOpts->place_high_fanout_net = Options.place_high_fanout_net;
+    PlacerOpts->place_parallel_moves = Options.place_parallel_moves;
+    PlacerOpts->place_num_starts = Options.place_num_starts;
+    PlacerOpts->place_incremental_file = Options.place_incremental_file;
+    PlacerOpts->place_incremental_radius = Options.place_incremental_radius;
+    PlacerOpts->place_snapshot_file = Options.place_snapshot_file;
     PlacerOpts->RL_agent_placement = Options.RL_agent_placement;
     PlacerOpts->place_agent_multistate = Options.place_agent_multistate;
     PlacerOpts->place_checkpointing = Options.place_checkpointing;
     PlacerOpts->place_agent_epsilon = Options.place_agent_epsilon;
     PlacerOpts->place_agent_gamma = Options.place_agent_gamma;
+    PlacerOpts->place_agent_prob_update_interval = Options.place_agent_prob_update_interval;
     PlacerOpts->place_dm_rlim = Options.place_dm_rlim;
     PlacerOpts->place_agent_space = Options.place_agent_space;
     PlacerOpts->place_reward_fun = Options.place_reward_fun;
@@ -697,6 +1018,22 @@ static void SetupAnalysisOpts(const t_options& Options, t_analysis_opts& analysi
 
     analysis_opts.timing_update_type = Options.timing_update_type;
     analysis_opts.write_timing_summary = Options.write_timing_summary;
+
+    analysis_opts.timing_corners.clear();
+    for (const std::string& corner_spec : Options.timing_corners.value()) {
+        size_t sep = corner_spec.rfind(':');
+        if (sep == std::string::npos || sep == 0 || sep + 1 == corner_spec.size()) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Invalid timing corner '%s' (expected <name>:<delay_scale>)\n", corner_spec.c_str());
+        }
+
+        t_timing_corner corner;
+        corner.name = corner_spec.substr(0, sep);
+        corner.delay_scale = vtr::atof(corner_spec.substr(sep + 1));
+        if (!(corner.delay_scale > 0.)) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Delay scale of timing corner '%s' must be greater than 0\n", corner.name.c_str());
+        }
+        analysis_opts.timing_corners.push_back(corner);
+    }
 }
 
 static void SetupPowerOpts(const t_options& Options, t_power_opts* power_opts, t_arch* Arch) {
@@ -30,4 +30,12 @@ void SetupVPR(const t_options* Options,
               std::string* GraphicsCommands,
               t_power_opts* PowerOpts,
               t_vpr_setup* vpr_setup);
+
+/**
+ * @brief Re-derives the placement, routing and analysis options (and output file names) of vpr_setup from Options
+ *
+ * For a job which re-uses the netlist and device set up from other options. The stages to run and the cached
+ * artifacts are kept unchanged.
+ */
+void SetupVprJobOpts(const t_options& Options, t_vpr_setup* vpr_setup);
 #endif
@@ -38,6 +38,12 @@ void ShowSetup(const t_vpr_setup& vpr_setup) {
     } else {
         VTR_LOG("Vpr floorplanning constraints file: %s\n", vpr_setup.FileNameOpts.read_vpr_constraints_file.c_str());
     }
+    if (!vpr_setup.FileNameOpts.cache_dir.empty()) {
+        VTR_LOG("Cache directory: %s\n", vpr_setup.FileNameOpts.cache_dir.c_str());
+    }
+    if (!vpr_setup.FileNameOpts.flow_checkpoint_dir.empty()) {
+        VTR_LOG("Flow checkpoint directory: %s\n", vpr_setup.FileNameOpts.flow_checkpoint_dir.c_str());
+    }
     VTR_LOG("\n");
 
     VTR_LOG("Packer: %s\n", (vpr_setup.PackerOpts.doPacking ? "ENABLED" : "DISABLED"));
@@ -332,6 +338,8 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
         VTR_LOG("RouterOpts.min_channel_width_hint: %d\n", RouterOpts.min_channel_width_hint);
         VTR_LOG("RouterOpts.read_rr_edge_metadata: %s\n", RouterOpts.read_rr_edge_metadata ? "true" : "false");
         VTR_LOG("RouterOpts.exit_after_first_routing_iteration: %s\n", RouterOpts.exit_after_first_routing_iteration ? "true" : "false");
+        VTR_LOG("RouterOpts.deterministic_parallel_route: %s\n", RouterOpts.deterministic_parallel_route ? "true" : "false");
+        VTR_LOG("RouterOpts.parallel_route_cutline_nets: %s\n", RouterOpts.parallel_route_cutline_nets ? "true" : "false");
 
         if (TIMING_DRIVEN == RouterOpts.router_algorithm) {
             VTR_LOG("RouterOpts.astar_fac: %f\n", RouterOpts.astar_fac);
@@ -342,6 +350,7 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             VTR_LOG("RouterOpts.save_routing_per_iteration: %s\n", RouterOpts.save_routing_per_iteration ? "true" : "false");
             VTR_LOG("RouterOpts.congested_routing_iteration_threshold_frac: %f\n", RouterOpts.congested_routing_iteration_threshold_frac);
             VTR_LOG("RouterOpts.high_fanout_threshold: %d\n", RouterOpts.high_fanout_threshold);
+            VTR_LOG("RouterOpts.bidir_search_min_dist: %d\n", RouterOpts.bidir_search_min_dist);
             VTR_LOG("RouterOpts.router_debug_net: %d\n", RouterOpts.router_debug_net);
             VTR_LOG("RouterOpts.router_debug_sink_rr: %d\n", RouterOpts.router_debug_sink_rr);
             VTR_LOG("RouterOpts.router_debug_iteration: %d\n", RouterOpts.router_debug_iteration);
@@ -382,6 +391,7 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
                 default:
                     VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown lookahead_type\n");
             }
+            VTR_LOG("RouterOpts.lookahead_half_precision: %s\n", RouterOpts.lookahead_half_precision ? "true" : "false");
 
             VTR_LOG("RouterOpts.initial_timing: ");
             switch (RouterOpts.initial_timing) {
@@ -406,6 +416,12 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
                 case e_heap_type::BUCKET_HEAP_APPROXIMATION:
                     VTR_LOG("BUCKET_HEAP_APPROXIMATION\n");
                     break;
+                case e_heap_type::FOUR_ARY_HEAP:
+                    VTR_LOG("FOUR_ARY_HEAP\n");
+                    break;
+                case e_heap_type::RADIX_HEAP:
+                    VTR_LOG("RADIX_HEAP\n");
+                    break;
                 default:
                     VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown router_heap\n");
             }
@@ -474,6 +490,8 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
         VTR_LOG("RouterOpts.min_channel_width_hint: %d\n", RouterOpts.min_channel_width_hint);
         VTR_LOG("RouterOpts.read_rr_edge_metadata: %s\n", RouterOpts.read_rr_edge_metadata ? "true" : "false");
         VTR_LOG("RouterOpts.exit_after_first_routing_iteration: %s\n", RouterOpts.exit_after_first_routing_iteration ? "true" : "false");
+        VTR_LOG("RouterOpts.deterministic_parallel_route: %s\n", RouterOpts.deterministic_parallel_route ? "true" : "false");
+        VTR_LOG("RouterOpts.parallel_route_cutline_nets: %s\n", RouterOpts.parallel_route_cutline_nets ? "true" : "false");
         if (TIMING_DRIVEN == RouterOpts.router_algorithm) {
             VTR_LOG("RouterOpts.astar_fac: %f\n", RouterOpts.astar_fac);
             VTR_LOG("RouterOpts.router_profiler_astar_fac: %f\n", RouterOpts.router_profiler_astar_fac);
@@ -484,6 +502,7 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
             VTR_LOG("RouterOpts.save_routing_per_iteration: %s\n", RouterOpts.save_routing_per_iteration ? "true" : "false");
             VTR_LOG("RouterOpts.congested_routing_iteration_threshold_frac: %f\n", RouterOpts.congested_routing_iteration_threshold_frac);
             VTR_LOG("RouterOpts.high_fanout_threshold: %d\n", RouterOpts.high_fanout_threshold);
+            VTR_LOG("RouterOpts.bidir_search_min_dist: %d\n", RouterOpts.bidir_search_min_dist);
             VTR_LOG("RouterOpts.router_debug_net: %d\n", RouterOpts.router_debug_net);
             VTR_LOG("RouterOpts.router_debug_sink_rr: %d\n", RouterOpts.router_debug_sink_rr);
             VTR_LOG("RouterOpts.router_debug_iteration: %d\n", RouterOpts.router_debug_iteration);
@@ -521,6 +540,7 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
                 default:
                     VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown lookahead_type\n");
             }
+            VTR_LOG("RouterOpts.lookahead_half_precision: %s\n", RouterOpts.lookahead_half_precision ? "true" : "false");
 
             VTR_LOG("RouterOpts.initial_timing: ");
             switch (RouterOpts.initial_timing) {
@@ -545,6 +565,12 @@ static void ShowRouterOpts(const t_router_opts& RouterOpts) {
                 case e_heap_type::BUCKET_HEAP_APPROXIMATION:
                     VTR_LOG("BUCKET_HEAP_APPROXIMATION\n");
                     break;
+                case e_heap_type::FOUR_ARY_HEAP:
+                    VTR_LOG("FOUR_ARY_HEAP\n");
+                    break;
+                case e_heap_type::RADIX_HEAP:
+                    VTR_LOG("RADIX_HEAP\n");
+                    break;
                 default:
                     VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown router_heap\n");
             }
@@ -605,12 +631,27 @@ static void ShowPlacerOpts(const t_placer_opts& PlacerOpts,
             VTR_LOG("Using constraints file '%s'\n", PlacerOpts.constraints_file.c_str());
         }
 
+        VTR_LOG("PlacerOpts.place_incremental_file: ");
+        if (PlacerOpts.place_incremental_file.empty()) {
+            VTR_LOG("No previous placement given\n");
+        } else {
+            VTR_LOG("Incremental placement from '%s' (radius %d)\n", PlacerOpts.place_incremental_file.c_str(), PlacerOpts.place_incremental_radius);
+        }
+
+        VTR_LOG("PlacerOpts.place_snapshot_file: ");
+        if (PlacerOpts.place_snapshot_file.empty()) {
+            VTR_LOG("No placement snapshot\n");
+        } else {
+            VTR_LOG("'%s'\n", PlacerOpts.place_snapshot_file.c_str());
+        }
+
         VTR_LOG("PlacerOpts.place_cost_exp: %f\n", PlacerOpts.place_cost_exp);
 
         VTR_LOG("PlacerOpts.place_chan_width: %d\n", PlacerOpts.place_chan_width);
 
         if (PlacerOpts.place_algorithm.is_timing_driven()) {
             VTR_LOG("PlacerOpts.inner_loop_recompute_divider: %d\n", PlacerOpts.inner_loop_recompute_divider);
+            VTR_LOG("PlacerOpts.inner_loop_recompute_accepted_moves: %d\n", PlacerOpts.inner_loop_recompute_accepted_moves);
             VTR_LOG("PlacerOpts.recompute_crit_iter: %d\n", PlacerOpts.recompute_crit_iter);
             VTR_LOG("PlacerOpts.timing_tradeoff: %f\n", PlacerOpts.timing_tradeoff);
             VTR_LOG("PlacerOpts.td_place_exp_first: %f\n", PlacerOpts.td_place_exp_first);
@@ -632,11 +673,14 @@ static void ShowPlacerOpts(const t_placer_opts& PlacerOpts,
             if ((size_t)PlacerOpts.delay_model_type > 1)
                 VPR_FATAL_ERROR(VPR_ERROR_UNKNOWN, "Unknown delay_model_type\n");
             VTR_LOG("PlacerOpts.delay_model_type: %s\n", place_delay_model_strings[(size_t)PlacerOpts.delay_model_type].c_str());
+            VTR_LOG("PlacerOpts.delay_model_half_precision: %s\n", PlacerOpts.delay_model_half_precision ? "true" : "false");
         }
 
         VTR_LOG("PlacerOpts.rlim_escape_fraction: %f\n", PlacerOpts.rlim_escape_fraction);
         VTR_LOG("PlacerOpts.move_stats_file: %s\n", PlacerOpts.move_stats_file.c_str());
         VTR_LOG("PlacerOpts.placement_saves_per_temperature: %d\n", PlacerOpts.placement_saves_per_temperature);
+        VTR_LOG("PlacerOpts.place_parallel_moves: %d\n", PlacerOpts.place_parallel_moves);
+        VTR_LOG("PlacerOpts.place_num_starts: %d\n", PlacerOpts.place_num_starts);
 
         VTR_LOG("PlacerOpts.effort_scaling: ");
         switch (PlacerOpts.effort_scaling) {
@@ -676,6 +720,7 @@ static void ShowNetlistOpts(const t_netlist_opts& NetlistOpts) {
     VTR_LOG("NetlistOpts.sweep_dangling_blocks         : %s\n", (NetlistOpts.sweep_dangling_blocks) ? "true" : "false");
     VTR_LOG("NetlistOpts.sweep_constant_primary_outputs: %s\n", (NetlistOpts.sweep_constant_primary_outputs) ? "true" : "false");
     VTR_LOG("NetlistOpts.netlist_verbosity             : %d\n", NetlistOpts.netlist_verbosity);
+    VTR_LOG("NetlistOpts.parallel_blif_parse           : %s\n", (NetlistOpts.parallel_blif_parse) ? "true" : "false");
 
     std::string const_gen_inference_strings[3] = {"NONE", "COMB", "COMB_SEQ"};
     if ((size_t)NetlistOpts.const_gen_inference > 3)
@@ -777,6 +822,7 @@ static void ShowPackerOpts(const t_packer_opts& PackerOpts) {
     VTR_LOG("PackerOpts.hill_climbing_flag: %s", (PackerOpts.hill_climbing_flag ? "true\n" : "false\n"));
     VTR_LOG("PackerOpts.inter_cluster_net_delay: %f\n", PackerOpts.inter_cluster_net_delay);
     VTR_LOG("PackerOpts.timing_driven: %s", (PackerOpts.timing_driven ? "true\n" : "false\n"));
+    VTR_LOG("PackerOpts.timing_update_interval: %d\n", PackerOpts.timing_update_interval);
     VTR_LOG("PackerOpts.target_external_pin_util: %s", vtr::join(PackerOpts.target_external_pin_util, " ").c_str());
     VTR_LOG("\n");
     VTR_LOG("\n");
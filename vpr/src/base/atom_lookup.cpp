@@ -85,12 +85,12 @@ void AtomLookup::set_atom_clb(const AtomBlockId blk_id, const ClusterBlockId clb
  * Nets
  */
 AtomNetId AtomLookup::atom_net(const ClusterNetId clb_net_index) const {
-    auto iter = atom_net_to_clb_net_.find(clb_net_index);
-    if (iter == atom_net_to_clb_net_.inverse_end()) {
+    auto iter = clb_net_to_atom_net_.find(clb_net_index);
+    if (iter == clb_net_to_atom_net_.end()) {
         //Not found
         return AtomNetId::INVALID();
     }
-    return iter->second;
+    return *iter;
 }
 
 ClusterNetId AtomLookup::clb_net(const AtomNetId net_id) const {
@@ -99,7 +99,7 @@ ClusterNetId AtomLookup::clb_net(const AtomNetId net_id) const {
         //Not found
         return ClusterNetId::INVALID();
     }
-    return iter->second;
+    return *iter;
 }
 
 void AtomLookup::set_atom_clb_net(const AtomNetId net_id, const ClusterNetId clb_net_index) {
@@ -107,13 +107,22 @@ void AtomLookup::set_atom_clb_net(const AtomNetId net_id, const ClusterNetId clb
     //If either are invalid remove any mapping
     if (!net_id && clb_net_index != ClusterNetId::INVALID()) {
         //Remove
-        atom_net_to_clb_net_.erase(clb_net_index);
+        AtomNetId mapped_net_id = atom_net(clb_net_index);
+        if (mapped_net_id) {
+            atom_net_to_clb_net_[mapped_net_id] = ClusterNetId::INVALID();
+            clb_net_to_atom_net_[clb_net_index] = AtomNetId::INVALID();
+        }
     } else if (net_id && clb_net_index == ClusterNetId::INVALID()) {
         //Remove
-        atom_net_to_clb_net_.erase(net_id);
+        ClusterNetId mapped_clb_net_index = clb_net(net_id);
+        if (mapped_clb_net_index) {
+            clb_net_to_atom_net_[mapped_clb_net_index] = AtomNetId::INVALID();
+            atom_net_to_clb_net_[net_id] = ClusterNetId::INVALID();
+        }
     } else if (net_id && clb_net_index != ClusterNetId::INVALID()) {
         //Store
         atom_net_to_clb_net_.update(net_id, clb_net_index);
+        clb_net_to_atom_net_.update(clb_net_index, net_id);
     }
 }
 
@@ -140,7 +149,7 @@ tatum::NodeId AtomLookup::atom_pin_tnode(const AtomPinId pin, BlockTnode block_t
 AtomPinId AtomLookup::tnode_atom_pin(const tatum::NodeId tnode) const {
     auto iter = tnode_atom_pin_.find(tnode);
     if (iter != tnode_atom_pin_.end()) {
-        return iter->second;
+        return *iter;
     }
 
     return AtomPinId::INVALID(); //Not found
@@ -166,5 +175,5 @@ void AtomLookup::set_atom_pin_tnode(const AtomPinId pin, const tatum::NodeId nod
     }
 
     //Each tnode maps to precisely one pin at any point in time
-    tnode_atom_pin_[node] = pin;
+    tnode_atom_pin_.update(node, pin);
 }
@@ -112,11 +112,13 @@ class AtomLookup {
 
     vtr::vector_map<AtomBlockId, ClusterBlockId> atom_to_clb_;
 
-    vtr::bimap<AtomNetId, ClusterNetId, vtr::linear_map, vtr::linear_map> atom_net_to_clb_net_;
+    //Both directions of the atom net <-> clb net mapping, indexed by id (invalid ids mark unmapped nets)
+    vtr::vector_map<AtomNetId, ClusterNetId> atom_net_to_clb_net_;
+    vtr::vector_map<ClusterNetId, AtomNetId> clb_net_to_atom_net_;
 
     vtr::linear_map<AtomPinId, tatum::NodeId> atom_pin_tnode_external_;
     vtr::linear_map<AtomPinId, tatum::NodeId> atom_pin_tnode_internal_;
-    vtr::linear_map<tatum::NodeId, AtomPinId> tnode_atom_pin_;
+    vtr::vector_map<tatum::NodeId, AtomPinId> tnode_atom_pin_;
 };
 
 #endif
@@ -292,6 +292,19 @@ void AtomNetlist::shrink_to_fit_impl() {
     port_models_.shrink_to_fit();
 }
 
+size_t AtomNetlist::memory_usage_impl() const {
+    return vtr::memory_usage(block_models_, block_truth_tables_, port_models_, net_aliases_map_);
+}
+
+void AtomNetlist::reserve_impl(size_t num_blocks, size_t num_ports, size_t /*num_pins*/, size_t /*num_nets*/) {
+    //Block data
+    block_models_.reserve(num_blocks);
+    block_truth_tables_.reserve(num_blocks);
+
+    //Port data
+    port_models_.reserve(num_ports);
+}
+
 /*
  *
  * Sanity Checks
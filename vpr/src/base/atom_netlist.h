@@ -78,6 +78,8 @@
 #include "atom_netlist_fwd.h"
 
 class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId> {
+    friend class NetlistSnapshot; //Reads and writes the netlist data directly (atom_netlist_snapshot.cpp)
+
   public:
     /**
      * @brief Constructs a netlist
@@ -247,6 +249,12 @@ class AtomNetlist : public Netlist<AtomBlockId, AtomPortId, AtomPinId, AtomNetId
     ///@brief Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
 
+    ///@brief Returns the (estimated) heap memory used by the atom specific data, in bytes
+    size_t memory_usage_impl() const override;
+
+    ///@brief Reserves the storage of the atom specific data
+    void reserve_impl(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) override;
+
     /*
      * Sanity checks
      */
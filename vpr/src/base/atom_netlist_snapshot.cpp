@@ -0,0 +1,414 @@
+#include "atom_netlist_snapshot.h"
+
+#include <cstring>
+#include <unordered_map>
+
+#include "atom_netlist.h"
+#include "arch_types.h"
+#include "vpr_error.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "atom_netlist_snapshot.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void write_atom_netlist_snapshot(const std::string& /*file*/, const AtomNetlist& /*netlist*/) {
+    VPR_THROW(VPR_ERROR_ATOM_NETLIST, "write_atom_netlist_snapshot " DISABLE_ERROR);
+}
+
+AtomNetlist read_atom_netlist_snapshot(const std::string& /*file*/, const t_model* /*user_models*/, const t_model* /*library_models*/) {
+    VPR_THROW(VPR_ERROR_ATOM_NETLIST, "read_atom_netlist_snapshot " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+///@brief Encoding of invalid ids in snapshots
+static constexpr uint32_t SNAPSHOT_INVALID_ID = 0xffffffff;
+
+template<typename Id>
+static uint32_t to_snapshot_id(const Id id) {
+    return id ? size_t(id) : SNAPSHOT_INVALID_ID;
+}
+
+template<typename Id>
+static Id from_snapshot_id(const uint32_t id) {
+    return id == SNAPSHOT_INVALID_ID ? Id::INVALID() : Id(id);
+}
+
+template<typename ListBuilder, typename K, typename Id>
+static void write_ids(ListBuilder list, const vtr::vector_map<K, Id>& ids) {
+    size_t i = 0;
+    for (const Id id : ids) {
+        list.set(i++, to_snapshot_id(id));
+    }
+}
+
+template<typename ListsBuilder, typename K, typename Id>
+static void write_id_lists(ListsBuilder lists, const vtr::vector_map<K, std::vector<Id>>& id_lists) {
+    size_t i = 0;
+    for (const std::vector<Id>& ids : id_lists) {
+        auto list = lists.init(i++, ids.size());
+        for (size_t j = 0; j < ids.size(); ++j) {
+            list.set(j, to_snapshot_id(ids[j]));
+        }
+    }
+}
+
+template<typename ListBuilder, typename K, typename T>
+static void write_values(ListBuilder list, const vtr::vector_map<K, T>& values) {
+    size_t i = 0;
+    for (const T value : values) {
+        list.set(i++, value);
+    }
+}
+
+template<typename ListsBuilder, typename K>
+static void write_params(ListsBuilder lists, const vtr::vector_map<K, std::unordered_map<std::string, std::string>>& params) {
+    size_t i = 0;
+    for (const auto& blk_params : params) {
+        auto list = lists.init(i++, blk_params.size());
+        size_t j = 0;
+        for (const auto& param : blk_params) {
+            list[j].setName(param.first.c_str());
+            list[j].setValue(param.second.c_str());
+            ++j;
+        }
+    }
+}
+
+template<typename ListReader, typename K, typename Id>
+static void read_ids(ListReader list, vtr::vector_map<K, Id>& ids) {
+    ids.clear();
+    ids.reserve(list.size());
+    for (uint32_t id : list) {
+        ids.push_back(from_snapshot_id<Id>(id));
+    }
+}
+
+template<typename ListsReader, typename K, typename Id>
+static void read_id_lists(ListsReader lists, vtr::vector_map<K, std::vector<Id>>& id_lists) {
+    id_lists.clear();
+    id_lists.reserve(lists.size());
+    for (auto list : lists) {
+        std::vector<Id> ids;
+        ids.reserve(list.size());
+        for (uint32_t id : list) {
+            ids.push_back(from_snapshot_id<Id>(id));
+        }
+        id_lists.push_back(std::move(ids));
+    }
+}
+
+template<typename ListReader, typename K, typename T>
+static void read_values(ListReader list, vtr::vector_map<K, T>& values) {
+    values.clear();
+    values.reserve(list.size());
+    for (auto value : list) {
+        values.push_back(T(value));
+    }
+}
+
+template<typename ListsReader, typename K>
+static void read_params(ListsReader lists, vtr::vector_map<K, std::unordered_map<std::string, std::string>>& params) {
+    params.clear();
+    params.reserve(lists.size());
+    for (auto list : lists) {
+        std::unordered_map<std::string, std::string> blk_params;
+        for (auto param : list) {
+            blk_params.emplace(param.getName().cStr(), param.getValue().cStr());
+        }
+        params.push_back(std::move(blk_params));
+    }
+}
+
+///@brief Fills ids with the valid ids 0..num_ids-1 (a compressed netlist has no invalid ids)
+template<typename K>
+static void fill_valid_ids(vtr::vector_map<K, K>& ids, size_t num_ids) {
+    ids.clear();
+    ids.reserve(num_ids);
+    for (size_t i = 0; i < num_ids; ++i) {
+        ids.push_back(K(i));
+    }
+}
+
+static const t_model* find_snapshot_model(const char* name, const t_model* user_models, const t_model* library_models) {
+    for (const t_model* models : {user_models, library_models}) {
+        for (const t_model* model = models; model; model = model->next) {
+            if (std::strcmp(model->name, name) == 0) {
+                return model;
+            }
+        }
+    }
+    return nullptr;
+}
+
+static const t_model_ports* find_snapshot_model_port(const t_model* model, const std::string& name) {
+    for (const t_model_ports* ports : {model->inputs, model->outputs}) {
+        for (const t_model_ports* port = ports; port; port = port->next) {
+            if (name == port->name) {
+                return port;
+            }
+        }
+    }
+    return nullptr;
+}
+
+///@brief Reads and writes the private data of netlists (a friend of Netlist<> and AtomNetlist)
+class NetlistSnapshot {
+  public:
+    static void write(VprAtomNetlist::Builder snapshot, const AtomNetlist& netlist) {
+        write_netlist(snapshot.initNetlist(), netlist);
+
+        std::unordered_map<const t_model*, uint32_t> model_indices;
+        std::vector<const t_model*> models;
+        auto block_models = snapshot.initBlockModels(netlist.block_models_.size());
+        size_t iblk = 0;
+        for (const t_model* model : netlist.block_models_) {
+            auto result = model_indices.emplace(model, models.size());
+            if (result.second) {
+                models.push_back(model);
+            }
+            block_models.set(iblk++, result.first->second);
+        }
+        auto model_names = snapshot.initModels(models.size());
+        for (size_t imodel = 0; imodel < models.size(); ++imodel) {
+            model_names.set(imodel, models[imodel]->name);
+        }
+
+        auto truth_tables = snapshot.initBlockTruthTables(netlist.block_truth_tables_.size());
+        iblk = 0;
+        for (const AtomNetlist::TruthTable& truth_table : netlist.block_truth_tables_) {
+            auto rows = truth_tables.init(iblk++, truth_table.size());
+            for (size_t irow = 0; irow < truth_table.size(); ++irow) {
+                auto row = rows.init(irow, truth_table[irow].size());
+                for (size_t i = 0; i < truth_table[irow].size(); ++i) {
+                    row.set(i, uint8_t(truth_table[irow][i]));
+                }
+            }
+        }
+
+        auto net_aliases = snapshot.initNetAliases(netlist.net_aliases_map_.size());
+        size_t ialias = 0;
+        for (const auto& kv : netlist.net_aliases_map_) {
+            auto net_alias = net_aliases[ialias++];
+            net_alias.setNetName(kv.first.c_str());
+            auto aliases = net_alias.initAliases(kv.second.size());
+            size_t i = 0;
+            for (const std::string& alias : kv.second) {
+                aliases.set(i++, alias.c_str());
+            }
+        }
+    }
+
+    static void read(VprAtomNetlist::Reader snapshot, AtomNetlist& netlist, const t_model* user_models, const t_model* library_models, const char* file) {
+        read_netlist(snapshot.getNetlist(), netlist);
+
+        std::vector<const t_model*> models;
+        for (auto name : snapshot.getModels()) {
+            const t_model* model = find_snapshot_model(name.cStr(), user_models, library_models);
+            if (!model) {
+                vpr_throw(VPR_ERROR_ATOM_NETLIST, file, 0,
+                          "Netlist snapshot uses model '%s' which is not in the architecture", name.cStr());
+            }
+            models.push_back(model);
+        }
+
+        netlist.set_block_types(find_snapshot_model(MODEL_INPUT, user_models, library_models),
+                                find_snapshot_model(MODEL_OUTPUT, user_models, library_models));
+
+        auto block_models = snapshot.getBlockModels();
+        auto truth_tables = snapshot.getBlockTruthTables();
+        size_t num_blocks = netlist.block_ids_.size();
+        if (block_models.size() != num_blocks || truth_tables.size() != num_blocks) {
+            vpr_throw(VPR_ERROR_ATOM_NETLIST, file, 0, "Netlist snapshot has inconsistent block data");
+        }
+
+        netlist.block_models_.clear();
+        netlist.block_models_.reserve(num_blocks);
+        for (uint32_t imodel : block_models) {
+            if (imodel >= models.size()) {
+                vpr_throw(VPR_ERROR_ATOM_NETLIST, file, 0, "Netlist snapshot has an invalid block model");
+            }
+            netlist.block_models_.push_back(models[imodel]);
+        }
+
+        netlist.block_truth_tables_.clear();
+        netlist.block_truth_tables_.reserve(num_blocks);
+        for (auto rows : truth_tables) {
+            AtomNetlist::TruthTable truth_table;
+            truth_table.reserve(rows.size());
+            for (auto row : rows) {
+                std::vector<vtr::LogicValue> values;
+                values.reserve(row.size());
+                for (uint8_t value : row) {
+                    values.push_back(vtr::LogicValue(value));
+                }
+                truth_table.push_back(std::move(values));
+            }
+            netlist.block_truth_tables_.push_back(std::move(truth_table));
+        }
+
+        //Port models are the ports of the block's model with the port's name
+        netlist.port_models_.clear();
+        netlist.port_models_.reserve(netlist.port_ids_.size());
+        for (AtomPortId port_id : netlist.port_ids_) {
+            const t_model* model = netlist.block_models_[netlist.port_blocks_[port_id]];
+            const t_model_ports* model_port = find_snapshot_model_port(model, netlist.port_name(port_id));
+            if (!model_port) {
+                vpr_throw(VPR_ERROR_ATOM_NETLIST, file, 0,
+                          "Netlist snapshot port '%s' is not a port of model '%s'",
+                          netlist.port_name(port_id).c_str(), model->name);
+            }
+            netlist.port_models_.push_back(model_port);
+        }
+
+        netlist.net_aliases_map_.clear();
+        for (auto net_alias : snapshot.getNetAliases()) {
+            auto& aliases = netlist.net_aliases_map_[net_alias.getNetName().cStr()];
+            for (auto alias : net_alias.getAliases()) {
+                aliases.insert(alias.cStr());
+            }
+        }
+    }
+
+  private:
+    template<typename BlockId, typename PortId, typename PinId, typename NetId>
+    static void write_netlist(VprNetlist::Builder snapshot, const Netlist<BlockId, PortId, PinId, NetId>& netlist) {
+        VTR_ASSERT_MSG(netlist.is_compressed(), "Only compressed netlists can be snapshot");
+
+        snapshot.setName(netlist.netlist_name_.c_str());
+        snapshot.setId(netlist.netlist_id_.c_str());
+
+        auto strings = snapshot.initStrings(netlist.strings_.size());
+        size_t istring = 0;
+        for (const std::string& str : netlist.strings_) {
+            strings.set(istring++, str.c_str());
+        }
+
+        size_t num_blocks = netlist.block_ids_.size();
+        write_ids(snapshot.initBlockNames(num_blocks), netlist.block_names_);
+        write_id_lists(snapshot.initBlockPorts(num_blocks), netlist.block_ports_);
+        write_values(snapshot.initBlockNumInputPorts(num_blocks), netlist.block_num_input_ports_);
+        write_values(snapshot.initBlockNumOutputPorts(num_blocks), netlist.block_num_output_ports_);
+        write_values(snapshot.initBlockNumClockPorts(num_blocks), netlist.block_num_clock_ports_);
+        write_id_lists(snapshot.initBlockPins(num_blocks), netlist.block_pins_);
+        write_values(snapshot.initBlockNumInputPins(num_blocks), netlist.block_num_input_pins_);
+        write_values(snapshot.initBlockNumOutputPins(num_blocks), netlist.block_num_output_pins_);
+        write_values(snapshot.initBlockNumClockPins(num_blocks), netlist.block_num_clock_pins_);
+        write_params(snapshot.initBlockParams(num_blocks), netlist.block_params_);
+        write_params(snapshot.initBlockAttrs(num_blocks), netlist.block_attrs_);
+
+        size_t num_ports = netlist.port_ids_.size();
+        write_ids(snapshot.initPortNames(num_ports), netlist.port_names_);
+        write_ids(snapshot.initPortBlocks(num_ports), netlist.port_blocks_);
+        write_id_lists(snapshot.initPortPins(num_ports), netlist.port_pins_);
+        write_values(snapshot.initPortWidths(num_ports), netlist.port_widths_);
+        auto port_types = snapshot.initPortTypes(num_ports);
+        size_t iport = 0;
+        for (PortType type : netlist.port_types_) {
+            port_types.set(iport++, uint8_t(type));
+        }
+
+        size_t num_pins = netlist.pin_ids_.size();
+        write_ids(snapshot.initPinPorts(num_pins), netlist.pin_ports_);
+        write_values(snapshot.initPinPortBits(num_pins), netlist.pin_port_bits_);
+        write_ids(snapshot.initPinNets(num_pins), netlist.pin_nets_);
+        write_values(snapshot.initPinNetIndices(num_pins), netlist.pin_net_indices_);
+        write_values(snapshot.initPinIsConstant(num_pins), netlist.pin_is_constant_);
+
+        size_t num_nets = netlist.net_ids_.size();
+        write_ids(snapshot.initNetNames(num_nets), netlist.net_names_);
+        write_id_lists(snapshot.initNetPins(num_nets), netlist.net_pins_);
+        write_values(snapshot.initNetIsIgnored(num_nets), netlist.net_is_ignored_);
+        write_values(snapshot.initNetIsGlobal(num_nets), netlist.net_is_global_);
+    }
+
+    template<typename BlockId, typename PortId, typename PinId, typename NetId>
+    static void read_netlist(VprNetlist::Reader snapshot, Netlist<BlockId, PortId, PinId, NetId>& netlist) {
+        netlist.netlist_name_ = snapshot.getName().cStr();
+        netlist.netlist_id_ = snapshot.getId().cStr();
+
+        auto strings = snapshot.getStrings();
+        fill_valid_ids(netlist.string_ids_, strings.size());
+        netlist.strings_.clear();
+        netlist.strings_.reserve(strings.size());
+        netlist.string_to_string_id_.clear();
+        netlist.string_to_string_id_.reserve(strings.size());
+        for (auto str : strings) {
+            netlist.string_to_string_id_.insert(str.cStr(), StringId(netlist.strings_.size()));
+            netlist.strings_.push_back(str.cStr());
+        }
+
+        fill_valid_ids(netlist.block_ids_, snapshot.getBlockNames().size());
+        read_ids(snapshot.getBlockNames(), netlist.block_names_);
+        read_id_lists(snapshot.getBlockPorts(), netlist.block_ports_);
+        read_values(snapshot.getBlockNumInputPorts(), netlist.block_num_input_ports_);
+        read_values(snapshot.getBlockNumOutputPorts(), netlist.block_num_output_ports_);
+        read_values(snapshot.getBlockNumClockPorts(), netlist.block_num_clock_ports_);
+        read_id_lists(snapshot.getBlockPins(), netlist.block_pins_);
+        read_values(snapshot.getBlockNumInputPins(), netlist.block_num_input_pins_);
+        read_values(snapshot.getBlockNumOutputPins(), netlist.block_num_output_pins_);
+        read_values(snapshot.getBlockNumClockPins(), netlist.block_num_clock_pins_);
+        read_params(snapshot.getBlockParams(), netlist.block_params_);
+        read_params(snapshot.getBlockAttrs(), netlist.block_attrs_);
+
+        fill_valid_ids(netlist.port_ids_, snapshot.getPortNames().size());
+        read_ids(snapshot.getPortNames(), netlist.port_names_);
+        read_ids(snapshot.getPortBlocks(), netlist.port_blocks_);
+        read_id_lists(snapshot.getPortPins(), netlist.port_pins_);
+        read_values(snapshot.getPortWidths(), netlist.port_widths_);
+        netlist.port_types_.clear();
+        netlist.port_types_.reserve(snapshot.getPortTypes().size());
+        for (uint8_t type : snapshot.getPortTypes()) {
+            netlist.port_types_.push_back(PortType(type));
+        }
+
+        fill_valid_ids(netlist.pin_ids_, snapshot.getPinPorts().size());
+        read_ids(snapshot.getPinPorts(), netlist.pin_ports_);
+        read_values(snapshot.getPinPortBits(), netlist.pin_port_bits_);
+        read_ids(snapshot.getPinNets(), netlist.pin_nets_);
+        read_values(snapshot.getPinNetIndices(), netlist.pin_net_indices_);
+        read_values(snapshot.getPinIsConstant(), netlist.pin_is_constant_);
+
+        fill_valid_ids(netlist.net_ids_, snapshot.getNetNames().size());
+        read_ids(snapshot.getNetNames(), netlist.net_names_);
+        read_id_lists(snapshot.getNetPins(), netlist.net_pins_);
+        read_values(snapshot.getNetIsIgnored(), netlist.net_is_ignored_);
+        read_values(snapshot.getNetIsGlobal(), netlist.net_is_global_);
+
+        netlist.dirty_ = false;
+        netlist.num_removed_ids_ = 0;
+        netlist.rebuild_lookups();
+    }
+};
+
+void write_atom_netlist_snapshot(const std::string& file, const AtomNetlist& netlist) {
+    ::capnp::MallocMessageBuilder builder;
+    NetlistSnapshot::write(builder.initRoot<VprAtomNetlist>(), netlist);
+    writeMessageToFile(file, &builder);
+}
+
+AtomNetlist read_atom_netlist_snapshot(const std::string& file, const t_model* user_models, const t_model* library_models) {
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+
+    AtomNetlist netlist;
+    NetlistSnapshot::read(reader.getRoot<VprAtomNetlist>(), netlist, user_models, library_models, file.c_str());
+
+    //Catches snapshots which do not match this version of the netlist data structures
+    if (!netlist.verify()) {
+        vpr_throw(VPR_ERROR_ATOM_NETLIST, file.c_str(), 0, "Netlist snapshot is inconsistent");
+    }
+
+    return netlist;
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -0,0 +1,23 @@
+#ifndef ATOM_NETLIST_SNAPSHOT_H
+#define ATOM_NETLIST_SNAPSHOT_H
+/**
+ * @file
+ * @brief Binary (capnproto) snapshots of a cleaned AtomNetlist
+ *
+ * Loading a snapshot replaces reading and cleaning the circuit (see --cache_dir).
+ * The snapshot holds the netlist's arrays directly, so the loaded netlist has the
+ * same ids (and hence block, net and pin order) as the one written.
+ */
+
+#include <string>
+
+#include "atom_netlist_fwd.h"
+#include "logic_types.h"
+
+///@brief Writes netlist, which must be compressed, to file
+void write_atom_netlist_snapshot(const std::string& file, const AtomNetlist& netlist);
+
+///@brief Reads the netlist in file, resolving its block models from user_models and library_models
+AtomNetlist read_atom_netlist_snapshot(const std::string& file, const t_model* user_models, const t_model* library_models);
+
+#endif /* ATOM_NETLIST_SNAPSHOT_H */
@@ -9,6 +9,10 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vpr_error.h"
 #include "vpr_utils.h"
 
@@ -22,6 +26,10 @@ int infer_and_mark_constant_pins(AtomNetlist& netlist, e_const_gen_inference con
 
 ///@brief Marks all primtive output pins which have no combinationally connected inputs as constant pins
 int mark_undriven_primitive_outputs_as_constant(AtomNetlist& netlist, int verbosity);
+int mark_undriven_block_outputs_as_constant(AtomNetlist& netlist, AtomBlockId blk, int verbosity);
+
+///@brief Returns false if none of the output pins of blk can currently be inferred constant (may return true spuriously)
+bool may_infer_constant_outputs(const AtomNetlist& netlist, AtomBlockId blk);
 
 ///@brief Marks all primtive output pins of blk which have only constant inputs as constant pins
 int infer_and_mark_block_pins_constant(AtomNetlist& netlist, AtomBlockId blk, e_const_gen_inference const_gen_inference_method, int verbosity);
@@ -443,45 +451,52 @@ int mark_undriven_primitive_outputs_as_constant(AtomNetlist& netlist, int verbos
     for (AtomBlockId blk : netlist.blocks()) {
         if (!blk) continue;
 
-        //Don't mark primary I/Os as constants
-        if (netlist.block_type(blk) != AtomBlockType::BLOCK) continue;
+        num_pins_marked_constant += mark_undriven_block_outputs_as_constant(netlist, blk, verbosity);
+    }
+
+    return num_pins_marked_constant;
+}
 
-        for (AtomPortId output_port : netlist.block_output_ports(blk)) {
-            const t_model_ports* model_port = netlist.port_model(output_port);
+int mark_undriven_block_outputs_as_constant(AtomNetlist& netlist, AtomBlockId blk, int verbosity) {
+    //Don't mark primary I/Os as constants
+    if (netlist.block_type(blk) != AtomBlockType::BLOCK) return 0;
 
-            //Don't mark sequential or clock generator ports as constants
-            if (!model_port->clock.empty() || model_port->is_clock) continue;
+    size_t num_pins_marked_constant = 0;
+    for (AtomPortId output_port : netlist.block_output_ports(blk)) {
+        const t_model_ports* model_port = netlist.port_model(output_port);
 
-            //Find the upstream combinationally connected ports
-            std::vector<AtomPortId> upstream_ports = find_combinationally_connected_input_ports(netlist, output_port);
+        //Don't mark sequential or clock generator ports as constants
+        if (!model_port->clock.empty() || model_port->is_clock) continue;
 
-            //Check if any of the 'upstream' input pins have connected nets
-            //
-            //Note that we only check to see whether they are *connected* not whether they are non-constant.
-            //Inference of pins as constant generators from upstream *constant nets* is handled elsewhere.
-            bool has_connected_inputs = false;
-            for (AtomPortId input_port : upstream_ports) {
-                for (AtomPinId input_pin : netlist.port_pins(input_port)) {
-                    AtomNetId input_net = netlist.pin_net(input_pin);
-
-                    if (input_net) {
-                        has_connected_inputs = true;
-                        break;
-                    }
+        //Find the upstream combinationally connected ports
+        std::vector<AtomPortId> upstream_ports = find_combinationally_connected_input_ports(netlist, output_port);
+
+        //Check if any of the 'upstream' input pins have connected nets
+        //
+        //Note that we only check to see whether they are *connected* not whether they are non-constant.
+        //Inference of pins as constant generators from upstream *constant nets* is handled elsewhere.
+        bool has_connected_inputs = false;
+        for (AtomPortId input_port : upstream_ports) {
+            for (AtomPinId input_pin : netlist.port_pins(input_port)) {
+                AtomNetId input_net = netlist.pin_net(input_pin);
+
+                if (input_net) {
+                    has_connected_inputs = true;
+                    break;
                 }
             }
+        }
 
-            if (!has_connected_inputs) {
-                //The current output port has no inputs driving the primitive's internal
-                //timing edges. Therefore we treat all its pins as constant generators.
-                for (AtomPinId output_pin : netlist.port_pins(output_port)) {
-                    if (netlist.pin_is_constant(output_pin)) continue;
+        if (!has_connected_inputs) {
+            //The current output port has no inputs driving the primitive's internal
+            //timing edges. Therefore we treat all its pins as constant generators.
+            for (AtomPinId output_pin : netlist.port_pins(output_port)) {
+                if (netlist.pin_is_constant(output_pin)) continue;
 
-                    VTR_LOGV(verbosity > 1, "Marking pin '%s' as constant since it has no combinationally connected inputs\n",
-                             netlist.pin_name(output_pin).c_str());
-                    netlist.set_pin_is_constant(output_pin, true);
-                    ++num_pins_marked_constant;
-                }
+                VTR_LOGV(verbosity > 1, "Marking pin '%s' as constant since it has no combinationally connected inputs\n",
+                         netlist.pin_name(output_pin).c_str());
+                netlist.set_pin_is_constant(output_pin, true);
+                ++num_pins_marked_constant;
             }
         }
     }
@@ -648,6 +663,41 @@ int infer_and_mark_block_sequential_outputs_constant(AtomNetlist& netlist, AtomB
     return num_pins_marked_constant;
 }
 
+bool may_infer_constant_outputs(const AtomNetlist& netlist, AtomBlockId blk) {
+    //Only primitive outputs are inferred constant
+    if (netlist.block_type(blk) != AtomBlockType::BLOCK) return false;
+
+    bool all_outputs_constant = true;
+    for (AtomPinId output_pin : netlist.block_output_pins(blk)) {
+        if (!netlist.pin_is_constant(output_pin)) {
+            all_outputs_constant = false;
+            break;
+        }
+    }
+    if (all_outputs_constant) return false;
+
+    //Outputs are inferred constant only if some (possibly none) of the inputs are
+    //all unconnected or constant, which requires an input port without pins or
+    //an unconnected or constant input pin
+    if (netlist.block_input_pins(blk).size() == 0) return true;
+
+    for (AtomPortId input_port : netlist.block_input_ports(blk)) {
+        if (netlist.port_pins(input_port).size() == 0) return true;
+
+        for (AtomPinId input_pin : netlist.port_pins(input_port)) {
+            AtomNetId input_net = netlist.pin_net(input_pin);
+            if (!input_net || netlist.net_is_constant(input_net)) return true;
+        }
+    }
+
+    //Or an output port without combinationally connected inputs
+    for (AtomPortId output_port : netlist.block_output_ports(blk)) {
+        if (find_combinationally_connected_input_ports(netlist, output_port).empty()) return true;
+    }
+
+    return false;
+}
+
 std::vector<AtomPortId> find_combinationally_connected_input_ports(const AtomNetlist& netlist, AtomPortId output_port) {
     std::vector<AtomPortId> upstream_ports;
 
@@ -699,12 +749,28 @@ void absorb_buffer_luts(AtomNetlist& netlist, int verbosity) {
 
     size_t removed_buffer_count = 0;
 
+    //Identify the buffer luts. Removing a buffer only merges the nets around it, so does
+    //not change which of the other blocks are buffers
+    std::vector<AtomBlockId> blocks(netlist.blocks().begin(), netlist.blocks().end());
+    std::vector<char> block_is_buffer_lut(blocks.size(), false);
+    auto find_buffer_lut = [&](size_t iblk) {
+        block_is_buffer_lut[iblk] = blocks[iblk] && is_buffer_lut(netlist, blocks[iblk]);
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), blocks.size(), find_buffer_lut);
+#else
+    for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+        find_buffer_lut(iblk);
+    }
+#endif
+
     //Remove the buffer luts
-    for (auto blk : netlist.blocks()) {
-        if (is_buffer_lut(netlist, blk)) {
-            if (remove_buffer_lut(netlist, blk, verbosity)) {
-                ++removed_buffer_count;
-            }
+    for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+        if (!block_is_buffer_lut[iblk]) continue;
+
+        VTR_ASSERT_SAFE(is_buffer_lut(netlist, blocks[iblk]));
+        if (remove_buffer_lut(netlist, blocks[iblk], verbosity)) {
+            ++removed_buffer_count;
         }
     }
     VTR_LOGV(verbosity > 0, "Absorbed %zu LUT buffers\n", removed_buffer_count);
@@ -990,13 +1056,65 @@ size_t sweep_constant_primary_outputs(AtomNetlist& netlist, int verbosity) {
     return removed_count;
 }
 
-size_t sweep_iterative(AtomNetlist& netlist,
+namespace {
+
+/**
+ * @brief Worklist implementation of sweep_iterative()
+ *
+ * A block or net only becomes sweepable, and a block's outputs only become constant, when
+ * a connected block or net is removed or one of the block's input nets becomes constant.
+ * Instead of re-scanning the whole netlist until nothing changes, the initial candidates
+ * are identified once (concurrently with TBB) and each change then only queues the
+ * neighbouring blocks and nets to be re-checked. Since these conditions never revert as
+ * the netlist is swept, this reaches the same fixed point as repeated full sweeps.
+ */
+class AtomNetlistSweeper {
+  public:
+    AtomNetlistSweeper(AtomNetlist& netlist,
                        bool should_sweep_ios,
                        bool should_sweep_nets,
                        bool should_sweep_blocks,
                        bool should_sweep_constant_primary_outputs,
                        e_const_gen_inference const_gen_inference_method,
-                       int verbosity) {
+                       int verbosity)
+        : netlist_(netlist)
+        , should_sweep_ios_(should_sweep_ios)
+        , should_sweep_nets_(should_sweep_nets)
+        , should_sweep_blocks_(should_sweep_blocks)
+        , should_sweep_constant_primary_outputs_(should_sweep_constant_primary_outputs)
+        , const_gen_inference_method_(const_gen_inference_method)
+        , verbosity_(verbosity)
+        , block_queued_(netlist.blocks().size(), false)
+        , net_queued_(netlist.nets().size(), false) {}
+
+    void sweep() {
+        queue_initial_candidates();
+
+        //Blocks are processed first, since removing them is what makes most nets sweepable
+        while (!block_queue_.empty() || !net_queue_.empty()) {
+            while (!block_queue_.empty()) {
+                AtomBlockId blk_id = block_queue_.back();
+                block_queue_.pop_back();
+                block_queued_[blk_id] = false;
+
+                if (netlist_.valid_block_id(blk_id)) { //i.e. not already removed
+                    process_block(blk_id);
+                }
+            }
+
+            if (!net_queue_.empty()) {
+                AtomNetId net_id = net_queue_.back();
+                net_queue_.pop_back();
+                net_queued_[net_id] = false;
+
+                if (netlist_.valid_net_id(net_id)) {
+                    process_net(net_id);
+                }
+            }
+        }
+    }
+
+  public:
     size_t dangling_nets_swept = 0;
     size_t dangling_blocks_swept = 0;
     size_t dangling_inputs_swept = 0;
@@ -1004,70 +1122,213 @@ size_t sweep_iterative(AtomNetlist& netlist,
     size_t constant_outputs_swept = 0;
     size_t constant_generators_marked = 0;
 
-    //We perform multiple passes of sweeping, since sweeping something may
-    //enable more things to be swept afterward.
-    //
-    //We keep sweeping until nothing else is removed
-    size_t pass_dangling_nets_swept;
-    size_t pass_dangling_blocks_swept;
-    size_t pass_dangling_inputs_swept;
-    size_t pass_dangling_outputs_swept;
-    size_t pass_constant_outputs_swept;
-    size_t pass_constant_generators_marked;
-    do {
-        pass_dangling_nets_swept = 0;
-        pass_dangling_blocks_swept = 0;
-        pass_dangling_inputs_swept = 0;
-        pass_dangling_outputs_swept = 0;
-        pass_constant_outputs_swept = 0;
-        pass_constant_generators_marked = 0;
+  private:
+    void queue_initial_candidates() {
+        std::vector<AtomBlockId> blocks(netlist_.blocks().begin(), netlist_.blocks().end());
+        std::vector<AtomNetId> nets(netlist_.nets().begin(), netlist_.nets().end());
+
+        std::vector<char> block_is_candidate(blocks.size(), false);
+        std::vector<char> net_is_candidate(nets.size(), false);
+        auto find_block_candidate = [&](size_t iblk) {
+            block_is_candidate[iblk] = blocks[iblk] && is_candidate_block(blocks[iblk]);
+        };
+        auto find_net_candidate = [&](size_t inet) {
+            net_is_candidate[inet] = nets[inet] && is_candidate_net(nets[inet]);
+        };
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), blocks.size(), find_block_candidate);
+        tbb::parallel_for(size_t(0), nets.size(), find_net_candidate);
+#else
+        for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+            find_block_candidate(iblk);
+        }
+        for (size_t inet = 0; inet < nets.size(); ++inet) {
+            find_net_candidate(inet);
+        }
+#endif
+
+        //Queued in reverse, so the candidates are first processed in netlist order
+        for (size_t iblk = blocks.size(); iblk-- > 0;) {
+            if (block_is_candidate[iblk]) queue_block(blocks[iblk]);
+        }
+        for (size_t inet = nets.size(); inet-- > 0;) {
+            if (net_is_candidate[inet]) queue_net(nets[inet]);
+        }
+    }
+
+    ///@brief Returns true if blk_id may be swept or have outputs marked constant
+    bool is_candidate_block(const AtomBlockId blk_id) const {
+        AtomBlockType type = netlist_.block_type(blk_id);
+        if (type == AtomBlockType::INPAD || type == AtomBlockType::OUTPAD) {
+            return (should_sweep_ios_ && (is_removable_input(netlist_, blk_id) || is_removable_output(netlist_, blk_id)))
+                   || (should_sweep_constant_primary_outputs_ && type == AtomBlockType::OUTPAD);
+        }
+
+        return (should_sweep_blocks_ && is_removable_block(netlist_, blk_id))
+               || may_infer_constant_outputs(netlist_, blk_id);
+    }
+
+    ///@brief Returns true if net_id may be swept
+    bool is_candidate_net(const AtomNetId net_id) const {
+        return should_sweep_nets_ && (!netlist_.net_driver(net_id) || netlist_.net_sinks(net_id).size() == 0);
+    }
+
+    void process_block(const AtomBlockId blk_id) {
+        std::string reason;
+        if (should_sweep_ios_ && is_removable_input(netlist_, blk_id, &reason)) {
+            VTR_LOGV_WARN(verbosity_ > 1, "Primary input '%s' will be swept (%s)\n", netlist_.block_name(blk_id).c_str(), reason.c_str());
+            remove_block(blk_id);
+            ++dangling_inputs_swept;
+            return;
+        }
+
+        if (should_sweep_ios_ && is_removable_output(netlist_, blk_id, &reason)) {
+            VTR_LOGV_WARN(verbosity_ > 1, "Primary output '%s' will be swept (%s)\n", netlist_.block_name(blk_id).c_str(), reason.c_str());
+            remove_block(blk_id);
+            ++dangling_outputs_swept;
+            return;
+        }
+
+        AtomBlockType type = netlist_.block_type(blk_id);
+        if (should_sweep_blocks_ && type == AtomBlockType::BLOCK && is_removable_block(netlist_, blk_id, &reason)) {
+            VTR_LOGV_WARN(verbosity_ > 1, "Block '%s' will be swept (%s)\n", netlist_.block_name(blk_id).c_str(), reason.c_str());
+            remove_block(blk_id);
+            ++dangling_blocks_swept;
+            return;
+        }
 
-        if (should_sweep_ios) {
-            pass_dangling_inputs_swept += sweep_inputs(netlist, verbosity);
-            pass_dangling_outputs_swept += sweep_outputs(netlist, verbosity);
+        if (should_sweep_constant_primary_outputs_ && type == AtomBlockType::OUTPAD && has_only_constant_inputs(blk_id)) {
+            VTR_LOGV_WARN(verbosity_ > 2, "Sweeping constant primary output '%s'\n", netlist_.block_name(blk_id).c_str());
+            remove_block(blk_id);
+            ++constant_outputs_swept;
+            return;
         }
 
-        if (should_sweep_blocks) {
-            pass_dangling_blocks_swept += sweep_blocks(netlist, verbosity);
+        size_t num_pins_marked = mark_undriven_block_outputs_as_constant(netlist_, blk_id, verbosity_);
+        num_pins_marked += infer_and_mark_block_pins_constant(netlist_, blk_id, const_gen_inference_method_, verbosity_);
+        if (num_pins_marked > 0) {
+            constant_generators_marked += num_pins_marked;
+
+            //The sinks of the block's (now possibly constant) output nets
+            for (AtomPinId output_pin : netlist_.block_output_pins(blk_id)) {
+                AtomNetId net_id = netlist_.pin_net(output_pin);
+                if (!net_id) continue;
+
+                for (AtomPinId sink_pin : netlist_.net_sinks(net_id)) {
+                    queue_block(netlist_.pin_block(sink_pin));
+                }
+            }
+        }
+    }
+
+    void process_net(const AtomNetId net_id) {
+        bool removable = false;
+        if (!netlist_.net_driver(net_id)) {
+            VTR_LOGV_WARN(verbosity_ > 1, "Net '%s' has no driver and will be removed\n", netlist_.net_name(net_id).c_str());
+            removable = true;
+        }
+        if (netlist_.net_sinks(net_id).size() == 0) {
+            VTR_LOGV_WARN(verbosity_ > 1, "Net '%s' has no sinks and will be removed\n", netlist_.net_name(net_id).c_str());
+            removable = true;
         }
+        if (!removable) return;
 
-        if (should_sweep_nets) {
-            pass_dangling_nets_swept += sweep_nets(netlist, verbosity);
+        //The driver may now have no fanout, and the sinks have lost an input
+        std::vector<AtomBlockId> net_blocks;
+        for (AtomPinId pin_id : netlist_.net_pins(net_id)) {
+            if (pin_id) net_blocks.push_back(netlist_.pin_block(pin_id));
         }
 
-        if (should_sweep_constant_primary_outputs) {
-            pass_constant_outputs_swept += sweep_constant_primary_outputs(netlist, verbosity);
+        netlist_.remove_net(net_id);
+        ++dangling_nets_swept;
+
+        for (AtomBlockId blk_id : net_blocks) {
+            queue_block(blk_id);
+        }
+    }
+
+    void remove_block(const AtomBlockId blk_id) {
+        //The block's nets lose their driver or a sink
+        std::vector<AtomNetId> block_nets;
+        for (AtomPinId pin_id : netlist_.block_pins(blk_id)) {
+            AtomNetId net_id = netlist_.pin_net(pin_id);
+            if (net_id) block_nets.push_back(net_id);
         }
 
-        pass_constant_generators_marked += mark_constant_generators(netlist, const_gen_inference_method, verbosity);
+        netlist_.remove_block(blk_id);
 
-        dangling_nets_swept += pass_dangling_nets_swept;
-        dangling_blocks_swept += pass_dangling_blocks_swept;
-        dangling_inputs_swept += pass_dangling_inputs_swept;
-        dangling_outputs_swept += pass_dangling_outputs_swept;
-        constant_outputs_swept += pass_constant_outputs_swept;
-        constant_generators_marked += pass_constant_generators_marked;
-    } while (pass_dangling_nets_swept != 0
-             || pass_dangling_blocks_swept != 0
-             || pass_dangling_inputs_swept != 0
-             || pass_dangling_outputs_swept != 0
-             || pass_constant_outputs_swept != 0
-             || pass_constant_generators_marked != 0);
+        for (AtomNetId net_id : block_nets) {
+            queue_net(net_id);
+        }
+    }
 
-    VTR_LOGV(verbosity > 0, "Swept input(s)      : %zu\n", dangling_inputs_swept);
+    bool has_only_constant_inputs(const AtomBlockId blk_id) const {
+        for (AtomPinId pin_id : netlist_.block_input_pins(blk_id)) {
+            AtomNetId net_id = netlist_.pin_net(pin_id);
+            if (net_id && !netlist_.net_is_constant(net_id)) return false;
+        }
+        return true;
+    }
+
+    void queue_block(const AtomBlockId blk_id) {
+        if (block_queued_[blk_id]) return;
+        block_queued_[blk_id] = true;
+        block_queue_.push_back(blk_id);
+    }
+
+    void queue_net(const AtomNetId net_id) {
+        if (!should_sweep_nets_ || net_queued_[net_id]) return;
+        net_queued_[net_id] = true;
+        net_queue_.push_back(net_id);
+    }
+
+  private:
+    AtomNetlist& netlist_;
+    bool should_sweep_ios_;
+    bool should_sweep_nets_;
+    bool should_sweep_blocks_;
+    bool should_sweep_constant_primary_outputs_;
+    e_const_gen_inference const_gen_inference_method_;
+    int verbosity_;
+
+    std::vector<AtomBlockId> block_queue_;
+    std::vector<AtomNetId> net_queue_;
+    vtr::vector<AtomBlockId, char> block_queued_;
+    vtr::vector<AtomNetId, char> net_queued_;
+};
+
+} // namespace
+
+size_t sweep_iterative(AtomNetlist& netlist,
+                       bool should_sweep_ios,
+                       bool should_sweep_nets,
+                       bool should_sweep_blocks,
+                       bool should_sweep_constant_primary_outputs,
+                       e_const_gen_inference const_gen_inference_method,
+                       int verbosity) {
+    AtomNetlistSweeper sweeper(netlist,
+                               should_sweep_ios,
+                               should_sweep_nets,
+                               should_sweep_blocks,
+                               should_sweep_constant_primary_outputs,
+                               const_gen_inference_method,
+                               verbosity);
+    sweeper.sweep();
+
+    VTR_LOGV(verbosity > 0, "Swept input(s)      : %zu\n", sweeper.dangling_inputs_swept);
     VTR_LOGV(verbosity > 0, "Swept output(s)     : %zu (%zu dangling, %zu constant)\n",
-             dangling_outputs_swept + constant_outputs_swept,
-             dangling_outputs_swept,
-             constant_outputs_swept);
-    VTR_LOGV(verbosity > 0, "Swept net(s)        : %zu\n", dangling_nets_swept);
-    VTR_LOGV(verbosity > 0, "Swept block(s)      : %zu\n", dangling_blocks_swept);
-    VTR_LOGV(verbosity > 0, "Constant Pins Marked: %zu\n", constant_generators_marked);
-
-    return dangling_nets_swept
-           + dangling_blocks_swept
-           + dangling_inputs_swept
-           + dangling_outputs_swept
-           + constant_outputs_swept;
+             sweeper.dangling_outputs_swept + sweeper.constant_outputs_swept,
+             sweeper.dangling_outputs_swept,
+             sweeper.constant_outputs_swept);
+    VTR_LOGV(verbosity > 0, "Swept net(s)        : %zu\n", sweeper.dangling_nets_swept);
+    VTR_LOGV(verbosity > 0, "Swept block(s)      : %zu\n", sweeper.dangling_blocks_swept);
+    VTR_LOGV(verbosity > 0, "Constant Pins Marked: %zu\n", sweeper.constant_generators_marked);
+
+    return sweeper.dangling_nets_swept
+           + sweeper.dangling_blocks_swept
+           + sweeper.dangling_inputs_swept
+           + sweeper.dangling_outputs_swept
+           + sweeper.constant_outputs_swept;
 }
 
 size_t sweep_blocks(AtomNetlist& netlist, int verbosity) {
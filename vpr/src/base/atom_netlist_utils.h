@@ -28,6 +28,10 @@ void absorb_buffer_luts(AtomNetlist& netlist, int verbosity);
  * @brief Repeatedly sweeps the netlist removing blocks and nets
  *        until nothing more can be swept. If sweep_ios is true also sweeps
  *        primary-inputs and primary-outputs
+ *
+ * Constant generators are also marked (as by mark_constant_generators()). After
+ * the initial candidates are found, only the neighbours of the swept blocks and nets
+ * (or of newly constant pins) are revisited.
  */
 size_t sweep_iterative(AtomNetlist& netlist,
                        bool should_sweep_dangling_ios,
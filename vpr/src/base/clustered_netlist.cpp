@@ -265,6 +265,10 @@ void ClusteredNetlist::shrink_to_fit_impl() {
     //Net data
 }
 
+size_t ClusteredNetlist::memory_usage_impl() const {
+    return vtr::memory_usage(block_pbs_, block_types_, block_logical_pins_, blocks_per_type_, pin_logical_index_);
+}
+
 /*
  *
  * Sanity Checks
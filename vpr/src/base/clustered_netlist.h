@@ -299,6 +299,9 @@ class ClusteredNetlist : public Netlist<ClusterBlockId, ClusterPortId, ClusterPi
     ///@brief Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
 
+    ///@brief Returns the (estimated) heap memory used by the cluster specific data, in bytes
+    size_t memory_usage_impl() const override;
+
     /*
      * Component removal
      */
@@ -7,8 +7,10 @@ ClusteredPinAtomPinsLookup::ClusteredPinAtomPinsLookup(const ClusteredNetlist& c
 ClusteredPinAtomPinsLookup::atom_pin_range ClusteredPinAtomPinsLookup::connected_atom_pins(ClusterPinId clustered_pin) const {
     VTR_ASSERT(clustered_pin);
 
-    return vtr::make_range(clustered_pin_connected_atom_pins_[clustered_pin].begin(),
-                           clustered_pin_connected_atom_pins_[clustered_pin].end());
+    size_t ipin = size_t(clustered_pin);
+    VTR_ASSERT_SAFE(ipin + 1 < connected_atom_pin_offsets_.size());
+    return vtr::make_range(connected_atom_pins_.begin() + connected_atom_pin_offsets_[ipin],
+                           connected_atom_pins_.begin() + connected_atom_pin_offsets_[ipin + 1]);
 }
 
 ClusterPinId ClusteredPinAtomPinsLookup::connected_clb_pin(AtomPinId atom_pin) const {
@@ -18,21 +20,27 @@ ClusterPinId ClusteredPinAtomPinsLookup::connected_clb_pin(AtomPinId atom_pin) c
 void ClusteredPinAtomPinsLookup::init_lookup(const ClusteredNetlist& clustered_netlist, const AtomNetlist& atom_netlist, const IntraLbPbPinLookup& pb_gpin_lookup) {
     auto clustered_pins = clustered_netlist.pins();
 
-    clustered_pin_connected_atom_pins_.clear();
-    clustered_pin_connected_atom_pins_.resize(clustered_pins.size());
+    //Offsets are indexed by the clustered pin ids, which must be contiguous
+    VTR_ASSERT(clustered_netlist.is_compressed());
+
+    connected_atom_pin_offsets_.clear();
+    connected_atom_pin_offsets_.reserve(clustered_pins.size() + 1);
+    connected_atom_pins_.clear();
 
     atom_pin_connected_cluster_pin_.clear();
     atom_pin_connected_cluster_pin_.resize(atom_netlist.pins().size());
 
+    connected_atom_pin_offsets_.push_back(0);
     for (ClusterPinId clustered_pin : clustered_pins) {
         auto clustered_block = clustered_netlist.pin_block(clustered_pin);
         int logical_pin_index = clustered_netlist.pin_logical_index(clustered_pin);
-        clustered_pin_connected_atom_pins_[clustered_pin] = find_clb_pin_connected_atom_pins(clustered_block, logical_pin_index, pb_gpin_lookup);
-
-        for (AtomPinId atom_pin : clustered_pin_connected_atom_pins_[clustered_pin]) {
+        for (AtomPinId atom_pin : find_clb_pin_connected_atom_pins(clustered_block, logical_pin_index, pb_gpin_lookup)) {
+            connected_atom_pins_.push_back(atom_pin);
             atom_pin_connected_cluster_pin_[atom_pin] = clustered_pin;
         }
+        connected_atom_pin_offsets_.push_back(connected_atom_pins_.size());
     }
+    connected_atom_pins_.shrink_to_fit();
 }
 
 ClusterAtomsLookup::ClusterAtomsLookup() {
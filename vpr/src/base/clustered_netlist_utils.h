@@ -23,7 +23,11 @@ class ClusteredPinAtomPinsLookup {
     void init_lookup(const ClusteredNetlist& clustered_netlist, const AtomNetlist& atom_netlist, const IntraLbPbPinLookup& pb_gpin_lookup);
 
   private:
-    vtr::vector<ClusterPinId, std::vector<AtomPinId>> clustered_pin_connected_atom_pins_;
+    //The atom pins connected to each clustered pin, in compressed sparse row layout: the atom pins
+    //of clustered pin i are [connected_atom_pin_offsets_[i], connected_atom_pin_offsets_[i + 1])
+    std::vector<size_t> connected_atom_pin_offsets_;
+    std::vector<AtomPinId> connected_atom_pins_;
+
     vtr::vector<AtomPinId, ClusterPinId> atom_pin_connected_cluster_pin_;
 };
 
@@ -0,0 +1,98 @@
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+#include "flow_checkpoint.h"
+
+///@brief The output file recorded for each stage of a flow checkpoint (empty for the stages which did not complete)
+typedef std::array<std::string, 3> t_flow_checkpoint_files;
+
+///@brief The name of each stage in the flow checkpoint file
+static const std::array<const char*, 3> FLOW_CHECKPOINT_STAGE_NAMES = {"pack", "place", "route"};
+
+static std::string get_flow_checkpoint_file(const std::string& checkpoint_dir);
+
+static t_flow_checkpoint_files read_flow_checkpoint(const std::string& checkpoint_dir);
+
+std::string get_place_snapshot_checkpoint_file(const std::string& checkpoint_dir) {
+    return (std::filesystem::path(checkpoint_dir) / "place.snapshot").string();
+}
+
+std::string get_route_checkpoint_file(const std::string& checkpoint_dir) {
+    return (std::filesystem::path(checkpoint_dir) / "route.checkpoint").string();
+}
+
+bool is_flow_stage_checkpointed(const std::string& checkpoint_dir, e_flow_checkpoint_stage stage, const std::string& output_file) {
+    t_flow_checkpoint_files files = read_flow_checkpoint(checkpoint_dir);
+    const std::string& checkpointed_file = files[size_t(stage)];
+
+    return !checkpointed_file.empty()
+           && checkpointed_file == output_file
+           && vtr::file_exists(checkpointed_file.c_str());
+}
+
+void checkpoint_flow_stage(const std::string& checkpoint_dir, e_flow_checkpoint_stage stage, const std::string& output_file) {
+    t_flow_checkpoint_files files = read_flow_checkpoint(checkpoint_dir);
+    files[size_t(stage)] = output_file;
+
+    //Replace the checkpoint atomically, so an interruption never leaves a partial one behind
+    std::string checkpoint_file = get_flow_checkpoint_file(checkpoint_dir);
+    std::string tmp_file = checkpoint_file + ".tmp";
+    {
+        std::ofstream fstream(tmp_file, std::ios::trunc);
+        if (!fstream) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "'%s' - Cannot write flow checkpoint.\n", tmp_file.c_str());
+        }
+
+        fstream << "#VPR flow checkpoint: completed stage and output file\n";
+        for (size_t istage = 0; istage < files.size(); ++istage) {
+            if (!files[istage].empty()) {
+                fstream << FLOW_CHECKPOINT_STAGE_NAMES[istage] << " " << files[istage] << "\n";
+            }
+        }
+
+        if (!fstream) {
+            VPR_FATAL_ERROR(VPR_ERROR_OTHER, "'%s' - Cannot write flow checkpoint.\n", tmp_file.c_str());
+        }
+    }
+
+    if (std::rename(tmp_file.c_str(), checkpoint_file.c_str()) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "'%s' - Cannot replace flow checkpoint with '%s'.\n",
+                        checkpoint_file.c_str(), tmp_file.c_str());
+    }
+}
+
+static std::string get_flow_checkpoint_file(const std::string& checkpoint_dir) {
+    return (std::filesystem::path(checkpoint_dir) / "flow.checkpoint").string();
+}
+
+///@brief Reads the flow checkpoint of checkpoint_dir (no stage completed if there is none)
+static t_flow_checkpoint_files read_flow_checkpoint(const std::string& checkpoint_dir) {
+    t_flow_checkpoint_files files;
+
+    std::ifstream fstream(get_flow_checkpoint_file(checkpoint_dir));
+    std::string line;
+    while (std::getline(fstream, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        //<stage> <output file>, where the file name may contain spaces
+        size_t split = line.find(' ');
+        if (split == std::string::npos) {
+            continue;
+        }
+        std::string stage_name = line.substr(0, split);
+        for (size_t istage = 0; istage < files.size(); ++istage) {
+            if (stage_name == FLOW_CHECKPOINT_STAGE_NAMES[istage]) {
+                files[istage] = line.substr(split + 1);
+            }
+        }
+    }
+
+    return files;
+}
@@ -0,0 +1,42 @@
+#ifndef VPR_FLOW_CHECKPOINT_H
+#define VPR_FLOW_CHECKPOINT_H
+
+/**
+ * @file
+ * @brief Checkpoints of the progress of the VPR flow, to resume an interrupted run (see --resume_from).
+ *
+ * A checkpoint directory holds:
+ *  - The flow checkpoint, which records the stages (packing, placement, routing) that completed,
+ *    and the output file (.net, .place, .route) each of them wrote.
+ *  - The placement snapshot written by the placer at every temperature (see write_place_snapshot()).
+ *  - The route checkpoint written by the router at every iteration (see write_route_checkpoint()).
+ *
+ * A resumed run loads the completed stages from their output files instead of running them again,
+ * and the interrupted stage resumes from its snapshot or checkpoint.
+ */
+
+#include <string>
+
+///@brief The stages of the flow recorded in a flow checkpoint
+enum class e_flow_checkpoint_stage {
+    PACK,
+    PLACE,
+    ROUTE
+};
+
+///@brief Returns the file of the placement snapshot in checkpoint_dir
+std::string get_place_snapshot_checkpoint_file(const std::string& checkpoint_dir);
+
+///@brief Returns the file of the route checkpoint in checkpoint_dir
+std::string get_route_checkpoint_file(const std::string& checkpoint_dir);
+
+/**
+ * @brief Returns true if the flow checkpoint of checkpoint_dir records that stage completed
+ *        and wrote output_file, and that file still exists
+ */
+bool is_flow_stage_checkpointed(const std::string& checkpoint_dir, e_flow_checkpoint_stage stage, const std::string& output_file);
+
+///@brief Records in the flow checkpoint of checkpoint_dir that stage completed and wrote output_file
+void checkpoint_flow_stage(const std::string& checkpoint_dir, e_flow_checkpoint_stage stage, const std::string& output_file);
+
+#endif
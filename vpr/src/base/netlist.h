@@ -418,7 +418,9 @@
 #include <unordered_map>
 #include "vtr_range.h"
 #include "vtr_logic.h"
+#include "vtr_memory_usage.h"
 #include "vtr_vector_map.h"
+#include "vtr_string_id_index.h"
 
 #include "logic_types.h"
 
@@ -445,6 +447,8 @@ class NetlistIdRemapper {
 
 template<typename BlockId = ParentBlockId, typename PortId = ParentPortId, typename PinId = ParentPinId, typename NetId = ParentNetId>
 class Netlist {
+    friend class NetlistSnapshot; //Reads and writes the netlist data directly (atom_netlist_snapshot.cpp)
+
   public: //Public Types
     typedef typename vtr::vector_map<BlockId, BlockId>::const_iterator block_iterator;
     typedef typename std::unordered_map<std::string, std::string>::const_iterator attr_iterator;
@@ -486,6 +490,9 @@ class Netlist {
     ///@brief Sanity check for internal consistency (throws an exception on failure)
     bool verify() const;
 
+    ///@brief Returns the (estimated) heap memory used by the netlist, in bytes
+    size_t memory_usage() const;
+
     ///@brief Returns true if the netlist has invalid entries due to modifications (e.g. from remove_*() calls)
     bool is_dirty() const;
 
@@ -495,6 +502,18 @@ class Netlist {
      */
     bool is_compressed() const;
 
+    ///@brief Returns the number of blocks, ports, pins and nets removed (i.e. with invalid ids) since the last compress()
+    size_t num_removed_ids() const;
+
+    /**
+     * @brief Returns true if the removed ids make up more than max_removed_fraction of all the ids
+     *
+     * compress() re-builds every netlist structure, whatever the number of removed ids. Callers
+     * which repeatedly modify the netlist can instead leave it dirty, and only compress it (e.g.
+     * with remove_and_compress()) once this is true, or at the end of their modifications.
+     */
+    bool should_compress(float max_removed_fraction) const;
+
     ///@brief Returns whether the net is ignored i.e. not routed
     bool net_is_ignored(const NetId id) const;
 
@@ -869,6 +888,14 @@ class Netlist {
      */
     void merge_nets(const NetId driver_net, const NetId sink_net);
 
+    /**
+     * @brief Reserves storage for the specified number of blocks, ports, pins and nets
+     *
+     * Avoids repeatedly re-allocating the netlist's storage while it is built, if its
+     * approximate size is known beforehand (e.g. by a netlist file reader).
+     */
+    void reserve(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets);
+
     /*
      * Note: all remove_*() will mark the associated items as invalid, but the items
      * will not be removed until compress() is called.
@@ -1080,6 +1107,8 @@ class Netlist {
     //The functions follow the Non-Virtual Interface (NVI) idiom, and
     //are called from this class in their respective non-impl() functions.
     virtual void shrink_to_fit_impl() {}
+    virtual size_t memory_usage_impl() const { return 0; }
+    virtual void reserve_impl(size_t /*num_blocks*/, size_t /*num_ports*/, size_t /*num_pins*/, size_t /*num_nets*/) {}
 
     virtual bool validate_block_sizes_impl(size_t /*num_blocks*/) const { return true; }
     virtual bool validate_port_sizes_impl(size_t /*num_ports*/) const { return true; }
@@ -1109,6 +1138,7 @@ class Netlist {
     std::string netlist_name_; ///<Name of the top-level netlist
     std::string netlist_id_;   ///<Unique identifier for the netlist
     bool dirty_ = false;       ///<Indicates the netlist has invalid entries from remove_*() functions
+    size_t num_removed_ids_ = 0; ///<Number of blocks/ports/pins/nets invalidated by remove_*() functions since the last compress()
 
     //Block data
     vtr::vector_map<BlockId, BlockId> block_ids_;    ///<Valid block ids
@@ -1158,7 +1188,7 @@ class Netlist {
   private: //Fast lookups
     vtr::vector_map<StringId, BlockId> block_name_to_block_id_;
     vtr::vector_map<StringId, NetId> net_name_to_net_id_;
-    std::unordered_map<std::string, StringId> string_to_string_id_;
+    vtr::string_id_index<StringId> string_to_string_id_; ///<Indexes strings_ without copying the strings
     vtr::vector_map<NetId, bool> net_is_ignored_; ///<Boolean mapping indicating if the net is ignored
     vtr::vector_map<NetId, bool> net_is_global_;  ///<Boolean mapping indicating if the net is global
 };
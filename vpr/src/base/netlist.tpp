@@ -68,6 +68,17 @@ bool Netlist<BlockId, PortId, PinId, NetId>::is_compressed() const {
     return !is_dirty();
 }
 
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+size_t Netlist<BlockId, PortId, PinId, NetId>::num_removed_ids() const {
+    return num_removed_ids_;
+}
+
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+bool Netlist<BlockId, PortId, PinId, NetId>::should_compress(float max_removed_fraction) const {
+    size_t num_ids = block_ids_.size() + port_ids_.size() + pin_ids_.size() + net_ids_.size();
+    return num_removed_ids_ > max_removed_fraction * num_ids;
+}
+
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 bool Netlist<BlockId, PortId, PinId, NetId>::net_is_ignored(const NetId id) const {
     VTR_ASSERT_SAFE(valid_net_id(id));
@@ -556,6 +567,31 @@ PinId Netlist<BlockId, PortId, PinId, NetId>::find_pin(const std::string name) c
  * Validation
  *
  */
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+size_t Netlist<BlockId, PortId, PinId, NetId>::memory_usage() const {
+    size_t bytes = 0;
+
+    //Block data
+    bytes += vtr::memory_usage(block_ids_, block_names_, block_ports_, block_num_input_ports_, block_num_output_ports_,
+                               block_num_clock_ports_, block_pins_, block_num_input_pins_, block_num_output_pins_,
+                               block_num_clock_pins_, block_params_, block_attrs_);
+
+    //Port data
+    bytes += vtr::memory_usage(port_ids_, port_names_, port_blocks_, port_pins_, port_widths_, port_types_);
+
+    //Pin data
+    bytes += vtr::memory_usage(pin_ids_, pin_ports_, pin_port_bits_, pin_nets_, pin_net_indices_, pin_is_constant_);
+
+    //Net data
+    bytes += vtr::memory_usage(net_ids_, net_names_, net_pins_);
+
+    //String data and lookups
+    bytes += vtr::memory_usage(string_ids_, strings_, block_name_to_block_id_, net_name_to_net_id_,
+                               string_to_string_id_, net_is_ignored_, net_is_global_);
+
+    return bytes + memory_usage_impl();
+}
+
 //Top-level verification method, checks that the sizes
 //references, and lookups are all consistent.
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
@@ -982,6 +1018,7 @@ void Netlist<BlockId, PortId, PinId, NetId>::remove_block(const BlockId blk_id)
 
     //Mark as invalid
     block_ids_[blk_id] = BlockId::INVALID();
+    ++num_removed_ids_;
 
     //Mark netlist dirty
     dirty_ = true;
@@ -1000,6 +1037,7 @@ void Netlist<BlockId, PortId, PinId, NetId>::remove_port(const PortId port_id) {
 
     //Mark as invalid
     port_ids_[port_id] = PortId::INVALID();
+    ++num_removed_ids_;
 
     //Call derived class' remove()
     remove_port_impl(port_id);
@@ -1020,6 +1058,7 @@ void Netlist<BlockId, PortId, PinId, NetId>::remove_pin(const PinId pin_id) {
 
     //Mark as invalid
     pin_ids_[pin_id] = PinId::INVALID();
+    ++num_removed_ids_;
 
     //Call derived class' remove()
     remove_pin_impl(pin_id);
@@ -1045,6 +1084,7 @@ void Netlist<BlockId, PortId, PinId, NetId>::remove_net(const NetId net_id) {
 
     //Mark as invalid
     net_ids_[net_id] = NetId::INVALID();
+    ++num_removed_ids_;
 
     //Call derived class' remove()
     remove_net_impl(net_id);
@@ -1132,6 +1172,7 @@ typename Netlist<BlockId, PortId, PinId, NetId>::IdRemapper Netlist<BlockId, Por
 
     //Netlist is now clean
     dirty_ = false;
+    num_removed_ids_ = 0;
 
     return id_remapper;
 }
@@ -1468,6 +1509,56 @@ void Netlist<BlockId, PortId, PinId, NetId>::shrink_to_fit() {
     VTR_ASSERT(validate_string_sizes());
 }
 
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+void Netlist<BlockId, PortId, PinId, NetId>::reserve(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) {
+    //Block data
+    block_ids_.reserve(num_blocks);
+    block_names_.reserve(num_blocks);
+    block_pins_.reserve(num_blocks);
+    block_num_input_pins_.reserve(num_blocks);
+    block_num_output_pins_.reserve(num_blocks);
+    block_num_clock_pins_.reserve(num_blocks);
+    block_ports_.reserve(num_blocks);
+    block_num_input_ports_.reserve(num_blocks);
+    block_num_output_ports_.reserve(num_blocks);
+    block_num_clock_ports_.reserve(num_blocks);
+    block_params_.reserve(num_blocks);
+    block_attrs_.reserve(num_blocks);
+
+    //Port data
+    port_ids_.reserve(num_ports);
+    port_names_.reserve(num_ports);
+    port_blocks_.reserve(num_ports);
+    port_pins_.reserve(num_ports);
+    port_widths_.reserve(num_ports);
+    port_types_.reserve(num_ports);
+
+    //Pin data
+    pin_ids_.reserve(num_pins);
+    pin_ports_.reserve(num_pins);
+    pin_port_bits_.reserve(num_pins);
+    pin_nets_.reserve(num_pins);
+    pin_net_indices_.reserve(num_pins);
+    pin_is_constant_.reserve(num_pins);
+
+    //Net data
+    net_ids_.reserve(num_nets);
+    net_names_.reserve(num_nets);
+    net_pins_.reserve(num_nets);
+    net_is_ignored_.reserve(num_nets);
+    net_is_global_.reserve(num_nets);
+
+    //String data (block and net names dominate)
+    size_t num_strings = num_blocks + num_nets;
+    string_ids_.reserve(num_strings);
+    strings_.reserve(num_strings);
+    string_to_string_id_.reserve(num_strings);
+    block_name_to_block_id_.reserve(num_strings);
+    net_name_to_net_id_.reserve(num_strings);
+
+    reserve_impl(num_blocks, num_ports, num_pins, num_nets);
+}
+
 /*
  *
  * Sanity Checks
@@ -1874,17 +1965,11 @@ bool Netlist<BlockId, PortId, PinId, NetId>::verify_block_invariants() const {
  */
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
 typename Netlist<BlockId, PortId, PinId, NetId>::StringId Netlist<BlockId, PortId, PinId, NetId>::find_string(const std::string& str) const {
-    auto iter = string_to_string_id_.find(str);
-    if (iter != string_to_string_id_.end()) {
-        StringId str_id = iter->second;
+    StringId str_id = string_to_string_id_.find(str, strings_);
 
-        VTR_ASSERT_SAFE(str_id);
-        VTR_ASSERT_SAFE(strings_[str_id] == str);
+    VTR_ASSERT_SAFE(!str_id || strings_[str_id] == str);
 
-        return str_id;
-    } else {
-        return StringId::INVALID();
-    }
+    return str_id;
 }
 
 template<typename BlockId, typename PortId, typename PinId, typename NetId>
@@ -2022,8 +2107,7 @@ typename Netlist<BlockId, PortId, PinId, NetId>::StringId Netlist<BlockId, PortI
         string_ids_.push_back(str_id);
 
         //Store the reverse look-up
-        auto key = str;
-        string_to_string_id_[key] = str_id;
+        string_to_string_id_.insert(str, str_id);
 
         //Initialize the data
         strings_.emplace_back(str);
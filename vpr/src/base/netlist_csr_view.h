@@ -0,0 +1,144 @@
+#ifndef NETLIST_CSR_VIEW_H
+#define NETLIST_CSR_VIEW_H
+
+/**
+ * @file
+ * @brief A frozen, flat view of the connectivity of a compressed Netlist.
+ *
+ * The Netlist accessors (net_pins(), pin_block(), block_pins() ...) go through per-net and
+ * per-block vectors, and pin_block() through the pin's port. This is flexible while the
+ * netlist is built, but inner loops which only read the connectivity (e.g. the placement
+ * cost updates) pay for the indirections on every call.
+ *
+ * NetlistCsrView copies the connectivity once into compressed sparse row arrays:
+ *  - The pins of each net (driver first, as in Netlist::net_pins()) and the block of each
+ *    of these pins, so a net's blocks are read without touching the pins.
+ *  - The pins of each block, in Netlist::block_pins() order.
+ *  - The net, net pin index and block of each pin.
+ *
+ * The view does not track later changes: it must be rebuilt if the netlist is modified.
+ */
+
+#include <vector>
+
+#include "vtr_array_view.h"
+#include "vtr_assert.h"
+
+#include "netlist.h"
+
+template<typename BlockId, typename PortId, typename PinId, typename NetId>
+class NetlistCsrView {
+  public:
+    NetlistCsrView() = default;
+
+    ///@brief Builds the view of netlist, which must be compressed (i.e. its ids are contiguous)
+    explicit NetlistCsrView(const Netlist<BlockId, PortId, PinId, NetId>& netlist) {
+        VTR_ASSERT(netlist.is_compressed());
+
+        size_t num_nets = netlist.nets().size();
+        size_t num_blocks = netlist.blocks().size();
+        size_t num_pins = netlist.pins().size();
+
+        net_pin_offsets_.reserve(num_nets + 1);
+        net_pins_.reserve(num_pins);
+        net_pin_blocks_.reserve(num_pins);
+        net_pin_offsets_.push_back(0);
+        for (NetId net_id : netlist.nets()) {
+            for (PinId pin_id : netlist.net_pins(net_id)) {
+                net_pins_.push_back(pin_id);
+                net_pin_blocks_.push_back(pin_id ? netlist.pin_block(pin_id) : BlockId::INVALID());
+            }
+            net_pin_offsets_.push_back(net_pins_.size());
+        }
+
+        block_pin_offsets_.reserve(num_blocks + 1);
+        block_pins_.reserve(num_pins);
+        block_pin_offsets_.push_back(0);
+        for (BlockId blk_id : netlist.blocks()) {
+            for (PinId pin_id : netlist.block_pins(blk_id)) {
+                block_pins_.push_back(pin_id);
+            }
+            block_pin_offsets_.push_back(block_pins_.size());
+        }
+
+        pin_nets_.reserve(num_pins);
+        pin_net_indices_.reserve(num_pins);
+        pin_blocks_.reserve(num_pins);
+        for (PinId pin_id : netlist.pins()) {
+            pin_nets_.push_back(netlist.pin_net(pin_id));
+            pin_net_indices_.push_back(netlist.pin_net_index(pin_id));
+            pin_blocks_.push_back(netlist.pin_block(pin_id));
+        }
+    }
+
+  public: //Nets
+    ///@brief Returns the pins of net_id, driver first
+    vtr::array_view<const PinId> net_pins(const NetId net_id) const {
+        size_t inet = size_t(net_id);
+        VTR_ASSERT_SAFE(inet + 1 < net_pin_offsets_.size());
+        return vtr::array_view<const PinId>(net_pins_.data() + net_pin_offsets_[inet], net_pin_offsets_[inet + 1] - net_pin_offsets_[inet]);
+    }
+
+    ///@brief Returns the blocks of the pins of net_id, in net_pins() order
+    vtr::array_view<const BlockId> net_pin_blocks(const NetId net_id) const {
+        size_t inet = size_t(net_id);
+        VTR_ASSERT_SAFE(inet + 1 < net_pin_offsets_.size());
+        return vtr::array_view<const BlockId>(net_pin_blocks_.data() + net_pin_offsets_[inet], net_pin_offsets_[inet + 1] - net_pin_offsets_[inet]);
+    }
+
+    ///@brief Returns the number of pins (driver and sinks) of net_id
+    size_t net_num_pins(const NetId net_id) const {
+        size_t inet = size_t(net_id);
+        VTR_ASSERT_SAFE(inet + 1 < net_pin_offsets_.size());
+        return net_pin_offsets_[inet + 1] - net_pin_offsets_[inet];
+    }
+
+    ///@brief Returns the pin at net_pin_index of net_id (0 is the driver)
+    PinId net_pin(const NetId net_id, int net_pin_index) const {
+        VTR_ASSERT_SAFE(net_pin_index >= 0 && size_t(net_pin_index) < net_num_pins(net_id));
+        return net_pins_[net_pin_offsets_[size_t(net_id)] + net_pin_index];
+    }
+
+    ///@brief Returns the block of the driver of net_id
+    BlockId net_driver_block(const NetId net_id) const {
+        return (net_num_pins(net_id) > 0) ? net_pin_blocks_[net_pin_offsets_[size_t(net_id)]] : BlockId::INVALID();
+    }
+
+  public: //Blocks
+    ///@brief Returns the pins of blk_id
+    vtr::array_view<const PinId> block_pins(const BlockId blk_id) const {
+        size_t iblk = size_t(blk_id);
+        VTR_ASSERT_SAFE(iblk + 1 < block_pin_offsets_.size());
+        return vtr::array_view<const PinId>(block_pins_.data() + block_pin_offsets_[iblk], block_pin_offsets_[iblk + 1] - block_pin_offsets_[iblk]);
+    }
+
+  public: //Pins
+    NetId pin_net(const PinId pin_id) const {
+        VTR_ASSERT_SAFE(size_t(pin_id) < pin_nets_.size());
+        return pin_nets_[size_t(pin_id)];
+    }
+
+    int pin_net_index(const PinId pin_id) const {
+        VTR_ASSERT_SAFE(size_t(pin_id) < pin_net_indices_.size());
+        return pin_net_indices_[size_t(pin_id)];
+    }
+
+    BlockId pin_block(const PinId pin_id) const {
+        VTR_ASSERT_SAFE(size_t(pin_id) < pin_blocks_.size());
+        return pin_blocks_[size_t(pin_id)];
+    }
+
+  private:
+    std::vector<size_t> net_pin_offsets_; ///<[0..num_nets] Start of the pins of each net in net_pins_
+    std::vector<PinId> net_pins_;
+    std::vector<BlockId> net_pin_blocks_;
+
+    std::vector<size_t> block_pin_offsets_; ///<[0..num_blocks] Start of the pins of each block in block_pins_
+    std::vector<PinId> block_pins_;
+
+    std::vector<NetId> pin_nets_;
+    std::vector<int> pin_net_indices_;
+    std::vector<BlockId> pin_blocks_;
+};
+
+#endif
@@ -18,6 +18,10 @@
 #include "vtr_logic.h"
 #include "vtr_version.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vpr_error.h"
 #include "vpr_types.h"
 
@@ -965,9 +969,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         std::stringstream instances_ss;
 
         size_t unconn_count = 0;
-        for (auto& inst : cell_instances_) {
-            inst->print_verilog(instances_ss, unconn_count, depth + 1);
-        }
+        print_instances(instances_ss, unconn_count, [depth](Instance& inst, std::ostream& os, size_t& inst_unconn_count) {
+            inst.print_verilog(os, inst_unconn_count, depth + 1);
+        });
 
         //Unconnected wires declarations
         if (unconn_count) {
@@ -1034,9 +1038,9 @@ class NetlistWriterVisitor : public NetlistVisitor {
         blif_os_ << "\n";
         blif_os_ << indent(depth) << "#Cell instances\n";
         size_t unconn_count = 0;
-        for (auto& inst : cell_instances_) {
-            inst->print_blif(blif_os_, unconn_count);
-        }
+        print_instances(blif_os_, unconn_count, [](Instance& inst, std::ostream& os, size_t& inst_unconn_count) {
+            inst.print_blif(os, inst_unconn_count);
+        });
 
         blif_os_ << "\n";
         blif_os_ << indent(depth) << ".end\n";
@@ -1086,13 +1090,74 @@ class NetlistWriterVisitor : public NetlistVisitor {
         }
 
         //Cells
-        for (const auto& inst : cell_instances_) {
-            inst->print_sdf(sdf_os_, depth + 1);
-        }
+        size_t unconn_count = 0;
+        print_instances(sdf_os_, unconn_count, [depth](Instance& inst, std::ostream& os, size_t& /*inst_unconn_count*/) {
+            inst.print_sdf(os, depth + 1);
+        });
 
         sdf_os_ << indent(depth) << ")\n";
     }
 
+    /**
+     * @brief Prints all the cell instances to os in order, with print_inst(inst, os, unconn_count)
+     *
+     * With TBB, chunks of instances are formatted concurrently into separate buffers which
+     * are then written in order. Since the unconnected net names of a chunk depend on the
+     * number created by the preceding chunks, chunks which create some are formatted again
+     * (concurrently) once that number is known, unless it is the number they assumed.
+     * The output is identical to printing the instances serially.
+     */
+    template<typename PrintInst>
+    void print_instances(std::ostream& os, size_t& unconn_count, PrintInst print_inst) {
+#ifdef VPR_USE_TBB
+        constexpr size_t INSTANCES_PER_CHUNK = 1024;
+        size_t num_chunks = (cell_instances_.size() + INSTANCES_PER_CHUNK - 1) / INSTANCES_PER_CHUNK;
+
+        std::vector<std::string> chunk_text(num_chunks);
+        std::vector<size_t> chunk_first_unconn(num_chunks, unconn_count);
+        std::vector<size_t> chunk_num_unconn(num_chunks, 0);
+
+        auto print_chunk = [&](size_t ichunk) {
+            std::stringstream chunk_ss;
+            size_t chunk_unconn_count = chunk_first_unconn[ichunk];
+
+            size_t end = std::min(cell_instances_.size(), (ichunk + 1) * INSTANCES_PER_CHUNK);
+            for (size_t iinst = ichunk * INSTANCES_PER_CHUNK; iinst < end; ++iinst) {
+                print_inst(*cell_instances_[iinst], chunk_ss, chunk_unconn_count);
+            }
+
+            chunk_text[ichunk] = chunk_ss.str();
+            chunk_num_unconn[ichunk] = chunk_unconn_count - chunk_first_unconn[ichunk];
+        };
+
+        tbb::parallel_for(size_t(0), num_chunks, print_chunk);
+
+        //Re-format the chunks whose unconnected nets were misnumbered
+        std::vector<size_t> reprint_chunks;
+        for (size_t ichunk = 0; ichunk < num_chunks; ++ichunk) {
+            size_t first_unconn = unconn_count;
+            unconn_count += chunk_num_unconn[ichunk];
+            if (chunk_num_unconn[ichunk] > 0 && first_unconn != chunk_first_unconn[ichunk]) {
+                chunk_first_unconn[ichunk] = first_unconn;
+                reprint_chunks.push_back(ichunk);
+            }
+        }
+
+        tbb::parallel_for(size_t(0), reprint_chunks.size(), [&](size_t i) {
+            print_chunk(reprint_chunks[i]);
+        });
+
+        for (std::string& text : chunk_text) {
+            os << text;
+            std::string().swap(text); //Free the chunk's buffer once written
+        }
+#else
+        for (auto& inst : cell_instances_) {
+            print_inst(*inst, os, unconn_count);
+        }
+#endif
+    }
+
     /**
      * @brief Returns the name of a circuit-level Input/Output
      *
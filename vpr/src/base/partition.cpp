@@ -11,7 +11,7 @@ void Partition::set_name(std::string _part_name) {
     name = _part_name;
 }
 
-const PartitionRegion Partition::get_part_region() {
+const PartitionRegion& Partition::get_part_region() {
     return part_region;
 }
 
@@ -46,7 +46,7 @@ class Partition {
     /**
      * @brief Get the PartitionRegion (union of rectangular regions) for this partition
      */
-    const PartitionRegion get_part_region();
+    const PartitionRegion& get_part_region();
 
   private:
     std::string name;            ///< name of the partition, name will be unique across partitions
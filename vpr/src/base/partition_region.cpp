@@ -17,7 +17,7 @@ void PartitionRegion::set_partition_region(std::vector<Region> pr) {
     partition_region = pr;
 }
 
-bool PartitionRegion::empty() {
+bool PartitionRegion::empty() const {
     return partition_region.size() == 0;
 }
 
@@ -79,3 +79,14 @@ void print_partition_region(FILE* fp, PartitionRegion pr) {
         print_region(fp, part_region[i]);
     }
 }
+
+void shift_partition_region(PartitionRegion& pr, int x_shift, int y_shift) {
+    std::vector<Region> part_region = pr.get_partition_region();
+    for (Region& region : part_region) {
+        RegionRectCoord rect = region.get_region_rect();
+        region.set_region_rect(RegionRectCoord(rect.xmin + x_shift, rect.ymin + y_shift,
+                                               rect.xmax + x_shift, rect.ymax + y_shift,
+                                               rect.layer_num));
+    }
+    pr.set_partition_region(part_region);
+}
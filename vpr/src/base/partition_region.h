@@ -36,7 +36,7 @@ class PartitionRegion {
     /**
      * @brief Check if the PartitionRegion is empty (meaning there is no constraint on the object the PartitionRegion belongs to)
      */
-    bool empty();
+    bool empty() const;
 
     /**
      * @brief Check if the given location is within the legal bounds of the  PartitionRegion.
@@ -70,4 +70,7 @@ class PartitionRegion {
 ///@brief used to print data from a PartitionRegion
 void print_partition_region(FILE* fp, PartitionRegion pr);
 
+///@brief Moves all the regions of a PartitionRegion by x_shift, y_shift grid tiles
+void shift_partition_region(PartitionRegion& pr, int x_shift, int y_shift);
+
 #endif /* PARTITION_REGIONS_H */
@@ -30,6 +30,7 @@
 #include "read_xml_arch_file.h"
 #include "echo_files.h"
 #include "route_common.h"
+#include "router_lookahead.h"
 #include "place_macro.h"
 #include "power.h"
 
@@ -89,6 +90,9 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
 
     t_placer_opts placer_opts = placer_opts_ref;
 
+    /* Router options of the search attempts (see --aggressive_binary_search_abort) */
+    t_router_opts search_router_opts = router_opts;
+
     /* Allocate the major routing structures. */
 
     if (router_opts.route_type == GLOBAL) {
@@ -147,6 +151,9 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
 
     attempt_count = 0;
 
+    /* Keep the lookahead when the routing graph is rebuilt for another channel width */
+    set_router_lookahead_cache_pinned(router_opts.reuse_lookahead_across_chan_widths);
+
     while (final == -1) {
         VTR_LOG("\n");
         VTR_LOG("Attempting to route at %d channels (binary search bounds: [%d, %d])\n", current, low, high);
@@ -191,9 +198,18 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
                       arch->num_directs,
                       false);
         }
+
+        //Below a known routable width a failed attempt only costs a slightly worse
+        //minimum width, so give up on the likely failures early
+        search_router_opts.routing_failure_predictor = router_opts.routing_failure_predictor;
+        if (router_opts.aggressive_binary_search_abort && high != -1 && current < high
+            && router_opts.routing_failure_predictor != OFF) {
+            search_router_opts.routing_failure_predictor = AGGRESSIVE;
+        }
+
         success = try_route(router_net_list,
                             current,
-                            router_opts,
+                            search_router_opts,
                             analysis_opts,
                             det_routing_arch, segment_inf,
                             net_delay,
@@ -373,6 +389,9 @@ int binary_search_place_and_route(const Netlist<>& placement_net_list,
      * * the best channel widths for final drawing and statistics output.  */
     t_chan_width chan_width = init_chan(final, arch->Chans, graph_directionality);
 
+    /* The final routing graph gets a lookahead of its own */
+    set_router_lookahead_cache_pinned(false);
+
     free_rr_graph();
 
     create_rr_graph(graph_type,
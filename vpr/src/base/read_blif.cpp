@@ -13,6 +13,9 @@
  * blifparse callback interface.  The callback methods are then called when basic blif
  * primitives are encountered by the parser.  The callback methods then create the associated
  * netlist data structures.
+ *
+ * The callbacks are either called by the blifparse library, or by the ParallelBlifParser
+ * (read_blif_parallel.h) which tokenizes the file concurrently.
  */
 #include <cstdio>
 #include <cstring>
@@ -22,6 +25,7 @@
 #include <cctype> //std::isdigit
 
 #include "blifparse.hpp"
+#include "read_blif_parallel.h"
 #include "atom_netlist.h"
 
 #include "vtr_assert.h"
@@ -75,6 +79,11 @@ struct BlifAllocCallback : public blifparse::Callback {
 
         blif_models_.emplace_back(model_name, netlist_id_);
         blif_models_.back().set_block_types(inpad_model_, outpad_model_);
+        if (blif_models_.size() <= model_size_hints_.size()) {
+            //Nets are mostly driven by a block, so the number of blocks approximates the number of nets
+            const t_blif_model_size& model_size = model_size_hints_[blif_models_.size() - 1];
+            blif_models_.back().reserve(model_size.num_blocks, model_size.num_ports, model_size.num_pins, model_size.num_blocks);
+        }
         blif_models_black_box_.emplace_back(false);
         ended_ = false;
         set_curr_block(AtomBlockId::INVALID()); //This statement doesn't define a block, so mark invalid
@@ -407,6 +416,11 @@ struct BlifAllocCallback : public blifparse::Callback {
     }
 
   public:
+    ///@brief Sets the approximate size of each model to be parsed, used to reserve their storage
+    void set_model_size_hints(std::vector<t_blif_model_size> model_sizes) {
+        model_size_hints_ = std::move(model_sizes);
+    }
+
     //Retrieve the netlist
     size_t determine_main_netlist_index() {
         //Look through all the models loaded, to find the one which is non-blackbox (i.e. has real blocks
@@ -636,6 +650,7 @@ struct BlifAllocCallback : public blifparse::Callback {
 
     std::vector<AtomNetlist> blif_models_;
     std::vector<bool> blif_models_black_box_;
+    std::vector<t_blif_model_size> model_size_hints_;
 
     AtomNetlist& main_netlist_;    ///<User object we fill
     const std::string netlist_id_; ///<Unique identifier based on the contents of the blif file
@@ -740,12 +755,19 @@ bool is_real_param(const std::string& param) {
 AtomNetlist read_blif(e_circuit_format circuit_format,
                       const char* blif_file,
                       const t_model* user_models,
-                      const t_model* library_models) {
+                      const t_model* library_models,
+                      bool parallel_parse) {
     AtomNetlist netlist;
     std::string netlist_id = vtr::secure_digest_file(blif_file);
 
     BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models);
-    blifparse::blif_parse_filename(blif_file, alloc_callback);
+    if (parallel_parse) {
+        ParallelBlifParser parser(blif_file);
+        alloc_callback.set_model_size_hints(parser.model_sizes());
+        parser.parse(alloc_callback);
+    } else {
+        blifparse::blif_parse_filename(blif_file, alloc_callback);
+    }
 
     return netlist;
 }
@@ -11,6 +11,7 @@ bool is_real_param(const std::string& param);
 AtomNetlist read_blif(e_circuit_format circuit_format,
                       const char* blif_file,
                       const t_model* user_models,
-                      const t_model* library_models);
+                      const t_model* library_models,
+                      bool parallel_parse = false);
 
 #endif /*READ_BLIF_H*/
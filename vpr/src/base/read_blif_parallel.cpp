@@ -0,0 +1,605 @@
+#include "read_blif_parallel.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "vtr_assert.h"
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#    include <tbb/task_arena.h>
+#endif
+
+///@brief Chunks per thread, to balance chunks of different densities
+static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+enum class e_blif_command {
+    MODEL,
+    INPUTS,
+    OUTPUTS,
+    NAMES,
+    LATCH,
+    SUBCKT,
+    BLACKBOX,
+    END,
+    CONN,
+    CNAME,
+    ATTR,
+    PARAM
+};
+
+///@brief A BLIF command, with the arguments of its callback
+struct t_blif_command {
+    e_blif_command type;
+    int lineno;                       ///<Line number, relative to the start of its chunk
+    std::vector<std::string> strings; ///<String arguments (for .subckt the model and then the port/net pairs)
+
+    std::vector<std::vector<blifparse::LogicValue>> so_cover; ///<.names only
+
+    blifparse::LatchType latch_type = blifparse::LatchType::UNSPECIFIED; ///<.latch only
+    blifparse::LogicValue latch_init = blifparse::LogicValue::UNKOWN;    ///<.latch only
+};
+
+///@brief A part of the file starting at a directive line, and its commands
+struct t_blif_chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    int first_line = 1; ///<Line number of the chunk's first line
+    int num_lines = 0;  ///<Number of line ends in the chunk
+
+    std::vector<t_blif_command> commands;
+
+    bool has_error = false; ///<Tokenizing stopped at an error, reported after the commands
+    int error_lineno = 0;   ///<Relative to the start of the chunk
+    std::string error_near;
+    std::string error_msg;
+};
+
+///@brief The contents of a file, memory mapped where supported
+class BlifFileData {
+  public:
+    explicit BlifFileData(const std::string& filename) {
+#ifndef _WIN32
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            vpr_throw(VPR_ERROR_BLIF_F, filename.c_str(), 0, "Could not open file '%s'.\n", filename.c_str());
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0) {
+            close(fd);
+            vpr_throw(VPR_ERROR_BLIF_F, filename.c_str(), 0, "Could not stat file '%s'.\n", filename.c_str());
+        }
+        size_ = file_stat.st_size;
+        if (size_ > 0) {
+            void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                mapped_ = mapped;
+                data_ = static_cast<const char*>(mapped);
+            }
+        }
+        close(fd);
+        if (mapped_ || size_ == 0) {
+            return;
+        }
+#endif
+        //Fallback: read the whole file
+        FILE* fp = std::fopen(filename.c_str(), "rb");
+        if (!fp) {
+            vpr_throw(VPR_ERROR_BLIF_F, filename.c_str(), 0, "Could not open file '%s'.\n", filename.c_str());
+        }
+        std::fseek(fp, 0, SEEK_END);
+        buffer_.resize(std::ftell(fp));
+        std::fseek(fp, 0, SEEK_SET);
+        size_t num_read = std::fread(buffer_.data(), 1, buffer_.size(), fp);
+        std::fclose(fp);
+        buffer_.resize(num_read);
+
+        size_ = buffer_.size();
+        data_ = buffer_.data();
+    }
+
+    BlifFileData(const BlifFileData&) = delete;
+    BlifFileData& operator=(const BlifFileData&) = delete;
+
+    ~BlifFileData() {
+#ifndef _WIN32
+        if (mapped_) {
+            munmap(mapped_, size_);
+        }
+#endif
+    }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    size_t size() const { return size_; }
+
+  private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    void* mapped_ = nullptr;
+    std::vector<char> buffer_;
+};
+
+static std::vector<std::pair<const char*, const char*>> split_into_chunks(const char* begin, const char* end, size_t min_chunk_bytes);
+static bool is_chunk_boundary(const char* line, const char* begin, const char* end);
+static bool is_line_continuation(const char* p, const char* end);
+static bool next_logical_line(const char*& p, const char* end, int& lineno, int& line_start, std::vector<std::string>& tokens, std::string& error);
+static void tokenize_chunk(t_blif_chunk& chunk);
+static bool parse_command(std::vector<std::string>& tokens, int line_start, std::vector<t_blif_command>& commands, bool& in_names, std::string& error);
+static bool parse_latch(std::vector<std::string>& tokens, t_blif_command& command, std::string& error);
+
+ParallelBlifParser::ParallelBlifParser(const std::string& filename, size_t min_chunk_bytes)
+    : filename_(filename) {
+    BlifFileData data(filename);
+
+    for (const auto& range : split_into_chunks(data.begin(), data.end(), min_chunk_bytes)) {
+        chunks_.emplace_back(new t_blif_chunk);
+        chunks_.back()->begin = range.first;
+        chunks_.back()->end = range.second;
+    }
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), chunks_.size(), [&](size_t ichunk) {
+        tokenize_chunk(*chunks_[ichunk]);
+    });
+#else
+    for (auto& chunk : chunks_) {
+        tokenize_chunk(*chunk);
+    }
+#endif
+
+    //Chunks only refer to the file data while being tokenized
+    int first_line = 1;
+    for (auto& chunk : chunks_) {
+        chunk->begin = nullptr;
+        chunk->end = nullptr;
+        chunk->first_line = first_line;
+        first_line += chunk->num_lines;
+    }
+
+    //Estimate the size of each model
+    for (const auto& chunk : chunks_) {
+        for (const t_blif_command& command : chunk->commands) {
+            if (command.type == e_blif_command::MODEL) {
+                model_sizes_.emplace_back();
+            }
+            if (model_sizes_.empty()) continue; //Error reported by the callback
+
+            t_blif_model_size& model_size = model_sizes_.back();
+            switch (command.type) {
+                case e_blif_command::INPUTS:
+                case e_blif_command::OUTPUTS:
+                    model_size.num_blocks += command.strings.size();
+                    model_size.num_ports += command.strings.size();
+                    model_size.num_pins += command.strings.size();
+                    break;
+                case e_blif_command::NAMES:
+                    model_size.num_blocks += 1;
+                    model_size.num_ports += 2;
+                    model_size.num_pins += command.strings.size();
+                    break;
+                case e_blif_command::LATCH:
+                    model_size.num_blocks += 1;
+                    model_size.num_ports += 3;
+                    model_size.num_pins += 3;
+                    break;
+                case e_blif_command::SUBCKT:
+                    model_size.num_blocks += 1;
+                    model_size.num_ports += (command.strings.size() - 1) / 2;
+                    model_size.num_pins += (command.strings.size() - 1) / 2;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+ParallelBlifParser::~ParallelBlifParser() = default;
+
+void ParallelBlifParser::parse(blifparse::Callback& callback) {
+    callback.start_parse();
+
+    callback.filename(filename_);
+
+    for (auto& chunk : chunks_) {
+        for (t_blif_command& command : chunk->commands) {
+            callback.lineno(chunk->first_line + command.lineno);
+
+            std::vector<std::string>& strings = command.strings;
+            switch (command.type) {
+                case e_blif_command::MODEL:
+                    callback.begin_model(std::move(strings[0]));
+                    break;
+                case e_blif_command::INPUTS:
+                    callback.inputs(std::move(strings));
+                    break;
+                case e_blif_command::OUTPUTS:
+                    callback.outputs(std::move(strings));
+                    break;
+                case e_blif_command::NAMES:
+                    callback.names(std::move(strings), std::move(command.so_cover));
+                    break;
+                case e_blif_command::LATCH:
+                    callback.latch(std::move(strings[0]), std::move(strings[1]), command.latch_type, std::move(strings[2]), command.latch_init);
+                    break;
+                case e_blif_command::SUBCKT: {
+                    std::vector<std::string> ports;
+                    std::vector<std::string> nets;
+                    for (size_t i = 1; i + 1 < strings.size(); i += 2) {
+                        ports.push_back(std::move(strings[i]));
+                        nets.push_back(std::move(strings[i + 1]));
+                    }
+                    callback.subckt(std::move(strings[0]), std::move(ports), std::move(nets));
+                    break;
+                }
+                case e_blif_command::BLACKBOX:
+                    callback.blackbox();
+                    break;
+                case e_blif_command::END:
+                    callback.end_model();
+                    break;
+                case e_blif_command::CONN:
+                    callback.conn(std::move(strings[0]), std::move(strings[1]));
+                    break;
+                case e_blif_command::CNAME:
+                    callback.cname(std::move(strings[0]));
+                    break;
+                case e_blif_command::ATTR:
+                    callback.attr(std::move(strings[0]), std::move(strings[1]));
+                    break;
+                case e_blif_command::PARAM:
+                    callback.param(std::move(strings[0]), std::move(strings[1]));
+                    break;
+                default:
+                    VTR_ASSERT_MSG(false, "Unrecognized BLIF command");
+            }
+        }
+        chunk->commands.clear();
+        chunk->commands.shrink_to_fit();
+
+        if (chunk->has_error) {
+            callback.parse_error(chunk->first_line + chunk->error_lineno, chunk->error_near, chunk->error_msg);
+            return;
+        }
+    }
+
+    callback.finish_parse();
+}
+
+///@brief Splits [begin, end) into chunks starting at directive lines
+static std::vector<std::pair<const char*, const char*>> split_into_chunks(const char* begin, const char* end, size_t min_chunk_bytes) {
+    size_t size = end - begin;
+
+    size_t num_threads = 1;
+#ifdef VPR_USE_TBB
+    num_threads = tbb::this_task_arena::max_concurrency();
+#endif
+    size_t num_chunks = std::min(CHUNKS_PER_THREAD * num_threads, size / std::max<size_t>(min_chunk_bytes, 1) + 1);
+
+    std::vector<std::pair<const char*, const char*>> chunks;
+    const char* chunk_begin = begin;
+    for (size_t ichunk = 1; ichunk < num_chunks; ++ichunk) {
+        const char* p = std::max(chunk_begin, begin + ichunk * (size / num_chunks));
+
+        //Advance to the next line starting with a directive
+        while (p < end) {
+            p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!p) {
+                p = end;
+                break;
+            }
+            ++p;
+            if (is_chunk_boundary(p, begin, end)) break;
+        }
+        if (p >= end) break;
+
+        chunks.emplace_back(chunk_begin, p);
+        chunk_begin = p;
+    }
+    chunks.emplace_back(chunk_begin, end);
+
+    return chunks;
+}
+
+/**
+ * @brief Returns true if a chunk can start at line, i.e. it starts with a directive
+ *        (so it is not a .names cover row) and does not continue the previous line
+ */
+static bool is_chunk_boundary(const char* line, const char* begin, const char* end) {
+    //The previous line must not end with a continuation (conservatively including
+    //comments ending with a backslash)
+    const char* prev = line - 1; //The previous line's '\n'
+    while (prev > begin && (prev[-1] == '\r')) {
+        --prev;
+    }
+    if (prev > begin && prev[-1] == '\\') {
+        return false;
+    }
+
+    const char* p = line;
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    return p < end && *p == '.';
+}
+
+///@brief Returns true if p (a backslash) is followed by the end of the line
+static bool is_line_continuation(const char* p, const char* end) {
+    VTR_ASSERT_SAFE(*p == '\\');
+    ++p;
+    while (p < end && *p == '\r') {
+        ++p;
+    }
+    return p == end || *p == '\n';
+}
+
+/**
+ * @brief Splits the next non-empty logical line (i.e. joining continued lines) at p into tokens
+ *
+ * As in the blifparse lexer, '#' starts a comment at the start of a token, '=' is a token
+ * of its own, and quoted strings (including their quotes) are single tokens.
+ *
+ * Returns false at the end of the chunk, or on an error (setting error).
+ */
+static bool next_logical_line(const char*& p, const char* end, int& lineno, int& line_start, std::vector<std::string>& tokens, std::string& error) {
+    tokens.clear();
+    while (p < end) {
+        char c = *p;
+        if (c == ' ' || c == '\t' || c == '\r') {
+            ++p;
+        } else if (c == '\n') {
+            ++p;
+            ++lineno;
+            if (!tokens.empty()) {
+                return true;
+            }
+        } else if (c == '#') {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            p = eol ? eol : end;
+        } else if (c == '\\' && is_line_continuation(p, end)) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            p = eol ? eol + 1 : end;
+            ++lineno;
+        } else {
+            if (tokens.empty()) {
+                line_start = lineno;
+            }
+
+            const char* token_begin = p;
+            if (c == '=') {
+                ++p;
+            } else if (c == '"') {
+                ++p;
+                while (p < end && *p != '"' && *p != '\n') {
+                    ++p;
+                }
+                if (p == end || *p != '"') {
+                    error = "Unterminated quoted string";
+                    tokens.emplace_back(token_begin, p);
+                    return false;
+                }
+                ++p;
+            } else {
+                while (p < end) {
+                    c = *p;
+                    if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '=' || c == '"') break;
+                    if (c == '\\' && is_line_continuation(p, end)) break;
+                    ++p;
+                }
+            }
+            tokens.emplace_back(token_begin, p);
+        }
+    }
+    return !tokens.empty(); //Last line without a line end
+}
+
+static void tokenize_chunk(t_blif_chunk& chunk) {
+    //Count the line ends first, so the chunk's line numbering is known even if it has an error
+    chunk.num_lines = std::count(chunk.begin, chunk.end, '\n');
+
+    const char* p = chunk.begin;
+    int lineno = 0;
+    int line_start = 0;
+    bool in_names = false;
+    std::vector<std::string> tokens;
+    std::string error;
+    while (true) {
+        bool has_line = next_logical_line(p, chunk.end, lineno, line_start, tokens, error);
+        if (!has_line && error.empty()) break;
+
+        if (error.empty()) {
+            parse_command(tokens, line_start, chunk.commands, in_names, error);
+        }
+
+        if (!error.empty()) {
+            chunk.has_error = true;
+            chunk.error_lineno = line_start;
+            chunk.error_near = tokens.empty() ? "" : tokens.back();
+            chunk.error_msg = error;
+            break;
+        }
+    }
+}
+
+///@brief Adds the command of the logical line tokens to commands. Returns false on an error (setting error).
+static bool parse_command(std::vector<std::string>& tokens, int line_start, std::vector<t_blif_command>& commands, bool& in_names, std::string& error) {
+    const std::string& directive = tokens[0];
+
+    if (directive[0] != '.') {
+        if (!in_names) {
+            error = "Unexpected '" + directive + "'";
+            return false;
+        }
+
+        //A single-output cover row of the current .names
+        t_blif_command& names = commands.back();
+        std::vector<blifparse::LogicValue> row;
+        for (const std::string& token : tokens) {
+            for (char c : token) {
+                if (c == '0') {
+                    row.push_back(blifparse::LogicValue::FALSE);
+                } else if (c == '1') {
+                    row.push_back(blifparse::LogicValue::TRUE);
+                } else if (c == '-') {
+                    row.push_back(blifparse::LogicValue::DONT_CARE);
+                } else {
+                    error = "Unrecognized character in .names single-output cover row";
+                    return false;
+                }
+            }
+        }
+        if (row.size() != names.strings.size()) {
+            error = vtr::string_fmt("Mismatched .names single-output cover row."
+                                    " names connected to %zu net(s), but cover row has %zu element(s)",
+                                    names.strings.size(), row.size());
+            return false;
+        }
+        names.so_cover.push_back(std::move(row));
+        return true;
+    }
+
+    in_names = false;
+
+    t_blif_command command;
+    command.lineno = line_start;
+
+    //Checks the number of arguments (excluding the directive)
+    auto check_num_args = [&](size_t min_args, size_t max_args) {
+        size_t num_args = tokens.size() - 1;
+        if (num_args < min_args || num_args > max_args) {
+            error = vtr::string_fmt("Unexpected number of arguments (%zu) for %s", num_args, directive.c_str());
+            return false;
+        }
+        for (size_t i = 1; i < tokens.size(); ++i) {
+            if (tokens[i] == "=" && directive != ".subckt") {
+                error = "Unexpected '=' in " + directive;
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (directive == ".model") {
+        command.type = e_blif_command::MODEL;
+        if (!check_num_args(1, 1)) return false;
+    } else if (directive == ".inputs") {
+        command.type = e_blif_command::INPUTS;
+        if (!check_num_args(0, tokens.size())) return false;
+    } else if (directive == ".outputs") {
+        command.type = e_blif_command::OUTPUTS;
+        if (!check_num_args(0, tokens.size())) return false;
+    } else if (directive == ".names") {
+        command.type = e_blif_command::NAMES;
+        if (!check_num_args(0, tokens.size())) return false;
+        in_names = true;
+    } else if (directive == ".latch") {
+        command.type = e_blif_command::LATCH;
+        if (!check_num_args(2, 5)) return false;
+        if (!parse_latch(tokens, command, error)) return false;
+        commands.push_back(std::move(command));
+        return true;
+    } else if (directive == ".subckt") {
+        command.type = e_blif_command::SUBCKT;
+        //Model, then port=net triples
+        if (tokens.size() < 2 || (tokens.size() - 2) % 3 != 0) {
+            error = "Mismatched subckt port and net connection(s)";
+            return false;
+        }
+        command.strings.push_back(std::move(tokens[1]));
+        for (size_t i = 2; i < tokens.size(); i += 3) {
+            if (tokens[i] == "=" || tokens[i + 1] != "=" || tokens[i + 2] == "=") {
+                error = "Expected port=net connections in .subckt";
+                return false;
+            }
+            command.strings.push_back(std::move(tokens[i]));
+            command.strings.push_back(std::move(tokens[i + 2]));
+        }
+        commands.push_back(std::move(command));
+        return true;
+    } else if (directive == ".blackbox") {
+        command.type = e_blif_command::BLACKBOX;
+        if (!check_num_args(0, 0)) return false;
+    } else if (directive == ".end") {
+        command.type = e_blif_command::END;
+        if (!check_num_args(0, 0)) return false;
+    } else if (directive == ".conn") {
+        command.type = e_blif_command::CONN;
+        if (!check_num_args(2, 2)) return false;
+    } else if (directive == ".cname") {
+        command.type = e_blif_command::CNAME;
+        if (!check_num_args(1, 1)) return false;
+    } else if (directive == ".attr" || directive == ".param") {
+        command.type = (directive == ".attr") ? e_blif_command::ATTR : e_blif_command::PARAM;
+        if (!check_num_args(1, 2)) return false;
+        if (tokens.size() == 2) {
+            tokens.emplace_back(); //No value
+        }
+    } else {
+        error = "Unrecognized directive '" + directive + "'";
+        return false;
+    }
+
+    command.strings.assign(std::make_move_iterator(tokens.begin() + 1), std::make_move_iterator(tokens.end()));
+    commands.push_back(std::move(command));
+    return true;
+}
+
+///@brief Fills in a .latch command from its tokens (input, output [type control] [init])
+static bool parse_latch(std::vector<std::string>& tokens, t_blif_command& command, std::string& error) {
+    size_t num_args = tokens.size() - 1;
+
+    command.strings = {std::move(tokens[1]), std::move(tokens[2]), ""};
+
+    if (num_args >= 4) {
+        const std::string& type = tokens[3];
+        if (type == "fe") {
+            command.latch_type = blifparse::LatchType::FALLING_EDGE;
+        } else if (type == "re") {
+            command.latch_type = blifparse::LatchType::RISING_EDGE;
+        } else if (type == "ah") {
+            command.latch_type = blifparse::LatchType::ACTIVE_HIGH;
+        } else if (type == "al") {
+            command.latch_type = blifparse::LatchType::ACTIVE_LOW;
+        } else if (type == "as") {
+            command.latch_type = blifparse::LatchType::ASYNCHRONOUS;
+        } else {
+            error = "Unrecognized .latch type '" + type + "'";
+            return false;
+        }
+
+        if (tokens[4] != "NIL") {
+            command.strings[2] = std::move(tokens[4]);
+        }
+    }
+
+    if (num_args == 3 || num_args == 5) {
+        const std::string& init = tokens.back();
+        if (init == "0") {
+            command.latch_init = blifparse::LogicValue::FALSE;
+        } else if (init == "1") {
+            command.latch_init = blifparse::LogicValue::TRUE;
+        } else if (init == "2") {
+            command.latch_init = blifparse::LogicValue::DONT_CARE;
+        } else if (init == "3") {
+            command.latch_init = blifparse::LogicValue::UNKOWN;
+        } else {
+            error = "Unrecognized .latch initial value '" + init + "'";
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,53 @@
+#ifndef READ_BLIF_PARALLEL_H
+#define READ_BLIF_PARALLEL_H
+/**
+ * @file
+ * @brief A parallel BLIF/EBLIF parser driving the blifparse callback interface
+ *
+ * The file is mapped into memory and split into chunks at directive lines (e.g.
+ * .model/.names/.subckt), which are tokenized concurrently (when built with TBB).
+ * The commands of all chunks are then passed to a blifparse::Callback serially
+ * and in file order, so the callback sees the same sequence of calls as with
+ * blifparse::blif_parse_filename().
+ *
+ * Errors are reported through Callback::parse_error() once all the commands
+ * preceding them have been passed to the callback.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "blifparse.hpp"
+
+///@brief Approximate size of a BLIF .model, used to reserve the storage of its netlist
+struct t_blif_model_size {
+    size_t num_blocks = 0;
+    size_t num_ports = 0;
+    size_t num_pins = 0;
+};
+
+struct t_blif_chunk;
+
+class ParallelBlifParser {
+  public:
+    ///@brief Files are not split into chunks smaller than this, as tokenizing them is cheap
+    static constexpr size_t DEFAULT_MIN_CHUNK_BYTES = 1 << 20;
+
+    ///@brief Loads and tokenizes filename, split into chunks of at least min_chunk_bytes
+    explicit ParallelBlifParser(const std::string& filename, size_t min_chunk_bytes = DEFAULT_MIN_CHUNK_BYTES);
+    ~ParallelBlifParser();
+
+    ///@brief Returns the approximate size of each .model of the file, in file order
+    const std::vector<t_blif_model_size>& model_sizes() const { return model_sizes_; }
+
+    ///@brief Passes the commands of the file to callback. Can only be called once.
+    void parse(blifparse::Callback& callback);
+
+  private:
+    std::string filename_;
+    std::vector<std::unique_ptr<t_blif_chunk>> chunks_; ///<The file split at directive lines
+    std::vector<t_blif_model_size> model_sizes_;
+};
+
+#endif /*READ_BLIF_PARALLEL_H*/
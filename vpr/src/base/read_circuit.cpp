@@ -3,6 +3,7 @@
 #include "read_interchange_netlist.h"
 #include "atom_netlist.h"
 #include "atom_netlist_utils.h"
+#include "atom_netlist_snapshot.h"
 #include "echo_files.h"
 
 #include "vtr_assert.h"
@@ -49,6 +50,20 @@ AtomNetlist read_and_process_circuit(e_circuit_format circuit_format, t_vpr_setu
         }
     }
 
+    //A cached snapshot of the cleaned netlist replaces reading and cleaning the circuit
+    const t_file_name_opts& file_name_opts = vpr_setup.FileNameOpts;
+    if (!file_name_opts.read_atom_netlist_snapshot_file.empty()) {
+        AtomNetlist netlist;
+        {
+            vtr::ScopedStartFinishTimer t("Load circuit snapshot");
+            netlist = read_atom_netlist_snapshot(file_name_opts.read_atom_netlist_snapshot_file, user_models, library_models);
+        }
+
+        show_circuit_stats(netlist);
+
+        return netlist;
+    }
+
     AtomNetlist netlist;
     {
         vtr::ScopedStartFinishTimer t("Load circuit");
@@ -56,7 +71,7 @@ AtomNetlist read_and_process_circuit(e_circuit_format circuit_format, t_vpr_setu
         switch (circuit_format) {
             case e_circuit_format::BLIF:
             case e_circuit_format::EBLIF:
-                netlist = read_blif(circuit_format, circuit_file, user_models, library_models);
+                netlist = read_blif(circuit_format, circuit_file, user_models, library_models, vpr_setup.NetlistOpts.parallel_blif_parse);
                 break;
             case e_circuit_format::FPGA_INTERCHANGE:
                 netlist = read_interchange_netlist(circuit_file, arch);
@@ -86,6 +101,10 @@ AtomNetlist read_and_process_circuit(e_circuit_format circuit_format, t_vpr_setu
         print_netlist_as_blif(getEchoFileName(E_ECHO_ATOM_NETLIST_CLEANED), netlist);
     }
 
+    if (!file_name_opts.write_atom_netlist_snapshot_file.empty()) {
+        write_atom_netlist_snapshot(file_name_opts.write_atom_netlist_snapshot_file, netlist);
+    }
+
     show_circuit_stats(netlist);
 
     return netlist;
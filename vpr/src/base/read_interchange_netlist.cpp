@@ -8,18 +8,16 @@
  */
 #include <cmath>
 #include <limits>
-#include <kj/std/iostream.h>
 #include <regex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
-#include <zlib.h>
 #include <iostream>
-#include <sstream>
 
 #include "LogicalNetlist.capnp.h"
 #include "capnp/serialize.h"
 #include "capnp/serialize-packed.h"
+#include "gzip_input_stream.h"
 
 #include "atom_netlist.h"
 
@@ -525,32 +523,8 @@ AtomNetlist read_interchange_netlist(const char* ic_netlist_file,
     AtomNetlist netlist;
     std::string netlist_id = vtr::secure_digest_file(ic_netlist_file);
 
-    // Decompress GZipped capnproto device file
-    gzFile file = gzopen(ic_netlist_file, "r");
-    VTR_ASSERT(file != Z_NULL);
-
-    std::vector<uint8_t> output_data;
-    output_data.resize(4096);
-    std::stringstream sstream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
-    while (true) {
-        int ret = gzread(file, output_data.data(), output_data.size());
-        VTR_ASSERT(ret >= 0);
-        if (ret > 0) {
-            sstream.write((const char*)output_data.data(), ret);
-            VTR_ASSERT(sstream);
-        } else {
-            VTR_ASSERT(ret == 0);
-            int error;
-            gzerror(file, &error);
-            VTR_ASSERT(error == Z_OK);
-            break;
-        }
-    }
-
-    VTR_ASSERT(gzclose(file) == Z_OK);
-
-    sstream.seekg(0);
-    kj::std::StdInputStream istream(sstream);
+    // Read the GZipped capnproto netlist file, inflating it as the message is read
+    GzipInputStream istream(ic_netlist_file);
 
     // Reader options
     capnp::ReaderOptions reader_options;
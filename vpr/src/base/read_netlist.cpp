@@ -6,6 +6,7 @@
  * @brief Read a circuit netlist in XML format and populate the netlist data structures for VPR
  */
 
+#include <cctype>
 #include <cstdio>
 #include <cstring>
 #include <ctime>
@@ -61,9 +62,215 @@ static t_pb_routes alloc_pb_route(t_pb_graph_node* pb_graph_node);
 
 static void load_atom_pin_mapping(const ClusteredNetlist& clb_nlist);
 
+namespace {
+
+///@brief The text of an element of a .net file
+struct t_net_file_element {
+    std::string name;
+    std::string text;
+    size_t line = 0; ///<Line of the file the element starts at
+};
+
+/**
+ * @brief Reads the elements of a .net file one at a time
+ *
+ * The packed netlist is a root <block> whose children are the clusters. Rather than
+ * loading the DOM of the whole file (many times the size of the file) the file is
+ * scanned for the children of the root, and only the text of the current one is held
+ * in memory, so it can be loaded into its own (small) DOM, processed and discarded.
+ */
+class NetFileReader {
+  public:
+    explicit NetFileReader(const char* filename)
+        : filename_(filename)
+        , file_(std::fopen(filename, "rb")) {
+        if (!file_) {
+            throw pugiutil::XmlError("Failed to open file", filename_);
+        }
+    }
+
+    NetFileReader(const NetFileReader&) = delete;
+    NetFileReader& operator=(const NetFileReader&) = delete;
+
+    ~NetFileReader() {
+        std::fclose(file_);
+    }
+
+    ///@brief Reads the start tag of the root element (as a complete element). Returns false if there is none.
+    bool next_root(t_net_file_element& element) {
+        while (skip_to_markup()) {
+            begin_element(element);
+            e_markup kind = read_markup(&element.name);
+            if (kind == e_markup::START_TAG) {
+                element.text += "</" + element.name + ">";
+                root_open_ = true;
+            }
+            if (kind == e_markup::START_TAG || kind == e_markup::EMPTY_TAG) {
+                capture_ = nullptr;
+                return true;
+            }
+            capture_ = nullptr;
+        }
+        return false;
+    }
+
+    ///@brief Reads the next child element of the root element. Returns false once the root element is closed.
+    bool next_child(t_net_file_element& element) {
+        while (root_open_) {
+            if (!skip_to_markup()) {
+                throw pugiutil::XmlError("Unexpected end of file (root element is not closed)", filename_, line_);
+            }
+            begin_element(element);
+            e_markup kind = read_markup(&element.name);
+            if (kind == e_markup::START_TAG) {
+                //Read up to the matching end tag
+                std::string name;
+                for (size_t depth = 1; depth > 0;) {
+                    if (!skip_to_markup()) {
+                        throw pugiutil::XmlError("Unexpected end of file (element '" + element.name + "' is not closed)", filename_, line_);
+                    }
+                    e_markup child_kind = read_markup(&name);
+                    if (child_kind == e_markup::START_TAG) {
+                        ++depth;
+                    } else if (child_kind == e_markup::END_TAG) {
+                        --depth;
+                    }
+                }
+            } else if (kind == e_markup::END_TAG) {
+                root_open_ = false;
+            }
+            capture_ = nullptr;
+
+            if (kind == e_markup::START_TAG || kind == e_markup::EMPTY_TAG) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    enum class e_markup {
+        START_TAG,
+        EMPTY_TAG,
+        END_TAG,
+        OTHER //Comments, processing instructions, DOCTYPE, CDATA
+    };
+
+    //Returns the next character of the file (or EOF), appending it to the captured text
+    int get() {
+        if (pos_ == size_) {
+            size_ = std::fread(buffer_, 1, sizeof(buffer_), file_);
+            pos_ = 0;
+            if (size_ == 0) {
+                return EOF;
+            }
+        }
+        char c = buffer_[pos_++];
+        if (c == '\n') {
+            ++line_;
+        }
+        if (capture_) {
+            capture_->push_back(c);
+        }
+        return c;
+    }
+
+    //Returns the next character, which must exist
+    int get_required() {
+        int c = get();
+        if (c == EOF) {
+            throw pugiutil::XmlError("Unexpected end of file", filename_, line_);
+        }
+        return c;
+    }
+
+    //Consumes the file up to and including the next '<'. Returns false at the end of the file.
+    bool skip_to_markup() {
+        for (int c = get(); c != EOF; c = get()) {
+            if (c == '<') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //Starts capturing the text of element, whose '<' was just consumed
+    void begin_element(t_net_file_element& element) {
+        element.text = "<";
+        element.line = line_;
+        capture_ = &element.text;
+    }
+
+    //Consumes characters up to and including end
+    void skip_past(const char* end) {
+        size_t len = std::strlen(end);
+        std::string window;
+        while (window.size() < len || window.compare(window.size() - len, len, end) != 0) {
+            window.push_back(get_required());
+        }
+    }
+
+    //Consumes the markup following a '<', returning its kind (and the name of tags)
+    e_markup read_markup(std::string* name) {
+        int c = get_required();
+        if (c == '!') {
+            c = get_required();
+            if (c == '-') {
+                skip_past("-->");
+            } else if (c == '[') {
+                skip_past("]]>");
+            } else {
+                skip_past(">");
+            }
+            return e_markup::OTHER;
+        } else if (c == '?') {
+            skip_past("?>");
+            return e_markup::OTHER;
+        } else if (c == '/') {
+            skip_past(">");
+            return e_markup::END_TAG;
+        }
+
+        name->clear();
+        while (c != '>' && c != '/' && !std::isspace(c)) {
+            name->push_back(c);
+            c = get_required();
+        }
+
+        //Skip the attributes, whose (quoted) values may contain '>' or '/'
+        int prev = 0;
+        while (c != '>') {
+            if (c == '"' || c == '\'') {
+                int quote = c;
+                while (get_required() != quote) {
+                }
+            }
+            prev = c;
+            c = get_required();
+        }
+        return (prev == '/') ? e_markup::EMPTY_TAG : e_markup::START_TAG;
+    }
+
+    std::string filename_;
+    std::FILE* file_;
+
+    char buffer_[1 << 16];
+    size_t pos_ = 0;
+    size_t size_ = 0;
+    size_t line_ = 1;
+
+    std::string* capture_ = nullptr; //Text of the element being read
+    bool root_open_ = false;
+};
+
+} // namespace
+
 /**
  * @brief Initializes the clb_nlist with info from a netlist
  *
+ * The file is read one cluster at a time (see NetFileReader), so the DOM
+ * of only one cluster is held in memory at a time.
+ *
  *   @param net_file   Name of the netlist file to read
  */
 ClusteredNetlist read_netlist(const char* net_file,
@@ -84,26 +291,24 @@ ClusteredNetlist read_netlist(const char* net_file,
     //Save an identifier for the netlist based on it's contents
     auto clb_nlist = ClusteredNetlist(net_file, vtr::secure_digest_file(net_file));
 
-    pugi::xml_document doc;
-    pugiutil::loc_data loc_data;
-    try {
-        loc_data = pugiutil::load_xml(doc, net_file);
-    } catch (pugiutil::XmlError& e) {
-        vpr_throw(VPR_ERROR_NET_F, net_file, 0,
-                  "Failed to load netlist file '%s' (%s).\n", net_file, e.what());
-    }
-
     try {
         /* Save netlist file's name in file-scoped variable */
         netlist_file_name = net_file;
 
+        NetFileReader net_file_reader(net_file);
+        t_net_file_element element;
+
         /* Root node should be block */
-        auto top = doc.child("block");
-        if (!top) {
-            vpr_throw(VPR_ERROR_NET_F, net_file, loc_data.line(top),
+        if (!net_file_reader.next_root(element) || element.name != "block") {
+            vpr_throw(VPR_ERROR_NET_F, net_file, element.line,
                       "Root element must be 'block'.\n");
         }
 
+        //The root element, and later its children other than clusters
+        pugi::xml_document doc;
+        pugiutil::loc_data loc_data = pugiutil::load_xml_buffer(doc, net_file, element.text.data(), element.text.size(), element.line);
+        auto top = doc.child("block");
+
         /* Check top-level netlist attributes */
         auto top_name = top.attribute("name");
         if (!top_name) {
@@ -164,6 +369,28 @@ ClusteredNetlist read_netlist(const char* net_file,
             }
         }
 
+        /* Parse all CLB blocks and all nets*/
+
+        //Reset atom/pb mapping (it is reloaded from the packed netlist file)
+        for (auto blk_id : atom_ctx.nlist.blocks())
+            atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
+
+        /* Process netlist, one top-level element at a time */
+        pugi::xml_document block_doc;
+        while (net_file_reader.next_child(element)) {
+            if (element.name == "block") {
+                auto block_loc_data = pugiutil::load_xml_buffer(block_doc, net_file, element.text.data(), element.text.size(), element.line);
+                processComplexBlock(block_doc.child("block"), ClusterBlockId(bcount), &num_primitives, block_loc_data, &clb_nlist);
+                block_doc.reset();
+                bcount++;
+            } else {
+                //Keep the (small) top level I/O lists, and anything else, with the root
+                pugi::xml_document child_doc;
+                pugiutil::load_xml_buffer(child_doc, net_file, element.text.data(), element.text.size(), element.line);
+                top.append_copy(child_doc.document_element());
+            }
+        }
+
         //Collect top level I/Os
         auto top_inputs = pugiutil::get_single_child(top, "inputs", loc_data);
         circuit_inputs = vtr::split(top_inputs.text().get());
@@ -174,25 +401,10 @@ ClusteredNetlist read_netlist(const char* net_file,
         auto top_clocks = pugiutil::get_single_child(top, "clocks", loc_data);
         circuit_clocks = vtr::split(top_clocks.text().get());
 
-        /* Parse all CLB blocks and all nets*/
-
-        //Reset atom/pb mapping (it is reloaded from the packed netlist file)
-        for (auto blk_id : atom_ctx.nlist.blocks())
-            atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
-
-        //Count the number of blocks for allocation
-        bcount = pugiutil::count_children(top, "block", loc_data, pugiutil::ReqOpt::OPTIONAL);
         if (bcount == 0)
             VTR_LOG_WARN("Packed netlist contains no clustered blocks\n");
 
-        /* Process netlist */
-        unsigned i = 0;
-        for (auto curr_block = top.child("block"); curr_block; curr_block = curr_block.next_sibling("block")) {
-            processComplexBlock(curr_block, ClusterBlockId(i), &num_primitives, loc_data, &clb_nlist);
-            i++;
-        }
-        VTR_ASSERT(bcount == i);
-        VTR_ASSERT(clb_nlist.blocks().size() == i);
+        VTR_ASSERT(clb_nlist.blocks().size() == bcount);
         VTR_ASSERT(num_primitives >= 0);
         VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.nlist.blocks().size());
 
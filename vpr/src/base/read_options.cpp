@@ -9,6 +9,8 @@
 #include "vtr_log.h"
 #include "vtr_util.h"
 #include "vtr_path.h"
+#include <map>
+#include <set>
 #include <string>
 
 using argparse::ConvertedValue;
@@ -29,6 +31,83 @@ t_options read_options(int argc, const char** argv) {
     return args;
 }
 
+t_options read_options_throw(int argc, const char** argv) {
+    t_options args = t_options(); //Explicitly initialize for zero initialization
+
+    auto parser = create_arg_parser(argv[0], args);
+
+    try {
+        parser.parse_args_throw(argc, argv);
+    } catch (const argparse::ArgParseHelp&) {
+        parser.print_help();
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Help requested instead of running VPR\n");
+    } catch (const argparse::ArgParseVersion&) {
+        parser.print_version();
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Version requested instead of running VPR\n");
+    } catch (const argparse::ArgParseError& e) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "%s\n", e.what());
+    }
+
+    set_conditional_defaults(args);
+
+    verify_args(args);
+
+    return args;
+}
+
+t_options read_options_with_overrides(const std::vector<std::string>& args, const std::vector<std::string>& override_args) {
+    //Look-up of the option strings (e.g. '--seed', '-j') to the number of values they take
+    t_options dummy_args = t_options();
+    auto parser = create_arg_parser("vpr", dummy_args);
+
+    std::map<std::string, char> option_nargs;
+    for (const auto& group : parser.argument_groups()) {
+        for (const auto& arg : group.arguments()) {
+            if (arg->positional()) {
+                continue;
+            }
+            for (const std::string& opt : {arg->long_option(), arg->short_option()}) {
+                if (!opt.empty()) {
+                    option_nargs[opt] = arg->nargs();
+                }
+            }
+        }
+    }
+
+    std::set<std::string> overridden_options;
+    for (const std::string& arg : override_args) {
+        if (option_nargs.count(arg)) {
+            overridden_options.insert(arg);
+        }
+    }
+
+    //Drop the overridden options (and their values) from args
+    std::vector<const char*> argv = {"vpr"};
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (!overridden_options.count(args[i])) {
+            argv.push_back(args[i].c_str());
+            continue;
+        }
+
+        char nargs = option_nargs[args[i]];
+        if (nargs == '0') {
+            continue;
+        } else if (nargs == '1') {
+            ++i;
+        } else {
+            //A variable number of values, up to the next option
+            while (i + 1 < args.size() && !option_nargs.count(args[i + 1])) {
+                ++i;
+            }
+        }
+    }
+    for (const std::string& arg : override_args) {
+        argv.push_back(arg.c_str());
+    }
+
+    return read_options_throw(argv.size(), argv.data());
+}
+
 struct ParseOnOff {
     ConvertedValue<bool> from_str(std::string str) {
         ConvertedValue<bool> conv_value;
@@ -209,6 +288,8 @@ struct ParseNodeReorderAlgorithm {
             conv_value.set_value(DEGREE_BFS);
         else if (str == "random_shuffle")
             conv_value.set_value(RANDOM_SHUFFLE);
+        else if (str == "spatial_hilbert")
+            conv_value.set_value(SPATIAL_HILBERT);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_rr_node_reorder_algorithm (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -223,15 +304,17 @@ struct ParseNodeReorderAlgorithm {
             conv_value.set_value("none");
         else if (val == DEGREE_BFS)
             conv_value.set_value("degree_bfs");
-        else {
-            VTR_ASSERT(val == RANDOM_SHUFFLE);
+        else if (val == RANDOM_SHUFFLE)
             conv_value.set_value("random_shuffle");
+        else {
+            VTR_ASSERT(val == SPATIAL_HILBERT);
+            conv_value.set_value("spatial_hilbert");
         }
         return conv_value;
     }
 
     std::vector<std::string> default_choices() {
-        return {"none", "degree_bfs", "random_shuffle"};
+        return {"none", "degree_bfs", "random_shuffle", "spatial_hilbert"};
     }
 };
 
@@ -1018,6 +1101,10 @@ struct ParseRouterHeap {
             conv_value.set_value(e_heap_type::BINARY_HEAP);
         else if (str == "bucket")
             conv_value.set_value(e_heap_type::BUCKET_HEAP_APPROXIMATION);
+        else if (str == "four_ary")
+            conv_value.set_value(e_heap_type::FOUR_ARY_HEAP);
+        else if (str == "radix")
+            conv_value.set_value(e_heap_type::RADIX_HEAP);
         else {
             std::stringstream msg;
             msg << "Invalid conversion from '" << str << "' to e_heap_type (expected one of: " << argparse::join(default_choices(), ", ") << ")";
@@ -1030,6 +1117,10 @@ struct ParseRouterHeap {
         ConvertedValue<std::string> conv_value;
         if (val == e_heap_type::BINARY_HEAP)
             conv_value.set_value("binary");
+        else if (val == e_heap_type::FOUR_ARY_HEAP)
+            conv_value.set_value("four_ary");
+        else if (val == e_heap_type::RADIX_HEAP)
+            conv_value.set_value("radix");
         else {
             VTR_ASSERT(val == e_heap_type::BUCKET_HEAP_APPROXIMATION);
             conv_value.set_value("bucket");
@@ -1038,7 +1129,7 @@ struct ParseRouterHeap {
     }
 
     std::vector<std::string> default_choices() {
-        return {"binary", "bucket"};
+        return {"binary", "bucket", "four_ary", "radix"};
     }
 };
 
@@ -1384,6 +1475,25 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .metavar("DEVICE_NAME")
         .default_value("auto");
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.crop_device_to_floorplan, "--crop_device_to_floorplan")
+        .help(
+            "Only builds the device grid and routing resources covering the bounding box of the floorplan"
+            " constraints (--read_vpr_constraints), grown by --crop_device_margin tiles. All blocks must then"
+            " fit in that part of the device. Placement and routing files still use full device coordinates.")
+        .default_value("off");
+
+    gen_grp.add_argument<int>(args.crop_device_margin, "--crop_device_margin")
+        .help("Number of grid tiles kept around the floorplan constraints with --crop_device_to_floorplan")
+        .default_value("2");
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.pipeline_device_creation, "--pipeline_device_creation")
+        .help(
+            "Builds the routing resource graph and router lookahead on a background thread while the circuit"
+            " is packed, instead of after packing. Only applies when the device (--device) and the channel"
+            " width (--route_chan_width) are fixed and the circuit is packed rather than loaded; otherwise"
+            " the device is built after packing.")
+        .default_value("off");
+
     gen_grp.add_argument<size_t>(args.num_workers, "--num_workers", "-j")
         .help(
             "Controls how many parallel workers VPR may use:\n"
@@ -1425,6 +1535,32 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument(args.write_timing_trace, "--write_timing_trace")
+        .help(
+            "Writes the (nested) run time and peak memory usage of each stage of the flow, on every thread,"
+            " to the specified file as a Chrome trace event JSON (viewable with chrome://tracing or Perfetto)")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument<bool, ParseOnOff>(args.server, "--server")
+        .help(
+            "After implementing the circuit, keeps running and reads further jobs from standard input:"
+            " one VPR command line (without the program name) per line, until 'exit' or the end of the input."
+            " Jobs using the same architecture file, --device and --route_chan_width as the previous job"
+            " re-use its routing resource graph and router lookahead instead of re-building them.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    gen_grp.add_argument(args.fork_jobs, "--fork_jobs")
+        .help(
+            "Once the circuit is packed and the device (with its routing resource graph and router lookahead) is"
+            " built, forks a child process per line of the specified job file to place and route it. Each line"
+            " holds options (e.g. '--seed 2') replacing those of the command line for that job. The children share"
+            " the device data copy-on-write, and write their output files and log with the prefix 'job<N>_'"
+            " (unless the job sets --outfile_prefix).")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument(args.target_device_utilization, "--target_utilization")
         .help(
             "Sets the target device utilization."
@@ -1550,7 +1686,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.RouteFile, "--route_file")
-        .help("Path to routing file")
+        .help("Path to routing file. Files with the .bin extension are read and written in a binary (capnproto) format")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.route_warm_start_file, "--route_warm_start_file")
+        .help(
+            "Starts routing from the routing file of a previous run (e.g. before an ECO, or with another placement seed)."
+            " Nets whose routing still connects their terminals keep it, and the router only routes the other nets"
+            " and the nets involved in congestion. Files with the .bin extension are read in the binary format")
+        .metavar("ROUTE_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.SDCFile, "--sdc_file")
@@ -1594,6 +1738,37 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Writes the intra-cluster lookahead data to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.write_router_connection_telemetry, "--write_router_connection_telemetry")
+        .help(
+            "Writes a binary record of every connection routed (net, sink, heap pushes and pops, run-time,"
+            " lookahead estimated and actual path cost, sink delay and retries) to the specified file."
+            " See router_telemetry.h for the record layout.")
+        .metavar("TELEMETRY_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_router_connection_capture, "--write_router_connection_capture")
+        .help(
+            "Captures the connection routing queries of the (serial) router (starting route tree, sink,"
+            " cost parameters, bounding box and the congestion of each iteration) to the specified file,"
+            " so they can be replayed against the connection router with route_diag --replay_connections."
+            " See router_connection_capture.h for the file layout.")
+        .metavar("CAPTURE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.router_connection_capture_limit, "--router_connection_capture_limit")
+        .help("Maximum number of connections captured with --write_router_connection_capture.")
+        .default_value("100000")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.write_router_lookahead_profile, "--write_router_lookahead_profile")
+        .help(
+            "Compares the delay the router lookahead expects from each wire of the routed connections with the"
+            " delay actually routed from it, and writes the error per entry of the lookahead's wire table"
+            " (layer, wire type, segment type, dx, dy) as CSV to the specified file."
+            " Only the map lookahead can be profiled.")
+        .metavar("PROFILE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_placement_delay_lookup, "--read_placement_delay_lookup")
         .help(
             "Reads the placement delay lookup from the specified file instead of computing it.")
@@ -1603,6 +1778,28 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Writes the placement delay lookup to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.cache_dir, "--cache_dir")
+        .help(
+            "Directory in which the cleaned atom netlist, intra-cluster routing graphs, routing resource graph,"
+            " router lookahead and placement delay lookup are cached."
+            " Each is stored under a digest of the circuit file, architecture file, channel width and options it depends on,"
+            " and later runs with the same digest read it back instead of recomputing it."
+            " Files specified with the corresponding --read_*/--write_* options take precedence."
+            " Requires VPR built with Cap'n Proto support; all but the atom netlist and intra-cluster routing graphs"
+            " also require a fixed channel width (--route_chan_width) and no flat routing.")
+        .metavar("CACHE_DIR")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    file_grp.add_argument(args.resume_from, "--resume_from")
+        .help(
+            "Directory in which the progress of the flow is checkpointed, so that an interrupted run resumes where it stopped"
+            " when run again with the same options."
+            " Stages which completed (packing, placement, routing) are loaded back from their output files,"
+            " placement resumes from a snapshot of its last temperature (see --place_snapshot_file),"
+            " and routing restarts from the congestion costs of its last iteration.")
+        .metavar("DIR")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.out_file_prefix, "--outfile_prefix")
         .help("Prefix for output files")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1659,6 +1856,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    netlist_grp.add_argument<bool, ParseOnOff>(args.parallel_blif_parse, "--parallel_blif_parse")
+        .help(
+            "Controls whether BLIF/EBLIF circuits are read with a memory mapped parser which"
+            " tokenizes parts of the file concurrently (using the --num_workers threads),"
+            " instead of the libblifparse parser")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& pack_grp = parser.add_argument_group("packing options");
 
     pack_grp.add_argument<bool, ParseOnOff>(args.connection_driven_clustering, "--connection_driven_clustering")
@@ -1814,8 +2019,10 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
 
     pack_grp.add_argument(args.pack_num_moves, "--pack_num_moves")
         .help(
-            "The number of moves that can be tried in packing stage")
-        .default_value("100000")
+            "The number of molecule swaps tried to improve the packing after clustering."
+            " Swaps are tried by several threads concurrently (see --num_workers)."
+            " 0 disables the iterative improvement")
+        .default_value("0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     pack_grp.add_argument(args.pack_move_type, "--pack_move_type")
@@ -1825,6 +2032,24 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("semiDirectedSwap")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    pack_grp.add_argument(args.pack_timing_update_interval, "--pack_timing_update_interval")
+        .help(
+            "During timing driven clustering, the number of clusters formed between incremental timing"
+            " analysis updates. Each update accounts for the nets absorbed into the clusters formed so far,"
+            " so later clusters are guided by up to date criticalities."
+            " 0 uses the criticalities of the initial timing analysis throughout clustering")
+        .default_value("20")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    pack_grp.add_argument(args.write_pack_profile, "--write_pack_profile")
+        .help(
+            "Records the wall time, call count and success/failure count of each packing phase"
+            " (seed selection, candidate gathering, molecule packing, intra-cluster routing and timing updates)"
+            " and writes them to the specified JSON file."
+            " The time of a phase includes that of the phases it calls")
+        .metavar("FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& place_grp = parser.add_argument_group("placement options");
 
     place_grp.add_argument(args.Seed, "--seed")
@@ -1907,6 +2132,32 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("0.25")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.PlaceConvergeTol, "--anneal_converge_tol")
+        .help(
+            "Stops annealing early (and starts the quench) once neither the bounding box cost nor the timing cost"
+            " improved by more than this fraction over --anneal_converge_temps consecutive temperatures"
+            " whose success ratio is below --anneal_success_target."
+            " Values <= 0 disable early convergence detection.")
+        .default_value("0.0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.PlaceConvergeTemps, "--anneal_converge_temps")
+        .help(
+            "Number of consecutive temperatures without significant improvement (see --anneal_converge_tol)"
+            " after which annealing is considered converged.")
+        .default_value("5")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.PlaceTimeBudget, "--anneal_time_budget")
+        .help(
+            "Target run-time (in seconds) of each placement start."
+            " Based on the measured time per move, the annealer cools faster when the remaining temperatures"
+            " would not fit in the budget, stops annealing once no temperature fits,"
+            " and shortens the quench to the remaining time."
+            " Values < 0 disable the budget.")
+        .default_value("-1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument<e_pad_loc_type, ParseFixPins>(args.pad_loc_type, "--fix_pins")
         .help(
             "Fixes I/O pad locations randomly during placement. Valid options:\n"
@@ -1923,6 +2174,34 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_incremental_file, "--place_incremental")
+        .help(
+            "Incremental (ECO) placement from a previous .place file of the netlist."
+            " Blocks are put back at their previous locations when these are still legal,"
+            " and only the new blocks (and those which could not keep their location) are placed from scratch."
+            " Instead of a full anneal, a quench then re-optimizes the blocks within --place_incremental_radius"
+            " of those blocks; all other blocks stay where they are.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_incremental_radius, "--place_incremental_radius")
+        .help(
+            "Size, in tiles, of the neighbourhood of the new and changed blocks that --place_incremental re-optimizes."
+            " Also limits the distance of the moves of the incremental quench.")
+        .default_value("5")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_snapshot_file, "--place_snapshot_file")
+        .help(
+            "Binary placement snapshot, to resume long placements after an interruption."
+            " The placement and annealer state are written to this file at the start of every temperature."
+            " If the file already exists when placement starts, the anneal resumes from it"
+            " (from the saved temperature, placement and random number generator state)."
+            " It is removed once the anneal completes."
+            " Not supported with --place_incremental or --place_num_starts.")
+        .default_value("")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument<e_place_algorithm, ParsePlaceAlgorithm>(args.PlaceAlgorithm, "--place_algorithm")
         .help(
             "Controls which placement algorithm is used. Valid options:\n"
@@ -1966,6 +2245,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument<bool, ParseOnOff>(args.place_move_timing_stats, "--place_move_timing_stats")
+        .help(
+            "Measures the time spent proposing, evaluating and committing or reverting the moves of each move type,"
+            " and reports the per-move latency and throughput of each phase at the end of placement."
+            " Only moves evaluated one at a time (--place_parallel_moves 1) are timed,"
+            " and timing adds some overhead to each move.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.placement_saves_per_temperature, "--save_placement_per_temperature")
         .help(
             "Controls how often VPR saves the current placement to a file per temperature (may be helpful for debugging)."
@@ -2007,6 +2295,27 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("10")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_parallel_moves, "--place_parallel_moves")
+        .help(
+            "Number of moves the annealer proposes at once and evaluates in parallel (using up to --num_workers threads)."
+            " Moves which touch the same blocks, locations or nets as an earlier move of the batch are aborted,"
+            " and the remaining moves are accepted or rejected in order."
+            " A value of 1 evaluates moves one at a time."
+            " Batches are only used without the RL agent (--RL_agent_placement off), without NoC placement and"
+            " with the bounding_box or criticality_timing placement algorithms.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    place_grp.add_argument(args.place_num_starts, "--place_num_starts")
+        .help(
+            "Number of independent anneals to run, with seeds --seed, --seed + 1, ..."
+            " The placement with the lowest estimated critical path delay (or bounding box cost for"
+            " wirelength-driven placement) is kept. The architecture, rr graph, router lookahead and"
+            " placement delay model are only built once for all the starts."
+            " Post-placement reports and echo files describe the last start.")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument<bool, ParseOnOff>(args.RL_agent_placement, "--RL_agent_placement")
         .help(
             "Uses a Reinforcement Learning (RL) agent in choosing the appropiate move type in placement."
@@ -2043,6 +2352,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("0.05")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument(args.place_agent_prob_update_interval, "--place_agent_prob_update_interval")
+        .help(
+            "Number of moves proposed by the softmax placement RL agent between recomputations of its action probabilities. "
+            "The probabilities are only recomputed once the agent's Q-table changed. "
+            "Values > 1 trade how quickly the agent reacts to rewards for less per-move overhead")
+        .default_value("1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.place_dm_rlim, "--place_dm_rlim")
         .help(
             "The maximum range limit of any directed move other than the uniform move. "
@@ -2148,6 +2465,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("0")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_timing_grp.add_argument(args.inner_loop_recompute_accepted_moves, "--inner_loop_recompute_accepted_moves")
+        .help(
+            "If non-zero, also performs an incremental timing analysis during placement after every"
+            " this many accepted moves. Only the timing affected by the moves since the previous"
+            " analysis is re-evaluated, so frequent updates keep criticalities fresh at modest cost."
+            " Zero only uses --inner_loop_recompute_divider and --quench_recompute_divider")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_timing_grp.add_argument(args.place_exp_first, "--td_place_exp_first")
         .help(
             "Controls how critical a connection is as a function of slack at the start of placement."
@@ -2177,6 +2503,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("min")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_timing_grp.add_argument<bool, ParseOnOff>(args.place_delay_model_half_precision, "--place_delay_model_half_precision")
+        .help(
+            "Stores the delta delays of the placement delay model in half precision (about 3 significant digits),"
+            " which halves their cache footprint in the placer's delay queries."
+            " The delay model is written (--write_placement_delay_lookup) before its precision is reduced.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_timing_grp.add_argument(args.place_delay_offset, "--place_delay_offset")
         .help(
             "A constant offset (in seconds) applied to the placer's delay model.")
@@ -2312,6 +2646,24 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<bool, ParseOnOff>(args.aggressive_binary_search_abort, "--aggressive_binary_search_abort")
+        .help(
+            "Once the minimum channel width search has found a routable channel width, route the narrower"
+            " channel widths it tries with the aggressive routing failure predictor, so that attempts which"
+            " are unlikely to succeed are given up early. Attempts above the best known routable width, and the"
+            " verification of --verify_binary_search, still use --routing_failure_predictor."
+            " This may increase the reported minimum channel width.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.reuse_lookahead_across_chan_widths, "--reuse_lookahead_across_chan_widths")
+        .help(
+            "Compute the router lookahead once, for the first channel width tried by the minimum channel width"
+            " search, and reuse it for the routing graphs of the other channel widths instead of recomputing it"
+            " for every attempt. The lookahead is recomputed for the final channel width.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument<e_router_algorithm, ParseRouterAlgorithm>(args.RouterAlgorithm, "--router_algorithm")
         .help(
             "Specifies the router algorithm to use.\n"
@@ -2321,6 +2673,24 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .choices({"parallel", "timing_driven"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<bool, ParseOnOff>(args.deterministic_parallel_route, "--deterministic_parallel_route")
+        .help(
+            "Makes the parallel router produce identical results regardless of --num_workers and thread scheduling."
+            " Nets are routed in a fixed order within each partition, and nets whose reachable routing resources"
+            " could overlap a cutline are kept in the serially routed parent partition."
+            " Only has an effect with '--router_algorithm parallel'.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.parallel_route_cutline_nets, "--parallel_route_cutline_nets")
+        .help(
+            "Makes the parallel router also route the nets which cross a partition cutline in parallel."
+            " The nets of each partition are split into batches of nets whose reachable routing resources"
+            " can't overlap, and the nets of a batch are routed concurrently."
+            " Only has an effect with '--router_algorithm parallel'.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument(args.min_incremental_reroute_fanout, "--min_incremental_reroute_fanout")
         .help("The net fanout threshold above which nets will be re-routed incrementally.")
         .default_value("16")
@@ -2346,9 +2716,11 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
             "Specifies the node reordering algorithm to use.\n"
             " * none: don't reorder nodes\n"
             " * degree_bfs: sort by degree and then by BFS\n"
-            " * random_shuffle: a random shuffle\n")
+            " * random_shuffle: a random shuffle\n"
+            " * spatial_hilbert: sort by layer, then along a Hilbert curve through the (xlow, ylow)\n"
+            "                    locations, then by type, so nodes close on the device are close in memory\n")
         .default_value("none")
-        .choices({"none", "degree_bfs", "random_shuffle"})
+        .choices({"none", "degree_bfs", "random_shuffle", "spatial_hilbert"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     route_grp.add_argument(args.reorder_rr_graph_nodes_threshold, "--reorder_rr_graph_nodes_threshold")
@@ -2363,6 +2735,21 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<bool, ParseOnOff>(args.compress_rr_graph_edges, "--compress_rr_graph_edges")
+        .help(
+            "Store the edges of the built RR graph in a compressed read-only form, which roughly halves"
+            " their memory footprint. The source node of an edge is then found by a binary search,"
+            " which slows down searches that walk edges backwards.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_grp.add_argument<bool, ParseOnOff>(args.report_rr_graph_patterns, "--report_rr_graph_patterns")
+        .help(
+            "Report how many distinct node patterns (nodes with the same attributes and out-edges, up to a"
+            " translation) the RR graph has, and the memory a tile-templated RR graph would need.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument(args.flat_routing, "--flat_routing")
         .help("Enable VPR's flat routing (routing the nets from the source primitive to the destination primitive)")
         .default_value("false")
@@ -2445,6 +2832,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .choices({"minimax", "scale_delay", "yoyo", "disable"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument(args.routing_budgets_convergence_delta, "--routing_budgets_convergence_delta")
+        .help(
+            "Largest change (in seconds) of any connection's budget below which the minimax and yoyo"
+            " budget allocation iterations are considered converged and stop."
+            " Larger values calculate the budgets faster, at the expense of their quality.")
+        .default_value("5e-12")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<bool, ParseOnOff>(args.save_routing_per_iteration, "--save_routing_per_iteration")
         .help(
             "Controls whether VPR saves the current routing to a file after each routing iteration."
@@ -2474,6 +2869,30 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("64")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.batch_clock_routing, "--batch_clock_routing")
+        .help(
+            "Routes all the sinks of each global (clock) net with a single search of the cheapest paths from its"
+            " route tree, instead of a search per sink. Much faster for the large fanout clock nets of dedicated"
+            " clock networks (see --clock_modeling and --two_stage_clock_routing). Sinks it can not reach, and the"
+            " nets of routing with delay budgets, are routed as usual.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.global_route_corridors, "--global_route_corridors")
+        .help(
+            "Before the first routing iteration, globally routes the nets on the tile grid (with the channel widths"
+            " as capacities and a few negotiated congestion passes, run in parallel). The first iteration then"
+            " searches each connection within the corridor of its global route, rather than the net's bounding box,"
+            " falling back to the bounding box if the corridor has no path. Reduces the runtime of the first"
+            " iteration on large designs. High fanout and global nets are routed as usual.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<int>(args.global_route_corridor_margin, "--global_route_corridor_margin")
+        .help("Number of grid tiles the corridors of --global_route_corridors are expanded by on each side")
+        .default_value("3")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<float>(args.router_high_fanout_max_slope, "--router_high_fanout_max_slope")
         .help(
             "Minimum routing progress where high fanout routing is enabled."
@@ -2482,6 +2901,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("0.1")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<int>(args.router_bidir_search_min_dist, "--router_bidir_search_min_dist")
+        .help(
+            "Connections whose source and sink are at least this many grid tiles apart (Manhattan distance),"
+            " and which are not timing critical, are routed with a bidirectional (meet-in-the-middle) search:"
+            " a bounded backward search from the sink is run first, and the forward search stops once it reaches"
+            " the backward search region at a low enough cost."
+            " Values less than zero disable bidirectional search")
+        .default_value("-1")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_router_lookahead, ParseRouterLookahead>(args.router_lookahead_type, "--router_lookahead")
         .help(
             "Controls what lookahead the router uses to calculate cost of completing a connection.\n"
@@ -2498,6 +2927,23 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("map")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument(args.router_lookahead_profile_correction, "--router_lookahead_profile_correction")
+        .help(
+            "With --write_router_lookahead_profile, once routing is done, raises the delay of the lookahead entries"
+            " which under-estimate the smallest delay routed for them by more than this fraction to that delay."
+            " The corrected lookahead is then written again if --write_router_lookahead is set."
+            " Zero disables corrections.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.router_lookahead_half_precision, "--router_lookahead_half_precision")
+        .help(
+            "Stores the wire cost table of the map lookahead in half precision (about 3 significant digits),"
+            " which halves its memory and cache footprint in the router's cost estimates."
+            " The lookahead is written (--write_router_lookahead) before its precision is reduced.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_max_convergence_count, "--router_max_convergence_count")
         .help(
             "Controls how many times the router is allowed to converge to a legal routing before halting."
@@ -2533,6 +2979,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument(args.router_skip_timing_update_criticality, "--router_skip_timing_update_criticality")
+        .help(
+            "Skips the timing analysis after a routing iteration if the criticality of every connection of the nets"
+            " it rerouted was below this value (the delay changes are then analyzed after the next iteration)."
+            " Updates are never skipped twice in a row, after a legal routing, or with routing budgets."
+            " Zero disables skipping; the timing analysis is always skipped when no connection delay changed.")
+        .default_value("0")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument<e_heap_type, ParseRouterHeap>(args.router_heap, "--router_heap")
         .help(
             "Controls what type of heap to use for timing driven router.\n"
@@ -2540,10 +2995,24 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
             " * bucket: A bucket heap approximation is used. The bucket heap\n"
             " *         is faster because it is only a heap approximation.\n"
             " *         Testing has shown the approximation results in\n"
-            " *         similiar QoR with less CPU work.\n")
+            " *         similiar QoR with less CPU work.\n"
+            " * four_ary: A 4-ary heap with cache line aligned children is used.\n"
+            " * radix: A monotone radix heap keyed on the bits of the cost is used.\n"
+            " *        Items cheaper than the last popped item are treated as equal\n"
+            " *        to it, so like bucket this is a (close) approximation.\n")
         .default_value("binary")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.congestion_driven_net_order, "--congestion_driven_net_order")
+        .help(
+            "Until the routing first becomes legal, each routing iteration (after the first) reroutes the nets"
+            " using overused routing resources first, most overused first, and ends as soon as they have"
+            " resolved all the overuse. The timing driven reroutes of the remaining (legal) nets are then"
+            " left to the iterations after the routing has converged."
+            " Only affects the serial router.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_first_iteration_timing_report_file, "--router_first_iter_timing_report")
         .help("Name of the post first routing iteration timing report file (not generated if unspecfied)")
         .default_value("")
@@ -2677,6 +3146,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Writes implemented design final timing summary to the specified JSON, XML or TXT file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    analysis_grp.add_argument(args.timing_corners, "--timing_corners")
+        .help(
+            "Additional delay corners of the final timing analysis, specified as <name>:<delay_scale> pairs"
+            " (e.g. '--timing_corners slow:1.2 fast:0.8'). Each corner scales all the delays of the"
+            " nominal analysis, and re-uses its timing graph, netlist and routing. The timing summary"
+            " of each corner is printed, and its timing reports are written with a '<name>.' prefix.")
+        .nargs('+')
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& power_grp = parser.add_argument_group("power analysis options");
 
     power_grp.add_argument<bool, ParseOnOff>(args.do_power, "--power")
@@ -2968,6 +3446,20 @@ bool verify_args(const t_options& args) {
                         args.router_lookahead_type.argument_name().c_str());
     }
 
+    if (args.crop_device_to_floorplan && args.read_vpr_constraints_file.provenance() != Provenance::SPECIFIED) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s option must be specified if %s is turned on\n",
+                        args.read_vpr_constraints_file.argument_name().c_str(),
+                        args.crop_device_to_floorplan.argument_name().c_str());
+    }
+
+    if (args.crop_device_margin < 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "%s must be non-negative (was %d)\n",
+                        args.crop_device_margin.argument_name().c_str(),
+                        args.crop_device_margin.value());
+    }
+
     /**
      * @brief If the user provided the "--noc" command line option, then there
      * must be a NoC in the FPGA and the netlist must include NoC routers.
@@ -14,6 +14,7 @@ struct t_options {
     argparse::ArgValue<std::string> NetFile;
     argparse::ArgValue<std::string> PlaceFile;
     argparse::ArgValue<std::string> RouteFile;
+    argparse::ArgValue<std::string> route_warm_start_file;
     argparse::ArgValue<std::string> CircuitFile;
     argparse::ArgValue<std::string> ActFile;
     argparse::ArgValue<std::string> PowerFile;
@@ -31,6 +32,8 @@ struct t_options {
     argparse::ArgValue<std::string> write_vpr_constraints_file;
 
     argparse::ArgValue<std::string> write_placement_delay_lookup;
+    argparse::ArgValue<std::string> cache_dir;
+    argparse::ArgValue<std::string> resume_from;
     argparse::ArgValue<std::string> read_placement_delay_lookup;
 
     argparse::ArgValue<std::string> write_router_lookahead;
@@ -39,6 +42,11 @@ struct t_options {
     argparse::ArgValue<std::string> write_intra_cluster_router_lookahead;
     argparse::ArgValue<std::string> read_intra_cluster_router_lookahead;
 
+    argparse::ArgValue<std::string> write_router_connection_telemetry;
+    argparse::ArgValue<std::string> write_router_connection_capture;
+    argparse::ArgValue<int> router_connection_capture_limit;
+    argparse::ArgValue<std::string> write_router_lookahead_profile;
+
     argparse::ArgValue<std::string> write_block_usage;
 
     /* Stage Options */
@@ -62,7 +70,13 @@ struct t_options {
     argparse::ArgValue<e_timing_update_type> timing_update_type;
     argparse::ArgValue<bool> CreateEchoFile;
     argparse::ArgValue<bool> verify_file_digests;
+    argparse::ArgValue<std::string> write_timing_trace;
+    argparse::ArgValue<bool> server;
+    argparse::ArgValue<std::string> fork_jobs;
     argparse::ArgValue<std::string> device_layout;
+    argparse::ArgValue<bool> crop_device_to_floorplan;
+    argparse::ArgValue<int> crop_device_margin;
+    argparse::ArgValue<bool> pipeline_device_creation;
     argparse::ArgValue<float> target_device_utilization;
     argparse::ArgValue<e_constant_net_method> constant_net_method;
     argparse::ArgValue<e_clock_modeling> clock_modeling;
@@ -82,6 +96,7 @@ struct t_options {
     argparse::ArgValue<bool> sweep_dangling_blocks;
     argparse::ArgValue<bool> sweep_constant_primary_outputs;
     argparse::ArgValue<int> netlist_verbosity;
+    argparse::ArgValue<bool> parallel_blif_parse;
 
     /* Clustering options */
     argparse::ArgValue<bool> connection_driven_clustering;
@@ -101,6 +116,8 @@ struct t_options {
     argparse::ArgValue<bool> use_attraction_groups;
     argparse::ArgValue<int> pack_num_moves;
     argparse::ArgValue<std::string> pack_move_type;
+    argparse::ArgValue<int> pack_timing_update_interval;
+    argparse::ArgValue<std::string> write_pack_profile;
     /* Placement options */
     argparse::ArgValue<int> Seed;
     argparse::ArgValue<bool> ShowPlaceTiming;
@@ -113,6 +130,9 @@ struct t_options {
     argparse::ArgValue<float> PlaceAlphaDecay;
     argparse::ArgValue<float> PlaceSuccessMin;
     argparse::ArgValue<float> PlaceSuccessTarget;
+    argparse::ArgValue<float> PlaceConvergeTol;
+    argparse::ArgValue<int> PlaceConvergeTemps;
+    argparse::ArgValue<float> PlaceTimeBudget;
     argparse::ArgValue<sched_type> anneal_sched_type;
     argparse::ArgValue<e_place_algorithm> PlaceAlgorithm;
     argparse::ArgValue<e_place_algorithm> PlaceQuenchAlgorithm;
@@ -120,6 +140,7 @@ struct t_options {
     argparse::ArgValue<int> PlaceChanWidth;
     argparse::ArgValue<float> place_rlim_escape_fraction;
     argparse::ArgValue<std::string> place_move_stats_file;
+    argparse::ArgValue<bool> place_move_timing_stats;
     argparse::ArgValue<int> placement_saves_per_temperature;
     argparse::ArgValue<e_place_effort_scaling> place_effort_scaling;
     argparse::ArgValue<e_place_delta_delay_algorithm> place_delta_delay_matrix_calculation_method;
@@ -127,12 +148,18 @@ struct t_options {
     argparse::ArgValue<std::vector<float>> place_static_move_prob;
     argparse::ArgValue<std::vector<float>> place_static_notiming_move_prob;
     argparse::ArgValue<int> place_high_fanout_net;
+    argparse::ArgValue<int> place_parallel_moves;
+    argparse::ArgValue<int> place_num_starts;
+    argparse::ArgValue<std::string> place_incremental_file;
+    argparse::ArgValue<int> place_incremental_radius;
+    argparse::ArgValue<std::string> place_snapshot_file;
 
     argparse::ArgValue<bool> RL_agent_placement;
     argparse::ArgValue<bool> place_agent_multistate;
     argparse::ArgValue<bool> place_checkpointing;
     argparse::ArgValue<float> place_agent_epsilon;
     argparse::ArgValue<float> place_agent_gamma;
+    argparse::ArgValue<int> place_agent_prob_update_interval;
     argparse::ArgValue<float> place_dm_rlim;
     argparse::ArgValue<e_agent_space> place_agent_space;
     argparse::ArgValue<e_agent_algorithm> place_agent_algorithm;
@@ -158,6 +185,7 @@ struct t_options {
     argparse::ArgValue<int> RecomputeCritIter;
     argparse::ArgValue<int> inner_loop_recompute_divider;
     argparse::ArgValue<int> quench_recompute_divider;
+    argparse::ArgValue<int> inner_loop_recompute_accepted_moves;
     argparse::ArgValue<float> place_exp_first;
     argparse::ArgValue<float> place_exp_last;
     argparse::ArgValue<float> place_delay_offset;
@@ -168,6 +196,7 @@ struct t_options {
     argparse::ArgValue<std::string> post_place_timing_report_file;
     argparse::ArgValue<PlaceDelayModelType> place_delay_model;
     argparse::ArgValue<e_reducer> place_delay_model_reducer;
+    argparse::ArgValue<bool> place_delay_model_half_precision;
     argparse::ArgValue<std::string> allowed_tiles_for_delay_model;
 
     /* Router Options */
@@ -184,7 +213,12 @@ struct t_options {
     argparse::ArgValue<int> RouteChanWidth;
     argparse::ArgValue<int> min_route_chan_width_hint; ///<Hint to binary search router about what the min chan width is
     argparse::ArgValue<bool> verify_binary_search;
+    argparse::ArgValue<bool> aggressive_binary_search_abort;
+    argparse::ArgValue<bool> reuse_lookahead_across_chan_widths;
+    argparse::ArgValue<bool> congestion_driven_net_order;
     argparse::ArgValue<e_router_algorithm> RouterAlgorithm;
+    argparse::ArgValue<bool> deterministic_parallel_route;
+    argparse::ArgValue<bool> parallel_route_cutline_nets;
     argparse::ArgValue<int> min_incremental_reroute_fanout;
     argparse::ArgValue<bool> read_rr_edge_metadata;
     argparse::ArgValue<bool> exit_after_first_routing_iteration;
@@ -194,6 +228,8 @@ struct t_options {
     argparse::ArgValue<e_rr_node_reorder_algorithm> reorder_rr_graph_nodes_algorithm;
     argparse::ArgValue<int> reorder_rr_graph_nodes_threshold;
     argparse::ArgValue<int> reorder_rr_graph_nodes_seed;
+    argparse::ArgValue<bool> compress_rr_graph_edges;
+    argparse::ArgValue<bool> report_rr_graph_patterns;
     argparse::ArgValue<bool> flat_routing;
     argparse::ArgValue<bool> has_choking_spot;
 
@@ -206,18 +242,26 @@ struct t_options {
     argparse::ArgValue<e_incr_reroute_delay_ripup> incr_reroute_delay_ripup;
     argparse::ArgValue<e_routing_failure_predictor> routing_failure_predictor;
     argparse::ArgValue<e_routing_budgets_algorithm> routing_budgets_algorithm;
+    argparse::ArgValue<float> routing_budgets_convergence_delta;
     argparse::ArgValue<bool> save_routing_per_iteration;
     argparse::ArgValue<float> congested_routing_iteration_threshold_frac;
     argparse::ArgValue<e_route_bb_update> route_bb_update;
     argparse::ArgValue<int> router_high_fanout_threshold;
+    argparse::ArgValue<bool> batch_clock_routing;
+    argparse::ArgValue<bool> global_route_corridors;
+    argparse::ArgValue<int> global_route_corridor_margin;
     argparse::ArgValue<float> router_high_fanout_max_slope;
+    argparse::ArgValue<int> router_bidir_search_min_dist;
     argparse::ArgValue<int> router_debug_net;
     argparse::ArgValue<int> router_debug_sink_rr;
     argparse::ArgValue<int> router_debug_iteration;
     argparse::ArgValue<e_router_lookahead> router_lookahead_type;
+    argparse::ArgValue<float> router_lookahead_profile_correction;
+    argparse::ArgValue<bool> router_lookahead_half_precision;
     argparse::ArgValue<int> router_max_convergence_count;
     argparse::ArgValue<float> router_reconvergence_cpd_threshold;
     argparse::ArgValue<bool> router_update_lower_bound_delays;
+    argparse::ArgValue<float> router_skip_timing_update_criticality;
     argparse::ArgValue<std::string> router_first_iteration_timing_report_file;
     argparse::ArgValue<e_router_initial_timing> router_initial_timing;
     argparse::ArgValue<e_heap_type> router_heap;
@@ -233,10 +277,15 @@ struct t_options {
     argparse::ArgValue<e_post_synth_netlist_unconn_handling> post_synth_netlist_unconn_input_handling;
     argparse::ArgValue<e_post_synth_netlist_unconn_handling> post_synth_netlist_unconn_output_handling;
     argparse::ArgValue<std::string> write_timing_summary;
+    argparse::ArgValue<std::vector<std::string>> timing_corners;
 };
 
 argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& args);
 t_options read_options(int argc, const char** argv);
+///@brief Like read_options(), but invalid arguments (or --help/--version) throw a VprError instead of exiting
+t_options read_options_throw(int argc, const char** argv);
+///@brief Like read_options_throw() for the arguments args (without the program name), with the options also given in override_args replaced by their values there
+t_options read_options_with_overrides(const std::vector<std::string>& args, const std::vector<std::string>& override_args);
 void set_conditional_defaults(t_options& args);
 bool verify_args(const t_options& args);
 
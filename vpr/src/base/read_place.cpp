@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
 #include <fstream>
 #include <algorithm>
 
@@ -7,6 +8,7 @@
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "vtr_digest.h"
+#include "vtr_random.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -29,6 +31,17 @@ void read_place_body(
     const char* place_file,
     bool is_place_file);
 
+///@brief Identifies the binary placement snapshots written by write_place_snapshot()
+constexpr char PLACE_SNAPSHOT_MAGIC[8] = {'V', 'P', 'R', 'P', 'L', 'S', 'N', 'P'};
+///@brief Incremented whenever the layout of the snapshots changes
+constexpr uint32_t PLACE_SNAPSHOT_VERSION = 2;
+
+template<typename T>
+static void append_snapshot_value(std::vector<char>& buf, const T& value);
+
+template<typename T>
+static bool read_snapshot_value(const std::vector<char>& buf, size_t& offset, T& value);
+
 void read_place(
     const char* net_file,
     const char* place_file,
@@ -72,6 +85,61 @@ void read_constraints(const char* constraints_file) {
     VTR_LOG("\n");
 }
 
+vtr::vector<ClusterBlockId, t_pl_loc> read_place_locations(const char* place_file, const DeviceGrid& grid) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    std::ifstream fstream(place_file);
+    if (!fstream) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Cannot open place file.\n",
+                        place_file);
+    }
+
+    VTR_LOG("Reading previous placement %s.\n", place_file);
+
+    //The netlist is expected to have changed since the placement was written,
+    //so a netlist ID mismatch is only reported as a warning
+    read_place_header(fstream, "", place_file, false, grid);
+
+    vtr::vector<ClusterBlockId, t_pl_loc> block_locs(cluster_ctx.clb_nlist.blocks().size());
+    const t_grid_crop& crop = g_vpr_ctx.device().grid_crop;
+
+    std::string line;
+    size_t num_read = 0;
+    while (std::getline(fstream, line)) {
+        std::vector<std::string> tokens = vtr::split(line);
+
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue; //Skip blank and commented lines
+        }
+
+        //Same format as the body of a place file: name x y sub_tile [layer] [#comment]
+        bool is_2d = tokens.size() == 4 || (tokens.size() > 4 && tokens[4][0] == '#');
+        bool is_3d = tokens.size() == 5 || (tokens.size() > 5 && tokens[5][0] == '#');
+        if (!is_2d && !is_3d) {
+            VTR_LOG_WARN("Skipping invalid line '%s' in previous placement %s\n", line.c_str(), place_file);
+            continue;
+        }
+
+        ClusterBlockId blk_id = cluster_ctx.clb_nlist.find_block(tokens[0]);
+        if (blk_id == ClusterBlockId::INVALID()) {
+            continue; //Block was removed from the netlist
+        }
+
+        t_pl_loc& loc = block_locs[blk_id];
+        loc.x = vtr::atoi(tokens[1]) - crop.x_offset;
+        loc.y = vtr::atoi(tokens[2]) - crop.y_offset;
+        loc.sub_tile = vtr::atoi(tokens[3]);
+        loc.layer = is_2d ? 0 : vtr::atoi(tokens[4]);
+        ++num_read;
+    }
+
+    VTR_LOG("Read the previous locations of %zu of %zu blocks.\n", num_read, block_locs.size());
+    VTR_LOG("\n");
+
+    return block_locs;
+}
+
 /**
  * This function reads the header (first two lines) of a placement file.
  * The header consists of two lines that specify the netlist file and grid size that were used when generating placement.
@@ -143,12 +211,17 @@ void read_place_header(std::ifstream& placement_file,
                    && tokens[6] == "blocks") {
             //Load the device grid dimensions
 
+            //Placement files use the full device's dimensions when the grid is cropped
+            const t_grid_crop& crop = g_vpr_ctx.device().grid_crop;
+            size_t width = crop.is_cropped() ? crop.full_width : grid.width();
+            size_t height = crop.is_cropped() ? crop.full_height : grid.height();
+
             size_t place_file_width = vtr::atou(tokens[2]);
             size_t place_file_height = vtr::atou(tokens[4]);
-            if (grid.width() != place_file_width || grid.height() != place_file_height) {
+            if (width != place_file_width || height != place_file_height) {
                 vpr_throw(VPR_ERROR_PLACE_F, place_file, lineno,
                           "Current FPGA size (%d x %d) is different from size when placement generated (%d x %d)",
-                          grid.width(), grid.height(), place_file_width, place_file_height);
+                          width, height, place_file_width, place_file_height);
             }
 
             seen_grid_dimensions = true;
@@ -176,6 +249,7 @@ void read_place_body(std::ifstream& placement_file,
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     auto& atom_ctx = g_vpr_ctx.atom();
+    const t_grid_crop& crop = g_vpr_ctx.device().grid_crop;
 
     std::string line;
     int lineno = 0;
@@ -221,8 +295,8 @@ void read_place_body(std::ifstream& placement_file,
             }
 
             std::string block_name = tokens[block_name_index];
-            int block_x = vtr::atoi(tokens[block_x_index]);
-            int block_y = vtr::atoi(tokens[block_y_index]);
+            int block_x = vtr::atoi(tokens[block_x_index]) - crop.x_offset;
+            int block_y = vtr::atoi(tokens[block_y_index]) - crop.y_offset;
             int sub_tile_index = vtr::atoi(tokens[sub_tile_index_index]);
             int block_layer;
             if (block_layer_index != -1) {
@@ -321,7 +395,10 @@ void print_place(const char* net_file,
     fprintf(fp, "Netlist_File: %s Netlist_ID: %s\n",
             net_file,
             net_id);
-    fprintf(fp, "Array size: %zu x %zu logic blocks\n\n", device_ctx.grid.width(), device_ctx.grid.height());
+    const t_grid_crop& crop = device_ctx.grid_crop;
+    fprintf(fp, "Array size: %zu x %zu logic blocks\n\n",
+            crop.is_cropped() ? crop.full_width : device_ctx.grid.width(),
+            crop.is_cropped() ? crop.full_height : device_ctx.grid.height());
     fprintf(fp, "#block name\tx\ty\tsubblk\tlayer\tblock number\n");
     fprintf(fp, "#----------\t--\t--\t------\t-----\t------------\n");
 
@@ -332,8 +409,8 @@ void print_place(const char* net_file,
                 fprintf(fp, "\t");
 
             fprintf(fp, "%d\t%d\t%d\t%d",
-                    place_ctx.block_locs[blk_id].loc.x,
-                    place_ctx.block_locs[blk_id].loc.y,
+                    place_ctx.block_locs[blk_id].loc.x + crop.x_offset,
+                    place_ctx.block_locs[blk_id].loc.y + crop.y_offset,
                     place_ctx.block_locs[blk_id].loc.sub_tile,
                     place_ctx.block_locs[blk_id].loc.layer);
             fprintf(fp, "\t#%zu\n", size_t(blk_id));
@@ -344,3 +421,168 @@ void print_place(const char* net_file,
     //Calculate the ID of the placement
     place_ctx.placement_id = vtr::secure_digest_file(place_file);
 }
+
+void write_place_snapshot(const char* snapshot_file, const t_place_snapshot_anneal_state& anneal_state) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+    const t_grid_crop& crop = device_ctx.grid_crop;
+
+    //Build the whole snapshot in memory, so it is written with a single write
+    const std::string& netlist_id = cluster_ctx.clb_nlist.netlist_id();
+    size_t num_blocks = cluster_ctx.clb_nlist.blocks().size();
+
+    std::vector<char> buf;
+    buf.reserve(sizeof(PLACE_SNAPSHOT_MAGIC) + netlist_id.size() + 4 * sizeof(int32_t) * (num_blocks + 8));
+    buf.insert(buf.end(), std::begin(PLACE_SNAPSHOT_MAGIC), std::end(PLACE_SNAPSHOT_MAGIC));
+    append_snapshot_value(buf, PLACE_SNAPSHOT_VERSION);
+
+    append_snapshot_value(buf, uint32_t(netlist_id.size()));
+    buf.insert(buf.end(), netlist_id.begin(), netlist_id.end());
+
+    //Same coordinates as place files, which use the full device's dimensions when the grid is cropped
+    append_snapshot_value(buf, uint32_t(crop.is_cropped() ? crop.full_width : device_ctx.grid.width()));
+    append_snapshot_value(buf, uint32_t(crop.is_cropped() ? crop.full_height : device_ctx.grid.height()));
+
+    append_snapshot_value(buf, anneal_state.num_temps);
+    append_snapshot_value(buf, anneal_state.t);
+    append_snapshot_value(buf, anneal_state.alpha);
+    append_snapshot_value(buf, anneal_state.rlim);
+    append_snapshot_value(buf, anneal_state.crit_exponent);
+    append_snapshot_value(buf, anneal_state.move_lim);
+    append_snapshot_value(buf, anneal_state.rand_state);
+
+    append_snapshot_value(buf, uint32_t(num_blocks));
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        const t_pl_loc& loc = place_ctx.block_locs[blk_id].loc;
+        append_snapshot_value(buf, int32_t(loc.x + crop.x_offset));
+        append_snapshot_value(buf, int32_t(loc.y + crop.y_offset));
+        append_snapshot_value(buf, int32_t(loc.sub_tile));
+        append_snapshot_value(buf, int32_t(loc.layer));
+    }
+
+    std::string tmp_file = std::string(snapshot_file) + ".tmp";
+    {
+        std::ofstream fstream(tmp_file, std::ios::binary | std::ios::trunc);
+        if (!fstream || !fstream.write(buf.data(), buf.size())) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                            "'%s' - Cannot write placement snapshot.\n",
+                            tmp_file.c_str());
+        }
+    }
+
+    if (std::rename(tmp_file.c_str(), snapshot_file) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Cannot replace placement snapshot with '%s'.\n",
+                        snapshot_file, tmp_file.c_str());
+    }
+}
+
+vtr::vector<ClusterBlockId, t_pl_loc> read_place_snapshot(const char* snapshot_file,
+                                                         const DeviceGrid& grid,
+                                                         t_place_snapshot_anneal_state& anneal_state) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    const t_grid_crop& crop = g_vpr_ctx.device().grid_crop;
+
+    std::vector<char> buf;
+    {
+        std::ifstream fstream(snapshot_file, std::ios::binary | std::ios::ate);
+        if (!fstream) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                            "'%s' - Cannot open placement snapshot.\n",
+                            snapshot_file);
+        }
+        buf.resize(size_t(fstream.tellg()));
+        fstream.seekg(0);
+        if (!fstream.read(buf.data(), buf.size())) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                            "'%s' - Cannot read placement snapshot.\n",
+                            snapshot_file);
+        }
+    }
+
+    size_t offset = sizeof(PLACE_SNAPSHOT_MAGIC);
+    uint32_t version = 0;
+    if (buf.size() < offset || !std::equal(std::begin(PLACE_SNAPSHOT_MAGIC), std::end(PLACE_SNAPSHOT_MAGIC), buf.begin())
+        || !read_snapshot_value(buf, offset, version) || version != PLACE_SNAPSHOT_VERSION) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Not a placement snapshot written by this version of VPR.\n",
+                        snapshot_file);
+    }
+
+    uint32_t netlist_id_size = 0;
+    bool valid = read_snapshot_value(buf, offset, netlist_id_size) && netlist_id_size <= buf.size() - offset;
+    std::string netlist_id;
+    if (valid) {
+        netlist_id.assign(buf.data() + offset, netlist_id_size);
+        offset += netlist_id_size;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t num_blocks = 0;
+    valid = valid
+            && read_snapshot_value(buf, offset, width)
+            && read_snapshot_value(buf, offset, height)
+            && read_snapshot_value(buf, offset, anneal_state.num_temps)
+            && read_snapshot_value(buf, offset, anneal_state.t)
+            && read_snapshot_value(buf, offset, anneal_state.alpha)
+            && read_snapshot_value(buf, offset, anneal_state.rlim)
+            && read_snapshot_value(buf, offset, anneal_state.crit_exponent)
+            && read_snapshot_value(buf, offset, anneal_state.move_lim)
+            && read_snapshot_value(buf, offset, anneal_state.rand_state)
+            && read_snapshot_value(buf, offset, num_blocks)
+            && buf.size() - offset == size_t(num_blocks) * 4 * sizeof(int32_t);
+    if (!valid) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Truncated or corrupted placement snapshot.\n",
+                        snapshot_file);
+    }
+
+    //The blocks are stored by id, so the snapshot must be for exactly the same netlist
+    if (netlist_id != cluster_ctx.clb_nlist.netlist_id() || num_blocks != cluster_ctx.clb_nlist.blocks().size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - The placement snapshot (Netlist_ID: '%s', %u blocks) does not match the current netlist (Netlist_ID: '%s', %zu blocks).\n",
+                        snapshot_file, netlist_id.c_str(), num_blocks,
+                        cluster_ctx.clb_nlist.netlist_id().c_str(), cluster_ctx.clb_nlist.blocks().size());
+    }
+
+    size_t grid_width = crop.is_cropped() ? crop.full_width : grid.width();
+    size_t grid_height = crop.is_cropped() ? crop.full_height : grid.height();
+    if (width != grid_width || height != grid_height) {
+        VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
+                        "'%s' - Current FPGA size (%zu x %zu) is different from size when the placement snapshot was written (%u x %u).\n",
+                        snapshot_file, grid_width, grid_height, width, height);
+    }
+
+    vtr::vector<ClusterBlockId, t_pl_loc> block_locs(num_blocks);
+    for (ClusterBlockId blk_id : cluster_ctx.clb_nlist.blocks()) {
+        int32_t coords[4];
+        std::memcpy(coords, buf.data() + offset, sizeof(coords));
+        offset += sizeof(coords);
+
+        t_pl_loc& loc = block_locs[blk_id];
+        loc.x = coords[0] - crop.x_offset;
+        loc.y = coords[1] - crop.y_offset;
+        loc.sub_tile = coords[2];
+        loc.layer = coords[3];
+    }
+
+    return block_locs;
+}
+
+template<typename T>
+static void append_snapshot_value(std::vector<char>& buf, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool read_snapshot_value(const std::vector<char>& buf, size_t& offset, T& value) {
+    if (buf.size() - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, buf.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
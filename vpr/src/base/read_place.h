@@ -1,6 +1,8 @@
 #ifndef READ_PLACE_H
 #define READ_PLACE_H
 
+#include "vtr_random.h"
+
 /**
  * This function is for reading a place file when placement is skipped.
  * It takes in the current netlist file and grid dimensions to check that they match those that were used when placement was generated.
@@ -17,8 +19,48 @@ void read_place(
  */
 void read_constraints(const char* constraints_file);
 
+/**
+ * This function reads the block locations of a previous placement, for incremental placement of a modified netlist.
+ * Unlike read_place(), it does not modify the placement: it returns the location recorded for each block of the
+ * current netlist (an invalid t_pl_loc for blocks missing from the file), and silently skips blocks that no longer exist.
+ * The grid dimensions recorded in the file must match the current grid.
+ */
+vtr::vector<ClusterBlockId, t_pl_loc> read_place_locations(const char* place_file, const DeviceGrid& grid);
+
 void print_place(const char* net_file,
                  const char* net_id,
                  const char* place_file);
 
+/**
+ * The state of the annealer saved with a placement snapshot, so that an interrupted placement can resume
+ * at the temperature where it stopped.
+ */
+struct t_place_snapshot_anneal_state {
+    int num_temps = 0;
+    float t = 0.;
+    float alpha = 0.;
+    float rlim = 0.;
+    float crit_exponent = 0.;
+    int move_lim = 0;
+    vtr::RandState rand_state = 0; ///<State of the random number generator, so the resumed anneal proposes the same moves
+};
+
+/**
+ * This function writes a binary snapshot of the current placement: the location of each block (by block id),
+ * the netlist ID and grid dimensions used to check that it matches when it is read back, and the annealer state.
+ * Unlike print_place(), there is no per-block text to format, so it is cheap enough to write at every temperature.
+ * The snapshot is written to a temporary file which then replaces snapshot_file, so an interruption
+ * never leaves a partial snapshot behind. It uses the byte order of the host.
+ */
+void write_place_snapshot(const char* snapshot_file, const t_place_snapshot_anneal_state& anneal_state);
+
+/**
+ * This function reads a snapshot written by write_place_snapshot() with a single read of the file.
+ * Like read_place_locations(), it does not modify the placement: it returns the location of each block
+ * and the annealer state. It is an error if the snapshot was written for another netlist or grid.
+ */
+vtr::vector<ClusterBlockId, t_pl_loc> read_place_snapshot(const char* snapshot_file,
+                                                         const DeviceGrid& grid,
+                                                         t_place_snapshot_anneal_state& anneal_state);
+
 #endif
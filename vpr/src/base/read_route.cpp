@@ -47,9 +47,31 @@
 #include "route_tree.h"
 #include "read_route.h"
 #include "binary_heap.h"
+#include "heap_type.h"
+#include "vtr_time.h"
 
 #include "old_traceback.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "route.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+///@brief An element of the traceback of a net loaded to warm start the router (see load_warm_start_routing())
+struct t_warm_start_trace {
+    int index;         ///<RR node
+    int iswitch;       ///<Switch to the next element, or OPEN at the end of a branch
+    int net_pin_index; ///<Net pin of a SINK, OPEN for other nodes
+};
+
+typedef vtr::vector<ParentNetId, std::vector<t_warm_start_trace>> t_warm_start_tracebacks;
+
 /*************Functions local to this module*************/
 static void process_route(const Netlist<>& net_list, std::ifstream& fp, const char* filename, int& lineno, bool is_flat);
 static void process_nodes(const Netlist<>& net_list, std::ifstream& fp, ClusterNetId inet, const char* filename, int& lineno);
@@ -59,6 +81,14 @@ static void format_coordinates(int& layer_num, int& x, int& y, std::string coord
 static void format_pin_info(std::string& pb_name, std::string& port_name, int& pb_pin_num, std::string input);
 static std::string format_name(std::string name);
 static bool check_rr_graph_connectivity(RRNodeId prev_node, RRNodeId node);
+static bool finish_route_loading(const Netlist<>& router_net_list, const t_router_opts& router_opts);
+static bool is_binary_route_file(const char* route_file);
+static bool read_binary_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests);
+static void print_binary_route(const Netlist<>& net_list, const char* placement_file, const char* route_file, bool is_flat);
+static void read_warm_start_tracebacks(const Netlist<>& net_list, const char* route_file, t_warm_start_tracebacks& tracebacks);
+static void read_binary_warm_start_tracebacks(const Netlist<>& net_list, const char* route_file, bool is_flat, t_warm_start_tracebacks& tracebacks);
+static bool load_warm_start_route_tree(ParentNetId net_id, const std::vector<t_warm_start_trace>& traceback, bool is_flat);
+static RREdgeId find_rr_edge(RRNodeId from_node, RRNodeId to_node, int iswitch);
 void print_route(const Netlist<>& net_list, FILE* fp, bool is_flat);
 
 /*************Global Functions****************************/
@@ -67,9 +97,14 @@ void print_route(const Netlist<>& net_list, FILE* fp, bool is_flat);
  * @brief Reads in the routing file to fill in the trace.head and t_clb_opins_used data structure.
  *
  * Perform a series of verification tests to ensure the netlist,
- * placement, and routing files match
+ * placement, and routing files match. Files with the .bin extension are
+ * read as binary (capnproto) routing files.
  */
 bool read_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests, bool is_flat) {
+    if (is_binary_route_file(route_file)) {
+        return read_binary_route(route_file, router_opts, verify_file_digests);
+    }
+
     auto& device_ctx = g_vpr_ctx.mutable_device();
     auto& place_ctx = g_vpr_ctx.placement();
     bool flat_router = router_opts.flat_routing;
@@ -117,10 +152,13 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
     ++lineno;
     header.clear();
     header = vtr::split(header_str);
-    if (header[0] == "Array" && header[1] == "size:" && (vtr::atou(header[2].c_str()) != device_ctx.grid.width() || vtr::atou(header[4].c_str()) != device_ctx.grid.height())) {
+    const t_grid_crop& crop = device_ctx.grid_crop;
+    size_t width = crop.is_cropped() ? crop.full_width : device_ctx.grid.width();
+    size_t height = crop.is_cropped() ? crop.full_height : device_ctx.grid.height();
+    if (header[0] == "Array" && header[1] == "size:" && (vtr::atou(header[2].c_str()) != width || vtr::atou(header[4].c_str()) != height)) {
         vpr_throw(VPR_ERROR_ROUTE, route_file, lineno,
                   "Device dimensions %sx%s specified in the routing file does not match given %dx%d ",
-                  header[2].c_str(), header[4].c_str(), device_ctx.grid.width(), device_ctx.grid.height());
+                  header[2].c_str(), header[4].c_str(), width, height);
     }
 
     /* Read in every net */
@@ -128,6 +166,14 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
 
     fp.close();
 
+    return finish_route_loading(router_net_list, router_opts);
+}
+
+///@brief Sets up the clb opins and occupancy of the loaded routing, and checks its feasibility
+static bool finish_route_loading(const Netlist<>& router_net_list, const t_router_opts& router_opts) {
+    auto& device_ctx = g_vpr_ctx.device();
+    bool flat_router = router_opts.flat_routing;
+
     /*Correctly set up the clb opins*/
     BinaryHeap small_heap;
     small_heap.init_heap(device_ctx.grid);
@@ -500,6 +546,11 @@ static void format_coordinates(int& layer_num, int& x, int& y, std::string coord
         x = coords[1];
         y = coords[2];
     }
+
+    //Routing files use full device coordinates when the device grid is cropped
+    const t_grid_crop& crop = g_vpr_ctx.device().grid_crop;
+    x -= crop.x_offset;
+    y -= crop.y_offset;
 }
 
 /**
@@ -566,6 +617,208 @@ static bool check_rr_graph_connectivity(RRNodeId prev_node, RRNodeId node) {
     return false;
 }
 
+/**
+ * @brief Loads the routing of route_file to warm start the router.
+ *
+ * Only the nets which still connect their current SOURCE to all their current SINKs keep
+ * their routing. Unlike read_route(), anything else (a changed placement or netlist, another
+ * RR graph) only leaves the affected nets unrouted.
+ */
+size_t load_warm_start_routing(const Netlist<>& net_list, const char* route_file, bool is_flat) {
+    vtr::ScopedStartFinishTimer timer("Loading warm start routing");
+
+    t_warm_start_tracebacks tracebacks(net_list.nets().size());
+    if (is_binary_route_file(route_file)) {
+        read_binary_warm_start_tracebacks(net_list, route_file, is_flat, tracebacks);
+    } else {
+        read_warm_start_tracebacks(net_list, route_file, tracebacks);
+    }
+
+    size_t num_nets = 0;
+    size_t num_kept_nets = 0;
+    for (auto net_id : net_list.nets()) {
+        if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).empty()) {
+            continue; //Never routed
+        }
+        ++num_nets;
+
+        if (load_warm_start_route_tree(net_id, tracebacks[net_id], is_flat)) {
+            ++num_kept_nets;
+        }
+    }
+
+    //The occupancy of the kept routing, which the router starts negotiating from
+    recompute_occupancy_from_scratch(net_list, is_flat);
+
+    VTR_LOG("Kept the routing of %zu of %zu nets from '%s', the other %zu nets will be routed from scratch\n",
+            num_kept_nets, num_nets, route_file, num_nets - num_kept_nets);
+
+    return num_kept_nets;
+}
+
+///@brief Reads the tracebacks of the nets of net_list (matched by name) in a text routing file, without checking them
+static void read_warm_start_tracebacks(const Netlist<>& net_list, const char* route_file, t_warm_start_tracebacks& tracebacks) {
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    std::ifstream fp(route_file);
+    if (!fp.is_open()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Cannot open %s routing file", route_file);
+    }
+
+    int lineno = 0;
+    std::string input;
+    ParentNetId net_id = ParentNetId::INVALID(); //Net of the nodes being read
+    while (std::getline(fp, input)) {
+        ++lineno;
+        std::vector<std::string> tokens = vtr::split(input);
+
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue; //Skip blank and commented lines
+        } else if (tokens[0] == "Array" && tokens.size() > 4 && tokens[1] == "size:") {
+            const t_grid_crop& crop = device_ctx.grid_crop;
+            size_t width = crop.is_cropped() ? crop.full_width : device_ctx.grid.width();
+            size_t height = crop.is_cropped() ? crop.full_height : device_ctx.grid.height();
+            if (vtr::atou(tokens[2].c_str()) != width || vtr::atou(tokens[4].c_str()) != height) {
+                VTR_LOGF_WARN(route_file, lineno,
+                              "Device dimensions %sx%s specified in the routing file do not match given %zux%zu, routing every net from scratch\n",
+                              tokens[2].c_str(), tokens[4].c_str(), width, height);
+                return;
+            }
+        } else if (tokens[0] == "Net" && tokens.size() > 2) {
+            net_id = ParentNetId::INVALID();
+            if (tokens.size() == 3) {
+                //Global nets (listed with the blocks they connect) are never routed
+                net_id = net_list.find_net(format_name(tokens[2]));
+            }
+        } else if (tokens[0] == "Node:" && net_id && tokens.size() > 2) {
+            t_warm_start_trace trace;
+            trace.index = atoi(tokens[1].c_str());
+            trace.iswitch = OPEN;
+            trace.net_pin_index = OPEN;
+            for (size_t itoken = 2; itoken + 1 < tokens.size(); ++itoken) {
+                if (tokens[itoken] == "Switch:") {
+                    trace.iswitch = atoi(tokens[itoken + 1].c_str());
+                } else if (tokens[itoken] == "Net_pin_index:") {
+                    trace.net_pin_index = atoi(tokens[itoken + 1].c_str());
+                }
+            }
+
+            //A node of another RR graph is rejected along with its net by load_warm_start_route_tree()
+            if (trace.index >= 0 && size_t(trace.index) < device_ctx.rr_graph.num_nodes()
+                && tokens[2] != device_ctx.rr_graph.node_type_string(RRNodeId(trace.index))) {
+                trace.index = OPEN;
+            }
+
+            tracebacks[net_id].push_back(trace);
+        }
+    }
+}
+
+/**
+ * @brief Builds the route tree of net_id from its warm start traceback, if it is still a legal routing of the net
+ *
+ * The traceback has to start at the net's SOURCE, reach each of the net's SINKs once (as the
+ * sink of its net pin), and follow the edges (and switches) of the RR graph in between.
+ * Returns false, leaving the net unrouted, otherwise.
+ */
+static bool load_warm_start_route_tree(ParentNetId net_id, const std::vector<t_warm_start_trace>& traceback, bool is_flat) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[net_id];
+
+    if (traceback.empty() || traceback.back().iswitch != OPEN) {
+        return false; //Not routed, or truncated
+    }
+    for (const t_warm_start_trace& trace : traceback) {
+        if (trace.index < 0 || size_t(trace.index) >= rr_graph.num_nodes()) {
+            return false; //Not a node of this RR graph
+        }
+    }
+    if (RRNodeId(traceback[0].index) != terminals[0]) {
+        return false; //The driver moved
+    }
+
+    //The SINKs ending each branch, in the order they were reached
+    struct t_branch_sink {
+        RRNodeId node;
+        RRNodeId prev_node;
+        RREdgeId prev_edge;
+        int net_pin_index;
+    };
+    std::vector<t_branch_sink> branch_sinks;
+
+    std::unordered_set<int> tree_nodes = {traceback[0].index};
+    std::vector<bool> is_pin_reached(terminals.size(), false);
+    for (size_t i = 1; i < traceback.size(); ++i) {
+        const t_warm_start_trace& trace = traceback[i];
+        RRNodeId node(trace.index);
+        bool is_sink = (rr_graph.node_type(node) == SINK);
+
+        if (traceback[i - 1].iswitch == OPEN) {
+            //Starts a new branch from a node already in the tree
+            if (is_sink || !tree_nodes.count(trace.index)) {
+                return false;
+            }
+            continue;
+        }
+
+        RRNodeId prev_node(traceback[i - 1].index);
+        RREdgeId prev_edge = find_rr_edge(prev_node, node, traceback[i - 1].iswitch);
+        if (!prev_edge) {
+            return false; //Not connected in this RR graph
+        }
+
+        if (is_sink) {
+            int ipin = trace.net_pin_index;
+            if (trace.iswitch != OPEN || ipin < 1 || size_t(ipin) >= terminals.size()
+                || is_pin_reached[ipin] || terminals[ipin] != node) {
+                return false; //The sink moved
+            }
+            is_pin_reached[ipin] = true;
+            branch_sinks.push_back({node, prev_node, prev_edge, ipin});
+        } else {
+            if (trace.iswitch == OPEN || !tree_nodes.insert(trace.index).second) {
+                return false; //Dangling, or loops back into the tree
+            }
+
+            //Traced back by RouteTree::update_from_heap() below
+            auto node_inf = route_ctx.rr_node_route_inf[node];
+            node_inf.prev_node = prev_node;
+            node_inf.prev_edge = prev_edge;
+        }
+    }
+    if (branch_sinks.size() != terminals.size() - 1) {
+        return false; //Some sinks are not reached
+    }
+
+    //Add the branch to each SINK, as the router would have
+    RouteTree tree(net_id);
+    for (const t_branch_sink& sink : branch_sinks) {
+        t_heap hptr;
+        hptr.index = sink.node;
+        hptr.set_prev_node(sink.prev_node);
+        hptr.set_prev_edge(sink.prev_edge);
+        tree.update_from_heap(&hptr, sink.net_pin_index, nullptr, is_flat);
+    }
+    route_ctx.route_trees[net_id] = std::move(tree);
+
+    return true;
+}
+
+///@brief Returns the RR edge from from_node to to_node through switch iswitch, or an invalid edge if there is none
+static RREdgeId find_rr_edge(RRNodeId from_node, RRNodeId to_node, int iswitch) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& rr_nodes = rr_graph.rr_nodes();
+
+    for (RREdgeId edge : rr_graph.edge_range(from_node)) {
+        if (rr_nodes.edge_sink_node(edge) == to_node && rr_nodes.edge_switch(edge) == iswitch) {
+            return edge;
+        }
+    }
+    return RREdgeId::INVALID();
+}
+
 void print_route(const Netlist<>& net_list,
                  FILE* fp,
                  bool is_flat) {
@@ -573,6 +826,7 @@ void print_route(const Netlist<>& net_list,
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.mutable_routing();
+    const t_grid_crop& crop = device_ctx.grid_crop;
 
     if (route_ctx.route_trees.empty())
         return; //Only if routing exists
@@ -597,12 +851,12 @@ void print_route(const Netlist<>& net_list,
                     int layer_num = rr_graph.node_layer(inode);
 
                     fprintf(fp, "Node:\t%zu\t%6s (%d,%d,%d) ", size_t(inode),
-                            rr_graph.node_type_string(inode), layer_num, ilow, jlow);
+                            rr_graph.node_type_string(inode), layer_num, ilow + crop.x_offset, jlow + crop.y_offset);
 
                     if ((ilow != rr_graph.node_xhigh(inode))
                         || (jlow != rr_graph.node_yhigh(inode)))
-                        fprintf(fp, "to (%d,%d) ", rr_graph.node_xhigh(inode),
-                                rr_graph.node_yhigh(inode));
+                        fprintf(fp, "to (%d,%d) ", rr_graph.node_xhigh(inode) + crop.x_offset,
+                                rr_graph.node_yhigh(inode) + crop.y_offset);
 
                     switch (rr_type) {
                         case IPIN:
@@ -688,19 +942,27 @@ void print_route(const Netlist<>& net_list,
                 fprintf(fp, "Block %s (#%zu) at (%d,%d), Pin class %d.\n",
                         net_list.block_name(block_id).c_str(),
                         size_t(block_id),
-                        blk_loc.loc.x,
-                        blk_loc.loc.y,
+                        blk_loc.loc.x + crop.x_offset,
+                        blk_loc.loc.y + crop.y_offset,
                         iclass);
             }
         }
     }
 }
 
-/* Prints out the routing to file route_file.  */
+/* Prints out the routing to file route_file (in binary if it has the .bin extension).  */
 void print_route(const Netlist<>& net_list,
                  const char* placement_file,
                  const char* route_file,
                  bool is_flat) {
+    if (is_binary_route_file(route_file)) {
+        print_binary_route(net_list, placement_file, route_file, is_flat);
+
+        //Save the digest of the route file
+        g_vpr_ctx.mutable_routing().routing_id = vtr::secure_digest_file(route_file);
+        return;
+    }
+
     FILE* fp;
 
     fp = fopen(route_file, "w");
@@ -711,7 +973,10 @@ void print_route(const Netlist<>& net_list,
 
     fprintf(fp, "Placement_File: %s Placement_ID: %s\n", placement_file, place_ctx.placement_id.c_str());
 
-    fprintf(fp, "Array size: %zu x %zu logic blocks.\n", device_ctx.grid.width(), device_ctx.grid.height());
+    const t_grid_crop& crop = device_ctx.grid_crop;
+    fprintf(fp, "Array size: %zu x %zu logic blocks.\n",
+            crop.is_cropped() ? crop.full_width : device_ctx.grid.width(),
+            crop.is_cropped() ? crop.full_height : device_ctx.grid.height());
     fprintf(fp, "\nRouting:");
 
     print_route(net_list, fp, is_flat);
@@ -721,3 +986,296 @@ void print_route(const Netlist<>& net_list,
     //Save the digest of the route file
     route_ctx.routing_id = vtr::secure_digest_file(route_file);
 }
+
+static bool is_binary_route_file(const char* route_file) {
+    return vtr::check_file_name_extension(route_file, ".bin");
+}
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+static bool read_binary_route(const char* /*route_file*/, const t_router_opts& /*router_opts*/, bool /*verify_file_digests*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Reading binary routing files " DISABLE_ERROR);
+}
+
+static void print_binary_route(const Netlist<>& /*net_list*/, const char* /*placement_file*/, const char* /*route_file*/, bool /*is_flat*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Writing binary routing files " DISABLE_ERROR);
+}
+
+static void read_binary_warm_start_tracebacks(const Netlist<>& /*net_list*/, const char* /*route_file*/, bool /*is_flat*/, t_warm_start_tracebacks& /*tracebacks*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "Reading binary routing files " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+///@brief The traceback of one routed net in a binary routing file
+struct t_binary_net_route {
+    ParentNetId net_id;
+    ::capnp::List<uint32_t>::Reader nodes;
+    ::capnp::List<int16_t>::Reader switches;
+    ::capnp::List<int32_t>::Reader net_pin_indices;
+};
+
+/**
+ * @brief Builds the route tree of a net from its traceback in a binary routing file
+ *
+ * Does not touch the message's read limiter, so nets can be loaded concurrently.
+ */
+static void load_binary_net_route(const t_binary_net_route& net_route, const char* route_file) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    t_trace* head = nullptr;
+    t_trace* tail = nullptr;
+    for (size_t i = 0; i < net_route.nodes.size(); ++i) {
+        size_t inode = net_route.nodes[i];
+        if (inode >= rr_graph.num_nodes()) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Node %zu of net %zu is not in the RR graph", inode, size_t(net_route.net_id));
+        }
+
+        t_trace* tptr = alloc_trace_data();
+        tptr->index = inode;
+        tptr->iswitch = net_route.switches[i];
+        tptr->net_pin_index = net_route.net_pin_indices[i];
+        tptr->next = nullptr;
+
+        if (tail) {
+            tail->next = tptr;
+        } else {
+            head = tptr;
+        }
+        tail = tptr;
+    }
+
+    if (rr_graph.node_type(RRNodeId(head->index)) != SOURCE) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "The routing of net %zu does not start at a SOURCE", size_t(net_route.net_id));
+    }
+
+    VTR_ASSERT(validate_traceback(head));
+    route_ctx.route_trees[net_route.net_id] = TracebackCompat::traceback_to_route_tree(head);
+    free_traceback(head);
+}
+
+static bool read_binary_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& place_ctx = g_vpr_ctx.placement();
+    bool flat_router = router_opts.flat_routing;
+
+    VTR_LOG("Begin loading FPGA binary routing file.\n");
+
+    MmapFile f(route_file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto route = reader.getRoot<VprRoute>();
+
+    if (std::string(route.getPlacementId().cStr()) != place_ctx.placement_id) {
+        auto msg = vtr::string_fmt(
+            "Placement file %s specified in the routing file"
+            " does not match the loaded placement (ID %s != %s)",
+            route.getPlacementFile().cStr(), route.getPlacementId().cStr(), place_ctx.placement_id.c_str());
+        if (verify_file_digests) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0, msg.c_str());
+        } else {
+            VTR_LOGF_WARN(route_file, 0, "%s\n", msg.c_str());
+        }
+    }
+
+    if (route.getGridWidth() != device_ctx.grid.width() || route.getGridHeight() != device_ctx.grid.height()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Device dimensions %ux%u specified in the routing file does not match given %zux%zu ",
+                  route.getGridWidth(), route.getGridHeight(), device_ctx.grid.width(), device_ctx.grid.height());
+    }
+
+    if (route.getNumRrNodes() != device_ctx.rr_graph.num_nodes()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "The routing file was written for a RR graph of %zu nodes, but the RR graph has %zu nodes",
+                  size_t(route.getNumRrNodes()), device_ctx.rr_graph.num_nodes());
+    }
+
+    if (route.getIsFlat() != flat_router) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "The routing file was written %s flat routing, but flat routing is %s",
+                  route.getIsFlat() ? "with" : "without", flat_router ? "on" : "off");
+    }
+
+    /*Allocate necessary routing structures*/
+    alloc_and_load_rr_node_route_structs();
+    const Netlist<>& router_net_list = (flat_router) ? (const Netlist<>&)g_vpr_ctx.atom().nlist : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
+    init_route_structs(router_net_list,
+                       router_opts.bb_factor,
+                       router_opts.has_choking_spot,
+                       flat_router);
+
+    //Check every net against the netlist and gather the tracebacks of the routed ones.
+    //This is done serially since the message reader's read limit is not thread safe.
+    size_t num_nets = router_net_list.nets().size();
+    std::vector<t_binary_net_route> net_routes;
+    for (auto net : route.getNets()) {
+        ParentNetId net_id(net.getId());
+        if (size_t(net_id) >= num_nets) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Net %zu specified in the routing file is not in the netlist", size_t(net_id));
+        }
+        if (router_net_list.net_name(net_id) != net.getName().cStr()) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Net name %s for net number %zu specified in the routing file does not match given %s",
+                      net.getName().cStr(), size_t(net_id), router_net_list.net_name(net_id).c_str());
+        }
+        if (router_net_list.net_is_ignored(net_id) != net.getIsGlobal()) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "Net %zu (%s) is %s in the routing file, but %s in the netlist",
+                      size_t(net_id), net.getName().cStr(),
+                      net.getIsGlobal() ? "global" : "not global",
+                      router_net_list.net_is_ignored(net_id) ? "global" : "not global");
+        }
+
+        t_binary_net_route net_route;
+        net_route.net_id = net_id;
+        net_route.nodes = net.getNodes();
+        net_route.switches = net.getSwitches();
+        net_route.net_pin_indices = net.getNetPinIndices();
+        if (net_route.switches.size() != net_route.nodes.size() || net_route.net_pin_indices.size() != net_route.nodes.size()) {
+            vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                      "The traceback of net %zu (%s) is malformed", size_t(net_id), net.getName().cStr());
+        }
+
+        if (net_route.nodes.size() > 0) {
+            net_routes.push_back(net_route);
+        }
+    }
+
+    //Build the route trees
+#    ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), net_routes.size(), [&](size_t i) {
+        load_binary_net_route(net_routes[i], route_file);
+    });
+#    else
+    for (const t_binary_net_route& net_route : net_routes) {
+        load_binary_net_route(net_route, route_file);
+    }
+#    endif
+
+    return finish_route_loading(router_net_list, router_opts);
+}
+
+///@brief Reads the tracebacks of the nets of net_list (matched by name) in a binary routing file, without checking them
+static void read_binary_warm_start_tracebacks(const Netlist<>& net_list, const char* route_file, bool is_flat, t_warm_start_tracebacks& tracebacks) {
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    MmapFile f(route_file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto route = reader.getRoot<VprRoute>();
+
+    //The RR node ids of the file are meaningless for another RR graph
+    if (route.getGridWidth() != device_ctx.grid.width() || route.getGridHeight() != device_ctx.grid.height()
+        || route.getNumRrNodes() != device_ctx.rr_graph.num_nodes() || route.getIsFlat() != is_flat) {
+        VTR_LOGF_WARN(route_file, 0,
+                      "The routing file was written for another device, RR graph or flat routing setting, routing every net from scratch\n");
+        return;
+    }
+
+    for (auto net : route.getNets()) {
+        ParentNetId net_id = net_list.find_net(net.getName().cStr());
+        if (!net_id) continue;
+
+        auto nodes = net.getNodes();
+        auto switches = net.getSwitches();
+        auto net_pin_indices = net.getNetPinIndices();
+        if (switches.size() != nodes.size() || net_pin_indices.size() != nodes.size()) {
+            continue; //Malformed, leave the net unrouted
+        }
+
+        std::vector<t_warm_start_trace>& traceback = tracebacks[net_id];
+        traceback.reserve(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            traceback.push_back({int(nodes[i]), switches[i], net_pin_indices[i]});
+        }
+    }
+}
+
+/** @brief The traceback of a net to write to a binary routing file */
+struct t_binary_net_traceback {
+    std::vector<uint32_t> nodes;
+    std::vector<int16_t> switches;
+    std::vector<int32_t> net_pin_indices;
+};
+
+/** @brief Appends the traceback of the route tree below node, in the order of TracebackCompat::traceback_from_route_tree() */
+static void append_binary_net_traceback(const RouteTreeNode& node, t_binary_net_traceback& traceback) {
+    if (node.is_leaf()) {
+        traceback.nodes.push_back(size_t(node.inode));
+        traceback.switches.push_back(OPEN);
+        traceback.net_pin_indices.push_back(node.net_pin_index);
+        return;
+    }
+
+    for (const RouteTreeNode& child : node.child_nodes()) {
+        traceback.nodes.push_back(size_t(node.inode));
+        traceback.switches.push_back(size_t(child.parent_switch));
+        traceback.net_pin_indices.push_back(node.net_pin_index);
+
+        append_binary_net_traceback(child, traceback);
+    }
+}
+
+static void print_binary_route(const Netlist<>& net_list, const char* placement_file, const char* route_file, bool is_flat) {
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto route = builder.initRoot<VprRoute>();
+
+    route.setPlacementFile(placement_file);
+    route.setPlacementId(place_ctx.placement_id.c_str());
+    route.setGridWidth(device_ctx.grid.width());
+    route.setGridHeight(device_ctx.grid.height());
+    route.setNumRrNodes(device_ctx.rr_graph.num_nodes());
+    route.setIsFlat(is_flat);
+
+    if (!route_ctx.route_trees.empty()) { //Only if routing exists
+        //Build the tracebacks of the nets concurrently (the message builder is not thread safe)
+        vtr::vector<ParentNetId, t_binary_net_traceback> tracebacks(net_list.nets().size());
+        auto build_traceback = [&](ParentNetId net_id) {
+            if (net_list.net_is_ignored(net_id) || !route_ctx.route_trees[net_id]) {
+                return; //Global or unrouted (e.g. used in the local cluster only)
+            }
+            append_binary_net_traceback(route_ctx.route_trees[net_id]->root(), tracebacks[net_id]);
+        };
+#    ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), net_list.nets().size(), [&](size_t inet) {
+            build_traceback(ParentNetId(inet));
+        });
+#    else
+        for (auto net_id : net_list.nets()) {
+            build_traceback(net_id);
+        }
+#    endif
+
+        auto nets = route.initNets(net_list.nets().size());
+        size_t inet = 0;
+        for (auto net_id : net_list.nets()) {
+            auto net = nets[inet++];
+            net.setId(size_t(net_id));
+            net.setName(net_list.net_name(net_id).c_str());
+            net.setIsGlobal(net_list.net_is_ignored(net_id));
+
+            const t_binary_net_traceback& traceback = tracebacks[net_id];
+            if (traceback.nodes.empty()) {
+                continue;
+            }
+
+            net.setNodes(kj::arrayPtr(traceback.nodes.data(), traceback.nodes.size()));
+            net.setSwitches(kj::arrayPtr(traceback.switches.data(), traceback.switches.size()));
+            net.setNetPinIndices(kj::arrayPtr(traceback.net_pin_indices.data(), traceback.net_pin_indices.size()));
+        }
+    }
+
+    writeMessageToFile(route_file, &builder);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
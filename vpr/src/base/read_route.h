@@ -2,7 +2,8 @@
  * @file
  * @brief Functions to read/write a .route file, which contains a serialized routing state.
  *
- * This is used to perform --analysis only
+ * This is used to perform --analysis only, and to warm start the router from a previous routing
+ * (--route_warm_start_file)
  */
 
 #ifndef READ_ROUTE_H
@@ -14,4 +15,14 @@
 bool read_route(const char* route_file, const t_router_opts& RouterOpts, bool verify_file_digests, bool is_flat);
 void print_route(const Netlist<>& net_list, const char* placement_file, const char* route_file, bool is_flat);
 
+/**
+ * @brief Loads the routing of the nets of net_list which did not change since route_file was written, to warm start the router
+ *
+ * Nets are matched by name, and only keep their routing if it still connects their current
+ * terminals through the RR graph. The other nets are left unrouted. The occupancy of the RR
+ * nodes is recomputed for the kept routing. The routing structures have to be initialized
+ * (init_route_structs()). Returns the number of nets whose routing was kept.
+ */
+size_t load_warm_start_routing(const Netlist<>& net_list, const char* route_file, bool is_flat);
+
 #endif /* READ_ROUTE_H */
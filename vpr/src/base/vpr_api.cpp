@@ -17,6 +17,11 @@
 #include <chrono>
 #include <cmath>
 #include <sstream>
+#include <filesystem>
+#include <limits>
+#include <exception>
+#include <thread>
+#include <utility>
 
 #include "vtr_assert.h"
 #include "vtr_math.h"
@@ -55,6 +60,7 @@
 #include "timing_place_lookup.h"
 #include "route_export.h"
 #include "vpr_api.h"
+#include "vpr_fork_jobs.h"
 #include "read_sdc.h"
 #include "power.h"
 #include "pack_types.h"
@@ -87,6 +93,7 @@
 #include "read_route.h"
 #include "read_blif.h"
 #include "read_place.h"
+#include "flow_checkpoint.h"
 
 #include "arch_util.h"
 
@@ -105,6 +112,7 @@
 static void free_complex_block_types();
 
 static void free_device(const t_det_routing_arch& routing_arch);
+static void free_device_arch_data();
 static void free_circuit();
 
 static void get_intercluster_switch_fanin_estimates(const t_vpr_setup& vpr_setup,
@@ -113,6 +121,18 @@ static void get_intercluster_switch_fanin_estimates(const t_vpr_setup& vpr_setup
                                                     int* opin_switch_fanin,
                                                     int* wire_switch_fanin,
                                                     int* ipin_switch_fanin);
+
+static void commit_cache_files(const t_file_name_opts& filename_opts);
+
+static void checkpoint_completed_stage(const t_file_name_opts& filename_opts, e_stage_action action, e_flow_checkpoint_stage stage, const std::string& output_file);
+
+static void crop_device_grid_to_floorplan(int margin);
+
+static void load_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch);
+static void report_device_grid_usage(const t_vpr_setup& vpr_setup);
+
+static bool can_pipeline_device_creation(const t_vpr_setup& vpr_setup);
+static bool rr_graph_needed_before_routing(const t_vpr_setup& vpr_setup);
 /* Local subroutines end */
 
 ///@brief Display general VPR information
@@ -183,6 +203,7 @@ void vpr_init(const int argc, const char** argv, t_options* options, t_vpr_setup
     vpr_print_args(argc, argv);
 
     vpr_init_with_options(options, vpr_setup, arch);
+    vpr_setup->command_line.assign(argv + 1, argv + argc);
 }
 
 /**
@@ -193,6 +214,10 @@ void vpr_init(const int argc, const char** argv, t_options* options, t_vpr_setup
  * 3. Sanity check all three
  */
 void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_arch* arch) {
+    if (!options->write_timing_trace.value().empty()) {
+        vtr::start_timing_trace(options->write_timing_trace.value());
+    }
+
     //Set the number of parallel workers
     // We determine the number of workers in the following order:
     //  1. An explicitly specified command-line argument
@@ -232,6 +257,9 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
 
     vpr_setup->TimingEnabled = options->timing_analysis;
     vpr_setup->device_layout = options->device_layout;
+    vpr_setup->crop_device_to_floorplan = options->crop_device_to_floorplan;
+    vpr_setup->crop_device_margin = options->crop_device_margin;
+    vpr_setup->pipeline_device_creation = options->pipeline_device_creation;
     vpr_setup->constant_net_method = options->constant_net_method;
     vpr_setup->clock_modeling = options->clock_modeling;
     vpr_setup->two_stage_clock_routing = options->two_stage_clock_routing;
@@ -370,17 +398,79 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
      * (contrary to the name). */
     tbb::global_control c(tbb::global_control::max_allowed_parallelism, vpr_setup.num_workers);
 
+    //With a fixed device and channel width, the rr graph and router lookahead do not depend on
+    //the packing, so they are built while packing runs (which only reads the device data)
+    bool pipeline_device_creation = vpr_setup.pipeline_device_creation && can_pipeline_device_creation(vpr_setup);
+    std::thread device_thread;
+    std::exception_ptr device_error;
+    if (pipeline_device_creation) {
+        VTR_LOG("Building the device while packing\n");
+        load_device_grid(vpr_setup, arch);
+        vpr_setup_clock_networks(vpr_setup, arch);
+
+        device_thread = std::thread([&]() {
+            try {
+                vtr::ScopedStartFinishTimer timer("Create Device (alongside packing)");
+                vpr_create_rr_graph(vpr_setup, arch, vpr_setup.PlacerOpts.place_chan_width, false);
+                if (placer_needs_lookahead(vpr_setup) || (vpr_setup.RouterOpts.doRouting == STAGE_DO && !vpr_setup.RouterOpts.flat_routing)) {
+                    get_cached_router_lookahead(vpr_setup.RoutingArch,
+                                                vpr_setup.RouterOpts.lookahead_type,
+                                                vpr_setup.RouterOpts.write_router_lookahead,
+                                                vpr_setup.RouterOpts.read_router_lookahead,
+                                                vpr_setup.Segments,
+                                                vpr_setup.RouterOpts.lookahead_half_precision,
+                                                /*is_flat=*/false);
+                }
+            } catch (...) {
+                device_error = std::current_exception();
+            }
+        });
+    }
+    auto join_device_thread = [&]() {
+        if (device_thread.joinable()) {
+            device_thread.join();
+        }
+        if (device_error) {
+            std::rethrow_exception(std::exchange(device_error, nullptr));
+        }
+    };
+
     { //Pack
-        bool pack_success = vpr_pack_flow(vpr_setup, arch);
+        bool pack_success;
+        try {
+            pack_success = vpr_pack_flow(vpr_setup, arch);
+        } catch (...) {
+            if (device_thread.joinable()) {
+                device_thread.join();
+            }
+            throw;
+        }
+        join_device_thread();
 
         if (!pack_success) {
             return false; //Unimplementable
         }
+        g_vpr_ctx.print_memory_usage("packing");
+        checkpoint_completed_stage(vpr_setup.FileNameOpts, vpr_setup.PackerOpts.doPacking, e_flow_checkpoint_stage::PACK, vpr_setup.FileNameOpts.NetFile);
     }
 
-    // For the time being, we decided to create the flat graph after placement is done. Thus, the is_flat parameter for this function
-    //, since it is called before routing, should be false.
-    vpr_create_device(vpr_setup, arch, false);
+    if (pipeline_device_creation) {
+        report_device_grid_usage(vpr_setup);
+        //The NoC traffic flows refer to the clustered blocks
+        vpr_setup_noc(vpr_setup, arch);
+    } else {
+        // For the time being, we decided to create the flat graph after placement is done. Thus, the is_flat parameter for this function
+        //, since it is called before routing, should be false.
+        vpr_create_device(vpr_setup, arch, false);
+    }
+
+    if (!vpr_setup.FileNameOpts.fork_jobs_file.empty()) {
+        //The rest of the flow is run by a child process per job
+        bool jobs_succeeded = false;
+        if (!vpr_fork_jobs(vpr_setup, jobs_succeeded)) {
+            return jobs_succeeded;
+        }
+    }
 
     // TODO: Placer still assumes that cluster net list is used - graphics can not work with flat routing yet
     vpr_init_graphics(vpr_setup, arch, false);
@@ -392,20 +482,29 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
             std::cout << "failed placement" << std::endl;
             return false; //Unimplementable
         }
+        g_vpr_ctx.print_memory_usage("placement");
+        checkpoint_completed_stage(vpr_setup.FileNameOpts, vpr_setup.PlacerOpts.doPlacement, e_flow_checkpoint_stage::PLACE, vpr_setup.FileNameOpts.PlaceFile);
     }
     bool is_flat = vpr_setup.RouterOpts.flat_routing;
     const Netlist<>& router_net_list = is_flat ? (const Netlist<>&)g_vpr_ctx.atom().nlist : (const Netlist<>&)g_vpr_ctx.clustering().clb_nlist;
     RouteStatus route_status;
     { //Route
         route_status = vpr_route_flow(router_net_list, vpr_setup, arch, is_flat);
+        g_vpr_ctx.print_memory_usage("routing");
+        if (route_status.success()) {
+            checkpoint_completed_stage(vpr_setup.FileNameOpts, vpr_setup.RouterOpts.doRouting, e_flow_checkpoint_stage::ROUTE, vpr_setup.FileNameOpts.RouteFile);
+        }
     }
     { //Analysis
         vpr_analysis_flow(router_net_list, vpr_setup, arch, route_status, is_flat);
+        g_vpr_ctx.print_memory_usage("analysis");
     }
 
     //close the graphics
     vpr_close_graphics(vpr_setup);
 
+    commit_cache_files(vpr_setup.FileNameOpts);
+
     return route_status.success();
 }
 
@@ -417,7 +516,7 @@ void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& arch, bool is_flat)
 
     vpr_setup_noc(vpr_setup, arch);
 
-    if (vpr_setup.PlacerOpts.place_chan_width != NO_FIXED_CHANNEL_WIDTH) {
+    if (vpr_setup.PlacerOpts.place_chan_width != NO_FIXED_CHANNEL_WIDTH && rr_graph_needed_before_routing(vpr_setup)) {
         vpr_create_rr_graph(vpr_setup, arch, vpr_setup.PlacerOpts.place_chan_width, is_flat);
     }
 }
@@ -429,6 +528,12 @@ void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& arch, bool is_flat)
  */
 void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch) {
     vtr::ScopedStartFinishTimer timer("Build Device Grid");
+    load_device_grid(vpr_setup, Arch);
+    report_device_grid_usage(vpr_setup);
+}
+
+///@brief Builds the device grid (and crops it, if requested)
+static void load_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch) {
     /* Read in netlist file for placement and routing */
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& device_ctx = g_vpr_ctx.mutable_device();
@@ -448,6 +553,22 @@ void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch) {
     //Build the device
     float target_device_utilization = vpr_setup.PackerOpts.target_device_utilization;
     device_ctx.grid = create_device_grid(vpr_setup.device_layout, Arch.grid_layouts, num_type_instances, target_device_utilization);
+    device_ctx.grid_crop = t_grid_crop();
+    if (vpr_setup.crop_device_to_floorplan) {
+        crop_device_grid_to_floorplan(vpr_setup.crop_device_margin);
+    }
+}
+
+///@brief Reports the size of the device grid and its usage by the clustered netlist
+static void report_device_grid_usage(const t_vpr_setup& vpr_setup) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& device_ctx = g_vpr_ctx.device();
+
+    std::map<t_logical_block_type_ptr, size_t> num_type_instances;
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        num_type_instances[cluster_ctx.clb_nlist.block_type(blk_id)]++;
+    }
+    float target_device_utilization = vpr_setup.PackerOpts.target_device_utilization;
 
     /*
      *Report on the device
@@ -509,6 +630,96 @@ void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch) {
     }
 }
 
+/**
+ * @brief Crops the device grid to the bounding box of the floorplan constraints (grown by margin tiles),
+ *        and moves the floorplan constraints to the coordinates of the cropped grid
+ *
+ * The rr graph is built from the grid, so it then only covers the cropped part of the device.
+ */
+static void crop_device_grid_to_floorplan(int margin) {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+    auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
+    auto& constraints = floorplanning_ctx.constraints;
+
+    //Bounding box of all the regions of all the partitions
+    int xmin = std::numeric_limits<int>::max();
+    int ymin = std::numeric_limits<int>::max();
+    int xmax = std::numeric_limits<int>::min();
+    int ymax = std::numeric_limits<int>::min();
+    for (int ipart = 0; ipart < constraints.get_num_partitions(); ++ipart) {
+        for (Region region : constraints.get_partition_pr(PartitionId(ipart)).get_partition_region()) {
+            if (region.empty()) continue;
+
+            RegionRectCoord rect = region.get_region_rect();
+            xmin = std::min(xmin, rect.xmin);
+            ymin = std::min(ymin, rect.ymin);
+            xmax = std::max(xmax, rect.xmax);
+            ymax = std::max(ymax, rect.ymax);
+        }
+    }
+
+    if (xmin > xmax || xmax + margin < 0 || ymax + margin < 0
+        || xmin - margin >= int(device_ctx.grid.width()) || ymin - margin >= int(device_ctx.grid.height())) {
+        VTR_LOG_WARN("The floorplan constraints do not cover any part of the device, not cropping the device\n");
+        return;
+    }
+
+    vtr::Rect<int> region(xmin - margin, ymin - margin, xmax + margin, ymax + margin);
+    device_ctx.grid = crop_device_grid(device_ctx.grid, region, device_ctx.grid_crop);
+
+    const t_grid_crop& crop = device_ctx.grid_crop;
+    VTR_LOG("Device cropped to the floorplan constraints: %zu x %zu grid tiles at (%d,%d) of the %zu x %zu device\n",
+            device_ctx.grid.width(), device_ctx.grid.height(), crop.x_offset, crop.y_offset, crop.full_width, crop.full_height);
+
+    //Move the floorplan constraints to the cropped grid
+    for (int ipart = 0; ipart < constraints.get_num_partitions(); ++ipart) {
+        PartitionRegion pr = constraints.get_partition_pr(PartitionId(ipart));
+        shift_partition_region(pr, -crop.x_offset, -crop.y_offset);
+        constraints.set_partition_pr(PartitionId(ipart), pr);
+    }
+    for (PartitionRegion& pr : floorplanning_ctx.cluster_constraints) {
+        shift_partition_region(pr, -crop.x_offset, -crop.y_offset);
+    }
+}
+
+/**
+ * @brief Returns true if the device can be created while packing runs (--pipeline_device_creation)
+ *
+ * The rr graph only depends on the packing through the device size and the channel width, so both
+ * must be fixed. Cropping the device moves the floorplan constraints, so it must happen after packing.
+ */
+static bool can_pipeline_device_creation(const t_vpr_setup& vpr_setup) {
+    const char* reason = nullptr;
+    if (vpr_setup.PackerOpts.doPacking != STAGE_DO) {
+        reason = "packing is not run";
+    } else if (vpr_setup.device_layout == "auto") {
+        reason = "the device is sized to the packing (use --device to select a fixed device)";
+    } else if (vpr_setup.PlacerOpts.place_chan_width == NO_FIXED_CHANNEL_WIDTH) {
+        reason = "the channel width is not fixed (use --route_chan_width)";
+    } else if (vpr_setup.crop_device_to_floorplan) {
+        reason = "the device is cropped to the floorplan";
+    }
+
+    if (reason) {
+        VTR_LOG("Not building the device while packing: %s\n", reason);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns true if the rr graph must be built with the device, rather than when the routing is loaded
+ *
+ * Only the placer (through its delay model and the router lookahead) uses the rr graph ahead of routing.
+ * When the placement and the routing are both loaded (e.g. to re-run the analysis of a finished design),
+ * building the rr graph with the device would at best be early, and with flat routing wasted, since the
+ * loaded routing needs a flat rr graph.
+ */
+static bool rr_graph_needed_before_routing(const t_vpr_setup& vpr_setup) {
+    return vpr_setup.PlacerOpts.doPlacement == STAGE_DO
+           || vpr_setup.RouterOpts.doRouting != STAGE_LOAD;
+}
+
 void vpr_setup_clock_networks(t_vpr_setup& vpr_setup, const t_arch& Arch) {
     if (vpr_setup.clock_modeling == DEDICATED_NETWORK) {
         setup_clock_networks(Arch, vpr_setup.Segments);
@@ -731,6 +942,7 @@ void vpr_place(const Netlist<>& net_list, t_vpr_setup& vpr_setup, const t_arch&
             vpr_setup.RouterOpts.write_router_lookahead,
             vpr_setup.RouterOpts.read_router_lookahead,
             vpr_setup.Segments,
+            vpr_setup.RouterOpts.lookahead_half_precision,
             is_flat);
     }
 
@@ -826,8 +1038,9 @@ RouteStatus vpr_route_flow(const Netlist<>& net_list,
             //Load a previous routing
             //if the previous load file is generated using flat routing,
             //we need to create rr_graph with is_flat flag to add additional
-            //internal nodes/edges.
-            if (is_flat) {
+            //internal nodes/edges. The rr graph is also only built here if
+            //nothing used it before routing (see vpr_create_device()).
+            if (is_flat || rr_graph.num_nodes() == 0) {
                 vpr_create_rr_graph(vpr_setup, arch, chan_width, is_flat);
             }
 
@@ -909,6 +1122,7 @@ RouteStatus vpr_route_fixed_W(const Netlist<>& net_list,
         vpr_setup.RouterOpts.write_router_lookahead,
         vpr_setup.RouterOpts.read_router_lookahead,
         vpr_setup.Segments,
+        vpr_setup.RouterOpts.lookahead_half_precision,
         is_flat);
 
     vtr::ScopedStartFinishTimer timer("Routing");
@@ -1017,8 +1231,10 @@ void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_wi
 
     int warnings = 0;
 
-    //Clean-up any previous RR graph
-    free_rr_graph();
+    //Clean-up any previous RR graph, unless create_rr_graph() may keep it
+    if (!vpr_setup.reuse_rr_graph) {
+        free_rr_graph();
+    }
 
     //Create the RR graph
     create_rr_graph(graph_type,
@@ -1151,6 +1367,13 @@ void free_device(const t_det_routing_arch& /*routing_arch*/) {
     device_ctx.chan_width.y_list.clear();
     device_ctx.chan_width.max = device_ctx.chan_width.x_max = device_ctx.chan_width.y_max = device_ctx.chan_width.x_min = device_ctx.chan_width.y_min = 0;
 
+    free_device_arch_data();
+}
+
+///@brief Frees the device data loaded from the architecture file, which is re-loaded by the next vpr_init()
+static void free_device_arch_data() {
+    auto& device_ctx = g_vpr_ctx.mutable_device();
+
     device_ctx.arch_switch_inf.clear();
 
     device_ctx.all_sw_inf.clear();
@@ -1158,6 +1381,46 @@ void free_device(const t_det_routing_arch& /*routing_arch*/) {
     free_complex_block_types();
 }
 
+/**
+ * @brief Moves the files written for the --cache_dir cache during this run to their final names
+ *
+ * This is only done once the flow completed, so a file which failed to be written never enters the cache.
+ */
+static void commit_cache_files(const t_file_name_opts& filename_opts) {
+    for (const auto& [tmp_file, cache_file] : filename_opts.cache_files_to_commit) {
+        if (!vtr::file_exists(tmp_file.c_str())) {
+            continue; //Artifact was not needed by this run
+        }
+
+        //Renaming within the cache directory is atomic, so concurrent runs see either no file or a complete one
+        std::error_code ec;
+        std::filesystem::rename(tmp_file, cache_file, ec);
+        if (ec) {
+            VTR_LOG_WARN("Failed to add '%s' to the cache: %s\n", cache_file.c_str(), ec.message().c_str());
+        } else {
+            VTR_LOG("Added '%s' to the cache\n", cache_file.c_str());
+        }
+    }
+}
+
+/**
+ * @brief Records in the --resume_from flow checkpoint that a stage which was run (not loaded) completed
+ *
+ * The per-iteration checkpoints of the stage are no longer needed once its output file is written.
+ */
+static void checkpoint_completed_stage(const t_file_name_opts& filename_opts, e_stage_action action, e_flow_checkpoint_stage stage, const std::string& output_file) {
+    if (filename_opts.flow_checkpoint_dir.empty() || action != STAGE_DO) {
+        return;
+    }
+
+    checkpoint_flow_stage(filename_opts.flow_checkpoint_dir, stage, output_file);
+
+    if (stage == e_flow_checkpoint_stage::ROUTE) {
+        std::error_code ec;
+        std::filesystem::remove(get_route_checkpoint_file(filename_opts.flow_checkpoint_dir), ec);
+    }
+}
+
 static void free_complex_block_types() {
     auto& device_ctx = g_vpr_ctx.mutable_device();
 
@@ -1179,6 +1442,8 @@ static void free_atoms() {
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
     atom_ctx.nlist = AtomNetlist();
     atom_ctx.lookup = AtomLookup();
+    atom_ctx.atom_molecules.clear();
+    atom_ctx.list_of_pack_molecules.reset();
 }
 
 static void free_placement() {
@@ -1205,6 +1470,7 @@ static void free_routing() {
 static void free_noc() {
     auto& noc_ctx = g_vpr_ctx.mutable_noc();
     delete noc_ctx.noc_flows_router;
+    noc_ctx.noc_flows_router = nullptr;
 }
 
 void vpr_free_vpr_data_structures(t_arch& Arch,
@@ -1229,6 +1495,23 @@ void vpr_free_all(t_arch& Arch,
     vpr_free_vpr_data_structures(Arch, vpr_setup);
 }
 
+void vpr_free_all_but_rr_graph(t_arch& Arch,
+                               t_vpr_setup& vpr_setup) {
+    if (vpr_setup.RouterOpts.doRouting) {
+        free_route_structs();
+    }
+    free_all_lb_type_rr_graph(vpr_setup.PackerRRGraph);
+    free_circuit();
+    free_arch(&Arch);
+    //The channel widths are kept, so the next create_rr_graph() sees the rr graph is up to date
+    free_device_arch_data();
+    free_echo_file_info();
+    free_placement();
+    free_routing();
+    free_atoms();
+    free_noc();
+}
+
 /****************************************************************************************************
  * Advanced functions
  *  Used when you need fine-grained control over VPR that the main VPR operations do not enable
@@ -1403,6 +1686,7 @@ void vpr_analysis(const Netlist<>& net_list,
 
         //Do final timing analysis
         auto analysis_delay_calc = std::make_shared<AnalysisDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_delay, vpr_setup.RouterOpts.flat_routing);
+        analysis_delay_calc->materialize_edge_delays(*g_vpr_ctx.timing().graph);
         auto timing_info = make_setup_hold_timing_info(analysis_delay_calc, vpr_setup.AnalysisOpts.timing_update_type);
         timing_info->update();
 
@@ -1419,6 +1703,20 @@ void vpr_analysis(const Netlist<>& net_list,
         generate_setup_timing_stats(/*prefix=*/"", *timing_info,
                                     *analysis_delay_calc, vpr_setup.AnalysisOpts, vpr_setup.RouterOpts.flat_routing);
 
+        //Analyze the additional delay corners, re-using the timing graph and routing of the nominal one
+        for (const t_timing_corner& corner : vpr_setup.AnalysisOpts.timing_corners) {
+            VTR_LOG("\n");
+            VTR_LOG("Timing corner '%s' (delay scale %g)\n", corner.name.c_str(), corner.delay_scale);
+
+            auto corner_delay_calc = std::make_shared<AnalysisDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, net_delay, vpr_setup.RouterOpts.flat_routing);
+            corner_delay_calc->set_delay_scale(corner.delay_scale);
+            corner_delay_calc->materialize_edge_delays(*g_vpr_ctx.timing().graph);
+            auto corner_timing_info = make_setup_hold_timing_info(corner_delay_calc, vpr_setup.AnalysisOpts.timing_update_type);
+            corner_timing_info->update();
+
+            generate_corner_timing_stats(corner, *corner_timing_info, *corner_delay_calc, vpr_setup.AnalysisOpts, vpr_setup.RouterOpts.flat_routing);
+        }
+
         //Write the post-syntesis netlist
         if (vpr_setup.AnalysisOpts.gen_post_synthesis_netlist) {
             netlist_writer(atom_ctx.nlist.netlist_name().c_str(), analysis_delay_calc,
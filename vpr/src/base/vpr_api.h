@@ -129,7 +129,7 @@ void vpr_analysis(const Netlist<>& net_list,
 
 /* Device creating */
 
-///@brief Create the device (grid + rr graph)
+///@brief Create the device (grid + rr graph, unless the rr graph is first needed by a loaded routing, which builds it)
 void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& Arch, bool is_flat);
 
 ///@brief Create the device grid
@@ -149,6 +149,9 @@ void vpr_setup_noc_routing_algorithm(std::string noc_routing_algorithm_name);
 void vpr_free_vpr_data_structures(t_arch& Arch, t_vpr_setup& vpr_setup);
 void vpr_free_all(t_arch& Arch,
                   t_vpr_setup& vpr_setup);
+///@brief Frees like vpr_free_all(), except for the rr graph (and its channel widths and router lookahead) so a following flow on the same device can re-use them
+void vpr_free_all_but_rr_graph(t_arch& Arch,
+                               t_vpr_setup& vpr_setup);
 
 /* Display general info to user */
 void vpr_print_title();
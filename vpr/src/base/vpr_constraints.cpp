@@ -2,60 +2,82 @@
 #include "partition.h"
 
 void VprConstraints::add_constrained_atom(const AtomBlockId blk_id, const PartitionId part_id) {
-    auto got = constrained_atoms.find(blk_id);
-
     /**
-     * Each atom can only be in one partition. If the atom is not found in constrained_atoms, it
-     * will be added with its partition id.
-     * If the atom is already in constrained_atoms, the partition id will be updated.
+     * Each atom can only be in one partition. If the atom is already constrained,
+     * its partition id will be updated.
      */
-    if (got == constrained_atoms.end()) {
-        constrained_atoms.insert({blk_id, part_id});
-    } else {
-        got->second = part_id;
+    if (size_t(blk_id) >= constrained_atoms.size()) {
+        constrained_atoms.resize(size_t(blk_id) + 1, PartitionId::INVALID());
     }
+    constrained_atoms[blk_id] = part_id;
+    part_atoms_dirty = true;
 }
 
 PartitionId VprConstraints::get_atom_partition(AtomBlockId blk_id) {
-    PartitionId part_id;
-
-    auto got = constrained_atoms.find(blk_id);
-
-    if (got == constrained_atoms.end()) {
-        return part_id = PartitionId::INVALID(); ///< atom is not in a partition, i.e. unconstrained
-    } else {
-        return got->second;
+    if (size_t(blk_id) >= constrained_atoms.size()) {
+        return PartitionId::INVALID(); ///< atom is not in a partition, i.e. unconstrained
     }
+    return constrained_atoms[blk_id];
 }
 
 void VprConstraints::add_partition(Partition part) {
     partitions.push_back(part);
+    part_atoms_dirty = true;
+    pair_intersections.clear();
 }
 
 Partition VprConstraints::get_partition(PartitionId part_id) {
     return partitions[part_id];
 }
 
-std::vector<AtomBlockId> VprConstraints::get_part_atoms(PartitionId part_id) {
-    std::vector<AtomBlockId> part_atoms;
-
-    for (auto& it : constrained_atoms) {
-        if (it.second == part_id) {
-            part_atoms.push_back(it.first);
+const std::vector<AtomBlockId>& VprConstraints::get_part_atoms(PartitionId part_id) {
+    if (part_atoms_dirty) {
+        part_atoms.clear();
+        part_atoms.resize(partitions.size());
+        for (size_t iblk = 0; iblk < constrained_atoms.size(); iblk++) {
+            PartitionId atom_part = constrained_atoms[AtomBlockId(iblk)];
+            if (!atom_part) continue;
+
+            //Atoms may be constrained to partitions before they are added
+            if (size_t(atom_part) >= part_atoms.size()) {
+                part_atoms.resize(size_t(atom_part) + 1);
+            }
+            part_atoms[atom_part].push_back(AtomBlockId(iblk));
         }
+        part_atoms_dirty = false;
     }
 
-    return part_atoms;
+    if (size_t(part_id) >= part_atoms.size()) {
+        part_atoms.resize(size_t(part_id) + 1);
+    }
+    return part_atoms[part_id];
 }
 
 int VprConstraints::get_num_partitions() {
     return partitions.size();
 }
 
-PartitionRegion VprConstraints::get_partition_pr(PartitionId part_id) {
-    PartitionRegion pr;
-    pr = partitions[part_id].get_part_region();
-    return pr;
+const PartitionRegion& VprConstraints::get_partition_pr(PartitionId part_id) {
+    return partitions[part_id].get_part_region();
+}
+
+const PartitionRegion& VprConstraints::get_partition_pair_intersection(PartitionId part_a, PartitionId part_b) {
+    if (size_t(part_b) < size_t(part_a)) {
+        std::swap(part_a, part_b);
+    }
+    size_t key = size_t(part_a) * partitions.size() + size_t(part_b);
+
+    auto it = pair_intersections.find(key);
+    if (it == pair_intersections.end()) {
+        PartitionRegion pr = intersection(partitions[part_a].get_part_region(), partitions[part_b].get_part_region());
+        it = pair_intersections.insert(std::make_pair(key, std::move(pr))).first;
+    }
+    return it->second;
+}
+
+void VprConstraints::set_partition_pr(PartitionId part_id, PartitionRegion pr) {
+    partitions[part_id].set_part_region(pr);
+    pair_intersections.clear();
 }
 
 void print_constraints(FILE* fp, VprConstraints constraints) {
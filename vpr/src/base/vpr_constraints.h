@@ -1,6 +1,8 @@
 #ifndef VPR_CONSTRAINTS_H
 #define VPR_CONSTRAINTS_H
 
+#include <unordered_map>
+
 #include "vtr_vector.h"
 #include "vpr_utils.h"
 #include "partition.h"
@@ -69,11 +71,14 @@ class VprConstraints {
     Partition get_partition(PartitionId part_id);
 
     /**
-     * @brief Return all the atoms that belong to a partition
+     * @brief Return all the atoms that belong to a partition, in increasing id order
+     *
+     * The atoms of all the partitions are grouped together on the first call after
+     * the constrained atoms change.
      *
      *   @param part_id   The id of the partition whose atoms are needed
      */
-    std::vector<AtomBlockId> get_part_atoms(PartitionId part_id);
+    const std::vector<AtomBlockId>& get_part_atoms(PartitionId part_id);
 
     /**
      * @brief Returns the number of partitions in the object
@@ -85,18 +90,51 @@ class VprConstraints {
      *
      *   @param part_id The id of the partition whose PartitionRegion is needed
      */
-    PartitionRegion get_partition_pr(PartitionId part_id);
+    const PartitionRegion& get_partition_pr(PartitionId part_id);
+
+    /**
+     * @brief Returns the intersection of the PartitionRegions of two partitions
+     *
+     * The intersections are computed once and cached (until a partition or PartitionRegion is
+     * set again, which invalidates the references returned), since the packer intersects the
+     * same pairs of partitions over and over.
+     *
+     *   @param part_a  The id of one of the partitions
+     *   @param part_b  The id of the other partition
+     */
+    const PartitionRegion& get_partition_pair_intersection(PartitionId part_a, PartitionId part_b);
+
+    /**
+     * @brief Sets the PartitionRegion of the specified Partition
+     *
+     *   @param part_id The id of the partition whose PartitionRegion is set
+     *   @param pr      The new PartitionRegion of the partition
+     */
+    void set_partition_pr(PartitionId part_id, PartitionRegion pr);
 
   private:
     /**
-     * Store all constrained atoms
+     * Store the partition of each atom (PartitionId::INVALID() for unconstrained atoms),
+     * sized to the largest constrained atom id
      */
-    std::unordered_map<AtomBlockId, PartitionId> constrained_atoms;
+    vtr::vector<AtomBlockId, PartitionId> constrained_atoms;
 
     /**
      * Store all partitions
      */
     vtr::vector<PartitionId, Partition> partitions;
+
+    /**
+     * The atoms of each partition, valid unless part_atoms_dirty
+     */
+    vtr::vector<PartitionId, std::vector<AtomBlockId>> part_atoms;
+    bool part_atoms_dirty = false;
+
+    /**
+     * The cached intersections of pairs of partitions, keyed by the smallest partition id
+     * times the number of partitions plus the other one
+     */
+    std::unordered_map<size_t, PartitionRegion> pair_intersections;
 };
 
 ///@brief used to print floorplanning constraints data from a VprConstraints object
@@ -117,10 +117,6 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
 
     virtual inline void set_add_atom_name_pattern(const char* name_pattern, void*& /*ctx*/) final {
         auto& atom_ctx = g_vpr_ctx.atom();
-        std::string atom_name = name_pattern;
-
-        auto atom_name_regex = std::regex(atom_name);
-
         atoms_.clear();
 
         atom_id_ = atom_ctx.nlist.find_block(name_pattern);
@@ -135,10 +131,13 @@ class VprConstraintsSerializer final : public uxsd::VprConstraintsBase<VprConstr
             atoms_.push_back(atom_id_);
         } else {
             /*If the atom name returns an invalid ID, it might be a regular expression, so loop through the atoms blocks
-             * and see if any block names match atom_name_regex.
+             * and see if any block names match atom_name_regex. (The regex is only compiled here,
+             * since constraints files listing every atom by name would spend most of their
+             * reading time compiling regexes.)
              */
+            auto atom_name_regex = std::regex(name_pattern);
             for (auto block_id : atom_ctx.nlist.blocks()) {
-                auto block_name = atom_ctx.nlist.block_name(block_id);
+                const std::string& block_name = atom_ctx.nlist.block_name(block_id);
 
                 if (std::regex_search(block_name, atom_name_regex)) {
                     atoms_.push_back(block_id);
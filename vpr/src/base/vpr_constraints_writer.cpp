@@ -29,6 +29,14 @@ void write_vpr_floorplan_constraints(const char* file_name, int expand, bool sub
         setup_vpr_floorplan_constraints_one_loc(constraints, expand, subtile);
     }
 
+    //Constraints files use full device coordinates when the device grid is cropped
+    const t_grid_crop& crop = g_vpr_ctx.device().grid_crop;
+    for (int ipart = 0; ipart < constraints.get_num_partitions(); ++ipart) {
+        PartitionRegion pr = constraints.get_partition_pr(PartitionId(ipart));
+        shift_partition_region(pr, crop.x_offset, crop.y_offset);
+        constraints.set_partition_pr(PartitionId(ipart), pr);
+    }
+
     VprConstraintsSerializer writer(constraints);
 
     if (vtr::check_file_name_extension(file_name, ".xml")) {
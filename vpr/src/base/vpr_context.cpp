@@ -0,0 +1,82 @@
+#include "vpr_context.h"
+
+#include "vtr_log.h"
+#include "vtr_memory_usage.h"
+#include "vtr_rusage.h"
+
+constexpr float BYTES_PER_MIB = 1024 * 1024;
+
+size_t t_context_memory_usage::total() const {
+    size_t bytes = 0;
+    for (const auto& item : data) {
+        bytes += item.second;
+    }
+    return bytes;
+}
+
+t_context_memory_usage AtomContext::memory_usage() const {
+    size_t molecule_bytes = vtr::memory_usage(atom_molecules);
+    for (const t_pack_molecule* molecule = list_of_pack_molecules.get(); molecule != nullptr; molecule = molecule->next) {
+        molecule_bytes += sizeof(t_pack_molecule) + vtr::memory_usage(molecule->atom_block_ids);
+    }
+
+    return {{{"atom netlist", nlist.memory_usage()},
+             {"pack molecules", molecule_bytes}}};
+}
+
+t_context_memory_usage DeviceContext::memory_usage() const {
+    return {{{"device grid", grid.grid_size() * sizeof(t_grid_tile)},
+             {"rr graph nodes and edges", rr_graph_builder.storage_memory_usage()},
+             {"rr graph node look-up", rr_graph_builder.node_lookup_memory_usage()},
+             {"rr graph other data", vtr::memory_usage(rr_indexed_data, rr_rc_data, rr_non_config_node_sets,
+                                                       switch_fanin_remap)}}};
+}
+
+t_context_memory_usage ClusteringContext::memory_usage() const {
+    return {{{"clustered netlist", clb_nlist.memory_usage()},
+             {"cluster pin nets", vtr::memory_usage(post_routing_clb_pin_nets, pre_routing_net_pin_mapping)}}};
+}
+
+t_context_memory_usage PlacementContext::memory_usage() const {
+    return {{{"block locations", vtr::memory_usage(block_locs, physical_pins)},
+             {"grid blocks", grid_blocks.memory_usage()}}};
+}
+
+t_context_memory_usage RoutingContext::memory_usage() const {
+    const RouterLookahead* router_lookahead = cached_router_lookahead_.get(router_lookahead_cache_key_);
+
+    return {{{"route trees", vtr::memory_usage(route_trees, trace_nodes)},
+             {"rr node route info", rr_node_route_inf.memory_usage() + chan_occupancy.memory_usage()},
+             {"net terminals", vtr::memory_usage(net_rr_terminals, is_clock_net, rr_blk_source, net_terminal_groups,
+                                                 net_terminal_group_num, non_configurable_bitset, route_bb)},
+             {"router lookahead", router_lookahead ? router_lookahead->memory_usage() : 0}}};
+}
+
+void VprContext::print_memory_usage(const std::string& stage) const {
+    const std::pair<const char*, t_context_memory_usage> contexts[] = {
+        {"Atom", atom_.memory_usage()},
+        {"Device", device_.memory_usage()},
+        {"Clustering", clustering_.memory_usage()},
+        {"Placement", placement_.memory_usage()},
+        {"Routing", routing_.memory_usage()},
+    };
+
+    VTR_LOG("\n");
+    VTR_LOG("Memory usage after %s (estimated, MiB):\n", stage.c_str());
+    VTR_LOG("  %-12s %-26s %10s\n", "Context", "Data structure", "MiB");
+
+    size_t total_bytes = 0;
+    for (const auto& context : contexts) {
+        for (const auto& item : context.second.data) {
+            if (item.second == 0) {
+                continue;
+            }
+            VTR_LOG("  %-12s %-26s %10.1f\n", context.first, item.first.c_str(), item.second / BYTES_PER_MIB);
+        }
+        total_bytes += context.second.total();
+    }
+
+    VTR_LOG("  %-12s %-26s %10.1f\n", "Total", "", total_bytes / BYTES_PER_MIB);
+    VTR_LOG("  %-12s %-26s %10.1f\n", "Peak RSS", "", vtr::get_max_rss() / BYTES_PER_MIB);
+    VTR_LOG("\n");
+}
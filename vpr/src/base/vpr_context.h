@@ -32,6 +32,7 @@
 #include "noc_storage.h"
 #include "noc_traffic_flows.h"
 #include "noc_routing.h"
+#include "pack_profile.h"
 
 /**
  * @brief A Context is collection of state relating to a particular part of VPR
@@ -50,6 +51,20 @@ struct Context {
     virtual ~Context() = default;
 };
 
+/**
+ * @brief The (estimated) heap memory used by the major data structures of a context
+ *
+ * Reported by the memory_usage() of the contexts which hold large data structures, and summarized
+ * for all of them by VprContext::print_memory_usage().
+ */
+struct t_context_memory_usage {
+    ///@brief (name, bytes) of each data structure
+    std::vector<std::pair<std::string, size_t>> data;
+
+    ///@brief Returns the total bytes of the data structures
+    size_t total() const;
+};
+
 /**
  * @brief State relating to the atom-level netlist
  *
@@ -88,6 +103,9 @@ struct AtomContext : public Context {
      * Is is useful in freeing the pack molecules at the destructor of the Atom context using free_pack_molecules.
      */
     std::unique_ptr<t_pack_molecule, decltype(&free_pack_molecules)> list_of_pack_molecules;
+
+    ///@brief Returns the (estimated) heap memory used by the major data structures of this context
+    t_context_memory_usage memory_usage() const;
 };
 
 /**
@@ -149,6 +167,10 @@ struct DeviceContext : public Context {
      * This represents the physical layout of the device. To get the physical tile at each location (layer_num, x, y) the helper functions in this data structure should be used.
      */
     DeviceGrid grid;
+
+    ///@brief Location of grid within the full device (see --crop_device_to_floorplan)
+    t_grid_crop grid_crop;
+
     /*
      * Empty types
      */
@@ -194,11 +216,8 @@ struct DeviceContext : public Context {
     ///@brief Fly-weighted Resistance/Capacitance data for RR Nodes
     std::vector<t_rr_rc_data> rr_rc_data;
 
-    ///@brief Sets of non-configurably connected nodes
-    std::vector<std::vector<RRNodeId>> rr_non_config_node_sets;
-
-    ///@brief Reverse look-up from RR node to non-configurably connected node set (index into rr_non_config_node_sets)
-    std::unordered_map<RRNodeId, int> rr_node_to_non_config_node_set;
+    ///@brief Sets of non-configurably connected nodes, and the set of each RR node
+    t_rr_non_config_node_sets rr_non_config_node_sets;
 
     /* A writeable view of routing resource graph to be the ONLY database
      * for routing resource graph builder functions.
@@ -263,6 +282,9 @@ struct DeviceContext : public Context {
      * Place Related
      *******************************************************************/
     enum e_pad_loc_type pad_loc_type;
+
+    ///@brief Returns the (estimated) heap memory used by the major data structures of this context
+    t_context_memory_usage memory_usage() const;
 };
 
 /**
@@ -310,6 +332,9 @@ struct ClusteringContext : public Context {
      */
     std::map<ClusterBlockId, std::map<int, ClusterNetId>> post_routing_clb_pin_nets;
     std::map<ClusterBlockId, std::map<int, int>> pre_routing_net_pin_mapping;
+
+    ///@brief Returns the (estimated) heap memory used by the major data structures of this context
+    t_context_memory_usage memory_usage() const;
 };
 
 /**
@@ -347,6 +372,10 @@ struct ClusteringHelperContext : public Context {
     // A vector of unordered_sets of AtomBlockIds that are inside each clustered block [0 .. num_clustered_blocks-1]
     // unordered_set for faster insertion/deletion during the iterative improvement process of packing
     vtr::vector<ClusterBlockId, std::unordered_set<AtomBlockId>> atoms_lookup;
+
+    // Per phase wall time and call counts of packing (--write_pack_profile)
+    PackProfile pack_profile;
+
     ~ClusteringHelperContext() {
         delete[] primitives_list;
     }
@@ -358,7 +387,9 @@ struct ClusteringHelperContext : public Context {
  * This contain data structures to synchronize multithreading of packing iterative improvement.
  */
 struct PackingMultithreadingContext : public Context {
-    vtr::vector<ClusterBlockId, bool> clb_in_flight;
+    ///@brief Whether a worker currently owns each cluster. A char rather than a bool, since std::vector<bool> packs neighbouring clusters' flags into one word
+    vtr::vector<ClusterBlockId, char> clb_in_flight;
+    ///@brief Guards the clb_in_flight flag of each cluster
     vtr::vector<ClusterBlockId, std::mutex> mu;
 };
 
@@ -396,6 +427,9 @@ struct PlacementContext : public Context {
      * Used for unique identification and consistency checking
      */
     std::string placement_id;
+
+    ///@brief Returns the (estimated) heap memory used by the major data structures of this context
+    t_context_memory_usage memory_usage() const;
 };
 
 /**
@@ -416,7 +450,10 @@ struct RoutingContext : public Context {
 
     vtr::vector<ParentBlockId, std::vector<RRNodeId>> rr_blk_source; /* [0..num_blocks-1][0..num_class-1] */
 
-    vtr::vector<RRNodeId, t_rr_node_route_inf> rr_node_route_inf; /* [0..device_ctx.num_rr_nodes-1] */
+    t_rr_node_route_inf_storage rr_node_route_inf; /* [0..device_ctx.num_rr_nodes-1] */
+
+    ///@brief Total occupancy of the routing wires at each channel location, kept in sync with rr_node_route_inf
+    t_chan_occupancy chan_occupancy;
 
     vtr::vector<ParentNetId, std::vector<std::vector<int>>> net_terminal_groups;
 
@@ -439,6 +476,9 @@ struct RoutingContext : public Context {
     ///@brief Limits area within which each net must be routed.
     vtr::vector<ParentNetId, t_bb> route_bb; /* [0..cluster_ctx.clb_nlist.nets().size()-1]*/
 
+    ///@brief Global routing corridor of each connection (see global_route.h), used by the first routing iteration only.
+    vtr::vector<ParentNetId, std::vector<t_bb>> connection_route_bb; /* [0..cluster_ctx.clb_nlist.nets().size()-1][1..num_sinks] */
+
     t_clb_opins_used clb_opins_used_locally; //[0..cluster_ctx.clb_nlist.blocks().size()-1][0..num_class-1]
 
     /**
@@ -449,16 +489,26 @@ struct RoutingContext : public Context {
     std::string routing_id;
 
     // Cache key used to create router lookahead
-    std::tuple<e_router_lookahead, std::string, std::vector<t_segment_inf>> router_lookahead_cache_key_;
+    std::tuple<e_router_lookahead, std::string, std::vector<t_segment_inf>, bool> router_lookahead_cache_key_;
 
     /**
      * @brief Cache of router lookahead object.
      *
-     * Cache key: (lookahead type, read lookahead (if any), segment definitions).
+     * Cache key: (lookahead type, read lookahead (if any), segment definitions, half precision storage).
      */
-    vtr::Cache<std::tuple<e_router_lookahead, std::string, std::vector<t_segment_inf>>,
+    vtr::Cache<std::tuple<e_router_lookahead, std::string, std::vector<t_segment_inf>, bool>,
                RouterLookahead>
         cached_router_lookahead_;
+
+    /**
+     * @brief While set, invalidate_router_lookahead_cache() keeps the cached lookahead
+     *
+     * See set_router_lookahead_cache_pinned().
+     */
+    bool router_lookahead_cache_pinned_ = false;
+
+    ///@brief Returns the (estimated) heap memory used by the major data structures of this context
+    t_context_memory_usage memory_usage() const;
 };
 
 /**
@@ -489,6 +539,15 @@ struct FloorplanningContext : public Context {
      */
     vtr::vector<ClusterBlockId, PartitionRegion> cluster_constraints;
 
+    /**
+     * @brief The partitions whose PartitionRegions were intersected into each cluster's constraints
+     *
+     * Only maintained during clustering. When it is not empty, the PartitionRegion of a cluster is
+     * the intersection of the PartitionRegions of these partitions, so atoms of these partitions
+     * can be added to the cluster without intersecting its PartitionRegion again.
+     */
+    vtr::vector<ClusterBlockId, std::vector<PartitionId>> cluster_partitions;
+
     std::vector<Region> overfull_regions;
 };
 
@@ -615,6 +674,13 @@ class VprContext : public Context {
     const PackingMultithreadingContext& packing_multithreading() const { return packing_multithreading_; }
     PackingMultithreadingContext& mutable_packing_multithreading() { return packing_multithreading_; }
 
+    /**
+     * @brief Logs a table of the memory used by the major data structures of each context, and the peak RSS
+     *
+     * @param stage The flow stage which just finished (e.g. "packing")
+     */
+    void print_memory_usage(const std::string& stage) const;
+
   private:
     DeviceContext device_;
 
@@ -0,0 +1,179 @@
+#include "vpr_fork_jobs.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__)
+#    include <sys/types.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
+
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_util.h"
+
+#include "globals.h"
+#include "read_options.h"
+#include "router_lookahead.h"
+#include "SetupVPR.h"
+#include "vpr_error.h"
+#include "vpr_exit_codes.h"
+#include "vpr_server.h"
+
+static std::vector<std::vector<std::string>> read_fork_jobs(const std::string& filename);
+static void setup_fork_job(t_vpr_setup& vpr_setup, const t_options& options, std::vector<std::string> job_args, size_t job);
+
+template<typename T>
+static void check_job_unchanged(const argparse::ArgValue<T>& job_value, const argparse::ArgValue<T>& value, size_t job) {
+    if (job_value.value() != value.value()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Fork job %zu can not change %s: the netlist and device are shared by all the jobs\n",
+                        job, value.argument_name().c_str());
+    }
+}
+
+bool vpr_fork_jobs(t_vpr_setup& vpr_setup, bool& jobs_succeeded) {
+#if defined(__unix__)
+    vtr::ScopedStartFinishTimer timer("Fork jobs");
+
+    std::vector<std::vector<std::string>> jobs = read_fork_jobs(vpr_setup.FileNameOpts.fork_jobs_file);
+    if (jobs.empty()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "No jobs found in fork job file '%s'\n", vpr_setup.FileNameOpts.fork_jobs_file.c_str());
+    }
+
+    //The jobs' options are the command line's with their changes
+    if (vpr_setup.command_line.empty()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "--fork_jobs requires VPR to be initialized from a command line (vpr_init())\n");
+    }
+    std::vector<const char*> argv = {"vpr"};
+    for (const std::string& arg : vpr_setup.command_line) {
+        argv.push_back(arg.c_str());
+    }
+    const t_options options = read_options_throw(argv.size(), argv.data());
+
+    if (vpr_setup.num_workers != 1) {
+        VTR_LOG_WARN("Worker threads do not survive forking, --fork_jobs should be used with --num_workers 1\n");
+    }
+
+    //Computed before forking, so all the jobs share the parent's copy
+    if (!g_vpr_ctx.device().rr_graph.empty()) {
+        get_cached_router_lookahead(vpr_setup.RoutingArch,
+                                    vpr_setup.RouterOpts.lookahead_type,
+                                    vpr_setup.RouterOpts.write_router_lookahead,
+                                    vpr_setup.RouterOpts.read_router_lookahead,
+                                    vpr_setup.Segments,
+                                    vpr_setup.RouterOpts.lookahead_half_precision,
+                                    /*is_flat=*/false);
+    } else {
+        VTR_LOG_WARN("Without a fixed channel width (--route_chan_width) each fork job builds its own routing resource graph\n");
+    }
+
+    //Unwritten output would otherwise be written again by every child
+    std::fflush(nullptr);
+
+    std::vector<pid_t> pids(jobs.size(), -1);
+    for (size_t ijob = 0; ijob < jobs.size(); ++ijob) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            setup_fork_job(vpr_setup, options, jobs[ijob], ijob + 1);
+            return true;
+        } else if (pid < 0) {
+            VTR_LOG_ERROR("Failed to fork job %zu: %s\n", ijob + 1, std::strerror(errno));
+        } else {
+            pids[ijob] = pid;
+        }
+    }
+
+    std::vector<int> exit_codes(jobs.size(), ERROR_EXIT_CODE);
+    for (size_t ijob = 0; ijob < jobs.size(); ++ijob) {
+        int status = 0;
+        if (pids[ijob] > 0 && waitpid(pids[ijob], &status, 0) == pids[ijob] && WIFEXITED(status)) {
+            exit_codes[ijob] = WEXITSTATUS(status);
+        }
+    }
+
+    VTR_LOG("\n");
+    VTR_LOG("Fork job results:\n");
+    VTR_LOG("  %4s %9s  %s\n", "Job", "Exit code", "Options");
+    jobs_succeeded = true;
+    for (size_t ijob = 0; ijob < jobs.size(); ++ijob) {
+        VTR_LOG("  %4zu %9d  %s\n", ijob + 1, exit_codes[ijob], vtr::join(jobs[ijob], " ").c_str());
+        if (exit_codes[ijob] != SUCCESS_EXIT_CODE) {
+            jobs_succeeded = false;
+        }
+    }
+    VTR_LOG("\n");
+
+    return false;
+#else
+    (void)vpr_setup;
+    (void)jobs_succeeded;
+    VPR_FATAL_ERROR(VPR_ERROR_OTHER, "--fork_jobs is only supported on Unix\n");
+#endif
+}
+
+///@brief Returns the arguments of each job in the fork job file
+static std::vector<std::vector<std::string>> read_fork_jobs(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER, "Failed to open fork job file '%s'\n", filename.c_str());
+    }
+
+    std::vector<std::vector<std::string>> jobs;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> job_args = split_job_line(line);
+        if (job_args.empty() || job_args[0][0] == '#') {
+            continue;
+        }
+        jobs.push_back(job_args);
+    }
+    return jobs;
+}
+
+///@brief Sets up the child process of job (numbered from 1) to run the rest of the flow with options changed by job_args
+static void setup_fork_job(t_vpr_setup& vpr_setup, const t_options& options, std::vector<std::string> job_args, size_t job) {
+    //Unless the job says otherwise, its output files are named after it
+    if (std::find(job_args.begin(), job_args.end(), "--outfile_prefix") == job_args.end()) {
+        job_args.push_back("--outfile_prefix");
+        job_args.push_back(options.out_file_prefix.value() + "job" + std::to_string(job) + "_");
+    }
+
+    t_options job_options = read_options_with_overrides(vpr_setup.command_line, job_args);
+
+    //The jobs run concurrently, so each only logs to its own file
+    vtr::set_log_file((job_options.out_file_prefix.value() + "vpr_stdout.log").c_str());
+    if (!std::freopen("/dev/null", "w", stdout)) {
+        VTR_LOG_WARN("Failed to silence the standard output of fork job %zu\n", job);
+    }
+
+    VTR_LOG("Fork job %zu: %s\n", job, vtr::join(job_args, " ").c_str());
+
+    check_job_unchanged(job_options.ArchFile, options.ArchFile, job);
+    check_job_unchanged(job_options.CircuitName, options.CircuitName, job);
+    check_job_unchanged(job_options.CircuitFile, options.CircuitFile, job);
+    check_job_unchanged(job_options.device_layout, options.device_layout, job);
+    check_job_unchanged(job_options.read_rr_graph_file, options.read_rr_graph_file, job);
+    check_job_unchanged(job_options.PlaceChanWidth, options.PlaceChanWidth, job);
+    check_job_unchanged(job_options.RouteChanWidth, options.RouteChanWidth, job);
+
+    SetupVprJobOpts(job_options, &vpr_setup);
+    vpr_setup.FileNameOpts.fork_jobs_file.clear();
+
+    //Only the first job adds the artifacts it computes to the cache, so the jobs don't write the same files
+    if (job != 1) {
+        vpr_setup.FileNameOpts.cache_files_to_commit.clear();
+        vpr_setup.PlacerOpts.write_placement_delay_lookup.clear();
+        vpr_setup.RouterOpts.write_router_lookahead.clear();
+    }
+
+    //The parent writes the trace of its own timers
+    if (!job_options.write_timing_trace.value().empty()) {
+        vtr::start_timing_trace(job_options.out_file_prefix.value() + job_options.write_timing_trace.value());
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef VPR_FORK_JOBS_H
+#define VPR_FORK_JOBS_H
+
+/**
+ * @file
+ * @brief Fans the placement and routing of a packed circuit out to child processes (--fork_jobs)
+ *
+ * Once the device (and, with a fixed channel width, its routing resource graph and router lookahead) is built,
+ * a child process is forked per line of the job file. The children share the netlist and device data with the
+ * parent copy-on-write, so it is neither re-computed nor duplicated in memory by each job. Each line holds the
+ * options which replace those of the command line for its job, e.g.
+ *
+ *      --seed 2
+ *      --seed 3 --inner_num 2 --router_algorithm parallel
+ *
+ * Blank lines and lines starting with '#' are ignored. The architecture, circuit, device and channel width are
+ * shared by all the jobs, and options of the stages before placement have no effect. Job N writes its output
+ * files (and its log, instead of stdout) with the prefix 'job<N>_', unless it sets --outfile_prefix itself.
+ */
+
+#include "vpr_types.h"
+
+/**
+ * @brief Forks a child process per job of vpr_setup.FileNameOpts.fork_jobs_file
+ *
+ * In a child process, returns true with vpr_setup updated for its job: the caller continues the flow for the job.
+ * In the parent, waits for all the jobs, reports their results and returns false, with jobs_succeeded set to
+ * whether they all succeeded.
+ */
+bool vpr_fork_jobs(t_vpr_setup& vpr_setup, bool& jobs_succeeded);
+
+#endif
@@ -0,0 +1,229 @@
+#include "vpr_server.h"
+
+#include <cctype>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vtr_digest.h"
+#include "vtr_error.h"
+#include "vtr_log.h"
+
+#include "tatum/error.hpp"
+
+#include "globals.h"
+#include "vpr_api.h"
+#include "vpr_error.h"
+#include "vpr_exit_codes.h"
+#include "vpr_tatum_error.h"
+
+///@brief The switches chosen while building the rr graph, which a job re-using the rr graph must inherit
+struct t_resident_rr_graph_switches {
+    int wire_to_rr_ipin_switch;
+    int wire_to_rr_ipin_switch_between_dice;
+};
+
+static std::string resident_device_key(const t_options& options, int exit_code);
+static int run_job(const std::vector<std::string>* job_args,
+                   t_options& options,
+                   t_vpr_setup& vpr_setup,
+                   t_arch& arch,
+                   const t_resident_rr_graph_switches* resident_switches);
+
+int vpr_run_server(t_options& options, t_vpr_setup& vpr_setup, t_arch& arch, std::istream& jobs) {
+    int server_exit_code = SUCCESS_EXIT_CODE;
+
+    //The first job was initialized by the caller
+    size_t num_jobs = 1;
+    int exit_code = run_job(nullptr, options, vpr_setup, arch, nullptr);
+    std::string resident_key = resident_device_key(options, exit_code);
+
+    std::string line;
+    while (true) {
+        VTR_LOG("VPR server: job %zu finished with exit code %d\n", num_jobs, exit_code);
+        if (exit_code != SUCCESS_EXIT_CODE) {
+            server_exit_code = exit_code;
+        }
+        if (exit_code == INTERRUPTED_EXIT_CODE) {
+            break;
+        }
+
+        std::vector<std::string> job_args;
+        while (job_args.empty() && std::getline(jobs, line)) {
+            job_args = split_job_line(line);
+            if (!job_args.empty() && job_args[0][0] == '#') {
+                job_args.clear();
+            }
+        }
+        if (job_args.empty() || (job_args.size() == 1 && job_args[0] == "exit")) {
+            break;
+        }
+
+        ++num_jobs;
+        VTR_LOG("\n");
+        VTR_LOG("VPR server: starting job %zu\n", num_jobs);
+
+        //The next job's options decide what can be kept, so they are read before anything is freed
+        std::vector<const char*> argv = {"vpr"};
+        for (const std::string& arg : job_args) {
+            argv.push_back(arg.c_str());
+        }
+
+        t_options next_options;
+        std::string next_key;
+        try {
+            next_options = read_options_throw(argv.size(), argv.data());
+            next_key = resident_device_key(next_options, SUCCESS_EXIT_CODE);
+        } catch (const VprError& vpr_error) {
+            vpr_print_error(vpr_error);
+            exit_code = ERROR_EXIT_CODE;
+            continue; //Nothing was run, so the previous job's data is kept for the next job
+        } catch (const vtr::VtrError& vtr_error) {
+            VTR_LOG_ERROR("%s:%d %s\n", vtr_error.filename_c_str(), vtr_error.line(), vtr_error.what());
+            exit_code = ERROR_EXIT_CODE;
+            continue;
+        }
+
+        bool reuse_device = !resident_key.empty() && next_key == resident_key;
+        t_resident_rr_graph_switches resident_switches = {vpr_setup.RoutingArch.wire_to_rr_ipin_switch,
+                                                          vpr_setup.RoutingArch.wire_to_rr_ipin_switch_between_dice};
+        if (reuse_device) {
+            VTR_LOG("VPR server: re-using the device of the previous job\n");
+            vpr_free_all_but_rr_graph(arch, vpr_setup);
+        } else {
+            vpr_free_all(arch, vpr_setup);
+        }
+
+        //Reset in place: the router lookahead refers to vpr_setup's routing architecture
+        vpr_setup = t_vpr_setup();
+        arch = t_arch();
+        options = next_options;
+
+        exit_code = run_job(&job_args, options, vpr_setup, arch, reuse_device ? &resident_switches : nullptr);
+        resident_key = (exit_code == SUCCESS_EXIT_CODE || exit_code == UNIMPLEMENTABLE_EXIT_CODE) ? next_key : "";
+    }
+
+    vpr_free_all(arch, vpr_setup);
+
+    return server_exit_code;
+}
+
+std::vector<std::string> split_job_line(const std::string& line) {
+    std::vector<std::string> args;
+
+    std::string arg;
+    bool in_arg = false;
+    bool in_quotes = false;
+    for (char c : line) {
+        if (c == '"') {
+            in_quotes = !in_quotes;
+            in_arg = true;
+        } else if (!in_quotes && std::isspace(static_cast<unsigned char>(c))) {
+            if (in_arg) {
+                args.push_back(arg);
+                arg.clear();
+                in_arg = false;
+            }
+        } else {
+            arg += c;
+            in_arg = true;
+        }
+    }
+    if (in_arg) {
+        args.push_back(arg);
+    }
+
+    return args;
+}
+
+/**
+ * @brief Returns what must match between two jobs for the second to re-use the device of the first
+ *
+ * Empty if the device can not be re-used: it depends on the netlist (e.g. --device auto), or the job
+ * (with exit code exit_code) failed part way through and may have left it inconsistent.
+ */
+static std::string resident_device_key(const t_options& options, int exit_code) {
+    if ((exit_code != SUCCESS_EXIT_CODE && exit_code != UNIMPLEMENTABLE_EXIT_CODE)
+        || options.device_layout.value() == "auto"
+        || options.crop_device_to_floorplan
+        || options.flat_routing
+        || options.read_rr_edge_metadata
+        || !options.write_rr_graph_file.value().empty()) {
+        return "";
+    }
+
+    std::stringstream key;
+    key << "arch_file=" << options.ArchFile.value() << "\n";
+    key << "arch_digest=" << vtr::secure_digest_file(options.ArchFile.value()) << "\n";
+    key << "device=" << options.device_layout.value() << "\n";
+    key << "read_rr_graph=" << options.read_rr_graph_file.value() << "\n";
+    key << "route_type=" << static_cast<int>(options.RouteType.value()) << "\n";
+    key << "base_cost_type=" << static_cast<int>(options.base_cost_type.value()) << "\n";
+    key << "clock_modeling=" << static_cast<int>(options.clock_modeling.value()) << "\n";
+    key << "two_stage_clock_routing=" << options.two_stage_clock_routing.value() << "\n";
+    key << "reorder_rr_graph_nodes=" << static_cast<int>(options.reorder_rr_graph_nodes_algorithm.value())
+        << "," << options.reorder_rr_graph_nodes_threshold.value()
+        << "," << options.reorder_rr_graph_nodes_seed.value() << "\n";
+    key << "compress_rr_graph_edges=" << options.compress_rr_graph_edges.value() << "\n";
+    return key.str();
+}
+
+/**
+ * @brief Runs the flow of a job, returning the exit code VPR would have returned for it
+ *
+ * The job is first initialized from job_args/options, unless job_args is null. If resident_switches is not
+ * null, the rr graph left by the previous job is re-used (provided its channel widths match).
+ */
+static int run_job(const std::vector<std::string>* job_args,
+                   t_options& options,
+                   t_vpr_setup& vpr_setup,
+                   t_arch& arch,
+                   const t_resident_rr_graph_switches* resident_switches) {
+    try {
+        if (job_args) {
+            std::vector<const char*> argv = {"vpr"};
+            for (const std::string& arg : *job_args) {
+                argv.push_back(arg.c_str());
+            }
+            vpr_print_args(argv.size(), argv.data());
+
+            vpr_init_with_options(&options, &vpr_setup, &arch);
+            vpr_setup.command_line = *job_args;
+        }
+
+        if (resident_switches) {
+            vpr_setup.reuse_rr_graph = true;
+            vpr_setup.RoutingArch.wire_to_rr_ipin_switch = resident_switches->wire_to_rr_ipin_switch;
+            vpr_setup.RoutingArch.wire_to_rr_ipin_switch_between_dice = resident_switches->wire_to_rr_ipin_switch_between_dice;
+        }
+
+        bool flow_succeeded = vpr_flow(vpr_setup, arch);
+        if (!flow_succeeded) {
+            VTR_LOG("VPR failed to implement circuit\n");
+            return UNIMPLEMENTABLE_EXIT_CODE;
+        }
+
+        auto& timing_ctx = g_vpr_ctx.timing();
+        print_timing_stats("Flow", timing_ctx.stats);
+
+        VTR_LOG("VPR succeeded\n");
+
+    } catch (const tatum::Error& tatum_error) {
+        VTR_LOG_ERROR("%s\n", format_tatum_error(tatum_error).c_str());
+        return ERROR_EXIT_CODE;
+
+    } catch (const VprError& vpr_error) {
+        vpr_print_error(vpr_error);
+        if (vpr_error.type() == VPR_ERROR_INTERRUPTED) {
+            return INTERRUPTED_EXIT_CODE;
+        } else {
+            return ERROR_EXIT_CODE;
+        }
+
+    } catch (const vtr::VtrError& vtr_error) {
+        VTR_LOG_ERROR("%s:%d %s\n", vtr_error.filename_c_str(), vtr_error.line(), vtr_error.what());
+        return ERROR_EXIT_CODE;
+    }
+
+    return SUCCESS_EXIT_CODE;
+}
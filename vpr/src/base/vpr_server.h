@@ -0,0 +1,44 @@
+#ifndef VPR_SERVER_H
+#define VPR_SERVER_H
+
+/**
+ * @file
+ * @brief A long running VPR (--server on) which implements a sequence of jobs
+ *
+ * Once the job given on the command line is done, further jobs are read from an input stream: one VPR
+ * command line per line (without the program name), e.g.
+ *
+ *      k6_frac_N10_mem32K_40nm.xml seed_sweep.blif --device vpr_fixed_layout --route_chan_width 100 --seed 2
+ *
+ * Blank lines and lines starting with '#' are ignored, and a line holding 'exit' (or the end of the
+ * input) stops the server. Arguments are separated by whitespace; double quotes group an argument
+ * containing whitespace.
+ *
+ * Between jobs only the netlist dependent data is freed when the next job targets the same device:
+ * the same (unchanged) architecture file, a fixed --device and the same routing options. The routing
+ * resource graph and the router lookahead of the previous job are then re-used (provided the channel
+ * widths also match), instead of being re-built. Otherwise everything is freed, as at the end of a
+ * normal VPR run.
+ */
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "physical_types.h"
+#include "read_options.h"
+#include "vpr_types.h"
+
+/**
+ * @brief Runs the job already initialized (by vpr_init()) in options/vpr_setup/arch, then the jobs read from jobs
+ *
+ * Each job is reported as finished with the exit code VPR would have returned for it. Everything is freed on return.
+ *
+ *   @return SUCCESS_EXIT_CODE if all the jobs succeeded, otherwise the exit code of the last job which did not
+ */
+int vpr_run_server(t_options& options, t_vpr_setup& vpr_setup, t_arch& arch, std::istream& jobs);
+
+///@brief Splits a job line into its whitespace separated arguments, where double quotes group an argument
+std::vector<std::string> split_job_line(const std::string& line);
+
+#endif
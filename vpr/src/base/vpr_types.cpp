@@ -237,6 +237,40 @@ void free_cluster_placement_stats(t_cluster_placement_stats* cluster_placement_s
     delete[] cluster_placement_stats_list;
 }
 
+void t_rr_non_config_node_sets::init(size_t num_nodes, const std::vector<std::vector<RRNodeId>>& sets) {
+    clear();
+
+    size_t num_set_nodes = 0;
+    for (const auto& set : sets) {
+        num_set_nodes += set.size();
+    }
+
+    set_first_node_.reserve(sets.size() + 1);
+    set_nodes_.reserve(num_set_nodes);
+    node_sets_.resize(num_nodes, OPEN);
+
+    set_first_node_.push_back(0);
+    for (size_t iset = 0; iset < sets.size(); ++iset) {
+        for (RRNodeId node : sets[iset]) {
+            VTR_ASSERT(size_t(node) < num_nodes);
+            VTR_ASSERT(node_sets_[node] == OPEN);
+            node_sets_[node] = iset;
+            set_nodes_.push_back(node);
+        }
+        set_first_node_.push_back(set_nodes_.size());
+    }
+}
+
+void t_rr_non_config_node_sets::clear() {
+    set_first_node_.clear();
+    set_nodes_.clear();
+    node_sets_.clear();
+}
+
+size_t t_rr_non_config_node_sets::memory_usage() const {
+    return vtr::memory_usage(set_first_node_, set_nodes_, node_sets_);
+}
+
 void t_cluster_placement_stats::move_inflight_to_tried() {
     tried.insert(*in_flight.begin());
     in_flight.clear();
@@ -320,4 +354,8 @@ void t_cluster_placement_stats::free_primitives() {
             delete primitive.second;
         }
     }
-}
\ No newline at end of file
+}
+uint32_t new_rr_node_route_search_epoch() {
+    static std::atomic<uint32_t> last_search_epoch(0);
+    return ++last_search_epoch;
+}
@@ -24,10 +24,13 @@
 #ifndef VPR_TYPES_H
 #define VPR_TYPES_H
 
+#include <atomic>
+#include <limits>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
+#include <type_traits>
 #include "arch_types.h"
 #include "atom_netlist_fwd.h"
 #include "clustered_netlist_fwd.h"
@@ -36,8 +39,11 @@
 #include "heap_type.h"
 
 #include "vtr_assert.h"
+#include "vtr_array_view.h"
 #include "vtr_ndmatrix.h"
 #include "vtr_vector.h"
+#include "vtr_memory.h"
+#include "vtr_memory_usage.h"
 #include "vtr_util.h"
 #include "vtr_flat_map.h"
 #include "vtr_cache.h"
@@ -430,6 +436,7 @@ class t_cluster_placement_stats {
     int num_pb_types;                     ///<num primitive pb_types inside complex block
     bool has_long_chain;                  ///<specifies if this cluster has a molecule placed in it that belongs to a long chain (a chain that spans more than one cluster)
     const t_pack_molecule* curr_molecule; ///<current molecule being considered for packing
+    const t_pb_graph_node* pb_graph_head; ///<root pb_graph_node of the complex block, whose implementable models give a quick rejection test
 
     // Vector of size num_pb_types [0.. num_pb_types-1]. Each element is an unordered_map of the cluster_placement_primitives that are of this pb_type
     // Each cluster_placement_primitive is associated with and index (key of the map) for easier lookup, insertion and deletion.
@@ -792,6 +799,11 @@ struct t_grid_blocks {
     inline bool subtile_empty(size_t isubtile) const {
         return blocks[isubtile] == EMPTY_BLOCK_ID;
     }
+
+    ///@brief Returns the heap memory used by the blocks of this location, in bytes
+    inline size_t memory_usage() const {
+        return vtr::memory_usage(blocks);
+    }
 };
 
 class GridBlock {
@@ -834,6 +846,11 @@ class GridBlock {
         grid_blocks_.clear();
     }
 
+    ///@brief Returns the (estimated) heap memory used by the grid, in bytes
+    inline size_t memory_usage() const {
+        return vtr::memory_usage(grid_blocks_);
+    }
+
   private:
     vtr::NdMatrix<t_grid_blocks, 3> grid_blocks_;
 };
@@ -855,6 +872,16 @@ struct t_file_name_opts {
     std::string write_vpr_constraints_file;
     std::string write_block_usage;
     bool verify_file_digests;
+
+    std::string cache_dir;                                                  ///<Directory of the --cache_dir cache (empty if disabled)
+    std::string flow_checkpoint_dir;                                        ///<Directory of the --resume_from flow checkpoints (empty if disabled)
+    std::vector<std::pair<std::string, std::string>> cache_files_to_commit; ///<Temporary files written for the cache, and the cache files they become once the flow finishes
+    std::string read_lb_type_rr_graphs_file;                                ///<Cached intra-cluster routing graphs to load instead of building them (empty if none)
+    std::string write_lb_type_rr_graphs_file;                               ///<File to save the intra-cluster routing graphs to (empty if none)
+    std::string read_atom_netlist_snapshot_file;                            ///<Cached cleaned atom netlist to load instead of reading the circuit (empty if none)
+    std::string write_atom_netlist_snapshot_file;                           ///<File to save the cleaned atom netlist to (empty if none)
+
+    std::string fork_jobs_file; ///<File of the jobs to fork once the device is built (empty if none)
 };
 
 ///@brief Options for netlist loading
@@ -867,6 +894,8 @@ struct t_netlist_opts {
     bool sweep_constant_primary_outputs = false;
 
     int netlist_verbosity = 1; ///<Verbose output during netlist cleaning
+
+    bool parallel_blif_parse = false; ///<Read BLIF/EBLIF circuits with ParallelBlifParser
 };
 
 ///@brief Should a stage in the CAD flow be skipped, loaded from a file, or performed
@@ -917,6 +946,8 @@ struct t_packer_opts {
     bool use_attraction_groups;
     int pack_num_moves;
     std::string pack_move_type;
+    int timing_update_interval; ///<Number of clusters formed between timing analysis updates during timing driven clustering (0 disables them)
+    std::string write_pack_profile; ///<File to write the per phase packing profile to (empty if not profiling)
 };
 
 /**
@@ -945,6 +976,17 @@ struct t_annealing_sched {
     float alpha_decay;
     float success_min;
     float success_target;
+
+    /* Runtime-aware limits, used by all schedule types                   *
+     * Annealing stops (and the quench starts) once neither the bounding  *
+     * box nor the timing cost improved by more than `converge_tol`       *
+     * (relative) over `converge_temps` low success rate temperatures.    *
+     * With a `time_budget` (seconds, < 0 for none) the remaining         *
+     * temperatures are skipped faster, and the quench shortened, to      *
+     * finish the placement within the budget.                            */
+    float converge_tol;
+    int converge_temps;
+    float time_budget;
 };
 
 /******************************************************************
@@ -1155,18 +1197,21 @@ struct t_placer_opts {
     int recompute_crit_iter;
     int inner_loop_recompute_divider;
     int quench_recompute_divider;
+    int inner_loop_recompute_accepted_moves;
     float td_place_exp_first;
     int seed;
     float td_place_exp_last;
     e_stage_action doPlacement;
     float rlim_escape_fraction;
     std::string move_stats_file;
+    bool move_timing_stats; ///< Whether to time the proposal, evaluation and commit/revert of each move type
     int placement_saves_per_temperature;
     e_place_effort_scaling effort_scaling;
     e_timing_update_type timing_update_type;
 
     PlaceDelayModelType delay_model_type;
     e_reducer delay_model_reducer;
+    bool delay_model_half_precision; ///<Store the delay model tables in half precision
 
     float delay_offset;
     int delay_ramp_delta_threshold;
@@ -1186,9 +1231,15 @@ struct t_placer_opts {
     bool place_agent_multistate;
     bool place_checkpointing;
     int place_high_fanout_net;
+    int place_parallel_moves;           ///< Number of moves proposed and evaluated together by the annealer (1 = one at a time)
+    int place_num_starts;               ///< Number of independent anneals (with consecutive seeds) from which the best placement is kept
+    std::string place_incremental_file; ///< Previous placement to start an incremental (ECO) placement from; empty for a full placement
+    int place_incremental_radius;       ///< Neighbourhood (in tiles) of the changed blocks re-optimized by incremental placement
+    std::string place_snapshot_file;    ///< Binary placement snapshot written at every temperature, and resumed from if it exists; empty for none
     e_agent_algorithm place_agent_algorithm;
     float place_agent_epsilon;
     float place_agent_gamma;
+    int place_agent_prob_update_interval; ///< Moves proposed by a softmax agent between recomputations of its action probabilities
     float place_dm_rlim;
     e_agent_space place_agent_space;
     //int place_timing_cost_func;
@@ -1339,6 +1390,8 @@ struct t_router_opts {
     int fixed_channel_width;
     int min_channel_width_hint; ///<Hint to binary search of what the minimum channel width is
     enum e_router_algorithm router_algorithm;
+    bool deterministic_parallel_route; ///<Make the parallel router's results independent of thread count and scheduling
+    bool parallel_route_cutline_nets;  ///<Route the nets of each partition tree node in parallel batches of nets which can't share rr nodes
     enum e_base_cost_type base_cost_type;
     float astar_fac;
     float router_profiler_astar_fac;
@@ -1346,6 +1399,9 @@ struct t_router_opts {
     float criticality_exp;
     float init_wirelength_abort_threshold;
     bool verify_binary_search;
+    bool aggressive_binary_search_abort;
+    bool reuse_lookahead_across_chan_widths;
+    bool congestion_driven_net_order;
     bool full_stats;
     bool congestion_analysis;
     bool fanout_analysis;
@@ -1353,13 +1409,20 @@ struct t_router_opts {
     e_stage_action doRouting;
     enum e_routing_failure_predictor routing_failure_predictor;
     enum e_routing_budgets_algorithm routing_budgets_algorithm;
+    float routing_budgets_convergence_delta;
     bool save_routing_per_iteration;
+    std::string route_checkpoint_file; ///<Congestion state checkpointed at every routing iteration, and resumed from if it exists; empty for none
+    std::string route_warm_start_file; ///<Routing file of a previous run whose still legal net routing the router starts from; empty for none
     float congested_routing_iteration_threshold_frac;
     e_route_bb_update route_bb_update;
     enum e_clock_modeling clock_modeling; ///<How clock pins and nets should be handled
     bool two_stage_clock_routing;         ///<How clock nets on dedicated networks should be routed
+    bool batch_clock_routing;             ///<Route the sinks of global nets with a single search, rather than one per sink
+    bool global_route_corridors;          ///<Bound the first iteration's connections to the corridors of a coarse global routing
+    int global_route_corridor_margin;     ///<Tiles added around each global routing corridor
     int high_fanout_threshold;
     float high_fanout_max_slope;
+    int bidir_search_min_dist; ///<Minimum source-sink distance of connections routed with a bidirectional search. Negative disables it
     int router_debug_net;
     int router_debug_sink_rr;
     int router_debug_iteration;
@@ -1368,6 +1431,7 @@ struct t_router_opts {
     float reconvergence_cpd_threshold;
     e_router_initial_timing initial_timing;
     bool update_lower_bound_delays;
+    float skip_timing_update_criticality; ///<Skip the timing update of an iteration which only rerouted connections below this criticality
 
     std::string first_iteration_timing_report_file;
     bool strict_checks;
@@ -1378,6 +1442,13 @@ struct t_router_opts {
     std::string write_intra_cluster_router_lookahead;
     std::string read_intra_cluster_router_lookahead;
 
+    std::string write_router_connection_telemetry;
+    std::string write_router_connection_capture; ///<Capture the connection routing queries to this file (see router_connection_capture.h)
+    int router_connection_capture_limit;         ///<Maximum number of connections to capture
+    std::string write_router_lookahead_profile;
+    float router_lookahead_profile_correction;
+    bool lookahead_half_precision; ///<Store the lookahead tables in half precision
+
     e_heap_type router_heap;
     bool exit_after_first_routing_iteration;
 
@@ -1394,6 +1465,18 @@ struct t_router_opts {
     e_rr_node_reorder_algorithm reorder_rr_graph_nodes_algorithm = DONT_REORDER;
     int reorder_rr_graph_nodes_threshold = 0;
     int reorder_rr_graph_nodes_seed = 1;
+
+    // Store the edges of the built rr graph in compressed form (see t_rr_graph_storage::compress_edges)
+    bool compress_rr_graph_edges = false;
+
+    // Report the repeated node patterns of the rr graph (see get_rr_graph_pattern_stats)
+    bool report_rr_graph_patterns = false;
+};
+
+///@brief An additional delay corner of the final timing analysis (see --timing_corners)
+struct t_timing_corner {
+    std::string name;
+    float delay_scale; ///<Factor applied to all the delays (and setup/hold times) of the nominal corner
 };
 
 struct t_analysis_opts {
@@ -1409,6 +1492,7 @@ struct t_analysis_opts {
     bool timing_report_skew;
     std::string echo_dot_timing_graph_node;
     std::string write_timing_summary;
+    std::vector<t_timing_corner> timing_corners;
 
     e_timing_update_type timing_update_type;
 };
@@ -1464,6 +1548,9 @@ struct t_noc_opts {
  *   @param read_rr_graph_filename  File to read the RR graph from (overrides
  *             architecture)
  *   @param write_rr_graph_filename  File to write the RR graph to after generation
+ *   @param read_rr_graph_is_cached  True if read_rr_graph_filename is a --cache_dir
+ *             rr graph, which was checked when VPR generated it and is named after
+ *             the digest of its inputs, so it is not checked again when loaded
  */
 struct t_det_routing_arch {
     enum e_directionality directionality; /* UDSD by AY */
@@ -1482,6 +1569,7 @@ struct t_det_routing_arch {
 
     std::string read_rr_graph_filename;
     std::string write_rr_graph_filename;
+    bool read_rr_graph_is_cached = false;
 };
 
 /**
@@ -1635,6 +1723,13 @@ constexpr bool is_src_sink(e_rr_type type) { return (type == SOURCE || type == S
  * @brief Extra information about each rr_node needed only during routing
  *        (i.e. during the maze expansion).
  *
+ * This is stored as two separate arrays (see t_rr_node_route_inf_storage):
+ * the search lane, which the connection router reads and writes on every
+ * edge it expands, and the congestion lane, which only changes when a net
+ * is ripped up or committed and in the pathfinder cost update.
+ * t_rr_node_route_inf is a view which ties the two lanes of a single node
+ * back together, so it can be used as if it was a plain struct.
+ *
  *   @param prev_node  Index of the previous node (on the lowest cost path known
  *                     to reach this node); used to generate the traceback.
  *                     If there is no predecessor, prev_node = NO_PREVIOUS.
@@ -1650,25 +1745,230 @@ constexpr bool is_src_sink(e_rr_type type) { return (type == SOURCE || type == S
  *   @param target_flag  Is this node a target (sink) for the current routing?
  *                     Number of times this node must be reached to fully route.
  *   @param occ        The current occupancy of the associated rr node
+ *   @param search_epoch  The path search which last wrote prev_node, prev_edge,
+ *                     path_cost and backward_path_cost. For any other search they
+ *                     are stale and read as unset (see t_rr_node_route_inf_storage::search_inf()),
+ *                     so the router never has to reset them between searches.
  */
-struct t_rr_node_route_inf {
+struct t_rr_node_route_search_inf {
     RRNodeId prev_node;
     RREdgeId prev_edge;
 
-    float acc_cost;
     float path_cost;
     float backward_path_cost;
 
+    uint32_t search_epoch = 0;
+};
+
+/**
+ * @brief Returns a new path search epoch (see t_rr_node_route_search_inf::search_epoch)
+ *
+ * The epochs are unique across all threads, so concurrent routers never see each
+ * other's search data as their own. They start at 1, 0 marks never searched entries.
+ */
+uint32_t new_rr_node_route_search_epoch();
+
+///@brief Congestion lane of t_rr_node_route_inf. See above.
+struct t_rr_node_route_cong_inf {
+    float acc_cost;
     short target_flag;
+    short occ = 0;
+};
+
+/**
+ * @brief View of a single rr_node's routing information in t_rr_node_route_inf_storage.
+ *
+ * Exposes the same fields as if the search and congestion lanes were a single struct.
+ * Views are cheap to construct and should be passed around by value.
+ * The const flavour (t_const_rr_node_route_inf) is what a const storage hands out.
+ */
+template<bool is_const>
+class t_rr_node_route_inf_view {
+    template<typename T>
+    using ref = std::conditional_t<is_const, const T&, T&>;
+
+  public:
+    t_rr_node_route_inf_view(ref<t_rr_node_route_search_inf> search, ref<t_rr_node_route_cong_inf> cong)
+        : prev_node(search.prev_node)
+        , prev_edge(search.prev_edge)
+        , path_cost(search.path_cost)
+        , backward_path_cost(search.backward_path_cost)
+        , acc_cost(cong.acc_cost)
+        , target_flag(cong.target_flag)
+        , cong_(cong) {}
+
+    ///@brief A mutable view can be used wherever a const one is expected
+    template<bool other_is_const, typename = std::enable_if_t<is_const && !other_is_const>>
+    t_rr_node_route_inf_view(const t_rr_node_route_inf_view<other_is_const>& other)
+        : prev_node(other.prev_node)
+        , prev_edge(other.prev_edge)
+        , path_cost(other.path_cost)
+        , backward_path_cost(other.backward_path_cost)
+        , acc_cost(other.acc_cost)
+        , target_flag(other.target_flag)
+        , cong_(other.cong_) {}
+
+    ref<RRNodeId> prev_node;
+    ref<RREdgeId> prev_edge;
+
+    ref<float> path_cost;
+    ref<float> backward_path_cost;
+
+    ref<float> acc_cost;
+    ref<short> target_flag;
 
   public: //Accessors
-    short occ() const { return occ_; }
+    short occ() const { return cong_.occ; }
 
   public: //Mutators
-    void set_occ(int new_occ) { occ_ = new_occ; }
+    template<bool c = is_const, typename = std::enable_if_t<!c>>
+    void set_occ(int new_occ) { cong_.occ = new_occ; }
 
   private: //Data
-    short occ_ = 0;
+    friend class t_rr_node_route_inf_view<!is_const>;
+    ref<t_rr_node_route_cong_inf> cong_;
+};
+
+typedef t_rr_node_route_inf_view<false> t_rr_node_route_inf;
+typedef t_rr_node_route_inf_view<true> t_const_rr_node_route_inf;
+
+/**
+ * @brief Struct-of-arrays storage for t_rr_node_route_inf, indexed by RRNodeId.
+ *
+ * Provides the subset of the vtr::vector interface which the router needs, so that
+ * rr_node_route_inf[inode].path_cost etc. keep working. Code which sweeps over all nodes
+ * but only cares about one lane (e.g. the pathfinder cost update) can use the lanes directly.
+ */
+class t_rr_node_route_inf_storage {
+  public:
+    t_rr_node_route_inf operator[](RRNodeId inode) {
+        return t_rr_node_route_inf(search_[inode], cong_[inode]);
+    }
+    t_const_rr_node_route_inf operator[](RRNodeId inode) const {
+        return t_const_rr_node_route_inf(search_[inode], cong_[inode]);
+    }
+
+    /**
+     * @brief Returns the view of inode as seen by the path search search_epoch
+     *
+     * If the search data of inode was last written by another search, it is reset
+     * (to no previous node and infinite costs) and claimed by search_epoch first.
+     */
+    t_rr_node_route_inf search_inf(RRNodeId inode, uint32_t search_epoch) {
+        t_rr_node_route_search_inf& search = search_[inode];
+        if (search.search_epoch != search_epoch) {
+            search = unset_search_inf();
+            search.search_epoch = search_epoch;
+        }
+        return t_rr_node_route_inf(search, cong_[inode]);
+    }
+
+    ///@brief Returns the view of inode as seen by the path search search_epoch, without claiming it
+    t_const_rr_node_route_inf search_inf(RRNodeId inode, uint32_t search_epoch) const {
+        const t_rr_node_route_search_inf& search = search_[inode];
+        return t_const_rr_node_route_inf((search.search_epoch == search_epoch) ? search : unset_search_inf(), cong_[inode]);
+    }
+
+    size_t size() const { return search_.size(); }
+    bool empty() const { return search_.empty(); }
+
+    void resize(size_t num_nodes) {
+        search_.resize(num_nodes);
+        cong_.resize(num_nodes);
+    }
+    void clear() {
+        search_.clear();
+        cong_.clear();
+    }
+
+    ///@brief Returns the heap memory used by both lanes, in bytes
+    size_t memory_usage() const {
+        return vtr::memory_usage(search_, cong_);
+    }
+
+    //Both lanes are indexed randomly by the routers, so are backed by huge pages to limit TLB misses
+    typedef vtr::vector<RRNodeId, t_rr_node_route_search_inf, vtr::huge_page_allocator<t_rr_node_route_search_inf>> search_lane_t;
+    typedef vtr::vector<RRNodeId, t_rr_node_route_cong_inf, vtr::huge_page_allocator<t_rr_node_route_cong_inf>> cong_lane_t;
+
+    ///@brief Per-node data read and written by the path search
+    search_lane_t& search_lane() { return search_; }
+    const search_lane_t& search_lane() const { return search_; }
+
+    ///@brief Per-node pathfinder congestion state
+    cong_lane_t& cong_lane() { return cong_; }
+    const cong_lane_t& cong_lane() const { return cong_; }
+
+  private:
+    static const t_rr_node_route_search_inf& unset_search_inf() {
+        static const t_rr_node_route_search_inf unset = {RRNodeId::INVALID(),
+                                                         RREdgeId::INVALID(),
+                                                         std::numeric_limits<float>::infinity(),
+                                                         std::numeric_limits<float>::infinity(),
+                                                         0};
+        return unset;
+    }
+
+    search_lane_t search_;
+    cong_lane_t cong_;
+};
+
+/**
+ * @brief The total occupancy of the CHANX and CHANY nodes spanning each channel location
+ *
+ * The router keeps it up to date whenever it changes the occupancy of a routing wire (see
+ * pathfinder_update_single_node_occupancy()), so the channel utilization can be reported
+ * without walking the route trees. The parallel router updates it concurrently for nets
+ * whose wires may span the same locations, so the counts are atomic.
+ */
+class t_chan_occupancy {
+  public:
+    ///@brief Sizes the occupancy to a device grid of width x height locations, all unoccupied
+    void init(size_t width, size_t height) {
+        width_ = width;
+        height_ = height;
+        chanx_occ_ = std::vector<std::atomic<int>>(width * height);
+        chany_occ_ = std::vector<std::atomic<int>>(width * height);
+    }
+
+    void clear() {
+        init(0, 0);
+    }
+
+    bool empty() const { return chanx_occ_.empty(); }
+    size_t width() const { return width_; }
+    size_t height() const { return height_; }
+
+    ///@brief Adds delta to the occupancy of the chan_type (CHANX or CHANY) channel at (x, y)
+    void add_occ(t_rr_type chan_type, int x, int y, int delta) {
+        occ_lane(chan_type)[index(x, y)].fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    ///@brief Returns the occupancy of the chan_type (CHANX or CHANY) channel at (x, y)
+    int occ(t_rr_type chan_type, int x, int y) const {
+        VTR_ASSERT_SAFE(chan_type == CHANX || chan_type == CHANY);
+        const auto& lane = (chan_type == CHANX) ? chanx_occ_ : chany_occ_;
+        return lane[index(x, y)].load(std::memory_order_relaxed);
+    }
+
+    size_t memory_usage() const {
+        return (chanx_occ_.capacity() + chany_occ_.capacity()) * sizeof(std::atomic<int>);
+    }
+
+  private:
+    std::vector<std::atomic<int>>& occ_lane(t_rr_type chan_type) {
+        VTR_ASSERT_SAFE(chan_type == CHANX || chan_type == CHANY);
+        return (chan_type == CHANX) ? chanx_occ_ : chany_occ_;
+    }
+
+    size_t index(int x, int y) const {
+        VTR_ASSERT_SAFE(x >= 0 && size_t(x) < width_ && y >= 0 && size_t(y) < height_);
+        return size_t(x) * height_ + size_t(y);
+    }
+
+    size_t width_ = 0;
+    size_t height_ = 0;
+    std::vector<std::atomic<int>> chanx_occ_; ///<[0..width-1][0..height-1] flattened
+    std::vector<std::atomic<int>> chany_occ_; ///<[0..width-1][0..height-1] flattened
 };
 
 /**
@@ -1735,6 +2035,49 @@ struct t_non_configurable_rr_sets {
     std::set<std::set<t_node_edge>> edge_sets;
 };
 
+/**
+ * @brief The sets of RR nodes connected by non-configurable edges
+ *
+ * A connection using one node of a set must use them all, so the router looks up the set
+ * of the nodes it expands. The set of every node is stored in a flat array indexed by node,
+ * and the nodes of each set are stored contiguously, so neither needs a hash look-up.
+ */
+class t_rr_non_config_node_sets {
+  public:
+    ///@brief Builds the sets of an RR graph with num_nodes nodes, from the nodes of each set
+    void init(size_t num_nodes, const std::vector<std::vector<RRNodeId>>& sets);
+
+    void clear();
+
+    ///@brief Returns the number of sets
+    size_t size() const {
+        return set_first_node_.empty() ? 0 : set_first_node_.size() - 1;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    ///@brief Returns the nodes of set iset
+    vtr::array_view<const RRNodeId> operator[](size_t iset) const {
+        VTR_ASSERT_SAFE(iset + 1 < set_first_node_.size());
+        return vtr::array_view<const RRNodeId>(set_nodes_.data() + set_first_node_[iset],
+                                               set_first_node_[iset + 1] - set_first_node_[iset]);
+    }
+
+    ///@brief Returns the set of node, or OPEN if it is not connected by non-configurable edges
+    int node_set(RRNodeId node) const {
+        return (size_t(node) < node_sets_.size()) ? node_sets_[node] : OPEN;
+    }
+
+    size_t memory_usage() const;
+
+  private:
+    std::vector<size_t> set_first_node_; ///<[0..num_sets] Start of the nodes of each set in set_nodes_
+    std::vector<RRNodeId> set_nodes_;
+    vtr::vector<RRNodeId, int> node_sets_; ///<Set of each node, or OPEN
+};
+
 #define NO_PREVIOUS -1
 
 ///@brief Power estimation options
@@ -1762,6 +2105,22 @@ struct t_TokenPair {
 
 struct t_lb_type_rr_node; /* Defined in pack_types.h */
 
+/**
+ * @brief Location of the device grid within the full device, when the grid is cropped
+ *        to the floorplan constraints (--crop_device_to_floorplan)
+ *
+ * Grid location (x, y) is location (x + x_offset, y + y_offset) of the full device.
+ * The files read and written by VPR (e.g. placement and routing) use full device coordinates.
+ */
+struct t_grid_crop {
+    int x_offset = 0;
+    int y_offset = 0;
+    size_t full_width = 0;  ///<Width of the full device grid (0 if the grid is not cropped)
+    size_t full_height = 0; ///<Height of the full device grid (0 if the grid is not cropped)
+
+    bool is_cropped() const { return full_width != 0; }
+};
+
 ///@brief Store settings for VPR
 struct t_vpr_setup {
     bool TimingEnabled;             ///<Is VPR timing enabled
@@ -1786,11 +2145,16 @@ struct t_vpr_setup {
     std::string GraphicsCommands;        ///<commands to control graphics settings
     t_power_opts PowerOpts;
     std::string device_layout;
+    bool crop_device_to_floorplan;             ///<Only build the part of the device covering the floorplan constraints
+    int crop_device_margin;                    ///<Number of grid tiles kept around the floorplan constraints when cropping the device
+    bool pipeline_device_creation;             ///<Build the rr graph and router lookahead while packing, when they do not depend on the packing
     e_constant_net_method constant_net_method; ///<How constant nets should be handled
     e_clock_modeling clock_modeling;           ///<How clocks should be handled
     bool two_stage_clock_routing;              ///<How clocks should be routed in the presence of a dedicated clock network
     bool exit_before_pack;                     ///<Exits early before starting packing (useful for collecting statistics without running/loading any stages)
     unsigned int num_workers;                  ///Maximum number of worker threads (determined from an env var or cmdline option)
+    bool reuse_rr_graph = false;               ///<Keep the rr graph (and router lookahead) left by a previous flow if its channel widths are unchanged
+    std::vector<std::string> command_line;     ///<The arguments VPR was initialized from (without the program name), if known
 };
 
 class RouteStatus {
@@ -20,6 +20,7 @@
 #include <sstream>
 #include <array>
 #include <iostream>
+#include <chrono>
 #include <time.h>
 
 #include "vtr_assert.h"
@@ -103,7 +104,7 @@ void act_on_mouse_move(ezgl::application* app, GdkEventButton* event, double x,
 
 static void highlight_blocks(double x, double y);
 
-static float get_router_expansion_cost(const t_rr_node_route_inf node_inf,
+static float get_router_expansion_cost(const t_const_rr_node_route_inf node_inf,
                                        e_draw_router_expansion_cost draw_router_expansion_cost);
 static void draw_router_expansion_costs(ezgl::renderer* g);
 
@@ -172,6 +173,11 @@ ezgl::point2d point_1(0, 0);
 ezgl::rectangle initial_world;
 std::string rr_highlight_message;
 
+//Redraws which do not wait for the user are skipped if they come sooner than this after the previous
+//one, so that watching a run does not slow the placer and router down to the speed of drawing
+constexpr std::chrono::milliseconds MIN_UNPAUSED_REDRAW_INTERVAL(100);
+std::chrono::steady_clock::time_point last_redraw_time;
+
 #endif // NO_GRAPHICS
 
 /********************** Subroutine definitions ******************************/
@@ -458,6 +464,13 @@ void update_screen(ScreenUpdatePriority priority, const char* msg, enum pic_type
     //the user won't need to click manually.
     draw_state->auto_proceed = (state_change && !should_pause);
 
+    auto now = std::chrono::steady_clock::now();
+    bool must_redraw = state_change || should_pause || draw_state->forced_pause || draw_state->save_graphics;
+    if (!must_redraw && now - last_redraw_time < MIN_UNPAUSED_REDRAW_INTERVAL) {
+        return;
+    }
+    last_redraw_time = now;
+
     if (state_change                   //Must update buttons
         || should_pause                //The priority means graphics should pause for user interaction
         || draw_state->forced_pause) { //The user asked to pause
@@ -578,6 +591,7 @@ void init_draw_coords(float width_val) {
      * rr_node, as the number of rr_nodes may change.						*/
     if (rr_graph.num_nodes() != 0) {
         draw_state->draw_rr_node.resize(rr_graph.num_nodes());
+        invalidate_draw_rr_index();
         for (RRNodeId inode : rr_graph.nodes()) {
             draw_state->draw_rr_node[inode].color = DEFAULT_RR_NODE_COLOR;
             draw_state->draw_rr_node[inode].node_highlighted = false;
@@ -911,7 +925,7 @@ ezgl::color to_ezgl_color(vtr::Color<float> color) {
     return ezgl::color(color.r * 255, color.g * 255, color.b * 255);
 }
 
-static float get_router_expansion_cost(const t_rr_node_route_inf node_inf,
+static float get_router_expansion_cost(const t_const_rr_node_route_inf node_inf,
                                        e_draw_router_expansion_cost draw_router_expansion_cost) {
     if (draw_router_expansion_cost == DRAW_ROUTER_EXPANSION_COST_TOTAL
         || draw_router_expansion_cost
@@ -942,9 +956,15 @@ static void draw_router_expansion_costs(ezgl::renderer* g) {
 
     vtr::vector<RRNodeId, float> rr_costs(device_ctx.rr_graph.num_nodes());
 
+    // Only the costs of the latest path search are current: the others are stale
+    uint32_t latest_search_epoch = 0;
+    for (const auto& search_inf : routing_ctx.rr_node_route_inf.search_lane()) {
+        latest_search_epoch = std::max(latest_search_epoch, search_inf.search_epoch);
+    }
+
     for (RRNodeId inode : device_ctx.rr_graph.nodes()) {
         float cost = get_router_expansion_cost(
-            routing_ctx.rr_node_route_inf[inode],
+            routing_ctx.rr_node_route_inf.search_inf(inode, latest_search_epoch),
             draw_state->show_router_expansion_cost);
         rr_costs[inode] = cost;
     }
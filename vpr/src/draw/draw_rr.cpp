@@ -11,6 +11,7 @@
 #include "rr_graph_fwd.h"
 #include "vtr_assert.h"
 #include "vtr_ndoffsetmatrix.h"
+#include "vtr_ndmatrix.h"
 #include "vtr_memory.h"
 #include "vtr_log.h"
 #include "vtr_color_map.h"
@@ -63,8 +64,32 @@
 constexpr float SB_EDGE_TURN_ARROW_POSITION = 0.2;
 constexpr float SB_EDGE_STRAIGHT_ARROW_POSITION = 0.95;
 
+//Adjacent tracks of a channel are one world unit apart. Below this many screen pixels
+//per track the wires are indistinguishable, so only the channel utilization is drawn
+constexpr float MIN_RR_DETAIL_PIXELS_PER_TRACK = 1.0;
+
+/* Grid bucket index of the rr nodes, so that only the nodes near the visible world
+ * (or a click) are visited. Each node is stored in the bucket of every tile it spans.
+ * Built lazily, and invalidated by invalidate_draw_rr_index() when the rr graph changes. */
+struct t_draw_rr_index {
+    vtr::NdMatrix<std::vector<RRNodeId>, 3> buckets; //[0..num_layers-1][0..grid.width()-1][0..grid.height()-1]
+    bool valid = false;
+};
+
+static t_draw_rr_index draw_rr_index;
+
+static void draw_one_rr_node(RRNodeId inode, ezgl::renderer* g);
+static void draw_rr_chan_util(const std::vector<RRNodeId>& nodes, ezgl::renderer* g);
+static void build_draw_rr_index();
+static void get_tile_range(float world_low, float world_high, const float* tile_coords, int num_tiles, int* tile_low, int* tile_high);
+static std::vector<RRNodeId> get_rr_nodes_in_tiles(int xlow, int xhigh, int ylow, int yhigh);
+static std::vector<RRNodeId> get_visible_rr_nodes(ezgl::renderer* g);
+static bool is_rr_node_hit(RRNodeId inode, float click_x, float click_y);
+
 /* Draws the routing resources that exist in the FPGA, if the user wants
- * them drawn.
+ * them drawn. Only the rr nodes in (or next to) the visible world are drawn,
+ * and when zoomed out too far to tell the wires apart, the channel utilization
+ * is drawn instead of the individual wires.
  */
 void draw_rr(ezgl::renderer* g) {
     t_draw_state* draw_state = get_draw_state_vars();
@@ -80,8 +105,9 @@ void draw_rr(ezgl::renderer* g) {
 
     g->set_line_dash(ezgl::line_dash::none);
 
+    //Edges are coloured from both of their nodes, so refresh the colour of every node,
+    //not only of the visible ones
     for (const RRNodeId inode : device_ctx.rr_graph.nodes()) {
-        int layer_num = rr_graph.node_layer(inode);
         int transparency_factor = get_rr_node_transparency(inode);
         if (!draw_state->draw_rr_node[inode].node_highlighted) {
             /* If not highlighted node, assign color based on type. */
@@ -108,47 +134,198 @@ void draw_rr(ezgl::renderer* g) {
         }
 
         draw_state->draw_rr_node[inode].color.alpha = transparency_factor;
+    }
 
-        if (!draw_state->draw_layer_display[layer_num].visible)
-            continue; // skip drawing if layer is not visible
+    std::vector<RRNodeId> visible_nodes = get_visible_rr_nodes(g);
 
-        /* Now call drawing routines to draw the node. */
-        switch (rr_graph.node_type(inode)) {
-            case SINK:
-                draw_rr_src_sink(inode, draw_state->draw_rr_node[inode].color, g);
-                break;
-            case SOURCE:
-                draw_rr_edges(inode, g);
-                draw_rr_src_sink(inode, draw_state->draw_rr_node[inode].color, g);
-                break;
+    float pixels_per_track = std::abs(g->world_to_screen(ezgl::rectangle({0, 0}, {1, 1})).width());
+    if (pixels_per_track < MIN_RR_DETAIL_PIXELS_PER_TRACK) {
+        draw_rr_chan_util(visible_nodes, g);
 
-            case CHANX:
-                draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
-                break;
+        //Still show what the user highlighted
+        for (const RRNodeId inode : visible_nodes) {
+            if (draw_state->draw_rr_node[inode].node_highlighted) {
+                draw_one_rr_node(inode, g);
+            }
+        }
+    } else {
+        for (const RRNodeId inode : visible_nodes) {
+            draw_one_rr_node(inode, g);
+        }
+    }
 
-            case CHANY:
-                draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
-                break;
+    drawroute(HIGHLIGHTED, g);
+}
 
-            case IPIN:
-                draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
-                break;
+/* Calls the drawing routines of an rr node on a visible layer. */
+static void draw_one_rr_node(RRNodeId inode, ezgl::renderer* g) {
+    t_draw_state* draw_state = get_draw_state_vars();
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
 
-            case OPIN:
-                draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
-                draw_rr_edges(inode, g);
-                break;
+    switch (rr_graph.node_type(inode)) {
+        case SINK:
+            draw_rr_src_sink(inode, draw_state->draw_rr_node[inode].color, g);
+            break;
+        case SOURCE:
+            draw_rr_edges(inode, g);
+            draw_rr_src_sink(inode, draw_state->draw_rr_node[inode].color, g);
+            break;
 
-            default:
-                vpr_throw(VPR_ERROR_OTHER, __FILE__, __LINE__,
-                          "in draw_rr: Unexpected rr_node type: %d.\n", rr_graph.node_type(inode));
+        case CHANX:
+            draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        case CHANY:
+            draw_rr_chan(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        case IPIN:
+            draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        case OPIN:
+            draw_rr_pin(inode, draw_state->draw_rr_node[inode].color, g);
+            draw_rr_edges(inode, g);
+            break;
+
+        default:
+            vpr_throw(VPR_ERROR_OTHER, __FILE__, __LINE__,
+                      "in draw_rr: Unexpected rr_node type: %d.\n", rr_graph.node_type(inode));
+    }
+}
+
+/* Fills each channel segment holding some of nodes with a colour showing the fraction
+ * of its tracks in use, in place of drawing the individual wires. */
+static void draw_rr_chan_util(const std::vector<RRNodeId>& nodes, ezgl::renderer* g) {
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    auto& route_ctx = g_vpr_ctx.routing();
+
+    //Occupancies are only known once the router has allocated them
+    bool has_occ = route_ctx.rr_node_route_inf.size() == rr_graph.num_nodes();
+
+    vtr::Matrix<float> chanx_usage({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
+    vtr::Matrix<float> chany_usage({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
+    vtr::Matrix<float> chanx_avail({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
+    vtr::Matrix<float> chany_avail({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
+
+    for (const RRNodeId inode : nodes) {
+        t_rr_type type = rr_graph.node_type(inode);
+        if (type != CHANX && type != CHANY) {
+            continue;
+        }
+
+        auto& usage = (type == CHANX) ? chanx_usage : chany_usage;
+        auto& avail = (type == CHANX) ? chanx_avail : chany_avail;
+        int occ = has_occ ? route_ctx.rr_node_route_inf[inode].occ() : 0;
+        for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); x++) {
+            for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); y++) {
+                usage[x][y] += occ;
+                avail[x][y] += rr_graph.node_capacity(inode);
+            }
         }
     }
 
-    drawroute(HIGHLIGHTED, g);
+    vtr::PlasmaColorMap cmap(0., 1.);
+    float tile_width = draw_coords->get_tile_width();
+    float tile_height = draw_coords->get_tile_height();
+
+    for (size_t x = 0; x < device_ctx.grid.width() - 1; ++x) {
+        for (size_t y = 0; y < device_ctx.grid.height() - 1; ++y) {
+            if (chanx_avail[x][y] > 0.) {
+                float util = std::min(routing_util(chanx_usage[x][y], chanx_avail[x][y]), 1.f);
+                g->set_color(to_ezgl_color(cmap.color(util)));
+                g->fill_rectangle({draw_coords->tile_x[x], draw_coords->tile_y[y] + tile_height},
+                                  {draw_coords->tile_x[x] + tile_width, draw_coords->tile_y[y + 1]});
+            }
+            if (chany_avail[x][y] > 0.) {
+                float util = std::min(routing_util(chany_usage[x][y], chany_avail[x][y]), 1.f);
+                g->set_color(to_ezgl_color(cmap.color(util)));
+                g->fill_rectangle({draw_coords->tile_x[x] + tile_width, draw_coords->tile_y[y]},
+                                  {draw_coords->tile_x[x + 1], draw_coords->tile_y[y] + tile_height});
+            }
+        }
+    }
+}
+
+void invalidate_draw_rr_index() {
+    draw_rr_index.valid = false;
+    draw_rr_index.buckets.clear();
+}
+
+static void build_draw_rr_index() {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    draw_rr_index.buckets.resize({(size_t)device_ctx.grid.get_num_layers(), device_ctx.grid.width(), device_ctx.grid.height()});
+    for (const RRNodeId inode : rr_graph.nodes()) {
+        int layer_num = rr_graph.node_layer(inode);
+        for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); x++) {
+            for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); y++) {
+                draw_rr_index.buckets[layer_num][x][y].push_back(inode);
+            }
+        }
+    }
+    draw_rr_index.valid = true;
+}
+
+/* Returns the range of tiles whose drawing (tile_coords of the tile to the next one)
+ * overlaps [world_low, world_high]. tile_coords are the sorted tile_x or tile_y. */
+static void get_tile_range(float world_low, float world_high, const float* tile_coords, int num_tiles, int* tile_low, int* tile_high) {
+    *tile_low = std::upper_bound(tile_coords, tile_coords + num_tiles, world_low) - tile_coords - 1;
+    *tile_high = std::upper_bound(tile_coords, tile_coords + num_tiles, world_high) - tile_coords - 1;
+
+    *tile_low = std::max(*tile_low, 0);
+    *tile_high = std::min(std::max(*tile_high, 0), num_tiles - 1);
+}
+
+/* Returns the rr nodes on visible layers spanning any of the tiles in the range, in increasing id order
+ * (the order the whole graph is drawn and hit-tested in). */
+static std::vector<RRNodeId> get_rr_nodes_in_tiles(int xlow, int xhigh, int ylow, int yhigh) {
+    t_draw_state* draw_state = get_draw_state_vars();
+
+    if (!draw_rr_index.valid) {
+        build_draw_rr_index();
+    }
+
+    std::vector<RRNodeId> nodes;
+    for (size_t layer_num = 0; layer_num < draw_rr_index.buckets.dim_size(0); layer_num++) {
+        if (!draw_state->draw_layer_display[layer_num].visible) {
+            continue;
+        }
+        for (int x = xlow; x <= xhigh; x++) {
+            for (int y = ylow; y <= yhigh; y++) {
+                const auto& bucket = draw_rr_index.buckets[layer_num][x][y];
+                nodes.insert(nodes.end(), bucket.begin(), bucket.end());
+            }
+        }
+    }
+
+    //Nodes spanning several tiles are in several buckets
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    return nodes;
+}
+
+/* Returns the rr nodes to draw for the visible world. The visible tiles are widened
+ * by one tile, since the edges of the nodes just outside the view can reach into it. */
+static std::vector<RRNodeId> get_visible_rr_nodes(ezgl::renderer* g) {
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    ezgl::rectangle visible_world = g->get_visible_world();
+
+    int xlow, xhigh, ylow, yhigh;
+    get_tile_range(visible_world.left(), visible_world.right(), draw_coords->tile_x, grid.width(), &xlow, &xhigh);
+    get_tile_range(visible_world.bottom(), visible_world.top(), draw_coords->tile_y, grid.height(), &ylow, &yhigh);
+
+    return get_rr_nodes_in_tiles(std::max(xlow - 1, 0), std::min(xhigh + 1, (int)grid.width() - 1),
+                                 std::max(ylow - 1, 0), std::min(yhigh + 1, (int)grid.height() - 1));
 }
 
 void draw_rr_chan(RRNodeId inode, const ezgl::color color, ezgl::renderer* g) {
@@ -690,73 +867,84 @@ void draw_expand_non_configurable_rr_nodes_recurr(RRNodeId from_node,
  *  It returns the hit RR node's ID (or OPEN if no hit)
  */
 RRNodeId draw_check_rr_node_hit(float click_x, float click_y) {
-    RRNodeId hit_node = RRNodeId::INVALID();
+    t_draw_coords* draw_coords = get_draw_coords_vars();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    //Only the nodes of the clicked tile and its neighbours (for the click tolerance) can be hit
+    int xlow, xhigh, ylow, yhigh;
+    get_tile_range(click_x, click_x, draw_coords->tile_x, grid.width(), &xlow, &xhigh);
+    get_tile_range(click_y, click_y, draw_coords->tile_y, grid.height(), &ylow, &yhigh);
+
+    std::vector<RRNodeId> nodes = get_rr_nodes_in_tiles(std::max(xlow - 1, 0), std::min(xhigh + 1, (int)grid.width() - 1),
+                                                        std::max(ylow - 1, 0), std::min(yhigh + 1, (int)grid.height() - 1));
+
+    for (const RRNodeId inode : nodes) {
+        if (is_rr_node_hit(inode, click_x, click_y)) {
+            return inode;
+        }
+    }
+    return RRNodeId::INVALID();
+}
+
+/* Returns true if the click lies within the drawn bounding box of inode. */
+static bool is_rr_node_hit(RRNodeId inode, float click_x, float click_y) {
     ezgl::rectangle bound_box;
 
     t_draw_coords* draw_coords = get_draw_coords_vars();
-    t_draw_state* draw_state = get_draw_state_vars();
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
-    for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
-        int layer_num = rr_graph.node_layer(inode);
-        if (!draw_state->draw_layer_display[layer_num].visible) {
-            continue; /* Don't check RR nodes on currently invisible layers*/
-        }
-        switch (rr_graph.node_type(inode)) {
-            case IPIN:
-            case OPIN: {
-                int i = rr_graph.node_xlow(inode);
-                int j = rr_graph.node_ylow(inode);
-                t_physical_tile_type_ptr type = device_ctx.grid.get_physical_type({i, j, layer_num});
-                int width_offset = device_ctx.grid.get_width_offset({i, j, layer_num});
-                int height_offset = device_ctx.grid.get_height_offset({i, j, layer_num});
-                int ipin = rr_graph.node_pin_num(inode);
-                float xcen, ycen;
-                for (const e_side& iside : SIDES) {
-                    // If pin exists on this side of the block, then get pin coordinates
-                    if (type->pinloc[width_offset][height_offset][size_t(iside)][ipin]) {
-                        draw_get_rr_pin_coords(inode, &xcen, &ycen, iside);
-
-                        // Now check if we clicked on this pin
-                        if (click_x >= xcen - draw_coords->pin_size && click_x <= xcen + draw_coords->pin_size && click_y >= ycen - draw_coords->pin_size && click_y <= ycen + draw_coords->pin_size) {
-                            hit_node = inode;
-                            return hit_node;
-                        }
+    int layer_num = rr_graph.node_layer(inode);
+    switch (rr_graph.node_type(inode)) {
+        case IPIN:
+        case OPIN: {
+            int i = rr_graph.node_xlow(inode);
+            int j = rr_graph.node_ylow(inode);
+            t_physical_tile_type_ptr type = device_ctx.grid.get_physical_type({i, j, layer_num});
+            int width_offset = device_ctx.grid.get_width_offset({i, j, layer_num});
+            int height_offset = device_ctx.grid.get_height_offset({i, j, layer_num});
+            int ipin = rr_graph.node_pin_num(inode);
+            float xcen, ycen;
+            for (const e_side& iside : SIDES) {
+                // If pin exists on this side of the block, then get pin coordinates
+                if (type->pinloc[width_offset][height_offset][size_t(iside)][ipin]) {
+                    draw_get_rr_pin_coords(inode, &xcen, &ycen, iside);
+
+                    // Now check if we clicked on this pin
+                    if (click_x >= xcen - draw_coords->pin_size && click_x <= xcen + draw_coords->pin_size && click_y >= ycen - draw_coords->pin_size && click_y <= ycen + draw_coords->pin_size) {
+                        return true;
                     }
                 }
-                break;
             }
-            case SOURCE:
-            case SINK: {
-                float xcen, ycen;
-                draw_get_rr_src_sink_coords(rr_graph.rr_nodes()[size_t(inode)], &xcen, &ycen);
-
-                // Now check if we clicked on this pin
-                if (click_x >= xcen - draw_coords->pin_size && click_x <= xcen + draw_coords->pin_size && click_y >= ycen - draw_coords->pin_size && click_y <= ycen + draw_coords->pin_size) {
-                    hit_node = inode;
-                    return hit_node;
-                }
-                break;
+            break;
+        }
+        case SOURCE:
+        case SINK: {
+            float xcen, ycen;
+            draw_get_rr_src_sink_coords(rr_graph.rr_nodes()[size_t(inode)], &xcen, &ycen);
+
+            // Now check if we clicked on this pin
+            if (click_x >= xcen - draw_coords->pin_size && click_x <= xcen + draw_coords->pin_size && click_y >= ycen - draw_coords->pin_size && click_y <= ycen + draw_coords->pin_size) {
+                return true;
             }
-            case CHANX:
-            case CHANY: {
-                bound_box = draw_get_rr_chan_bbox(inode);
-
-                // Check if we clicked on this wire, with 30%
-                // tolerance outside its boundary
-                const float tolerance = 0.3;
-                if (click_x >= bound_box.left() - tolerance && click_x <= bound_box.right() + tolerance && click_y >= bound_box.bottom() - tolerance && click_y <= bound_box.top() + tolerance) {
-                    hit_node = inode;
-                    return hit_node;
-                }
-                break;
+            break;
+        }
+        case CHANX:
+        case CHANY: {
+            bound_box = draw_get_rr_chan_bbox(inode);
+
+            // Check if we clicked on this wire, with 30%
+            // tolerance outside its boundary
+            const float tolerance = 0.3;
+            if (click_x >= bound_box.left() - tolerance && click_x <= bound_box.right() + tolerance && click_y >= bound_box.bottom() - tolerance && click_y <= bound_box.top() + tolerance) {
+                return true;
             }
-            default:
-                break;
+            break;
         }
+        default:
+            break;
     }
-    return hit_node;
+    return false;
 }
 
 /* This routine is called when the routing resource graph is shown, and someone
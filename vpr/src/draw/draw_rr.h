@@ -84,6 +84,10 @@ RRNodeId draw_check_rr_node_hit(float click_x, float click_y);
  * clicked upon, we highlight it in Magenta, and its fanout in red.*/
 bool highlight_rr_nodes(float x, float y);
 
+/* Frees the spatial index of the rr nodes used to find the nodes to draw and hit-test.
+ * Must be called whenever the rr graph changes; the index is rebuilt on demand. */
+void invalidate_draw_rr_index();
+
 /* Draws routing costs */
 void draw_rr_costs(ezgl::renderer* g, const vtr::vector<RRNodeId, float>& rr_costs, bool lowest_cost_first = true);
 
@@ -8,6 +8,7 @@
 #    include "draw_global.h"
 #    include "save_graphics.h"
 #    include "vtr_path.h"
+#    include "vtr_log.h"
 #    include "search_bar.h"
 
 extern ezgl::rectangle initial_world;
@@ -62,6 +63,8 @@ void save_graphics(std::string extension, std::string file_name) {
         extension = std::string(extension.begin() + 1, extension.end());
     }
 
+    //Printing only renders into a cairo surface of the requested size, so it needs neither a
+    //window nor the GTK event loop, and also works headless (--disp off --save_graphics on)
     auto canvas = application.get_canvas(application.get_main_canvas_id());
 
     bool result = true;
@@ -76,7 +79,13 @@ void save_graphics(std::string extension, std::string file_name) {
     } else if (extension == "svg") {
         result = canvas->print_svg(file_name.c_str(), initial_world.width(), initial_world.height());
     } else {
-        warning_dialog_box("Invalid file type");
+        if (get_draw_state_vars()->show_graphics) {
+            warning_dialog_box("Invalid file type");
+        } else {
+            //There is no window to show a dialog box in
+            VTR_LOG_WARN("Unable to save graphics to '%s': invalid file type (expected pdf, png or svg)\n", file_name.c_str());
+        }
+        return;
     }
 
     VTR_ASSERT_MSG(result == true, "Failed to save graphics");
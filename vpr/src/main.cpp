@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <iostream>
 
 #include "vtr_error.h"
 #include "vtr_memory.h"
@@ -24,6 +25,7 @@
 #include "vpr_exit_codes.h"
 #include "vpr_error.h"
 #include "vpr_api.h"
+#include "vpr_server.h"
 #include "vpr_signal_handler.h"
 #include "vpr_tatum_error.h"
 
@@ -42,6 +44,8 @@
  * 4.  Clean up
  */
 int main(int argc, const char** argv) {
+    //Written (if requested) once the timer of the entire flow has finished
+    vtr::ScopedTimingTraceWriter timing_trace_writer;
     vtr::ScopedFinishTimer t("The entire flow of VPR");
 
     t_options Options = t_options();
@@ -58,6 +62,11 @@ int main(int argc, const char** argv) {
             return SUCCESS_EXIT_CODE;
         }
 
+        if (Options.server) {
+            /* Implement this and further jobs from stdin, keeping the device between them */
+            return vpr_run_server(Options, vpr_setup, Arch, std::cin);
+        }
+
         bool flow_succeeded = vpr_flow(vpr_setup, Arch);
         if (!flow_succeeded) {
             VTR_LOG("VPR failed to implement circuit\n");
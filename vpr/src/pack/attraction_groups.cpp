@@ -1,5 +1,7 @@
 #include "attraction_groups.h"
 
+#include <algorithm>
+
 AttractionInfo::AttractionInfo(bool attraction_groups_on) {
     auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
     auto& atom_ctx = g_vpr_ctx.atom();
@@ -147,6 +149,23 @@ void AttractionInfo::set_attraction_group_info(AttractGroupId group_id, const At
     attraction_groups[group_id] = group_info;
 }
 
+void AttractionInfo::update_att_group_for_packed_atom(const AtomBlockId atom_id) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    AttractionGroup& group = attraction_groups[atom_attraction_group[atom_id]];
+    group.num_packed_atoms++;
+
+    if (2 * group.num_packed_atoms > group.group_atoms.size()) {
+        //Keep the unpacked atoms, in order
+        auto is_packed = [&](const AtomBlockId atom) {
+            return atom_ctx.lookup.atom_clb(atom) != ClusterBlockId::INVALID();
+        };
+        group.group_atoms.erase(std::remove_if(group.group_atoms.begin(), group.group_atoms.end(), is_packed),
+                                group.group_atoms.end());
+        group.num_packed_atoms = 0;
+    }
+}
+
 void AttractionInfo::add_attraction_group(const AttractionGroup& group_info) {
     attraction_groups.push_back(group_info);
 }
@@ -34,9 +34,13 @@ struct attraction_id_tag;
 typedef vtr::StrongId<attraction_id_tag> AttractGroupId;
 
 struct AttractionGroup {
-    //stores all atoms in the attraction group
+    //stores all atoms in the attraction group (and may still hold some which have been packed, see
+    //AttractionInfo::update_att_group_for_packed_atom())
     std::vector<AtomBlockId> group_atoms;
 
+    //number of atoms in group_atoms packed since the group was last compacted
+    size_t num_packed_atoms = 0;
+
     /*
      * Atoms belonging to this attraction group will receive this gain if they
      * are potential candidates to be put in a cluster with the same attraction group.
@@ -72,6 +76,13 @@ class AttractionInfo {
 
     void set_attraction_group_info(AttractGroupId group_id, const AttractionGroup& group_info);
 
+    /*
+     * Records that atom_id (which is in an attraction group) was packed. Once half the atoms of the
+     * group are packed ones they are dropped, so searching a group for unpacked atoms stays
+     * proportional to its unpacked atoms without periodically rebuilding every group.
+     */
+    void update_att_group_for_packed_atom(const AtomBlockId atom_id);
+
     float get_attraction_group_gain(const AttractGroupId group_id);
 
     void set_attraction_group_gain(const AttractGroupId group_id, const float new_gain);
@@ -212,6 +212,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
 
     cluster_stats.blocks_since_last_analysis = 0;
     num_blocks_hill_added = 0;
+    int clusters_since_timing_update = 0;
 
     VTR_ASSERT(helper_ctx.max_cluster_size < MAX_SHORT);
     /* Limit maximum number of elements for each cluster */
@@ -270,8 +271,7 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
                               cluster_stats.num_molecules_processed,
                               cluster_stats.mols_since_last_print,
                               device_ctx.grid.width(),
-                              device_ctx.grid.height(),
-                              attraction_groups);
+                              device_ctx.grid.height());
 
             VTR_LOGV(verbosity > 2,
                      "Complex block %d: '%s' (%s) ", helper_ctx.total_clb_num,
@@ -370,6 +370,16 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
             if (is_cluster_legal) {
                 istart = save_cluster_routing_and_pick_new_seed(packer_opts, helper_ctx.total_clb_num, seed_atoms, num_blocks_hill_added, clustering_data.intra_lb_routing, seedindex, cluster_stats, router_data);
                 store_cluster_info_and_free(packer_opts, clb_index, logic_block_type, le_pb_type, le_count, clb_inter_blk_nets);
+
+                //The criticalities guiding the next clusters account for the nets absorbed so far
+                if (packer_opts.timing_driven && packer_opts.timing_update_interval > 0) {
+                    invalidate_absorbed_net_timing(clb_index, *timing_info);
+                    if (++clusters_since_timing_update >= packer_opts.timing_update_interval) {
+                        PackPhaseTimer phase_timer(helper_ctx.pack_profile, e_pack_phase::TIMING_UPDATE);
+                        timing_info->update();
+                        clusters_since_timing_update = 0;
+                    }
+                }
             } else {
                 free_data_and_requeue_used_mols_if_illegal(clb_index, savedseedindex, num_used_type_instances, helper_ctx.total_clb_num, seedindex);
             }
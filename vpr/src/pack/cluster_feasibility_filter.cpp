@@ -62,6 +62,8 @@ static void sum_pin_class(t_pb_graph_node* pb_graph_node);
 static void discover_all_forced_connections(t_pb_graph_node* pb_graph_node);
 static bool is_forced_connection(const t_pb_graph_pin* pb_graph_pin);
 
+static void load_implementable_models_rec(t_pb_graph_node* pb_graph_node);
+
 /**
  * Identify all pin class information for complex block
  */
@@ -83,6 +85,14 @@ void load_pin_classes_in_pb_graph_head(t_pb_graph_node* pb_graph_node) {
     reset_pin_class_scratch_pad_rec(pb_graph_node);
     load_list_of_connectable_input_pin_ptrs(pb_graph_node);
     discover_all_forced_connections(pb_graph_node);
+
+    /* Load the models each node can implement */
+    load_implementable_models_rec(pb_graph_node);
+}
+
+bool pb_graph_node_can_implement_model(const t_pb_graph_node* pb_graph_node, const t_model* model) {
+    size_t imodel = model->index;
+    return imodel < pb_graph_node->implementable_models.size() && pb_graph_node->implementable_models.get(imodel);
 }
 
 /**
@@ -539,3 +549,43 @@ static bool is_forced_connection(const t_pb_graph_pin* pb_graph_pin) {
     }
     return is_forced_connection(pb_graph_pin->output_edges[0]->output_pins[0]);
 }
+
+/**
+ * Recursive function to load the models implementable under each pb_graph_node,
+ * as the union of its children's over all modes usable by the packer
+ */
+static void load_implementable_models_rec(t_pb_graph_node* pb_graph_node) {
+    vtr::dynamic_bitset<>& models = pb_graph_node->implementable_models;
+    models.clear();
+
+    if (pb_graph_node->is_primitive()) {
+        const t_model* model = pb_graph_node->pb_type->model;
+        if (model != nullptr) {
+            models.resize(model->index + 1);
+            models.set(model->index, true);
+        }
+        return;
+    }
+
+    for (int i = 0; i < pb_graph_node->pb_type->num_modes; i++) {
+        if (pb_graph_node->pb_type->modes[i].disable_packing) {
+            continue;
+        }
+        for (int j = 0; j < pb_graph_node->pb_type->modes[i].num_pb_type_children; j++) {
+            for (int k = 0; k < pb_graph_node->pb_type->modes[i].pb_type_children[j].num_pb; k++) {
+                t_pb_graph_node* child = &pb_graph_node->child_pb_graph_nodes[i][j][k];
+                load_implementable_models_rec(child);
+
+                const vtr::dynamic_bitset<>& child_models = child->implementable_models;
+                if (child_models.size() > models.size()) {
+                    models.resize(child_models.size());
+                }
+                for (size_t imodel = 0; imodel < child_models.size(); imodel++) {
+                    if (child_models.get(imodel)) {
+                        models.set(imodel, true);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -25,4 +25,8 @@
 
 void load_pin_classes_in_pb_graph_head(t_pb_graph_node* pb_graph_node);
 
+/* Returns true if a primitive in or under pb_graph_node can implement model.
+ * This is a constant time necessary condition for packing an atom of that model under the node. */
+bool pb_graph_node_can_implement_model(const t_pb_graph_node* pb_graph_node, const t_model* model);
+
 #endif
@@ -25,6 +25,7 @@
 #include "vpr_utils.h"
 #include "hash.h"
 #include "cluster_placement.h"
+#include "cluster_feasibility_filter.h"
 
 /****************************************/
 /*Local Function Declaration			*/
@@ -65,6 +66,7 @@ t_cluster_placement_stats* alloc_and_load_cluster_placement_stats() {
         cluster_placement_stats_list[type.index] = t_cluster_placement_stats();
         if (!is_empty_type(&type)) {
             cluster_placement_stats_list[type.index].curr_molecule = nullptr;
+            cluster_placement_stats_list[type.index].pb_graph_head = type.pb_graph_head;
             load_cluster_placement_stats_for_pb_graph_node(&cluster_placement_stats_list[type.index],
                                                            type.pb_graph_head);
         }
@@ -112,6 +114,17 @@ bool get_next_primitive_list(t_cluster_placement_stats* cluster_placement_stats,
         }
     }
 
+    /* Quickly reject molecules with an atom the complex block can not implement anywhere */
+    for (i = 0; i < get_array_size_of_molecule(molecule); i++) {
+        AtomBlockId blk_id = molecule->atom_block_ids[i];
+        if (blk_id && !pb_graph_node_can_implement_model(cluster_placement_stats->pb_graph_head, g_vpr_ctx.atom().nlist.block_model(blk_id))) {
+            for (int j = 0; j < molecule->num_blocks; j++) {
+                primitives_list[j] = nullptr;
+            }
+            return false;
+        }
+    }
+
     /* find next set of blocks
      * 1. Remove invalid blocks to invalid queue
      * 2. Find lowest cost array of primitives that implements blocks
@@ -569,6 +582,11 @@ bool exists_free_primitive_for_atom_block(t_cluster_placement_stats* cluster_pla
                                           const AtomBlockId blk_id) {
     int i;
 
+    /* The complex block can not implement the atom's model anywhere */
+    if (!pb_graph_node_can_implement_model(cluster_placement_stats->pb_graph_head, g_vpr_ctx.atom().nlist.block_model(blk_id))) {
+        return false;
+    }
+
     /* might have a primitive in flight that's still valid */
     if (!cluster_placement_stats->in_flight_empty()) {
         if (primitive_type_feasible(blk_id,
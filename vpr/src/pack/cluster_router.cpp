@@ -18,9 +18,12 @@
 #include <map>
 #include <queue>
 #include <cmath>
+#include <unordered_set>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_hash.h"
+#include "vtr_flat_hash_map.h"
 
 #include "vpr_error.h"
 #include "vpr_types.h"
@@ -69,21 +72,34 @@ class reservable_pq : public std::priority_queue<T, U, V> {
     size_type cur_cap;
 };
 
+struct lb_route_signature_hash {
+    size_t operator()(const std::vector<int>& signature) const {
+        size_t seed = signature.size();
+        for (int value : signature) {
+            vtr::hash_combine(seed, value);
+        }
+        return seed;
+    }
+};
+
+/* Signatures (see get_lb_route_signature()) of the intra-logic block routing problems already found to be
+ * unroutable. Shared by all clusters, since identical problems recur across clusters of the same type.
+ * Cleared when it reaches MAX_UNROUTABLE_LB_ROUTES entries, to bound its memory. */
+static std::unordered_set<std::vector<int>, lb_route_signature_hash> unroutable_lb_routes;
+static constexpr size_t MAX_UNROUTABLE_LB_ROUTES = 100000;
+
 /*****************************************************************************************
  * Internal functions declarations
  ******************************************************************************************/
-static void free_lb_net_rt(t_lb_trace* lb_trace);
-static void free_lb_trace(t_lb_trace* lb_trace);
 static void add_pin_to_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id);
 static void remove_pin_from_rt_terminals(t_lb_router_data* router_data, const AtomPinId pin_id);
 
 static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data);
 
-static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status);
-static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data);
+static void commit_remove_rt(const t_lb_trace& rt, t_lb_router_data* router_data, e_commit_remove op, vtr::flat_hash_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status);
+static bool is_skip_route_net(const t_lb_trace& rt, t_lb_router_data* router_data);
 static void add_source_to_rt(t_lb_router_data* router_data, int inet);
 static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net);
-static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net, int explore_id_index);
 static bool try_expand_nodes(t_lb_router_data* router_data,
                              t_intra_lb_net* lb_net,
                              t_expansion_node* exp_node,
@@ -102,12 +118,13 @@ static void expand_edges(t_lb_router_data* router_data,
 static void expand_node(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout);
 static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_node exp_node, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int net_fanout);
 
-static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_data, int irt_net);
+static bool add_to_rt(t_lb_trace& rt, int node_index, t_lb_router_data* router_data, int irt_net);
 static bool is_route_success(t_lb_router_data* router_data);
-static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index);
+static int find_node_in_rt(const t_lb_trace& rt, int rt_index);
 static void reset_explored_node_tb(t_lb_router_data* router_data);
+static std::vector<int> get_lb_route_signature(const t_lb_router_data* router_data);
 static void save_and_reset_lb_route(t_lb_router_data* router_data);
-static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const int prev_pin_id, const t_lb_trace* trace);
+static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const t_lb_trace& trace);
 
 static std::string describe_lb_type_rr_node(int inode,
                                             const t_lb_router_data* router_data);
@@ -124,7 +141,7 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
 static void print_route(const char* filename, t_lb_router_data* router_data);
 static void print_route(FILE* fp, t_lb_router_data* router_data);
 #endif
-static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_data);
+static void print_trace(FILE* fp, const t_lb_trace& trace, t_lb_router_data* router_data);
 
 /*****************************************************************************************
  * Constructor/Destructor functions
@@ -165,27 +182,27 @@ void free_router_data(t_lb_router_data* router_data) {
     }
 }
 
-static bool route_has_conflict(t_lb_trace* rt, t_lb_router_data* router_data) {
+static bool route_has_conflict(const t_lb_trace& rt, t_lb_router_data* router_data) {
     std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
 
-    int cur_mode = -1;
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-        int new_mode = get_lb_type_rr_graph_edge_mode(lb_type_graph,
-                                                      rt->current_node, rt->next_nodes[i].current_node);
-        if (cur_mode != -1 && cur_mode != new_mode) {
-            return true;
-        }
-        if (route_has_conflict(&rt->next_nodes[i], router_data) == true) {
-            return true;
+    /* All the edges leaving a node must use the same mode */
+    for (const t_lb_trace::t_node& trace_node : rt.nodes) {
+        int cur_mode = -1;
+        for (int ichild = trace_node.first_child; ichild != OPEN; ichild = rt.nodes[ichild].next_sibling) {
+            int new_mode = get_lb_type_rr_graph_edge_mode(lb_type_graph,
+                                                          trace_node.current_node, rt.nodes[ichild].current_node);
+            if (cur_mode != -1 && cur_mode != new_mode) {
+                return true;
+            }
+            cur_mode = new_mode;
         }
-        cur_mode = new_mode;
     }
 
     return false;
 }
 
 // Check one edge for mode conflict.
-static bool check_edge_for_route_conflicts(std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map,
+static bool check_edge_for_route_conflicts(vtr::flat_hash_map<const t_pb_graph_node*, const t_mode*>* mode_map,
                                            const t_pb_graph_pin* driver_pin,
                                            const t_pb_graph_pin* pin) {
     if (driver_pin == nullptr) {
@@ -407,6 +424,7 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
     std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
     bool is_routed = false;
     bool is_impossible = false;
+    PackPhaseTimer phase_timer(g_vpr_ctx.mutable_cl_helper().pack_profile, e_pack_phase::INTRA_LB_ROUTE);
 
     mode_status->is_mode_conflict = false;
     mode_status->try_expand_all_modes = false;
@@ -420,15 +438,27 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
 
     /* Reset current routing */
     for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
-        free_lb_net_rt(lb_nets[inet].rt_tree);
-        lb_nets[inet].rt_tree = nullptr;
+        lb_nets[inet].rt_tree.clear();
     }
     for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
         router_data->lb_rr_node_stats[inode].historical_usage = 0;
         router_data->lb_rr_node_stats[inode].occ = 0;
     }
 
-    std::unordered_map<const t_pb_graph_node*, const t_mode*> mode_map;
+    /* The outcome of a route without mode expansion depends only on the signature, so a problem already found
+     * to be unroutable can be rejected without routing it again. Routable problems are still routed, since
+     * their routing is saved for this cluster. */
+    std::vector<int> signature;
+    if (!mode_status->expand_all_modes) {
+        signature = get_lb_route_signature(router_data);
+        if (unroutable_lb_routes.count(signature)) {
+            VTR_LOGV(verbosity > 3, "Proposed %s cluster is known to be unroutable\n", router_data->lb_type->name);
+            phase_timer.set_success(false);
+            return false;
+        }
+    }
+
+    vtr::flat_hash_map<const t_pb_graph_node*, const t_mode*> mode_map;
 
     /*	Iteratively remove congestion until a successful route is found.
      * Cap the total number of iterations tried so that if a solution does not exist, then the router won't run indefinitely */
@@ -442,8 +472,7 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
                 continue;
             }
             commit_remove_rt(lb_nets[idx].rt_tree, router_data, RT_REMOVE, &mode_map, mode_status);
-            free_lb_net_rt(lb_nets[idx].rt_tree);
-            lb_nets[idx].rt_tree = nullptr;
+            lb_nets[idx].rt_tree.clear();
             add_source_to_rt(router_data, idx);
 
             /* Route each sink of net */
@@ -531,13 +560,25 @@ bool try_intra_lb_route(t_lb_router_data* router_data,
 
         //Clean-up
         for (unsigned int inet = 0; inet < lb_nets.size(); inet++) {
-            free_lb_net_rt(lb_nets[inet].rt_tree);
-            lb_nets[inet].rt_tree = nullptr;
+            lb_nets[inet].rt_tree.clear();
+        }
+
+        //Mode issues make the caller retry differently (and may update the illegal modes), so only remember plain failures
+        if (!signature.empty() && !mode_status->is_mode_issue()) {
+            if (unroutable_lb_routes.size() >= MAX_UNROUTABLE_LB_ROUTES) {
+                unroutable_lb_routes.clear();
+            }
+            unroutable_lb_routes.insert(std::move(signature));
         }
     }
+    phase_timer.set_success(is_routed);
     return is_routed;
 }
 
+void reset_intra_lb_route_cache() {
+    unroutable_lb_routes.clear();
+}
+
 /*****************************************************************************************
  * Accessor Functions
  ******************************************************************************************/
@@ -550,7 +591,7 @@ t_pb_routes alloc_and_load_pb_route(const std::vector<t_intra_lb_net>* intra_lb_
     t_pb_routes pb_route;
 
     for (int inet = 0; inet < (int)lb_nets.size(); inet++) {
-        load_trace_to_pb_route(pb_route, total_pins, lb_nets[inet].atom_net_id, OPEN, lb_nets[inet].rt_tree);
+        load_trace_to_pb_route(pb_route, total_pins, lb_nets[inet].atom_net_id, lb_nets[inet].rt_tree);
     }
 
     return pb_route;
@@ -567,12 +608,6 @@ void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets) {
     if (intra_lb_nets == nullptr) {
         return;
     }
-    std::vector<t_intra_lb_net>& lb_nets = *intra_lb_nets;
-    for (unsigned int i = 0; i < lb_nets.size(); i++) {
-        lb_nets[i].terminals.clear();
-        free_lb_net_rt(lb_nets[i].rt_tree);
-        lb_nets[i].rt_tree = nullptr;
-    }
     delete intra_lb_nets;
 }
 
@@ -580,14 +615,23 @@ void free_intra_lb_nets(std::vector<t_intra_lb_net>* intra_lb_nets) {
  * Internal Functions
  ****************************************************************************/
 
-/* Recurse through route tree trace to populate pb pin to atom net lookup array */
-static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const int prev_pin_id, const t_lb_trace* trace) {
-    int ipin = trace->current_node;
-    int driver_pb_pin_id = prev_pin_id;
-    int cur_pin_id = OPEN;
-    if (ipin < total_pins) {
-        /* This routing node corresponds with a pin.  This node is virtual (ie. sink or source node) */
-        cur_pin_id = ipin;
+/* Walk the route tree trace to populate pb pin to atom net lookup array */
+static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins, const AtomNetId net_id, const t_lb_trace& trace) {
+    for (int itrace = trace.root(); itrace != OPEN; itrace = trace.next_preorder(itrace)) {
+        int ipin = trace.nodes[itrace].current_node;
+        if (ipin >= total_pins) {
+            continue;
+        }
+
+        /* This routing node corresponds with a pin.  This node is virtual (ie. sink or source node).
+         * It is driven by its parent if that is also a pin */
+        int driver_pb_pin_id = OPEN;
+        int iparent = trace.nodes[itrace].parent;
+        if (iparent != OPEN && trace.nodes[iparent].current_node < total_pins) {
+            driver_pb_pin_id = trace.nodes[iparent].current_node;
+        }
+
+        int cur_pin_id = ipin;
         if (!pb_route.count(ipin)) {
             pb_route.insert(std::make_pair(cur_pin_id, t_pb_route()));
             pb_route[cur_pin_id].atom_net_id = net_id;
@@ -596,30 +640,6 @@ static void load_trace_to_pb_route(t_pb_routes& pb_route, const int total_pins,
             VTR_ASSERT(pb_route[cur_pin_id].atom_net_id == net_id);
         }
     }
-    for (int itrace = 0; itrace < (int)trace->next_nodes.size(); itrace++) {
-        load_trace_to_pb_route(pb_route, total_pins, net_id, cur_pin_id, &trace->next_nodes[itrace]);
-    }
-}
-
-/* Free route tree for intra-logic block routing */
-static void free_lb_net_rt(t_lb_trace* lb_trace) {
-    if (lb_trace != nullptr) {
-        for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-            free_lb_trace(&lb_trace->next_nodes[i]);
-        }
-        lb_trace->next_nodes.clear();
-        delete lb_trace;
-    }
-}
-
-/* Free trace for intra-logic block routing */
-static void free_lb_trace(t_lb_trace* lb_trace) {
-    if (lb_trace != nullptr) {
-        for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-            free_lb_trace(&lb_trace->next_nodes[i]);
-        }
-        lb_trace->next_nodes.clear();
-    }
 }
 
 /* Given a pin of a net, assign route tree terminals for it
@@ -972,7 +992,7 @@ static void fix_duplicate_equivalent_pins(t_lb_router_data* router_data) {
 }
 
 /* Commit or remove route tree from currently routed solution */
-static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_commit_remove op, std::unordered_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status) {
+static void commit_remove_rt(const t_lb_trace& rt, t_lb_router_data* router_data, e_commit_remove op, vtr::flat_hash_map<const t_pb_graph_node*, const t_mode*>* mode_map, t_mode_selection_status* mode_status) {
     t_lb_rr_node_stats* lb_rr_node_stats;
     t_explored_node_tb* explored_node_tb;
     std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
@@ -982,70 +1002,56 @@ static void commit_remove_rt(t_lb_trace* rt, t_lb_router_data* router_data, e_co
     lb_rr_node_stats = router_data->lb_rr_node_stats;
     explored_node_tb = router_data->explored_node_tb;
 
-    if (rt == nullptr) {
-        return;
-    }
-
-    inode = rt->current_node;
+    /* Update the route tree nodes, parents before children */
+    for (int itrace = rt.root(); itrace != OPEN; itrace = rt.next_preorder(itrace)) {
+        inode = rt.nodes[itrace].current_node;
 
-    /* Determine if node is being used or removed */
-    if (op == RT_COMMIT) {
-        incr = 1;
-        if (lb_rr_node_stats[inode].occ >= lb_type_graph[inode].capacity) {
-            lb_rr_node_stats[inode].historical_usage += (lb_rr_node_stats[inode].occ - lb_type_graph[inode].capacity + 1); /* store historical overuse */
-        }
-    } else {
-        incr = -1;
-        explored_node_tb[inode].inet = OPEN;
-    }
-
-    lb_rr_node_stats[inode].occ += incr;
-    VTR_ASSERT(lb_rr_node_stats[inode].occ >= 0);
-
-    auto& driver_node = lb_type_graph[inode];
-    auto* driver_pin = driver_node.pb_graph_pin;
-
-    /* Recursively update route tree */
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
         // Check to see if there is no mode conflict between previous nets.
         // A conflict is present if there are differing modes between a pb_graph_node
         // and its children.
-        if (op == RT_COMMIT && mode_status->try_expand_all_modes) {
-            auto& node = lb_type_graph[rt->next_nodes[i].current_node];
-            auto* pin = node.pb_graph_pin;
+        int iparent = rt.nodes[itrace].parent;
+        if (op == RT_COMMIT && mode_status->try_expand_all_modes && iparent != OPEN) {
+            auto* driver_pin = lb_type_graph[rt.nodes[iparent].current_node].pb_graph_pin;
+            auto* pin = lb_type_graph[inode].pb_graph_pin;
 
             if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
                 mode_status->is_mode_conflict = true;
             }
         }
 
-        commit_remove_rt(&rt->next_nodes[i], router_data, op, mode_map, mode_status);
+        /* Determine if node is being used or removed */
+        if (op == RT_COMMIT) {
+            incr = 1;
+            if (lb_rr_node_stats[inode].occ >= lb_type_graph[inode].capacity) {
+                lb_rr_node_stats[inode].historical_usage += (lb_rr_node_stats[inode].occ - lb_type_graph[inode].capacity + 1); /* store historical overuse */
+            }
+        } else {
+            incr = -1;
+            explored_node_tb[inode].inet = OPEN;
+        }
+
+        lb_rr_node_stats[inode].occ += incr;
+        VTR_ASSERT(lb_rr_node_stats[inode].occ >= 0);
     }
 }
 
 /* Should net be skipped?  If the net does not conflict with another net, then skip routing this net */
-static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data) {
+static bool is_skip_route_net(const t_lb_trace& rt, t_lb_router_data* router_data) {
     t_lb_rr_node_stats* lb_rr_node_stats;
     std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
-    int inode;
 
     lb_rr_node_stats = router_data->lb_rr_node_stats;
 
-    if (rt == nullptr) {
+    if (rt.empty()) {
         return false; /* Net is not routed, therefore must route net */
     }
 
-    inode = rt->current_node;
+    for (const t_lb_trace::t_node& trace_node : rt.nodes) {
+        int inode = trace_node.current_node;
 
-    /* Determine if node is overused */
-    if (lb_rr_node_stats[inode].occ > lb_type_graph[inode].capacity) {
-        /* Conflict between this net and another net at this node, reroute net */
-        return false;
-    }
-
-    /* Recursively check that rest of route tree does not have a conflict */
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-        if (!is_skip_route_net(&rt->next_nodes[i], router_data)) {
+        /* Determine if node is overused */
+        if (lb_rr_node_stats[inode].occ > lb_type_graph[inode].capacity) {
+            /* Conflict between this net and another net at this node, reroute net */
             return false;
         }
     }
@@ -1056,37 +1062,33 @@ static bool is_skip_route_net(t_lb_trace* rt, t_lb_router_data* router_data) {
 
 /* At source mode as starting point to existing route tree */
 static void add_source_to_rt(t_lb_router_data* router_data, int inet) {
-    VTR_ASSERT((*router_data->intra_lb_nets)[inet].rt_tree == nullptr);
-    (*router_data->intra_lb_nets)[inet].rt_tree = new t_lb_trace;
-    (*router_data->intra_lb_nets)[inet].rt_tree->current_node = (*router_data->intra_lb_nets)[inet].terminals[0];
+    t_intra_lb_net& lb_net = (*router_data->intra_lb_nets)[inet];
+    VTR_ASSERT(lb_net.rt_tree.empty());
+    lb_net.rt_tree.add_node(lb_net.terminals[0], OPEN);
 }
 
 /* Expand all nodes found in route tree into priority queue */
 static void expand_rt(t_lb_router_data* router_data, int inet, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net) {
-    std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
-
-    VTR_ASSERT(pq.empty());
-
-    expand_rt_rec(lb_nets[inet].rt_tree, OPEN, router_data->explored_node_tb, pq, irt_net, router_data->explore_id_index);
-}
-
-/* Expand all nodes found in route tree into priority queue recursively */
-static void expand_rt_rec(t_lb_trace* rt, int prev_index, t_explored_node_tb* explored_node_tb, reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node>& pq, int irt_net, int explore_id_index) {
+    const t_lb_trace& rt = (*router_data->intra_lb_nets)[inet].rt_tree;
+    t_explored_node_tb* explored_node_tb = router_data->explored_node_tb;
     t_expansion_node enode;
 
-    /* Perhaps should use a cost other than zero */
-    enode.cost = 0;
-    enode.node_index = rt->current_node;
-    enode.prev_index = prev_index;
-    pq.push(enode);
-    explored_node_tb[enode.node_index].inet = irt_net;
-    explored_node_tb[enode.node_index].explored_id = OPEN;
-    explored_node_tb[enode.node_index].enqueue_id = explore_id_index;
-    explored_node_tb[enode.node_index].enqueue_cost = 0;
-    explored_node_tb[enode.node_index].prev_index = prev_index;
+    VTR_ASSERT(pq.empty());
 
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-        expand_rt_rec(&rt->next_nodes[i], rt->current_node, explored_node_tb, pq, irt_net, explore_id_index);
+    for (int itrace = rt.root(); itrace != OPEN; itrace = rt.next_preorder(itrace)) {
+        int iparent = rt.nodes[itrace].parent;
+        int prev_index = (iparent == OPEN) ? OPEN : rt.nodes[iparent].current_node;
+
+        /* Perhaps should use a cost other than zero */
+        enode.cost = 0;
+        enode.node_index = rt.nodes[itrace].current_node;
+        enode.prev_index = prev_index;
+        pq.push(enode);
+        explored_node_tb[enode.node_index].inet = irt_net;
+        explored_node_tb[enode.node_index].explored_id = OPEN;
+        explored_node_tb[enode.node_index].enqueue_id = router_data->explore_id_index;
+        explored_node_tb[enode.node_index].enqueue_cost = 0;
+        explored_node_tb[enode.node_index].prev_index = prev_index;
     }
 }
 
@@ -1204,12 +1206,11 @@ static void expand_node_all_modes(t_lb_router_data* router_data, t_expansion_nod
 }
 
 /* Add new path from existing route tree to target sink */
-static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_data, int irt_net) {
+static bool add_to_rt(t_lb_trace& rt, int node_index, t_lb_router_data* router_data, int irt_net) {
     t_explored_node_tb* explored_node_tb = router_data->explored_node_tb;
     std::vector<int> trace_forward;
     int rt_index, trace_index;
-    t_lb_trace* link_node;
-    t_lb_trace curr_node;
+    int link_node;
 
     /* Store path all the way back to route tree */
     rt_index = node_index;
@@ -1221,17 +1222,15 @@ static bool add_to_rt(t_lb_trace* rt, int node_index, t_lb_router_data* router_d
 
     /* Find rt_index on the route tree */
     link_node = find_node_in_rt(rt, rt_index);
-    if (link_node == nullptr) {
-        VTR_LOG("Link node is nullptr. Routing impossible");
+    if (link_node == OPEN) {
+        VTR_LOG("Link node is not on the route tree. Routing impossible");
         return true;
     }
 
     /* Add path to root tree */
     while (!trace_forward.empty()) {
         trace_index = trace_forward.back();
-        curr_node.current_node = trace_index;
-        link_node->next_nodes.push_back(curr_node);
-        link_node = &link_node->next_nodes.back();
+        link_node = rt.add_node(trace_index, link_node);
         trace_forward.pop_back();
     }
 
@@ -1251,20 +1250,14 @@ static bool is_route_success(t_lb_router_data* router_data) {
     return true;
 }
 
-/* Given a route tree and an index of a node on the route tree, return a pointer to the trace corresponding to that index */
-static t_lb_trace* find_node_in_rt(t_lb_trace* rt, int rt_index) {
-    t_lb_trace* cur;
-    if (rt->current_node == rt_index) {
-        return rt;
-    } else {
-        for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-            cur = find_node_in_rt(&rt->next_nodes[i], rt_index);
-            if (cur != nullptr) {
-                return cur;
-            }
+/* Given a route tree and an index of a node on the route tree, return the trace node corresponding to that index (or OPEN) */
+static int find_node_in_rt(const t_lb_trace& rt, int rt_index) {
+    for (int itrace = rt.root(); itrace != OPEN; itrace = rt.next_preorder(itrace)) {
+        if (rt.nodes[itrace].current_node == rt_index) {
+            return itrace;
         }
     }
-    return nullptr;
+    return OPEN;
 }
 
 #ifdef PRINT_INTRA_LB_ROUTE
@@ -1299,21 +1292,22 @@ static void print_route(FILE* fp, t_lb_router_data* router_data) {
 #endif
 
 /* Debug routine, print out trace of net */
-static void print_trace(FILE* fp, t_lb_trace* trace, t_lb_router_data* router_data) {
-    if (trace == NULL) {
+static void print_trace(FILE* fp, const t_lb_trace& trace, t_lb_router_data* router_data) {
+    if (trace.empty()) {
         fprintf(fp, "NULL");
         return;
     }
-    for (unsigned int ibranch = 0; ibranch < trace->next_nodes.size(); ibranch++) {
-        auto current_node = trace->current_node;
+    /* Print the edge into each non-root trace node, in depth-first order */
+    for (int itrace = trace.next_preorder(trace.root()); itrace != OPEN; itrace = trace.next_preorder(itrace)) {
+        const t_lb_trace::t_node& parent = trace.nodes[trace.nodes[itrace].parent];
+        auto current_node = parent.current_node;
         auto current_str = describe_lb_type_rr_node(current_node, router_data);
-        auto next_node = trace->next_nodes[ibranch].current_node;
+        auto next_node = trace.nodes[itrace].current_node;
         auto next_str = describe_lb_type_rr_node(next_node, router_data);
-        if (trace->next_nodes.size() > 1) {
+        if (parent.first_child != parent.last_child) {
             fprintf(fp, "\n\tB");
         }
         fprintf(fp, "(%d:%s-->%d:%s) ", current_node, current_str.c_str(), next_node, next_str.c_str());
-        print_trace(fp, &trace->next_nodes[ibranch], router_data);
     }
 }
 
@@ -1351,8 +1345,7 @@ static void save_and_reset_lb_route(t_lb_router_data* router_data) {
         for (int iterm = 0; iterm < (int)lb_nets[inet].terminals.size(); iterm++) {
             saved_lb_nets[inet].terminals[iterm] = lb_nets[inet].terminals[iterm];
         }
-        saved_lb_nets[inet].rt_tree = lb_nets[inet].rt_tree;
-        lb_nets[inet].rt_tree = nullptr;
+        std::swap(saved_lb_nets[inet].rt_tree, lb_nets[inet].rt_tree);
     }
 }
 
@@ -1447,20 +1440,8 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
         AtomNetId atom_net = lb_nets[inet].atom_net_id;
 
         //Walk the lb_traceback to find congested RR nodes for each net
-        std::queue<t_lb_trace> q;
-
-        if (lb_nets[inet].rt_tree) {
-            q.push(*lb_nets[inet].rt_tree);
-        }
-        while (!q.empty()) {
-            t_lb_trace curr = q.front();
-            q.pop();
-
-            for (const t_lb_trace& next_trace : curr.next_nodes) {
-                q.push(next_trace);
-            }
-
-            int inode = curr.current_node;
+        for (const t_lb_trace::t_node& trace_node : lb_nets[inet].rt_tree.nodes) {
+            int inode = trace_node.current_node;
             const t_lb_type_rr_node& rr_node = lb_type_graph[inode];
             const t_lb_rr_node_stats& rr_node_stats = lb_rr_node_stats[inode];
 
@@ -1493,6 +1474,32 @@ static std::string describe_congested_rr_nodes(const std::vector<int>& congested
     return description;
 }
 
+/* Returns a canonical description of the routing problem of router_data: the logic block type, the terminals
+ * of each net (in routing order), and the rr nodes whose mode is forced by the pbs in the cluster */
+static std::vector<int> get_lb_route_signature(const t_lb_router_data* router_data) {
+    const std::vector<t_intra_lb_net>& lb_nets = *router_data->intra_lb_nets;
+    const std::vector<t_lb_type_rr_node>& lb_type_graph = *router_data->lb_type_graph;
+
+    std::vector<int> signature;
+    signature.push_back(router_data->lb_type->index);
+
+    for (const t_intra_lb_net& lb_net : lb_nets) {
+        signature.push_back(lb_net.terminals.size());
+        signature.insert(signature.end(), lb_net.terminals.begin(), lb_net.terminals.end());
+    }
+
+    //Nets and modes are separated by OPEN, which no terminal count can be
+    signature.push_back(OPEN);
+    for (unsigned int inode = 0; inode < lb_type_graph.size(); inode++) {
+        if (router_data->lb_rr_node_stats[inode].mode != -1) {
+            signature.push_back(inode);
+            signature.push_back(router_data->lb_rr_node_stats[inode].mode);
+        }
+    }
+
+    return signature;
+}
+
 void reset_intra_lb_route(t_lb_router_data* router_data) {
     for (auto& node : *router_data->lb_type_graph) {
         auto* pin = node.pb_graph_pin;
@@ -21,6 +21,7 @@ void remove_atom_from_target(t_lb_router_data* router_data, const AtomBlockId bl
 void set_reset_pb_modes(t_lb_router_data* router_data, const t_pb* pb, const bool set);
 bool try_intra_lb_route(t_lb_router_data* router_data, int verbosity, t_mode_selection_status* mode_status);
 void reset_intra_lb_route(t_lb_router_data* router_data);
+void reset_intra_lb_route_cache();
 
 /* Accessor Functions */
 t_pb_routes alloc_and_load_pb_route(const std::vector<t_intra_lb_net>* intra_lb_nets, t_pb_graph_node* pb_graph_head);
@@ -7,6 +7,11 @@
 #include "vtr_math.h"
 #include "SetupGrid.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#    include <tbb/parallel_sort.h>
+#endif
+
 /**********************************/
 /* Global variables in clustering */
 /**********************************/
@@ -186,11 +191,20 @@ void calc_init_packing_timing(const t_packer_opts& packer_opts,
      * Initialize the timing analyzer
      */
     clustering_delay_calc = std::make_shared<PreClusterDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, packer_opts.inter_cluster_net_delay, expected_lowest_cost_pb_gnode);
-    timing_info = make_setup_timing_info(clustering_delay_calc, packer_opts.timing_update_type);
+
+    //Periodic updates during clustering each touch few edges, which is what the incremental analyzer is for
+    e_timing_update_type update_type = packer_opts.timing_update_type;
+    if (update_type == e_timing_update_type::AUTO && packer_opts.timing_update_interval > 0) {
+        update_type = e_timing_update_type::INCREMENTAL;
+    }
+    timing_info = make_setup_timing_info(clustering_delay_calc, update_type);
 
     //Calculate the initial timing
     timing_info->update();
 
+    //Unconstrained endpoints were reported by the initial analysis, don't repeat it on every update
+    timing_info->set_warn_unconstrained(false);
+
     if (isEchoFileEnabled(E_ECHO_PRE_PACKING_TIMING_GRAPH)) {
         auto& timing_ctx = g_vpr_ctx.timing();
         tatum::write_echo(getEchoFileName(E_ECHO_PRE_PACKING_TIMING_GRAPH),
@@ -226,6 +240,83 @@ void calc_init_packing_timing(const t_packer_opts& packer_opts,
     }
 }
 
+//Records that the PartitionRegion of partid is about to be intersected into the cluster's PartitionRegion
+static void update_cluster_partitions(const ClusterBlockId clb_index, const PartitionId partid) {
+    auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
+    if (size_t(clb_index) >= floorplanning_ctx.cluster_partitions.size()) {
+        return;
+    }
+
+    //The partitions are unknown if the cluster was constrained before they were tracked
+    std::vector<PartitionId>& cluster_partitions = floorplanning_ctx.cluster_partitions[clb_index];
+    if (cluster_partitions.empty() && !floorplanning_ctx.cluster_constraints[clb_index].empty()) {
+        return;
+    }
+    cluster_partitions.push_back(partid);
+}
+
+//Collects the atom blocks packed in pb and its children
+static void collect_pb_atoms(const t_pb* pb, std::vector<AtomBlockId>& atoms) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+    const t_pb_type* pb_type = pb->pb_graph_node->pb_type;
+
+    if (pb_type->num_modes == 0) {
+        AtomBlockId blk_id = atom_ctx.lookup.pb_atom(pb);
+        if (blk_id) {
+            atoms.push_back(blk_id);
+        }
+        return;
+    }
+
+    if (pb->child_pbs == nullptr) {
+        return;
+    }
+    for (int i = 0; i < pb_type->modes[pb->mode].num_pb_type_children; i++) {
+        if (pb->child_pbs[i] == nullptr) continue;
+        for (int j = 0; j < pb_type->modes[pb->mode].pb_type_children[i].num_pb; j++) {
+            if (pb->child_pbs[i][j].name != nullptr) {
+                collect_pb_atoms(&pb->child_pbs[i][j], atoms);
+            }
+        }
+    }
+}
+
+/*
+ * The nets between atoms of the same cluster now have an intra-cluster delay (see PreClusterDelayCalculator),
+ * so the interconnect edges driving their sinks must be re-analyzed.
+ */
+int invalidate_absorbed_net_timing(const ClusterBlockId clb_index, SetupTimingInfo& timing_info) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& timing_graph = *g_vpr_ctx.timing().graph;
+
+    std::vector<AtomBlockId> atoms;
+    collect_pb_atoms(cluster_ctx.clb_nlist.block_pb(clb_index), atoms);
+
+    int num_invalidated = 0;
+    for (AtomBlockId blk_id : atoms) {
+        for (AtomPinId sink_pin : atom_ctx.nlist.block_input_pins(blk_id)) {
+            AtomNetId net_id = atom_ctx.nlist.pin_net(sink_pin);
+            AtomBlockId driver_blk = atom_ctx.nlist.pin_block(atom_ctx.nlist.net_driver(net_id));
+            if (atom_ctx.lookup.atom_clb(driver_blk) != clb_index) {
+                continue;
+            }
+
+            tatum::NodeId sink_tnode = atom_ctx.lookup.atom_pin_tnode(sink_pin);
+            if (!sink_tnode) continue;
+
+            for (tatum::EdgeId edge : timing_graph.node_in_edges(sink_tnode)) {
+                if (timing_graph.edge_type(edge) == tatum::EdgeType::INTERCONNECT) {
+                    timing_info.invalidate_delay(edge);
+                    ++num_invalidated;
+                }
+            }
+        }
+    }
+
+    return num_invalidated;
+}
+
 //Free the clustering data structures
 void free_clustering_data(const t_packer_opts& packer_opts,
                           t_clustering_data& clustering_data) {
@@ -327,8 +418,7 @@ void print_pack_status(int num_clb,
                        int num_molecules_processed,
                        int& mols_since_last_print,
                        int device_width,
-                       int device_height,
-                       AttractionInfo& attraction_groups) {
+                       int device_height) {
     //Print a packing update each time another 4% of molecules have been packed.
     const float print_frequency = 0.04;
 
@@ -353,33 +443,6 @@ void print_pack_status(int num_clb,
         VTR_LOG("\n");
         fflush(stdout);
         mols_since_last_print = 0;
-        if (attraction_groups.num_attraction_groups() > 0) {
-            rebuild_attraction_groups(attraction_groups);
-        }
-    }
-}
-
-/*
- * Periodically rebuild the attraction groups to reflect which atoms in them
- * are still available for new clusters (i.e. remove the atoms that have already
- * been packed from the attraction group).
- */
-void rebuild_attraction_groups(AttractionInfo& attraction_groups) {
-    auto& atom_ctx = g_vpr_ctx.atom();
-
-    for (int igroup = 0; igroup < attraction_groups.num_attraction_groups(); igroup++) {
-        AttractGroupId group_id(igroup);
-        AttractionGroup& group = attraction_groups.get_attraction_group_info(group_id);
-        AttractionGroup new_att_group_info;
-
-        for (AtomBlockId atom : group.group_atoms) {
-            //If the ClusterBlockId is anything other than invalid, the atom has been packed already
-            if (atom_ctx.lookup.atom_clb(atom) == ClusterBlockId::INVALID()) {
-                new_att_group_info.group_atoms.push_back(atom);
-            }
-        }
-
-        attraction_groups.set_attraction_group_info(group_id, new_att_group_info);
     }
 }
 
@@ -427,7 +490,7 @@ void remove_molecule_from_pb_stats_candidates(t_pack_molecule* molecule,
 
 /* Add blk to list of feasible blocks sorted according to gain */
 void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                         std::map<AtomBlockId, float>& gain,
+                                         vtr::stamped_id_map<AtomBlockId, float>& gain,
                                          t_pb* pb,
                                          int max_queue_size,
                                          AttractionInfo& attraction_groups) {
@@ -441,11 +504,10 @@ void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
      * more molecules helps to achieve this purpose.
      */
     if (attraction_groups.num_attraction_groups() > 0) {
-        auto got = pb->pb_stats->atom_failures.find(molecule->atom_block_ids[0]);
-        if (got == pb->pb_stats->atom_failures.end()) {
+        if (pb->pb_stats->atom_failures.count(molecule->atom_block_ids[0]) == 0) {
             num_molecule_failures = 0;
         } else {
-            num_molecule_failures = got->second;
+            num_molecule_failures = pb->pb_stats->atom_failures[molecule->atom_block_ids[0]];
         }
 
         if (num_molecule_failures > 0) {
@@ -779,7 +841,7 @@ t_pack_molecule* get_free_molecule_with_most_ext_inputs_for_cluster(t_pb* cur_pb
     int inputs_avail = 0;
 
     for (int i = 0; i < cur_pb->pb_graph_node->num_input_pin_class; i++) {
-        inputs_avail += cur_pb->pb_stats->input_pins_used[i].size();
+        inputs_avail += cur_pb->pb_stats->input_pins_used[i];
     }
 
     t_pack_molecule* molecule = nullptr;
@@ -809,10 +871,11 @@ void alloc_and_load_pb_stats(t_pb* pb, const int feasible_block_array_size) {
      * only those atom block structures will be fastest.  If almost all blocks    *
      * have been touched it should be faster to just run through them all    *
      * in order (less addressing and better cache locality).                 */
-    pb->pb_stats->input_pins_used = std::vector<std::unordered_map<size_t, AtomNetId>>(pb->pb_graph_node->num_input_pin_class);
-    pb->pb_stats->output_pins_used = std::vector<std::unordered_map<size_t, AtomNetId>>(pb->pb_graph_node->num_output_pin_class);
-    pb->pb_stats->lookahead_input_pins_used = std::vector<std::vector<AtomNetId>>(pb->pb_graph_node->num_input_pin_class);
-    pb->pb_stats->lookahead_output_pins_used = std::vector<std::vector<AtomNetId>>(pb->pb_graph_node->num_output_pin_class);
+    pb->pb_stats->input_pins_used = std::vector<int>(pb->pb_graph_node->num_input_pin_class, 0);
+    pb->pb_stats->output_pins_used = std::vector<int>(pb->pb_graph_node->num_output_pin_class, 0);
+    pb->pb_stats->lookahead_input_pins_used = std::vector<int>(pb->pb_graph_node->num_input_pin_class, 0);
+    pb->pb_stats->lookahead_output_pins_used = std::vector<int>(pb->pb_graph_node->num_output_pin_class, 0);
+    pb->pb_stats->num_lookahead_atoms = 0;
     pb->pb_stats->num_feasible_blocks = NOT_VALID;
     pb->pb_stats->feasible_blocks = new t_pack_molecule*[feasible_block_array_size];
 
@@ -830,6 +893,9 @@ void alloc_and_load_pb_stats(t_pb* pb, const int feasible_block_array_size) {
     pb->pb_stats->sharinggain.clear();
     pb->pb_stats->hillgain.clear();
     pb->pb_stats->transitive_fanout_candidates.clear();
+    pb->pb_stats->num_transitive_explored_nets = 0;
+    pb->pb_stats->transitive_cluster_atoms.clear();
+    pb->pb_stats->high_fanout_net_first_unpacked_pin.clear();
 
     pb->pb_stats->num_pins_of_net_in_pb.clear();
 
@@ -941,6 +1007,7 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
 
     auto& atom_ctx = g_vpr_ctx.atom();
     auto& floorplanning_ctx = g_vpr_ctx.mutable_floorplanning();
+    PackPhaseTimer phase_timer(g_vpr_ctx.mutable_cl_helper().pack_profile, e_pack_phase::TRY_PACK_MOLECULE);
     parent = nullptr;
 
     block_pack_status = BLK_STATUS_UNDEFINED;
@@ -969,11 +1036,13 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
         VTR_LOGV(verbosity > 4, "\t\t\tFAILED Placement Feasibility Filter: Only one long chain per cluster is allowed\n");
         //Record the failure of this molecule in the current pb stats
         record_molecule_failure(molecule, pb);
+        phase_timer.set_success(false);
         return BLK_FAILED_FEASIBLE;
     }
 
     bool cluster_pr_needs_update = false;
     bool cluster_pr_update_check = false;
+    PartitionId cluster_pr_partition = PartitionId::INVALID(); //Partition intersected into temp_cluster_pr
 
     //check if every atom in the molecule is legal in the cluster from a floorplanning perspective
     for (int i_mol = 0; i_mol < molecule_size; i_mol++) {
@@ -986,10 +1055,12 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
             if (block_pack_status == BLK_FAILED_FLOORPLANNING) {
                 //Record the failure of this molecule in the current pb stats
                 record_molecule_failure(molecule, pb);
+                phase_timer.set_success(false);
                 return block_pack_status;
             }
             if (cluster_pr_needs_update == true) {
                 cluster_pr_update_check = true;
+                cluster_pr_partition = floorplanning_ctx.constraints.get_atom_partition(molecule->atom_block_ids[i_mol]);
             }
         }
     }
@@ -1017,8 +1088,7 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
 
             if (enable_pin_feasibility_filter && block_pack_status == BLK_PASSED) {
                 /* Check if pin usage is feasible for the current packing assignment */
-                reset_lookahead_pins_used(pb);
-                try_update_lookahead_pins_used(pb);
+                update_lookahead_pins_used(pb, molecule);
                 if (!check_lookahead_pins_used(pb, max_external_pin_util)) {
                     VTR_LOGV(verbosity > 4, "\t\t\tFAILED Pin Feasibility Filter\n");
                     block_pack_status = BLK_FAILED_FEASIBLE;
@@ -1073,6 +1143,9 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
                      * TODO: SW Engineering note - may want to update cluster stats here too instead of doing it outside
                      */
                     VTR_ASSERT(block_pack_status == BLK_PASSED);
+                    if (enable_pin_feasibility_filter) {
+                        commit_lookahead_pins_used(pb);
+                    }
                     if (molecule->is_chain()) {
                         /* Chained molecules often take up lots of area and are important,
                          * if a chain is packed in, want to rename logic block to match chain name */
@@ -1098,6 +1171,7 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
 
                     //update cluster PartitionRegion if atom with floorplanning constraints was added
                     if (cluster_pr_update_check) {
+                        update_cluster_partitions(clb_index, cluster_pr_partition);
                         floorplanning_ctx.cluster_constraints[clb_index] = temp_cluster_pr;
                         if (verbosity > 2) {
                             VTR_LOG("\nUpdated PartitionRegion of cluster %d\n", clb_index);
@@ -1121,6 +1195,9 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
             }
 
             if (block_pack_status != BLK_PASSED) {
+                if (enable_pin_feasibility_filter) {
+                    revert_lookahead_pins_used(pb);
+                }
                 for (i = 0; i < failed_location; i++) {
                     if (molecule->atom_block_ids[i]) {
                         remove_atom_from_target(router_data, molecule->atom_block_ids[i]);
@@ -1149,6 +1226,7 @@ enum e_block_pack_status try_pack_molecule(t_cluster_placement_stats* cluster_pl
             break; /* no more candidate primitives available, this molecule will not pack, return fail */
         }
     }
+    phase_timer.set_success(block_pack_status == BLK_PASSED);
     return block_pack_status;
 }
 
@@ -1160,12 +1238,8 @@ void record_molecule_failure(t_pack_molecule* molecule, t_pb* pb) {
     //The convention when checking if a molecule has failed to pack in the cluster
     //is to check whether the first atoms has been recorded as having failed
 
-    auto got = pb->pb_stats->atom_failures.find(molecule->atom_block_ids[0]);
-    if (got == pb->pb_stats->atom_failures.end()) {
-        pb->pb_stats->atom_failures.insert({molecule->atom_block_ids[0], 1});
-    } else {
-        got->second++;
-    }
+    //A new entry starts at zero failures
+    pb->pb_stats->atom_failures[molecule->atom_block_ids[0]]++;
 }
 
 /**
@@ -1318,9 +1392,6 @@ enum e_block_pack_status atom_cluster_floorplanning_check(const AtomBlockId blk_
     PartitionId partid;
     partid = floorplanning_ctx.constraints.get_atom_partition(blk_id);
 
-    PartitionRegion atom_pr;
-    PartitionRegion cluster_pr;
-
     //if the atom does not belong to a partition, it can be put in the cluster
     //regardless of what the cluster's PartitionRegion is because it has no constraints
     if (partid == PartitionId::INVALID()) {
@@ -1331,10 +1402,10 @@ enum e_block_pack_status atom_cluster_floorplanning_check(const AtomBlockId blk_
         return BLK_PASSED;
     } else {
         //get pr of that partition
-        atom_pr = floorplanning_ctx.constraints.get_partition_pr(partid);
+        const PartitionRegion& atom_pr = floorplanning_ctx.constraints.get_partition_pr(partid);
 
         //intersect it with the pr of the current cluster
-        cluster_pr = floorplanning_ctx.cluster_constraints[clb_index];
+        const PartitionRegion& cluster_pr = floorplanning_ctx.cluster_constraints[clb_index];
 
         if (cluster_pr.empty() == true) {
             temp_cluster_pr = atom_pr;
@@ -1343,13 +1414,33 @@ enum e_block_pack_status atom_cluster_floorplanning_check(const AtomBlockId blk_
                 VTR_LOG("\t\t\t Intersect: Atom block %d has floorplanning constraints, passed cluster %d which has empty PR\n", blk_id, clb_index);
             }
             return BLK_PASSED;
+        }
+
+        //if the cluster's PartitionRegion is the intersection of partitions including the atom's,
+        //intersecting it with the atom's PartitionRegion would not change it
+        const std::vector<PartitionId>* cluster_partitions = nullptr;
+        if (size_t(clb_index) < floorplanning_ctx.cluster_partitions.size()) {
+            cluster_partitions = &floorplanning_ctx.cluster_partitions[clb_index];
+        }
+        if (cluster_partitions && std::find(cluster_partitions->begin(), cluster_partitions->end(), partid) != cluster_partitions->end()) {
+            if (verbosity > 3) {
+                VTR_LOG("\t\t\t Intersect: Atom block %d passed cluster %d, which is already constrained to its partition\n", blk_id, clb_index);
+            }
+            cluster_pr_needs_update = false;
+            return BLK_PASSED;
+        }
+
+        //update cluster_pr with the intersection of the cluster's PartitionRegion
+        //and the atom's PartitionRegion (cached when the cluster is constrained to a single partition)
+        PartitionRegion intersect_pr;
+        const PartitionRegion* new_cluster_pr = &intersect_pr;
+        if (cluster_partitions && cluster_partitions->size() == 1) {
+            new_cluster_pr = &floorplanning_ctx.constraints.get_partition_pair_intersection((*cluster_partitions)[0], partid);
         } else {
-            //update cluster_pr with the intersection of the cluster's PartitionRegion
-            //and the atom's PartitionRegion
-            update_cluster_part_reg(cluster_pr, atom_pr);
+            intersect_pr = intersection(cluster_pr, atom_pr);
         }
 
-        if (cluster_pr.empty() == true) {
+        if (new_cluster_pr->empty() == true) {
             if (verbosity > 3) {
                 VTR_LOG("\t\t\t Intersect: Atom block %d failed floorplanning check for cluster %d \n", blk_id, clb_index);
             }
@@ -1357,7 +1448,7 @@ enum e_block_pack_status atom_cluster_floorplanning_check(const AtomBlockId blk_
             return BLK_FAILED_FLOORPLANNING;
         } else {
             //update the cluster's PartitionRegion with the intersecting PartitionRegion
-            temp_cluster_pr = cluster_pr;
+            temp_cluster_pr = *new_cluster_pr;
             cluster_pr_needs_update = true;
             if (verbosity > 3) {
                 VTR_LOG("\t\t\t Intersect: Atom block %d passed cluster %d, cluster PR was updated with intersection result \n", blk_id, clb_index);
@@ -1587,8 +1678,7 @@ void try_fill_cluster(const t_packer_opts& packer_opts,
                       cluster_stats.num_molecules_processed,
                       cluster_stats.mols_since_last_print,
                       device_ctx.grid.width(),
-                      device_ctx.grid.height(),
-                      attraction_groups);
+                      device_ctx.grid.height());
 
     update_cluster_stats(next_molecule, clb_index,
                          is_clock, //Set of all clocks
@@ -1705,6 +1795,7 @@ void update_timing_gain_values(const AtomNetId net_id,
     float timinggain;
 
     auto& atom_ctx = g_vpr_ctx.atom();
+    PackPhaseTimer phase_timer(g_vpr_ctx.mutable_cl_helper().pack_profile, e_pack_phase::TIMING_GAIN_UPDATE);
 
     /* Check if this atom net lists its driving atom block twice.  If so, avoid  *
      * double counting this atom block by skipping the first (driving) pin. */
@@ -1942,6 +2033,9 @@ void update_cluster_stats(const t_pack_molecule* molecule,
 
         //Update attraction group
         AttractGroupId atom_grp_id = attraction_groups.get_atom_attraction_group(blk_id);
+        if (atom_grp_id != AttractGroupId::INVALID()) {
+            attraction_groups.update_att_group_for_packed_atom(blk_id);
+        }
 
         while (cur_pb) {
             /* reset list of feasible blocks */
@@ -2015,8 +2109,6 @@ void update_cluster_stats(const t_pack_molecule* molecule,
 
         update_total_gain(alpha, beta, timing_driven, connection_driven,
                           atom_pb->parent_pb, attraction_groups);
-
-        commit_lookahead_pins_used(cb);
     }
 
     // if this molecule came from the transitive fanout candidates remove it
@@ -2057,6 +2149,7 @@ void start_new_cluster(t_cluster_placement_stats* cluster_placement_stats,
     /*Cluster's PartitionRegion is empty initially, meaning it has no floorplanning constraints*/
     PartitionRegion empty_pr;
     floorplanning_ctx.cluster_constraints.push_back(empty_pr);
+    floorplanning_ctx.cluster_partitions.resize(floorplanning_ctx.cluster_constraints.size());
 
     /* Allocate a dummy initial cluster and load a atom block as a seed and check if it is legal */
     AtomBlockId root_atom = molecule->atom_block_ids[molecule->root];
@@ -2182,7 +2275,10 @@ void start_new_cluster(t_cluster_placement_stats* cluster_placement_stats,
         num_instances += device_ctx.grid.num_instances(equivalent_tile, -1);
     }
 
-    if (num_used_type_instances[block_type] > num_instances) {
+    //A fixed device layout does not grow (and its grid may already be in use by the device
+    //creation overlapped with packing), so it is not re-created
+    bool fixed_device = device_layout_name != "auto" && device_ctx.grid.name() == device_layout_name;
+    if (num_used_type_instances[block_type] > num_instances && !fixed_device) {
         device_ctx.grid = create_device_grid(device_layout_name, arch->grid_layouts, num_used_type_instances, target_device_utilization);
     }
 }
@@ -2215,6 +2311,8 @@ t_pack_molecule* get_highest_gain_molecule(t_pb* cur_pb,
                         "Hill climbing not supported yet, error out.\n");
     }
 
+    PackPhaseTimer phase_timer(g_vpr_ctx.mutable_cl_helper().pack_profile, e_pack_phase::CANDIDATE_GATHERING);
+
     // 1. Find unpacked molecules based on criticality and strong connectedness (connected by low fanout nets) with current cluster
     if (cur_pb->pb_stats->num_feasible_blocks == NOT_VALID) {
         add_cluster_molecule_candidates_by_connectivity_and_timing(cur_pb, cluster_placement_stats_ptr, feasible_block_array_size, attraction_groups);
@@ -2249,6 +2347,8 @@ t_pack_molecule* get_highest_gain_molecule(t_pb* cur_pb,
         add_cluster_molecule_candidates_by_attraction_group(cur_pb, cluster_placement_stats_ptr, attraction_groups,
                                                             feasible_block_array_size, cluster_index, primitive_candidate_block_types);
     }
+    phase_timer.set_success(cur_pb->pb_stats->num_feasible_blocks > 0);
+
     /* Grab highest gain molecule */
     t_pack_molecule* molecule = nullptr;
     if (cur_pb->pb_stats->num_feasible_blocks > 0) {
@@ -2305,15 +2405,26 @@ void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
 
     auto& atom_ctx = g_vpr_ctx.atom();
 
+    /* Blocks stay packed while the cluster is open, so the leading run of packed
+     * pins is skipped the next time this net is explored */
+    auto net_pins = atom_ctx.nlist.net_pins(net_id);
+    size_t& first_unpacked_pin = cur_pb->pb_stats->high_fanout_net_first_unpacked_pin[net_id];
+    bool leading_packed = true;
+
     int count = 0;
-    for (auto pin_id : atom_ctx.nlist.net_pins(net_id)) {
+    for (size_t ipin = first_unpacked_pin; ipin < net_pins.size(); ipin++) {
         if (count >= AAPACK_MAX_HIGH_FANOUT_EXPLORE) {
             break;
         }
 
-        AtomBlockId blk_id = atom_ctx.nlist.pin_block(pin_id);
+        AtomBlockId blk_id = atom_ctx.nlist.pin_block(*(net_pins.begin() + ipin));
 
-        if (atom_ctx.lookup.atom_clb(blk_id) == ClusterBlockId::INVALID()) {
+        if (atom_ctx.lookup.atom_clb(blk_id) != ClusterBlockId::INVALID()) {
+            if (leading_packed) {
+                first_unpacked_pin = ipin + 1;
+            }
+        } else {
+            leading_packed = false;
             auto rng = atom_ctx.atom_molecules.equal_range(blk_id);
             for (const auto& kv : vtr::make_range(rng.first, rng.second)) {
                 t_pack_molecule* molecule = kv.second;
@@ -2464,7 +2575,7 @@ void add_cluster_molecule_candidates_by_transitive_connectivity(t_pb* cur_pb,
     //TODO: For now, only done by fan-out; should also consider fan-in
     cur_pb->pb_stats->explore_transitive_fanout = false;
 
-    /* First time finding transitive fanout candidates therefore alloc and load them */
+    /* Add the candidates reached through the nets marked since the last exploration */
     load_transitive_fanout_candidates(cluster_index,
                                       cur_pb->pb_stats,
                                       clb_inter_blk_nets,
@@ -2664,140 +2775,163 @@ t_molecule_stats calc_max_molecules_stats(const t_pack_molecule* molecule_head)
     return max_molecules_stats;
 }
 
-std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
-                                               const t_molecule_stats& max_molecule_stats,
-                                               const vtr::vector<AtomBlockId, float>& atom_criticality) {
-    std::vector<AtomBlockId> seed_atoms;
-
-    //Put all atoms in seed list
+/**
+ * @brief Returns the seed gain of blk for seed_type (any type except e_cluster_seed::TIMING).
+ *
+ * Only reads the netlist and molecules, so it may be called for different atoms concurrently.
+ */
+static float calc_seed_gain(const e_cluster_seed seed_type,
+                            const AtomBlockId blk,
+                            const t_molecule_stats& max_molecule_stats,
+                            const vtr::vector<AtomBlockId, float>& atom_criticality) {
     auto& atom_ctx = g_vpr_ctx.atom();
-    for (auto blk : atom_ctx.nlist.blocks()) {
-        seed_atoms.emplace_back(blk);
-    }
-
-    //Initially all gains are zero
-    vtr::vector<AtomBlockId, float> atom_gains(atom_ctx.nlist.blocks().size(), 0.);
 
-    if (seed_type == e_cluster_seed::TIMING) {
-        VTR_ASSERT(atom_gains.size() == atom_criticality.size());
-
-        //By criticality
-        atom_gains = atom_criticality;
-
-    } else if (seed_type == e_cluster_seed::MAX_INPUTS) {
+    if (seed_type == e_cluster_seed::MAX_INPUTS) {
         //By number of used molecule input pins
-        for (auto blk : atom_ctx.nlist.blocks()) {
-            int max_molecule_inputs = 0;
-            auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
-            for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
-                const t_pack_molecule* blk_mol = kv.second;
+        int max_molecule_inputs = 0;
+        auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
+        for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
+            const t_pack_molecule* blk_mol = kv.second;
 
-                const t_molecule_stats molecule_stats = calc_molecule_stats(blk_mol);
+            const t_molecule_stats molecule_stats = calc_molecule_stats(blk_mol);
 
-                //Keep the max over all molecules associated with the atom
-                max_molecule_inputs = std::max(max_molecule_inputs, molecule_stats.num_used_ext_inputs);
-            }
-
-            atom_gains[blk] = max_molecule_inputs;
+            //Keep the max over all molecules associated with the atom
+            max_molecule_inputs = std::max(max_molecule_inputs, molecule_stats.num_used_ext_inputs);
         }
 
+        return max_molecule_inputs;
+
     } else if (seed_type == e_cluster_seed::BLEND) {
         //By blended gain (criticality and inputs used)
-        for (auto blk : atom_ctx.nlist.blocks()) {
-            /* Score seed gain of each block as a weighted sum of timing criticality,
-             * number of tightly coupled blocks connected to it, and number of external inputs */
-            float seed_blend_fac = 0.5;
-            float max_blend_gain = 0;
+        /* Score seed gain of each block as a weighted sum of timing criticality,
+         * number of tightly coupled blocks connected to it, and number of external inputs */
+        float seed_blend_fac = 0.5;
+        float max_blend_gain = 0;
 
-            auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
-            for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
-                const t_pack_molecule* blk_mol = kv.second;
+        auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
+        for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
+            const t_pack_molecule* blk_mol = kv.second;
 
-                const t_molecule_stats molecule_stats = calc_molecule_stats(blk_mol);
+            const t_molecule_stats molecule_stats = calc_molecule_stats(blk_mol);
 
-                VTR_ASSERT(max_molecule_stats.num_used_ext_inputs > 0);
+            VTR_ASSERT(max_molecule_stats.num_used_ext_inputs > 0);
 
-                float blend_gain = (seed_blend_fac * atom_criticality[blk]
-                                    + (1 - seed_blend_fac) * (molecule_stats.num_used_ext_inputs / max_molecule_stats.num_used_ext_inputs));
-                blend_gain *= (1 + 0.2 * (molecule_stats.num_blocks - 1));
+            float blend_gain = (seed_blend_fac * atom_criticality[blk]
+                                + (1 - seed_blend_fac) * (molecule_stats.num_used_ext_inputs / max_molecule_stats.num_used_ext_inputs));
+            blend_gain *= (1 + 0.2 * (molecule_stats.num_blocks - 1));
 
-                //Keep the max over all molecules associated with the atom
-                max_blend_gain = std::max(max_blend_gain, blend_gain);
-            }
-            atom_gains[blk] = max_blend_gain;
+            //Keep the max over all molecules associated with the atom
+            max_blend_gain = std::max(max_blend_gain, blend_gain);
         }
+        return max_blend_gain;
 
     } else if (seed_type == e_cluster_seed::MAX_PINS || seed_type == e_cluster_seed::MAX_INPUT_PINS) {
         //By pins per molecule (i.e. available pins on primitives, not pins in use)
+        int max_molecule_pins = 0;
+        auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
+        for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
+            const t_pack_molecule* mol = kv.second;
+
+            const t_molecule_stats molecule_stats = calc_molecule_stats(mol);
+
+            //Keep the max over all molecules associated with the atom
+            int molecule_pins = 0;
+            if (seed_type == e_cluster_seed::MAX_PINS) {
+                //All pins
+                molecule_pins = molecule_stats.num_pins;
+            } else {
+                VTR_ASSERT(seed_type == e_cluster_seed::MAX_INPUT_PINS);
+                //Input pins only
+                molecule_pins = molecule_stats.num_input_pins;
+            }
 
-        for (auto blk : atom_ctx.nlist.blocks()) {
-            int max_molecule_pins = 0;
-            auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
-            for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
-                const t_pack_molecule* mol = kv.second;
+            //Keep the max over all molecules associated with the atom
+            max_molecule_pins = std::max(max_molecule_pins, molecule_pins);
+        }
+        return max_molecule_pins;
 
-                const t_molecule_stats molecule_stats = calc_molecule_stats(mol);
+    } else {
+        VTR_ASSERT(seed_type == e_cluster_seed::BLEND2);
+        float max_gain = 0;
+        auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
+        for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
+            const t_pack_molecule* mol = kv.second;
 
-                //Keep the max over all molecules associated with the atom
-                int molecule_pins = 0;
-                if (seed_type == e_cluster_seed::MAX_PINS) {
-                    //All pins
-                    molecule_pins = molecule_stats.num_pins;
-                } else {
-                    VTR_ASSERT(seed_type == e_cluster_seed::MAX_INPUT_PINS);
-                    //Input pins only
-                    molecule_pins = molecule_stats.num_input_pins;
-                }
+            const t_molecule_stats molecule_stats = calc_molecule_stats(mol);
 
-                //Keep the max over all molecules associated with the atom
-                max_molecule_pins = std::max(max_molecule_pins, molecule_pins);
-            }
-            atom_gains[blk] = max_molecule_pins;
-        }
+            float pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_pins, max_molecule_stats.num_pins);
+            float input_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_input_pins, max_molecule_stats.num_input_pins);
+            float output_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_output_pins, max_molecule_stats.num_output_pins);
+            float used_ext_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_used_ext_pins, max_molecule_stats.num_used_ext_pins);
+            float used_ext_input_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_used_ext_inputs, max_molecule_stats.num_used_ext_inputs);
+            float used_ext_output_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_used_ext_outputs, max_molecule_stats.num_used_ext_outputs);
+            float num_blocks_ratio = vtr::safe_ratio<float>(molecule_stats.num_blocks, max_molecule_stats.num_blocks);
+            float criticality = atom_criticality[blk];
 
-    } else if (seed_type == e_cluster_seed::BLEND2) {
-        for (auto blk : atom_ctx.nlist.blocks()) {
-            float max_gain = 0;
-            auto molecule_rng = atom_ctx.atom_molecules.equal_range(blk);
-            for (const auto& kv : vtr::make_range(molecule_rng.first, molecule_rng.second)) {
-                const t_pack_molecule* mol = kv.second;
+            constexpr float PIN_WEIGHT = 0.;
+            constexpr float INPUT_PIN_WEIGHT = 0.5;
+            constexpr float OUTPUT_PIN_WEIGHT = 0.;
+            constexpr float USED_PIN_WEIGHT = 0.;
+            constexpr float USED_INPUT_PIN_WEIGHT = 0.2;
+            constexpr float USED_OUTPUT_PIN_WEIGHT = 0.;
+            constexpr float BLOCKS_WEIGHT = 0.2;
+            constexpr float CRITICALITY_WEIGHT = 0.1;
 
-                const t_molecule_stats molecule_stats = calc_molecule_stats(mol);
+            float gain = PIN_WEIGHT * pin_ratio
+                         + INPUT_PIN_WEIGHT * input_pin_ratio
+                         + OUTPUT_PIN_WEIGHT * output_pin_ratio
 
-                float pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_pins, max_molecule_stats.num_pins);
-                float input_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_input_pins, max_molecule_stats.num_input_pins);
-                float output_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_output_pins, max_molecule_stats.num_output_pins);
-                float used_ext_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_used_ext_pins, max_molecule_stats.num_used_ext_pins);
-                float used_ext_input_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_used_ext_inputs, max_molecule_stats.num_used_ext_inputs);
-                float used_ext_output_pin_ratio = vtr::safe_ratio<float>(molecule_stats.num_used_ext_outputs, max_molecule_stats.num_used_ext_outputs);
-                float num_blocks_ratio = vtr::safe_ratio<float>(molecule_stats.num_blocks, max_molecule_stats.num_blocks);
-                float criticality = atom_criticality[blk];
+                         + USED_PIN_WEIGHT * used_ext_pin_ratio
+                         + USED_INPUT_PIN_WEIGHT * used_ext_input_pin_ratio
+                         + USED_OUTPUT_PIN_WEIGHT * used_ext_output_pin_ratio
 
-                constexpr float PIN_WEIGHT = 0.;
-                constexpr float INPUT_PIN_WEIGHT = 0.5;
-                constexpr float OUTPUT_PIN_WEIGHT = 0.;
-                constexpr float USED_PIN_WEIGHT = 0.;
-                constexpr float USED_INPUT_PIN_WEIGHT = 0.2;
-                constexpr float USED_OUTPUT_PIN_WEIGHT = 0.;
-                constexpr float BLOCKS_WEIGHT = 0.2;
-                constexpr float CRITICALITY_WEIGHT = 0.1;
+                         + BLOCKS_WEIGHT * num_blocks_ratio
+                         + CRITICALITY_WEIGHT * criticality;
 
-                float gain = PIN_WEIGHT * pin_ratio
-                             + INPUT_PIN_WEIGHT * input_pin_ratio
-                             + OUTPUT_PIN_WEIGHT * output_pin_ratio
+            max_gain = std::max(max_gain, gain);
+        }
 
-                             + USED_PIN_WEIGHT * used_ext_pin_ratio
-                             + USED_INPUT_PIN_WEIGHT * used_ext_input_pin_ratio
-                             + USED_OUTPUT_PIN_WEIGHT * used_ext_output_pin_ratio
+        return max_gain;
+    }
+}
 
-                             + BLOCKS_WEIGHT * num_blocks_ratio
-                             + CRITICALITY_WEIGHT * criticality;
+std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
+                                               const t_molecule_stats& max_molecule_stats,
+                                               const vtr::vector<AtomBlockId, float>& atom_criticality) {
+    std::vector<AtomBlockId> seed_atoms;
 
-                max_gain = std::max(max_gain, gain);
-            }
+    //Put all atoms in seed list
+    auto& atom_ctx = g_vpr_ctx.atom();
+    for (auto blk : atom_ctx.nlist.blocks()) {
+        seed_atoms.emplace_back(blk);
+    }
 
-            atom_gains[blk] = max_gain;
-        }
+    //Initially all gains are zero
+    vtr::vector<AtomBlockId, float> atom_gains(atom_ctx.nlist.blocks().size(), 0.);
+
+    if (seed_type == e_cluster_seed::TIMING) {
+        VTR_ASSERT(atom_gains.size() == atom_criticality.size());
+
+        //By criticality
+        atom_gains = atom_criticality;
+
+    } else if (seed_type == e_cluster_seed::MAX_INPUTS
+               || seed_type == e_cluster_seed::BLEND
+               || seed_type == e_cluster_seed::MAX_PINS
+               || seed_type == e_cluster_seed::MAX_INPUT_PINS
+               || seed_type == e_cluster_seed::BLEND2) {
+        //Each atom's gain is independent of the others, and scoring visits
+        //every pin of every molecule (and the sinks of their output nets)
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), seed_atoms.size(), [&](size_t iatom) {
+            AtomBlockId blk = seed_atoms[iatom];
+            atom_gains[blk] = calc_seed_gain(seed_type, blk, max_molecule_stats, atom_criticality);
+        });
+#else
+        for (auto blk : seed_atoms) {
+            atom_gains[blk] = calc_seed_gain(seed_type, blk, max_molecule_stats, atom_criticality);
+        }
+#endif
 
     } else {
         VPR_FATAL_ERROR(VPR_ERROR_PACK, "Unrecognized cluster seed type");
@@ -2811,10 +2945,23 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
     // std::sort which does not specify how equal values are handled). Using a stable
     // sort ensures that regardless of the underlying sorting algorithm the same seed
     // order is produced regardless of compiler.
+    //
+    // The seeds start in increasing id order, so breaking ties by id gives the stable
+    // order with any sort, including a parallel one.
+#ifdef VPR_USE_TBB
+    auto by_descending_gain = [&](const AtomBlockId lhs, const AtomBlockId rhs) {
+        if (atom_gains[lhs] != atom_gains[rhs]) {
+            return atom_gains[lhs] > atom_gains[rhs];
+        }
+        return lhs < rhs;
+    };
+    tbb::parallel_sort(seed_atoms.begin(), seed_atoms.end(), by_descending_gain);
+#else
     auto by_descending_gain = [&](const AtomBlockId lhs, const AtomBlockId rhs) {
         return atom_gains[lhs] > atom_gains[rhs];
     };
     std::stable_sort(seed_atoms.begin(), seed_atoms.end(), by_descending_gain);
+#endif
 
     if (getEchoEnabled() && isEchoFileEnabled(E_ECHO_CLUSTERING_BLOCK_CRITICALITIES)) {
         print_seed_gains(getEchoFileName(E_ECHO_CLUSTERING_BLOCK_CRITICALITIES), seed_atoms, atom_gains, atom_criticality);
@@ -2825,6 +2972,7 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
 
 t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::vector<AtomBlockId> seed_atoms) {
     auto& atom_ctx = g_vpr_ctx.atom();
+    PackPhaseTimer phase_timer(g_vpr_ctx.mutable_cl_helper().pack_profile, e_pack_phase::SEED_SELECTION);
 
     while (*seedindex < static_cast<int>(seed_atoms.size())) {
         AtomBlockId blk_id = seed_atoms[(*seedindex)++];
@@ -2842,11 +2990,13 @@ t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::vecto
                 }
             }
             VTR_ASSERT(best != nullptr);
+            phase_timer.set_success(true);
             return best;
         }
     }
 
     /*if it makes it to here , there are no more blocks available*/
+    phase_timer.set_success(false);
     return nullptr;
 }
 
@@ -2856,7 +3006,7 @@ t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::vecto
  * + molecule_base_gain*some_factor
  * - introduced_input_nets_of_unrelated_blocks_pulled_in_by_molecule*some_other_factor
  */
-float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures) {
+float get_molecule_gain(t_pack_molecule* molecule, vtr::stamped_id_map<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures) {
     float gain;
     int i;
     int num_introduced_inputs_of_indirectly_related_block;
@@ -2931,81 +3081,165 @@ int compare_molecule_gain(const void* a, const void* b) {
     return 0;
 }
 
-/* Determine if speculatively packed cur_pb is pin feasible
- * Runtime is actually not that bad for this.  It's worst case O(k^2) where k is the
- * number of pb_graph pins.  Can use hash tables or make incremental if becomes an issue.
- */
-void try_update_lookahead_pins_used(t_pb* cur_pb) {
+/* Resets the speculative pin class usage of cur_pb and the pbs below it */
+void reset_lookahead_pins_used(t_pb* cur_pb) {
     int i, j;
     const t_pb_type* pb_type = cur_pb->pb_graph_node->pb_type;
+    if (cur_pb->pb_stats == nullptr) {
+        return; /* No pins used, no need to continue */
+    }
 
-    // run recursively till a leaf (primitive) pb block is reached
     if (pb_type->num_modes > 0 && cur_pb->name != nullptr) {
+        std::fill(cur_pb->pb_stats->lookahead_input_pins_used.begin(), cur_pb->pb_stats->lookahead_input_pins_used.end(), 0);
+        std::fill(cur_pb->pb_stats->lookahead_output_pins_used.begin(), cur_pb->pb_stats->lookahead_output_pins_used.end(), 0);
+
         if (cur_pb->child_pbs != nullptr) {
             for (i = 0; i < pb_type->modes[cur_pb->mode].num_pb_type_children; i++) {
                 if (cur_pb->child_pbs[i] != nullptr) {
                     for (j = 0; j < pb_type->modes[cur_pb->mode].pb_type_children[i].num_pb; j++) {
-                        try_update_lookahead_pins_used(&cur_pb->child_pbs[i][j]);
+                        reset_lookahead_pins_used(&cur_pb->child_pbs[i][j]);
                     }
                 }
             }
         }
-    } else {
-        // find if this child (primitive) pb block has an atom mapped to it,
-        // if yes compute and mark lookahead pins used for that pb block
-        auto& atom_ctx = g_vpr_ctx.atom();
-        AtomBlockId blk_id = atom_ctx.lookup.pb_atom(cur_pb);
-        if (pb_type->blif_model != nullptr && blk_id) {
-            compute_and_mark_lookahead_pins_used(blk_id);
-        }
     }
 }
 
-/* Resets nets used at different pin classes for determining pin feasibility */
-void reset_lookahead_pins_used(t_pb* cur_pb) {
-    int i, j;
-    const t_pb_type* pb_type = cur_pb->pb_graph_node->pb_type;
-    if (cur_pb->pb_stats == nullptr) {
-        return; /* No pins used, no need to continue */
+//Adds (delta = 1) or removes (delta = -1) the pin class uses of a net
+static void apply_lookahead_pin_uses(const std::vector<t_lookahead_pin_use>& uses, int delta) {
+    for (const t_lookahead_pin_use& use : uses) {
+        std::vector<int>& pins_used = use.is_output ? use.pb->pb_stats->lookahead_output_pins_used
+                                                    : use.pb->pb_stats->lookahead_input_pins_used;
+        pins_used[use.pin_class] += delta;
+        VTR_ASSERT_SAFE(pins_used[use.pin_class] >= 0);
     }
+}
 
-    if (pb_type->num_modes > 0 && cur_pb->name != nullptr) {
-        for (i = 0; i < cur_pb->pb_graph_node->num_input_pin_class; i++) {
-            cur_pb->pb_stats->lookahead_input_pins_used[i].clear();
+//Recomputes the pin classes used by net_inf, the net net_id and its pins in the cluster
+static void compute_lookahead_net_uses(const AtomNetId net_id, t_lookahead_net& net_inf) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    net_inf.uses.clear();
+    for (AtomPinId pin_id : net_inf.pins) {
+        const t_pb_graph_pin* pb_graph_pin = find_pb_graph_pin(atom_ctx.nlist, atom_ctx.lookup, pin_id);
+        const t_pb* primitive_pb = atom_ctx.lookup.atom_pb(atom_ctx.nlist.pin_block(pin_id));
+        VTR_ASSERT(primitive_pb != nullptr);
+        compute_and_mark_lookahead_pins_used_for_pin(pb_graph_pin, primitive_pb, net_id, net_inf.uses);
+    }
+
+    //A net uses a pin of each class once, however many of its pins need it
+    std::vector<t_lookahead_pin_use> unique_uses;
+    for (const t_lookahead_pin_use& use : net_inf.uses) {
+        if (std::find(unique_uses.begin(), unique_uses.end(), use) == unique_uses.end()) {
+            unique_uses.push_back(use);
         }
+    }
+    net_inf.uses = std::move(unique_uses);
+}
+
+/* Rebuilds the pin class usage of the atoms already in cluster cb (except those of molecule) from scratch.
+ * Only needed when the atoms of the cluster changed without going through try_pack_molecule(),
+ * i.e. when the re-clustering API removed atoms from it. */
+static void rebuild_lookahead_pins_used(t_pb* cb, const t_pack_molecule* molecule) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+    t_pb_stats* cb_stats = cb->pb_stats;
+
+    reset_lookahead_pins_used(cb);
+    cb_stats->lookahead_nets.clear();
+    cb_stats->lookahead_undo.clear();
 
-        for (i = 0; i < cur_pb->pb_graph_node->num_output_pin_class; i++) {
-            cur_pb->pb_stats->lookahead_output_pins_used[i].clear();
+    std::vector<AtomBlockId> atoms;
+    collect_pb_atoms(cb, atoms);
+    for (AtomBlockId blk_id : atoms) {
+        if (std::find(molecule->atom_block_ids.begin(), molecule->atom_block_ids.end(), blk_id) != molecule->atom_block_ids.end()) {
+            continue;
+        }
+        for (AtomPinId pin_id : atom_ctx.nlist.block_pins(blk_id)) {
+            cb_stats->lookahead_nets[atom_ctx.nlist.pin_net(pin_id)].pins.push_back(pin_id);
         }
+    }
 
-        if (cur_pb->child_pbs != nullptr) {
-            for (i = 0; i < pb_type->modes[cur_pb->mode].num_pb_type_children; i++) {
-                if (cur_pb->child_pbs[i] != nullptr) {
-                    for (j = 0; j < pb_type->modes[cur_pb->mode].pb_type_children[i].num_pb; j++) {
-                        reset_lookahead_pins_used(&cur_pb->child_pbs[i][j]);
-                    }
-                }
+    for (auto& kv : cb_stats->lookahead_nets) {
+        compute_lookahead_net_uses(kv.first, kv.second);
+        apply_lookahead_pin_uses(kv.second.uses, 1);
+        //The committed usage bounds the usage of the root checked later on
+        for (const t_lookahead_pin_use& use : kv.second.uses) {
+            t_pb_stats* stats = use.pb->pb_stats;
+            if (use.is_output) {
+                stats->output_pins_used[use.pin_class] = std::max(stats->output_pins_used[use.pin_class], stats->lookahead_output_pins_used[use.pin_class]);
+            } else {
+                stats->input_pins_used[use.pin_class] = std::max(stats->input_pins_used[use.pin_class], stats->lookahead_input_pins_used[use.pin_class]);
             }
         }
     }
+    cb_stats->num_lookahead_atoms = cb_stats->num_child_blocks_in_pb;
 }
 
-/* Determine if pins of speculatively packed pb are legal */
-void compute_and_mark_lookahead_pins_used(const AtomBlockId blk_id) {
+/* Determine if speculatively packed cur_pb is pin feasible
+ *
+ * The pin class usage is maintained incrementally: the usage of a net only depends on where its
+ * pins are placed, so adding a molecule only changes the usage of the nets of its atoms. Those
+ * nets are recomputed (from all their pins in the cluster), and their previous state is kept so
+ * revert_lookahead_pins_used() can undo the molecule if it does not pack.
+ */
+void update_lookahead_pins_used(t_pb* cb, const t_pack_molecule* molecule) {
     auto& atom_ctx = g_vpr_ctx.atom();
+    t_pb_stats* cb_stats = cb->pb_stats;
+    VTR_ASSERT(cb->is_root() && cb_stats != nullptr);
+    VTR_ASSERT(cb_stats->lookahead_undo.empty());
 
-    const t_pb* cur_pb = atom_ctx.lookup.atom_pb(blk_id);
-    VTR_ASSERT(cur_pb != nullptr);
+    if (cb_stats->num_lookahead_atoms != cb_stats->num_child_blocks_in_pb) {
+        rebuild_lookahead_pins_used(cb, molecule);
+    }
 
-    /* Walk through inputs, outputs, and clocks marking pins off of the same class */
-    for (auto pin_id : atom_ctx.nlist.block_pins(blk_id)) {
-        auto net_id = atom_ctx.nlist.pin_net(pin_id);
+    //Remove the current usage of the nets of the molecule, and add its pins to them
+    for (AtomBlockId blk_id : molecule->atom_block_ids) {
+        if (!blk_id) continue;
+        cb_stats->num_lookahead_atoms++;
 
-        const t_pb_graph_pin* pb_graph_pin = find_pb_graph_pin(atom_ctx.nlist, atom_ctx.lookup, pin_id);
-        compute_and_mark_lookahead_pins_used_for_pin(pb_graph_pin, cur_pb, net_id);
+        for (AtomPinId pin_id : atom_ctx.nlist.block_pins(blk_id)) {
+            AtomNetId net_id = atom_ctx.nlist.pin_net(pin_id);
+            t_lookahead_net& net_inf = cb_stats->lookahead_nets[net_id];
+
+            auto is_net = [&](const std::pair<AtomNetId, t_lookahead_net>& undo) { return undo.first == net_id; };
+            if (std::find_if(cb_stats->lookahead_undo.begin(), cb_stats->lookahead_undo.end(), is_net) == cb_stats->lookahead_undo.end()) {
+                apply_lookahead_pin_uses(net_inf.uses, -1);
+                cb_stats->lookahead_undo.emplace_back(net_id, net_inf);
+            }
+            net_inf.pins.push_back(pin_id);
+        }
+    }
+
+    //Recompute their usage with the molecule in place
+    for (const auto& undo : cb_stats->lookahead_undo) {
+        t_lookahead_net& net_inf = cb_stats->lookahead_nets[undo.first];
+        compute_lookahead_net_uses(undo.first, net_inf);
+        apply_lookahead_pin_uses(net_inf.uses, 1);
     }
 }
 
+/* Undoes update_lookahead_pins_used() for a molecule which failed to pack */
+void revert_lookahead_pins_used(t_pb* cb) {
+    t_pb_stats* cb_stats = cb->pb_stats;
+    if (cb_stats->lookahead_undo.empty()) {
+        return; /* Failed before its pins were looked at */
+    }
+
+    for (auto& undo : cb_stats->lookahead_undo) {
+        auto it = cb_stats->lookahead_nets.find(undo.first);
+        VTR_ASSERT(it != cb_stats->lookahead_nets.end());
+        apply_lookahead_pin_uses(it->second.uses, -1);
+        apply_lookahead_pin_uses(undo.second.uses, 1);
+        if (undo.second.pins.empty()) {
+            cb_stats->lookahead_nets.erase(it);
+        } else {
+            it->second = std::move(undo.second);
+        }
+    }
+    cb_stats->lookahead_undo.clear();
+    cb_stats->num_lookahead_atoms = cb_stats->num_child_blocks_in_pb;
+}
+
 /**
  * Given a pin and its assigned net, mark all pin classes that are affected.
  * Check if connecting this pin to it's driver pin or to all sink pins will
@@ -3014,7 +3248,7 @@ void compute_and_mark_lookahead_pins_used(const AtomBlockId blk_id) {
  * required add this net to the pin class (to increment the number of used
  * pins from this class) that should be used to leave the pb_block.
  */
-void compute_and_mark_lookahead_pins_used_for_pin(const t_pb_graph_pin* pb_graph_pin, const t_pb* primitive_pb, const AtomNetId net_id) {
+void compute_and_mark_lookahead_pins_used_for_pin(const t_pb_graph_pin* pb_graph_pin, const t_pb* primitive_pb, const AtomNetId net_id, std::vector<t_lookahead_pin_use>& uses) {
     auto& atom_ctx = g_vpr_ctx.atom();
 
     // starting from the parent pb of the input primitive go up in the hierarchy till the root block
@@ -3064,12 +3298,8 @@ void compute_and_mark_lookahead_pins_used_for_pin(const t_pb_graph_pin* pb_graph
             // Must use an input pin to connect the driver to the input pin of the given primitive, either the
             // driver atom is not contained in the cluster or is contained but cannot reach the primitive pin
             if (!is_reachable) {
-                // add net to lookahead_input_pins_used if not already added
-                auto it = std::find(cur_pb->pb_stats->lookahead_input_pins_used[pin_class].begin(),
-                                    cur_pb->pb_stats->lookahead_input_pins_used[pin_class].end(), net_id);
-                if (it == cur_pb->pb_stats->lookahead_input_pins_used[pin_class].end()) {
-                    cur_pb->pb_stats->lookahead_input_pins_used[pin_class].push_back(net_id);
-                }
+                // the net uses an input pin of this class
+                uses.push_back({const_cast<t_pb*>(cur_pb), pin_class, false});
             }
         } else {
             VTR_ASSERT(pb_graph_pin->port->type == OUT_PORT);
@@ -3128,7 +3358,7 @@ void compute_and_mark_lookahead_pins_used_for_pin(const t_pb_graph_pin* pb_graph
 
             if (net_exits_cluster) {
                 /* This output must exit this cluster */
-                cur_pb->pb_stats->lookahead_output_pins_used[pin_class].push_back(net_id);
+                uses.push_back({const_cast<t_pb*>(cur_pb), pin_class, true});
             }
         }
     }
@@ -3188,98 +3418,72 @@ t_pb_graph_pin* get_driver_pb_graph_pin(const t_pb* driver_pb, const AtomPinId d
     return nullptr;
 }
 
-/* Check if the number of available inputs/outputs for a pin class is sufficient for speculatively packed blocks */
-bool check_lookahead_pins_used(t_pb* cur_pb, t_ext_pin_util max_external_pin_util) {
-    const t_pb_type* pb_type = cur_pb->pb_graph_node->pb_type;
-
-    if (pb_type->num_modes > 0 && cur_pb->name) {
-        for (int i = 0; i < cur_pb->pb_graph_node->num_input_pin_class; i++) {
-            size_t class_size = cur_pb->pb_graph_node->input_pin_class_size[i];
+/* Check if the number of available inputs/outputs for a pin class is sufficient for speculatively packed blocks
+ *
+ * Only the pin classes used by the nets of the molecule being tried can have changed (and the others
+ * were feasible when the molecules already in the cluster were committed), so only those are checked.
+ */
+bool check_lookahead_pins_used(t_pb* cb, t_ext_pin_util max_external_pin_util) {
+    for (const auto& undo : cb->pb_stats->lookahead_undo) {
+        for (const t_lookahead_pin_use& use : cb->pb_stats->lookahead_nets[undo.first].uses) {
+            const t_pb* cur_pb = use.pb;
+            const t_pb_stats* stats = cur_pb->pb_stats;
+
+            size_t class_size;
+            size_t pins_used;
+            if (!use.is_output) {
+                class_size = cur_pb->pb_graph_node->input_pin_class_size[use.pin_class];
+                pins_used = stats->lookahead_input_pins_used[use.pin_class];
+
+                if (cur_pb->is_root()) {
+                    // Scale the class size by the maximum external pin utilization factor
+                    // Use ceil to avoid classes of size 1 from being scaled to zero
+                    class_size = std::ceil(max_external_pin_util.input_pin_util * class_size);
+                    // if the number of pins already used is larger than class size, then the number of
+                    // cluster inputs already used should be our constraint. Why is this needed? This is
+                    // needed since when packing the seed block the maximum external pin utilization is
+                    // used as 1.0 allowing molecules that are using up to all the cluster inputs to be
+                    // packed legally. Therefore, if the seed block is already using more inputs than
+                    // the allowed maximum utilization, this should become the new maximum pin utilization.
+                    class_size = std::max<size_t>(class_size, stats->input_pins_used[use.pin_class]);
+                }
+            } else {
+                class_size = cur_pb->pb_graph_node->output_pin_class_size[use.pin_class];
+                pins_used = stats->lookahead_output_pins_used[use.pin_class];
 
-            if (cur_pb->is_root()) {
-                // Scale the class size by the maximum external pin utilization factor
-                // Use ceil to avoid classes of size 1 from being scaled to zero
-                class_size = std::ceil(max_external_pin_util.input_pin_util * class_size);
-                // if the number of pins already used is larger than class size, then the number of
-                // cluster inputs already used should be our constraint. Why is this needed? This is
-                // needed since when packing the seed block the maximum external pin utilization is
-                // used as 1.0 allowing molecules that are using up to all the cluster inputs to be
-                // packed legally. Therefore, if the seed block is already using more inputs than
-                // the allowed maximum utilization, this should become the new maximum pin utilization.
-                class_size = std::max<size_t>(class_size, cur_pb->pb_stats->input_pins_used[i].size());
-            }
-
-            if (cur_pb->pb_stats->lookahead_input_pins_used[i].size() > class_size) {
-                return false;
+                if (cur_pb->is_root()) {
+                    // Scale the class size by the maximum external pin utilization factor (see above)
+                    class_size = std::ceil(max_external_pin_util.output_pin_util * class_size);
+                    class_size = std::max<size_t>(class_size, stats->output_pins_used[use.pin_class]);
+                }
             }
-        }
 
-        for (int i = 0; i < cur_pb->pb_graph_node->num_output_pin_class; i++) {
-            size_t class_size = cur_pb->pb_graph_node->output_pin_class_size[i];
-            if (cur_pb->is_root()) {
-                // Scale the class size by the maximum external pin utilization factor
-                // Use ceil to avoid classes of size 1 from being scaled to zero
-                class_size = std::ceil(max_external_pin_util.output_pin_util * class_size);
-                // if the number of pins already used is larger than class size, then the number of
-                // cluster outputs already used should be our constraint. Why is this needed? This is
-                // needed since when packing the seed block the maximum external pin utilization is
-                // used as 1.0 allowing molecules that are using up to all the cluster inputs to be
-                // packed legally. Therefore, if the seed block is already using more inputs than
-                // the allowed maximum utilization, this should become the new maximum pin utilization.
-                class_size = std::max<size_t>(class_size, cur_pb->pb_stats->output_pins_used[i].size());
-            }
-
-            if (cur_pb->pb_stats->lookahead_output_pins_used[i].size() > class_size) {
+            if (pins_used > class_size) {
                 return false;
             }
         }
-
-        if (cur_pb->child_pbs) {
-            for (int i = 0; i < pb_type->modes[cur_pb->mode].num_pb_type_children; i++) {
-                if (cur_pb->child_pbs[i]) {
-                    for (int j = 0; j < pb_type->modes[cur_pb->mode].pb_type_children[i].num_pb; j++) {
-                        if (!check_lookahead_pins_used(&cur_pb->child_pbs[i][j], max_external_pin_util))
-                            return false;
-                    }
-                }
-            }
-        }
     }
 
     return true;
 }
 
 /* Speculation successful, commit input/output pins used */
-void commit_lookahead_pins_used(t_pb* cur_pb) {
-    const t_pb_type* pb_type = cur_pb->pb_graph_node->pb_type;
-
-    if (pb_type->num_modes > 0 && cur_pb->name) {
-        for (int i = 0; i < cur_pb->pb_graph_node->num_input_pin_class; i++) {
-            VTR_ASSERT(cur_pb->pb_stats->lookahead_input_pins_used[i].size() <= (unsigned int)cur_pb->pb_graph_node->input_pin_class_size[i]);
-            for (size_t j = 0; j < cur_pb->pb_stats->lookahead_input_pins_used[i].size(); j++) {
-                VTR_ASSERT(cur_pb->pb_stats->lookahead_input_pins_used[i][j]);
-                cur_pb->pb_stats->input_pins_used[i].insert({j, cur_pb->pb_stats->lookahead_input_pins_used[i][j]});
-            }
-        }
-
-        for (int i = 0; i < cur_pb->pb_graph_node->num_output_pin_class; i++) {
-            VTR_ASSERT(cur_pb->pb_stats->lookahead_output_pins_used[i].size() <= (unsigned int)cur_pb->pb_graph_node->output_pin_class_size[i]);
-            for (size_t j = 0; j < cur_pb->pb_stats->lookahead_output_pins_used[i].size(); j++) {
-                VTR_ASSERT(cur_pb->pb_stats->lookahead_output_pins_used[i][j]);
-                cur_pb->pb_stats->output_pins_used[i].insert({j, cur_pb->pb_stats->lookahead_output_pins_used[i][j]});
-            }
-        }
-
-        if (cur_pb->child_pbs) {
-            for (int i = 0; i < pb_type->modes[cur_pb->mode].num_pb_type_children; i++) {
-                if (cur_pb->child_pbs[i]) {
-                    for (int j = 0; j < pb_type->modes[cur_pb->mode].pb_type_children[i].num_pb; j++) {
-                        commit_lookahead_pins_used(&cur_pb->child_pbs[i][j]);
-                    }
-                }
+void commit_lookahead_pins_used(t_pb* cb) {
+    t_pb_stats* cb_stats = cb->pb_stats;
+
+    for (const auto& undo : cb_stats->lookahead_undo) {
+        for (const t_lookahead_pin_use& use : cb_stats->lookahead_nets[undo.first].uses) {
+            t_pb_stats* stats = use.pb->pb_stats;
+            if (!use.is_output) {
+                VTR_ASSERT(stats->lookahead_input_pins_used[use.pin_class] <= use.pb->pb_graph_node->input_pin_class_size[use.pin_class]);
+                stats->input_pins_used[use.pin_class] = std::max(stats->input_pins_used[use.pin_class], stats->lookahead_input_pins_used[use.pin_class]);
+            } else {
+                VTR_ASSERT(stats->lookahead_output_pins_used[use.pin_class] <= use.pb->pb_graph_node->output_pin_class_size[use.pin_class]);
+                stats->output_pins_used[use.pin_class] = std::max(stats->output_pins_used[use.pin_class], stats->lookahead_output_pins_used[use.pin_class]);
             }
         }
     }
+    cb_stats->lookahead_undo.clear();
 }
 
 /**
@@ -3288,15 +3492,21 @@ void commit_lookahead_pins_used(t_pb* cur_pb) {
  * cluster. Since this FF is feeding an adder that is packed in another cluster
  * this function should find other FFs that are feeding other inputs of this adder
  * since they are two hops away from the FF packed in this cluster
+ *
+ * The candidates are maintained incrementally while the cluster is open: only
+ * the nets marked since the previous call are explored, and the candidates found
+ * earlier are kept (packed ones are removed as they are packed).
  */
 void load_transitive_fanout_candidates(ClusterBlockId clb_index,
                                        t_pb_stats* pb_stats,
                                        vtr::vector<ClusterBlockId, std::vector<AtomNetId>>& clb_inter_blk_nets,
                                        int transitive_fanout_threshold) {
     auto& atom_ctx = g_vpr_ctx.atom();
+    auto& transitive_fanout_candidates = pb_stats->transitive_fanout_candidates;
 
-    // iterate over all the nets that have pins in this cluster
-    for (const auto net_id : pb_stats->marked_nets) {
+    // iterate over the nets that have pins in this cluster, and were not explored yet
+    for (size_t inet = pb_stats->num_transitive_explored_nets; inet < pb_stats->marked_nets.size(); inet++) {
+        AtomNetId net_id = pb_stats->marked_nets[inet];
         // only consider small nets to constrain runtime
         if (int(atom_ctx.nlist.net_pins(net_id).size()) < transitive_fanout_threshold + 1) {
             // iterate over all the pins of the net
@@ -3306,26 +3516,35 @@ void load_transitive_fanout_candidates(ClusterBlockId clb_index,
                 ClusterBlockId tclb = atom_ctx.lookup.atom_clb(atom_blk_id);
                 // if the block connected to this pin is packed in another cluster
                 if (tclb != clb_index && tclb != ClusterBlockId::INVALID()) {
-                    // explore transitive nets from already packed cluster
-                    for (AtomNetId tnet : clb_inter_blk_nets[tclb]) {
-                        // iterate over all the pins of the net
-                        for (AtomPinId tpin : atom_ctx.nlist.net_pins(tnet)) {
-                            auto blk_id = atom_ctx.nlist.pin_block(tpin);
-                            // This transitive atom is not packed, score and add
-                            if (atom_ctx.lookup.atom_clb(blk_id) == ClusterBlockId::INVALID()) {
-                                auto& transitive_fanout_candidates = pb_stats->transitive_fanout_candidates;
-
-                                if (pb_stats->gain.count(blk_id) == 0) {
-                                    pb_stats->gain[blk_id] = 0.001;
-                                } else {
-                                    pb_stats->gain[blk_id] += 0.001;
+                    // explore transitive nets from already packed cluster (once per cluster reached)
+                    auto cached = pb_stats->transitive_cluster_atoms.find(tclb);
+                    if (cached == pb_stats->transitive_cluster_atoms.end()) {
+                        std::vector<AtomBlockId> tatoms;
+                        for (AtomNetId tnet : clb_inter_blk_nets[tclb]) {
+                            // iterate over all the pins of the net
+                            for (AtomPinId tpin : atom_ctx.nlist.net_pins(tnet)) {
+                                auto blk_id = atom_ctx.nlist.pin_block(tpin);
+                                if (atom_ctx.lookup.atom_clb(blk_id) == ClusterBlockId::INVALID()) {
+                                    tatoms.push_back(blk_id);
                                 }
-                                auto rng = atom_ctx.atom_molecules.equal_range(blk_id);
-                                for (const auto& kv : vtr::make_range(rng.first, rng.second)) {
-                                    t_pack_molecule* molecule = kv.second;
-                                    if (molecule->valid) {
-                                        transitive_fanout_candidates.insert({molecule->atom_block_ids[molecule->root], molecule});
-                                    }
+                            }
+                        }
+                        cached = pb_stats->transitive_cluster_atoms.insert(std::make_pair(tclb, std::move(tatoms))).first;
+                    }
+
+                    for (AtomBlockId blk_id : cached->second) {
+                        // This transitive atom is not packed (it may have been packed into this cluster since it was cached), score and add
+                        if (atom_ctx.lookup.atom_clb(blk_id) == ClusterBlockId::INVALID()) {
+                            if (pb_stats->gain.count(blk_id) == 0) {
+                                pb_stats->gain[blk_id] = 0.001;
+                            } else {
+                                pb_stats->gain[blk_id] += 0.001;
+                            }
+                            auto rng = atom_ctx.atom_molecules.equal_range(blk_id);
+                            for (const auto& kv : vtr::make_range(rng.first, rng.second)) {
+                                t_pack_molecule* molecule = kv.second;
+                                if (molecule->valid) {
+                                    transitive_fanout_candidates.insert({molecule->atom_block_ids[molecule->root], molecule});
                                 }
                             }
                         }
@@ -3334,6 +3553,7 @@ void load_transitive_fanout_candidates(ClusterBlockId clb_index,
             }
         }
     }
+    pb_stats->num_transitive_explored_nets = pb_stats->marked_nets.size();
 }
 
 std::map<const t_model*, std::vector<t_logical_block_type_ptr>> identify_primitive_candidate_block_types() {
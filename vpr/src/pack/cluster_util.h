@@ -118,6 +118,9 @@ void calc_init_packing_timing(const t_packer_opts& packer_opts,
                               std::shared_ptr<SetupTimingInfo>& timing_info,
                               vtr::vector<AtomBlockId, float>& atom_criticality);
 
+//invalidate the timing edges of the nets absorbed by a completed cluster, returning how many were invalidated
+int invalidate_absorbed_net_timing(const ClusterBlockId clb_index, SetupTimingInfo& timing_info);
+
 //free the clustering data structures
 void free_clustering_data(const t_packer_opts& packer_opts,
                           t_clustering_data& clustering_data);
@@ -139,7 +142,7 @@ bool check_cluster_legality(const int& verbosity,
 bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb);
 
 void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                         std::map<AtomBlockId, float>& gain,
+                                         vtr::stamped_id_map<AtomBlockId, float>& gain,
                                          t_pb* pb,
                                          int max_queue_size,
                                          AttractionInfo& attraction_groups);
@@ -158,19 +161,20 @@ void alloc_and_init_clustering(const t_molecule_stats& max_molecule_stats,
 
 void free_pb_stats_recursive(t_pb* pb);
 
-void try_update_lookahead_pins_used(t_pb* cur_pb);
+void update_lookahead_pins_used(t_pb* cb, const t_pack_molecule* molecule);
 
-void reset_lookahead_pins_used(t_pb* cur_pb);
+void revert_lookahead_pins_used(t_pb* cb);
 
-void compute_and_mark_lookahead_pins_used(const AtomBlockId blk_id);
+void reset_lookahead_pins_used(t_pb* cur_pb);
 
 void compute_and_mark_lookahead_pins_used_for_pin(const t_pb_graph_pin* pb_graph_pin,
                                                   const t_pb* primitive_pb,
-                                                  const AtomNetId net_id);
+                                                  const AtomNetId net_id,
+                                                  std::vector<t_lookahead_pin_use>& uses);
 
-void commit_lookahead_pins_used(t_pb* cur_pb);
+void commit_lookahead_pins_used(t_pb* cb);
 
-bool check_lookahead_pins_used(t_pb* cur_pb, t_ext_pin_util max_external_pin_util);
+bool check_lookahead_pins_used(t_pb* cb, t_ext_pin_util max_external_pin_util);
 
 bool primitive_feasible(const AtomBlockId blk_id, t_pb* cur_pb);
 
@@ -193,10 +197,7 @@ void print_pack_status(int num_clb,
                        int num_molecules_processed,
                        int& mols_since_last_print,
                        int device_width,
-                       int device_height,
-                       AttractionInfo& attraction_groups);
-
-void rebuild_attraction_groups(AttractionInfo& attraction_groups);
+                       int device_height);
 
 void record_molecule_failure(t_pack_molecule* molecule, t_pb* pb);
 
@@ -409,7 +410,7 @@ std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_type,
 
 t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::vector<AtomBlockId> seed_atoms);
 
-float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures);
+float get_molecule_gain(t_pack_molecule* molecule, vtr::stamped_id_map<AtomBlockId, float>& blk_gain, AttractGroupId cluster_attraction_group_id, AttractionInfo& attraction_groups, int num_molecule_failures);
 
 int compare_molecule_gain(const void* a, const void* b);
 int net_sinks_reachable_in_cluster(const t_pb_graph_pin* driver_pb_gpin, const int depth, const AtomNetId net_id);
@@ -22,6 +22,7 @@
 #include <cstring>
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 #include "vtr_assert.h"
 #include "vtr_memory.h"
@@ -32,6 +33,15 @@
 #include "globals.h"
 #include "pack_types.h"
 #include "lb_type_rr_graph.h"
+#include "vpr_error.h"
+#include "vpr_utils.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "lb_type_rr_graph.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
 
 /*****************************************************************************************
  * Internal functions declarations
@@ -149,6 +159,146 @@ void echo_lb_type_rr_graphs(char* filename, std::vector<t_lb_type_rr_node>* lb_t
     fclose(fp);
 }
 
+/*****************************************************************************************
+ * Serialization functions
+ ******************************************************************************************/
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+std::vector<t_lb_type_rr_node>* read_lb_type_rr_graphs(const std::string& /*file*/) {
+    VPR_THROW(VPR_ERROR_PACK, "read_lb_type_rr_graphs " DISABLE_ERROR);
+}
+
+void write_lb_type_rr_graphs(const std::string& /*file*/, const std::vector<t_lb_type_rr_node>* /*lb_type_rr_graphs*/) {
+    VPR_THROW(VPR_ERROR_PACK, "write_lb_type_rr_graphs " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* Load the graphs written by write_lb_type_rr_graphs. The pb_graph_pin of each node is resolved through its
+ * pin_count_in_cluster, so the pb graphs must already be built from the same architecture. */
+std::vector<t_lb_type_rr_node>* read_lb_type_rr_graphs(const std::string& file) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    MmapFile f(file);
+    ::capnp::FlatArrayMessageReader reader(f.getData(), default_large_capnp_opts());
+    auto graphs = reader.getRoot<VprLbTypeRrGraphs>().getGraphs();
+
+    if (graphs.size() != device_ctx.logical_block_types.size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_PACK, "%s has %u logical block types but the architecture has %zu\n",
+                        file.c_str(), graphs.size(), device_ctx.logical_block_types.size());
+    }
+
+    IntraLbPbPinLookup pb_pin_lookup(device_ctx.logical_block_types);
+
+    std::vector<t_lb_type_rr_node>* lb_type_rr_graphs = new std::vector<t_lb_type_rr_node>[device_ctx.logical_block_types.size()];
+    for (const auto& type : device_ctx.logical_block_types) {
+        if (&type == device_ctx.EMPTY_LOGICAL_BLOCK_TYPE) {
+            continue;
+        }
+
+        auto graph = graphs[type.index];
+        if (graph.getTypeName() != type.name || graph.getTotalPbPins() != type.pb_graph_head->total_pb_pins) {
+            VPR_FATAL_ERROR(VPR_ERROR_PACK, "%s does not match logical block type '%s' of the architecture\n",
+                            file.c_str(), type.name);
+        }
+
+        auto nodes = graph.getNodes();
+        std::vector<t_lb_type_rr_node>& lb_type_rr_graph = lb_type_rr_graphs[type.index];
+        lb_type_rr_graph.resize(nodes.size());
+        for (unsigned int inode = 0; inode < nodes.size(); inode++) {
+            auto node = nodes[inode];
+            t_lb_type_rr_node& lb_rr_node = lb_type_rr_graph[inode];
+
+            lb_rr_node.capacity = node.getCapacity();
+            lb_rr_node.type = (e_lb_rr_type)node.getType();
+            lb_rr_node.intrinsic_cost = node.getIntrinsicCost();
+            if (node.getPbGraphPin() != OPEN) {
+                lb_rr_node.pb_graph_pin = const_cast<t_pb_graph_pin*>(pb_pin_lookup.pb_gpin(type.index, node.getPbGraphPin()));
+            }
+
+            lb_rr_node.num_modes = node.getNumModes();
+
+            auto modes = node.getModes();
+            if (modes.size() == 0) {
+                continue;
+            }
+            lb_rr_node.num_fanout = new short[modes.size()];
+            for (unsigned int imode = 0; imode < modes.size(); imode++) {
+                lb_rr_node.num_fanout[imode] = modes[imode].getOutedges().size();
+            }
+
+            if (!node.getHasOutedges()) {
+                continue;
+            }
+            lb_rr_node.outedges = new t_lb_type_rr_node_edge*[modes.size()];
+            for (unsigned int imode = 0; imode < modes.size(); imode++) {
+                auto outedges = modes[imode].getOutedges();
+                lb_rr_node.outedges[imode] = new t_lb_type_rr_node_edge[outedges.size()];
+                for (unsigned int iedge = 0; iedge < outedges.size(); iedge++) {
+                    lb_rr_node.outedges[imode][iedge].node_index = outedges[iedge].getNodeIndex();
+                    lb_rr_node.outedges[imode][iedge].intrinsic_cost = outedges[iedge].getIntrinsicCost();
+                }
+            }
+        }
+    }
+
+    return lb_type_rr_graphs;
+}
+
+void write_lb_type_rr_graphs(const std::string& file, const std::vector<t_lb_type_rr_node>* lb_type_rr_graphs) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto graphs = builder.initRoot<VprLbTypeRrGraphs>().initGraphs(device_ctx.logical_block_types.size());
+
+    for (const auto& type : device_ctx.logical_block_types) {
+        if (&type == device_ctx.EMPTY_LOGICAL_BLOCK_TYPE) {
+            continue;
+        }
+
+        const std::vector<t_lb_type_rr_node>& lb_type_rr_graph = lb_type_rr_graphs[type.index];
+        auto graph = graphs[type.index];
+        graph.setTypeName(type.name);
+        graph.setTotalPbPins(type.pb_graph_head->total_pb_pins);
+
+        auto nodes = graph.initNodes(lb_type_rr_graph.size());
+        for (unsigned int inode = 0; inode < lb_type_rr_graph.size(); inode++) {
+            const t_lb_type_rr_node& lb_rr_node = lb_type_rr_graph[inode];
+            auto node = nodes[inode];
+
+            node.setCapacity(lb_rr_node.capacity);
+            node.setType(lb_rr_node.type);
+            node.setPbGraphPin(lb_rr_node.pb_graph_pin ? lb_rr_node.pb_graph_pin->pin_count_in_cluster : OPEN);
+            node.setIntrinsicCost(lb_rr_node.intrinsic_cost);
+
+            node.setNumModes(lb_rr_node.num_modes);
+
+            /* Sinks have a num_fanout entry but no modes, so there is at least one entry whenever num_fanout is allocated */
+            int num_fanout_entries = lb_rr_node.num_fanout != nullptr ? std::max(lb_rr_node.num_modes, 1) : 0;
+            auto modes = node.initModes(num_fanout_entries);
+            node.setHasOutedges(lb_rr_node.outedges != nullptr);
+            for (int imode = 0; imode < num_fanout_entries; imode++) {
+                auto outedges = modes[imode].initOutedges(lb_rr_node.num_fanout[imode]);
+                for (int iedge = 0; iedge < lb_rr_node.num_fanout[imode]; iedge++) {
+                    if (lb_rr_node.outedges != nullptr) {
+                        outedges[iedge].setNodeIndex(lb_rr_node.outedges[imode][iedge].node_index);
+                        outedges[iedge].setIntrinsicCost(lb_rr_node.outedges[imode][iedge].intrinsic_cost);
+                    }
+                }
+            }
+        }
+    }
+
+    writeMessageToFile(file, &builder);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
+
 /******************************************************************************************
  * Internal functions
  ******************************************************************************************/
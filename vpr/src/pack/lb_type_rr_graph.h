@@ -8,6 +8,8 @@
 #ifndef LB_TYPE_RR_GRAPH_H
 #define LB_TYPE_RR_GRAPH_H
 
+#include <string>
+
 #include "pack_types.h"
 
 /* Constructors/Destructors */
@@ -19,6 +21,11 @@ int get_lb_type_rr_graph_ext_source_index(t_logical_block_type_ptr lb_type);
 int get_lb_type_rr_graph_ext_sink_index(t_logical_block_type_ptr lb_type);
 int get_lb_type_rr_graph_edge_mode(std::vector<t_lb_type_rr_node>& lb_type_rr_graph, int src_index, int dst_index);
 
+/* Serialization functions (require VTR_ENABLE_CAPNPROTO), used to cache the graphs across runs on the same architecture.
+ * Reading requires the pb graphs to be built, since nodes refer to their pb_graph_pin */
+std::vector<t_lb_type_rr_node>* read_lb_type_rr_graphs(const std::string& file);
+void write_lb_type_rr_graphs(const std::string& file, const std::vector<t_lb_type_rr_node>* lb_type_rr_graphs);
+
 /* Debug functions */
 void echo_lb_type_rr_graphs(char* filename, std::vector<t_lb_type_rr_node>* lb_type_rr_graphs);
 
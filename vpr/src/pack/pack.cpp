@@ -23,6 +23,9 @@
 #include "cluster.h"
 #include "SetupGrid.h"
 #include "re_cluster.h"
+#include "pack_improvement.h"
+#include "cluster_router.h"
+#include "pack_report.h"
 
 /* #define DUMP_PB_GRAPH 1 */
 /* #define DUMP_BLIF_INPUT 1 */
@@ -51,6 +54,8 @@ bool try_pack(t_packer_opts* packer_opts,
     std::vector<t_pack_patterns> list_of_packing_patterns;
     VTR_LOG("Begin packing '%s'.\n", packer_opts->circuit_file_name.c_str());
 
+    helper_ctx.pack_profile.reset(!packer_opts->write_pack_profile.empty());
+
     /* determine number of models in the architecture */
     helper_ctx.num_models = 0;
     cur_model = user_models;
@@ -113,6 +118,9 @@ bool try_pack(t_packer_opts* packer_opts,
         VTR_LOG("Using inter-cluster delay: %g\n", packer_opts->inter_cluster_net_delay);
     }
 
+    //Unroutable intra-logic block routing problems remembered by a previous packing do not apply to this one
+    reset_intra_lb_route_cache();
+
     helper_ctx.target_external_pin_util = parse_target_external_pin_util(packer_opts->target_external_pin_util);
     t_pack_high_fanout_thresholds high_fanout_thresholds = parse_high_fanout_thresholds(packer_opts->high_fanout_threshold);
 
@@ -254,6 +262,7 @@ bool try_pack(t_packer_opts* packer_opts,
             g_vpr_ctx.mutable_atom().lookup.set_atom_clb_net(net, ClusterNetId::INVALID());
         }
         g_vpr_ctx.mutable_floorplanning().cluster_constraints.clear();
+        g_vpr_ctx.mutable_floorplanning().cluster_partitions.clear();
         //attraction_groups.reset_attraction_groups();
 
         free_cluster_placement_stats(helper_ctx.cluster_placement_stats);
@@ -265,9 +274,9 @@ bool try_pack(t_packer_opts* packer_opts,
     /* Packing iterative improvement can be done here */
     /*       Use the re-cluster API to edit it        */
     /******************* Start *************************/
-    VTR_LOG("Start the iterative improvement process\n");
-    //iteratively_improve_packing(*packer_opts, clustering_data, 2);
-    VTR_LOG("the iterative improvement process is done\n");
+    if (packer_opts->pack_num_moves > 0) {
+        iteratively_improve_packing(*packer_opts, clustering_data, packer_opts->pack_verbosity);
+    }
 
     /*
      * auto& cluster_ctx = g_vpr_ctx.clustering();
@@ -277,6 +286,13 @@ bool try_pack(t_packer_opts* packer_opts,
      */
     /******************** End **************************/
 
+    //The cluster constraints may be changed after packing (e.g. for placement macros)
+    g_vpr_ctx.mutable_floorplanning().cluster_partitions.clear();
+
+    if (helper_ctx.pack_profile.enabled()) {
+        write_pack_profile(packer_opts->write_pack_profile, helper_ctx.pack_profile);
+    }
+
     //check clustering and output it
     check_and_output_clustering(*packer_opts, is_clock, arch, helper_ctx.total_clb_num, clustering_data.intra_lb_routing);
 
@@ -0,0 +1,369 @@
+#include "pack_improvement.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "vtr_random.h"
+#include "vtr_time.h"
+
+#include "globals.h"
+#include "re_cluster.h"
+#include "re_cluster_util.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#    include <tbb/task_arena.h>
+#endif
+
+enum class e_pack_move_type {
+    RANDOM_SWAP,
+    SEMI_DIRECTED_SWAP,
+    SEMI_DIRECTED_SAME_TYPE_SWAP
+};
+
+///@brief Move statistics accumulated over all workers
+struct t_pack_improvement_stats {
+    std::atomic<int> num_evaluated{0};
+    std::atomic<int> num_accepted{0};
+    std::atomic<int> ext_nets_reduction{0};
+};
+
+///@brief Serializes the re-clustering commits, and lookups of atoms in clusters that are not claimed
+static std::mutex commit_mutex;
+
+/****************** Static functions declarations ***********************/
+static e_pack_move_type parse_pack_move_type(const std::string& name);
+static bool claim_cluster(ClusterBlockId clb);
+static void release_cluster(ClusterBlockId clb);
+static AtomBlockId pick_atom_in_cluster(ClusterBlockId clb, const t_model* model, vtr::RandState& rand_state);
+static t_pack_molecule* packed_molecule(AtomBlockId atom, const std::unordered_set<AtomBlockId>& clb_atoms);
+static ClusterBlockId propose_swap_cluster(ClusterBlockId clb_1,
+                                           const t_pack_molecule* molecule_1,
+                                           e_pack_move_type move_type,
+                                           vtr::RandState& rand_state);
+static bool molecule_contains(const t_pack_molecule* molecule, AtomBlockId atom);
+static int count_external_nets(const std::unordered_set<AtomBlockId>& clb_atoms,
+                               const t_pack_molecule* removed,
+                               const t_pack_molecule* added);
+static void try_swap_in_claimed_clusters(ClusterBlockId clb_1,
+                                         ClusterBlockId clb_2,
+                                         t_pack_molecule* molecule_1,
+                                         e_pack_move_type move_type,
+                                         vtr::RandState& rand_state,
+                                         t_clustering_data& clustering_data,
+                                         int verbosity,
+                                         t_pack_improvement_stats& stats);
+static void try_pack_moves(int num_moves,
+                           e_pack_move_type move_type,
+                           vtr::RandState rand_state,
+                           t_clustering_data& clustering_data,
+                           int verbosity,
+                           t_pack_improvement_stats& stats);
+
+/****************** API functions ***********************/
+void iteratively_improve_packing(const t_packer_opts& packer_opts,
+                                 t_clustering_data& clustering_data,
+                                 int verbosity) {
+    vtr::ScopedStartFinishTimer timer("Packing iterative improvement");
+
+    size_t num_clusters = g_vpr_ctx.clustering().clb_nlist.blocks().size();
+    if (num_clusters < 2 || packer_opts.pack_num_moves <= 0) {
+        return;
+    }
+
+    e_pack_move_type move_type = parse_pack_move_type(packer_opts.pack_move_type);
+
+    //The atoms lookup is built lazily by cluster_to_atoms(), so build it once before any worker runs
+    auto& helper_ctx = g_vpr_ctx.mutable_cl_helper();
+    if (helper_ctx.atoms_lookup.empty()) {
+        init_clb_atoms_lookup(helper_ctx.atoms_lookup);
+    }
+
+    auto& packing_multithreading_ctx = g_vpr_ctx.mutable_packing_multithreading();
+    packing_multithreading_ctx.clb_in_flight.assign(num_clusters, false);
+    packing_multithreading_ctx.mu = vtr::vector<ClusterBlockId, std::mutex>(num_clusters);
+
+#ifdef VPR_USE_TBB
+    int num_workers = tbb::this_task_arena::max_concurrency();
+#else
+    int num_workers = 1;
+#endif
+
+    t_pack_improvement_stats stats;
+    auto run_worker = [&](int iworker) {
+        //Split the moves evenly, and give each worker its own (deterministic) random sequence
+        int num_moves = packer_opts.pack_num_moves / num_workers
+                        + (iworker < packer_opts.pack_num_moves % num_workers ? 1 : 0);
+        try_pack_moves(num_moves, move_type, vtr::RandState(iworker + 1), clustering_data, verbosity, stats);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(0, num_workers, run_worker);
+#else
+    for (int iworker = 0; iworker < num_workers; ++iworker) {
+        run_worker(iworker);
+    }
+#endif
+
+    packing_multithreading_ctx.clb_in_flight.clear();
+    packing_multithreading_ctx.mu = vtr::vector<ClusterBlockId, std::mutex>();
+
+    VTR_LOG("Packing iterative improvement (%s, %d worker%s): %d moves, %d swaps evaluated, %d accepted, %d external nets removed\n",
+            packer_opts.pack_move_type.c_str(), num_workers, num_workers == 1 ? "" : "s",
+            packer_opts.pack_num_moves, stats.num_evaluated.load(), stats.num_accepted.load(),
+            stats.ext_nets_reduction.load());
+}
+
+/****************** Static functions definitions ***********************/
+static e_pack_move_type parse_pack_move_type(const std::string& name) {
+    if (name == "randomSwap") {
+        return e_pack_move_type::RANDOM_SWAP;
+    } else if (name == "semiDirectedSwap") {
+        return e_pack_move_type::SEMI_DIRECTED_SWAP;
+    } else if (name == "semiDirectedSameTypeSwap") {
+        return e_pack_move_type::SEMI_DIRECTED_SAME_TYPE_SWAP;
+    }
+    VPR_FATAL_ERROR(VPR_ERROR_PACK, "Unknown packing move type '%s' (expected randomSwap, semiDirectedSwap or semiDirectedSameTypeSwap)\n",
+                    name.c_str());
+}
+
+/**
+ * @brief Marks clb as in flight, returning false if another worker already has it
+ *
+ * The mutex is only held while testing and setting the flag, so a worker never
+ * blocks on a cluster; it just gives up on the move.
+ */
+static bool claim_cluster(ClusterBlockId clb) {
+    auto& packing_multithreading_ctx = g_vpr_ctx.mutable_packing_multithreading();
+
+    std::lock_guard<std::mutex> lock(packing_multithreading_ctx.mu[clb]);
+    if (packing_multithreading_ctx.clb_in_flight[clb]) {
+        return false;
+    }
+    packing_multithreading_ctx.clb_in_flight[clb] = true;
+    return true;
+}
+
+static void release_cluster(ClusterBlockId clb) {
+    auto& packing_multithreading_ctx = g_vpr_ctx.mutable_packing_multithreading();
+
+    std::lock_guard<std::mutex> lock(packing_multithreading_ctx.mu[clb]);
+    packing_multithreading_ctx.clb_in_flight[clb] = false;
+}
+
+/**
+ * @brief Returns a random atom of the claimed cluster clb (of the given model, if not nullptr),
+ *        or an invalid id if there is none
+ */
+static AtomBlockId pick_atom_in_cluster(ClusterBlockId clb, const t_model* model, vtr::RandState& rand_state) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    std::vector<AtomBlockId> candidates;
+    for (AtomBlockId atom : *cluster_to_atoms(clb)) {
+        if (model == nullptr || atom_ctx.nlist.block_model(atom) == model) {
+            candidates.push_back(atom);
+        }
+    }
+
+    if (candidates.empty()) {
+        return AtomBlockId::INVALID();
+    }
+    //Sort so the pick does not depend on the hash set's iteration order
+    std::sort(candidates.begin(), candidates.end());
+    return candidates[vtr::irand(candidates.size() - 1, rand_state)];
+}
+
+/**
+ * @brief Returns the (non-chain) molecule atom was packed with, i.e. the first of
+ *        atom's molecules whose atoms are all in clb_atoms, or nullptr
+ */
+static t_pack_molecule* packed_molecule(AtomBlockId atom, const std::unordered_set<AtomBlockId>& clb_atoms) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    auto rng = atom_ctx.atom_molecules.equal_range(atom);
+    for (auto it = rng.first; it != rng.second; ++it) {
+        t_pack_molecule* molecule = it->second;
+
+        bool packed = std::all_of(molecule->atom_block_ids.begin(), molecule->atom_block_ids.end(),
+                                  [&](AtomBlockId blk) { return !blk || clb_atoms.count(blk); });
+        if (packed) {
+            //Chains span several clusters in a fixed arrangement, and are never swapped
+            return molecule->is_chain() ? nullptr : molecule;
+        }
+    }
+    return nullptr;
+}
+
+///@brief Returns the cluster to swap molecule_1 (of cluster clb_1) with, or an invalid id
+static ClusterBlockId propose_swap_cluster(ClusterBlockId clb_1,
+                                           const t_pack_molecule* molecule_1,
+                                           e_pack_move_type move_type,
+                                           vtr::RandState& rand_state) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+    ClusterBlockId clb_2 = ClusterBlockId::INVALID();
+
+    if (move_type == e_pack_move_type::RANDOM_SWAP) {
+        int num_clusters = g_vpr_ctx.clustering().clb_nlist.blocks().size();
+        clb_2 = ClusterBlockId(vtr::irand(num_clusters - 1, rand_state));
+    } else {
+        //Follow a random net of molecule_1 to the cluster of one of its other pins
+        std::vector<AtomNetId> nets;
+        for (AtomBlockId blk : molecule_1->atom_block_ids) {
+            if (!blk) continue;
+            for (AtomPinId pin : atom_ctx.nlist.block_pins(blk)) {
+                nets.push_back(atom_ctx.nlist.pin_net(pin));
+            }
+        }
+        if (nets.empty()) {
+            return ClusterBlockId::INVALID();
+        }
+
+        AtomNetId net = nets[vtr::irand(nets.size() - 1, rand_state)];
+        auto pins = atom_ctx.nlist.net_pins(net);
+        AtomPinId pin = *(pins.begin() + vtr::irand(pins.size() - 1, rand_state));
+
+        std::lock_guard<std::mutex> lock(commit_mutex);
+        clb_2 = atom_to_cluster(atom_ctx.nlist.pin_block(pin));
+    }
+
+    return clb_2 == clb_1 ? ClusterBlockId::INVALID() : clb_2;
+}
+
+static bool molecule_contains(const t_pack_molecule* molecule, AtomBlockId atom) {
+    return std::find(molecule->atom_block_ids.begin(), molecule->atom_block_ids.end(), atom)
+           != molecule->atom_block_ids.end();
+}
+
+/**
+ * @brief Returns the number of nets connecting the atoms of a cluster to
+ *        atoms outside it, once removed is taken out of and added put into the cluster
+ *
+ * removed and added may be nullptr to count the current cluster.
+ */
+static int count_external_nets(const std::unordered_set<AtomBlockId>& clb_atoms,
+                               const t_pack_molecule* removed,
+                               const t_pack_molecule* added) {
+    auto& atom_nlist = g_vpr_ctx.atom().nlist;
+
+    auto in_cluster = [&](AtomBlockId blk) {
+        if (added && molecule_contains(added, blk)) return true;
+        if (removed && molecule_contains(removed, blk)) return false;
+        return clb_atoms.count(blk) > 0;
+    };
+
+    std::vector<AtomNetId> nets;
+    auto add_block_nets = [&](AtomBlockId blk) {
+        for (AtomPinId pin : atom_nlist.block_pins(blk)) {
+            nets.push_back(atom_nlist.pin_net(pin));
+        }
+    };
+    for (AtomBlockId blk : clb_atoms) {
+        if (!removed || !molecule_contains(removed, blk)) {
+            add_block_nets(blk);
+        }
+    }
+    if (added) {
+        for (AtomBlockId blk : added->atom_block_ids) {
+            if (blk) add_block_nets(blk);
+        }
+    }
+    std::sort(nets.begin(), nets.end());
+    nets.erase(std::unique(nets.begin(), nets.end()), nets.end());
+
+    int num_external = 0;
+    for (AtomNetId net : nets) {
+        for (AtomPinId pin : atom_nlist.net_pins(net)) {
+            if (!in_cluster(atom_nlist.pin_block(pin))) {
+                ++num_external;
+                break;
+            }
+        }
+    }
+    return num_external;
+}
+
+/**
+ * @brief Picks a molecule of clb_2, and swaps it with molecule_1 (of clb_1) if that
+ *        reduces the external nets of the two clusters
+ *
+ * Both clusters must be claimed by the caller, which allows evaluating the swap
+ * without any lock.
+ */
+static void try_swap_in_claimed_clusters(ClusterBlockId clb_1,
+                                         ClusterBlockId clb_2,
+                                         t_pack_molecule* molecule_1,
+                                         e_pack_move_type move_type,
+                                         vtr::RandState& rand_state,
+                                         t_clustering_data& clustering_data,
+                                         int verbosity,
+                                         t_pack_improvement_stats& stats) {
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    if (!check_type_and_mode_compitability(clb_1, clb_2, verbosity)) {
+        return;
+    }
+
+    const t_model* model = nullptr;
+    if (move_type == e_pack_move_type::SEMI_DIRECTED_SAME_TYPE_SWAP) {
+        model = atom_ctx.nlist.block_model(molecule_1->atom_block_ids[molecule_1->root]);
+    }
+
+    AtomBlockId atom_2 = pick_atom_in_cluster(clb_2, model, rand_state);
+    if (!atom_2) {
+        return;
+    }
+    const std::unordered_set<AtomBlockId>& clb_atoms_1 = *cluster_to_atoms(clb_1);
+    const std::unordered_set<AtomBlockId>& clb_atoms_2 = *cluster_to_atoms(clb_2);
+    t_pack_molecule* molecule_2 = packed_molecule(atom_2, clb_atoms_2);
+    if (!molecule_2) {
+        return;
+    }
+
+    ++stats.num_evaluated;
+    int cost_before = count_external_nets(clb_atoms_1, nullptr, nullptr)
+                      + count_external_nets(clb_atoms_2, nullptr, nullptr);
+    int cost_after = count_external_nets(clb_atoms_1, molecule_1, molecule_2)
+                     + count_external_nets(clb_atoms_2, molecule_2, molecule_1);
+    if (cost_after >= cost_before) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(commit_mutex);
+    if (swap_two_molecules(molecule_1, molecule_2, true, verbosity, clustering_data)) {
+        ++stats.num_accepted;
+        stats.ext_nets_reduction += cost_before - cost_after;
+    }
+}
+
+static void try_pack_moves(int num_moves,
+                           e_pack_move_type move_type,
+                           vtr::RandState rand_state,
+                           t_clustering_data& clustering_data,
+                           int verbosity,
+                           t_pack_improvement_stats& stats) {
+    int num_clusters = g_vpr_ctx.clustering().clb_nlist.blocks().size();
+
+    for (int imove = 0; imove < num_moves; ++imove) {
+        ClusterBlockId clb_1(vtr::irand(num_clusters - 1, rand_state));
+        if (!claim_cluster(clb_1)) {
+            continue;
+        }
+
+        t_pack_molecule* molecule_1 = nullptr;
+        AtomBlockId atom_1 = pick_atom_in_cluster(clb_1, nullptr, rand_state);
+        if (atom_1) {
+            molecule_1 = packed_molecule(atom_1, *cluster_to_atoms(clb_1));
+        }
+
+        if (molecule_1) {
+            ClusterBlockId clb_2 = propose_swap_cluster(clb_1, molecule_1, move_type, rand_state);
+            if (clb_2 && claim_cluster(clb_2)) {
+                try_swap_in_claimed_clusters(clb_1, clb_2, molecule_1, move_type, rand_state, clustering_data, verbosity, stats);
+                release_cluster(clb_2);
+            }
+        }
+
+        release_cluster(clb_1);
+    }
+}
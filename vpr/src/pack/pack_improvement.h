@@ -0,0 +1,41 @@
+#ifndef PACK_IMPROVEMENT_H
+#define PACK_IMPROVEMENT_H
+/**
+ * @file
+ * @brief Iterative improvement of a complete clustering with the re-clustering API
+ *
+ * After do_clustering() is done, molecules are swapped between clusters of the
+ * same type and mode whenever the swap reduces the number of nets that leave
+ * the two clusters (i.e. the external pins they use).
+ *
+ * Swaps are proposed and evaluated by several workers concurrently. A worker
+ * claims the two clusters of a swap through the clb_in_flight flags (each
+ * guarded by its mutex in PackingMultithreadingContext) before reading them, so
+ * no two workers ever look at the same cluster at once. The swap itself is
+ * committed with swap_two_molecules(), which also updates structures shared by
+ * all clusters of a type (e.g. the cluster placement stats), so commits are
+ * serialized.
+ */
+
+#include "pack_types.h"
+#include "cluster_util.h"
+
+/**
+ * @brief Tries packer_opts.pack_num_moves molecule swaps of packer_opts.pack_move_type,
+ *        keeping those that reduce the clusters' external net usage.
+ *
+ * The move types are:
+ *   - randomSwap: swaps random molecules of two random clusters
+ *   - semiDirectedSwap: swaps a random molecule with a random molecule of a
+ *     cluster it is connected to
+ *   - semiDirectedSameTypeSwap: like semiDirectedSwap, but the two molecules'
+ *     root atoms must implement the same model
+ *
+ * Since swaps run concurrently, the result depends on thread timing when more
+ * than one worker is used.
+ */
+void iteratively_improve_packing(const t_packer_opts& packer_opts,
+                                 t_clustering_data& clustering_data,
+                                 int verbosity);
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef VPR_PACK_PROFILE_H
+#define VPR_PACK_PROFILE_H
+/**
+ * @file
+ * @brief Wall time and call count instrumentation of the packer's phases (--write_pack_profile)
+ *
+ * Phases nest (e.g. try_pack_molecule routes the cluster), so the time of a phase includes
+ * the time of the phases it calls.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+///@brief Packing phases recorded by the profile
+enum class e_pack_phase {
+    SEED_SELECTION,       ///<Picking the seed molecule of a new cluster
+    CANDIDATE_GATHERING,  ///<add_cluster_molecule_candidates_by_*
+    TRY_PACK_MOLECULE,    ///<Trying to add a molecule to a cluster
+    INTRA_LB_ROUTE,       ///<Routing a cluster's nets
+    TIMING_GAIN_UPDATE,   ///<Updating the timing gain of the atoms connected to a net
+    TIMING_UPDATE,        ///<Updating the timing analysis during clustering
+    NUM_PACK_PHASES
+};
+
+///@brief Returns the name of phase used in the profile report
+const char* pack_phase_name(e_pack_phase phase);
+
+///@brief Statistics of one phase
+struct t_pack_phase_stats {
+    size_t calls = 0;
+    double seconds = 0.;
+    size_t successes = 0; ///<Calls which reported success (only recorded by phases with an outcome)
+    size_t failures = 0;  ///<Calls which reported failure (only recorded by phases with an outcome)
+};
+
+///@brief Per phase statistics of a packing run, recorded only when enabled
+class PackProfile {
+  public:
+    bool enabled() const { return enabled_; }
+
+    ///@brief Enables or disables recording, and clears the recorded statistics
+    void reset(bool enable) {
+        enabled_ = enable;
+        stats_.fill(t_pack_phase_stats());
+    }
+
+    void record(e_pack_phase phase, double seconds, int outcome) {
+        t_pack_phase_stats& stats = stats_[size_t(phase)];
+        ++stats.calls;
+        stats.seconds += seconds;
+        if (outcome > 0) {
+            ++stats.successes;
+        } else if (outcome == 0) {
+            ++stats.failures;
+        }
+    }
+
+    const t_pack_phase_stats& stats(e_pack_phase phase) const { return stats_[size_t(phase)]; }
+
+  private:
+    bool enabled_ = false;
+    std::array<t_pack_phase_stats, size_t(e_pack_phase::NUM_PACK_PHASES)> stats_;
+};
+
+/**
+ * @brief Records the wall time of its scope as one call of a phase
+ *
+ * Does nothing (not even reading the clock) if the profile is disabled.
+ */
+class PackPhaseTimer {
+  public:
+    PackPhaseTimer(PackProfile& profile, e_pack_phase phase)
+        : profile_(profile.enabled() ? &profile : nullptr)
+        , phase_(phase) {
+        if (profile_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    PackPhaseTimer(const PackPhaseTimer&) = delete;
+    PackPhaseTimer& operator=(const PackPhaseTimer&) = delete;
+
+    ~PackPhaseTimer() {
+        if (profile_) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+            profile_->record(phase_, elapsed.count(), outcome_);
+        }
+    }
+
+    ///@brief Sets the outcome of the call
+    void set_success(bool success) { outcome_ = success ? 1 : 0; }
+
+  private:
+    PackProfile* profile_;
+    e_pack_phase phase_;
+    std::chrono::steady_clock::time_point start_;
+    int outcome_ = -1; //No outcome
+};
+
+#endif
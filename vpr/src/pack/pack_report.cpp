@@ -5,9 +5,11 @@
 #include "vpr_types.h"
 #include "vpr_utils.h"
 #include "histogram.h"
+#include "vpr_error.h"
 
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 
 void report_packing_pin_usage(std::ostream& os, const VprContext& ctx) {
     os << "#Packing pin usage report\n";
@@ -90,3 +92,53 @@ void report_packing_pin_usage(std::ostream& os, const VprContext& ctx) {
         os << "\n";
     }
 }
+
+const char* pack_phase_name(e_pack_phase phase) {
+    switch (phase) {
+        case e_pack_phase::SEED_SELECTION:
+            return "seed_selection";
+        case e_pack_phase::CANDIDATE_GATHERING:
+            return "candidate_gathering";
+        case e_pack_phase::TRY_PACK_MOLECULE:
+            return "try_pack_molecule";
+        case e_pack_phase::INTRA_LB_ROUTE:
+            return "intra_lb_route";
+        case e_pack_phase::TIMING_GAIN_UPDATE:
+            return "timing_gain_update";
+        case e_pack_phase::TIMING_UPDATE:
+            return "timing_update";
+        default:
+            VTR_ASSERT_MSG(false, "Unknown packing phase");
+            return "";
+    }
+}
+
+void write_pack_profile(const std::string& filename, const PackProfile& profile) {
+    std::ofstream os(filename);
+    if (!os) {
+        VPR_FATAL_ERROR(VPR_ERROR_PACK, "Failed to open packing profile file '%s'\n", filename.c_str());
+    }
+
+    os << std::setprecision(6);
+
+    os << "{\n";
+    os << "  \"phases\": [\n";
+    for (size_t iphase = 0; iphase < size_t(e_pack_phase::NUM_PACK_PHASES); ++iphase) {
+        e_pack_phase phase = e_pack_phase(iphase);
+        const t_pack_phase_stats& stats = profile.stats(phase);
+
+        os << "    {";
+        os << "\"phase\": \"" << pack_phase_name(phase) << "\", ";
+        os << "\"calls\": " << stats.calls << ", ";
+        os << "\"seconds\": " << stats.seconds << ", ";
+        os << "\"successes\": " << stats.successes << ", ";
+        os << "\"failures\": " << stats.failures;
+        os << "}";
+        if (iphase + 1 < size_t(e_pack_phase::NUM_PACK_PHASES)) {
+            os << ",";
+        }
+        os << "\n";
+    }
+    os << "  ]\n";
+    os << "}\n";
+}
@@ -2,8 +2,12 @@
 #define VPR_PACK_REPORT_H
 
 #include <iosfwd>
+#include <string>
 #include "vpr_context.h"
 
 void report_packing_pin_usage(std::ostream& os, const VprContext& ctx);
 
+///@brief Writes the per phase statistics of profile as a JSON table
+void write_pack_profile(const std::string& filename, const PackProfile& profile);
+
 #endif
@@ -7,12 +7,13 @@
  * Defines core data structures used in packing
  */
 #include <map>
-#include <unordered_map>
 #include <vector>
 
 #include "arch_types.h"
 #include "atom_netlist_fwd.h"
 #include "attraction_groups.h"
+#include "vtr_stamped_id_map.h"
+#include "vtr_flat_hash_map.h"
 
 /**************************************************************************
  * Packing Algorithm Enumerations
@@ -32,17 +33,40 @@ const std::vector<const char*> lb_rr_type_str{
  * Packing Algorithm Data Structures
  ***************************************************************************/
 
-/* Stores statistical information for a physical cluster_ctx.blocks such as costs and usages */
+class t_pb;
+
+/* A pin class of a pb which a net uses to enter (input) or leave (output) the pb */
+struct t_lookahead_pin_use {
+    t_pb* pb;
+    int pin_class;
+    bool is_output;
+
+    bool operator==(const t_lookahead_pin_use& other) const {
+        return pb == other.pb && pin_class == other.pin_class && is_output == other.is_output;
+    }
+};
+
+/* The pins of a net in the cluster, and the pin classes they make the net use */
+struct t_lookahead_net {
+    std::vector<AtomPinId> pins;
+    std::vector<t_lookahead_pin_use> uses;
+};
+
+/* Stores statistical information for a physical cluster_ctx.blocks such as costs and usages
+ *
+ * The gain and pin count tables are vtr::stamped_id_maps rather than std::maps: they are
+ * filled for every pb of every cluster, and keeping the entries in dense vectors avoids
+ * allocating (and freeing) a tree node per atom. */
 struct t_pb_stats {
     /* Packing statistics */
-    std::map<AtomBlockId, float> gain; /* Attraction (inverse of cost) function */
+    vtr::stamped_id_map<AtomBlockId, float> gain; /* Attraction (inverse of cost) function */
 
-    std::map<AtomBlockId, float> timinggain;     /* The timing criticality score of this atom cluster_ctx.blocks.
-                                                  * Determined by the most critical atom net
-                                                  * between this atom cluster_ctx.blocks and any atom cluster_ctx.blocks in
-                                                  * the current pb */
-    std::map<AtomBlockId, float> connectiongain; /* Weighted sum of connections to attraction function */
-    std::map<AtomBlockId, float> sharinggain;    /* How many nets on an atom cluster_ctx.blocks are already in the pb under consideration */
+    vtr::stamped_id_map<AtomBlockId, float> timinggain;     /* The timing criticality score of this atom cluster_ctx.blocks.
+                                                             * Determined by the most critical atom net
+                                                             * between this atom cluster_ctx.blocks and any atom cluster_ctx.blocks in
+                                                             * the current pb */
+    vtr::stamped_id_map<AtomBlockId, float> connectiongain; /* Weighted sum of connections to attraction function */
+    vtr::stamped_id_map<AtomBlockId, float> sharinggain;    /* How many nets on an atom cluster_ctx.blocks are already in the pb under consideration */
 
     /* This is the gain used for hill-climbing. It stores*
      * the reduction in the number of pins that adding this atom cluster_ctx.blocks to the the*
@@ -50,13 +74,13 @@ struct t_pb_stats {
      * addition of an atom cluster_ctx.blocks to a pb may reduce the number of inputs     *
      * required if it shares inputs with all other BLEs and it's output is  *
      * used by all other child pbs in this parent pb.                               */
-    std::map<AtomBlockId, float> hillgain;
+    vtr::stamped_id_map<AtomBlockId, float> hillgain;
 
     /*
      * stores the number of times atoms have failed to be packed into the cluster
      * key: root block id of the molecule, value: number of times the molecule has failed to be packed into the cluster
      */
-    std::map<AtomBlockId, int> atom_failures;
+    vtr::stamped_id_map<AtomBlockId, int> atom_failures;
 
     int pulled_from_atom_groups;
     int num_att_group_atoms_used;
@@ -74,17 +98,35 @@ struct t_pb_stats {
     bool explore_transitive_fanout;                                       /* If no marked candidate molecules and no high fanout nets to determine next candidate molecule then explore molecules on transitive fanout */
     std::map<AtomBlockId, t_pack_molecule*> transitive_fanout_candidates; // Holding trasitive fanout candidates key: root block id of the molecule, value: pointer to the molecule
 
+    /* The transitive fanout candidates are maintained incrementally: only the marked_nets added since
+     * the last exploration are explored. The unpacked atoms on the inter-block nets of each (closed)
+     * cluster reached are cached, since many nets of the cluster reach the same clusters. */
+    size_t num_transitive_explored_nets;                                                 // marked_nets[0..num_transitive_explored_nets-1] have been explored
+    vtr::flat_hash_map<ClusterBlockId, std::vector<AtomBlockId>> transitive_cluster_atoms; // key: cluster reached, value: atoms (with repeats) on its inter-block nets
+
+    /* The pins of each high fanout net before this index are known to be packed, so they are
+     * not walked again each time the net is explored */
+    vtr::flat_hash_map<AtomNetId, size_t> high_fanout_net_first_unpacked_pin;
+
     /* How many pins of each atom net are contained in the *
      * currently open pb?                                  */
-    std::map<AtomNetId, int> num_pins_of_net_in_pb;
+    vtr::stamped_id_map<AtomNetId, int> num_pins_of_net_in_pb;
 
     /* Record of pins of class used */
-    std::vector<std::unordered_map<size_t, AtomNetId>> input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] nets using this input pin class */
-    std::vector<std::unordered_map<size_t, AtomNetId>> output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] nets using this output pin class */
+    std::vector<int> input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] most pins of this input class used by the committed molecules */
+    std::vector<int> output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] most pins of this output class used by the committed molecules */
+
+    /* Number of nets speculatively using each pin class. They are maintained incrementally (see
+     * update_lookahead_pins_used()): adding a molecule only changes the usage of its own nets. */
+    std::vector<int> lookahead_input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] */
+    std::vector<int> lookahead_output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] */
 
-    /* Use vector because array size is expected to be small so runtime should be faster using vector than map despite the O(N) vs O(log(n)) behaviour.*/
-    std::vector<std::vector<AtomNetId>> lookahead_input_pins_used;  /* [0..pb_graph_node->num_pin_classes-1] vector of input pins of this class that are speculatively used */
-    std::vector<std::vector<AtomNetId>> lookahead_output_pins_used; /* [0..pb_graph_node->num_pin_classes-1] vector of input pins of this class that are speculatively used */
+    /* Cluster (root pb) only: the pins in the cluster and the pin classes used, of each net with pins
+     * in the cluster, and the previous state of the nets updated for the molecule being tried (so it
+     * can be reverted, or committed). A default t_lookahead_net means the net had no pins in the cluster. */
+    vtr::flat_hash_map<AtomNetId, t_lookahead_net> lookahead_nets;
+    std::vector<std::pair<AtomNetId, t_lookahead_net>> lookahead_undo;
+    int num_lookahead_atoms; /* Atoms whose pins are in lookahead_nets (rebuilt if it differs from num_child_blocks_in_pb) */
 
     //The attraction group associated with the cluster.
     //Will be AttractGroupId::INVALID() if no attraction group is associated with the cluster.
@@ -164,12 +206,61 @@ struct t_lb_rr_node_stats {
 /*
  * Data structure forming the route tree of a net within one logic cluster_ctx.blocks.
  *
- * A net is implemented using routing resource nodes.  The t_lb_trace data structure records one of the nodes used by the net and the connections
- * to other nodes
+ * A net is implemented using routing resource nodes.  The t_lb_trace data structure records the nodes used by the net and the connections
+ * between them.
+ *
+ * The tree is rebuilt for every net on every routing attempt, so it is stored flat instead of as nested vectors: trace node 0 is the
+ * root (the net's source), and the trace nodes refer to their parent, children and siblings by index. clear() keeps the storage for
+ * the next route.
  */
 struct t_lb_trace {
-    int current_node;                   /* current t_lb_type_rr_node used by net */
-    std::vector<t_lb_trace> next_nodes; /* index of previous edge that drives current node */
+    struct t_node {
+        int current_node;      /* t_lb_type_rr_node used by net */
+        int parent = OPEN;     /* trace node driving this one, OPEN for the root */
+        int first_child = OPEN;
+        int last_child = OPEN;
+        int next_sibling = OPEN;
+    };
+    std::vector<t_node> nodes;
+
+    bool empty() const { return nodes.empty(); }
+    void clear() { nodes.clear(); }
+
+    /* Returns the root trace node, or OPEN if the tree is empty */
+    int root() const { return nodes.empty() ? OPEN : 0; }
+
+    /* Adds lb_type_rr_node inode as the last child of trace node iparent (OPEN for the root), and returns its index */
+    int add_node(int inode, int iparent) {
+        int itrace = nodes.size();
+        t_node node;
+        node.current_node = inode;
+        node.parent = iparent;
+        nodes.push_back(node);
+
+        if (iparent != OPEN) {
+            if (nodes[iparent].last_child == OPEN) {
+                nodes[iparent].first_child = itrace;
+            } else {
+                nodes[nodes[iparent].last_child].next_sibling = itrace;
+            }
+            nodes[iparent].last_child = itrace;
+        }
+        return itrace;
+    }
+
+    /* Returns the trace node after itrace in a depth-first pre-order walk of the tree (children in the order they
+     * were added), or OPEN if itrace is the last one. Walking from root() visits every node without recursion. */
+    int next_preorder(int itrace) const {
+        if (nodes[itrace].first_child != OPEN) {
+            return nodes[itrace].first_child;
+        }
+        for (; itrace != OPEN; itrace = nodes[itrace].parent) {
+            if (nodes[itrace].next_sibling != OPEN) {
+                return nodes[itrace].next_sibling;
+            }
+        }
+        return OPEN;
+    }
 };
 
 /* Represents a net used inside a logic cluster_ctx.blocks and the physical nodes used by the net */
@@ -178,11 +269,10 @@ struct t_intra_lb_net {
     std::vector<int> terminals;        /* endpoints of the intra_lb_net, 0th position is the source, all others are sinks */
     std::vector<AtomPinId> atom_pins;  /* AtomPin's associated with each terminal */
     std::vector<bool> fixed_terminals; /* Marks a terminal as having a fixed target (i.e. a pin not a sink) */
-    t_lb_trace* rt_tree;               /* Route tree head */
+    t_lb_trace rt_tree;                /* Route tree, empty if the net is not routed */
 
     t_intra_lb_net() {
         atom_net_id = AtomNetId::INVALID();
-        rt_tree = nullptr;
     }
 };
 
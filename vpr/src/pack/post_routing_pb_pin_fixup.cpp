@@ -18,6 +18,34 @@
 /* Include global variables of VPR */
 #include "globals.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
+/********************************************************************
+ * The fix-up results of a clustered block. Each block is fixed up
+ * independently, so the results are only merged into the clustering
+ * context once all the blocks are done.
+ *******************************************************************/
+struct t_clb_post_routing_fixup {
+    std::map<int, ClusterNetId> pin_nets;       /* post_routing_clb_pin_nets of the block */
+    std::map<int, int> pre_routing_pin_mapping; /* pre_routing_net_pin_mapping of the block */
+    size_t num_mismatches = 0;
+    size_t num_fixup = 0;
+};
+
+/********************************************************************
+ * Scratch space of a thread fixing up the routing traces of blocks
+ *******************************************************************/
+struct t_pb_pin_fixup_scratch {
+    /* Atom pin originally mapped to each top-level pb_route of the
+     * current block (indexed by pb_route id), if it was cached */
+    std::vector<AtomPinId> atom_pins;
+    /* The pb_routes with a valid atom pin, to reset atom_pins */
+    std::vector<int> cached_pb_routes;
+};
+
 /********************************************************************
  * Give a given pin index, find the side where this pin is located 
  * on the physical tile
@@ -50,10 +78,11 @@ static std::vector<e_side> find_physical_tile_pin_side(t_physical_tile_type_ptr
 static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_list,
                                                          const AtomContext& atom_ctx,
                                                          const DeviceContext& device_ctx,
-                                                         ClusteringContext& clustering_ctx,
+                                                         const ClusteringContext& clustering_ctx,
                                                          const vtr::vector<RRNodeId, ParentNetId>& rr_node_nets,
                                                          const t_pl_loc& grid_coord,
                                                          const ClusterBlockId& blk_id,
+                                                         std::map<int, ClusterNetId>& clb_pin_nets,
                                                          size_t& num_mismatches,
                                                          const bool& verbose,
                                                          bool is_flat) {
@@ -228,7 +257,7 @@ static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_li
         }
 
         /* Update the clustering context with net modification */
-        clustering_ctx.post_routing_clb_pin_nets[blk_id][pb_graph_pin->pin_count_in_cluster] = cluster_equivalent_net_id;
+        clb_pin_nets[pb_graph_pin->pin_count_in_cluster] = cluster_equivalent_net_id;
 
         std::string routing_net_name("unmapped");
         if (clustering_ctx.clb_nlist.valid_net_id(cluster_equivalent_net_id)) {
@@ -265,6 +294,7 @@ static void update_cluster_pin_with_post_routing_results(const Netlist<>& net_li
  *******************************************************************/
 static int find_target_pb_route_from_equivalent_pins(const AtomContext& atom_ctx,
                                                      const ClusteringContext& clustering_ctx,
+                                                     const std::map<int, ClusterNetId>& clb_pin_nets,
                                                      const ClusterBlockId& blk_id,
                                                      t_pb* pb,
                                                      const t_pb_graph_pin* source_pb_graph_pin,
@@ -301,10 +331,10 @@ static int find_target_pb_route_from_equivalent_pins(const AtomContext& atom_ctx
             continue;
         }
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pin);
+        auto remapped_result = clb_pin_nets.find(pin);
 
         /* Skip this pin if it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == clb_pin_nets.end()) {
             continue;
         }
 
@@ -488,13 +518,18 @@ static AtomPinId find_mapped_atom_pin(const AtomContext& atom_ctx,
  *     
  *     Anything violates the assumption will be NOT be cached!!!
  *******************************************************************/
-static std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> cache_atom_pin_to_pb_pin_mapping(const AtomContext& atom_ctx,
-                                                                                                   const IntraLbPbPinLookup& intra_lb_pb_pin_lookup,
-                                                                                                   const ClusteringContext& clustering_ctx,
-                                                                                                   const ClusterBlockId& blk_id,
-                                                                                                   t_pb* pb,
-                                                                                                   t_logical_block_type_ptr logical_block) {
-    std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> atom_pin_to_pb_pin_mapping;
+static void cache_atom_pin_to_pb_pin_mapping(const AtomContext& atom_ctx,
+                                             const IntraLbPbPinLookup& intra_lb_pb_pin_lookup,
+                                             const std::map<int, ClusterNetId>& clb_pin_nets,
+                                             const ClusterBlockId& blk_id,
+                                             t_pb* pb,
+                                             t_logical_block_type_ptr logical_block,
+                                             t_pb_pin_fixup_scratch& scratch) {
+    size_t num_pb_pins = logical_block->pb_graph_head->total_pb_pins;
+    if (scratch.atom_pins.size() < num_pb_pins) {
+        scratch.atom_pins.resize(num_pb_pins, AtomPinId::INVALID());
+    }
+
     for (int pb_type_pin = 0; pb_type_pin < logical_block->pb_type->num_pins; ++pb_type_pin) {
         /* Skip non-equivalent ports, no need to do fix-up */
         const t_pb_graph_pin* pb_graph_pin = get_pb_graph_node_pin_from_block_pin(blk_id, pb_type_pin);
@@ -510,10 +545,10 @@ static std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> cache_atom_pin
         VTR_ASSERT(pb_graph_pin->parent_node == pb->pb_graph_node);
         VTR_ASSERT(pb_graph_pin->parent_node->is_root());
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pb_graph_pin->pin_count_in_cluster);
+        auto remapped_result = clb_pin_nets.find(pb_graph_pin->pin_count_in_cluster);
 
         /* Skip this pin: it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == clb_pin_nets.end()) {
             continue;
         }
 
@@ -532,11 +567,22 @@ static std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> cache_atom_pin
 
         /* Sometimes the routing traces is not what we target, skip caching */
         if (orig_mapped_atom_pin) {
-            atom_pin_to_pb_pin_mapping[pb_route_id] = std::make_pair(orig_mapped_atom_pin, atom_ctx.lookup.atom_pin_pb_graph_pin(orig_mapped_atom_pin));
+            scratch.atom_pins[pb_route_id] = orig_mapped_atom_pin;
+            scratch.cached_pb_routes.push_back(pb_route_id);
         }
     }
+}
 
-    return atom_pin_to_pb_pin_mapping;
+/********************************************************************
+ * Find the atom pin cached for a top-level pb_route of the block
+ * by cache_atom_pin_to_pb_pin_mapping()
+ *******************************************************************/
+static AtomPinId find_cached_atom_pin(const t_pb_pin_fixup_scratch& scratch,
+                                      const int& pb_route_id) {
+    VTR_ASSERT(size_t(pb_route_id) < scratch.atom_pins.size());
+    AtomPinId atom_pin = scratch.atom_pins[pb_route_id];
+    VTR_ASSERT(atom_pin);
+    return atom_pin;
 }
 
 /********************************************************************
@@ -594,13 +640,13 @@ static void rec_remove_downstream_pb_routes(t_pb_routes& curr_pb_routes,
  *    which should be handled in another function!!!
  *******************************************************************/
 static void update_cluster_regular_routing_traces_with_post_routing_results(AtomContext& atom_ctx,
-                                                                            const std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>>& previous_atom_pin_to_pb_pin_mapping,
-                                                                            ClusteringContext& clustering_ctx,
+                                                                            const t_pb_pin_fixup_scratch& previous_atom_pin_mapping,
+                                                                            const ClusteringContext& clustering_ctx,
+                                                                            t_clb_post_routing_fixup& clb_fixup,
                                                                             const ClusterBlockId& blk_id,
                                                                             t_pb* pb,
                                                                             t_logical_block_type_ptr logical_block,
                                                                             t_pb_routes& new_pb_routes,
-                                                                            size_t& num_fixup,
                                                                             const bool& verbose) {
     /* Go through each pb_graph pin at the top level
      * and build the new routing traces
@@ -625,15 +671,15 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
         VTR_ASSERT(pb_graph_pin->parent_node == pb->pb_graph_node);
         VTR_ASSERT(pb_graph_pin->parent_node->is_root());
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pb_graph_pin->pin_count_in_cluster);
+        auto remapped_result = clb_fixup.pin_nets.find(pb_graph_pin->pin_count_in_cluster);
 
         /* Skip this pin: it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == clb_fixup.pin_nets.end()) {
             continue;
         }
 
         /* Update only when there is a remapping! */
-        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets[blk_id].end());
+        VTR_ASSERT_SAFE(remapped_result != clb_fixup.pin_nets.end());
 
         /* Cache the remapped net id */
         AtomNetId remapped_net = atom_ctx.lookup.atom_net(remapped_result->second);
@@ -671,6 +717,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
          */
         int pb_route_id = find_target_pb_route_from_equivalent_pins(atom_ctx,
                                                                     clustering_ctx,
+                                                                    clb_fixup.pin_nets,
                                                                     blk_id,
                                                                     pb,
                                                                     pb_graph_pin,
@@ -678,7 +725,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                                                                     verbose);
 
         /* Record the previous pin mapping for finding the correct pin index during timing analysis */
-        clustering_ctx.pre_routing_net_pin_mapping[blk_id][pb_graph_pin->pin_count_in_cluster] = pb_route_id;
+        clb_fixup.pre_routing_pin_mapping[pb_graph_pin->pin_count_in_cluster] = pb_route_id;
 
         /* Remove the old pb_route and insert the new one */
         new_pb_routes.insert(std::make_pair(pb_graph_pin->pin_count_in_cluster, t_pb_route()));
@@ -799,7 +846,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                  * Fix the atom net lookup 
                  */
                 VTR_ASSERT(1 == pb->pb_route.at(pb_route_id).sink_pb_pin_ids.size());
-                const AtomPinId& orig_mapped_atom_pin = previous_atom_pin_to_pb_pin_mapping.at(pb_route_id).first;
+                const AtomPinId& orig_mapped_atom_pin = find_cached_atom_pin(previous_atom_pin_mapping, pb_route_id);
 
                 /* Print verbose outputs */
                 VTR_LOGV(verbose,
@@ -845,7 +892,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                          */
                         const t_pb_graph_pin* orig_mapped_top_level_pb_pin = find_mapped_equivalent_pb_pin_by_net(pb, pb_graph_pin, remapped_net);
                         VTR_ASSERT(orig_mapped_top_level_pb_pin);
-                        const AtomPinId& orig_mapped_atom_pin = previous_atom_pin_to_pb_pin_mapping.at(orig_mapped_top_level_pb_pin->pin_count_in_cluster).first;
+                        const AtomPinId& orig_mapped_atom_pin = find_cached_atom_pin(previous_atom_pin_mapping, orig_mapped_top_level_pb_pin->pin_count_in_cluster);
 
                         /* Print verbose outputs */
                         VTR_LOGV(verbose,
@@ -874,7 +921,7 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
                  atom_ctx.nlist.net_name(remapped_net).c_str());
 
         /* Update fixup counter */
-        num_fixup++;
+        clb_fixup.num_fixup++;
     }
 }
 
@@ -887,12 +934,12 @@ static void update_cluster_regular_routing_traces_with_post_routing_results(Atom
  *    which should be handled in another function!!!
  *******************************************************************/
 static void update_cluster_global_routing_traces_with_post_routing_results(const AtomContext& atom_ctx,
-                                                                           ClusteringContext& clustering_ctx,
+                                                                           const ClusteringContext& clustering_ctx,
+                                                                           t_clb_post_routing_fixup& clb_fixup,
                                                                            const ClusterBlockId& blk_id,
                                                                            t_pb* pb,
                                                                            t_logical_block_type_ptr logical_block,
                                                                            t_pb_routes& new_pb_routes,
-                                                                           size_t& num_fixup,
                                                                            const bool& verbose) {
     /* Reassign global nets to unused pins in the same port where they were mapped
      * NO optimization is done here!!! First find first fit
@@ -925,15 +972,15 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
 
         AtomNetId global_atom_net_id = atom_ctx.lookup.atom_net(global_net_id);
 
-        auto remapped_result = clustering_ctx.post_routing_clb_pin_nets.at(blk_id).find(pb_graph_pin->pin_count_in_cluster);
+        auto remapped_result = clb_fixup.pin_nets.find(pb_graph_pin->pin_count_in_cluster);
 
         /* Skip this pin: it is consistent in pre- and post- routing results */
-        if (remapped_result == clustering_ctx.post_routing_clb_pin_nets.at(blk_id).end()) {
+        if (remapped_result == clb_fixup.pin_nets.end()) {
             continue;
         }
 
         /* Update only when there is a remapping! */
-        VTR_ASSERT_SAFE(remapped_result != clustering_ctx.post_routing_clb_pin_nets[blk_id].end());
+        VTR_ASSERT_SAFE(remapped_result != clb_fixup.pin_nets.end());
 
         VTR_LOGV(verbose,
                  "Remapping clustered block '%s' global net '%s' to unused pin as %s\r",
@@ -963,8 +1010,8 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
         }
 
         /* Update the remapping nets for this global net */
-        clustering_ctx.post_routing_clb_pin_nets[blk_id][unused_pb_graph_pin->pin_count_in_cluster] = global_net_id;
-        clustering_ctx.pre_routing_net_pin_mapping[blk_id][unused_pb_graph_pin->pin_count_in_cluster] = pb_route_id;
+        clb_fixup.pin_nets[unused_pb_graph_pin->pin_count_in_cluster] = global_net_id;
+        clb_fixup.pre_routing_pin_mapping[unused_pb_graph_pin->pin_count_in_cluster] = pb_route_id;
 
         VTR_LOGV(verbose,
                  "Remap clustered block '%s' global net '%s' to pin '%s'\n",
@@ -973,7 +1020,7 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
                  unused_pb_graph_pin->to_string().c_str());
 
         /* Update fixup counter */
-        num_fixup++;
+        clb_fixup.num_fixup++;
     }
 }
 
@@ -988,12 +1035,13 @@ static void update_cluster_global_routing_traces_with_post_routing_results(const
  *******************************************************************/
 static void update_cluster_routing_traces_with_post_routing_results(AtomContext& atom_ctx,
                                                                     const IntraLbPbPinLookup& intra_lb_pb_pin_lookup,
-                                                                    ClusteringContext& clustering_ctx,
+                                                                    const ClusteringContext& clustering_ctx,
+                                                                    t_clb_post_routing_fixup& clb_fixup,
+                                                                    t_pb_pin_fixup_scratch& scratch,
                                                                     const ClusterBlockId& blk_id,
-                                                                    size_t& num_fixup,
                                                                     const bool& verbose) {
     /* Skip block where no remapping is applied */
-    if (clustering_ctx.post_routing_clb_pin_nets.find(blk_id) == clustering_ctx.post_routing_clb_pin_nets.end()) {
+    if (clb_fixup.pin_nets.empty()) {
         return;
     }
 
@@ -1004,29 +1052,35 @@ static void update_cluster_routing_traces_with_post_routing_results(AtomContext&
     t_pb_routes new_pb_routes = pb->pb_route;
 
     /* Cache the current mapping between atom pin to pb_graph pin in this block */
-    std::map<int, std::pair<AtomPinId, const t_pb_graph_pin*>> previous_atom_pin_to_pb_pin_mapping = cache_atom_pin_to_pb_pin_mapping(const_cast<const AtomContext&>(atom_ctx), intra_lb_pb_pin_lookup, const_cast<const ClusteringContext&>(clustering_ctx), blk_id, pb, logical_block);
+    cache_atom_pin_to_pb_pin_mapping(const_cast<const AtomContext&>(atom_ctx), intra_lb_pb_pin_lookup, clb_fixup.pin_nets, blk_id, pb, logical_block, scratch);
 
     update_cluster_regular_routing_traces_with_post_routing_results(atom_ctx,
-                                                                    previous_atom_pin_to_pb_pin_mapping,
+                                                                    scratch,
                                                                     clustering_ctx,
+                                                                    clb_fixup,
                                                                     blk_id,
                                                                     pb,
                                                                     logical_block,
                                                                     new_pb_routes,
-                                                                    num_fixup,
                                                                     verbose);
 
     update_cluster_global_routing_traces_with_post_routing_results(const_cast<const AtomContext&>(atom_ctx),
                                                                    clustering_ctx,
+                                                                   clb_fixup,
                                                                    blk_id,
                                                                    pb,
                                                                    logical_block,
                                                                    new_pb_routes,
-                                                                   num_fixup,
                                                                    verbose);
 
+    /* Reset the cache for the next block */
+    for (int pb_route_id : scratch.cached_pb_routes) {
+        scratch.atom_pins[pb_route_id] = AtomPinId::INVALID();
+    }
+    scratch.cached_pb_routes.clear();
+
     /* Replace old pb_routes with the new one */
-    pb->pb_route = new_pb_routes;
+    pb->pb_route = std::move(new_pb_routes);
 }
 
 /********************************************************************
@@ -1067,11 +1121,10 @@ void sync_netlists_to_routing(const Netlist<>& net_list,
 
     IntraLbPbPinLookup intra_lb_pb_pin_lookup(device_ctx.logical_block_types);
 
-    /* Count the number of mismatches and fix-up */
-    size_t num_mismatches = 0;
-    size_t num_fixup = 0;
-
+    /* Find the clustered blocks to fix up, each once */
+    std::vector<ClusterBlockId> clb_blk_ids;
     std::unordered_set<ClusterBlockId> seen_block_ids;
+    clb_blk_ids.reserve(clustering_ctx.clb_nlist.blocks().size());
     seen_block_ids.reserve(clustering_ctx.clb_nlist.blocks().size());
     /* Update the core logic (center blocks of the FPGA) */
     for (const ParentBlockId& blk_id : net_list.blocks()) {
@@ -1085,23 +1138,68 @@ void sync_netlists_to_routing(const Netlist<>& net_list,
         VTR_ASSERT(clb_blk_id != ClusterBlockId::INVALID());
 
         if (seen_block_ids.insert(clb_blk_id).second) {
-            update_cluster_pin_with_post_routing_results(net_list,
-                                                         atom_ctx,
-                                                         device_ctx,
-                                                         clustering_ctx,
-                                                         rr_node_nets,
-                                                         placement_ctx.block_locs[clb_blk_id].loc,
-                                                         clb_blk_id,
-                                                         num_mismatches,
-                                                         verbose,
-                                                         is_flat);
-
-            update_cluster_routing_traces_with_post_routing_results(atom_ctx,
-                                                                    intra_lb_pb_pin_lookup,
-                                                                    clustering_ctx,
-                                                                    clb_blk_id,
-                                                                    num_fixup,
-                                                                    verbose);
+            clb_blk_ids.push_back(clb_blk_id);
+        }
+    }
+
+    /* The fix-up of a block only modifies the block (its pb routing traces and
+     * the atom pins it contains), so the blocks are fixed up in parallel. The
+     * results are then merged in block order. Verbose fix-ups are done serially
+     * so their messages are not interleaved.
+     */
+    std::vector<t_clb_post_routing_fixup> clb_fixups(clb_blk_ids.size());
+
+    auto fixup_block = [&](size_t iblk, t_pb_pin_fixup_scratch& scratch) {
+        ClusterBlockId clb_blk_id = clb_blk_ids[iblk];
+        update_cluster_pin_with_post_routing_results(net_list,
+                                                     atom_ctx,
+                                                     device_ctx,
+                                                     clustering_ctx,
+                                                     rr_node_nets,
+                                                     placement_ctx.block_locs[clb_blk_id].loc,
+                                                     clb_blk_id,
+                                                     clb_fixups[iblk].pin_nets,
+                                                     clb_fixups[iblk].num_mismatches,
+                                                     verbose,
+                                                     is_flat);
+
+        update_cluster_routing_traces_with_post_routing_results(atom_ctx,
+                                                                intra_lb_pb_pin_lookup,
+                                                                clustering_ctx,
+                                                                clb_fixups[iblk],
+                                                                scratch,
+                                                                clb_blk_id,
+                                                                verbose);
+    };
+
+#ifdef VPR_USE_TBB
+    if (!verbose) {
+        tbb::enumerable_thread_specific<t_pb_pin_fixup_scratch> thread_scratch;
+        tbb::parallel_for(size_t(0), clb_blk_ids.size(), [&](size_t iblk) {
+            fixup_block(iblk, thread_scratch.local());
+        });
+    } else
+#endif
+    {
+        t_pb_pin_fixup_scratch scratch;
+        for (size_t iblk = 0; iblk < clb_blk_ids.size(); iblk++) {
+            fixup_block(iblk, scratch);
+        }
+    }
+
+    /* Count the number of mismatches and fix-up */
+    size_t num_mismatches = 0;
+    size_t num_fixup = 0;
+    for (size_t iblk = 0; iblk < clb_blk_ids.size(); iblk++) {
+        t_clb_post_routing_fixup& clb_fixup = clb_fixups[iblk];
+        num_mismatches += clb_fixup.num_mismatches;
+        num_fixup += clb_fixup.num_fixup;
+
+        if (!clb_fixup.pin_nets.empty()) {
+            clustering_ctx.post_routing_clb_pin_nets[clb_blk_ids[iblk]] = std::move(clb_fixup.pin_nets);
+        }
+        if (!clb_fixup.pre_routing_pin_mapping.empty()) {
+            clustering_ctx.pre_routing_net_pin_mapping[clb_blk_ids[iblk]] = std::move(clb_fixup.pre_routing_pin_mapping);
         }
     }
 
@@ -65,7 +65,8 @@ static void free_pack_pattern_block(t_pack_pattern_block* pattern_block, t_pack_
 
 static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patterns,
                                             const int pack_pattern_index,
-                                            AtomBlockId blk_id);
+                                            AtomBlockId blk_id,
+                                            std::vector<AtomBlockId>& chain_path);
 
 static bool try_expand_molecule(t_pack_molecule* molecule,
                                 const AtomBlockId blk_id);
@@ -79,7 +80,7 @@ static t_pb_graph_node* get_expected_lowest_cost_primitive_for_atom_block(const
 
 static t_pb_graph_node* get_expected_lowest_cost_primitive_for_atom_block_in_pb_graph_node(const AtomBlockId blk_id, t_pb_graph_node* curr_pb_graph_node, float* cost);
 
-static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id, const t_pack_patterns* list_of_pack_pattern);
+static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id, const t_pack_patterns* list_of_pack_pattern, std::vector<AtomBlockId>& chain_path);
 
 static std::vector<t_pb_graph_pin*> find_end_of_path(t_pb_graph_pin* input_pin, int pattern_index);
 
@@ -813,11 +814,14 @@ t_pack_molecule* alloc_and_load_pack_molecules(t_pack_patterns* list_of_pack_pat
         VTR_ASSERT(is_used[best_pattern] == false);
         is_used[best_pattern] = true;
 
+        //Chain of atoms above the block being tried, kept while the block is retried (see find_new_root_atom_for_chain())
+        std::vector<AtomBlockId> chain_path;
+
         auto blocks = atom_ctx.nlist.blocks();
         for (auto blk_iter = blocks.begin(); blk_iter != blocks.end(); ++blk_iter) {
             auto blk_id = *blk_iter;
 
-            cur_molecule = try_create_molecule(list_of_pack_patterns, best_pattern, blk_id);
+            cur_molecule = try_create_molecule(list_of_pack_patterns, best_pattern, blk_id, chain_path);
             if (cur_molecule != nullptr) {
                 cur_molecule->next = list_of_molecules_head;
                 /* In the event of multiple molecules with the same atom block pattern,
@@ -933,9 +937,11 @@ static void free_pack_pattern_block(t_pack_pattern_block* pattern_block, t_pack_
  */
 static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patterns,
                                             const int pack_pattern_index,
-                                            AtomBlockId blk_id) {
+                                            AtomBlockId blk_id,
+                                            std::vector<AtomBlockId>& chain_path) {
     t_pack_molecule* molecule;
 
+    auto& atom_ctx = g_vpr_ctx.atom();
     auto& atom_mutable_ctx = g_vpr_ctx.mutable_atom();
 
     auto pack_pattern = &list_of_pack_patterns[pack_pattern_index];
@@ -948,10 +954,17 @@ static t_pack_molecule* try_create_molecule(t_pack_patterns* list_of_pack_patter
     // If a chain pattern extends beyond a single logic block, we must find
     // the furthest blk_id up the chain that is not mapped to a molecule yet.
     if (pack_pattern->is_chain) {
-        blk_id = find_new_root_atom_for_chain(blk_id, pack_pattern);
+        blk_id = find_new_root_atom_for_chain(blk_id, pack_pattern, chain_path);
         if (!blk_id) return nullptr;
     }
 
+    // Most blocks can not be the root of the pattern, reject them before building a molecule to expand
+    if (!pack_pattern->is_block_optional[pack_pattern->root_block->block_id]
+        && (!primitive_type_feasible(blk_id, pack_pattern->root_block->pb_type)
+            || atom_ctx.atom_molecules.count(blk_id))) {
+        return nullptr;
+    }
+
     molecule = new t_pack_molecule;
     molecule->valid = true;
     molecule->type = MOLECULE_FORCED_PACK;
@@ -1300,51 +1313,58 @@ static int compare_pack_pattern(const t_pack_patterns* pattern_a, const t_pack_p
  * Assumes that the root of a chain is the primitive that starts the chain or is driven from outside the logic block
  * block_index: index of current atom
  * list_of_pack_pattern: ptr to current chain pattern
+ * chain_path: the atoms from blk_id up to the root found by the previous call.
+ *             When a block is retried (its chain is cut into molecules from the top down, one per call),
+ *             the new root is found by dropping the atoms the previous molecules took from the top of the path,
+ *             rather than by walking up the whole chain again, which is quadratic in the chain length
  */
-static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id, const t_pack_patterns* list_of_pack_pattern) {
-    AtomBlockId new_root_blk_id;
-    t_pb_graph_pin* root_ipin;
-    t_pb_graph_node* root_pb_graph_node;
-    t_model_ports* model_port;
-
+static AtomBlockId find_new_root_atom_for_chain(const AtomBlockId blk_id, const t_pack_patterns* list_of_pack_pattern, std::vector<AtomBlockId>& chain_path) {
     auto& atom_ctx = g_vpr_ctx.atom();
 
+    if (!chain_path.empty() && chain_path.front() == blk_id) {
+        /* Retrying blk_id: atoms taken by molecules are at the top of the path */
+        while (!chain_path.empty() && atom_ctx.atom_molecules.count(chain_path.back())) {
+            chain_path.pop_back();
+        }
+        if (!chain_path.empty()) {
+            return chain_path.back();
+        }
+    }
+    chain_path.clear();
+
     VTR_ASSERT(list_of_pack_pattern->is_chain == true);
     VTR_ASSERT(list_of_pack_pattern->chain_root_pins.size());
-    root_ipin = list_of_pack_pattern->chain_root_pins[0][0];
-    root_pb_graph_node = root_ipin->parent_node;
+    t_pb_graph_pin* root_ipin = list_of_pack_pattern->chain_root_pins[0][0];
+    t_pb_graph_node* root_pb_graph_node = root_ipin->parent_node;
 
     if (primitive_type_feasible(blk_id, root_pb_graph_node->pb_type) == false) {
         return AtomBlockId::INVALID();
     }
 
     /* Assign driver furthest up the chain that matches the root node and is unassigned to a molecule as the root */
-    model_port = root_ipin->port->model_port;
-
-    // find the block id of the atom block driving the input of this block
-    AtomBlockId driver_blk_id = atom_ctx.nlist.find_atom_pin_driver(blk_id, model_port, root_ipin->pin_number);
+    t_model_ports* model_port = root_ipin->port->model_port;
+
+    chain_path.push_back(blk_id);
+    while (true) {
+        // find the block id of the atom block driving the input of the current top of the chain
+        AtomBlockId driver_blk_id = atom_ctx.nlist.find_atom_pin_driver(chain_path.back(), model_port, root_ipin->pin_number);
+
+        // the current top is the furthest up the chain if
+        // 1) there is no driver block for this net
+        // 2) the driver is used/invalid (already packed into a molecule)
+        // 3) the driver can not be the root of the chain
+        // 4) the chain loops back on itself
+        if (!driver_blk_id
+            || atom_ctx.atom_molecules.count(driver_blk_id)
+            || !primitive_type_feasible(driver_blk_id, root_pb_graph_node->pb_type)
+            || chain_path.size() >= atom_ctx.nlist.blocks().size()) {
+            break;
+        }
 
-    // if there is no driver block for this net
-    // then it is the furthest up the chain
-    if (!driver_blk_id) {
-        return blk_id;
+        chain_path.push_back(driver_blk_id);
     }
-    // check if driver atom is already packed
-    auto rng = atom_ctx.atom_molecules.equal_range(driver_blk_id);
-    bool rng_empty = (rng.first == rng.second);
-    if (!rng_empty) {
-        /* Driver is used/invalid, so current block is the furthest up the chain, return it */
-        return blk_id;
-    }
-
-    // didn't find furthest atom up the chain, keep searching further up the chain
-    new_root_blk_id = find_new_root_atom_for_chain(driver_blk_id, list_of_pack_pattern);
 
-    if (!new_root_blk_id) {
-        return blk_id;
-    } else {
-        return new_root_blk_id;
-    }
+    return chain_path.back();
 }
 
 /**
@@ -13,6 +13,9 @@
 //The name suffix of the new block (if exists)
 const char* name_suffix = "_m";
 
+//Fraction of removed ids above which fixing the clustered netlist compresses it
+constexpr float MAX_REMOVED_CLB_ID_FRACTION = 0.1;
+
 /******************* Static Functions ********************/
 //static void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist, const AtomBlockId atom_blk, const AtomPortId atom_port, const t_pb_graph_pin* gpin);
 static void load_atom_index_for_pb_pin(t_pb_routes& pb_route, int ipin);
@@ -133,6 +136,7 @@ bool start_new_cluster_for_mol(t_pack_molecule* molecule,
     /* Cluster's PartitionRegion is empty initially, meaning it has no floorplanning constraints */
     PartitionRegion empty_pr;
     floorplanning_ctx.cluster_constraints.push_back(empty_pr);
+    floorplanning_ctx.cluster_partitions.resize(floorplanning_ctx.cluster_constraints.size());
 
     /* Allocate a dummy initial cluster and load a atom block as a seed and check if it is legal */
     AtomBlockId root_atom = molecule->atom_block_ids[molecule->root];
@@ -361,7 +365,11 @@ static void fix_cluster_net_after_moving(const t_pack_molecule* molecule,
     for (auto& atom_blk : *(cluster_to_atoms(new_clb)))
         fix_atom_pin_mapping(atom_blk);
 
-    cluster_ctx.clb_nlist.remove_and_compress();
+    //Compressing re-builds the whole clustered netlist, so it is deferred until enough
+    //removed nets accumulate (or compress_clustered_netlist() is called)
+    if (cluster_ctx.clb_nlist.should_compress(MAX_REMOVED_CLB_ID_FRACTION)) {
+        compress_clustered_netlist();
+    }
     load_internal_to_block_net_nums(cluster_ctx.clb_nlist.block_type(old_clb), cluster_ctx.clb_nlist.block_pb(old_clb)->pb_route);
     load_internal_to_block_net_nums(cluster_ctx.clb_nlist.block_type(new_clb), cluster_ctx.clb_nlist.block_pb(new_clb)->pb_route);
 }
@@ -698,6 +706,32 @@ bool check_type_and_mode_compitability(const ClusterBlockId& old_clb,
     return true;
 }
 
+void compress_clustered_netlist() {
+    auto& cluster_ctx = g_vpr_ctx.mutable_clustering();
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    if (cluster_ctx.clb_nlist.is_compressed()) return;
+
+    //Collect the current cluster nets of the atom nets, since they are all re-numbered
+    std::vector<std::pair<AtomNetId, ClusterNetId>> atom_clb_nets;
+    for (AtomNetId atom_net : atom_ctx.nlist.nets()) {
+        ClusterNetId clb_net = atom_ctx.lookup.clb_net(atom_net);
+        if (clb_net) {
+            atom_clb_nets.emplace_back(atom_net, clb_net);
+            atom_ctx.lookup.set_atom_clb_net(atom_net, ClusterNetId::INVALID());
+        }
+    }
+
+    auto id_remapper = cluster_ctx.clb_nlist.remove_and_compress();
+
+    for (const auto& atom_clb_net : atom_clb_nets) {
+        ClusterNetId new_clb_net = id_remapper.new_net_id(atom_clb_net.second);
+        if (new_clb_net) {
+            atom_ctx.lookup.set_atom_clb_net(atom_clb_net.first, new_clb_net);
+        }
+    }
+}
+
 static void update_cluster_pb_stats(const t_pack_molecule* molecule,
                                     int molecule_size,
                                     ClusterBlockId clb_index,
@@ -152,4 +152,14 @@ bool check_type_and_mode_compitability(const ClusterBlockId& old_clb,
                                        const ClusterBlockId& new_clb,
                                        int verbosity);
 
+/**
+ * @brief A function that removes the unused items of the clustered netlist and compresses it,
+ * remapping the cluster nets of the atom lookup
+ *
+ * Moves fixing the clustered netlist (i.e. after packing is done) leave the removed nets in it
+ * until enough of them accumulate. This should be called once the moves are done, before the
+ * clustered netlist is used elsewhere.
+ */
+void compress_clustered_netlist();
+
 #endif
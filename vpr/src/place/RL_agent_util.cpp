@@ -80,11 +80,13 @@ void create_move_generators(std::unique_ptr<MoveGenerator>& move_generator, std:
                                                                       e_agent_space::MOVE_TYPE);
             }
             karmed_bandit_agent1->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent1->set_prob_update_interval(placer_opts.place_agent_prob_update_interval);
             move_generator = std::make_unique<SimpleRLMoveGenerator>(karmed_bandit_agent1);
             //agent's 2nd state
             karmed_bandit_agent2 = std::make_unique<SoftmaxAgent>(num_2nd_state_avail_moves,
                                                                   e_agent_space::MOVE_TYPE);
             karmed_bandit_agent2->set_step(placer_opts.place_agent_gamma, move_lim);
+            karmed_bandit_agent2->set_prob_update_interval(placer_opts.place_agent_prob_update_interval);
             move_generator2 = std::make_unique<SimpleRLMoveGenerator>(karmed_bandit_agent2);
         }
     }
@@ -16,6 +16,10 @@
 #    include "vpr_utils.h"
 #    include "place_util.h"
 
+#    ifdef VPR_USE_TBB
+#        include <tbb/parallel_invoke.h>
+#    endif
+
 // Templated struct for constructing and solving matrix equations in analytic placer
 template<typename T>
 struct EquationSystem {
@@ -283,8 +287,17 @@ void AnalyticPlacer::build_solve_type(t_logical_block_type_ptr run, int iter) {
     setup_solve_blks(run);
     // build and solve matrix equation for both x, y
     // passing -1 as iter to build_solve_direction() signals build_equation() not to add pseudo-connections
-    build_solve_direction(false, (iter == 0) ? -1 : iter, ap_cfg.buildSolveIter);
-    build_solve_direction(true, (iter == 0) ? -1 : iter, ap_cfg.buildSolveIter);
+    //
+    // The x system only reads and writes the x coordinates (loc.x, rawx, legal_loc.x) of blk_locs,
+    // and the y system the y coordinates, so both directions are built and solved concurrently
+    int solve_iter = (iter == 0) ? -1 : iter;
+#    ifdef VPR_USE_TBB
+    tbb::parallel_invoke([&]() { build_solve_direction(false, solve_iter, ap_cfg.buildSolveIter); },
+                         [&]() { build_solve_direction(true, solve_iter, ap_cfg.buildSolveIter); });
+#    else
+    build_solve_direction(false, solve_iter, ap_cfg.buildSolveIter);
+    build_solve_direction(true, solve_iter, ap_cfg.buildSolveIter);
+#    endif
     update_macros(); // update macro member locations, since only macro head is solved
 }
 
@@ -0,0 +1,128 @@
+#include "compressed_pr_grid.h"
+
+#include <algorithm>
+
+#include "vtr_hash.h"
+#include "vtr_memory.h"
+#include "vtr_random.h"
+
+#include "globals.h"
+
+//Returns true if the grid location is inside reg (ignoring the sub-tile)
+static bool is_in_region_rect(const Region& reg, int x, int y, int layer_num) {
+    const auto rect = reg.get_region_rect();
+    return rect.layer_num == layer_num
+           && x >= rect.xmin && x <= rect.xmax
+           && y >= rect.ymin && y <= rect.ymax;
+}
+
+t_compressed_pr_grid create_compressed_pr_grid(t_logical_block_type_ptr block_type, const PartitionRegion& pr) {
+    const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
+    const auto& grid = g_vpr_ctx.device().grid;
+
+    t_compressed_pr_grid pr_grid;
+    pr_grid.regions = pr.get_partition_region();
+    for (const Region& reg : pr_grid.regions) {
+        if (reg.get_sub_tile() != NO_SUBTILE) {
+            pr_grid.sub_tile_constrained = true;
+        }
+    }
+
+    int num_layers = compressed_block_grid.grid.size();
+    pr_grid.columns.resize(num_layers);
+    pr_grid.rows.resize(num_layers);
+
+    for (int layer_num = 0; layer_num < num_layers; layer_num++) {
+        for (int cx = 0; cx < (int)compressed_block_grid.get_num_columns(layer_num); cx++) {
+            std::vector<int> legal_rows;
+            for (const auto& block_row : compressed_block_grid.get_column_block_map(cx, layer_num)) {
+                int cy = block_row.first;
+                auto grid_loc = compressed_block_grid.compressed_loc_to_grid_loc({cx, cy, layer_num});
+                const auto& compatible_sub_tiles = compressed_block_grid.compatible_sub_tile_num(grid.get_physical_type(grid_loc)->index);
+
+                bool legal = false;
+                for (const Region& reg : pr_grid.regions) {
+                    if (!is_in_region_rect(reg, grid_loc.x, grid_loc.y, layer_num)) {
+                        continue;
+                    }
+                    if (reg.get_sub_tile() == NO_SUBTILE
+                        || std::find(compatible_sub_tiles.begin(), compatible_sub_tiles.end(), reg.get_sub_tile()) != compatible_sub_tiles.end()) {
+                        legal = true;
+                        break;
+                    }
+                }
+
+                if (legal) {
+                    legal_rows.push_back(cy);
+                }
+            }
+
+            if (!legal_rows.empty()) {
+                pr_grid.columns[layer_num].push_back(cx);
+                pr_grid.rows[layer_num].push_back(std::move(legal_rows));
+            }
+        }
+    }
+
+    return pr_grid;
+}
+
+bool pick_compressed_pr_grid_sub_tile(const t_compressed_pr_grid& pr_grid, t_logical_block_type_ptr block_type, t_pl_loc& loc) {
+    const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
+    auto tile_type = g_vpr_ctx.device().grid.get_physical_type({loc.x, loc.y, loc.layer});
+    const auto& compatible_sub_tiles = compressed_block_grid.compatible_sub_tile_num(tile_type->index);
+
+    std::vector<int> legal_sub_tiles;
+    for (int sub_tile : compatible_sub_tiles) {
+        for (const Region& reg : pr_grid.regions) {
+            if (is_in_region_rect(reg, loc.x, loc.y, loc.layer)
+                && (reg.get_sub_tile() == NO_SUBTILE || reg.get_sub_tile() == sub_tile)) {
+                legal_sub_tiles.push_back(sub_tile);
+                break;
+            }
+        }
+    }
+
+    if (legal_sub_tiles.empty()) {
+        return false;
+    }
+
+    loc.sub_tile = legal_sub_tiles[vtr::irand((int)legal_sub_tiles.size() - 1)];
+    return true;
+}
+
+std::size_t CompressedPRGridCache::t_key_hash::operator()(const std::pair<int, std::vector<Region>>& key) const noexcept {
+    std::size_t seed = std::hash<int>{}(key.first);
+    for (const Region& reg : key.second) {
+        vtr::hash_combine(seed, reg);
+    }
+    return seed;
+}
+
+const t_compressed_pr_grid& CompressedPRGridCache::get(ClusterBlockId blk_id) {
+    const auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    if (block_grid_.empty()) {
+        block_grid_.resize(cluster_ctx.clb_nlist.blocks().size(), OPEN);
+    }
+
+    int& igrid = block_grid_[blk_id];
+    if (igrid == OPEN) {
+        auto block_type = cluster_ctx.clb_nlist.block_type(blk_id);
+        const PartitionRegion& pr = g_vpr_ctx.floorplanning().cluster_constraints[blk_id];
+
+        auto result = grid_lookup_.emplace(std::make_pair(block_type->index, pr.get_partition_region()), grids_.size());
+        if (result.second) {
+            grids_.push_back(create_compressed_pr_grid(block_type, pr));
+        }
+        igrid = result.first->second;
+    }
+
+    return grids_[igrid];
+}
+
+void CompressedPRGridCache::clear() {
+    vtr::release_memory(grids_);
+    grid_lookup_.clear();
+    vtr::release_memory(block_grid_);
+}
@@ -0,0 +1,71 @@
+#ifndef VPR_COMPRESSED_PR_GRID_H
+#define VPR_COMPRESSED_PR_GRID_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "vtr_vector.h"
+
+#include "clustered_netlist_fwd.h"
+#include "partition_region.h"
+#include "physical_types.h"
+#include "vpr_types.h"
+
+/**
+ * @brief The locations of a block type's compressed grid which are legal for a floorplan PartitionRegion
+ *
+ * Stored like t_compressed_block_grid: only the compressed columns with at least one legal location, and the
+ * legal compressed rows of each of them, so moves of floorplan constrained blocks can sample legal locations only.
+ */
+struct t_compressed_pr_grid {
+    std::vector<std::vector<int>> columns;           // [0...num_layers-1][0...num_legal_columns-1] -> compressed x, sorted
+    std::vector<std::vector<std::vector<int>>> rows; // [0...num_layers-1][0...num_legal_columns-1][0...num_legal_rows-1] -> compressed y, sorted
+
+    std::vector<Region> regions; // The regions of the PartitionRegion
+    bool sub_tile_constrained = false; // Whether some of the regions only allow a specific sub-tile
+};
+
+/**
+ * @brief Returns the locations of block_type's compressed grid which are legal for the PartitionRegion pr
+ *
+ * A location is legal if it lies in one of the regions, and the region allows a sub-tile compatible with block_type.
+ */
+t_compressed_pr_grid create_compressed_pr_grid(t_logical_block_type_ptr block_type, const PartitionRegion& pr);
+
+/**
+ * @brief Picks a random sub-tile for loc, among the sub-tiles compatible with block_type that are legal for pr_grid's regions
+ *
+ * @return false if no sub-tile of loc is legal.
+ */
+bool pick_compressed_pr_grid_sub_tile(const t_compressed_pr_grid& pr_grid, t_logical_block_type_ptr block_type, t_pl_loc& loc);
+
+/**
+ * @brief Lazily built t_compressed_pr_grid of the floorplan constrained clusters
+ *
+ * Grids are shared between clusters of the same block type with identical (propagated) floorplan constraints.
+ * The cluster constraints must not change while the cache is in use; clear() it once they may have.
+ */
+class CompressedPRGridCache {
+  public:
+    ///@brief Returns the legal locations of the constrained cluster blk_id, building them if needed
+    const t_compressed_pr_grid& get(ClusterBlockId blk_id);
+
+    ///@brief Frees all grids
+    void clear();
+
+  private:
+    struct t_key_hash {
+        std::size_t operator()(const std::pair<int, std::vector<Region>>& key) const noexcept;
+    };
+
+    std::vector<t_compressed_pr_grid> grids_;
+
+    // (logical block type index, regions) -> index in grids_
+    std::unordered_map<std::pair<int, std::vector<Region>>, int, t_key_hash> grid_lookup_;
+
+    // [0...clb_nlist.blocks().size()-1] -> index in grids_ (OPEN if not looked up yet)
+    vtr::vector<ClusterBlockId, int> block_grid_;
+};
+
+#endif
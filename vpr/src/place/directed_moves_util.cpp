@@ -1,4 +1,5 @@
 #include "directed_moves_util.h"
+#include "placer_globals.h"
 
 void get_coordinate_of_pin(ClusterPinId pin, t_physical_tile_loc& tile_loc) {
     auto& device_ctx = g_vpr_ctx.device();
@@ -17,9 +18,121 @@ void get_coordinate_of_pin(ClusterPinId pin, t_physical_tile_loc& tile_loc) {
     tile_loc.y = std::max(std::min(tile_loc.y, (int)grid.height() - 2), 1); //-2 for no perim channels
 }
 
+static t_coord_sum get_coord_sum_of_pin(ClusterPinId pin) {
+    t_physical_tile_loc tile_loc;
+    get_coordinate_of_pin(pin, tile_loc);
+
+    t_coord_sum coord;
+    coord.x = tile_loc.x;
+    coord.y = tile_loc.y;
+    return coord;
+}
+
+void init_net_sink_coord_sums() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_move_ctx = g_placer_ctx.mutable_move();
+
+    place_move_ctx.net_sink_coord_sums.assign(cluster_ctx.clb_nlist.nets().size(), t_coord_sum());
+    place_move_ctx.sink_pin_coords.assign(cluster_ctx.clb_nlist.pins().size(), t_coord_sum());
+
+    for (ClusterNetId net_id : cluster_ctx.clb_nlist.nets()) {
+        t_coord_sum& net_sum = place_move_ctx.net_sink_coord_sums[net_id];
+        for (ClusterPinId sink_pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
+            t_coord_sum coord = get_coord_sum_of_pin(sink_pin_id);
+            place_move_ctx.sink_pin_coords[sink_pin_id] = coord;
+            net_sum.x += coord.x;
+            net_sum.y += coord.y;
+        }
+    }
+}
+
+void update_net_sink_coord_sums(const t_pl_blocks_to_be_moved& blocks_affected) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_move_ctx = g_placer_ctx.mutable_move();
+
+    if (place_move_ctx.net_sink_coord_sums.empty()) return;
+
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; ++iblk) {
+        ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
+
+        //The pin offsets may change too if the block moved to a different tile type,
+        //so recompute every sink pin's coordinates rather than shifting them
+        for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(blk)) {
+            if (cluster_ctx.clb_nlist.pin_type(pin_id) == PinType::DRIVER) continue;
+
+            t_coord_sum coord = get_coord_sum_of_pin(pin_id);
+            t_coord_sum& old_coord = place_move_ctx.sink_pin_coords[pin_id];
+            t_coord_sum& net_sum = place_move_ctx.net_sink_coord_sums[cluster_ctx.clb_nlist.pin_net(pin_id)];
+            net_sum.x += coord.x - old_coord.x;
+            net_sum.y += coord.y - old_coord.y;
+            old_coord = coord;
+        }
+    }
+}
+
+/**
+ * @brief Calculates the unweighted centroid of b_from from the net sink coordinate sums.
+ *
+ * Gives exactly the same result as the float accumulation in calculate_centroid_loc(), as
+ * long as the sums are exactly representable as floats; returns false (without setting the
+ * centroid) otherwise.
+ */
+static bool calculate_centroid_loc_from_sums(ClusterBlockId b_from, t_pl_loc& centroid) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    const auto& place_move_ctx = g_placer_ctx.move();
+
+    t_coord_sum acc;
+    int64_t acc_weight = 0;
+
+    for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(b_from)) {
+        ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
+        /* Ignore the special case nets which only connects a block to itself */
+        if (cluster_ctx.clb_nlist.net_sinks(net_id).size() == 1) {
+            ClusterBlockId source = cluster_ctx.clb_nlist.net_driver_block(net_id);
+            ClusterPinId sink_pin = *cluster_ctx.clb_nlist.net_sinks(net_id).begin();
+            ClusterBlockId sink = cluster_ctx.clb_nlist.pin_block(sink_pin);
+            if (sink == source) {
+                continue;
+            }
+        }
+
+        if (cluster_ctx.clb_nlist.pin_type(pin_id) == PinType::DRIVER) {
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id))
+                continue;
+
+            const t_coord_sum& net_sum = place_move_ctx.net_sink_coord_sums[net_id];
+            acc.x += net_sum.x;
+            acc.y += net_sum.y;
+            acc_weight += cluster_ctx.clb_nlist.net_sinks(net_id).size();
+        } else {
+            t_coord_sum coord = get_coord_sum_of_pin(cluster_ctx.clb_nlist.net_driver(net_id));
+            acc.x += coord.x;
+            acc.y += coord.y;
+            acc_weight += 1;
+        }
+    }
+
+    //Floats hold integers exactly up to 2^24, beyond that the float sums would have rounded
+    constexpr int64_t MAX_EXACT_FLOAT_INT = int64_t(1) << 24;
+    if (acc.x > MAX_EXACT_FLOAT_INT || acc.y > MAX_EXACT_FLOAT_INT || acc_weight > MAX_EXACT_FLOAT_INT) {
+        return false;
+    }
+
+    centroid.x = float(acc.x) / float(acc_weight);
+    centroid.y = float(acc.y) / float(acc_weight);
+    // TODO: For now, we don't move the centroid to a different layer
+    centroid.layer = g_vpr_ctx.placement().block_locs[b_from].loc.layer;
+    return true;
+}
+
 void calculate_centroid_loc(ClusterBlockId b_from, bool timing_weights, t_pl_loc& centroid, const PlacerCriticalities* criticalities) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
+    if (!timing_weights && !g_placer_ctx.move().net_sink_coord_sums.empty()
+        && calculate_centroid_loc_from_sums(b_from, centroid)) {
+        return;
+    }
+
     t_physical_tile_loc tile_loc;
     int ipin;
     float acc_weight = 0;
@@ -3,6 +3,7 @@
 
 #include "globals.h"
 #include "timing_place.h"
+#include "move_transactions.h"
 
 /**
  * @brief enum represents the different reward functions
@@ -33,4 +34,18 @@ void get_coordinate_of_pin(ClusterPinId pin, t_physical_tile_loc& tile_loc);
  */
 void calculate_centroid_loc(ClusterBlockId b_from, bool timing_weights, t_pl_loc& centroid, const PlacerCriticalities* criticalities);
 
+/**
+ * @brief Computes the sums of the sink coordinates of every net from scratch
+ *
+ * The sums let calculate_centroid_loc() find the (unweighted) centroid of a block in time
+ * proportional to the block's pins, rather than to the pins of all its nets. They are
+ * updated by commit_move_blocks(), so this only needs to be called when the placement
+ * changes other than through moves (e.g. after the initial placement, or restoring a
+ * placement checkpoint).
+ */
+void init_net_sink_coord_sums();
+
+///@brief Updates the sums of the sink coordinates of the nets of the blocks moved (if they have been initialized)
+void update_net_sink_coord_sums(const t_pl_blocks_to_be_moved& blocks_affected);
+
 #endif
@@ -15,7 +15,9 @@
 
 #include "echo_files.h"
 
+#include <algorithm>
 #include <chrono>
+#include <numeric>
 #include <time.h>
 
 #ifdef VERBOSE
@@ -39,6 +41,77 @@ constexpr int INVALID_X = -1;
  * legal position and place it during initial placement.                  */
 #define MAX_NUM_TRIES_TO_PLACE_MACROS_RANDOMLY 8
 
+/**
+ * @brief Remembers which tiles have no free sub-tile left for a block type, so exhaustive placement can skip them
+ *
+ * Without it, every macro falling back to exhaustive placement rescans all the (mostly already filled)
+ * locations of its region, which is quadratic on heavily constrained floorplans where most blocks end up there.
+ *
+ * Tiles are found to be full lazily while scanning, and stay full since blocks are only added during a
+ * placement attempt. Full tiles of a column are skipped with a union-find style "next candidate" link.
+ * The index must be cleared whenever blocks are removed from the grid.
+ */
+class FreeSlotIndex {
+  public:
+    ///@brief Forgets all full tiles
+    void clear() {
+        next_candidate_.clear();
+    }
+
+    /**
+     * @brief Returns the first position at or after pos in the compressed column cx of block_type which is not known to be full
+     *
+     * Positions index the column's block map (get_column_block_map()); returns the column size if all remaining tiles are full.
+     */
+    int next_candidate(t_logical_block_type_ptr block_type, int layer_num, int cx, int pos) {
+        std::vector<int>& next = column(block_type, layer_num, cx);
+        int root = pos;
+        while (next[root] != root) {
+            root = next[root];
+        }
+        //Path compression
+        while (next[pos] != root) {
+            int next_pos = next[pos];
+            next[pos] = root;
+            pos = next_pos;
+        }
+        return root;
+    }
+
+    ///@brief Marks the tile at position pos of the compressed column cx as having no free sub-tile for block_type
+    void mark_full(t_logical_block_type_ptr block_type, int layer_num, int cx, int pos) {
+        std::vector<int>& next = column(block_type, layer_num, cx);
+        next[pos] = pos + 1;
+    }
+
+  private:
+    std::vector<int>& column(t_logical_block_type_ptr block_type, int layer_num, int cx) {
+        const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
+        if (next_candidate_.empty()) {
+            next_candidate_.resize(g_vpr_ctx.device().logical_block_types.size());
+        }
+        auto& type_columns = next_candidate_[block_type->index];
+        if (type_columns.empty()) {
+            type_columns.resize(compressed_block_grid.grid.size());
+        }
+        auto& layer_columns = type_columns[layer_num];
+        if (layer_columns.empty()) {
+            layer_columns.resize(compressed_block_grid.get_num_columns(layer_num));
+        }
+        std::vector<int>& next = layer_columns[cx];
+        if (next.empty()) {
+            //One extra position past the end of the column, which is never full
+            next.resize(compressed_block_grid.get_column_block_map(cx, layer_num).size() + 1);
+            std::iota(next.begin(), next.end(), 0);
+        }
+        return next;
+    }
+
+    //[0..num_logical_block_types-1][0..num_layers-1][0..num_columns-1][0..column_size] -> a link towards the next tile of the
+    //column which is not known to be full (the position itself if the tile is not known to be full). Allocated lazily.
+    std::vector<std::vector<std::vector<std::vector<int>>>> next_candidate_;
+};
+
 /**
  * @brief Set choosen grid locations to EMPTY block id before each placement iteration
  *   
@@ -73,10 +146,20 @@ static bool try_place_macro(t_pl_macro pl_macro, t_pl_loc head_pos);
  *   @param pad_loc_type Used to check whether an io block needs to be marked as fixed.
  *   @param blk_types_empty_locs_in_grid First location (lowest y) and number of remaining blocks in each column for the blk_id type.
  *   @param block_scores The block_scores (ranking of what to place next) for unplaced blocks connected to this macro should be updated.
+ *   @param free_slots Tiles known to be full, used by exhaustive placement (can be nullptr).
  * 
  * @return true if macro was placed, false if not.
  */
-static bool place_macro(int macros_max_num_tries, t_pl_macro pl_macro, enum e_pad_loc_type pad_loc_type, std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid, vtr::vector<ClusterBlockId, t_block_score>& block_scores);
+static bool place_macro(int macros_max_num_tries, t_pl_macro pl_macro, enum e_pad_loc_type pad_loc_type, std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid, vtr::vector<ClusterBlockId, t_block_score>& block_scores, FreeSlotIndex* free_slots);
+
+/**
+ * @brief Looks for a valid placement location for block, see place_one_block().
+ *
+ *   @param free_slots Tiles known to be full, used by exhaustive placement (can be nullptr).
+ *
+ * @return true if the block gets placed, false if not.
+ */
+static bool try_place_block(const ClusterBlockId& blk_id, enum e_pad_loc_type pad_loc_type, std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid, vtr::vector<ClusterBlockId, t_block_score>* block_scores, FreeSlotIndex* free_slots);
 
 /*
  * Assign scores to each block based on macro size and floorplanning constraints.
@@ -203,10 +286,12 @@ static bool try_random_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_log
  *   constrained.
  *   @param block_type Logical block type of the macro blocks.
  *   @param pad_loc_type Used to check whether an io block needs to be marked as fixed.
+ *   @param free_slots Tiles known to be full for block types, updated with the full tiles found. Can be nullptr if blocks
+ *   may have been removed from the grid since placement was started.
  *
  * @return true if the macro gets placed, false if not.
  */
-static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_logical_block_type_ptr block_type, enum e_pad_loc_type pad_loc_type);
+static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_logical_block_type_ptr block_type, enum e_pad_loc_type pad_loc_type, FreeSlotIndex* free_slots);
 
 /**
  * @brief Looks for a valid placement location for macro in second iteration, tries to place as many macros as possible in one column 
@@ -229,7 +314,19 @@ static bool try_dense_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_logi
  *   @param pad_loc_type Used to check whether an io block needs to be marked as fixed.
  *   @param constraints_file Used to read block locations if any constraints is available.
  */
-static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_scores, enum e_pad_loc_type pad_loc_type, const char* constraints_file);
+static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_scores, enum e_pad_loc_type pad_loc_type, const char* constraints_file, const vtr::vector<ClusterBlockId, t_pl_loc>* prev_block_locs);
+
+/**
+ * @brief Puts the blocks of a previous placement back at their previous locations, for incremental placement.
+ *
+ * Blocks already placed (e.g. by the constraints file), blocks without a previous location (new blocks) and
+ * blocks whose previous location is no longer legal or free are skipped and left to the regular initial placement.
+ * A placement macro is only put back if all its members kept their offsets from the macro head.
+ *
+ *   @param prev_block_locs The previous location of each block (invalid for blocks without one).
+ *   @param pad_loc_type Used to check whether an io block needs to be marked as fixed.
+ */
+static void place_blocks_at_previous_locations(const vtr::vector<ClusterBlockId, t_pl_loc>& prev_block_locs, enum e_pad_loc_type pad_loc_type);
 
 /**
  * @brief If any blocks remain unplaced after all initial placement iterations, this routine
@@ -665,7 +762,7 @@ static bool try_random_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_log
     return legal;
 }
 
-static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_logical_block_type_ptr block_type, enum e_pad_loc_type pad_loc_type) {
+static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t_logical_block_type_ptr block_type, enum e_pad_loc_type pad_loc_type, FreeSlotIndex* free_slots) {
     const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[block_type->index];
     auto& place_ctx = g_vpr_ctx.mutable_placement();
 
@@ -688,19 +785,26 @@ static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t
             continue;
         }
 
+        // Only the rows within the region can hold the macro head
+        const auto& compressed_to_grid_y = compressed_block_grid.compressed_to_grid_y[layer_num];
+        int min_cy = std::lower_bound(compressed_to_grid_y.begin(), compressed_to_grid_y.end(), reg_coord.ymin) - compressed_to_grid_y.begin();
+
         for (int cx = min_cx; cx <= max_cx && placed == false; cx++) {
             const auto& block_rows = compressed_block_grid.get_column_block_map(cx, layer_num);
-            auto y_lower_iter = block_rows.begin();
-            auto y_upper_iter = block_rows.end();
+            int y_range = block_rows.size();
 
-            int y_range = std::distance(y_lower_iter, y_upper_iter);
-
-            VTR_ASSERT(y_range >= 0);
+            int dy = block_rows.lower_bound(min_cy) - block_rows.begin();
+            if (free_slots != nullptr) {
+                dy = free_slots->next_candidate(block_type, layer_num, cx, dy);
+            }
 
-            for (int dy = 0; dy < y_range && placed == false; dy++) {
-                int cy = (y_lower_iter + dy)->first;
+            while (dy < y_range && placed == false) {
+                int cy = (block_rows.begin() + dy)->first;
 
                 auto grid_loc = compressed_block_grid.compressed_loc_to_grid_loc({cx, cy, layer_num});
+                if (grid_loc.y > reg_coord.ymax) {
+                    break;
+                }
                 to_loc.x = grid_loc.x;
                 to_loc.y = grid_loc.y;
                 to_loc.layer = grid_loc.layer_num;
@@ -720,6 +824,7 @@ static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t
                         }
                     }
                 } else {
+                    bool tile_full = true;
                     for (const auto& sub_tile : tile_type->sub_tiles) {
                         if (is_sub_tile_compatible(tile_type, block_type, sub_tile.capacity.low)) {
                             int st_low = sub_tile.capacity.low;
@@ -728,6 +833,7 @@ static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t
                             for (int st = st_low; st <= st_high && placed == false; st++) {
                                 to_loc.sub_tile = st;
                                 if (place_ctx.grid_blocks.block_at_location(to_loc) == EMPTY_BLOCK_ID) {
+                                    tile_full = false;
                                     placed = try_place_macro(pl_macro, to_loc);
                                     if (placed) {
                                         fix_IO_block_types(pl_macro, to_loc, pad_loc_type);
@@ -740,6 +846,16 @@ static bool try_exhaustive_placement(t_pl_macro pl_macro, PartitionRegion& pr, t
                             break;
                         }
                     }
+
+                    //No later macro of this type can be placed here either
+                    if (tile_full && free_slots != nullptr) {
+                        free_slots->mark_full(block_type, layer_num, cx, dy);
+                    }
+                }
+
+                dy++;
+                if (free_slots != nullptr) {
+                    dy = free_slots->next_candidate(block_type, layer_num, cx, dy);
                 }
             }
         }
@@ -805,7 +921,7 @@ static bool try_place_macro(t_pl_macro pl_macro, t_pl_loc head_pos) {
     return (macro_placed);
 }
 
-static bool place_macro(int macros_max_num_tries, t_pl_macro pl_macro, enum e_pad_loc_type pad_loc_type, std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid, vtr::vector<ClusterBlockId, t_block_score>& block_scores) {
+static bool place_macro(int macros_max_num_tries, t_pl_macro pl_macro, enum e_pad_loc_type pad_loc_type, std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid, vtr::vector<ClusterBlockId, t_block_score>& block_scores, FreeSlotIndex* free_slots) {
     ClusterBlockId blk_id;
     blk_id = pl_macro.members[0].blk_index;
 
@@ -863,7 +979,7 @@ static bool place_macro(int macros_max_num_tries, t_pl_macro pl_macro, enum e_pa
         // if there are no legal positions, error out
 
         // Exhaustive placement of carry macros
-        macro_placed = try_exhaustive_placement(pl_macro, pr, block_type, pad_loc_type);
+        macro_placed = try_exhaustive_placement(pl_macro, pr, block_type, pad_loc_type, free_slots);
     }
     return macro_placed;
 }
@@ -913,7 +1029,7 @@ static vtr::vector<ClusterBlockId, t_block_score> assign_block_scores() {
     return block_scores;
 }
 
-static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_scores, enum e_pad_loc_type pad_loc_type, const char* constraints_file) {
+static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_scores, enum e_pad_loc_type pad_loc_type, const char* constraints_file, const vtr::vector<ClusterBlockId, t_pl_loc>* prev_block_locs) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
@@ -934,16 +1050,25 @@ static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_s
     //[0..device_ctx.logical_block_types.size()-1][0..num_of_grid_columns_containing_this_block_type-1]
     std::vector<std::vector<t_grid_empty_locs_block_type>> blk_types_empty_locs_in_grid;
 
+    //Tiles found to be full by exhaustive placement in the current iteration
+    FreeSlotIndex free_slots;
+
     for (auto iter_no = 0; iter_no < MAX_INIT_PLACE_ATTEMPTS; iter_no++) {
         //clear grid for a new placement iteration
         clear_block_type_grid_locs(unplaced_blk_type_in_curr_itr);
         unplaced_blk_type_in_curr_itr.clear();
+        free_slots.clear();
 
         //Check whether the constraint file is NULL, if not, read in the block locations from the constraints file here
         if (strlen(constraints_file) != 0) {
             read_constraints(constraints_file);
         }
 
+        //For incremental placement, put the blocks back where the previous placement had them
+        if (prev_block_locs != nullptr) {
+            place_blocks_at_previous_locations(*prev_block_locs, pad_loc_type);
+        }
+
         //resize the vector to store unplaced block types empty locations
         blk_types_empty_locs_in_grid.resize(device_ctx.logical_block_types.size());
 
@@ -965,7 +1090,7 @@ static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_s
             auto blk_id_type = cluster_ctx.clb_nlist.block_type(blk_id);
             blocks_placed_since_heap_update++;
 
-            bool block_placed = place_one_block(blk_id, pad_loc_type, &blk_types_empty_locs_in_grid[blk_id_type->index], &block_scores);
+            bool block_placed = try_place_block(blk_id, pad_loc_type, &blk_types_empty_locs_in_grid[blk_id_type->index], &block_scores, &free_slots);
 
             //update heap based on update_heap_freq calculated above
             if (blocks_placed_since_heap_update % (update_heap_freq) == 0) {
@@ -1001,6 +1126,55 @@ static void place_all_blocks(vtr::vector<ClusterBlockId, t_block_score>& block_s
     }
 }
 
+static void place_blocks_at_previous_locations(const vtr::vector<ClusterBlockId, t_pl_loc>& prev_block_locs, enum e_pad_loc_type pad_loc_type) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        const t_pl_loc& head_pos = prev_block_locs[blk_id];
+        if (is_block_placed(blk_id) || head_pos.x == INVALID_X) {
+            continue;
+        }
+
+        t_pl_macro pl_macro;
+        int imacro;
+        get_imacro_from_iblk(&imacro, blk_id, place_ctx.pl_macros);
+
+        if (imacro != -1) {
+            pl_macro = place_ctx.pl_macros[imacro];
+
+            //Macros are placed from their head, and only if no member moved relative to it
+            if (pl_macro.members[0].blk_index != blk_id) {
+                continue;
+            }
+            bool macro_unchanged = std::all_of(pl_macro.members.begin(), pl_macro.members.end(),
+                                               [&](const t_pl_macro_member& member) {
+                                                   return prev_block_locs[member.blk_index] == head_pos + member.offset;
+                                               });
+            if (!macro_unchanged) {
+                continue;
+            }
+        } else {
+            t_pl_macro_member macro_member;
+            macro_member.blk_index = blk_id;
+            macro_member.offset = t_pl_offset(0, 0, 0);
+            pl_macro.members.push_back(macro_member);
+        }
+
+        //The grid is unchanged, but the file may come from another tool or a different architecture revision
+        if (!is_loc_on_chip({head_pos.x, head_pos.y, head_pos.layer})
+            || head_pos.sub_tile < 0
+            || head_pos.sub_tile >= grid.get_physical_type({head_pos.x, head_pos.y, head_pos.layer})->capacity) {
+            continue;
+        }
+
+        if (try_place_macro(pl_macro, head_pos)) {
+            fix_IO_block_types(pl_macro, head_pos, pad_loc_type);
+        }
+    }
+}
+
 static void clear_block_type_grid_locs(std::unordered_set<int> unplaced_blk_types_index) {
     auto& device_ctx = g_vpr_ctx.device();
     bool clear_all_block_types = false;
@@ -1050,6 +1224,15 @@ bool place_one_block(const ClusterBlockId& blk_id,
                      enum e_pad_loc_type pad_loc_type,
                      std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid,
                      vtr::vector<ClusterBlockId, t_block_score>* block_scores) {
+    //Blocks may have been removed from the grid since initial placement, so no tiles are known to be full
+    return try_place_block(blk_id, pad_loc_type, blk_types_empty_locs_in_grid, block_scores, nullptr);
+}
+
+static bool try_place_block(const ClusterBlockId& blk_id,
+                            enum e_pad_loc_type pad_loc_type,
+                            std::vector<t_grid_empty_locs_block_type>* blk_types_empty_locs_in_grid,
+                            vtr::vector<ClusterBlockId, t_block_score>* block_scores,
+                            FreeSlotIndex* free_slots) {
     auto& place_ctx = g_vpr_ctx.placement();
 
     //Check if block has already been placed
@@ -1066,7 +1249,7 @@ bool place_one_block(const ClusterBlockId& blk_id,
 
     if (imacro != -1) { //If the block belongs to a macro, pass that macro to the placement routines
         pl_macro = place_ctx.pl_macros[imacro];
-        placed_macro = place_macro(MAX_NUM_TRIES_TO_PLACE_MACROS_RANDOMLY, pl_macro, pad_loc_type, blk_types_empty_locs_in_grid, (*block_scores));
+        placed_macro = place_macro(MAX_NUM_TRIES_TO_PLACE_MACROS_RANDOMLY, pl_macro, pad_loc_type, blk_types_empty_locs_in_grid, (*block_scores), free_slots);
     } else {
         //If it does not belong to a macro, create a macro with the one block and then pass to the placement routines
         //This is done so that the initial placement flow can be the same whether the block belongs to a macro or not
@@ -1076,13 +1259,16 @@ bool place_one_block(const ClusterBlockId& blk_id,
         macro_member.blk_index = blk_id;
         macro_member.offset = block_offset;
         pl_macro.members.push_back(macro_member);
-        placed_macro = place_macro(MAX_NUM_TRIES_TO_PLACE_MACROS_RANDOMLY, pl_macro, pad_loc_type, blk_types_empty_locs_in_grid, (*block_scores));
+        placed_macro = place_macro(MAX_NUM_TRIES_TO_PLACE_MACROS_RANDOMLY, pl_macro, pad_loc_type, blk_types_empty_locs_in_grid, (*block_scores), free_slots);
     }
 
     return placed_macro;
 }
 
-void initial_placement(enum e_pad_loc_type pad_loc_type, const char* constraints_file, bool noc_enabled) {
+void initial_placement(enum e_pad_loc_type pad_loc_type,
+                       const char* constraints_file,
+                       bool noc_enabled,
+                       const vtr::vector<ClusterBlockId, t_pl_loc>* prev_block_locs) {
     vtr::ScopedStartFinishTimer timer("Initial Placement");
 
     /* Go through cluster blocks to calculate the tightest placement
@@ -1098,7 +1284,7 @@ void initial_placement(enum e_pad_loc_type pad_loc_type, const char* constraints
     vtr::vector<ClusterBlockId, t_block_score> block_scores = assign_block_scores();
 
     //Place all blocks
-    place_all_blocks(block_scores, pad_loc_type, constraints_file);
+    place_all_blocks(block_scores, pad_loc_type, constraints_file, prev_block_locs);
 
     //if any blocks remain unplaced, print an error
     check_initial_placement_legality();
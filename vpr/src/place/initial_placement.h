@@ -50,8 +50,14 @@ struct t_grid_empty_locs_block_type {
  *   @param constraints_file Used to read block locations if any constraints is available.
  *   @param noc_enabled Used to check whether the user turned on the noc
  * optimization during placement.
+ *   @param prev_block_locs For incremental placement, the block locations of a previous placement
+ * (see read_place_locations()). Blocks are put back at their previous location when it is still
+ * legal and free, and only the remaining blocks are placed from scratch. nullptr otherwise.
  */
-void initial_placement(enum e_pad_loc_type pad_loc_type, const char* constraints_file, bool noc_enabled);
+void initial_placement(enum e_pad_loc_type pad_loc_type,
+                       const char* constraints_file,
+                       bool noc_enabled,
+                       const vtr::vector<ClusterBlockId, t_pl_loc>* prev_block_locs);
 
 /**
  * @brief Looks for a valid placement location for block.
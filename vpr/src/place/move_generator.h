@@ -28,10 +28,24 @@ struct MoveOutcomeStats {
  * rejected_moves: the number of rejected moves of each move and block type (e.g. [0..NUM_PL_MOVE_TYPES * (agent_available_types.size()-1)] )
  *
  */
+/**
+ * @brief Time spent in each phase of the moves of one move type (see --place_move_timing_stats)
+ */
+struct MoveTypeTiming {
+    size_t num_moves = 0;     // Moves proposed
+    size_t num_evaluated = 0; // Moves not aborted while being proposed
+    size_t num_accepted = 0;
+    double propose_time = 0.;  // Seconds spent proposing the moves
+    double evaluate_time = 0.; // Seconds spent applying the moves and computing their cost changes
+    double commit_time = 0.;   // Seconds spent committing the accepted moves
+    double revert_time = 0.;   // Seconds spent reverting the rejected moves
+};
+
 struct MoveTypeStat {
     std::vector<int> blk_type_moves;
     std::vector<int> accepted_moves;
     std::vector<int> rejected_moves;
+    std::vector<MoveTypeTiming> move_timing; // [0..num_move_types-1], empty unless --place_move_timing_stats is on
 };
 
 /**
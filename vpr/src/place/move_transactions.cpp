@@ -1,6 +1,7 @@
 #include "move_utils.h"
 
 #include "globals.h"
+#include "directed_moves_util.h"
 #include "place_util.h"
 
 //Records that block 'blk' should be moved to the specified 'to' location
@@ -84,6 +85,8 @@ void commit_move_blocks(const t_pl_blocks_to_be_moved& blocks_affected) {
         place_ctx.grid_blocks.set_block_at_location(to, blk);
 
     } // Finish updating clb for all blocks
+
+    update_net_sink_coord_sums(blocks_affected);
 }
 
 //Moves the blocks in blocks_affected to their old locations
@@ -670,6 +670,16 @@ ClusterBlockId pick_from_highly_critical_block(ClusterNetId& net_from, int& pin_
     return ClusterBlockId::INVALID();
 }
 
+//Picks a sub-tile of to_loc which is legal for the floorplan constraints of the constrained block b_from, if the
+//constraints restrict sub-tiles. Returns false if no sub-tile of to_loc is legal.
+static bool pick_floorplan_legal_sub_tile(ClusterBlockId b_from, t_logical_block_type_ptr type, t_pl_loc& to_loc) {
+    const auto& pr_grid = g_placer_ctx.mutable_move().compressed_pr_grids.get(b_from);
+    if (!pr_grid.sub_tile_constrained) {
+        return true;
+    }
+    return pick_compressed_pr_grid_sub_tile(pr_grid, type, to_loc);
+}
+
 bool find_to_loc_uniform(t_logical_block_type_ptr type,
                          float rlim,
                          const t_pl_loc from,
@@ -706,24 +716,24 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
     bool legal = false;
 
     //TODO: constraints should be adapted to 3D architecture
-    if (is_cluster_constrained(b_from)) {
-        bool intersect = intersect_range_limit_with_floorplan_constraints(type,
-                                                                          b_from,
-                                                                          search_range[from_layer_num],
-                                                                          delta_cx,
-                                                                          from_layer_num);
-        if (!intersect) {
-            return false;
-        }
+    bool constrained = is_cluster_constrained(b_from);
+    if (constrained) {
+        //Only sample the locations which are legal for the block's floorplan constraints
+        legal = find_compatible_compressed_loc_in_pr(b_from,
+                                                     compressed_locs[from_layer_num],
+                                                     search_range[from_layer_num],
+                                                     to_compressed_loc,
+                                                     from_layer_num);
+    } else {
+        //TODO: For now, we only move the blocks on the same tile
+        legal = find_compatible_compressed_loc_in_range(type,
+                                                        delta_cx,
+                                                        compressed_locs[from_layer_num],
+                                                        search_range[from_layer_num],
+                                                        to_compressed_loc,
+                                                        false,
+                                                        from_layer_num);
     }
-    //TODO: For now, we only move the blocks on the same tile
-    legal = find_compatible_compressed_loc_in_range(type,
-                                                    delta_cx,
-                                                    compressed_locs[from_layer_num],
-                                                    search_range[from_layer_num],
-                                                    to_compressed_loc,
-                                                    false,
-                                                    from_layer_num);
 
     if (!legal) {
         //No valid position found
@@ -734,6 +744,9 @@ bool find_to_loc_uniform(t_logical_block_type_ptr type,
 
     //Convert to true (uncompressed) grid locations
     compressed_grid_to_loc(type, to_compressed_loc, to);
+    if (constrained && !pick_floorplan_legal_sub_tile(b_from, type, to)) {
+        return false;
+    }
 
     auto& grid = g_vpr_ctx.device().grid;
     const auto& to_type = grid.get_physical_type(t_physical_tile_loc(to.x, to.y, to.layer));
@@ -796,25 +809,24 @@ bool find_to_loc_median(t_logical_block_type_ptr blk_type,
     t_physical_tile_loc to_compressed_loc;
     bool legal = false;
 
-    if (is_cluster_constrained(b_from)) {
-        bool intersect = intersect_range_limit_with_floorplan_constraints(blk_type,
-                                                                          b_from,
-                                                                          search_range,
-                                                                          delta_cx,
-                                                                          from_layer_num);
-        if (!intersect) {
-            return false;
-        }
+    bool constrained = is_cluster_constrained(b_from);
+    if (constrained) {
+        //Only sample the locations which are legal for the block's floorplan constraints
+        legal = find_compatible_compressed_loc_in_pr(b_from,
+                                                     from_compressed_locs[from_layer_num],
+                                                     search_range,
+                                                     to_compressed_loc,
+                                                     from_layer_num);
+    } else {
+        legal = find_compatible_compressed_loc_in_range(blk_type,
+                                                        delta_cx,
+                                                        from_compressed_locs[from_layer_num],
+                                                        search_range,
+                                                        to_compressed_loc,
+                                                        true,
+                                                        from_layer_num);
     }
 
-    legal = find_compatible_compressed_loc_in_range(blk_type,
-                                                    delta_cx,
-                                                    from_compressed_locs[from_layer_num],
-                                                    search_range,
-                                                    to_compressed_loc,
-                                                    true,
-                                                    from_layer_num);
-
     if (!legal) {
         //No valid position found
         return false;
@@ -824,6 +836,9 @@ bool find_to_loc_median(t_logical_block_type_ptr blk_type,
 
     //Convert to true (uncompressed) grid locations
     compressed_grid_to_loc(blk_type, to_compressed_loc, to_loc);
+    if (constrained && !pick_floorplan_legal_sub_tile(b_from, blk_type, to_loc)) {
+        return false;
+    }
 
     auto& grid = g_vpr_ctx.device().grid;
     const auto& to_type = grid.get_physical_type(t_physical_tile_loc(to_loc.x, to_loc.y, to_loc.layer));
@@ -878,26 +893,25 @@ bool find_to_loc_centroid(t_logical_block_type_ptr blk_type,
     t_physical_tile_loc to_compressed_loc;
     bool legal = false;
 
-    if (is_cluster_constrained(b_from)) {
-        bool intersect = intersect_range_limit_with_floorplan_constraints(blk_type,
-                                                                          b_from,
-                                                                          search_range[from_layer_num],
-                                                                          delta_cx,
-                                                                          from_layer_num);
-        if (!intersect) {
-            return false;
-        }
+    bool constrained = is_cluster_constrained(b_from);
+    if (constrained) {
+        //Only sample the locations which are legal for the block's floorplan constraints
+        legal = find_compatible_compressed_loc_in_pr(b_from,
+                                                     from_compressed_loc[from_layer_num],
+                                                     search_range[from_layer_num],
+                                                     to_compressed_loc,
+                                                     from_layer_num);
+    } else {
+        //TODO: For now, we only move the blocks on the same tile
+        legal = find_compatible_compressed_loc_in_range(blk_type,
+                                                        delta_cx,
+                                                        from_compressed_loc[from_layer_num],
+                                                        search_range[from_layer_num],
+                                                        to_compressed_loc,
+                                                        false,
+                                                        from_layer_num);
     }
 
-    //TODO: For now, we only move the blocks on the same tile
-    legal = find_compatible_compressed_loc_in_range(blk_type,
-                                                    delta_cx,
-                                                    from_compressed_loc[from_layer_num],
-                                                    search_range[from_layer_num],
-                                                    to_compressed_loc,
-                                                    false,
-                                                    from_layer_num);
-
     if (!legal) {
         //No valid position found
         return false;
@@ -907,6 +921,9 @@ bool find_to_loc_centroid(t_logical_block_type_ptr blk_type,
 
     //Convert to true (uncompressed) grid locations
     compressed_grid_to_loc(blk_type, to_compressed_loc, to_loc);
+    if (constrained && !pick_floorplan_legal_sub_tile(b_from, blk_type, to_loc)) {
+        return false;
+    }
 
     auto& grid = g_vpr_ctx.device().grid;
     const auto& to_type = grid.get_physical_type(t_physical_tile_loc(to_loc.x, to_loc.y, to_loc.layer));
@@ -1047,6 +1064,68 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
     return legal;
 }
 
+bool find_compatible_compressed_loc_in_pr(ClusterBlockId b_from,
+                                          const t_physical_tile_loc& from_loc,
+                                          const t_bb& search_range,
+                                          t_physical_tile_loc& to_loc,
+                                          int to_layer_num) {
+    //TODO For the time being, the blocks only moved in the same layer. This assertion should be removed after VPR is updated to move blocks between layers
+    VTR_ASSERT(to_layer_num == from_loc.layer_num);
+    const auto& pr_grid = g_placer_ctx.mutable_move().compressed_pr_grids.get(b_from);
+    const auto& columns = pr_grid.columns[to_layer_num];
+    const auto& rows = pr_grid.rows[to_layer_num];
+    to_loc.layer_num = to_layer_num;
+
+    //The columns with legal locations within the search range
+    int first_column = std::lower_bound(columns.begin(), columns.end(), search_range.xmin) - columns.begin();
+    int num_columns = (std::upper_bound(columns.begin(), columns.end(), search_range.xmax) - columns.begin()) - first_column;
+
+    std::unordered_set<int> tried_columns;
+    while ((int)tried_columns.size() < num_columns) { //Until found or all possibilities exhausted
+        int icolumn = first_column + vtr::irand(num_columns - 1);
+
+        //Record this column as tried
+        auto res = tried_columns.insert(icolumn);
+        if (!res.second) {
+            continue; //Already tried this column
+        }
+
+        //The legal rows of this column within the search range
+        const auto& column_rows = rows[icolumn];
+        auto y_lower_iter = std::lower_bound(column_rows.begin(), column_rows.end(), search_range.ymin);
+        auto y_upper_iter = std::upper_bound(y_lower_iter, column_rows.end(), search_range.ymax);
+        int y_range = std::distance(y_lower_iter, y_upper_iter);
+
+        to_loc.x = columns[icolumn];
+
+        //Never pick the block's current location
+        int from_dy = OPEN;
+        if (to_loc.x == from_loc.x) {
+            auto from_iter = std::lower_bound(y_lower_iter, y_upper_iter, from_loc.y);
+            if (from_iter != y_upper_iter && *from_iter == from_loc.y) {
+                from_dy = std::distance(y_lower_iter, from_iter);
+                y_range--;
+            }
+        }
+
+        if (y_range <= 0) {
+            continue; //No other legal location in this column
+        }
+
+        int dy = vtr::irand(y_range - 1);
+        if (from_dy != OPEN && dy >= from_dy) {
+            dy++;
+        }
+        to_loc.y = *(y_lower_iter + dy);
+
+        VTR_ASSERT(to_loc.y >= search_range.ymin);
+        VTR_ASSERT(to_loc.y <= search_range.ymax);
+        return true;
+    }
+
+    return false;
+}
+
 std::vector<t_physical_tile_loc> get_compressed_loc(const t_compressed_block_grid& compressed_block_grid,
                                                     t_pl_loc grid_loc,
                                                     int num_layers) {
@@ -1154,66 +1233,6 @@ std::vector<t_bb> get_compressed_grid_bounded_search_range(const t_compressed_bl
     return search_range;
 }
 
-bool intersect_range_limit_with_floorplan_constraints(t_logical_block_type_ptr type,
-                                                      ClusterBlockId b_from,
-                                                      t_bb& search_range,
-                                                      int& delta_cx,
-                                                      int layer_num) {
-    //Retrieve the compressed block grid for this block type
-    const auto& compressed_block_grid = g_vpr_ctx.placement().compressed_block_grids[type->index];
-
-    auto min_grid_loc = compressed_block_grid.compressed_loc_to_grid_loc({search_range.xmin,
-                                                                          search_range.ymin,
-                                                                          layer_num});
-
-    auto max_grid_loc = compressed_block_grid.compressed_loc_to_grid_loc({search_range.xmax,
-                                                                          search_range.ymax,
-                                                                          layer_num});
-
-    Region range_reg;
-    range_reg.set_region_rect({min_grid_loc.x,
-                               min_grid_loc.y,
-                               max_grid_loc.x,
-                               max_grid_loc.y,
-                               layer_num});
-
-    auto& floorplanning_ctx = g_vpr_ctx.floorplanning();
-
-    PartitionRegion pr = floorplanning_ctx.cluster_constraints[b_from];
-    std::vector<Region> regions;
-    if (!pr.empty()) {
-        regions = pr.get_partition_region();
-    }
-    Region intersect_reg;
-    /*
-     * If region size is greater than 1, the block is constrained to more than one rectangular region.
-     * In this case, we return true (i.e. the range limit intersects with
-     * the floorplan constraints) to simplify the problem. This simplification can be done because
-     * this routine is done for cpu time optimization, so we do not have to necessarily check each
-     * complicated case to get correct functionality during place moves.
-     */
-    if (regions.size() == 1) {
-        intersect_reg = intersection(regions[0], range_reg);
-
-        if (intersect_reg.empty()) {
-            return false;
-        } else {
-            const auto intersect_coord = intersect_reg.get_region_rect();
-            VTR_ASSERT(intersect_coord.layer_num == layer_num);
-            auto min_compressed_loc = compressed_block_grid.grid_loc_to_compressed_loc_approx({intersect_coord.xmin,
-                                                                                               intersect_coord.ymin,
-                                                                                               layer_num});
-
-            auto max_compressed_loc = compressed_block_grid.grid_loc_to_compressed_loc_approx({intersect_coord.xmax,
-                                                                                               intersect_coord.ymax,
-                                                                                               layer_num});
-            delta_cx = max_compressed_loc.x - min_compressed_loc.x;
-        }
-    }
-
-    return true;
-}
-
 std::string e_move_result_to_string(e_move_result move_outcome) {
     std::string move_result_to_string[] = {"Rejected", "Accepted", "Aborted"};
     return move_result_to_string[move_outcome];
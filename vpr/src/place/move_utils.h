@@ -237,6 +237,24 @@ bool find_compatible_compressed_loc_in_range(t_logical_block_type_ptr type,
                                              bool is_median,
                                              int to_layer_num);
 
+/**
+ * @brief find compressed location in a compressed range which is legal for the floorplan constraints of the block b_from
+ *
+ * Only samples the locations of the block type's compressed grid which are legal for the block's (propagated) floorplan
+ * constraints (see CompressedPRGridCache), so moves of constrained blocks are not aborted for violating them.
+ * b_from must be floorplan constrained.
+ *
+ * from_loc: the compressed location of the old location
+ * search_range: the compressed range to search in
+ * to_loc: the new location on the compressed grid
+ * to_layer_num: the layer number of the new location (set by the caller)
+ */
+bool find_compatible_compressed_loc_in_pr(ClusterBlockId b_from,
+                                          const t_physical_tile_loc& from_loc,
+                                          const t_bb& search_range,
+                                          t_physical_tile_loc& to_loc,
+                                          int to_layer_num);
+
 /**
  * @brief Get the the compressed loc from the uncompressed loc (grid_loc)
  * @note This assumes the grid_loc corresponds to a location of the block type that compressed_block_grid stores its
@@ -299,29 +317,6 @@ std::vector<t_bb> get_compressed_grid_bounded_search_range(const t_compressed_bl
                                                            float rlim,
                                                            int num_layers);
 
-/*
- * If the block to be moved (b_from) has a floorplan constraint, this routine changes the max and min coords
- * in the compressed grid (min_cx, min_cy, max_cx, max_cy) to make sure the range limit is within the floorplan constraint.
- *
- * Returns false if there is no intersection between the range limit and the floorplan constraint,
- * true otherwise.
- *
- *
- * If region size of the block's floorplan constraints is greater than 1, the block is constrained to more than one rectangular region.
- * In this case, we return true (i.e. the range limit intersects with
- * the floorplan constraints) to simplify the problem. This simplification can be done because
- * this routine is done for cpu time optimization, so we do not have to necessarily check each
- * complicated case to get correct functionality during place moves.
- *
- * The intersection takes place in the layer (die) specified by layer_num.
- *
- */
-bool intersect_range_limit_with_floorplan_constraints(t_logical_block_type_ptr type,
-                                                      ClusterBlockId b_from,
-                                                      t_bb& search_range,
-                                                      int& delta_cx,
-                                                      int layer_num);
-
 std::string e_move_result_to_string(e_move_result move_outcome);
 
 #endif
@@ -0,0 +1,99 @@
+#include "net_bb_histograms.h"
+
+#include "vtr_assert.h"
+#include "vtr_memory.h"
+
+void NetBBHistograms::init(size_t num_nets, int max_x, int max_y) {
+    VTR_ASSERT(max_x >= 0 && max_y >= 0);
+
+    num_x_ = max_x + 1;
+    num_y_ = max_y + 1;
+
+    net_index_.assign(num_nets, NO_HISTOGRAM);
+    x_counts_.clear();
+    y_counts_.clear();
+    pin_offset_.clear();
+    pin_x_.clear();
+    pin_y_.clear();
+}
+
+void NetBBHistograms::clear() {
+    num_x_ = 0;
+    num_y_ = 0;
+
+    vtr::release_memory(net_index_);
+    vtr::release_memory(x_counts_);
+    vtr::release_memory(y_counts_);
+    vtr::release_memory(pin_offset_);
+    vtr::release_memory(pin_x_);
+    vtr::release_memory(pin_y_);
+}
+
+void NetBBHistograms::add_net(ClusterNetId net, size_t num_pins) {
+    VTR_ASSERT(size_t(net) < net_index_.size());
+    VTR_ASSERT(net_index_[net] == NO_HISTOGRAM);
+
+    net_index_[net] = pin_offset_.size();
+    pin_offset_.push_back(pin_x_.size());
+
+    x_counts_.resize(x_counts_.size() + num_x_, 0);
+    y_counts_.resize(y_counts_.size() + num_y_, 0);
+    pin_x_.resize(pin_x_.size() + num_pins, NOT_COUNTED);
+    pin_y_.resize(pin_y_.size() + num_pins, NOT_COUNTED);
+}
+
+void NetBBHistograms::set_pin_loc(ClusterNetId net, size_t ipin, int x, int y) {
+    VTR_ASSERT_SAFE(has_net(net));
+    VTR_ASSERT_SAFE(x >= 0 && size_t(x) < num_x_);
+    VTR_ASSERT_SAFE(y >= 0 && size_t(y) < num_y_);
+
+    size_t pin = pin_offset_[net_index_[net]] + ipin;
+    int* x_counts = &x_counts_[x_offset(net)];
+    int* y_counts = &y_counts_[y_offset(net)];
+
+    if (pin_x_[pin] != NOT_COUNTED) {
+        --x_counts[pin_x_[pin]];
+        --y_counts[pin_y_[pin]];
+    }
+
+    ++x_counts[x];
+    ++y_counts[y];
+    pin_x_[pin] = x;
+    pin_y_[pin] = y;
+}
+
+int NetBBHistograms::lowest_x_from(ClusterNetId net, int x) const {
+    const int* x_counts = &x_counts_[x_offset(net)];
+    while (x_counts[x] == 0) {
+        ++x;
+        VTR_ASSERT_SAFE(size_t(x) < num_x_);
+    }
+    return x;
+}
+
+int NetBBHistograms::highest_x_from(ClusterNetId net, int x) const {
+    const int* x_counts = &x_counts_[x_offset(net)];
+    while (x_counts[x] == 0) {
+        --x;
+        VTR_ASSERT_SAFE(x >= 0);
+    }
+    return x;
+}
+
+int NetBBHistograms::lowest_y_from(ClusterNetId net, int y) const {
+    const int* y_counts = &y_counts_[y_offset(net)];
+    while (y_counts[y] == 0) {
+        ++y;
+        VTR_ASSERT_SAFE(size_t(y) < num_y_);
+    }
+    return y;
+}
+
+int NetBBHistograms::highest_y_from(ClusterNetId net, int y) const {
+    const int* y_counts = &y_counts_[y_offset(net)];
+    while (y_counts[y] == 0) {
+        --y;
+        VTR_ASSERT_SAFE(y >= 0);
+    }
+    return y;
+}
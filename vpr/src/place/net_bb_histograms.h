@@ -0,0 +1,95 @@
+#ifndef VPR_NET_BB_HISTOGRAMS_H
+#define VPR_NET_BB_HISTOGRAMS_H
+
+#include <vector>
+
+#include "clustered_netlist_fwd.h"
+#include "vtr_vector.h"
+
+/**
+ * @brief Per-net histograms of the pin coordinates of high fanout nets.
+ *
+ * For every tracked net, the number of its pins in each column (x) and in
+ * each row (y) is kept, along with the coordinate each pin is currently
+ * counted at. When a pin leaves an edge of the net's bounding box, the new
+ * edge is found by scanning the histogram inwards from the old edge instead
+ * of re-visiting every pin of the net, so shrinking a bounding box costs
+ * O(distance moved by the edge) rather than O(fanout).
+ *
+ * The data is stored as structure-of-arrays: the x counts, y counts and pin
+ * coordinates of all tracked nets live in three flat vectors, with each
+ * net's entries contiguous.
+ *
+ * Different nets may be updated concurrently; a single net may not.
+ */
+class NetBBHistograms {
+  public:
+    /**
+     * @brief Drops all tracked nets and sizes the store for nets in
+     *        [0, num_nets) with pin coordinates in [0, max_x] x [0, max_y].
+     */
+    void init(size_t num_nets, int max_x, int max_y);
+
+    ///@brief Drops all tracked nets and releases the memory.
+    void clear();
+
+    /**
+     * @brief Starts tracking net with num_pins pins.
+     *
+     * The pins are not counted anywhere until set_pin_loc() is called on them.
+     */
+    void add_net(ClusterNetId net, size_t num_pins);
+
+    ///@brief Returns true if net is tracked.
+    bool has_net(ClusterNetId net) const {
+        return size_t(net) < net_index_.size() && net_index_[net] != NO_HISTOGRAM;
+    }
+
+    ///@brief Moves the count of pin ipin (net pin index) of net to (x, y).
+    void set_pin_loc(ClusterNetId net, size_t ipin, int x, int y);
+
+    ///@brief Returns the number of pins of net in column x.
+    int num_pins_at_x(ClusterNetId net, int x) const {
+        return x_counts_[x_offset(net) + x];
+    }
+
+    ///@brief Returns the number of pins of net in row y.
+    int num_pins_at_y(ClusterNetId net, int y) const {
+        return y_counts_[y_offset(net) + y];
+    }
+
+    ///@brief Returns the lowest column >= x holding a pin of net.
+    int lowest_x_from(ClusterNetId net, int x) const;
+    ///@brief Returns the highest column <= x holding a pin of net.
+    int highest_x_from(ClusterNetId net, int x) const;
+    ///@brief Returns the lowest row >= y holding a pin of net.
+    int lowest_y_from(ClusterNetId net, int y) const;
+    ///@brief Returns the highest row <= y holding a pin of net.
+    int highest_y_from(ClusterNetId net, int y) const;
+
+  private:
+    static constexpr int NO_HISTOGRAM = -1;
+    static constexpr int NOT_COUNTED = -1;
+
+    size_t x_offset(ClusterNetId net) const { return size_t(net_index_[net]) * num_x_; }
+    size_t y_offset(ClusterNetId net) const { return size_t(net_index_[net]) * num_y_; }
+
+    size_t num_x_ = 0;
+    size_t num_y_ = 0;
+
+    ///@brief [0..num_nets-1] Index of each net's histogram, or NO_HISTOGRAM
+    vtr::vector<ClusterNetId, int> net_index_;
+
+    ///@brief [0..num_tracked_nets*num_x_-1] Pins per column of each tracked net
+    std::vector<int> x_counts_;
+    ///@brief [0..num_tracked_nets*num_y_-1] Pins per row of each tracked net
+    std::vector<int> y_counts_;
+
+    ///@brief [0..num_tracked_nets-1] Index of each tracked net's first pin in pin_x_/pin_y_
+    std::vector<size_t> pin_offset_;
+    ///@brief Coordinate each pin of the tracked nets is counted at, or NOT_COUNTED
+    std::vector<int> pin_x_;
+    std::vector<int> pin_y_;
+};
+
+#endif
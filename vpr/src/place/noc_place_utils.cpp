@@ -1,14 +1,65 @@
 
 #include "noc_place_utils.h"
 
+#include "vtr_hash.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 /********************** Variables local to noc_place_utils.c pp***************************/
 /* Proposed and actual cost of a noc traffic flow used for each move assessment */
 static vtr::vector<NocTrafficFlowId, TrafficFlowPlaceCost> traffic_flow_costs, proposed_traffic_flow_costs;
 
 /* Keeps track of traffic flows that have been updated at each attempted placement move*/
 static std::vector<NocTrafficFlowId> affected_traffic_flows;
+
+/* Hashes a (source, sink) pair of physical NoC routers */
+struct noc_router_pair_hash {
+    std::size_t operator()(const std::pair<NocRouterId, NocRouterId>& router_pair) const noexcept {
+        std::size_t seed = std::hash<NocRouterId>{}(router_pair.first);
+        vtr::hash_combine(seed, router_pair.second);
+        return seed;
+    }
+};
+
+/* Routes found so far between (source, sink) pairs of physical NoC routers. The supported routing algorithms
+ * only depend on the two routers, so traffic flows re-routed between the same routers (e.g. when router moves
+ * are rejected or routers are swapped back) reuse the route instead of routing again. Cleared whenever the
+ * traffic flows are routed from scratch (initial_noc_routing()), as the NoC model or routing algorithm may have changed. */
+static std::unordered_map<std::pair<NocRouterId, NocRouterId>, std::vector<NocLinkId>, noc_router_pair_hash> noc_route_cache;
 /*********************************************************** *****************************/
 
+/* Returns the hard (source, sink) routers where the router cluster blocks of the traffic flow are placed */
+static std::pair<NocRouterId, NocRouterId> get_traffic_flow_routers(const t_noc_traffic_flow& traffic_flow, const NocStorage& noc_model, const vtr::vector_map<ClusterBlockId, t_block_loc>& placed_cluster_block_locations) {
+    NocRouterId source_router_block_id = noc_model.get_router_at_grid_location(placed_cluster_block_locations[traffic_flow.source_router_cluster_id].loc);
+    NocRouterId sink_router_block_id = noc_model.get_router_at_grid_location(placed_cluster_block_locations[traffic_flow.sink_router_cluster_id].loc);
+    return {source_router_block_id, sink_router_block_id};
+}
+
+/* Routes all the traffic flows based on where their router cluster blocks are placed, stores the
+ * route of each traffic flow in traffic_flow_routes (indexed like get_all_traffic_flow_id()).
+ * Given a fixed placement the traffic flows are independent, so they are routed in parallel if VPR is built with TBB
+ * (the routing algorithms keep no state between flows). */
+static void route_all_traffic_flows(const NocStorage& noc_model, const NocTrafficFlows& noc_traffic_flows_storage, NocRouting& noc_flows_router, const vtr::vector_map<ClusterBlockId, t_block_loc>& placed_cluster_block_locations, std::vector<std::vector<NocLinkId>>& traffic_flow_routes) {
+    const std::vector<NocTrafficFlowId>& traffic_flow_ids = noc_traffic_flows_storage.get_all_traffic_flow_id();
+    traffic_flow_routes.resize(traffic_flow_ids.size());
+
+    auto route_traffic_flow = [&](size_t iflow) {
+        const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_ids[iflow]);
+        auto routers = get_traffic_flow_routers(curr_traffic_flow, noc_model, placed_cluster_block_locations);
+        noc_flows_router.route_flow(routers.first, routers.second, traffic_flow_routes[iflow], noc_model);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), traffic_flow_ids.size(), route_traffic_flow);
+#else
+    for (size_t iflow = 0; iflow < traffic_flow_ids.size(); iflow++) {
+        route_traffic_flow(iflow);
+    }
+#endif
+}
+
 void initial_noc_routing(void) {
     // need to get placement information about where the router cluster blocks are placed on the device
     const auto& place_ctx = g_vpr_ctx.placement();
@@ -19,16 +70,27 @@ void initial_noc_routing(void) {
 
     NocTrafficFlows* noc_traffic_flows_storage = &noc_ctx.noc_traffic_flows_storage;
 
+    // routes found before may belong to another NoC model or routing algorithm
+    noc_route_cache.clear();
+
+    // route all the traffic flows based on where the router cluster blocks are placed
+    std::vector<std::vector<NocLinkId>> traffic_flow_routes;
+    route_all_traffic_flows(noc_ctx.noc_model, *noc_traffic_flows_storage, *noc_ctx.noc_flows_router, place_ctx.block_locs, traffic_flow_routes);
+
     /* We need all the traffic flow ids to be able to access them. The range
      * of traffic flow ids go from 0 to the total number of traffic flows within
      * the NoC.
-     * go through all the traffic flows and route them. Then once routed, update the links used in the routed traffic flows with their usages
+     * go through all the traffic flows and store their routes. Then update the links used in the routed traffic flows with their usages
+     * (in traffic flow order, so the link usages do not depend on the order the traffic flows were routed in)
      */
-    for (const auto& traffic_flow_id : noc_traffic_flows_storage->get_all_traffic_flow_id()) {
+    const std::vector<NocTrafficFlowId>& traffic_flow_ids = noc_traffic_flows_storage->get_all_traffic_flow_id();
+    for (size_t iflow = 0; iflow < traffic_flow_ids.size(); iflow++) {
+        NocTrafficFlowId traffic_flow_id = traffic_flow_ids[iflow];
         const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage->get_single_noc_traffic_flow(traffic_flow_id);
 
-        // update the traffic flow route based on where the router cluster blocks are placed
-        std::vector<NocLinkId>& curr_traffic_flow_route = get_traffic_flow_route(traffic_flow_id, noc_ctx.noc_model, *noc_traffic_flows_storage, *noc_ctx.noc_flows_router, place_ctx.block_locs);
+        std::vector<NocLinkId>& curr_traffic_flow_route = noc_traffic_flows_storage->get_mutable_traffic_flow_route(traffic_flow_id);
+        curr_traffic_flow_route = std::move(traffic_flow_routes[iflow]);
+        noc_route_cache.emplace(get_traffic_flow_routers(curr_traffic_flow, noc_ctx.noc_model, place_ctx.block_locs), curr_traffic_flow_route);
 
         // update the links used in the found traffic flow route, links' bandwidth should be incremented since the traffic flow is routed
         update_traffic_flow_link_usage(curr_traffic_flow_route, noc_ctx.noc_model, 1, curr_traffic_flow.traffic_flow_bandwidth);
@@ -110,17 +172,18 @@ std::vector<NocLinkId>& get_traffic_flow_route(NocTrafficFlowId traffic_flow_id,
     // get the traffic flow with the current id
     const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage.get_single_noc_traffic_flow(traffic_flow_id);
 
-    // get the source and destination logical router blocks in the current traffic flow
-    ClusterBlockId logical_source_router_block_id = curr_traffic_flow.source_router_cluster_id;
-    ClusterBlockId logical_sink_router_block_id = curr_traffic_flow.sink_router_cluster_id;
-
     // get the ids of the hard router blocks where the logical router cluster blocks have been placed
-    NocRouterId source_router_block_id = noc_model.get_router_at_grid_location(placed_cluster_block_locations[logical_source_router_block_id].loc);
-    NocRouterId sink_router_block_id = noc_model.get_router_at_grid_location(placed_cluster_block_locations[logical_sink_router_block_id].loc);
+    auto router_pair = get_traffic_flow_routers(curr_traffic_flow, noc_model, placed_cluster_block_locations);
 
-    // route the current traffic flow
+    // route the current traffic flow, unless a route between the two routers was already found
     std::vector<NocLinkId>& curr_traffic_flow_route = noc_traffic_flows_storage.get_mutable_traffic_flow_route(traffic_flow_id);
-    noc_flows_router.route_flow(source_router_block_id, sink_router_block_id, curr_traffic_flow_route, noc_model);
+    auto cached_route = noc_route_cache.find(router_pair);
+    if (cached_route != noc_route_cache.end()) {
+        curr_traffic_flow_route = cached_route->second;
+    } else {
+        noc_flows_router.route_flow(router_pair.first, router_pair.second, curr_traffic_flow_route, noc_model);
+        noc_route_cache.emplace(router_pair, curr_traffic_flow_route);
+    }
 
     return curr_traffic_flow_route;
 }
@@ -318,34 +381,22 @@ int check_noc_placement_costs(const t_placer_costs& costs, double error_toleranc
     NocRoutingAlgorithmCreator routing_algorithm_factory;
     NocRouting* temp_noc_routing_algorithm = routing_algorithm_factory.create_routing_algorithm(noc_opts.noc_routing_algorithm);
 
-    // stores a temporarily found route for a traffic flow
-    std::vector<NocLinkId> temp_found_noc_route;
+    // find a route for all the traffic flows based on where the routers are placed within the NoC
+    std::vector<std::vector<NocLinkId>> temp_found_noc_routes;
+    route_all_traffic_flows(*noc_model, *noc_traffic_flows_storage, *temp_noc_routing_algorithm, *placed_cluster_block_locations, temp_found_noc_routes);
 
-    // go through all the traffic flows and find a route for them based on where the routers are placed within the NoC
-    for (const auto& traffic_flow_id : noc_traffic_flows_storage->get_all_traffic_flow_id()) {
+    // go through all the traffic flows and accumulate their costs to find the total cost of the NoC placement
+    const std::vector<NocTrafficFlowId>& traffic_flow_ids = noc_traffic_flows_storage->get_all_traffic_flow_id();
+    for (size_t iflow = 0; iflow < traffic_flow_ids.size(); iflow++) {
         // get the traffic flow with the current id
-        const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage->get_single_noc_traffic_flow(traffic_flow_id);
-
-        // get the source and destination logical router blocks in the current traffic flow
-        ClusterBlockId logical_source_router_block_id = curr_traffic_flow.source_router_cluster_id;
-        ClusterBlockId logical_sink_router_block_id = curr_traffic_flow.sink_router_cluster_id;
-
-        // get the ids of the hard router blocks where the logical router cluster blocks have been placed
-        NocRouterId source_router_block_id = noc_model->get_router_at_grid_location((*placed_cluster_block_locations)[logical_source_router_block_id].loc);
-        NocRouterId sink_router_block_id = noc_model->get_router_at_grid_location((*placed_cluster_block_locations)[logical_sink_router_block_id].loc);
+        const t_noc_traffic_flow& curr_traffic_flow = noc_traffic_flows_storage->get_single_noc_traffic_flow(traffic_flow_ids[iflow]);
 
-        // route the current traffic flow
-        temp_noc_routing_algorithm->route_flow(source_router_block_id, sink_router_block_id, temp_found_noc_route, *noc_model);
-
-        // now calculate the costs associated to the current traffic flow and accumulate it to find the total cost of the NoC placement
-        double current_flow_aggregate_bandwidth_cost = calculate_traffic_flow_aggregate_bandwidth_cost(temp_found_noc_route, curr_traffic_flow);
+        // now calculate the costs associated to the current traffic flow
+        double current_flow_aggregate_bandwidth_cost = calculate_traffic_flow_aggregate_bandwidth_cost(temp_found_noc_routes[iflow], curr_traffic_flow);
         noc_aggregate_bandwidth_cost_check += current_flow_aggregate_bandwidth_cost;
 
-        double current_flow_latency_cost = calculate_traffic_flow_latency_cost(temp_found_noc_route, *noc_model, curr_traffic_flow, noc_opts);
+        double current_flow_latency_cost = calculate_traffic_flow_latency_cost(temp_found_noc_routes[iflow], *noc_model, curr_traffic_flow, noc_opts);
         noc_latency_cost_check += current_flow_latency_cost;
-
-        // clear the current traffic flow route, so we can route the next traffic flow
-        temp_found_noc_route.clear();
     }
 
     // check whether the aggregate bandwidth placement cost is within the error tolerance
@@ -448,6 +499,7 @@ void free_noc_placement_structs(void) {
     vtr::release_memory(traffic_flow_costs);
     vtr::release_memory(proposed_traffic_flow_costs);
     vtr::release_memory(affected_traffic_flows);
+    noc_route_cache.clear();
 
     return;
 }
@@ -130,7 +130,8 @@ void commit_noc_costs();
  * 
  * First, the hard routers blocks that represent the placed location of
  * the router cluster blocks are identified. Then the traffic flow
- * is routed and updated.
+ * is routed and updated. The route found between the same two hard routers
+ * since the last initial_noc_routing() is reused instead of routing again.
  * 
  * @param traffic_flow_id Represents the traffic flow that needs to be routed
  * @param noc_model Contains all the links and routers within the NoC. Used
@@ -41,6 +41,7 @@
 #include "place_timing_update.h"
 #include "move_transactions.h"
 #include "move_utils.h"
+#include "net_bb_histograms.h"
 #include "read_place.h"
 #include "place_constraints.h"
 #include "manual_moves.h"
@@ -62,12 +63,20 @@
 #include "place_checkpoint.h"
 
 #include "clustered_netlist_utils.h"
+#include "netlist_csr_view.h"
 
 #include "re_cluster.h"
 #include "re_cluster_util.h"
 #include "cluster_placement.h"
 
 #include "noc_place_utils.h"
+#include "directed_moves_util.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_for.h>
+#    include <tbb/parallel_for_each.h>
+#endif
 
 /*  define the RL agent's reward function factor constant. This factor controls the weight of bb cost *
  *  compared to the timing cost in the agent's reward function. The reward is calculated as           *
@@ -102,6 +111,10 @@ using std::min;
 #define UPDATED_ONCE 'U'
 #define GOT_FROM_SCRATCH 'S'
 
+/* Nets with at least this many sinks keep per-net pin coordinate histograms *
+ * so their bounding boxes can shrink without a from-scratch recomputation.  */
+#define HISTOGRAM_BB_NET 64
+
 /* For comp_cost.  NORMAL means use the method that generates updateable  *
  * bounding boxes for speed.  CHECK means compute all bounding boxes from *
  * scratch using a very simple routine to allow checks of the other       *
@@ -116,11 +129,46 @@ enum e_cost_methods {
 constexpr float INVALID_DELAY = std::numeric_limits<float>::quiet_NaN();
 constexpr float INVALID_COST = std::numeric_limits<double>::quiet_NaN();
 
+/* A move proposed by try_swap_batch(). The moves of a batch touch disjoint *
+ * blocks, locations and nets, so the cost change of each move is evaluated *
+ * independently of (and concurrently with) the other moves of the batch.   */
+struct t_batched_move {
+    t_batched_move(size_t max_blocks)
+        : blocks_affected(max_blocks) {}
+
+    t_pl_blocks_to_be_moved blocks_affected;
+    t_propose_action proposed_action{e_move_type::UNIFORM, -1};
+    std::vector<ClusterNetId> nets_to_update;
+    double bb_delta_c = 0;
+    double timing_delta_c = 0;
+};
+
+/* The outcome of one start of a multi-start placement (--place_num_starts). */
+struct t_placement_start_result {
+    double bb_cost = 0.;
+    float cpd = 0.; //Estimated critical path delay; 0 for wirelength-driven placement
+
+    /* Lower CPD wins; the bounding box cost breaks ties (and is the only *
+     * criterion for wirelength-driven placement).                        */
+    bool is_better_than(const t_placement_start_result& other) const {
+        if (cpd != other.cpd) {
+            return cpd < other.cpd;
+        }
+        return bb_cost < other.bb_cost;
+    }
+};
+
 /********************** Variables local to place.c ***************************/
 
 /* Cost of a net, and a temporary cost of a net used during move assessment. */
 static vtr::vector<ClusterNetId, double> net_cost, proposed_net_cost;
 
+/* Flat copy of the clustered netlist connectivity, read by the cost updates of  *
+ * every move instead of the netlist accessors. The clustered netlist does not   *
+ * change during placement.                                                      */
+typedef NetlistCsrView<ClusterBlockId, ClusterPortId, ClusterPinId, ClusterNetId> ClusteredNetlistCsrView;
+static ClusteredNetlistCsrView clb_nlist_view;
+
 /* [0...cluster_ctx.clb_nlist.nets().size()-1]                                               *
  * A flag array to indicate whether the specific bounding box has been updated   *
  * in this particular swap or not. If it has been updated before, the code       *
@@ -151,6 +199,10 @@ static vtr::NdMatrix<float, 2> chany_place_cost_fac({0, 0}); //[0...device_ctx.g
 static vtr::vector<ClusterNetId, t_bb> ts_bb_coord_new, ts_bb_edge_new;
 static std::vector<ClusterNetId> ts_nets_to_update;
 
+/* Pin coordinate histograms of the nets with at least HISTOGRAM_BB_NET sinks. *
+ * Updated alongside the tentative bounding boxes and restored on rejection.  */
+static NetBBHistograms net_bb_histograms;
+
 /* These file-scoped variables keep track of the number of swaps       *
  * rejected, accepted or aborted. The total number of swap attempts    *
  * is the sum of the three number.                                     */
@@ -252,6 +304,20 @@ std::unique_ptr<FILE, decltype(&vtr::fclose)> f_move_stats_file(nullptr,
 void print_clb_placement(const char* fname);
 #endif
 
+static t_placement_start_result try_place_start(const Netlist<>& net_list,
+                                                const t_placer_opts& placer_opts,
+                                                t_annealing_sched annealing_sched,
+                                                const t_router_opts& router_opts,
+                                                const t_analysis_opts& analysis_opts,
+                                                const t_noc_opts& noc_opts,
+                                                t_chan_width_dist chan_width_dist,
+                                                t_det_routing_arch* det_routing_arch,
+                                                std::vector<t_segment_inf>& segment_inf,
+                                                t_direct_inf* directs,
+                                                int num_directs,
+                                                bool is_flat,
+                                                std::unique_ptr<PlaceDelayModel>& place_delay_model);
+
 static void alloc_and_load_placement_structs(float place_cost_exp,
                                              const t_placer_opts& placer_opts,
                                              const t_noc_opts& noc_opts,
@@ -261,6 +327,8 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
 static void alloc_and_load_try_swap_structs();
 static void free_try_swap_structs();
 
+static std::vector<ClusterBlockId> fix_blocks_outside_eco_region(const vtr::vector<ClusterBlockId, t_pl_loc>& prev_block_locs, int radius);
+
 static void free_placement_structs(const t_placer_opts& placer_opts, const t_noc_opts& noc_opts);
 
 static void alloc_and_load_for_fast_cost_update(float place_cost_exp);
@@ -269,8 +337,8 @@ static void free_fast_cost_update();
 
 static double comp_bb_cost(e_cost_methods method);
 
-static void update_move_nets(int num_nets_affected);
-static void reset_move_nets(int num_nets_affected);
+static void update_move_nets(const std::vector<ClusterNetId>& nets_to_update);
+static void reset_move_nets(const std::vector<ClusterNetId>& nets_to_update);
 
 static e_move_result try_swap(const t_annealing_state* state,
                               t_placer_costs* costs,
@@ -330,15 +398,24 @@ static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new);
 
 static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new, int xold, int yold, int xnew, int ynew);
 
+static void update_bb_from_histogram(ClusterNetId net_id, size_t net_pin, t_bb* bb_coord_new, t_bb* bb_edge_new, int xnew, int ynew);
+
+static void get_pin_bb_loc(ClusterPinId pin_id, int& x, int& y);
+
+static void load_net_bb_histogram(ClusterNetId net_id);
+
+static void revert_net_bb_histograms(const t_pl_blocks_to_be_moved& blocks_affected);
+
 static int find_affected_nets_and_update_costs(
     const t_place_algorithm& place_algorithm,
     const PlaceDelayModel* delay_model,
     const PlacerCriticalities* criticalities,
     t_pl_blocks_to_be_moved& blocks_affected,
     double& bb_delta_c,
-    double& timing_delta_c);
+    double& timing_delta_c,
+    std::vector<ClusterNetId>& nets_to_update);
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets);
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update);
 
 static void update_net_bb(const ClusterNetId net,
                           const t_pl_blocks_to_be_moved& blocks_affected,
@@ -376,6 +453,46 @@ static void outer_loop_update_timing_info(const t_placer_opts& placer_opts,
                                           NetPinTimingInvalidator* pin_timing_invalidator,
                                           SetupTimingInfo* timing_info);
 
+static bool use_batched_moves(const t_placer_opts& placer_opts,
+                              const t_noc_opts& noc_opts,
+                              const t_place_algorithm& place_algorithm);
+
+static bool accepted_moves_timing_update_due(const t_placer_opts& placer_opts,
+                                             int accepted_since_timing_update);
+
+static void try_swap_batch(const t_annealing_state* state,
+                           t_placer_costs* costs,
+                           t_placer_statistics* stats,
+                           MoveGenerator& move_generator,
+                           SetupTimingInfo* timing_info,
+                           NetPinTimingInvalidator* pin_timing_invalidator,
+                           std::vector<t_batched_move>& batch,
+                           int num_moves,
+                           const PlaceDelayModel* delay_model,
+                           const PlacerCriticalities* criticalities,
+                           const t_placer_opts& placer_opts,
+                           MoveTypeStat& move_type_stat,
+                           const t_place_algorithm& place_algorithm,
+                           float timing_bb_factor);
+
+static void placement_batched_inner_loop(const t_annealing_state* state,
+                                         const t_placer_opts& placer_opts,
+                                         const t_noc_opts& noc_opts,
+                                         int inner_recompute_limit,
+                                         t_placer_statistics* stats,
+                                         t_placer_costs* costs,
+                                         int* moves_since_cost_recompute,
+                                         NetPinTimingInvalidator* pin_timing_invalidator,
+                                         const PlaceDelayModel* delay_model,
+                                         PlacerCriticalities* criticalities,
+                                         PlacerSetupSlacks* setup_slacks,
+                                         MoveGenerator& move_generator,
+                                         t_pl_blocks_to_be_moved& blocks_affected,
+                                         SetupTimingInfo* timing_info,
+                                         const t_place_algorithm& place_algorithm,
+                                         MoveTypeStat& move_type_stat,
+                                         float timing_bb_factor);
+
 static void placement_inner_loop(const t_annealing_state* state,
                                  const t_placer_opts& placer_opts,
                                  const t_noc_opts& noc_opts,
@@ -432,6 +549,15 @@ static void print_placement_swaps_stats(const t_annealing_state& state);
 static void print_placement_move_types_stats(
     const MoveTypeStat& move_type_stat);
 
+static void print_placement_move_timing_stats(
+    const MoveTypeStat& move_type_stat);
+
+static double end_move_phase(std::chrono::steady_clock::time_point& phase_start);
+
+static t_place_snapshot_anneal_state get_snapshot_anneal_state(const t_annealing_state& state);
+
+static void restore_snapshot_anneal_state(t_annealing_state& state, const t_place_snapshot_anneal_state& snapshot_state);
+
 /*****************************************************************************/
 void try_place(const Netlist<>& net_list,
                const t_placer_opts& placer_opts,
@@ -445,10 +571,84 @@ void try_place(const Netlist<>& net_list,
                t_direct_inf* directs,
                int num_directs,
                bool is_flat) {
+    /* Runs --place_num_starts independent anneals with consecutive seeds and *
+     * keeps the best placement. The delay model (and everything else built  *
+     * before placement: architecture, rr graph, lookahead) is shared by all  *
+     * the starts.                                                            */
+    std::unique_ptr<PlaceDelayModel> place_delay_model;
+
+    int num_starts = std::max(placer_opts.place_num_starts, 1);
+    if (num_starts == 1) {
+        try_place_start(net_list, placer_opts, annealing_sched, router_opts, analysis_opts, noc_opts,
+                        chan_width_dist, det_routing_arch, segment_inf, directs, num_directs, is_flat,
+                        place_delay_model);
+        return;
+    }
+
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    t_placement_start_result best_result;
+    vtr::vector_map<ClusterBlockId, t_block_loc> best_block_locs;
+    int best_start = OPEN;
+
+    for (int istart = 0; istart < num_starts; ++istart) {
+        int seed = placer_opts.seed + istart;
+
+        VTR_LOG("\n");
+        VTR_LOG("Placement start %d of %d (seed %d)\n", istart + 1, num_starts, seed);
+        vtr::srandom(seed);
+
+        t_placement_start_result result = try_place_start(net_list, placer_opts, annealing_sched, router_opts,
+                                                          analysis_opts, noc_opts, chan_width_dist,
+                                                          det_routing_arch, segment_inf, directs, num_directs,
+                                                          is_flat, place_delay_model);
+
+        VTR_LOG("Placement start %d: bb_cost: %g CPD: %g ns\n", istart + 1, result.bb_cost, 1e9 * result.cpd);
+
+        if (best_start == OPEN || result.is_better_than(best_result)) {
+            best_result = result;
+            best_block_locs = place_ctx.block_locs;
+            best_start = istart;
+        }
+    }
+
+    VTR_LOG("\n");
+    VTR_LOG("Keeping placement start %d of %d (seed %d): bb_cost: %g CPD: %g ns\n",
+            best_start + 1, num_starts, placer_opts.seed + best_start, best_result.bb_cost, 1e9 * best_result.cpd);
+
+    if (best_start != num_starts - 1) {
+        VTR_LOG_WARN("Placement reports and echo files were written for start %d, not the kept start %d\n",
+                     num_starts, best_start + 1);
+
+        place_ctx.block_locs = best_block_locs;
+        sync_grid_to_blocks();
+
+        // Update physical pin values
+        for (auto block_id : g_vpr_ctx.clustering().clb_nlist.blocks()) {
+            place_sync_external_block_connections(block_id);
+        }
+    }
+}
+
+static t_placement_start_result try_place_start(const Netlist<>& net_list,
+                                                const t_placer_opts& placer_opts,
+                                                t_annealing_sched annealing_sched,
+                                                const t_router_opts& router_opts,
+                                                const t_analysis_opts& analysis_opts,
+                                                const t_noc_opts& noc_opts,
+                                                t_chan_width_dist chan_width_dist,
+                                                t_det_routing_arch* det_routing_arch,
+                                                std::vector<t_segment_inf>& segment_inf,
+                                                t_direct_inf* directs,
+                                                int num_directs,
+                                                bool is_flat,
+                                                std::unique_ptr<PlaceDelayModel>& place_delay_model) {
     /* Does almost all the work of placing a circuit.  Width_fac gives the   *
      * width of the widest channel.  Place_cost_exp says what exponent the   *
      * width should be taken to when calculating costs.  This allows a       *
-     * greater bias for anisotropic architectures.                           */
+     * greater bias for anisotropic architectures.                           *
+     * place_delay_model is only computed if it is not already allocated,    *
+     * so it can be reused between starts.                                   */
 
     /*
      * Currently, the functions that require is_flat as their parameter and are called during placement should
@@ -485,7 +685,6 @@ void try_place(const Netlist<>& net_list,
 
     std::shared_ptr<SetupTimingInfo> timing_info;
     std::shared_ptr<PlacementDelayCalculator> placement_delay_calc;
-    std::unique_ptr<PlaceDelayModel> place_delay_model;
     std::unique_ptr<MoveGenerator> move_generator;
     std::unique_ptr<MoveGenerator> move_generator2;
     std::unique_ptr<ManualMoveGenerator> manual_move_generator;
@@ -505,7 +704,7 @@ void try_place(const Netlist<>& net_list,
     num_swap_aborted = 0;
     num_ts_called = 0;
 
-    if (placer_opts.place_algorithm.is_timing_driven()) {
+    if (placer_opts.place_algorithm.is_timing_driven() && !place_delay_model) {
         /*do this before the initial placement to avoid messing up the initial placement */
         place_delay_model = alloc_lookups_and_delay_model(net_list,
                                                           chan_width_dist,
@@ -530,6 +729,10 @@ void try_place(const Netlist<>& net_list,
     //create the move generator based on the chosen strategy
     create_move_generators(move_generator, move_generator2, placer_opts, move_lim);
 
+    if (placer_opts.place_parallel_moves > 1 && (placer_opts.RL_agent_placement || noc_opts.noc)) {
+        VTR_LOG_WARN("--place_parallel_moves has no effect with the RL agent or NoC placement; moves are evaluated one at a time\n");
+    }
+
     width_fac = placer_opts.place_chan_width;
 
     if (router_opts.route_type == GLOBAL) {
@@ -544,7 +747,36 @@ void try_place(const Netlist<>& net_list,
 
     vtr::ScopedStartFinishTimer timer("Placement");
 
-    initial_placement(placer_opts.pad_loc_type, placer_opts.constraints_file.c_str(), noc_opts.noc);
+    /* Incremental placement starts from the previous placement of the netlist, and *
+     * only re-optimizes the neighbourhood of the blocks that could not keep their  *
+     * previous location with a quench.                                             */
+    bool incremental = !placer_opts.place_incremental_file.empty();
+    vtr::vector<ClusterBlockId, t_pl_loc> prev_block_locs;
+    if (incremental) {
+        prev_block_locs = read_place_locations(placer_opts.place_incremental_file.c_str(), device_ctx.grid);
+    }
+
+    /* A placement snapshot is written at every temperature, so that an interrupted *
+     * anneal can resume from the placement and temperature where it stopped.      */
+    bool snapshot = !placer_opts.place_snapshot_file.empty();
+    if (snapshot && (incremental || placer_opts.place_num_starts > 1)) {
+        VTR_LOG_WARN("--place_snapshot_file is not supported with --place_incremental or --place_num_starts: no snapshot is written\n");
+        snapshot = false;
+    }
+    bool resume = snapshot && vtr::file_exists(placer_opts.place_snapshot_file.c_str());
+    t_place_snapshot_anneal_state resume_state;
+    if (resume) {
+        VTR_LOG("Resuming placement from snapshot %s.\n", placer_opts.place_snapshot_file.c_str());
+        prev_block_locs = read_place_snapshot(placer_opts.place_snapshot_file.c_str(), device_ctx.grid, resume_state);
+    }
+
+    initial_placement(placer_opts.pad_loc_type, placer_opts.constraints_file.c_str(), noc_opts.noc,
+                      (incremental || resume) ? &prev_block_locs : nullptr);
+
+    std::vector<ClusterBlockId> eco_fixed_blocks;
+    if (incremental) {
+        eco_fixed_blocks = fix_blocks_outside_eco_region(prev_block_locs, placer_opts.place_incremental_radius);
+    }
 
 #ifdef ENABLE_ANALYTIC_PLACE
     /*
@@ -564,6 +796,8 @@ void try_place(const Netlist<>& net_list,
         place_sync_external_block_connections(block_id);
     }
 
+    init_net_sink_coord_sums();
+
     init_draw_coords((float)width_fac);
 
     /* Allocated here because it goes into timing critical code where each memory allocation is expensive */
@@ -765,6 +999,9 @@ void try_place(const Netlist<>& net_list,
     move_type_stat.blk_type_moves.resize(device_ctx.logical_block_types.size() * placer_opts.place_static_move_prob.size(), 0);
     move_type_stat.accepted_moves.resize(device_ctx.logical_block_types.size() * placer_opts.place_static_move_prob.size(), 0);
     move_type_stat.rejected_moves.resize(device_ctx.logical_block_types.size() * placer_opts.place_static_move_prob.size(), 0);
+    if (placer_opts.move_timing_stats) {
+        move_type_stat.move_timing.resize(placer_opts.place_static_move_prob.size());
+    }
 
     /* Get the first range limiter */
     first_rlim = (float)max(device_ctx.grid.width() - 1,
@@ -781,12 +1018,17 @@ void try_place(const Netlist<>& net_list,
                             first_crit_exponent,
                             device_ctx.grid.get_num_layers());
 
-    /* Update the starting temperature for placement annealing to a more appropriate value */
-    state.t = starting_t(&state, &costs, annealing_sched,
-                         place_delay_model.get(), placer_criticalities.get(),
-                         placer_setup_slacks.get(), timing_info.get(), *move_generator,
-                         *manual_move_generator, pin_timing_invalidator.get(),
-                         blocks_affected, placer_opts, noc_opts, move_type_stat);
+    /* Update the starting temperature for placement annealing to a more appropriate value *
+     * (incremental placement only runs the quench, so it needs no starting temperature)  */
+    if (resume) {
+        restore_snapshot_anneal_state(state, resume_state);
+    } else if (!incremental) {
+        state.t = starting_t(&state, &costs, annealing_sched,
+                             place_delay_model.get(), placer_criticalities.get(),
+                             placer_setup_slacks.get(), timing_info.get(), *move_generator,
+                             *manual_move_generator, pin_timing_invalidator.get(),
+                             blocks_affected, placer_opts, noc_opts, move_type_stat);
+    }
 
     if (!placer_opts.move_stats_file.empty()) {
         f_move_stats_file = std::unique_ptr<FILE, decltype(&vtr::fclose)>(
@@ -807,6 +1049,9 @@ void try_place(const Netlist<>& net_list,
         skip_anneal = true;
 #endif /* ENABLE_ANALYTIC_PLACE */
 
+    if (incremental)
+        skip_anneal = true;
+
     //RL agent state definition
     e_agent_state agent_state = EARLY_IN_THE_ANNEAL;
 
@@ -820,10 +1065,16 @@ void try_place(const Netlist<>& net_list,
         VTR_LOG("\n");
         print_place_status_header();
 
+        float temperature_sec = 0.;
+
         /* Outer loop of the simulated annealing begins */
         do {
             vtr::Timer temperature_timer;
 
+            if (snapshot) {
+                write_place_snapshot(placer_opts.place_snapshot_file.c_str(), get_snapshot_anneal_state(state));
+            }
+
             outer_loop_update_timing_info(placer_opts, noc_opts, &costs, num_connections,
                                           state.crit_exponent, &outer_crit_iter_count,
                                           place_delay_model.get(), placer_criticalities.get(),
@@ -866,7 +1117,8 @@ void try_place(const Netlist<>& net_list,
             tot_iter += state.move_lim;
             ++state.num_temps;
 
-            print_place_status(state, stats, temperature_timer.elapsed_sec(),
+            temperature_sec = temperature_timer.elapsed_sec();
+            print_place_status(state, stats, temperature_sec,
                                critical_path.delay(), sTNS, sWNS, tot_iter);
 
             if (placer_opts.place_algorithm.is_timing_driven()
@@ -889,13 +1141,22 @@ void try_place(const Netlist<>& net_list,
             //            }
             //#endif
         } while (state.outer_loop_update(stats.success_rate, costs, placer_opts,
-                                         annealing_sched));
+                                         annealing_sched, temperature_sec, timer.elapsed_sec()));
         /* Outer loop of the simmulated annealing ends */
+
+        //The anneal completed, so there is nothing left to resume
+        if (snapshot) {
+            std::remove(placer_opts.place_snapshot_file.c_str());
+        }
     } //skip_anneal ends
 
     /* Start Quench */
     state.t = 0;                         //Freeze out: only accept solutions that improve placement.
-    state.move_lim = state.move_lim_max; //Revert the move limit to initial value.
+    state.move_lim = state.quench_move_lim(annealing_sched, timer.elapsed_sec()); //Revert the move limit to initial value (unless out of time).
+    if (incremental) {
+        //Keep the moves within the neighbourhood of the changed blocks
+        state.rlim = std::min<float>(state.rlim, std::max(placer_opts.place_incremental_radius, 1));
+    }
 
     auto pre_quench_timing_stats = timing_ctx.stats;
     { /* Quench */
@@ -982,6 +1243,11 @@ void try_place(const Netlist<>& net_list,
         place_sync_external_block_connections(block_id);
     }
 
+    //Release the blocks that were only fixed for incremental placement
+    for (ClusterBlockId blk_id : eco_fixed_blocks) {
+        g_vpr_ctx.mutable_placement().block_locs[blk_id].is_fixed = false;
+    }
+
     check_place(costs, place_delay_model.get(), placer_criticalities.get(),
                 placer_opts.place_algorithm, noc_opts);
 
@@ -1038,6 +1304,8 @@ void try_place(const Netlist<>& net_list,
 
     print_placement_move_types_stats(move_type_stat);
 
+    print_placement_move_timing_stats(move_type_stat);
+
     if (noc_opts.noc) {
         write_noc_placement_file(noc_opts.noc_placement_file_name);
     }
@@ -1055,6 +1323,13 @@ void try_place(const Netlist<>& net_list,
             p_runtime_ctx.f_update_td_costs_nets_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_sum_nets_elapsed_sec,
             p_runtime_ctx.f_update_td_costs_total_elapsed_sec);
+
+    t_placement_start_result result;
+    result.bb_cost = costs.bb_cost;
+    if (placer_opts.place_algorithm.is_timing_driven()) {
+        result.cpd = critical_path.delay();
+    }
+    return result;
 }
 
 /* Function to update the setup slacks and criticalities before the inner loop of the annealing/quench */
@@ -1116,6 +1391,15 @@ static void placement_inner_loop(const t_annealing_state* state,
                                  const t_place_algorithm& place_algorithm,
                                  MoveTypeStat& move_type_stat,
                                  float timing_bb_factor) {
+    if (use_batched_moves(placer_opts, noc_opts, place_algorithm)) {
+        placement_batched_inner_loop(state, placer_opts, noc_opts, inner_recompute_limit,
+                                     stats, costs, moves_since_cost_recompute,
+                                     pin_timing_invalidator, delay_model, criticalities, setup_slacks,
+                                     move_generator, blocks_affected, timing_info,
+                                     place_algorithm, move_type_stat, timing_bb_factor);
+        return;
+    }
+
     int inner_crit_iter_count, inner_iter;
 
     int inner_placement_save_count = 0; //How many times have we dumped placement to a file this temperature?
@@ -1124,6 +1408,9 @@ static void placement_inner_loop(const t_annealing_state* state,
 
     inner_crit_iter_count = 1;
 
+    //Moves accepted since the last timing update (see --inner_loop_recompute_accepted_moves)
+    int accepted_since_timing_update = 0;
+
     bool manual_move_enabled = false;
 
     /* Inner loop begins */
@@ -1137,6 +1424,7 @@ static void placement_inner_loop(const t_annealing_state* state,
             /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
             stats->single_swap_update(*costs);
             num_swap_accepted++;
+            accepted_since_timing_update++;
         } else if (swap_result == ABORTED) {
             num_swap_aborted++;
         } else { // swap_result == REJECTED
@@ -1147,10 +1435,12 @@ static void placement_inner_loop(const t_annealing_state* state,
             /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
              * We do this only once in a while, since it is expensive.
              */
-            if (inner_crit_iter_count >= inner_recompute_limit
+            if ((inner_crit_iter_count >= inner_recompute_limit
+                 || accepted_moves_timing_update_due(placer_opts, accepted_since_timing_update))
                 && inner_iter != state->move_lim - 1) { /*on last iteration don't recompute */
 
                 inner_crit_iter_count = 0;
+                accepted_since_timing_update = 0;
 #ifdef VERBOSE
                 VTR_LOG("Inner loop recompute criticalities\n");
 #endif
@@ -1207,6 +1497,117 @@ static void placement_inner_loop(const t_annealing_state* state,
     stats->calc_iteration_stats(*costs, state->move_lim);
 }
 
+/* Whether enough moves have been accepted since the last timing update to run another one
+ * (see --inner_loop_recompute_accepted_moves). The update is incremental: the pin timing
+ * invalidator has recorded the connections changed by those moves, so STA and the
+ * criticality update only revisit their fan-out cones. */
+static bool accepted_moves_timing_update_due(const t_placer_opts& placer_opts,
+                                             int accepted_since_timing_update) {
+    return placer_opts.inner_loop_recompute_accepted_moves > 0
+           && accepted_since_timing_update >= placer_opts.inner_loop_recompute_accepted_moves;
+}
+
+/* Whether the inner loop proposes and evaluates moves in batches (see try_swap_batch()).
+ * The RL agent learns from the outcome of each move before proposing the next one, and
+ * the NoC and setup slack costs are not per-net, so these fall back to one move at a time. */
+static bool use_batched_moves(const t_placer_opts& placer_opts,
+                              const t_noc_opts& noc_opts,
+                              const t_place_algorithm& place_algorithm) {
+    return placer_opts.place_parallel_moves > 1
+           && !placer_opts.RL_agent_placement
+           && !noc_opts.noc
+           && place_algorithm != SLACK_TIMING_PLACE;
+}
+
+/* Same as placement_inner_loop(), but proposes up to placer_opts.place_parallel_moves *
+ * moves at a time with try_swap_batch(). Timing and cost recomputations are done      *
+ * between batches.                                                                    */
+static void placement_batched_inner_loop(const t_annealing_state* state,
+                                         const t_placer_opts& placer_opts,
+                                         const t_noc_opts& noc_opts,
+                                         int inner_recompute_limit,
+                                         t_placer_statistics* stats,
+                                         t_placer_costs* costs,
+                                         int* moves_since_cost_recompute,
+                                         NetPinTimingInvalidator* pin_timing_invalidator,
+                                         const PlaceDelayModel* delay_model,
+                                         PlacerCriticalities* criticalities,
+                                         PlacerSetupSlacks* setup_slacks,
+                                         MoveGenerator& move_generator,
+                                         t_pl_blocks_to_be_moved& blocks_affected,
+                                         SetupTimingInfo* timing_info,
+                                         const t_place_algorithm& place_algorithm,
+                                         MoveTypeStat& move_type_stat,
+                                         float timing_bb_factor) {
+    int inner_crit_iter_count = 0;
+    int accepted_since_timing_update = 0;
+    int inner_placement_save_count = 0; //How many times have we dumped placement to a file this temperature?
+
+    stats->reset();
+
+    std::vector<t_batched_move> batch(placer_opts.place_parallel_moves,
+                                      t_batched_move(blocks_affected.moved_blocks.size()));
+
+    /* Inner loop begins */
+    for (int inner_iter = 0; inner_iter < state->move_lim;) {
+        int num_moves = std::min(placer_opts.place_parallel_moves, state->move_lim - inner_iter);
+
+        int prev_success_sum = stats->success_sum;
+        try_swap_batch(state, costs, stats, move_generator, timing_info, pin_timing_invalidator,
+                       batch, num_moves, delay_model, criticalities,
+                       placer_opts, move_type_stat, place_algorithm, timing_bb_factor);
+        accepted_since_timing_update += stats->success_sum - prev_success_sum;
+
+        int prev_inner_iter = inner_iter;
+        inner_iter += num_moves;
+
+        if (place_algorithm.is_timing_driven()) {
+            /* Re-timing analyze the circuit once in a while (every inner_recompute_limit moves) */
+            inner_crit_iter_count += num_moves;
+            if ((inner_crit_iter_count >= inner_recompute_limit
+                 || accepted_moves_timing_update_due(placer_opts, accepted_since_timing_update))
+                && inner_iter < state->move_lim) { /*after the last batch don't recompute */
+
+                inner_crit_iter_count = 0;
+                accepted_since_timing_update = 0;
+
+                PlaceCritParams crit_params;
+                crit_params.crit_exponent = state->crit_exponent;
+                crit_params.crit_limit = placer_opts.place_crit_limit;
+
+                //Update all timing related classes
+                perform_full_timing_update(crit_params, delay_model,
+                                           criticalities, setup_slacks, pin_timing_invalidator,
+                                           timing_info, costs);
+            }
+        }
+
+        /* Prevent round-off error from accumulating in the incrementally updated costs */
+        *moves_since_cost_recompute += num_moves;
+        if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
+            recompute_costs_from_scratch(placer_opts, noc_opts, delay_model,
+                                         criticalities, costs);
+            *moves_since_cost_recompute = 0;
+        }
+
+        if (placer_opts.placement_saves_per_temperature >= 1) {
+            int save_interval = state->move_lim / placer_opts.placement_saves_per_temperature;
+            if (save_interval > 0 && prev_inner_iter / save_interval != inner_iter / save_interval) {
+                std::string filename = vtr::string_fmt("placement_%03d_%03d.place",
+                                                       state->num_temps + 1, inner_placement_save_count);
+                VTR_LOG(
+                    "Saving placement to file at temperature move %d / %d: %s\n",
+                    inner_iter - 1, state->move_lim, filename.c_str());
+                print_place(nullptr, nullptr, filename.c_str());
+                ++inner_placement_save_count;
+            }
+        }
+    }
+
+    /* Calculate the success_rate and std_dev of the costs. */
+    stats->calc_iteration_stats(*costs, state->move_lim);
+}
+
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts,
                                          const t_noc_opts& noc_opts,
                                          const PlaceDelayModel* delay_model,
@@ -1306,33 +1707,54 @@ static float starting_t(const t_annealing_state* state, t_placer_costs* costs, t
     int move_lim = std::min(state->move_lim_max,
                             (int)cluster_ctx.clb_nlist.blocks().size());
 
-    bool manual_move_enabled = false;
+    if (use_batched_moves(placer_opts, noc_opts, placer_opts.place_algorithm)) {
+        /* Sample batches of disjoint moves, whose cost changes are evaluated in parallel *
+         * before any of them is committed (see try_swap_batch()).                      */
+        t_placer_statistics stats;
+        std::vector<t_batched_move> batch(placer_opts.place_parallel_moves,
+                                          t_batched_move(blocks_affected.moved_blocks.size()));
+
+        for (int imove = 0; imove < move_lim;) {
+            int num_moves = std::min(placer_opts.place_parallel_moves, move_lim - imove);
+            try_swap_batch(state, costs, &stats, move_generator, timing_info, pin_timing_invalidator,
+                           batch, num_moves, delay_model, criticalities,
+                           placer_opts, move_type_stat, placer_opts.place_algorithm,
+                           REWARD_BB_TIMING_RELATIVE_WEIGHT);
+            imove += num_moves;
+        }
 
-    for (int i = 0; i < move_lim; i++) {
+        num_accepted = stats.success_sum;
+        av = stats.av_cost;
+        sum_of_squares = stats.sum_of_squares;
+    } else {
+        bool manual_move_enabled = false;
+
+        for (int i = 0; i < move_lim; i++) {
 #ifndef NO_GRAPHICS
-        //Checks manual move flag for manual move feature
-        t_draw_state* draw_state = get_draw_state_vars();
-        if (draw_state->show_graphics) {
-            manual_move_enabled = manual_move_is_selected();
-        }
+            //Checks manual move flag for manual move feature
+            t_draw_state* draw_state = get_draw_state_vars();
+            if (draw_state->show_graphics) {
+                manual_move_enabled = manual_move_is_selected();
+            }
 #endif /*NO_GRAPHICS*/
 
-        //Will not deploy setup slack analysis, so omit crit_exponenet and setup_slack
-        e_move_result swap_result = try_swap(state, costs, move_generator,
-                                             manual_move_generator, timing_info, pin_timing_invalidator,
-                                             blocks_affected, delay_model, criticalities, setup_slacks,
-                                             placer_opts, noc_opts, move_type_stat, placer_opts.place_algorithm,
-                                             REWARD_BB_TIMING_RELATIVE_WEIGHT, manual_move_enabled);
-
-        if (swap_result == ACCEPTED) {
-            num_accepted++;
-            av += costs->cost;
-            sum_of_squares += costs->cost * costs->cost;
-            num_swap_accepted++;
-        } else if (swap_result == ABORTED) {
-            num_swap_aborted++;
-        } else {
-            num_swap_rejected++;
+            //Will not deploy setup slack analysis, so omit crit_exponenet and setup_slack
+            e_move_result swap_result = try_swap(state, costs, move_generator,
+                                                 manual_move_generator, timing_info, pin_timing_invalidator,
+                                                 blocks_affected, delay_model, criticalities, setup_slacks,
+                                                 placer_opts, noc_opts, move_type_stat, placer_opts.place_algorithm,
+                                                 REWARD_BB_TIMING_RELATIVE_WEIGHT, manual_move_enabled);
+
+            if (swap_result == ACCEPTED) {
+                num_accepted++;
+                av += costs->cost;
+                sum_of_squares += costs->cost * costs->cost;
+                num_swap_accepted++;
+            } else if (swap_result == ABORTED) {
+                num_swap_aborted++;
+            } else {
+                num_swap_rejected++;
+            }
         }
     }
 
@@ -1367,15 +1789,12 @@ static float starting_t(const t_annealing_state* state, t_placer_costs* costs, t
     return init_temp;
 }
 
-static void update_move_nets(int num_nets_affected) {
+static void update_move_nets(const std::vector<ClusterNetId>& nets_to_update) {
     /* update net cost functions and reset flags. */
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_move_ctx = g_placer_ctx.mutable_move();
 
-    for (int inet_affected = 0; inet_affected < num_nets_affected;
-         inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
-
+    for (ClusterNetId net_id : nets_to_update) {
         place_move_ctx.bb_coords[net_id] = ts_bb_coord_new[net_id];
         if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET)
             place_move_ctx.bb_num_on_edges[net_id] = ts_bb_edge_new[net_id];
@@ -1388,11 +1807,9 @@ static void update_move_nets(int num_nets_affected) {
     }
 }
 
-static void reset_move_nets(int num_nets_affected) {
+static void reset_move_nets(const std::vector<ClusterNetId>& nets_to_update) {
     /* Reset the net cost function flags first. */
-    for (int inet_affected = 0; inet_affected < num_nets_affected;
-         inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+    for (ClusterNetId net_id : nets_to_update) {
         proposed_net_cost[net_id] = -1;
         bb_updated_before[net_id] = NOT_UPDATED_YET;
     }
@@ -1475,6 +1892,14 @@ static e_move_result try_swap(const t_annealing_state* state,
 
     e_create_move create_move_outcome = e_create_move::ABORT;
 
+    //Manual moves wait for the user, so they are not timed
+    MoveTypeTiming* move_timing = nullptr;
+    std::chrono::steady_clock::time_point phase_start;
+    bool time_move = !move_type_stat.move_timing.empty() && !manual_move_enabled;
+    if (time_move) {
+        phase_start = std::chrono::steady_clock::now();
+    }
+
     //When manual move toggle button is active, the manual move window asks the user for input.
     if (manual_move_enabled) {
 #ifndef NO_GRAPHICS
@@ -1494,6 +1919,12 @@ static e_move_result try_swap(const t_annealing_state* state,
     }
     LOG_MOVE_STATS_PROPOSED(t, blocks_affected);
 
+    if (time_move) {
+        move_timing = &move_type_stat.move_timing[(int)proposed_action.move_type];
+        ++move_timing->num_moves;
+        move_timing->propose_time += end_move_phase(phase_start);
+    }
+
     e_move_result move_outcome = e_move_result::ABORTED;
 
     if (create_move_outcome == e_create_move::ABORT) {
@@ -1527,9 +1958,9 @@ static e_move_result try_swap(const t_annealing_state* state,
         //
         //Also find all the pins affected by the swap, and calculates new connection
         //delays and timing costs and store them in proposed_* data structures.
-        int num_nets_affected = find_affected_nets_and_update_costs(
+        find_affected_nets_and_update_costs(
             place_algorithm, delay_model, criticalities, blocks_affected,
-            bb_delta_c, timing_delta_c);
+            bb_delta_c, timing_delta_c, ts_nets_to_update);
 
         //For setup slack analysis, we first do a timing analysis to get the newest
         //slack values resulted from the proposed block moves. If the move turns out
@@ -1581,6 +2012,11 @@ static e_move_result try_swap(const t_annealing_state* state,
             delta_c = delta_c + noc_placement_weighting * (noc_latency_delta_c * costs->noc_latency_cost_norm + noc_aggregate_bandwidth_delta_c * costs->noc_aggregate_bandwidth_cost_norm);
         }
 
+        if (time_move) {
+            ++move_timing->num_evaluated;
+            move_timing->evaluate_time += end_move_phase(phase_start);
+        }
+
         /* 1 -> move accepted, 0 -> rejected. */
         move_outcome = assess_swap(delta_c, state->t);
 
@@ -1619,7 +2055,7 @@ static e_move_result try_swap(const t_annealing_state* state,
             }
 
             /* Update net cost functions and reset flags. */
-            update_move_nets(num_nets_affected);
+            update_move_nets(ts_nets_to_update);
 
             /* Update clb data structures since we kept the move. */
             commit_move_blocks(blocks_affected);
@@ -1634,6 +2070,11 @@ static e_move_result try_swap(const t_annealing_state* state,
                 costs->noc_latency_cost += noc_latency_delta_c;
             }
 
+            if (time_move) {
+                ++move_timing->num_accepted;
+                move_timing->commit_time += end_move_phase(phase_start);
+            }
+
             //Highlights the new block when manual move is selected.
 #ifndef NO_GRAPHICS
             if (manual_move_enabled) {
@@ -1645,10 +2086,11 @@ static e_move_result try_swap(const t_annealing_state* state,
             VTR_ASSERT_SAFE(move_outcome == REJECTED);
 
             /* Reset the net cost function flags first. */
-            reset_move_nets(num_nets_affected);
+            reset_move_nets(ts_nets_to_update);
 
             /* Restore the place_ctx.block_locs data structures to their state before the move. */
             revert_move_blocks(blocks_affected);
+            revert_net_bb_histograms(blocks_affected);
 
             if (place_algorithm == SLACK_TIMING_PLACE) {
                 /* Revert the timing delays and costs to pre-update values.       */
@@ -1684,6 +2126,10 @@ static e_move_result try_swap(const t_annealing_state* state,
             if (noc_opts.noc) {
                 revert_noc_traffic_flow_routes(blocks_affected);
             }
+
+            if (time_move) {
+                move_timing->revert_time += end_move_phase(phase_start);
+            }
         }
 
         move_outcome_stats.delta_cost_norm = delta_c;
@@ -1728,6 +2174,210 @@ static e_move_result try_swap(const t_annealing_state* state,
     return move_outcome;
 }
 
+/**
+ * @brief Proposes num_moves moves and evaluates them together.
+ *
+ * The moves are proposed one after another from the current placement.
+ * A move which touches a block, location or net already touched by an
+ * earlier move of the batch is aborted. The remaining moves therefore
+ * change the bounding box and timing costs of disjoint sets of nets, so
+ * they are applied and their cost changes are evaluated in parallel.
+ * Finally each move is accepted or rejected in the order it was proposed,
+ * which is equivalent to evaluating the moves one after another.
+ *
+ * The outcome of the batch does not depend on the number of threads.
+ */
+static void try_swap_batch(const t_annealing_state* state,
+                           t_placer_costs* costs,
+                           t_placer_statistics* stats,
+                           MoveGenerator& move_generator,
+                           SetupTimingInfo* timing_info,
+                           NetPinTimingInvalidator* pin_timing_invalidator,
+                           std::vector<t_batched_move>& batch,
+                           int num_moves,
+                           const PlaceDelayModel* delay_model,
+                           const PlacerCriticalities* criticalities,
+                           const t_placer_opts& placer_opts,
+                           MoveTypeStat& move_type_stat,
+                           const t_place_algorithm& place_algorithm,
+                           float timing_bb_factor) {
+    VTR_ASSERT_SAFE(place_algorithm != SLACK_TIMING_PLACE);
+    VTR_ASSERT(num_moves <= (int)batch.size());
+
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    float rlim_escape_fraction = placer_opts.rlim_escape_fraction;
+    float timing_tradeoff = placer_opts.timing_tradeoff;
+
+    //Blocks, locations and nets touched by the moves of this batch so far
+    std::unordered_set<ClusterBlockId> batch_blocks;
+    std::unordered_set<t_pl_loc> batch_locs;
+    std::unordered_set<ClusterNetId> batch_nets;
+
+    auto conflicts_with_batch = [&](const t_pl_blocks_to_be_moved& blocks_affected) {
+        for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+            const t_pl_moved_block& moved_block = blocks_affected.moved_blocks[iblk];
+            if (batch_blocks.count(moved_block.block_num)
+                || batch_locs.count(moved_block.old_loc)
+                || batch_locs.count(moved_block.new_loc)) {
+                return true;
+            }
+            for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(moved_block.block_num)) {
+                ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+                if (!cluster_ctx.clb_nlist.net_is_ignored(net_id) && batch_nets.count(net_id)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    auto add_to_batch = [&](const t_pl_blocks_to_be_moved& blocks_affected) {
+        for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+            const t_pl_moved_block& moved_block = blocks_affected.moved_blocks[iblk];
+            batch_blocks.insert(moved_block.block_num);
+            batch_locs.insert(moved_block.old_loc);
+            batch_locs.insert(moved_block.new_loc);
+            for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(moved_block.block_num)) {
+                ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+                if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+                    batch_nets.insert(net_id);
+                }
+            }
+        }
+    };
+
+    /* Propose the moves */
+    std::vector<t_batched_move*> valid_moves;
+    for (int imove = 0; imove < num_moves; imove++) {
+        t_batched_move& move = batch[imove];
+
+        num_ts_called++;
+
+        /* Allow some fraction of moves to not be restricted by rlim, */
+        /* in the hopes of better escaping local minima.              */
+        float rlim;
+        if (rlim_escape_fraction > 0. && vtr::frand() < rlim_escape_fraction) {
+            rlim = std::numeric_limits<float>::infinity();
+        } else {
+            rlim = state->rlim;
+        }
+
+        move.proposed_action = {e_move_type::UNIFORM, -1};
+        e_create_move create_move_outcome = move_generator.propose_move(move.blocks_affected, move.proposed_action, rlim, placer_opts, criticalities);
+
+        if (move.proposed_action.logical_blk_type_index != -1) { //if the agent proposed the block type, then collect the block type stat
+            ++move_type_stat.blk_type_moves[(move.proposed_action.logical_blk_type_index * (placer_opts.place_static_move_prob.size())) + (int)move.proposed_action.move_type];
+        }
+
+        if (create_move_outcome == e_create_move::VALID && conflicts_with_batch(move.blocks_affected)) {
+            log_move_abort("conflicting move in batch");
+            create_move_outcome = e_create_move::ABORT;
+        }
+
+        if (create_move_outcome == e_create_move::ABORT) {
+            num_swap_aborted++;
+
+            MoveOutcomeStats move_outcome_stats;
+            move_outcome_stats.outcome = ABORTED;
+            calculate_reward_and_process_outcome(placer_opts, move_outcome_stats,
+                                                 0., timing_bb_factor, move_generator);
+
+            clear_move_blocks(move.blocks_affected);
+            continue;
+        }
+
+        add_to_batch(move.blocks_affected);
+        valid_moves.push_back(&move);
+    }
+
+    /* Apply the moves and find the cost changes of their (disjoint) affected nets */
+    auto evaluate_move = [&](t_batched_move* move) {
+        apply_move_blocks(move->blocks_affected);
+
+        move->bb_delta_c = 0.;
+        move->timing_delta_c = 0.;
+        find_affected_nets_and_update_costs(
+            place_algorithm, delay_model, criticalities, move->blocks_affected,
+            move->bb_delta_c, move->timing_delta_c, move->nets_to_update);
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for_each(valid_moves.begin(), valid_moves.end(), evaluate_move);
+#else
+    for (t_batched_move* move : valid_moves) {
+        evaluate_move(move);
+    }
+#endif
+
+    /* Accept or reject the moves in the order they were proposed */
+    for (t_batched_move* move : valid_moves) {
+        double delta_c;
+        if (place_algorithm == CRITICALITY_TIMING_PLACE) {
+            delta_c = (1 - timing_tradeoff) * move->bb_delta_c * costs->bb_cost_norm
+                      + timing_tradeoff * move->timing_delta_c
+                            * costs->timing_cost_norm;
+        } else {
+            VTR_ASSERT_SAFE(place_algorithm == BOUNDING_BOX_PLACE);
+            delta_c = move->bb_delta_c * costs->bb_cost_norm;
+        }
+
+        e_move_result move_outcome = assess_swap(delta_c, state->t);
+
+        if (move_outcome == ACCEPTED) {
+            costs->cost += delta_c;
+            costs->bb_cost += move->bb_delta_c;
+
+            if (place_algorithm == CRITICALITY_TIMING_PLACE) {
+                costs->timing_cost += move->timing_delta_c;
+
+                invalidate_affected_connections(move->blocks_affected,
+                                                pin_timing_invalidator, timing_info);
+                commit_td_cost(move->blocks_affected);
+            }
+
+            update_move_nets(move->nets_to_update);
+            commit_move_blocks(move->blocks_affected);
+
+            if (move->proposed_action.logical_blk_type_index != -1) {
+                ++move_type_stat.accepted_moves[(move->proposed_action.logical_blk_type_index * (placer_opts.place_static_move_prob.size())) + (int)move->proposed_action.move_type];
+            }
+
+            stats->single_swap_update(*costs);
+            num_swap_accepted++;
+        } else {
+            VTR_ASSERT_SAFE(move_outcome == REJECTED);
+
+            reset_move_nets(move->nets_to_update);
+            revert_move_blocks(move->blocks_affected);
+            revert_net_bb_histograms(move->blocks_affected);
+
+            if (place_algorithm == CRITICALITY_TIMING_PLACE) {
+                revert_td_cost(move->blocks_affected);
+            }
+
+            if (move->proposed_action.logical_blk_type_index != -1) {
+                ++move_type_stat.rejected_moves[(move->proposed_action.logical_blk_type_index * (placer_opts.place_static_move_prob.size())) + (int)move->proposed_action.move_type];
+            }
+
+            num_swap_rejected++;
+        }
+
+        MoveOutcomeStats move_outcome_stats;
+        move_outcome_stats.delta_cost_norm = delta_c;
+        move_outcome_stats.delta_bb_cost_norm = move->bb_delta_c * costs->bb_cost_norm;
+        move_outcome_stats.delta_timing_cost_norm = move->timing_delta_c * costs->timing_cost_norm;
+        move_outcome_stats.delta_bb_cost_abs = move->bb_delta_c;
+        move_outcome_stats.delta_timing_cost_abs = move->timing_delta_c;
+        move_outcome_stats.outcome = move_outcome;
+
+        calculate_reward_and_process_outcome(placer_opts, move_outcome_stats,
+                                             delta_c, timing_bb_factor, move_generator);
+
+        clear_move_blocks(move->blocks_affected);
+    }
+}
+
 /**
  * @brief Find all the nets and pins affected by this swap and update costs.
  *
@@ -1747,6 +2397,7 @@ static e_move_result try_swap(const t_annealing_state* state,
  *
  * The change in the bounding box cost is stored in `bb_delta_c`.
  * The change in the timing cost is stored in `timing_delta_c`.
+ * The affected nets are stored in `nets_to_update`.
  *
  * @return The number of affected nets.
  */
@@ -1756,20 +2407,21 @@ static int find_affected_nets_and_update_costs(
     const PlacerCriticalities* criticalities,
     t_pl_blocks_to_be_moved& blocks_affected,
     double& bb_delta_c,
-    double& timing_delta_c) {
+    double& timing_delta_c,
+    std::vector<ClusterNetId>& nets_to_update) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
     VTR_ASSERT_SAFE(timing_delta_c == 0.);
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    int num_affected_nets = 0;
+    nets_to_update.clear();
 
     /* Go through all the blocks moved. */
     for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
         ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
 
         /* Go through all the pins in the moved block. */
-        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(blk)) {
-            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+        for (ClusterPinId blk_pin : clb_nlist_view.block_pins(blk)) {
+            ClusterNetId net_id = clb_nlist_view.pin_net(blk_pin);
             VTR_ASSERT_SAFE_MSG(net_id,
                                 "Only valid nets should be found in compressed netlist block pins");
 
@@ -1779,7 +2431,7 @@ static int find_affected_nets_and_update_costs(
                 continue;
 
             /* Record effected nets */
-            record_affected_net(net_id, num_affected_nets);
+            record_affected_net(net_id, nets_to_update);
 
             /* Update the net bounding boxes. */
             update_net_bb(net_id, blocks_affected, iblk, blk, blk_pin);
@@ -1794,26 +2446,22 @@ static int find_affected_nets_and_update_costs(
 
     /* Now update the bounding box costs (since the net bounding     *
      * boxes are up-to-date). The cost is only updated once per net. */
-    for (int inet_affected = 0; inet_affected < num_affected_nets;
-         inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
-
+    for (ClusterNetId net_id : nets_to_update) {
         proposed_net_cost[net_id] = get_net_cost(net_id,
                                                  &ts_bb_coord_new[net_id]);
         bb_delta_c += proposed_net_cost[net_id] - net_cost[net_id];
     }
 
-    return num_affected_nets;
+    return nets_to_update.size();
 }
 
 ///@brief Record effected nets.
 static void record_affected_net(const ClusterNetId net,
-                                int& num_affected_nets) {
+                                std::vector<ClusterNetId>& nets_to_update) {
     /* Record effected nets. */
     if (proposed_net_cost[net] < 0.) {
         /* Net not marked yet. */
-        ts_nets_to_update[num_affected_nets] = net;
-        num_affected_nets++;
+        nets_to_update.push_back(net);
 
         /* Flag to say we've marked this net. */
         proposed_net_cost[net] = 1.;
@@ -1831,14 +2479,22 @@ static void update_net_bb(const ClusterNetId net,
                           int iblk,
                           const ClusterBlockId blk,
                           const ClusterPinId blk_pin) {
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-
-    if (cluster_ctx.clb_nlist.net_sinks(net).size() < SMALL_NET) {
+    if (clb_nlist_view.net_num_pins(net) - 1 < SMALL_NET) {
         //For small nets brute-force bounding box update is faster
 
         if (bb_updated_before[net] == NOT_UPDATED_YET) { //Only once per-net
             get_non_updateable_bb(net, &ts_bb_coord_new[net]);
         }
+    } else if (net_bb_histograms.has_net(net)) {
+        //For high fanout nets, update the pin histogram and rescan it for the new edges
+        int iblk_pin = tile_pin_index(blk_pin);
+
+        t_physical_tile_type_ptr blk_type = physical_tile_type(blk);
+
+        update_bb_from_histogram(net, clb_nlist_view.pin_net_index(blk_pin),
+                                 &ts_bb_coord_new[net], &ts_bb_edge_new[net],
+                                 blocks_affected.moved_blocks[iblk].new_loc.x + blk_type->pin_width_offset[iblk_pin],
+                                 blocks_affected.moved_blocks[iblk].new_loc.y + blk_type->pin_height_offset[iblk_pin]);
     } else {
         //For large nets, update bounding box incrementally
         int iblk_pin = tile_pin_index(blk_pin);
@@ -1902,11 +2558,14 @@ static void update_td_delta_costs(const PlaceDelayModel* delay_model,
 
     if (cluster_ctx.clb_nlist.pin_type(pin) == PinType::DRIVER) {
         /* This pin is a net driver on a moved block. */
-        /* Recompute all point to point connection delays for the net sinks. */
-        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net).size();
-             ipin++) {
-            float temp_delay = comp_td_single_connection_delay(delay_model, net,
-                                                               ipin);
+        /* Recompute all point to point connection delays for the net sinks *
+         * with one batched delay model query.                              */
+        static thread_local std::vector<float> net_delays;
+        comp_td_net_connection_delays(delay_model, net, net_delays);
+
+        size_t num_pins = clb_nlist_view.net_num_pins(net);
+        for (size_t ipin = 1; ipin < num_pins; ipin++) {
+            float temp_delay = net_delays[ipin];
             /* If the delay hasn't changed, do not mark this pin as affected */
             if (temp_delay == connection_delay[net][ipin]) {
                 continue;
@@ -1920,7 +2579,7 @@ static void update_td_delta_costs(const PlaceDelayModel* delay_model,
                                  - connection_timing_cost[net][ipin];
 
             /* Record this connection in blocks_affected.affected_pins */
-            ClusterPinId sink_pin = cluster_ctx.clb_nlist.net_pin(net, ipin);
+            ClusterPinId sink_pin = clb_nlist_view.net_pin(net, ipin);
             blocks_affected.affected_pins.push_back(sink_pin);
         }
     } else {
@@ -1930,7 +2589,7 @@ static void update_td_delta_costs(const PlaceDelayModel* delay_model,
         /* Check if this sink's net is driven by a moved block */
         if (!driven_by_moved_block(net, blocks_affected)) {
             /* Get the sink pin index in the net */
-            int ipin = cluster_ctx.clb_nlist.pin_net_index(pin);
+            int ipin = clb_nlist_view.pin_net_index(pin);
 
             float temp_delay = comp_td_single_connection_delay(delay_model, net,
                                                                ipin);
@@ -2183,10 +2842,7 @@ static void invalidate_affected_connections(
 //Returns true if 'net' is driven by one of the blocks in 'blocks_affected'
 static bool driven_by_moved_block(const ClusterNetId net,
                                   const t_pl_blocks_to_be_moved& blocks_affected) {
-    auto& cluster_ctx = g_vpr_ctx.clustering();
-
-    ClusterBlockId net_driver_block = cluster_ctx.clb_nlist.net_driver_block(
-        net);
+    ClusterBlockId net_driver_block = clb_nlist_view.net_driver_block(net);
     for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
         if (net_driver_block == blocks_affected.moved_blocks[iblk].block_num) {
             return true;
@@ -2209,8 +2865,26 @@ static double comp_bb_cost(e_cost_methods method) {
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_move_ctx = g_placer_ctx.mutable_move();
 
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {       /* for each net ... */
-        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
+    if (method == NORMAL) {
+        auto& grid = g_vpr_ctx.device().grid;
+        net_bb_histograms.init(cluster_ctx.clb_nlist.nets().size(), grid.width() - 1, grid.height() - 1);
+
+        /* The histograms share their storage, so they are loaded serially */
+        for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+            if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)
+                && cluster_ctx.clb_nlist.net_sinks(net_id).size() >= HISTOGRAM_BB_NET) {
+                load_net_bb_histogram(net_id);
+            }
+        }
+    }
+
+    /* The bounding box and cost of each net only depend on (and update) that net */
+    auto nets = cluster_ctx.clb_nlist.nets();
+    auto comp_net_bb_cost = [&](size_t begin, size_t end) {
+        for (size_t inet = begin; inet < end; inet++) {
+            ClusterNetId net_id = *(nets.begin() + inet);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) continue;
+
             /* Small nets don't use incremental updating on their bounding boxes, *
              * so they can use a fast bounding box calculator.                    */
             if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET
@@ -2224,6 +2898,20 @@ static double comp_bb_cost(e_cost_methods method) {
 
             net_cost[net_id] = get_net_cost(net_id,
                                             &place_move_ctx.bb_coords[net_id]);
+        }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nets.size()), [&](const tbb::blocked_range<size_t>& range) {
+        comp_net_bb_cost(range.begin(), range.end());
+    });
+#else
+    comp_net_bb_cost(0, nets.size());
+#endif
+
+    /* Sum in net order, so the cost does not depend on the number of threads */
+    for (auto net_id : nets) {                               /* for each net ... */
+        if (!cluster_ctx.clb_nlist.net_is_ignored(net_id)) { /* Do only if not ignored. */
             cost += net_cost[net_id];
             if (method == CHECK)
                 expected_wirelength += get_net_wirelength_estimate(net_id,
@@ -2299,6 +2987,8 @@ static void alloc_and_load_placement_structs(float place_cost_exp,
         }
     }
 
+    clb_nlist_view = ClusteredNetlistCsrView(cluster_ctx.clb_nlist);
+
     net_cost.resize(num_nets, -1.);
     proposed_net_cost.resize(num_nets, -1.);
     place_move_ctx.bb_coords.resize(num_nets, t_bb());
@@ -2338,10 +3028,15 @@ static void free_placement_structs(const t_placer_opts& placer_opts, const t_noc
 
     free_placement_macros_structs();
 
+    clb_nlist_view = ClusteredNetlistCsrView();
+
     vtr::release_memory(net_cost);
     vtr::release_memory(proposed_net_cost);
     vtr::release_memory(place_move_ctx.bb_coords);
     vtr::release_memory(place_move_ctx.bb_num_on_edges);
+    vtr::release_memory(place_move_ctx.net_sink_coord_sums);
+    vtr::release_memory(place_move_ctx.sink_pin_coords);
+    place_move_ctx.compressed_pr_grids.clear();
 
     vtr::release_memory(bb_updated_before);
 
@@ -2363,7 +3058,7 @@ static void alloc_and_load_try_swap_structs() {
 
     ts_bb_coord_new.resize(num_nets, t_bb());
     ts_bb_edge_new.resize(num_nets, t_bb());
-    ts_nets_to_update.resize(num_nets, ClusterNetId::INVALID());
+    ts_nets_to_update.reserve(num_nets);
 
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     place_ctx.compressed_block_grids = create_compressed_block_grids();
@@ -2373,11 +3068,60 @@ static void free_try_swap_structs() {
     vtr::release_memory(ts_bb_coord_new);
     vtr::release_memory(ts_bb_edge_new);
     vtr::release_memory(ts_nets_to_update);
+    net_bb_histograms.clear();
 
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     vtr::release_memory(place_ctx.compressed_block_grids);
 }
 
+static std::vector<ClusterBlockId> fix_blocks_outside_eco_region(const vtr::vector<ClusterBlockId, t_pl_loc>& prev_block_locs, int radius) {
+    /* Fixes every block that kept its previous location and is more than   *
+     * radius tiles (in x or y) away from all the blocks that did not, so    *
+     * that the placer only re-optimizes the neighbourhood of the new and    *
+     * changed blocks. Returns the blocks it fixed.                          */
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    vtr::NdMatrix<char, 3> in_eco_region({(size_t)grid.get_num_layers(), grid.width(), grid.height()}, false);
+
+    size_t num_changed = 0;
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        const t_pl_loc& loc = place_ctx.block_locs[blk_id].loc;
+        if (loc == prev_block_locs[blk_id]) {
+            continue;
+        }
+
+        ++num_changed;
+        for (int x = std::max(loc.x - radius, 0); x <= std::min<int>(loc.x + radius, grid.width() - 1); ++x) {
+            for (int y = std::max(loc.y - radius, 0); y <= std::min<int>(loc.y + radius, grid.height() - 1); ++y) {
+                in_eco_region[loc.layer][x][y] = true;
+            }
+        }
+    }
+
+    std::vector<ClusterBlockId> fixed_blocks;
+    size_t num_movable = 0;
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        t_block_loc& block_loc = place_ctx.block_locs[blk_id];
+        if (block_loc.is_fixed) {
+            continue;
+        }
+
+        if (in_eco_region[block_loc.loc.layer][block_loc.loc.x][block_loc.loc.y]) {
+            ++num_movable;
+        } else {
+            block_loc.is_fixed = true;
+            fixed_blocks.push_back(blk_id);
+        }
+    }
+
+    VTR_LOG("Incremental placement: %zu of %zu blocks are new or could not keep their previous location; %zu blocks are left movable\n",
+            num_changed, cluster_ctx.clb_nlist.blocks().size(), num_movable);
+
+    return fixed_blocks;
+}
+
 /* This routine finds the bounding box of each net from scratch (i.e.   *
  * from only the block location information).  It updates both the       *
  * coordinate and number of pins on each edge information.  It           *
@@ -2386,12 +3130,14 @@ static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_
     int pnum, x, y, xmin, xmax, ymin, ymax;
     int xmin_edge, xmax_edge, ymin_edge, ymax_edge;
 
-    auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
     auto& grid = device_ctx.grid;
 
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
+    auto net_pins = clb_nlist_view.net_pins(net_id);
+    auto net_pin_blocks = clb_nlist_view.net_pin_blocks(net_id);
+
+    ClusterBlockId bnum = net_pin_blocks[0];
     pnum = net_pin_to_tile_pin_index(net_id, 0);
     VTR_ASSERT(pnum >= 0);
     x = place_ctx.block_locs[bnum].loc.x
@@ -2411,9 +3157,9 @@ static void get_bb_from_scratch(ClusterNetId net_id, t_bb* coords, t_bb* num_on_
     xmax_edge = 1;
     ymax_edge = 1;
 
-    for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        pnum = tile_pin_index(pin_id);
+    for (size_t ipin = 1; ipin < net_pins.size(); ipin++) {
+        bnum = net_pin_blocks[ipin];
+        pnum = tile_pin_index(net_pins[ipin]);
         x = place_ctx.block_locs[bnum].loc.x
             + physical_tile_type(bnum)->pin_width_offset[pnum];
         y = place_ctx.block_locs[bnum].loc.y
@@ -2509,10 +3255,8 @@ static double get_net_cost(ClusterNetId net_id, t_bb* bbptr) {
      * box.                                                                 */
 
     double ncost, crossing;
-    auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    crossing = wirelength_crossing_count(
-        cluster_ctx.clb_nlist.net_pins(net_id).size());
+    crossing = wirelength_crossing_count(clb_nlist_view.net_num_pins(net_id));
 
     /* Could insert a check for xmin == xmax.  In that case, assume  *
      * connection will be made with no bends and hence no x-cost.    *
@@ -2543,11 +3287,13 @@ static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new) {
     int xmax, ymax, xmin, ymin, x, y;
     int pnum;
 
-    auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
     auto& device_ctx = g_vpr_ctx.device();
 
-    ClusterBlockId bnum = cluster_ctx.clb_nlist.net_driver_block(net_id);
+    auto net_pins = clb_nlist_view.net_pins(net_id);
+    auto net_pin_blocks = clb_nlist_view.net_pin_blocks(net_id);
+
+    ClusterBlockId bnum = net_pin_blocks[0];
     pnum = net_pin_to_tile_pin_index(net_id, 0);
 
     x = place_ctx.block_locs[bnum].loc.x
@@ -2560,9 +3306,9 @@ static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new) {
     xmax = x;
     ymax = y;
 
-    for (auto pin_id : cluster_ctx.clb_nlist.net_sinks(net_id)) {
-        bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
-        pnum = tile_pin_index(pin_id);
+    for (size_t ipin = 1; ipin < net_pins.size(); ipin++) {
+        bnum = net_pin_blocks[ipin];
+        pnum = tile_pin_index(net_pins[ipin]);
         x = place_ctx.block_locs[bnum].loc.x
             + physical_tile_type(bnum)->pin_width_offset[pnum];
         y = place_ctx.block_locs[bnum].loc.y
@@ -2595,6 +3341,94 @@ static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new) {
     bb_coord_new->ymax = max(min<int>(ymax, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
 }
 
+/* Returns the coordinate of a pin as seen by the bounding box routines, *
+ * i.e. clipped to the 1..grid.width()-2, 1..grid.height()-2 range.      */
+static void get_pin_bb_loc(ClusterPinId pin_id, int& x, int& y) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    ClusterBlockId bnum = cluster_ctx.clb_nlist.pin_block(pin_id);
+    int pnum = tile_pin_index(pin_id);
+    x = place_ctx.block_locs[bnum].loc.x
+        + physical_tile_type(bnum)->pin_width_offset[pnum];
+    y = place_ctx.block_locs[bnum].loc.y
+        + physical_tile_type(bnum)->pin_height_offset[pnum];
+
+    x = max(min<int>(x, grid.width() - 2), 1);  //-2 for no perim channels
+    y = max(min<int>(y, grid.height() - 2), 1); //-2 for no perim channels
+}
+
+/* Starts tracking the pin coordinate histogram of net_id, loaded from the *
+ * current block locations.                                                */
+static void load_net_bb_histogram(ClusterNetId net_id) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    net_bb_histograms.add_net(net_id, cluster_ctx.clb_nlist.net_pins(net_id).size());
+
+    for (auto pin_id : cluster_ctx.clb_nlist.net_pins(net_id)) {
+        int x, y;
+        get_pin_bb_loc(pin_id, x, y);
+        net_bb_histograms.set_pin_loc(net_id, cluster_ctx.clb_nlist.pin_net_index(pin_id), x, y);
+    }
+}
+
+/* Restores the pin histograms touched by a rejected move. Must be called *
+ * after the block moves have been reverted.                              */
+static void revert_net_bb_histograms(const t_pl_blocks_to_be_moved& blocks_affected) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        ClusterBlockId blk = blocks_affected.moved_blocks[iblk].block_num;
+
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(blk)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (net_id == ClusterNetId::INVALID() || !net_bb_histograms.has_net(net_id))
+                continue;
+
+            int x, y;
+            get_pin_bb_loc(blk_pin, x, y);
+            net_bb_histograms.set_pin_loc(net_id, cluster_ctx.clb_nlist.pin_net_index(blk_pin), x, y);
+        }
+    }
+}
+
+/* Updates the bounding box of a net tracked by net_bb_histograms after   *
+ * pin net_pin moved to (xnew, ynew). The histogram knows where the pin   *
+ * used to be, so edges left without pins are found by scanning inwards   *
+ * from the old edge, and the bounding box never has to be recomputed     *
+ * from scratch.                                                          */
+static void update_bb_from_histogram(ClusterNetId net_id, size_t net_pin, t_bb* bb_coord_new, t_bb* bb_edge_new, int xnew, int ynew) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& place_move_ctx = g_placer_ctx.move();
+
+    xnew = max(min<int>(xnew, device_ctx.grid.width() - 2), 1);  //-2 for no perim channels
+    ynew = max(min<int>(ynew, device_ctx.grid.height() - 2), 1); //-2 for no perim channels
+
+    t_bb bb;
+    if (bb_updated_before[net_id] == NOT_UPDATED_YET) {
+        bb = place_move_ctx.bb_coords[net_id];
+        bb_updated_before[net_id] = UPDATED_ONCE;
+    } else {
+        bb = *bb_coord_new;
+    }
+
+    net_bb_histograms.set_pin_loc(net_id, net_pin, xnew, ynew);
+
+    /* Grow towards the new location, then shrink any edge left empty. */
+    bb.xmin = net_bb_histograms.lowest_x_from(net_id, min(bb.xmin, xnew));
+    bb.xmax = net_bb_histograms.highest_x_from(net_id, max(bb.xmax, xnew));
+    bb.ymin = net_bb_histograms.lowest_y_from(net_id, min(bb.ymin, ynew));
+    bb.ymax = net_bb_histograms.highest_y_from(net_id, max(bb.ymax, ynew));
+
+    *bb_coord_new = bb;
+
+    bb_edge_new->xmin = net_bb_histograms.num_pins_at_x(net_id, bb.xmin);
+    bb_edge_new->xmax = net_bb_histograms.num_pins_at_x(net_id, bb.xmax);
+    bb_edge_new->ymin = net_bb_histograms.num_pins_at_y(net_id, bb.ymin);
+    bb_edge_new->ymax = net_bb_histograms.num_pins_at_y(net_id, bb.ymax);
+}
+
 static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new, int xold, int yold, int xnew, int ynew) {
     /* Updates the bounding box of a net by storing its coordinates in    *
      * the bb_coord_new data structure and the number of blocks on each   *
@@ -3133,6 +3967,28 @@ static void generate_post_place_timing_reports(const t_placer_opts& placer_opts,
         *timing_info.setup_analyzer(), analysis_opts.timing_report_npaths);
 }
 
+static t_place_snapshot_anneal_state get_snapshot_anneal_state(const t_annealing_state& state) {
+    t_place_snapshot_anneal_state snapshot_state;
+    snapshot_state.num_temps = state.num_temps;
+    snapshot_state.t = state.t;
+    snapshot_state.alpha = state.alpha;
+    snapshot_state.rlim = state.rlim;
+    snapshot_state.crit_exponent = state.crit_exponent;
+    snapshot_state.move_lim = state.move_lim;
+    snapshot_state.rand_state = vtr::get_random_state();
+    return snapshot_state;
+}
+
+static void restore_snapshot_anneal_state(t_annealing_state& state, const t_place_snapshot_anneal_state& snapshot_state) {
+    state.num_temps = snapshot_state.num_temps;
+    state.t = snapshot_state.t;
+    state.alpha = snapshot_state.alpha;
+    state.rlim = snapshot_state.rlim;
+    state.crit_exponent = snapshot_state.crit_exponent;
+    state.move_lim = snapshot_state.move_lim;
+    vtr::set_random_state(snapshot_state.rand_state);
+}
+
 #if 0
 static void update_screen_debug();
 
@@ -3298,6 +4154,53 @@ static void print_placement_move_types_stats(
     VTR_LOG("\n");
 }
 
+static void print_placement_move_timing_stats(
+    const MoveTypeStat& move_type_stat) {
+    if (move_type_stat.move_timing.empty()) {
+        return;
+    }
+
+    //Latencies are per move of the phase (e.g. the commit latency is per accepted move),
+    //throughput is the number of moves proposed per second spent in all phases
+    VTR_LOG("\n\nPlacement move timing (per move type):\n");
+    VTR_LOG(
+        "----------------- ------------ ------------ ------------ ------------ ------------ -------------\n");
+    VTR_LOG("%-17s %12s %12s %12s %12s %12s %13s\n",
+            "Move Type", "Moves", "Propose(us)", "Evaluate(us)", "Commit(us)", "Revert(us)", "Moves/sec");
+    VTR_LOG(
+        "----------------- ------------ ------------ ------------ ------------ ------------ -------------\n");
+
+    auto per_move_us = [](double time, size_t num_moves) {
+        return num_moves > 0 ? 1e6 * time / num_moves : 0.;
+    };
+
+    for (size_t imove = 0; imove < move_type_stat.move_timing.size(); imove++) {
+        const MoveTypeTiming& timing = move_type_stat.move_timing[imove];
+        if (timing.num_moves == 0) {
+            continue;
+        }
+
+        size_t num_rejected = timing.num_evaluated - timing.num_accepted;
+        double total_time = timing.propose_time + timing.evaluate_time + timing.commit_time + timing.revert_time;
+        VTR_LOG("%-17.17s %12zu %12.3f %12.3f %12.3f %12.3f %13.4g\n",
+                move_type_to_string(e_move_type(imove)).c_str(), timing.num_moves,
+                per_move_us(timing.propose_time, timing.num_moves),
+                per_move_us(timing.evaluate_time, timing.num_evaluated),
+                per_move_us(timing.commit_time, timing.num_accepted),
+                per_move_us(timing.revert_time, num_rejected),
+                total_time > 0. ? timing.num_moves / total_time : 0.);
+    }
+    VTR_LOG("\n");
+}
+
+//Returns the seconds elapsed since phase_start, and restarts phase_start for the next phase of the move
+static double end_move_phase(std::chrono::steady_clock::time_point& phase_start) {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - phase_start).count();
+    phase_start = now;
+    return elapsed;
+}
+
 static void calculate_reward_and_process_outcome(
     const t_placer_opts& placer_opts,
     const MoveOutcomeStats& move_outcome_stats,
@@ -1,5 +1,6 @@
 #include "place_checkpoint.h"
 #include "noc_place_utils.h"
+#include "directed_moves_util.h"
 
 float t_placement_checkpoint::get_cp_cpd() { return cpd; }
 double t_placement_checkpoint::get_cp_bb_cost() { return costs.bb_cost; }
@@ -31,6 +32,7 @@ void restore_best_placement(t_placement_checkpoint& placement_checkpoint, std::s
     if (placement_checkpoint.cp_is_valid() && timing_info->least_slack_critical_path().delay() > placement_checkpoint.get_cp_cpd() && costs.bb_cost < 1.05 * placement_checkpoint.get_cp_bb_cost()) {
         //restore the latest placement checkpoint
         costs = placement_checkpoint.restore_placement();
+        init_net_sink_coord_sums();
 
         //recompute timing from scratch
         placer_criticalities.get()->set_recompute_required();
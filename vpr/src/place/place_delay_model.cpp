@@ -14,6 +14,7 @@
 
 #include "vtr_log.h"
 #include "vtr_math.h"
+#include "vtr_half.h"
 #include "vpr_error.h"
 
 #include "placer_globals.h"
@@ -26,28 +27,106 @@
 #    include "serdes_utils.h"
 #endif /* VTR_ENABLE_CAPNPROTO */
 
+///@brief PlaceDelayModel methods.
+void PlaceDelayModel::delays(int from_x, int from_y, int from_pin, const t_delay_sinks& sinks, float* delays) const {
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        delays[i] = delay(from_x, from_y, from_pin, sinks.x[i], sinks.y[i], sinks.pin[i], sinks.layer[i]);
+    }
+}
+
 ///@brief DeltaDelayModel methods.
 float DeltaDelayModel::delay(int from_x, int from_y, int /*from_pin*/, int to_x, int to_y, int /*to_pin*/, int layer_num) const {
     int delta_x = std::abs(from_x - to_x);
     int delta_y = std::abs(from_y - to_y);
 
+    return table_delay(layer_num, delta_x, delta_y);
+}
+
+float DeltaDelayModel::table_delay(size_t layer_num, size_t delta_x, size_t delta_y) const {
+    if (!half_delays_.empty()) {
+        return vtr::half_to_float(half_delays_[layer_num][delta_x][delta_y]) * half_delay_scale_;
+    }
     return delays_[layer_num][delta_x][delta_y];
 }
 
+void DeltaDelayModel::delays(int from_x, int from_y, int /*from_pin*/, const t_delay_sinks& sinks, float* delays) const {
+    //Index the flat matrix storage directly so the loop reduces to
+    //integer arithmetic and a gather, which the compiler can vectorize
+    const int* to_x = sinks.x.data();
+    const int* to_y = sinks.y.data();
+    const int* to_layer = sinks.layer.data();
+    const size_t num_sinks = sinks.size();
+
+    if (!half_delays_.empty()) {
+        const size_t dx_stride = half_delays_.dim_size(2);
+        const size_t layer_stride = half_delays_.dim_size(1) * dx_stride;
+
+        for (size_t i = 0; i < num_sinks; ++i) {
+            size_t delta_x = std::abs(from_x - to_x[i]);
+            size_t delta_y = std::abs(from_y - to_y[i]);
+
+            delays[i] = vtr::half_to_float(half_delays_.get(to_layer[i] * layer_stride + delta_x * dx_stride + delta_y)) * half_delay_scale_;
+        }
+        return;
+    }
+
+    const size_t dx_stride = delays_.dim_size(2);
+    const size_t layer_stride = delays_.dim_size(1) * dx_stride;
+
+    for (size_t i = 0; i < num_sinks; ++i) {
+        size_t delta_x = std::abs(from_x - to_x[i]);
+        size_t delta_y = std::abs(from_y - to_y[i]);
+
+        delays[i] = delays_.get(to_layer[i] * layer_stride + delta_x * dx_stride + delta_y);
+    }
+}
+
+void DeltaDelayModel::compact() {
+    if (!half_delays_.empty()) {
+        return;
+    }
+
+    float max_delay = 0.;
+    for (size_t i = 0; i < delays_.size(); ++i) {
+        if (std::isfinite(delays_.get(i))) {
+            max_delay = std::max(max_delay, std::abs(delays_.get(i)));
+        }
+    }
+    half_delay_scale_ = vtr::half_scale(max_delay);
+
+    half_delays_.resize({delays_.dim_size(0), delays_.dim_size(1), delays_.dim_size(2)});
+    float max_error = 0.;
+    for (size_t i = 0; i < delays_.size(); ++i) {
+        float delay = delays_.get(i);
+        half_delays_.get(i) = vtr::float_to_half(delay / half_delay_scale_);
+        if (std::isfinite(delay) && delay != 0.) {
+            float half_delay = vtr::half_to_float(half_delays_.get(i)) * half_delay_scale_;
+            max_error = std::max(max_error, std::abs(half_delay - delay) / std::abs(delay));
+        }
+    }
+    delays_.clear();
+
+    VTR_LOG("Placement delay model compacted to half precision (max relative delay error %g)\n", max_error);
+}
+
 void DeltaDelayModel::dump_echo(std::string filepath) const {
     FILE* f = vtr::fopen(filepath.c_str(), "w");
     fprintf(f, "         ");
-    for (size_t layer_num = 0; layer_num < delays_.dim_size(0); ++layer_num) {
+    bool is_half = !half_delays_.empty();
+    size_t num_layers = is_half ? half_delays_.dim_size(0) : delays_.dim_size(0);
+    size_t num_dx = is_half ? half_delays_.dim_size(1) : delays_.dim_size(1);
+    size_t num_dy = is_half ? half_delays_.dim_size(2) : delays_.dim_size(2);
+    for (size_t layer_num = 0; layer_num < num_layers; ++layer_num) {
         fprintf(f, " %9zu", layer_num);
         fprintf(f, "\n");
-        for (size_t dx = 0; dx < delays_.dim_size(1); ++dx) {
+        for (size_t dx = 0; dx < num_dx; ++dx) {
             fprintf(f, " %9zu", dx);
         }
         fprintf(f, "\n");
-        for (size_t dy = 0; dy < delays_.dim_size(2); ++dy) {
+        for (size_t dy = 0; dy < num_dy; ++dy) {
             fprintf(f, "%9zu", dy);
-            for (size_t dx = 0; dx < delays_.dim_size(1); ++dx) {
-                fprintf(f, " %9.2e", delays_[layer_num][dx][dy]);
+            for (size_t dx = 0; dx < num_dx; ++dx) {
+                fprintf(f, " %9.2e", table_delay(layer_num, dx, dy));
             }
             fprintf(f, "\n");
         }
@@ -55,6 +134,10 @@ void DeltaDelayModel::dump_echo(std::string filepath) const {
     vtr::fclose(f);
 }
 
+void OverrideDelayModel::compact() {
+    base_delay_model_->compact();
+}
+
 const DeltaDelayModel* OverrideDelayModel::base_delay_model() const {
     return base_delay_model_.get();
 }
@@ -92,6 +175,59 @@ float OverrideDelayModel::delay(int from_x, int from_y, int from_pin, int to_x,
     return delay_val;
 }
 
+void OverrideDelayModel::delays(int from_x, int from_y, int from_pin, const t_delay_sinks& sinks, float* delays) const {
+    //Start from the base delay model and patch in any override found
+    base_delay_model_->delays(from_x, from_y, from_pin, sinks, delays);
+
+    auto& grid = g_vpr_ctx.device().grid;
+
+    int from_layer = OPEN;
+    t_physical_tile_type_ptr from_type_ptr = nullptr;
+    auto overrides_begin = delay_overrides_.end();
+    auto overrides_end = delay_overrides_.end();
+
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        if (sinks.layer[i] != from_layer) {
+            //The source tile type (and so the overrides that may apply) only
+            //changes with the layer, which is almost always the same for all sinks
+            from_layer = sinks.layer[i];
+            from_type_ptr = grid.get_physical_type({from_x, from_y, from_layer});
+
+            //Overrides are sorted by from_type first: find the ones of this source
+            t_override first_key = {(short)from_type_ptr->index, std::numeric_limits<short>::min(),
+                                    std::numeric_limits<short>::min(), std::numeric_limits<short>::min(),
+                                    std::numeric_limits<short>::min(), std::numeric_limits<short>::min()};
+            t_override last_key = {(short)from_type_ptr->index, std::numeric_limits<short>::max(),
+                                   std::numeric_limits<short>::max(), std::numeric_limits<short>::max(),
+                                   std::numeric_limits<short>::max(), std::numeric_limits<short>::max()};
+            overrides_begin = delay_overrides_.lower_bound(first_key);
+            overrides_end = delay_overrides_.upper_bound(last_key);
+        }
+
+        if (overrides_begin == overrides_end) {
+            continue; //No override from this source type
+        }
+
+        t_physical_tile_type_ptr to_type_ptr = grid.get_physical_type({sinks.x[i], sinks.y[i], sinks.layer[i]});
+
+        t_override override_key;
+        override_key.from_type = from_type_ptr->index;
+        override_key.from_class = from_type_ptr->pin_class[from_pin];
+        override_key.to_type = to_type_ptr->index;
+        override_key.to_class = to_type_ptr->pin_class[sinks.pin[i]];
+        override_key.delta_x = sinks.x[i] - from_x;
+        override_key.delta_y = sinks.y[i] - from_y;
+
+        auto override_iter = std::lower_bound(overrides_begin, overrides_end, override_key,
+                                              [](const std::pair<t_override, float>& lhs, const t_override& rhs) {
+                                                  return lhs.first < rhs;
+                                              });
+        if (override_iter != overrides_end && !(override_key < override_iter->first)) {
+            delays[i] = override_iter->second;
+        }
+    }
+}
+
 void OverrideDelayModel::set_delay_override(int from_type, int from_class, int to_type, int to_class, int delta_x, int delta_y, float delay_val) {
     t_override override_key;
     override_key.from_type = from_type;
@@ -184,11 +320,6 @@ static void ToFloat(float* out, const VprFloatEntry::Reader& in) {
     *out = in.getValue();
 }
 
-static void FromFloat(VprFloatEntry::Builder* out, const float& in) {
-    // Setting a scalar field is always "set<field name>(value)".
-    out->setValue(in);
-}
-
 void DeltaDelayModel::read(const std::string& file) {
     // MmapFile object creates an mmap of the specified path, and will munmap
     // when the object leaves scope.
@@ -237,11 +368,12 @@ void DeltaDelayModel::write(const std::string& file) const {
     // fields in the message.
     auto model = builder.initRoot<VprDeltaDelayModel>();
 
-    // FromNdMatrix is a generic function for converting a vtr::NdMatrix to a
-    // Matrix message.  It is the mirror function of ToNdMatrix described in
-    // read above.
+    // FromNdMatrixRaw stores a vtr::NdMatrix of trivially copyable values
+    // (like float) in a Matrix message as raw bytes.  ToNdMatrix described in
+    // read above reads it back.  FromNdMatrix is the generic (element by
+    // element) function, for other value types.
     auto delay_values = model.getDelays();
-    FromNdMatrix<3, VprFloatEntry, float>(&delay_values, delays_, FromFloat);
+    FromNdMatrixRaw<3, VprFloatEntry, float>(&delay_values, delays_);
 
     // writeMessageToFile writes message to the specified file.
     writeMessageToFile(file, &builder);
@@ -284,7 +416,7 @@ void OverrideDelayModel::write(const std::string& file) const {
     auto model = builder.initRoot<VprOverrideDelayModel>();
 
     auto delays = model.getDelays();
-    FromNdMatrix<3, VprFloatEntry, float>(&delays, base_delay_model_->delays(), FromFloat);
+    FromNdMatrixRaw<3, VprFloatEntry, float>(&delays, base_delay_model_->delays());
 
     // Non-scalar capnproto fields should be first initialized with
     // init<field  name>(count), and then accessed from the returned
@@ -379,15 +511,61 @@ float comp_td_single_connection_delay(const PlaceDelayModel* delay_model, Cluste
     return (delay_source_to_sink);
 }
 
+void comp_td_net_connection_delays(const PlaceDelayModel* delay_model, ClusterNetId net_id, std::vector<float>& delays) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    size_t num_pins = cluster_ctx.clb_nlist.net_pins(net_id).size();
+    delays.assign(num_pins, 0.);
+
+    if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || num_pins < 2) {
+        return;
+    }
+
+    //Scratch space for the sinks; per thread since nets may be evaluated concurrently
+    static thread_local t_delay_sinks sinks;
+    sinks.clear();
+
+    ClusterPinId source_pin = cluster_ctx.clb_nlist.net_driver(net_id);
+    ClusterBlockId source_block = cluster_ctx.clb_nlist.pin_block(source_pin);
+    int source_block_ipin = cluster_ctx.clb_nlist.pin_logical_index(source_pin);
+    int source_x = place_ctx.block_locs[source_block].loc.x;
+    int source_y = place_ctx.block_locs[source_block].loc.y;
+
+    for (ClusterPinId sink_pin : cluster_ctx.clb_nlist.net_sinks(net_id)) {
+        ClusterBlockId sink_block = cluster_ctx.clb_nlist.pin_block(sink_pin);
+        const t_pl_loc& sink_loc = place_ctx.block_locs[sink_block].loc;
+        sinks.push_back(sink_loc.x, sink_loc.y, cluster_ctx.clb_nlist.pin_logical_index(sink_pin), sink_loc.layer);
+    }
+
+    delay_model->delays(source_x, source_y, source_block_ipin, sinks, delays.data() + 1);
+
+    for (size_t ipin = 1; ipin < num_pins; ++ipin) {
+        if (delays[ipin] < 0) {
+            ClusterBlockId sink_block = cluster_ctx.clb_nlist.pin_block(cluster_ctx.clb_nlist.net_pin(net_id, ipin));
+            VPR_ERROR(VPR_ERROR_PLACE,
+                      "in comp_td_net_connection_delays: Bad delay_source_to_sink value %g from %s (at %d,%d) to %s (at %d,%d)\n"
+                      "in comp_td_net_connection_delays: Delay is less than 0\n",
+                      delays[ipin],
+                      block_type_pin_index_to_name(physical_tile_type(source_block), source_block_ipin, false).c_str(),
+                      source_x, source_y,
+                      block_type_pin_index_to_name(physical_tile_type(sink_block), sinks.pin[ipin - 1], false).c_str(),
+                      sinks.x[ipin - 1], sinks.y[ipin - 1]);
+        }
+    }
+}
+
 ///@brief Recompute all point to point delays, updating `connection_delay` matrix.
 void comp_td_connection_delays(const PlaceDelayModel* delay_model) {
     const auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& p_timing_ctx = g_placer_ctx.mutable_timing();
     auto& connection_delay = p_timing_ctx.connection_delay;
 
+    std::vector<float> net_delays;
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ++ipin) {
-            connection_delay[net_id][ipin] = comp_td_single_connection_delay(delay_model, net_id, ipin);
+        comp_td_net_connection_delays(delay_model, net_id, net_delays);
+        for (size_t ipin = 1; ipin < net_delays.size(); ++ipin) {
+            connection_delay[net_id][ipin] = net_delays[ipin];
         }
     }
 }
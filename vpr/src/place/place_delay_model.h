@@ -27,6 +27,33 @@
 ///@brief Forward declarations.
 class PlaceDelayModel;
 
+/**
+ * @brief The sink pins of a batched delay query, stored as structure of arrays
+ *        so the per-sink index computations of the delay models vectorize.
+ */
+struct t_delay_sinks {
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> pin;
+    std::vector<int> layer;
+
+    size_t size() const { return x.size(); }
+
+    void clear() {
+        x.clear();
+        y.clear();
+        pin.clear();
+        layer.clear();
+    }
+
+    void push_back(int sink_x, int sink_y, int sink_pin, int sink_layer) {
+        x.push_back(sink_x);
+        y.push_back(sink_y);
+        pin.push_back(sink_pin);
+        layer.push_back(sink_layer);
+    }
+};
+
 ///@brief Initialize the placer delay model.
 std::unique_ptr<PlaceDelayModel> alloc_lookups_and_delay_model(const Netlist<>& net_list,
                                                                t_chan_width_dist chan_width_dist,
@@ -41,6 +68,15 @@ std::unique_ptr<PlaceDelayModel> alloc_lookups_and_delay_model(const Netlist<>&
 ///@brief Returns the delay of one point to point connection.
 float comp_td_single_connection_delay(const PlaceDelayModel* delay_model, ClusterNetId net_id, int ipin);
 
+/**
+ * @brief Computes the delays of all the point to point connections of a net
+ *        with a single batched delay model query.
+ *
+ * On return, delays[ipin] holds the delay to net pin ipin for ipin in
+ * [1..num_pins-1]; delays[0] (the driver) is left at 0.
+ */
+void comp_td_net_connection_delays(const PlaceDelayModel* delay_model, ClusterNetId net_id, std::vector<float>& delays);
+
 ///@brief Recompute all point to point delays, updating `connection_delay` matrix.
 void comp_td_connection_delays(const PlaceDelayModel* delay_model);
 
@@ -64,6 +100,15 @@ class PlaceDelayModel {
      */
     virtual float delay(int from_x, int from_y, int from_pin, int to_x, int to_y, int to_pin, int layer_num) const = 0;
 
+    /**
+     * @brief Returns the delay estimates from one source pin to many sink pins.
+     *
+     * delays[i] is set to delay(from_x, from_y, from_pin, sinks.x[i], sinks.y[i],
+     * sinks.pin[i], sinks.layer[i]). The default implementation does exactly that;
+     * models override it to share the per-query work across the batch.
+     */
+    virtual void delays(int from_x, int from_y, int from_pin, const t_delay_sinks& sinks, float* delays) const;
+
     ///@brief Dumps the delay model to an echo file.
     virtual void dump_echo(std::string filename) const = 0;
 
@@ -80,6 +125,14 @@ class PlaceDelayModel {
      * May be unimplemented, in which case method should throw an exception.
      */
     virtual void read(const std::string& file) = 0;
+
+    /**
+     * @brief Converts the delay model tables to half precision storage (if supported).
+     *
+     * This halves the cache footprint of the delay queries, at the cost of keeping
+     * ~3 significant digits. Called once the model is computed (or read) and written.
+     */
+    virtual void compact() {}
 };
 
 ///@brief A simple delay model based on the distance (delta) between block locations.
@@ -97,17 +150,28 @@ class DeltaDelayModel : public PlaceDelayModel {
         const t_router_opts& router_opts,
         int longest_length) override;
     float delay(int from_x, int from_y, int /*from_pin*/, int to_x, int to_y, int /*to_pin*/, int layer_num) const override;
+    void delays(int from_x, int from_y, int /*from_pin*/, const t_delay_sinks& sinks, float* delays) const override;
     void dump_echo(std::string filepath) const override;
 
     void read(const std::string& file) override;
     void write(const std::string& file) const override;
+    void compact() override;
+
+    ///@brief Returns the delay table, which is not available once compacted
     const vtr::NdMatrix<float, 3>& delays() const {
+        VTR_ASSERT(half_delays_.empty());
         return delays_;
     }
 
   private:
     vtr::NdMatrix<float, 3> delays_; // [0..num_layers-1][0..max_dx][0..max_dy]
     bool is_flat_;
+
+    // Half precision version of delays_ (divided by half_delay_scale_), which replaces it once compacted
+    vtr::NdMatrix<uint16_t, 3> half_delays_;
+    float half_delay_scale_ = 1.;
+
+    float table_delay(size_t layer_num, size_t delta_x, size_t delta_y) const;
 };
 
 class OverrideDelayModel : public PlaceDelayModel {
@@ -122,10 +186,13 @@ class OverrideDelayModel : public PlaceDelayModel {
     // returns delay from the specified (x,y) to the specified (x,y) with both endpoints on layer_num and the
     // specified from and to pins
     float delay(int from_x, int from_y, int from_pin, int to_x, int to_y, int to_pin, int layer_num) const override;
+    // batched version of delay(): looks the overrides up only for the sinks that may have one
+    void delays(int from_x, int from_y, int from_pin, const t_delay_sinks& sinks, float* delays) const override;
     void dump_echo(std::string filepath) const override;
 
     void read(const std::string& file) override;
     void write(const std::string& file) const override;
+    void compact() override;
 
   public: //Mutators
     void set_base_delay_model(std::unique_ptr<DeltaDelayModel> base_delay_model);
@@ -8,6 +8,11 @@
 #include "placer_globals.h"
 #include "place_timing_update.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 /* Routines local to place_timing_update.cpp */
 static double comp_td_connection_cost(const PlaceDelayModel* delay_model,
                                       const PlacerCriticalities& place_crit,
@@ -250,7 +255,17 @@ void update_td_costs(const PlaceDelayModel* delay_model, const PlacerCriticaliti
     auto& connection_timing_cost = p_timing_ctx.connection_timing_cost;
 
     //Update the modified pin timing costs
-    {
+    bool all_modified = place_crit.pins_with_modified_criticality().size() >= connection_timing_cost.num_connections();
+    if (all_modified) {
+        //After a from-scratch criticality update every connection changes, so refill them
+        //all (and the summation tree) in bulk, in parallel
+        vtr::Timer timer;
+        connection_timing_cost.set_all_costs(clb_nlist, [&](ClusterNetId net, int ipin) {
+            return comp_td_connection_cost(delay_model, place_crit, net, ipin);
+        });
+
+        p_runtime_ctx.f_update_td_costs_connections_elapsed_sec += timer.elapsed_sec();
+    } else {
         vtr::Timer timer;
         auto clb_pins_modified = place_crit.pins_with_modified_criticality();
         for (ClusterPinId clb_pin : clb_pins_modified) {
@@ -308,18 +323,32 @@ void comp_td_costs(const PlaceDelayModel* delay_model, const PlacerCriticalities
     auto& connection_timing_cost = p_timing_ctx.connection_timing_cost;
     auto& net_timing_cost = p_timing_ctx.net_timing_cost;
 
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) continue;
+    /* Record the new connection costs (computed in parallel) */
+    connection_timing_cost.set_all_costs(cluster_ctx.clb_nlist, [&](ClusterNetId net_id, int ipin) {
+        float conn_timing_cost = comp_td_connection_cost(delay_model, place_crit, net_id, ipin);
+        return conn_timing_cost;
+    });
 
-        for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-            float conn_timing_cost = comp_td_connection_cost(delay_model, place_crit, net_id, ipin);
+    /* Store net timing cost for more efficient incremental updating */
+    auto nets = cluster_ctx.clb_nlist.nets();
+    auto comp_net_timing_costs = [&](size_t begin, size_t end) {
+        for (size_t inet = begin; inet < end; inet++) {
+            ClusterNetId net_id = *(nets.begin() + inet);
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) continue;
 
-            /* Record new value */
-            connection_timing_cost[net_id][ipin] = conn_timing_cost;
+            net_timing_cost[net_id] = sum_td_net_cost(net_id);
         }
-        /* Store net timing cost for more efficient incremental updating */
-        net_timing_cost[net_id] = sum_td_net_cost(net_id);
-    }
+    };
+
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nets.size()), [&](const tbb::blocked_range<size_t>& range) {
+        comp_net_timing_costs(range.begin(), range.end());
+    });
+#else
+    comp_net_timing_costs(0, nets.size());
+#endif
+
+    /* Summed serially (in net order) by sum_td_costs(), so the cost does not depend on the number of threads */
     /* Make sure timing cost does not go above MIN_TIMING_COST. */
     *timing_cost = sum_td_costs();
 }
@@ -150,12 +150,20 @@ int get_initial_move_lim(const t_placer_opts& placer_opts, const t_annealing_sch
  *   DUSTY_SCHED: This schedule jumps backward and slows down in response to success ratio.
  *                See doc/src/vpr/dusty_sa.rst for more details.
  *
+ * On top of all of them, annealing exits early once the costs converged,
+ * and cools faster to fit the time budget (see converged() and apply_time_budget()).
+ *
+ * @param temperature_sec Run-time of the temperature that just finished.
+ * @param elapsed_sec Run-time of the placement so far.
+ *
  * @return True->continues the annealing. False->exits the annealing.
  */
 bool t_annealing_state::outer_loop_update(float success_rate,
                                           const t_placer_costs& costs,
                                           const t_placer_opts& placer_opts,
-                                          const t_annealing_sched& annealing_sched) {
+                                          const t_annealing_sched& annealing_sched,
+                                          float temperature_sec,
+                                          float elapsed_sec) {
 #ifndef NO_GRAPHICS
     t_draw_state* draw_state = get_draw_state_vars();
     if (draw_state->list_of_breakpoints.size() != 0) {
@@ -164,6 +172,13 @@ bool t_annealing_state::outer_loop_update(float success_rate,
     }
 #endif
 
+    float prev_t = t;
+    sec_per_move = temperature_sec / move_lim;
+
+    if (converged(success_rate, costs, placer_opts, annealing_sched)) {
+        return false;
+    }
+
     if (annealing_sched.type == USER_SCHED) {
         /* Update t with user specified alpha. */
         t *= annealing_sched.alpha_t;
@@ -171,7 +186,7 @@ bool t_annealing_state::outer_loop_update(float success_rate,
         /* Check if the exit criterion is met. */
         bool exit_anneal = t >= annealing_sched.exit_t;
 
-        return exit_anneal;
+        return exit_anneal && apply_time_budget(prev_t, annealing_sched.exit_t, annealing_sched, elapsed_sec);
     }
 
     /* Automatically determine exit temperature. */
@@ -225,6 +240,10 @@ bool t_annealing_state::outer_loop_update(float success_rate,
         }
     }
 
+    if (!apply_time_budget(prev_t, t_exit, annealing_sched, elapsed_sec)) {
+        return false;
+    }
+
     /* Update the range limiter. */
     update_rlim(success_rate);
 
@@ -237,6 +256,97 @@ bool t_annealing_state::outer_loop_update(float success_rate,
     return true;
 }
 
+/**
+ * @brief Detects that annealing stopped improving the placement.
+ *
+ * At high temperatures many uphill moves are accepted, so only temperatures
+ * whose success ratio is below the schedule's success target are considered.
+ * Annealing is converged once neither the bounding box cost nor (if timing
+ * driven) the timing cost improved by more than converge_tol (relative) over
+ * converge_temps such temperatures.
+ *
+ * @return True if annealing should exit.
+ */
+bool t_annealing_state::converged(float success_rate,
+                                  const t_placer_costs& costs,
+                                  const t_placer_opts& placer_opts,
+                                  const t_annealing_sched& annealing_sched) {
+    if (annealing_sched.converge_tol <= 0.) {
+        return false;
+    }
+
+    bool timing_driven = placer_opts.place_algorithm.is_timing_driven();
+    bool improved = converge_bb_cost < 0.
+                    || success_rate >= annealing_sched.success_target
+                    || costs.bb_cost < converge_bb_cost * (1. - annealing_sched.converge_tol)
+                    || (timing_driven && costs.timing_cost < converge_timing_cost * (1. - annealing_sched.converge_tol));
+    if (improved) {
+        converge_bb_cost = costs.bb_cost;
+        converge_timing_cost = costs.timing_cost;
+        converge_temps = 0;
+        return false;
+    }
+
+    ++converge_temps;
+    if (converge_temps < annealing_sched.converge_temps) {
+        return false;
+    }
+
+    VTR_LOG("Annealing converged: costs improved by less than %g%% over the last %d temperatures\n",
+            100. * annealing_sched.converge_tol, converge_temps);
+    return true;
+}
+
+/**
+ * @brief Fits the rest of the annealing in the schedule's time budget.
+ *
+ * The run-time of the next temperatures and of the quench is estimated from
+ * the run-time per move of the last temperature. Time for a full quench is
+ * kept, and t is lowered (if need be) so it reaches t_exit geometrically
+ * within the temperatures that fit in the rest of the budget.
+ *
+ * @return False if no temperature fits anymore, and annealing should exit.
+ */
+bool t_annealing_state::apply_time_budget(float prev_t,
+                                          float t_exit,
+                                          const t_annealing_sched& annealing_sched,
+                                          float elapsed_sec) {
+    if (annealing_sched.time_budget < 0. || sec_per_move <= 0.) {
+        return true;
+    }
+
+    float anneal_sec = annealing_sched.time_budget - elapsed_sec - sec_per_move * move_lim_max;
+    float num_temps_left = std::floor(anneal_sec / (sec_per_move * move_lim));
+    if (num_temps_left < 1.) {
+        VTR_LOG("Annealing stopped to fit the placement time budget of %g seconds\n", annealing_sched.time_budget);
+        return false;
+    }
+
+    if (t_exit > 0. && t_exit < prev_t) {
+        t = std::min(t, prev_t * std::pow(t_exit / prev_t, 1.f / num_temps_left));
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the move limit of the quench.
+ *
+ * This is move_lim_max, unless the quench would not fit in the rest of the
+ * schedule's time budget, in which case it is shortened accordingly.
+ */
+int t_annealing_state::quench_move_lim(const t_annealing_sched& annealing_sched, float elapsed_sec) const {
+    if (annealing_sched.time_budget < 0. || sec_per_move <= 0.) {
+        return move_lim_max;
+    }
+
+    float num_moves = (annealing_sched.time_budget - elapsed_sec) / sec_per_move;
+    if (num_moves >= move_lim_max) {
+        return move_lim_max;
+    }
+    return std::max(1, int(num_moves));
+}
+
 /**
  * @brief Update the range limiter to keep acceptance prob. near 0.44.
  *
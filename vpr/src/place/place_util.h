@@ -110,12 +110,24 @@ class t_placer_costs {
  *              can still make progress, since an rlim of 0 wouldn't allow any swaps.
  *   @param INVERSE_DELTA_RLIM
  *              Used to update crit_exponent. See update_rlim() for more.
+ *   @param sec_per_move
+ *              Run-time per move measured in the last temperature (< 0 if unknown).
+ *              Used to fit the annealing in t_annealing_sched::time_budget.
+ *   @param converge_bb_cost, converge_timing_cost, converge_temps
+ *              Costs at the last significant improvement, and the number of
+ *              temperatures since then (see t_annealing_sched::converge_tol).
  *
  * Mutators:
  *   @param outer_loop_update()
  *              Update the annealing state variables in the placement outer loop.
  *   @param update_rlim(), update_crit_exponent(), update_move_lim()
  *              Inline subroutines used by the main routine outer_loop_update().
+ *   @param converged(), apply_time_budget()
+ *              Runtime-aware limits applied by outer_loop_update() on top of the schedule.
+ *
+ * Accessors:
+ *   @param quench_move_lim()
+ *              Move limit of the quench, shortened to fit the time budget.
  */
 class t_annealing_state {
   public:
@@ -135,6 +147,11 @@ class t_annealing_state {
     float INVERSE_DELTA_RLIM;
     int NUM_LAYERS = 1;
 
+    float sec_per_move = -1.;
+    double converge_bb_cost = -1.;
+    double converge_timing_cost = -1.;
+    int converge_temps = 0;
+
   public: //Constructor
     t_annealing_state(const t_annealing_sched& annealing_sched,
                       float first_t,
@@ -147,12 +164,25 @@ class t_annealing_state {
     bool outer_loop_update(float success_rate,
                            const t_placer_costs& costs,
                            const t_placer_opts& placer_opts,
-                           const t_annealing_sched& annealing_sched);
+                           const t_annealing_sched& annealing_sched,
+                           float temperature_sec,
+                           float elapsed_sec);
+
+  public: //Accessor
+    int quench_move_lim(const t_annealing_sched& annealing_sched, float elapsed_sec) const;
 
   private: //Mutator
     inline void update_rlim(float success_rate);
     inline void update_crit_exponent(const t_placer_opts& placer_opts);
     inline void update_move_lim(float success_target, float success_rate);
+    bool converged(float success_rate,
+                   const t_placer_costs& costs,
+                   const t_placer_opts& placer_opts,
+                   const t_annealing_sched& annealing_sched);
+    bool apply_time_budget(float prev_t,
+                           float t_exit,
+                           const t_annealing_sched& annealing_sched,
+                           float elapsed_sec);
 };
 
 /**
@@ -11,6 +11,7 @@
 #include "vpr_context.h"
 #include "vpr_net_pins_matrix.h"
 #include "timing_place.h"
+#include "compressed_pr_grid.h"
 
 /**
  * @brief State relating to the timing driven data.
@@ -86,6 +87,12 @@ struct PlacerRuntimeContext : public Context {
     float f_update_td_costs_total_elapsed_sec;
 };
 
+///@brief A sum of (or a single) x, y grid coordinates
+struct t_coord_sum {
+    int64_t x = 0;
+    int64_t y = 0;
+};
+
 /**
  * @brief Placement Move generators data
  */
@@ -107,6 +114,16 @@ struct PlacerMoveContext : public Context {
 
     // Container to save the highly critical pins (higher than a timing criticality limit setted by commandline option)
     std::vector<std::pair<ClusterNetId, int>> highly_crit_pins;
+
+    // [0..cluster_ctx.clb_nlist.nets().size()-1]. Sum of the coordinates of each net's sinks, used by centroid moves.
+    // Kept up to date on committed moves (see init_net_sink_coord_sums() in directed_moves_util.h)
+    vtr::vector<ClusterNetId, t_coord_sum> net_sink_coord_sums;
+
+    // [0..cluster_ctx.clb_nlist.pins().size()-1]. Coordinates of each sink pin as included in net_sink_coord_sums
+    vtr::vector<ClusterPinId, t_coord_sum> sink_pin_coords;
+
+    // Legal locations of the floorplan constrained blocks, sampled by their moves (see find_compatible_compressed_loc_in_pr())
+    CompressedPRGridCache compressed_pr_grids;
 };
 
 /**
@@ -118,7 +118,9 @@ void KArmedBanditAgent::process_outcome(double reward, e_reward_function reward_
     float delta_q = step * (reward - q_[last_action_]);
 
     //Update the estimated value of the last action
+    float old_q = q_[last_action_];
     q_[last_action_] += delta_q;
+    q_updated_(last_action_, old_q);
 
     //write agent internal q-table and actions into a file for debugging purposes
     //agent_info_file_ variable is a NULL pointer by default
@@ -188,6 +190,7 @@ void EpsilonGreedyAgent::init_q_scores_() {
     q_ = std::vector<float>(num_available_actions_, 0.);
     num_action_chosen_ = std::vector<size_t>(num_available_actions_, 0);
     cumm_epsilon_action_prob_ = std::vector<float>(num_available_actions_, 1.0 / (num_available_actions_));
+    best_action_ = 0;
 
     //agent_info_file_ = vtr::fopen("agent_info.txt", "w");
     //write agent internal q-table and actions into file for debugging purposes
@@ -212,11 +215,9 @@ t_propose_action EpsilonGreedyAgent::propose_action() {
     } else {
         /* Greedy (Exploit)
          * For probability 1-epsilon, choose the greedy move_type */
-        auto itr = std::max_element(q_.begin(), q_.end());
-        VTR_ASSERT(itr != q_.end());
-        auto action_type_q_pos = itr - q_.begin();
+        VTR_ASSERT_DEBUG(best_action_ == size_t(std::max_element(q_.begin(), q_.end()) - q_.begin()));
         //Mark the q_table location that agent used to update its value after processing the move outcome
-        last_action_ = action_type_q_pos;
+        last_action_ = best_action_;
     }
 
     t_propose_action proposed_action{action_to_move_type_(last_action_),
@@ -228,6 +229,17 @@ t_propose_action EpsilonGreedyAgent::propose_action() {
     return proposed_action;
 }
 
+void EpsilonGreedyAgent::q_updated_(size_t action, float old_q) {
+    if (action == best_action_) {
+        //Still the (first) best action unless its value decreased
+        if (q_[action] < old_q) {
+            best_action_ = std::max_element(q_.begin(), q_.end()) - q_.begin();
+        }
+    } else if (q_[action] > q_[best_action_] || (q_[action] == q_[best_action_] && action < best_action_)) {
+        best_action_ = action;
+    }
+}
+
 void EpsilonGreedyAgent::set_epsilon(float epsilon) {
     VTR_LOG("Setting egreedy epsilon: %g\n", epsilon);
     epsilon_ = epsilon;
@@ -281,11 +293,29 @@ void SoftmaxAgent::init_q_scores_() {
     if (propose_blk_type_) {
         set_block_ratio_();
     }
+    //calculate the scaled and clipped exponential function for the estimated q value for each action
+    std::transform(q_.begin(), q_.end(), exp_q_.begin(), scaled_clipped_exp);
     set_action_prob_();
 }
 
+void SoftmaxAgent::set_prob_update_interval(int interval) {
+    VTR_ASSERT(interval >= 1);
+    prob_update_interval_ = interval;
+}
+
+void SoftmaxAgent::q_updated_(size_t action, float /*old_q*/) {
+    //Only this action's exponential changes
+    exp_q_[action] = scaled_clipped_exp(q_[action]);
+    action_prob_outdated_ = true;
+}
+
 t_propose_action SoftmaxAgent::propose_action() {
-    set_action_prob_();
+    //The action probabilities only change with the Q-table, and are then recomputed
+    //at most every prob_update_interval_ proposals
+    ++num_proposals_since_prob_update_;
+    if (action_prob_outdated_ && num_proposals_since_prob_update_ >= prob_update_interval_) {
+        set_action_prob_();
+    }
 
     float p = vtr::frand();
     auto itr = std::lower_bound(cumm_action_prob_.begin(), cumm_action_prob_.end(), p);
@@ -323,19 +353,25 @@ void SoftmaxAgent::set_block_ratio_() {
 }
 
 void SoftmaxAgent::set_action_prob_() {
-    //calculate the scaled and clipped exponential function for the estimated q value for each action
-    std::transform(q_.begin(), q_.end(), exp_q_.begin(), scaled_clipped_exp);
+    //exp_q_ holds the scaled and clipped exponential of the estimated q value for each action (see q_updated_())
+    action_prob_outdated_ = false;
+    num_proposals_since_prob_update_ = 0;
 
     //calculate the sum of all scaled clipped exponential q values
     float sum_q = std::accumulate(exp_q_.begin(), exp_q_.end(), 0.0);
 
     //calculate the probability of each action as the ratio of scaled_clipped_exp(action(i))/sum(scaled_clipped_exponential)
-    for (size_t i = 0; i < num_available_actions_; ++i) {
-        if (propose_blk_type_) {
-            //calculate block type index based on its location on q_table
-            int blk_ratio_index = (int)i / num_available_moves_;
-            action_prob_[i] = (exp_q_[i] / sum_q) * block_type_ratio_[blk_ratio_index];
-        } else {
+    //(branch-free inner loops over the flat action array, which compilers can vectorize)
+    if (propose_blk_type_) {
+        //the q_table holds num_available_moves_ consecutive actions per block type
+        for (size_t itype = 0; itype < num_available_types_; ++itype) {
+            float blk_type_ratio = block_type_ratio_[itype];
+            for (size_t i = itype * num_available_moves_; i < (itype + 1) * num_available_moves_; ++i) {
+                action_prob_[i] = (exp_q_[i] / sum_q) * blk_type_ratio;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < num_available_actions_; ++i) {
             action_prob_[i] = (exp_q_[i] / sum_q);
         }
     }
@@ -83,6 +83,15 @@ class KArmedBanditAgent {
      */
     inline int agent_to_phy_blk_type(int idx);
 
+    /**
+     * @brief Called by process_outcome() once the estimated value q_[action] changed, so
+     * agents can incrementally update what they derive from the Q-table.
+     *
+     *   @param action The action whose estimated value changed
+     *   @param old_q The previous estimated value of action
+     */
+    virtual void q_updated_(size_t /*action*/, float /*old_q*/) {}
+
   protected:
     float exp_alpha_ = -1;                  //Step size for q_ updates (< 0 implies use incremental average)
     size_t num_available_moves_;            //Number of move types that agent can choose from to perform
@@ -146,9 +155,13 @@ class EpsilonGreedyAgent : public KArmedBanditAgent {
      */
     void init_q_scores_();
 
+    ///@brief Keeps best_action_ up to date (only rescans the Q-table when the best action's value decreased)
+    void q_updated_(size_t action, float old_q) override;
+
   private:
     float epsilon_ = 0.1;                         //How often to perform a non-greedy exploration action
     std::vector<float> cumm_epsilon_action_prob_; //The accumulative probability of choosing each action
+    size_t best_action_ = 0;                      //The first action with the highest estimated value (the greedy action)
 };
 
 /**
@@ -166,6 +179,14 @@ class SoftmaxAgent : public KArmedBanditAgent {
     //void process_outcome(double reward, std::string reward_fun) override; //Updates the agent based on the reward of the last proposed action
     t_propose_action propose_action() override; //Returns the type of the next action as well as the block type the agent wishes to perform
 
+    /**
+     * @brief Set how often the action probabilities are recomputed
+     *
+     *   @param interval Number of proposed actions between updates of the action probabilities from the Q-table
+     *   (1 updates them before every proposal), can be specified by the command-line option "--place_agent_prob_update_interval"
+     */
+    void set_prob_update_interval(int interval);
+
   private:
     /**
      * @brief Initialize agent's Q-table and internal variable to zero (RL-agent learns everything throughout the placement run and has no prior knowledge)
@@ -184,7 +205,13 @@ class SoftmaxAgent : public KArmedBanditAgent {
      */
     void set_action_prob_();
 
+    ///@brief Updates the exponential of the changed Q value, and marks the action probabilities as outdated
+    void q_updated_(size_t action, float old_q) override;
+
   private:
+    bool action_prob_outdated_ = false;             //Whether q_ changed since the action probabilities were last computed
+    size_t prob_update_interval_ = 1;               //Number of proposed actions between updates of the action probabilities
+    size_t num_proposals_since_prob_update_ = 0;    //Number of proposed actions since the action probabilities were last computed
     std::vector<float> exp_q_;            //The clipped and scaled exponential of the estimated Q value for each action
     std::vector<float> action_prob_;      //The probability of choosing each action
     std::vector<float> cumm_action_prob_; //The accumulative probability of choosing each action
@@ -3,6 +3,7 @@
  * @brief Stores the method definitions of classes defined in timing_place.h.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 
@@ -20,6 +21,30 @@
 
 #include "timing_info.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_for.h>
+#endif
+
+/**
+ * @brief Calls compute(begin, end) over [0, num_items), in parallel chunks if in_parallel is set
+ *        (and VPR is built with TBB).
+ */
+template<typename F>
+static void for_each_chunk(size_t num_items, bool in_parallel, const F& compute) {
+#ifdef VPR_USE_TBB
+    if (in_parallel) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_items), [&](const tbb::blocked_range<size_t>& range) {
+            compute(range.begin(), range.end());
+        });
+        return;
+    }
+#else
+    (void)in_parallel;
+#endif
+    compute(0, num_items);
+}
+
 ///@brief Allocates space for the timing_place_crit_ data structure.
 PlacerCriticalities::PlacerCriticalities(const ClusteredNetlist& clb_nlist, const ClusteredPinAtomPinsLookup& netlist_pin_lookup)
     : clb_nlist_(clb_nlist)
@@ -46,7 +71,8 @@ void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_inf
     }
 
     /* Determine what pins need updating */
-    if (!recompute_required && crit_params.crit_exponent == last_crit_exponent_) {
+    bool incremental = !recompute_required && crit_params.crit_exponent == last_crit_exponent_;
+    if (incremental) {
         incr_update_criticalities(timing_info);
     } else {
         recompute_criticalities();
@@ -61,14 +87,26 @@ void PlacerCriticalities::update_criticalities(const SetupTimingInfo* timing_inf
      * For every pin on every net (or, equivalently, for every tedge ending
      * in that pin), timing_place_crit_ = criticality^(criticality exponent) */
 
+    /* Compute the new criticalities of the affected pins. A full recompute touches every
+     * connection, so it is done in parallel; the highly critical pins are then updated
+     * serially, in the same order as before. */
+    auto modified_pins = cluster_pins_with_modified_criticality_.begin();
+    size_t num_modified_pins = cluster_pins_with_modified_criticality_.size();
+    new_criticalities_.resize(num_modified_pins);
+    for_each_chunk(num_modified_pins, !incremental, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            // Routing for placement is not flat (at least for the time being)
+            float clb_pin_crit = calculate_clb_net_pin_criticality(*timing_info, pin_lookup_, ParentPinId(size_t(modified_pins[i])), false);
+            new_criticalities_[i] = pow(clb_pin_crit, crit_params.crit_exponent);
+        }
+    });
+
     /* Update the affected pins */
-    for (ClusterPinId clb_pin : cluster_pins_with_modified_criticality_) {
+    for (size_t i = 0; i < num_modified_pins; i++) {
+        ClusterPinId clb_pin = modified_pins[i];
         ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
         int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
-        // Routing for placement is not flat (at least for the time being)
-        float clb_pin_crit = calculate_clb_net_pin_criticality(*timing_info, pin_lookup_, ParentPinId(size_t(clb_pin)), false);
-
-        float new_crit = pow(clb_pin_crit, crit_params.crit_exponent);
+        float new_crit = new_criticalities_[i];
         /*
          * Update the highly critical pins container
          *
@@ -190,21 +228,26 @@ void PlacerSetupSlacks::update_setup_slacks(const SetupTimingInfo* timing_info)
     }
 
     /* Determine what pins need updating */
-    if (!recompute_required) {
+    bool incremental = !recompute_required;
+    if (incremental) {
         incr_update_setup_slacks(timing_info);
     } else {
         recompute_setup_slacks();
     }
 
-    /* Update the affected pins */
-    for (ClusterPinId clb_pin : cluster_pins_with_modified_setup_slack_) {
-        ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
-        int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
+    /* Update the affected pins (in parallel for a full recompute, each pin is written once) */
+    auto modified_pins = cluster_pins_with_modified_setup_slack_.begin();
+    for_each_chunk(cluster_pins_with_modified_setup_slack_.size(), !incremental, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            ClusterPinId clb_pin = modified_pins[i];
+            ClusterNetId clb_net = clb_nlist_.pin_net(clb_pin);
+            int pin_index_in_net = clb_nlist_.pin_net_index(clb_pin);
 
-        float clb_pin_setup_slack = calculate_clb_net_pin_setup_slack(*timing_info, pin_lookup_, clb_pin);
+            float clb_pin_setup_slack = calculate_clb_net_pin_setup_slack(*timing_info, pin_lookup_, clb_pin);
 
-        timing_place_setup_slacks_[clb_net][pin_index_in_net] = clb_pin_setup_slack;
-    }
+            timing_place_setup_slacks_[clb_net][pin_index_in_net] = clb_pin_setup_slack;
+        }
+    });
 
     /* Setup slacks updated. In sync with timing info.     */
     /* Can be incrementally updated on the next iteration. */
@@ -264,3 +307,55 @@ void PlacerSetupSlacks::set_setup_slack(ClusterNetId net_id, int ipin, float sla
 PlacerSetupSlacks::pin_range PlacerSetupSlacks::pins_with_modified_setup_slack() const {
     return vtr::make_range(cluster_pins_with_modified_setup_slack_);
 }
+
+/**************************************/
+
+void PlacerTimingCosts::set_all_costs(const ClusteredNetlist& nlist, const std::function<double(ClusterNetId, int)>& conn_cost) {
+    if (connection_costs_.empty()) return;
+
+    /* The connections of each net are stored contiguously, so the nets can be filled in parallel */
+    auto nets = nlist.nets();
+    for_each_chunk(nets.size(), true, [&](size_t begin, size_t end) {
+        for (size_t inet = begin; inet < end; inet++) {
+            ClusterNetId net_id = *(nets.begin() + inet);
+            if (nlist.net_is_ignored(net_id)) continue;
+
+            double* net_connection_costs = &connection_costs_[net_start_indicies_[net_id]];
+            for (size_t ipin = 1; ipin < nlist.net_pins(net_id).size(); ipin++) {
+                net_connection_costs[ipin] = conn_cost(net_id, ipin);
+            }
+        }
+    });
+
+    recompute_intermediate_costs();
+}
+
+void PlacerTimingCosts::recompute_intermediate_costs() {
+    size_t num_nodes = connection_costs_.size();
+    size_t num_intermediate_nodes = num_nodes - num_connections_;
+
+    auto child_cost = [&](size_t ichild) {
+        //Out-of-tree children contribute nothing (as in total_cost_recurr())
+        return ichild < num_nodes ? connection_costs_[ichild] : 0.;
+    };
+
+    /* Level ilevel holds nodes [2^ilevel - 1, 2^(ilevel+1) - 1). Walk the levels bottom-up, so
+     * the children of every node in a level are final before the level is computed. */
+    size_t ilevel = 0;
+    while ((size_t(2) << ilevel) - 1 < num_intermediate_nodes) {
+        ++ilevel;
+    }
+    for (int level = ilevel; level >= 0; --level) {
+        size_t level_begin = (size_t(1) << level) - 1;
+        size_t level_end = std::min((size_t(2) << level) - 1, num_intermediate_nodes);
+
+        //Only the deeper levels are wide enough to be worth running in parallel
+        constexpr size_t MIN_PARALLEL_LEVEL_SIZE = 4096;
+        for_each_chunk(level_end - level_begin, level_end - level_begin >= MIN_PARALLEL_LEVEL_SIZE, [&](size_t begin, size_t end) {
+            for (size_t inode = level_begin + begin; inode < level_begin + end; inode++) {
+                connection_costs_[inode] = child_cost(left_child(inode)) + child_cost(right_child(inode));
+            }
+        });
+    }
+}
+
@@ -35,6 +35,9 @@
  */
 
 #pragma once
+
+#include <functional>
+
 #include "vtr_vec_id_set.h"
 #include "timing_info_fwd.h"
 #include "clustered_netlist_utils.h"
@@ -165,6 +168,9 @@ class PlacerCriticalities {
     ///@brief Set of pins with criticaltites modified by last call to update_criticalities().
     vtr::vec_id_set<ClusterPinId> cluster_pins_with_modified_criticality_;
 
+    ///@brief Scratch space for the new criticalities of cluster_pins_with_modified_criticality_.
+    std::vector<float> new_criticalities_;
+
     ///@brief Incremental update. See timing_place.cpp for more.
     void incr_update_criticalities(const SetupTimingInfo* timing_info);
 
@@ -379,6 +385,7 @@ class PlacerTimingCosts {
         }
 
         size_t num_connections = iconn;
+        num_connections_ = num_connections;
 
         //Determine how many binary tree levels we need to have a leaf
         //for each connection cost
@@ -483,14 +490,29 @@ class PlacerTimingCosts {
     void clear() {
         connection_costs_.clear();
         net_start_indicies_.clear();
+        num_connections_ = 0;
     }
 
     void swap(PlacerTimingCosts& other) {
         std::swap(connection_costs_, other.connection_costs_);
         std::swap(net_start_indicies_, other.net_start_indicies_);
         std::swap(num_levels_, other.num_levels_);
+        std::swap(num_connections_, other.num_connections_);
     }
 
+    ///@brief Returns the number of connections (i.e. sinks of nets which are not ignored).
+    size_t num_connections() const { return num_connections_; }
+
+    /**
+     * @brief Sets the cost of every connection to conn_cost(net, ipin) and re-totals the tree.
+     *
+     * Equivalent to assigning each connection cost, but the connection costs and then each
+     * level of the binary tree (bottom-up) are computed in parallel, if VPR is built with TBB.
+     * Every intermediate node still sums the same two children, so total_cost() returns a
+     * result bit-identical to assigning the costs one at a time.
+     */
+    void set_all_costs(const ClusteredNetlist& nlist, const std::function<double(ClusterNetId, int)>& conn_cost);
+
     /**
      * @brief Calculates the total cost of all connections efficiently
      *        in the face of modified connection costs.
@@ -505,6 +527,9 @@ class PlacerTimingCosts {
     }
 
   private:
+    ///@brief Re-calculates all intermediate nodes from the leaves, one level of the tree at a time.
+    void recompute_intermediate_costs();
+
     ///@brief Recursively calculate and update the timing cost rooted at inode.
     double total_cost_recurr(size_t inode) {
         //Prune out-of-tree
@@ -624,4 +649,7 @@ class PlacerTimingCosts {
 
     ///@brief Number of levels in the binary tree.
     size_t num_levels_ = 0;
+
+    ///@brief Number of connections (leaves) in the binary tree.
+    size_t num_connections_ = 0;
 };
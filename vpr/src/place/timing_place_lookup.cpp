@@ -34,6 +34,11 @@
 #include "router_delay_profiling.h"
 #include "place_delay_model.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 /*To compute delay between blocks we calculate the delay between */
 /*different nodes in the FPGA.  From this procedure we generate
  * a lookup table which tells us the delay between different locations in*/
@@ -57,6 +62,25 @@ struct t_profile_loc {
     std::vector<vtr::Point<int>> deltas;
 };
 
+//A delay sampled for a (delta_x, delta_y) offset while profiling from one source location.
+//A delay of EMPTY_DELTA marks an offset whose source or sink is empty.
+struct t_delta_delay_sample {
+    int delta_x;
+    int delta_y;
+    float delay;
+};
+
+//A source location and the range of sink locations profiled from it
+struct t_delta_delay_region {
+    int layer_num;
+    int source_x;
+    int source_y;
+    int start_x;
+    int start_y;
+    int end_x;
+    int end_y;
+};
+
 struct t_profile_info {
     std::vector<t_profile_loc> locations;
 
@@ -81,7 +105,7 @@ static float route_connection_delay(
 // Prototype for computing delta delay matrix.
 typedef std::function<void(
     RouterDelayProfiler&,
-    vtr::Matrix<std::vector<float>>&,
+    std::vector<t_delta_delay_sample>&,
     int,
     int,
     int,
@@ -97,7 +121,7 @@ typedef std::function<void(
 
 static void generic_compute_matrix_iterative_astar(
     RouterDelayProfiler& route_profiler,
-    vtr::Matrix<std::vector<float>>& matrix,
+    std::vector<t_delta_delay_sample>& samples,
     int layer_num,
     int source_x,
     int source_y,
@@ -112,7 +136,7 @@ static void generic_compute_matrix_iterative_astar(
 
 static void generic_compute_matrix_dijkstra_expansion(
     RouterDelayProfiler& route_profiler,
-    vtr::Matrix<std::vector<float>>& matrix,
+    std::vector<t_delta_delay_sample>& samples,
     int layer_num,
     int source_x,
     int source_y,
@@ -187,6 +211,7 @@ std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts&
                                                                           router_opts.write_router_lookahead,
                                                                           router_opts.read_router_lookahead,
                                                                           segment_inf,
+                                                                          router_opts.lookahead_half_precision,
                                                                           is_flat);
     RouterDelayProfiler route_profiler(net_list, router_lookahead, is_flat);
 
@@ -212,6 +237,10 @@ std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts&
         place_delay_model->write(placer_opts.write_placement_delay_lookup);
     }
 
+    if (placer_opts.delay_model_half_precision) {
+        place_delay_model->compact();
+    }
+
     /*free all data structures that are no longer needed */
     free_routing_structs();
 
@@ -419,9 +448,22 @@ static void add_delay_to_matrix(
     }
 }
 
+static void add_sample_to_matrix(
+    vtr::Matrix<std::vector<float>>* matrix,
+    const t_delta_delay_sample& sample) {
+    if (sample.delay == EMPTY_DELTA) {
+        if ((*matrix)[sample.delta_x][sample.delta_y].empty()) {
+            //Only set empty target if we don't already have a valid delta delay
+            (*matrix)[sample.delta_x][sample.delta_y].push_back(EMPTY_DELTA);
+        }
+    } else {
+        add_delay_to_matrix(matrix, sample.delta_x, sample.delta_y, sample.delay);
+    }
+}
+
 static void generic_compute_matrix_dijkstra_expansion(
     RouterDelayProfiler& /*route_profiler*/,
-    vtr::Matrix<std::vector<float>>& matrix,
+    std::vector<t_delta_delay_sample>& samples,
     int layer_num,
     int source_x,
     int source_y,
@@ -443,23 +485,22 @@ static void generic_compute_matrix_dijkstra_expansion(
                 int delta_x = abs(sink_x - source_x);
                 int delta_y = abs(sink_y - source_y);
 
-                if (matrix[delta_x][delta_y].empty()) {
-                    //Only set empty target if we don't already have a valid delta delay
-                    matrix[delta_x][delta_y].push_back(EMPTY_DELTA);
+                samples.push_back({delta_x, delta_y, EMPTY_DELTA});
 #ifdef VERBOSE
-                    VTR_LOG("Computed delay: %12s delta: %d,%d (src: %d,%d sink: %d,%d)\n",
-                            "EMPTY",
-                            delta_x, delta_y,
-                            source_x, source_y,
-                            sink_x, sink_y);
+                VTR_LOG("Computed delay: %12s delta: %d,%d (src: %d,%d sink: %d,%d)\n",
+                        "EMPTY",
+                        delta_x, delta_y,
+                        source_x, source_y,
+                        sink_x, sink_y);
 #endif
-                }
             }
         }
 
         return;
     }
 
+    //Delays found from this source location, recorded as samples once complete
+    vtr::Matrix<std::vector<float>> matrix({device_ctx.grid.width(), device_ctx.grid.height()});
     vtr::Matrix<bool> found_matrix({matrix.dim_size(0), matrix.dim_size(1)}, false);
 
     auto best_driver_ptcs = get_best_classes(DRIVER, device_ctx.grid.get_physical_type({source_x, source_y, layer_num}));
@@ -551,11 +592,19 @@ static void generic_compute_matrix_dijkstra_expansion(
             }
         }
     }
+
+    for (size_t delta_x = 0; delta_x < matrix.dim_size(0); ++delta_x) {
+        for (size_t delta_y = 0; delta_y < matrix.dim_size(1); ++delta_y) {
+            for (float delay : matrix[delta_x][delta_y]) {
+                samples.push_back({int(delta_x), int(delta_y), delay});
+            }
+        }
+    }
 }
 
 static void generic_compute_matrix_iterative_astar(
     RouterDelayProfiler& route_profiler,
-    vtr::Matrix<std::vector<float>>& matrix,
+    std::vector<t_delta_delay_sample>& samples,
     int layer_num,
     int source_x,
     int source_y,
@@ -588,17 +637,14 @@ static void generic_compute_matrix_iterative_astar(
             bool is_allowed_type = allowed_types.empty() || allowed_types.find(src_type->name) != allowed_types.end();
 
             if (src_or_target_empty || !is_allowed_type) {
-                if (matrix[delta_x][delta_y].empty()) {
-                    //Only set empty target if we don't already have a valid delta delay
-                    matrix[delta_x][delta_y].push_back(EMPTY_DELTA);
+                samples.push_back({delta_x, delta_y, EMPTY_DELTA});
 #ifdef VERBOSE
-                    VTR_LOG("Computed delay: %12s delta: %d,%d (src: %d,%d sink: %d,%d)\n",
-                            "EMPTY",
-                            delta_x, delta_y,
-                            source_x, source_y,
-                            sink_x, sink_y);
+                VTR_LOG("Computed delay: %12s delta: %d,%d (src: %d,%d sink: %d,%d)\n",
+                        "EMPTY",
+                        delta_x, delta_y,
+                        source_x, source_y,
+                        sink_x, sink_y);
 #endif
-                }
             } else {
                 //Valid start/end
 
@@ -611,13 +657,7 @@ static void generic_compute_matrix_iterative_astar(
                         source_x, source_y,
                         sink_x, sink_y);
 #endif
-                if (matrix[delta_x][delta_y].size() == 1 && matrix[delta_x][delta_y][0] == EMPTY_DELTA) {
-                    //Overwrite empty delta
-                    matrix[delta_x][delta_y][0] = delay;
-                } else {
-                    //Collect delta
-                    matrix[delta_x][delta_y].push_back(delay);
-                }
+                samples.push_back({delta_x, delta_y, delay});
             }
         }
     }
@@ -639,9 +679,29 @@ static vtr::NdMatrix<float, 3> compute_delta_delays(
 
     vtr::NdMatrix<float, 3> delta_delays({static_cast<unsigned long>(grid.get_num_layers()), grid.width(), grid.height()});
 
-    for (int layer_num = 0; layer_num < grid.get_num_layers(); layer_num++) {
-        vtr::Matrix<std::vector<float>> sampled_delta_delays({grid.width(), grid.height()});
+    std::set<std::string> allowed_types;
+    if (!placer_opts.allowed_tiles_for_delay_model.empty()) {
+        auto allowed_types_vector = vtr::split(placer_opts.allowed_tiles_for_delay_model, ",");
+        for (const auto& type : allowed_types_vector) {
+            allowed_types.insert(type);
+        }
+    }
 
+    t_compute_delta_delay_matrix generic_compute_matrix;
+    switch (placer_opts.place_delta_delay_matrix_calculation_method) {
+        case e_place_delta_delay_algorithm::ASTAR_ROUTE:
+            generic_compute_matrix = generic_compute_matrix_iterative_astar;
+            break;
+        case e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION:
+            generic_compute_matrix = generic_compute_matrix_dijkstra_expansion;
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Unknown place_delta_delay_matrix_calculation_method %d", placer_opts.place_delta_delay_matrix_calculation_method);
+    }
+
+    //Collect the source locations (and sink ranges) to profile on every layer
+    std::vector<t_delta_delay_region> regions;
+    for (int layer_num = 0; layer_num < grid.get_num_layers(); layer_num++) {
         size_t mid_x = vtr::nint(grid.width() / 2);
         size_t mid_y = vtr::nint(grid.height() / 2);
 
@@ -656,14 +716,6 @@ static vtr::NdMatrix<float, 3> compute_delta_delays(
             high_y = std::max(grid.height() - longest_length, mid_y);
         }
 
-        std::set<std::string> allowed_types;
-        if (!placer_opts.allowed_tiles_for_delay_model.empty()) {
-            auto allowed_types_vector = vtr::split(placer_opts.allowed_tiles_for_delay_model, ",");
-            for (const auto& type : allowed_types_vector) {
-                allowed_types.insert(type);
-            }
-        }
-
         //   +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
         //   +                 |                       |               +
         //   +        A        |           B           |       C       +
@@ -712,29 +764,11 @@ static vtr::NdMatrix<float, 3> compute_delta_delays(
         }
         VTR_ASSERT(src_type != nullptr);
 
-        t_compute_delta_delay_matrix generic_compute_matrix;
-        switch (placer_opts.place_delta_delay_matrix_calculation_method) {
-            case e_place_delta_delay_algorithm::ASTAR_ROUTE:
-                generic_compute_matrix = generic_compute_matrix_iterative_astar;
-                break;
-            case e_place_delta_delay_algorithm::DIJKSTRA_EXPANSION:
-                generic_compute_matrix = generic_compute_matrix_dijkstra_expansion;
-                break;
-            default:
-                VPR_FATAL_ERROR(VPR_ERROR_PLACE, "Unknown place_delta_delay_matrix_calculation_method %d", placer_opts.place_delta_delay_matrix_calculation_method);
-        }
-
-#ifdef VERBOSE
-        VTR_LOG("Computing from lower left edge (%d,%d):\n", x, y);
-#endif
-        generic_compute_matrix(route_profiler, sampled_delta_delays,
-                               layer_num,
-                               x, y,
-                               x, y,
-                               grid.width() - 1, grid.height() - 1,
-                               router_opts,
-                               measure_directconnect, allowed_types,
-                               is_flat);
+        //Computing from lower left edge
+        regions.push_back({layer_num,
+                           x, y,
+                           x, y,
+                           (int)grid.width() - 1, (int)grid.height() - 1});
 
         //Find the lowest x location on the bottom edge with a non-empty block
         src_type = nullptr;
@@ -755,73 +789,105 @@ static vtr::NdMatrix<float, 3> compute_delta_delays(
             }
         }
         VTR_ASSERT(src_type != nullptr);
-#ifdef VERBOSE
-        VTR_LOG("Computing from left bottom edge (%d,%d):\n", x, y);
-#endif
-        generic_compute_matrix(route_profiler, sampled_delta_delays,
-                               layer_num,
-                               x, y,
-                               x, y,
-                               grid.width() - 1, grid.height() - 1,
-                               router_opts,
-                               measure_directconnect, allowed_types,
-                               is_flat);
+
+        //Computing from left bottom edge
+        regions.push_back({layer_num,
+                           x, y,
+                           x, y,
+                           (int)grid.width() - 1, (int)grid.height() - 1});
 
         //Since the other delta delay values may have suffered from edge effects,
         //we recalculate deltas within regions B, C, E, F
-#ifdef VERBOSE
-        VTR_LOG("Computing from low/low:\n");
-#endif
-        generic_compute_matrix(route_profiler, sampled_delta_delays,
-                               layer_num,
-                               low_x, low_y,
-                               low_x, low_y,
-                               grid.width() - 1, grid.height() - 1,
-                               router_opts,
-                               measure_directconnect, allowed_types,
-                               is_flat);
+        regions.push_back({layer_num,
+                           (int)low_x, (int)low_y,
+                           (int)low_x, (int)low_y,
+                           (int)grid.width() - 1, (int)grid.height() - 1});
 
         //Since the other delta delay values may have suffered from edge effects,
         //we recalculate deltas within regions D, E, G, H
-#ifdef VERBOSE
-        VTR_LOG("Computing from high/high:\n");
-#endif
-        generic_compute_matrix(route_profiler, sampled_delta_delays,
-                               layer_num,
-                               high_x, high_y,
-                               0, 0,
-                               high_x, high_y,
-                               router_opts,
-                               measure_directconnect, allowed_types,
-                               is_flat);
+        regions.push_back({layer_num,
+                           (int)high_x, (int)high_y,
+                           0, 0,
+                           (int)high_x, (int)high_y});
 
         //Since the other delta delay values may have suffered from edge effects,
         //we recalculate deltas within regions A, B, D, E
-#ifdef VERBOSE
-        VTR_LOG("Computing from high/low:\n");
-#endif
-        generic_compute_matrix(route_profiler, sampled_delta_delays,
-                               layer_num,
-                               high_x, low_y,
-                               0, low_y,
-                               high_x, grid.height() - 1,
-                               router_opts,
-                               measure_directconnect, allowed_types,
-                               is_flat);
+        regions.push_back({layer_num,
+                           (int)high_x, (int)low_y,
+                           0, (int)low_y,
+                           (int)high_x, (int)grid.height() - 1});
 
         //Since the other delta delay values may have suffered from edge effects,
         //we recalculate deltas within regions E, F, H, I
+        regions.push_back({layer_num,
+                           (int)low_x, (int)high_y,
+                           (int)low_x, 0,
+                           (int)grid.width() - 1, (int)high_y});
+    }
+
+    //Each source location is profiled independently. The A* router routes every
+    //connection separately, so its regions are further split into one task per
+    //sink column; the Dijkstra expansion is done once per source location.
+    std::vector<t_delta_delay_region> tasks;
+    for (const t_delta_delay_region& region : regions) {
+        if (placer_opts.place_delta_delay_matrix_calculation_method == e_place_delta_delay_algorithm::ASTAR_ROUTE) {
+            for (int sink_x = region.start_x; sink_x <= region.end_x; ++sink_x) {
+                t_delta_delay_region task = region;
+                task.start_x = sink_x;
+                task.end_x = sink_x;
+                tasks.push_back(task);
+            }
+        } else {
+            tasks.push_back(region);
+        }
+    }
+
+    std::vector<std::vector<t_delta_delay_sample>> task_samples(tasks.size());
+    auto compute_task = [&](RouterDelayProfiler& task_route_profiler, size_t itask) {
+        const t_delta_delay_region& task = tasks[itask];
 #ifdef VERBOSE
-        VTR_LOG("Computing from low/high:\n");
+        VTR_LOG("Computing from (%d,%d) on layer %d:\n", task.source_x, task.source_y, task.layer_num);
 #endif
-        generic_compute_matrix(route_profiler, sampled_delta_delays,
-                               layer_num,
-                               low_x, high_y,
-                               low_x, 0,
-                               grid.width() - 1, high_y,
+        generic_compute_matrix(task_route_profiler, task_samples[itask],
+                               task.layer_num,
+                               task.source_x, task.source_y,
+                               task.start_x, task.start_y,
+                               task.end_x, task.end_y,
                                router_opts,
                                measure_directconnect, allowed_types,
                                is_flat);
+    };
+
+    bool computed_in_parallel = false;
+#ifdef VPR_USE_TBB
+    //Router debug output is only meaningful when connections are routed one after another
+    if (!router_debug_requested(router_opts)) {
+        //Each thread routes with its own copy of the profiler
+        tbb::enumerable_thread_specific<RouterDelayProfiler> route_profilers(route_profiler);
+        tbb::parallel_for(size_t(0), tasks.size(), [&](size_t itask) {
+            compute_task(route_profilers.local(), itask);
+        });
+        computed_in_parallel = true;
+    }
+#endif
+    if (!computed_in_parallel) {
+        for (size_t itask = 0; itask < tasks.size(); ++itask) {
+            compute_task(route_profiler, itask);
+        }
+    }
+
+    //Combine the samples in task order, so the delta delays do not depend on the number of threads
+    for (int layer_num = 0; layer_num < grid.get_num_layers(); layer_num++) {
+        vtr::Matrix<std::vector<float>> sampled_delta_delays({grid.width(), grid.height()});
+
+        for (size_t itask = 0; itask < tasks.size(); ++itask) {
+            if (tasks[itask].layer_num != layer_num) {
+                continue;
+            }
+            for (const t_delta_delay_sample& sample : task_samples[itask]) {
+                add_sample_to_matrix(&sampled_delta_delays, sample);
+            }
+        }
 
         for (size_t dx = 0; dx < sampled_delta_delays.dim_size(0); ++dx) {
             for (size_t dy = 0; dy < sampled_delta_delays.dim_size(1); ++dy) {
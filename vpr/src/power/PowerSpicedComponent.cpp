@@ -66,20 +66,21 @@ void PowerCallibInputs::callibrate() {
 
 PowerCallibSize* PowerCallibInputs::get_entry_bound(bool lower,
                                                     float transistor_size) {
-    PowerCallibSize* prev = entries[0];
-
     VTR_ASSERT(sorted);
-    for (std::vector<PowerCallibSize*>::iterator it = entries.begin() + 1;
-         it != entries.end(); it++) {
-        if ((*it)->transistor_size > transistor_size) {
-            if (lower)
-                return prev;
-            else
-                return *it;
-        }
-        prev = *it;
+
+    /* First entry (after the min placeholder) larger than transistor_size */
+    std::vector<PowerCallibSize*>::iterator it = std::upper_bound(entries.begin() + 1, entries.end(), transistor_size,
+                                                                  [](float size, const PowerCallibSize* entry) {
+                                                                      return size < entry->transistor_size;
+                                                                  });
+    if (it == entries.end()) {
+        return nullptr;
     }
-    return nullptr;
+
+    if (lower)
+        return *(it - 1);
+    else
+        return *it;
 }
 
 PowerSpicedComponent::PowerSpicedComponent(std::string component_name,
@@ -126,27 +127,28 @@ PowerCallibInputs* PowerSpicedComponent::get_entry(int num_inputs) {
 
 PowerCallibInputs* PowerSpicedComponent::get_entry_bound(bool lower,
                                                          int num_inputs) {
-    PowerCallibInputs* prev = entries[0];
-
     VTR_ASSERT(sorted);
-    for (std::vector<PowerCallibInputs*>::iterator it = entries.begin() + 1;
-         it != entries.end(); it++) {
-        if ((*it)->num_inputs > num_inputs) {
-            if (lower) {
-                if (prev == entries[0])
-                    return nullptr;
-                else
-                    return prev;
-            } else {
-                if (*it == entries[entries.size() - 1])
-                    return nullptr;
-                else
-                    return *it;
-            }
-        }
-        prev = *it;
+
+    /* First entry (after the min placeholder) with more inputs than num_inputs */
+    std::vector<PowerCallibInputs*>::iterator it = std::upper_bound(entries.begin() + 1, entries.end(), num_inputs,
+                                                                    [](int inputs, const PowerCallibInputs* entry) {
+                                                                        return inputs < entry->num_inputs;
+                                                                    });
+    if (it == entries.end()) {
+        return nullptr;
+    }
+
+    if (lower) {
+        if (it - 1 == entries.begin())
+            return nullptr;
+        else
+            return *(it - 1);
+    } else {
+        if (it == entries.end() - 1)
+            return nullptr;
+        else
+            return *it;
     }
-    return nullptr;
 }
 
 void PowerSpicedComponent::add_data_point(int num_inputs, float transistor_size, float power) {
@@ -158,6 +160,17 @@ void PowerSpicedComponent::add_data_point(int num_inputs, float transistor_size,
 
 float PowerSpicedComponent::scale_factor(int num_inputs,
                                          float transistor_size) {
+    VTR_ASSERT(done_callibration);
+
+    auto result = scale_factor_cache.emplace(std::make_pair(num_inputs, transistor_size), 0.);
+    if (result.second) {
+        result.first->second = interpolate_scale_factor(num_inputs, transistor_size);
+    }
+    return result.first->second;
+}
+
+float PowerSpicedComponent::interpolate_scale_factor(int num_inputs,
+                                                     float transistor_size) {
     PowerCallibInputs* inputs_lower;
     PowerCallibInputs* inputs_upper;
 
@@ -237,6 +250,7 @@ void PowerSpicedComponent::sort_me() {
 
 void PowerSpicedComponent::callibrate() {
     sort_me();
+    scale_factor_cache.clear();
 
     for (std::vector<PowerCallibInputs*>::iterator it = entries.begin();
          it != entries.end(); it++) {
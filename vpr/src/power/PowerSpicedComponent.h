@@ -20,6 +20,10 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "vtr_hash.h"
 
 /************************* STRUCTS **********************************/
 class PowerSpicedComponent;
@@ -68,6 +72,11 @@ class PowerSpicedComponent {
     bool sorted;
     bool done_callibration;
 
+    /* Memoized scale factors, keyed by (num_inputs, transistor_size).
+     * The same few sizes are looked up for every instance of a component,
+     * and the factors do not change once callibrated. */
+    std::unordered_map<std::pair<int, float>, float, vtr::hash_pair> scale_factor_cache;
+
     PowerCallibInputs* add_entry(int num_inputs);
     PowerCallibInputs* get_entry(int num_inputs);
     PowerCallibInputs* get_entry_bound(bool lower, int num_inputs);
@@ -78,6 +87,7 @@ class PowerSpicedComponent {
 
     void add_data_point(int num_inputs, float transistor_size, float power);
     float scale_factor(int num_inputs, float transistor_size);
+    float interpolate_scale_factor(int num_inputs, float transistor_size);
     void sort_me();
 
     //	void update_scale_factor(float (*fn)(float size));
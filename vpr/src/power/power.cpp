@@ -27,6 +27,7 @@
 #include <ctime>
 #include <cmath>
 #include <ctype.h>
+#include <vector>
 
 #include "vtr_util.h"
 #include "vtr_path.h"
@@ -64,6 +65,18 @@ typedef enum {
 /************************* File Scope **********************************/
 static t_rr_node_power* rr_node_power;
 
+/* The power of an unused instance of a logical block type only depends on the
+ * architecture, so it is computed once per type. Computing it also adds to the
+ * pb_type, mode, interconnect and component breakdowns (the accumulators), so
+ * the amount added to each of them is kept too, and replayed for the other
+ * unused instances. */
+struct t_unused_block_power {
+    bool valid = false;
+    t_power_usage power;
+    std::vector<t_power_usage*> accumulators;
+    std::vector<t_power_usage> added;
+};
+
 /************************* Function Declarations ********************/
 /* Routing */
 static void power_usage_routing(t_power_usage* power_usage,
@@ -76,6 +89,8 @@ static void power_usage_pb(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node
 static void power_usage_primitive(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node* pb_graph_node, ClusterBlockId iblk);
 static void power_reset_tile_usage();
 static void power_reset_pb_type(t_pb_type* pb_type);
+static void power_collect_pb_type_usages(t_pb_type* pb_type, std::vector<t_power_usage*>& usages);
+static void power_usage_unused_block(t_power_usage* power_usage, t_logical_block_type_ptr logical_block, std::vector<t_unused_block_power>& unused_block_power);
 static void power_usage_local_buffers_and_wires(t_power_usage* power_usage,
                                                 t_pb* pb,
                                                 t_pb_graph_node* pb_node,
@@ -581,6 +596,57 @@ static void power_reset_pb_type(t_pb_type* pb_type) {
     }
 }
 
+/* Collects the accumulated power usages of pb_type and its descendants, as reset by power_reset_pb_type() */
+static void power_collect_pb_type_usages(t_pb_type* pb_type, std::vector<t_power_usage*>& usages) {
+    usages.push_back(&pb_type->pb_type_power->power_usage);
+    usages.push_back(&pb_type->pb_type_power->power_usage_bufs_wires);
+
+    for (int mode_idx = 0; mode_idx < pb_type->num_modes; mode_idx++) {
+        usages.push_back(&pb_type->modes[mode_idx].mode_power->power_usage);
+
+        for (int child_idx = 0; child_idx < pb_type->modes[mode_idx].num_pb_type_children; child_idx++) {
+            power_collect_pb_type_usages(&pb_type->modes[mode_idx].pb_type_children[child_idx], usages);
+        }
+        for (int interc_idx = 0; interc_idx < pb_type->modes[mode_idx].num_interconnect; interc_idx++) {
+            usages.push_back(&pb_type->modes[mode_idx].interconnect[interc_idx].interconnect_power->power_usage);
+        }
+    }
+}
+
+/* Calculates the power of an unused instance of logical_block, see t_unused_block_power */
+static void power_usage_unused_block(t_power_usage* power_usage, t_logical_block_type_ptr logical_block, std::vector<t_unused_block_power>& unused_block_power) {
+    t_unused_block_power& unused = unused_block_power[logical_block->index];
+
+    if (!unused.valid) {
+        auto& power_ctx = g_vpr_ctx.power();
+
+        power_collect_pb_type_usages(logical_block->pb_type, unused.accumulators);
+        for (int component_idx = 0; component_idx < POWER_COMPONENT_MAX_NUM; component_idx++) {
+            unused.accumulators.push_back(&power_ctx.by_component.components[component_idx]);
+        }
+
+        /* Accumulate from zero, to find what this instance adds */
+        std::vector<t_power_usage> saved;
+        for (t_power_usage* accumulator : unused.accumulators) {
+            saved.push_back(*accumulator);
+            power_zero_usage(accumulator);
+        }
+
+        power_usage_pb(&unused.power, nullptr, logical_block->pb_graph_head, ClusterBlockId::INVALID());
+
+        for (size_t i = 0; i < unused.accumulators.size(); i++) {
+            unused.added.push_back(*unused.accumulators[i]);
+            *unused.accumulators[i] = saved[i];
+        }
+        unused.valid = true;
+    }
+
+    for (size_t i = 0; i < unused.accumulators.size(); i++) {
+        power_add_usage(unused.accumulators[i], &unused.added[i]);
+    }
+    *power_usage = unused.power;
+}
+
 /**
  * Resets the power usage for all tile types
  */
@@ -607,6 +673,7 @@ static void power_usage_blocks(t_power_usage* power_usage) {
     power_reset_tile_usage();
 
     t_logical_block_type_ptr logical_block;
+    std::vector<t_unused_block_power> unused_block_power(device_ctx.logical_block_types.size());
 
     /* Loop through all grid locations */
     for (int layer_num = 0; layer_num < device_ctx.grid.get_num_layers(); layer_num++) {
@@ -631,12 +698,14 @@ static void power_usage_blocks(t_power_usage* power_usage) {
                     if (iblk != EMPTY_BLOCK_ID && iblk != INVALID_BLOCK_ID) {
                         pb = cluster_ctx.clb_nlist.block_pb(iblk);
                         logical_block = cluster_ctx.clb_nlist.block_type(iblk);
+
+                        /* Calculate power of this CLB */
+                        power_usage_pb(&pb_power, pb, logical_block->pb_graph_head, iblk);
                     } else {
                         logical_block = pick_logical_type(physical_tile);
+                        power_usage_unused_block(&pb_power, logical_block, unused_block_power);
                     }
 
-                    /* Calculate power of this CLB */
-                    power_usage_pb(&pb_power, pb, logical_block->pb_graph_head, iblk);
                     power_add_usage(power_usage, &pb_power);
                 }
             }
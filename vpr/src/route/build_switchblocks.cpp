@@ -130,6 +130,10 @@
 #include <iterator>
 #include <iostream>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vtr_assert.h"
 #include "vtr_memory.h"
 #include "vtr_log.h"
@@ -142,7 +146,7 @@
 #include "parse_switchblocks.h"
 #include "vtr_expr_eval.h"
 
-using vtr::FormulaParser;
+using vtr::CompiledFormula;
 using vtr::t_formula_data;
 
 /************ Defines ************/
@@ -180,8 +184,14 @@ struct t_wire_switchpoint {
     int switchpoint; //Switchpoint of the wire
 };
 
+/* the formulas of a switchblock, compiled once for all the locations at which it is built */
+struct t_switchblock_formulas {
+    std::map<SB_Side_Connection, std::vector<CompiledFormula>> permutations; /* parallel to t_switchblock_inf::permutation_map */
+    std::vector<CompiledFormula> num_conns;                                  /* [0..wireconns.size()-1] */
+};
+
 struct t_wireconn_scratchpad {
-    FormulaParser formula_parser;
+    const t_switchblock_formulas* sb_formulas = nullptr; /* formulas of the switchblock being built */
     t_formula_data formula_data;
     std::vector<t_wire_switchpoint> potential_src_wires;
     std::vector<t_wire_switchpoint> potential_dest_wires;
@@ -205,12 +215,12 @@ static void compute_wire_connections(
     enum e_side to_side,
     const t_chan_details& chan_details_x,
     const t_chan_details& chan_details_y,
-    t_switchblock_inf* sb,
+    const t_switchblock_inf* sb,
     const DeviceGrid& grid,
     const t_wire_type_sizes* wire_type_sizes_x,
     const t_wire_type_sizes* wire_type_sizes_y,
     e_directionality directionality,
-    t_sb_connection_map* sb_conns,
+    std::vector<t_switchblock_connection>* sb_conns,
     vtr::RandState& rand_state,
     t_wireconn_scratchpad* scratchpad);
 
@@ -230,12 +240,15 @@ static void compute_wireconn_connections(
     const t_wire_type_sizes* wire_type_sizes_x,
     const t_wire_type_sizes* wire_type_sizes_y,
     const t_switchblock_inf* sb,
-    t_wireconn_inf* wireconn_ptr,
-    t_sb_connection_map* sb_conns,
+    int iwireconn,
+    std::vector<t_switchblock_connection>* sb_conns,
     vtr::RandState& rand_state,
     t_wireconn_scratchpad* scratchpad);
 
-static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, std::string num_conns_formula, int from_wire_count, int to_wire_count);
+/* compiles the permutation and num_conns formulas of sb */
+static void compile_switchblock_formulas(const t_switchblock_inf& sb, t_switchblock_formulas* sb_formulas);
+
+static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, const CompiledFormula& num_conns_formula, int from_wire_count, int to_wire_count);
 
 /* returns the wire indices belonging to the types in 'wire_type_vec' and switchpoints in 'points' at the given channel segment */
 static void get_switchpoint_wires(
@@ -291,11 +304,6 @@ t_sb_connection_map* alloc_and_load_switchblock_permutations(const t_chan_detail
                                                              t_chan_width* nodes_per_chan,
                                                              e_directionality directionality,
                                                              vtr::RandState& rand_state) {
-    /* Holds temporary memory for parsing. */
-    t_wireconn_scratchpad scratchpad;
-
-    t_sb_connection_map* sb_conns = new t_sb_connection_map;
-
     /* We assume that x & y channels have the same ratios of wire types. i.e., looking at a single
      * channel is representative of all channels in the FPGA -- as of 3/9/2013 this is true in VPR */
     t_wire_type_sizes wire_type_sizes;
@@ -315,44 +323,156 @@ t_sb_connection_map* alloc_and_load_switchblock_permutations(const t_chan_detail
     count_wire_type_sizes(chan_details_x[0][0].data(), nodes_per_chan->x_max, &wire_type_sizes_x);
     count_wire_type_sizes(chan_details_x[0][0].data(), nodes_per_chan->max, &wire_type_sizes);
 
-    /******** slow switch block computation method; computes switchblocks at each coordinate ********/
-    /* iterate over all the switchblocks specified in the architecture */
+    /* compile the formulas of all the switchblocks once, for all the locations they are built at */
+    std::vector<t_switchblock_formulas> sb_formulas(switchblocks.size());
+    bool uses_shuffled_switchpoints = false;
     for (int i_sb = 0; i_sb < (int)switchblocks.size(); i_sb++) {
-        t_switchblock_inf sb = switchblocks[i_sb];
+        const t_switchblock_inf& sb = switchblocks[i_sb];
 
         /* verify that switchblock type matches specified directionality -- currently we have to stay consistent */
         if (directionality != sb.directionality) {
             VPR_FATAL_ERROR(VPR_ERROR_ARCH, "alloc_and_load_switchblock_connections: Switchblock %s does not match directionality of architecture\n", sb.name.c_str());
         }
-        /* Iterate over the x,y coordinates spanning the FPGA. */
-        for (size_t x_coord = 0; x_coord < grid.width(); x_coord++) {
-            for (size_t y_coord = 0; y_coord <= grid.height(); y_coord++) {
-                if (sb_not_here(grid, x_coord, y_coord, sb.location)) {
-                    continue;
-                }
-                /* now we iterate over all the potential side1->side2 connections */
-                for (e_side from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-                    for (e_side to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-                        /* Fill appropriate entry of the sb_conns map with vector specifying the wires
-                         * the current wire will connect to */
-                        compute_wire_connections(x_coord, y_coord, from_side, to_side,
-                                                 chan_details_x, chan_details_y, &sb, grid,
-                                                 &wire_type_sizes_x, &wire_type_sizes_y, directionality, sb_conns, rand_state, &scratchpad);
-                    }
+        compile_switchblock_formulas(sb, &sb_formulas[i_sb]);
+
+        for (const t_wireconn_inf& wireconn : sb.wireconns) {
+            uses_shuffled_switchpoints |= (wireconn.from_switchpoint_order == SwitchPointOrder::SHUFFLED
+                                           || wireconn.to_switchpoint_order == SwitchPointOrder::SHUFFLED);
+        }
+    }
+
+    /* computes the connections of switchblock i_sb at every location of column x_coord */
+    auto compute_column_connections = [&](int i_sb, size_t x_coord, vtr::RandState& column_rand_state, t_wireconn_scratchpad& scratchpad, std::vector<t_switchblock_connection>& sb_conns) {
+        const t_switchblock_inf& sb = switchblocks[i_sb];
+        scratchpad.sb_formulas = &sb_formulas[i_sb];
+        for (size_t y_coord = 0; y_coord <= grid.height(); y_coord++) {
+            if (sb_not_here(grid, x_coord, y_coord, sb.location)) {
+                continue;
+            }
+            /* now we iterate over all the potential side1->side2 connections */
+            for (e_side from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
+                for (e_side to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
+                    /* Add the connections the current wire makes at this side pair to sb_conns */
+                    compute_wire_connections(x_coord, y_coord, from_side, to_side,
+                                             chan_details_x, chan_details_y, &sb, grid,
+                                             &wire_type_sizes_x, &wire_type_sizes_y, directionality, &sb_conns, column_rand_state, &scratchpad);
                 }
             }
         }
+    };
+
+    /* the connections made, as lists which each hold all the connections of the switchblocks they contain */
+    std::vector<std::vector<t_switchblock_connection>> connection_lists;
+
+    if (uses_shuffled_switchpoints) {
+        /* shuffled switchpoints draw from a single random number sequence, so the switchblocks must be built
+         * in the same order every time for build_rr_graph() to be deterministic */
+        t_wireconn_scratchpad scratchpad;
+        connection_lists.resize(1);
+        for (int i_sb = 0; i_sb < (int)switchblocks.size(); i_sb++) {
+            for (size_t x_coord = 0; x_coord < grid.width(); x_coord++) {
+                compute_column_connections(i_sb, x_coord, rand_state, scratchpad, connection_lists[0]);
+            }
+        }
+    } else {
+        /* the columns are independent: build each of them into its own list. Within a column, the
+         * switchblocks are built (and a side pair's connections made) in architecture order, as above */
+        connection_lists.resize(grid.width());
+        auto compute_column = [&](size_t x_coord) {
+            t_wireconn_scratchpad scratchpad;
+            vtr::RandState unused_rand_state = 0;
+            for (int i_sb = 0; i_sb < (int)switchblocks.size(); i_sb++) {
+                compute_column_connections(i_sb, x_coord, unused_rand_state, scratchpad, connection_lists[x_coord]);
+            }
+        };
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), grid.width(), compute_column);
+#else
+        for (size_t x_coord = 0; x_coord < grid.width(); x_coord++) {
+            compute_column(x_coord);
+        }
+#endif
     }
 
-    return sb_conns;
+    return new t_sb_connection_map(grid.width(), grid.height() + 1, connection_lists);
+}
+
+t_sb_connection_map::t_sb_connection_map(size_t grid_width, size_t grid_height, const std::vector<std::vector<t_switchblock_connection>>& connection_lists)
+    : grid_width_(grid_width)
+    , grid_height_(grid_height) {
+    size_t num_lookups = grid_width_ * grid_height_ * NUM_SIDES * NUM_SIDES;
+
+    /* count the connections of each switchblock side pair, then place them with a stable counting sort */
+    edge_offsets_.assign(num_lookups + 1, 0);
+    for (const auto& connections : connection_lists) {
+        for (const t_switchblock_connection& conn : connections) {
+            const Switchblock_Lookup& sb_conn = conn.sb_conn;
+            long ilookup = lookup_index(sb_conn.x_coord, sb_conn.y_coord, sb_conn.from_side, sb_conn.to_side);
+            VTR_ASSERT(ilookup >= 0);
+            edge_offsets_[ilookup + 1]++;
+        }
+    }
+    for (size_t ilookup = 0; ilookup < num_lookups; ilookup++) {
+        edge_offsets_[ilookup + 1] += edge_offsets_[ilookup];
+    }
+
+    edges_.resize(edge_offsets_[num_lookups]);
+    std::vector<size_t> next_edge(edge_offsets_.begin(), edge_offsets_.end() - 1);
+    for (const auto& connections : connection_lists) {
+        for (const t_switchblock_connection& conn : connections) {
+            const Switchblock_Lookup& sb_conn = conn.sb_conn;
+            long ilookup = lookup_index(sb_conn.x_coord, sb_conn.y_coord, sb_conn.from_side, sb_conn.to_side);
+            edges_[next_edge[ilookup]++] = conn.edge;
+        }
+    }
+
+    /* sort the connections of each side pair by source wire, keeping the order in which the connections of a
+     * source wire were made (the order in which the rr graph edges are created) */
+    auto sort_lookup_edges = [&](size_t ilookup) {
+        std::stable_sort(edges_.begin() + edge_offsets_[ilookup], edges_.begin() + edge_offsets_[ilookup + 1],
+                         [](const t_switchblock_edge& lhs, const t_switchblock_edge& rhs) {
+                             return lhs.from_wire < rhs.from_wire;
+                         });
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_lookups, sort_lookup_edges);
+#else
+    for (size_t ilookup = 0; ilookup < num_lookups; ilookup++) {
+        sort_lookup_edges(ilookup);
+    }
+#endif
+}
+
+vtr::array_view<const t_switchblock_edge> t_sb_connection_map::edges(int x, int y, e_side from_side, e_side to_side, int from_wire) const {
+    long ilookup = lookup_index(x, y, from_side, to_side);
+    if (ilookup < 0) {
+        return vtr::array_view<const t_switchblock_edge>();
+    }
+
+    auto begin = edges_.begin() + edge_offsets_[ilookup];
+    auto end = edges_.begin() + edge_offsets_[ilookup + 1];
+    auto first = std::lower_bound(begin, end, from_wire, [](const t_switchblock_edge& edge, int wire) {
+        return edge.from_wire < wire;
+    });
+    auto last = std::upper_bound(first, end, from_wire, [](int wire, const t_switchblock_edge& edge) {
+        return wire < edge.from_wire;
+    });
+
+    return vtr::array_view<const t_switchblock_edge>(edges_.data() + (first - edges_.begin()), last - first);
+}
+
+long t_sb_connection_map::lookup_index(int x, int y, e_side from_side, e_side to_side) const {
+    if (x < 0 || y < 0 || size_t(x) >= grid_width_ || size_t(y) >= grid_height_) {
+        return -1;
+    }
+    return ((long(x) * grid_height_ + y) * NUM_SIDES + from_side) * NUM_SIDES + to_side;
 }
 
 /* deallocates switch block connections sparse array */
 void free_switchblock_permutations(t_sb_connection_map* sb_conns) {
-    sb_conns->clear();
     delete sb_conns;
     sb_conns = nullptr;
-    /* the switch block unordered_map can get quite large and it doesn't seem like the program
+    /* the switch block connections can get quite large and it doesn't seem like the program
      * is interested in releasing the memory back to the OS after the map is cleared.
      * calling malloc_trim forces the program to give unused heap space back to the OS.
      * this significantly reduces memory usage during the routing stage when running multiple
@@ -553,7 +673,7 @@ static void get_switchpoint_wires(
 
 /* Compute the wire(s) that the wire at (x, y, from_side, to_side) should connect to.
  * sb_conns is updated with the result */
-static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_side, enum e_side to_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, t_switchblock_inf* sb, const DeviceGrid& grid, const t_wire_type_sizes* wire_type_sizes_x, const t_wire_type_sizes* wire_type_sizes_y, e_directionality directionality, t_sb_connection_map* sb_conns, vtr::RandState& rand_state, t_wireconn_scratchpad* scratchpad) {
+static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_side, enum e_side to_side, const t_chan_details& chan_details_x, const t_chan_details& chan_details_y, const t_switchblock_inf* sb, const DeviceGrid& grid, const t_wire_type_sizes* wire_type_sizes_x, const t_wire_type_sizes* wire_type_sizes_y, e_directionality directionality, std::vector<t_switchblock_connection>* sb_conns, vtr::RandState& rand_state, t_wireconn_scratchpad* scratchpad) {
     int from_x, from_y;                     /* index into source channel */
     int to_x, to_y;                         /* index into destination channel */
     t_rr_type from_chan_type, to_chan_type; /* the type of channel - i.e. CHANX or CHANY */
@@ -598,21 +718,18 @@ static void compute_wire_connections(int x_coord, int y_coord, enum e_side from_
     }
     /* iterate over all the wire connections specified for this switch block */
     for (int iconn = 0; iconn < (int)sb->wireconns.size(); iconn++) {
-        /* pointer to a connection specification between wire types/subsegment_nums */
-        t_wireconn_inf* wireconn_ptr = &sb->wireconns[iconn];
-
         /* compute the destination wire segments to which the source wire segment should connect based on the
-         * current wireconn */
+         * current wireconn (a connection specification between wire types/subsegment_nums) */
         compute_wireconn_connections(grid, directionality, from_chan_details, to_chan_details,
                                      sb_conn, from_x, from_y, to_x, to_y, from_chan_type, to_chan_type, wire_type_sizes_from,
-                                     wire_type_sizes_to, sb, wireconn_ptr, sb_conns, rand_state, scratchpad);
+                                     wire_type_sizes_to, sb, iconn, sb_conns, rand_state, scratchpad);
     }
 
     return;
 }
 
 /* computes the destination wire segments that a source wire segment at the coordinate 'sb_conn' (in
- * channel segment with coordinate from_x/from_y) should connect to based on the specified 'wireconn_ptr'.
+ * channel segment with coordinate from_x/from_y) should connect to based on the wireconn at index iwireconn of sb.
  * wireconn_ptr defines the source and destination sets of wire segments (based on wire segment type & switchpoint
  * as defined at the top of this file), and the indices of wires to connect to are relative to these sets */
 static void compute_wireconn_connections(
@@ -630,12 +747,14 @@ static void compute_wireconn_connections(
     const t_wire_type_sizes* wire_type_sizes_from,
     const t_wire_type_sizes* wire_type_sizes_to,
     const t_switchblock_inf* sb,
-    t_wireconn_inf* wireconn_ptr,
-    t_sb_connection_map* sb_conns,
+    int iwireconn,
+    std::vector<t_switchblock_connection>* sb_conns,
     vtr::RandState& rand_state,
     t_wireconn_scratchpad* scratchpad) {
     constexpr bool verbose = false;
 
+    const t_wireconn_inf* wireconn_ptr = &sb->wireconns[iwireconn];
+
     /* vectors that will contain indices of the wires belonging to the source/dest wire types/points */
 
     get_switchpoint_wires(grid,
@@ -701,7 +820,7 @@ static void compute_wireconn_connections(
     //      * interleave (to ensure good diversity)
 
     //Determine how many connections to make
-    int num_conns = evaluate_num_conns_formula(scratchpad, wireconn_ptr->num_conns_formula, potential_src_wires.size(), potential_dest_wires.size());
+    int num_conns = evaluate_num_conns_formula(scratchpad, scratchpad->sb_formulas->num_conns[iwireconn], potential_src_wires.size(), potential_dest_wires.size());
     VTR_ASSERT_MSG(num_conns >= 0, "Number of switchblock connections to create must be non-negative");
 
     VTR_LOGV(verbose, "  num_conns: %zu\n", num_conns);
@@ -732,22 +851,22 @@ static void compute_wireconn_connections(
 
         //Evaluate permutation functions for the from_wire
         SB_Side_Connection side_conn(sb_conn.from_side, sb_conn.to_side);
-        auto iter = sb->permutation_map.find(side_conn);
-        if (iter == sb->permutation_map.end()) {
+        auto iter = scratchpad->sb_formulas->permutations.find(side_conn);
+        if (iter == scratchpad->sb_formulas->permutations.end()) {
             continue;
         }
-        const std::vector<std::string>& permutations_ref = iter->second;
+        const std::vector<CompiledFormula>& permutations_ref = iter->second;
         for (int iperm = 0; iperm < (int)permutations_ref.size(); iperm++) {
             /* Convert the symbolic permutation formula to a number */
             t_formula_data& formula_data = scratchpad->formula_data;
             formula_data.clear();
             formula_data.set_var_value("W", dest_W);
             formula_data.set_var_value("t", src_wire_ind);
-            int raw_dest_wire_ind = get_sb_formula_raw_result(scratchpad->formula_parser, permutations_ref[iperm].c_str(), formula_data);
+            int raw_dest_wire_ind = permutations_ref[iperm].evaluate(formula_data);
             int dest_wire_ind = adjust_formula_result(raw_dest_wire_ind, src_W, dest_W, iconn);
 
             if (dest_wire_ind < 0) {
-                VPR_FATAL_ERROR(VPR_ERROR_ARCH, "Got a negative wire from switch block formula %s", permutations_ref[iperm].c_str());
+                VPR_FATAL_ERROR(VPR_ERROR_ARCH, "Got a negative wire from switch block formula %s", permutations_ref[iperm].formula().c_str());
             }
 
             int to_wire = potential_dest_wires[dest_wire_ind].wire; //Index in channel
@@ -766,8 +885,8 @@ static void compute_wireconn_connections(
             }
             VTR_LOGV(verbose, "  make_conn: %d -> %d switch=%d\n", sb_edge.from_wire, sb_edge.to_wire, sb_edge.switch_ind);
 
-            /* and now, finally, add this switchblock connection to the switchblock connections map */
-            (*sb_conns)[sb_conn].push_back(sb_edge);
+            /* and now, finally, add this switchblock connection to the switchblock connections */
+            sb_conns->push_back({sb_conn, sb_edge});
 
             /* If bidir architecture, implement the reverse connection as well */
             if (BI_DIRECTIONAL == directionality) {
@@ -778,20 +897,41 @@ static void compute_wireconn_connections(
                 //Coverity flags this (false positive), so annotatate so coverity ignores it:
                 // coverity[swapped_arguments : Intentional]
                 Switchblock_Lookup sb_conn_reverse(sb_conn.x_coord, sb_conn.y_coord, sb_conn.to_side, sb_conn.from_side);
-                (*sb_conns)[sb_conn_reverse].push_back(sb_reverse_edge);
+                sb_conns->push_back({sb_conn_reverse, sb_reverse_edge});
             }
         }
     }
 }
 
-static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, std::string num_conns_formula, int from_wire_count, int to_wire_count) {
+/* compiles the permutation and num_conns formulas of sb, so they are not parsed again at every location and wire */
+static void compile_switchblock_formulas(const t_switchblock_inf& sb, t_switchblock_formulas* sb_formulas) {
+    sb_formulas->permutations.clear();
+    sb_formulas->num_conns.clear();
+
+    try {
+        for (const auto& [side_conn, permutations] : sb.permutation_map) {
+            std::vector<CompiledFormula>& compiled_permutations = sb_formulas->permutations[side_conn];
+            for (const std::string& permutation : permutations) {
+                compiled_permutations.emplace_back(permutation);
+            }
+        }
+
+        for (const t_wireconn_inf& wireconn : sb.wireconns) {
+            sb_formulas->num_conns.emplace_back(wireconn.num_conns_formula);
+        }
+    } catch (const vtr::VtrError& error) {
+        VPR_FATAL_ERROR(VPR_ERROR_ARCH, "Invalid formula in switchblock %s: %s", sb.name.c_str(), error.what());
+    }
+}
+
+static int evaluate_num_conns_formula(t_wireconn_scratchpad* scratchpad, const CompiledFormula& num_conns_formula, int from_wire_count, int to_wire_count) {
     t_formula_data& vars = scratchpad->formula_data;
     vars.clear();
 
     vars.set_var_value("from", from_wire_count);
     vars.set_var_value("to", to_wire_count);
 
-    return scratchpad->formula_parser.parse_formula(num_conns_formula, vars);
+    return num_conns_formula.evaluate(vars);
 }
 
 /* Here we find the correct channel (x or y), and the coordinates to index into it based on the
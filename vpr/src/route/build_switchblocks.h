@@ -9,6 +9,7 @@
 #include "device_grid.h"
 
 #include "vtr_random.h"
+#include "vtr_array_view.h"
 
 /************ Classes, structs, typedefs ************/
 
@@ -40,7 +41,7 @@ class Switchblock_Lookup {
         to_side = set_to;
     }
 
-    /* Overload == operator which is used by std::unordered_map */
+    /* Overload == operator */
     bool operator==(const Switchblock_Lookup& obj) const {
         bool result;
         if (x_coord == obj.x_coord && y_coord == obj.y_coord
@@ -53,18 +54,6 @@ class Switchblock_Lookup {
     }
 };
 
-struct t_hash_Switchblock_Lookup {
-    size_t operator()(const Switchblock_Lookup& obj) const noexcept {
-        //TODO: use vtr::hash_combine
-        size_t result;
-        result = ((((std::hash<int>()(obj.x_coord)
-                     ^ std::hash<int>()(obj.y_coord) << 10)
-                    ^ std::hash<int>()((int)obj.from_side) << 20)
-                   ^ std::hash<int>()((int)obj.to_side) << 30));
-        return result;
-    }
-};
-
 /* contains the index of the destination wire segment within a channel
  * and the index of the switch used to connect to it */
 struct t_switchblock_edge {
@@ -73,13 +62,42 @@ struct t_switchblock_edge {
     short switch_ind;
 };
 
+/* a switchblock connection, and the switchblock side pair it is made at */
+struct t_switchblock_connection {
+    Switchblock_Lookup sb_conn;
+    t_switchblock_edge edge;
+};
+
 /* Switchblock connections are made as [x][y][from_side][to_side][from_wire_ind].
- * The Switchblock_Lookup class specifies these dimensions.
- * Furthermore, a source_wire at a given 5-d coordinate may connect to multiple destination wires so the value
- * of the map is a vector of destination wires.
- * A matrix specifying connections for all switchblocks in an FPGA would be sparse and possibly very large
- * so we use an unordered map to take advantage of the sparsity. */
-typedef std::unordered_map<Switchblock_Lookup, std::vector<t_switchblock_edge>, t_hash_Switchblock_Lookup> t_sb_connection_map;
+ * The Switchblock_Lookup class specifies the first four dimensions.
+ * Furthermore, a source_wire at a given 5-d coordinate may connect to multiple destination wires.
+ * A matrix specifying connections for all switchblocks in an FPGA would be sparse and possibly very large,
+ * so the connections are stored in a single flat array instead: grouped by Switchblock_Lookup (through a dense
+ * [x][y][from_side][to_side] offset array), and sorted by source wire within each group. */
+class t_sb_connection_map {
+  public:
+    /* builds the map of a grid_width x grid_height grid of switchblocks from the specified lists of connections.
+     * The connections of a switchblock side pair keep the relative order they have in their list, which must
+     * therefore all be in a single list */
+    t_sb_connection_map(size_t grid_width, size_t grid_height, const std::vector<std::vector<t_switchblock_connection>>& connection_lists);
+
+    /* returns the connections from wire from_wire at switchblock side pair (x, y, from_side, to_side) */
+    vtr::array_view<const t_switchblock_edge> edges(int x, int y, e_side from_side, e_side to_side, int from_wire) const;
+
+    /* returns the total number of connections */
+    size_t size() const { return edges_.size(); }
+
+  private:
+    /* returns the index of a switchblock side pair in edge_offsets_, or -1 if it is out of the grid */
+    long lookup_index(int x, int y, e_side from_side, e_side to_side) const;
+
+  private:
+    size_t grid_width_;
+    size_t grid_height_;
+
+    std::vector<size_t> edge_offsets_; /* [0..num_lookups] start of the connections of each switchblock side pair in edges_ */
+    std::vector<t_switchblock_edge> edges_;
+};
 
 /************ Functions ************/
 
@@ -33,6 +33,10 @@
 #include <map>
 #include <iterator>
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 #include "vtr_random.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -102,10 +106,44 @@ static float get_wire_homogeneity(const int Fc, const int nodes_per_chan, const
 static float get_hamming_proximity(const int Fc, const int num_pin_type_pins, const int exponent, const bool both_sides, const Conn_Block_Metrics* cb_metrics);
 /* Returns Lemieux's cost function for sparse crossbars (see his 2001 book) applied here to the connection block */
 static float get_lemieux_cost_func(const int exponent, const bool both_sides, const Conn_Block_Metrics* cb_metrics);
+/* computes the specified metric from scratch */
+static float get_metric(const e_metric metric, const int Fc, const int nodes_per_chan, const int num_pin_type_pins, const bool both_sides, const Conn_Block_Metrics* cb_metrics);
+/* returns the part of the specified metric that depends on the switches of the pin at 'pin_index' on 'side' to old_track and
+ * new_track. Moving a switch of this pin from old_track to new_track changes the metric by exactly the difference of this
+ * contribution after and before the move, so try_move doesn't have to recompute the whole metric */
+static float get_move_metric_contribution(const e_metric metric, const int Fc, const int nodes_per_chan, const int num_pin_type_pins, const bool both_sides, const int side, const int pin_index, const int old_track, const int new_track, const Conn_Block_Metrics* cb_metrics);
+
+/* the hamming proximity and Lemieux's cost function compare the pins of a block side with each other. if 'both_sides' is true, the
+ * pins of the opposite side are compared with them too. this function returns the compared pins of 'group' (a side, which is < 2 if
+ * both_sides is true) as (side, pin index) pairs, in the order in which the metrics compare them */
+static void get_pin_group(const int group, const bool both_sides, const Conn_Block_Metrics* cb_metrics, std::vector<std::pair<int, int> >* group_pins);
+/* returns the sum of the hamming proximity or Lemieux cost function terms over all the pin pairs of a pin group */
+static float get_pin_group_pairs_sum(const e_metric metric, const int exponent, const std::vector<std::pair<int, int> >& group_pins, const Conn_Block_Metrics* cb_metrics);
+/* returns the sum of the hamming proximity or Lemieux cost function terms over the pin pairs of a pin group that include the pin at 'ipin' */
+static float get_pin_pairs_sum_of_pin(const e_metric metric, const int exponent, const std::vector<std::pair<int, int> >& group_pins, const int ipin, const Conn_Block_Metrics* cb_metrics);
+/* returns the hamming proximity or Lemieux cost function term of a pair of pins, given the tracks of the pin that comes first in
+ * its pin group and the tracks of the other pin */
+static float get_pin_pair_term(const e_metric metric, const int exponent, const std::set<int>* pin_tracks, const std::set<int>* comp_pin_tracks);
+
+/* returns the pin diversity of a single pin */
+static float get_pin_diversity_of_pin(const int Fc, const int side, const int pin_index, const Conn_Block_Metrics* cb_metrics);
+/* gets the number of unconnected wires, the mean number of switches per wire and the normalization factor of the wire homogeneity of
+ * 'side' (along with the opposite side if both_sides is true). returns false if there are no pins on these sides */
+static bool get_wire_homogeneity_side_params(const int Fc, const int nodes_per_chan, const int exponent, const bool both_sides, const int side, const Conn_Block_Metrics* cb_metrics, int* unconnected_wires, float* mean, float* normalization);
+/* returns the wire homogeneity term of a single track of 'side' (along with the opposite side if both_sides is true) */
+static float get_wire_homogeneity_of_track(const int exponent, const bool both_sides, const int side, const int track, const float mean, const Conn_Block_Metrics* cb_metrics);
+
+/* returns whether the CB metrics of this block type and pin type should account for pins on both sides of a channel segment */
+static bool get_both_sides(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type);
+/* get and set the value of the specified metric in cb_metrics */
+static float get_metric_value(const e_metric metric, const Conn_Block_Metrics* cb_metrics);
+static void set_metric_value(const e_metric metric, const float value, Conn_Block_Metrics* cb_metrics);
 
 /* this annealer is used to adjust a desired wire or pin metric while keeping the other type of metric
  * relatively constant */
 static bool annealer(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, const float target_metric_tolerance, int***** pin_to_track_connections, Conn_Block_Metrics* cb_metrics);
+/* recomputes the adjusted metric and its orthogonal metric from scratch, and returns the resulting annealer cost */
+static double recompute_annealer_metrics(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, Conn_Block_Metrics* cb_metrics);
 /* updates temperature based on current temperature and the annealer's outer loop iteration */
 static double update_temp(const double temp);
 /* determines whether to accept or reject a proposed move based on the resulting delta of the cost and current temperature */
@@ -202,16 +240,7 @@ void get_conn_block_metrics(const t_physical_tile_type_ptr block_type, int*****
 
     /* check based on block type whether we should account for pins on both sides of a channel when computing the relevant CB metrics
      * (i.e. from a block on the left and from a block on the right for a vertical channel, for instance) */
-    bool both_sides = false;
-    if (0 == strcmp("clb", block_type->name) && DRIVER == pin_type) {
-        /* many CLBs are adjacent to eachother, so connections from one CLB
-         *  will share the channel segment with its neighbor. We'd like to take this into
-         *  account for the applicable metrics. */
-        both_sides = true;
-    } else {
-        /* other blocks (i.e. IO, RAM, etc) are not as frequent as CLBs */
-        both_sides = false;
-    }
+    bool both_sides = get_both_sides(block_type, pin_type);
 
     /* get the metrics */
     cb_metrics->wire_homogeneity = get_wire_homogeneity(Fc, nodes_per_chan, num_pin_type_pins, 2, both_sides, cb_metrics);
@@ -346,88 +375,56 @@ int get_max_Fc(const int* Fc_array, const t_physical_tile_type_ptr block_type, c
 /* returns the pin diversity metric of a block */
 static float get_pin_diversity(const int Fc, const int num_pin_type_pins, const Conn_Block_Metrics* cb_metrics) {
     float total_pin_diversity = 0;
-    float exp_factor = 3.3;
-    int num_wire_types = cb_metrics->num_wire_types;
 
     /* Determine the diversity of each pin. The concept of this function is that	*
      *  a pin connecting to a wire class more than once returns diminishing gains.	*
      *  This is modelled as an exponential function s.t. at large ratios of  	*
      *  connections/expected_connections we will always get (almost) the same 	*
      *  contribution to pin diversity.						*/
-    float mean = (float)Fc / (float)(num_wire_types);
     for (int iside = 0; iside < 4; iside++) {
         for (int ipin = 0; ipin < (int)cb_metrics->pin_locations.at(iside).size(); ipin++) {
-            float pin_diversity = 0;
-            for (int i = 0; i < num_wire_types; i++) {
-                pin_diversity += (1 / (float)num_wire_types) * (1 - exp(-exp_factor * (float)cb_metrics->wire_types_used_count.at(iside).at(ipin).at(i) / mean));
-            }
-            total_pin_diversity += pin_diversity;
+            total_pin_diversity += get_pin_diversity_of_pin(Fc, iside, ipin, cb_metrics);
         }
     }
     total_pin_diversity /= num_pin_type_pins;
     return total_pin_diversity;
 }
 
+/* returns the pin diversity of a single pin */
+static float get_pin_diversity_of_pin(const int Fc, const int side, const int pin_index, const Conn_Block_Metrics* cb_metrics) {
+    float exp_factor = 3.3;
+    int num_wire_types = cb_metrics->num_wire_types;
+
+    float mean = (float)Fc / (float)(num_wire_types);
+    float pin_diversity = 0;
+    for (int i = 0; i < num_wire_types; i++) {
+        pin_diversity += (1 / (float)num_wire_types) * (1 - exp(-exp_factor * (float)cb_metrics->wire_types_used_count.at(side).at(pin_index).at(i) / mean));
+    }
+    return pin_diversity;
+}
+
 /* Returns Lemieux's cost function for sparse crossbars (see his 2001 book) applied here to the connection block */
 static float get_lemieux_cost_func(const int exponent, const bool both_sides, const Conn_Block_Metrics* cb_metrics) {
     float lcf = 0;
 
-    const t_2d_int_vec* pin_locations = &cb_metrics->pin_locations;
-    const t_vec_vec_set* pin_to_tracks = &cb_metrics->pin_to_tracks;
-
     /* may want to calculate LCF for two sides at once to simulate presence of neighboring blocks */
     int mult = (both_sides) ? 2 : 1;
 
+    std::vector<std::pair<int, int> > group_pins;
     /* iterate over the sides */
     for (int iside = 0; iside < (4 / mult); iside++) {
-        /* how many pins do we need to iterate over? this depends on whether or not we take into
+        /* which pins do we need to compare? this depends on whether or not we take into
          * account pins on adjacent sides of a channel */
-        int num_pins = 0;
-        if (both_sides) {
-            num_pins = (int)pin_locations->at(iside).size() + (int)pin_locations->at(iside + 2).size();
-        } else {
-            num_pins = (int)pin_locations->at(iside).size();
-        }
+        get_pin_group(iside, both_sides, cb_metrics, &group_pins);
+        int num_pins = (int)group_pins.size();
 
-        if (0 == num_pins) {
+        /* a single pin has nothing to be compared to */
+        if (num_pins < 2) {
             continue;
         }
 
-        float lcf_pins = 0;
-        /* for each pin... */
-        int pin_comparisons = 0;
-        for (int ipin = 0; ipin < num_pins; ipin++) {
-            int pin_ind = ipin;
-            int pin_side = iside;
-            if (both_sides) {
-                if (ipin >= (int)pin_locations->at(iside).size()) {
-                    pin_side += 2;
-                    pin_ind = pin_ind % pin_locations->at(iside).size();
-                }
-            }
-            float pin_lcf = 0;
-            /* ...compare it's track connections to every other pin that we haven't already compared it to */
-            for (int icomp = ipin + 1; icomp < num_pins; icomp++) {
-                int comp_pin_ind = icomp;
-                int comp_side = iside;
-                if (both_sides) {
-                    if (icomp >= (int)pin_locations->at(iside).size()) {
-                        comp_side += 2;
-                        comp_pin_ind = comp_pin_ind % pin_locations->at(iside).size();
-                    }
-                }
-                pin_comparisons++;
-                /* get the hamming proximity between the tracks of the two pins being compared */
-                float pin_to_pin_lcf = (float)hamming_proximity_of_two_sets(&pin_to_tracks->at(pin_side).at(pin_ind), &pin_to_tracks->at(comp_side).at(comp_pin_ind));
-                pin_to_pin_lcf = 2 * ((int)pin_to_tracks->at(pin_side).at(pin_ind).size() - pin_to_pin_lcf);
-                if (0 == pin_to_pin_lcf) {
-                    pin_to_pin_lcf = 1;
-                }
-                pin_to_pin_lcf = pow(1.0 / pin_to_pin_lcf, exponent);
-                pin_lcf += pin_to_pin_lcf;
-            }
-            lcf_pins += pin_lcf;
-        }
+        /* compare the track connections of each pin to all the other pins */
+        float lcf_pins = get_pin_group_pairs_sum(LEMIEUX_COST_FUNC, exponent, group_pins, cb_metrics);
         lcf += lcf_pins / (0.5 * num_pins * (num_pins - 1));
     }
     lcf /= (4.0 / (both_sides ? 2.0 : 1.0));
@@ -439,58 +436,24 @@ static float get_lemieux_cost_func(const int exponent, const bool both_sides, co
 static float get_hamming_proximity(const int Fc, const int num_pin_type_pins, const int exponent, const bool both_sides, const Conn_Block_Metrics* cb_metrics) {
     float hamming_proximity = 0;
 
-    const t_2d_int_vec* pin_locations = &cb_metrics->pin_locations;
-    const t_vec_vec_set* pin_to_tracks = &cb_metrics->pin_to_tracks;
-
     /* may want to calculate HP for two sides at once to simulate presence of neighboring blocks */
     int mult = (both_sides) ? 2 : 1;
 
+    std::vector<std::pair<int, int> > group_pins;
     /* iterate over the sides */
     for (int iside = 0; iside < (4 / mult); iside++) {
-        /* how many pins do we need to iterate over? this depends on whether or not we take into
+        /* which pins do we need to compare? this depends on whether or not we take into
          * account pins on adjacent sides of a channel */
-        int num_pins = 0;
-        if (both_sides) {
-            num_pins = (int)pin_locations->at(iside).size() + (int)pin_locations->at(iside + 2).size();
-        } else {
-            num_pins = (int)pin_locations->at(iside).size();
-        }
+        get_pin_group(iside, both_sides, cb_metrics, &group_pins);
+        int num_pins = (int)group_pins.size();
 
-        if (0 == num_pins) {
+        /* a single pin has nothing to be compared to */
+        if (num_pins < 2) {
             continue;
         }
 
-        float hp_pins = 0;
-        /* for each pin... */
-        int pin_comparisons = 0;
-        for (int ipin = 0; ipin < num_pins; ipin++) {
-            int pin_ind = ipin;
-            int pin_side = iside;
-            if (both_sides) {
-                if (ipin >= (int)pin_locations->at(iside).size()) {
-                    pin_side += 2;
-                    pin_ind = pin_ind % pin_locations->at(iside).size();
-                }
-            }
-            float pin_hp = 0;
-            /* ...compare it's track connections to every other pin that we haven't already compared it to */
-            for (int icomp = ipin + 1; icomp < num_pins; icomp++) {
-                int comp_pin_ind = icomp;
-                int comp_side = iside;
-                if (both_sides) {
-                    if (icomp >= (int)pin_locations->at(iside).size()) {
-                        comp_side += 2;
-                        comp_pin_ind = comp_pin_ind % pin_locations->at(iside).size();
-                    }
-                }
-                pin_comparisons++;
-                /* get the hamming proximity between the tracks of the two pins being compared */
-                float pin_to_pin_hp = (float)hamming_proximity_of_two_sets(&pin_to_tracks->at(pin_side).at(pin_ind), &pin_to_tracks->at(comp_side).at(comp_pin_ind));
-                pin_to_pin_hp = pow(pin_to_pin_hp, exponent);
-                pin_hp += pin_to_pin_hp;
-            }
-            hp_pins += pin_hp;
-        }
+        /* compare the track connections of each pin to all the other pins */
+        float hp_pins = get_pin_group_pairs_sum(HAMMING_PROXIMITY, exponent, group_pins, cb_metrics);
         hamming_proximity += hp_pins * 2.0 / (float)((num_pins - 1) * pow(Fc, exponent));
     }
     hamming_proximity /= num_pin_type_pins;
@@ -498,6 +461,91 @@ static float get_hamming_proximity(const int Fc, const int num_pin_type_pins, co
     return hamming_proximity;
 }
 
+/* the hamming proximity and Lemieux's cost function compare the pins of a block side with each other. if 'both_sides' is true, the
+ * pins of the opposite side are compared with them too. this function returns the compared pins of 'group' (a side, which is < 2 if
+ * both_sides is true) as (side, pin index) pairs, in the order in which the metrics compare them */
+static void get_pin_group(const int group, const bool both_sides, const Conn_Block_Metrics* cb_metrics, std::vector<std::pair<int, int> >* group_pins) {
+    group_pins->clear();
+
+    int mult = (both_sides) ? 2 : 1;
+    for (int i = 0; i < mult; i++) {
+        int side = group + 2 * i;
+        for (int ipin = 0; ipin < (int)cb_metrics->pin_locations.at(side).size(); ipin++) {
+            group_pins->push_back(std::make_pair(side, ipin));
+        }
+    }
+}
+
+/* returns the sum of the hamming proximity or Lemieux cost function terms over all the pin pairs of a pin group */
+static float get_pin_group_pairs_sum(const e_metric metric, const int exponent, const std::vector<std::pair<int, int> >& group_pins, const Conn_Block_Metrics* cb_metrics) {
+    const t_vec_vec_set* pin_to_tracks = &cb_metrics->pin_to_tracks;
+    size_t num_pins = group_pins.size();
+
+    /* the pins are compared in parallel: each pin is compared to every other pin that comes after it in the group. The sums of
+     * the individual pins are then added up in order, so the result doesn't depend on the number of threads */
+    std::vector<float> pin_sums(num_pins, 0);
+    auto sum_pin_pairs = [&](size_t ipin) {
+        const std::set<int>* pin_tracks = &pin_to_tracks->at(group_pins[ipin].first).at(group_pins[ipin].second);
+        float pin_sum = 0;
+        for (size_t icomp = ipin + 1; icomp < num_pins; icomp++) {
+            pin_sum += get_pin_pair_term(metric, exponent, pin_tracks, &pin_to_tracks->at(group_pins[icomp].first).at(group_pins[icomp].second));
+        }
+        pin_sums[ipin] = pin_sum;
+    };
+#ifdef VPR_USE_TBB
+    tbb::parallel_for(size_t(0), num_pins, sum_pin_pairs);
+#else
+    for (size_t ipin = 0; ipin < num_pins; ipin++) {
+        sum_pin_pairs(ipin);
+    }
+#endif
+
+    float sum = 0;
+    for (float pin_sum : pin_sums) {
+        sum += pin_sum;
+    }
+    return sum;
+}
+
+/* returns the sum of the hamming proximity or Lemieux cost function terms over the pin pairs of a pin group that include the pin at 'ipin' */
+static float get_pin_pairs_sum_of_pin(const e_metric metric, const int exponent, const std::vector<std::pair<int, int> >& group_pins, const int ipin, const Conn_Block_Metrics* cb_metrics) {
+    const t_vec_vec_set* pin_to_tracks = &cb_metrics->pin_to_tracks;
+    const std::set<int>* pin_tracks = &pin_to_tracks->at(group_pins[ipin].first).at(group_pins[ipin].second);
+
+    float sum = 0;
+    for (int icomp = 0; icomp < (int)group_pins.size(); icomp++) {
+        if (icomp == ipin) {
+            continue;
+        }
+        const std::set<int>* comp_pin_tracks = &pin_to_tracks->at(group_pins[icomp].first).at(group_pins[icomp].second);
+        /* the terms of a pin pair are computed relative to the pin that comes first in the group */
+        if (icomp > ipin) {
+            sum += get_pin_pair_term(metric, exponent, pin_tracks, comp_pin_tracks);
+        } else {
+            sum += get_pin_pair_term(metric, exponent, comp_pin_tracks, pin_tracks);
+        }
+    }
+    return sum;
+}
+
+/* returns the hamming proximity or Lemieux cost function term of a pair of pins, given the tracks of the pin that comes first in
+ * its pin group and the tracks of the other pin */
+static float get_pin_pair_term(const e_metric metric, const int exponent, const std::set<int>* pin_tracks, const std::set<int>* comp_pin_tracks) {
+    /* get the hamming proximity between the tracks of the two pins being compared */
+    float term = (float)hamming_proximity_of_two_sets(pin_tracks, comp_pin_tracks);
+    if (LEMIEUX_COST_FUNC == metric) {
+        term = 2 * ((int)pin_tracks->size() - term);
+        if (0 == term) {
+            term = 1;
+        }
+        term = pow(1.0 / term, exponent);
+    } else {
+        VTR_ASSERT_SAFE(HAMMING_PROXIMITY == metric);
+        term = pow(term, exponent);
+    }
+    return term;
+}
+
 /* iterates through the elements of set 1 and returns the number of elements in set1 that are
  * also in set2 (in terms of bit vectors, this looks for the number of positions where both bit vectors
  * have a value of 1; values of 0 not counted... so, not quite true hamming proximity). Analogously, if we
@@ -520,51 +568,24 @@ static int hamming_proximity_of_two_sets(const std::set<int>* set1, const std::s
 static float get_wire_homogeneity(const int Fc, const int nodes_per_chan, const int num_pin_type_pins, const int exponent, const bool both_sides, const Conn_Block_Metrics* cb_metrics) {
     float total_wire_homogeneity = 0;
     float wire_homogeneity[4];
-    int counted_pins_per_side[4];
-
-    /* get the number of pins on each side */
-    const t_2d_int_vec* pin_locations = &cb_metrics->pin_locations;
-    for (int iside = 0; iside < 4; iside++) {
-        counted_pins_per_side[iside] = (int)pin_locations->at(iside).size();
-    }
 
     int unconnected_wires = 0;
-    int total_conns = 0;
-    int total_pins_on_side = 0;
     float mean = 0;
-    float wire_homogeneity_temp = 0;
+    float normalization = 0;
     /* If 'both_sides' is true, then the metric is calculated as if there is a block on both sides of the
      * channel. This is useful for frequently-occuring blocks like the CLB, which are packed together side by side */
     int mult = (both_sides) ? 2 : 1;
     /* and now compute the wire homogeneity metric */
     /* sides must be ordered as TOP, RIGHT, BOTTOM, LEFT. see the e_side enum */
     for (int side = 0; side < (4 / mult); side++) {
-        mean = 0;
-        unconnected_wires = 0;
-        total_conns = total_pins_on_side = 0;
-        for (int i = 0; i < mult; i++) {
-            total_pins_on_side += counted_pins_per_side[side + mult * i];
-        }
-
-        if (total_pins_on_side == 0) {
+        if (!get_wire_homogeneity_side_params(Fc, nodes_per_chan, exponent, both_sides, side, cb_metrics, &unconnected_wires, &mean, &normalization)) {
             continue;
         }
 
-        total_conns = total_pins_on_side * Fc;
-        unconnected_wires = (total_conns) ? std::max(0, nodes_per_chan - total_conns) : 0;
-        mean = (float)total_conns / (float)(nodes_per_chan - unconnected_wires);
         wire_homogeneity[side] = 0;
         for (int track = 0; track < nodes_per_chan; track++) {
-            wire_homogeneity_temp = 0;
-            for (int i = 0; i < mult; i++) {
-                if (counted_pins_per_side[side + i * mult] > 0) {
-                    /* only include sides with connected pins */
-                    wire_homogeneity_temp += (float)cb_metrics->track_to_pins.at(side + i * mult).at(track).size();
-                }
-            }
-            wire_homogeneity[side] += pow(fabs(wire_homogeneity_temp - mean), exponent);
+            wire_homogeneity[side] += get_wire_homogeneity_of_track(exponent, both_sides, side, track, mean, cb_metrics);
         }
-        float normalization = ((float)Fc * pow(((float)total_pins_on_side - mean), exponent) + (float)(nodes_per_chan - Fc) * pow(mean, exponent)) / (float)total_pins_on_side;
         wire_homogeneity[side] -= unconnected_wires * mean;
         wire_homogeneity[side] /= normalization;
         total_wire_homogeneity += wire_homogeneity[side];
@@ -574,6 +595,183 @@ static float get_wire_homogeneity(const int Fc, const int nodes_per_chan, const
     return total_wire_homogeneity;
 }
 
+/* gets the number of unconnected wires, the mean number of switches per wire and the normalization factor of the wire homogeneity of
+ * 'side' (along with the opposite side if both_sides is true). returns false if there are no pins on these sides */
+static bool get_wire_homogeneity_side_params(const int Fc, const int nodes_per_chan, const int exponent, const bool both_sides, const int side, const Conn_Block_Metrics* cb_metrics, int* unconnected_wires, float* mean, float* normalization) {
+    const t_2d_int_vec* pin_locations = &cb_metrics->pin_locations;
+    int mult = (both_sides) ? 2 : 1;
+
+    int total_pins_on_side = 0;
+    for (int i = 0; i < mult; i++) {
+        total_pins_on_side += (int)pin_locations->at(side + mult * i).size();
+    }
+
+    if (total_pins_on_side == 0) {
+        return false;
+    }
+
+    int total_conns = total_pins_on_side * Fc;
+    *unconnected_wires = (total_conns) ? std::max(0, nodes_per_chan - total_conns) : 0;
+    *mean = (float)total_conns / (float)(nodes_per_chan - *unconnected_wires);
+    *normalization = ((float)Fc * pow(((float)total_pins_on_side - *mean), exponent) + (float)(nodes_per_chan - Fc) * pow(*mean, exponent)) / (float)total_pins_on_side;
+    return true;
+}
+
+/* returns the wire homogeneity term of a single track of 'side' (along with the opposite side if both_sides is true) */
+static float get_wire_homogeneity_of_track(const int exponent, const bool both_sides, const int side, const int track, const float mean, const Conn_Block_Metrics* cb_metrics) {
+    int mult = (both_sides) ? 2 : 1;
+
+    float wire_homogeneity_temp = 0;
+    for (int i = 0; i < mult; i++) {
+        if (cb_metrics->pin_locations.at(side + i * mult).size() > 0) {
+            /* only include sides with connected pins */
+            wire_homogeneity_temp += (float)cb_metrics->track_to_pins.at(side + i * mult).at(track).size();
+        }
+    }
+    return pow(fabs(wire_homogeneity_temp - mean), exponent);
+}
+
+/* computes the specified metric from scratch */
+static float get_metric(const e_metric metric, const int Fc, const int nodes_per_chan, const int num_pin_type_pins, const bool both_sides, const Conn_Block_Metrics* cb_metrics) {
+    float value = 0;
+    switch (metric) {
+        case WIRE_HOMOGENEITY:
+            value = get_wire_homogeneity(Fc, nodes_per_chan, num_pin_type_pins, 2, both_sides, cb_metrics);
+            break;
+        case HAMMING_PROXIMITY:
+            value = get_hamming_proximity(Fc, num_pin_type_pins, 2, both_sides, cb_metrics);
+            break;
+        case LEMIEUX_COST_FUNC:
+            value = get_lemieux_cost_func(2, both_sides, cb_metrics);
+            break;
+        case PIN_DIVERSITY:
+            value = get_pin_diversity(Fc, num_pin_type_pins, cb_metrics);
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "get_metric: illegal CB metric: %d\n", (int)metric);
+            break;
+    }
+    return value;
+}
+
+/* returns the part of the specified metric that depends on the switches of the pin at 'pin_index' on 'side' to old_track and
+ * new_track. Moving a switch of this pin from old_track to new_track changes the metric by exactly the difference of this
+ * contribution after and before the move, so try_move doesn't have to recompute the whole metric */
+static float get_move_metric_contribution(const e_metric metric, const int Fc, const int nodes_per_chan, const int num_pin_type_pins, const bool both_sides, const int side, const int pin_index, const int old_track, const int new_track, const Conn_Block_Metrics* cb_metrics) {
+    /* the group of sides over which the wire metrics are computed together */
+    int group = (both_sides) ? side % 2 : side;
+
+    float contribution = 0;
+    switch (metric) {
+        case WIRE_HOMOGENEITY: {
+            /* only the switch counts of the old and new tracks change */
+            int unconnected_wires = 0;
+            float mean = 0;
+            float normalization = 0;
+            if (get_wire_homogeneity_side_params(Fc, nodes_per_chan, 2, both_sides, group, cb_metrics, &unconnected_wires, &mean, &normalization)) {
+                contribution = get_wire_homogeneity_of_track(2, both_sides, group, old_track, mean, cb_metrics)
+                               + get_wire_homogeneity_of_track(2, both_sides, group, new_track, mean, cb_metrics);
+                contribution /= normalization;
+                contribution /= num_pin_type_pins;
+            }
+            break;
+        }
+        case HAMMING_PROXIMITY:
+        case LEMIEUX_COST_FUNC: {
+            /* only the comparisons of the moved pin with the other pins of its group change */
+            static std::vector<std::pair<int, int> > group_pins;
+            get_pin_group(group, both_sides, cb_metrics, &group_pins);
+            int num_pins = (int)group_pins.size();
+            if (num_pins < 2) {
+                break;
+            }
+
+            /* the index of the moved pin in its group */
+            int ipin = pin_index;
+            if (side != group) {
+                ipin += (int)cb_metrics->pin_locations.at(group).size();
+            }
+
+            contribution = get_pin_pairs_sum_of_pin(metric, 2, group_pins, ipin, cb_metrics);
+            if (HAMMING_PROXIMITY == metric) {
+                contribution *= 2.0 / (float)((num_pins - 1) * pow(Fc, 2));
+                contribution /= num_pin_type_pins;
+            } else {
+                contribution /= (0.5 * num_pins * (num_pins - 1));
+                contribution /= (4.0 / (both_sides ? 2.0 : 1.0));
+            }
+            break;
+        }
+        case PIN_DIVERSITY:
+            /* only the diversity of the moved pin changes */
+            contribution = get_pin_diversity_of_pin(Fc, side, pin_index, cb_metrics);
+            contribution /= num_pin_type_pins;
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "get_move_metric_contribution: illegal CB metric: %d\n", (int)metric);
+            break;
+    }
+    return contribution;
+}
+
+/* returns whether the CB metrics of this block type and pin type should account for pins on both sides of a channel segment */
+static bool get_both_sides(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type) {
+    bool both_sides = false;
+    if (0 == strcmp("clb", block_type->name) && DRIVER == pin_type) {
+        /* many CLBs are adjacent to eachother, so connections from one CLB
+         *  will share the channel segment with its neighbor. We'd like to take this into
+         *  account for the applicable metrics. */
+        both_sides = true;
+    } else {
+        /* other blocks (i.e. IO, RAM, etc) are not as frequent as CLBs */
+        both_sides = false;
+    }
+    return both_sides;
+}
+
+/* get and set the value of the specified metric in cb_metrics */
+static float get_metric_value(const e_metric metric, const Conn_Block_Metrics* cb_metrics) {
+    float value = 0;
+    switch (metric) {
+        case WIRE_HOMOGENEITY:
+            value = cb_metrics->wire_homogeneity;
+            break;
+        case HAMMING_PROXIMITY:
+            value = cb_metrics->hamming_proximity;
+            break;
+        case LEMIEUX_COST_FUNC:
+            value = cb_metrics->lemieux_cost_func;
+            break;
+        case PIN_DIVERSITY:
+            value = cb_metrics->pin_diversity;
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "get_metric_value: illegal CB metric: %d\n", (int)metric);
+            break;
+    }
+    return value;
+}
+
+static void set_metric_value(const e_metric metric, const float value, Conn_Block_Metrics* cb_metrics) {
+    switch (metric) {
+        case WIRE_HOMOGENEITY:
+            cb_metrics->wire_homogeneity = value;
+            break;
+        case HAMMING_PROXIMITY:
+            cb_metrics->hamming_proximity = value;
+            break;
+        case LEMIEUX_COST_FUNC:
+            cb_metrics->lemieux_cost_func = value;
+            break;
+        case PIN_DIVERSITY:
+            cb_metrics->pin_diversity = value;
+            break;
+        default:
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "set_metric_value: illegal CB metric: %d\n", (int)metric);
+            break;
+    }
+}
+
 /* goes through each pin of pin_type and determines which side of the block it comes out on. results are stored in
  * the 'pin_locations' 2d-vector */
 static void get_pin_locations(const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int num_pin_type_pins, int***** tracks_connected_to_pin, t_2d_int_vec* pin_locations) {
@@ -676,16 +874,10 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
 
     /* for the CLB block types it is appropriate to account for pins on both sides of a channel segment when
      * calculating a CB metric (because CLBs are often found side by side) */
-    bool both_sides = false;
-    if (0 == strcmp("clb", block_type->name) && DRIVER == pin_type) {
-        /* many CLBs are adjacent to eachother, so connections from one CLB
-         *  will share the channel segment with its neighbor. We'd like to take this into
-         *  account for the applicable metrics. */
-        both_sides = true;
-    } else {
-        /* other blocks (i.e. IO, RAM, etc) are not as frequent as CLBs */
-        both_sides = false;
-    }
+    bool both_sides = get_both_sides(block_type, pin_type);
+
+    /* the metric we'd like to keep within tolerance of its initial value */
+    e_metric orthogonal_metric = (metric < NUM_WIRE_METRICS) ? PIN_DIVERSITY : WIRE_HOMOGENEITY;
 
     static std::vector<int> set_of_tracks;
     /* the set_of_tracks vector is used to find sets of tracks satisfying some criteria that we want. we reserve memory for it, which
@@ -732,6 +924,12 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
             int new_track = vtr::irand(set_of_tracks.size() - 1);
             new_track = set_of_tracks.at(new_track);
 
+            /* the metrics are updated incrementally: get the parts of the metrics that the move will change */
+            float old_metric_contribution = get_move_metric_contribution(metric, Fc, nodes_per_chan, num_pin_type_pins, both_sides,
+                                                                         rand_side, rand_pin_index, old_track, new_track, cb_metrics);
+            float old_orthogonal_contribution = get_move_metric_contribution(orthogonal_metric, Fc, nodes_per_chan, num_pin_type_pins, both_sides,
+                                                                             rand_side, rand_pin_index, old_track, new_track, cb_metrics);
+
             /* move the rand_pin's connection from the old track to the new track and see what the new cost is */
             /* update CB metrics structures */
             pin_to_tracks->at(rand_side).at(rand_pin_index).erase(old_track);
@@ -745,13 +943,10 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
 
             /* the orthogonal metric needs to stay within some tolerance of its initial value. here we get the
              * orthogonal metric after the above move */
-            if (metric < NUM_WIRE_METRICS) {
-                /* get the new pin diversity cost */
-                new_orthogonal_metric = get_pin_diversity(Fc, num_pin_type_pins, cb_metrics);
-            } else {
-                /* get the new wire homogeneity cost */
-                new_orthogonal_metric = get_wire_homogeneity(Fc, nodes_per_chan, num_pin_type_pins, 2, both_sides, cb_metrics);
-            }
+            new_orthogonal_metric = get_metric_value(orthogonal_metric, cb_metrics)
+                                    + get_move_metric_contribution(orthogonal_metric, Fc, nodes_per_chan, num_pin_type_pins, both_sides,
+                                                                   rand_side, rand_pin_index, old_track, new_track, cb_metrics)
+                                    - old_orthogonal_contribution;
 
             /* check if the orthogonal metric has remained within tolerance */
             if (new_orthogonal_metric >= initial_orthogonal_metric - orthogonal_metric_tolerance
@@ -759,26 +954,12 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
                 /* The orthogonal metric is within tolerance. Can proceed */
 
                 /* get the new metric */
-                new_metric = 0;
+                new_metric = get_metric_value(metric, cb_metrics)
+                             + get_move_metric_contribution(metric, Fc, nodes_per_chan, num_pin_type_pins, both_sides,
+                                                            rand_side, rand_pin_index, old_track, new_track, cb_metrics)
+                             - old_metric_contribution;
 
                 double delta_cost;
-                switch (metric) {
-                    case WIRE_HOMOGENEITY:
-                        new_metric = get_wire_homogeneity(Fc, nodes_per_chan, num_pin_type_pins, 2, both_sides, cb_metrics);
-                        break;
-                    case HAMMING_PROXIMITY:
-                        new_metric = get_hamming_proximity(Fc, num_pin_type_pins, 2, both_sides, cb_metrics);
-                        break;
-                    case LEMIEUX_COST_FUNC:
-                        new_metric = get_lemieux_cost_func(2, both_sides, cb_metrics);
-                        break;
-                    case PIN_DIVERSITY:
-                        new_metric = get_pin_diversity(Fc, num_pin_type_pins, cb_metrics);
-                        break;
-                    default:
-                        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "try_move: illegal CB metric being adjusted: %d\n", (int)metric);
-                        break;
-                }
                 new_cost = fabs(target_metric - new_metric);
                 delta_cost = new_cost - cost;
                 if (!accept_move(delta_cost, temp)) {
@@ -814,27 +995,8 @@ static double try_move(const e_metric metric, const int nodes_per_chan, const fl
                 pin_to_track_connections[rand_pin][0][0][rand_side][track_index] = new_track;
 
                 /* update metrics */
-                switch (metric) {
-                    case WIRE_HOMOGENEITY:
-                        cb_metrics->wire_homogeneity = new_metric;
-                        cb_metrics->pin_diversity = new_orthogonal_metric;
-                        break;
-                    case HAMMING_PROXIMITY:
-                        cb_metrics->hamming_proximity = new_metric;
-                        cb_metrics->pin_diversity = new_orthogonal_metric;
-                        break;
-                    case LEMIEUX_COST_FUNC:
-                        cb_metrics->lemieux_cost_func = new_metric;
-                        cb_metrics->pin_diversity = new_orthogonal_metric;
-                        break;
-                    case PIN_DIVERSITY:
-                        cb_metrics->pin_diversity = new_metric;
-                        cb_metrics->wire_homogeneity = new_orthogonal_metric;
-                        break;
-                    default:
-                        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "try_move: illegal CB metric: %d\n", (int)metric);
-                        break;
-                }
+                set_metric_value(metric, new_metric, cb_metrics);
+                set_metric_value(orthogonal_metric, new_orthogonal_metric, cb_metrics);
             }
         }
     }
@@ -898,6 +1060,12 @@ static bool annealer(const e_metric metric, const int nodes_per_chan, const t_ph
             }
         }
 
+        /* the metrics are updated incrementally by try_move. Recompute them every so often so that rounding errors
+         * don't accumulate */
+        if ((i_outer + 1) % CB_METRICS_RECOMPUTE_ITERATIONS == 0) {
+            cost = recompute_annealer_metrics(metric, nodes_per_chan, block_type, pin_type, Fc, num_pin_type_pins, target_metric, cb_metrics);
+        }
+
         temp = update_temp(temp);
 
         /* stop if temperature has decreased to 0 */
@@ -911,6 +1079,9 @@ static bool annealer(const e_metric metric, const int nodes_per_chan, const t_ph
         }
     }
 
+    /* get the exact final metrics */
+    cost = recompute_annealer_metrics(metric, nodes_per_chan, block_type, pin_type, Fc, num_pin_type_pins, target_metric, cb_metrics);
+
     if (cost <= target_metric_tolerance) {
         success = true;
     } else {
@@ -920,6 +1091,17 @@ static bool annealer(const e_metric metric, const int nodes_per_chan, const t_ph
     return success;
 }
 
+/* recomputes the adjusted metric and its orthogonal metric from scratch, and returns the resulting annealer cost */
+static double recompute_annealer_metrics(const e_metric metric, const int nodes_per_chan, const t_physical_tile_type_ptr block_type, const e_pin_type pin_type, const int Fc, const int num_pin_type_pins, const float target_metric, Conn_Block_Metrics* cb_metrics) {
+    bool both_sides = get_both_sides(block_type, pin_type);
+    e_metric orthogonal_metric = (metric < NUM_WIRE_METRICS) ? PIN_DIVERSITY : WIRE_HOMOGENEITY;
+
+    set_metric_value(metric, get_metric(metric, Fc, nodes_per_chan, num_pin_type_pins, both_sides, cb_metrics), cb_metrics);
+    set_metric_value(orthogonal_metric, get_metric(orthogonal_metric, Fc, nodes_per_chan, num_pin_type_pins, both_sides, cb_metrics), cb_metrics);
+
+    return fabs(get_metric_value(metric, cb_metrics) - target_metric);
+}
+
 /* updates temperature based on current temperature and the annealer's outer loop iteration */
 static double update_temp(const double temp) {
     double new_temp;
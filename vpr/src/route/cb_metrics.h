@@ -9,6 +9,8 @@
 #define INITIAL_TEMP 1
 #define LOWEST_TEMP 0.00001
 #define TEMP_DECREASE_FAC 0.999
+/* the annealer updates the metrics incrementally, and recomputes them from scratch every this many outer iterations */
+#define CB_METRICS_RECOMPUTE_ITERATIONS 1000
 
 /**** Enums ****/
 /* Defines the different kinds of metrics that we can adjust */
@@ -17,6 +17,11 @@
 #include "read_xml_arch_file.h"
 #include "route_tree.h"
 
+#ifdef VPR_USE_TBB
+#    include <atomic>
+#    include <tbb/parallel_for.h>
+#endif
+
 /******************** Subroutines local to this module **********************/
 static void check_node_and_range(RRNodeId inode,
                                  enum e_route_type route_type,
@@ -31,6 +36,14 @@ static void check_sink(const Netlist<>& net_list,
                        ParentNetId net_id,
                        bool* pin_done);
 
+static void check_net_route(const Netlist<>& net_list,
+                            ParentNetId net_id,
+                            enum e_route_type route_type,
+                            size_t num_switches,
+                            bool is_flat);
+template<typename F>
+static void check_each_net(const Netlist<>& net_list, F check_net);
+
 static void check_switch(const RouteTreeNode& rt_node, size_t num_switch);
 static bool check_adjacent(RRNodeId from_node, RRNodeId to_node, bool is_flat);
 static int chanx_chany_adjacent(RRNodeId chanx_node, RRNodeId chany_node);
@@ -65,9 +78,7 @@ void check_route(const Netlist<>& net_list,
         return;
     }
 
-    int max_pins;
-    unsigned int ipin;
-    bool valid, connects;
+    bool valid;
 
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
@@ -95,83 +106,120 @@ void check_route(const Netlist<>& net_list,
                                      is_flat);
     }
 
-    max_pins = 0;
-    for (auto net_id : net_list.nets())
-        max_pins = std::max(max_pins, (int)net_list.net_pins(net_id).size());
+    /* Now check that all nets are indeed connected. */
+    check_each_net(net_list, [&](ParentNetId net_id) {
+        check_net_route(net_list, net_id, route_type, num_switches, is_flat);
+    });
 
-    auto pin_done = std::make_unique<bool[]>(max_pins);
+    if (check_route_option == e_check_route_option::FULL) {
+        check_all_non_configurable_edges(net_list, is_flat);
+    } else {
+        VTR_ASSERT(check_route_option == e_check_route_option::QUICK);
+    }
 
-    /* Now check that all nets are indeed connected. */
-    for (auto net_id : net_list.nets()) {
-        if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
-            continue;
+    VTR_LOG("Completed routing consistency check successfully.\n");
+    VTR_LOG("\n");
+}
 
-        std::fill_n(pin_done.get(), net_list.net_pins(net_id).size(), false);
+/* Checks that the routing of net_id is a properly connected path from its *
+ * SOURCE to all of its SINKs.                                             */
+static void check_net_route(const Netlist<>& net_list,
+                            ParentNetId net_id,
+                            enum e_route_type route_type,
+                            size_t num_switches,
+                            bool is_flat) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+    auto& route_ctx = g_vpr_ctx.routing();
 
-        if (!route_ctx.route_trees[net_id]) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %d has no routing.\n", size_t(net_id));
-        }
+    if (net_list.net_is_ignored(net_id) || net_list.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
+        return;
 
-        /* Check the SOURCE of the net. */
-        RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
-        check_node_and_range(source_inode, route_type, is_flat);
-        check_source(net_list, source_inode, net_id, is_flat);
+    auto pin_done = std::make_unique<bool[]>(net_list.net_pins(net_id).size());
+    std::fill_n(pin_done.get(), net_list.net_pins(net_id).size(), false);
 
-        pin_done[0] = true;
+    if (!route_ctx.route_trees[net_id]) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %d has no routing.\n", size_t(net_id));
+    }
 
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
-            RRNodeId inode = rt_node.inode;
-            int net_pin_index = rt_node.net_pin_index;
-            check_node_and_range(inode, route_type, is_flat);
-            check_switch(rt_node, num_switches);
-
-            if (rt_node.parent()) {
-                connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
-                              describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
-                }
+    /* Check the SOURCE of the net. */
+    RRNodeId source_inode = route_ctx.route_trees[net_id].value().root().inode;
+    check_node_and_range(source_inode, route_type, is_flat);
+    check_source(net_list, source_inode, net_id, is_flat);
+
+    pin_done[0] = true;
+
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+        RRNodeId inode = rt_node.inode;
+        int net_pin_index = rt_node.net_pin_index;
+        check_node_and_range(inode, route_type, is_flat);
+        check_switch(rt_node, num_switches);
+
+        if (rt_node.parent()) {
+            bool connects = check_adjacent(rt_node.parent()->inode, rt_node.inode, is_flat);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, rt_node.parent()->inode, is_flat).c_str(),
+                          describe_rr_node(rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat).c_str());
             }
+        }
 
-            if (rr_graph.node_type(inode) == SINK) {
-                check_sink(net_list, inode, net_pin_index, net_id, pin_done.get());
-                num_sinks += 1;
-            }
+        if (rr_graph.node_type(inode) == SINK) {
+            check_sink(net_list, inode, net_pin_index, net_id, pin_done.get());
+            num_sinks += 1;
         }
+    }
+
+    if (num_sinks != net_list.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), net_list.net_name(net_id).c_str(),
+                        num_sinks, net_list.net_sinks(net_id).size());
+    }
 
-        if (num_sinks != net_list.net_sinks(net_id).size()) {
+    for (unsigned int ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
+        if (pin_done[ipin] == false) {
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), net_list.net_name(net_id).c_str(),
-                            num_sinks, net_list.net_sinks(net_id).size());
+                            "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
         }
+    }
 
-        for (ipin = 0; ipin < net_list.net_pins(net_id).size(); ipin++) {
-            if (pin_done[ipin] == false) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
-            }
-        }
+    check_net_for_stubs(net_list, net_id, is_flat);
+}
 
-        check_net_for_stubs(net_list, net_id, is_flat);
-    } /* End for each net */
+/* Calls check_net on every net of net_list. The nets are checked in        *
+ * parallel when VPR is built with TBB: the errors are then recorded per    *
+ * net, and the error of the first failing net (in netlist order) is        *
+ * re-thrown, so the reported error does not depend on thread scheduling.   */
+template<typename F>
+static void check_each_net(const Netlist<>& net_list, F check_net) {
+#ifdef VPR_USE_TBB
+    std::vector<ParentNetId> nets(net_list.nets().begin(), net_list.nets().end());
+    std::vector<std::unique_ptr<VprError>> net_errors(nets.size());
+
+    tbb::parallel_for(size_t(0), nets.size(), [&](size_t inet) {
+        try {
+            check_net(nets[inet]);
+        } catch (const VprError& error) {
+            net_errors[inet] = std::make_unique<VprError>(error);
+        }
+    });
 
-    if (check_route_option == e_check_route_option::FULL) {
-        check_all_non_configurable_edges(net_list, is_flat);
-    } else {
-        VTR_ASSERT(check_route_option == e_check_route_option::QUICK);
+    for (const auto& error : net_errors) {
+        if (error) throw *error;
     }
-
-    VTR_LOG("Completed routing consistency check successfully.\n");
-    VTR_LOG("\n");
+#else
+    for (auto net_id : net_list.nets()) {
+        check_net(net_id);
+    }
+#endif
 }
 
 /* Checks that this SINK node is one of the terminals of inet, and marks   *
@@ -478,6 +526,32 @@ void recompute_occupancy_from_scratch(const Netlist<>& net_list, bool is_flat) {
     auto& route_ctx = g_vpr_ctx.mutable_routing();
     auto& device_ctx = g_vpr_ctx.device();
 
+#ifdef VPR_USE_TBB
+    /* Go through each net and count the tracks and pins used everywhere.     *
+     * The nets are counted in parallel. An overused node is shared by several *
+     * nets, so the counts are accumulated atomically and then copied over    *
+     * the occupancy of every node.                                           */
+    std::vector<ParentNetId> nets(net_list.nets().begin(), net_list.nets().end());
+    std::vector<std::atomic<int>> node_occ(device_ctx.rr_graph.num_nodes());
+
+    tbb::parallel_for(size_t(0), nets.size(), [&](size_t inet) {
+        ParentNetId net_id = nets[inet];
+        if (!route_ctx.route_trees[net_id])
+            return;
+
+        if (net_list.net_is_ignored(net_id)) /* Skip ignored nets. */
+            return;
+
+        for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+            node_occ[size_t(rt_node.inode)].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    auto& cong_lane = route_ctx.rr_node_route_inf.cong_lane();
+    for (size_t inode = 0; inode < node_occ.size(); ++inode) {
+        cong_lane[RRNodeId(inode)].occ = node_occ[inode].load(std::memory_order_relaxed);
+    }
+#else
     /* First set the occupancy of everything to zero. */
     for (RRNodeId inode : device_ctx.rr_graph.nodes())
         route_ctx.rr_node_route_inf[inode].set_occ(0);
@@ -496,6 +570,7 @@ void recompute_occupancy_from_scratch(const Netlist<>& net_list, bool is_flat) {
             route_ctx.rr_node_route_inf[inode].set_occ(route_ctx.rr_node_route_inf[inode].occ() + 1);
         }
     }
+#endif
 
     /* We only need to reserve output pins if flat routing is not enabled */
     if (!is_flat) {
@@ -515,6 +590,9 @@ void recompute_occupancy_from_scratch(const Netlist<>& net_list, bool is_flat) {
             }
         }
     }
+
+    /* The occupancy was set directly, so the channel occupancy has to be rebuilt */
+    recompute_chan_occupancy();
 }
 
 static void check_locally_used_clb_opins(const t_clb_opins_used& clb_opins_used_locally,
@@ -588,12 +666,12 @@ static void check_all_non_configurable_edges(const Netlist<>& net_list, bool is_
     vtr::ScopedStartFinishTimer timer("Checking to ensure non-configurable edges are legal");
     auto non_configurable_rr_sets = identify_non_configurable_rr_sets();
 
-    for (auto net_id : net_list.nets()) {
+    check_each_net(net_list, [&](ParentNetId net_id) {
         check_non_configurable_edges(net_list,
                                      net_id,
                                      non_configurable_rr_sets,
                                      is_flat);
-    }
+    });
 }
 
 // Checks that the specified routing is legal with respect to non-configurable edges
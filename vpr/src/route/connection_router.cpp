@@ -3,8 +3,24 @@
 
 #include "binary_heap.h"
 #include "bucket.h"
+#include "four_ary_heap.h"
+#include "radix_heap.h"
 #include "rr_graph_fwd.h"
 
+#include <array>
+#include <queue>
+
+/** Number of out-edges timing_driven_expand_neighbours() prunes at once.
+ * Large enough for the pruning loop to be vectorized, small enough to live in registers/L1 */
+static constexpr size_t EXPANSION_BATCH_SIZE = 16;
+
+/** Connections more critical than this never use the bidirectional search, since its
+ * backward costs can't account for the upstream resistance */
+static constexpr float BIDIR_MAX_CRITICALITY = 0.5;
+
+/** Maximum number of nodes settled by the backward search of a bidirectional search */
+static constexpr size_t BIDIR_REVERSE_NODE_BUDGET = 2000;
+
 static inline bool relevant_node_to_target(const RRGraphView* rr_graph,
                                            RRNodeId node_to_add,
                                            RRNodeId target_node) {
@@ -85,7 +101,6 @@ std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_conne
         return std::make_tuple(true, /*retry=*/false, out);
     } else {
         reset_path_costs();
-        modified_rr_node_inf_.clear();
         heap_.empty_heap();
         return std::make_tuple(false, retry, t_heap());
     }
@@ -116,6 +131,7 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
                    bounding_box.xmin, bounding_box.ymin,
                    bounding_box.xmax, bounding_box.ymax);
 
+    prepare_bidir_search(source_node, sink_node, cost_params, bounding_box);
     t_heap* cheapest = timing_driven_route_connection_from_heap(sink_node,
                                                                 cost_params,
                                                                 bounding_box);
@@ -146,6 +162,7 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
         // when we were otherwise going to give up -- the typical case (route
         // found with the bounding box) remains fast and never re-tries .
         VTR_LOG_WARN("No routing path for connection to sink_rr %d, retrying with full device bounding box\n", sink_node);
+        router_stats_->full_device_bb_retries++;
 
         t_bb full_device_bounding_box;
         full_device_bounding_box.xmin = 0;
@@ -156,7 +173,7 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
         //
         //TODO: potential future optimization
         //      We have already explored the RR nodes accessible within the regular
-        //      BB (which are stored in modified_rr_node_inf), and so already know
+        //      BB (which are stamped with the current search epoch), and so already know
         //      their cost from the source. Instead of re-starting the path search
         //      from scratch (i.e. from the previous route tree as we do below), we
         //      could just re-add all the explored nodes to the heap and continue
@@ -167,7 +184,6 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
         //add_route_tree_to_heap() the nodes in the route tree actually
         //make it back into the heap.
         reset_path_costs();
-        modified_rr_node_inf_.clear();
         heap_.empty_heap();
 
         //Re-initialize the heap since it was emptied by the previous call to
@@ -176,6 +192,7 @@ std::tuple<bool, t_heap*> ConnectionRouter<Heap>::timing_driven_route_connection
         heap_.build_heap(); // via sifting down everything
 
         //Try finding the path again with the relaxed bounding box
+        prepare_bidir_search(source_node, sink_node, cost_params, full_device_bounding_box);
         cheapest = timing_driven_route_connection_from_heap(sink_node,
                                                             cost_params,
                                                             full_device_bounding_box);
@@ -234,11 +251,11 @@ std::tuple<bool, bool, t_heap> ConnectionRouter<Heap>::timing_driven_route_conne
         //Found no path, that may be due to an unlucky choice of existing route tree sub-set,
         //try again with the full route tree to be sure this is not an artifact of high-fanout routing
         VTR_LOG_WARN("No routing path found in high-fanout mode for net connection (to sink_rr %d), retrying with full route tree\n", sink_node);
+        router_stats_->high_fanout_full_tree_retries++;
 
         //Reset any previously recorded node costs so timing_driven_route_connection()
         //starts over from scratch.
         reset_path_costs();
-        modified_rr_node_inf_.clear();
 
         std::tie(retry_with_full_bb, cheapest) = timing_driven_route_connection_common_setup(rt_root,
                                                                                              sink_node,
@@ -300,9 +317,20 @@ t_heap* ConnectionRouter<Heap>::timing_driven_route_connection_from_heap(RRNodeI
         VTR_LOGV_DEBUG(router_debug_, "  Popping node %d (cost: %g)\n",
                        inode, cheapest->cost);
 
+        // With a bidirectional search, stop once no path left in the heap is expected to be
+        // cheaper than the best path through the backward search region
+        if (bidir_active_ && bidir_best_meet_.is_valid() && cheapest->cost >= bidir_best_meet_cost_) {
+            t_heap* meet_path = commit_bidir_meet(sink_node);
+            if (meet_path != nullptr) {
+                heap_.free(cheapest);
+                cheapest = meet_path;
+                break;
+            }
+        }
+
         // Have we found the target?
         if (inode == sink_node) {
-            // If we're running RCV, the path will be stored in the path_data->path_rr vector
+            // If we're running RCV, the path will be stored in the path manager's arena (from path_data->path_tail)
             // This is then placed into the traceback so that the correct path is returned
             // TODO: This can be eliminated by modifying the actual traceback function in route_timing
             if (rcv_path_manager.is_enabled()) {
@@ -318,11 +346,21 @@ t_heap* ConnectionRouter<Heap>::timing_driven_route_connection_from_heap(RRNodeI
                                       cost_params,
                                       bounding_box);
 
+        if (bidir_active_) {
+            update_bidir_meet(inode);
+        }
+
         rcv_path_manager.free_path_struct(cheapest->path_data);
         heap_.free(cheapest);
         cheapest = nullptr;
     }
 
+    if (cheapest == nullptr && bidir_active_ && bidir_best_meet_.is_valid()) {
+        // The heap ran out before the termination rule fired
+        cheapest = commit_bidir_meet(sink_node);
+    }
+    clear_bidir_search();
+
     if (router_debug_) {
         //Update known path costs for nodes pushed but not popped, useful for debugging
         empty_heap_annotating_node_route_inf();
@@ -423,9 +461,9 @@ void ConnectionRouter<Heap>::timing_driven_expand_cheapest(t_heap* cheapest,
                                                            t_bb bounding_box) {
     RRNodeId inode = cheapest->index;
 
-    t_rr_node_route_inf* route_inf = &rr_node_route_inf_[inode];
-    float best_total_cost = route_inf->path_cost;
-    float best_back_cost = route_inf->backward_path_cost;
+    t_rr_node_route_inf route_inf = search_inf(inode);
+    float best_total_cost = route_inf.path_cost;
+    float best_back_cost = route_inf.backward_path_cost;
 
     float new_total_cost = cheapest->cost;
     float new_back_cost = cheapest->backward_path_cost;
@@ -508,29 +546,73 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbours(t_heap* current,
         VTR_PREFETCH(&rr_switch_inf_[switch_idx], 0, 0);
     }
 
-    for (RREdgeId from_edge : edges) {
-        RRNodeId to_node = rr_nodes_.edge_sink_node(from_edge);
-        timing_driven_expand_neighbour(current,
-                                       from_node,
-                                       from_edge,
-                                       to_node,
-                                       cost_params,
-                                       bounding_box,
-                                       target_node,
-                                       target_bb);
+    // Expand the edges in batches. For each batch, first gather the sink nodes and run the
+    // cheap pruning checks in a tight, branch-free loop (which the compiler can vectorize),
+    // then only compute the full costs (congestion, delay, lookahead) for the survivors.
+    //
+    // Two checks are done in the pruning loop:
+    //  - BB-pruning: the sink node is entirely outside the (expanded) net bounding box.
+    //  - Dominance: the best known backward cost of the sink node is already no more than the
+    //    backward cost of the current node. Since costs are non-negative, the new path can't
+    //    have a lower backward cost, so timing_driven_add_to_heap() would reject it anyway.
+    // Both are disabled with RCV, since RCV doesn't prune on them (see timing_driven_add_to_heap()).
+    const bool rcv_enabled = rcv_path_manager.is_enabled();
+    const float current_back_cost = current->backward_path_cost;
+
+    std::array<RREdgeId, EXPANSION_BATCH_SIZE> batch_edges;
+    std::array<RRNodeId, EXPANSION_BATCH_SIZE> batch_nodes;
+    std::array<bool, EXPANSION_BATCH_SIZE> batch_keep;
+
+    auto edge_it = edges.begin();
+    while (edge_it != edges.end()) {
+        size_t batch_size = 0;
+        for (; batch_size < EXPANSION_BATCH_SIZE && edge_it != edges.end(); ++batch_size, ++edge_it) {
+            batch_edges[batch_size] = *edge_it;
+            batch_nodes[batch_size] = rr_nodes_.edge_sink_node(*edge_it);
+        }
+
+        for (size_t i = 0; i < batch_size; i++) {
+            RRNodeId to_node = batch_nodes[i];
+            bool outside_bb = (rr_graph_->node_xhigh(to_node) < bounding_box.xmin)  // Strictly left of BB left-edge
+                              | (rr_graph_->node_xlow(to_node) > bounding_box.xmax) // Strictly right of BB right-edge
+                              | (rr_graph_->node_yhigh(to_node) < bounding_box.ymin) // Strictly below BB bottom-edge
+                              | (rr_graph_->node_ylow(to_node) > bounding_box.ymax); // Strictly above BB top-edge
+            bool dominated = search_inf_const(to_node).backward_path_cost <= current_back_cost;
+            batch_keep[i] = rcv_enabled | !(outside_bb | dominated);
+        }
+
+        for (size_t i = 0; i < batch_size; i++) {
+            if (!batch_keep[i]) {
+                VTR_LOGV_DEBUG(router_debug_,
+                               "      Pruned expansion of node %d edge %zu -> %d"
+                               " (outside of expanded net bounding box %d,%dx%d,%d"
+                               " or no better than known backward cost %g)\n",
+                               from_node, size_t(batch_edges[i]), size_t(batch_nodes[i]),
+                               bounding_box.xmin, bounding_box.ymin, bounding_box.xmax, bounding_box.ymax,
+                               search_inf_const(batch_nodes[i]).backward_path_cost);
+                continue;
+            }
+            timing_driven_expand_neighbour(current,
+                                           from_node,
+                                           batch_edges[i],
+                                           batch_nodes[i],
+                                           cost_params,
+                                           target_node,
+                                           target_bb);
+        }
     }
 }
 
 // Conditionally adds to_node to the router heap (via path from from_node via from_edge).
-// RR nodes outside the expanded bounding box specified in bounding_box are not added
-// to the heap.
+// BB-pruning is done by the caller (timing_driven_expand_neighbours()).
+// Disable BB-pruning if RCV is enabled, as this can make it harder for circuits with high negative hold slack to resolve this
+// TODO: Only disable pruning if the net has negative hold slack, maybe go off budgets
 template<typename Heap>
 void ConnectionRouter<Heap>::timing_driven_expand_neighbour(t_heap* current,
                                                             RRNodeId from_node,
                                                             RREdgeId from_edge,
                                                             RRNodeId to_node,
                                                             const t_conn_cost_params cost_params,
-                                                            const t_bb bounding_box,
                                                             RRNodeId target_node,
                                                             const t_bb target_bb) {
     int to_xlow = rr_graph_->node_xlow(to_node);
@@ -538,24 +620,6 @@ void ConnectionRouter<Heap>::timing_driven_expand_neighbour(t_heap* current,
     int to_xhigh = rr_graph_->node_xhigh(to_node);
     int to_yhigh = rr_graph_->node_yhigh(to_node);
 
-    // BB-pruning
-    // Disable BB-pruning if RCV is enabled, as this can make it harder for circuits with high negative hold slack to resolve this
-    // TODO: Only disable pruning if the net has negative hold slack, maybe go off budgets
-    if ((to_xhigh < bounding_box.xmin    // Strictly left of BB left-edge
-         || to_xlow > bounding_box.xmax  // Strictly right of BB right-edge
-         || to_yhigh < bounding_box.ymin // Strictly below BB bottom-edge
-         || to_ylow > bounding_box.ymax) // Strictly above BB top-edge
-        && !rcv_path_manager.is_enabled()) {
-        VTR_LOGV_DEBUG(router_debug_,
-                       "      Pruned expansion of node %d edge %zu -> %d"
-                       " (to node location %d,%dx%d,%d outside of expanded"
-                       " net bounding box %d,%dx%d,%d)\n",
-                       from_node, size_t(from_edge), size_t(to_node),
-                       to_xlow, to_ylow, to_xhigh, to_yhigh,
-                       bounding_box.xmin, bounding_box.ymin, bounding_box.xmax, bounding_box.ymax);
-        return; /* Node is outside (expanded) bounding box. */
-    }
-
     /* Prune away IPINs that lead to blocks other than the target one.  Avoids  *
      * the issue of how to cost them properly so they don't get expanded before *
      * more promising routes, but makes route-through (via CLBs) impossible.   *
@@ -635,8 +699,9 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params
                                       from_edge,
                                       target_node);
 
-    float best_total_cost = rr_node_route_inf_[to_node].path_cost;
-    float best_back_cost = rr_node_route_inf_[to_node].backward_path_cost;
+    t_const_rr_node_route_inf to_route_inf = search_inf_const(to_node);
+    float best_total_cost = to_route_inf.path_cost;
+    float best_back_cost = to_route_inf.backward_path_cost;
 
     float new_total_cost = next.cost;
     float new_back_cost = next.backward_path_cost;
@@ -669,10 +734,7 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params
         next_ptr->set_prev_node(from_node);
 
         if (rcv_path_manager.is_enabled() && current->path_data) {
-            next_ptr->path_data->path_rr = current->path_data->path_rr;
-            next_ptr->path_data->edge = current->path_data->edge;
-            next_ptr->path_data->path_rr.emplace_back(from_node);
-            next_ptr->path_data->edge.emplace_back(from_edge);
+            rcv_path_manager.extend_path(next_ptr->path_data, current->path_data, from_node, from_edge);
         }
 
         heap_.add_to_heap(next_ptr);
@@ -699,15 +761,14 @@ void ConnectionRouter<Heap>::timing_driven_add_to_heap(const t_conn_cost_params
 static bool same_non_config_node_set(RRNodeId from_node, RRNodeId to_node) {
     auto& device_ctx = g_vpr_ctx.device();
 
-    auto from_itr = device_ctx.rr_node_to_non_config_node_set.find(from_node);
-    auto to_itr = device_ctx.rr_node_to_non_config_node_set.find(to_node);
+    int from_set = device_ctx.rr_non_config_node_sets.node_set(from_node);
+    int to_set = device_ctx.rr_non_config_node_sets.node_set(to_node);
 
-    if (from_itr == device_ctx.rr_node_to_non_config_node_set.end()
-        || to_itr == device_ctx.rr_node_to_non_config_node_set.end()) {
+    if (from_set == OPEN || to_set == OPEN) {
         return false; //Not part of a non-config node set
     }
 
-    return from_itr->second == to_itr->second; //Check for same non-config set IDs
+    return from_set == to_set; //Check for same non-config set IDs
 }
 
 #endif
@@ -764,6 +825,192 @@ void ConnectionRouter<Heap>::set_rcv_enabled(bool enable) {
     rcv_path_manager.set_enabled(enable);
 }
 
+template<typename Heap>
+void ConnectionRouter<Heap>::set_bidir_search_min_dist(int min_dist) {
+    VTR_ASSERT_MSG(min_dist < 0 || rr_nodes_.has_in_edges(),
+                   "Bidirectional search requires the RR graph in-edges to be built before the router is constructed");
+    bidir_search_min_dist_ = min_dist;
+}
+
+template<typename Heap>
+bool ConnectionRouter<Heap>::prepare_bidir_search(RRNodeId source_node,
+                                                  RRNodeId sink_node,
+                                                  const t_conn_cost_params cost_params,
+                                                  t_bb bounding_box) {
+    VTR_ASSERT_SAFE(!bidir_active_);
+
+    // RCV tracks whole paths in its own structures, which the stitching below doesn't update
+    if (bidir_search_min_dist_ < 0 || rcv_path_manager.is_enabled() || cost_params.criticality > BIDIR_MAX_CRITICALITY) {
+        return false;
+    }
+
+    int dist = std::abs(rr_graph_->node_xlow(source_node) - rr_graph_->node_xlow(sink_node))
+               + std::abs(rr_graph_->node_ylow(source_node) - rr_graph_->node_ylow(sink_node));
+    if (dist < bidir_search_min_dist_) {
+        return false;
+    }
+
+    if (bidir_reverse_cost_.empty()) {
+        bidir_reverse_cost_.resize(rr_nodes_.size(), std::numeric_limits<float>::infinity());
+        bidir_reverse_edge_.resize(rr_nodes_.size(), RREdgeId::INVALID());
+    }
+
+    // Bounded Dijkstra from the sink, over the in-edges. The cost of an edge is what
+    // evaluate_timing_driven_node_costs() would charge for it, less the R_upstream
+    // dependent part of the delay.
+    using t_reverse_heap_elem = std::pair<float, RRNodeId>;
+    std::priority_queue<t_reverse_heap_elem, std::vector<t_reverse_heap_elem>, std::greater<t_reverse_heap_elem>> reverse_heap;
+
+    bidir_reverse_cost_[size_t(sink_node)] = 0.;
+    bidir_reverse_touched_.push_back(sink_node);
+    reverse_heap.emplace(0., sink_node);
+
+    size_t num_settled = 0;
+    while (!reverse_heap.empty() && num_settled < BIDIR_REVERSE_NODE_BUDGET) {
+        float to_cost = reverse_heap.top().first;
+        RRNodeId to_node = reverse_heap.top().second;
+        reverse_heap.pop();
+
+        if (to_cost > bidir_reverse_cost_[size_t(to_node)]) {
+            continue; // Stale entry
+        }
+        num_settled++;
+
+        // OPINs are only reachable from their SOURCE, which the forward search starts from
+        t_rr_type to_type = rr_graph_->node_type(to_node);
+        if (to_type == OPIN || to_type == SOURCE) {
+            continue;
+        }
+
+        float to_cong_cost = (1. - cost_params.criticality) * get_rr_cong_cost(to_node, cost_params.pres_fac);
+
+        for (RREdgeId edge : rr_nodes_.node_in_edges(to_node)) {
+            RRNodeId from_node = rr_nodes_.edge_src_node(edge);
+            if (rr_graph_->node_xhigh(from_node) < bounding_box.xmin
+                || rr_graph_->node_xlow(from_node) > bounding_box.xmax
+                || rr_graph_->node_yhigh(from_node) < bounding_box.ymin
+                || rr_graph_->node_ylow(from_node) > bounding_box.ymax) {
+                continue;
+            }
+
+            int iswitch = rr_nodes_.edge_switch(edge);
+            float from_cost = to_cost + cost_params.criticality * rr_switch_inf_[iswitch].Tdel;
+            if (rr_switch_inf_[iswitch].configurable()) {
+                from_cost += to_cong_cost;
+            }
+            if (cost_params.bend_cost != 0.) {
+                t_rr_type from_type = rr_graph_->node_type(from_node);
+                if ((from_type == CHANX && to_type == CHANY) || (from_type == CHANY && to_type == CHANX)) {
+                    from_cost += cost_params.bend_cost;
+                }
+            }
+
+            float& best_from_cost = bidir_reverse_cost_[size_t(from_node)];
+            if (from_cost < best_from_cost) {
+                if (std::isinf(best_from_cost)) {
+                    bidir_reverse_touched_.push_back(from_node);
+                }
+                best_from_cost = from_cost;
+                bidir_reverse_edge_[size_t(from_node)] = edge;
+                reverse_heap.emplace(from_cost, from_node);
+            }
+        }
+    }
+
+    VTR_LOGV_DEBUG(router_debug_, "  Bidirectional search: backward search from %d settled %zu nodes\n", sink_node, num_settled);
+
+    router_stats_->bidir_searches++;
+    bidir_active_ = true;
+    bidir_best_meet_ = RRNodeId::INVALID();
+    bidir_best_meet_cost_ = std::numeric_limits<float>::infinity();
+    return true;
+}
+
+template<typename Heap>
+void ConnectionRouter<Heap>::clear_bidir_search() {
+    for (RRNodeId node : bidir_reverse_touched_) {
+        bidir_reverse_cost_[size_t(node)] = std::numeric_limits<float>::infinity();
+        bidir_reverse_edge_[size_t(node)] = RREdgeId::INVALID();
+    }
+    bidir_reverse_touched_.clear();
+    bidir_active_ = false;
+    bidir_best_meet_ = RRNodeId::INVALID();
+}
+
+template<typename Heap>
+void ConnectionRouter<Heap>::update_bidir_meet(RRNodeId inode) {
+    float reverse_cost = bidir_reverse_cost_[size_t(inode)];
+    if (std::isinf(reverse_cost)) {
+        return;
+    }
+
+    // The settled backward cost, i.e. the one of the path prev_edge records
+    float meet_cost = search_inf_const(inode).backward_path_cost + reverse_cost;
+    if (meet_cost < bidir_best_meet_cost_) {
+        bidir_best_meet_ = inode;
+        bidir_best_meet_cost_ = meet_cost;
+    }
+}
+
+template<typename Heap>
+t_heap* ConnectionRouter<Heap>::commit_bidir_meet(RRNodeId sink_node) {
+    RRNodeId meet_node = bidir_best_meet_;
+    bidir_best_meet_ = RRNodeId::INVALID();
+    bidir_best_meet_cost_ = std::numeric_limits<float>::infinity();
+
+    // Backward half, excluding the meet node itself
+    std::vector<RRNodeId> backward_path;
+    for (RRNodeId node = meet_node; node != sink_node;) {
+        node = rr_nodes_.edge_sink_node(bidir_reverse_edge_[size_t(node)]);
+        backward_path.push_back(node);
+    }
+
+    // If the forward half already goes through a node of the backward half, stitching the
+    // two would make the traceback loop. Fall back to the normal (unidirectional) search.
+    for (RRNodeId node = meet_node; search_inf_const(node).prev_edge != RREdgeId::INVALID(); node = search_inf_const(node).prev_node) {
+        if (std::find(backward_path.begin(), backward_path.end(), search_inf_const(node).prev_node) != backward_path.end()) {
+            VTR_LOGV_DEBUG(router_debug_, "  Bidirectional search: halves overlap at meet %d, continuing unidirectionally\n", meet_node);
+            bidir_active_ = false;
+            return nullptr;
+        }
+    }
+
+    VTR_LOGV_DEBUG(router_debug_, "  Bidirectional search: meet at %d\n", meet_node);
+    router_stats_->bidir_meets++;
+
+    float meet_back_cost = search_inf_const(meet_node).backward_path_cost;
+    float meet_reverse_cost = bidir_reverse_cost_[size_t(meet_node)];
+
+    RRNodeId prev_node = meet_node;
+    for (RRNodeId node : backward_path) {
+        RREdgeId edge = bidir_reverse_edge_[size_t(prev_node)];
+        float back_cost = meet_back_cost + meet_reverse_cost - bidir_reverse_cost_[size_t(node)];
+
+        if (node == sink_node) {
+            // The sink is recorded by the caller (see update_cheapest()), like for a normal search
+            t_heap* sink_heap = heap_.alloc();
+            sink_heap->index = sink_node;
+            sink_heap->set_prev_node(prev_node);
+            sink_heap->set_prev_edge(edge);
+            sink_heap->cost = back_cost;
+            sink_heap->backward_path_cost = back_cost;
+            sink_heap->R_upstream = 0.; // Recomputed by the route tree
+            return sink_heap;
+        }
+
+        t_rr_node_route_inf route_inf = search_inf(node);
+        route_inf.prev_node = prev_node;
+        route_inf.prev_edge = edge;
+        route_inf.path_cost = back_cost;
+        route_inf.backward_path_cost = back_cost;
+
+        prev_node = node;
+    }
+
+    VTR_ASSERT_MSG(false, "Backward path of a bidirectional search must end at the sink");
+    return nullptr;
+}
+
 //Calculates the cost of reaching to_node
 template<typename Heap>
 void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
@@ -872,10 +1119,14 @@ void ConnectionRouter<Heap>::evaluate_timing_driven_node_costs(t_heap* to,
     } else {
         const auto& device_ctx = g_vpr_ctx.device();
         //Update total cost
-        float expected_cost = router_lookahead_.get_expected_cost(to_node,
-                                                                  target_node,
-                                                                  cost_params,
-                                                                  to->R_upstream);
+        //Without a target (when finding the shortest paths to all nodes) there is nothing to look ahead to
+        float expected_cost = 0.;
+        if (target_node != RRNodeId::INVALID()) {
+            expected_cost = router_lookahead_.get_expected_cost(to_node,
+                                                                target_node,
+                                                                cost_params,
+                                                                to->R_upstream);
+        }
         VTR_LOGV_DEBUG(router_debug_ && !std::isfinite(expected_cost),
                        "        Lookahead from %s (%s) to %s (%s) is non-finite, expected_cost = %f, to->R_upstream = %f\n",
                        rr_node_arch_name(to_node, is_flat_).c_str(),
@@ -899,9 +1150,9 @@ void ConnectionRouter<Heap>::empty_heap_annotating_node_route_inf() {
     while (!heap_.is_empty_heap()) {
         t_heap* tmp = heap_.get_heap_head();
 
-        rr_node_route_inf_[tmp->index].path_cost = tmp->cost;
-        rr_node_route_inf_[tmp->index].backward_path_cost = tmp->backward_path_cost;
-        modified_rr_node_inf_.push_back(tmp->index);
+        t_rr_node_route_inf route_inf = search_inf(tmp->index);
+        route_inf.path_cost = tmp->cost;
+        route_inf.backward_path_cost = tmp->backward_path_cost;
 
         rcv_path_manager.free_path_struct(tmp->path_data);
         heap_.free(tmp);
@@ -977,18 +1228,20 @@ void ConnectionRouter<Heap>::add_route_tree_node_to_heap(
 
     if (!rcv_path_manager.is_enabled()) {
         // tot_cost = backward_path_cost + cost_params.astar_fac * expected_cost;
-        float tot_cost = backward_path_cost
-                         + cost_params.astar_fac
-                               * router_lookahead_.get_expected_cost(inode,
-                                                                     target_node,
-                                                                     cost_params,
-                                                                     R_upstream);
+        float tot_cost = backward_path_cost;
+        if (target_node != RRNodeId::INVALID()) {
+            tot_cost += cost_params.astar_fac
+                        * router_lookahead_.get_expected_cost(inode,
+                                                              target_node,
+                                                              cost_params,
+                                                              R_upstream);
+        }
         VTR_LOGV_DEBUG(router_debug_, "  Adding node %8d to heap from init route tree with cost %g (%s)\n",
                        inode,
                        tot_cost,
                        describe_rr_node(device_ctx.rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, inode, is_flat_).c_str());
 
-        push_back_node(&heap_, rr_node_route_inf_,
+        push_back_node(&heap_, SearchRouteInf{*this},
                        inode, tot_cost, RRNodeId::INVALID(), RREdgeId::INVALID(),
                        backward_path_cost, R_upstream);
     } else {
@@ -1128,7 +1381,7 @@ std::unique_ptr<ConnectionRouterInterface> make_connection_router(e_heap_type he
                                                                   const RRGraphView* rr_graph,
                                                                   const std::vector<t_rr_rc_data>& rr_rc_data,
                                                                   const vtr::vector<RRSwitchId, t_rr_switch_inf>& rr_switch_inf,
-                                                                  vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf,
+                                                                  t_rr_node_route_inf_storage& rr_node_route_inf,
                                                                   bool is_flat) {
     switch (heap_type) {
         case e_heap_type::BINARY_HEAP:
@@ -1151,6 +1404,26 @@ std::unique_ptr<ConnectionRouterInterface> make_connection_router(e_heap_type he
                 rr_switch_inf,
                 rr_node_route_inf,
                 is_flat);
+        case e_heap_type::FOUR_ARY_HEAP:
+            return std::make_unique<ConnectionRouter<FourAryHeap>>(
+                grid,
+                router_lookahead,
+                rr_nodes,
+                rr_graph,
+                rr_rc_data,
+                rr_switch_inf,
+                rr_node_route_inf,
+                is_flat);
+        case e_heap_type::RADIX_HEAP:
+            return std::make_unique<ConnectionRouter<RadixHeap>>(
+                grid,
+                router_lookahead,
+                rr_nodes,
+                rr_graph,
+                rr_rc_data,
+                rr_switch_inf,
+                rr_node_route_inf,
+                is_flat);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d",
                             heap_type);
@@ -31,7 +31,7 @@ class ConnectionRouter : public ConnectionRouterInterface {
         const RRGraphView* rr_graph,
         const std::vector<t_rr_rc_data>& rr_rc_data,
         const vtr::vector<RRSwitchId, t_rr_switch_inf>& rr_switch_inf,
-        vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf,
+        t_rr_node_route_inf_storage& rr_node_route_inf,
         bool is_flat)
         : grid_(grid)
         , router_lookahead_(router_lookahead)
@@ -44,20 +44,19 @@ class ConnectionRouter : public ConnectionRouterInterface {
         , rr_node_route_inf_(rr_node_route_inf)
         , is_flat_(is_flat)
         , router_stats_(nullptr)
-        , router_debug_(false) {
+        , router_debug_(false)
+        , bidir_search_min_dist_(-1)
+        , bidir_active_(false)
+        , bidir_best_meet_cost_(std::numeric_limits<float>::infinity())
+        , search_epoch_(new_rr_node_route_search_epoch()) {
         heap_.init_heap(grid);
         heap_.set_prune_limit(rr_nodes_.size(), kHeapPruneFactor * rr_nodes_.size());
     }
 
-    // Clear's the modified list.  Should be called after reset_path_costs
-    // have been called.
-    void clear_modified_rr_node_info() final {
-        modified_rr_node_inf_.clear();
-    }
-
-    // Reset modified data in rr_node_route_inf based on modified_rr_node_inf.
+    // Start a new search epoch: the path costs written by the previous
+    // searches become stale, and read as unset, without touching them.
     void reset_path_costs() final {
-        ::reset_path_costs(modified_rr_node_inf_);
+        search_epoch_ = new_rr_node_route_search_epoch();
     }
 
     /** Finds a path from the route tree rooted at rt_root to sink_node.
@@ -128,28 +127,38 @@ class ConnectionRouter : public ConnectionRouterInterface {
     // Ensure route budgets have been calculated before enabling this
     void set_rcv_enabled(bool enable) final;
 
+    void set_bidir_search_min_dist(int min_dist) final;
+
   private:
-    // Mark that data associated with rr_node "inode" has been modified, and
-    // needs to be reset in reset_path_costs.
-    void add_to_mod_list(RRNodeId inode) {
-        if (std::isinf(rr_node_route_inf_[inode].path_cost)) {
-            modified_rr_node_inf_.push_back(inode);
-        }
+    // Returns the routing information of inode in the current search, claiming it
+    // for writing (stale data of previous searches is reset first).
+    inline t_rr_node_route_inf search_inf(RRNodeId inode) {
+        return rr_node_route_inf_.search_inf(inode, search_epoch_);
+    }
+
+    // Returns the routing information of inode in the current search, read-only.
+    inline t_const_rr_node_route_inf search_inf_const(RRNodeId inode) const {
+        return const_cast<const t_rr_node_route_inf_storage&>(rr_node_route_inf_).search_inf(inode, search_epoch_);
     }
 
+    // Indexes the routing information of the current search,
+    // for the helpers of route_common.h such as push_back_node()
+    struct SearchRouteInf {
+        const ConnectionRouter& router;
+        t_const_rr_node_route_inf operator[](RRNodeId inode) const { return router.search_inf_const(inode); }
+    };
+
     // Update the route path to the node pointed to by cheapest.
     inline void update_cheapest(t_heap* cheapest) {
-        update_cheapest(cheapest, &rr_node_route_inf_[cheapest->index]);
+        update_cheapest(cheapest, search_inf(cheapest->index));
     }
 
-    inline void update_cheapest(t_heap* cheapest, t_rr_node_route_inf* route_inf) {
+    inline void update_cheapest(t_heap* cheapest, t_rr_node_route_inf route_inf) {
         //Record final link to target
-        add_to_mod_list(cheapest->index);
-
-        route_inf->prev_node = cheapest->prev_node();
-        route_inf->prev_edge = cheapest->prev_edge();
-        route_inf->path_cost = cheapest->cost;
-        route_inf->backward_path_cost = cheapest->backward_path_cost;
+        route_inf.prev_node = cheapest->prev_node();
+        route_inf.prev_edge = cheapest->prev_edge();
+        route_inf.path_cost = cheapest->cost;
+        route_inf.backward_path_cost = cheapest->backward_path_cost;
     }
 
     /** Common logic from timing_driven_route_connection_from_route_tree and
@@ -200,15 +209,14 @@ class ConnectionRouter : public ConnectionRouterInterface {
     // Conditionally adds to_node to the router heap (via path from from_node
     // via from_edge).
     //
-    // RR nodes outside bounding box specified in bounding_box are not added
-    // to the heap.
+    // Expects the caller to have BB-pruned to_node already (see
+    // timing_driven_expand_neighbours).
     void timing_driven_expand_neighbour(
         t_heap* current,
         RRNodeId from_node,
         RREdgeId from_edge,
         RRNodeId to_node,
         const t_conn_cost_params cost_params,
-        const t_bb bounding_box,
         RRNodeId target_node,
         const t_bb target_bb);
 
@@ -263,6 +271,44 @@ class ConnectionRouter : public ConnectionRouterInterface {
         const t_conn_cost_params cost_params,
         bool is_high_fanout);
 
+    /* Bidirectional (meet-in-the-middle) search
+     *
+     * For a long, non-critical connection, prepare_bidir_search() runs a bounded
+     * Dijkstra search backwards from the sink over the in-edges of the RR graph.
+     * It records, for every node it reaches, the cost of the cheapest known path
+     * from that node to the sink and the first edge of that path.
+     *
+     * The forward search then treats every node it settles inside that region as
+     * a candidate "meet": forward path cost + backward cost to the sink. It stops
+     * as soon as the cheapest heap key is no lower than the best meet. Both sides
+     * are compared in the same units as the heap keys (backward cost + astar_fac *
+     * lookahead), so this is as exact as the lookahead itself: with an admissible
+     * lookahead the meet is optimal, with the (inadmissible) map lookahead it is
+     * a comparable approximation.
+     *
+     * The backward costs only know the intrinsic switch delays (R_upstream is only
+     * known going forwards), which is why only non-critical connections use it.
+     * Timing of the final path is recomputed by the route tree as usual. */
+
+    // Returns true if the bidirectional search was set up for this connection
+    bool prepare_bidir_search(RRNodeId source_node,
+                              RRNodeId sink_node,
+                              const t_conn_cost_params cost_params,
+                              t_bb bounding_box);
+
+    // Forget the backward search results
+    void clear_bidir_search();
+
+    // Called by the forward search after it settled inode: record inode as a meet
+    // if it is the best one so far
+    void update_bidir_meet(RRNodeId inode);
+
+    // Stitch the backward path from the best meet onto the forward path by
+    // writing it into rr_node_route_inf, and return a heap element for the sink
+    // (so the callers can trace back from it like from a normal search result).
+    // Returns nullptr if the two halves overlap, in which case the meet is dropped.
+    t_heap* commit_bidir_meet(RRNodeId sink_node);
+
     t_bb add_high_fanout_route_tree_to_heap(
         const RouteTreeNode& rt_root,
         RRNodeId target_node,
@@ -278,9 +324,8 @@ class ConnectionRouter : public ConnectionRouterInterface {
     vtr::array_view<const t_rr_switch_inf> rr_switch_inf_;
     const vtr::vector<ParentNetId, std::vector<std::vector<int>>>& net_terminal_groups;
     const vtr::vector<ParentNetId, std::vector<int>>& net_terminal_group_num;
-    vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf_;
+    t_rr_node_route_inf_storage& rr_node_route_inf_;
     bool is_flat_;
-    std::vector<RRNodeId> modified_rr_node_inf_;
     RouterStats* router_stats_;
     const ConnectionParameters* conn_params_;
     HeapImplementation heap_;
@@ -288,6 +333,19 @@ class ConnectionRouter : public ConnectionRouterInterface {
 
     // The path manager for RCV, keeps track of the route tree as a set, also manages the allocation of the heap types
     PathManager rcv_path_manager;
+
+    // Bidirectional search state (see prepare_bidir_search()).
+    // The per-node vectors are only allocated once bidirectional search is first used.
+    int bidir_search_min_dist_;
+    bool bidir_active_;
+    std::vector<float> bidir_reverse_cost_;       // Cost from node to the sink, infinity if unknown
+    std::vector<RREdgeId> bidir_reverse_edge_;    // First edge of the cheapest known path from node to the sink
+    std::vector<RRNodeId> bidir_reverse_touched_; // Nodes with a finite bidir_reverse_cost_
+    RRNodeId bidir_best_meet_;
+    float bidir_best_meet_cost_;
+
+    // Epoch of the current search in rr_node_route_inf_ (see t_rr_node_route_search_inf::search_epoch)
+    uint32_t search_epoch_;
 };
 
 /** Construct a connection router that uses the specified heap type.
@@ -303,7 +361,7 @@ std::unique_ptr<ConnectionRouterInterface> make_connection_router(
     const RRGraphView* rr_graph,
     const std::vector<t_rr_rc_data>& rr_rc_data,
     const vtr::vector<RRSwitchId, t_rr_switch_inf>& rr_switch_inf,
-    vtr::vector<RRNodeId, t_rr_node_route_inf>& rr_node_route_inf,
+    t_rr_node_route_inf_storage& rr_node_route_inf,
     bool is_flat);
 
 #endif /* _CONNECTION_ROUTER_H */
@@ -37,11 +37,8 @@ class ConnectionRouterInterface {
   public:
     virtual ~ConnectionRouterInterface() {}
 
-    // Clear's the modified list.  Should be called after reset_path_costs
-    // have been called.
-    virtual void clear_modified_rr_node_info() = 0;
-
-    // Reset modified data in rr_node_route_inf based on modified_rr_node_inf.
+    // Forget the path costs recorded in rr_node_route_inf by the previous
+    // searches, so the next search starts from scratch.
     virtual void reset_path_costs() = 0;
 
     /** Finds a path from the route tree rooted at rt_root to sink_node.
@@ -113,6 +110,13 @@ class ConnectionRouterInterface {
     //
     // Ensure route budgets have been calculated before enabling this
     virtual void set_rcv_enabled(bool enable) = 0;
+
+    // Route non-critical connections spanning at least min_dist tiles with a
+    // bidirectional search. A negative min_dist disables it.
+    //
+    // Requires the in-edges of the RR graph (see RRGraphBuilder::init_in_edges)
+    // to have been built before the router was constructed.
+    virtual void set_bidir_search_min_dist(int min_dist) = 0;
 };
 
 #endif /* _CONNECTION_ROUTER_INTERFACE_H */
@@ -67,21 +67,7 @@ t_non_configurable_rr_sets EdgeGroups::output_sets() {
 
 // Set device context structures for non-configurable node sets.
 void EdgeGroups::set_device_context(DeviceContext& device_ctx) {
-    std::vector<std::vector<RRNodeId>> rr_non_config_node_sets;
-    for (const auto& item : rr_non_config_node_sets_) {
-        rr_non_config_node_sets.emplace_back(std::move(item));
-    }
-
-    std::unordered_map<RRNodeId, int> rr_node_to_non_config_node_set;
-    for (size_t set = 0; set < rr_non_config_node_sets.size(); ++set) {
-        for (const auto inode : rr_non_config_node_sets[set]) {
-            rr_node_to_non_config_node_set.insert(
-                std::make_pair(inode, set));
-        }
-    }
-
-    device_ctx.rr_non_config_node_sets = std::move(rr_non_config_node_sets);
-    device_ctx.rr_node_to_non_config_node_set = std::move(rr_node_to_non_config_node_set);
+    device_ctx.rr_non_config_node_sets.init(device_ctx.rr_graph.num_nodes(), rr_non_config_node_sets_);
 }
 
 // Perform a DFS traversal marking everything reachable with the same set id
@@ -0,0 +1,227 @@
+#include "four_ary_heap.h"
+#include "rr_graph_fwd.h"
+#include "vtr_log.h"
+
+FourAryHeap::FourAryHeap()
+    : groups_()
+    , heap_tail_(ROOT)
+    , max_index_(std::numeric_limits<size_t>::max())
+    , prune_limit_(std::numeric_limits<size_t>::max()) {}
+
+FourAryHeap::~FourAryHeap() {
+    free_all_memory();
+}
+
+t_heap* FourAryHeap::alloc() {
+    return storage_.alloc();
+}
+void FourAryHeap::free(t_heap* hptr) {
+    storage_.free(hptr);
+}
+
+void FourAryHeap::init_heap(const DeviceGrid& grid) {
+    size_t target_heap_size = (grid.width() - 1) * (grid.height() - 1);
+    if (groups_.empty() || size_t(capacity() - ROOT) < target_heap_size) {
+        groups_.clear();
+        groups_.resize((target_heap_size + ROOT) / 4 + 1);
+    }
+    heap_tail_ = ROOT;
+}
+
+void FourAryHeap::add_to_heap(t_heap* hptr) {
+    expand_heap_if_full();
+    // start with undefined hole
+    ++heap_tail_;
+    sift_up(heap_tail_ - 1, {hptr, hptr->cost});
+
+    // If we have pruned, rebuild the heap now.
+    if (check_prune_limit()) {
+        build_heap();
+    }
+}
+
+bool FourAryHeap::is_empty_heap() const {
+    return heap_tail_ == ROOT;
+}
+
+t_heap* FourAryHeap::get_heap_head() {
+    /* Returns a pointer to the smallest element on the heap, or NULL if the     *
+     * heap is empty.  Invalid (index == OPEN) entries on the heap are never     *
+     * returned -- they are just skipped over.                                   */
+    t_heap* cheapest;
+
+    do {
+        if (heap_tail_ == ROOT) { /* Empty heap. */
+            VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
+            return (nullptr);
+        }
+
+        cheapest = slot(ROOT).elem;
+
+        --heap_tail_;
+        if (heap_tail_ != ROOT) {
+            slot(ROOT) = slot(heap_tail_);
+            sift_down(ROOT);
+        }
+    } while (!cheapest->index.is_valid()); /* Get another one if invalid entry. */
+
+    return (cheapest);
+}
+
+void FourAryHeap::empty_heap() {
+    for (size_t i = ROOT; i < heap_tail_; i++)
+        free(slot(i).elem);
+
+    heap_tail_ = ROOT;
+}
+
+size_t FourAryHeap::size() const { return heap_tail_ - ROOT; }
+
+size_t FourAryHeap::capacity() const { return groups_.size() * 4; }
+
+// Sift the item in slot hole down until it is no more expensive than its children, in O(lgn) time
+void FourAryHeap::sift_down(size_t hole) {
+    HeapNode head = slot(hole);
+    while (true) {
+        size_t child = first_child(hole);
+        if (child >= heap_tail_)
+            break;
+
+        size_t last = std::min(child + 4, heap_tail_);
+        size_t best = child;
+        for (size_t c = child + 1; c < last; c++) {
+            if (slot(c).cost < slot(best).cost)
+                best = c;
+        }
+
+        if (slot(best).cost < head.cost) {
+            slot(hole) = slot(best);
+            hole = best;
+        } else
+            break;
+    }
+    slot(hole) = head;
+}
+
+// runs in O(n) time by sifting down every non-leaf slot, starting from the last one
+void FourAryHeap::build_heap() {
+    if (size() < 2)
+        return;
+    for (size_t i = parent(heap_tail_ - 1); i >= ROOT; --i)
+        sift_down(i);
+}
+
+void FourAryHeap::set_prune_limit(size_t max_index, size_t prune_limit) {
+    if (prune_limit != std::numeric_limits<size_t>::max()) {
+        VTR_ASSERT(max_index < prune_limit);
+    }
+    max_index_ = max_index;
+    prune_limit_ = prune_limit;
+}
+
+// O(lgn) sifting up to maintain heap property after insertion (should sift down when building heap)
+void FourAryHeap::sift_up(size_t leaf, HeapNode node) {
+    while ((leaf > ROOT) && (node.cost < slot(parent(leaf)).cost)) {
+        // sift hole up
+        slot(leaf) = slot(parent(leaf));
+        leaf = parent(leaf);
+    }
+    slot(leaf) = node;
+}
+
+//expands heap by "realloc"
+void FourAryHeap::expand_heap_if_full() {
+    if (heap_tail_ >= capacity()) { /* Heap is full */
+        groups_.resize(std::max<size_t>(1, groups_.size() * 2));
+    }
+}
+
+// adds an element to the back of heap and expand if necessary, but does not maintain heap property
+void FourAryHeap::push_back(t_heap* const hptr) {
+    expand_heap_if_full();
+    slot(heap_tail_) = {hptr, hptr->cost};
+    ++heap_tail_;
+
+    check_prune_limit();
+}
+
+bool FourAryHeap::is_valid() const {
+    if (groups_.empty()) {
+        return false;
+    }
+
+    for (size_t i = ROOT + 1; i < heap_tail_; ++i) {
+        if (slot(i).cost < slot(parent(i)).cost) return false;
+        if (slot(i).cost != slot(i).elem->cost) return false;
+    }
+    return true;
+}
+
+void FourAryHeap::free_all_memory() {
+    if (!groups_.empty()) {
+        empty_heap();
+        groups_.clear();
+    }
+
+    storage_.free_all_memory();
+}
+
+bool FourAryHeap::check_prune_limit() {
+    if (size() > prune_limit_) {
+        prune_heap();
+        return true;
+    }
+
+    return false;
+}
+
+void FourAryHeap::prune_heap() {
+    VTR_ASSERT(max_index_ < prune_limit_);
+
+    std::vector<t_heap*> best_heap_item(max_index_, nullptr);
+
+    // Find the cheapest instance of each index and store it.
+    for (size_t i = ROOT; i < heap_tail_; i++) {
+        t_heap* elem = slot(i).elem;
+        if (elem == nullptr) {
+            continue;
+        }
+
+        if (!elem->index.is_valid()) {
+            free(elem);
+            slot(i).elem = nullptr;
+            continue;
+        }
+
+        auto idx = size_t(elem->index);
+
+        VTR_ASSERT(idx < max_index_);
+
+        if (best_heap_item[idx] == nullptr || best_heap_item[idx]->cost > elem->cost) {
+            best_heap_item[idx] = elem;
+        }
+    }
+
+    // Free unused nodes.
+    for (size_t i = ROOT; i < heap_tail_; i++) {
+        t_heap* elem = slot(i).elem;
+        if (elem == nullptr) {
+            continue;
+        }
+
+        auto idx = size_t(elem->index);
+
+        if (best_heap_item[idx] != elem) {
+            free(elem);
+            slot(i).elem = nullptr;
+        }
+    }
+
+    heap_tail_ = ROOT;
+
+    for (size_t i = 0; i < max_index_; ++i) {
+        if (best_heap_item[i] != nullptr) {
+            slot(heap_tail_++) = {best_heap_item[i], best_heap_item[i]->cost};
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef _FOUR_ARY_HEAP_H
+#define _FOUR_ARY_HEAP_H
+
+#include "heap_type.h"
+#include "vtr_memory.h"
+#include <vector>
+
+/** A 4-ary min-heap of t_heap items.
+ *
+ * Compared to BinaryHeap, this halves the depth of the tree and keeps the
+ * cost of each item next to its pointer, so sifting doesn't have to chase
+ * t_heap pointers to compare costs. The slots are laid out so that all four
+ * children of a node share a single 64-byte cache line: the root is slot 3,
+ * and the children of slot i are slots [4 * (i - 2), 4 * (i - 2) + 3]. */
+class FourAryHeap : public HeapInterface {
+  public:
+    FourAryHeap();
+    ~FourAryHeap();
+
+    t_heap* alloc() final;
+    void free(t_heap* hptr) final;
+
+    void init_heap(const DeviceGrid& grid) final;
+    void add_to_heap(t_heap* hptr) final;
+    void push_back(t_heap* const hptr) final;
+    bool is_empty_heap() const final;
+    bool is_valid() const final;
+    void empty_heap() final;
+    t_heap* get_heap_head() final;
+    void build_heap() final;
+    void set_prune_limit(size_t max_index, size_t prune_limit) final;
+
+    void free_all_memory() final;
+
+  private:
+    /** A heap slot. The cost is duplicated from elem so that comparisons stay in the heap array */
+    struct HeapNode {
+        t_heap* elem;
+        float cost;
+    };
+
+    /** Four consecutive slots, aligned to a cache line */
+    struct alignas(64) HeapNodeGroup {
+        HeapNode nodes[4];
+    };
+
+    static constexpr size_t ROOT = 3;
+    static size_t parent(size_t i) { return (i >> 2) + 2; }
+    static size_t first_child(size_t i) { return (i - 2) << 2; }
+
+    HeapNode& slot(size_t i) { return groups_[i >> 2].nodes[i & 3]; }
+    const HeapNode& slot(size_t i) const { return groups_[i >> 2].nodes[i & 3]; }
+
+    size_t size() const;
+    size_t capacity() const;
+    void sift_up(size_t leaf, HeapNode node);
+    void sift_down(size_t hole);
+    void expand_heap_if_full();
+    bool check_prune_limit();
+    void prune_heap();
+
+    HeapStorage storage_;
+    std::vector<HeapNodeGroup, vtr::aligned_allocator<HeapNodeGroup>> groups_;
+    size_t heap_tail_; /* Index of first unused slot in the heap array */
+
+    size_t max_index_;
+    size_t prune_limit_;
+};
+
+#endif /* _FOUR_ARY_HEAP_H */
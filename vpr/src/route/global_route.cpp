@@ -0,0 +1,264 @@
+#include "global_route.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "vtr_geometry.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "globals.h"
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
+namespace {
+
+constexpr int NUM_GLOBAL_ROUTE_PASSES = 3;
+
+// Present congestion factor of each pass: the first pass finds the shortest routes
+constexpr float GLOBAL_ROUTE_PRES_FAC[NUM_GLOBAL_ROUTE_PASSES] = {0., 1., 4.};
+
+// Historical congestion added per unit of relative overflow of an edge after each pass
+constexpr float GLOBAL_ROUTE_HIST_FAC = 0.5;
+
+constexpr int NOT_IN_TREE = -2;
+constexpr int TREE_ROOT = -1;
+
+/** The tile grid graph: edge (dir, x, y) connects tile (x, y) to (x + 1, y) (dir 0) or (x, y + 1) (dir 1) */
+class GlobalRouteGrid {
+  public:
+    GlobalRouteGrid(size_t width, size_t height, const t_chan_width& chan_width)
+        : width_(width)
+        , height_(height)
+        , capacity_(2 * width * height, 0)
+        , usage_(2 * width * height, 0)
+        , history_(2 * width * height, 0.) {
+        for (size_t x = 0; x < width; x++) {
+            for (size_t y = 0; y < height; y++) {
+                //Moving horizontally crosses the CHANX of the row, vertically the CHANY of the column
+                capacity_[edge(0, x, y)] = (y < chan_width.x_list.size()) ? chan_width.x_list[y] : 0;
+                capacity_[edge(1, x, y)] = (x < chan_width.y_list.size()) ? chan_width.y_list[x] : 0;
+            }
+        }
+    }
+
+    int edge(int dir, int x, int y) const {
+        return (dir * width_ + x) * height_ + y;
+    }
+
+    /** Cost of one more net using edge e, given the edges own_edges (sorted) the net already uses in usage_ */
+    float edge_cost(int e, float pres_fac, const std::vector<int>& own_edges) const {
+        int usage = usage_[e];
+        if (std::binary_search(own_edges.begin(), own_edges.end(), e)) {
+            --usage;
+        }
+        int overflow = std::max(0, usage + 1 - capacity_[e]);
+        return (1. + history_[e]) * (1. + pres_fac * overflow);
+    }
+
+    /** Re-computes the usage from the edges of all the nets, then adds their overflow to the history.
+     * Returns the number of overflowed edges */
+    size_t update_usage(const vtr::vector<ParentNetId, std::vector<int>>& net_edges) {
+        std::fill(usage_.begin(), usage_.end(), 0);
+        for (const std::vector<int>& edges : net_edges) {
+            for (int e : edges) {
+                ++usage_[e];
+            }
+        }
+
+        size_t num_overflowed = 0;
+        for (size_t e = 0; e < usage_.size(); e++) {
+            int overflow = usage_[e] - capacity_[e];
+            if (overflow > 0) {
+                history_[e] += GLOBAL_ROUTE_HIST_FAC * overflow / std::max(capacity_[e], 1);
+                ++num_overflowed;
+            }
+        }
+        return num_overflowed;
+    }
+
+  private:
+    int width_;
+    int height_;
+    std::vector<int> capacity_;
+    std::vector<int> usage_;
+    std::vector<float> history_;
+};
+
+/** Routes net_id on grid within its bounding box, returning the edges it uses (sorted) and the corridors of its connections */
+std::vector<int> global_route_net(const Netlist<>& net_list,
+                                  ParentNetId net_id,
+                                  const GlobalRouteGrid& grid,
+                                  float pres_fac,
+                                  const std::vector<int>& own_edges,
+                                  int corridor_margin,
+                                  std::vector<t_bb>& corridors) {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    t_bb bb = route_ctx.route_bb[net_id];
+    bb.xmin = std::max(bb.xmin, 0);
+    bb.ymin = std::max(bb.ymin, 0);
+    bb.xmax = std::min(bb.xmax, int(device_ctx.grid.width()) - 1);
+    bb.ymax = std::min(bb.ymax, int(device_ctx.grid.height()) - 1);
+    int bb_width = bb.xmax - bb.xmin + 1;
+    int bb_height = bb.ymax - bb.ymin + 1;
+
+    //Tiles are indexed within the bounding box
+    auto tile_of = [&](RRNodeId node) {
+        int x = vtr::clamp<int>(rr_graph.node_xlow(node), bb.xmin, bb.xmax);
+        int y = vtr::clamp<int>(rr_graph.node_ylow(node), bb.ymin, bb.ymax);
+        return (x - bb.xmin) * bb_height + (y - bb.ymin);
+    };
+    auto tile_x = [&](int tile) { return bb.xmin + tile / bb_height; };
+    auto tile_y = [&](int tile) { return bb.ymin + tile % bb_height; };
+
+    const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[net_id];
+    int source_tile = tile_of(terminals[0]);
+
+    std::vector<int> tree_parent(bb_width * bb_height, NOT_IN_TREE);
+    std::vector<int> tree_tiles = {source_tile};
+    tree_parent[source_tile] = TREE_ROOT;
+
+    //Route the sinks closest to the source first, so the further ones can branch off their routes
+    std::vector<int> pins;
+    for (size_t ipin = 1; ipin < terminals.size(); ipin++) {
+        pins.push_back(ipin);
+    }
+    auto source_distance = [&](int ipin) {
+        int tile = tile_of(terminals[ipin]);
+        return std::abs(tile_x(tile) - tile_x(source_tile)) + std::abs(tile_y(tile) - tile_y(source_tile));
+    };
+    std::stable_sort(pins.begin(), pins.end(), [&](int lhs, int rhs) {
+        return source_distance(lhs) < source_distance(rhs);
+    });
+
+    std::vector<int> edges;
+    std::vector<float> cost(bb_width * bb_height);
+    std::vector<int> prev(bb_width * bb_height);
+    typedef std::pair<float, int> t_queue_entry; //<cost + estimate, tile>
+    for (int ipin : pins) {
+        int sink_tile = tile_of(terminals[ipin]);
+        if (tree_parent[sink_tile] != NOT_IN_TREE) {
+            continue;
+        }
+
+        //A* from the whole tree: every edge costs at least 1, so the Manhattan distance never over-estimates
+        auto estimate = [&](int tile) {
+            return float(std::abs(tile_x(tile) - tile_x(sink_tile)) + std::abs(tile_y(tile) - tile_y(sink_tile)));
+        };
+        std::fill(cost.begin(), cost.end(), std::numeric_limits<float>::infinity());
+        std::priority_queue<t_queue_entry, std::vector<t_queue_entry>, std::greater<t_queue_entry>> queue;
+        for (int tile : tree_tiles) {
+            cost[tile] = 0.;
+            prev[tile] = TREE_ROOT;
+            queue.emplace(estimate(tile), tile);
+        }
+
+        while (!queue.empty()) {
+            int tile = queue.top().second;
+            float tile_cost = queue.top().first - estimate(tile);
+            queue.pop();
+            if (tile == sink_tile) break;
+            if (tile_cost > cost[tile]) continue; //Stale entry
+
+            int x = tile_x(tile);
+            int y = tile_y(tile);
+            const int neighbours[4][3] = {{x + 1, y, grid.edge(0, x, y)},
+                                          {x - 1, y, grid.edge(0, x - 1, y)},
+                                          {x, y + 1, grid.edge(1, x, y)},
+                                          {x, y - 1, grid.edge(1, x, y - 1)}};
+            for (const auto& neighbour : neighbours) {
+                if (neighbour[0] < bb.xmin || neighbour[0] > bb.xmax || neighbour[1] < bb.ymin || neighbour[1] > bb.ymax) {
+                    continue;
+                }
+                int to_tile = (neighbour[0] - bb.xmin) * bb_height + (neighbour[1] - bb.ymin);
+                float to_cost = tile_cost + grid.edge_cost(neighbour[2], pres_fac, own_edges);
+                if (to_cost < cost[to_tile]) {
+                    cost[to_tile] = to_cost;
+                    prev[to_tile] = tile;
+                    queue.emplace(to_cost + estimate(to_tile), to_tile);
+                }
+            }
+        }
+
+        //Add the path to the tree (the bounding box is connected, so the sink was reached)
+        for (int tile = sink_tile; tree_parent[tile] == NOT_IN_TREE; tile = prev[tile]) {
+            int from_tile = prev[tile];
+            tree_parent[tile] = from_tile;
+            tree_tiles.push_back(tile);
+
+            int x = std::min(tile_x(tile), tile_x(from_tile));
+            int y = std::min(tile_y(tile), tile_y(from_tile));
+            edges.push_back(grid.edge(tile_x(tile) != tile_x(from_tile) ? 0 : 1, x, y));
+        }
+    }
+
+    //A connection's corridor covers the tiles from its sink up to the source
+    corridors.assign(terminals.size(), t_bb());
+    for (int ipin : pins) {
+        int sink_tile = tile_of(terminals[ipin]);
+        t_bb corridor(tile_x(sink_tile), tile_x(sink_tile), tile_y(sink_tile), tile_y(sink_tile));
+        for (int tile = sink_tile; tile != TREE_ROOT; tile = tree_parent[tile]) {
+            corridor.xmin = std::min(corridor.xmin, tile_x(tile));
+            corridor.xmax = std::max(corridor.xmax, tile_x(tile));
+            corridor.ymin = std::min(corridor.ymin, tile_y(tile));
+            corridor.ymax = std::max(corridor.ymax, tile_y(tile));
+        }
+        const t_bb& net_bb = route_ctx.route_bb[net_id];
+        corridor.xmin = std::max(corridor.xmin - corridor_margin, net_bb.xmin);
+        corridor.xmax = std::min(corridor.xmax + corridor_margin, net_bb.xmax);
+        corridor.ymin = std::max(corridor.ymin - corridor_margin, net_bb.ymin);
+        corridor.ymax = std::min(corridor.ymax + corridor_margin, net_bb.ymax);
+        corridors[ipin] = corridor;
+    }
+
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+} // namespace
+
+vtr::vector<ParentNetId, std::vector<t_bb>> compute_global_route_corridors(const Netlist<>& net_list,
+                                                                           const t_router_opts& router_opts) {
+    vtr::ScopedStartFinishTimer timer("Global routing corridors");
+
+    const auto& device_ctx = g_vpr_ctx.device();
+    GlobalRouteGrid grid(device_ctx.grid.width(), device_ctx.grid.height(), device_ctx.chan_width);
+
+    std::vector<ParentNetId> nets;
+    for (ParentNetId net_id : net_list.nets()) {
+        if (net_list.net_is_ignored(net_id) || net_list.net_is_global(net_id)) continue;
+        if (int(net_list.net_sinks(net_id).size()) >= router_opts.high_fanout_threshold) continue;
+        nets.push_back(net_id);
+    }
+
+    vtr::vector<ParentNetId, std::vector<t_bb>> corridors(net_list.nets().size());
+    vtr::vector<ParentNetId, std::vector<int>> net_edges(net_list.nets().size());
+    for (int pass = 0; pass < NUM_GLOBAL_ROUTE_PASSES; pass++) {
+        //Each net only changes its own results, and reads the usage of the previous pass
+        auto route_net = [&](size_t inet) {
+            ParentNetId net_id = nets[inet];
+            net_edges[net_id] = global_route_net(net_list, net_id, grid, GLOBAL_ROUTE_PRES_FAC[pass], net_edges[net_id],
+                                                 router_opts.global_route_corridor_margin, corridors[net_id]);
+        };
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), nets.size(), route_net);
+#else
+        for (size_t inet = 0; inet < nets.size(); inet++) {
+            route_net(inet);
+        }
+#endif
+
+        size_t num_overflowed = grid.update_usage(net_edges);
+        VTR_LOG("Global routing pass %d: %zu nets, %zu overused tile edges\n", pass + 1, nets.size(), num_overflowed);
+        if (num_overflowed == 0) break;
+    }
+
+    return corridors;
+}
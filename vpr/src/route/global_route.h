@@ -0,0 +1,31 @@
+#pragma once
+/** @file Coarse global routing of the nets on the tile grid (--global_route_corridors).
+ *
+ * Before the first PathFinder iteration, each net is routed on a graph with a node per tile
+ * and an edge between adjacent tiles, whose capacity is the width of the channel crossed
+ * (from DeviceContext::chan_width). A few negotiated congestion passes spread the nets over
+ * the channels; the nets of a pass are routed in parallel against the usage of the previous
+ * pass, so the result does not depend on the number of threads.
+ *
+ * The corridor of a connection is the bounding box of its path in the net's global route,
+ * grown by a margin and clipped to the net's bounding box. The first detailed routing
+ * iteration first searches each connection within its corridor instead of the net's
+ * bounding box, which keeps the very first (congestion unaware) searches of large designs
+ * small. */
+
+#include <vector>
+
+#include "netlist.h"
+#include "vpr_types.h"
+#include "vtr_vector.h"
+
+/**
+ * @brief Computes the corridor of each connection of the nets in net_list
+ *
+ * Returns the corridors as [net][net pin index] (the entry of the driver is unused). The
+ * corridors of a net are empty if it is not globally routed: ignored and global nets, and
+ * nets of at least router_opts.high_fanout_threshold sinks, which are routed with a spatial
+ * lookup of their route tree instead.
+ */
+vtr::vector<ParentNetId, std::vector<t_bb>> compute_global_route_corridors(const Netlist<>& net_list,
+                                                                           const t_router_opts& router_opts);
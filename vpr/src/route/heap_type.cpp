@@ -2,6 +2,8 @@
 
 #include "binary_heap.h"
 #include "bucket.h"
+#include "four_ary_heap.h"
+#include "radix_heap.h"
 #include "rr_graph_fwd.h"
 #include "vpr_error.h"
 #include "vpr_types.h"
@@ -65,6 +67,10 @@ std::unique_ptr<HeapInterface> make_heap(e_heap_type heap_type) {
             return std::make_unique<BinaryHeap>();
         case e_heap_type::BUCKET_HEAP_APPROXIMATION:
             return std::make_unique<Bucket>();
+        case e_heap_type::FOUR_ARY_HEAP:
+            return std::make_unique<FourAryHeap>();
+        case e_heap_type::RADIX_HEAP:
+            return std::make_unique<RadixHeap>();
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap_type %d", heap_type);
     }
@@ -227,6 +227,8 @@ enum class e_heap_type {
     INVALID_HEAP = 0,
     BINARY_HEAP,
     BUCKET_HEAP_APPROXIMATION,
+    FOUR_ARY_HEAP,
+    RADIX_HEAP,
 };
 
 // Heap factory.
@@ -2,18 +2,53 @@
 #include <cmath>
 #include <memory>
 
-PartitionTree::PartitionTree(const Netlist<>& netlist) {
+PartitionTree::PartitionTree(const Netlist<>& netlist, int bb_margin)
+    : _bb_margin(bb_margin) {
     const auto& device_ctx = g_vpr_ctx.device();
 
     auto all_nets = std::vector<ParentNetId>(netlist.nets().begin(), netlist.nets().end());
     _root = build_helper(netlist, all_nets, 0, 0, device_ctx.grid.width() - 1, device_ctx.grid.height() - 1);
 }
 
+PartitionTree::PartitionTree(const Netlist<>& netlist,
+                             const std::vector<ParentNetId>& nets,
+                             const vtr::vector<ParentNetId, float>& net_work,
+                             int bb_margin)
+    : _bb_margin(bb_margin)
+    , _net_work(&net_work) {
+    const auto& device_ctx = g_vpr_ctx.device();
+
+    _root = build_helper(netlist, nets, 0, 0, device_ctx.grid.width() - 1, device_ctx.grid.height() - 1);
+    /* The router expects a root to put nets to retry in, even if there is nothing to route now */
+    if (!_root)
+        _root = std::make_unique<PartitionTreeNode>();
+    _net_work = nullptr;
+}
+
+float PartitionTree::net_work(const Netlist<>& netlist, ParentNetId net_id) const {
+    if (_net_work)
+        return (*_net_work)[net_id];
+    return netlist.net_sinks(net_id).size();
+}
+
+t_bb PartitionTree::partition_bb(ParentNetId net_id) const {
+    const auto& device_ctx = g_vpr_ctx.device();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    t_bb bb = route_ctx.route_bb[net_id];
+    if (_bb_margin > 0) {
+        bb.xmin = std::max(0, bb.xmin - _bb_margin);
+        bb.ymin = std::max(0, bb.ymin - _bb_margin);
+        bb.xmax = std::min((int)device_ctx.grid.width() - 1, bb.xmax + _bb_margin);
+        bb.ymax = std::min((int)device_ctx.grid.height() - 1, bb.ymax + _bb_margin);
+    }
+    return bb;
+}
+
 std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>& netlist, const std::vector<ParentNetId>& nets, int x1, int y1, int x2, int y2) {
     if (nets.empty())
         return nullptr;
 
-    const auto& route_ctx = g_vpr_ctx.routing();
     auto out = std::make_unique<PartitionTreeNode>();
 
     /* Build ParaDRo-ish prefix sum lookup for each bin (coordinate) in the device.
@@ -27,48 +62,57 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
 
     VTR_ASSERT(W > 1 && H > 1);
     /* Cutlines are placed between integral coordinates.
-     * For instance, x_total_before[0] assumes a cutline at x=0.5, so fanouts at x=0 are included but not
-     * x=1. It's similar for x_total_after[0], which excludes fanouts at x=0 and includes x=1.
-     * Note that we have W-1 possible cutlines for a W-wide box. */
-    std::vector<int> x_total_before(W - 1, 0), x_total_after(W - 1, 0);
-    std::vector<int> y_total_before(H - 1, 0), y_total_after(H - 1, 0);
+     * For instance, x_total_before[0] assumes a cutline at x=0.5, so work at x=0 is included but not
+     * x=1. It's similar for x_total_after[0], which excludes work at x=0 and includes x=1.
+     * Note that we have W-1 possible cutlines for a W-wide box.
+     *
+     * The *_count lookups hold net counts instead of work and are only used to reject one-way cuts:
+     * a net with (estimated) zero work still has to go somewhere. */
+    std::vector<double> x_total_before(W - 1, 0), x_total_after(W - 1, 0);
+    std::vector<double> y_total_before(H - 1, 0), y_total_after(H - 1, 0);
+    std::vector<int> x_count_before(W - 1, 0), x_count_after(W - 1, 0);
+    std::vector<int> y_count_before(H - 1, 0), y_count_after(H - 1, 0);
 
     for (auto net_id : nets) {
-        t_bb bb = route_ctx.route_bb[net_id];
-        size_t fanouts = netlist.net_sinks(net_id).size();
+        t_bb bb = partition_bb(net_id);
+        double work = net_work(netlist, net_id);
 
         /* Inclusive start and end coords of the bbox relative to x1. Clamp to [x1, x2]. */
         int x_start = std::max(x1, bb.xmin) - x1;
         int x_end = std::min(bb.xmax, x2) - x1;
         /* Fill in the lookups assuming a cutline at x + 0.5. */
         for (int x = x_start; x < W - 1; x++) {
-            x_total_before[x] += fanouts;
+            x_total_before[x] += work;
+            x_count_before[x]++;
         }
         for (int x = 0; x < x_end; x++) {
-            x_total_after[x] += fanouts;
+            x_total_after[x] += work;
+            x_count_after[x]++;
         }
         int y_start = std::max(y1, bb.ymin) - y1;
         int y_end = std::min(bb.ymax, y2) - y1;
         for (int y = y_start; y < H - 1; y++) {
-            y_total_before[y] += fanouts;
+            y_total_before[y] += work;
+            y_count_before[y]++;
         }
         for (int y = 0; y < y_end; y++) {
-            y_total_after[y] += fanouts;
+            y_total_after[y] += work;
+            y_count_after[y]++;
         }
     }
 
-    int best_score = std::numeric_limits<int>::max();
+    double best_score = std::numeric_limits<double>::max();
     float best_pos = std::numeric_limits<double>::quiet_NaN();
     Axis best_axis = Axis::X;
 
-    int max_x_before = x_total_before[W - 2];
-    int max_x_after = x_total_after[0];
+    int max_x_before = x_count_before[W - 2];
+    int max_x_after = x_count_after[0];
     for (int x = 0; x < W - 1; x++) {
-        int before = x_total_before[x];
-        int after = x_total_after[x];
+        int before = x_count_before[x];
+        int after = x_count_after[x];
         if (before == max_x_before || after == max_x_after) /* Cutting here would leave no nets to the left or right */
             continue;
-        int score = abs(x_total_before[x] - x_total_after[x]);
+        double score = std::abs(x_total_before[x] - x_total_after[x]);
         if (score < best_score) {
             best_score = score;
             best_pos = x1 + x + 0.5; /* Lookups are relative to (x1, y1) */
@@ -76,14 +120,14 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
         }
     }
 
-    int max_y_before = y_total_before[H - 2];
-    int max_y_after = y_total_after[0];
+    int max_y_before = y_count_before[H - 2];
+    int max_y_after = y_count_after[0];
     for (int y = 0; y < H - 1; y++) {
-        int before = y_total_before[y];
-        int after = y_total_after[y];
+        int before = y_count_before[y];
+        int after = y_count_after[y];
         if (before == max_y_before || after == max_y_after) /* Cutting here would leave no nets to the left or right (sideways) */
             continue;
-        int score = abs(y_total_before[y] - y_total_after[y]);
+        double score = std::abs(y_total_before[y] - y_total_after[y]);
         if (score < best_score) {
             best_score = score;
             best_pos = y1 + y + 0.5; /* Lookups are relative to (x1, y1) */
@@ -102,7 +146,7 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
 
     if (best_axis == Axis::X) {
         for (auto net_id : nets) {
-            t_bb bb = route_ctx.route_bb[net_id];
+            t_bb bb = partition_bb(net_id);
             if (bb.xmax < best_pos) {
                 left_nets.push_back(net_id);
             } else if (bb.xmin > best_pos) {
@@ -117,7 +161,7 @@ std::unique_ptr<PartitionTreeNode> PartitionTree::build_helper(const Netlist<>&
     } else {
         VTR_ASSERT(best_axis == Axis::Y);
         for (auto net_id : nets) {
-            t_bb bb = route_ctx.route_bb[net_id];
+            t_bb bb = partition_bb(net_id);
             if (bb.ymax < best_pos) {
                 left_nets.push_back(net_id);
             } else if (bb.ymin > best_pos) {
@@ -77,14 +77,37 @@ class PartitionTree {
     PartitionTree& operator=(const PartitionTree&) = delete;
     PartitionTree& operator=(PartitionTree&&) = default;
 
-    /** Can only be built from a netlist */
-    PartitionTree(const Netlist<>& netlist);
+    /** Can only be built from a netlist.
+     *
+     * @param netlist Input netlist
+     * @param bb_margin Number of tiles to grow each net's route_bb by on every side before partitioning.
+     *                  Passing the longest rr node span guarantees that sibling subtrees can never touch
+     *                  the same rr node, which is what makes the deterministic parallel router deterministic. */
+    PartitionTree(const Netlist<>& netlist, int bb_margin = 0);
+
+    /** Build from a subset of the nets, balancing cutlines by estimated routing work instead of fanout.
+     *
+     * @param netlist Input netlist
+     * @param nets Nets to partition. Typically only the nets which will be rerouted in the next iteration.
+     * @param net_work Estimated routing work per net, e.g. heap pushes in the last iteration. Only used during construction.
+     * @param bb_margin See above */
+    PartitionTree(const Netlist<>& netlist,
+                  const std::vector<ParentNetId>& nets,
+                  const vtr::vector<ParentNetId, float>& net_work,
+                  int bb_margin = 0);
 
     /** Access root. Shouldn't cause a segfault, because PartitionTree constructor always makes a _root */
     inline PartitionTreeNode& root(void) { return *_root; }
 
   private:
     std::unique_ptr<PartitionTreeNode> _root;
+    int _bb_margin = 0;
+    /** Per-net work estimates to balance cutlines with. If null, net fanout is used */
+    const vtr::vector<ParentNetId, float>* _net_work = nullptr;
+    /** Estimated routing work for \p net_id */
+    float net_work(const Netlist<>& netlist, ParentNetId net_id) const;
+    /** route_bb of \p net_id grown by _bb_margin, clipped to the device */
+    t_bb partition_bb(ParentNetId net_id) const;
     std::unique_ptr<PartitionTreeNode> build_helper(const Netlist<>& netlist, const std::vector<ParentNetId>& nets, int x1, int y1, int x2, int y2);
 };
 
@@ -0,0 +1,194 @@
+#include "radix_heap.h"
+#include "rr_graph_fwd.h"
+#include "vtr_log.h"
+
+#include <cmath>
+#include <cstring>
+
+RadixHeap::RadixHeap()
+    : last_key_(0)
+    , size_(0)
+    , max_index_(std::numeric_limits<size_t>::max())
+    , prune_limit_(std::numeric_limits<size_t>::max()) {}
+
+RadixHeap::~RadixHeap() {
+    free_all_memory();
+}
+
+t_heap* RadixHeap::alloc() {
+    return storage_.alloc();
+}
+void RadixHeap::free(t_heap* hptr) {
+    storage_.free(hptr);
+}
+
+uint32_t RadixHeap::cost_to_key(float cost) {
+    // The bit patterns of non-negative IEEE-754 floats sort the same way as their values.
+    // Negative costs and NaNs don't occur in the router, but map them to 0 to stay safe.
+    if (!(cost > 0.f))
+        return 0;
+    uint32_t key;
+    static_assert(sizeof(key) == sizeof(cost), "RadixHeap assumes 32-bit floats");
+    std::memcpy(&key, &cost, sizeof(key));
+    return key;
+}
+
+size_t RadixHeap::bucket_index(uint32_t key) const {
+    if (key == last_key_)
+        return 0;
+    return 32 - __builtin_clz(key ^ last_key_);
+}
+
+void RadixHeap::init_heap(const DeviceGrid& grid) {
+    size_t target_heap_size = (grid.width() - 1) * (grid.height() - 1);
+    buckets_[0].reserve(target_heap_size);
+    empty_heap();
+}
+
+void RadixHeap::add_to_heap(t_heap* hptr) {
+    // Clamp keys smaller than the last popped one (see class comment)
+    uint32_t key = std::max(cost_to_key(hptr->cost), last_key_);
+    buckets_[bucket_index(key)].push_back({hptr, key});
+    ++size_;
+
+    check_prune_limit();
+}
+
+// The bucket structure is always valid, so there is no difference between push_back and add_to_heap
+void RadixHeap::push_back(t_heap* const hptr) {
+    add_to_heap(hptr);
+}
+
+void RadixHeap::build_heap() {
+}
+
+bool RadixHeap::is_empty_heap() const {
+    return size_ == 0;
+}
+
+void RadixHeap::redistribute() {
+    size_t i = 1;
+    while (buckets_[i].empty())
+        ++i;
+
+    uint32_t new_last_key = std::numeric_limits<uint32_t>::max();
+    for (const HeapNode& node : buckets_[i]) {
+        new_last_key = std::min(new_last_key, node.key);
+    }
+    last_key_ = new_last_key;
+
+    // Every item differs from the new last_key_ only below bit i-1, so they all move to lower buckets
+    for (const HeapNode& node : buckets_[i]) {
+        buckets_[bucket_index(node.key)].push_back(node);
+    }
+    buckets_[i].clear();
+}
+
+t_heap* RadixHeap::get_heap_head() {
+    /* Returns a pointer to the smallest element on the heap, or NULL if the     *
+     * heap is empty.  Invalid (index == OPEN) entries on the heap are never     *
+     * returned -- they are just skipped over.                                   */
+    t_heap* cheapest;
+
+    do {
+        if (size_ == 0) { /* Empty heap. */
+            VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
+            return (nullptr);
+        }
+
+        if (buckets_[0].empty())
+            redistribute();
+
+        cheapest = buckets_[0].back().elem;
+        buckets_[0].pop_back();
+        --size_;
+    } while (!cheapest->index.is_valid()); /* Get another one if invalid entry. */
+
+    return (cheapest);
+}
+
+void RadixHeap::empty_heap() {
+    for (auto& bucket : buckets_) {
+        for (const HeapNode& node : bucket)
+            free(node.elem);
+        bucket.clear();
+    }
+
+    size_ = 0;
+    last_key_ = 0;
+}
+
+bool RadixHeap::is_valid() const {
+    size_t num_items = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+        for (const HeapNode& node : buckets_[i]) {
+            if (bucket_index(node.key) != i) return false;
+        }
+        num_items += buckets_[i].size();
+    }
+    return num_items == size_;
+}
+
+void RadixHeap::set_prune_limit(size_t max_index, size_t prune_limit) {
+    if (prune_limit != std::numeric_limits<size_t>::max()) {
+        VTR_ASSERT(max_index < prune_limit);
+    }
+    max_index_ = max_index;
+    prune_limit_ = prune_limit;
+}
+
+void RadixHeap::free_all_memory() {
+    empty_heap();
+    for (auto& bucket : buckets_) {
+        bucket.shrink_to_fit();
+    }
+
+    storage_.free_all_memory();
+}
+
+bool RadixHeap::check_prune_limit() {
+    if (size_ > prune_limit_) {
+        prune_heap();
+        return true;
+    }
+
+    return false;
+}
+
+void RadixHeap::prune_heap() {
+    VTR_ASSERT(max_index_ < prune_limit_);
+
+    std::vector<const HeapNode*> best_heap_item(max_index_, nullptr);
+
+    // Find the cheapest instance of each index
+    for (const auto& bucket : buckets_) {
+        for (const HeapNode& node : bucket) {
+            if (!node.elem->index.is_valid())
+                continue;
+
+            auto idx = size_t(node.elem->index);
+
+            VTR_ASSERT(idx < max_index_);
+
+            if (best_heap_item[idx] == nullptr || best_heap_item[idx]->elem->cost > node.elem->cost) {
+                best_heap_item[idx] = &node;
+            }
+        }
+    }
+
+    // Keep only those, in place (bucket assignment depends only on the key, so they stay put)
+    size_ = 0;
+    for (auto& bucket : buckets_) {
+        size_t num_kept = 0;
+        for (size_t i = 0; i < bucket.size(); i++) {
+            const HeapNode& node = bucket[i];
+            if (node.elem->index.is_valid() && best_heap_item[size_t(node.elem->index)] == &node) {
+                bucket[num_kept++] = node;
+            } else {
+                free(node.elem);
+            }
+        }
+        bucket.resize(num_kept);
+        size_ += num_kept;
+    }
+}
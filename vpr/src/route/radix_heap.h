@@ -0,0 +1,67 @@
+#ifndef _RADIX_HEAP_H
+#define _RADIX_HEAP_H
+
+#include "heap_type.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/** A monotone radix heap of t_heap items.
+ *
+ * Costs are mapped to 32-bit keys by reinterpreting the bits of the (non-negative)
+ * float cost, which preserves their order. Items are kept in 33 buckets by the
+ * highest bit in which their key differs from the key last popped, so pushing is
+ * O(1) and each item is moved between buckets at most 32 times before being popped.
+ *
+ * A radix heap requires that no key smaller than the last popped one is ever pushed.
+ * The router only satisfies this with a consistent lookahead, so smaller keys are
+ * clamped to the last popped key instead: such items come out next, before anything
+ * that is already on the heap, but in unspecified order among themselves. Like Bucket,
+ * this makes RadixHeap a (very close) approximation of a priority queue. */
+class RadixHeap : public HeapInterface {
+  public:
+    RadixHeap();
+    ~RadixHeap();
+
+    t_heap* alloc() final;
+    void free(t_heap* hptr) final;
+
+    void init_heap(const DeviceGrid& grid) final;
+    void add_to_heap(t_heap* hptr) final;
+    void push_back(t_heap* const hptr) final;
+    bool is_empty_heap() const final;
+    bool is_valid() const final;
+    void empty_heap() final;
+    t_heap* get_heap_head() final;
+    void build_heap() final;
+    void set_prune_limit(size_t max_index, size_t prune_limit) final;
+
+    void free_all_memory() final;
+
+  private:
+    static constexpr size_t NUM_BUCKETS = 33;
+
+    struct HeapNode {
+        t_heap* elem;
+        uint32_t key;
+    };
+
+    /** Map a cost to an order-preserving integer key */
+    static uint32_t cost_to_key(float cost);
+    /** Which bucket does key go into, relative to last_key_? */
+    size_t bucket_index(uint32_t key) const;
+    /** Refill bucket 0 from the first non-empty bucket */
+    void redistribute();
+    bool check_prune_limit();
+    void prune_heap();
+
+    HeapStorage storage_;
+    std::array<std::vector<HeapNode>, NUM_BUCKETS> buckets_;
+    uint32_t last_key_; /* Key of the item last popped (0 if none since the heap was emptied) */
+    size_t size_;
+
+    size_t max_index_;
+    size_t prune_limit_;
+};
+
+#endif /* _RADIX_HEAP_H */
@@ -53,6 +53,11 @@
 #include "route_budgets.h"
 #include "vtr_time.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_reduce.h>
+#endif
+
 #define SHORT_PATH_EXP 0.5
 
 route_budgets::route_budgets(const Netlist<>& net_list, bool is_flat)
@@ -139,6 +144,17 @@ void route_budgets::load_route_budgets(NetPinsMatrix<float>& net_delay,
     alloc_budget_memory();
     load_initial_budgets();
 
+    auto& atom_ctx = g_vpr_ctx.atom();
+    timing_update_type_ = router_opts.timing_update_type;
+    pin_timing_invalidator_ = make_net_pin_timing_invalidator(timing_update_type_,
+                                                              net_list_,
+                                                              netlist_pin_lookup,
+                                                              atom_ctx.nlist,
+                                                              atom_ctx.lookup,
+                                                              *g_vpr_ctx.timing().graph,
+                                                              is_flat_);
+    convergence_delta_ = router_opts.routing_budgets_convergence_delta;
+
     /*go to the associated function depending on user input/default settings*/
     if (router_opts.routing_budgets_algorithm == MINIMAX || router_opts.routing_budgets_algorithm == YOYO) {
         bool use_negative_hold_slacks = router_opts.routing_budgets_algorithm == YOYO;
@@ -148,6 +164,7 @@ void route_budgets::load_route_budgets(NetPinsMatrix<float>& net_delay,
     } else if (router_opts.routing_budgets_algorithm == SCALE_DELAY) {
         allocate_slack_using_delays_and_criticalities(net_delay, timing_info, netlist_pin_lookup, router_opts);
     }
+    free_budget_timing();
     set = true;
 }
 
@@ -201,14 +218,10 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     iteration = 0;
     max_budget_change = 900e-12;
 
-    // Cutoff threshold so slack allocator can detect if budgets aren't changing, and stop loop early
-    // An experimentally derived constant that allows for a balance between budget calculation time, and quality
-    constexpr float MAX_BUDGET_CHANGE_THRESHOLD = 5e-12;
-
     original_timing_info = perform_sta(net_delay);
 
     /*This allocates long path slack and increases the budgets*/
-    while ((iteration > 3 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) || iteration <= 3) {
+    while ((iteration > 3 && max_budget_change > convergence_delta_) || iteration <= 3) {
         timing_info = perform_sta(delay_max_budget);
 
         max_budget_change = minimax_PERT(original_timing_info, timing_info, delay_max_budget, net_delay, netlist_pin_lookup, SETUP, true, BOTH);
@@ -237,7 +250,7 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     max_budget_change = 900e-12;
 
     /*Allocate the short path slack to decrease the budgets accordingly*/
-    while ((iteration > 3 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) || iteration <= 3) {
+    while ((iteration > 3 && max_budget_change > convergence_delta_) || iteration <= 3) {
         timing_info_min = perform_sta(delay_min_budget);
         max_budget_change = minimax_PERT(original_timing_info, timing_info_min, delay_min_budget, net_delay, netlist_pin_lookup, HOLD, true, POSITIVE);
         iteration++;
@@ -254,7 +267,7 @@ void route_budgets::allocate_slack_using_weights(NetPinsMatrix<float>& net_delay
     float bottom_range = -1e-9;
 
     original_timing_info = perform_sta(net_delay);
-    while (iteration < 5 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD) {
+    while (iteration < 5 && max_budget_change > convergence_delta_) {
         /*budgets must be in bounds before timing analysis*/
         if (iteration != 0) {
             keep_budget_in_bounds(delay_min_budget);
@@ -282,10 +295,7 @@ void route_budgets::process_negative_slack_using_minimax(NetPinsMatrix<float>& n
     float second_max_budget_change = 900e-12;
     original_timing_info = perform_sta(net_delay);
 
-    // Cutoff threshold so if budgets aren't changing, stop early
-    constexpr float MAX_BUDGET_CHANGE_THRESHOLD_PREPROCESSING = 5e-12;
-
-    while (iteration < 20 && max_budget_change > MAX_BUDGET_CHANGE_THRESHOLD_PREPROCESSING) {
+    while (iteration < 20 && max_budget_change > convergence_delta_) {
         if (iteration == 0) {
             max_budget_change = minimax_PERT(original_timing_info, original_timing_info, delay_max_budget, net_delay, netlist_pin_lookup, HOLD, true, NEGATIVE);
             timing_info = perform_sta(delay_max_budget);
@@ -361,75 +371,112 @@ float route_budgets::minimax_PERT(std::shared_ptr<SetupHoldTimingInfo> orig_timi
                                   bool keep_in_bounds,
                                   slack_allocated_type slack_type) {
     /*This function uses weights to calculate how much slack to allocate to a connection.
-     * The weights are deteremined by how much delay of the whole path is present in this connection*/
+     * The weights are deteremined by how much delay of the whole path is present in this connection.
+     * Each net's connections only depend on the timing analyses, so the nets are processed in parallel
+     * when VPR is built with TBB. Returns the largest budget change*/
+
+#ifdef VPR_USE_TBB
+    auto nets = net_list_.nets();
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, nets.size()), 0.f,
+        [&](const tbb::blocked_range<size_t>& range, float max_budget_change) {
+            for (size_t inet = range.begin(); inet != range.end(); ++inet) {
+                float net_budget_change = minimax_PERT(*(nets.begin() + inet), orig_timing_info, timing_info, temp_budgets, net_delay,
+                                                       netlist_pin_lookup, analysis_type, keep_in_bounds, slack_type);
+                max_budget_change = std::max(max_budget_change, net_budget_change);
+            }
+            return max_budget_change;
+        },
+        [](float lhs, float rhs) { return std::max(lhs, rhs); });
+#else
+    float max_budget_change = 0;
+    for (auto net_id : net_list_.nets()) {
+        float net_budget_change = minimax_PERT(net_id, orig_timing_info, timing_info, temp_budgets, net_delay,
+                                               netlist_pin_lookup, analysis_type, keep_in_bounds, slack_type);
+        max_budget_change = std::max(max_budget_change, net_budget_change);
+    }
+    return max_budget_change;
+#endif
+}
+
+float route_budgets::minimax_PERT(ParentNetId net_id,
+                                  std::shared_ptr<SetupHoldTimingInfo> orig_timing_info,
+                                  std::shared_ptr<SetupHoldTimingInfo> timing_info,
+                                  NetPinsMatrix<float>& temp_budgets,
+                                  NetPinsMatrix<float>& net_delay,
+                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                  analysis_type analysis_type,
+                                  bool keep_in_bounds,
+                                  slack_allocated_type slack_type) {
+    /*Allocates the slack of the connections of net_id, returning the largest budget change.
+     * Only the connections of net_id are written, so nets may be processed concurrently*/
 
     std::shared_ptr<const tatum::SetupHoldTimingAnalyzer> timing_analyzer = orig_timing_info->setup_hold_analyzer();
     float total_path_delay = 0;
     float path_slack;
     float hold_path_slack;
     float max_budget_change = 0;
-    for (auto net_id : net_list_.nets()) {
-        for (auto pin_id : net_list_.net_sinks(net_id)) {
-            int ipin = net_list_.pin_net_index(pin_id);
-            AtomPinId atom_pin;
+    for (auto pin_id : net_list_.net_sinks(net_id)) {
+        int ipin = net_list_.pin_net_index(pin_id);
+        AtomPinId atom_pin;
 
-            /*calculate slack, save the pin that has min slack to calculate total path delay*/
-            if (analysis_type == HOLD) {
-                path_slack = calculate_clb_pin_slack(net_id, ipin, timing_info, netlist_pin_lookup, HOLD, atom_pin);
+        /*calculate slack, save the pin that has min slack to calculate total path delay*/
+        if (analysis_type == HOLD) {
+            path_slack = calculate_clb_pin_slack(net_id, ipin, timing_info, netlist_pin_lookup, HOLD, atom_pin);
 
-                // Path level guardbands
-                if (path_slack > 0) {
-                    path_slack = path_slack * 0.70 - 300e-12;
-                } else {
-                    path_slack = path_slack - 100e-12;
-                }
-                hold_path_slack = path_slack;
+            // Path level guardbands
+            if (path_slack > 0) {
+                path_slack = path_slack * 0.70 - 300e-12;
             } else {
-                path_slack = calculate_clb_pin_slack(net_id, ipin, timing_info, netlist_pin_lookup, SETUP, atom_pin);
-                hold_path_slack = calculate_clb_pin_slack(net_id, ipin, orig_timing_info, netlist_pin_lookup, HOLD, atom_pin);
-                if (hold_path_slack > 0) {
-                    hold_path_slack = hold_path_slack * 0.70 - 300e-12;
-                } else {
-                    hold_path_slack = hold_path_slack - 100e-12;
-                }
+                path_slack = path_slack - 100e-12;
+            }
+            hold_path_slack = path_slack;
+        } else {
+            path_slack = calculate_clb_pin_slack(net_id, ipin, timing_info, netlist_pin_lookup, SETUP, atom_pin);
+            hold_path_slack = calculate_clb_pin_slack(net_id, ipin, orig_timing_info, netlist_pin_lookup, HOLD, atom_pin);
+            if (hold_path_slack > 0) {
+                hold_path_slack = hold_path_slack * 0.70 - 300e-12;
+            } else {
+                hold_path_slack = hold_path_slack - 100e-12;
             }
+        }
 
-            total_path_delay = get_total_path_delay(timing_analyzer, analysis_type, net_id, ipin, atom_pin);
-            // if ((size_t)net_id == 10) {
-            //     VTR_LOG("NET 10 TOTAL PATH DELAY IS %e\n", total_path_delay);
-            // }
+        total_path_delay = get_total_path_delay(timing_analyzer, analysis_type, net_id, ipin, atom_pin);
+        // if ((size_t)net_id == 10) {
+        //     VTR_LOG("NET 10 TOTAL PATH DELAY IS %e\n", total_path_delay);
+        // }
 
-            if (total_path_delay == -1) {
-                /*Delay node is not valid, leave the budgets as is*/
-                continue;
-            }
+        if (total_path_delay == -1) {
+            /*Delay node is not valid, leave the budgets as is*/
+            continue;
+        }
 
-            /*During hold analysis, increase the budgets when there is negative slack.
-             * During setup analysis, decrease the budgets when there is negative slack*/
-            if ((slack_type == NEGATIVE && path_slack < 0) || (slack_type == POSITIVE && path_slack > 0) || slack_type == BOTH) {
-                if (analysis_type == HOLD) {
-                    temp_budgets[net_id][ipin] += -1 * net_delay[net_id][ipin] * path_slack / total_path_delay;
+        /*During hold analysis, increase the budgets when there is negative slack.
+         * During setup analysis, decrease the budgets when there is negative slack*/
+        if ((slack_type == NEGATIVE && path_slack < 0) || (slack_type == POSITIVE && path_slack > 0) || slack_type == BOTH) {
+            if (analysis_type == HOLD) {
+                temp_budgets[net_id][ipin] += -1 * net_delay[net_id][ipin] * path_slack / total_path_delay;
+                max_budget_change = std::max(max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
+            } else {
+                if ((slack_type == POSITIVE) || (hold_path_slack > 0)) {
+                    temp_budgets[net_id][ipin] += net_delay[net_id][ipin] * path_slack / total_path_delay;
                     max_budget_change = std::max(max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
-                } else {
-                    if ((slack_type == POSITIVE) || (hold_path_slack > 0)) {
-                        temp_budgets[net_id][ipin] += net_delay[net_id][ipin] * path_slack / total_path_delay;
-                        max_budget_change = std::max(max_budget_change, std::abs(net_delay[net_id][ipin] * path_slack / total_path_delay));
-                    }
                 }
             }
+        }
 
-            // if ((size_t)net_id == 916 && analysis_type == HOLD) {
-            //     VTR_LOG("Path slack %e weight %e max_budget_change %e net min budg %e\n", path_slack, net_delay[net_id][ipin]/total_path_delay, max_budget_change, temp_budgets[net_id][ipin]);
-            // }
+        // if ((size_t)net_id == 916 && analysis_type == HOLD) {
+        //     VTR_LOG("Path slack %e weight %e max_budget_change %e net min budg %e\n", path_slack, net_delay[net_id][ipin]/total_path_delay, max_budget_change, temp_budgets[net_id][ipin]);
+        // }
 
-            /*Budgets need to be between maximum and minimum budgets*/
-            if (keep_in_bounds) {
-                keep_budget_in_bounds(temp_budgets, net_id, pin_id);
-            }
+        /*Budgets need to be between maximum and minimum budgets*/
+        if (keep_in_bounds) {
+            keep_budget_in_bounds(temp_budgets, net_id, pin_id);
+        }
 
-            if ((slack_type == NEGATIVE && path_slack < 0 && analysis_type == HOLD) || hold_path_slack < 0) {
-                should_reroute_for_hold[net_id] = true;
-            }
+        if ((slack_type == NEGATIVE && path_slack < 0 && analysis_type == HOLD) || hold_path_slack < 0) {
+            //The entry exists (see load_initial_budgets()), so this does not modify the map itself
+            should_reroute_for_hold.at(net_id) = true;
         }
     }
     return max_budget_change;
@@ -659,19 +706,44 @@ void route_budgets::check_if_budgets_in_bounds() {
 }
 
 std::shared_ptr<SetupHoldTimingInfo> route_budgets::perform_sta(NetPinsMatrix<float>& temp_budgets) {
-    auto& atom_ctx = g_vpr_ctx.atom();
-    /*Perform static timing analysis to get the delay and path weights for slack allocation*/
-    std::shared_ptr<RoutingDelayCalculator> routing_delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, temp_budgets, is_flat_);
+    /*Perform static timing analysis to get the delay and path weights for slack allocation.
+     * The delay calculator refers to temp_budgets, so the timing info built on the first analysis
+     * of a matrix is only updated by later analyses of it. With incremental timing updates only the
+     * connections whose delays changed since the previous update are re-analyzed*/
+    t_budget_timing& budget_timing = budget_timing_[&temp_budgets];
+
+    if (!budget_timing.timing_info) {
+        auto& atom_ctx = g_vpr_ctx.atom();
+        budget_timing.delay_calc = std::make_shared<RoutingDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, temp_budgets, is_flat_);
+        budget_timing.timing_info = make_setup_hold_timing_info(budget_timing.delay_calc, timing_update_type_);
+
+        /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
+        budget_timing.timing_info->set_warn_unconstrained(false);
+    } else if (timing_update_type_ == e_timing_update_type::INCREMENTAL) {
+        for (auto net_id : net_list_.nets()) {
+            for (auto pin_id : net_list_.net_sinks(net_id)) {
+                int ipin = net_list_.pin_net_index(pin_id);
+                if (temp_budgets[net_id][ipin] != budget_timing.analyzed_delays[net_id][ipin]) {
+                    pin_timing_invalidator_->invalidate_connection(pin_id, budget_timing.timing_info.get());
+                }
+            }
+        }
+        pin_timing_invalidator_->reset();
+    }
 
-    //TODO: now that we support incremental timing updates, we should avoid re-building the timing analyzer from scratch and try
-    //      to calculate this incrementally
-    std::shared_ptr<SetupHoldTimingInfo> timing_info = make_setup_hold_timing_info(routing_delay_calc, e_timing_update_type::AUTO);
+    budget_timing.timing_info->update();
 
-    /*Unconstrained nodes should be warned in the main routing function, do not report it here*/
-    timing_info->set_warn_unconstrained(false);
-    timing_info->update();
+    if (timing_update_type_ == e_timing_update_type::INCREMENTAL) {
+        budget_timing.analyzed_delays = temp_budgets;
+    }
+
+    return budget_timing.timing_info;
+}
 
-    return timing_info;
+void route_budgets::free_budget_timing() {
+    /*The budget matrices are re-allocated each time the budgets are loaded*/
+    budget_timing_.clear();
+    pin_timing_invalidator_.reset();
 }
 
 void route_budgets::update_congestion_times(ParentNetId net_id) {
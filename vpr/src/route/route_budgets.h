@@ -7,7 +7,10 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include <map>
+#include <memory>
 #include "RoutingDelayCalculator.h"
+#include "NetPinTimingInvalidator.h"
 
 enum analysis_type {
     SETUP,
@@ -78,11 +81,21 @@ class route_budgets {
                        analysis_type analysis_type,
                        bool keep_in_bounds,
                        slack_allocated_type slack_type = BOTH);
+    float minimax_PERT(ParentNetId net_id,
+                       std::shared_ptr<SetupHoldTimingInfo> orig_timing_info,
+                       std::shared_ptr<SetupHoldTimingInfo> timing_info,
+                       NetPinsMatrix<float>& temp_budgets,
+                       NetPinsMatrix<float>& net_delay,
+                       const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                       analysis_type analysis_type,
+                       bool keep_in_bounds,
+                       slack_allocated_type slack_type);
 
     void process_negative_slack_using_minimax(NetPinsMatrix<float>& net_delay, const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
 
     /*Perform static timing analysis*/
     std::shared_ptr<SetupHoldTimingInfo> perform_sta(NetPinsMatrix<float>& temp_budgets);
+    void free_budget_timing();
 
     /*checks*/
     void keep_budget_in_bounds(NetPinsMatrix<float>& temp_budgets);
@@ -129,6 +142,20 @@ class route_budgets {
     vtr::vector<ParentNetId, int> num_times_congested; //[0..num_nets]
     std::queue<float> negative_hold_slacks;
 
+    /*The timing analysis of each matrix passed to perform_sta(), kept while the budgets are loaded
+     * so repeated analyses of a matrix update its timing info instead of re-building it*/
+    struct t_budget_timing {
+        std::shared_ptr<RoutingDelayCalculator> delay_calc;
+        std::shared_ptr<SetupHoldTimingInfo> timing_info;
+        NetPinsMatrix<float> analyzed_delays; //The delays of the last (incremental) update
+    };
+    std::map<const NetPinsMatrix<float>*, t_budget_timing> budget_timing_;
+    std::unique_ptr<NetPinTimingInvalidator> pin_timing_invalidator_;
+    e_timing_update_type timing_update_type_ = e_timing_update_type::AUTO;
+
+    /*the budget loops stop once no budget changes by more than this (seconds)*/
+    float convergence_delta_ = 5e-12;
+
     const Netlist<>& net_list_;
     bool is_flat_;
 
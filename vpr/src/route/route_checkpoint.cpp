@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "vtr_log.h"
+
+#include "vpr_error.h"
+#include "globals.h"
+#include "route_checkpoint.h"
+
+///@brief Identifies the route checkpoints written by write_route_checkpoint()
+constexpr char ROUTE_CHECKPOINT_MAGIC[8] = {'V', 'P', 'R', 'R', 'T', 'C', 'K', 'P'};
+///@brief Incremented whenever the layout of the checkpoints changes
+constexpr uint32_t ROUTE_CHECKPOINT_VERSION = 1;
+
+template<typename T>
+static void append_checkpoint_value(std::vector<char>& buf, const T& value);
+
+template<typename T>
+static bool read_checkpoint_value(const std::vector<char>& buf, size_t& offset, T& value);
+
+void write_route_checkpoint(const char* checkpoint_file, const t_route_checkpoint& checkpoint) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& place_ctx = g_vpr_ctx.placement();
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    const std::string& placement_id = place_ctx.placement_id;
+    size_t num_nodes = rr_graph.num_nodes();
+
+    std::vector<char> buf;
+    buf.reserve(sizeof(ROUTE_CHECKPOINT_MAGIC) + placement_id.size() + 8 * sizeof(uint32_t) + num_nodes * sizeof(float));
+    buf.insert(buf.end(), std::begin(ROUTE_CHECKPOINT_MAGIC), std::end(ROUTE_CHECKPOINT_MAGIC));
+    append_checkpoint_value(buf, ROUTE_CHECKPOINT_VERSION);
+
+    append_checkpoint_value(buf, uint32_t(placement_id.size()));
+    buf.insert(buf.end(), placement_id.begin(), placement_id.end());
+
+    append_checkpoint_value(buf, int32_t(checkpoint.itry));
+    append_checkpoint_value(buf, checkpoint.pres_fac);
+
+    append_checkpoint_value(buf, uint64_t(num_nodes));
+    for (RRNodeId inode : rr_graph.nodes()) {
+        append_checkpoint_value(buf, float(route_ctx.rr_node_route_inf[inode].acc_cost));
+    }
+
+    std::string tmp_file = std::string(checkpoint_file) + ".tmp";
+    {
+        std::ofstream fstream(tmp_file, std::ios::binary | std::ios::trunc);
+        if (!fstream || !fstream.write(buf.data(), buf.size())) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "'%s' - Cannot write route checkpoint.\n",
+                            tmp_file.c_str());
+        }
+    }
+
+    if (std::rename(tmp_file.c_str(), checkpoint_file) != 0) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "'%s' - Cannot replace route checkpoint with '%s'.\n",
+                        checkpoint_file, tmp_file.c_str());
+    }
+}
+
+bool read_route_checkpoint(const char* checkpoint_file, t_route_checkpoint& checkpoint) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& place_ctx = g_vpr_ctx.placement();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    std::vector<char> buf;
+    {
+        std::ifstream fstream(checkpoint_file, std::ios::binary | std::ios::ate);
+        if (!fstream) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "'%s' - Cannot open route checkpoint.\n",
+                            checkpoint_file);
+        }
+        buf.resize(size_t(fstream.tellg()));
+        fstream.seekg(0);
+        if (!fstream.read(buf.data(), buf.size())) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "'%s' - Cannot read route checkpoint.\n",
+                            checkpoint_file);
+        }
+    }
+
+    size_t offset = sizeof(ROUTE_CHECKPOINT_MAGIC);
+    uint32_t version = 0;
+    if (buf.size() < offset || !std::equal(std::begin(ROUTE_CHECKPOINT_MAGIC), std::end(ROUTE_CHECKPOINT_MAGIC), buf.begin())
+        || !read_checkpoint_value(buf, offset, version) || version != ROUTE_CHECKPOINT_VERSION) {
+        VTR_LOG_WARN("Ignoring route checkpoint %s: not written by this version of VPR\n", checkpoint_file);
+        return false;
+    }
+
+    uint32_t placement_id_size = 0;
+    bool valid = read_checkpoint_value(buf, offset, placement_id_size) && placement_id_size <= buf.size() - offset;
+    std::string placement_id;
+    if (valid) {
+        placement_id.assign(buf.data() + offset, placement_id_size);
+        offset += placement_id_size;
+    }
+
+    int32_t itry = 0;
+    float pres_fac = 0.;
+    uint64_t num_nodes = 0;
+    valid = valid
+            && read_checkpoint_value(buf, offset, itry)
+            && read_checkpoint_value(buf, offset, pres_fac)
+            && read_checkpoint_value(buf, offset, num_nodes)
+            && (buf.size() - offset) / sizeof(float) == num_nodes
+            && (buf.size() - offset) % sizeof(float) == 0;
+    if (!valid) {
+        VTR_LOG_WARN("Ignoring route checkpoint %s: truncated or corrupted\n", checkpoint_file);
+        return false;
+    }
+
+    if (placement_id != place_ctx.placement_id) {
+        VTR_LOG_WARN("Ignoring route checkpoint %s: written for another placement (ID %s != %s)\n",
+                     checkpoint_file, placement_id.c_str(), place_ctx.placement_id.c_str());
+        return false;
+    }
+
+    if (num_nodes != rr_graph.num_nodes()) {
+        VTR_LOG_WARN("Ignoring route checkpoint %s: written for a RR graph of %zu nodes, but the RR graph has %zu nodes\n",
+                     checkpoint_file, size_t(num_nodes), rr_graph.num_nodes());
+        return false;
+    }
+
+    for (RRNodeId inode : rr_graph.nodes()) {
+        float acc_cost;
+        std::memcpy(&acc_cost, buf.data() + offset, sizeof(acc_cost));
+        offset += sizeof(acc_cost);
+        route_ctx.rr_node_route_inf[inode].acc_cost = acc_cost;
+    }
+
+    checkpoint.itry = itry;
+    checkpoint.pres_fac = pres_fac;
+    return true;
+}
+
+template<typename T>
+static void append_checkpoint_value(std::vector<char>& buf, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool read_checkpoint_value(const std::vector<char>& buf, size_t& offset, T& value) {
+    if (buf.size() - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, buf.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
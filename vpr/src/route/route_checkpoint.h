@@ -0,0 +1,39 @@
+#ifndef VPR_ROUTE_CHECKPOINT_H
+#define VPR_ROUTE_CHECKPOINT_H
+
+/**
+ * @file
+ * @brief Checkpoints of the congestion state of the router, to resume an interrupted routing.
+ *
+ * The state the negotiated congestion router learns over its iterations is the accumulated
+ * (historical) cost of each RR node and the present congestion factor. A route checkpoint saves
+ * both at the end of a routing iteration. Routing resumed from it has to route every net again on
+ * its first iteration, but does so with the congestion history of the interrupted routing, instead
+ * of negotiating the congestion from scratch again.
+ */
+
+/**
+ * @brief The router iteration state saved in a route checkpoint (besides the accumulated costs)
+ */
+struct t_route_checkpoint {
+    int itry = 0;        ///<Number of routing iterations completed
+    float pres_fac = 0.; ///<Present congestion factor of the next iteration
+};
+
+/**
+ * @brief Writes checkpoint and the accumulated cost of every RR node to checkpoint_file
+ *
+ * The checkpoint is written to a temporary file which then replaces checkpoint_file,
+ * so an interruption never leaves a partial checkpoint behind.
+ */
+void write_route_checkpoint(const char* checkpoint_file, const t_route_checkpoint& checkpoint);
+
+/**
+ * @brief Reads a checkpoint written by write_route_checkpoint() and restores the accumulated cost of every RR node
+ *
+ * Returns false, leaving the accumulated costs untouched, if the checkpoint was written for another
+ * placement or RR graph (e.g. another channel width during a minimum channel width search).
+ */
+bool read_route_checkpoint(const char* checkpoint_file, t_route_checkpoint& checkpoint);
+
+#endif
@@ -31,6 +31,7 @@
 #include "atom_netlist_utils.h"
 
 #include "route_profiling.h"
+#include "read_route.h"
 
 #include "timing_util.h"
 #include "RoutingDelayCalculator.h"
@@ -40,6 +41,11 @@
 #include "bucket.h"
 #include "draw_global.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_reduce.h>
+#endif
+
 /*  The numbering relation between the channels and clbs is:				*
  *																	        *
  *  |    IO     | chan_   |   CLB     | chan_   |   CLB     |               *
@@ -70,6 +76,8 @@
  *                                                                          */
 
 /******************** Subroutines local to route_common.c *******************/
+static void update_chan_occupancy(t_chan_occupancy& chan_occupancy, const RRGraphView& rr_graph, RRNodeId inode, int add_or_sub);
+
 static vtr::vector<ParentNetId, std::vector<RRNodeId>> load_net_rr_terminals(const RRGraphView& rr_graph,
                                                                              const Netlist<>& net_list,
                                                                              bool is_flat);
@@ -255,6 +263,11 @@ bool try_route(const Netlist<>& net_list,
                        router_opts.has_choking_spot,
                        is_flat);
 
+    if (!router_opts.route_warm_start_file.empty()) {
+        //The nets which kept their routing are only rerouted if they are congested
+        load_warm_start_routing(net_list, router_opts.route_warm_start_file.c_str(), is_flat);
+    }
+
     if (net_list.nets().empty()) {
         VTR_LOG_WARN("No nets to route\n");
     }
@@ -374,6 +387,42 @@ void pathfinder_update_single_node_occupancy(RRNodeId inode, int add_or_sub) {
     route_ctx.rr_node_route_inf[inode].set_occ(occ);
     // can't have negative occupancy
     VTR_ASSERT(occ >= 0);
+
+    update_chan_occupancy(route_ctx.chan_occupancy, g_vpr_ctx.device().rr_graph, inode, add_or_sub);
+}
+
+/* Adds add_or_sub to the channel occupancy at every location spanned by inode, if it is a routing wire */
+static void update_chan_occupancy(t_chan_occupancy& chan_occupancy, const RRGraphView& rr_graph, RRNodeId inode, int add_or_sub) {
+    t_rr_type rr_type = rr_graph.node_type(inode);
+    if (chan_occupancy.empty() || (rr_type != CHANX && rr_type != CHANY)) {
+        return;
+    }
+
+    if (rr_type == CHANX) {
+        int y = rr_graph.node_ylow(inode);
+        for (int x = rr_graph.node_xlow(inode); x <= rr_graph.node_xhigh(inode); ++x) {
+            chan_occupancy.add_occ(CHANX, x, y, add_or_sub);
+        }
+    } else {
+        int x = rr_graph.node_xlow(inode);
+        for (int y = rr_graph.node_ylow(inode); y <= rr_graph.node_yhigh(inode); ++y) {
+            chan_occupancy.add_occ(CHANY, x, y, add_or_sub);
+        }
+    }
+}
+
+void recompute_chan_occupancy() {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    route_ctx.chan_occupancy.init(device_ctx.grid.width(), device_ctx.grid.height());
+    for (const RRNodeId& rr_id : rr_graph.nodes()) {
+        int occ = route_ctx.rr_node_route_inf[rr_id].occ();
+        if (occ != 0) {
+            update_chan_occupancy(route_ctx.chan_occupancy, rr_graph, rr_id, occ);
+        }
+    }
 }
 
 void pathfinder_update_acc_cost_and_overuse_info(float acc_fac, OveruseInfo& overuse_info) {
@@ -387,26 +436,52 @@ void pathfinder_update_acc_cost_and_overuse_info(float acc_fac, OveruseInfo& ove
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.mutable_routing();
-    size_t overused_nodes = 0, total_overuse = 0, worst_overuse = 0;
 
-    for (const RRNodeId& rr_id : rr_graph.nodes()) {
-        int overuse = route_ctx.rr_node_route_inf[rr_id].occ() - rr_graph.node_capacity(rr_id);
+    // Only the congestion lane is needed here, so sweep it directly
+    auto& cong_inf = route_ctx.rr_node_route_inf.cong_lane();
 
-        // If overused, update the acc_cost and add this node to the overuse info
-        // If not, do nothing
-        if (overuse > 0) {
-            route_ctx.rr_node_route_inf[rr_id].acc_cost += overuse * acc_fac;
+    // Updates the nodes [begin, end) and adds their overuse to sums
+    auto update_nodes = [&](size_t begin, size_t end, OveruseInfo sums) {
+        for (size_t inode = begin; inode < end; ++inode) {
+            RRNodeId rr_id(inode);
+            int overuse = cong_inf[rr_id].occ - rr_graph.node_capacity(rr_id);
 
-            ++overused_nodes;
-            total_overuse += overuse;
-            worst_overuse = std::max(worst_overuse, size_t(overuse));
+            // If overused, update the acc_cost and add this node to the overuse info
+            // If not, do nothing
+            if (overuse > 0) {
+                cong_inf[rr_id].acc_cost += overuse * acc_fac;
+
+                ++sums.overused_nodes;
+                sums.total_overuse += overuse;
+                sums.worst_overuse = std::max(sums.worst_overuse, size_t(overuse));
+            }
         }
-    }
+        return sums;
+    };
+
+    // Each node is updated independently, and the sums are integers,
+    // so the sweep is split over the threads when VPR is built with TBB
+    OveruseInfo sums;
+#ifdef VPR_USE_TBB
+    sums = tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, rr_graph.num_nodes()), sums,
+        [&](const tbb::blocked_range<size_t>& range, OveruseInfo range_sums) {
+            return update_nodes(range.begin(), range.end(), range_sums);
+        },
+        [](OveruseInfo lhs, const OveruseInfo& rhs) {
+            lhs.overused_nodes += rhs.overused_nodes;
+            lhs.total_overuse += rhs.total_overuse;
+            lhs.worst_overuse = std::max(lhs.worst_overuse, rhs.worst_overuse);
+            return lhs;
+        });
+#else
+    sums = update_nodes(0, rr_graph.num_nodes(), sums);
+#endif
 
     // Update overuse info
-    overuse_info.overused_nodes = overused_nodes;
-    overuse_info.total_overuse = total_overuse;
-    overuse_info.worst_overuse = worst_overuse;
+    overuse_info.overused_nodes = sums.overused_nodes;
+    overuse_info.total_overuse = sums.total_overuse;
+    overuse_info.worst_overuse = sums.worst_overuse;
 }
 
 /** Update pathfinder cost of all nodes rooted at rt_node, including rt_node itself */
@@ -466,19 +541,6 @@ void init_route_structs(const Netlist<>& net_list,
     }
 }
 
-/* The routine sets the path_cost to HUGE_POSITIVE_FLOAT for  *
- * all channel segments touched by previous routing phases.    */
-void reset_path_costs(const std::vector<RRNodeId>& visited_rr_nodes) {
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
-
-    for (auto node : visited_rr_nodes) {
-        route_ctx.rr_node_route_inf[node].path_cost = std::numeric_limits<float>::infinity();
-        route_ctx.rr_node_route_inf[node].backward_path_cost = std::numeric_limits<float>::infinity();
-        route_ctx.rr_node_route_inf[node].prev_node = RRNodeId::INVALID();
-        route_ctx.rr_node_route_inf[node].prev_edge = RREdgeId::INVALID();
-    }
-}
-
 /* Returns the congestion cost of using this rr-node plus that of any      *
  * non-configurably connected rr_nodes that must be used when it is used.  */
 float get_rr_cong_cost(RRNodeId inode, float pres_fac) {
@@ -488,10 +550,10 @@ float get_rr_cong_cost(RRNodeId inode, float pres_fac) {
     float cost = get_single_rr_cong_cost(inode, pres_fac);
 
     if (route_ctx.non_configurable_bitset.get(inode)) {
-        // Access unordered_map only when the node is part of a non-configurable set
-        auto itr = device_ctx.rr_node_to_non_config_node_set.find(inode);
-        if (itr != device_ctx.rr_node_to_non_config_node_set.end()) {
-            for (RRNodeId node : device_ctx.rr_non_config_node_sets[itr->second]) {
+        // Look up the set only when the node is part of a non-configurable set
+        int node_set = device_ctx.rr_non_config_node_sets.node_set(inode);
+        if (node_set != OPEN) {
+            for (RRNodeId node : device_ctx.rr_non_config_node_sets[node_set]) {
                 if (node == inode) {
                     continue; //Already included above
                 }
@@ -622,8 +684,11 @@ void alloc_and_load_rr_node_route_structs() {
 
     reset_rr_node_route_structs();
 
-    for (auto i : device_ctx.rr_node_to_non_config_node_set) {
-        route_ctx.non_configurable_bitset.set(i.first, true);
+    const auto& non_config_node_sets = device_ctx.rr_non_config_node_sets;
+    for (size_t iset = 0; iset < non_config_node_sets.size(); ++iset) {
+        for (RRNodeId node : non_config_node_sets[iset]) {
+            route_ctx.non_configurable_bitset.set(node, true);
+        }
     }
 }
 
@@ -637,7 +702,7 @@ void reset_rr_node_route_structs() {
     VTR_ASSERT(route_ctx.rr_node_route_inf.size() == size_t(device_ctx.rr_graph.num_nodes()));
 
     for (const RRNodeId& rr_id : device_ctx.rr_graph.nodes()) {
-        auto& node_inf = route_ctx.rr_node_route_inf[rr_id];
+        auto node_inf = route_ctx.rr_node_route_inf[rr_id];
 
         node_inf.prev_node = RRNodeId::INVALID();
         node_inf.prev_edge = RREdgeId::INVALID();
@@ -647,6 +712,8 @@ void reset_rr_node_route_structs() {
         node_inf.target_flag = 0;
         node_inf.set_occ(0);
     }
+
+    route_ctx.chan_occupancy.init(device_ctx.grid.width(), device_ctx.grid.height());
 }
 
 /* Allocates and loads the route_ctx.net_rr_terminals data structure. For each net it stores the rr_node   *
@@ -937,14 +1004,6 @@ t_bb load_net_route_bb(const Netlist<>& net_list,
     return bb;
 }
 
-void add_to_mod_list(RRNodeId inode, std::vector<RRNodeId>& modified_rr_node_inf) {
-    auto& route_ctx = g_vpr_ctx.routing();
-
-    if (std::isinf(route_ctx.rr_node_route_inf[inode].path_cost)) {
-        modified_rr_node_inf.push_back(inode);
-    }
-}
-
 //To ensure the router can only swap pins which are actually logically equivalent, some block output pins must be
 //reserved in certain cases.
 //
@@ -1054,6 +1113,7 @@ static void adjust_one_rr_occ_and_acc_cost(RRNodeId inode, int add_or_sub, float
     int new_occ = route_ctx.rr_node_route_inf[inode].occ() + add_or_sub;
     int capacity = rr_graph.node_capacity(inode);
     route_ctx.rr_node_route_inf[inode].set_occ(new_occ);
+    update_chan_occupancy(route_ctx.chan_occupancy, rr_graph, inode, add_or_sub);
 
     if (new_occ < capacity) {
     } else {
@@ -18,6 +18,9 @@ t_bb load_net_route_bb(const Netlist<>& net_list,
 
 void pathfinder_update_single_node_occupancy(RRNodeId inode, int add_or_sub);
 
+/** Rebuild the channel occupancy of the routing context from the occupancy of every rr node */
+void recompute_chan_occupancy();
+
 void pathfinder_update_acc_cost_and_overuse_info(float acc_fac, OveruseInfo& overuse_info);
 
 /** Update pathfinder cost of all nodes under root (including root) */
@@ -25,8 +28,6 @@ void pathfinder_update_cost_from_route_tree(const RouteTreeNode& root, int add_o
 
 float update_pres_fac(float new_pres_fac);
 
-void reset_path_costs(const std::vector<RRNodeId>& visited_rr_nodes);
-
 float get_rr_cong_cost(RRNodeId inode, float pres_fac);
 
 /* Returns the base cost of using this rr_node */
@@ -91,8 +92,6 @@ void mark_ends(const Netlist<>& net_list, ParentNetId net_id);
 
 void mark_remaining_ends(ParentNetId net_id);
 
-void add_to_mod_list(RRNodeId inode, std::vector<RRNodeId>& modified_rr_node_inf);
-
 void init_route_structs(const Netlist<>& net_list,
                         int bb_factor,
                         bool has_choking_point,
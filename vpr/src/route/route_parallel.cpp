@@ -11,6 +11,8 @@
 
 #include "binary_heap.h"
 #include "bucket.h"
+#include "four_ary_heap.h"
+#include "radix_heap.h"
 #include "concrete_timing_info.h"
 #include "connection_router.h"
 #include "draw.h"
@@ -24,7 +26,11 @@
 #include "route_parallel.h"
 // all functions in profiling:: namespace, which are only activated if PROFILE is defined
 #include "route_profiling.h"
+#include "global_route.h"
+#include "router_lookahead_profiler.h"
+#include "router_telemetry.h"
 #include "timing_util.h"
+#include "vtr_memory.h"
 #include "vtr_time.h"
 
 #include "NetPinTimingInvalidator.h"
@@ -32,8 +38,14 @@
 #ifdef VPR_USE_TBB
 
 #    include "tbb/enumerable_thread_specific.h"
+#    include "tbb/parallel_for.h"
 #    include "tbb/task_group.h"
 
+/** Maximum number of batches of a partition tree node which are filled at the same time (see batch_node_nets()) */
+constexpr size_t MAX_OPEN_NET_BATCHES = 8;
+/** Maximum number of nets in a batch (see batch_node_nets()) */
+constexpr size_t MAX_NET_BATCH_SIZE = 64;
+
 /** route_net and similar functions need many bits of state collected from various
  * parts of VPR, collect them here for ease of use */
 template<typename ConnectionRouter>
@@ -56,11 +68,41 @@ class RouteIterCtx {
     const RoutingPredictor& routing_predictor;
     const vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>>& choking_spots;
     bool is_flat;
+    /** How much to grow net BBs by when building the PartitionTree (nonzero in deterministic mode) */
+    int partition_bb_margin;
+    /** How much to grow net BBs by when batching the nets of a partition tree node
+     * (see batch_node_nets()), or -1 if these nets are routed serially */
+    int batch_bb_margin;
+    /** Estimated routing work per net, used to balance the PartitionTree.
+     * Starts as fanout * BB area and gets replaced by the heap pushes measured when routing the net */
+    vtr::vector<ParentNetId, float>& net_work;
 };
 
+/** Get the largest x or y span of any rr node in \p rr_graph.
+ * A node is only reachable if it overlaps a net's BB, so it can extend at most this
+ * many tiles outside the BB. Growing BBs by this much before partitioning makes sure
+ * that sibling partitions never touch the same rr node. */
+static int get_max_rr_node_span(const RRGraphView& rr_graph);
+
+/** Does \p net_id only connect terminals of the same tile? In flat routing such a net
+ * (e.g. between two primitives of a cluster) normally stays within the intra-cluster
+ * resources of its tile, so the routing work does not grow with its route BB. */
+static bool net_is_intra_tile(const RRGraphView& rr_graph, const std::vector<RRNodeId>& net_terminals);
+
+/** Split \p nets (in routing order) into batches of nets which can be routed concurrently, to be routed in order.
+ * The nets of a batch have BBs which don't overlap once grown by \p bb_margin, so they can't reach the same rr node.
+ * Each net goes to the first of the (at most MAX_OPEN_NET_BATCHES) open batches where it fits. If none fits,
+ * the oldest open batch is closed and the net starts a new one. This keeps nets roughly in routing order. */
+static std::vector<std::vector<ParentNetId>> batch_node_nets(const std::vector<ParentNetId>& nets, int bb_margin);
+
 /** Helper for reduce_partition_tree. Traverse \p node's subtree and collect results into \p results */
 static void reduce_partition_tree_helper(const PartitionTreeNode& node, RouteIterResults& results);
 
+/** Get the routing work (see RouteIterCtx::net_work) of \p node's subtree: the total, and the work of the most
+ * expensive root to leaf path, which bounds the routing time however many threads there are.
+ * Returns <total work, critical path work> */
+static std::pair<float, float> get_partition_tree_work(const PartitionTreeNode& node, const vtr::vector<ParentNetId, float>& net_work);
+
 /**
  * Try to route in parallel with the given ConnectionRouter.
  * ConnectionRouter is typically templated with a heap type, so this lets us
@@ -109,6 +151,63 @@ static RouteIterResults route_without_partition_tree(std::vector<ParentNetId>& n
 
 /************************ Subroutine definitions *****************************/
 
+static bool net_is_intra_tile(const RRGraphView& rr_graph, const std::vector<RRNodeId>& net_terminals) {
+    if (net_terminals.empty())
+        return false;
+    RRNodeId source = net_terminals[0];
+    for (RRNodeId terminal : net_terminals) {
+        if (rr_graph.node_layer(terminal) != rr_graph.node_layer(source)
+            || rr_graph.node_xlow(terminal) != rr_graph.node_xlow(source)
+            || rr_graph.node_ylow(terminal) != rr_graph.node_ylow(source))
+            return false;
+    }
+    return true;
+}
+
+static std::vector<std::vector<ParentNetId>> batch_node_nets(const std::vector<ParentNetId>& nets, int bb_margin) {
+    const auto& route_bb = g_vpr_ctx.routing().route_bb;
+
+    // BBs grown by bb_margin on each side overlap iff the original BBs are within 2 * bb_margin
+    auto overlaps = [&](ParentNetId a, ParentNetId b) {
+        const t_bb& bb_a = route_bb[a];
+        const t_bb& bb_b = route_bb[b];
+        return bb_a.xmin <= bb_b.xmax + 2 * bb_margin && bb_b.xmin <= bb_a.xmax + 2 * bb_margin
+               && bb_a.ymin <= bb_b.ymax + 2 * bb_margin && bb_b.ymin <= bb_a.ymax + 2 * bb_margin;
+    };
+
+    std::vector<std::vector<ParentNetId>> batches;
+    std::vector<std::vector<ParentNetId>> open_batches; // Oldest first
+    for (ParentNetId net_id : nets) {
+        auto fits = [&](const std::vector<ParentNetId>& batch) {
+            return batch.size() < MAX_NET_BATCH_SIZE
+                   && std::none_of(batch.begin(), batch.end(), [&](ParentNetId other) { return overlaps(net_id, other); });
+        };
+        auto batch_it = std::find_if(open_batches.begin(), open_batches.end(), fits);
+        if (batch_it != open_batches.end()) {
+            batch_it->push_back(net_id);
+            continue;
+        }
+        if (open_batches.size() == MAX_OPEN_NET_BATCHES) {
+            batches.push_back(std::move(open_batches.front()));
+            open_batches.erase(open_batches.begin());
+        }
+        open_batches.push_back({net_id});
+    }
+    for (auto& batch : open_batches) {
+        batches.push_back(std::move(batch));
+    }
+    return batches;
+}
+
+static int get_max_rr_node_span(const RRGraphView& rr_graph) {
+    int max_span = 0;
+    for (RRNodeId inode : rr_graph.nodes()) {
+        max_span = std::max(max_span, rr_graph.node_xhigh(inode) - rr_graph.node_xlow(inode));
+        max_span = std::max(max_span, rr_graph.node_yhigh(inode) - rr_graph.node_ylow(inode));
+    }
+    return max_span;
+}
+
 bool try_parallel_route(const Netlist<>& net_list,
                         const t_det_routing_arch& det_routing_arch,
                         const t_router_opts& router_opts,
@@ -146,6 +245,30 @@ bool try_parallel_route(const Netlist<>& net_list,
                                                                      delay_calc,
                                                                      first_iteration_priority,
                                                                      is_flat);
+        case e_heap_type::FOUR_ARY_HEAP:
+            return try_parallel_route_tmpl<ConnectionRouter<FourAryHeap>>(net_list,
+                                                                          det_routing_arch,
+                                                                          router_opts,
+                                                                          analysis_opts,
+                                                                          segment_inf,
+                                                                          net_delay,
+                                                                          netlist_pin_lookup,
+                                                                          timing_info,
+                                                                          delay_calc,
+                                                                          first_iteration_priority,
+                                                                          is_flat);
+        case e_heap_type::RADIX_HEAP:
+            return try_parallel_route_tmpl<ConnectionRouter<RadixHeap>>(net_list,
+                                                                        det_routing_arch,
+                                                                        router_opts,
+                                                                        analysis_opts,
+                                                                        segment_inf,
+                                                                        net_delay,
+                                                                        netlist_pin_lookup,
+                                                                        timing_info,
+                                                                        delay_calc,
+                                                                        first_iteration_priority,
+                                                                        is_flat);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap type %d", router_opts.router_heap);
     }
@@ -220,6 +343,7 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
                                                                           router_opts.write_router_lookahead,
                                                                           router_opts.read_router_lookahead,
                                                                           segment_inf,
+                                                                          router_opts.lookahead_half_precision,
                                                                           is_flat);
 
     if (is_flat) {
@@ -240,6 +364,7 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
                                                        router_opts.write_router_lookahead,
                                                        router_opts.read_router_lookahead,
                                                        segment_inf,
+                                                       router_opts.lookahead_half_precision,
                                                        is_flat);
         if (!router_opts.write_intra_cluster_router_lookahead.empty()) {
             router_lookahead->write_intra_cluster(router_opts.write_intra_cluster_router_lookahead);
@@ -248,6 +373,18 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
 
     VTR_ASSERT(router_lookahead != nullptr);
 
+    router_telemetry::Session telemetry(router_opts.write_router_connection_telemetry, *router_lookahead);
+    router_lookahead_profiler::Session lookahead_profile(router_opts.write_router_lookahead_profile,
+                                                         *router_lookahead,
+                                                         router_opts.router_lookahead_profile_correction,
+                                                         router_opts.write_router_lookahead);
+
+    if (router_opts.global_route_corridors) {
+        route_ctx.connection_route_bb = compute_global_route_corridors(net_list, router_opts);
+    } else {
+        route_ctx.connection_route_bb.clear();
+    }
+
     /*
      * Routing parameters
      */
@@ -290,6 +427,10 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
     std::shared_ptr<SetupHoldTimingInfo> route_timing_info;
     {
         vtr::ScopedStartFinishTimer init_timing_timer("Initializing router criticalities");
+
+        //Warm started nets are only rerouted if congested, so their delays are those of their routing
+        init_net_delay_from_route_trees(net_list, net_delay);
+
         if (timing_info) {
             if (router_opts.initial_timing == e_router_initial_timing::ALL_CRITICAL) {
                 //First routing iteration, make all nets critical for a min-delay routing
@@ -333,10 +474,44 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
 
     tbb::task_group tbb_task_group;
 
-    /* Set up thread local storage.
-     * tbb::enumerable_thread_specific will construct the elements as needed.
-     * see https://spec.oneapi.io/versions/1.0-rev-3/elements/oneTBB/source/thread_local_storage/enumerable_thread_specific_cls/construct_destroy_copy.html */
-    auto routers = tbb::enumerable_thread_specific<ConnectionRouter>(ConnectionRouter(
+    /* In deterministic mode, nets close enough to a cutline to share rr nodes with the other
+     * side are kept in the parent node. Then no two concurrently routed nets can read or write
+     * the same rr_node_route_inf entry, and the results don't depend on thread scheduling. */
+    int partition_bb_margin = 0;
+    if (router_opts.deterministic_parallel_route) {
+        partition_bb_margin = get_max_rr_node_span(device_ctx.rr_graph);
+        VTR_LOG("Deterministic parallel routing: growing partition BBs by %d\n", partition_bb_margin);
+    }
+
+    /* The nets of a batch route concurrently, so they must never touch the same rr node (even outside
+     * deterministic mode): they share the search data of rr_node_route_inf */
+    int batch_bb_margin = -1;
+    if (router_opts.parallel_route_cutline_nets) {
+        batch_bb_margin = router_opts.deterministic_parallel_route ? partition_bb_margin : get_max_rr_node_span(device_ctx.rr_graph);
+        VTR_LOG("Routing the nets of each partition in parallel batches (BB margin %d)\n", batch_bb_margin);
+    }
+
+    /* Initial work estimates for balancing the partition tree. These get overwritten by
+     * measurements as soon as a net is routed. In flat routing the nets local to a tile are
+     * estimated as if their BB was that tile: otherwise their (expanded) route BBs make them
+     * look as expensive as global nets, and the first iteration's cutlines are poorly balanced */
+    vtr::vector<ParentNetId, float> net_work(net_list.nets().size());
+    for (auto net_id : net_list.nets()) {
+        const t_bb& bb = route_ctx.route_bb[net_id];
+        float bb_area = (bb.xmax - bb.xmin + 1) * (bb.ymax - bb.ymin + 1);
+        if (is_flat && net_is_intra_tile(device_ctx.rr_graph, route_ctx.net_rr_terminals[net_id]))
+            bb_area = 1;
+        net_work[net_id] = net_list.net_sinks(net_id).size() * bb_area;
+    }
+
+    if (router_opts.bidir_search_min_dist >= 0) {
+        /* The bidirectional search walks the RR graph backwards. This has to happen
+         * before the routers take their view of the RR graph. */
+        g_vpr_ctx.mutable_device().rr_graph_builder.init_in_edges();
+    }
+
+    /* Here we provide an "exemplar" to copy for each thread */
+    ConnectionRouter router_exemplar(
         device_ctx.grid,
         *router_lookahead,
         device_ctx.rr_graph.rr_nodes(),
@@ -344,7 +519,13 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
         device_ctx.rr_rc_data,
         device_ctx.rr_graph.rr_switch(),
         route_ctx.rr_node_route_inf,
-        is_flat)); /* Here we provide an "exemplar" to copy for each thread */
+        is_flat);
+    router_exemplar.set_bidir_search_min_dist(router_opts.bidir_search_min_dist);
+
+    /* Set up thread local storage.
+     * tbb::enumerable_thread_specific will construct the elements as needed.
+     * see https://spec.oneapi.io/versions/1.0-rev-3/elements/oneTBB/source/thread_local_storage/enumerable_thread_specific_cls/construct_destroy_copy.html */
+    auto routers = tbb::enumerable_thread_specific<ConnectionRouter>(router_exemplar);
     auto router_stats_thread = tbb::enumerable_thread_specific<RouterStats>();
     auto route_structs = tbb::enumerable_thread_specific<timing_driven_route_structs>(net_list);
 
@@ -366,8 +547,17 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
 
     int rcv_finished_count = RCV_FINISH_EARLY_COUNTDOWN;
 
+    bool timing_update_skipped = false; //Whether the last iteration skipped its timing update
+
     print_route_status_header();
     for (itry = 1; itry <= router_opts.max_router_iterations; ++itry) {
+        router_telemetry::set_iteration(itry);
+
+        if (itry == 2) {
+            //The global routing corridors only guide the first, congestion unaware, iteration
+            vtr::release_memory(route_ctx.connection_route_bb);
+        }
+
         for (auto& stats : router_stats_thread) {
             init_router_stats(stats);
         }
@@ -411,7 +601,10 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
             worst_negative_slack,
             routing_predictor,
             choking_spots,
-            is_flat};
+            is_flat,
+            partition_bb_margin,
+            batch_bb_margin,
+            net_work};
 
         vtr::Timer net_routing_timer;
         RouteIterResults iter_results = route_with_partition_tree(tbb_task_group, iter_ctx);
@@ -454,11 +647,17 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
         routing_predictor.add_iteration_overuse(itry, overuse_info.overused_nodes);
 
         if (timing_info) {
-            //Update timing based on the new routing
+            //Update timing based on the new routing, unless no (critical) connection delay changed
             //Note that the net delays have already been updated by parallel_route_net
-            timing_info->update();
-            timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during routing
-            pin_timing_invalidator->reset();
+            if (should_skip_timing_update(itry, router_opts, net_list, netlist_pin_lookup, timing_info, *pin_timing_invalidator,
+                                          iter_results.rerouted_nets, routing_is_feasible, timing_update_skipped, is_flat)) {
+                timing_update_skipped = true;
+            } else {
+                timing_info->update();
+                timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during routing
+                pin_timing_invalidator->reset();
+                timing_update_skipped = false;
+            }
 
             //Use the real timing analysis criticalities for subsequent routing iterations
             //  'route_timing_info' is what is actually passed into the net/connection routers,
@@ -793,6 +992,8 @@ bool try_parallel_route_tmpl(const Netlist<>& net_list,
     VTR_LOG("total_number_of_adding_all_rt: %zu ", router_stats.add_all_rt);
     VTR_LOG("total_number_of_adding_high_fanout_rt: %zu ", router_stats.add_high_fanout_rt);
     VTR_LOG("total_number_of_adding_all_rt_from_calling_high_fanout_rt: %zu ", router_stats.add_all_rt_from_high_fanout);
+    VTR_LOG("total_number_of_bidir_searches: %zu ", router_stats.bidir_searches);
+    VTR_LOG("total_number_of_bidir_meets: %zu ", router_stats.bidir_meets);
     VTR_LOG("\n");
 
     PartitionTreeDebug::write("partition_tree.log");
@@ -878,54 +1079,101 @@ NetResultFlags try_parallel_route_net(ConnectionRouter& router,
     return flags;
 }
 
+/* Routes a net with the state in ctx, and returns its flags and measured work (heap pushes).
+ * Only touches per-net or thread local state, so nets with distinct BBs can go through it concurrently */
+template<typename ConnectionRouter>
+static NetResultFlags route_ctx_net(RouteIterCtx<ConnectionRouter>& ctx, ParentNetId net_id, float& work) {
+    //Keep the messages of each net together, instead of interleaved with those of the other threads
+    vtr::ScopedLogBuffer log_buffer;
+
+    size_t heap_pushes_before = ctx.router_stats.local().heap_pushes;
+    auto flags = try_parallel_route_net(
+        ctx.routers.local(),
+        ctx.net_list,
+        net_id,
+        ctx.itry,
+        ctx.pres_fac,
+        ctx.router_opts,
+        ctx.connections_inf,
+        ctx.router_stats.local(),
+        ctx.route_structs.local().pin_criticality,
+        ctx.net_delay,
+        ctx.netlist_pin_lookup,
+        ctx.timing_info,
+        ctx.pin_timing_invalidator,
+        ctx.budgeting_inf,
+        ctx.worst_negative_slack,
+        ctx.routing_predictor,
+        ctx.choking_spots[net_id],
+        ctx.is_flat);
+    work = ctx.router_stats.local().heap_pushes - heap_pushes_before;
+    return flags;
+}
+
 /* Helper for route_partition_tree(). */
 template<typename ConnectionRouter>
 void route_partition_tree_helper(tbb::task_group& g,
                                  PartitionTreeNode& node,
                                  RouteIterCtx<ConnectionRouter>& ctx,
                                  vtr::linear_map<ParentNetId, int>& nets_to_retry) {
-    /* Sort so net with most sinks is routed first. */
+    /* Sort so net with most sinks is routed first. Break ties with the net ID so that
+     * the routing order within a node is fixed. */
     std::sort(node.nets.begin(), node.nets.end(), [&](const ParentNetId id1, const ParentNetId id2) -> bool {
-        return ctx.net_list.net_sinks(id1).size() > ctx.net_list.net_sinks(id2).size();
+        size_t sinks1 = ctx.net_list.net_sinks(id1).size();
+        size_t sinks2 = ctx.net_list.net_sinks(id2).size();
+        if (sinks1 != sinks2)
+            return sinks1 > sinks2;
+        return id1 < id2;
     });
 
     node.is_routable = true;
     node.rerouted_nets.clear();
+    std::vector<ParentNetId> my_nets_to_retry;
 
-    vtr::Timer t;
-    for (auto net_id : node.nets) {
-        auto flags = try_parallel_route_net(
-            ctx.routers.local(),
-            ctx.net_list,
-            net_id,
-            ctx.itry,
-            ctx.pres_fac,
-            ctx.router_opts,
-            ctx.connections_inf,
-            ctx.router_stats.local(),
-            ctx.route_structs.local().pin_criticality,
-            ctx.net_delay,
-            ctx.netlist_pin_lookup,
-            ctx.timing_info,
-            ctx.pin_timing_invalidator,
-            ctx.budgeting_inf,
-            ctx.worst_negative_slack,
-            ctx.routing_predictor,
-            ctx.choking_spots[net_id],
-            ctx.is_flat);
+    vtr::ScopedActionTimer t("Route partition tree node");
 
+    /* Records the result of a net, in routing order */
+    auto record_net = [&](ParentNetId net_id, const NetResultFlags& flags, float work) {
         if (!flags.success && !flags.retry_with_full_bb) {
             node.is_routable = false;
         }
         if (flags.was_rerouted) {
             node.rerouted_nets.push_back(net_id);
+            /* Each net is only in one node, so no other thread writes this entry */
+            ctx.net_work[net_id] = work;
         }
-        /* If we need to retry this net with full-device BB, it will go up to the top
-         * of the tree, so remove it from this node and keep track of it */
+        /* If we need to retry this net with full-device BB, it is rerouted after the
+         * partition tree, so remove it from this node and keep track of it */
         if (flags.retry_with_full_bb) {
-            node.nets.erase(std::remove(node.nets.begin(), node.nets.end(), net_id), node.nets.end());
+            my_nets_to_retry.push_back(net_id);
             nets_to_retry[net_id] = true;
         }
+    };
+
+    if (ctx.batch_bb_margin < 0) {
+        for (auto net_id : node.nets) {
+            float work;
+            auto flags = route_ctx_net(ctx, net_id, work);
+            record_net(net_id, flags, work);
+        }
+    } else {
+        /* The nets of a batch can't reach the same rr nodes, so they route concurrently. The batches
+         * are routed in order, so each sees the congestion of the batches before it */
+        for (const auto& batch : batch_node_nets(node.nets, ctx.batch_bb_margin)) {
+            std::vector<NetResultFlags> batch_flags(batch.size());
+            std::vector<float> batch_work(batch.size());
+            tbb::parallel_for(size_t(0), batch.size(), [&](size_t inet) {
+                batch_flags[inet] = route_ctx_net(ctx, batch[inet], batch_work[inet]);
+            });
+            for (size_t inet = 0; inet < batch.size(); inet++) {
+                record_net(batch[inet], batch_flags[inet], batch_work[inet]);
+            }
+        }
+    }
+
+    /* Don't erase while iterating over node.nets above */
+    for (auto net_id : my_nets_to_retry) {
+        node.nets.erase(std::remove(node.nets.begin(), node.nets.end(), net_id), node.nets.end());
     }
 
     PartitionTreeDebug::log("Node with " + std::to_string(node.nets.size()) + " nets routed in " + std::to_string(t.elapsed_sec()) + " s");
@@ -943,6 +1191,23 @@ void route_partition_tree_helper(tbb::task_group& g,
     }
 }
 
+static std::pair<float, float> get_partition_tree_work(const PartitionTreeNode& node, const vtr::vector<ParentNetId, float>& net_work) {
+    float node_work = 0.;
+    for (ParentNetId net_id : node.rerouted_nets) {
+        node_work += net_work[net_id];
+    }
+
+    float total_work = node_work;
+    float max_child_critical_work = 0.;
+    for (const auto* child : {node.left.get(), node.right.get()}) {
+        if (!child) continue;
+        auto child_work = get_partition_tree_work(*child, net_work);
+        total_work += child_work.first;
+        max_child_critical_work = std::max(max_child_critical_work, child_work.second);
+    }
+    return {total_work, node_work + max_child_critical_work};
+}
+
 /** Reduce results from partition tree into a single RouteIterResults */
 static void reduce_partition_tree_helper(const PartitionTreeNode& node, RouteIterResults& results) {
     results.is_routable &= node.is_routable;
@@ -971,40 +1236,81 @@ RouteIterResults route_partition_tree(tbb::task_group& g,
     auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     /* a net id -> retry? vector
-     * not a bool vector or a set because multiple threads may be writing on it */
-    vtr::linear_map<ParentNetId, int> nets_to_retry;
+     * not a bool vector or a set because multiple threads may be writing on it.
+     * Sized up front so that no thread ever resizes it while others are inserting */
+    vtr::linear_map<ParentNetId, int> nets_to_retry(ctx.net_list.nets().size());
 
     route_partition_tree_helper(g, tree.root(), ctx, nets_to_retry);
     g.wait();
 
-    /* grow bounding box and add to top level if there is any net to retry */
-    for (const auto& kv : nets_to_retry) {
-        if (kv.second) {
-            ParentNetId net_id = kv.first;
-            route_ctx.route_bb[net_id] = {
-                0,
-                (int)(device_ctx.grid.width() - 1),
-                0,
-                (int)(device_ctx.grid.height() - 1)};
-            tree.root().nets.push_back(net_id);
-        }
+    /* How well could this iteration scale? The nets of a partition (and its ancestors) must route
+     * before its children, so the most expensive root to leaf path is routed serially */
+    float total_work, critical_work;
+    std::tie(total_work, critical_work) = get_partition_tree_work(tree.root(), ctx.net_work);
+    if (critical_work > 0.) {
+        VTR_LOG("# Partition tree routing work: %g heap pushes, %g on the critical path (parallel speedup bound %.2fx)\n",
+                total_work, critical_work, total_work / critical_work);
     }
 
     RouteIterResults out;
     reduce_partition_tree_helper(tree.root(), out);
+
+    /* Nets which could not be routed within their BB would break the isolation of the partitions if their BB grew,
+     * so they were left partially routed. Now that no other thread is routing, grow their BB to the full device and
+     * reroute them serially, as the serial router would have, instead of leaving them unrouted until the next iteration.
+     * (They are already in the rerouted nets of the node which first routed them.) */
+    size_t num_retried_nets = 0;
+    for (const auto& kv : nets_to_retry) {
+        if (!kv.second) continue;
+
+        ParentNetId net_id = kv.first;
+        route_ctx.route_bb[net_id] = {
+            0,
+            (int)(device_ctx.grid.width() - 1),
+            0,
+            (int)(device_ctx.grid.height() - 1)};
+
+        float work;
+        auto flags = route_ctx_net(ctx, net_id, work);
+        if (!flags.success) {
+            out.is_routable = false;
+        }
+        ctx.net_work[net_id] += work;
+        ++num_retried_nets;
+    }
+    if (num_retried_nets > 0) {
+        VTR_LOG("# Rerouted %zu nets with a full-device bounding box after the partition tree\n", num_retried_nets);
+    }
+
     for (auto& thread_stats : ctx.router_stats) {
         update_router_stats(out.stats, thread_stats);
     }
     return out;
 }
 
-/* Build a partition tree and route with it */
+/* Build a partition tree and route with it.
+ * Only the nets which need rerouting are put in the tree, so the cutlines are
+ * balanced over the work actually done in this iteration. */
 template<typename ConnectionRouter>
 static RouteIterResults route_with_partition_tree(tbb::task_group& g, RouteIterCtx<ConnectionRouter>& ctx) {
     vtr::Timer t2;
-    PartitionTree partition_tree(ctx.net_list);
+
+    std::vector<ParentNetId> nets_to_route;
+    for (auto net_id : ctx.net_list.nets()) {
+        if (ctx.net_list.net_is_ignored(net_id))
+            continue;
+        bool reroute_for_hold = false;
+        if (ctx.budgeting_inf.if_set()) {
+            reroute_for_hold = ctx.budgeting_inf.get_should_reroute(net_id);
+            reroute_for_hold &= ctx.worst_negative_slack != 0;
+        }
+        if (reroute_for_hold || should_route_net(net_id, ctx.connections_inf, true))
+            nets_to_route.push_back(net_id);
+    }
+
+    PartitionTree partition_tree(ctx.net_list, nets_to_route, ctx.net_work, ctx.partition_bb_margin);
     float total_prep_time = t2.elapsed_sec();
-    VTR_LOG("# Built partition tree in %f seconds\n", total_prep_time);
+    VTR_LOG("# Built partition tree with %zu nets in %f seconds\n", nets_to_route.size(), total_prep_time);
 
     return route_partition_tree(g, partition_tree, ctx);
 }
@@ -1,6 +1,8 @@
 #include "route_path_manager.h"
 #include "globals.h"
 
+#include <algorithm>
+
 PathManager::PathManager() {
     // Only init data structure if required by RCV
     // Is disabled by default
@@ -17,8 +19,8 @@ bool PathManager::node_exists_in_tree(t_heap_path* path_data,
     if (!path_data || !is_enabled_) return false;
 
     // First check the smaller current path, the ordering of these checks might effect runtime slightly
-    for (auto& node : path_data->path_rr) {
-        if (node == to_node) {
+    for (int link = path_data->path_tail; link != NO_PATH_LINK; link = path_links_[link].prev) {
+        if (path_links_[link].node == to_node) {
             return true;
         }
     }
@@ -42,16 +44,31 @@ void PathManager::mark_node_visited(RRNodeId node) {
 void PathManager::insert_backwards_path_into_traceback(t_heap_path* path_data, float cost, float backward_path_cost, RoutingContext& route_ctx) {
     if (!is_enabled_) return;
 
-    for (unsigned i = 1; i < path_data->edge.size() - 1; i++) {
-        RRNodeId node_2 = path_data->path_rr[i];
-        RREdgeId edge = path_data->edge[i - 1];
-        route_ctx.rr_node_route_inf[node_2].prev_node = path_data->path_rr[i - 1];
+    // The path is only reconstructed (from its last node) for the sink
+    traceback_path_.clear();
+    for (int link = path_data->path_tail; link != NO_PATH_LINK; link = path_links_[link].prev) {
+        traceback_path_.push_back(&path_links_[link]);
+    }
+    std::reverse(traceback_path_.begin(), traceback_path_.end());
+
+    for (unsigned i = 1; i + 1 < traceback_path_.size(); i++) {
+        RRNodeId node_2 = traceback_path_[i]->node;
+        RREdgeId edge = traceback_path_[i - 1]->edge;
+        route_ctx.rr_node_route_inf[node_2].prev_node = traceback_path_[i - 1]->node;
         route_ctx.rr_node_route_inf[node_2].prev_edge = edge;
         route_ctx.rr_node_route_inf[node_2].path_cost = cost;
         route_ctx.rr_node_route_inf[node_2].backward_path_cost = backward_path_cost;
     }
 }
 
+void PathManager::extend_path(t_heap_path* dest, const t_heap_path* src, RRNodeId from_node, RREdgeId from_edge) {
+    if (!is_enabled_) return;
+
+    // Only the new node is stored, it links to the (shared) partial path of src
+    path_links_.push_back({from_node, from_edge, src->path_tail});
+    dest->path_tail = path_links_.size() - 1;
+}
+
 bool PathManager::is_enabled() {
     return is_enabled_;
 }
@@ -61,8 +78,6 @@ void PathManager::set_enabled(bool enable) {
 }
 
 void PathManager::alloc_path_struct(t_heap_path*& tptr) {
-    // TODO: Use arena allocation for this part
-
     // If RCV isn't enabled return a nullptr
     if (!is_enabled_) {
         return;
@@ -75,13 +90,12 @@ void PathManager::alloc_path_struct(t_heap_path*& tptr) {
         tptr = freed_nodes_.back();
         freed_nodes_.pop_back();
     } else {
-        tptr = new t_heap_path;
-        alloc_list_.push_back(tptr);
+        alloc_list_.emplace_back();
+        tptr = &alloc_list_.back();
     }
     // }
 
-    tptr->path_rr.clear();
-    tptr->edge.clear();
+    tptr->path_tail = NO_PATH_LINK;
     tptr->backward_cong = 0.;
     tptr->backward_delay = 0.;
 }
@@ -95,27 +109,31 @@ void PathManager::free_path_struct(t_heap_path*& tptr) {
 }
 
 void PathManager::free_all_memory() {
-    // Only delete freed nodes because doing a partial arena alloc scheme
-    // Actually delete in heap_type
-    for (t_heap_path* node : alloc_list_) {
-        delete node;
-    }
+    freed_nodes_.clear();
+    alloc_list_.clear();
+    path_links_.clear();
 }
 
 void PathManager::empty_heap() {
     if (!is_enabled_) return;
 
-    freed_nodes_.resize(alloc_list_.size());
+    // Put all of alloc_list_ into the freed nodes list
+    freed_nodes_.clear();
+    for (t_heap_path& node : alloc_list_) {
+        freed_nodes_.push_back(&node);
+    }
 
-    // Copy alloc_list_ into the freed nodes list
-    std::copy(alloc_list_.begin(), alloc_list_.end(), freed_nodes_.begin());
+    // No partial path is in use anymore
+    path_links_.clear();
 }
 
 void PathManager::update_route_tree_set(t_heap_path* cheapest_path_struct) {
     if (!is_enabled_) return;
 
     // Add all values in path struct to the route tree nodes set
-    route_tree_nodes_.insert(cheapest_path_struct->path_rr.begin(), cheapest_path_struct->path_rr.end());
+    for (int link = cheapest_path_struct->path_tail; link != NO_PATH_LINK; link = path_links_[link].prev) {
+        route_tree_nodes_.insert(path_links_[link].node);
+    }
 }
 
 void PathManager::empty_route_tree_nodes() {
@@ -4,25 +4,40 @@
 #include <set>
 #include <list>
 #include <vector>
+#include <deque>
 
 #ifndef _PATH_MANAGER_H
 #    define _PATH_MANAGER_H
 
+/* A node of a partial path, stored in the PathManager's path arena
+ *
+ * node: A node of the partial path
+ *
+ * edge: The edge from node to reach the next node of the path
+ *
+ * prev: The arena index of the previous node of the path, or NO_PATH_LINK for its first node */
+struct t_path_link {
+    RRNodeId node;
+    RREdgeId edge;
+    int prev;
+};
+
+constexpr int NO_PATH_LINK = -1;
+
 /* Extra path data needed by RCV, seperated from t_heap struct for performance reasons
  * Can be accessed by a pointer, won't be initialized unless by RCV
  * Use PathManager class to handle this structure's allocation and deallocation
  *
- * path_rr: The entire partial path up until the route tree with the first node being the SOURCE,
- *          or a part of the route tree that already exists for this net 
- * 
- * edge: A list of edges from each node in the partial path to reach the next node
+ * path_tail: The arena index of the last node of the partial path up until the route tree (see t_path_link),
+ *            or NO_PATH_LINK if the path is empty. Following the prev links leads to the path's first node,
+ *            the SOURCE or a part of the route tree that already exists for this net. The partial paths
+ *            of the heap elements share their common prefixes, so extending a path does not copy it
  * 
  * backward_delay: The delay of the partial path plus the path from route tree to source
  * 
  * backward_cong: The congestion estimate of the partial path plus the path from route tree to source */
 struct t_heap_path {
-    std::vector<RRNodeId> path_rr;
-    std::vector<RREdgeId> edge;
+    int path_tail = NO_PATH_LINK;
     float backward_delay = 0.;
     float backward_cong = 0.;
 };
@@ -76,6 +91,9 @@ class PathManager {
     // Insert the partial path data into the main route context traceback
     void insert_backwards_path_into_traceback(t_heap_path* path_data, float cost, float backward_path_cost, RoutingContext& route_ctx);
 
+    // Set the partial path of dest to the partial path of src followed by from_node (reached by from_edge)
+    void extend_path(t_heap_path* dest, const t_heap_path* src, RRNodeId from_node, RREdgeId from_edge);
+
     // Dynamically create a t_heap_path structure to be used in the heap
     // Will return unless RCV is enabled
     void alloc_path_struct(t_heap_path*& tptr);
@@ -90,8 +108,8 @@ class PathManager {
     // Cleanup and free all the allocated memory, called when PathManager is destroyed
     void free_all_memory();
 
-    // Put all currently allocated structures into the free_nodes list
-    // This currently does NOT invalidate them
+    // Put all currently allocated structures into the free_nodes list and clear the path arena
+    // This currently does NOT invalidate them, but their partial paths are lost
     // Ideally used before a t_heap empty_heap() call
     void empty_heap();
 
@@ -106,8 +124,8 @@ class PathManager {
     // Is RCV enabled and thus route_tree_nodes in use
     bool is_enabled_;
 
-    // This is a list of all currently allocated heap path pointers
-    std::vector<t_heap_path*> alloc_list_;
+    // All the allocated heap path structures, a deque so the pointers to them stay valid
+    std::deque<t_heap_path> alloc_list_;
 
     // A list of freed nodes, to be used where possible to avoid unnecessary news
     std::vector<t_heap_path*> freed_nodes_;
@@ -115,6 +133,12 @@ class PathManager {
     // Set containing the current route tree, for faster lookup
     // Required by RCV so the router doesn't expand already visited nodes
     std::set<RRNodeId> route_tree_nodes_;
+
+    // Arena holding the nodes of all the partial paths of the heap elements, cleared by empty_heap()
+    std::vector<t_path_link> path_links_;
+
+    // The partial path being inserted into the traceback, kept to avoid re-allocating it
+    std::vector<const t_path_link*> traceback_path_;
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <ctime>
 #include <cmath>
+#include <limits>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
@@ -12,7 +13,9 @@
 #include "rr_graph_fwd.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_memory.h"
 #include "vtr_time.h"
+#include "vtr_util.h"
 
 #include "vpr_utils.h"
 #include "vpr_types.h"
@@ -31,16 +34,23 @@
 #include "move_utils.h"
 #include "rr_graph.h"
 #include "routing_predictor.h"
+#include "route_checkpoint.h"
 #include "VprTimingGraphResolver.h"
 
 // all functions in profiling:: namespace, which are only activated if PROFILE is defined
 #include "route_profiling.h"
+#include "global_route.h"
+#include "router_lookahead_profiler.h"
+#include "router_telemetry.h"
+#include "router_connection_capture.h"
 
 #include "concrete_timing_info.h"
 #include "timing_util.h"
 #include "route_budgets.h"
 #include "binary_heap.h"
 #include "bucket.h"
+#include "four_ary_heap.h"
+#include "radix_heap.h"
 #include "connection_router.h"
 
 #include "tatum/TimingReporter.hpp"
@@ -117,6 +127,23 @@ static std::tuple<bool, bool> timing_driven_pre_route_to_clock_root(ConnectionRo
                                                                     bool is_flat,
                                                                     bool can_grow_bb);
 
+/** Routes the target_pins of a global (e.g. clock) net with a single search, instead of one for each sink:
+ * the cheapest paths from the route tree to all the nodes of the net's bounding box are found at once, and
+ * each sink is connected to the route tree along its path. Suits the (tree like) dedicated clock networks,
+ * where there is little to gain from searching for each sink separately.
+ * @return The target pins which could not be reached, to be routed individually */
+template<typename ConnectionRouter>
+static std::vector<int> timing_driven_route_sinks_in_batch(ConnectionRouter& router,
+                                                           const Netlist<>& net_list,
+                                                           ParentNetId net_id,
+                                                           const std::vector<int>& target_pins,
+                                                           t_conn_cost_params cost_params,
+                                                           int high_fanout_threshold,
+                                                           RouteTree& tree,
+                                                           SpatialRouteTreeLookup& spatial_rt_lookup,
+                                                           RouterStats& router_stats,
+                                                           bool is_flat);
+
 static void setup_routing_resources(int itry,
                                     ParentNetId net_id,
                                     const Netlist<>& net_list,
@@ -153,6 +180,8 @@ struct more_sinks_than {
 
 static bool is_high_fanout(int fanout, int fanout_threshold);
 
+static size_t order_congested_nets_first(const Netlist<>& net_list, std::vector<ParentNetId>& nets);
+
 // The reason that try_timing_driven_route_tmpl (and descendents) are being
 // templated over is because using a virtual interface instead fully templating
 // the router results in a 5% runtime increase.
@@ -210,6 +239,30 @@ bool try_timing_driven_route(const Netlist<>& net_list,
                                                                           delay_calc,
                                                                           first_iteration_priority,
                                                                           is_flat);
+        case e_heap_type::FOUR_ARY_HEAP:
+            return try_timing_driven_route_tmpl<ConnectionRouter<FourAryHeap>>(net_list,
+                                                                               det_routing_arch,
+                                                                               router_opts,
+                                                                               analysis_opts,
+                                                                               segment_inf,
+                                                                               net_delay,
+                                                                               netlist_pin_lookup,
+                                                                               timing_info,
+                                                                               delay_calc,
+                                                                               first_iteration_priority,
+                                                                               is_flat);
+        case e_heap_type::RADIX_HEAP:
+            return try_timing_driven_route_tmpl<ConnectionRouter<RadixHeap>>(net_list,
+                                                                             det_routing_arch,
+                                                                             router_opts,
+                                                                             analysis_opts,
+                                                                             segment_inf,
+                                                                             net_delay,
+                                                                             netlist_pin_lookup,
+                                                                             timing_info,
+                                                                             delay_calc,
+                                                                             first_iteration_priority,
+                                                                             is_flat);
         default:
             VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Unknown heap type %d", router_opts.router_heap);
     }
@@ -291,6 +344,7 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
                                                                           router_opts.write_router_lookahead,
                                                                           router_opts.read_router_lookahead,
                                                                           segment_inf,
+                                                                          router_opts.lookahead_half_precision,
                                                                           is_flat);
 
     if (is_flat) {
@@ -311,6 +365,7 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
                                                        router_opts.write_router_lookahead,
                                                        router_opts.read_router_lookahead,
                                                        segment_inf,
+                                                       router_opts.lookahead_half_precision,
                                                        is_flat);
         if (!router_opts.write_intra_cluster_router_lookahead.empty()) {
             router_lookahead->write_intra_cluster(router_opts.write_intra_cluster_router_lookahead);
@@ -319,6 +374,19 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
 
     VTR_ASSERT(router_lookahead != nullptr);
 
+    router_telemetry::Session telemetry(router_opts.write_router_connection_telemetry, *router_lookahead);
+    router_capture::Session connection_capture(router_opts.write_router_connection_capture, router_opts.router_connection_capture_limit);
+    router_lookahead_profiler::Session lookahead_profile(router_opts.write_router_lookahead_profile,
+                                                         *router_lookahead,
+                                                         router_opts.router_lookahead_profile_correction,
+                                                         router_opts.write_router_lookahead);
+
+    if (router_opts.global_route_corridors) {
+        route_ctx.connection_route_bb = compute_global_route_corridors(net_list, router_opts);
+    } else {
+        route_ctx.connection_route_bb.clear();
+    }
+
     /*
      * Routing parameters
      */
@@ -350,6 +418,12 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
     RoutingMetrics best_routing_metrics;
     int legal_convergence_count = 0;
 
+    if (router_opts.bidir_search_min_dist >= 0) {
+        // The bidirectional search walks the RR graph backwards. This has to happen
+        // before the router takes its view of the RR graph.
+        g_vpr_ctx.mutable_device().rr_graph_builder.init_in_edges();
+    }
+
     ConnectionRouter router(
         device_ctx.grid,
         *router_lookahead,
@@ -359,6 +433,7 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
         device_ctx.rr_graph.rr_switch(),
         route_ctx.rr_node_route_inf,
         is_flat);
+    router.set_bidir_search_min_dist(router_opts.bidir_search_min_dist);
 
     /*
      * On the first routing iteration ignore congestion to get reasonable net
@@ -370,6 +445,10 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
     std::shared_ptr<SetupHoldTimingInfo> route_timing_info;
     {
         vtr::ScopedStartFinishTimer init_timing_timer("Initializing router criticalities");
+
+        //Warm started nets are only rerouted if congested, so their delays are those of their routing
+        init_net_delay_from_route_trees(net_list, net_delay);
+
         if (timing_info) {
             if (router_opts.initial_timing == e_router_initial_timing::ALL_CRITICAL) {
                 //First routing iteration, make all nets critical for a min-delay routing
@@ -431,8 +510,28 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
 
     int rcv_finished_count = RCV_FINISH_EARLY_COUNTDOWN;
 
+    bool timing_update_skipped = false; //Whether the last iteration skipped its timing update
+
+    //Resume the congestion state of an interrupted routing, if it was checkpointed
+    t_route_checkpoint resumed_checkpoint;
+    bool resumed = !router_opts.route_checkpoint_file.empty()
+                   && vtr::file_exists(router_opts.route_checkpoint_file.c_str())
+                   && read_route_checkpoint(router_opts.route_checkpoint_file.c_str(), resumed_checkpoint);
+    if (resumed) {
+        VTR_LOG("Resuming routing with the congestion costs after routing iteration %d (pres_fac %g)\n",
+                resumed_checkpoint.itry, resumed_checkpoint.pres_fac);
+    }
+
     print_route_status_header();
     for (itry = 1; itry <= router_opts.max_router_iterations; ++itry) {
+        router_telemetry::set_iteration(itry);
+        router_capture::set_iteration(itry);
+
+        if (itry == 2) {
+            //The global routing corridors only guide the first, congestion unaware, iteration
+            vtr::release_memory(route_ctx.connection_route_bb);
+        }
+
         RouterStats router_iteration_stats;
         init_router_stats(router_iteration_stats);
         std::vector<ParentNetId> rerouted_nets;
@@ -453,10 +552,29 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
             worst_negative_slack = timing_info->hold_total_negative_slack();
         }
 
+        //Until the first legal routing, optionally reroute the congested nets first and end
+        //the iteration once they have resolved all the overuse (see --congestion_driven_net_order)
+        bool congestion_driven_order = router_opts.congestion_driven_net_order
+                                       && itry > 1
+                                       && legal_convergence_count == 0
+                                       && overuse_info.overused_nodes > 0;
+        std::vector<ParentNetId> iteration_nets = sorted_nets;
+        size_t num_congested_nets = 0;
+        if (congestion_driven_order) {
+            num_congested_nets = order_congested_nets_first(net_list, iteration_nets);
+        }
+
         /*
          * Route each net
          */
-        for (auto net_id : sorted_nets) {
+        for (size_t inet = 0; inet < iteration_nets.size(); ++inet) {
+            if (congestion_driven_order && inet == num_congested_nets && feasible_routing()) {
+                //The remaining nets are legal: leave their (timing driven) reroutes
+                //to the iterations after the routing has converged
+                break;
+            }
+
+            ParentNetId net_id = iteration_nets[inet];
             NetResultFlags flags = try_timing_driven_route_net(router,
                                                                net_list,
                                                                net_id,
@@ -512,11 +630,17 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
         routing_predictor.add_iteration_overuse(itry, overuse_info.overused_nodes);
 
         if (timing_info) {
-            //Update timing based on the new routing
+            //Update timing based on the new routing, unless no (critical) connection delay changed
             //Note that the net delays have already been updated by timing_driven_route_net
-            timing_info->update();
-            timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during routing
-            pin_timing_invalidator->reset();
+            if (should_skip_timing_update(itry, router_opts, net_list, netlist_pin_lookup, timing_info, *pin_timing_invalidator,
+                                          rerouted_nets, routing_is_feasible, timing_update_skipped, is_flat)) {
+                timing_update_skipped = true;
+            } else {
+                timing_info->update();
+                timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during routing
+                pin_timing_invalidator->reset();
+                timing_update_skipped = false;
+            }
 
             //Use the real timing analysis criticalities for subsequent routing iterations
             //  'route_timing_info' is what is actually passed into the net/connection routers,
@@ -664,7 +788,8 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
 
         //Update pres_fac
         if (itry == 1) {
-            pres_fac = update_pres_fac(router_opts.initial_pres_fac);
+            //A resumed routing picks up the congestion factor where it stopped
+            pres_fac = update_pres_fac(resumed ? std::max(router_opts.initial_pres_fac, resumed_checkpoint.pres_fac) : router_opts.initial_pres_fac);
         } else {
             pres_fac *= router_opts.pres_fac_mult;
 
@@ -788,6 +913,13 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
         if (router_opts.congestion_analysis) profiling::congestion_analysis();
         if (router_opts.fanout_analysis) profiling::time_on_fanout_analysis();
         // profiling::time_on_criticality_analysis();
+
+        if (!router_opts.route_checkpoint_file.empty()) {
+            t_route_checkpoint checkpoint;
+            checkpoint.itry = (resumed ? resumed_checkpoint.itry : 0) + itry;
+            checkpoint.pres_fac = pres_fac;
+            write_route_checkpoint(router_opts.route_checkpoint_file.c_str(), checkpoint);
+        }
     }
 
     if (routing_is_successful) {
@@ -849,6 +981,8 @@ bool try_timing_driven_route_tmpl(const Netlist<>& net_list,
     VTR_LOG("total_number_of_adding_all_rt: %zu ", router_stats.add_all_rt);
     VTR_LOG("total_number_of_adding_high_fanout_rt: %zu ", router_stats.add_high_fanout_rt);
     VTR_LOG("total_number_of_adding_all_rt_from_calling_high_fanout_rt: %zu ", router_stats.add_all_rt_from_high_fanout);
+    VTR_LOG("total_number_of_bidir_searches: %zu ", router_stats.bidir_searches);
+    VTR_LOG("total_number_of_bidir_meets: %zu ", router_stats.bidir_meets);
     VTR_LOG("\n");
 
     return routing_is_successful;
@@ -981,13 +1115,10 @@ NetResultFlags timing_driven_route_net(ConnectionRouter& router,
 
     bool high_fanout = is_high_fanout(num_sinks, router_opts.high_fanout_threshold);
 
-    SpatialRouteTreeLookup spatial_route_tree_lookup;
-    if (high_fanout) {
-        spatial_route_tree_lookup = build_route_tree_spatial_lookup(net_list,
-                                                                    route_ctx.route_bb,
-                                                                    net_id,
-                                                                    tree.root());
-    }
+    // The tree keeps its spatial lookup up to date as it is pruned and grown, so it is only built once per net
+    SpatialRouteTreeLookup no_spatial_route_tree_lookup;
+    SpatialRouteTreeLookup& spatial_route_tree_lookup = high_fanout ? tree.spatial_lookup(net_list, route_ctx.route_bb)
+                                                                    : no_spatial_route_tree_lookup;
 
     // after this point the route tree is correct
     // remaining_targets from this point on are the **pin indices** that have yet to be routed
@@ -1040,8 +1171,9 @@ NetResultFlags timing_driven_route_net(ConnectionRouter& router,
         cost_params.criticality = router_opts.max_criticality;
 
         /* Is the connection router allowed to grow the bounding box? That's not the case
-         * when routing in parallel, so disallow it. TODO: Have both timing_driven and parallel
-         * routers handle this in the same way */
+         * when routing in parallel: the parallel router reroutes the net with a full-device
+         * bounding box once its partition tree is routed. TODO: Have both timing_driven and
+         * parallel routers handle this in the same way */
         bool can_grow_bb = (router_opts.router_algorithm != PARALLEL);
 
         std::tie(flags.success, flags.retry_with_full_bb) = timing_driven_pre_route_to_clock_root(router,
@@ -1056,16 +1188,37 @@ NetResultFlags timing_driven_route_net(ConnectionRouter& router,
                                                                                                   is_flat,
                                                                                                   can_grow_bb);
 
-        return flags;
+        if (!flags.success) {
+            return flags;
+        }
     }
 
     if (budgeting_inf.if_set()) {
         budgeting_inf.set_should_reroute(net_id, false);
     }
 
+    // Global nets (without delay budgets to meet) can have their sinks routed in a batch,
+    // only the sinks it could not reach are then routed individually
+    const std::vector<int>* targets_to_route = &remaining_targets;
+    std::vector<int> unrouted_targets;
+    if (net_list.net_is_global(net_id) && router_opts.batch_clock_routing && !budgeting_inf.if_set() && !remaining_targets.empty()) {
+        cost_params.criticality = pin_criticality[remaining_targets[0]];
+        unrouted_targets = timing_driven_route_sinks_in_batch(router,
+                                                              net_list,
+                                                              net_id,
+                                                              remaining_targets,
+                                                              cost_params,
+                                                              router_opts.high_fanout_threshold,
+                                                              tree,
+                                                              spatial_route_tree_lookup,
+                                                              router_stats,
+                                                              is_flat);
+        targets_to_route = &unrouted_targets;
+    }
+
     // explore in order of decreasing criticality (no longer need sink_order array)
-    for (unsigned itarget = 0; itarget < remaining_targets.size(); ++itarget) {
-        int target_pin = remaining_targets[itarget];
+    for (unsigned itarget = 0; itarget < targets_to_route->size(); ++itarget) {
+        int target_pin = (*targets_to_route)[itarget];
 
         RRNodeId sink_rr = route_ctx.net_rr_terminals[net_id][target_pin];
 
@@ -1163,7 +1316,7 @@ static std::tuple<bool, bool> timing_driven_pre_route_to_clock_root(ConnectionRo
 
     t_bb bounding_box = route_ctx.route_bb[net_id];
 
-    router.clear_modified_rr_node_info();
+    router.reset_path_costs();
 
     bool found_path, retry_with_full_bb;
     t_heap cheapest;
@@ -1228,6 +1381,71 @@ static std::tuple<bool, bool> timing_driven_pre_route_to_clock_root(ConnectionRo
     return std::make_tuple(true, false);
 }
 
+template<typename ConnectionRouter>
+static std::vector<int> timing_driven_route_sinks_in_batch(ConnectionRouter& router,
+                                                           const Netlist<>& net_list,
+                                                           ParentNetId net_id,
+                                                           const std::vector<int>& target_pins,
+                                                           t_conn_cost_params cost_params,
+                                                           int high_fanout_threshold,
+                                                           RouteTree& tree,
+                                                           SpatialRouteTreeLookup& spatial_rt_lookup,
+                                                           RouterStats& router_stats,
+                                                           bool is_flat) {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    VTR_LOGV_DEBUG(f_router_debug, "Net %zu routing %zu sinks in a batch\n", size_t(net_id), target_pins.size());
+
+    bool high_fanout = is_high_fanout(net_list.net_sinks(net_id).size(), high_fanout_threshold);
+
+    router.reset_path_costs();
+
+    // There is no single target to look ahead to
+    cost_params.astar_fac = 0.;
+    ConnectionParameters conn_params(net_id,
+                                     -1,
+                                     false,
+                                     std::unordered_map<RRNodeId, int>());
+
+    vtr::vector<RRNodeId, t_heap> cheapest_paths = router.timing_driven_find_all_shortest_paths_from_route_tree(tree.root(),
+                                                                                                              cost_params,
+                                                                                                              route_ctx.route_bb[net_id],
+                                                                                                              router_stats,
+                                                                                                              conn_params);
+
+    // The paths form a tree of the cheapest paths from the route tree, so each sink's path stays valid
+    // (through the rr_node_route_inf traceback) as the previous sinks' paths are added to the route tree
+    std::vector<int> unrouted_pins;
+    for (int target_pin : target_pins) {
+        RRNodeId sink_node = route_ctx.net_rr_terminals[net_id][target_pin];
+        t_heap& cheapest = cheapest_paths[sink_node];
+        if (cheapest.index == RRNodeId::INVALID()) {
+            unrouted_pins.push_back(target_pin);
+            continue;
+        }
+
+        route_ctx.rr_node_route_inf[sink_node].target_flag--; /* Connected to this SINK. */
+
+        vtr::optional<const RouteTreeNode&> new_branch, new_sink;
+        std::tie(new_branch, new_sink) = tree.update_from_heap(&cheapest, target_pin, ((high_fanout) ? &spatial_rt_lookup : nullptr), is_flat);
+
+        VTR_ASSERT_DEBUG(!high_fanout || validate_route_tree_spatial_lookup(tree.root(), spatial_rt_lookup));
+
+        /* update global occupancy from the new branch */
+        if (new_branch)
+            pathfinder_update_cost_from_route_tree(new_branch.value(), 1);
+
+        ++router_stats.connections_routed;
+    }
+
+    router.reset_path_costs();
+
+    VTR_LOGV_DEBUG(f_router_debug, "Net %zu routed %zu of its %zu sinks in a batch\n",
+                   size_t(net_id), target_pins.size() - unrouted_pins.size(), target_pins.size());
+
+    return unrouted_pins;
+}
+
 template<typename ConnectionRouter>
 static NetResultFlags timing_driven_route_sink(ConnectionRouter& router,
                                                const Netlist<>& net_list,
@@ -1253,14 +1471,15 @@ static NetResultFlags timing_driven_route_sink(ConnectionRouter& router,
     RRNodeId sink_node = route_ctx.net_rr_terminals[net_id][target_pin];
     VTR_LOGV_DEBUG(f_router_debug, "Net %zu Target %d (%s)\n", size_t(net_id), itarget, describe_rr_node(device_ctx.rr_graph, device_ctx.grid, device_ctx.rr_indexed_data, sink_node, is_flat).c_str());
 
-    router.clear_modified_rr_node_info();
+    router.reset_path_costs();
 
     bool found_path;
     t_heap cheapest;
     t_bb bounding_box = route_ctx.route_bb[net_id];
 
     /* Is the connection router allowed to grow the bounding box? That's not the case
-     * when routing in parallel, so disallow it. */
+     * when routing in parallel, so disallow it (the parallel router reroutes the net with
+     * a full-device bounding box once its partition tree is routed). */
     bool can_grow_bb = (router_opts.router_algorithm != PARALLEL);
 
     bool net_is_global = net_list.net_is_global(net_id);
@@ -1272,10 +1491,16 @@ static NetResultFlags timing_driven_route_sink(ConnectionRouter& router,
     bool has_choking_spot = ((int)choking_spots[target_pin].size() != 0) && router_opts.has_choking_spot;
     ConnectionParameters conn_params(net_id, target_pin, has_choking_spot, choking_spots[target_pin]);
 
+    router_telemetry::t_connection_start telemetry_start;
+    if (router_telemetry::enabled()) {
+        telemetry_start = router_telemetry::connection_start(router_stats);
+    }
+
     //We normally route high fanout nets by only adding spatially close-by routing to the heap (reduces run-time).
     //However, if the current sink is 'critical' from a timing perspective, we put the entire route tree back onto
     //the heap to ensure it has more flexibility to find the best path.
-    if (high_fanout && !sink_critical && !net_is_global && !net_is_clock && -routing_predictor.get_slope() > router_opts.high_fanout_max_slope) {
+    bool high_fanout_routing = high_fanout && !sink_critical && !net_is_global && !net_is_clock && -routing_predictor.get_slope() > router_opts.high_fanout_max_slope;
+    if (high_fanout_routing) {
         std::tie(found_path, flags.retry_with_full_bb, cheapest) = router.timing_driven_route_connection_from_route_tree_high_fanout(tree.root(),
                                                                                                                                      sink_node,
                                                                                                                                      cost_params,
@@ -1285,16 +1510,42 @@ static NetResultFlags timing_driven_route_sink(ConnectionRouter& router,
                                                                                                                                      conn_params,
                                                                                                                                      can_grow_bb);
     } else {
-        std::tie(found_path, flags.retry_with_full_bb, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
-                                                                                                                         sink_node,
-                                                                                                                         cost_params,
-                                                                                                                         bounding_box,
-                                                                                                                         router_stats,
-                                                                                                                         conn_params,
-                                                                                                                         can_grow_bb);
+        found_path = false;
+
+        if (router_capture::enabled()) {
+            router_capture::capture_connection(tree, sink_node, cost_params, bounding_box);
+        }
+
+        //The first iteration searches within the connection's global routing corridor, if any,
+        //and falls back to the net's bounding box if the corridor has no path
+        if (size_t(net_id) < route_ctx.connection_route_bb.size() && !route_ctx.connection_route_bb[net_id].empty()) {
+            std::tie(found_path, std::ignore, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
+                                                                                                                sink_node,
+                                                                                                                cost_params,
+                                                                                                                route_ctx.connection_route_bb[net_id][target_pin],
+                                                                                                                router_stats,
+                                                                                                                conn_params,
+                                                                                                                /*can_grow_bb=*/false);
+        }
+
+        if (!found_path) {
+            std::tie(found_path, flags.retry_with_full_bb, cheapest) = router.timing_driven_route_connection_from_route_tree(tree.root(),
+                                                                                                                             sink_node,
+                                                                                                                             cost_params,
+                                                                                                                             bounding_box,
+                                                                                                                             router_stats,
+                                                                                                                             conn_params,
+                                                                                                                             can_grow_bb);
+        }
     }
 
     if (!found_path) {
+        if (router_telemetry::enabled()) {
+            router_telemetry::connection_finish(telemetry_start, router_stats, net_id, target_pin, tree.root().inode, sink_node, cost_params,
+                                                high_fanout_routing, found_path, flags.retry_with_full_bb,
+                                                std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN());
+        }
+
         ParentBlockId src_block = net_list.net_driver_block(net_id);
         ParentBlockId sink_block = net_list.pin_block(*(net_list.net_pins(net_id).begin() + target_pin));
         VTR_LOG("Failed to route connection from '%s' to '%s' for net '%s' (#%zu)\n",
@@ -1319,6 +1570,17 @@ static NetResultFlags timing_driven_route_sink(ConnectionRouter& router,
 
     VTR_ASSERT_DEBUG(!high_fanout || validate_route_tree_spatial_lookup(tree.root(), spatial_rt_lookup));
 
+    if (router_lookahead_profiler::enabled() && new_sink) {
+        router_lookahead_profiler::record_connection(*new_sink);
+    }
+
+    if (router_telemetry::enabled()) {
+        float sink_delay = new_sink ? new_sink->Tdel : std::numeric_limits<float>::quiet_NaN();
+        router_telemetry::connection_finish(telemetry_start, router_stats, net_id, target_pin, tree.root().inode, sink_node, cost_params,
+                                            high_fanout_routing, found_path, flags.retry_with_full_bb,
+                                            cheapest.backward_path_cost, sink_delay);
+    }
+
     if (f_router_debug) {
         std::string msg = vtr::string_fmt("Routed Net %zu connection %d to RR node %d successfully", size_t(net_id), itarget, sink_node);
         update_screen(ScreenUpdatePriority::MAJOR, msg.c_str(), ROUTING, nullptr);
@@ -1389,27 +1651,22 @@ static void setup_routing_resources(int itry,
             pathfinder_update_cost_from_route_tree(tree.value().root(), 1);
         }
 
-        /* copy the existing routing
-         * prune() depends on global occ, so we can't subtract before pruning
-         * OPT: to skip this copy, return a "diff" from RouteTree::prune */
-        RouteTree tree2 = tree.value();
-
         // Skip this check if RCV is enabled, as RCV can use another method to cause reroutes
         VTR_ASSERT_SAFE(should_route_net(net_id, connections_inf, true) || router_opts.routing_budgets_algorithm == YOYO);
 
-        // Prune the copy (using congestion data before subtraction)
-        vtr::optional<RouteTree&> pruned_tree2 = tree2.prune(connections_inf);
+        /* Prune the congested branches in place. prune() depends on global occ, so the
+         * occupancy of the pruned nodes is only subtracted after pruning. Only the pruned
+         * branches are touched: the legal rest of the tree (usually most of a high fanout
+         * net) is neither copied nor re-added to the occupancy. */
+        std::vector<RRNodeId> pruned_nodes;
+        vtr::optional<RouteTree&> pruned_tree = tree.value().prune(connections_inf, nullptr, &pruned_nodes);
 
-        // Subtract congestion using the non-pruned original
-        pathfinder_update_cost_from_route_tree(tree.value().root(), -1);
+        for (RRNodeId inode : pruned_nodes) {
+            pathfinder_update_single_node_occupancy(inode, -1);
+        }
 
-        if (pruned_tree2) { //Partially pruned
+        if (pruned_tree) { //Partially pruned
             profiling::route_tree_preserved();
-
-            // Add back congestion for the pruned route tree
-            pathfinder_update_cost_from_route_tree(pruned_tree2.value().root(), 1);
-            // pruned_tree2 is no longer required -> we can move rather than copy
-            tree = std::move(pruned_tree2.value());
         } else { // Fully destroyed
             profiling::route_tree_pruned();
 
@@ -1466,10 +1723,6 @@ void update_rr_route_inf_from_tree(const RouteTreeNode& rt_node) {
         route_ctx.rr_node_route_inf[inode].prev_node = RRNodeId::INVALID();
         route_ctx.rr_node_route_inf[inode].prev_edge = RREdgeId::INVALID();
 
-        // path cost should be unset
-        VTR_ASSERT(std::isinf(route_ctx.rr_node_route_inf[inode].path_cost));
-        VTR_ASSERT(std::isinf(route_ctx.rr_node_route_inf[inode].backward_path_cost));
-
         update_rr_route_inf_from_tree(child);
     }
 }
@@ -1795,6 +2048,33 @@ static bool is_high_fanout(int fanout, int fanout_threshold) {
     return true;
 }
 
+//Moves the nets whose routing uses overused rr nodes to the front of nets, those using
+//the most overused nodes first. The relative order of the other nets is unchanged.
+//Returns the number of such (congested) nets.
+static size_t order_congested_nets_first(const Netlist<>& net_list, std::vector<ParentNetId>& nets) {
+    auto& route_ctx = g_vpr_ctx.routing();
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    std::vector<int> num_overused_nodes(net_list.nets().size(), 0);
+    for (auto net_id : nets) {
+        if (!route_ctx.route_trees[net_id])
+            continue;
+        for (auto& rt_node : route_ctx.route_trees[net_id].value().all_nodes()) {
+            if (route_ctx.rr_node_route_inf[rt_node.inode].occ() > rr_graph.node_capacity(rt_node.inode))
+                ++num_overused_nodes[size_t(net_id)];
+        }
+    }
+
+    auto congested_end = std::stable_partition(nets.begin(), nets.end(), [&](ParentNetId net_id) {
+        return num_overused_nodes[size_t(net_id)] > 0;
+    });
+    std::stable_sort(nets.begin(), congested_end, [&](ParentNetId net1, ParentNetId net2) {
+        return num_overused_nodes[size_t(net1)] > num_overused_nodes[size_t(net2)];
+    });
+
+    return std::distance(nets.begin(), congested_end);
+}
+
 // In heavily congested designs a static bounding box (BB) can
 // become problematic for routability (it effectively enforces a
 // hard blockage restricting where a net can route).
@@ -1979,6 +2259,43 @@ bool should_setup_lower_bound_connection_delays(int itry, const t_router_opts& /
     return false;
 }
 
+bool should_skip_timing_update(int itry,
+                               const t_router_opts& router_opts,
+                               const Netlist<>& net_list,
+                               const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                               std::shared_ptr<SetupHoldTimingInfo> timing_info,
+                               const NetPinTimingInvalidator& pin_timing_invalidator,
+                               const std::vector<ParentNetId>& rerouted_nets,
+                               bool routing_is_feasible,
+                               bool last_update_skipped,
+                               bool is_flat) {
+    //The criticalities of the 1st iteration may not come from timing analysis (e.g. all critical)
+    if (itry == 1) return false;
+
+    //Nothing to update
+    if (pin_timing_invalidator.empty()) return true;
+
+    if (router_opts.skip_timing_update_criticality <= 0.) return false;
+    if (routing_is_feasible || last_update_skipped) return false;
+    if (router_opts.routing_budgets_algorithm != DISABLE) return false; //Budgets are updated from the timing analysis
+
+    for (ParentNetId net_id : rerouted_nets) {
+        for (ParentPinId pin_id : net_list.net_sinks(net_id)) {
+            float pin_criticality = get_net_pin_criticality(timing_info,
+                                                            netlist_pin_lookup,
+                                                            router_opts.max_criticality,
+                                                            router_opts.criticality_exp,
+                                                            net_id,
+                                                            pin_id,
+                                                            is_flat);
+            if (pin_criticality >= router_opts.skip_timing_update_criticality) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool is_better_quality_routing(const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
                                const RoutingMetrics& best_routing_metrics,
                                const WirelengthInfo& wirelength_info,
@@ -2093,6 +2410,7 @@ void init_net_delay_from_lookahead(const RouterLookahead& router_lookahead,
 
     for (auto net_id : net_list.nets()) {
         if (net_list.net_is_ignored(net_id)) continue;
+        if (g_vpr_ctx.routing().route_trees[net_id]) continue; //See init_net_delay_from_route_trees()
 
         RRNodeId source_rr = net_rr_terminals[net_id][0];
 
@@ -2113,6 +2431,17 @@ void init_net_delay_from_lookahead(const RouterLookahead& router_lookahead,
     }
 }
 
+// Initializes net_delay of the already routed nets from their route trees
+void init_net_delay_from_route_trees(const Netlist<>& net_list, NetPinsMatrix<float>& net_delay) {
+    const auto& route_ctx = g_vpr_ctx.routing();
+
+    for (auto net_id : net_list.nets()) {
+        if (net_list.net_is_ignored(net_id) || !route_ctx.route_trees[net_id]) continue;
+
+        update_net_delays_from_route_tree(net_delay[net_id].data(), net_list, net_id, nullptr, nullptr);
+    }
+}
+
 void update_router_stats(RouterStats& router_stats, RouterStats& router_iteration_stats) {
     router_stats.connections_routed += router_iteration_stats.connections_routed;
     router_stats.nets_routed += router_iteration_stats.nets_routed;
@@ -2134,6 +2463,10 @@ void update_router_stats(RouterStats& router_stats, RouterStats& router_iteratio
     router_stats.add_all_rt += router_iteration_stats.add_all_rt;
     router_stats.add_all_rt_from_high_fanout += router_iteration_stats.add_all_rt_from_high_fanout;
     router_stats.add_high_fanout_rt += router_iteration_stats.add_high_fanout_rt;
+    router_stats.bidir_searches += router_iteration_stats.bidir_searches;
+    router_stats.bidir_meets += router_iteration_stats.bidir_meets;
+    router_stats.high_fanout_full_tree_retries += router_iteration_stats.high_fanout_full_tree_retries;
+    router_stats.full_device_bb_retries += router_iteration_stats.full_device_bb_retries;
 }
 
 void init_router_stats(RouterStats& router_stats) {
@@ -2157,6 +2490,10 @@ void init_router_stats(RouterStats& router_stats) {
     router_stats.add_all_rt = 0;
     router_stats.add_high_fanout_rt = 0;
     router_stats.add_all_rt_from_high_fanout = 0;
+    router_stats.bidir_searches = 0;
+    router_stats.bidir_meets = 0;
+    router_stats.high_fanout_full_tree_retries = 0;
+    router_stats.full_device_bb_retries = 0;
 }
 
 vtr::vector<ParentNetId, std::vector<std::unordered_map<RRNodeId, int>>> set_nets_choking_spots(const Netlist<>& net_list,
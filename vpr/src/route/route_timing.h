@@ -117,6 +117,9 @@ void init_net_delay_from_lookahead(const RouterLookahead& router_lookahead,
                                    const RRGraphView& rr_graph,
                                    bool is_flat);
 
+/** Initialize the net_delay of the nets routed before the first routing iteration (i.e. warm started) from their route trees. */
+void init_net_delay_from_route_trees(const Netlist<>& net_list, NetPinsMatrix<float>& net_delay);
+
 void init_router_stats(RouterStats& router_stats);
 
 bool is_better_quality_routing(const vtr::vector<ParentNetId, vtr::optional<RouteTree>>& best_routing,
@@ -181,6 +184,22 @@ bool should_route_net(ParentNetId net_id,
 
 bool should_setup_lower_bound_connection_delays(int itry, const t_router_opts& router_opts);
 
+/** Returns true if the timing analysis after routing iteration itry can be skipped: no connection delay
+ * changed (see NetPinTimingInvalidator::empty()), or every sink of the rerouted nets had a criticality
+ * below router_opts.skip_timing_update_criticality. The latter is not allowed if the routing is legal
+ * or if the previous iteration already skipped its timing analysis (last_update_skipped).
+ * A skipped analysis must not reset the invalidator, so the next one includes the delay changes. */
+bool should_skip_timing_update(int itry,
+                               const t_router_opts& router_opts,
+                               const Netlist<>& net_list,
+                               const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                               std::shared_ptr<SetupHoldTimingInfo> timing_info,
+                               const NetPinTimingInvalidator& pin_timing_invalidator,
+                               const std::vector<ParentNetId>& rerouted_nets,
+                               bool routing_is_feasible,
+                               bool last_update_skipped,
+                               bool is_flat);
+
 bool timing_driven_check_net_delays(const Netlist<>& net_list,
                                     NetPinsMatrix<float>& net_delay);
 
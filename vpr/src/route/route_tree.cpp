@@ -4,6 +4,7 @@
 #include "route_timing.h"
 #include "rr_graph_fwd.h"
 #include "vtr_math.h"
+#include "vtr_memory_usage.h"
 
 /* Construct a new RouteTreeNode.
  * Doesn't add the node to parent's child_nodes! (see add_child) */
@@ -71,7 +72,7 @@ void RouteTreeNode::print_x(int depth) const {
 
 /* Construct a top-level route tree. */
 RouteTree::RouteTree(RRNodeId _inode) {
-    _root = new RouteTreeNode(_inode, RRSwitchId::INVALID(), nullptr);
+    _root = _node_pool.create(_inode, RRSwitchId::INVALID(), nullptr);
     _net_id = ParentNetId::INVALID();
     _rr_node_to_rt_node[_inode] = _root;
 }
@@ -80,7 +81,7 @@ RouteTree::RouteTree(ParentNetId _inet) {
     auto& route_ctx = g_vpr_ctx.routing();
 
     RRNodeId inode = RRNodeId(route_ctx.net_rr_terminals[_inet][0]);
-    _root = new RouteTreeNode(inode, RRSwitchId::INVALID(), nullptr);
+    _root = _node_pool.create(inode, RRSwitchId::INVALID(), nullptr);
     _net_id = _inet;
     _rr_node_to_rt_node[inode] = _root;
 
@@ -92,7 +93,7 @@ RouteTree::RouteTree(ParentNetId _inet) {
 /** Make a copy of rhs and return it.
  * Traverse it as a tree so we can keep parent & child ptrs valid. */
 RouteTreeNode* RouteTree::copy_tree(const RouteTreeNode* rhs) {
-    RouteTreeNode* root = new RouteTreeNode(rhs->inode, RRSwitchId::INVALID(), nullptr);
+    RouteTreeNode* root = _node_pool.create(rhs->inode, RRSwitchId::INVALID(), nullptr);
     _rr_node_to_rt_node[root->inode] = root;
     copy_tree_x(root, *rhs);
     return root;
@@ -101,7 +102,7 @@ RouteTreeNode* RouteTree::copy_tree(const RouteTreeNode* rhs) {
 /* Helper for copy_list: copy child nodes of rhs into lhs */
 void RouteTree::copy_tree_x(RouteTreeNode* lhs, const RouteTreeNode& rhs) {
     for (auto& rchild : rhs.child_nodes()) {
-        RouteTreeNode* child = new RouteTreeNode(rchild);
+        RouteTreeNode* child = _node_pool.create(rchild);
         child->_is_leaf = true;
         add_node(lhs, child);
         copy_tree_x(child, rchild);
@@ -110,6 +111,7 @@ void RouteTree::copy_tree_x(RouteTreeNode* lhs, const RouteTreeNode& rhs) {
 
 /* Copy constructor */
 RouteTree::RouteTree(const RouteTree& rhs) {
+    _node_pool.reserve(rhs._rr_node_to_rt_node.size());
     _isink_to_rt_node.resize(rhs._isink_to_rt_node.size());
     _net_id = rhs._net_id;
     _root = copy_tree(rhs._root);
@@ -124,6 +126,7 @@ RouteTree::RouteTree(const RouteTree& rhs) {
  * from multiple threads, but better safe than sorry */
 RouteTree::RouteTree(RouteTree&& rhs) {
     std::unique_lock<std::mutex> rhs_write_lock(rhs._write_mutex);
+    _node_pool = std::move(rhs._node_pool);
     _root = rhs._root;
     _net_id = rhs._net_id;
     rhs._root = nullptr;
@@ -131,6 +134,7 @@ RouteTree::RouteTree(RouteTree&& rhs) {
     _isink_to_rt_node = std::move(rhs._isink_to_rt_node);
     _is_isink_reached = std::move(rhs._is_isink_reached);
     _num_sinks = rhs._num_sinks;
+    _spatial_lookup = std::move(rhs._spatial_lookup);
 }
 
 /* Copy assignment: free list, clear lookup, reload list. */
@@ -138,7 +142,9 @@ RouteTree& RouteTree::operator=(const RouteTree& rhs) {
     if (this == &rhs)
         return *this;
     std::unique_lock<std::mutex> write_lock(_write_mutex);
-    free_list(_root);
+    _spatial_lookup.clear();
+    _node_pool.clear();
+    _node_pool.reserve(rhs._rr_node_to_rt_node.size());
     _rr_node_to_rt_node.clear();
     _isink_to_rt_node.clear();
     _isink_to_rt_node.resize(rhs._isink_to_rt_node.size());
@@ -162,7 +168,7 @@ RouteTree& RouteTree::operator=(RouteTree&& rhs) {
     std::unique_lock<std::mutex> write_lock(_write_mutex, std::defer_lock);
     std::unique_lock<std::mutex> rhs_write_lock(rhs._write_mutex, std::defer_lock);
     std::lock(write_lock, rhs_write_lock);
-    free_list(_root);
+    _node_pool = std::move(rhs._node_pool);
     _root = rhs._root;
     _net_id = rhs._net_id;
     rhs._root = nullptr;
@@ -170,6 +176,7 @@ RouteTree& RouteTree::operator=(RouteTree&& rhs) {
     _isink_to_rt_node = std::move(rhs._isink_to_rt_node);
     _is_isink_reached = std::move(rhs._is_isink_reached);
     _num_sinks = rhs._num_sinks;
+    _spatial_lookup = std::move(rhs._spatial_lookup);
     return *this;
 }
 
@@ -209,7 +216,7 @@ void RouteTree::reload_timing_unlocked(vtr::optional<RouteTreeNode&> from_node)
         Tdel_start += rr_graph.rr_switch_inf(iswitch).Tdel;
     }
 
-    load_route_tree_Tdel(unbuffered_subtree_rt_root, Tdel_start);
+    update_unbuffered_subtree_Tdel(unbuffered_subtree_rt_root, *from_node, Tdel_start);
 }
 
 /** Sets the R_upstream values of all the nodes in the new path to the
@@ -345,6 +352,57 @@ void RouteTree::load_route_tree_Tdel(RouteTreeNode& from_node, float Tarrival) {
     }
 }
 
+/** Updates the Tdel values of the unbuffered subtree rooted at unbuffered_subtree_rt_root
+ * after the new subtree from_node was added to it (and the C_downstream values of the path
+ * between them were updated). Only the nodes on that path, the new subtree and the
+ * subtrees hanging off the path whose arrival time changed are reloaded: e.g. a branch added
+ * through a buffered switch without internal capacitance does not change the timing of the
+ * rest of the tree, which is then left untouched. Tarrival is the arrival time at the
+ * *input* of unbuffered_subtree_rt_root. */
+void RouteTree::update_unbuffered_subtree_Tdel(RouteTreeNode& unbuffered_subtree_rt_root, RouteTreeNode& from_node, float Tarrival) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    //Path from from_node up to (and including) the unbuffered subtree root
+    std::vector<RouteTreeNode*> path;
+    for (RouteTreeNode* rt_node = &from_node; rt_node != &unbuffered_subtree_rt_root; rt_node = rt_node->_parent) {
+        VTR_ASSERT_SAFE(rt_node->_parent);
+        path.push_back(rt_node);
+    }
+
+    //Walk down the path, reloading the side branches whose arrival time changed. The delays are
+    //computed exactly as load_route_tree_Tdel() does, so an unchanged Tdel means an unchanged subtree
+    RouteTreeNode* rt_node = &unbuffered_subtree_rt_root;
+    while (!path.empty()) {
+        RouteTreeNode* next_node = path.back();
+        path.pop_back();
+
+        rt_node->Tdel = Tarrival + 0.5 * rt_node->C_downstream * rr_graph.node_R(rt_node->inode);
+
+        for (RouteTreeNode& child : rt_node->_child_nodes()) {
+            RRSwitchId iswitch = child.parent_switch;
+
+            float Tchild = rt_node->Tdel + rr_graph.rr_switch_inf(iswitch).R * child.C_downstream;
+            Tchild += rr_graph.rr_switch_inf(iswitch).Tdel;
+
+            if (&child == next_node) {
+                Tarrival = Tchild;
+                continue;
+            }
+
+            //The descendants' delays only depend on the child's Tdel
+            float Tdel_child = Tchild + 0.5 * child.C_downstream * rr_graph.node_R(child.inode);
+            if (Tdel_child != child.Tdel) {
+                load_route_tree_Tdel(child, Tchild);
+            }
+        }
+        rt_node = next_node;
+    }
+
+    //The new subtree has no timing yet
+    load_route_tree_Tdel(from_node, Tarrival);
+}
+
 vtr::optional<const RouteTreeNode&> RouteTree::find_by_rr_id(RRNodeId rr_node) const {
     auto it = _rr_node_to_rt_node.find(rr_node);
     if (it != _rr_node_to_rt_node.end()) {
@@ -481,13 +539,14 @@ void RouteTree::print(void) const {
  * returns a tuple: RouteTreeNode of the branch it adds to the route tree and
  * RouteTreeNode of the SINK it adds to the routing. */
 std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
-RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat) {
+RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat, const t_rr_node_route_inf_storage* rr_node_route_inf) {
     /* Lock the route tree for writing. At least on Linux this shouldn't have an impact on single-threaded code */
     std::unique_lock<std::mutex> write_lock(_write_mutex);
 
     //Create a new subtree from the target in hptr to existing routing
     vtr::optional<RouteTreeNode&> start_of_new_subtree_rt_node, sink_rt_node;
-    std::tie(start_of_new_subtree_rt_node, sink_rt_node) = add_subtree_from_heap(hptr, target_net_pin_index, is_flat);
+    std::tie(start_of_new_subtree_rt_node, sink_rt_node) = add_subtree_from_heap(hptr, target_net_pin_index, is_flat,
+                                                                                 rr_node_route_inf ? *rr_node_route_inf : g_vpr_ctx.routing().rr_node_route_inf);
 
     if (!start_of_new_subtree_rt_node)
         return {vtr::nullopt, *sink_rt_node};
@@ -498,6 +557,9 @@ RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRoute
     if (spatial_rt_lookup) {
         update_route_tree_spatial_lookup_recur(*start_of_new_subtree_rt_node, *spatial_rt_lookup);
     }
+    if (!_spatial_lookup.empty() && spatial_rt_lookup != &_spatial_lookup) {
+        update_route_tree_spatial_lookup_recur(*start_of_new_subtree_rt_node, _spatial_lookup);
+    }
 
     if (_net_id.is_valid()) /* We don't have this lookup if the tree isn't associated with a net */
         _is_isink_reached[target_net_pin_index] = true;
@@ -510,10 +572,9 @@ RouteTree::update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRoute
  * to the SINK indicated by hptr. Returns the first (most upstream) new rt_node,
  * and the rt_node of the new SINK. Traverses up from SINK  */
 std::tuple<vtr::optional<RouteTreeNode&>, vtr::optional<RouteTreeNode&>>
-RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat) {
+RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat, const t_rr_node_route_inf_storage& rr_node_route_inf) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    auto& route_ctx = g_vpr_ctx.routing();
 
     RRNodeId sink_inode = RRNodeId(hptr->index);
 
@@ -538,8 +599,8 @@ RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is
     while (!_rr_node_to_rt_node.count(new_inode)) {
         new_branch_inodes.push_back(new_inode);
         new_branch_iswitches.push_back(new_iswitch);
-        edge = route_ctx.rr_node_route_inf[new_inode].prev_edge;
-        new_inode = RRNodeId(route_ctx.rr_node_route_inf[new_inode].prev_node);
+        edge = rr_node_route_inf[new_inode].prev_edge;
+        new_inode = RRNodeId(rr_node_route_inf[new_inode].prev_node);
         new_iswitch = RRSwitchId(rr_graph.rr_nodes().edge_switch(edge));
     }
     new_branch_iswitches.push_back(new_iswitch);
@@ -554,7 +615,7 @@ RouteTree::add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is
      * ---
      * Walk through new_branch_iswitches and corresponding new_branch_inodes. */
     for (int i = new_branch_inodes.size() - 1; i >= 0; i--) {
-        RouteTreeNode* new_node = new RouteTreeNode(new_branch_inodes[i], new_branch_iswitches[i], last_node);
+        RouteTreeNode* new_node = _node_pool.create(new_branch_inodes[i], new_branch_iswitches[i], last_node);
 
         e_rr_type node_type = rr_graph.node_type(new_branch_inodes[i]);
         // If is_flat is enabled, IPINs should be added, since they are used for intra-cluster routing
@@ -617,7 +678,7 @@ void RouteTree::add_non_configurable_nodes(RouteTreeNode* rt_node,
 
         RRSwitchId edge_switch(rr_graph.edge_switch(rr_node, iedge));
 
-        RouteTreeNode* new_node = new RouteTreeNode(to_rr_node, edge_switch, rt_node);
+        RouteTreeNode* new_node = _node_pool.create(to_rr_node, edge_switch, rt_node);
         add_node(rt_node, new_node);
 
         new_node->net_pin_index = OPEN;
@@ -638,7 +699,7 @@ void RouteTree::add_non_configurable_nodes(RouteTreeNode* rt_node,
  *
  * Note: does not update R_upstream/C_downstream */
 vtr::optional<RouteTree&>
-RouteTree::prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_usage) {
+RouteTree::prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_usage, std::vector<RRNodeId>* pruned_nodes) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.routing();
@@ -652,7 +713,7 @@ RouteTree::prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_us
     VTR_ASSERT_MSG(route_ctx.rr_node_route_inf[root().inode].occ() <= rr_graph.node_capacity(root().inode),
                    "Route tree root/SOURCE should never be congested");
 
-    auto pruned_node = prune_x(*_root, connections_inf, false, non_config_node_set_usage);
+    auto pruned_node = prune_x(*_root, connections_inf, false, non_config_node_set_usage, pruned_nodes);
     if (pruned_node)
         return *this;
     else
@@ -663,17 +724,13 @@ RouteTree::prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_us
  * Recursively traverse the route tree rooted at node and remove any congested subtrees.
  * Returns nullopt if pruned */
 vtr::optional<RouteTreeNode&>
-RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_prune, std::vector<int>* non_config_node_set_usage) {
+RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_prune, std::vector<int>* non_config_node_set_usage, std::vector<RRNodeId>* pruned_nodes) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
     auto& route_ctx = g_vpr_ctx.routing();
     bool congested = (route_ctx.rr_node_route_inf[rt_node.inode].occ() > rr_graph.node_capacity(rt_node.inode));
 
-    int node_set = -1;
-    auto itr = device_ctx.rr_node_to_non_config_node_set.find(rt_node.inode);
-    if (itr != device_ctx.rr_node_to_non_config_node_set.end()) {
-        node_set = itr->second;
-    }
+    int node_set = device_ctx.rr_non_config_node_sets.node_set(rt_node.inode);
 
     if (congested) {
         //This connection is congested -- prune it
@@ -688,7 +745,7 @@ RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_pru
     // Recursively prune child nodes
     bool all_children_pruned = true;
     remove_child_if(rt_node, [&](auto& child) {
-        vtr::optional<RouteTreeNode&> child_maybe = prune_x(child, connections_inf, force_prune, non_config_node_set_usage);
+        vtr::optional<RouteTreeNode&> child_maybe = prune_x(child, connections_inf, force_prune, non_config_node_set_usage, pruned_nodes);
 
         if (child_maybe.has_value()) { // Not pruned
             all_children_pruned = false;
@@ -714,6 +771,8 @@ RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_pru
         } else {
             //Record as not reached
             _is_isink_reached[rt_node.net_pin_index] = false;
+            if (pruned_nodes)
+                pruned_nodes->push_back(rt_node.inode);
             return vtr::nullopt; // Pruned
         }
     } else if (all_children_pruned) {
@@ -759,6 +818,8 @@ RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_pru
         if (reached_non_configurably && !force_prune) {
             return rt_node; //Not pruned
         } else {
+            if (pruned_nodes)
+                pruned_nodes->push_back(rt_node.inode);
             return vtr::nullopt; //Pruned
         }
 
@@ -806,7 +867,7 @@ RouteTree::prune_x(RouteTreeNode& rt_node, CBRR& connections_inf, bool force_pru
             //  node set usage count will be > 0. However after
             //  prune_route_tree_recurr visits 2, 3 and 4, the node set usage
             //  will be 0, so everything can be pruned.
-            return prune_x(rt_node, connections_inf, /*force_prune=*/false, non_config_node_set_usage);
+            return prune_x(rt_node, connections_inf, /*force_prune=*/false, non_config_node_set_usage, pruned_nodes);
         }
 
         //An unpruned intermediate node
@@ -859,26 +920,49 @@ std::vector<int> RouteTree::get_non_config_node_set_usage(void) const {
     auto& device_ctx = g_vpr_ctx.device();
     std::vector<int> usage(device_ctx.rr_non_config_node_sets.size(), 0);
 
-    const auto& rr_to_nonconf = device_ctx.rr_node_to_non_config_node_set;
+    const auto& non_config_node_sets = device_ctx.rr_non_config_node_sets;
 
     for (auto& rt_node : all_nodes()) {
-        auto it = rr_to_nonconf.find(rt_node.inode);
-        if (it == rr_to_nonconf.end())
+        int node_set = non_config_node_sets.node_set(rt_node.inode);
+        if (node_set == OPEN)
             continue;
 
         if (device_ctx.rr_graph.node_type(rt_node.inode) == SINK) {
             if (device_ctx.rr_graph.rr_switch_inf(rt_node.parent_switch).configurable()) {
-                usage[it->second] += 1;
+                usage[node_set] += 1;
             }
             continue;
         }
 
         for (auto& child : rt_node.child_nodes()) {
             if (device_ctx.rr_graph.rr_switch_inf(child.parent_switch).configurable()) {
-                usage[it->second] += 1;
+                usage[node_set] += 1;
             }
         }
     }
 
     return usage;
 }
+
+SpatialRouteTreeLookup& RouteTree::spatial_lookup(const Netlist<>& net_list, const vtr::vector<ParentNetId, t_bb>& net_bound_box) {
+    std::unique_lock<std::mutex> write_lock(_write_mutex);
+
+    VTR_ASSERT_MSG(_net_id, "RouteTree must be constructed using a ParentNetId");
+
+    std::array<size_t, 2> bins = route_tree_spatial_lookup_bins(net_list, net_bound_box, _net_id);
+    if (_spatial_lookup.empty() || _spatial_lookup.dim_size(0) != bins[0] || _spatial_lookup.dim_size(1) != bins[1]) {
+        _spatial_lookup = build_route_tree_spatial_lookup(net_list, net_bound_box, _net_id, *_root);
+    }
+
+    return _spatial_lookup;
+}
+
+size_t RouteTree::memory_usage(void) const {
+    size_t spatial_lookup_bytes = _spatial_lookup.size() * sizeof(_spatial_lookup.get(0));
+    for (size_t i = 0; i < _spatial_lookup.size(); i++) {
+        spatial_lookup_bytes += _spatial_lookup.get(i).capacity() * sizeof(std::reference_wrapper<const RouteTreeNode>);
+    }
+
+    return _node_pool.memory_usage() + vtr::memory_usage(_rr_node_to_rt_node, _isink_to_rt_node, _is_isink_reached)
+           + spatial_lookup_bytes;
+}
@@ -32,20 +32,20 @@
  *
  * Congested paths in a tree can be pruned using RouteTree::prune(). This is done between iterations to keep only the legally routed section.
  * Note that updates to a tree require an update to the global occupancy state via pathfinder_update_cost_from_route_tree().
- * RouteTree::prune() depends on this global data to find congestions, so the flow to prune a tree is somewhat convoluted:
+ * RouteTree::prune() depends on this global data to find congestions, so the occupancy of the pruned nodes
+ * can only be subtracted once pruning is done. prune() can report the pruned nodes for that:
  *
- *      RouteTree tree2 = tree;
- *      // Prune the copy (using congestion data before subtraction)
- *      vtr::optional<RouteTree&> pruned_tree2 = tree2.prune(connections_inf);
+ *      std::vector<RRNodeId> pruned_nodes;
+ *      // Prune in place (using congestion data before subtraction)
+ *      vtr::optional<RouteTree&> pruned_tree = tree.prune(connections_inf, nullptr, &pruned_nodes);
  *
- *      // Subtract congestion using the non-pruned original
- *      pathfinder_update_cost_from_route_tree(tree.root(), -1);
+ *      // Subtract congestion of the pruned branches only
+ *      for (RRNodeId inode : pruned_nodes)
+ *          pathfinder_update_single_node_occupancy(inode, -1);
  *
- *      if (pruned_tree2) {  // Partially pruned
- *          // Add back congestion for the pruned route tree
- *          pathfinder_update_cost_from_route_tree(pruned_tree2.value().root(), 1);
+ *      if (pruned_tree) {  // Partially pruned
  *          ...
- *      } else {  // Fully destroyed
+ *      } else {  // Fully destroyed (pruned_nodes includes the root)
  *          ...
  *
  * Most usage of RouteTree outside of the router requires iterating through existing routing. Both RouteTree and RouteTreeNode exposes functions to
@@ -80,11 +80,16 @@
  * When the occupancy and timing data is up to date, a tree can be sanity checked using RouteTree::is_valid().
  */
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "connection_based_routing_fwd.h"
 #include "route_tree_fwd.h"
@@ -94,6 +99,8 @@
 #include "vtr_range.h"
 #include "vtr_vec_id_set.h"
 
+class t_rr_node_route_inf_storage;
+
 /**
  * @brief A single route tree node
  *
@@ -319,6 +326,109 @@ class RouteTreeNode {
     };
 };
 
+/**
+ * @brief Pool of RouteTreeNodes owned by a single RouteTree.
+ *
+ * Nodes are carved out of chunks which grow geometrically (up to MAX_CHUNK_NODES nodes),
+ * and freed nodes are kept on a free list for reuse by the next allocation. The chunks are
+ * only returned to the heap in bulk, when the pool is cleared or destroyed, so ripping up
+ * a whole net costs a handful of deallocations instead of one per node.
+ *
+ * A RouteTree is only modified by one thread at a time (see RouteTree::_write_mutex), so
+ * the pool needs no synchronization: unlike the global heap, it is not contended by the
+ * threads of the parallel router.
+ */
+class RouteTreeNodePool {
+  public:
+    RouteTreeNodePool() = default;
+    RouteTreeNodePool(const RouteTreeNodePool&) = delete;
+    RouteTreeNodePool& operator=(const RouteTreeNodePool&) = delete;
+    RouteTreeNodePool(RouteTreeNodePool&& rhs) noexcept {
+        *this = std::move(rhs);
+    }
+    RouteTreeNodePool& operator=(RouteTreeNodePool&& rhs) noexcept {
+        _chunks = std::move(rhs._chunks);
+        rhs._chunks.clear();
+        _next = std::exchange(rhs._next, nullptr);
+        _end = std::exchange(rhs._end, nullptr);
+        _free = std::exchange(rhs._free, nullptr);
+        _next_chunk_nodes = std::exchange(rhs._next_chunk_nodes, MIN_CHUNK_NODES);
+        _num_slots = std::exchange(rhs._num_slots, 0);
+        return *this;
+    }
+
+    /** Construct a node in the pool */
+    template<class... Args>
+    inline RouteTreeNode* create(Args&&... args) {
+        t_slot* slot = _free;
+        if (slot) {
+            _free = slot->next_free;
+        } else {
+            if (_next == _end)
+                add_chunk();
+            slot = _next++;
+        }
+        return new (slot->storage) RouteTreeNode(std::forward<Args>(args)...);
+    }
+
+    /** Return a node (created by this pool) to the pool */
+    inline void destroy(RouteTreeNode* node) {
+        node->~RouteTreeNode();
+        t_slot* slot = reinterpret_cast<t_slot*>(node);
+        slot->next_free = _free;
+        _free = slot;
+    }
+
+    /** Make sure the next num_nodes nodes created (from an empty pool) are contiguous */
+    inline void reserve(size_t num_nodes) {
+        if (_chunks.empty())
+            _next_chunk_nodes = std::max(_next_chunk_nodes, num_nodes);
+    }
+
+    /** Free all the nodes at once. The nodes are not destroyed one by one,
+     * which is fine since their destructor is trivial */
+    inline void clear() {
+        _chunks.clear();
+        _next = _end = _free = nullptr;
+        _next_chunk_nodes = MIN_CHUNK_NODES;
+        _num_slots = 0;
+    }
+
+    /** Heap memory used by the pool (including the free slots), in bytes */
+    inline size_t memory_usage() const {
+        return _num_slots * sizeof(t_slot) + _chunks.capacity() * sizeof(_chunks[0]);
+    }
+
+  private:
+    static_assert(std::is_trivially_destructible<RouteTreeNode>::value, "clear() frees the nodes without destroying them");
+
+    static constexpr size_t MIN_CHUNK_NODES = 4;
+    static constexpr size_t MAX_CHUNK_NODES = 1024;
+
+    union t_slot {
+        t_slot* next_free;
+        alignas(RouteTreeNode) unsigned char storage[sizeof(RouteTreeNode)];
+    };
+
+    inline void add_chunk() {
+        _chunks.emplace_back(new t_slot[_next_chunk_nodes]);
+        _next = _chunks.back().get();
+        _end = _next + _next_chunk_nodes;
+        _num_slots += _next_chunk_nodes;
+        _next_chunk_nodes = std::min(2 * _next_chunk_nodes, MAX_CHUNK_NODES);
+    }
+
+    std::vector<std::unique_ptr<t_slot[]>> _chunks;
+    /** Next never used slot of the last chunk, and the end of that chunk */
+    t_slot* _next = nullptr;
+    t_slot* _end = nullptr;
+    /** Singly linked list of the destroyed nodes' slots */
+    t_slot* _free = nullptr;
+    size_t _next_chunk_nodes = MIN_CHUNK_NODES;
+    /** Total number of slots of the chunks */
+    size_t _num_slots = 0;
+};
+
 /** fwd definition for compatibility class in old_traceback.h */
 class TracebackCompat;
 
@@ -345,7 +455,7 @@ class RouteTree {
 
     ~RouteTree() {
         std::unique_lock<std::mutex> write_lock(_write_mutex);
-        free_list(_root);
+        _node_pool.clear();
     }
 
     /** Add the most recently finished wire segment to the routing tree, and
@@ -354,9 +464,11 @@ class RouteTree {
      * is the net pin index corresponding to the SINK that was reached. This routine
      * returns a tuple: RouteTreeNode of the branch it adds to the route tree and
      * RouteTreeNode of the SINK it adds to the routing.
+     * The path is traced back through rr_node_route_inf, which defaults to the
+     * global RoutingContext::rr_node_route_inf when not given.
      * Locking operation: only one thread can update_from_heap() a RouteTree at a time. */
     std::tuple<vtr::optional<const RouteTreeNode&>, vtr::optional<const RouteTreeNode&>>
-    update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat);
+    update_from_heap(t_heap* hptr, int target_net_pin_index, SpatialRouteTreeLookup* spatial_rt_lookup, bool is_flat, const t_rr_node_route_inf_storage* rr_node_route_inf = nullptr);
 
     /** Reload timing values (R_upstream, C_downstream, Tdel).
      * Can take a RouteTreeNode& to do an incremental update.
@@ -381,6 +493,17 @@ class RouteTree {
         return _num_sinks;
     }
 
+    /** Get the spatial lookup of this tree's nodes (see spatial_route_tree_lookup.h) for routing its net
+     * within net_bound_box. The lookup is built on first use, then kept up to date as nodes are added
+     * by update_from_heap() and removed by prune() and freeze(), so it is only re-built when a change
+     * in the net's bounding box changes its bins.
+     * Requires a tree constructed using a ParentNetId.
+     * Locking operation: only one thread can get the spatial_lookup() of a RouteTree at a time. */
+    SpatialRouteTreeLookup& spatial_lookup(const Netlist<>& net_list, const vtr::vector<ParentNetId, t_bb>& net_bound_box);
+
+    /** Get the (estimated) heap memory used by this tree, in bytes */
+    size_t memory_usage(void) const;
+
     /** Check the consistency of this route tree. Looks for:
      * - invalid parent-child links
      * - invalid timing values
@@ -397,9 +520,12 @@ class RouteTree {
 
     /** Prune overused nodes from the tree.
      * Also prune unused non-configurable nodes if non_config_node_set_usage is provided (see get_non_config_node_set_usage)
+     * If pruned_nodes is provided, the RR nodes of all pruned RouteTreeNodes are appended to it.
      * Returns nullopt if the entire tree is pruned.
      * Locking operation: only one thread can prune() a RouteTree at a time. */
-    vtr::optional<RouteTree&> prune(CBRR& connections_inf, std::vector<int>* non_config_node_set_usage = nullptr);
+    vtr::optional<RouteTree&> prune(CBRR& connections_inf,
+                                    std::vector<int>* non_config_node_set_usage = nullptr,
+                                    std::vector<RRNodeId>* pruned_nodes = nullptr);
 
     /** Remove all sinks and mark the remaining nodes as un-expandable.
      * This is used after routing a clock net.
@@ -488,7 +614,7 @@ class RouteTree {
 
   private:
     std::tuple<vtr::optional<RouteTreeNode&>, vtr::optional<RouteTreeNode&>>
-    add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat);
+    add_subtree_from_heap(t_heap* hptr, int target_net_pin_index, bool is_flat, const t_rr_node_route_inf_storage& rr_node_route_inf);
 
     void add_non_configurable_nodes(RouteTreeNode* rt_node,
                                     bool reached_by_non_configurable_edge,
@@ -500,6 +626,7 @@ class RouteTree {
     float load_new_subtree_C_downstream(RouteTreeNode& from_node);
     RouteTreeNode& update_unbuffered_ancestors_C_downstream(RouteTreeNode& from_node);
     void load_route_tree_Tdel(RouteTreeNode& from_node, float Tarrival);
+    void update_unbuffered_subtree_Tdel(RouteTreeNode& unbuffered_subtree_rt_root, RouteTreeNode& from_node, float Tarrival);
 
     bool is_valid_x(const RouteTreeNode& rt_node) const;
     bool is_uncongested_x(const RouteTreeNode& rt_node) const;
@@ -508,7 +635,8 @@ class RouteTree {
     prune_x(RouteTreeNode& rt_node,
             CBRR& connections_inf,
             bool force_prune,
-            std::vector<int>* non_config_node_set_usage);
+            std::vector<int>* non_config_node_set_usage,
+            std::vector<RRNodeId>* pruned_nodes);
 
     void freeze_x(RouteTreeNode& rt_node);
 
@@ -540,16 +668,6 @@ class RouteTree {
         parent->_is_leaf = false;
     }
 
-    /** Free all nodes after node */
-    inline void free_list(RouteTreeNode* node) {
-        RouteTreeNode* p = node;
-        while (p) {
-            RouteTreeNode* x = p;
-            p = p->_next;
-            free_node(x);
-        }
-    }
-
     /** Make a copy of rhs and return it. Updates _rr_node_to_rt_node */
     RouteTreeNode* copy_tree(const RouteTreeNode* rhs);
 
@@ -558,11 +676,13 @@ class RouteTree {
 
     /** Free a node. Only keeps the linked list valid (not the tree ptrs) */
     inline void free_node(RouteTreeNode* node) {
+        if (!_spatial_lookup.empty())
+            remove_route_tree_spatial_lookup_node(*node, _spatial_lookup);
         if (node->_prev)
             node->_prev->_next = node->_next;
         if (node->_next)
             node->_next->_prev = node->_prev;
-        delete node;
+        _node_pool.destroy(node);
     }
 
     /** Iterate through parent's child nodes and remove if p returns true.
@@ -600,6 +720,9 @@ class RouteTree {
             parent._is_leaf = true;
     }
 
+    /** Storage of the nodes of this tree */
+    RouteTreeNodePool _node_pool;
+
     /** Root node.
      * This is also the internal node list via the ptrs in RouteTreeNode. */
     RouteTreeNode* _root;
@@ -634,6 +757,10 @@ class RouteTree {
     /** Number of sinks in this tree's net. Useful for iteration. */
     size_t _num_sinks;
 
+    /** Spatial lookup of the nodes in this tree, empty until requested by spatial_lookup().
+     * Refers to the nodes in _node_pool, so it is moved along with it but not copied. */
+    SpatialRouteTreeLookup _spatial_lookup;
+
     /** Write mutex on this RouteTree. Acquired by the write operations automatically:
      * the caller does not need to know about a lock. */
     std::mutex _write_mutex;
@@ -13,6 +13,21 @@ vtr::Matrix<float> calculate_routing_usage(t_rr_type rr_type, bool is_flat, bool
 
     vtr::Matrix<float> usage({{device_ctx.grid.width(), device_ctx.grid.height()}}, 0.);
 
+    //The channel occupancy is kept up to date as nets are ripped up and re-routed,
+    //so it can be copied instead of walking the route trees. Drawing still walks
+    //them, since it only counts the wires on the visible layers.
+    const auto& chan_occupancy = route_ctx.chan_occupancy;
+    if (is_print && !chan_occupancy.empty()
+        && chan_occupancy.width() == device_ctx.grid.width()
+        && chan_occupancy.height() == device_ctx.grid.height()) {
+        for (size_t x = 0; x < device_ctx.grid.width(); ++x) {
+            for (size_t y = 0; y < device_ctx.grid.height(); ++y) {
+                usage[x][y] = chan_occupancy.occ(rr_type, x, y);
+            }
+        }
+        return usage;
+    }
+
     //Collect all the in-use RR nodes
     std::set<RRNodeId> rr_nodes;
     for (auto net : cluster_ctx.clb_nlist.nets()) {
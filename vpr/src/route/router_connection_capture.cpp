@@ -0,0 +1,311 @@
+#include "router_connection_capture.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+
+#include "vtr_assert.h"
+#include "vtr_util.h"
+
+#include "globals.h"
+#include "vpr_error.h"
+#include "vpr_types.h"
+#include "connection_router_interface.h"
+#include "heap_type.h"
+
+namespace router_capture {
+
+namespace {
+
+struct t_stream {
+    std::FILE* file = nullptr;
+
+    std::string filename;
+    uint32_t num_rr_nodes = 0;
+
+    size_t num_connections = 0; // Connections captured to filename so far
+    size_t max_connections = 0;
+
+    uint32_t iteration = 0;
+    bool congestion_pending = false; // Congestion of the current iteration not captured yet
+};
+
+t_stream f_stream;
+bool f_session = false;
+
+template<typename T>
+void write_value(const T& value) {
+    size_t written = std::fwrite(&value, sizeof(T), 1, f_stream.file);
+    VTR_ASSERT(written == 1);
+}
+
+template<typename T>
+void write_values(const std::vector<T>& values) {
+    size_t written = std::fwrite(values.data(), sizeof(T), values.size(), f_stream.file);
+    VTR_ASSERT(written == values.size());
+}
+
+void write_congestion() {
+    const auto& route_ctx = g_vpr_ctx.routing();
+    const auto& cong_lane = route_ctx.rr_node_route_inf.cong_lane();
+
+    std::vector<t_congestion_entry> entries;
+    for (size_t inode = 0; inode < cong_lane.size(); inode++) {
+        const t_rr_node_route_cong_inf& cong = cong_lane[RRNodeId(inode)];
+        if (cong.acc_cost != 1. || cong.occ != 0) {
+            entries.push_back({uint32_t(inode), cong.acc_cost, int32_t(cong.occ)});
+        }
+    }
+
+    write_value(CONGESTION);
+    write_value(f_stream.iteration);
+    write_value(uint32_t(entries.size()));
+    write_values(entries);
+
+    f_stream.congestion_pending = false;
+}
+
+// The RR edge through which rt_node is reached from its parent
+uint32_t parent_edge(const RouteTreeNode& parent, const RouteTreeNode& rt_node) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    const auto& rr_nodes = rr_graph.rr_nodes();
+
+    for (RREdgeId edge : rr_graph.edge_range(parent.inode)) {
+        if (rr_nodes.edge_sink_node(edge) == rt_node.inode
+            && RRSwitchId(rr_nodes.edge_switch(edge)) == rt_node.parent_switch) {
+            return size_t(edge);
+        }
+    }
+    VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "No RR edge from the route tree node %zu to its child %zu\n",
+                    size_t(parent.inode), size_t(rt_node.inode));
+}
+
+template<typename T>
+bool read_value(const std::vector<char>& buf, size_t& offset, T& value) {
+    if (buf.size() - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, buf.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+template<typename T>
+bool read_values(const std::vector<char>& buf, size_t& offset, size_t num_values, std::vector<T>& values) {
+    if ((buf.size() - offset) / sizeof(T) < num_values) {
+        return false;
+    }
+    values.resize(num_values);
+    std::memcpy(values.data(), buf.data() + offset, num_values * sizeof(T));
+    offset += num_values * sizeof(T);
+    return true;
+}
+
+} // namespace
+
+Session::Session(const std::string& filename, int max_connections) {
+    VTR_ASSERT(!f_session);
+    if (filename.empty() || max_connections <= 0) return;
+
+    uint32_t num_rr_nodes = g_vpr_ctx.device().rr_graph.num_nodes();
+    if (filename == f_stream.filename && num_rr_nodes == f_stream.num_rr_nodes) {
+        f_stream.file = vtr::fopen(filename.c_str(), "ab");
+    } else {
+        f_stream.file = vtr::fopen(filename.c_str(), "wb");
+        f_stream.filename = filename;
+        f_stream.num_rr_nodes = num_rr_nodes;
+        f_stream.num_connections = 0;
+
+        t_file_header header;
+        header.num_rr_nodes = num_rr_nodes;
+        write_value(header);
+    }
+
+    f_stream.max_connections = max_connections;
+    f_stream.iteration = 0;
+    f_stream.congestion_pending = true;
+    f_session = true;
+}
+
+Session::~Session() {
+    if (!f_session) return;
+
+    vtr::fclose(f_stream.file);
+    f_stream.file = nullptr;
+    f_session = false;
+}
+
+bool enabled() {
+    return f_session && f_stream.num_connections < f_stream.max_connections;
+}
+
+void set_iteration(int itry) {
+    f_stream.iteration = itry;
+    f_stream.congestion_pending = true;
+}
+
+void capture_connection(const RouteTree& tree,
+                        RRNodeId sink_node,
+                        const t_conn_cost_params& cost_params,
+                        const t_bb& bounding_box) {
+    VTR_ASSERT_SAFE(enabled());
+
+    if (f_stream.congestion_pending) {
+        write_congestion();
+    }
+
+    //The tree nodes are visited in pre-order, so parents are indexed before their children
+    std::vector<t_tree_node> tree_nodes;
+    std::unordered_map<RRNodeId, int32_t> node_index;
+    for (const RouteTreeNode& rt_node : tree.all_nodes()) {
+        t_tree_node node;
+        node.rr_node = size_t(rt_node.inode);
+        node.parent = NO_PARENT;
+        node.rr_edge = 0;
+        if (rt_node.parent()) {
+            const RouteTreeNode& parent = rt_node.parent().value();
+            node.parent = node_index.at(parent.inode);
+            node.rr_edge = parent_edge(parent, rt_node);
+        }
+        node_index[rt_node.inode] = tree_nodes.size();
+        tree_nodes.push_back(node);
+    }
+
+    t_connection_query query;
+    query.sink_node = size_t(sink_node);
+    query.criticality = cost_params.criticality;
+    query.astar_fac = cost_params.astar_fac;
+    query.bend_cost = cost_params.bend_cost;
+    query.pres_fac = cost_params.pres_fac;
+    query.xmin = bounding_box.xmin;
+    query.xmax = bounding_box.xmax;
+    query.ymin = bounding_box.ymin;
+    query.ymax = bounding_box.ymax;
+    query.num_tree_nodes = tree_nodes.size();
+
+    write_value(CONNECTION);
+    write_value(query);
+    write_values(tree_nodes);
+
+    ++f_stream.num_connections;
+}
+
+t_capture read_capture(const std::string& filename) {
+    std::vector<char> buf;
+    {
+        std::ifstream fstream(filename, std::ios::binary | std::ios::ate);
+        if (!fstream) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - Cannot open connection capture.\n", filename.c_str());
+        }
+        buf.resize(size_t(fstream.tellg()));
+        fstream.seekg(0);
+        if (!fstream.read(buf.data(), buf.size())) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - Cannot read connection capture.\n", filename.c_str());
+        }
+    }
+
+    size_t offset = 0;
+    t_file_header header;
+    t_file_header expected_header;
+    if (!read_value(buf, offset, header)
+        || !std::equal(std::begin(header.magic), std::end(header.magic), std::begin(expected_header.magic))
+        || header.version != FILE_VERSION) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - Not a connection capture of this version of VPR.\n", filename.c_str());
+    }
+
+    t_capture capture;
+    capture.num_rr_nodes = header.num_rr_nodes;
+
+    auto corrupted = [&]() {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "'%s' - Truncated or corrupted connection capture (at byte %zu).\n",
+                        filename.c_str(), offset);
+    };
+
+    while (offset < buf.size()) {
+        uint32_t block_type;
+        if (!read_value(buf, offset, block_type)) corrupted();
+
+        if (block_type == CONGESTION) {
+            uint32_t iteration, num_entries;
+            if (!read_value(buf, offset, iteration) || !read_value(buf, offset, num_entries)) corrupted();
+
+            capture.congestion.emplace_back();
+            if (!read_values(buf, offset, num_entries, capture.congestion.back())) corrupted();
+            for (const t_congestion_entry& entry : capture.congestion.back()) {
+                if (entry.rr_node >= capture.num_rr_nodes) corrupted();
+            }
+        } else if (block_type == CONNECTION) {
+            //Connections are always preceded by the congestion of their iteration
+            if (capture.congestion.empty()) corrupted();
+
+            t_captured_connection connection;
+            connection.congestion = capture.congestion.size() - 1;
+            if (!read_value(buf, offset, connection.query)
+                || connection.query.sink_node >= capture.num_rr_nodes
+                || connection.query.num_tree_nodes == 0
+                || !read_values(buf, offset, connection.query.num_tree_nodes, connection.tree)) {
+                corrupted();
+            }
+            for (size_t inode = 0; inode < connection.tree.size(); inode++) {
+                const t_tree_node& node = connection.tree[inode];
+                bool valid_parent = (inode == 0) ? (node.parent == NO_PARENT) : (node.parent >= 0 && size_t(node.parent) < inode);
+                if (node.rr_node >= capture.num_rr_nodes || !valid_parent) corrupted();
+            }
+            capture.connections.push_back(std::move(connection));
+        } else {
+            corrupted();
+        }
+    }
+
+    return capture;
+}
+
+void load_congestion(const std::vector<t_congestion_entry>& congestion, t_rr_node_route_inf_storage& rr_node_route_inf) {
+    auto& cong_lane = rr_node_route_inf.cong_lane();
+    for (t_rr_node_route_cong_inf& cong : cong_lane) {
+        cong.acc_cost = 1.;
+        cong.target_flag = 0;
+        cong.occ = 0;
+    }
+    for (const t_congestion_entry& entry : congestion) {
+        t_rr_node_route_cong_inf& cong = cong_lane[RRNodeId(entry.rr_node)];
+        cong.acc_cost = entry.acc_cost;
+        cong.occ = entry.occ;
+    }
+}
+
+RouteTree build_route_tree(const std::vector<t_tree_node>& tree_nodes, t_rr_node_route_inf_storage& scratch, bool is_flat) {
+    VTR_ASSERT(!tree_nodes.empty() && tree_nodes[0].parent == NO_PARENT);
+
+    RouteTree tree(RRNodeId(tree_nodes[0].rr_node));
+
+    //Point the traceback of each node at its parent
+    std::vector<bool> is_leaf(tree_nodes.size(), true);
+    for (size_t inode = 1; inode < tree_nodes.size(); inode++) {
+        const t_tree_node& node = tree_nodes[inode];
+        auto node_inf = scratch[RRNodeId(node.rr_node)];
+        node_inf.prev_node = RRNodeId(tree_nodes[node.parent].rr_node);
+        node_inf.prev_edge = RREdgeId(node.rr_edge);
+        is_leaf[node.parent] = false;
+    }
+
+    //Add the branch to each leaf, as the router would have. Nodes may already be
+    //in the tree, if they were added as non-configurably connected nodes
+    for (size_t inode = 1; inode < tree_nodes.size(); inode++) {
+        RRNodeId leaf(tree_nodes[inode].rr_node);
+        if (!is_leaf[inode] || tree.find_by_rr_id(leaf)) continue;
+
+        t_heap hptr;
+        hptr.index = leaf;
+        hptr.set_prev_node(scratch[leaf].prev_node);
+        hptr.set_prev_edge(scratch[leaf].prev_edge);
+        tree.update_from_heap(&hptr, OPEN, nullptr, is_flat, &scratch);
+    }
+
+    return tree;
+}
+
+} // namespace router_capture
@@ -0,0 +1,137 @@
+#pragma once
+/* Optional capture of the connection routing queries of a routing run (--write_router_connection_capture).
+ *
+ * Each captured connection records everything the connection router needs to repeat its
+ * search: the route tree it starts from, the sink, the cost parameters and the bounding box.
+ * The congestion state (the accumulated cost and occupancy of every RR node whose congestion
+ * is not the default) is captured once per router iteration, right before its first captured
+ * connection, so replayed searches see the congestion of the start of each iteration rather
+ * than the exact one each connection was routed with.
+ *
+ * route_diag --replay_connections replays a capture against ConnectionRouter, so changes to
+ * the router kernel (heaps, lookaheads, ...) can be benchmarked on real queries without the
+ * noise of full routing runs. Only the serial router captures connections, and high fanout
+ * connections (which only search from the part of the route tree close to their sink) are
+ * not captured.
+ *
+ * The file starts with a t_file_header, followed by blocks in host byte order. Each block
+ * starts with its e_block_type:
+ *  - CONGESTION: the router iteration (uint32_t), the number of entries (uint32_t) and
+ *                that many t_congestion_entry.
+ *  - CONNECTION: a t_connection_query, followed by its t_connection_query::num_tree_nodes
+ *                t_tree_node in pre-order (the root first, parents before children). */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rr_graph_fwd.h"
+#include "route_tree.h"
+
+class t_rr_node_route_inf_storage;
+struct t_bb;
+struct t_conn_cost_params;
+
+namespace router_capture {
+
+constexpr uint32_t FILE_VERSION = 1;
+
+struct t_file_header {
+    char magic[8] = {'V', 'P', 'R', 'C', 'A', 'P', 'T', '\0'};
+    uint32_t version = FILE_VERSION;
+    uint32_t num_rr_nodes = 0; // Size of the RR graph the queries refer to
+};
+
+enum e_block_type : uint32_t {
+    CONGESTION = 1,
+    CONNECTION = 2
+};
+
+struct t_congestion_entry {
+    uint32_t rr_node;
+    float acc_cost;
+    int32_t occ;
+};
+
+struct t_connection_query {
+    uint32_t sink_node;
+    float criticality;
+    float astar_fac;
+    float bend_cost;
+    float pres_fac;
+    int32_t xmin; // Bounding box of the search
+    int32_t xmax;
+    int32_t ymin;
+    int32_t ymax;
+    uint32_t num_tree_nodes;
+};
+
+// Parent of the route tree root
+constexpr int32_t NO_PARENT = -1;
+
+struct t_tree_node {
+    uint32_t rr_node;
+    int32_t parent;   // Index of the parent t_tree_node, or NO_PARENT for the root
+    uint32_t rr_edge; // RR edge from the parent to this node (unused for the root)
+};
+
+static_assert(sizeof(t_congestion_entry) == 12, "Congestion entry layout is part of the file format");
+static_assert(sizeof(t_connection_query) == 40, "Connection query layout is part of the file format");
+static_assert(sizeof(t_tree_node) == 12, "Route tree node layout is part of the file format");
+
+/**
+ * @brief Captures up to max_connections connections routed to filename (if non-empty) until destroyed
+ *
+ * As with the router telemetry, the first session writing to a file truncates it, and later
+ * sessions writing to the same file (e.g. the routing attempts of a minimum channel width search)
+ * append to it, up to max_connections connections in total. Sessions of RR graphs of different
+ * sizes are not replayable together, so a session of another RR graph size restarts the file.
+ */
+class Session {
+  public:
+    Session(const std::string& filename, int max_connections);
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+};
+
+///@brief Returns true if the next connection routed should be captured
+bool enabled();
+
+///@brief Sets the router iteration of the connections captured from now on (and captures its congestion with the first one)
+void set_iteration(int itry);
+
+///@brief Captures a connection about to be routed from tree to sink_node
+void capture_connection(const RouteTree& tree,
+                        RRNodeId sink_node,
+                        const t_conn_cost_params& cost_params,
+                        const t_bb& bounding_box);
+
+///@brief A captured connection, as read back by read_capture()
+struct t_captured_connection {
+    t_connection_query query;
+    size_t congestion; // Index of the congestion snapshot (in t_capture::congestion) the connection was routed with
+    std::vector<t_tree_node> tree;
+};
+
+struct t_capture {
+    uint32_t num_rr_nodes = 0;
+    std::vector<std::vector<t_congestion_entry>> congestion;
+    std::vector<t_captured_connection> connections;
+};
+
+///@brief Reads a capture written by a Session (errors out if it is not a valid capture)
+t_capture read_capture(const std::string& filename);
+
+///@brief Resets the congestion of every RR node in rr_node_route_inf, then applies the congestion snapshot
+void load_congestion(const std::vector<t_congestion_entry>& congestion, t_rr_node_route_inf_storage& rr_node_route_inf);
+
+/**
+ * @brief Rebuilds a captured route tree (including its timing)
+ *
+ * scratch is sized to the RR graph, and only used for the traceback of the branches.
+ */
+RouteTree build_route_tree(const std::vector<t_tree_node>& tree_nodes, t_rr_node_route_inf_storage& scratch, bool is_flat);
+
+} // namespace router_capture
@@ -12,6 +12,8 @@ RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
                                          const RouterLookahead* lookahead,
                                          bool is_flat)
     : net_list_(net_list)
+    , lookahead_(lookahead)
+    , rr_node_route_inf_(g_vpr_ctx.routing().rr_node_route_inf)
     , router_(
           g_vpr_ctx.device().grid,
           *lookahead,
@@ -19,9 +21,28 @@ RouterDelayProfiler::RouterDelayProfiler(const Netlist<>& net_list,
           &g_vpr_ctx.device().rr_graph,
           g_vpr_ctx.device().rr_rc_data,
           g_vpr_ctx.device().rr_graph.rr_switch(),
-          g_vpr_ctx.mutable_routing().rr_node_route_inf,
+          rr_node_route_inf_,
           is_flat)
-    , is_flat_(is_flat) {}
+    , is_flat_(is_flat) {
+    /* Update base costs according to fanout and criticality rules.
+     * Done once up-front since calculate_delay() may run on several threads. */
+    update_rr_base_costs(1);
+}
+
+RouterDelayProfiler::RouterDelayProfiler(const RouterDelayProfiler& other)
+    : net_list_(other.net_list_)
+    , lookahead_(other.lookahead_)
+    , rr_node_route_inf_(g_vpr_ctx.routing().rr_node_route_inf)
+    , router_(
+          g_vpr_ctx.device().grid,
+          *other.lookahead_,
+          g_vpr_ctx.device().rr_graph.rr_nodes(),
+          &g_vpr_ctx.device().rr_graph,
+          g_vpr_ctx.device().rr_rc_data,
+          g_vpr_ctx.device().rr_graph.rr_switch(),
+          rr_node_route_inf_,
+          other.is_flat_)
+    , is_flat_(other.is_flat_) {}
 
 bool RouterDelayProfiler::calculate_delay(RRNodeId source_node, RRNodeId sink_node, const t_router_opts& router_opts, float* net_delay) {
     /* Returns true as long as found some way to hook up this net, even if that *
@@ -30,7 +51,6 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node, RRNodeId sink_no
      * case the rr_graph is disconnected and you can give up.                   */
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
 
     //vtr::ScopedStartFinishTimer t(vtr::string_fmt("Profiling Delay from %s at %d,%d (%s) to %s at %d,%d (%s)",
     //rr_graph.node_type_string(RRNodeId(source_node)),
@@ -43,10 +63,10 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node, RRNodeId sink_no
     //rr_node_arch_name(sink_node).c_str()));
 
     RouteTree tree((RRNodeId(source_node)));
-    enable_router_debug(router_opts, ParentNetId(), sink_node, 0, &router_);
-
-    /* Update base costs according to fanout and criticality rules */
-    update_rr_base_costs(1);
+    if (router_debug_requested(router_opts)) {
+        //Only touch the (global) router debug state when asked to, so profilers can run concurrently
+        enable_router_debug(router_opts, ParentNetId(), sink_node, 0, &router_);
+    }
 
     //maximum bounding box for placement
     t_bb bounding_box;
@@ -62,7 +82,7 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node, RRNodeId sink_no
 
     route_budgets budgeting_inf(net_list_, is_flat_);
 
-    router_.clear_modified_rr_node_info();
+    router_.reset_path_costs();
     RouterStats router_stats;
 
     bool found_path;
@@ -84,12 +104,12 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node, RRNodeId sink_no
         VTR_ASSERT(RRNodeId(cheapest.index) == sink_node);
 
         vtr::optional<const RouteTreeNode&> rt_node_of_sink;
-        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, is_flat_);
+        std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, is_flat_, &rr_node_route_inf_);
 
         //find delay
         *net_delay = rt_node_of_sink->Tdel;
 
-        VTR_ASSERT_MSG(route_ctx.rr_node_route_inf[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
+        VTR_ASSERT_MSG(rr_node_route_inf_[tree.root().inode].occ() <= rr_graph.node_capacity(tree.root().inode), "SOURCE should never be congested");
     }
 
     //VTR_LOG("Explored %zu of %zu (%.2f) RR nodes: path delay %g\n", router_stats.heap_pops, device_ctx.rr_nodes.size(), float(router_stats.heap_pops) / device_ctx.rr_nodes.size(), *net_delay);
@@ -102,12 +122,19 @@ bool RouterDelayProfiler::calculate_delay(RRNodeId source_node, RRNodeId sink_no
     return found_path;
 }
 
-//Returns the shortest path delay from src_node to all RR nodes in the RR graph, or NaN if no path exists
+bool router_debug_requested(const t_router_opts& router_opts) {
+    return router_opts.router_debug_net >= -1
+           || router_opts.router_debug_sink_rr >= 0
+           || router_opts.router_debug_iteration >= 0;
+}
+
+//Returns the shortest path delay from src_node to all RR nodes in the RR graph, or NaN if no path exists.
+//Searches over a private copy of the routing node state, so it is safe to call from several threads at once.
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src_rr_node,
                                                                     const t_router_opts& router_opts,
                                                                     bool is_flat) {
     auto& device_ctx = g_vpr_ctx.device();
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    t_rr_node_route_inf_storage rr_node_route_inf(g_vpr_ctx.routing().rr_node_route_inf);
 
     vtr::vector<RRNodeId, float> path_delays_to(device_ctx.rr_graph.num_nodes(), std::numeric_limits<float>::quiet_NaN());
 
@@ -131,6 +158,7 @@ vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src
     auto router_lookahead = make_router_lookahead(det_routing_arch, e_router_lookahead::NO_OP,
                                                   /*write_lookahead=*/"", /*read_lookahead=*/"",
                                                   /*segment_inf=*/{},
+                                                  /*half_precision=*/false,
                                                   is_flat);
 
     ConnectionRouter<BinaryHeap> router(
@@ -140,7 +168,7 @@ vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src
         &g_vpr_ctx.device().rr_graph,
         device_ctx.rr_rc_data,
         device_ctx.rr_graph.rr_switch(),
-        route_ctx.rr_node_route_inf,
+        rr_node_route_inf,
         is_flat);
     RouterStats router_stats;
     ConnectionParameters conn_params(ParentNetId::INVALID(), OPEN, false, std::unordered_map<RRNodeId, int>());
@@ -163,7 +191,7 @@ vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src
             //Build the routing tree to get the delay
             tree = RouteTree(RRNodeId(src_rr_node));
             vtr::optional<const RouteTreeNode&> rt_node_of_sink;
-            std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&shortest_paths[sink_rr_node], OPEN, nullptr, router_opts.flat_routing);
+            std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&shortest_paths[sink_rr_node], OPEN, nullptr, router_opts.flat_routing, &rr_node_route_inf);
 
             VTR_ASSERT(rt_node_of_sink->inode == RRNodeId(sink_rr_node));
 
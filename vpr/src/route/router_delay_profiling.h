@@ -8,20 +8,37 @@
 
 #include <vector>
 
+/**
+ * @brief Routes single connections on an otherwise empty device to profile their delay.
+ *
+ * Each profiler searches over its own copy of the routing node state, so
+ * independent profilers (e.g. copies made with the copy constructor) can
+ * calculate delays concurrently from different threads.
+ */
 class RouterDelayProfiler {
   public:
     RouterDelayProfiler(const Netlist<>& net_list,
                         const RouterLookahead* lookahead,
                         bool is_flat);
+
+    ///@brief Creates an independent profiler for the same netlist and lookahead
+    RouterDelayProfiler(const RouterDelayProfiler& other);
+    RouterDelayProfiler& operator=(const RouterDelayProfiler&) = delete;
+
     bool calculate_delay(RRNodeId source_node, RRNodeId sink_node, const t_router_opts& router_opts, float* net_delay);
 
   private:
     const Netlist<>& net_list_;
+    const RouterLookahead* lookahead_;
     RouterStats router_stats_;
+    t_rr_node_route_inf_storage rr_node_route_inf_;
     ConnectionRouter<BinaryHeap> router_;
     bool is_flat_;
 };
 
+///@brief Returns true if any of the router debug options (e.g. --router_debug_net) are set
+bool router_debug_requested(const t_router_opts& router_opts);
+
 vtr::vector<RRNodeId, float> calculate_all_path_delays_from_rr_node(RRNodeId src_rr_node,
                                                                     const t_router_opts& router_opts,
                                                                     bool is_flat);
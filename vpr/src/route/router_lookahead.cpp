@@ -31,6 +31,7 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
                                                        std::string write_lookahead,
                                                        std::string read_lookahead,
                                                        const std::vector<t_segment_inf>& segment_inf,
+                                                       bool half_precision,
                                                        bool is_flat) {
     std::unique_ptr<RouterLookahead> router_lookahead = make_router_lookahead_object(det_routing_arch,
                                                                                      router_lookahead_type,
@@ -46,6 +47,10 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
         router_lookahead->write(write_lookahead);
     }
 
+    if (half_precision) {
+        router_lookahead->compact();
+    }
+
     return router_lookahead;
 }
 
@@ -193,33 +198,55 @@ static int get_expected_segs_to_target(RRNodeId inode, RRNodeId target_node, int
 
 void invalidate_router_lookahead_cache() {
     auto& router_ctx = g_vpr_ctx.mutable_routing();
+    if (router_ctx.router_lookahead_cache_pinned_) {
+        //The lookahead is kept, but not what it derived from the rr graph
+        RouterLookahead* router_lookahead = router_ctx.cached_router_lookahead_.get_mutable(router_ctx.router_lookahead_cache_key_);
+        if (router_lookahead) {
+            router_lookahead->clear_rr_graph_data();
+        }
+        return;
+    }
     router_ctx.cached_router_lookahead_.clear();
 }
 
+void set_router_lookahead_cache_pinned(bool pinned) {
+    auto& router_ctx = g_vpr_ctx.mutable_routing();
+    bool was_pinned = router_ctx.router_lookahead_cache_pinned_;
+    router_ctx.router_lookahead_cache_pinned_ = pinned;
+    if (was_pinned && !pinned) {
+        invalidate_router_lookahead_cache();
+    }
+}
+
 const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det_routing_arch,
                                                    e_router_lookahead router_lookahead_type,
                                                    std::string write_lookahead,
                                                    std::string read_lookahead,
                                                    const std::vector<t_segment_inf>& segment_inf,
+                                                   bool half_precision,
                                                    bool is_flat) {
-    auto& router_ctx = g_vpr_ctx.routing();
     auto& mut_router_ctx = g_vpr_ctx.mutable_routing();
 
-    auto cache_key = std::make_tuple(router_lookahead_type, read_lookahead, segment_inf);
+    auto cache_key = std::make_tuple(router_lookahead_type, read_lookahead, segment_inf, half_precision);
     mut_router_ctx.router_lookahead_cache_key_ = cache_key;
 
     // Check if cache is valid.
-    const RouterLookahead* router_lookahead = router_ctx.cached_router_lookahead_.get(cache_key);
-    if (router_lookahead) {
-        return router_lookahead;
-    } else {
-        return mut_router_ctx.cached_router_lookahead_.set(
+    RouterLookahead* router_lookahead = mut_router_ctx.cached_router_lookahead_.get_mutable(cache_key);
+    if (!router_lookahead) {
+        mut_router_ctx.cached_router_lookahead_.set(
             cache_key,
             make_router_lookahead(det_routing_arch,
                                   router_lookahead_type,
                                   write_lookahead,
                                   read_lookahead,
                                   segment_inf,
+                                  half_precision,
                                   is_flat));
+        router_lookahead = mut_router_ctx.cached_router_lookahead_.get_mutable(cache_key);
     }
+
+    // A lookahead kept from a previous rr graph has to re-load its rr graph data
+    router_lookahead->load_rr_graph_data();
+
+    return router_lookahead;
 }
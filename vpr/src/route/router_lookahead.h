@@ -6,6 +6,16 @@
 
 struct t_conn_cost_params; //Forward declaration
 
+// Index of an entry of the table a lookahead (e.g. the map lookahead) estimates
+// the cost to reach a target from a wire with
+struct t_wire_cost_entry_index {
+    int layer;
+    int chan_index; //0 for CHANX, 1 for CHANY
+    int seg_index;
+    int delta_x;
+    int delta_y;
+};
+
 class RouterLookahead {
   public:
     // Get expected cost from node to target_node.
@@ -36,6 +46,31 @@ class RouterLookahead {
     // May be unimplemented, in which case method should throw an exception.
     virtual void write_intra_cluster(const std::string& file) const = 0;
 
+    // Get the entry of the lookahead's wire table which estimates the cost from
+    // the CHANX/CHANY node to target_node. Returns false if the lookahead has no
+    // such table. Used to profile the lookahead (see router_lookahead_profiler.h).
+    virtual bool get_wire_cost_entry_index(RRNodeId /*node*/, RRNodeId /*target_node*/, t_wire_cost_entry_index& /*index*/) const { return false; }
+
+    // Raise the delay of an entry of the lookahead's wire table to at least delay.
+    virtual void raise_wire_cost_entry_delay(const t_wire_cost_entry_index& /*index*/, float /*delay*/) {}
+
+    // Convert the lookahead's tables to half precision storage (if supported).
+    // This halves their cache footprint in the cost estimates, at the cost of
+    // keeping ~3 significant digits. Called once the lookahead is computed (or
+    // read) and written.
+    virtual void compact() {}
+
+    // Load the data the lookahead derives from the current rr graph to speed up
+    // the cost estimates (if any). The lookahead itself does not depend on rr
+    // node ids, so it may be kept over several rr graphs (see
+    // set_router_lookahead_cache_pinned()): this data is then cleared with the
+    // rr graph and re-loaded for the next one.
+    virtual void load_rr_graph_data() {}
+    virtual void clear_rr_graph_data() {}
+
+    // Returns the (estimated) heap memory used by the lookahead data, in bytes.
+    virtual size_t memory_usage() const { return 0; }
+
     virtual ~RouterLookahead() {}
 };
 
@@ -48,11 +83,22 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(const t_det_routing_arch&
                                                        std::string write_lookahead,
                                                        std::string read_lookahead,
                                                        const std::vector<t_segment_inf>& segment_inf,
+                                                       bool half_precision,
                                                        bool is_flat);
 
 // Clear router lookahead cache (e.g. when changing or free rrgraph).
 void invalidate_router_lookahead_cache();
 
+// While pinned, invalidate_router_lookahead_cache() keeps the cached lookahead.
+//
+// Used to reuse one lookahead across the rr graphs of different channel widths
+// (e.g. during the minimum channel width search). The lookahead tables only
+// depend on the segment types and switches (not on rr node ids), so the
+// lookahead of one channel width remains a (slightly less accurate) estimate
+// for another. Unpinning invalidates the cache, so that the lookahead is
+// recomputed for the next rr graph.
+void set_router_lookahead_cache_pinned(bool pinned);
+
 // Returns lookahead for given rr graph.
 //
 // Object is cached in RouterContext, but access to cached object should
@@ -62,6 +108,7 @@ const RouterLookahead* get_cached_router_lookahead(const t_det_routing_arch& det
                                                    std::string write_lookahead,
                                                    std::string read_lookahead,
                                                    const std::vector<t_segment_inf>& segment_inf,
+                                                   bool half_precision,
                                                    bool is_flat);
 
 class ClassicLookahead : public RouterLookahead {
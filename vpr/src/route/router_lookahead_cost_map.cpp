@@ -4,6 +4,7 @@
 #include "globals.h"
 #include "echo_files.h"
 #include "vtr_geometry.h"
+#include "vtr_memory_usage.h"
 
 #ifdef VTR_ENABLE_CAPNPROTO
 #    include "capnp/serialize.h"
@@ -341,6 +342,10 @@ std::vector<std::pair<int, int>> CostMap::list_empty() const {
     return results;
 }
 
+size_t CostMap::memory_usage() const {
+    return vtr::memory_usage(cost_map_, offset_, penalty_);
+}
+
 static void assign_min_entry(util::Cost_Entry* dst, const util::Cost_Entry& src) {
     if (src.delay < dst->delay) {
         dst->delay = src.delay;
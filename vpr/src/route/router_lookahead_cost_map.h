@@ -85,6 +85,11 @@ class CostMap {
     void print(int iseg) const;
     std::vector<std::pair<int, int>> list_empty() const;
 
+    /**
+     * @brief Returns the (estimated) heap memory used by the cost map, in bytes
+     */
+    size_t memory_usage() const;
+
   private:
     vtr::Matrix<vtr::Matrix<util::Cost_Entry>> cost_map_; ///<Cost map containing all the costs computed during the lookahead generation.
                                                           ///<It is indexed as follows: cost_map_[0][segment_index][delta_x][delta_y]
@@ -9,6 +9,7 @@
 #include "router_lookahead_sampling.h"
 #include "globals.h"
 #include "vtr_math.h"
+#include "vtr_memory_usage.h"
 #include "vtr_time.h"
 #include "vtr_geometry.h"
 #include "echo_files.h"
@@ -363,11 +364,16 @@ bool ExtendedMapLookahead::add_paths(RRNodeId start_node,
  * to that pin is stored to an entry in the routing_cost_map.
  *
  * Returns the maximum (last) minimum cost path stored, and
- * the number of paths from start_node stored. */
+ * the number of paths from start_node stored.
+ *
+ * node_expanded and paths must only have been modified by previous runs,
+ * which recorded the nodes they reached in reached_nodes: only those are
+ * reset, rather than the whole rr graph for each of the many runs. */
 template<typename Entry>
 std::pair<float, int> ExtendedMapLookahead::run_dijkstra(RRNodeId start_node,
                                                          std::vector<bool>* node_expanded,
                                                          std::vector<util::Search_Path>* paths,
+                                                         std::vector<RRNodeId>* reached_nodes,
                                                          util::RoutingCosts* routing_costs) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
@@ -375,12 +381,15 @@ std::pair<float, int> ExtendedMapLookahead::run_dijkstra(RRNodeId start_node,
 
     /* a list of boolean flags (one for each rr node) to figure out if a
      * certain node has already been expanded */
-    std::fill(node_expanded->begin(), node_expanded->end(), false);
     /* For each node keep a list of the cost with which that node has been
      * visited (used to determine whether to push a candidate node onto the
      * expansion queue.
      * Also store the parent node so we can reconstruct a specific path. */
-    std::fill(paths->begin(), paths->end(), util::Search_Path{std::numeric_limits<float>::infinity(), std::numeric_limits<size_t>::max(), -1});
+    for (RRNodeId node : *reached_nodes) {
+        (*node_expanded)[size_t(node)] = false;
+        (*paths)[size_t(node)] = util::Search_Path{std::numeric_limits<float>::infinity(), std::numeric_limits<size_t>::max(), -1};
+    }
+    reached_nodes->clear();
     /* a priority queue for expansion */
     std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
 
@@ -401,6 +410,8 @@ std::pair<float, int> ExtendedMapLookahead::run_dijkstra(RRNodeId start_node,
         if ((*node_expanded)[size_t(node)]) {
             continue;
         }
+        /* every node whose path is set is pushed, so it is popped (and recorded) here at least once */
+        reached_nodes->push_back(node);
 
         /* if this node is an ipin record its congestion/delay in the routing_cost_map */
         if (rr_graph.node_type(node) == IPIN) {
@@ -449,8 +460,10 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
         util::RoutingCosts delay_costs;
         util::RoutingCosts base_costs;
         int total_path_count = 0;
-        std::vector<bool> node_expanded(device_ctx.rr_graph.num_nodes());
-        std::vector<util::Search_Path> paths(device_ctx.rr_graph.num_nodes());
+        std::vector<bool> node_expanded(device_ctx.rr_graph.num_nodes(), false);
+        std::vector<util::Search_Path> paths(device_ctx.rr_graph.num_nodes(),
+                                             util::Search_Path{std::numeric_limits<float>::infinity(), std::numeric_limits<size_t>::max(), -1});
+        std::vector<RRNodeId> reached_nodes;
 
         // Each point in a sample region contains a set of nodes. Each node becomes a starting node
         // for the dijkstra expansions, and different paths are explored to reach different locations.
@@ -472,12 +485,12 @@ void ExtendedMapLookahead::compute(const std::vector<t_segment_inf>& segment_inf
                 //       Experiments have shown that the having two separate expansions lead to better results for Series 7 devices, but
                 //       this might not be true for Stratix ones.
                 {
-                    auto result = run_dijkstra<util::PQ_Entry_Delay>(node, &node_expanded, &paths, &delay_costs);
+                    auto result = run_dijkstra<util::PQ_Entry_Delay>(node, &node_expanded, &paths, &reached_nodes, &delay_costs);
                     max_delay_cost = std::max(max_delay_cost, result.first);
                     path_count += result.second;
                 }
                 {
-                    auto result = run_dijkstra<util::PQ_Entry_Base_Cost>(node, &node_expanded, &paths, &base_costs);
+                    auto result = run_dijkstra<util::PQ_Entry_Base_Cost>(node, &node_expanded, &paths, &reached_nodes, &base_costs);
                     max_base_cost = std::max(max_base_cost, result.first);
                     path_count += result.second;
                 }
@@ -622,3 +635,7 @@ void ExtendedMapLookahead::write(const std::string& file) const {
 }
 
 #endif
+
+size_t ExtendedMapLookahead::memory_usage() const {
+    return vtr::memory_usage(src_opin_delays, chan_ipins_delays, cost_map_);
+}
@@ -57,6 +57,7 @@ class ExtendedMapLookahead : public RouterLookahead {
     std::pair<float, int> run_dijkstra(RRNodeId start_node,
                                        std::vector<bool>* node_expanded,
                                        std::vector<util::Search_Path>* paths,
+                                       std::vector<RRNodeId>* reached_nodes,
                                        util::RoutingCosts* routing_costs);
 
     CostMap cost_map_; ///<Cost map containing all data to extract the entry cost when querying the lookahead.
@@ -103,6 +104,11 @@ class ExtendedMapLookahead : public RouterLookahead {
     void write_intra_cluster(const std::string& /*file*/) const override {
         VPR_THROW(VPR_ERROR_ROUTE, "ExtendedMapLookahead::write_intra_cluster unimplemented");
     }
+
+    /**
+     * @brief Returns the (estimated) heap memory used by the extended lookahead map, in bytes
+     */
+    size_t memory_usage() const override;
 };
 
 #endif
@@ -21,7 +21,10 @@
  * if there are multiple possiblities).
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <numeric>
 #include <vector>
 #include <queue>
 #include <ctime>
@@ -31,9 +34,12 @@
 #include "globals.h"
 #include "vtr_math.h"
 #include "vtr_log.h"
+#include "vtr_memory.h"
+#include "vtr_memory_usage.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 #include "vtr_geometry.h"
+#include "vtr_half.h"
 #include "router_lookahead_map.h"
 #include "router_lookahead_map_utils.h"
 #include "rr_graph2.h"
@@ -41,6 +47,12 @@
 #include "route_common.h"
 #include "route_timing.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for.h>
+#    include <tbb/parallel_for_each.h>
+#    include <tbb/enumerable_thread_specific.h>
+#endif
+
 #ifdef VTR_ENABLE_CAPNPROTO
 #    include "capnp/serialize.h"
 #    include "map_lookahead.capnp.h"
@@ -195,15 +207,45 @@ struct t_dijkstra_data {
     /* for each node keep a list of the cost with which that node has been visited (used to determine whether to push
      * a candidate node onto the expansion queue */
     vtr::vector<RRNodeId, float> node_visited_costs;
+    /* the nodes expanded or visited by the last run, whose flags/costs are reset by the next one (instead of resetting
+     * those of the whole rr graph for each of the thousands of runs) */
+    std::vector<RRNodeId> touched_nodes;
     /* a priority queue for expansion */
     std::priority_queue<PQ_Entry> pq;
 };
 
+/* how the Dijkstra expansion treats an rr node reached through an edge. It only depends on the (static) rr graph and grid,
+ * so it is classified once for all the runs instead of looking up the grid for every edge of every run */
+enum class e_expansion_node : uint8_t {
+    SKIP,   /* intra-cluster node, not explored by the lookahead */
+    EXPAND, /* inter-cluster node */
+    STOP    /* inter-cluster SINK: the expansion of a node stops at its first such child */
+};
+typedef vtr::vector<RRNodeId, e_expansion_node> t_expansion_nodes; //[0..rr_graph.num_nodes()-1]
+
+/* the Dijkstra floods profiling one wire segment type in one channel direction of a layer */
+struct t_wire_lookahead_sample_set {
+    int layer_num;
+    int segment_index;
+    e_rr_type chan_type;
+    std::vector<RRNodeId> sample_nodes;
+};
+
 /******** File-Scope Variables ********/
 
 //Look-up table from CHANX/CHANY (to SINKs) for various distances
 t_wire_cost_map f_wire_cost_map;
 
+//Half precision version of f_wire_cost_map, which replaces it once the lookahead is compacted.
+//The delays and congestion costs are stored divided by their scale (see vtr::half_scale()).
+t_half_wire_cost_map f_half_wire_cost_map;
+float f_half_delay_scale = 1.;
+float f_half_congestion_scale = 1.;
+
+//Slice (first index) of f_wire_cost_map/f_half_wire_cost_map holding the lookahead of each layer [0..num_layers-1].
+//Layers with identical lookaheads (e.g. identical stacked dies) share a slice, see share_identical_layer_costs().
+std::vector<int> f_wire_cost_map_layer_slices;
+
 /******** File-Scope Functions ********/
 
 /***
@@ -223,21 +265,24 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
  * @param det_routing_arch
  * @param device_ctx
  */
-static void compute_tiles_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
-                                    std::unordered_map<int, std::unordered_map<int, util::Cost_Entry>>& tile_min_cost,
+static void compute_tiles_lookahead(std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
+                                    std::vector<std::vector<util::Cost_Entry>>& tile_min_cost,
                                     const t_det_routing_arch& det_routing_arch,
                                     const DeviceContext& device_ctx);
 /***
- * @brief Compute the cose from tile pins to tile sinks
- * @param inter_tile_pin_primitive_pin_delay [physical_tile_type_idx][from_pin_ptc_num][sink_ptc_num] -> cost
+ * @brief Compute the cost from tile pins to tile sinks
+ * @param tile_rr_graph_builder rr graph of the tile, built by build_tile_rr_graph() at (layer, x, y)
  * @param physical_tile
- * @param det_routing_arch
- * @param delayless_switch
+ * @param layer
+ * @param x
+ * @param y
+ * @return [from_pin_ptc_num][sink_ptc_num] -> cost
  */
-static void compute_tile_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
-                                   t_physical_tile_type_ptr physical_tile,
-                                   const t_det_routing_arch& det_routing_arch,
-                                   const int delayless_switch);
+static util::t_ipin_primitive_sink_delays compute_tile_lookahead(RRGraphBuilder& tile_rr_graph_builder,
+                                                                  t_physical_tile_type_ptr physical_tile,
+                                                                  int layer,
+                                                                  int x,
+                                                                  int y);
 
 /***
  * @brief Compute the minimum cost to get to the sinks from pins on the cluster
@@ -245,9 +290,9 @@ static void compute_tile_lookahead(std::unordered_map<int, util::t_ipin_primitiv
  * @param physical_tile
  * @param inter_tile_pin_primitive_pin_delay [physical_tile_type_idx][from_pin_ptc_num][sink_ptc_num] -> cost
  */
-static void store_min_cost_to_sinks(std::unordered_map<int, std::unordered_map<int, util::Cost_Entry>>& tile_min_cost,
+static void store_min_cost_to_sinks(std::vector<std::vector<util::Cost_Entry>>& tile_min_cost,
                                     t_physical_tile_type_ptr physical_tile,
-                                    const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay);
+                                    const std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay);
 
 /***
  * @brief Iterate over the first and second dimension of f_wire_cost_map to get the minimum cost for each dx and dy_
@@ -255,13 +300,23 @@ static void store_min_cost_to_sinks(std::unordered_map<int, std::unordered_map<i
  */
 static void min_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 3>& internal_opin_global_cost_map);
 
+/***
+ * @brief Replace f_wire_cost_map by its (scaled) half precision version f_half_wire_cost_map
+ */
+static void compact_wire_cost_map();
+
+/***
+ * @brief Store the identical layer slices of f_wire_cost_map once, and map the layers to them in f_wire_cost_map_layer_slices
+ */
+static void share_identical_layer_costs();
+
 // Read the file and fill inter_tile_pin_primitive_pin_delay and tile_min_cost
-static void read_intra_cluster_router_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
+static void read_intra_cluster_router_lookahead(std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
                                                 const std::string& file);
 
 // Write the file with inter_tile_pin_primitive_pin_delay and tile_min_cost
 static void write_intra_cluster_router_lookahead(const std::string& file,
-                                                 const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay);
+                                                 const std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay);
 
 /* returns index of a node from which to start routing */
 static RRNodeId get_start_node(int layer, int start_x, int start_y, int target_x, int target_y, t_rr_type rr_type, int seg_index, int track_offset);
@@ -272,12 +327,14 @@ static void run_dijkstra(RRNodeId start_node,
                          int start_x,
                          int start_y,
                          t_routing_cost_map& routing_cost_map,
+                         const t_expansion_nodes& expansion_nodes,
                          t_dijkstra_data* data);
+/* classifies the rr nodes for the Dijkstra expansion */
+static t_expansion_nodes classify_expansion_nodes();
 /* iterates over the children of the specified node and selectively pushes them onto the priority queue */
 static void expand_dijkstra_neighbours(PQ_Entry parent_entry,
-                                       vtr::vector<RRNodeId, float>& node_visited_costs,
-                                       vtr::vector<RRNodeId, bool>& node_expanded,
-                                       std::priority_queue<PQ_Entry>& pq);
+                                       const t_expansion_nodes& expansion_nodes,
+                                       t_dijkstra_data* data);
 /* sets the lookahead cost map entries based on representative cost entries from routing_cost_map */
 static void set_lookahead_map_costs(int layer_num, int segment_index, e_rr_type chan_type, t_routing_cost_map& routing_cost_map);
 /* fills in missing lookahead map entries by copying the cost of the closest valid entry */
@@ -285,7 +342,9 @@ static void fill_in_missing_lookahead_entries(int segment_index, e_rr_type chan_
 /* returns a cost entry in the f_wire_cost_map that is near the specified coordinates (and preferably towards (0,0)) */
 static Cost_Entry get_nearby_cost_entry(int layer_num, int x, int y, int segment_index, int chan_index);
 /* returns the absolute delta_x and delta_y offset required to reach to_node from from_node */
+static t_map_lookahead_node_key make_node_key(const RRNodeId node);
 static void get_xy_deltas(const RRNodeId from_node, const RRNodeId to_node, int* delta_x, int* delta_y);
+static void get_xy_deltas(const t_map_lookahead_node_key& from_key, const t_map_lookahead_node_key& to_key, int* delta_x, int* delta_y);
 static void adjust_rr_position(const RRNodeId rr, int& x, int& y);
 static void adjust_rr_pin_position(const RRNodeId rr, int& x, int& y);
 static void adjust_rr_wire_position(const RRNodeId rr, int& x, int& y);
@@ -299,18 +358,17 @@ float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_nod
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
-    t_physical_tile_type_ptr from_physical_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(current_node),
-                                                                                     rr_graph.node_ylow(current_node),
-                                                                                     rr_graph.node_layer(current_node)});
-    t_rr_type from_rr_type = rr_graph.node_type(current_node);
+    const t_map_lookahead_node_key from_key = node_key(current_node);
+    const t_map_lookahead_node_key to_key = node_key(target_node);
+
+    t_physical_tile_type_ptr from_physical_type = &device_ctx.physical_tile_types[from_key.tile_index];
+    t_rr_type from_rr_type = t_rr_type(from_key.type);
     int from_node_ptc_num = rr_graph.node_ptc_num(current_node);
 
-    t_physical_tile_type_ptr to_physical_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(target_node),
-                                                                                   rr_graph.node_ylow(target_node),
-                                                                                   rr_graph.node_layer(target_node)});
-    t_rr_type to_rr_type = rr_graph.node_type(target_node);
+    t_physical_tile_type_ptr to_physical_type = &device_ctx.physical_tile_types[to_key.tile_index];
+    t_rr_type to_rr_type = t_rr_type(to_key.type);
     int to_node_ptc_num = rr_graph.node_ptc_num(target_node);
-    int to_layer_num = rr_graph.node_layer(target_node);
+    int to_layer_num = to_key.layer;
     VTR_ASSERT(to_rr_type == t_rr_type::SINK);
 
     float delay_cost = 0.;
@@ -320,14 +378,14 @@ float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_nod
 
     if (is_flat_) {
         // We have not checked the multi-layer FPGA for flat routing
-        VTR_ASSERT(rr_graph.node_layer(current_node) == rr_graph.node_layer(target_node));
+        VTR_ASSERT(from_key.layer == to_key.layer);
         if (from_rr_type == CHANX || from_rr_type == CHANY) {
-            std::tie(delay_cost, cong_cost) = get_expected_delay_and_cong(current_node, target_node, params, R_upstream);
+            std::tie(delay_cost, cong_cost) = get_expected_delay_and_cong(current_node, from_key, to_key, params);
 
             // delay_cost and cong_cost only represent the cost to get to the root-level pins. The below offsets are used to represent the intra-cluster cost
             // of getting to a sink
-            delay_offset_cost = params.criticality * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).delay;
-            cong_offset_cost = (1. - params.criticality) * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).congestion;
+            delay_offset_cost = params.criticality * tile_min_cost[to_physical_type->index][to_node_ptc_num].delay;
+            cong_offset_cost = (1. - params.criticality) * tile_min_cost[to_physical_type->index][to_node_ptc_num].congestion;
 
             return delay_cost + cong_cost + delay_offset_cost + cong_offset_cost;
         } else if (from_rr_type == OPIN) {
@@ -335,55 +393,53 @@ float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_nod
                                       from_rr_type,
                                       from_node_ptc_num)) {
                 // Similar to CHANX and CHANY
-                std::tie(delay_cost, cong_cost) = get_expected_delay_and_cong(current_node, target_node, params, R_upstream);
+                std::tie(delay_cost, cong_cost) = get_expected_delay_and_cong(current_node, from_key, to_key, params);
 
-                delay_offset_cost = params.criticality * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).delay;
-                cong_offset_cost = (1. - params.criticality) * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).congestion;
+                delay_offset_cost = params.criticality * tile_min_cost[to_physical_type->index][to_node_ptc_num].delay;
+                cong_offset_cost = (1. - params.criticality) * tile_min_cost[to_physical_type->index][to_node_ptc_num].congestion;
                 return delay_cost + cong_cost + delay_offset_cost + cong_offset_cost;
             } else {
                 if (node_in_same_physical_tile(current_node, target_node)) {
                     delay_offset_cost = 0.;
                     cong_offset_cost = 0.;
-                    const auto& pin_delays = inter_tile_pin_primitive_pin_delay.at(from_physical_type->index)[from_node_ptc_num];
-                    auto pin_delay_itr = pin_delays.find(rr_graph.node_ptc_num(target_node));
-                    if (pin_delay_itr == pin_delays.end()) {
+                    const util::Cost_Entry& pin_delay = inter_tile_pin_primitive_pin_delay[from_physical_type->index][from_node_ptc_num][to_node_ptc_num];
+                    if (!pin_delay.valid()) {
                         // There isn't any intra-cluster path to connect the current OPIN to the SINK, thus it has to outside.
                         // The best estimation we have now, it the minimum intra-cluster delay to the sink. However, this cost is incomplete,
                         // since it does not consider the cost of going outside of the cluster and, then, returning to it.
-                        delay_cost = params.criticality * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).delay;
-                        cong_cost = (1. - params.criticality) * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).congestion;
+                        delay_cost = params.criticality * tile_min_cost[to_physical_type->index][to_node_ptc_num].delay;
+                        cong_cost = (1. - params.criticality) * tile_min_cost[to_physical_type->index][to_node_ptc_num].congestion;
                         return delay_cost + cong_cost;
                     } else {
-                        delay_cost = params.criticality * pin_delay_itr->second.delay;
-                        cong_cost = (1. - params.criticality) * pin_delay_itr->second.congestion;
+                        delay_cost = params.criticality * pin_delay.delay;
+                        cong_cost = (1. - params.criticality) * pin_delay.congestion;
                     }
                 } else {
                     // Since we don't know which type of wires are accessible from an OPIN inside the cluster, we use
                     // distance_based_min_cost to get an estimation of the global cost, and then, add this cost to the tile_min_cost
                     // to have an estimation of the cost of getting into a cluster - We don't have any estimation of the cost to get out of the cluster
                     int delta_x, delta_y;
-                    get_xy_deltas(current_node, target_node, &delta_x, &delta_y);
+                    get_xy_deltas(from_key, to_key, &delta_x, &delta_y);
                     delta_x = abs(delta_x);
                     delta_y = abs(delta_y);
                     delay_cost = params.criticality * distance_based_min_cost[to_layer_num][delta_x][delta_y].delay;
                     cong_cost = (1. - params.criticality) * distance_based_min_cost[to_layer_num][delta_x][delta_y].congestion;
 
-                    delay_offset_cost = params.criticality * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).delay;
-                    cong_offset_cost = (1. - params.criticality) * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).congestion;
+                    delay_offset_cost = params.criticality * tile_min_cost[to_physical_type->index][to_node_ptc_num].delay;
+                    cong_offset_cost = (1. - params.criticality) * tile_min_cost[to_physical_type->index][to_node_ptc_num].congestion;
                 }
                 return delay_cost + cong_cost + delay_offset_cost + cong_offset_cost;
             }
         } else if (from_rr_type == IPIN) {
             // we assume that route-through is not enabled.
             VTR_ASSERT(node_in_same_physical_tile(current_node, target_node));
-            const auto& pin_delays = inter_tile_pin_primitive_pin_delay.at(from_physical_type->index)[from_node_ptc_num];
-            auto pin_delay_itr = pin_delays.find(rr_graph.node_ptc_num(target_node));
-            if (pin_delay_itr == pin_delays.end()) {
+            const util::Cost_Entry& pin_delay = inter_tile_pin_primitive_pin_delay[from_physical_type->index][from_node_ptc_num][to_node_ptc_num];
+            if (!pin_delay.valid()) {
                 delay_cost = std::numeric_limits<float>::max() / 1e12;
                 cong_cost = std::numeric_limits<float>::max() / 1e12;
             } else {
-                delay_cost = params.criticality * pin_delay_itr->second.delay;
-                cong_cost = (1. - params.criticality) * pin_delay_itr->second.congestion;
+                delay_cost = params.criticality * pin_delay.delay;
+                cong_cost = (1. - params.criticality) * pin_delay.congestion;
             }
             return delay_cost + cong_cost;
         } else if (from_rr_type == SOURCE) {
@@ -394,14 +450,14 @@ float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_nod
                 cong_offset_cost = 0.;
             } else {
                 int delta_x, delta_y;
-                get_xy_deltas(current_node, target_node, &delta_x, &delta_y);
+                get_xy_deltas(from_key, to_key, &delta_x, &delta_y);
                 delta_x = abs(delta_x);
                 delta_y = abs(delta_y);
                 delay_cost = params.criticality * distance_based_min_cost[to_layer_num][delta_x][delta_y].delay;
                 cong_cost = (1. - params.criticality) * distance_based_min_cost[to_layer_num][delta_x][delta_y].congestion;
 
-                delay_offset_cost = params.criticality * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).delay;
-                cong_offset_cost = (1. - params.criticality) * tile_min_cost.at(to_physical_type->index).at(to_node_ptc_num).congestion;
+                delay_offset_cost = params.criticality * tile_min_cost[to_physical_type->index][to_node_ptc_num].delay;
+                cong_offset_cost = (1. - params.criticality) * tile_min_cost[to_physical_type->index][to_node_ptc_num].congestion;
             }
             return delay_cost + cong_cost + delay_offset_cost + cong_offset_cost;
         } else {
@@ -411,7 +467,7 @@ float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_nod
     } else {
         if (from_rr_type == CHANX || from_rr_type == CHANY || from_rr_type == SOURCE || from_rr_type == OPIN) {
             // Get the total cost using the combined delay and congestion costs
-            std::tie(delay_cost, cong_cost) = get_expected_delay_and_cong(current_node, target_node, params, R_upstream);
+            std::tie(delay_cost, cong_cost) = get_expected_delay_and_cong(current_node, from_key, to_key, params);
             return delay_cost + cong_cost;
         } else if (from_rr_type == IPIN) { /* Change if you're allowing route-throughs */
             return (device_ctx.rr_indexed_data[RRIndexedDataId(SINK_COST_INDEX)].base_cost);
@@ -425,30 +481,33 @@ float MapLookahead::get_expected_cost(RRNodeId current_node, RRNodeId target_nod
 /* queries the lookahead_map (should have been computed prior to routing) to get the expected cost
  * from the specified source to the specified target */
 std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_node, RRNodeId to_node, const t_conn_cost_params& params, float /*R_upstream*/) const {
+    return get_expected_delay_and_cong(from_node, node_key(from_node), node_key(to_node), params);
+}
+
+std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_node,
+                                                                  const t_map_lookahead_node_key& from_key,
+                                                                  const t_map_lookahead_node_key& to_key,
+                                                                  const t_conn_cost_params& params) const {
     auto& device_ctx = g_vpr_ctx.device();
     auto& rr_graph = device_ctx.rr_graph;
 
     int delta_x, delta_y;
-    int from_layer_num = rr_graph.node_layer(from_node);
-    get_xy_deltas(from_node, to_node, &delta_x, &delta_y);
+    int from_layer_num = from_key.layer;
+    get_xy_deltas(from_key, to_key, &delta_x, &delta_y);
     delta_x = abs(delta_x);
     delta_y = abs(delta_y);
 
     float expected_delay_cost = std::numeric_limits<float>::infinity();
     float expected_cong_cost = std::numeric_limits<float>::infinity();
 
-    e_rr_type from_type = rr_graph.node_type(from_node);
+    e_rr_type from_type = e_rr_type(from_key.type);
     if (from_type == SOURCE || from_type == OPIN) {
         //When estimating costs from a SOURCE/OPIN we look-up to find which wire types (and the
         //cost to reach them) in src_opin_delays. Once we know what wire types are
         //reachable, we query the f_wire_cost_map (i.e. the wire lookahead) to get the final
         //delay to reach the sink.
 
-        t_physical_tile_type_ptr tile_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(from_node),
-                                                                                rr_graph.node_ylow(from_node),
-                                                                                from_layer_num});
-
-        auto tile_index = std::distance(&device_ctx.physical_tile_types[0], tile_type);
+        int tile_index = from_key.tile_index;
 
         auto from_ptc = rr_graph.node_ptc_num(from_node);
 
@@ -519,8 +578,7 @@ std::pair<float, float> MapLookahead::get_expected_delay_and_cong(RRNodeId from_
         VTR_ASSERT_SAFE(from_type == CHANX || from_type == CHANY);
         //When estimating costs from a wire, we directly look-up the result in the wire lookahead (f_wire_cost_map)
 
-        auto from_cost_index = rr_graph.node_cost_index(from_node);
-        int from_seg_index = device_ctx.rr_indexed_data[from_cost_index].seg_index;
+        int from_seg_index = from_key.seg_index;
 
         VTR_ASSERT(from_seg_index >= 0);
 
@@ -584,7 +642,9 @@ void MapLookahead::compute_intra_tile() {
 }
 
 void MapLookahead::read(const std::string& file) {
+    f_half_wire_cost_map.clear();
     read_router_lookahead(file);
+    share_identical_layer_costs();
 
     //Next, compute which wire types are accessible (and the cost to reach them)
     //from the different physical tile type's SOURCEs & OPINs
@@ -595,11 +655,12 @@ void MapLookahead::read_intra_cluster(const std::string& file) {
     vtr::ScopedStartFinishTimer timer("Loading router intra cluster lookahead map");
     is_flat_ = true;
     // Maps related to global resources should not be empty
-    VTR_ASSERT(!f_wire_cost_map.empty());
+    VTR_ASSERT(!f_wire_cost_map.empty() || !f_half_wire_cost_map.empty());
     read_intra_cluster_router_lookahead(inter_tile_pin_primitive_pin_delay,
                                         file);
 
     const auto& tiles = g_vpr_ctx.device().physical_tile_types;
+    tile_min_cost.resize(tiles.size());
     for (const auto& tile : tiles) {
         if (is_empty_type(&tile)) {
             continue;
@@ -622,8 +683,94 @@ void MapLookahead::write_intra_cluster(const std::string& file) const {
                                          inter_tile_pin_primitive_pin_delay);
 }
 
+bool MapLookahead::get_wire_cost_entry_index(RRNodeId node, RRNodeId target_node, t_wire_cost_entry_index& index) const {
+    const t_map_lookahead_node_key from_key = node_key(node);
+    const t_map_lookahead_node_key to_key = node_key(target_node);
+    VTR_ASSERT_SAFE(is_chan(e_rr_type(from_key.type)));
+
+    int delta_x, delta_y;
+    get_xy_deltas(from_key, to_key, &delta_x, &delta_y);
+
+    index.layer = from_key.layer;
+    index.chan_index = (e_rr_type(from_key.type) == CHANY) ? 1 : 0;
+    index.seg_index = from_key.seg_index;
+    index.delta_x = abs(delta_x);
+    index.delta_y = abs(delta_y);
+    return true;
+}
+
+void MapLookahead::raise_wire_cost_entry_delay(const t_wire_cost_entry_index& index, float delay) {
+    //Raises the entry of every layer sharing the slice of index.layer
+    int slice = f_wire_cost_map_layer_slices[index.layer];
+    if (!f_half_wire_cost_map.empty()) {
+        t_half_cost_entry& half_entry = f_half_wire_cost_map[slice][index.chan_index][index.seg_index][index.delta_x][index.delta_y];
+        if (vtr::half_to_float(half_entry.delay) * f_half_delay_scale < delay) {
+            half_entry.delay = vtr::float_to_half(delay / f_half_delay_scale);
+        }
+        return;
+    }
+    Cost_Entry& cost_entry = f_wire_cost_map[slice][index.chan_index][index.seg_index][index.delta_x][index.delta_y];
+    cost_entry.delay = std::max(cost_entry.delay, delay);
+}
+
+void MapLookahead::compact() {
+    if (f_half_wire_cost_map.empty()) {
+        compact_wire_cost_map();
+    }
+}
+
+void MapLookahead::load_rr_graph_data() {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+    if (node_keys_.size() == rr_graph.num_nodes()) {
+        return;
+    }
+
+    node_keys_.clear();
+    node_keys_.reserve(rr_graph.num_nodes());
+    for (const RRNodeId node : rr_graph.nodes()) {
+        node_keys_.push_back(make_node_key(node));
+    }
+}
+
+void MapLookahead::clear_rr_graph_data() {
+    vtr::release_memory(node_keys_);
+}
+
+t_map_lookahead_node_key MapLookahead::node_key(RRNodeId node) const {
+    //Without the data of the current rr graph (e.g. when profiling the lookahead), work it out
+    if (node_keys_.empty()) {
+        return make_node_key(node);
+    }
+    VTR_ASSERT_SAFE(size_t(node) < node_keys_.size());
+    return node_keys_[node];
+}
+
+size_t MapLookahead::memory_usage() const {
+    return vtr::memory_usage(f_wire_cost_map, f_half_wire_cost_map, f_wire_cost_map_layer_slices, src_opin_delays, inter_tile_pin_primitive_pin_delay,
+                             tile_min_cost, distance_based_min_cost, node_keys_);
+}
+
 /******** Function Definitions ********/
 
+/* returns the entry of the wire lookahead, from whichever of f_wire_cost_map and f_half_wire_cost_map holds it */
+static inline Cost_Entry wire_cost_map_entry(int layer_num, int chan_index, int seg_index, int delta_x, int delta_y) {
+    int slice = f_wire_cost_map_layer_slices[layer_num];
+    if (!f_half_wire_cost_map.empty()) {
+        const t_half_cost_entry& entry = f_half_wire_cost_map[slice][chan_index][seg_index][delta_x][delta_y];
+        return Cost_Entry(vtr::half_to_float(entry.delay) * f_half_delay_scale,
+                          vtr::half_to_float(entry.congestion) * f_half_congestion_scale);
+    }
+    return f_wire_cost_map[slice][chan_index][seg_index][delta_x][delta_y];
+}
+
+/* returns the size of the dimension dim of the wire lookahead, where dimension 0 is the layers */
+static size_t wire_cost_map_dim_size(size_t dim) {
+    if (dim == 0) {
+        return f_wire_cost_map_layer_slices.size();
+    }
+    return f_half_wire_cost_map.empty() ? f_wire_cost_map.dim_size(dim) : f_half_wire_cost_map.dim_size(dim);
+}
+
 Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, int layer_num, int delta_x, int delta_y) {
     VTR_ASSERT_SAFE(rr_type == CHANX || rr_type == CHANY);
 
@@ -632,11 +779,93 @@ Cost_Entry get_wire_cost_entry(e_rr_type rr_type, int seg_index, int layer_num,
         chan_index = 1;
     }
 
-    VTR_ASSERT_SAFE(layer_num < (int)f_wire_cost_map.dim_size(0));
-    VTR_ASSERT_SAFE(delta_x < (int)f_wire_cost_map.dim_size(3));
-    VTR_ASSERT_SAFE(delta_y < (int)f_wire_cost_map.dim_size(4));
+    VTR_ASSERT_SAFE(layer_num < (int)wire_cost_map_dim_size(0));
+    VTR_ASSERT_SAFE(delta_x < (int)wire_cost_map_dim_size(3));
+    VTR_ASSERT_SAFE(delta_y < (int)wire_cost_map_dim_size(4));
+
+    return wire_cost_map_entry(layer_num, chan_index, seg_index, delta_x, delta_y);
+}
+
+static void compact_wire_cost_map() {
+    vtr::ScopedStartFinishTimer timer("Compacting router wire lookahead to half precision");
+    VTR_ASSERT(f_half_wire_cost_map.empty());
+
+    float max_delay = 0.;
+    float max_congestion = 0.;
+    for (size_t i = 0; i < f_wire_cost_map.size(); i++) {
+        const Cost_Entry& entry = f_wire_cost_map.get(i);
+        if (std::isfinite(entry.delay)) max_delay = std::max(max_delay, std::abs(entry.delay));
+        if (std::isfinite(entry.congestion)) max_congestion = std::max(max_congestion, std::abs(entry.congestion));
+    }
+    f_half_delay_scale = vtr::half_scale(max_delay);
+    f_half_congestion_scale = vtr::half_scale(max_congestion);
+
+    f_half_wire_cost_map.resize({f_wire_cost_map.dim_size(0),
+                                 f_wire_cost_map.dim_size(1),
+                                 f_wire_cost_map.dim_size(2),
+                                 f_wire_cost_map.dim_size(3),
+                                 f_wire_cost_map.dim_size(4)});
+
+    //Track the error on the delays, which must stay well below the variations the router relies on
+    float max_delay_error = 0.;
+    for (size_t i = 0; i < f_wire_cost_map.size(); i++) {
+        const Cost_Entry& entry = f_wire_cost_map.get(i);
+        t_half_cost_entry& half_entry = f_half_wire_cost_map.get(i);
+        half_entry.delay = vtr::float_to_half(entry.delay / f_half_delay_scale);
+        half_entry.congestion = vtr::float_to_half(entry.congestion / f_half_congestion_scale);
+
+        float delay = vtr::half_to_float(half_entry.delay) * f_half_delay_scale;
+        if (std::isfinite(entry.delay) && entry.delay != 0.) {
+            max_delay_error = std::max(max_delay_error, std::abs(delay - entry.delay) / std::abs(entry.delay));
+        }
+    }
+
+    size_t float_bytes = vtr::memory_usage(f_wire_cost_map);
+    f_wire_cost_map.clear();
+
+    VTR_LOG("Wire lookahead compacted from %.2f MiB to %.2f MiB (max relative delay error %g)\n",
+            float_bytes / 1024. / 1024., vtr::memory_usage(f_half_wire_cost_map) / 1024. / 1024., max_delay_error);
+}
+
+static void share_identical_layer_costs() {
+    VTR_ASSERT(f_half_wire_cost_map.empty());
+    size_t num_layers = f_wire_cost_map.dim_size(0);
+    size_t slice_size = (num_layers > 0) ? f_wire_cost_map.size() / num_layers : 0;
+
+    //Find the first layer with the same costs as each layer. The costs are compared bit for bit,
+    //so sharing never changes a cost estimate (and the NaNs of unreachable entries compare equal).
+    std::vector<size_t> unique_layers;
+    f_wire_cost_map_layer_slices.assign(num_layers, OPEN);
+    for (size_t layer_num = 0; layer_num < num_layers; layer_num++) {
+        const Cost_Entry* layer_costs = &f_wire_cost_map.get(layer_num * slice_size);
+        for (size_t islice = 0; islice < unique_layers.size(); islice++) {
+            const Cost_Entry* slice_costs = &f_wire_cost_map.get(unique_layers[islice] * slice_size);
+            if (std::memcmp(layer_costs, slice_costs, slice_size * sizeof(Cost_Entry)) == 0) {
+                f_wire_cost_map_layer_slices[layer_num] = islice;
+                break;
+            }
+        }
+        if (f_wire_cost_map_layer_slices[layer_num] == OPEN) {
+            f_wire_cost_map_layer_slices[layer_num] = unique_layers.size();
+            unique_layers.push_back(layer_num);
+        }
+    }
+
+    if (unique_layers.size() == num_layers) {
+        return;
+    }
+
+    t_wire_cost_map shared_wire_cost_map({unique_layers.size(),
+                                          f_wire_cost_map.dim_size(1),
+                                          f_wire_cost_map.dim_size(2),
+                                          f_wire_cost_map.dim_size(3),
+                                          f_wire_cost_map.dim_size(4)});
+    for (size_t islice = 0; islice < unique_layers.size(); islice++) {
+        std::copy_n(&f_wire_cost_map.get(unique_layers[islice] * slice_size), slice_size, &shared_wire_cost_map.get(islice * slice_size));
+    }
+    f_wire_cost_map = std::move(shared_wire_cost_map);
 
-    return f_wire_cost_map[layer_num][chan_index][seg_index][delta_x][delta_y];
+    VTR_LOG("Wire lookahead of %zu layers stored as %zu distinct layer cost maps\n", num_layers, unique_layers.size());
 }
 
 static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segment_inf) {
@@ -647,6 +876,9 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
     auto& grid = device_ctx.grid;
 
     //Re-allocate
+    f_half_wire_cost_map.clear();
+    f_wire_cost_map_layer_slices.resize(grid.get_num_layers());
+    std::iota(f_wire_cost_map_layer_slices.begin(), f_wire_cost_map_layer_slices.end(), 0);
     f_wire_cost_map = t_wire_cost_map({static_cast<unsigned long>(grid.get_num_layers()),
                                        2,
                                        segment_inf.size(),
@@ -677,7 +909,8 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
     int target_x = device_ctx.grid.width() - 2;
     int target_y = device_ctx.grid.height() - 2;
 
-    //Profile each wire segment type
+    //Pick the sample locations to profile each wire segment type from
+    std::vector<t_wire_lookahead_sample_set> sample_sets;
     for (int layer_num = 0; layer_num < grid.get_num_layers(); layer_num++) {
         //if arch file specifies die_number="layer_num" doesn't require inter-cluster
         //programmable routing resources, then we shouldn't profile wire segment types in
@@ -749,12 +982,6 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
                 }
             }
 
-            //Finally, now that we have a list of sample locations, run a Djikstra flood from
-            //each sample location to profile the routing network from this type
-
-            t_dijkstra_data dijkstra_data;
-            t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
-
             for (e_rr_type chan_type : chan_types) {
                 if (sample_nodes[chan_type].empty()) {
                     VTR_LOG_WARN("Unable to find any sample location for segment %s type '%s' (length %d)\n",
@@ -762,40 +989,72 @@ static void compute_router_wire_lookahead(const std::vector<t_segment_inf>& segm
                                  segment_inf[iseg].name.c_str(),
                                  segment_inf[iseg].length);
                 } else {
-                    //reset cost for this segment
-                    routing_cost_map.fill(Expansion_Cost_Entry());
+                    sample_sets.push_back({layer_num, iseg, chan_type, std::move(sample_nodes[chan_type])});
+                }
+            }
+        }
+    }
 
-                    for (RRNodeId sample_node : sample_nodes[chan_type]) {
-                        int sample_x = rr_graph.node_xlow(sample_node);
-                        int sample_y = rr_graph.node_ylow(sample_node);
+    //Finally, now that we have a list of sample locations, run a Djikstra flood from
+    //each sample location to profile the routing network from each type.
+    //
+    //The sample sets are independent and each writes its own slice of f_wire_cost_map,
+    //so they are profiled in parallel. Each set keeps its own routing_cost_map, while
+    //the (per rr node) Dijkstra data is re-used by all the sets profiled on a thread.
+    const t_expansion_nodes expansion_nodes = classify_expansion_nodes();
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<t_dijkstra_data> all_dijkstra_data;
+    tbb::parallel_for_each(sample_sets, [&](const t_wire_lookahead_sample_set& sample_set) {
+        t_dijkstra_data& dijkstra_data = all_dijkstra_data.local();
+#else
+    t_dijkstra_data dijkstra_data;
+    for (const t_wire_lookahead_sample_set& sample_set : sample_sets) {
+#endif
+        t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
 
-                        if (rr_graph.node_direction(sample_node) == Direction::DEC) {
-                            sample_x = rr_graph.node_xhigh(sample_node);
-                            sample_y = rr_graph.node_yhigh(sample_node);
-                        }
+        for (RRNodeId sample_node : sample_set.sample_nodes) {
+            int sample_x = rr_graph.node_xlow(sample_node);
+            int sample_y = rr_graph.node_ylow(sample_node);
 
-                        run_dijkstra(sample_node,
-                                     layer_num,
-                                     sample_x,
-                                     sample_y,
-                                     routing_cost_map,
-                                     &dijkstra_data);
-                    }
+            if (rr_graph.node_direction(sample_node) == Direction::DEC) {
+                sample_x = rr_graph.node_xhigh(sample_node);
+                sample_y = rr_graph.node_yhigh(sample_node);
+            }
 
-                    if (false) print_router_cost_map(routing_cost_map);
+            run_dijkstra(sample_node,
+                         sample_set.layer_num,
+                         sample_x,
+                         sample_y,
+                         routing_cost_map,
+                         expansion_nodes,
+                         &dijkstra_data);
+        }
 
-                    /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
-                     * cost map */
-                    set_lookahead_map_costs(layer_num, iseg, chan_type, routing_cost_map);
+        if (false) print_router_cost_map(routing_cost_map);
 
-                    /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
-                     * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed) */
-                    fill_in_missing_lookahead_entries(iseg, chan_type);
-                }
-            }
+        /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
+         * cost map */
+        set_lookahead_map_costs(sample_set.layer_num, sample_set.segment_index, sample_set.chan_type, routing_cost_map);
+#if defined(VPR_USE_TBB)
+    });
+#else
+    }
+#endif
+
+    /* fill in missing entries in the lookahead cost map by copying the closest cost entries (cost map was computed based on
+     * a reference coordinate > (0,0) so some entries that represent a cross-chip distance have not been computed).
+     * This reads entries of all layers, so it is only done once every sample set has been profiled. */
+    for (const t_wire_lookahead_sample_set& sample_set : sample_sets) {
+        fill_in_missing_lookahead_entries(sample_set.segment_index, sample_set.chan_type);
+    }
+
+    if (false) {
+        for (int layer_num = 0; layer_num < grid.get_num_layers(); layer_num++) {
+            print_wire_cost_map(layer_num, segment_inf);
         }
-        if (false) print_wire_cost_map(layer_num, segment_inf);
     }
+
+    share_identical_layer_costs();
 }
 
 /* returns index of a node from which to start routing */
@@ -820,7 +1079,10 @@ static RRNodeId get_start_node(int layer, int start_x, int start_y, int target_x
     int start_lookup_y = start_y;
 
     /* find first node in channel that has specified segment index and goes in the desired direction */
-    for (const RRNodeId& node_id : node_lookup.find_channel_nodes(layer, start_lookup_x, start_lookup_y, rr_type)) {
+    for (RRNodeId node_id : node_lookup.channel_nodes(layer, start_lookup_x, start_lookup_y, rr_type)) {
+        if (!node_id) {
+            continue;
+        }
         VTR_ASSERT(rr_graph.node_type(node_id) == rr_type);
 
         Direction node_direction = rr_graph.node_direction(node_id);
@@ -847,17 +1109,26 @@ static void run_dijkstra(RRNodeId start_node,
                          int start_x,
                          int start_y,
                          t_routing_cost_map& routing_cost_map,
+                         const t_expansion_nodes& expansion_nodes,
                          t_dijkstra_data* data) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
     auto& node_expanded = data->node_expanded;
-    node_expanded.resize(rr_graph.num_nodes());
-    std::fill(node_expanded.begin(), node_expanded.end(), false);
-
     auto& node_visited_costs = data->node_visited_costs;
-    node_visited_costs.resize(rr_graph.num_nodes());
-    std::fill(node_visited_costs.begin(), node_visited_costs.end(), -1.0);
+    if (node_expanded.size() != rr_graph.num_nodes()) {
+        node_expanded.assign(rr_graph.num_nodes(), false);
+        node_visited_costs.assign(rr_graph.num_nodes(), -1.0);
+        data->touched_nodes.clear();
+    }
+
+    /* reset the nodes of the previous run */
+    for (RRNodeId node : data->touched_nodes) {
+        node_expanded[node] = false;
+        node_visited_costs[node] = -1.0;
+    }
+    data->touched_nodes.clear();
+    data->touched_nodes.push_back(start_node);
 
     /* a priority queue for expansion */
     std::priority_queue<PQ_Entry>& pq = data->pq;
@@ -905,36 +1176,54 @@ static void run_dijkstra(RRNodeId start_node,
             }
         }
 
-        expand_dijkstra_neighbours(current, node_visited_costs, node_expanded, pq);
+        expand_dijkstra_neighbours(current, expansion_nodes, data);
         node_expanded[curr_node] = true;
     }
 }
 
+static t_expansion_nodes classify_expansion_nodes() {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    t_expansion_nodes expansion_nodes(rr_graph.num_nodes(), e_expansion_node::SKIP);
+    for (RRNodeId node : rr_graph.nodes()) {
+        // For the time being, we decide to not let the lookahead explore the node inside the clusters
+        t_physical_tile_type_ptr physical_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(node),
+                                                                                    rr_graph.node_ylow(node),
+                                                                                    rr_graph.node_layer(node)});
+
+        if (is_inter_cluster_node(physical_type,
+                                  rr_graph.node_type(node),
+                                  rr_graph.node_ptc_num(node))) {
+            expansion_nodes[node] = (rr_graph.node_type(node) == SINK) ? e_expansion_node::STOP : e_expansion_node::EXPAND;
+        }
+    }
+    return expansion_nodes;
+}
+
 /* iterates over the children of the specified node and selectively pushes them onto the priority queue */
 static void expand_dijkstra_neighbours(PQ_Entry parent_entry,
-                                       vtr::vector<RRNodeId, float>& node_visited_costs,
-                                       vtr::vector<RRNodeId, bool>& node_expanded,
-                                       std::priority_queue<PQ_Entry>& pq) {
+                                       const t_expansion_nodes& expansion_nodes,
+                                       t_dijkstra_data* data) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
+    auto& node_visited_costs = data->node_visited_costs;
+    auto& node_expanded = data->node_expanded;
+    auto& pq = data->pq;
+
     RRNodeId parent = parent_entry.rr_node;
 
     for (t_edge_size edge : rr_graph.edges(parent)) {
         RRNodeId child_node = rr_graph.edge_sink_node(parent, edge);
-        // For the time being, we decide to not let the lookahead explore the node inside the clusters
-        t_physical_tile_type_ptr physical_type = device_ctx.grid.get_physical_type({rr_graph.node_xlow(child_node),
-                                                                                    rr_graph.node_ylow(child_node),
-                                                                                    rr_graph.node_layer(child_node)});
 
-        if (!is_inter_cluster_node(physical_type,
-                                   rr_graph.node_type(child_node),
-                                   rr_graph.node_ptc_num(child_node))) {
+        e_expansion_node child_expansion = expansion_nodes[child_node];
+        if (child_expansion == e_expansion_node::SKIP) {
             continue;
         }
         int switch_ind = size_t(rr_graph.edge_switch(parent, edge));
 
-        if (rr_graph.node_type(child_node) == SINK) return;
+        if (child_expansion == e_expansion_node::STOP) return;
 
         /* skip this child if it has already been expanded from */
         if (node_expanded[child_node]) {
@@ -952,6 +1241,9 @@ static void expand_dijkstra_neighbours(PQ_Entry parent_entry,
         }
 
         /* finally, record the cost with which the child was visited and put the child entry on the queue */
+        if (node_visited_costs[child_node] < 0) {
+            data->touched_nodes.push_back(child_node);
+        }
         node_visited_costs[child_node] = child_entry.cost;
         pq.push(child_entry);
     }
@@ -1136,26 +1428,46 @@ Cost_Entry Expansion_Cost_Entry::get_median_entry() {
     return representative_entry;
 }
 
-/* returns the absolute delta_x and delta_y offset required to reach to_node from from_node */
-static void get_xy_deltas(const RRNodeId from_node, const RRNodeId to_node, int* delta_x, int* delta_y) {
+/* returns the lookahead key of node, see t_map_lookahead_node_key */
+static t_map_lookahead_node_key make_node_key(const RRNodeId node) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
 
-    e_rr_type from_type = rr_graph.node_type(from_node);
-    e_rr_type to_type = rr_graph.node_type(to_node);
+    t_map_lookahead_node_key key;
+    key.xlow = rr_graph.node_xlow(node);
+    key.ylow = rr_graph.node_ylow(node);
+    key.xhigh = rr_graph.node_xhigh(node);
+    key.yhigh = rr_graph.node_yhigh(node);
+    key.layer = rr_graph.node_layer(node);
+    key.type = rr_graph.node_type(node);
+    key.direction = is_chan(rr_graph.node_type(node)) ? rr_graph.node_direction(node) : Direction::NONE;
+    key.seg_index = device_ctx.rr_indexed_data[rr_graph.node_cost_index(node)].seg_index;
+
+    t_physical_tile_type_ptr tile_type = device_ctx.grid.get_physical_type({key.xlow, key.ylow, key.layer});
+    key.tile_index = std::distance(&device_ctx.physical_tile_types[0], tile_type);
+
+    int adjusted_x = 0;
+    int adjusted_y = 0;
+    adjust_rr_position(node, adjusted_x, adjusted_y);
+    key.adjusted_x = adjusted_x;
+    key.adjusted_y = adjusted_y;
+
+    return key;
+}
 
-    if (!is_chan(from_type) && !is_chan(to_type)) {
-        //Alternate formulation for non-channel types
-        int from_x = 0;
-        int from_y = 0;
-        adjust_rr_position(from_node, from_x, from_y);
+/* returns the absolute delta_x and delta_y offset required to reach to_node from from_node */
+static void get_xy_deltas(const RRNodeId from_node, const RRNodeId to_node, int* delta_x, int* delta_y) {
+    get_xy_deltas(make_node_key(from_node), make_node_key(to_node), delta_x, delta_y);
+}
 
-        int to_x = 0;
-        int to_y = 0;
-        adjust_rr_position(to_node, to_x, to_y);
+static void get_xy_deltas(const t_map_lookahead_node_key& from_key, const t_map_lookahead_node_key& to_key, int* delta_x, int* delta_y) {
+    e_rr_type from_type = e_rr_type(from_key.type);
+    e_rr_type to_type = e_rr_type(to_key.type);
 
-        *delta_x = to_x - from_x;
-        *delta_y = to_y - from_y;
+    if (!is_chan(from_type) && !is_chan(to_type)) {
+        //Alternate formulation for non-channel types
+        *delta_x = to_key.adjusted_x - from_key.adjusted_x;
+        *delta_y = to_key.adjusted_y - from_key.adjusted_y;
     } else {
         //Traditional formulation
 
@@ -1167,17 +1479,17 @@ static void get_xy_deltas(const RRNodeId from_node, const RRNodeId to_node, int*
         int to_seg;
         int to_chan;
         if (from_type == CHANY) {
-            from_seg_low = rr_graph.node_ylow(from_node);
-            from_seg_high = rr_graph.node_yhigh(from_node);
-            from_chan = rr_graph.node_xlow(from_node);
-            to_seg = rr_graph.node_ylow(to_node);
-            to_chan = rr_graph.node_xlow(to_node);
+            from_seg_low = from_key.ylow;
+            from_seg_high = from_key.yhigh;
+            from_chan = from_key.xlow;
+            to_seg = to_key.ylow;
+            to_chan = to_key.xlow;
         } else {
-            from_seg_low = rr_graph.node_xlow(from_node);
-            from_seg_high = rr_graph.node_xhigh(from_node);
-            from_chan = rr_graph.node_ylow(from_node);
-            to_seg = rr_graph.node_xlow(to_node);
-            to_chan = rr_graph.node_ylow(to_node);
+            from_seg_low = from_key.xlow;
+            from_seg_high = from_key.xhigh;
+            from_chan = from_key.ylow;
+            to_seg = to_key.xlow;
+            to_chan = to_key.ylow;
         }
 
         /* now we want to count the minimum number of *channel segments* between the from and to nodes */
@@ -1213,7 +1525,7 @@ static void get_xy_deltas(const RRNodeId from_node, const RRNodeId to_node, int*
 
         /* account for wire direction. lookahead map was computed by looking up and to the right starting at INC wires. for targets
          * that are opposite of the wire direction, let's add 1 to delta_seg */
-        Direction from_dir = rr_graph.node_direction(from_node);
+        Direction from_dir = from_key.direction;
         if (is_chan(from_type)
             && ((to_seg < from_seg_low && from_dir == Direction::INC) || (to_seg > from_seg_high && from_dir == Direction::DEC))) {
             delta_seg++;
@@ -1228,8 +1540,8 @@ static void get_xy_deltas(const RRNodeId from_node, const RRNodeId to_node, int*
         }
     }
 
-    VTR_ASSERT_SAFE(std::abs(*delta_x) < (int)device_ctx.grid.width());
-    VTR_ASSERT_SAFE(std::abs(*delta_y) < (int)device_ctx.grid.height());
+    VTR_ASSERT_SAFE(std::abs(*delta_x) < (int)g_vpr_ctx.device().grid.width());
+    VTR_ASSERT_SAFE(std::abs(*delta_y) < (int)g_vpr_ctx.device().grid.height());
 }
 
 static void adjust_rr_position(const RRNodeId rr, int& x, int& y) {
@@ -1387,69 +1699,93 @@ static void print_router_cost_map(const t_routing_cost_map& router_cost_map) {
     }
 }
 
-static void compute_tiles_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
-                                    std::unordered_map<int, std::unordered_map<int, util::Cost_Entry>>& tile_min_cost,
+static void compute_tiles_lookahead(std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
+                                    std::vector<std::vector<util::Cost_Entry>>& tile_min_cost,
                                     const t_det_routing_arch& det_routing_arch,
                                     const DeviceContext& device_ctx) {
     const auto& tiles = device_ctx.physical_tile_types;
+    int layer = 0;
+    int x = 1;
+    int y = 1;
 
+    std::vector<t_physical_tile_type_ptr> physical_tiles;
     for (const auto& tile : tiles) {
         if (is_empty_type(&tile)) {
             continue;
         }
+        physical_tiles.push_back(&tile);
+    }
+
+    //Building a tile's rr graph may add entries to the (shared) device_ctx.rr_rc_data,
+    //so the tile graphs are built serially. The searches from the tile pins, which are the
+    //bulk of the work, only read their own tile graph and are run in parallel across tile types.
+    std::vector<RRGraphBuilder> tile_rr_graph_builders(physical_tiles.size());
+    for (size_t itile = 0; itile < physical_tiles.size(); ++itile) {
+        build_tile_rr_graph(tile_rr_graph_builders[itile],
+                            det_routing_arch,
+                            physical_tiles[itile],
+                            layer,
+                            x,
+                            y,
+                            device_ctx.delayless_switch_idx);
+    }
+
+    std::vector<util::t_ipin_primitive_sink_delays> tile_pin_delays(physical_tiles.size());
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for(size_t(0), physical_tiles.size(), [&](size_t itile) {
+#else
+    for (size_t itile = 0; itile < physical_tiles.size(); ++itile) {
+#endif
+        tile_pin_delays[itile] = compute_tile_lookahead(tile_rr_graph_builders[itile],
+                                                        physical_tiles[itile],
+                                                        layer,
+                                                        x,
+                                                        y);
+        tile_rr_graph_builders[itile].clear();
+#if defined(VPR_USE_TBB)
+    });
+#else
+    }
+#endif
+
+    inter_tile_pin_primitive_pin_delay.resize(tiles.size());
+    tile_min_cost.resize(tiles.size());
+    for (size_t itile = 0; itile < physical_tiles.size(); ++itile) {
+        inter_tile_pin_primitive_pin_delay[physical_tiles[itile]->index] = std::move(tile_pin_delays[itile]);
 
-        compute_tile_lookahead(inter_tile_pin_primitive_pin_delay,
-                               &tile,
-                               det_routing_arch,
-                               device_ctx.delayless_switch_idx);
         store_min_cost_to_sinks(tile_min_cost,
-                                &tile,
+                                physical_tiles[itile],
                                 inter_tile_pin_primitive_pin_delay);
     }
 }
 
-static void compute_tile_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
-                                   t_physical_tile_type_ptr physical_tile,
-                                   const t_det_routing_arch& det_routing_arch,
-                                   const int delayless_switch) {
-    RRGraphBuilder rr_graph_builder;
-    int layer = 0;
-    int x = 1;
-    int y = 1;
-    build_tile_rr_graph(rr_graph_builder,
-                        det_routing_arch,
-                        physical_tile,
-                        layer,
-                        x,
-                        y,
-                        delayless_switch);
-
-    RRGraphView rr_graph{rr_graph_builder.rr_nodes(),
-                         rr_graph_builder.node_lookup(),
-                         rr_graph_builder.rr_node_metadata(),
-                         rr_graph_builder.rr_edge_metadata(),
+static util::t_ipin_primitive_sink_delays compute_tile_lookahead(RRGraphBuilder& tile_rr_graph_builder,
+                                                                  t_physical_tile_type_ptr physical_tile,
+                                                                  int layer,
+                                                                  int x,
+                                                                  int y) {
+    RRGraphView rr_graph{tile_rr_graph_builder.rr_nodes(),
+                         tile_rr_graph_builder.node_lookup(),
+                         tile_rr_graph_builder.rr_node_metadata(),
+                         tile_rr_graph_builder.rr_edge_metadata(),
                          g_vpr_ctx.device().rr_indexed_data,
                          g_vpr_ctx.device().rr_rc_data,
-                         rr_graph_builder.rr_segments(),
-                         rr_graph_builder.rr_switch()};
-
-    util::t_ipin_primitive_sink_delays pin_delays = util::compute_intra_tile_dijkstra(rr_graph,
-                                                                                      physical_tile,
-                                                                                      layer,
-                                                                                      x,
-                                                                                      y);
-
-    auto insert_res = inter_tile_pin_primitive_pin_delay.insert(std::make_pair(physical_tile->index, pin_delays));
-    VTR_ASSERT(insert_res.second);
-
-    rr_graph_builder.clear();
+                         tile_rr_graph_builder.rr_segments(),
+                         tile_rr_graph_builder.rr_switch()};
+
+    return util::compute_intra_tile_dijkstra(rr_graph,
+                                             physical_tile,
+                                             layer,
+                                             x,
+                                             y);
 }
 
-static void store_min_cost_to_sinks(std::unordered_map<int, std::unordered_map<int, util::Cost_Entry>>& tile_min_cost,
+static void store_min_cost_to_sinks(std::vector<std::vector<util::Cost_Entry>>& tile_min_cost,
                                     t_physical_tile_type_ptr physical_tile,
-                                    const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay) {
-    const auto& tile_pin_delays = inter_tile_pin_primitive_pin_delay.at(physical_tile->index);
-    std::unordered_map<int, util::Cost_Entry> min_cost_map;
+                                    const std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay) {
+    const auto& tile_pin_delays = inter_tile_pin_primitive_pin_delay[physical_tile->index];
+    std::vector<util::Cost_Entry>& min_costs = tile_min_cost[physical_tile->index];
+    min_costs.assign(get_tile_class_max_ptc(physical_tile, true), util::Cost_Entry());
     for (auto& primitive_sink_pair : physical_tile->primitive_class_inf) {
         int primitive_sink = primitive_sink_pair.first;
         auto min_cost = util::Cost_Entry(std::numeric_limits<float>::max() / 1e12,
@@ -1459,20 +1795,13 @@ static void store_min_cost_to_sinks(std::unordered_map<int, std::unordered_map<i
             if (get_pin_type_from_pin_physical_num(physical_tile, pin_physical_num) != e_pin_type::RECEIVER) {
                 continue;
             }
-            const auto& pin_delays = tile_pin_delays[pin_physical_num];
-            if (pin_delays.find(primitive_sink) != pin_delays.end()) {
-                auto pin_cost = pin_delays.at(primitive_sink);
-                if (pin_cost.delay < min_cost.delay) {
-                    min_cost = pin_cost;
-                }
+            const util::Cost_Entry& pin_cost = tile_pin_delays[pin_physical_num][primitive_sink];
+            if (pin_cost.valid() && pin_cost.delay < min_cost.delay) {
+                min_cost = pin_cost;
             }
         }
-        auto insert_res = min_cost_map.insert(std::make_pair(primitive_sink, min_cost));
-        VTR_ASSERT(insert_res.second);
+        min_costs[primitive_sink] = min_cost;
     }
-
-    auto insert_res = tile_min_cost.insert(std::make_pair(physical_tile->index, min_cost_map));
-    VTR_ASSERT(insert_res.second);
 }
 
 static void min_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 3>& internal_opin_global_cost_map) {
@@ -1487,10 +1816,10 @@ static void min_global_cost_map(vtr::NdMatrix<util::Cost_Entry, 3>& internal_opi
         for (int dx = 0; dx < width; dx++) {
             for (int dy = 0; dy < height; dy++) {
                 util::Cost_Entry min_cost(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-                for (int chan_idx = 0; chan_idx < (int)f_wire_cost_map.dim_size(1); chan_idx++) {
-                    for (int seg_idx = 0; seg_idx < (int)f_wire_cost_map.dim_size(2); seg_idx++) {
-                        auto cost = util::Cost_Entry(f_wire_cost_map[layer_num][chan_idx][seg_idx][dx][dy].delay,
-                                                     f_wire_cost_map[layer_num][chan_idx][seg_idx][dx][dy].congestion);
+                for (int chan_idx = 0; chan_idx < (int)wire_cost_map_dim_size(1); chan_idx++) {
+                    for (int seg_idx = 0; seg_idx < (int)wire_cost_map_dim_size(2); seg_idx++) {
+                        Cost_Entry wire_cost = wire_cost_map_entry(layer_num, chan_idx, seg_idx, dx, dy);
+                        auto cost = util::Cost_Entry(wire_cost.delay, wire_cost.congestion);
                         if (cost.delay < min_cost.delay) {
                             min_cost.delay = cost.delay;
                             min_cost.congestion = cost.congestion;
@@ -1522,13 +1851,13 @@ void DeltaDelayModel::write(const std::string& /*file*/) const {
     VPR_THROW(VPR_ERROR_PLACE, "MapLookahead::write " DISABLE_ERROR);
 }
 
-static void read_intra_cluster_router_lookahead(std::unordered_map<t_physical_tile_type_ptr, util::t_ipin_primitive_sink_delays>& /*inter_tile_pin_primitive_pin_delay*/,
+static void read_intra_cluster_router_lookahead(std::vector<util::t_ipin_primitive_sink_delays>& /*inter_tile_pin_primitive_pin_delay*/,
                                                 const std::string& /*file*/) {
     VPR_THROW(VPR_ERROR_PLACE, "MapLookahead::read_intra_cluster_router_lookahead " DISABLE_ERROR);
 }
 
 static void write_intra_cluster_router_lookahead(const std::string& /*file*/,
-                                                 const std::unordered_map<t_physical_tile_type_ptr, util::t_ipin_primitive_sink_delays>& /*inter_tile_pin_primitive_pin_delay*/) {
+                                                 const std::vector<util::t_ipin_primitive_sink_delays>& /*inter_tile_pin_primitive_pin_delay*/) {
     VPR_THROW(VPR_ERROR_PLACE, "MapLookahead::write_intra_cluster_router_lookahead " DISABLE_ERROR);
 }
 
@@ -1556,45 +1885,7 @@ static void fromIntEntry(::capnp::List<int64_t, ::capnp::Kind::PRIMITIVE>::Build
     out.set(idx, cost);
 }
 
-static void toPairEntry(std::unordered_map<int, util::Cost_Entry>& map_out,
-                        const int& key,
-                        const VprMapCostEntry::Reader& cap_cost) {
-    VTR_ASSERT(map_out.find(key) == map_out.end());
-    util::Cost_Entry cost(cap_cost.getDelay(), cap_cost.getCongestion());
-    map_out[key] = cost;
-}
-
-static void fromPairEntry(::capnp::List<int64_t, ::capnp::Kind::PRIMITIVE>::Builder& out_key,
-                          ::capnp::List<::VprMapCostEntry, ::capnp::Kind::STRUCT>::Builder& out_val,
-                          int flat_idx,
-                          const int& key,
-                          const util::Cost_Entry& cost) {
-    out_key.set(flat_idx, key);
-    out_val[flat_idx].setDelay(cost.delay);
-    out_val[flat_idx].setCongestion(cost.congestion);
-}
-
-static void getIntraClusterArrayFlatSize(int& num_tile_types,
-                                         int& num_pins,
-                                         int& num_sinks,
-                                         const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay) {
-    const auto& physical_tile_types = g_vpr_ctx.device().physical_tile_types;
-    num_tile_types = (int)physical_tile_types.size();
-
-    num_pins = 0;
-    for (const auto& tile_type : inter_tile_pin_primitive_pin_delay) {
-        num_pins += (int)tile_type.second.size();
-    }
-
-    num_sinks = 0;
-    for (const auto& tile_type : inter_tile_pin_primitive_pin_delay) {
-        for (const auto& pin_sink : tile_type.second) {
-            num_sinks += (int)pin_sink.size();
-        }
-    }
-}
-
-static void read_intra_cluster_router_lookahead(std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
+static void read_intra_cluster_router_lookahead(std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay,
                                                 const std::string& file) {
     MmapFile f(file);
 
@@ -1614,67 +1905,90 @@ static void read_intra_cluster_router_lookahead(std::unordered_map<int, util::t_
                            map.getPinNumSinks(),
                            toIntEntry);
 
-    int num_seen_pair = 0;
-    int num_seen_pin = 0;
+    const auto& physical_tile_types = g_vpr_ctx.device().physical_tile_types;
+    if (physical_tile_num_pin_arr.size() != physical_tile_types.size()) {
+        VPR_THROW(VPR_ERROR_ROUTE, "Intra cluster lookahead '%s' has %zu tile types, expected %zu\n",
+                  file.c_str(), physical_tile_num_pin_arr.size(), physical_tile_types.size());
+    }
+
+    auto pin_sinks = map.getPinSinks();
+    auto pin_sink_costs = map.getPinSinkCosts();
+
+    //The sinks of each pin are stored sparsely in the file, and expanded to the dense tile matrices
+    inter_tile_pin_primitive_pin_delay.clear();
+    inter_tile_pin_primitive_pin_delay.resize(physical_tile_types.size());
+    size_t num_seen_pair = 0;
+    size_t num_seen_pin = 0;
     for (int physical_tile_idx = 0; physical_tile_idx < (int)physical_tile_num_pin_arr.size(); physical_tile_idx++) {
+        t_physical_tile_type_ptr physical_tile = &physical_tile_types[physical_tile_idx];
         int num_pins = physical_tile_num_pin_arr[physical_tile_idx];
-        util::t_ipin_primitive_sink_delays tile_pin_sink_cost_map(num_pins);
+        int max_ptc_num = get_tile_pin_max_ptc(physical_tile, true);
+        int max_class_ptc_num = get_tile_class_max_ptc(physical_tile, true);
+        if (num_pins > max_ptc_num) {
+            VPR_THROW(VPR_ERROR_ROUTE, "Intra cluster lookahead '%s' does not match the pins of tile %s\n",
+                      file.c_str(), physical_tile->name);
+        }
+
+        util::t_ipin_primitive_sink_delays& tile_pin_sink_costs = inter_tile_pin_primitive_pin_delay[physical_tile_idx];
+        if (is_empty_type(physical_tile)) {
+            VTR_ASSERT(num_pins == 0);
+        } else {
+            tile_pin_sink_costs.resize({size_t(max_ptc_num), size_t(max_class_ptc_num)});
+        }
 
         for (int pin_num = 0; pin_num < num_pins; pin_num++) {
-            std::unordered_map<int, util::Cost_Entry> pin_sink_cost_map;
-            toUnorderedMap<int64_t, VprMapCostEntry, int, util::Cost_Entry>(pin_sink_cost_map,
-                                                                            num_seen_pair,
-                                                                            num_seen_pair + pin_num_sink_arr[num_seen_pin],
-                                                                            map.getPinSinks(),
-                                                                            map.getPinSinkCosts(),
-                                                                            toPairEntry);
-            tile_pin_sink_cost_map[pin_num] = pin_sink_cost_map;
-            num_seen_pair += (int)pin_sink_cost_map.size();
-            VTR_ASSERT((int)pin_sink_cost_map.size() == pin_num_sink_arr[num_seen_pin]);
+            VTR_ASSERT(num_seen_pin < pin_num_sink_arr.size());
+            size_t num_pin_sinks = pin_num_sink_arr[num_seen_pin];
+            VTR_ASSERT(num_seen_pair + num_pin_sinks <= pin_sinks.size());
+            for (size_t isink = num_seen_pair; isink < num_seen_pair + num_pin_sinks; isink++) {
+                int sink_ptc = pin_sinks[isink];
+                if (sink_ptc < 0 || sink_ptc >= max_class_ptc_num) {
+                    VPR_THROW(VPR_ERROR_ROUTE, "Intra cluster lookahead '%s' does not match the classes of tile %s\n",
+                              file.c_str(), physical_tile->name);
+                }
+                util::Cost_Entry& cost = tile_pin_sink_costs[pin_num][sink_ptc];
+                VTR_ASSERT(!cost.valid());
+                cost = util::Cost_Entry(pin_sink_costs[isink].getDelay(), pin_sink_costs[isink].getCongestion());
+            }
+            num_seen_pair += num_pin_sinks;
             ++num_seen_pin;
         }
-        inter_tile_pin_primitive_pin_delay[physical_tile_idx] = tile_pin_sink_cost_map;
     }
 }
 
 static void write_intra_cluster_router_lookahead(const std::string& file,
-                                                 const std::unordered_map<int, util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay) {
+                                                 const std::vector<util::t_ipin_primitive_sink_delays>& inter_tile_pin_primitive_pin_delay) {
     ::capnp::MallocMessageBuilder builder;
 
     auto vpr_intra_cluster_lookahead_builder = builder.initRoot<VprIntraClusterLookahead>();
 
-    int num_tile_types, num_pins, num_sinks;
-    getIntraClusterArrayFlatSize(num_tile_types,
-                                 num_pins,
-                                 num_sinks,
-                                 inter_tile_pin_primitive_pin_delay);
-
+    //Only the reachable sinks of each pin are written, in increasing sink order
+    int num_tile_types = (int)g_vpr_ctx.device().physical_tile_types.size();
     std::vector<int> physical_tile_num_pin_arr(num_tile_types, 0);
-    {
-        for (const auto& physical_type : inter_tile_pin_primitive_pin_delay) {
-            int physical_type_idx = physical_type.first;
-            physical_tile_num_pin_arr[physical_type_idx] = (int)physical_type.second.size();
+    std::vector<int> pin_num_sink_arr;
+    size_t num_sinks = 0;
+    for (int physical_tile_idx = 0; physical_tile_idx < (int)inter_tile_pin_primitive_pin_delay.size(); ++physical_tile_idx) {
+        const util::t_ipin_primitive_sink_delays& tile_pin_sink_costs = inter_tile_pin_primitive_pin_delay[physical_tile_idx];
+        physical_tile_num_pin_arr[physical_tile_idx] = (int)tile_pin_sink_costs.dim_size(0);
+        for (size_t pin_num = 0; pin_num < tile_pin_sink_costs.dim_size(0); ++pin_num) {
+            int num_pin_sinks = 0;
+            for (size_t sink_ptc = 0; sink_ptc < tile_pin_sink_costs.dim_size(1); ++sink_ptc) {
+                num_pin_sinks += tile_pin_sink_costs[pin_num][sink_ptc].valid();
+            }
+            pin_num_sink_arr.push_back(num_pin_sinks);
+            num_sinks += num_pin_sinks;
         }
+    }
 
+    {
         ::capnp::List<int64_t>::Builder physical_tile_num_pin_arr_builder = vpr_intra_cluster_lookahead_builder.initPhysicalTileNumPins(num_tile_types);
         fromVector<int64_t, int>(physical_tile_num_pin_arr_builder,
                                  physical_tile_num_pin_arr,
                                  fromIntEntry);
     }
 
-    std::vector<int> pin_num_sink_arr(num_pins, 0);
     {
-        int num_seen_pin = 0;
-        for (int physical_tile_idx = 0; physical_tile_idx < num_tile_types; ++physical_tile_idx) {
-            if (inter_tile_pin_primitive_pin_delay.find(physical_tile_idx) == inter_tile_pin_primitive_pin_delay.end()) {
-                continue;
-            }
-            for (const auto& pin_sinks : inter_tile_pin_primitive_pin_delay.at(physical_tile_idx)) {
-                pin_num_sink_arr[num_seen_pin] = (int)pin_sinks.size();
-                ++num_seen_pin;
-            }
-        }
-        ::capnp::List<int64_t>::Builder pin_num_sink_arr_builder = vpr_intra_cluster_lookahead_builder.initPinNumSinks(num_pins);
+        ::capnp::List<int64_t>::Builder pin_num_sink_arr_builder = vpr_intra_cluster_lookahead_builder.initPinNumSinks(pin_num_sink_arr.size());
         fromVector<int64_t, int>(pin_num_sink_arr_builder,
                                  pin_num_sink_arr,
                                  fromIntEntry);
@@ -1684,19 +1998,21 @@ static void write_intra_cluster_router_lookahead(const std::string& file,
         ::capnp::List<int64_t>::Builder pin_sink_arr_builder = vpr_intra_cluster_lookahead_builder.initPinSinks(num_sinks);
         ::capnp::List<VprMapCostEntry>::Builder pin_sink_cost_builder = vpr_intra_cluster_lookahead_builder.initPinSinkCosts(num_sinks);
 
-        int num_seen_pin = 0;
-        for (int physical_tile_idx = 0; physical_tile_idx < num_tile_types; ++physical_tile_idx) {
-            for (int pin_num = 0; pin_num < physical_tile_num_pin_arr[physical_tile_idx]; ++pin_num) {
-                const std::unordered_map<int, util::Cost_Entry>& pin_sinks = inter_tile_pin_primitive_pin_delay.at(physical_tile_idx).at(pin_num);
-                FromUnorderedMap<int64_t, VprMapCostEntry, int, util::Cost_Entry>(
-                    pin_sink_arr_builder,
-                    pin_sink_cost_builder,
-                    num_seen_pin,
-                    pin_sinks,
-                    fromPairEntry);
-                num_seen_pin += (int)pin_sinks.size();
+        size_t num_seen_pair = 0;
+        for (const util::t_ipin_primitive_sink_delays& tile_pin_sink_costs : inter_tile_pin_primitive_pin_delay) {
+            for (size_t pin_num = 0; pin_num < tile_pin_sink_costs.dim_size(0); ++pin_num) {
+                for (size_t sink_ptc = 0; sink_ptc < tile_pin_sink_costs.dim_size(1); ++sink_ptc) {
+                    const util::Cost_Entry& cost = tile_pin_sink_costs[pin_num][sink_ptc];
+                    if (!cost.valid()) continue;
+
+                    pin_sink_arr_builder.set(num_seen_pair, sink_ptc);
+                    pin_sink_cost_builder[num_seen_pair].setDelay(cost.delay);
+                    pin_sink_cost_builder[num_seen_pair].setCongestion(cost.congestion);
+                    ++num_seen_pair;
+                }
             }
         }
+        VTR_ASSERT(num_seen_pair == num_sinks);
     }
 
     writeMessageToFile(file, &builder);
@@ -1720,8 +2036,31 @@ void write_router_lookahead(const std::string& file) {
 
     auto map = builder.initRoot<VprMapLookahead>();
 
+    //The file holds every layer at full precision: expand the shared layers of a
+    //lookahead (and the precision a compacted one kept)
+    t_wire_cost_map expanded_wire_cost_map;
+    bool is_expanded = !f_half_wire_cost_map.empty() || f_wire_cost_map.dim_size(0) != f_wire_cost_map_layer_slices.size();
+    if (is_expanded) {
+        expanded_wire_cost_map.resize({wire_cost_map_dim_size(0),
+                                       wire_cost_map_dim_size(1),
+                                       wire_cost_map_dim_size(2),
+                                       wire_cost_map_dim_size(3),
+                                       wire_cost_map_dim_size(4)});
+        for (size_t layer_num = 0; layer_num < expanded_wire_cost_map.dim_size(0); layer_num++) {
+            for (size_t chan_index = 0; chan_index < expanded_wire_cost_map.dim_size(1); chan_index++) {
+                for (size_t seg_index = 0; seg_index < expanded_wire_cost_map.dim_size(2); seg_index++) {
+                    for (size_t dx = 0; dx < expanded_wire_cost_map.dim_size(3); dx++) {
+                        for (size_t dy = 0; dy < expanded_wire_cost_map.dim_size(4); dy++) {
+                            expanded_wire_cost_map[layer_num][chan_index][seg_index][dx][dy] = wire_cost_map_entry(layer_num, chan_index, seg_index, dx, dy);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     auto cost_map = map.initCostMap();
-    FromNdMatrix<5, VprMapCostEntry, Cost_Entry>(&cost_map, f_wire_cost_map, FromCostEntry);
+    FromNdMatrix<5, VprMapCostEntry, Cost_Entry>(&cost_map, is_expanded ? expanded_wire_cost_map : f_wire_cost_map, FromCostEntry);
 
     writeMessageToFile(file, &builder);
 }
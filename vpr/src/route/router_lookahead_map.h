@@ -3,9 +3,26 @@
 #include <string>
 #include <limits>
 #include "vtr_ndmatrix.h"
+#include "vtr_vector.h"
 #include "router_lookahead.h"
 #include "router_lookahead_map_utils.h"
 
+/* The attributes of an rr node which the map lookahead reads to estimate the cost to or from it,
+ * packed together so that a query reads a single entry per node */
+struct t_map_lookahead_node_key {
+    int16_t xlow;
+    int16_t ylow;
+    int16_t xhigh;
+    int16_t yhigh;
+    int16_t adjusted_x; //Position of the node used for the distance between pins/sources/sinks, see adjust_rr_position()
+    int16_t adjusted_y;
+    int16_t seg_index;  //Segment type index of CHANX/CHANY nodes
+    int16_t tile_index; //Physical tile type at (xlow, ylow)
+    uint8_t layer;
+    uint8_t type; //t_rr_type
+    Direction direction;
+};
+
 class MapLookahead : public RouterLookahead {
   public:
     explicit MapLookahead(const t_det_routing_arch& det_routing_arch, bool is_flat)
@@ -16,13 +33,21 @@ class MapLookahead : public RouterLookahead {
     //Look-up table from SOURCE/OPIN to CHANX/CHANY of various types
     util::t_src_opin_delays src_opin_delays;
     // Lookup table from a tile pins to the primitive classes inside that tile
-    std::unordered_map<int, util::t_ipin_primitive_sink_delays> inter_tile_pin_primitive_pin_delay; // [physical_tile_type][from_pin_physical_num][sink_physical_num] -> cost
+    std::vector<util::t_ipin_primitive_sink_delays> inter_tile_pin_primitive_pin_delay; // [physical_tile_type][from_pin_physical_num][sink_physical_num] -> cost
     // Lookup table to store the minimum cost to reach to a primitive pin from the root-level IPINs
-    std::unordered_map<int, std::unordered_map<int, util::Cost_Entry>> tile_min_cost; // [physical_tile_type][sink_physical_num] -> cost
+    std::vector<std::vector<util::Cost_Entry>> tile_min_cost; // [physical_tile_type][sink_physical_num] -> cost
     // Lookup table to store the minimum cost for each dx and dy
     vtr::NdMatrix<util::Cost_Entry, 3> distance_based_min_cost; // [layer_num][dx][dy] -> cost
     const t_det_routing_arch& det_routing_arch_;
     bool is_flat_;
+    // Lookahead keys of the nodes of the current rr graph, empty until load_rr_graph_data()
+    vtr::vector<RRNodeId, t_map_lookahead_node_key> node_keys_;
+
+    t_map_lookahead_node_key node_key(RRNodeId node) const;
+    std::pair<float, float> get_expected_delay_and_cong(RRNodeId from_node,
+                                                        const t_map_lookahead_node_key& from_key,
+                                                        const t_map_lookahead_node_key& to_key,
+                                                        const t_conn_cost_params& params) const;
 
   protected:
     float get_expected_cost(RRNodeId node, RRNodeId target_node, const t_conn_cost_params& params, float R_upstream) const override;
@@ -34,6 +59,17 @@ class MapLookahead : public RouterLookahead {
     void read_intra_cluster(const std::string& file) override;
     void write(const std::string& file) const override;
     void write_intra_cluster(const std::string& file) const override;
+
+    bool get_wire_cost_entry_index(RRNodeId node, RRNodeId target_node, t_wire_cost_entry_index& index) const override;
+    void raise_wire_cost_entry_delay(const t_wire_cost_entry_index& index, float delay) override;
+
+    void compact() override;
+
+    void load_rr_graph_data() override;
+    void clear_rr_graph_data() override;
+
+  public:
+    size_t memory_usage() const override;
 };
 
 /* f_cost_map is an array of these cost entries that specifies delay/congestion estimates
@@ -59,5 +95,13 @@ class Cost_Entry {
 typedef vtr::NdMatrix<Cost_Entry, 5> t_wire_cost_map; //[0..num_layers][0..1][[0..num_seg_types-1]0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
                                                       //[0..1] entry distinguish between CHANX/CHANY start nodes respectively
 
+/* a Cost_Entry stored as (scaled) half precision values, see MapLookahead::compact() */
+struct t_half_cost_entry {
+    uint16_t delay;
+    uint16_t congestion;
+};
+
+typedef vtr::NdMatrix<t_half_cost_entry, 5> t_half_wire_cost_map; //Same dimensions as t_wire_cost_map
+
 void read_router_lookahead(const std::string& file);
 void write_router_lookahead(const std::string& file);
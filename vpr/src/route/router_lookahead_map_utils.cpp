@@ -19,6 +19,11 @@
 #include "route_common.h"
 #include "route_timing.h"
 
+#if defined(VPR_USE_TBB)
+#    include <tbb/parallel_for_each.h>
+#endif
+
+static void compute_tile_src_opin_lookahead(int layer_num, size_t itile, bool is_flat, util::t_src_opin_delays& src_opin_delays);
 static void dijkstra_flood_to_wires(int itile, RRNodeId inode, util::t_src_opin_delays& src_opin_delays);
 static void dijkstra_flood_to_ipins(RRNodeId node, util::t_chan_ipins_delays& chan_ipins_delays);
 
@@ -308,7 +313,6 @@ template void expand_dijkstra_neighbours(const RRGraphView& rr_graph,
 t_src_opin_delays compute_router_src_opin_lookahead(bool is_flat) {
     vtr::ScopedStartFinishTimer timer("Computing src/opin lookahead");
     auto& device_ctx = g_vpr_ctx.device();
-    auto& rr_graph = device_ctx.rr_graph;
 
     t_src_opin_delays src_opin_delays;
 
@@ -318,71 +322,29 @@ t_src_opin_delays compute_router_src_opin_lookahead(bool is_flat) {
     }
 
     //We assume that the routing connectivity of each instance of a physical tile is the same,
-    //and so only measure one instance of each type
+    //and so only measure one instance of each type.
+    //
+    //Each (layer, tile type) only writes its own src_opin_delays[layer][tile], so they are
+    //profiled in parallel. On 3D devices this covers the layers at once.
+    std::vector<std::pair<int, size_t>> layer_tiles;
     for (int layer_num = 0; layer_num < device_ctx.grid.get_num_layers(); layer_num++) {
         for (size_t itile = 0; itile < device_ctx.physical_tile_types.size(); ++itile) {
-            if (device_ctx.grid.num_instances(&device_ctx.physical_tile_types[itile], layer_num) == 0) {
-                continue;
-            }
-            for (e_rr_type rr_type : {SOURCE, OPIN}) {
-                t_physical_tile_loc sample_loc(OPEN, OPEN, OPEN);
-
-                size_t num_sampled_locs = 0;
-                bool ptcs_with_no_delays = true;
-                while (ptcs_with_no_delays) { //Haven't found wire connected to ptc
-                    ptcs_with_no_delays = false;
-
-                    sample_loc = pick_sample_tile(layer_num, &device_ctx.physical_tile_types[itile], sample_loc);
-
-                    if (sample_loc.x == OPEN && sample_loc.y == OPEN && sample_loc.layer_num == OPEN) {
-                        //No untried instances of the current tile type left
-                        VTR_LOG_WARN("Found no %ssample locations for %s in %s\n",
-                                     (num_sampled_locs == 0) ? "" : "more ",
-                                     rr_node_typename[rr_type],
-                                     device_ctx.physical_tile_types[itile].name);
-                        break;
-                    }
-
-                    //VTR_LOG("Sampling %s at (%d,%d)\n", device_ctx.physical_tile_types[itile].name, sample_loc.x(), sample_loc.y());
-                    const std::vector<RRNodeId>& rr_nodes_at_loc = device_ctx.rr_graph.node_lookup().find_grid_nodes_at_all_sides(sample_loc.layer_num, sample_loc.x, sample_loc.y, rr_type);
-                    for (RRNodeId node_id : rr_nodes_at_loc) {
-                        int ptc = rr_graph.node_ptc_num(node_id);
-                        // For the time being, we decide to not let the lookahead explore the node inside the clusters
-                        if (!is_inter_cluster_node(&device_ctx.physical_tile_types[itile],
-                                                   rr_type,
-                                                   ptc)) {
-                            continue;
-                        }
-
-                        if (ptc >= int(src_opin_delays[layer_num][itile].size())) {
-                            src_opin_delays[layer_num][itile].resize(ptc + 1); //Inefficient but functional...
-                        }
-
-                        //Find the wire types which are reachable from inode and record them and
-                        //the cost to reach them
-                        dijkstra_flood_to_wires(itile, node_id, src_opin_delays);
-
-                        if (src_opin_delays[layer_num][itile][ptc].empty()) {
-                            VTR_LOGV_DEBUG(f_router_debug, "Found no reachable wires from %s (%s) at (%d,%d)\n",
-                                           rr_node_typename[rr_type],
-                                           rr_node_arch_name(node_id, is_flat).c_str(),
-                                           sample_loc.x,
-                                           sample_loc.y,
-                                           is_flat);
-
-                            ptcs_with_no_delays = true;
-                        }
-                    }
-
-                    ++num_sampled_locs;
-                }
-                if (ptcs_with_no_delays) {
-                    VPR_ERROR(VPR_ERROR_ROUTE, "Some SOURCE/OPINs have no reachable wires\n");
-                }
+            if (device_ctx.grid.num_instances(&device_ctx.physical_tile_types[itile], layer_num) != 0) {
+                layer_tiles.emplace_back(layer_num, itile);
             }
         }
     }
 
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for_each(layer_tiles, [&](const std::pair<int, size_t>& layer_tile) {
+        compute_tile_src_opin_lookahead(layer_tile.first, layer_tile.second, is_flat, src_opin_delays);
+    });
+#else
+    for (const std::pair<int, size_t>& layer_tile : layer_tiles) {
+        compute_tile_src_opin_lookahead(layer_tile.first, layer_tile.second, is_flat, src_opin_delays);
+    }
+#endif
+
     return src_opin_delays;
 }
 
@@ -424,7 +386,10 @@ t_chan_ipins_delays compute_router_chan_ipin_lookahead() {
             for (int ix = min_x; ix < max_x; ix++) {
                 for (int iy = min_y; iy < max_y; iy++) {
                     for (auto rr_type : {CHANX, CHANY}) {
-                        for (const RRNodeId& node_id : node_lookup.find_channel_nodes(sample_loc.layer_num, ix, iy, rr_type)) {
+                        for (RRNodeId node_id : node_lookup.channel_nodes(sample_loc.layer_num, ix, iy, rr_type)) {
+                            if (!node_id) {
+                                continue;
+                            }
                             //Find the IPINs which are reachable from the wires within the bounding box
                             //around the selected tile location
                             dijkstra_flood_to_ipins(node_id, chan_ipins_delays);
@@ -445,11 +410,12 @@ t_ipin_primitive_sink_delays compute_intra_tile_dijkstra(const RRGraphView& rr_g
                                                          int y) {
     auto tile_pins_vec = get_flat_tile_pins(physical_tile);
     int max_ptc_num = get_tile_pin_max_ptc(physical_tile, true);
+    int max_class_ptc_num = get_tile_class_max_ptc(physical_tile, true);
 
-    t_ipin_primitive_sink_delays pin_delays;
-    pin_delays.resize(max_ptc_num);
+    t_ipin_primitive_sink_delays pin_delays({size_t(max_ptc_num), size_t(max_class_ptc_num)});
 
-    for (int pin_physical_num : tile_pins_vec) {
+    //Each search only writes the row of its starting pin, so the pins are searched in parallel
+    auto search_from_pin = [&](int pin_physical_num) {
         RRNodeId pin_node_id = get_pin_rr_node_id(rr_graph.node_lookup(),
                                                   physical_tile,
                                                   layer,
@@ -459,13 +425,81 @@ t_ipin_primitive_sink_delays compute_intra_tile_dijkstra(const RRGraphView& rr_g
         VTR_ASSERT(pin_node_id != RRNodeId::INVALID());
 
         run_intra_tile_dijkstra(rr_graph, pin_delays, physical_tile, pin_node_id);
-    }
+    };
+#if defined(VPR_USE_TBB)
+    tbb::parallel_for_each(tile_pins_vec.begin(), tile_pins_vec.end(), search_from_pin);
+#else
+    std::for_each(tile_pins_vec.begin(), tile_pins_vec.end(), search_from_pin);
+#endif
 
     return pin_delays;
 }
 
 } // namespace util
 
+/* profiles the wires reachable from the SOURCEs and OPINs of a sample instance of tile itile on layer_num */
+static void compute_tile_src_opin_lookahead(int layer_num, size_t itile, bool is_flat, util::t_src_opin_delays& src_opin_delays) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& rr_graph = device_ctx.rr_graph;
+
+    for (e_rr_type rr_type : {SOURCE, OPIN}) {
+        t_physical_tile_loc sample_loc(OPEN, OPEN, OPEN);
+
+        size_t num_sampled_locs = 0;
+        bool ptcs_with_no_delays = true;
+        while (ptcs_with_no_delays) { //Haven't found wire connected to ptc
+            ptcs_with_no_delays = false;
+
+            sample_loc = pick_sample_tile(layer_num, &device_ctx.physical_tile_types[itile], sample_loc);
+
+            if (sample_loc.x == OPEN && sample_loc.y == OPEN && sample_loc.layer_num == OPEN) {
+                //No untried instances of the current tile type left
+                VTR_LOG_WARN("Found no %ssample locations for %s in %s\n",
+                             (num_sampled_locs == 0) ? "" : "more ",
+                             rr_node_typename[rr_type],
+                             device_ctx.physical_tile_types[itile].name);
+                break;
+            }
+
+            //VTR_LOG("Sampling %s at (%d,%d)\n", device_ctx.physical_tile_types[itile].name, sample_loc.x(), sample_loc.y());
+            const std::vector<RRNodeId>& rr_nodes_at_loc = device_ctx.rr_graph.node_lookup().find_grid_nodes_at_all_sides(sample_loc.layer_num, sample_loc.x, sample_loc.y, rr_type);
+            for (RRNodeId node_id : rr_nodes_at_loc) {
+                int ptc = rr_graph.node_ptc_num(node_id);
+                // For the time being, we decide to not let the lookahead explore the node inside the clusters
+                if (!is_inter_cluster_node(&device_ctx.physical_tile_types[itile],
+                                           rr_type,
+                                           ptc)) {
+                    continue;
+                }
+
+                if (ptc >= int(src_opin_delays[layer_num][itile].size())) {
+                    src_opin_delays[layer_num][itile].resize(ptc + 1); //Inefficient but functional...
+                }
+
+                //Find the wire types which are reachable from inode and record them and
+                //the cost to reach them
+                dijkstra_flood_to_wires(itile, node_id, src_opin_delays);
+
+                if (src_opin_delays[layer_num][itile][ptc].empty()) {
+                    VTR_LOGV_DEBUG(f_router_debug, "Found no reachable wires from %s (%s) at (%d,%d)\n",
+                                   rr_node_typename[rr_type],
+                                   rr_node_arch_name(node_id, is_flat).c_str(),
+                                   sample_loc.x,
+                                   sample_loc.y,
+                                   is_flat);
+
+                    ptcs_with_no_delays = true;
+                }
+            }
+
+            ++num_sampled_locs;
+        }
+        if (ptcs_with_no_delays) {
+            VPR_ERROR(VPR_ERROR_ROUTE, "Some SOURCE/OPINs have no reachable wires\n");
+        }
+    }
+}
+
 static void dijkstra_flood_to_wires(int itile, RRNodeId node, util::t_src_opin_delays& src_opin_delays) {
     auto& device_ctx = g_vpr_ctx.device();
     const auto& rr_graph = device_ctx.rr_graph;
@@ -765,7 +799,7 @@ static void run_intra_tile_dijkstra(const RRGraphView& rr_graph,
     root.node = starting_node_id;
 
     int root_ptc = rr_graph.node_ptc_num(root.node);
-    std::unordered_map<int, util::Cost_Entry>& starting_pin_delay_map = pin_delays.at(root_ptc);
+    auto starting_pin_delays = pin_delays[root_ptc];
     pq.push(root);
 
     while (!pq.empty()) {
@@ -799,8 +833,9 @@ static void run_intra_tile_dijkstra(const RRGraphView& rr_graph,
             }
         } else {
             int curr_ptc = rr_graph.node_ptc_num(curr.node);
-            if (starting_pin_delay_map.find(curr_ptc) == starting_pin_delay_map.end() || starting_pin_delay_map.at(curr_ptc).delay > curr.delay) {
-                starting_pin_delay_map[curr_ptc] = util::Cost_Entry(curr.delay, curr.congestion);
+            util::Cost_Entry& sink_delay = starting_pin_delays[curr_ptc];
+            if (!sink_delay.valid() || sink_delay.delay > curr.delay) {
+                sink_delay = util::Cost_Entry(curr.delay, curr.congestion);
             }
         }
     }
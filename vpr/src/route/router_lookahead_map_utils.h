@@ -22,6 +22,8 @@
 #include <unordered_map>
 #include "vpr_types.h"
 #include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
+#include "vtr_flat_hash_map.h"
 #include "rr_node.h"
 #include "rr_graph_view.h"
 
@@ -172,7 +174,7 @@ struct HashRoutingCostKey {
 };
 
 // Map used to store intermediate routing costs
-typedef std::unordered_map<RoutingCostKey, float, HashRoutingCostKey> RoutingCosts;
+typedef vtr::flat_hash_map<RoutingCostKey, float, HashRoutingCostKey> RoutingCosts;
 
 /* a class that represents an entry in the Dijkstra expansion priority queue */
 class PQ_Entry {
@@ -274,8 +276,11 @@ struct t_reachable_wire_inf {
 // as the lookahead expected cost.
 typedef std::vector<std::vector<std::vector<std::map<int, t_reachable_wire_inf>>>> t_src_opin_delays;
 
-//[from pin ptc num][target src ptc num]->cost
-typedef std::vector<std::unordered_map<int, Cost_Entry>> t_ipin_primitive_sink_delays;
+//[from pin ptc num][target sink ptc num]->cost
+//
+// Dense per-tile matrix over all the pins and classes of the tile (with flat routing); the
+// entries of the sinks which are not reachable from a pin are invalid Cost_Entry.
+typedef vtr::NdMatrix<Cost_Entry, 2> t_ipin_primitive_sink_delays;
 
 //[0..device_ctx.physical_tile_types.size()-1][0..max_ptc-1]
 // ^                                           ^
@@ -0,0 +1,232 @@
+#include "router_lookahead_profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#include "connection_router_interface.h"
+#include "globals.h"
+#include "route_tree.h"
+#include "router_lookahead.h"
+
+namespace router_lookahead_profiler {
+
+namespace {
+
+// Entries routed fewer times are not corrected: a few detours would make them pessimistic
+constexpr size_t MIN_CORRECTION_SAMPLES = 10;
+
+struct t_entry_stats {
+    size_t samples = 0;
+    double expected_delay_sum = 0.;
+    double actual_delay_sum = 0.;
+    float min_actual_delay = std::numeric_limits<float>::infinity();
+};
+
+// Statistics of the wire table entries, by pack_index()
+typedef std::unordered_map<uint64_t, t_entry_stats> t_entry_stats_map;
+
+struct t_profile {
+    const RouterLookahead* router_lookahead = nullptr;
+    float correction_threshold = 0.;
+    std::string write_lookahead;
+
+    // Statistics of the threads which profiled connections in the current session
+    std::mutex mutex;
+    std::vector<std::unique_ptr<t_entry_stats_map>> thread_stats;
+
+    // Statistics accumulated by the sessions writing to filename
+    std::string filename;
+    std::map<uint64_t, t_entry_stats> stats;
+};
+
+t_profile f_profile;
+bool f_enabled = false;
+
+// Identifies the session, so threads do not reuse the statistics of an earlier session
+size_t f_session = 0;
+
+thread_local t_entry_stats_map* tl_stats = nullptr;
+thread_local size_t tl_stats_session = 0;
+
+// Layers and wire types fit 8 bits, segment types and deltas 16 bits. Ordered like the wire table
+uint64_t pack_index(const t_wire_cost_entry_index& index) {
+    return (uint64_t(index.layer) << 56) | (uint64_t(index.chan_index) << 48) | (uint64_t(index.seg_index) << 32)
+           | (uint64_t(index.delta_x) << 16) | uint64_t(index.delta_y);
+}
+
+t_wire_cost_entry_index unpack_index(uint64_t packed) {
+    t_wire_cost_entry_index index;
+    index.layer = int((packed >> 56) & 0xff);
+    index.chan_index = int((packed >> 48) & 0xff);
+    index.seg_index = int((packed >> 32) & 0xffff);
+    index.delta_x = int((packed >> 16) & 0xffff);
+    index.delta_y = int(packed & 0xffff);
+    return index;
+}
+
+t_entry_stats_map& thread_stats() {
+    if (tl_stats == nullptr || tl_stats_session != f_session) {
+        std::lock_guard<std::mutex> lock(f_profile.mutex);
+        f_profile.thread_stats.push_back(std::make_unique<t_entry_stats_map>());
+        tl_stats = f_profile.thread_stats.back().get();
+        tl_stats_session = f_session;
+    }
+    return *tl_stats;
+}
+
+void merge_stats(t_entry_stats& into, const t_entry_stats& from) {
+    into.samples += from.samples;
+    into.expected_delay_sum += from.expected_delay_sum;
+    into.actual_delay_sum += from.actual_delay_sum;
+    into.min_actual_delay = std::min(into.min_actual_delay, from.min_actual_delay);
+}
+
+void write_profile(const std::string& filename) {
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    std::FILE* file = vtr::fopen(filename.c_str(), "w");
+    std::fprintf(file, "layer,wire_type,segment,dx,dy,samples,mean_expected_delay,mean_actual_delay,min_actual_delay,mean_error,mean_relative_error\n");
+    for (const auto& kv : f_profile.stats) {
+        t_wire_cost_entry_index index = unpack_index(kv.first);
+        const t_entry_stats& stats = kv.second;
+
+        double mean_expected = stats.expected_delay_sum / stats.samples;
+        double mean_actual = stats.actual_delay_sum / stats.samples;
+        double mean_error = mean_actual - mean_expected;
+        double mean_relative_error = (mean_actual > 0.) ? mean_error / mean_actual : 0.;
+
+        std::fprintf(file, "%d,%s,%s,%d,%d,%zu,%g,%g,%g,%g,%g\n",
+                     index.layer,
+                     (index.chan_index == 0) ? "CHANX" : "CHANY",
+                     rr_graph.rr_segments(RRSegmentId(index.seg_index)).name.c_str(),
+                     index.delta_x,
+                     index.delta_y,
+                     stats.samples,
+                     mean_expected,
+                     mean_actual,
+                     stats.min_actual_delay,
+                     mean_error,
+                     mean_relative_error);
+    }
+    vtr::fclose(file);
+}
+
+// Raises the entries which under-estimate their smallest routed delay by more than the correction threshold
+void correct_lookahead() {
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+    RouterLookahead* router_lookahead = route_ctx.cached_router_lookahead_.get_mutable(route_ctx.router_lookahead_cache_key_);
+    if (router_lookahead != f_profile.router_lookahead) {
+        VTR_LOG_WARN("The profiled router lookahead is not the cached one, so it is not corrected\n");
+        return;
+    }
+
+    size_t num_corrected = 0;
+    for (auto itr = f_profile.stats.begin(); itr != f_profile.stats.end();) {
+        const t_entry_stats& stats = itr->second;
+        double mean_expected = stats.expected_delay_sum / stats.samples;
+        if (stats.samples >= MIN_CORRECTION_SAMPLES && mean_expected < (1. - f_profile.correction_threshold) * stats.min_actual_delay) {
+            router_lookahead->raise_wire_cost_entry_delay(unpack_index(itr->first), stats.min_actual_delay);
+            ++num_corrected;
+            //Its expected delay changed, so the entry is profiled again from scratch
+            itr = f_profile.stats.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+
+    VTR_LOG("Raised the delay of %zu router lookahead entries under-estimating their routed delay by more than %g%%\n",
+            num_corrected, 100. * f_profile.correction_threshold);
+
+    if (num_corrected > 0 && !f_profile.write_lookahead.empty()) {
+        router_lookahead->write(f_profile.write_lookahead);
+    }
+}
+
+} // namespace
+
+Session::Session(const std::string& filename,
+                 const RouterLookahead& router_lookahead,
+                 float correction_threshold,
+                 const std::string& write_lookahead) {
+    VTR_ASSERT(!f_enabled);
+    if (filename.empty()) return;
+
+    if (filename != f_profile.filename) {
+        f_profile.filename = filename;
+        f_profile.stats.clear();
+    }
+
+    f_profile.router_lookahead = &router_lookahead;
+    f_profile.correction_threshold = correction_threshold;
+    f_profile.write_lookahead = write_lookahead;
+    ++f_session;
+    f_enabled = true;
+}
+
+Session::~Session() {
+    if (!f_enabled) return;
+
+    // Routing is done, so no thread is still profiling
+    for (const auto& stats_map : f_profile.thread_stats) {
+        for (const auto& kv : *stats_map) {
+            merge_stats(f_profile.stats[kv.first], kv.second);
+        }
+    }
+    f_profile.thread_stats.clear();
+
+    if (f_profile.stats.empty()) {
+        VTR_LOG_WARN("No router lookahead entries were profiled: only the map lookahead can be profiled\n");
+    }
+    write_profile(f_profile.filename);
+
+    if (f_profile.correction_threshold > 0.) {
+        correct_lookahead();
+    }
+
+    f_profile.router_lookahead = nullptr;
+    f_enabled = false;
+}
+
+bool enabled() {
+    return f_enabled;
+}
+
+void record_connection(const RouteTreeNode& sink_rt_node) {
+    VTR_ASSERT_SAFE(f_enabled);
+    const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    t_conn_cost_params cost_params;
+    cost_params.criticality = 1.; // Ensures lookahead returns delay value
+
+    t_entry_stats_map& entry_stats = thread_stats();
+    for (vtr::optional<const RouteTreeNode&> rt_node = sink_rt_node.parent(); rt_node; rt_node = rt_node->parent()) {
+        e_rr_type rr_type = rr_graph.node_type(rt_node->inode);
+        if (rr_type != CHANX && rr_type != CHANY) continue;
+
+        t_wire_cost_entry_index index;
+        if (!f_profile.router_lookahead->get_wire_cost_entry_index(rt_node->inode, sink_rt_node.inode, index)) {
+            return; // Not a table based lookahead
+        }
+
+        float expected_delay = f_profile.router_lookahead->get_expected_delay_and_cong(rt_node->inode, sink_rt_node.inode, cost_params, 0.).first;
+        float actual_delay = sink_rt_node.Tdel - rt_node->Tdel;
+
+        t_entry_stats& stats = entry_stats[pack_index(index)];
+        ++stats.samples;
+        stats.expected_delay_sum += expected_delay;
+        stats.actual_delay_sum += actual_delay;
+        stats.min_actual_delay = std::min(stats.min_actual_delay, actual_delay);
+    }
+}
+
+} // namespace router_lookahead_profiler
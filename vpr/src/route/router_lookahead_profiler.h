@@ -0,0 +1,51 @@
+#pragma once
+/* Optional profile of the router lookahead's accuracy (--write_router_lookahead_profile).
+ *
+ * Once a connection is routed, the delay the lookahead expects from each wire on its path
+ * to the sink is compared with the delay actually routed from that wire to the sink (taken
+ * from the route tree). The comparisons are accumulated per entry of the lookahead's wire
+ * table (layer, wire type, segment type, dx, dy), and written as a CSV heatmap of the error
+ * once routing is done. Overly optimistic entries show up as a large positive error.
+ *
+ * With a correction threshold (--router_lookahead_profile_correction), the entries which
+ * under-estimate the smallest delay routed for them by more than that fraction are raised
+ * to that delay once routing is done, and the lookahead is written again (if requested with
+ * --write_router_lookahead), so a saved lookahead improves with the designs routed with it.
+ *
+ * Only lookaheads with a wire table (the map lookahead) can be profiled. Like the router
+ * telemetry, each thread accumulates its own statistics, so the parallel router can be
+ * profiled too. Sessions writing to the same file (e.g. the routing attempts of a minimum
+ * channel width search) accumulate their statistics. */
+
+#include <string>
+
+class RouterLookahead;
+class RouteTreeNode;
+
+namespace router_lookahead_profiler {
+
+/**
+ * @brief Profiles the connections routed to filename (if non-empty) until destroyed
+ *
+ * If correction_threshold > 0, the lookahead's entries are then corrected and, if write_lookahead
+ * is not empty, the corrected lookahead is written to it.
+ */
+class Session {
+  public:
+    Session(const std::string& filename,
+            const RouterLookahead& router_lookahead,
+            float correction_threshold,
+            const std::string& write_lookahead);
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+};
+
+///@brief Returns true if connections are being profiled
+bool enabled();
+
+///@brief Profiles the wires on the path from the route tree root to sink_rt_node, the sink of a connection just routed
+void record_connection(const RouteTreeNode& sink_rt_node);
+
+} // namespace router_lookahead_profiler
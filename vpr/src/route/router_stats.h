@@ -51,6 +51,12 @@ struct RouterStats {
     size_t add_all_rt_from_high_fanout = 0;
     size_t add_high_fanout_rt = 0;
     size_t add_all_rt = 0;
+
+    size_t bidir_searches = 0; // Connections which ran a backward search (see ConnectionRouter::prepare_bidir_search)
+    size_t bidir_meets = 0;    // ... and were then completed through the backward search region
+
+    size_t high_fanout_full_tree_retries = 0; // High fanout connections retried from the full route tree
+    size_t full_device_bb_retries = 0;        // Connections retried with a full-device bounding box
 };
 
 class WirelengthInfo {
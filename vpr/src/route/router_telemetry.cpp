@@ -0,0 +1,182 @@
+#include "router_telemetry.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "vtr_assert.h"
+#include "vtr_util.h"
+
+#include "connection_router_interface.h"
+#include "router_lookahead.h"
+#include "router_stats.h"
+
+namespace router_telemetry {
+
+namespace {
+
+// Records a thread collects before writing them to the file
+constexpr size_t RECORDS_PER_BUFFER = 4096;
+
+struct t_buffer {
+    t_connection_record records[RECORDS_PER_BUFFER];
+    size_t size = 0;
+};
+
+struct t_stream {
+    std::FILE* file = nullptr;
+    const RouterLookahead* router_lookahead = nullptr;
+
+    // Buffers of the threads which recorded connections in the current session
+    std::mutex mutex;
+    std::vector<std::unique_ptr<t_buffer>> buffers;
+
+    std::string filename;
+    uint16_t attempt = 0;
+    uint16_t iteration = 0;
+};
+
+t_stream f_stream;
+bool f_enabled = false;
+
+// Identifies the session, so threads do not reuse a buffer of an earlier session
+size_t f_session = 0;
+
+thread_local t_buffer* tl_buffer = nullptr;
+thread_local size_t tl_buffer_session = 0;
+
+void write_buffer(t_buffer& buffer) {
+    if (buffer.size == 0) return;
+
+    size_t written = std::fwrite(buffer.records, sizeof(t_connection_record), buffer.size, f_stream.file);
+    VTR_ASSERT(written == buffer.size);
+    buffer.size = 0;
+}
+
+t_buffer& thread_buffer() {
+    if (tl_buffer == nullptr || tl_buffer_session != f_session) {
+        std::lock_guard<std::mutex> lock(f_stream.mutex);
+        f_stream.buffers.push_back(std::make_unique<t_buffer>());
+        tl_buffer = f_stream.buffers.back().get();
+        tl_buffer_session = f_session;
+    }
+    return *tl_buffer;
+}
+
+uint32_t saturate_to_uint32(size_t value) {
+    return uint32_t(std::min<size_t>(value, std::numeric_limits<uint32_t>::max()));
+}
+
+} // namespace
+
+Session::Session(const std::string& filename, const RouterLookahead& router_lookahead) {
+    VTR_ASSERT(!f_enabled);
+    if (filename.empty()) return;
+
+    if (filename == f_stream.filename) {
+        f_stream.file = vtr::fopen(filename.c_str(), "ab");
+        ++f_stream.attempt;
+    } else {
+        f_stream.file = vtr::fopen(filename.c_str(), "wb");
+        f_stream.filename = filename;
+        f_stream.attempt = 0;
+
+        t_file_header header;
+        header.record_size = sizeof(t_connection_record);
+        std::fwrite(&header, sizeof(header), 1, f_stream.file);
+    }
+
+    f_stream.router_lookahead = &router_lookahead;
+    f_stream.iteration = 0;
+    ++f_session;
+    f_enabled = true;
+}
+
+Session::~Session() {
+    if (!f_enabled) return;
+
+    // Routing is done, so no thread is still recording
+    for (auto& buffer : f_stream.buffers) {
+        write_buffer(*buffer);
+    }
+    f_stream.buffers.clear();
+
+    vtr::fclose(f_stream.file);
+    f_stream.file = nullptr;
+    f_stream.router_lookahead = nullptr;
+    f_enabled = false;
+}
+
+bool enabled() {
+    return f_enabled;
+}
+
+void set_iteration(int itry) {
+    f_stream.iteration = uint16_t(std::min(itry, int(std::numeric_limits<uint16_t>::max())));
+}
+
+t_connection_start connection_start(const RouterStats& router_stats) {
+    t_connection_start start;
+    start.time = std::chrono::steady_clock::now();
+    start.heap_pushes = router_stats.heap_pushes;
+    start.heap_pops = router_stats.heap_pops;
+    start.high_fanout_full_tree_retries = router_stats.high_fanout_full_tree_retries;
+    start.full_device_bb_retries = router_stats.full_device_bb_retries;
+    return start;
+}
+
+void connection_finish(const t_connection_start& start,
+                       const RouterStats& router_stats,
+                       ParentNetId net_id,
+                       int sink_pin,
+                       RRNodeId source_node,
+                       RRNodeId sink_node,
+                       const t_conn_cost_params& cost_params,
+                       bool high_fanout,
+                       bool found_path,
+                       bool retry_with_full_bb,
+                       float actual_cost,
+                       float sink_delay) {
+    VTR_ASSERT_SAFE(f_enabled);
+
+    t_connection_record record;
+    record.net_id = size_t(net_id);
+    record.sink_pin = sink_pin;
+    record.attempt = f_stream.attempt;
+    record.iteration = f_stream.iteration;
+    record.heap_pushes = saturate_to_uint32(router_stats.heap_pushes - start.heap_pushes);
+    record.heap_pops = saturate_to_uint32(router_stats.heap_pops - start.heap_pops);
+    record.wall_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start.time).count();
+    record.criticality = cost_params.criticality;
+    record.expected_cost = f_stream.router_lookahead->get_expected_cost(source_node, sink_node, cost_params, 0.);
+    record.actual_cost = actual_cost;
+    record.sink_delay = sink_delay;
+
+    record.retry_flags = 0;
+    if (router_stats.high_fanout_full_tree_retries != start.high_fanout_full_tree_retries) {
+        record.retry_flags |= RETRIED_WITH_FULL_ROUTE_TREE;
+    }
+    if (router_stats.full_device_bb_retries != start.full_device_bb_retries) {
+        record.retry_flags |= RETRIED_WITH_FULL_DEVICE_BB;
+    }
+    if (retry_with_full_bb) {
+        record.retry_flags |= DEFERRED_TO_FULL_DEVICE_BB;
+    }
+    if (!found_path) {
+        record.retry_flags |= NO_PATH;
+    }
+    record.flags = high_fanout ? HIGH_FANOUT : 0;
+    record.reserved = 0;
+
+    t_buffer& buffer = thread_buffer();
+    buffer.records[buffer.size++] = record;
+    if (buffer.size == RECORDS_PER_BUFFER) {
+        std::lock_guard<std::mutex> lock(f_stream.mutex);
+        write_buffer(buffer);
+    }
+}
+
+} // namespace router_telemetry
@@ -0,0 +1,115 @@
+#pragma once
+/* Optional per-connection router telemetry (--write_router_connection_telemetry).
+ *
+ * Each connection routed by the router appends one fixed size t_connection_record
+ * to a binary file, so pathological connections and lookahead inaccuracy can be
+ * analyzed offline across many runs. Records are copied into a per-thread buffer
+ * which is only written to the file (under a lock) once full, so the parallel
+ * router can record connections too and the overhead stays small.
+ *
+ * The file starts with a t_file_header, followed by the records in host byte order.
+ * Records of a thread are in routing order, but records of different threads are
+ * interleaved in blocks. */
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "netlist_fwd.h"
+#include "rr_graph_fwd.h"
+
+class RouterLookahead;
+struct RouterStats;
+struct t_conn_cost_params;
+
+namespace router_telemetry {
+
+constexpr uint32_t FILE_VERSION = 1;
+
+struct t_file_header {
+    char magic[8] = {'V', 'P', 'R', 'C', 'O', 'N', 'N', '\0'};
+    uint32_t version = FILE_VERSION;
+    uint32_t record_size = 0; // sizeof(t_connection_record)
+};
+
+// Bits of t_connection_record::retry_flags
+enum e_retry_flag : uint8_t {
+    RETRIED_WITH_FULL_ROUTE_TREE = 1 << 0, // No path from the high fanout subset of the route tree, retried from the full tree
+    RETRIED_WITH_FULL_DEVICE_BB = 1 << 1,  // No path within the net bounding box, retried with a full-device bounding box
+    DEFERRED_TO_FULL_DEVICE_BB = 1 << 2,   // No path within the net bounding box, left unrouted to be retried with a full-device bounding box
+    NO_PATH = 1 << 3                       // The connection could not be routed
+};
+
+// Bits of t_connection_record::flags
+enum e_connection_flag : uint8_t {
+    HIGH_FANOUT = 1 << 0 // Routed from the spatially close part of the route tree only
+};
+
+struct t_connection_record {
+    uint32_t net_id;
+    uint32_t sink_pin;  // Net pin index of the connection's sink
+    uint16_t attempt;   // Routing attempt (e.g. channel width) the connection was routed in, from 0
+    uint16_t iteration; // Router iteration
+    uint32_t heap_pushes;
+    uint32_t heap_pops;
+    float wall_time;     // Seconds spent routing the connection
+    float criticality;   // Criticality the connection was routed with
+    float expected_cost; // Router lookahead estimate of the cost from the net source to the sink
+    float actual_cost;   // Backward path cost of the path found to the sink
+    float sink_delay;    // Elmore delay to the sink in the updated route tree (NaN if not routed)
+    uint8_t retry_flags; // e_retry_flag bits
+    uint8_t flags;       // e_connection_flag bits
+    uint16_t reserved;
+};
+
+static_assert(sizeof(t_connection_record) == 44, "Connection record layout is part of the file format");
+
+/**
+ * @brief Records connections routed to filename (if non-empty) until destroyed
+ *
+ * The first session writing to a file truncates it; later sessions writing to the same
+ * file (e.g. the routing attempts of a minimum channel width search) append to it,
+ * and are told apart by t_connection_record::attempt.
+ */
+class Session {
+  public:
+    Session(const std::string& filename, const RouterLookahead& router_lookahead);
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+};
+
+///@brief Returns true if connections are being recorded
+bool enabled();
+
+///@brief Sets the router iteration of the connections recorded from now on
+void set_iteration(int itry);
+
+///@brief State at the start of routing a connection
+struct t_connection_start {
+    std::chrono::steady_clock::time_point time;
+    size_t heap_pushes = 0;
+    size_t heap_pops = 0;
+    size_t high_fanout_full_tree_retries = 0;
+    size_t full_device_bb_retries = 0;
+};
+
+///@brief Returns the state to pass to connection_finish() once the connection is routed
+t_connection_start connection_start(const RouterStats& router_stats);
+
+///@brief Records a connection routed since connection_start()
+void connection_finish(const t_connection_start& start,
+                       const RouterStats& router_stats,
+                       ParentNetId net_id,
+                       int sink_pin,
+                       RRNodeId source_node,
+                       RRNodeId sink_node,
+                       const t_conn_cost_params& cost_params,
+                       bool high_fanout,
+                       bool found_path,
+                       bool retry_with_full_bb,
+                       float actual_cost,
+                       float sink_delay);
+
+} // namespace router_telemetry
@@ -40,6 +40,10 @@
 #include "rr_types.h"
 #include "echo_files.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 //#define VERBOSE
 //used for getting the exact count of each edge type and printing it to std out.
 
@@ -79,11 +83,28 @@ struct t_pin_spec {
     RRNodeId pin_rr_node_id;
 };
 
+///@brief R and C of a channel wire node, recorded by build_rr_chan() so its rc index can be assigned afterwards
+struct t_chan_node_rc {
+    RRNodeId node;
+    float R;
+    float C;
+};
+
+///@brief Per-channel output of build_rr_chan() for the CHANX and CHANY segments at one (i, j)
+struct t_chan_build_buffers {
+    t_rr_edge_info_set chanx_edges;
+    t_rr_edge_info_set chany_edges;
+    std::vector<t_chan_node_rc> chanx_node_rcs;
+    std::vector<t_chan_node_rc> chany_node_rcs;
+};
+
 /******************* Variables local to this module. ***********************/
 
 /********************* Subroutines local to this module. *******************/
 void print_rr_graph_stats();
 
+static void print_rr_graph_pattern_stats();
+
 ///@brief given a specific type, it returns layers that the type are located at
 std::set<int> get_layers_of_physical_types(const t_physical_tile_type_ptr type);
 
@@ -478,6 +499,7 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                           const t_chan_details& chan_details_x,
                           const t_chan_details& chan_details_y,
                           t_rr_edge_info_set& created_rr_edges,
+                          std::vector<t_chan_node_rc>& created_node_rcs,
                           const int wire_to_ipin_switch,
                           const int wire_to_pin_between_dice_switch,
                           const enum e_directionality directionality);
@@ -677,6 +699,12 @@ void create_rr_graph(const t_graph_type graph_type,
         if (device_ctx.read_rr_graph_filename != det_routing_arch->read_rr_graph_filename) {
             free_rr_graph();
 
+            //A cached rr graph was already checked when it was generated
+            bool check_loaded_rr_graph = router_opts.do_check_rr_graph && !det_routing_arch->read_rr_graph_is_cached;
+            if (router_opts.do_check_rr_graph && !check_loaded_rr_graph) {
+                VTR_LOG("Skipping the check of cached rr graph '%s'\n", det_routing_arch->read_rr_graph_filename.c_str());
+            }
+
             load_rr_file(&mutable_device_ctx.rr_graph_builder,
                          &mutable_device_ctx.rr_graph,
                          device_ctx.physical_tile_types,
@@ -695,7 +723,7 @@ void create_rr_graph(const t_graph_type graph_type,
                          det_routing_arch->read_rr_graph_filename.c_str(),
                          &det_routing_arch->read_rr_graph_filename,
                          router_opts.read_rr_edge_metadata,
-                         router_opts.do_check_rr_graph,
+                         check_loaded_rr_graph,
                          echo_enabled,
                          echo_file_name,
                          is_flat);
@@ -769,6 +797,16 @@ void create_rr_graph(const t_graph_type graph_type,
                            is_flat);
 
     print_rr_graph_stats();
+    if (router_opts.report_rr_graph_patterns) {
+        print_rr_graph_pattern_stats();
+    }
+
+    if (router_opts.compress_rr_graph_edges) {
+        mutable_device_ctx.rr_graph_builder.compress_edges();
+    }
+
+    // All nodes have been added. The look-up is restored if nodes are added later (e.g. for flat routing)
+    mutable_device_ctx.rr_graph_builder.node_lookup().flatten();
 
     // Write out rr graph file if needed - Currently, writing the flat rr-graph is not supported since loading from a flat rr-graph is not supported.
     // When this function is called in any stage other than routing, the is_flat flag passed to this function is false, regardless of the flag passed
@@ -890,6 +928,24 @@ void print_rr_graph_stats() {
     VTR_LOG("  RR Graph Edges: %zu\n", num_rr_edges);
 }
 
+static void print_rr_graph_pattern_stats() {
+    vtr::ScopedStartFinishTimer timer("Find RR graph node patterns");
+    t_rr_graph_pattern_stats stats = get_rr_graph_pattern_stats(g_vpr_ctx.device().rr_graph);
+
+    // Explicit storage: node data, ptc, first edge, fan-in and layer per node; source, sink and switch per edge.
+    // Templated storage: the same for each pattern, plus a pattern id and a position (x, y, layer) per node.
+    constexpr size_t node_bytes = sizeof(t_rr_node_data) + sizeof(t_rr_node_ptc_data) + sizeof(RREdgeId) + sizeof(t_edge_size) + sizeof(short);
+    constexpr size_t edge_bytes = 2 * sizeof(RRNodeId) + sizeof(short);
+    constexpr size_t instance_bytes = sizeof(uint32_t) + 3 * sizeof(short);
+    size_t explicit_bytes = stats.num_nodes * node_bytes + stats.num_edges * edge_bytes;
+    size_t templated_bytes = stats.num_node_patterns * node_bytes + stats.num_pattern_edges * edge_bytes + stats.num_nodes * instance_bytes;
+
+    VTR_LOG("  RR Graph Node Patterns: %zu (%zu edges), %zu nodes with an irregular pattern\n",
+            stats.num_node_patterns, stats.num_pattern_edges, stats.num_irregular_nodes);
+    VTR_LOG("  RR Graph Storage: %.2f MiB explicit, ~%.2f MiB templated\n",
+            explicit_bytes / 1024. / 1024., templated_bytes / 1024. / 1024.);
+}
+
 std::set<int> get_layers_of_physical_types(const t_physical_tile_type_ptr type) {
     const auto& device_ctx = g_vpr_ctx.device();
     std::set<int> phy_type_layers;
@@ -2110,6 +2166,12 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
     /* Build channels */
     VTR_ASSERT(Fs % 3 == 0);
 
+    //The channels of one column (all j for a given i) are built concurrently, each into its
+    //own buffers. The buffers are then loaded in the order a serial build would use (CHANX
+    //before CHANY, increasing j), so the resulting RR graph doesn't depend on the number
+    //of threads. Only one column is buffered at a time, to keep the peak memory close to
+    //the serial build.
+    std::vector<t_chan_build_buffers> column_buffers(grid.height() - 1);
     for (int layer = 0; layer < grid.get_num_layers(); ++layer) {
         auto& device_ctx = g_vpr_ctx.device();
         /* Skip the current die if architecture file specifies that it doesn't require inter-cluster programmable resource routing */
@@ -2117,24 +2179,20 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
             continue;
         }
         for (size_t i = 0; i < grid.width() - 1; ++i) {
-            for (size_t j = 0; j < grid.height() - 1; ++j) {
+            auto build_chans_at = [&](size_t j) {
+                t_chan_build_buffers& buffers = column_buffers[j];
                 if (i > 0) {
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.x_list[j]);
                     build_rr_chan(rr_graph_builder, layer, i, j, CHANX, track_to_pin_lookup_x, sb_conn_map, switch_block_conn,
                                   CHANX_COST_INDEX_START,
                                   chan_width, grid, tracks_per_chan,
                                   sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create,
+                                  buffers.chanx_edges,
+                                  buffers.chanx_node_rcs,
                                   wire_to_ipin_switch,
                                   wire_to_pin_between_dice_switch,
                                   directionality);
-
-                    //Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
-
-                    rr_edges_to_create.clear();
+                    uniquify_edges(buffers.chanx_edges);
                 }
                 if (j > 0) {
                     int tracks_per_chan = ((is_global_graph) ? 1 : chan_width.y_list[i]);
@@ -2142,17 +2200,35 @@ static std::function<void(t_chan_width*)> alloc_and_load_rr_graph(RRGraphBuilder
                                   CHANX_COST_INDEX_START + num_seg_types_x,
                                   chan_width, grid, tracks_per_chan,
                                   sblock_pattern, Fs / 3, chan_details_x, chan_details_y,
-                                  rr_edges_to_create,
+                                  buffers.chany_edges,
+                                  buffers.chany_node_rcs,
                                   wire_to_ipin_switch,
                                   wire_to_pin_between_dice_switch,
                                   directionality);
+                    uniquify_edges(buffers.chany_edges);
+                }
+            };
 
-                    //Create the actual CHAN->CHAN edges
-                    uniquify_edges(rr_edges_to_create);
-                    alloc_and_load_edges(rr_graph_builder, rr_edges_to_create);
-                    num_edges += rr_edges_to_create.size();
+#ifdef VPR_USE_TBB
+            tbb::parallel_for(size_t(0), column_buffers.size(), build_chans_at);
+#else
+            for (size_t j = 0; j < column_buffers.size(); ++j) {
+                build_chans_at(j);
+            }
+#endif
 
-                    rr_edges_to_create.clear();
+            //Create the actual CHAN->CHAN edges
+            for (t_chan_build_buffers& buffers : column_buffers) {
+                for (auto* node_rcs : {&buffers.chanx_node_rcs, &buffers.chany_node_rcs}) {
+                    for (const t_chan_node_rc& node_rc : *node_rcs) {
+                        rr_graph_builder.set_node_rc_index(node_rc.node, NodeRCIndex(find_create_rr_rc_data(node_rc.R, node_rc.C, g_vpr_ctx.mutable_device().rr_rc_data)));
+                    }
+                    node_rcs->clear();
+                }
+                for (auto* chan_edges : {&buffers.chanx_edges, &buffers.chany_edges}) {
+                    alloc_and_load_edges(rr_graph_builder, *chan_edges);
+                    num_edges += chan_edges->size();
+                    chan_edges->clear();
                 }
             }
         }
@@ -3040,14 +3116,18 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
                           const t_chan_details& chan_details_x,
                           const t_chan_details& chan_details_y,
                           t_rr_edge_info_set& rr_edges_to_create,
+                          std::vector<t_chan_node_rc>& created_node_rcs,
                           const int wire_to_ipin_switch,
                           const int wire_to_pin_between_dice_switch,
                           const enum e_directionality directionality) {
     /* this function builds both x and y-directed channel segments, so set up our
-     * coordinates based on channel type */
+     * coordinates based on channel type
+     *
+     * It only writes the nodes of this channel segment and the output arguments
+     * (which also holds for the lazily filled entries of sblock_pattern), so
+     * different channel segments can be built concurrently. */
 
     auto& device_ctx = g_vpr_ctx.device();
-    auto& mutable_device_ctx = g_vpr_ctx.mutable_device();
 
     //Initally assumes CHANX
     int seg_coord = x_coord;                           //The absolute coordinate of this segment within the channel
@@ -3200,10 +3280,11 @@ static void build_rr_chan(RRGraphBuilder& rr_graph_builder,
 
         rr_graph_builder.set_node_layer(node, layer);
 
+        //The rc index is assigned by the caller, since rr_rc_data is shared by all channels
         int length = end - start + 1;
         float R = length * seg_details[track].Rmetal();
         float C = length * seg_details[track].Cmetal();
-        rr_graph_builder.set_node_rc_index(node, NodeRCIndex(find_create_rr_rc_data(R, C, mutable_device_ctx.rr_rc_data)));
+        created_node_rcs.push_back({node, R, C});
 
         rr_graph_builder.set_node_type(node, chan_type);
         rr_graph_builder.set_node_track_num(node, track);
@@ -2047,45 +2047,36 @@ static int get_track_to_chan_seg(RRGraphBuilder& rr_graph_builder,
         }
     }
 
-    /* get coordinate to index into the SB map */
-    Switchblock_Lookup sb_coord(tile_x, tile_y, from_side, to_side);
-    if (sb_conn_map->count(sb_coord) > 0) {
-        /* get reference to the connections vector which lists all destination wires for a given source wire
-         * at a specific coordinate sb_coord */
-        std::vector<t_switchblock_edge>& conn_vector = (*sb_conn_map)[sb_coord];
+    /* get the connections listing all destination wires of the source wire at the SB map coordinate */
+    auto conns = sb_conn_map->edges(tile_x, tile_y, from_side, to_side, from_wire);
 
-        /* go through the connections... */
-        for (int iconn = 0; iconn < (int)conn_vector.size(); ++iconn) {
-            if (conn_vector.at(iconn).from_wire != from_wire) continue;
+    /* go through the connections... */
+    for (const t_switchblock_edge& conn : conns) {
+        int to_wire = conn.to_wire;
+        RRNodeId to_node = rr_graph_builder.node_lookup().find_node(layer, to_x, to_y, to_chan_type, to_wire);
 
-            int to_wire = conn_vector.at(iconn).to_wire;
-            RRNodeId to_node = rr_graph_builder.node_lookup().find_node(layer, to_x, to_y, to_chan_type, to_wire);
-
-            if (!to_node) {
-                continue;
-            }
+        if (!to_node) {
+            continue;
+        }
 
-            /* Get the index of the switch connecting the two wires */
-            int src_switch = conn_vector[iconn].switch_ind;
+        /* Get the index of the switch connecting the two wires */
+        int src_switch = conn.switch_ind;
 
-            //Apply any switch overrides
-            if (should_apply_switch_override(switch_override)) {
-                src_switch = switch_override;
-            }
+        //Apply any switch overrides
+        if (should_apply_switch_override(switch_override)) {
+            src_switch = switch_override;
+        }
 
-            rr_edges_to_create.emplace_back(from_rr_node, to_node, src_switch, false);
-            ++edge_count;
+        rr_edges_to_create.emplace_back(from_rr_node, to_node, src_switch, false);
+        ++edge_count;
 
-            auto& device_ctx = g_vpr_ctx.device();
+        auto& device_ctx = g_vpr_ctx.device();
 
-            if (device_ctx.arch_switch_inf[src_switch].directionality() == BI_DIRECTIONAL) {
-                //Add reverse edge since bi-directional
-                rr_edges_to_create.emplace_back(to_node, from_rr_node, src_switch, false);
-                ++edge_count;
-            }
+        if (device_ctx.arch_switch_inf[src_switch].directionality() == BI_DIRECTIONAL) {
+            //Add reverse edge since bi-directional
+            rr_edges_to_create.emplace_back(to_node, from_rr_node, src_switch, false);
+            ++edge_count;
         }
-    } else {
-        /* specified sb_conn_map entry does not exist -- do nothing */
     }
     return edge_count;
 }
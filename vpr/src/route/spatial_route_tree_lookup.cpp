@@ -1,11 +1,25 @@
 #include "spatial_route_tree_lookup.h"
 
+#include <algorithm>
+
 #include "globals.h"
 
 SpatialRouteTreeLookup build_route_tree_spatial_lookup(const Netlist<>& net_list,
                                                        const vtr::vector<ParentNetId, t_bb>& net_bound_box,
                                                        ParentNetId net,
                                                        const RouteTreeNode& rt_root) {
+    std::array<size_t, 2> bins = route_tree_spatial_lookup_bins(net_list, net_bound_box, net);
+
+    SpatialRouteTreeLookup spatial_lookup({bins[0], bins[1]});
+
+    update_route_tree_spatial_lookup_recur(rt_root, spatial_lookup);
+
+    return spatial_lookup;
+}
+
+std::array<size_t, 2> route_tree_spatial_lookup_bins(const Netlist<>& net_list,
+                                                     const vtr::vector<ParentNetId, t_bb>& net_bound_box,
+                                                     ParentNetId net) {
     constexpr float BIN_AREA_PER_SINK_FACTOR = 4;
 
     auto& device_ctx = g_vpr_ctx.device();
@@ -22,11 +36,7 @@ SpatialRouteTreeLookup build_route_tree_spatial_lookup(const Netlist<>& net_list
     size_t bins_x = std::ceil(device_ctx.grid.width() / bin_dim);
     size_t bins_y = std::ceil(device_ctx.grid.height() / bin_dim);
 
-    SpatialRouteTreeLookup spatial_lookup({bins_x, bins_y});
-
-    update_route_tree_spatial_lookup_recur(rt_root, spatial_lookup);
-
-    return spatial_lookup;
+    return {bins_x, bins_y};
 }
 
 // Adds the sub-tree rooted at rt_node to the spatial look-up
@@ -60,6 +70,32 @@ void update_route_tree_spatial_lookup_recur(const RouteTreeNode& rt_node, Spatia
     }
 }
 
+// Removes rt_node from the bins it was added to by update_route_tree_spatial_lookup_recur
+void remove_route_tree_spatial_lookup_node(const RouteTreeNode& rt_node, SpatialRouteTreeLookup& spatial_lookup) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const auto& rr_graph = device_ctx.rr_graph;
+
+    RRNodeId rr_node = (RRNodeId)rt_node.inode;
+
+    int bin_xlow = grid_to_bin_x(rr_graph.node_xlow(rr_node), spatial_lookup);
+    int bin_ylow = grid_to_bin_y(rr_graph.node_ylow(rr_node), spatial_lookup);
+    int bin_xhigh = grid_to_bin_x(rr_graph.node_xhigh(rr_node), spatial_lookup);
+    int bin_yhigh = grid_to_bin_y(rr_graph.node_yhigh(rr_node), spatial_lookup);
+
+    // Compare addresses: the same rr node may be in the tree more than once (e.g. SINKs)
+    auto remove_from_bin = [&](std::vector<std::reference_wrapper<const RouteTreeNode>>& bin) {
+        bin.erase(std::remove_if(bin.begin(), bin.end(), [&](const RouteTreeNode& node) {
+                      return &node == &rt_node;
+                  }),
+                  bin.end());
+    };
+
+    remove_from_bin(spatial_lookup[bin_xlow][bin_ylow]);
+    if (bin_xhigh != bin_xlow || bin_yhigh != bin_ylow) {
+        remove_from_bin(spatial_lookup[bin_xhigh][bin_yhigh]);
+    }
+}
+
 size_t grid_to_bin_x(size_t grid_x, const SpatialRouteTreeLookup& spatial_lookup) {
     auto& device_ctx = g_vpr_ctx.device();
 
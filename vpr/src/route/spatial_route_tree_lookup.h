@@ -1,5 +1,6 @@
 #ifndef VPR_SPATIAL_ROUTE_TREE_LOOKUP_H
 #define VPR_SPATIAL_ROUTE_TREE_LOOKUP_H
+#include <array>
 #include <vector>
 
 #include "vpr_types.h"
@@ -15,8 +16,16 @@ SpatialRouteTreeLookup build_route_tree_spatial_lookup(const Netlist<>& net_list
                                                        ParentNetId net,
                                                        const RouteTreeNode& rt_root);
 
+/** Get the number of bins (x, y) of the spatial look-up of net, as built by build_route_tree_spatial_lookup() */
+std::array<size_t, 2> route_tree_spatial_lookup_bins(const Netlist<>& net_list,
+                                                     const vtr::vector<ParentNetId, t_bb>& net_bound_box,
+                                                     ParentNetId net);
+
 void update_route_tree_spatial_lookup_recur(const RouteTreeNode& rt_node, SpatialRouteTreeLookup& spatial_lookup);
 
+/** Remove rt_node (but not its children) from the spatial look-up */
+void remove_route_tree_spatial_lookup_node(const RouteTreeNode& rt_node, SpatialRouteTreeLookup& spatial_lookup);
+
 size_t grid_to_bin_x(size_t grid_x, const SpatialRouteTreeLookup& spatial_lookup);
 size_t grid_to_bin_y(size_t grid_y, const SpatialRouteTreeLookup& spatial_lookup);
 
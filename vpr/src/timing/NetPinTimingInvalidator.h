@@ -7,6 +7,8 @@
 
 #include "vtr_vec_id_set.h"
 
+#include <atomic>
+
 #ifdef VPR_USE_TBB
 #    include <tbb/concurrent_unordered_set.h>
 #endif
@@ -21,6 +23,9 @@ class NetPinTimingInvalidator {
     virtual tedge_range pin_timing_edges(ParentPinId /* pin */) const = 0;
     virtual void invalidate_connection(ParentPinId /* pin */, TimingInfo* /* timing_info */) = 0;
     virtual void reset() = 0;
+
+    /** Returns true if no connection was invalidated since the last reset, i.e. no connection delay changed */
+    virtual bool empty() const = 0;
 };
 
 //Helper class for iterating through the timing edges associated with a particular
@@ -98,6 +103,10 @@ class IncrNetPinTimingInvalidator : public NetPinTimingInvalidator {
         invalidated_pins_.clear();
     }
 
+    bool empty() const {
+        return invalidated_pins_.size() == 0;
+    }
+
   private:
     tatum::EdgeId atom_pin_to_timing_edge(const tatum::TimingGraph& timing_graph,
                                           const AtomNetlist& atom_nlist,
@@ -149,10 +158,20 @@ class NoopNetPinTimingInvalidator : public NetPinTimingInvalidator {
     }
 
     void invalidate_connection(ParentPinId /* pin */, TimingInfo* /* timing_info */) {
+        //Still track whether a delay changed, so an unneeded full timing update can be skipped
+        invalidated_ = true;
     }
 
     void reset() {
+        invalidated_ = false;
     }
+
+    bool empty() const {
+        return !invalidated_;
+    }
+
+  private:
+    std::atomic<bool> invalidated_{false}; //Concurrently set by the parallel router
 };
 
 /** Make a NetPinTimingInvalidator depending on update_type. Will return a NoopInvalidator if it's not INCREMENTAL. */
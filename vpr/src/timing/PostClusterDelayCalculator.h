@@ -31,9 +31,22 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
 
     void clear_cache();
 
+    /**
+     * @brief Calculates the delays (and setup/hold times) of every edge of tg up front, in parallel if built with TBB
+     *
+     * Normally the delays of the edges between clusters are recomputed from the net delays on every call, since
+     * the net delays change during placement and routing. Once they are final (e.g. for the analysis after routing)
+     * this fills the per-edge delay caches completely, so the timing analysis only reads the cached delays.
+     * The net delays must not change until the next call to clear_cache().
+     */
+    void materialize_edge_delays(const tatum::TimingGraph& tg);
+
     void set_tsu_margin_relative(float val);
     void set_tsu_margin_absolute(float val);
 
+    ///@brief Scales all the delays (and setup/hold times) calculated, e.g. to analyze another delay corner
+    void set_delay_scale(float val);
+
   private:
     friend VprTimingGraphResolver;
 
@@ -77,6 +90,7 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
 
     float tsu_margin_rel_ = 1.0;
     float tsu_margin_abs_ = 0.0e-12;
+    float delay_scale_ = 1.0;
 
     mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_min_delay_cache_;
     mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_max_delay_cache_;
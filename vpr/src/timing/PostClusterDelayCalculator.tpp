@@ -7,6 +7,10 @@
 
 #include "vtr_assert.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
+
 //Print detailed debug info about edge delay calculation
 /*#define POST_CLUSTER_DELAY_CALC_DEBUG*/
 
@@ -39,6 +43,35 @@ inline void PostClusterDelayCalculator::clear_cache() {
     std::fill(pin_cache_max_.begin(), pin_cache_max_.end(), std::pair<ParentPinId, ParentPinId>(ParentPinId::INVALID(), ParentPinId::INVALID()));
 }
 
+inline void PostClusterDelayCalculator::materialize_edge_delays(const tatum::TimingGraph& tg) {
+    //Each edge only reads and writes its own cache entries, so the edges can be calculated concurrently
+    auto materialize_edge_delay = [&](tatum::EdgeId edge) {
+        if (tg.edge_disabled(edge)) {
+            return;
+        }
+
+        if (tg.edge_type(edge) == tatum::EdgeType::PRIMITIVE_CLOCK_CAPTURE) {
+            //Cached by the calculation itself
+            atom_setup_time(tg, edge);
+            atom_hold_time(tg, edge);
+        } else {
+            set_cached_delay(edge, DelayType::MAX, calc_edge_delay(tg, edge, DelayType::MAX));
+            set_cached_delay(edge, DelayType::MIN, calc_edge_delay(tg, edge, DelayType::MIN));
+        }
+    };
+
+#ifdef VPR_USE_TBB
+    std::vector<tatum::EdgeId> edges(tg.edges().begin(), tg.edges().end());
+    tbb::parallel_for(size_t(0), edges.size(), [&](size_t iedge) {
+        materialize_edge_delay(edges[iedge]);
+    });
+#else
+    for (tatum::EdgeId edge : tg.edges()) {
+        materialize_edge_delay(edge);
+    }
+#endif
+}
+
 inline void PostClusterDelayCalculator::set_tsu_margin_relative(float new_margin) {
     tsu_margin_rel_ = new_margin;
 }
@@ -47,6 +80,11 @@ inline void PostClusterDelayCalculator::set_tsu_margin_absolute(float new_margin
     tsu_margin_abs_ = new_margin;
 }
 
+inline void PostClusterDelayCalculator::set_delay_scale(float new_scale) {
+    delay_scale_ = new_scale;
+    clear_cache();
+}
+
 inline tatum::Time PostClusterDelayCalculator::max_edge_delay(const tatum::TimingGraph& tg, tatum::EdgeId edge_id) const {
 #ifdef POST_CLUSTER_DELAY_CALC_DEBUG
     VTR_LOG("=== Edge %zu (max) ===\n", size_t(edge_id));
@@ -103,7 +141,7 @@ inline tatum::Time PostClusterDelayCalculator::atom_combinational_delay(const ta
         AtomPinId src_pin = netlist_lookup_.tnode_atom_pin(src_node);
         AtomPinId sink_pin = netlist_lookup_.tnode_atom_pin(sink_node);
 
-        delay = tatum::Time(atom_delay_calc_.atom_combinational_delay(src_pin, sink_pin, delay_type));
+        delay = tatum::Time(delay_scale_ * atom_delay_calc_.atom_combinational_delay(src_pin, sink_pin, delay_type));
 
         //Insert
         set_cached_delay(edge_id, delay_type, delay);
@@ -129,7 +167,7 @@ inline tatum::Time PostClusterDelayCalculator::atom_setup_time(const tatum::Timi
         AtomPinId input_pin = netlist_lookup_.tnode_atom_pin(in_node);
         AtomPinId clock_pin = netlist_lookup_.tnode_atom_pin(clock_node);
 
-        tsu = tatum::Time(tsu_margin_rel_ * atom_delay_calc_.atom_setup_time(clock_pin, input_pin) + tsu_margin_abs_);
+        tsu = tatum::Time(tsu_margin_rel_ * delay_scale_ * atom_delay_calc_.atom_setup_time(clock_pin, input_pin) + tsu_margin_abs_);
 
         //Insert
         set_cached_setup_time(edge_id, tsu);
@@ -154,7 +192,7 @@ inline tatum::Time PostClusterDelayCalculator::atom_hold_time(const tatum::Timin
         AtomPinId input_pin = netlist_lookup_.tnode_atom_pin(in_node);
         AtomPinId clock_pin = netlist_lookup_.tnode_atom_pin(clock_node);
 
-        thld = tatum::Time(atom_delay_calc_.atom_hold_time(clock_pin, input_pin));
+        thld = tatum::Time(delay_scale_ * atom_delay_calc_.atom_hold_time(clock_pin, input_pin));
 
         //Insert
         set_cached_hold_time(edge_id, thld);
@@ -179,7 +217,7 @@ inline tatum::Time PostClusterDelayCalculator::atom_clock_to_q_delay(const tatum
         AtomPinId output_pin = netlist_lookup_.tnode_atom_pin(out_node);
         AtomPinId clock_pin = netlist_lookup_.tnode_atom_pin(clock_node);
 
-        tco = tatum::Time(atom_delay_calc_.atom_clock_to_q_delay(clock_pin, output_pin, delay_type));
+        tco = tatum::Time(delay_scale_ * atom_delay_calc_.atom_clock_to_q_delay(clock_pin, output_pin, delay_type));
 
         //Insert
         set_cached_delay(edge_id, delay_type, tco);
@@ -283,14 +321,14 @@ inline tatum::Time PostClusterDelayCalculator::atom_net_delay(const tatum::Timin
                     src_block_pin_index = cluster_ctx.clb_nlist.net_pin_logical_index(cluster_net_id, 0);
                     VTR_ASSERT(src_block_pin_index >= 0);
 
-                    tatum::Time driver_clb_delay = tatum::Time(clb_delay_calc_.internal_src_to_clb_output_delay(driver_block_id,
+                    tatum::Time driver_clb_delay = tatum::Time(delay_scale_ * clb_delay_calc_.internal_src_to_clb_output_delay(driver_block_id,
                                                                                                                 src_block_pin_index,
                                                                                                                 src_pb_route_id,
                                                                                                                 delay_type));
 
                     tatum::Time net_delay = tatum::Time(inter_cluster_delay((ParentNetId&)cluster_net_id, 0, sink_net_pin_index));
 
-                    tatum::Time sink_clb_delay = tatum::Time(clb_delay_calc_.clb_input_to_internal_sink_delay(clb_sink_block,
+                    tatum::Time sink_clb_delay = tatum::Time(delay_scale_ * clb_delay_calc_.clb_input_to_internal_sink_delay(clb_sink_block,
                                                                                                               sink_block_pin_index,
                                                                                                               sink_pb_route_id,
                                                                                                               delay_type));
@@ -320,7 +358,7 @@ inline tatum::Time PostClusterDelayCalculator::atom_net_delay(const tatum::Timin
                     //Connection entirely within the CLB
                     VTR_ASSERT(clb_src_block == clb_sink_block);
 
-                    edge_delay = tatum::Time(clb_delay_calc_.internal_src_to_internal_sink_delay(clb_src_block, src_pb_route_id, sink_pb_route_id, delay_type));
+                    edge_delay = tatum::Time(delay_scale_ * clb_delay_calc_.internal_src_to_internal_sink_delay(clb_src_block, src_pb_route_id, sink_pb_route_id, delay_type));
 
                     //Save the delay, since it won't change during placement or routing
                     // Note that we cache the full edge delay for edges completely contained within CLBs
@@ -387,7 +425,7 @@ inline float PostClusterDelayCalculator::inter_cluster_delay(const ParentNetId n
     VTR_ASSERT(src_net_pin_index == 0);
 
     //TODO: support minimum net delays
-    return net_delay_[net_id][sink_net_pin_index];
+    return delay_scale_ * net_delay_[net_id][sink_net_pin_index];
 }
 
 inline tatum::Time PostClusterDelayCalculator::get_cached_delay(tatum::EdgeId edge, DelayType delay_type) const {
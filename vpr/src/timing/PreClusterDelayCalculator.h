@@ -1,5 +1,7 @@
 #ifndef PRE_CLUSTER_DELAY_CALCULATOR_H
 #define PRE_CLUSTER_DELAY_CALCULATOR_H
+#include <algorithm>
+
 #include "vtr_assert.h"
 
 #include "tatum/Time.hpp"
@@ -12,6 +14,15 @@
 #include "atom_lookup.h"
 #include "physical_types.h"
 
+/**
+ * @brief Delay calculator used during clustering
+ *
+ * Primitive delays are those of each atom's expected lowest cost primitive. Nets between
+ * atoms of the same cluster are estimated from the cluster's local interconnect, and all
+ * other nets are assumed to have the inter-cluster net delay. Since the cluster of an atom
+ * changes during clustering, the edges of newly absorbed nets must be invalidated before
+ * the timing analysis is updated.
+ */
 class PreClusterDelayCalculator : public tatum::DelayCalculator {
   public:
     PreClusterDelayCalculator(const AtomNetlist& netlist,
@@ -38,6 +49,16 @@ class PreClusterDelayCalculator : public tatum::DelayCalculator {
         } else {
             VTR_ASSERT(edge_type == tatum::EdgeType::INTERCONNECT);
 
+            AtomPinId driver_pin = netlist_lookup_.tnode_atom_pin(src_node);
+            AtomPinId sink_pin = netlist_lookup_.tnode_atom_pin(sink_node);
+            if (driver_pin && sink_pin) {
+                ClusterBlockId driver_clb = netlist_lookup_.atom_clb(netlist_.pin_block(driver_pin));
+                if (driver_clb && driver_clb == netlist_lookup_.atom_clb(netlist_.pin_block(sink_pin))) {
+                    //Net absorbed into a cluster
+                    return intra_cluster_net_delay(driver_pin, sink_pin);
+                }
+            }
+
             //External net delay
             return tatum::Time(inter_cluster_net_delay_);
         }
@@ -129,6 +150,40 @@ class PreClusterDelayCalculator : public tatum::DelayCalculator {
         return time;
     }
 
+    //Estimates the delay of a connection routed through a cluster's local interconnect as the
+    //slowest pb graph edge leaving the driver pin plus the slowest one entering the sink pin
+    tatum::Time intra_cluster_net_delay(const AtomPinId driver_pin, const AtomPinId sink_pin) const {
+        const t_pb_graph_pin* driver_gpin = find_clustered_pb_graph_pin(driver_pin);
+        const t_pb_graph_pin* sink_gpin = find_clustered_pb_graph_pin(sink_pin);
+
+        float delay = 0.;
+        float edge_delay = 0.;
+        for (int iedge = 0; iedge < driver_gpin->num_output_edges; ++iedge) {
+            edge_delay = std::max(edge_delay, driver_gpin->output_edges[iedge]->delay_max);
+        }
+        delay += edge_delay;
+
+        edge_delay = 0.;
+        for (int iedge = 0; iedge < sink_gpin->num_input_edges; ++iedge) {
+            edge_delay = std::max(edge_delay, sink_gpin->input_edges[iedge]->delay_max);
+        }
+        delay += edge_delay;
+
+        return tatum::Time(delay);
+    }
+
+    //Returns the pb graph pin of pin in the primitive its (clustered) block was packed into
+    const t_pb_graph_pin* find_clustered_pb_graph_pin(const AtomPinId pin) const {
+        const t_pb* pb = netlist_lookup_.atom_pb(netlist_.pin_block(pin));
+        VTR_ASSERT(pb);
+
+        AtomPortId port = netlist_.pin_port(pin);
+        const t_pb_graph_pin* gpin = get_pb_graph_node_pin_from_model_port_pin(netlist_.port_model(port), netlist_.pin_port_bit(pin), pb->pb_graph_node);
+        VTR_ASSERT(gpin);
+
+        return gpin;
+    }
+
     const t_pb_graph_pin* find_pb_graph_pin(const AtomPinId pin) const {
         AtomBlockId blk = netlist_.pin_block(pin);
 
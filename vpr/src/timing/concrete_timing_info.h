@@ -6,6 +6,7 @@
 #include "timing_util.h"
 #include "vpr_error.h"
 #include "slack_evaluation.h"
+#include "setup_timing_summary.h"
 #include "globals.h"
 
 #include "tatum/report/graphviz_dot_writer.hpp"
@@ -28,7 +29,8 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
         , timing_constraints_(timing_constraints_v)
         , delay_calc_(delay_calc)
         , setup_analyzer_(analyzer_v)
-        , slack_crit_(g_vpr_ctx.atom().nlist, g_vpr_ctx.atom().lookup) {
+        , slack_crit_(g_vpr_ctx.atom().nlist, g_vpr_ctx.atom().lookup)
+        , timing_summary_(*timing_graph_v, *timing_constraints_v) {
         //pass
     }
 
@@ -36,34 +38,28 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
     //Accessors
     tatum::TimingPathInfo least_slack_critical_path() const override {
         if (least_slack_critical_path_.type() == tatum::TimingType::UNKOWN) {
-            least_slack_critical_path_ = find_least_slack_critical_path_delay(*timing_constraints_, *setup_analyzer_);
+            least_slack_critical_path_ = find_least_slack_critical_path_delay(critical_paths());
         }
         return least_slack_critical_path_;
     }
 
     tatum::TimingPathInfo longest_critical_path() const override {
         if (longest_critical_path_.type() == tatum::TimingType::UNKOWN) {
-            longest_critical_path_ = find_longest_critical_path_delay(*timing_constraints_, *setup_analyzer_);
+            longest_critical_path_ = find_longest_critical_path_delay(critical_paths());
         }
         return longest_critical_path_;
     }
 
     std::vector<tatum::TimingPathInfo> critical_paths() const override {
-        return tatum::find_critical_paths(*timing_graph_, *timing_constraints_, *setup_analyzer_);
+        return timing_summary_.critical_paths();
     }
 
     float setup_total_negative_slack() const override {
-        if (std::isnan(sTNS_)) {
-            sTNS_ = find_setup_total_negative_slack(*setup_analyzer_);
-        }
-        return sTNS_;
+        return timing_summary_.total_negative_slack();
     }
 
     float setup_worst_negative_slack() const override {
-        if (std::isnan(sWNS_)) {
-            sWNS_ = find_setup_worst_negative_slack(*setup_analyzer_);
-        }
-        return sWNS_;
+        return timing_summary_.worst_negative_slack();
     }
 
     float setup_pin_slack(AtomPinId pin) const override {
@@ -139,6 +135,7 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
     void update_setup_slacks() {
         clear_cache();
         slack_crit_.update_slacks_and_criticalities(*timing_graph_, *setup_analyzer_);
+        timing_summary_.update(*setup_analyzer_);
     }
 
     void set_warn_unconstrained(bool val) override { warn_unconstrained_ = val; }
@@ -151,10 +148,9 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
     std::shared_ptr<tatum::SetupTimingAnalyzer> setup_analyzer_;
 
     SetupSlackCrit slack_crit_;
+    SetupTimingSummary timing_summary_; //Critical paths and TNS/WNS, updated incrementally with the slacks
 
     //Cached values
-    mutable float sTNS_ = std::numeric_limits<float>::quiet_NaN();
-    mutable float sWNS_ = std::numeric_limits<float>::quiet_NaN();
     mutable tatum::TimingPathInfo least_slack_critical_path_;
     mutable tatum::TimingPathInfo longest_critical_path_;
 
@@ -165,8 +161,6 @@ class ConcreteSetupTimingInfo : public SetupTimingInfo {
 
     //Reset cached values to invalid (calculated lazily in accessors)
     void clear_cache() {
-        sTNS_ = std::numeric_limits<float>::quiet_NaN();
-        sWNS_ = std::numeric_limits<float>::quiet_NaN();
         least_slack_critical_path_ = tatum::TimingPathInfo();
         longest_critical_path_ = tatum::TimingPathInfo();
     }
@@ -1,5 +1,6 @@
 #include "read_sdc.h"
 
+#include <algorithm>
 #include <regex>
 
 #include "vtr_log.h"
@@ -16,6 +17,11 @@
 #include "atom_netlist_utils.h"
 #include "atom_lookup.h"
 
+#ifdef VPR_USE_TBB
+#    include <tbb/blocked_range.h>
+#    include <tbb/parallel_for.h>
+#endif
+
 void apply_default_timing_constraints(const AtomNetlist& netlist,
                                       const AtomLookup& lookup,
                                       tatum::TimingConstraints& timing_constraints);
@@ -50,6 +56,68 @@ std::map<std::string, AtomPinId> find_netlist_primary_ios(const AtomNetlist& net
 std::string orig_blif_name(std::string name);
 
 std::regex glob_pattern_to_regex(const std::string& glob_pattern);
+bool glob_pattern_is_literal(const std::string& glob_pattern);
+std::string glob_pattern_literal_prefix(const std::string& glob_pattern);
+
+//Patterns with at least this many candidate names are matched in parallel
+constexpr size_t PARALLEL_MATCH_MIN_NAMES = 16384;
+
+/**
+ * @brief Calls on_match for each (name, value) in the sorted range [first, last) whose name matches glob_pattern
+ *
+ * Literal patterns are looked up directly, and other patterns are only matched against the
+ * names which share their literal prefix. This is equivalent to matching every name in the
+ * range with glob_pattern_to_regex(), but avoids scanning all the names of large netlists
+ * for every SDC command.
+ */
+template<class Iter, class F>
+void for_each_glob_match(Iter first, Iter last, const std::string& glob_pattern, F on_match) {
+    auto name_less = [](const auto& entry, const std::string& str) { return entry.first < str; };
+
+    if (glob_pattern_is_literal(glob_pattern)) {
+        for (Iter iter = std::lower_bound(first, last, glob_pattern, name_less); iter != last && iter->first == glob_pattern; ++iter) {
+            on_match(iter->second);
+        }
+        return;
+    }
+
+    std::string prefix = glob_pattern_literal_prefix(glob_pattern);
+    Iter range_begin = std::lower_bound(first, last, prefix, name_less);
+    Iter range_end = range_begin;
+    while (range_end != last && range_end->first.compare(0, prefix.size(), prefix) == 0) {
+        ++range_end;
+    }
+
+    const std::regex regex = glob_pattern_to_regex(glob_pattern);
+    size_t num_names = std::distance(range_begin, range_end);
+
+    //Flag the matches (possibly in parallel), then report them in order
+    std::vector<char> matched(num_names, false);
+    auto match_names = [&](size_t begin, size_t end) {
+        Iter iter = std::next(range_begin, begin);
+        for (size_t i = begin; i < end; ++i, ++iter) {
+            matched[i] = std::regex_match(iter->first, regex);
+        }
+    };
+#ifdef VPR_USE_TBB
+    if (num_names >= PARALLEL_MATCH_MIN_NAMES) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, num_names), [&](const tbb::blocked_range<size_t>& range) {
+            match_names(range.begin(), range.end());
+        });
+    } else {
+        match_names(0, num_names);
+    }
+#else
+    match_names(0, num_names);
+#endif
+
+    Iter iter = range_begin;
+    for (size_t i = 0; i < num_names; ++i, ++iter) {
+        if (matched[i]) {
+            on_match(iter->second);
+        }
+    }
+}
 
 class SdcParseCallback : public sdcparse::Callback {
   public:
@@ -871,19 +939,12 @@ class SdcParseCallback : public sdcparse::Callback {
 
         std::set<AtomPinId> pins;
         for (const auto& port_pattern : port_group.strings) {
-            std::regex port_regex = glob_pattern_to_regex(port_pattern);
-
             bool found = false;
-            for (const auto& kv : netlist_primary_ios_) {
-                const std::string& io_name = kv.first;
-                if (std::regex_match(io_name, port_regex)) {
-                    found = true;
+            for_each_glob_match(netlist_primary_ios_.begin(), netlist_primary_ios_.end(), port_pattern, [&](AtomPinId pin) {
+                found = true;
 
-                    AtomPinId pin = kv.second;
-
-                    pins.insert(pin);
-                }
-            }
+                pins.insert(pin);
+            });
 
             if (!found) {
                 VTR_LOGF_WARN(fname_.c_str(), lineno_,
@@ -968,19 +1029,21 @@ class SdcParseCallback : public sdcparse::Callback {
                       "Expected pin collection via get_pins");
         }
 
-        for (const auto& pin_pattern : pin_group.strings) {
-            std::regex pin_regex = glob_pattern_to_regex(pin_pattern);
-
-            bool found = false;
+        if (sorted_pin_names_.empty()) {
+            //Build the pin name index on first use, since pin names are constructed on demand
             for (AtomPinId pin : netlist_.pins()) {
-                const std::string& pin_name = netlist_.pin_name(pin);
+                sorted_pin_names_.emplace_back(netlist_.pin_name(pin), pin);
+            }
+            std::sort(sorted_pin_names_.begin(), sorted_pin_names_.end());
+        }
 
-                if (std::regex_match(pin_name, pin_regex)) {
-                    found = true;
+        for (const auto& pin_pattern : pin_group.strings) {
+            bool found = false;
+            for_each_glob_match(sorted_pin_names_.begin(), sorted_pin_names_.end(), pin_pattern, [&](AtomPinId pin) {
+                found = true;
 
-                    pins.insert(pin);
-                }
-            }
+                pins.insert(pin);
+            });
 
             if (!found) {
                 VTR_LOGF_WARN(fname_.c_str(), lineno_,
@@ -1046,6 +1109,7 @@ class SdcParseCallback : public sdcparse::Callback {
     std::map<tatum::DomainId, sdcparse::CreateClock> sdc_clocks_;
     std::set<AtomPinId> netlist_clock_drivers_;
     std::map<std::string, AtomPinId> netlist_primary_ios_;
+    std::vector<std::pair<std::string, AtomPinId>> sorted_pin_names_; //All netlist pin names, sorted by name
 
     std::set<std::pair<tatum::DomainId, tatum::DomainId>> disabled_domain_pairs_;
     std::map<std::pair<tatum::DomainId, tatum::DomainId>, float> setup_override_constraints_;
@@ -1331,3 +1395,27 @@ std::regex glob_pattern_to_regex(const std::string& glob_pattern) {
 
     return std::regex(regex_str);
 }
+
+bool glob_pattern_is_literal(const std::string& glob_pattern) {
+    //Other than '*' and '.' (see glob_pattern_to_regex()), these characters keep their regex meaning
+    return glob_pattern.find_first_of("*?+[](){}|^$\\") == std::string::npos;
+}
+
+std::string glob_pattern_literal_prefix(const std::string& glob_pattern) {
+    if (glob_pattern.find('|') != std::string::npos) {
+        //Alternatives need not share a prefix
+        return std::string();
+    }
+
+    size_t pos = glob_pattern.find_first_of("*?+[](){}^$\\");
+    if (pos == std::string::npos) {
+        return glob_pattern;
+    }
+
+    std::string prefix = glob_pattern.substr(0, pos);
+    if (!prefix.empty() && (glob_pattern[pos] == '?' || glob_pattern[pos] == '+' || glob_pattern[pos] == '{')) {
+        //The last character of the prefix is quantified, so may not appear
+        prefix.pop_back();
+    }
+    return prefix;
+}
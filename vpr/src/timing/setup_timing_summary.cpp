@@ -0,0 +1,278 @@
+#include "setup_timing_summary.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tatum/TimingGraph.hpp"
+#include "tatum/error.hpp"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vpr_error.h"
+
+//Fraction of the timing graph nodes modified by an analysis beyond which the summary
+//is recomputed from scratch (re-visiting each modified end-point costs a heap update)
+constexpr float FULL_UPDATE_MODIFIED_NODE_FRACTION = 0.5;
+
+//Returns the slack of a timing end-point tag, checking it is usable as tatum::find_critical_paths() does
+static float endpoint_slack(const tatum::TimingTag& tag, const tatum::NodeId node) {
+    tatum::Time slack = tag.time();
+    if (!slack.valid()) {
+        throw tatum::Error("slack is not valid", node);
+    }
+    return slack.value();
+}
+
+SetupTimingSummary::SetupTimingSummary(const tatum::TimingGraph& timing_graph, const tatum::TimingConstraints& timing_constraints)
+    : timing_graph_(timing_graph)
+    , timing_constraints_(timing_constraints) {
+    //pass
+}
+
+SetupTimingSummary::~SetupTimingSummary() {
+    VTR_LOG("Full Setup Timing Summary updates %zu in %g sec\n", full_updates_, full_update_time_sec_);
+    VTR_LOG("Incr Setup Timing Summary updates %zu in %g sec\n", incr_updates_, incr_update_time_sec_);
+}
+
+std::vector<tatum::TimingPathInfo> SetupTimingSummary::critical_paths() const {
+    std::vector<tatum::TimingPathInfo> cpds;
+
+    //As in tatum::find_critical_paths(), the critical path delay (CPD) of a domain pair is its
+    //constraint minus the least slack of its end-points
+    for (size_t idomain_pair = 0; idomain_pair < domain_pairs_.size(); idomain_pair++) {
+        const std::vector<size_t>& heap = heaps_[idomain_pair];
+        if (heap.empty()) continue;
+
+        const DomainPair& domain_pair = domain_pairs_[idomain_pair];
+        const t_slot& worst_slot = slots_[heap.front()];
+        tatum::NodeId node = endpoints_[worst_slot.endpoint];
+
+        tatum::Time constraint = tatum::Time(timing_constraints_.setup_constraint(domain_pair.launch, domain_pair.capture));
+        if (!constraint.valid()) {
+            throw tatum::Error("constraint is not valid", node);
+        }
+
+        tatum::Time slack = tatum::Time(worst_slot.slack);
+        tatum::Time cpd = constraint - slack;
+        if (!cpd.valid()) {
+            throw tatum::Error("cpd is not valid", node);
+        }
+
+        cpds.emplace_back(tatum::TimingType::SETUP,
+                          cpd, slack,
+                          tatum::NodeId::INVALID(), //Not traced back to the start point
+                          node,
+                          domain_pair.launch, domain_pair.capture);
+    }
+
+    return cpds;
+}
+
+float SetupTimingSummary::total_negative_slack() const {
+    return total_negative_slack_;
+}
+
+float SetupTimingSummary::worst_negative_slack() const {
+    float wns = 0.;
+    for (const std::vector<size_t>& heap : heaps_) {
+        if (!heap.empty()) {
+            wns = std::min(wns, slots_[heap.front()].slack);
+        }
+    }
+    return wns;
+}
+
+void SetupTimingSummary::update(const tatum::SetupTimingAnalyzer& analyzer) {
+    vtr::Timer timer;
+
+    auto modified_nodes = analyzer.modified_nodes();
+
+    bool updated = false;
+    if (valid_ && modified_nodes.size() < FULL_UPDATE_MODIFIED_NODE_FRACTION * timing_graph_.nodes().size()) {
+        updated = true;
+        for (tatum::NodeId node : modified_nodes) {
+            size_t iendpoint = node_endpoint_[size_t(node)];
+            if (iendpoint != NO_ENDPOINT && !update_endpoint(iendpoint, analyzer)) {
+                updated = false;
+                break;
+            }
+        }
+    }
+
+    if (updated) {
+        ++incr_updates_;
+        incr_update_time_sec_ += timer.elapsed_sec();
+    } else {
+        recompute(analyzer);
+
+        ++full_updates_;
+        full_update_time_sec_ += timer.elapsed_sec();
+    }
+
+    VTR_ASSERT_DEBUG_MSG(verify(analyzer), "Updated setup timing summary should match the one computed from scratch");
+}
+
+void SetupTimingSummary::recompute(const tatum::SetupTimingAnalyzer& analyzer) {
+    endpoints_.clear();
+    node_endpoint_.assign(timing_graph_.nodes().size(), NO_ENDPOINT);
+    slots_.clear();
+    first_slot_.clear();
+    endpoint_tns_.clear();
+    total_negative_slack_ = 0.;
+    domain_pair_index_.clear();
+    domain_pairs_.clear();
+    heaps_.clear();
+
+    for (tatum::NodeId node : timing_graph_.logical_outputs()) {
+        size_t iendpoint = endpoints_.size();
+        endpoints_.push_back(node);
+        node_endpoint_[size_t(node)] = iendpoint;
+        first_slot_.push_back(slots_.size());
+
+        float tns = 0.;
+        for (const tatum::TimingTag& tag : analyzer.setup_slacks(node)) {
+            float slack = endpoint_slack(tag, node);
+            size_t idomain_pair = domain_pair_index(DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain()));
+
+            heaps_[idomain_pair].push_back(slots_.size());
+            slots_.push_back({iendpoint, idomain_pair, slack, heaps_[idomain_pair].size() - 1});
+
+            if (slack < 0.) {
+                tns += slack;
+            }
+        }
+        endpoint_tns_.push_back(tns);
+        total_negative_slack_ += tns;
+    }
+    first_slot_.push_back(slots_.size());
+
+    //Heapify
+    for (std::vector<size_t>& heap : heaps_) {
+        for (size_t pos = heap.size() / 2; pos-- > 0;) {
+            sift_down(heap, pos);
+        }
+    }
+
+    valid_ = true;
+}
+
+bool SetupTimingSummary::update_endpoint(size_t iendpoint, const tatum::SetupTimingAnalyzer& analyzer) {
+    tatum::NodeId node = endpoints_[iendpoint];
+
+    size_t islot = first_slot_[iendpoint];
+    size_t end_slot = first_slot_[iendpoint + 1];
+
+    float tns = 0.;
+    for (const tatum::TimingTag& tag : analyzer.setup_slacks(node)) {
+        if (islot == end_slot) return false;
+
+        t_slot& slot = slots_[islot];
+        if (!(domain_pairs_[slot.domain_pair] == DomainPair(tag.launch_clock_domain(), tag.capture_clock_domain()))) {
+            return false;
+        }
+
+        float slack = endpoint_slack(tag, node);
+        if (slack != slot.slack) {
+            slot.slack = slack;
+
+            std::vector<size_t>& heap = heaps_[slot.domain_pair];
+            sift_up(heap, slot.heap_pos);
+            sift_down(heap, slots_[islot].heap_pos);
+        }
+
+        if (slack < 0.) {
+            tns += slack;
+        }
+        ++islot;
+    }
+    if (islot != end_slot) return false;
+
+    total_negative_slack_ += double(tns) - double(endpoint_tns_[iendpoint]);
+    endpoint_tns_[iendpoint] = tns;
+
+    return true;
+}
+
+size_t SetupTimingSummary::domain_pair_index(const DomainPair& domain_pair) {
+    auto result = domain_pair_index_.emplace(domain_pair, domain_pairs_.size());
+    if (result.second) {
+        domain_pairs_.push_back(domain_pair);
+        heaps_.emplace_back();
+    }
+    return result.first->second;
+}
+
+bool SetupTimingSummary::slot_less(size_t lhs, size_t rhs) const {
+    float lhs_slack = slots_[lhs].slack;
+    float rhs_slack = slots_[rhs].slack;
+    return lhs_slack < rhs_slack || (lhs_slack == rhs_slack && lhs < rhs);
+}
+
+void SetupTimingSummary::sift_up(std::vector<size_t>& heap, size_t pos) {
+    size_t islot = heap[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!slot_less(islot, heap[parent])) break;
+
+        heap[pos] = heap[parent];
+        slots_[heap[pos]].heap_pos = pos;
+        pos = parent;
+    }
+    heap[pos] = islot;
+    slots_[islot].heap_pos = pos;
+}
+
+void SetupTimingSummary::sift_down(std::vector<size_t>& heap, size_t pos) {
+    size_t islot = heap[pos];
+    while (true) {
+        size_t child = 2 * pos + 1;
+        if (child >= heap.size()) break;
+        if (child + 1 < heap.size() && slot_less(heap[child + 1], heap[child])) {
+            ++child;
+        }
+        if (!slot_less(heap[child], islot)) break;
+
+        heap[pos] = heap[child];
+        slots_[heap[pos]].heap_pos = pos;
+        pos = child;
+    }
+    heap[pos] = islot;
+    slots_[islot].heap_pos = pos;
+}
+
+bool SetupTimingSummary::verify(const tatum::SetupTimingAnalyzer& analyzer) const {
+    auto calc_cpds = critical_paths();
+    auto cpds = tatum::find_critical_paths(timing_graph_, timing_constraints_, analyzer);
+
+    if (calc_cpds.size() != cpds.size()) {
+        VPR_ERROR(VPR_ERROR_TIMING,
+                  "Calculated number of critical paths does not match value calculated from scratch");
+        return false;
+    }
+    for (size_t ipath = 0; ipath < cpds.size(); ipath++) {
+        if (calc_cpds[ipath].launch_domain() != cpds[ipath].launch_domain()
+            || calc_cpds[ipath].capture_domain() != cpds[ipath].capture_domain()
+            || calc_cpds[ipath].delay().value() != cpds[ipath].delay().value()) {
+            VPR_ERROR(VPR_ERROR_TIMING,
+                      "Calculated critical path does not match value calculated from scratch");
+            return false;
+        }
+    }
+
+    //The total is accumulated in a different order (and precision), so only matches approximately
+    double tns = 0.;
+    for (tatum::NodeId node : timing_graph_.logical_outputs()) {
+        for (const tatum::TimingTag& tag : analyzer.setup_slacks(node)) {
+            if (tag.time().value() < 0.) {
+                tns += tag.time().value();
+            }
+        }
+    }
+    if (std::abs(tns - total_negative_slack_) > 1e-5 * std::abs(tns)) {
+        VPR_ERROR(VPR_ERROR_TIMING,
+                  "Calculated total negative slack does not match value calculated from scratch");
+        return false;
+    }
+
+    return true;
+}
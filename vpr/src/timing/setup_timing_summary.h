@@ -0,0 +1,93 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "DomainPair.h"
+#include "tatum/timing_analyzers.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/timing_paths.hpp"
+
+/*
+ * SetupTimingSummary keeps the setup timing summary of the timing end-points (i.e. the
+ * logical outputs of the timing graph): the critical path of each clock domain pair, and
+ * the total negative slack.
+ *
+ * It produces the same results as scanning every end-point (tatum::find_critical_paths(),
+ * find_setup_total_negative_slack() etc.), but update() only re-visits the end-points
+ * modified by the last timing analysis. It keeps a heap of end-point slacks for each
+ * clock domain pair, and a running total of the negative slacks.
+ */
+class SetupTimingSummary {
+  public: //Constructors
+    SetupTimingSummary(const tatum::TimingGraph& timing_graph, const tatum::TimingConstraints& timing_constraints);
+    ~SetupTimingSummary();
+
+  public: //Accessors
+    //Returns the critical path of each clock domain pair, as tatum::find_critical_paths()
+    std::vector<tatum::TimingPathInfo> critical_paths() const;
+
+    //Returns the total negative slack of all timing end-points and clock domain pairs
+    float total_negative_slack() const;
+
+    //Returns the worst negative slack across all timing end-points and clock domain pairs
+    float worst_negative_slack() const;
+
+  public: //Mutators
+    //Updates the summary from the end-point slacks of the last timing analysis performed by analyzer.
+    //Re-visits only the modified end-points when possible.
+    void update(const tatum::SetupTimingAnalyzer& analyzer);
+
+  private: //Types
+    //The slack of an end-point for one clock domain pair
+    struct t_slot {
+        size_t endpoint;
+        size_t domain_pair;
+        float slack;
+        size_t heap_pos; //Position in the heap of domain_pair
+    };
+
+    static constexpr size_t NO_ENDPOINT = size_t(-1);
+
+  private: //Implementation
+    //Rebuilds the summary from the slacks of all end-points
+    void recompute(const tatum::SetupTimingAnalyzer& analyzer);
+
+    //Updates the slacks of an end-point, returns false if its clock domain pairs changed
+    //(which requires the summary to be recomputed)
+    bool update_endpoint(size_t iendpoint, const tatum::SetupTimingAnalyzer& analyzer);
+
+    size_t domain_pair_index(const DomainPair& domain_pair);
+
+    //Heaps of slots, with the least slack first (and ties broken by end-point order, as in tatum::find_critical_paths())
+    bool slot_less(size_t lhs, size_t rhs) const;
+    void sift_up(std::vector<size_t>& heap, size_t pos);
+    void sift_down(std::vector<size_t>& heap, size_t pos);
+
+    //Sanity check that the summary matches the one calculated from scratch
+    bool verify(const tatum::SetupTimingAnalyzer& analyzer) const;
+
+  private: //Data
+    const tatum::TimingGraph& timing_graph_;
+    const tatum::TimingConstraints& timing_constraints_;
+
+    bool valid_ = false; //Whether the summary has been computed since construction
+
+    std::vector<tatum::NodeId> endpoints_;
+    std::vector<size_t> node_endpoint_; //End-point index of each timing graph node (or NO_ENDPOINT)
+
+    std::vector<t_slot> slots_;        //Slots of all end-points, in end-point order
+    std::vector<size_t> first_slot_;   //First slot of each end-point (with a final entry for the end)
+    std::vector<float> endpoint_tns_;  //Negative slack of each end-point (summed over its clock domain pairs)
+    double total_negative_slack_ = 0.; //Accumulated in double precision to avoid drifting across updates
+
+    std::map<DomainPair, size_t> domain_pair_index_;
+    std::vector<DomainPair> domain_pairs_;     //In the order they were first found, as in tatum::find_critical_paths()
+    std::vector<std::vector<size_t>> heaps_;   //Slot heap of each clock domain pair
+
+    //Run-time metrics
+    size_t full_updates_ = 0;
+    float full_update_time_sec_ = 0.;
+    size_t incr_updates_ = 0;
+    float incr_update_time_sec_ = 0.;
+};
@@ -216,9 +216,17 @@
  * for convenience (i.e. both map to the same tnode).
  *
  */
+#include <algorithm>
+#include <limits>
 #include <set>
+#include <unordered_map>
+
+#ifdef VPR_USE_TBB
+#    include <tbb/parallel_for.h>
+#endif
 
 #include "vtr_log.h"
+#include "vtr_util.h"
 #include "vtr_linear_map.h"
 
 #include "timing_graph_builder.h"
@@ -234,6 +242,88 @@ using tatum::NodeId;
 using tatum::NodeType;
 using tatum::TimingGraph;
 
+///@brief A tnode of a block's timing sub-graph and the atom pin look-up it is recorded in
+struct t_block_pin_tnode {
+    AtomPinId pin;
+    size_t tnode; ///<Index of the tnode within the sub-graph
+    BlockTnode block_tnode_type;
+};
+
+///@brief A timing edge between two tnodes of a block's timing sub-graph
+struct t_block_tedge {
+    tatum::EdgeType type;
+    size_t src_tnode;
+    size_t sink_tnode;
+};
+
+///@brief A message reported while building a sub-graph, logged once it is added to the timing graph
+struct t_block_timing_message {
+    std::string warning; ///<The warning, or empty for a clock buffer edge
+    size_t clock_edge = 0;
+    AtomPinId src_pin;
+    AtomPinId sink_pin;
+};
+
+/**
+ * @brief The timing nodes and internal edges of a netlist block
+ *
+ * Sub-graphs only depend on the netlist, so those of different blocks can be built
+ * concurrently. The tnodes are numbered within the sub-graph, and are offset when
+ * added to the timing graph.
+ */
+struct t_block_timing_subgraph {
+    static constexpr size_t NO_TNODE = std::numeric_limits<size_t>::max();
+
+    std::vector<NodeType> tnode_types;
+    std::vector<t_block_pin_tnode> pin_tnodes;
+    std::vector<t_block_tedge> tedges;
+    std::vector<t_block_timing_message> messages;
+    bool allow_dangling_combinational_nodes = false;
+
+    size_t add_tnode(NodeType type) {
+        tnode_types.push_back(type);
+        return tnode_types.size() - 1;
+    }
+
+    void add_tedge(tatum::EdgeType type, size_t src_tnode, size_t sink_tnode) {
+        tedges.push_back({type, src_tnode, sink_tnode});
+    }
+
+    void set_pin_tnode(AtomPinId pin, size_t tnode, BlockTnode block_tnode_type) {
+        pin_tnodes.push_back({pin, tnode, block_tnode_type});
+        pin_lookup(block_tnode_type)[pin] = tnode;
+    }
+
+    ///@brief Returns the tnode of pin, or NO_TNODE
+    size_t pin_tnode(AtomPinId pin, BlockTnode block_tnode_type) const {
+        const auto& lookup = (block_tnode_type == BlockTnode::EXTERNAL) ? external_pin_tnodes : internal_pin_tnodes;
+        auto iter = lookup.find(pin);
+        return (iter != lookup.end()) ? iter->second : NO_TNODE;
+    }
+
+    void add_warning(std::string warning) {
+        messages.push_back({std::move(warning), 0, AtomPinId::INVALID(), AtomPinId::INVALID()});
+    }
+
+    ///@brief Records a message for the last added edge (a clock buffer)
+    void add_clock_edge_message(AtomPinId src_pin, AtomPinId sink_pin) {
+        messages.push_back({std::string(), tedges.size() - 1, src_pin, sink_pin});
+    }
+
+    void clear_pin_lookups() {
+        std::unordered_map<AtomPinId, size_t>().swap(external_pin_tnodes);
+        std::unordered_map<AtomPinId, size_t>().swap(internal_pin_tnodes);
+    }
+
+  private:
+    std::unordered_map<AtomPinId, size_t>& pin_lookup(BlockTnode block_tnode_type) {
+        return (block_tnode_type == BlockTnode::EXTERNAL) ? external_pin_tnodes : internal_pin_tnodes;
+    }
+
+    std::unordered_map<AtomPinId, size_t> external_pin_tnodes;
+    std::unordered_map<AtomPinId, size_t> internal_pin_tnodes;
+};
+
 template<class K, class V>
 tatum::util::linear_map<K, V> remap_valid(const tatum::util::linear_map<K, V>& data, const tatum::util::linear_map<K, K>& id_map) {
     tatum::util::linear_map<K, V> new_data;
@@ -278,19 +368,53 @@ void TimingGraphBuilder::build(bool allow_dangling_combinational_nodes) {
     // Set by `--allow_dangling_combinational_nodes on`. Default value is false
     tg_->set_allow_dangling_combinational_nodes(allow_dangling_combinational_nodes);
 
+    //Reserve (approximately) the graph's size up-front, most pins correspond to a single
+    //tnode, and most edges to net connections
+    size_t num_net_edges = 0;
+    for (AtomNetId net : netlist_.nets()) {
+        num_net_edges += netlist_.net_sinks(net).size();
+    }
+    tg_->reserve(netlist_.pins().size(), num_net_edges + netlist_.pins().size());
+
     //Walk through the netlist blocks creating the timing sub-graphs corresponding to
     //each block (i.e. the timing nodes and internal edges of the block)
     //
     //Note that this does not add timing graph edges which are external to each block.
-    for (AtomBlockId blk : netlist_.blocks()) {
-        AtomBlockType blk_type = netlist_.block_type(blk);
+    //
+    //The sub-graphs of a batch of blocks are built concurrently (they only depend on the
+    //netlist), and then added to the timing graph in block order, so the timing graph is
+    //identical to one built serially.
+    constexpr size_t BLOCKS_PER_BATCH = 1 << 16;
+    auto blocks = netlist_.blocks();
+    std::vector<t_block_timing_subgraph> subgraphs;
+    for (size_t batch_begin = 0; batch_begin < blocks.size(); batch_begin += BLOCKS_PER_BATCH) {
+        size_t batch_size = std::min(BLOCKS_PER_BATCH, blocks.size() - batch_begin);
+        subgraphs.clear();
+        subgraphs.resize(batch_size);
+
+        auto build_subgraph = [&](size_t i) {
+            AtomBlockId blk = *(blocks.begin() + batch_begin + i);
+            AtomBlockType blk_type = netlist_.block_type(blk);
+
+            if (blk_type == AtomBlockType::INPAD || blk_type == AtomBlockType::OUTPAD) {
+                build_io_timing_subgraph(blk, subgraphs[i]);
+            } else if (blk_type == AtomBlockType::BLOCK) {
+                build_block_timing_subgraph(blk, subgraphs[i]);
+            } else {
+                VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unrecognized atom block type while constructing timing graph");
+            }
+        };
 
-        if (blk_type == AtomBlockType::INPAD || blk_type == AtomBlockType::OUTPAD) {
-            add_io_to_timing_graph(blk);
-        } else if (blk_type == AtomBlockType::BLOCK) {
-            add_block_to_timing_graph(blk);
-        } else {
-            VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unrecognized atom block type while constructing timing graph");
+#ifdef VPR_USE_TBB
+        tbb::parallel_for(size_t(0), batch_size, build_subgraph);
+#else
+        for (size_t i = 0; i < batch_size; ++i) {
+            build_subgraph(i);
+        }
+#endif
+
+        for (const t_block_timing_subgraph& subgraph : subgraphs) {
+            add_subgraph_to_timing_graph(subgraph);
         }
     }
 
@@ -323,8 +447,44 @@ void TimingGraphBuilder::opt_memory_layout() {
     remap_ids(id_map);
 }
 
-//Creates the timing graph nodes for the associated primary I/O
-void TimingGraphBuilder::add_io_to_timing_graph(const AtomBlockId blk) {
+//Adds the nodes and internal edges of a block's timing sub-graph to the timing graph
+void TimingGraphBuilder::add_subgraph_to_timing_graph(const t_block_timing_subgraph& subgraph) {
+    size_t first_tnode = tg_->nodes().size();
+    auto tnode_id = [&](size_t local_tnode) {
+        return NodeId(first_tnode + local_tnode);
+    };
+
+    for (NodeType node_type : subgraph.tnode_types) {
+        tg_->add_node(node_type);
+    }
+
+    for (const t_block_pin_tnode& pin_tnode : subgraph.pin_tnodes) {
+        netlist_lookup_.set_atom_pin_tnode(pin_tnode.pin, tnode_id(pin_tnode.tnode), pin_tnode.block_tnode_type);
+    }
+
+    for (const t_block_tedge& tedge : subgraph.tedges) {
+        tg_->add_edge(tedge.type, tnode_id(tedge.src_tnode), tnode_id(tedge.sink_tnode));
+    }
+
+    for (const t_block_timing_message& message : subgraph.messages) {
+        if (!message.warning.empty()) {
+            VTR_LOG_WARN("%s", message.warning.c_str());
+        } else {
+            //A clock buffer edge
+            const t_block_tedge& tedge = subgraph.tedges[message.clock_edge];
+            VTR_LOG("Adding edge from '%s' (tnode: %zu) -> '%s' (tnode: %zu) to allow clocks to propagate\n",
+                    netlist_.pin_name(message.src_pin).c_str(), size_t(tnode_id(tedge.src_tnode)),
+                    netlist_.pin_name(message.sink_pin).c_str(), size_t(tnode_id(tedge.sink_tnode)));
+        }
+    }
+
+    if (subgraph.allow_dangling_combinational_nodes) {
+        tg_->set_allow_dangling_combinational_nodes(true);
+    }
+}
+
+//Builds the timing sub-graph (a single node) for the associated primary I/O
+void TimingGraphBuilder::build_io_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
     NodeType node_type;
     AtomPinId pin;
     if (netlist_.block_type(blk) == AtomBlockType::INPAD) {
@@ -351,13 +511,13 @@ void TimingGraphBuilder::add_io_to_timing_graph(const AtomBlockId blk) {
         }
     }
 
-    NodeId tnode = tg_->add_node(node_type);
+    size_t tnode = subgraph.add_tnode(node_type);
 
-    netlist_lookup_.set_atom_pin_tnode(pin, tnode, BlockTnode::EXTERNAL);
+    subgraph.set_pin_tnode(pin, tnode, BlockTnode::EXTERNAL);
 }
 
-//Creates the timing graph nodes and internal edges for a netlist block
-void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
+//Builds the timing sub-graph (the timing nodes and internal edges) for a netlist block
+void TimingGraphBuilder::build_block_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
     /*
      * How the code builds the primtive timing sub-graph
      * -------------------------------------------------
@@ -391,15 +551,18 @@ void TimingGraphBuilder::add_block_to_timing_graph(const AtomBlockId blk) {
      * SOURCE (and leave any combinational inputs to that node disconnected).
      */
 
-    auto clock_generator_tnodes = create_block_timing_nodes(blk);
-    create_block_internal_data_timing_edges(blk, clock_generator_tnodes);
-    create_block_internal_clock_timing_edges(blk, clock_generator_tnodes);
+    auto clock_generator_tnodes = create_block_timing_nodes(blk, subgraph);
+    create_block_internal_data_timing_edges(blk, clock_generator_tnodes, subgraph);
+    create_block_internal_clock_timing_edges(blk, clock_generator_tnodes, subgraph);
+
+    //The pin look-ups are only needed while building the sub-graph
+    subgraph.clear_pin_lookups();
 }
 
 //Constructs the timing graph nodes for the specified block
 //
-//Returns the set of created tnodese which are clock generators
-std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const AtomBlockId blk) {
+//Returns the set of created tnodes (within the sub-graph) which are clock generators
+std::set<size_t> TimingGraphBuilder::create_block_timing_nodes(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const {
     std::set<std::string> output_ports_used_as_combinational_sinks;
 
     //Create the tnodes corresponding to input pins
@@ -409,26 +572,26 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
         //Inspect the port model to determine pin type
         const t_model_ports* model_port = netlist_.port_model(input_port);
 
-        NodeId tnode;
+        size_t tnode;
         VTR_ASSERT(!model_port->is_clock);
         if (model_port->clock.empty()) {
             //No clock => combinational input
-            tnode = tg_->add_node(NodeType::IPIN);
+            tnode = subgraph.add_tnode(NodeType::IPIN);
 
             //A combinational pin is really both internal and external, mark it internal here
             //and external in the default case below
-            netlist_lookup_.set_atom_pin_tnode(input_pin, tnode, BlockTnode::INTERNAL);
+            subgraph.set_pin_tnode(input_pin, tnode, BlockTnode::INTERNAL);
         } else {
             //This is a sequential data input (i.e. a sequential data capture point/timing path end-point)
-            tnode = tg_->add_node(NodeType::SINK);
+            tnode = subgraph.add_tnode(NodeType::SINK);
 
             if (!model_port->combinational_sink_ports.empty()) {
                 //There is an internal combinational connection starting at this sequential input
                 //pin. This is a new timing path and hence we must create a new SOURCE node.
 
                 //Create the internal source
-                NodeId internal_tnode = tg_->add_node(NodeType::SOURCE);
-                netlist_lookup_.set_atom_pin_tnode(input_pin, internal_tnode, BlockTnode::INTERNAL);
+                size_t internal_tnode = subgraph.add_tnode(NodeType::SOURCE);
+                subgraph.set_pin_tnode(input_pin, internal_tnode, BlockTnode::INTERNAL);
             }
         }
 
@@ -439,7 +602,7 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
                                                         model_port->combinational_sink_ports.end());
 
         //Save the pin to external tnode mapping
-        netlist_lookup_.set_atom_pin_tnode(input_pin, tnode, BlockTnode::EXTERNAL);
+        subgraph.set_pin_tnode(input_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Create the clock pins
@@ -452,23 +615,23 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
         VTR_ASSERT(model_port->is_clock);
         VTR_ASSERT(model_port->clock.empty());
 
-        NodeId tnode = tg_->add_node(NodeType::CPIN);
+        size_t tnode = subgraph.add_tnode(NodeType::CPIN);
 
-        netlist_lookup_.set_atom_pin_tnode(clock_pin, tnode, BlockTnode::EXTERNAL);
+        subgraph.set_pin_tnode(clock_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     //Create the output pins
-    std::set<tatum::NodeId> clock_generator_tnodes;
+    std::set<size_t> clock_generator_tnodes;
     for (AtomPinId output_pin : netlist_.block_output_pins(blk)) {
         AtomPortId output_port = netlist_.pin_port(output_pin);
 
         //Inspect the port model to determine pin type
         const t_model_ports* model_port = netlist_.port_model(output_port);
 
-        NodeId tnode;
+        size_t tnode;
         if (is_netlist_clock_source(output_pin)) {
             //A generated clock source
-            tnode = tg_->add_node(NodeType::SOURCE);
+            tnode = subgraph.add_tnode(NodeType::SOURCE);
 
             clock_generator_tnodes.insert(tnode);
 
@@ -476,56 +639,56 @@ std::set<tatum::NodeId> TimingGraphBuilder::create_block_timing_nodes(const Atom
                 //An implicit clock source, possibly clock derived from data
 
                 AtomNetId clock_net = netlist_.pin_net(output_pin);
-                VTR_LOG_WARN("Inferred implicit clock source %s for netlist clock %s (possibly data used as clock)\n",
-                             netlist_.pin_name(output_pin).c_str(), netlist_.net_name(clock_net).c_str());
+                subgraph.add_warning(vtr::string_fmt("Inferred implicit clock source %s for netlist clock %s (possibly data used as clock)\n",
+                                                     netlist_.pin_name(output_pin).c_str(), netlist_.net_name(clock_net).c_str()));
 
                 //This type of situation often requires cutting paths between the implicit clock source and
                 //it's inputs which can cause dangling combinational nodes. Do not error if this occurs.
-                tg_->set_allow_dangling_combinational_nodes(true);
+                subgraph.allow_dangling_combinational_nodes = true;
             }
         } else {
             VTR_ASSERT_MSG(!model_port->is_clock, "Primitive data output (i.e. non-clock source output pin) should not be marked as a clock generator");
 
             if (model_port->clock.empty()) {
                 //No clock => combinational output
-                tnode = tg_->add_node(NodeType::OPIN);
+                tnode = subgraph.add_tnode(NodeType::OPIN);
 
                 //A combinational pin is really both internal and external, mark it internal here
                 //and external in the default case below
-                netlist_lookup_.set_atom_pin_tnode(output_pin, tnode, BlockTnode::INTERNAL);
+                subgraph.set_pin_tnode(output_pin, tnode, BlockTnode::INTERNAL);
 
             } else {
                 VTR_ASSERT(!model_port->clock.empty());
                 //Has an associated clock => sequential output
-                tnode = tg_->add_node(NodeType::SOURCE);
+                tnode = subgraph.add_tnode(NodeType::SOURCE);
 
                 if (output_ports_used_as_combinational_sinks.count(model_port->name)) {
                     //There is a combinational path within the primitive terminating at this sequential output
 
                     //Create the internal sink node
-                    NodeId internal_tnode = tg_->add_node(NodeType::SINK);
-                    netlist_lookup_.set_atom_pin_tnode(output_pin, internal_tnode, BlockTnode::INTERNAL);
+                    size_t internal_tnode = subgraph.add_tnode(NodeType::SINK);
+                    subgraph.set_pin_tnode(output_pin, internal_tnode, BlockTnode::INTERNAL);
                 }
             }
         }
 
         //Record as external tnode
-        netlist_lookup_.set_atom_pin_tnode(output_pin, tnode, BlockTnode::EXTERNAL);
+        subgraph.set_pin_tnode(output_pin, tnode, BlockTnode::EXTERNAL);
     }
 
     return clock_generator_tnodes;
 }
 
-void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes) {
+void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const {
     //Connect the clock pins to the sources and sinks
     for (AtomPinId pin : netlist_.block_pins(blk)) {
         for (auto blk_tnode_type : {BlockTnode::EXTERNAL, BlockTnode::INTERNAL}) {
-            NodeId tnode = netlist_lookup_.atom_pin_tnode(pin, blk_tnode_type);
-            if (!tnode) continue;
+            size_t tnode = subgraph.pin_tnode(pin, blk_tnode_type);
+            if (tnode == t_block_timing_subgraph::NO_TNODE) continue;
 
             if (clock_generator_tnodes.count(tnode)) continue; //Clock sources don't have incoming clock pin connections
 
-            auto node_type = tg_->node_type(tnode);
+            auto node_type = subgraph.tnode_types[tnode];
 
             if (node_type != NodeType::SOURCE && node_type != NodeType::SINK) continue;
 
@@ -546,8 +709,8 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
             VTR_ASSERT(clk_pin);
 
             //Convert the pin to it's tnode
-            NodeId clk_tnode = netlist_lookup_.atom_pin_tnode(clk_pin);
-            VTR_ASSERT(clk_tnode);
+            size_t clk_tnode = subgraph.pin_tnode(clk_pin, BlockTnode::EXTERNAL);
+            VTR_ASSERT(clk_tnode != t_block_timing_subgraph::NO_TNODE);
 
             //Determine the type of edge to create
             //This corresponds to how the clock (clk_tnode) relates
@@ -564,7 +727,7 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
             }
 
             //Add the edge from the clock to the source/sink
-            tg_->add_edge(type, clk_tnode, tnode);
+            subgraph.add_tedge(type, clk_tnode, tnode);
         }
     }
 
@@ -572,9 +735,9 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
     //
     //These are typically used to represent clock buffers
     for (AtomPinId src_clock_pin : netlist_.block_clock_pins(blk)) {
-        NodeId src_tnode = netlist_lookup_.atom_pin_tnode(src_clock_pin, BlockTnode::EXTERNAL);
+        size_t src_tnode = subgraph.pin_tnode(src_clock_pin, BlockTnode::EXTERNAL);
 
-        if (!src_tnode) continue;
+        if (src_tnode == t_block_timing_subgraph::NO_TNODE) continue;
 
         //Look-up the combinationally connected sink ports name on the port model
         AtomPortId src_port = netlist_.pin_port(src_clock_pin);
@@ -588,16 +751,16 @@ void TimingGraphBuilder::create_block_internal_clock_timing_edges(const AtomBloc
             //output port
             for (AtomPinId sink_pin : netlist_.port_pins(sink_port)) {
                 //Get the tnode of the sink
-                NodeId sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                size_t sink_tnode = subgraph.pin_tnode(sink_pin, BlockTnode::EXTERNAL);
 
-                tg_->add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
-                VTR_LOG("Adding edge from '%s' (tnode: %zu) -> '%s' (tnode: %zu) to allow clocks to propagate\n", netlist_.pin_name(src_clock_pin).c_str(), size_t(src_tnode), netlist_.pin_name(sink_pin).c_str(), size_t(sink_tnode));
+                subgraph.add_tedge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
+                subgraph.add_clock_edge_message(src_clock_pin, sink_pin); //Reported with the final tnode ids
             }
         }
     }
 }
 
-void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes) {
+void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const {
     //Connect the combinational edges from data input pins
     //
     //These edges may represent an intermediate (combinational) sub-path of a
@@ -611,11 +774,11 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
         //Note that we have already created all the relevant nodes, and appropriately labelled them as
         //internal/external. As a result, we only need to consider the 'internal' tnodes when creating
         //the edges within the current block.
-        NodeId src_tnode = netlist_lookup_.atom_pin_tnode(src_pin, BlockTnode::INTERNAL);
+        size_t src_tnode = subgraph.pin_tnode(src_pin, BlockTnode::INTERNAL);
 
-        if (!src_tnode) continue;
+        if (src_tnode == t_block_timing_subgraph::NO_TNODE) continue;
 
-        auto src_type = tg_->node_type(src_tnode);
+        auto src_type = subgraph.tnode_types[src_tnode];
 
         //Look-up the combinationally connected sink ports name on the port model
         AtomPortId src_port = netlist_.pin_port(src_pin);
@@ -630,19 +793,19 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
             //output port
             for (AtomPinId sink_pin : netlist_.port_pins(sink_port)) {
                 //Get the tnode of the sink
-                NodeId sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::INTERNAL);
+                size_t sink_tnode = subgraph.pin_tnode(sink_pin, BlockTnode::INTERNAL);
 
-                if (!sink_tnode) {
+                if (sink_tnode == t_block_timing_subgraph::NO_TNODE) {
                     //No tnode found, either a combinational clock generator or an error
 
                     //Try again looking for an external tnode
-                    sink_tnode = netlist_lookup_.atom_pin_tnode(sink_pin, BlockTnode::EXTERNAL);
+                    sink_tnode = subgraph.pin_tnode(sink_pin, BlockTnode::EXTERNAL);
 
                     //Is the sink a clock generator?
-                    if (sink_tnode && clock_generator_tnodes.count(sink_tnode)) {
+                    if (sink_tnode != t_block_timing_subgraph::NO_TNODE && clock_generator_tnodes.count(sink_tnode)) {
                         //Do not create the edge
-                        VTR_LOG_WARN("Timing edge from %s to %s will not be created since %s has been identified as a clock generator\n",
-                                     netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(sink_pin).c_str(), netlist_.pin_name(sink_pin).c_str());
+                        subgraph.add_warning(vtr::string_fmt("Timing edge from %s to %s will not be created since %s has been identified as a clock generator\n",
+                                                             netlist_.pin_name(src_pin).c_str(), netlist_.pin_name(sink_pin).c_str(), netlist_.pin_name(sink_pin).c_str()));
                     } else {
                         //Unknown
                         VPR_FATAL_ERROR(VPR_ERROR_TIMING, "Unable to find matching sink tnode for timing edge from %s to %s",
@@ -651,7 +814,7 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
 
                 } else {
                     //Valid tnode create the edge
-                    auto sink_type = tg_->node_type(sink_tnode);
+                    auto sink_type = subgraph.tnode_types[sink_tnode];
 
                     VTR_ASSERT_MSG((src_type == NodeType::IPIN && sink_type == NodeType::OPIN)
                                        || (src_type == NodeType::SOURCE && sink_type == NodeType::SINK)
@@ -660,7 +823,7 @@ void TimingGraphBuilder::create_block_internal_data_timing_edges(const AtomBlock
                                    "Internal primitive combinational edges must be between {IPIN, SOURCE} and {OPIN, SINK}");
 
                     //Add the edge between the pins
-                    tg_->add_edge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
+                    subgraph.add_tedge(tatum::EdgeType::PRIMITIVE_COMBINATIONAL, src_tnode, sink_tnode);
                 }
             }
         }
@@ -5,6 +5,8 @@
 #include "atom_netlist_fwd.h"
 #include "atom_lookup.h"
 
+struct t_block_timing_subgraph;
+
 /*
  * Class for constructing a Timing Graph (a tatum::TimingGraph, for use with the Tatum 
  * STA engine) from the provided AtomNetlist. It also updates the provided AtomLookup 
@@ -27,14 +29,17 @@ class TimingGraphBuilder {
     void build(bool allow_dangling_combinational_nodes);
     void opt_memory_layout();
 
-    void add_io_to_timing_graph(const AtomBlockId blk);
-    void add_block_to_timing_graph(const AtomBlockId blk);
+    //Build the timing sub-graph of a block (safe to call concurrently)
+    void build_io_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
+    void build_block_timing_subgraph(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
+
+    void add_subgraph_to_timing_graph(const t_block_timing_subgraph& subgraph);
     void add_net_to_timing_graph(const AtomNetId net);
 
-    //Helper functions for add_block_to_timing_graph()
-    std::set<tatum::NodeId> create_block_timing_nodes(const AtomBlockId blk);
-    void create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes);
-    void create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<tatum::NodeId>& clock_generator_tnodes);
+    //Helper functions for build_block_timing_subgraph()
+    std::set<size_t> create_block_timing_nodes(const AtomBlockId blk, t_block_timing_subgraph& subgraph) const;
+    void create_block_internal_data_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const;
+    void create_block_internal_clock_timing_edges(const AtomBlockId blk, const std::set<size_t>& clock_generator_tnodes, t_block_timing_subgraph& subgraph) const;
 
     void fix_comb_loops();
     tatum::EdgeId find_scc_edge_to_break(std::vector<tatum::NodeId> scc);
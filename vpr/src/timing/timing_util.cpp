@@ -24,11 +24,13 @@ double sec_to_mhz(double seconds) {
  * Setup-time related
  */
 tatum::TimingPathInfo find_longest_critical_path_delay(const tatum::TimingConstraints& constraints, const tatum::SetupTimingAnalyzer& setup_analyzer) {
-    tatum::TimingPathInfo crit_path_info;
-
     auto& timing_ctx = g_vpr_ctx.timing();
 
-    auto cpds = tatum::find_critical_paths(*timing_ctx.graph, constraints, setup_analyzer);
+    return find_longest_critical_path_delay(tatum::find_critical_paths(*timing_ctx.graph, constraints, setup_analyzer));
+}
+
+tatum::TimingPathInfo find_longest_critical_path_delay(const std::vector<tatum::TimingPathInfo>& cpds) {
+    tatum::TimingPathInfo crit_path_info;
 
     //Record the maximum critical path accross all domain pairs
     for (const auto& path_info : cpds) {
@@ -41,11 +43,13 @@ tatum::TimingPathInfo find_longest_critical_path_delay(const tatum::TimingConstr
 }
 
 tatum::TimingPathInfo find_least_slack_critical_path_delay(const tatum::TimingConstraints& constraints, const tatum::SetupTimingAnalyzer& setup_analyzer) {
-    tatum::TimingPathInfo crit_path_info;
-
     auto& timing_ctx = g_vpr_ctx.timing();
 
-    auto cpds = tatum::find_critical_paths(*timing_ctx.graph, constraints, setup_analyzer);
+    return find_least_slack_critical_path_delay(tatum::find_critical_paths(*timing_ctx.graph, constraints, setup_analyzer));
+}
+
+tatum::TimingPathInfo find_least_slack_critical_path_delay(const std::vector<tatum::TimingPathInfo>& cpds) {
+    tatum::TimingPathInfo crit_path_info;
 
     //Record the maximum critical path accross all domain pairs
     for (const auto& path_info : cpds) {
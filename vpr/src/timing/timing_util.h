@@ -29,6 +29,10 @@ tatum::TimingPathInfo find_longest_critical_path_delay(const tatum::TimingConstr
 //Returns the path delay of the least-slack critical timing path (i.e. across all domains)
 tatum::TimingPathInfo find_least_slack_critical_path_delay(const tatum::TimingConstraints& constraints, const tatum::SetupTimingAnalyzer& setup_analyzer);
 
+//Returns the longest and least-slack critical timing paths amongst the critical paths of each domain pair (cpds)
+tatum::TimingPathInfo find_longest_critical_path_delay(const std::vector<tatum::TimingPathInfo>& cpds);
+tatum::TimingPathInfo find_least_slack_critical_path_delay(const std::vector<tatum::TimingPathInfo>& cpds);
+
 //Returns the total negative slack (setup) of all timing end-points and clock domain pairs
 float find_setup_total_negative_slack(const tatum::SetupTimingAnalyzer& setup_analyzer);
 
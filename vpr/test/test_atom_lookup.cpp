@@ -0,0 +1,66 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "atom_lookup.h"
+
+namespace {
+
+TEST_CASE("test_atom_lookup_clb_nets", "[vpr_atom_lookup]") {
+    AtomLookup lookup;
+
+    AtomNetId atom_net_a(0);
+    AtomNetId atom_net_b(5);
+    ClusterNetId clb_net_a(3);
+    ClusterNetId clb_net_b(1);
+
+    // Nothing mapped yet (including ids past the end of the lookups)
+    REQUIRE(lookup.clb_net(atom_net_a) == ClusterNetId::INVALID());
+    REQUIRE(lookup.atom_net(clb_net_a) == AtomNetId::INVALID());
+
+    lookup.set_atom_clb_net(atom_net_a, clb_net_a);
+    lookup.set_atom_clb_net(atom_net_b, clb_net_b);
+
+    REQUIRE(lookup.clb_net(atom_net_a) == clb_net_a);
+    REQUIRE(lookup.clb_net(atom_net_b) == clb_net_b);
+    REQUIRE(lookup.atom_net(clb_net_a) == atom_net_a);
+    REQUIRE(lookup.atom_net(clb_net_b) == atom_net_b);
+
+    // Ids in between the mapped ones are not mapped
+    REQUIRE(lookup.clb_net(AtomNetId(2)) == ClusterNetId::INVALID());
+    REQUIRE(lookup.atom_net(ClusterNetId(2)) == AtomNetId::INVALID());
+
+    // Removing a mapping removes both of its directions
+    lookup.set_atom_clb_net(atom_net_a, ClusterNetId::INVALID());
+    REQUIRE(lookup.clb_net(atom_net_a) == ClusterNetId::INVALID());
+    REQUIRE(lookup.atom_net(clb_net_a) == AtomNetId::INVALID());
+    REQUIRE(lookup.clb_net(atom_net_b) == clb_net_b);
+    REQUIRE(lookup.atom_net(clb_net_b) == atom_net_b);
+}
+
+TEST_CASE("test_atom_lookup_tnodes", "[vpr_atom_lookup]") {
+    AtomLookup lookup;
+
+    AtomPinId pin_a(0);
+    AtomPinId pin_b(4);
+    tatum::NodeId ext_a(2);
+    tatum::NodeId ext_b(0);
+    tatum::NodeId int_b(7);
+
+    REQUIRE(lookup.tnode_atom_pin(ext_a) == AtomPinId::INVALID());
+
+    lookup.set_atom_pin_tnode(pin_a, ext_a, BlockTnode::EXTERNAL);
+    lookup.set_atom_pin_tnode(pin_b, ext_b, BlockTnode::EXTERNAL);
+    lookup.set_atom_pin_tnode(pin_b, int_b, BlockTnode::INTERNAL);
+
+    REQUIRE(lookup.atom_pin_tnode(pin_a, BlockTnode::EXTERNAL) == ext_a);
+    REQUIRE(lookup.atom_pin_tnode(pin_a, BlockTnode::INTERNAL) == tatum::NodeId::INVALID());
+    REQUIRE(lookup.atom_pin_tnode(pin_b, BlockTnode::EXTERNAL) == ext_b);
+    REQUIRE(lookup.atom_pin_tnode(pin_b, BlockTnode::INTERNAL) == int_b);
+
+    REQUIRE(lookup.tnode_atom_pin(ext_a) == pin_a);
+    REQUIRE(lookup.tnode_atom_pin(ext_b) == pin_b);
+    REQUIRE(lookup.tnode_atom_pin(int_b) == pin_b);
+    REQUIRE(lookup.tnode_atom_pin(tatum::NodeId(1)) == AtomPinId::INVALID());
+    REQUIRE(lookup.tnode_atom_pin(tatum::NodeId(100)) == AtomPinId::INVALID());
+}
+
+} // namespace
@@ -147,4 +147,32 @@ TEST_CASE("test_find_block_with_matching_name", "[vpr_clustered_netlist]") {
         REQUIRE((size_t)(block_id_from_name.find("router:noc_router_four|flit_out_two[0]~reg0")->second) == (size_t)test_router_id);
     }
 }
+
+TEST_CASE("test_should_compress", "[vpr_clustered_netlist]") {
+    ClusteredNetlist test_netlist("test_netlist", "77");
+
+    std::vector<ClusterNetId> nets;
+    for (int inet = 0; inet < 10; inet++) {
+        nets.push_back(test_netlist.create_net("net_" + std::to_string(inet)));
+    }
+
+    REQUIRE(test_netlist.num_removed_ids() == 0);
+    REQUIRE(!test_netlist.should_compress(0.));
+
+    // removing a tenth of the ids is not more than a tenth
+    test_netlist.remove_net(nets[3]);
+    REQUIRE(test_netlist.num_removed_ids() == 1);
+    REQUIRE(test_netlist.should_compress(0.05));
+    REQUIRE(!test_netlist.should_compress(0.1));
+
+    test_netlist.remove_net(nets[7]);
+    REQUIRE(test_netlist.num_removed_ids() == 2);
+    REQUIRE(test_netlist.should_compress(0.1));
+
+    // compressing drops the removed ids (and here, the remaining unconnected nets)
+    test_netlist.remove_and_compress();
+    REQUIRE(test_netlist.nets().size() == 0);
+    REQUIRE(test_netlist.num_removed_ids() == 0);
+    REQUIRE(!test_netlist.should_compress(0.));
+}
 } // namespace
\ No newline at end of file
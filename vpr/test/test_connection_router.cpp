@@ -8,18 +8,28 @@
 #include "net_delay.h"
 #include "place_and_route.h"
 #include "timing_place_lookup.h"
+#include "binary_heap.h"
+#include "bucket.h"
+#include "four_ary_heap.h"
+#include "radix_heap.h"
+#include "router_connection_capture.h"
+#include "vtr_time.h"
 
 static constexpr const char kArchFile[] = "../../vtr_flow/arch/timing/k6_frac_N10_mem32K_40nm.xml";
 static constexpr int kMaxHops = 10;
+static constexpr int kNumBenchmarkRoutes = 100;
 
 namespace {
 
 // Route from source_node to sink_node, returning either the delay, or infinity if unroutable.
+// The route tree of the route found is moved to routed_tree, if given.
+template<typename Heap>
 static float do_one_route(RRNodeId source_node,
                           RRNodeId sink_node,
                           const t_det_routing_arch& det_routing_arch,
                           const t_router_opts& router_opts,
-                          const std::vector<t_segment_inf>& segment_inf) {
+                          const std::vector<t_segment_inf>& segment_inf,
+                          vtr::optional<RouteTree>* routed_tree = nullptr) {
     bool is_flat = router_opts.flat_routing;
     auto& device_ctx = g_vpr_ctx.device();
 
@@ -49,9 +59,14 @@ static float do_one_route(RRNodeId source_node,
                                                   router_opts.write_router_lookahead,
                                                   router_opts.read_router_lookahead,
                                                   segment_inf,
+                                                  router_opts.lookahead_half_precision,
                                                   is_flat);
 
-    ConnectionRouter<BinaryHeap> router(
+    if (router_opts.bidir_search_min_dist >= 0) {
+        g_vpr_ctx.mutable_device().rr_graph_builder.init_in_edges();
+    }
+
+    ConnectionRouter<Heap> router(
         device_ctx.grid,
         *router_lookahead,
         device_ctx.rr_graph.rr_nodes(),
@@ -60,6 +75,7 @@ static float do_one_route(RRNodeId source_node,
         device_ctx.rr_graph.rr_switch(),
         g_vpr_ctx.mutable_routing().rr_node_route_inf,
         is_flat);
+    router.set_bidir_search_min_dist(router_opts.bidir_search_min_dist);
 
     // Find the cheapest route if possible.
     bool found_path;
@@ -86,6 +102,10 @@ static float do_one_route(RRNodeId source_node,
         vtr::optional<const RouteTreeNode&> rt_node_of_sink;
         std::tie(std::ignore, rt_node_of_sink) = tree.update_from_heap(&cheapest, OPEN, nullptr, router_opts.flat_routing);
         delay = rt_node_of_sink.value().Tdel;
+
+        if (routed_tree) {
+            *routed_tree = std::move(tree);
+        }
     }
 
     // Reset for the next router call.
@@ -93,6 +113,26 @@ static float do_one_route(RRNodeId source_node,
     return delay;
 }
 
+// Route the same connection kNumBenchmarkRoutes times with the given heap and log the run time.
+// Returns the delay of the route.
+template<typename Heap>
+static float benchmark_one_route(const char* heap_name,
+                                 RRNodeId source_node,
+                                 RRNodeId sink_node,
+                                 const t_vpr_setup& vpr_setup) {
+    vtr::Timer timer;
+    float delay = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < kNumBenchmarkRoutes; i++) {
+        delay = do_one_route<Heap>(source_node,
+                                   sink_node,
+                                   vpr_setup.RoutingArch,
+                                   vpr_setup.RouterOpts,
+                                   vpr_setup.Segments);
+    }
+    VTR_LOG("%s heap: %d routes in %g s\n", heap_name, kNumBenchmarkRoutes, timer.elapsed_sec());
+    return delay;
+}
+
 // Find a source and a sink by walking edges.
 std::tuple<RRNodeId, RRNodeId, int> find_source_and_sink() {
     auto& device_ctx = g_vpr_ctx.device();
@@ -175,15 +215,98 @@ TEST_CASE("connection_router", "[vpr]") {
     REQUIRE(hops >= 3);
 
     // Find the route
-    float delay = do_one_route(source_rr_node,
-                               sink_rr_node,
-                               vpr_setup.RoutingArch,
-                               vpr_setup.RouterOpts,
-                               vpr_setup.Segments);
+    vtr::optional<RouteTree> routed_tree;
+    float delay = do_one_route<BinaryHeap>(source_rr_node,
+                                           sink_rr_node,
+                                           vpr_setup.RoutingArch,
+                                           vpr_setup.RouterOpts,
+                                           vpr_setup.Segments,
+                                           &routed_tree);
 
     // Check that a route was found
     REQUIRE(delay < std::numeric_limits<float>::infinity());
 
+    // Compare the other heaps against BinaryHeap. FourAryHeap is an exact priority queue,
+    // so it has to find the same route. The approximate heaps only have to find a route.
+    benchmark_one_route<BinaryHeap>("binary", source_rr_node, sink_rr_node, vpr_setup);
+    REQUIRE(benchmark_one_route<FourAryHeap>("four_ary", source_rr_node, sink_rr_node, vpr_setup) == delay);
+    REQUIRE(benchmark_one_route<Bucket>("bucket", source_rr_node, sink_rr_node, vpr_setup) < std::numeric_limits<float>::infinity());
+    REQUIRE(benchmark_one_route<RadixHeap>("radix", source_rr_node, sink_rr_node, vpr_setup) < std::numeric_limits<float>::infinity());
+
+    // Route the connection as a non-critical one, with and without bidirectional search.
+    // Both have to find a route.
+    t_router_opts non_critical_router_opts = vpr_setup.RouterOpts;
+    non_critical_router_opts.max_criticality = 0.;
+    REQUIRE(do_one_route<BinaryHeap>(source_rr_node,
+                                     sink_rr_node,
+                                     vpr_setup.RoutingArch,
+                                     non_critical_router_opts,
+                                     vpr_setup.Segments)
+            < std::numeric_limits<float>::infinity());
+
+    non_critical_router_opts.bidir_search_min_dist = 0;
+    REQUIRE(do_one_route<BinaryHeap>(source_rr_node,
+                                     sink_rr_node,
+                                     vpr_setup.RoutingArch,
+                                     non_critical_router_opts,
+                                     vpr_setup.Segments)
+            < std::numeric_limits<float>::infinity());
+
+    // Capture a connection from the route tree of the route found, then check that
+    // it reads back and rebuilds into the same tree.
+    {
+        const auto& rr_graph = g_vpr_ctx.device().rr_graph;
+        auto& route_ctx = g_vpr_ctx.mutable_routing();
+        REQUIRE(routed_tree);
+        const RouteTree& tree = routed_tree.value();
+
+        std::vector<RRNodeId> tree_nodes;
+        for (const RouteTreeNode& rt_node : tree.all_nodes()) {
+            tree_nodes.push_back(rt_node.inode);
+        }
+        REQUIRE(tree_nodes.size() >= 2);
+
+        // Congest a node of the tree, and capture the connection
+        route_ctx.rr_node_route_inf[tree_nodes[1]].acc_cost = 2.;
+
+        t_conn_cost_params cost_params;
+        cost_params.criticality = 0.5;
+        t_bb bounding_box(1, 5, 2, 6);
+        {
+            router_capture::Session capture("test_connection_router.capture", 1);
+            router_capture::set_iteration(1);
+            REQUIRE(router_capture::enabled());
+            router_capture::capture_connection(tree, sink_rr_node, cost_params, bounding_box);
+            REQUIRE(!router_capture::enabled()); // Limit reached
+        }
+        route_ctx.rr_node_route_inf[tree_nodes[1]].acc_cost = 1.;
+
+        router_capture::t_capture capture = router_capture::read_capture("test_connection_router.capture");
+        REQUIRE(capture.num_rr_nodes == rr_graph.num_nodes());
+        REQUIRE(capture.congestion.size() == 1);
+        REQUIRE(capture.congestion[0].size() == 1);
+        REQUIRE(capture.congestion[0][0].rr_node == size_t(tree_nodes[1]));
+        REQUIRE(capture.congestion[0][0].acc_cost == 2.);
+
+        REQUIRE(capture.connections.size() == 1);
+        const auto& connection = capture.connections[0];
+        REQUIRE(connection.query.sink_node == size_t(sink_rr_node));
+        REQUIRE(connection.query.criticality == 0.5);
+        REQUIRE(connection.query.xmax == 5);
+        REQUIRE(connection.tree.size() == tree_nodes.size());
+
+        t_rr_node_route_inf_storage scratch;
+        scratch.resize(rr_graph.num_nodes());
+        RouteTree rebuilt_tree = router_capture::build_route_tree(connection.tree, scratch, false);
+
+        std::vector<RRNodeId> rebuilt_tree_nodes;
+        for (const RouteTreeNode& rt_node : rebuilt_tree.all_nodes()) {
+            rebuilt_tree_nodes.push_back(rt_node.inode);
+        }
+        REQUIRE(rebuilt_tree_nodes == tree_nodes);
+        REQUIRE(rebuilt_tree.find_by_rr_id(sink_rr_node).value().Tdel == delay);
+    }
+
     // Clean up
     free_routing_structs();
     vpr_free_all(arch,
@@ -76,4 +76,29 @@ TEST_CASE("edge_groups_create_sets", "[vpr]") {
     }
 }
 
+TEST_CASE("rr_non_config_node_sets_lookup", "[vpr]") {
+    std::vector<std::vector<RRNodeId>> node_sets{{RRNodeId(4), RRNodeId(1), RRNodeId(7)},
+                                                 {RRNodeId(0), RRNodeId(5)}};
+
+    t_rr_non_config_node_sets sets;
+    sets.init(/*num_nodes=*/9, node_sets);
+
+    REQUIRE(sets.size() == node_sets.size());
+    for (size_t iset = 0; iset < node_sets.size(); iset++) {
+        auto set_nodes = sets[iset];
+        REQUIRE(std::vector<RRNodeId>(set_nodes.begin(), set_nodes.end()) == node_sets[iset]);
+        for (RRNodeId node : node_sets[iset]) {
+            REQUIRE(sets.node_set(node) == int(iset));
+        }
+    }
+
+    for (int inode : {2, 3, 6, 8}) {
+        REQUIRE(sets.node_set(RRNodeId(inode)) == OPEN);
+    }
+
+    sets.clear();
+    REQUIRE(sets.empty());
+    REQUIRE(sets.node_set(RRNodeId(4)) == OPEN);
+}
+
 } // namespace
@@ -0,0 +1,54 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "net_bb_histograms.h"
+
+namespace {
+
+TEST_CASE("net_bb_histograms_track_pin_moves", "[vpr_place]") {
+    NetBBHistograms histograms;
+    histograms.init(3, 9, 9);
+
+    ClusterNetId net(1);
+    histograms.add_net(net, 3);
+
+    REQUIRE(histograms.has_net(net));
+    REQUIRE(!histograms.has_net(ClusterNetId(0)));
+    REQUIRE(!histograms.has_net(ClusterNetId(2)));
+
+    histograms.set_pin_loc(net, 0, 2, 3);
+    histograms.set_pin_loc(net, 1, 5, 3);
+    histograms.set_pin_loc(net, 2, 7, 8);
+
+    REQUIRE(histograms.num_pins_at_x(net, 2) == 1);
+    REQUIRE(histograms.num_pins_at_y(net, 3) == 2);
+    REQUIRE(histograms.lowest_x_from(net, 1) == 2);
+    REQUIRE(histograms.highest_x_from(net, 9) == 7);
+    REQUIRE(histograms.lowest_y_from(net, 0) == 3);
+    REQUIRE(histograms.highest_y_from(net, 9) == 8);
+
+    SECTION("moving the only pin off an edge shrinks the box") {
+        histograms.set_pin_loc(net, 2, 4, 4);
+
+        REQUIRE(histograms.num_pins_at_x(net, 7) == 0);
+        REQUIRE(histograms.num_pins_at_y(net, 8) == 0);
+        REQUIRE(histograms.highest_x_from(net, 7) == 5);
+        REQUIRE(histograms.highest_y_from(net, 8) == 4);
+    }
+
+    SECTION("moving a pin back restores the histogram") {
+        histograms.set_pin_loc(net, 0, 6, 6);
+        histograms.set_pin_loc(net, 0, 2, 3);
+
+        REQUIRE(histograms.num_pins_at_x(net, 6) == 0);
+        REQUIRE(histograms.num_pins_at_x(net, 2) == 1);
+        REQUIRE(histograms.num_pins_at_y(net, 3) == 2);
+        REQUIRE(histograms.lowest_x_from(net, 0) == 2);
+    }
+
+    SECTION("init drops all tracked nets") {
+        histograms.init(3, 9, 9);
+        REQUIRE(!histograms.has_net(net));
+    }
+}
+
+} // namespace
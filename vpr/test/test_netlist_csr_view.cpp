@@ -0,0 +1,92 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "clustered_netlist.h"
+#include "netlist_csr_view.h"
+
+#include <vector>
+
+namespace {
+
+TEST_CASE("test_netlist_csr_view_matches_netlist", "[vpr_netlist_csr_view]") {
+    // a single block type with enough pins for the test blocks
+    t_physical_tile_type tile_type;
+    tile_type.num_pins = 4;
+
+    t_logical_block_type block_type;
+    char block_name[] = "clb";
+    block_type.name = block_name;
+    block_type.index = 0;
+    block_type.equivalent_tiles.push_back(&tile_type);
+
+    t_pb pb;
+
+    ClusteredNetlist test_netlist("test_netlist", "77");
+
+    // three blocks, each with an input and an output port
+    char blk_names[3][5] = {"blk0", "blk1", "blk2"};
+    std::vector<ClusterBlockId> blocks;
+    std::vector<ClusterPortId> in_ports;
+    std::vector<ClusterPortId> out_ports;
+    for (auto& blk_name : blk_names) {
+        ClusterBlockId blk_id = test_netlist.create_block(blk_name, &pb, &block_type);
+        blocks.push_back(blk_id);
+        in_ports.push_back(test_netlist.create_port(blk_id, "in", 2, PortType::INPUT));
+        out_ports.push_back(test_netlist.create_port(blk_id, "out", 1, PortType::OUTPUT));
+    }
+
+    // net_a: blk0 -> blk1, blk2
+    // net_b: blk1 -> blk2, blk0
+    // net_c: blk2 -> (no sinks)
+    ClusterNetId net_a = test_netlist.create_net("net_a");
+    ClusterNetId net_b = test_netlist.create_net("net_b");
+    ClusterNetId net_c = test_netlist.create_net("net_c");
+
+    test_netlist.create_pin(out_ports[0], 0, net_a, PinType::DRIVER, 2);
+    test_netlist.create_pin(in_ports[1], 0, net_a, PinType::SINK, 0);
+    test_netlist.create_pin(in_ports[2], 0, net_a, PinType::SINK, 0);
+
+    test_netlist.create_pin(out_ports[1], 0, net_b, PinType::DRIVER, 2);
+    test_netlist.create_pin(in_ports[2], 1, net_b, PinType::SINK, 1);
+    test_netlist.create_pin(in_ports[0], 1, net_b, PinType::SINK, 1);
+
+    test_netlist.create_pin(out_ports[2], 0, net_c, PinType::DRIVER, 2);
+
+    NetlistCsrView<ClusterBlockId, ClusterPortId, ClusterPinId, ClusterNetId> view(test_netlist);
+
+    for (ClusterNetId net_id : test_netlist.nets()) {
+        auto net_pins = test_netlist.net_pins(net_id);
+        REQUIRE(view.net_num_pins(net_id) == net_pins.size());
+        REQUIRE(view.net_pins(net_id).size() == net_pins.size());
+        REQUIRE(view.net_pin_blocks(net_id).size() == net_pins.size());
+        REQUIRE(view.net_driver_block(net_id) == test_netlist.net_driver_block(net_id));
+
+        for (size_t ipin = 0; ipin < net_pins.size(); ipin++) {
+            ClusterPinId pin_id = test_netlist.net_pin(net_id, ipin);
+            REQUIRE(view.net_pin(net_id, ipin) == pin_id);
+            REQUIRE(view.net_pins(net_id)[ipin] == pin_id);
+            REQUIRE(view.net_pin_blocks(net_id)[ipin] == test_netlist.pin_block(pin_id));
+        }
+    }
+
+    for (ClusterBlockId blk_id : test_netlist.blocks()) {
+        auto block_pins = test_netlist.block_pins(blk_id);
+        auto view_block_pins = view.block_pins(blk_id);
+        REQUIRE(std::vector<ClusterPinId>(view_block_pins.begin(), view_block_pins.end())
+                == std::vector<ClusterPinId>(block_pins.begin(), block_pins.end()));
+    }
+
+    for (ClusterPinId pin_id : test_netlist.pins()) {
+        REQUIRE(view.pin_net(pin_id) == test_netlist.pin_net(pin_id));
+        REQUIRE(view.pin_net_index(pin_id) == test_netlist.pin_net_index(pin_id));
+        REQUIRE(view.pin_block(pin_id) == test_netlist.pin_block(pin_id));
+    }
+
+    // spot check the layout against the expected connectivity
+    REQUIRE(view.net_num_pins(net_a) == 3);
+    REQUIRE(view.net_pin_blocks(net_a)[0] == blocks[0]);
+    REQUIRE(view.net_pin_blocks(net_b)[2] == blocks[0]);
+    REQUIRE(view.net_num_pins(net_c) == 1);
+    REQUIRE(view.block_pins(blocks[0]).size() == 2);
+}
+
+} // namespace
@@ -0,0 +1,44 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "place_delay_model.h"
+
+namespace {
+
+TEST_CASE("batched_delta_delay_model_lookup", "[vpr]") {
+    constexpr size_t kDimLayer = 2;
+    constexpr size_t kDimX = 10;
+    constexpr size_t kDimY = 7;
+    vtr::NdMatrix<float, 3> delays;
+    delays.resize({kDimLayer, kDimX, kDimY});
+
+    for (size_t layer = 0; layer < kDimLayer; ++layer) {
+        for (size_t x = 0; x < kDimX; ++x) {
+            for (size_t y = 0; y < kDimY; ++y) {
+                delays[layer][x][y] = (layer + 1) * 100 + x * 10 + y;
+            }
+        }
+    }
+
+    DeltaDelayModel model(std::move(delays), false);
+
+    const int from_x = 4;
+    const int from_y = 3;
+
+    t_delay_sinks sinks;
+    for (size_t layer = 0; layer < kDimLayer; ++layer) {
+        for (int x = 0; x < (int)kDimX - from_x; ++x) {
+            for (int y = 0; y < (int)kDimY - from_y; ++y) {
+                sinks.push_back(x, y, 0, layer);
+            }
+        }
+    }
+
+    std::vector<float> batch_delays(sinks.size());
+    model.delays(from_x, from_y, 0, sinks, batch_delays.data());
+
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        REQUIRE(batch_delays[i] == model.delay(from_x, from_y, 0, sinks.x[i], sinks.y[i], sinks.pin[i], sinks.layer[i]));
+    }
+}
+
+} // namespace
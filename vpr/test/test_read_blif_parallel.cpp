@@ -0,0 +1,141 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "blifparse.hpp"
+#include "read_blif_parallel.h"
+
+namespace {
+
+//Records the (line number independent) sequence of callbacks
+class RecordingCallback : public blifparse::Callback {
+  public:
+    void start_parse() override { calls.push_back("start_parse"); }
+    void filename(std::string /*fname*/) override {}
+    void lineno(int /*line_num*/) override {}
+
+    void begin_model(std::string model_name) override { calls.push_back(".model " + model_name); }
+    void inputs(std::vector<std::string> inputs) override { calls.push_back(".inputs" + join(inputs)); }
+    void outputs(std::vector<std::string> outputs) override { calls.push_back(".outputs" + join(outputs)); }
+
+    void names(std::vector<std::string> nets, std::vector<std::vector<blifparse::LogicValue>> so_cover) override {
+        std::string call = ".names" + join(nets);
+        for (const auto& row : so_cover) {
+            call += " |";
+            for (auto value : row) {
+                call += " " + std::to_string(int(value));
+            }
+        }
+        calls.push_back(call);
+    }
+
+    void latch(std::string input, std::string output, blifparse::LatchType type, std::string control, blifparse::LogicValue init) override {
+        std::stringstream ss;
+        ss << ".latch " << input << " " << output << " " << int(type) << " '" << control << "' " << int(init);
+        calls.push_back(ss.str());
+    }
+
+    void subckt(std::string model, std::vector<std::string> ports, std::vector<std::string> nets) override {
+        std::string call = ".subckt " + model;
+        for (size_t i = 0; i < ports.size(); ++i) {
+            call += " " + ports[i] + "=" + nets[i];
+        }
+        calls.push_back(call);
+    }
+
+    void blackbox() override { calls.push_back(".blackbox"); }
+    void end_model() override { calls.push_back(".end"); }
+
+    void conn(std::string src, std::string dst) override { calls.push_back(".conn " + src + " " + dst); }
+    void cname(std::string cell_name) override { calls.push_back(".cname " + cell_name); }
+    void attr(std::string name, std::string value) override { calls.push_back(".attr " + name + " '" + value + "'"); }
+    void param(std::string name, std::string value) override { calls.push_back(".param " + name + " '" + value + "'"); }
+
+    void finish_parse() override { calls.push_back("finish_parse"); }
+
+    void parse_error(const int /*curr_lineno*/, const std::string& /*near_text*/, const std::string& /*msg*/) override {
+        calls.push_back("error");
+    }
+
+    std::vector<std::string> calls;
+
+  private:
+    static std::string join(const std::vector<std::string>& strings) {
+        std::string joined;
+        for (const auto& str : strings) {
+            joined += " " + str;
+        }
+        return joined;
+    }
+};
+
+constexpr const char* kBlif = R"(# A comment
+.model top
+.inputs a b \
+    c clk
+.outputs o1 o2
+
+.names a b \
+  n1
+11 1
+.names c o1 # An end of line comment
+0 1
+.latch n1 o2 re clk 0
+.latch n1 q1 re NIL
+.latch n1 q2 2
+.latch n1 q3
+.subckt adder a=a b = b cin=c sumout=o2
+.cname add0
+.param WIDTH 0101
+.param MODE "fast mode"
+.attr keep
+.conn n1 o2
+.end
+
+.model adder
+.inputs a b cin
+.outputs sumout
+.blackbox
+.end
+)";
+
+} // namespace
+
+TEST_CASE("Matches libblifparse", "[vpr_read_blif_parallel]") {
+    const char* blif_file = "test_read_blif_parallel.eblif";
+    {
+        std::ofstream out(blif_file);
+        out << kBlif;
+    }
+
+    RecordingCallback reference;
+    blifparse::blif_parse_filename(blif_file, reference);
+    REQUIRE(reference.calls.size() > 2);
+
+    //Also check with the file split into as many chunks as possible
+    for (size_t min_chunk_bytes : {ParallelBlifParser::DEFAULT_MIN_CHUNK_BYTES, size_t(1)}) {
+        ParallelBlifParser parser(blif_file, min_chunk_bytes);
+        REQUIRE(parser.model_sizes().size() == 2);
+        REQUIRE(parser.model_sizes()[0].num_blocks == 13); //4 inputs, 2 outputs, 2 .names, 4 .latch and 1 .subckt
+
+        RecordingCallback callback;
+        parser.parse(callback);
+        REQUIRE(callback.calls == reference.calls);
+    }
+}
+
+TEST_CASE("Reports errors", "[vpr_read_blif_parallel]") {
+    const char* blif_file = "test_read_blif_parallel_error.blif";
+    {
+        std::ofstream out(blif_file);
+        out << ".model top\n.inputs a\n.names a o\n1 1 1\n.end\n";
+    }
+
+    ParallelBlifParser parser(blif_file);
+    RecordingCallback callback;
+    parser.parse(callback);
+    REQUIRE(callback.calls.back() == "error");
+}
@@ -0,0 +1,69 @@
+#include <tuple>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "rr_graph_storage.h"
+
+namespace {
+
+using t_edge = std::tuple<RRNodeId, RRNodeId, short>;
+
+std::vector<t_edge> storage_edges(const t_rr_graph_storage& storage) {
+    std::vector<t_edge> edges;
+    storage.for_each_edge([&](RREdgeId edge, RRNodeId src, RRNodeId sink) {
+        REQUIRE(storage.edge_sink_node(edge) == sink);
+        edges.emplace_back(src, sink, storage.edge_switch(edge));
+    });
+    return edges;
+}
+
+TEST_CASE("rr_graph_storage_compress_edges", "[vpr]") {
+    for (size_t num_switches : {3, 300}) {
+        const size_t num_nodes = 1000;
+
+        t_rr_graph_storage storage;
+        storage.resize(num_nodes);
+        //Every third node has edges, so some nodes have none
+        for (size_t inode = 0; inode < num_nodes; inode += 3) {
+            for (size_t k = 0; k < 4; ++k) {
+                storage.emplace_back_edge(RRNodeId(inode),
+                                          RRNodeId((inode * 7 + k * 13) % num_nodes),
+                                          (inode + k) % num_switches,
+                                          true);
+            }
+        }
+
+        vtr::vector<RRSwitchId, t_rr_switch_inf> rr_switches(num_switches);
+        for (auto& rr_switch : rr_switches) {
+            rr_switch.set_type(SwitchType::MUX);
+        }
+        storage.mark_edges_as_rr_switch_ids();
+        storage.partition_edges(rr_switches);
+        storage.init_fan_in();
+
+        std::vector<t_edge> edges = storage_edges(storage);
+
+        storage.compress_edges();
+        REQUIRE(storage.edges_compressed());
+        REQUIRE(storage_edges(storage) == edges);
+
+        t_rr_graph_view view = storage.view();
+        size_t iedge = 0;
+        for (size_t inode = 0; inode < num_nodes; ++inode) {
+            for (RREdgeId edge : view.edge_range(RRNodeId(inode))) {
+                REQUIRE(view.edge_src_node(edge) == std::get<0>(edges[iedge]));
+                REQUIRE(view.edge_sink_node(edge) == std::get<1>(edges[iedge]));
+                REQUIRE(view.edge_switch(edge) == std::get<2>(edges[iedge]));
+                ++iedge;
+            }
+        }
+        REQUIRE(iedge == edges.size());
+
+        storage.decompress_edges();
+        REQUIRE(!storage.edges_compressed());
+        REQUIRE(storage_edges(storage) == edges);
+    }
+}
+
+} // namespace
@@ -0,0 +1,52 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "rr_spatial_lookup.h"
+
+namespace {
+
+TEST_CASE("rr_spatial_lookup_flatten", "[vpr]") {
+    RRSpatialLookup lookup;
+    //Track 1 of the channel is left unused. CHANX nodes are added with swapped (y, x) coordinates
+    lookup.add_node(RRNodeId(0), 0, 2, 1, CHANX, 0);
+    lookup.add_node(RRNodeId(1), 0, 2, 1, CHANX, 2);
+    lookup.add_node(RRNodeId(2), 0, 3, 1, CHANY, 0);
+    lookup.add_node(RRNodeId(3), 0, 3, 1, IPIN, 5, RIGHT);
+    lookup.add_node(RRNodeId(4), 1, 0, 0, SINK, 0);
+
+    auto check_lookup = [&]() {
+        REQUIRE(lookup.find_node(0, 1, 2, CHANX, 0) == RRNodeId(0));
+        REQUIRE(!lookup.find_node(0, 1, 2, CHANX, 1));
+        REQUIRE(lookup.find_node(0, 1, 2, CHANX, 2) == RRNodeId(1));
+        REQUIRE(!lookup.find_node(0, 1, 2, CHANX, 3));
+        REQUIRE(!lookup.find_node(0, 2, 1, CHANX, 0));
+        REQUIRE(lookup.find_node(0, 3, 1, CHANY, 0) == RRNodeId(2));
+        REQUIRE(lookup.find_node(0, 3, 1, IPIN, 5, RIGHT) == RRNodeId(3));
+        REQUIRE(!lookup.find_node(0, 3, 1, IPIN, 5, LEFT));
+        REQUIRE(lookup.find_node(1, 0, 0, SINK, 0) == RRNodeId(4));
+        REQUIRE(!lookup.find_node(2, 0, 0, SINK, 0));
+
+        REQUIRE(lookup.find_channel_nodes(0, 1, 2, CHANX) == std::vector<RRNodeId>{RRNodeId(0), RRNodeId(1)});
+        auto channel = lookup.channel_nodes(0, 1, 2, CHANX);
+        REQUIRE(channel.size() == 3);
+        REQUIRE(!channel[1]);
+        REQUIRE(lookup.channel_nodes(0, 100, 100, CHANX).empty());
+        REQUIRE(lookup.grid_nodes(0, 3, 1, IPIN, RIGHT).size() == 6);
+        REQUIRE(lookup.find_grid_nodes_at_all_sides(0, 3, 1, IPIN) == std::vector<RRNodeId>{RRNodeId(3)});
+    };
+
+    check_lookup();
+
+    lookup.flatten();
+    REQUIRE(lookup.is_flat());
+    check_lookup();
+
+    //Adding a node restores the nested look-up
+    lookup.add_node(RRNodeId(5), 0, 2, 1, CHANX, 1);
+    REQUIRE(!lookup.is_flat());
+    REQUIRE(lookup.find_node(0, 1, 2, CHANX, 1) == RRNodeId(5));
+    lookup.flatten();
+    REQUIRE(lookup.find_node(0, 1, 2, CHANX, 1) == RRNodeId(5));
+    REQUIRE(lookup.find_node(0, 3, 1, IPIN, 5, RIGHT) == RRNodeId(3));
+}
+
+} // namespace
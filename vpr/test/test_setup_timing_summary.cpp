@@ -0,0 +1,108 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "setup_timing_summary.h"
+
+#include "tatum/TimingGraph.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/analyzer_factory.hpp"
+#include "tatum/graph_walkers.hpp"
+#include "tatum/delay_calc/FixedDelayCalculator.hpp"
+#include "tatum/timing_paths.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Checks the summary against the one calculated by scanning all the end-points
+void require_matches_scan(const SetupTimingSummary& summary,
+                          const tatum::TimingGraph& tg,
+                          const tatum::TimingConstraints& tc,
+                          const tatum::SetupTimingAnalyzer& analyzer) {
+    auto ref_cpds = tatum::find_critical_paths(tg, tc, analyzer);
+    auto cpds = summary.critical_paths();
+    REQUIRE(cpds.size() == ref_cpds.size());
+    for (size_t ipath = 0; ipath < cpds.size(); ipath++) {
+        REQUIRE(cpds[ipath].launch_domain() == ref_cpds[ipath].launch_domain());
+        REQUIRE(cpds[ipath].capture_domain() == ref_cpds[ipath].capture_domain());
+        REQUIRE(cpds[ipath].delay() == ref_cpds[ipath].delay());
+    }
+
+    float ref_tns = 0.;
+    float ref_wns = 0.;
+    for (tatum::NodeId node : tg.logical_outputs()) {
+        for (const tatum::TimingTag& tag : analyzer.setup_slacks(node)) {
+            if (tag.time().value() < 0.) {
+                ref_tns += tag.time().value();
+                ref_wns = std::min(ref_wns, tag.time().value());
+            }
+        }
+    }
+    REQUIRE(summary.worst_negative_slack() == ref_wns);
+    REQUIRE(std::abs(summary.total_negative_slack() - ref_tns) <= 1e-5 * std::abs(ref_tns));
+}
+
+TEST_CASE("test_setup_timing_summary_incremental_updates", "[vpr_setup_timing_summary]") {
+    constexpr size_t NUM_IOS = 64;
+
+    // Primary inputs and outputs in two virtual clock domains. Each output is driven by two
+    // inputs, so some outputs have paths from both domains.
+    tatum::TimingGraph tg;
+    std::vector<tatum::NodeId> inputs;
+    std::vector<tatum::NodeId> outputs;
+    for (size_t i = 0; i < NUM_IOS; i++) {
+        inputs.push_back(tg.add_node(tatum::NodeType::SOURCE));
+        outputs.push_back(tg.add_node(tatum::NodeType::SINK));
+    }
+    std::vector<tatum::EdgeId> edges;
+    for (size_t i = 0; i < NUM_IOS; i++) {
+        edges.push_back(tg.add_edge(tatum::EdgeType::INTERCONNECT, inputs[i], outputs[i]));
+        edges.push_back(tg.add_edge(tatum::EdgeType::INTERCONNECT, inputs[(i + 3) % NUM_IOS], outputs[i]));
+    }
+    tg.levelize();
+
+    tatum::TimingConstraints tc;
+    tatum::DomainId domains[2] = {tc.create_clock_domain("clk_a"), tc.create_clock_domain("clk_b")};
+    for (tatum::DomainId launch : domains) {
+        for (tatum::DomainId capture : domains) {
+            tc.set_setup_constraint(launch, capture, tatum::Time(launch == capture ? 1e-9 : 2e-9));
+        }
+    }
+    for (size_t i = 0; i < NUM_IOS; i++) {
+        tc.set_input_constraint(inputs[i], domains[i % 2], tatum::DelayType::MAX, tatum::Time(0.));
+        tc.set_output_constraint(outputs[i], domains[(i / 2) % 2], tatum::DelayType::MAX, tatum::Time(0.));
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> delay_dist(0., 3e-9);
+
+    tatum::util::linear_map<tatum::EdgeId, tatum::Time> max_delays(tg.edges().size());
+    tatum::util::linear_map<tatum::EdgeId, tatum::Time> setup_times(tg.edges().size(), tatum::Time(0.));
+    for (tatum::EdgeId edge : edges) {
+        max_delays[edge] = tatum::Time(delay_dist(rng));
+    }
+    tatum::FixedDelayCalculator delay_calc(max_delays, setup_times);
+
+    auto analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::SerialIncrWalker>::make(tg, tc, delay_calc);
+    SetupTimingSummary summary(tg, tc);
+
+    analyzer->update_setup_timing();
+    summary.update(*analyzer);
+    require_matches_scan(summary, tg, tc, *analyzer);
+
+    // Change a few delays at a time, so only some of the end-points are modified by each analysis
+    for (int iupdate = 0; iupdate < 200; iupdate++) {
+        for (int ichange = 0; ichange < 3; ichange++) {
+            tatum::EdgeId edge = edges[rng() % edges.size()];
+            delay_calc.set_max_edge_delay(tg, edge, tatum::Time(delay_dist(rng)));
+            analyzer->invalidate_edge(edge);
+        }
+        analyzer->update_setup_timing();
+        summary.update(*analyzer);
+        require_matches_scan(summary, tg, tc, *analyzer);
+    }
+}
+
+} // namespace
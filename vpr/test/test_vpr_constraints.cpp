@@ -131,6 +131,51 @@ TEST_CASE("VprConstraints", "[vpr]") {
     REQUIRE(partition_atoms.size() == 3);
 }
 
+//Test the partition atom lists and the cached intersections of partitions
+TEST_CASE("VprConstraintsPartitionPairs", "[vpr]") {
+    VprConstraints vprcon;
+
+    Partition part_a, part_b;
+    PartitionRegion pr_a, pr_b;
+    Region reg_a, reg_b;
+    reg_a.set_region_rect({0, 0, 5, 5, 0});
+    reg_b.set_region_rect({3, 3, 8, 8, 0});
+    pr_a.add_to_part_region(reg_a);
+    pr_b.add_to_part_region(reg_b);
+    part_a.set_part_region(pr_a);
+    part_b.set_part_region(pr_b);
+    vprcon.add_partition(part_a);
+    vprcon.add_partition(part_b);
+
+    vprcon.add_constrained_atom(AtomBlockId(7), PartitionId(1));
+    vprcon.add_constrained_atom(AtomBlockId(2), PartitionId(0));
+    vprcon.add_constrained_atom(AtomBlockId(4), PartitionId(1));
+
+    REQUIRE(vprcon.get_atom_partition(AtomBlockId(3)) == PartitionId::INVALID());
+    REQUIRE(vprcon.get_atom_partition(AtomBlockId(100)) == PartitionId::INVALID());
+    REQUIRE(vprcon.get_part_atoms(PartitionId(0)) == std::vector<AtomBlockId>{AtomBlockId(2)});
+    REQUIRE(vprcon.get_part_atoms(PartitionId(1)) == std::vector<AtomBlockId>{AtomBlockId(4), AtomBlockId(7)});
+
+    //Moving an atom to another partition updates the atom lists
+    vprcon.add_constrained_atom(AtomBlockId(7), PartitionId(0));
+    REQUIRE(vprcon.get_part_atoms(PartitionId(0)) == std::vector<AtomBlockId>{AtomBlockId(2), AtomBlockId(7)});
+
+    std::vector<Region> int_regions = vprcon.get_partition_pair_intersection(PartitionId(0), PartitionId(1)).get_partition_region();
+    REQUIRE(int_regions.size() == 1);
+    REQUIRE(int_regions[0].get_region_rect() == RegionRectCoord(3, 3, 5, 5, 0));
+    REQUIRE(vprcon.get_partition_pair_intersection(PartitionId(1), PartitionId(0)).get_partition_region().size() == 1);
+
+    //Setting a PartitionRegion drops the cached intersections
+    PartitionRegion pr_c;
+    Region reg_c;
+    reg_c.set_region_rect({7, 7, 9, 9, 0});
+    pr_c.add_to_part_region(reg_c);
+    vprcon.set_partition_pr(PartitionId(0), pr_c);
+    int_regions = vprcon.get_partition_pair_intersection(PartitionId(0), PartitionId(1)).get_partition_region();
+    REQUIRE(int_regions.size() == 1);
+    REQUIRE(int_regions[0].get_region_rect() == RegionRectCoord(7, 7, 8, 8, 0));
+}
+
 //Test intersection function for Regions
 TEST_CASE("RegionIntersect", "[vpr]") {
     //Test partial intersection